@@ -33,6 +33,16 @@ if(NOT DEFINED MBEDCRYPTO_TARGET_NAME)
     message(FATAL_ERROR "Please set MBEDCRYPTO_TARGET_NAME before including this file.")
 endif()
 
+#Select the speed and size trade-off of the configuration, see
+#tfm_mbedcrypto_profile.h. The configurations not including that header
+#ignore it.
+if(DEFINED MBEDCRYPTO_PROFILE)
+    if(NOT MBEDCRYPTO_PROFILE MATCHES "^(SPEED|BALANCED|SIZE)$")
+        message(FATAL_ERROR "MBEDCRYPTO_PROFILE must be SPEED, BALANCED or SIZE, it is '${MBEDCRYPTO_PROFILE}'.")
+    endif()
+    string(APPEND MBEDCRYPTO_C_FLAGS " -DTFM_MBEDCRYPTO_PROFILE_${MBEDCRYPTO_PROFILE}")
+endif()
+
 if(MBEDCRYPTO_DEBUG)
     set(MBEDCRYPTO_BUILD_TYPE "Debug")
 else()
@@ -59,6 +69,14 @@ get_mbedcrypto_mbedtls_version()
 
 string(APPEND MBEDCRYPTO_C_FLAGS ${CMAKE_C_FLAGS})
 
+#Build Mbed Crypto with the DSP extension of the core, for the bignum kernels
+#of tfm_mbedtls_bn_mul.h. The option comes after the CPU options of
+#CMAKE_C_FLAGS, so it takes precedence over them.
+if (ARM_CPU_DSP)
+   compiler_get_dsp_option_string(_DSP_OPTION_STRING)
+   string(APPEND MBEDCRYPTO_C_FLAGS " ${_DSP_OPTION_STRING}")
+endif()
+
 # Workaround Mbed TLS issue https://github.com/ARMmbed/mbedtls/issues/1077
 if ((${ARM_CPU_ARCHITECTURE} STREQUAL "ARMv8-M.BASE") OR
     (${ARM_CPU_ARCHITECTURE} STREQUAL "ARMv6-M") OR
@@ -130,6 +130,70 @@ elseif(${COMPILER} STREQUAL "GNUARM")
 	endfunction()
 endif()
 
+option(TFM_STACK_USAGE "Write the stack usage of each function, for the partition stack usage report" OFF)
+if (TFM_STACK_USAGE)
+	if (NOT ${COMPILER} STREQUAL "GNUARM")
+		message(FATAL_ERROR "TFM_STACK_USAGE is only supported with the GNUARM compiler.")
+	endif()
+	list(APPEND COMMON_COMPILE_FLAGS -fstack-usage)
+endif()
+
+option(TFM_FP_ENABLE "Build the images for the FPU, with lazy preservation of the FP context of the secure partitions" OFF)
+if (TFM_FP_ENABLE)
+	if (ARM_CPU_ARCHITECTURE STREQUAL "ARMv8-M.MAIN" OR ARM_CPU_ARCHITECTURE STREQUAL "ARMv8.1-M.MAIN")
+		set(_FP_UNIT fpv5-sp-d16)
+	elseif (ARM_CPU_ARCHITECTURE STREQUAL "ARMv7-M")
+		set(_FP_UNIT fpv4-sp-d16)
+	else()
+		message(FATAL_ERROR "TFM_FP_ENABLE is not supported on ${ARM_CPU_ARCHITECTURE}, which has no FPU.")
+	endif()
+	#The soft-float calling convention is kept, so that the secure and the
+	#non-secure images do not need to agree on the FP ABI of the veneers.
+	list(REMOVE_ITEM COMMON_COMPILE_FLAGS -mfpu=none -msoft-float)
+	list(APPEND COMMON_COMPILE_FLAGS -mfloat-abi=softfp -mfpu=${_FP_UNIT})
+endif()
+
+option(TFM_LTO "Build the core, SPM and platform code of the secure image with link time optimization" OFF)
+if (TFM_LTO)
+	if (NOT TFM_LVL EQUAL 1)
+		message(FATAL_ERROR "TFM_LTO is only supported with TFM_LVL 1, the partitions of the higher isolation levels are placed by the name of their objects.")
+	endif()
+	if (${COMPILER} STREQUAL "ARMCLANG")
+		set(TFM_LTO_COMPILE_FLAGS -flto)
+		set(TFM_LTO_LINK_FLAGS --lto)
+	else()
+		set(TFM_LTO_COMPILE_FLAGS -flto)
+		#The optimization level is taken from the objects, the CMSE flag is
+		#given again so that the code generated at link time keeps it.
+		set(TFM_LTO_LINK_FLAGS -flto -fuse-linker-plugin ${CMSE_FLAGS})
+	endif()
+endif()
+
+#Build the objects of a target with link time optimization, if enabled.
+#The target shall be linked with config_setting_lto_linker_flags().
+function(config_setting_lto_compiler_flags tgt)
+	if (TFM_LTO)
+		embedded_set_target_compile_flags(TARGET ${tgt} LANGUAGE C FLAGS ${TFM_LTO_COMPILE_FLAGS} APPEND)
+	endif()
+endfunction()
+
+#Link a target with link time optimization, if enabled.
+function(config_setting_lto_linker_flags tgt)
+	if (TFM_LTO)
+		embedded_set_target_link_flags(TARGET ${tgt} FLAGS ${TFM_LTO_LINK_FLAGS} APPEND)
+	endif()
+endfunction()
+
+#Build some source files without link time optimization: the files holding
+#CMSE entry functions, which nothing in the image calls; the files calling C
+#functions from inline assembly, which the linker does not see as references;
+#and the files placed by the name of their object in the linker scripts.
+function(config_setting_lto_exclude_sources)
+	if (TFM_LTO)
+		set_source_files_properties(${ARGN} PROPERTIES COMPILE_FLAGS -fno-lto)
+	endif()
+endfunction()
+
 #Create a string from the compile flags list, so that it can be used later
 #in this file to set mbedtls and BL2 flags
 list_to_string(COMMON_COMPILE_FLAGS_STR ${COMMON_COMPILE_FLAGS})
@@ -155,13 +219,15 @@ option(TFM_PARTITION_SECURE_STORAGE "Enable the TF-M secure storage partition" O
 option(TFM_PARTITION_INTERNAL_TRUSTED_STORAGE "Enable the TF-M internal trusted storage partition" ON)
 option(TFM_PARTITION_CRYPTO "Enable the TF-M crypto partition" ON)
 option(TFM_PARTITION_INITIAL_ATTESTATION "Enable the TF-M initial attestation partition" ON)
+option(TFM_PARTITION_FIRMWARE_UPDATE "Enable the TF-M firmware update partition" OFF)
+option(TFM_PARTITION_TLS_RECORD "Enable the TF-M TLS record partition" OFF)
 
 if (NOT TFM_LVL EQUAL 1 AND NOT DEFINED CONFIG_TFM_ENABLE_MEMORY_PROTECT)
 	set (CONFIG_TFM_ENABLE_MEMORY_PROTECT ON)
 endif()
 
-if (TFM_PARTITION_INITIAL_ATTESTATION OR TFM_PARTITION_SECURE_STORAGE)
-	#PSA Initial Attestation and Protected storage rely on Cryptography API
+if (TFM_PARTITION_INITIAL_ATTESTATION OR TFM_PARTITION_SECURE_STORAGE OR TFM_PARTITION_FIRMWARE_UPDATE OR TFM_PARTITION_TLS_RECORD)
+	#PSA Initial Attestation, Protected storage, Firmware update and TLS record rely on Cryptography API
 	set(TFM_PARTITION_CRYPTO ON)
 endif()
 
@@ -176,6 +242,22 @@ endif()
 # Option to demonstrate usage of secure-only peripheral
 set (SECURE_UART1 OFF)
 
+option(TFM_STDIO_BUFFERED "Buffer the STDIO output and send it without waiting for the UART" OFF)
+set(TFM_STDIO_OVERFLOW "WAIT" CACHE STRING "Set what the buffered STDIO does with output which doesn't fit in the buffer.")
+set_property(CACHE TFM_STDIO_OVERFLOW PROPERTY STRINGS "WAIT;DROP")
+validate_cache_value(TFM_STDIO_OVERFLOW)
+if (TFM_STDIO_BUFFERED)
+	add_definitions(-DTFM_STDIO_BUFFERED)
+	if (TFM_STDIO_OVERFLOW STREQUAL "DROP")
+		add_definitions(-DTFM_STDIO_OVERFLOW_DROP)
+	endif()
+endif()
+
+option(TFM_LOG_DEFERRED "Output the secure log messages as binary frames decoded by the host" OFF)
+if (TFM_LOG_DEFERRED)
+	add_definitions(-DTFM_LOG_DEFERRED)
+endif()
+
 if (PLATFORM_SVC_HANDLERS)
 	add_definitions(-DPLATFORM_SVC_HANDLERS)
 endif()
@@ -207,6 +289,162 @@ if (DEFINED TFM_MULTI_CORE_TOPOLOGY AND TFM_MULTI_CORE_TOPOLOGY)
 	if (NOT REGRESSION)
 		set(TFM_MULTI_CORE_TEST OFF)
 	endif()
+
+	option(TFM_MAILBOX_RING "Exchange mailbox requests and replies through lock-free rings" OFF)
+	if (TFM_MAILBOX_RING)
+		add_definitions(-DTFM_MAILBOX_RING)
+	endif()
+
+	option(TFM_MAILBOX_COALESCE "Coalesce mailbox notifications between the cores" OFF)
+	if (TFM_MAILBOX_COALESCE)
+		add_definitions(-DTFM_MAILBOX_COALESCE)
+	endif()
+
+	option(TFM_MAILBOX_STATS "Collect mailbox latency and throughput statistics" OFF)
+	if (TFM_MAILBOX_STATS)
+		add_definitions(-DTFM_MAILBOX_STATS)
+	endif()
+
+	set(TFM_MAILBOX_QUEUE_SLOTS "" CACHE STRING "Number of NSPE mailbox queue slots, the platform default if empty")
+	if (TFM_MAILBOX_QUEUE_SLOTS)
+		add_definitions(-DNUM_MAILBOX_QUEUE_SLOT=${TFM_MAILBOX_QUEUE_SLOTS})
+	endif()
+
+	option(TFM_MULTI_NS_MAILBOX "Serve the NSPE mailbox queues of several NS cores" OFF)
+	if (TFM_MULTI_NS_MAILBOX)
+		add_definitions(-DTFM_MULTI_NS_MAILBOX)
+	endif()
+
+	option(TFM_MAILBOX_SG "Carry scatter-gather client vectors in mailbox PSA calls" OFF)
+	if (TFM_MAILBOX_SG)
+		add_definitions(-DTFM_MAILBOX_SG)
+	endif()
+
+	option(TFM_MAILBOX_NS_WINDOWS "Let NS software register shared memory windows which SPE checks once" OFF)
+	if (TFM_MAILBOX_NS_WINDOWS)
+		add_definitions(-DTFM_MAILBOX_NS_WINDOWS)
+	endif()
+	option(TFM_MAILBOX_CACHE_MAINT "Align the mailbox to cache lines and call the platform cache maintenance hooks" OFF)
+	if (TFM_MAILBOX_CACHE_MAINT)
+		add_definitions(-DTFM_MAILBOX_CACHE_MAINT)
+	endif()
+	option(TFM_MAILBOX_POLL "Let the secure core poll NSPE mailbox queues before falling back to the doorbell interrupt" OFF)
+	if (TFM_MAILBOX_POLL)
+		add_definitions(-DTFM_MAILBOX_POLL)
+	endif()
+	option(TFM_MAILBOX_INLINE_REPLY "Return the output data of small PSA calls in the mailbox reply slot" OFF)
+	if (TFM_MAILBOX_INLINE_REPLY)
+		add_definitions(-DTFM_MAILBOX_INLINE_REPLY)
+	endif()
+endif()
+
+if (CORE_IPC)
+	option(TFM_MSG_QUEUE_PRIORITY "Deliver RoT Service messages in client priority order" OFF)
+	if (TFM_MSG_QUEUE_PRIORITY)
+		add_definitions(-DTFM_MSG_QUEUE_PRIORITY)
+	endif()
+
+	option(TFM_IPC_TRACE "Record cycle counts of the IPC path, for debug only" OFF)
+	if (TFM_IPC_TRACE)
+		add_definitions(-DTFM_IPC_TRACE)
+	endif()
+
+	option(TFM_MEM_CHECK_CACHE "Cache tfm_memory_check() decisions per partition" OFF)
+	if (TFM_MEM_CHECK_CACHE)
+		add_definitions(-DTFM_MEM_CHECK_CACHE)
+	endif()
+
+	option(TFM_STACK_WATERMARK "Paint the partition stacks to measure their maximum usage" OFF)
+	if (TFM_STACK_WATERMARK)
+		add_definitions(-DTFM_STACK_WATERMARK)
+	endif()
+
+	option(TFM_PSA_ASYNC_CALL "Let NS clients call RoT Services without waiting for the reply" OFF)
+	if (TFM_PSA_ASYNC_CALL)
+		if (DEFINED TFM_MULTI_CORE_TOPOLOGY AND TFM_MULTI_CORE_TOPOLOGY)
+			message(FATAL_ERROR "TFM_PSA_ASYNC_CALL is not supported in multi-core topology.")
+		endif()
+		add_definitions(-DTFM_PSA_ASYNC_CALL)
+	endif()
+
+	option(TFM_NS_CONCURRENT_CALLS "Let NS threads wait for RoT Service replies in the NS OS" OFF)
+	if (TFM_NS_CONCURRENT_CALLS)
+		if (NOT TFM_PSA_ASYNC_CALL)
+			message(FATAL_ERROR "TFM_NS_CONCURRENT_CALLS requires TFM_PSA_ASYNC_CALL.")
+		endif()
+		add_definitions(-DTFM_NS_CONCURRENT_CALLS)
+	endif()
+
+	option(TFM_HOT_CODE_IN_RAM "Execute the SPM functions of the IPC call path from RAM" OFF)
+	if (TFM_HOT_CODE_IN_RAM)
+		if (NOT TFM_LVL EQUAL 1)
+			message(FATAL_ERROR "TFM_HOT_CODE_IN_RAM is only supported with TFM_LVL 1, the secure RAM is execute never at the higher isolation levels.")
+		endif()
+		add_definitions(-DTFM_HOT_CODE_IN_RAM)
+	endif()
+
+	option(TFM_SFN_PARTITIONS "Let partitions declare their RoT Services as secure functions run on the thread of the client" OFF)
+	if (TFM_SFN_PARTITIONS)
+		if (NOT TFM_LVL EQUAL 1)
+			message(FATAL_ERROR "TFM_SFN_PARTITIONS is only supported with TFM_LVL 1, a secure function runs with the privilege and the stack of its client.")
+		endif()
+		if (DEFINED TFM_MULTI_CORE_TOPOLOGY AND TFM_MULTI_CORE_TOPOLOGY)
+			message(FATAL_ERROR "TFM_SFN_PARTITIONS is not supported in multi-core topology.")
+		endif()
+		add_definitions(-DTFM_SFN_PARTITIONS)
+	endif()
+
+	option(TFM_THRD_TIME_SLICE "Share the CPU between the secure threads of equal priority in SysTick quanta" OFF)
+	if (TFM_THRD_TIME_SLICE)
+		if (DEFINED TFM_MULTI_CORE_TOPOLOGY AND TFM_MULTI_CORE_TOPOLOGY)
+			message(FATAL_ERROR "TFM_THRD_TIME_SLICE is not supported in multi-core topology.")
+		endif()
+		add_definitions(-DTFM_THRD_TIME_SLICE)
+	endif()
+
+	option(TFM_SHM_CHANNELS "Let partitions declare shared memory channels to other partitions in their manifest" OFF)
+	if (TFM_SHM_CHANNELS)
+		add_definitions(-DTFM_SHM_CHANNELS)
+	endif()
+
+	option(TFM_DEFERRED_INIT "Let partitions declare in their manifest to be initialized on their first request, or in the background of the non-secure image" OFF)
+	if (TFM_DEFERRED_INIT)
+		add_definitions(-DTFM_DEFERRED_INIT)
+	endif()
+endif()
+
+option(TFM_HOT_DATA_IN_FAST_RAM "Place the SPM runtime data in the fast RAM region of the platform" OFF)
+if (TFM_HOT_DATA_IN_FAST_RAM)
+	if (NOT TFM_LVL EQUAL 1)
+		message(FATAL_ERROR "TFM_HOT_DATA_IN_FAST_RAM is only supported with TFM_LVL 1.")
+	endif()
+	add_definitions(-DTFM_HOT_DATA_IN_FAST_RAM)
+endif()
+
+#The spill area is carved out of the non-secure RAM by region_defs.h, so the
+#option is seen by the non-secure build as well
+option(CRYPTO_CONTEXT_SPILL "Seal the idle multi-part operation contexts of the Crypto service to the spill area of the platform when they run out" OFF)
+if (CRYPTO_CONTEXT_SPILL)
+	if (NOT TFM_LVL EQUAL 1)
+		message(FATAL_ERROR "CRYPTO_CONTEXT_SPILL is only supported with TFM_LVL 1, the Crypto partition can not access the spill area at the higher isolation levels.")
+	endif()
+	add_definitions(-DTFM_CRYPTO_CONTEXT_SPILL)
+endif()
+
+option(TFM_SFN_FAST_PATH "Call fast path secure functions of the library model on the SPM stack" OFF)
+if (TFM_SFN_FAST_PATH)
+	if (CORE_IPC OR NOT TFM_LVL EQUAL 1)
+		message(FATAL_ERROR "TFM_SFN_FAST_PATH is only supported in the library model with TFM_LVL 1.")
+	endif()
+	add_definitions(-DTFM_SFN_FAST_PATH)
+endif()
+
+option(TFM_SFN_TRUSTED_CALLS "Skip the iovec buffer checks of calls to the trusted callees of a partition" OFF)
+if (TFM_SFN_TRUSTED_CALLS)
+	if (CORE_IPC OR NOT TFM_LVL EQUAL 1)
+		message(FATAL_ERROR "TFM_SFN_TRUSTED_CALLS is only supported in the library model with TFM_LVL 1.")
+	endif()
+	add_definitions(-DTFM_SFN_TRUSTED_CALLS)
 endif()
 
 if (TFM_LEGACY_API)
@@ -305,6 +543,23 @@ if (TFM_PARTITION_INITIAL_ATTESTATION)
 	add_definitions(-DTFM_PARTITION_INITIAL_ATTESTATION)
 endif()
 
+if (TFM_PARTITION_FIRMWARE_UPDATE)
+	if (NOT CORE_IPC OR NOT BL2)
+		message(FATAL_ERROR "TFM_PARTITION_FIRMWARE_UPDATE needs the IPC model and BL2.")
+	endif()
+	if (${MCUBOOT_UPGRADE_STRATEGY} STREQUAL "NO_SWAP" OR ${MCUBOOT_UPGRADE_STRATEGY} STREQUAL "RAM_LOADING")
+		message(FATAL_ERROR "TFM_PARTITION_FIRMWARE_UPDATE needs an upgrade strategy which installs the image from the secondary slot.")
+	endif()
+	add_definitions(-DTFM_PARTITION_FIRMWARE_UPDATE)
+endif()
+
+if (TFM_PARTITION_TLS_RECORD)
+	if (NOT CORE_IPC)
+		message(FATAL_ERROR "TFM_PARTITION_TLS_RECORD needs the IPC model.")
+	endif()
+	add_definitions(-DTFM_PARTITION_TLS_RECORD)
+endif()
+
 if (TFM_PARTITION_TEST_CORE)
 	add_definitions(-DTFM_PARTITION_TEST_CORE)
 endif()
@@ -340,6 +595,15 @@ if (PSA_API_TEST)
 		set(PSA_API_TEST_IPC OFF)
 	endif()
 
+	#Time each secure call of the tests, and print a latency table at the end
+	option(PSA_API_TEST_TIMING "Print the latency of the secure calls made by the PSA API compliance tests" OFF)
+	if (PSA_API_TEST_TIMING)
+		if (DEFINED TFM_MULTI_CORE_TOPOLOGY AND TFM_MULTI_CORE_TOPOLOGY)
+			message(FATAL_ERROR "PSA_API_TEST_TIMING is not supported in multi-core topology.")
+		endif()
+		add_definitions(-DPSA_API_TEST_TIMING)
+	endif()
+
 	#Set PSA API compliance test build path
 	if(NOT DEFINED PSA_API_TEST_BUILD_PATH)
 		#If not specified, assume it's the default build folder checked out at the same level of TFM root dir
@@ -414,6 +678,50 @@ if (NOT DEFINED SST_RAM_FS)
 	endif()
 endif()
 
+if (NOT DEFINED SST_CHUNKED_OBJECTS)
+	set (SST_CHUNKED_OBJECTS OFF)
+endif()
+
+if (NOT DEFINED SST_NV_COUNTER_EPOCHS)
+	set (SST_NV_COUNTER_EPOCHS OFF)
+endif()
+
+if (NOT DEFINED SST_RESIDENT_STORAGE_KEY)
+	set (SST_RESIDENT_STORAGE_KEY OFF)
+endif()
+
+if (NOT DEFINED SST_CRYPTO_ALG)
+	set (SST_CRYPTO_ALG "AES_GCM")
+endif()
+
+if (NOT DEFINED SST_STREAMED_OBJECTS)
+	set (SST_STREAMED_OBJECTS OFF)
+endif()
+
+if (NOT DEFINED SST_OBJ_TABLE_INDEX)
+	set (SST_OBJ_TABLE_INDEX OFF)
+endif()
+
+if (NOT DEFINED SST_OBJ_TABLE_JOURNAL)
+	set (SST_OBJ_TABLE_JOURNAL OFF)
+endif()
+
+if (NOT DEFINED SST_OBJ_TABLE_SHARDS)
+	set (SST_OBJ_TABLE_SHARDS OFF)
+endif()
+
+if (NOT DEFINED SST_TRANSACTIONS)
+	set (SST_TRANSACTIONS OFF)
+endif()
+
+if (NOT DEFINED SST_OBJECT_CACHE)
+	set (SST_OBJECT_CACHE OFF)
+endif()
+
+if (NOT DEFINED SST_WRITE_BEHIND)
+	set (SST_WRITE_BEHIND OFF)
+endif()
+
 if (NOT DEFINED SST_TEST_NV_COUNTERS)
 	if (REGRESSION AND ENABLE_SECURE_STORAGE_SERVICE_TESTS)
 		set(SST_TEST_NV_COUNTERS ON)
@@ -438,6 +746,54 @@ if (NOT DEFINED ITS_VALIDATE_METADATA_FROM_FLASH)
 	set (ITS_VALIDATE_METADATA_FROM_FLASH ON)
 endif()
 
+if (NOT DEFINED ITS_RAM_FILE_INDEX)
+	set (ITS_RAM_FILE_INDEX OFF)
+endif()
+
+if (NOT DEFINED ITS_LOG_FS)
+	set (ITS_LOG_FS OFF)
+endif()
+
+if (NOT DEFINED ITS_IN_PLACE_APPEND)
+	set (ITS_IN_PLACE_APPEND OFF)
+endif()
+
+if (NOT DEFINED ITS_METADATA_CACHE)
+	set (ITS_METADATA_CACHE OFF)
+endif()
+
+if (NOT DEFINED ITS_WEAR_LEVELING)
+	set (ITS_WEAR_LEVELING OFF)
+endif()
+
+if (NOT DEFINED ITS_MOUNT_CHECKPOINT)
+	set (ITS_MOUNT_CHECKPOINT OFF)
+endif()
+
+if (NOT DEFINED ITS_DEFERRED_ERASE)
+	set (ITS_DEFERRED_ERASE OFF)
+endif()
+
+if (NOT DEFINED ITS_PACKED_METADATA)
+	set (ITS_PACKED_METADATA OFF)
+endif()
+
+if (NOT DEFINED ITS_HOT_TIER)
+	set (ITS_HOT_TIER OFF)
+endif()
+
+if (NOT DEFINED ITS_FLASH_READ_CACHE)
+	set (ITS_FLASH_READ_CACHE OFF)
+endif()
+
+if (NOT DEFINED ITS_FLASH_STATS)
+	if (ENABLE_STORAGE_BENCHMARK_TESTS)
+		set (ITS_FLASH_STATS ON)
+	else()
+		set (ITS_FLASH_STATS OFF)
+	endif()
+endif()
+
 if (NOT DEFINED ITS_RAM_FS)
 	if (REGRESSION)
 		set (ITS_RAM_FS ON)
@@ -450,6 +806,24 @@ if (NOT DEFINED MBEDCRYPTO_DEBUG)
 	set(MBEDCRYPTO_DEBUG OFF)
 endif()
 
+if (NOT DEFINED MBEDCRYPTO_PROFILE)
+	set(MBEDCRYPTO_PROFILE "SPEED")
+endif()
+
+#Default TF-M audit logging service flags.
+#Documentation about these flags can be found in docs/user_guides/services/tfm_audit_integration_guide.rst
+if (NOT DEFINED AUDIT_PERSISTENT_LOG)
+	set(AUDIT_PERSISTENT_LOG OFF)
+endif()
+
+if (NOT DEFINED AUDIT_ASYNC_ADD_RECORD)
+	set(AUDIT_ASYNC_ADD_RECORD OFF)
+endif()
+
+if (NOT DEFINED AUDIT_RECORD_FILTER)
+	set(AUDIT_RECORD_FILTER OFF)
+endif()
+
 #Default TF-M initial-attestation service flags.
 #Documentation about these flags can be found in docs/user_guides/services/tfm_attestation_integration_guide.rst
 if (NOT DEFINED ATTEST_INCLUDE_OPTIONAL_CLAIMS)
@@ -460,6 +834,18 @@ if (NOT DEFINED ATTEST_INCLUDE_COSE_KEY_ID)
 	set(ATTEST_INCLUDE_COSE_KEY_ID OFF)
 endif()
 
+if (NOT DEFINED ATTEST_BATCH_TOKEN)
+	set(ATTEST_BATCH_TOKEN OFF)
+endif()
+
+if (NOT DEFINED ATTEST_PROFILING)
+	set(ATTEST_PROFILING OFF)
+endif()
+
+if (NOT DEFINED ATTEST_TOKEN_MAC0)
+	set(ATTEST_TOKEN_MAC0 OFF)
+endif()
+
 if (NOT DEFINED ATTEST_INCLUDE_TEST_CODE)
 	if (CMAKE_BUILD_TYPE STREQUAL "debug")
 		set(ATTEST_INCLUDE_TEST_CODE ON)
@@ -480,8 +866,52 @@ if (NOT DEFINED BOOT_DATA_AVAILABLE)
 	endif()
 endif()
 
+option(TFM_BOOT_TIME "Record the boot stage timestamps of BL2 and of the secure image" OFF)
+if (TFM_BOOT_TIME)
+	if (NOT BOOT_DATA_AVAILABLE)
+		message(FATAL_ERROR "TFM_BOOT_TIME needs the BL2 shared data area, which is only available with the TF-M MCUBoot.")
+	endif()
+	add_definitions(-DTFM_BOOT_TIME)
+endif()
+
+option(TFM_SPM_STATS "Account the cycles spent by each partition and the time spent by each RoT Service" OFF)
+if (TFM_SPM_STATS)
+	add_definitions(-DTFM_SPM_STATS)
+endif()
+
+option(TFM_SPM_PROFILE "Sample the PC of the secure image from the secure SysTick" OFF)
+if (TFM_SPM_PROFILE)
+	if (TFM_THRD_TIME_SLICE)
+		message(FATAL_ERROR "TFM_SPM_PROFILE and TFM_THRD_TIME_SLICE both use the secure SysTick.")
+	endif()
+	add_definitions(-DTFM_SPM_PROFILE)
+endif()
+
+option(TFM_RESOURCE_USAGE "Report the current and peak use of the resource pools of the secure image" OFF)
+if (TFM_RESOURCE_USAGE)
+	add_definitions(-DTFM_RESOURCE_USAGE)
+endif()
+
+option(TFM_PERF_COUNTERS "Let clients count cycles and core events with the platform service" OFF)
+option(TFM_PERF_COUNTERS_NS "Let the non-secure clients use the performance counters too" OFF)
+if (TFM_PERF_COUNTERS)
+	add_definitions(-DTFM_PERF_COUNTERS)
+	if (TFM_PERF_COUNTERS_NS)
+		add_definitions(-DTFM_PERF_COUNTERS_NS)
+	endif()
+elseif (TFM_PERF_COUNTERS_NS)
+	message(FATAL_ERROR "TFM_PERF_COUNTERS_NS needs TFM_PERF_COUNTERS.")
+endif()
+
+option(TFM_NV_COUNTERS_LOG "Store the NV counters as a log of records in two flash sectors" OFF)
+
 ##Set mbedTLS compiler flags for BL2 bootloader
-set(MBEDCRYPTO_C_FLAGS_BL2 "-D__ARM_FEATURE_CMSE=${ARM_FEATURE_CMSE} -D__thumb2__ ${COMMON_COMPILE_FLAGS_STR} -DMBEDTLS_CONFIG_FILE=\\\\\\\"config-rsa.h\\\\\\\" -I${CMAKE_CURRENT_LIST_DIR}/bl2/ext/mcuboot/include")
+set(MBEDCRYPTO_C_FLAGS_BL2 "-D__ARM_FEATURE_CMSE=${ARM_FEATURE_CMSE} -D__thumb2__ ${COMMON_COMPILE_FLAGS_STR} -DMBEDTLS_CONFIG_FILE=\\\\\\\"config-rsa.h\\\\\\\" -I${CMAKE_CURRENT_LIST_DIR}/bl2/ext/mcuboot/include -I${CMAKE_CURRENT_LIST_DIR}/platform/ext/common")
 if (MCUBOOT_SIGNATURE_TYPE STREQUAL "RSA-3072")
 	string(APPEND MBEDCRYPTO_C_FLAGS_BL2 " -DMCUBOOT_SIGN_RSA_LEN=3072")
+elseif (MCUBOOT_SIGNATURE_TYPE STREQUAL "EC-P256")
+	string(APPEND MBEDCRYPTO_C_FLAGS_BL2 " -DMCUBOOT_SIGN_EC256")
+endif()
+if (MCUBOOT_ENC_IMAGES)
+	string(APPEND MBEDCRYPTO_C_FLAGS_BL2 " -DMCUBOOT_ENC_IMAGES")
 endif()
@@ -24,8 +24,16 @@ void psa_api_test(void *arg)
     tfm_nspm_register_client_id();
 #endif /* TFM_NS_CLIENT_IDENTIFICATION */
 
+#ifdef PSA_API_TEST_TIMING
+    psa_api_test_timing_init();
+#endif
+
     val_entry();
 
+#ifdef PSA_API_TEST_TIMING
+    psa_api_test_timing_report();
+#endif
+
     for (;;) {
     }
 }
@@ -8,6 +8,9 @@
 #ifndef __PSA_API_TEST_H__
 #define __PSA_API_TEST_H__
 
+#include <stdint.h>
+#include "tfm_ns_interface.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -18,6 +21,39 @@ extern "C" {
  */
 void psa_api_test(void *arg);
 
+#ifdef PSA_API_TEST_TIMING
+/**
+ * \brief Enables the cycle counter used to time the secure calls
+ */
+void psa_api_test_timing_init(void);
+
+/**
+ * \brief Reads the cycle counter before a secure call
+ *
+ * \return The cycle counter value, to pass to
+ *         \ref psa_api_test_timing_record
+ */
+uint32_t psa_api_test_timing_start(void);
+
+/**
+ * \brief Adds a secure call to the latency table
+ *
+ * \param[in] fn     Veneer called
+ * \param[in] arg0   Argument 0 of the veneer
+ * \param[in] arg1   Argument 1 of the veneer
+ * \param[in] arg2   Argument 2 of the veneer
+ * \param[in] result Value returned by the veneer
+ * \param[in] start  Value returned by \ref psa_api_test_timing_start
+ */
+void psa_api_test_timing_record(veneer_fn fn, uint32_t arg0, uint32_t arg1,
+                                uint32_t arg2, int32_t result, uint32_t start);
+
+/**
+ * \brief Prints the latency table of the secure calls made so far
+ */
+void psa_api_test_timing_report(void);
+#endif /* PSA_API_TEST_TIMING */
+
 #ifdef __cplusplus
 }
 #endif
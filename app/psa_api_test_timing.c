@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include "psa_api_test.h"
+#include "tfm_api.h"
+#include "test/framework/test_framework.h"
+#ifdef TFM_PSA_API
+#include "psa/client.h"
+#include "psa_manifest/sid.h"
+#include "tfm_crypto_defs.h"
+#endif
+
+/* Number of (veneer, SID, function) entries of the latency table */
+#ifndef PSA_API_TEST_TIMING_ENTRIES
+#define PSA_API_TEST_TIMING_ENTRIES 64
+#endif
+
+/* Number of connections whose SID is remembered at the same time */
+#ifndef PSA_API_TEST_TIMING_CONNECTIONS
+#define PSA_API_TEST_TIMING_CONNECTIONS 8
+#endif
+
+/* Each line of the latency table has the following comma separated fields:
+ *  - the LATENCY tag, to pick the lines out of the test log
+ *  - the PSA client API in the IPC model, or the address of the veneer in
+ *    the library model
+ *  - the SID of the RoT Service called, 0 when there is none
+ *  - the function of a multiplexed service, the sfn_id of the crypto service,
+ *    0 otherwise
+ *  - the number of calls
+ *  - the minimum, the average and the maximum cycles per call
+ */
+#define LATENCY_HEADER "LATENCY,api,sid,function,calls,min,avg,max\r\n"
+
+/* Handle of a stateless service, see TFM_HANDLE_IS_STATELESS() of the SPM */
+#define STATELESS_HANDLE_INDICATOR  0x40000000U
+#define STATELESS_HANDLE_SID_MASK   0x00FFFFFFU
+
+struct latency_entry_t {
+    veneer_fn fn;           /*!< Veneer called */
+    uint32_t sid;           /*!< SID of the RoT Service */
+    uint32_t function;      /*!< Function of the RoT Service */
+    uint32_t calls;         /*!< Number of calls */
+    uint32_t min;           /*!< Minimum cycles per call */
+    uint32_t max;           /*!< Maximum cycles per call */
+    uint64_t total;         /*!< Total cycles of the calls */
+};
+
+static struct latency_entry_t latency_table[PSA_API_TEST_TIMING_ENTRIES];
+static uint32_t latency_entries;
+static uint32_t latency_dropped;
+
+#ifdef TFM_PSA_API
+struct connection_t {
+    psa_handle_t handle;    /*!< Handle returned by psa_connect() */
+    uint32_t sid;           /*!< SID connected to */
+};
+
+static struct connection_t connections[PSA_API_TEST_TIMING_CONNECTIONS];
+#endif
+
+#ifdef TFM_PSA_API
+static struct connection_t *connection_find(psa_handle_t handle)
+{
+    uint32_t i;
+
+    for (i = 0; i < PSA_API_TEST_TIMING_CONNECTIONS; i++) {
+        if (connections[i].handle == handle) {
+            return &connections[i];
+        }
+    }
+
+    return NULL;
+}
+
+static uint32_t handle_to_sid(psa_handle_t handle)
+{
+    struct connection_t *conn;
+
+    if (((uint32_t)handle & STATELESS_HANDLE_INDICATOR) != 0) {
+        return (uint32_t)handle & STATELESS_HANDLE_SID_MASK;
+    }
+
+    conn = connection_find(handle);
+
+    return conn ? conn->sid : 0;
+}
+
+/**
+ * \brief Finds the SID and the function of a PSA client API call, and keeps
+ *        track of the connections made and closed.
+ */
+static void psa_call_identify(veneer_fn fn, uint32_t arg0, uint32_t arg1,
+                              uint32_t arg2, int32_t result,
+                              uint32_t *sid, uint32_t *function)
+{
+    const struct tfm_control_parameter_t *ctrl_param;
+    const psa_invec *in_vec;
+    const struct tfm_crypto_pack_iovec *iov;
+    struct connection_t *conn;
+
+    if (fn == (veneer_fn)tfm_psa_call_veneer) {
+        *sid = handle_to_sid((psa_handle_t)arg0);
+        ctrl_param = (const struct tfm_control_parameter_t *)arg1;
+        in_vec = (const psa_invec *)arg2;
+        if ((*sid == TFM_CRYPTO_SID || *sid == TFM_CRYPTO_ASYM_SID) &&
+            ctrl_param->in_len > 0 &&
+            in_vec[0].len >= sizeof(struct tfm_crypto_pack_iovec)) {
+            iov = (const struct tfm_crypto_pack_iovec *)in_vec[0].base;
+            *function = iov->sfn_id;
+        }
+    } else if (fn == (veneer_fn)tfm_psa_connect_veneer) {
+        *sid = arg0;
+        if (result > 0) {
+            conn = connection_find(0);
+            if (conn) {
+                conn->handle = (psa_handle_t)result;
+                conn->sid = arg0;
+            }
+        }
+    } else if (fn == (veneer_fn)tfm_psa_close_veneer) {
+        conn = connection_find((psa_handle_t)arg0);
+        if (conn) {
+            *sid = conn->sid;
+            conn->handle = 0;
+        }
+    } else if (fn == (veneer_fn)tfm_psa_version_veneer) {
+        *sid = arg0;
+    }
+}
+
+static const char *psa_api_name(veneer_fn fn)
+{
+    if (fn == (veneer_fn)tfm_psa_call_veneer) {
+        return "psa_call";
+    } else if (fn == (veneer_fn)tfm_psa_connect_veneer) {
+        return "psa_connect";
+    } else if (fn == (veneer_fn)tfm_psa_close_veneer) {
+        return "psa_close";
+    } else if (fn == (veneer_fn)tfm_psa_version_veneer) {
+        return "psa_version";
+    } else if (fn == (veneer_fn)tfm_psa_framework_version_veneer) {
+        return "psa_framework_version";
+    }
+
+    return NULL;
+}
+#endif /* TFM_PSA_API */
+
+uint32_t psa_api_test_timing_start(void)
+{
+    return test_timer_read();
+}
+
+void psa_api_test_timing_record(veneer_fn fn, uint32_t arg0, uint32_t arg1,
+                                uint32_t arg2, int32_t result, uint32_t start)
+{
+    uint32_t cycles = test_timer_read() - start;
+    uint32_t sid = 0;
+    uint32_t function = 0;
+    struct latency_entry_t *entry = NULL;
+    uint32_t i;
+
+#ifdef TFM_PSA_API
+    psa_call_identify(fn, arg0, arg1, arg2, result, &sid, &function);
+#else
+    (void)arg0;
+    (void)arg1;
+    (void)arg2;
+    (void)result;
+#endif
+
+    for (i = 0; i < latency_entries; i++) {
+        if (latency_table[i].fn == fn && latency_table[i].sid == sid &&
+            latency_table[i].function == function) {
+            entry = &latency_table[i];
+            break;
+        }
+    }
+
+    if (!entry) {
+        if (latency_entries == PSA_API_TEST_TIMING_ENTRIES) {
+            latency_dropped++;
+            return;
+        }
+        entry = &latency_table[latency_entries++];
+        entry->fn = fn;
+        entry->sid = sid;
+        entry->function = function;
+        entry->min = UINT32_MAX;
+    }
+
+    entry->calls++;
+    entry->total += cycles;
+    if (cycles < entry->min) {
+        entry->min = cycles;
+    }
+    if (cycles > entry->max) {
+        entry->max = cycles;
+    }
+}
+
+void psa_api_test_timing_init(void)
+{
+    if (test_timer_start() != 0) {
+        printf("No cycle counter, the PSA API calls are not timed.\r\n");
+    }
+}
+
+void psa_api_test_timing_report(void)
+{
+    const struct latency_entry_t *entry;
+    uint32_t i;
+#ifdef TFM_PSA_API
+    const char *name;
+#endif
+
+    printf(LATENCY_HEADER);
+    for (i = 0; i < latency_entries; i++) {
+        entry = &latency_table[i];
+#ifdef TFM_PSA_API
+        name = psa_api_name(entry->fn);
+        if (name) {
+            printf("LATENCY,%s", name);
+        } else
+#endif
+        {
+            printf("LATENCY,0x%08x", (unsigned int)(uintptr_t)entry->fn);
+        }
+        printf(",0x%08x,%u,%u,%u,%u,%u\r\n",
+               (unsigned int)entry->sid, (unsigned int)entry->function,
+               (unsigned int)entry->calls, (unsigned int)entry->min,
+               (unsigned int)(entry->total / entry->calls),
+               (unsigned int)entry->max);
+    }
+
+    if (latency_dropped) {
+        printf("%u calls not timed, the latency table is full.\r\n",
+               (unsigned int)latency_dropped);
+    }
+}
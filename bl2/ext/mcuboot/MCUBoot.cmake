@@ -55,6 +55,10 @@ function(mcuboot_create_boot_payload)
 		set(KEY_FILE    "${MCUBOOT_DIR}/root-rsa-2048.pem")
 		set(KEY_FILE_S  "${MCUBOOT_DIR}/root-rsa-2048.pem")
 		set(KEY_FILE_NS "${MCUBOOT_DIR}/root-rsa-2048_1.pem")
+	elseif(MCUBOOT_SIGNATURE_TYPE STREQUAL "EC-P256")
+		set(KEY_FILE    "${MCUBOOT_DIR}/root-ec-p256.pem")
+		set(KEY_FILE_S  "${MCUBOOT_DIR}/root-ec-p256.pem")
+		set(KEY_FILE_NS "${MCUBOOT_DIR}/root-ec-p256_1.pem")
 	else()
 		message(FATAL_ERROR "${MCUBOOT_SIGNATURE_TYPE} is not supported as firmware signing algorithm")
 	endif()
@@ -330,7 +334,7 @@ function(mcuboot_override_upgrade_strategy strategy)
 		#Set the default upgrade strategy if the CACHE variable has not been set yet.
 		set(MCUBOOT_UPGRADE_STRATEGY "OVERWRITE_ONLY" CACHE STRING "Configure BL2 which upgrade strategy to use")
 		if (MCUBOOT_REPO STREQUAL "TF-M")
-			set_property(CACHE MCUBOOT_UPGRADE_STRATEGY PROPERTY STRINGS "OVERWRITE_ONLY;SWAP;NO_SWAP;RAM_LOADING")
+			set_property(CACHE MCUBOOT_UPGRADE_STRATEGY PROPERTY STRINGS "OVERWRITE_ONLY;SWAP;SWAP_USING_MOVE;NO_SWAP;RAM_LOADING")
 		else()
 			set_property(CACHE MCUBOOT_UPGRADE_STRATEGY PROPERTY STRINGS "OVERWRITE_ONLY;SWAP")
 		endif()
@@ -22,11 +22,11 @@ if (BL2)
 	validate_cache_value(MCUBOOT_IMAGE_NUMBER STRINGS)
 
 	set(MCUBOOT_UPGRADE_STRATEGY "OVERWRITE_ONLY" CACHE STRING "Configure BL2 which upgrade strategy to use")
-	set_property(CACHE MCUBOOT_UPGRADE_STRATEGY PROPERTY STRINGS "OVERWRITE_ONLY;SWAP;NO_SWAP;RAM_LOADING")
+	set_property(CACHE MCUBOOT_UPGRADE_STRATEGY PROPERTY STRINGS "OVERWRITE_ONLY;SWAP;SWAP_USING_MOVE;NO_SWAP;RAM_LOADING")
 	validate_cache_value(MCUBOOT_UPGRADE_STRATEGY)
 
 	set(MCUBOOT_SIGNATURE_TYPE "RSA-3072" CACHE STRING "Algorithm used by MCUBoot to validate signatures.")
-	set_property(CACHE MCUBOOT_SIGNATURE_TYPE PROPERTY STRINGS "RSA-3072;RSA-2048")
+	set_property(CACHE MCUBOOT_SIGNATURE_TYPE PROPERTY STRINGS "RSA-3072;RSA-2048;EC-P256")
 	validate_cache_value(MCUBOOT_SIGNATURE_TYPE)
 
 	if (MCUBOOT_REPO STREQUAL "TF-M")
@@ -46,6 +46,22 @@ if (BL2)
 	endif()
 	validate_cache_value(MCUBOOT_LOG_LEVEL)
 
+	set(MCUBOOT_HASH_BUF_SIZE "1024" CACHE STRING "Configure the size in bytes of the buffer the images are read through to be hashed.")
+	set(MCUBOOT_HASH_XIP Off CACHE BOOL "Configure MCUBoot to hash the images in place. All the image flash areas must be memory mapped.")
+
+	set(MCUBOOT_COPY_BUF_SIZE "1024" CACHE STRING "Configure the size in bytes of the buffer the images are copied through between the slots.")
+	set(MCUBOOT_OVERWRITE_ONLY_FAST Off CACHE BOOL "Configure MCUBoot to only erase and copy the sectors which hold the new image with the OVERWRITE_ONLY upgrade strategy.")
+
+	set(MCUBOOT_UNIFORM_SECTORS Off CACHE BOOL "Configure MCUBoot to derive the sector layout of the image areas from FLASH_AREA_IMAGE_SECTOR_SIZE at compile time.")
+	set(MCUBOOT_VALIDATION_CACHE Off CACHE BOOL "Configure MCUBoot to skip the full validation of an unchanged image in the primary slot.")
+	set(MCUBOOT_VALIDATION_CACHE_MAX_SKIP "16" CACHE STRING "Configure the number of boots after which an unchanged image is fully validated again.")
+	set(MCUBOOT_WARM_BOOT_CACHE Off CACHE BOOL "Configure MCUBoot to boot the image of the previous boot after a warm reset without running the boot sequence.")
+
+	set(MCUBOOT_DELTA_UPDATE Off CACHE BOOL "Configure MCUBoot to accept delta images, which hold the changes from the image in the primary slot, in the secondary slot.")
+	set(MCUBOOT_COMPRESSED_IMAGES Off CACHE BOOL "Configure MCUBoot to accept compressed images, which are decompressed to the primary slot or to RAM.")
+	set(MCUBOOT_NO_SWAP_REVERT Off CACHE BOOL "Configure MCUBoot to revert an image booted in test mode with the NO_SWAP upgrade strategy if it is not confirmed before the next reset.")
+	set(MCUBOOT_ENC_IMAGES Off CACHE BOOL "Configure MCUBoot to accept images encrypted with AES-128-CTR in the secondary slot, which are decrypted while they are installed.")
+
 	if ((${MCUBOOT_UPGRADE_STRATEGY} STREQUAL "NO_SWAP" OR
 		 ${MCUBOOT_UPGRADE_STRATEGY} STREQUAL "RAM_LOADING") AND
 		NOT (MCUBOOT_IMAGE_NUMBER EQUAL 1))
@@ -57,6 +73,7 @@ if (BL2)
 	if (MCUBOOT_REPO STREQUAL "UPSTREAM")
 		set_property(CACHE MCUBOOT_UPGRADE_STRATEGY PROPERTY STRINGS "OVERWRITE_ONLY;SWAP")
 		if (${MCUBOOT_UPGRADE_STRATEGY} STREQUAL "NO_SWAP" OR
+			${MCUBOOT_UPGRADE_STRATEGY} STREQUAL "SWAP_USING_MOVE" OR
 			${MCUBOOT_UPGRADE_STRATEGY} STREQUAL "RAM_LOADING")
 			message(WARNING "The ${MCUBOOT_UPGRADE_STRATEGY} upgrade strategy cannot be used when building against"
 				" upstream MCUBoot. Your choice was overriden.")
@@ -26,8 +26,12 @@
 #include "bootutil/bootutil.h"
 #include "flash_map_backend/flash_map_backend.h"
 #include "boot_record.h"
+#include "boot_time.h"
 #include "security_cnt.h"
 #include "boot_hal.h"
+#ifdef MCUBOOT_WARM_BOOT_CACHE
+#include "warm_boot.h"
+#endif
 #if MCUBOOT_LOG_LEVEL > MCUBOOT_LOG_LEVEL_OFF
 #include "uart_stdout.h"
 #endif
@@ -166,12 +170,16 @@ int main(void)
     __set_MSPLIM(msp_stack_bottom);
 #endif
 
+    BOOT_TIME_RECORD(TFM_BOOT_TIME_BL2_START);
+
     /* Perform platform specific initialization */
     if (boot_platform_init() != 0) {
         while (1)
             ;
     }
 
+    BOOT_TIME_RECORD(TFM_BOOT_TIME_BL2_PLATFORM_INIT);
+
 #if MCUBOOT_LOG_LEVEL > MCUBOOT_LOG_LEVEL_OFF
     stdio_init();
 #endif
@@ -200,7 +208,23 @@ int main(void)
     }
 #endif /* !MCUBOOT_USE_UPSTREAM */
 
+#ifdef MCUBOOT_WARM_BOOT_CACHE
+    /* After a warm reset the image of the previous boot is booted without
+     * running the boot sequence, if nothing has changed since.
+     */
+    rc = boot_warm_boot_load(&rsp);
+    if (rc == 0) {
+        BOOT_LOG_INF("Warm reset, booting the image of the previous boot");
+    } else {
+        rc = boot_go(&rsp);
+        if (rc == 0) {
+            /* A missing record only slows down the next warm reset */
+            (void)boot_warm_boot_save(&rsp);
+        }
+    }
+#else
     rc = boot_go(&rsp);
+#endif /* MCUBOOT_WARM_BOOT_CACHE */
     if (rc != 0) {
         BOOT_LOG_ERR("Unable to find bootable image");
         while (1)
@@ -236,6 +260,9 @@ int main(void)
     BOOT_LOG_INF("Bootloader chainload address offset: 0x%x",
                  rsp.br_image_off);
     BOOT_LOG_INF("Jumping to the first image slot");
+#ifdef TFM_BOOT_TIME
+    boot_time_save();
+#endif
     do_boot(&rsp);
 
     BOOT_LOG_ERR("Never should get here");
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef H_BOOTUTIL_ENC_KEY_
+#define H_BOOTUTIL_ENC_KEY_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "flash_map/flash_map.h"
+#include "bootutil/image.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * The body of an encrypted image is encrypted with AES-128 in CTR mode, with
+ * a random key and a counter starting from zero. The key is wrapped with the
+ * key encryption key of the device (RFC 3394) in the IMAGE_TLV_ENC_KW128 TLV.
+ * The image header, the TLVs and the image hash are not encrypted.
+ */
+#define BOOT_ENC_KEY_SIZE       16
+#define BOOT_ENC_TLV_SIZE       (BOOT_ENC_KEY_SIZE + 8)
+
+/*
+ * The encryption data of an image, saved in the image trailer when a swap
+ * starts. Both images are partially swapped when the swap is interrupted, so
+ * the data cannot be read from the images when it is resumed.
+ */
+struct boot_enc_rec {
+    uint8_t  enc_tlv[BOOT_ENC_TLV_SIZE]; /* Wrapped key of the image */
+    uint32_t body_off;                   /* Offset of the encrypted body */
+    uint32_t body_size;                  /* Size of the encrypted body */
+};
+
+#define BOOT_ENC_REC_SIZE       (sizeof(struct boot_enc_rec))
+
+/**
+ * Reads the encryption data of an image.
+ *
+ * @param hdr                   The header of the image.
+ * @param fap                   The flash area which holds the image.
+ * @param rec                   The encryption data of the image.
+ *
+ * @return                      0 on success; 1 if the image is not
+ *                                  encrypted; negative on failure.
+ */
+int boot_enc_read_rec(const struct image_header *hdr,
+                      const struct flash_area *fap, struct boot_enc_rec *rec);
+
+/**
+ * Unwraps the key of an image and makes it the key of a slot.
+ *
+ * @param image_index           The index of the image.
+ * @param slot                  The slot which holds the encrypted image.
+ * @param rec                   The encryption data of the image.
+ *
+ * @return                      0 on success; nonzero on failure.
+ */
+int boot_enc_set_key(int image_index, int slot, const struct boot_enc_rec *rec);
+
+/**
+ * Reads the encryption data of the image in a slot, and makes its key the key
+ * of the slot.
+ *
+ * @param image_index           The index of the image.
+ * @param slot                  The slot which holds the image.
+ * @param hdr                   The header of the image.
+ * @param fap                   The flash area of the slot.
+ *
+ * @return                      0 on success; 1 if the image is not
+ *                                  encrypted; negative on failure.
+ */
+int boot_enc_load(int image_index, int slot, const struct image_header *hdr,
+                  const struct flash_area *fap);
+
+/**
+ * Forgets the key of a slot.
+ */
+void boot_enc_clear(int image_index, int slot);
+
+/**
+ * Returns true if a slot has a key, so its image is encrypted.
+ */
+bool boot_enc_valid(int image_index, int slot);
+
+/**
+ * Encrypts or decrypts a buffer read from a slot, or written to a slot. Only
+ * the bytes which belong to the encrypted body of the image are changed, and
+ * none if the slot has no key.
+ *
+ * @param image_index           The index of the image.
+ * @param slot                  The slot whose key is used.
+ * @param off                   The offset of the buffer in the slot.
+ * @param buf                   The buffer, which is changed in place.
+ * @param sz                    The size of the buffer.
+ *
+ * @return                      0 on success; nonzero on failure.
+ */
+int boot_enc_crypt(int image_index, int slot, uint32_t off, uint8_t *buf,
+                   uint32_t sz);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* H_BOOTUTIL_ENC_KEY_ */
@@ -48,6 +48,7 @@ struct flash_area;
  * Image header flags.
  */
 #define IMAGE_F_PIC                      0x00000001 /* Not supported. */
+#define IMAGE_F_ENCRYPTED                0x00000004 /* Encrypted body. */
 #define IMAGE_F_NON_BOOTABLE             0x00000010 /* Split image app. */
 /*
  * Indicates that this image should be loaded into RAM instead of run
@@ -55,6 +56,11 @@ struct flash_area;
  * ih_load_addr field of the header.
  */
 #define IMAGE_F_RAM_LOAD                 0x00000020
+/*
+ * Indicates that the body of this image is a compressed image, which has to be
+ * decompressed to the primary slot or to RAM before it is run.
+ */
+#define IMAGE_F_COMPRESSED               0x00000040
 
 /*
  * Image trailer TLV types.
@@ -70,7 +76,9 @@ struct flash_area;
 #define IMAGE_TLV_KEY               0x02   /* public key */
 #define IMAGE_TLV_SHA256            0x10   /* SHA256 of image hdr and body */
 #define IMAGE_TLV_RSA2048_PSS       0x20   /* RSA2048 of hash output */
+#define IMAGE_TLV_ECDSA256          0x22   /* ECDSA of hash output */
 #define IMAGE_TLV_RSA3072_PSS       0x23   /* RSA3072 of hash output */
+#define IMAGE_TLV_ENC_KW128         0x31   /* Key encrypted with AES-KW-128 */
 #define IMAGE_TLV_DEPENDENCY        0x40   /* Image depends on other image */
 #define IMAGE_TLV_SEC_CNT           0x50   /* security counter */
 #define IMAGE_TLV_BOOT_RECORD       0x60   /* measured boot record */
@@ -126,6 +134,25 @@ struct image_tlv {
 _Static_assert(sizeof(struct image_header) == IMAGE_HEADER_SIZE,
                "struct image_header not required size");
 
+/** Size of the largest measured boot record TLV */
+#define IMAGE_BOOT_RECORD_MAX_SIZE  96
+
+/**
+ * Manifest data of an image, collected from its TLV area while the image is
+ * validated, so that the boot record and the security counter update do not
+ * read it again from flash.
+ */
+struct image_manifest {
+    uint8_t fa_id;              /* Flash area the image was validated in */
+    uint8_t valid;              /* Nonzero once the image is validated */
+    uint8_t signer_id_valid;    /* Nonzero if the signer ID was found */
+    uint8_t boot_record_len;    /* 0 if there is no boot record TLV */
+    uint32_t security_cnt;      /* Security counter TLV */
+    uint8_t image_hash[32];     /* SHA256 TLV */
+    uint8_t signer_id[32];      /* SHA256 of the public key */
+    uint8_t boot_record[IMAGE_BOOT_RECORD_MAX_SIZE]; /* Boot record TLV */
+};
+
 int bootutil_img_validate(int image_index,
                           struct image_header *hdr,
                           const struct flash_area *fap,
@@ -153,6 +180,30 @@ int32_t bootutil_get_img_security_cnt(struct image_header *hdr,
                                       const struct flash_area *fap,
                                       uint32_t *security_cnt);
 
+/**
+ * Returns the manifest data collected by the last successful validation of
+ * the image in a flash area, or NULL if the image was not validated or was
+ * changed since then.
+ */
+const struct image_manifest *
+bootutil_get_img_manifest(const struct flash_area *fap);
+
+/**
+ * Drops the manifest data of an image, before its slots are written.
+ */
+void bootutil_clear_img_manifest(int image_index);
+
+#ifdef MCUBOOT_RAM_LOADING
+/**
+ * Hands over the digest of an image computed while it was copied to its load
+ * address, so that the next validation of the image doesn't read the SRAM
+ * copy again. Passing a NULL hash drops the digest.
+ */
+void bootutil_set_img_ram_hash(int image_index,
+                               const struct image_header *hdr,
+                               const uint8_t *hash);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
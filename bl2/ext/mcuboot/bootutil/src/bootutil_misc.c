@@ -180,6 +180,10 @@ boot_trailer_sz(uint32_t min_write_sz)
            BOOT_STATUS_MAX_ENTRIES * BOOT_STATUS_STATE_COUNT * min_write_sz +
            /* swap_type + copy_done + image_ok + swap_size */
            BOOT_MAX_ALIGN * 4 +
+#ifdef MCUBOOT_ENC_IMAGES
+           /* encryption data of both slots */
+           BOOT_ENC_REC_SIZE * BOOT_NUM_SLOTS +
+#endif
            BOOT_MAGIC_SZ;
 }
 
@@ -239,6 +243,20 @@ boot_swap_size_off(const struct flash_area *fap)
     return boot_swap_info_off(fap) - BOOT_MAX_ALIGN;
 }
 
+#ifdef MCUBOOT_ENC_IMAGES
+/* The records are written in one go, so they only need to keep the trailer
+ * fields before them aligned.
+ */
+_Static_assert(BOOT_ENC_REC_SIZE % BOOT_MAX_ALIGN == 0,
+               "Encryption data must be a multiple of BOOT_MAX_ALIGN");
+
+static inline uint32_t
+boot_enc_rec_off(const struct flash_area *fap, uint8_t slot)
+{
+    return boot_swap_size_off(fap) - (slot + 1) * BOOT_ENC_REC_SIZE;
+}
+#endif
+
 int
 boot_read_swap_state(const struct flash_area *fap,
                      struct boot_swap_state *state)
@@ -390,6 +408,32 @@ boot_read_swap_size(int image_index, uint32_t *swap_size)
     return rc;
 }
 
+#ifdef MCUBOOT_ENC_IMAGES
+/**
+ * Reads the encryption data of a slot saved in a trailer.
+ *
+ * @returns 0 on success, the record is zeroed if the slot is not encrypted;
+ *          != 0 on error.
+ */
+int
+boot_read_enc_rec(const struct flash_area *fap, uint8_t slot,
+                  struct boot_enc_rec *rec)
+{
+    int rc;
+
+    rc = flash_area_read_is_empty(fap, boot_enc_rec_off(fap, slot), rec,
+                                  BOOT_ENC_REC_SIZE);
+    if (rc < 0) {
+        return BOOT_EFLASH;
+    }
+    if (rc == 1) {
+        memset(rec, 0, BOOT_ENC_REC_SIZE);
+    }
+
+    return 0;
+}
+#endif
+
 int
 boot_write_magic(const struct flash_area *fap)
 {
@@ -507,6 +551,27 @@ boot_write_swap_size(const struct flash_area *fap, uint32_t swap_size)
     return boot_write_trailer(fap, off, (const uint8_t *) &swap_size, 4);
 }
 
+#ifdef MCUBOOT_ENC_IMAGES
+int
+boot_write_enc_rec(const struct flash_area *fap, uint8_t slot,
+                   const struct boot_enc_rec *rec)
+{
+    uint32_t off;
+    int rc;
+
+    off = boot_enc_rec_off(fap, slot);
+    BOOT_LOG_DBG("writing enc_rec; fa_id=%d off=0x%lx (0x%lx)",
+                 fap->fa_id, (unsigned long)off,
+                 (unsigned long)fap->fa_off + off);
+    rc = flash_area_write(fap, off, rec, BOOT_ENC_REC_SIZE);
+    if (rc != 0) {
+        return BOOT_EFLASH;
+    }
+
+    return 0;
+}
+#endif
+
 int
 boot_swap_type_multi(int image_index)
 {
@@ -32,6 +32,9 @@
 #include "bootutil/bootutil.h"
 #include "bootutil/image.h"
 #include "flash_layout.h"
+#ifdef MCUBOOT_ENC_IMAGES
+#include "bootutil/enc_key.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -57,6 +60,11 @@ struct flash_area;
 
 #define BOOT_TMPBUF_SZ  256
 
+/* Size of the buffer the images are copied through between the slots */
+#ifndef MCUBOOT_COPY_BUF_SIZE
+#define MCUBOOT_COPY_BUF_SIZE 1024
+#endif
+
 /*
  * Maintain state of copy progress.
  */
@@ -66,6 +74,16 @@ struct boot_status {
     uint8_t use_scratch;  /* Are status bytes ever written to scratch? */
     uint8_t swap_type;    /* The type of swap in effect */
     uint32_t swap_size;   /* Total size of swapped image */
+#ifdef MCUBOOT_SWAP_USING_MOVE
+    uint8_t op;           /* Are the sectors being moved or swapped? */
+    uint8_t source;       /* Where the status was read from */
+#endif
+#ifdef MCUBOOT_ENC_IMAGES
+    /* Encryption data of the images in the primary and the secondary slot,
+     * zeroed if the image is not encrypted.
+     */
+    struct boot_enc_rec enc[2];
+#endif
 };
 
 #define BOOT_MAGIC_GOOD     1
@@ -98,6 +116,10 @@ struct boot_status {
  *  ~    Swap status (BOOT_MAX_IMG_SECTORS * min-write-size * 3)    ~
  *  ~                                                               ~
  *  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ *  ~        Encryption data, secondary slot (32 octets) [*]        ~
+ *  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ *  ~         Encryption data, primary slot (32 octets) [*]         ~
+ *  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
  *  |                      Swap size (4 octets)                     |
  *  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
  *  |   Swap info   |           0xff padding (7 octets)             |
@@ -109,6 +131,8 @@ struct boot_status {
  *  |                       MAGIC (16 octets)                       |
  *  |                                                               |
  *  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ *
+ *  [*]: Only present with MCUBOOT_ENC_IMAGES, see struct boot_enc_rec.
  */
 
 extern const uint32_t boot_img_magic[4];
@@ -170,6 +194,17 @@ _Static_assert(BOOT_IMAGE_NUMBER > 0, "Invalid value for BOOT_IMAGE_NUMBER");
 #define BOOT_STATUS_STATE_COUNT         3
 #define BOOT_STATUS_MAX_ENTRIES         MCUBOOT_STATUS_MAX_ENTRIES
 
+#ifdef MCUBOOT_SWAP_USING_MOVE
+/* The status area holds the entries of the move operations, then the entries
+ * of the swap operations.
+ */
+#define BOOT_STATUS_OP_MOVE             1
+#define BOOT_STATUS_OP_SWAP             2
+
+#define BOOT_STATUS_MOVE_STATE_COUNT    1
+#define BOOT_STATUS_SWAP_STATE_COUNT    2
+#endif
+
 #define BOOT_PRIMARY_SLOT               0
 #define BOOT_SECONDARY_SLOT             1
 
@@ -236,6 +271,12 @@ int boot_write_swap_info(const struct flash_area *fap, uint8_t swap_type,
                          uint8_t image_num);
 int boot_write_swap_size(const struct flash_area *fap, uint32_t swap_size);
 int boot_read_swap_size(int image_index, uint32_t *swap_size);
+#ifdef MCUBOOT_ENC_IMAGES
+int boot_write_enc_rec(const struct flash_area *fap, uint8_t slot,
+                       const struct boot_enc_rec *rec);
+int boot_read_enc_rec(const struct flash_area *fap, uint8_t slot,
+                      struct boot_enc_rec *rec);
+#endif
 
 /**
  * Safe (non-overflowing) uint32_t addition.  Returns true, and stores
@@ -327,7 +368,34 @@ static inline size_t boot_scratch_area_size(struct boot_loader_state *state)
     return BOOT_SCRATCH_AREA(state)->fa_size;
 }
 
-#ifndef MCUBOOT_USE_FLASH_AREA_GET_SECTORS
+#if defined(MCUBOOT_UNIFORM_SECTORS)
+
+/*
+ * All the sectors of the image areas have the same size, the sector layout is
+ * known at compile time and is not stored in the boot state.
+ */
+static inline size_t
+boot_img_sector_size(const struct boot_loader_state *state,
+                     size_t slot, size_t sector)
+{
+    (void)state;
+    (void)slot;
+    (void)sector;
+
+    return FLASH_AREA_IMAGE_SECTOR_SIZE;
+}
+
+static inline uint32_t
+boot_img_sector_off(const struct boot_loader_state *state, size_t slot,
+                    size_t sector)
+{
+    (void)state;
+    (void)slot;
+
+    return (uint32_t)sector * FLASH_AREA_IMAGE_SECTOR_SIZE;
+}
+
+#elif !defined(MCUBOOT_USE_FLASH_AREA_GET_SECTORS)
 
 static inline size_t
 boot_img_sector_size(const struct boot_loader_state *state,
@@ -365,7 +433,7 @@ boot_img_sector_off(const struct boot_loader_state *state, size_t slot,
            BOOT_IMG(state, slot).sectors[0].fs_off;
 }
 
-#endif  /* !defined(MCUBOOT_USE_FLASH_AREA_GET_SECTORS) */
+#endif  /* MCUBOOT_UNIFORM_SECTORS */
 
 #ifdef MCUBOOT_RAM_LOADING
 #define LOAD_IMAGE_DATA(hdr, fap, start, output, size)       \
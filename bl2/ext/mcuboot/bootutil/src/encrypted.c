@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifdef MCUBOOT_ENC_IMAGES
+
+#include <stddef.h>
+#include <string.h>
+
+#include "bootutil/enc_key.h"
+#include "bootutil/image.h"
+#include "bootutil_priv.h"
+#include "flash_map_backend/flash_map_backend.h"
+#include "platform/include/tfm_plat_crypto_keys.h"
+
+#include "mbedtls/aes.h"
+#include "mbedtls/nist_kw.h"
+
+/* The key of a slot. The AES context is used with a hardware AES engine when
+ * the platform provides one through MBEDTLS_AES_ALT.
+ */
+struct boot_enc_key {
+    bool valid;
+    uint32_t body_off;
+    uint32_t body_size;
+    mbedtls_aes_context aes;
+};
+
+static struct boot_enc_key boot_enc_keys[BOOT_IMAGE_NUMBER][BOOT_NUM_SLOTS];
+
+static void
+boot_enc_zeroize(void *buf, size_t sz)
+{
+    volatile uint8_t *p = buf;
+
+    while (sz--) {
+        *p++ = 0;
+    }
+}
+
+int
+boot_enc_read_rec(const struct image_header *hdr,
+                  const struct flash_area *fap, struct boot_enc_rec *rec)
+{
+    struct image_tlv_iter it;
+    uint32_t off;
+    uint16_t len;
+    int rc;
+
+    if (!(hdr->ih_flags & IMAGE_F_ENCRYPTED)) {
+        return 1;
+    }
+
+    rc = bootutil_tlv_iter_begin(&it, hdr, fap, IMAGE_TLV_ENC_KW128, false);
+    if (rc) {
+        return -1;
+    }
+
+    rc = bootutil_tlv_iter_next(&it, &off, &len, NULL);
+    if (rc != 0 || len != sizeof(rec->enc_tlv)) {
+        return -1;
+    }
+
+    rc = flash_area_read(fap, off, rec->enc_tlv, len);
+    if (rc) {
+        return -1;
+    }
+
+    rec->body_off = hdr->ih_hdr_size;
+    rec->body_size = hdr->ih_img_size;
+
+    return 0;
+}
+
+int
+boot_enc_set_key(int image_index, int slot, const struct boot_enc_rec *rec)
+{
+    struct boot_enc_key *enc = &boot_enc_keys[image_index][slot];
+    mbedtls_nist_kw_context kw;
+    uint8_t kek[ENC_IMAGE_KEK_LEN];
+    uint8_t key[BOOT_ENC_KEY_SIZE];
+    uint32_t kek_size = sizeof(kek);
+    size_t key_size;
+    int rc;
+
+    boot_enc_clear(image_index, slot);
+
+    if (tfm_plat_get_enc_image_kek(image_index, kek, &kek_size) !=
+        TFM_PLAT_ERR_SUCCESS || kek_size != sizeof(kek)) {
+        return -1;
+    }
+
+    mbedtls_nist_kw_init(&kw);
+    rc = mbedtls_nist_kw_setkey(&kw, MBEDTLS_CIPHER_ID_AES, kek,
+                                kek_size * 8, 0);
+    if (rc == 0) {
+        rc = mbedtls_nist_kw_unwrap(&kw, MBEDTLS_KW_MODE_KW, rec->enc_tlv,
+                                    sizeof(rec->enc_tlv), key, &key_size,
+                                    sizeof(key));
+    }
+    mbedtls_nist_kw_free(&kw);
+    boot_enc_zeroize(kek, sizeof(kek));
+
+    if (rc == 0 && key_size == sizeof(key)) {
+        mbedtls_aes_init(&enc->aes);
+        rc = mbedtls_aes_setkey_enc(&enc->aes, key, sizeof(key) * 8);
+        if (rc == 0) {
+            enc->body_off = rec->body_off;
+            enc->body_size = rec->body_size;
+            enc->valid = true;
+        } else {
+            mbedtls_aes_free(&enc->aes);
+        }
+    } else {
+        rc = -1;
+    }
+    boot_enc_zeroize(key, sizeof(key));
+
+    return rc;
+}
+
+int
+boot_enc_load(int image_index, int slot, const struct image_header *hdr,
+              const struct flash_area *fap)
+{
+    struct boot_enc_rec rec;
+    int rc;
+
+    rc = boot_enc_read_rec(hdr, fap, &rec);
+    if (rc != 0) {
+        boot_enc_clear(image_index, slot);
+        return rc;
+    }
+
+    if (boot_enc_set_key(image_index, slot, &rec)) {
+        return -1;
+    }
+
+    return 0;
+}
+
+void
+boot_enc_clear(int image_index, int slot)
+{
+    struct boot_enc_key *enc = &boot_enc_keys[image_index][slot];
+
+    if (enc->valid) {
+        mbedtls_aes_free(&enc->aes);
+        boot_enc_zeroize(enc, sizeof(*enc));
+    }
+}
+
+bool
+boot_enc_valid(int image_index, int slot)
+{
+    return boot_enc_keys[image_index][slot].valid;
+}
+
+int
+boot_enc_crypt(int image_index, int slot, uint32_t off, uint8_t *buf,
+               uint32_t sz)
+{
+    struct boot_enc_key *enc = &boot_enc_keys[image_index][slot];
+    uint8_t nonce_counter[16];
+    uint8_t stream_block[16];
+    uint32_t body_end;
+    uint32_t pos;
+    uint32_t blk;
+    size_t nc_off;
+    int i;
+
+    if (!enc->valid) {
+        return 0;
+    }
+
+    /* Only the part of the buffer which overlaps the body is encrypted */
+    body_end = enc->body_off + enc->body_size;
+    if (off >= body_end || off + sz <= enc->body_off) {
+        return 0;
+    }
+    if (off < enc->body_off) {
+        buf += enc->body_off - off;
+        sz -= enc->body_off - off;
+        off = enc->body_off;
+    }
+    if (off + sz > body_end) {
+        sz = body_end - off;
+    }
+
+    /* The counter is the big-endian index of the AES block in the body */
+    pos = off - enc->body_off;
+    blk = pos / sizeof(nonce_counter);
+    memset(nonce_counter, 0, sizeof(nonce_counter));
+    for (i = sizeof(nonce_counter) - 1; i >= 0 && blk != 0; i--) {
+        nonce_counter[i] = (uint8_t)blk;
+        blk >>= 8;
+    }
+
+    nc_off = pos % sizeof(nonce_counter);
+    if (nc_off != 0) {
+        /* The buffer starts inside a block, generate its key stream and move
+         * to the next counter as mbedtls_aes_crypt_ctr() expects it.
+         */
+        if (mbedtls_aes_crypt_ecb(&enc->aes, MBEDTLS_AES_ENCRYPT,
+                                  nonce_counter, stream_block)) {
+            return -1;
+        }
+        for (i = sizeof(nonce_counter) - 1; i >= 0; i--) {
+            if (++nonce_counter[i] != 0) {
+                break;
+            }
+        }
+    }
+
+    if (mbedtls_aes_crypt_ctr(&enc->aes, sz, &nc_off, nonce_counter,
+                              stream_block, buf, buf)) {
+        return -1;
+    }
+
+    return 0;
+}
+
+#endif /* MCUBOOT_ENC_IMAGES */
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+
+#ifdef MCUBOOT_SIGN_EC256
+#include "bootutil/sign_key.h"
+
+#include "mbedtls/ecdsa.h"
+#include "mbedtls/asn1.h"
+#include "mbedtls/oid.h"
+
+#include "bootutil_priv.h"
+
+/*
+ * Parse the public key used for signing: an ASN.1 SubjectPublicKeyInfo of an
+ * uncompressed point on the NIST P-256 curve.
+ */
+static int
+bootutil_parse_eckey(mbedtls_ecdsa_context *ctx, uint8_t **p, uint8_t *end)
+{
+    mbedtls_asn1_buf alg;
+    mbedtls_asn1_buf param;
+    size_t len;
+
+    if (mbedtls_asn1_get_tag(p, end, &len,
+                     MBEDTLS_ASN1_CONSTRUCTED | MBEDTLS_ASN1_SEQUENCE)) {
+        return -1;
+    }
+    end = *p + len;
+
+    if (mbedtls_asn1_get_alg(p, end, &alg, &param)) {
+        return -2;
+    }
+    if (alg.len != sizeof(MBEDTLS_OID_EC_ALG_UNRESTRICTED) - 1 ||
+        memcmp(alg.p, MBEDTLS_OID_EC_ALG_UNRESTRICTED, alg.len)) {
+        return -3;
+    }
+    if (param.len != sizeof(MBEDTLS_OID_EC_GRP_SECP256R1) - 1 ||
+        memcmp(param.p, MBEDTLS_OID_EC_GRP_SECP256R1, param.len)) {
+        return -4;
+    }
+
+    if (mbedtls_ecp_group_load(&ctx->grp, MBEDTLS_ECP_DP_SECP256R1)) {
+        return -5;
+    }
+
+    if (mbedtls_asn1_get_bitstring_null(p, end, &len)) {
+        return -6;
+    }
+    if (*p + len != end) {
+        return -7;
+    }
+
+    if (mbedtls_ecp_point_read_binary(&ctx->grp, &ctx->Q, *p, len)) {
+        return -8;
+    }
+
+    if (mbedtls_ecp_check_pubkey(&ctx->grp, &ctx->Q)) {
+        return -9;
+    }
+    return 0;
+}
+
+int
+bootutil_verify_sig(uint8_t *hash, uint32_t hlen, uint8_t *sig, size_t slen,
+  uint8_t key_id)
+{
+    mbedtls_ecdsa_context ctx;
+    int rc;
+    uint8_t *cp;
+    uint8_t *end;
+
+    mbedtls_ecdsa_init(&ctx);
+
+    cp = (uint8_t *)bootutil_keys[key_id].key;
+    end = cp + *bootutil_keys[key_id].len;
+
+    rc = bootutil_parse_eckey(&ctx, &cp, end);
+    if (rc) {
+        mbedtls_ecdsa_free(&ctx);
+        return -1;
+    }
+
+    /* The signature is the ASN.1 sequence of the r and s integers */
+    rc = mbedtls_ecdsa_read_signature(&ctx, hash, hlen, sig, slen);
+    mbedtls_ecdsa_free(&ctx);
+
+    return rc;
+}
+#endif /* MCUBOOT_SIGN_EC256 */
@@ -30,6 +30,9 @@
 #include <string.h>
 
 #include "flash_map/flash_map.h"
+#ifdef MCUBOOT_HASH_XIP
+#include "flash_map_backend/flash_map_backend.h"
+#endif
 #include "bootutil/image.h"
 #include "bootutil/sha256.h"
 #include "bootutil/sign_key.h"
@@ -37,16 +40,87 @@
 
 #if defined(MCUBOOT_SIGN_RSA)
 #include "mbedtls/rsa.h"
+#elif defined(MCUBOOT_SIGN_EC256)
+#include "mbedtls/ecdsa.h"
 #endif
 
 #include "mbedtls/asn1.h"
 
 #include "bootutil_priv.h"
+#include "bl2/include/boot_time.h"
 
 #ifdef MCUBOOT_HW_KEY
 #include "platform/include/tfm_plat_crypto_keys.h"
 #endif
 
+#ifdef MCUBOOT_ENC_IMAGES
+#include "sysflash/sysflash.h"
+#include "bootutil/enc_key.h"
+#endif
+
+#if defined(MCUBOOT_HASH_BUF_SIZE) && !defined(MCUBOOT_RAM_LOADING) && \
+    !defined(MCUBOOT_HASH_XIP)
+/*
+ * Read buffer of the image hash, used instead of the buffer of the caller when
+ * it is larger to reduce the number of flash reads.
+ */
+static uint32_t hash_buf[(MCUBOOT_HASH_BUF_SIZE + 3) / 4];
+#endif
+
+#ifdef MCUBOOT_RAM_LOADING
+/*
+ * Digest of each RAM-loaded image, computed by the copy to its load address.
+ * It is only used once, by the next validation of the same image.
+ */
+static struct {
+    uint32_t load_addr;
+    uint32_t size;
+    uint8_t  hash[32];
+    uint8_t  valid;
+} bootutil_ram_hashes[BOOT_IMAGE_NUMBER];
+
+void
+bootutil_set_img_ram_hash(int image_index, const struct image_header *hdr,
+                          const uint8_t *hash)
+{
+    if (!hash) {
+        bootutil_ram_hashes[image_index].valid = 0;
+        return;
+    }
+
+    bootutil_ram_hashes[image_index].load_addr = hdr->ih_load_addr;
+    bootutil_ram_hashes[image_index].size = BOOT_TLV_OFF(hdr) +
+                                            hdr->ih_protect_tlv_size;
+    memcpy(bootutil_ram_hashes[image_index].hash, hash,
+           sizeof(bootutil_ram_hashes[image_index].hash));
+    bootutil_ram_hashes[image_index].valid = 1;
+}
+
+/*
+ * Take the digest computed by the copy to SRAM, if it covers the image
+ * described by hdr. Return 0 if it has been taken.
+ */
+static int
+bootutil_take_img_ram_hash(int image_index, const struct image_header *hdr,
+                           uint32_t size, uint8_t *hash_result)
+{
+    int valid = bootutil_ram_hashes[image_index].valid &&
+                (bootutil_ram_hashes[image_index].load_addr ==
+                 hdr->ih_load_addr) &&
+                (bootutil_ram_hashes[image_index].size == size);
+
+    bootutil_ram_hashes[image_index].valid = 0;
+    if (!valid) {
+        return -1;
+    }
+
+    memcpy(hash_result, bootutil_ram_hashes[image_index].hash,
+           sizeof(bootutil_ram_hashes[image_index].hash));
+
+    return 0;
+}
+#endif /* MCUBOOT_RAM_LOADING */
+
 /*
  * Compute SHA256 over the image.
  */
@@ -58,7 +132,10 @@ bootutil_img_hash(int image_index,
 {
     bootutil_sha256_context sha256_ctx;
     uint32_t size;
-#ifndef MCUBOOT_RAM_LOADING
+#if defined(MCUBOOT_HASH_XIP) && !defined(MCUBOOT_RAM_LOADING)
+    uintptr_t flash_base;
+    int rc;
+#elif !defined(MCUBOOT_RAM_LOADING) || defined(MCUBOOT_COMPRESSED_IMAGES)
     uint32_t blk_sz;
     uint32_t off;
     int rc;
@@ -66,6 +143,21 @@ bootutil_img_hash(int image_index,
 
     (void)image_index;
 
+    /* Hash is computed over image header and image itself. */
+    size = BOOT_TLV_OFF(hdr);
+
+    /* If protected TLVs are present they are also hashed. */
+    size += hdr->ih_protect_tlv_size;
+
+#ifdef MCUBOOT_RAM_LOADING
+    /* The SRAM copy has already been hashed while it was written */
+    if (!(seed && (seed_len > 0)) &&
+        (bootutil_take_img_ram_hash(image_index, hdr, size,
+                                    hash_result) == 0)) {
+        return 0;
+    }
+#endif
+
     bootutil_sha256_init(&sha256_ctx);
 
     /* in some cases (split image) the hash is seeded with data from
@@ -74,15 +166,47 @@ bootutil_img_hash(int image_index,
         bootutil_sha256_update(&sha256_ctx, seed, seed_len);
     }
 
-    /* Hash is computed over image header and image itself. */
-    size = BOOT_TLV_OFF(hdr);
-
-    /* If protected TLVs are present they are also hashed. */
-    size += hdr->ih_protect_tlv_size;
-
 #ifdef MCUBOOT_RAM_LOADING
+#ifdef MCUBOOT_COMPRESSED_IMAGES
+    /* A compressed image is validated in the flash, before it is
+     * decompressed to its load address.
+     */
+    if (hdr->ih_flags & IMAGE_F_COMPRESSED) {
+        for (off = 0; off < size; off += blk_sz) {
+            blk_sz = size - off;
+            if (blk_sz > tmp_buf_sz) {
+                blk_sz = tmp_buf_sz;
+            }
+            rc = flash_area_read(fap, off, tmp_buf, blk_sz);
+            if (rc) {
+                return rc;
+            }
+            bootutil_sha256_update(&sha256_ctx, tmp_buf, blk_sz);
+        }
+    } else
+#endif
     bootutil_sha256_update(&sha256_ctx,(void*)(hdr->ih_load_addr), size);
+#elif defined(MCUBOOT_HASH_XIP)
+    /* The flash is memory mapped, hash the image in place */
+    (void)tmp_buf;
+    (void)tmp_buf_sz;
+
+    if (size > fap->fa_size) {
+        return -1;
+    }
+    rc = flash_device_base(fap->fa_device_id, &flash_base);
+    if (rc) {
+        return rc;
+    }
+    bootutil_sha256_update(&sha256_ctx,
+                           (const void *)(flash_base + fap->fa_off), size);
 #else
+#ifdef MCUBOOT_HASH_BUF_SIZE
+    if (sizeof(hash_buf) > tmp_buf_sz) {
+        tmp_buf = (uint8_t *)hash_buf;
+        tmp_buf_sz = sizeof(hash_buf);
+    }
+#endif
     for (off = 0; off < size; off += blk_sz) {
         blk_sz = size - off;
         if (blk_sz > tmp_buf_sz) {
@@ -92,6 +216,16 @@ bootutil_img_hash(int image_index,
         if (rc) {
             return rc;
         }
+#ifdef MCUBOOT_ENC_IMAGES
+        /* An encrypted image is hashed in its plaintext form */
+        if (fap->fa_id == FLASH_AREA_IMAGE_SECONDARY(image_index)) {
+            rc = boot_enc_crypt(image_index, BOOT_SECONDARY_SLOT, off,
+                                tmp_buf, blk_sz);
+            if (rc) {
+                return rc;
+            }
+        }
+#endif
         bootutil_sha256_update(&sha256_ctx, tmp_buf, blk_sz);
     }
 #endif
@@ -117,6 +251,10 @@ bootutil_img_hash(int image_index,
 #    endif
 #    define SIG_BUF_SIZE (MCUBOOT_SIGN_RSA_LEN / 8)
 #    define EXPECTED_SIG_LEN(x) ((x) == SIG_BUF_SIZE)
+#elif defined(MCUBOOT_SIGN_EC256)
+#    define EXPECTED_SIG_TLV IMAGE_TLV_ECDSA256
+#    define SIG_BUF_SIZE 128
+#    define EXPECTED_SIG_LEN(x) (1) /* always true, ASN.1 will validate */
 #else
 #    define SIG_BUF_SIZE 32 /* no signing, sha256 digest only */
 #endif
@@ -125,18 +263,13 @@ bootutil_img_hash(int image_index,
 #ifdef MCUBOOT_HW_KEY
 extern unsigned int pub_key_len;
 static int
-bootutil_find_key(uint8_t image_id, uint8_t *key, uint16_t key_len)
+bootutil_find_key(uint8_t image_id, uint8_t *key, uint16_t key_len,
+                  const uint8_t *hash)
 {
-    bootutil_sha256_context sha256_ctx;
-    uint8_t hash[32];
     uint8_t key_hash[32];
     uint32_t key_hash_size= sizeof(key_hash);
     enum tfm_plat_err_t plat_err;
 
-    bootutil_sha256_init(&sha256_ctx);
-    bootutil_sha256_update(&sha256_ctx, key, key_len);
-    bootutil_sha256_finish(&sha256_ctx, hash);
-
     plat_err = tfm_plat_get_rotpk_hash(image_id, key_hash, &key_hash_size);
     if (plat_err != TFM_PLAT_ERR_SUCCESS) {
         return -1;
@@ -149,24 +282,41 @@ bootutil_find_key(uint8_t image_id, uint8_t *key, uint16_t key_len)
     return -1;
 }
 #else /* !MCUBOOT_HW_KEY */
+/*
+ * Hashes of the public keys (one per image), computed once per boot, so that
+ * the validation of each image looks the key up without hashing every key.
+ */
+static uint8_t bootutil_key_hashes[BOOT_IMAGE_NUMBER][32];
+static bool bootutil_key_hashes_valid;
+
 static int
 bootutil_find_key(uint8_t *keyhash, uint8_t keyhash_len)
 {
     bootutil_sha256_context sha256_ctx;
+    int key_cnt;
     int i;
     const struct bootutil_key *key;
-    uint8_t hash[32];
 
     if (keyhash_len > 32) {
         return -1;
     }
 
-    for (i = 0; i < bootutil_key_cnt; i++) {
-        key = &bootutil_keys[i];
-        bootutil_sha256_init(&sha256_ctx);
-        bootutil_sha256_update(&sha256_ctx, key->key, *key->len);
-        bootutil_sha256_finish(&sha256_ctx, hash);
-        if (!boot_secure_memequal(hash, keyhash, keyhash_len)) {
+    key_cnt = (bootutil_key_cnt < BOOT_IMAGE_NUMBER) ? bootutil_key_cnt :
+                                                       BOOT_IMAGE_NUMBER;
+
+    if (!bootutil_key_hashes_valid) {
+        for (i = 0; i < key_cnt; i++) {
+            key = &bootutil_keys[i];
+            bootutil_sha256_init(&sha256_ctx);
+            bootutil_sha256_update(&sha256_ctx, key->key, *key->len);
+            bootutil_sha256_finish(&sha256_ctx, bootutil_key_hashes[i]);
+        }
+        bootutil_key_hashes_valid = true;
+    }
+
+    for (i = 0; i < key_cnt; i++) {
+        if (!boot_secure_memequal(bootutil_key_hashes[i], keyhash,
+                                  keyhash_len)) {
             return i;
         }
     }
@@ -175,6 +325,32 @@ bootutil_find_key(uint8_t *keyhash, uint8_t keyhash_len)
 #endif
 #endif
 
+/*
+ * Manifest data of the last validated image of each image index.
+ */
+static struct image_manifest bootutil_manifests[BOOT_IMAGE_NUMBER];
+
+const struct image_manifest *
+bootutil_get_img_manifest(const struct flash_area *fap)
+{
+    int i;
+
+    for (i = 0; i < BOOT_IMAGE_NUMBER; i++) {
+        if (bootutil_manifests[i].valid &&
+            (bootutil_manifests[i].fa_id == fap->fa_id)) {
+            return &bootutil_manifests[i];
+        }
+    }
+
+    return NULL;
+}
+
+void
+bootutil_clear_img_manifest(int image_index)
+{
+    bootutil_manifests[image_index].valid = 0;
+}
+
 /**
  * Reads the value of an image's security counter.
  *
@@ -191,6 +367,7 @@ bootutil_get_img_security_cnt(struct image_header *hdr,
                               uint32_t *img_security_cnt)
 {
     struct image_tlv_iter it;
+    const struct image_manifest *manifest;
     uint32_t off;
     uint16_t len;
     int32_t rc;
@@ -202,6 +379,13 @@ bootutil_get_img_security_cnt(struct image_header *hdr,
         return BOOT_EBADARGS;
     }
 
+    /* The security counter was already read if the image was validated. */
+    manifest = bootutil_get_img_manifest(fap);
+    if (manifest != NULL) {
+        *img_security_cnt = manifest->security_cnt;
+        return 0;
+    }
+
     /* The security counter TLV is in the protected part of the TLV area. */
     if (hdr->ih_protect_tlv_size == 0) {
         return BOOT_EBADIMAGE;
@@ -255,9 +439,11 @@ bootutil_img_validate(int image_index,
 #ifdef MCUBOOT_HW_KEY
     /* Few extra bytes for encoding and for public exponent */
     uint8_t key_buf[SIG_BUF_SIZE + 24];
+    bootutil_sha256_context sha256_ctx;
 #endif
 #endif
     struct image_tlv_iter it;
+    struct image_manifest *manifest = &bootutil_manifests[image_index];
     uint8_t buf[SIG_BUF_SIZE];
     uint8_t hash[32] = {0};
     uint32_t security_cnt;
@@ -265,12 +451,19 @@ bootutil_img_validate(int image_index,
     int32_t security_counter_valid = 0;
     int rc;
 
+    /* The manifest data is collected along with the checks below and is only
+     * kept if the image is valid.
+     */
+    memset(manifest, 0, sizeof(*manifest));
+
     rc = bootutil_img_hash(image_index, hdr, fap, tmp_buf,
             tmp_buf_sz, hash, seed, seed_len);
     if (rc) {
         return rc;
     }
 
+    BOOT_TIME_RECORD(TFM_BOOT_TIME_BL2_IMAGE_HASH);
+
     if (out_hash) {
         memcpy(out_hash, hash, 32);
     }
@@ -309,6 +502,7 @@ bootutil_img_validate(int image_index,
             }
 
             sha256_valid = 1;
+            memcpy(manifest->image_hash, hash, sizeof(hash));
 #ifdef EXPECTED_SIG_TLV
 #ifndef MCUBOOT_HW_KEY
         } else if (type == IMAGE_TLV_KEYHASH) {
@@ -322,6 +516,10 @@ bootutil_img_validate(int image_index,
             if (rc) {
                 return rc;
             }
+            if (len == sizeof(manifest->signer_id)) {
+                memcpy(manifest->signer_id, buf, len);
+                manifest->signer_id_valid = 1;
+            }
             key_id = bootutil_find_key(buf, len);
             /*
              * The key may not be found, which is acceptable.  There
@@ -339,7 +537,13 @@ bootutil_img_validate(int image_index,
             if (rc) {
                 return rc;
             }
-            key_id = bootutil_find_key(image_index, key_buf, len);
+            /* The hash of the key is the signer ID of the image */
+            bootutil_sha256_init(&sha256_ctx);
+            bootutil_sha256_update(&sha256_ctx, key_buf, len);
+            bootutil_sha256_finish(&sha256_ctx, manifest->signer_id);
+            manifest->signer_id_valid = 1;
+            key_id = bootutil_find_key(image_index, key_buf, len,
+                                       manifest->signer_id);
             /*
              * The key may not be found, which is acceptable.  There
              * can be multiple signatures, each preceded by a key.
@@ -362,6 +566,7 @@ bootutil_img_validate(int image_index,
             if (rc == 0) {
                 valid_signature = 1;
             }
+            BOOT_TIME_RECORD(TFM_BOOT_TIME_BL2_IMAGE_SIG);
             key_id = -1;
 #endif
         } else if (type == IMAGE_TLV_SEC_CNT) {
@@ -394,6 +599,17 @@ bootutil_img_validate(int image_index,
 
             /* The image's security counter has been successfully verified. */
             security_counter_valid = 1;
+            manifest->security_cnt = img_security_cnt;
+        } else if (type == IMAGE_TLV_BOOT_RECORD) {
+            /* Kept for the boot status, a missing record is reported there */
+            if (len <= sizeof(manifest->boot_record)) {
+                rc = LOAD_IMAGE_DATA(hdr, fap, off, manifest->boot_record,
+                                     len);
+                if (rc) {
+                    return rc;
+                }
+                manifest->boot_record_len = len;
+            }
         }
     }
 
@@ -407,5 +623,8 @@ bootutil_img_validate(int image_index,
     }
 #endif
 
+    manifest->fa_id = fap->fa_id;
+    manifest->valid = 1;
+
     return 0;
 }
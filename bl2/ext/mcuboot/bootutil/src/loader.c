@@ -40,11 +40,19 @@
 #include "flash_map_backend/flash_map_backend.h"
 #include "bootutil/bootutil.h"
 #include "bootutil/image.h"
+#include "bootutil/sha256.h"
 #include "bootutil_priv.h"
 #include "bootutil/bootutil_log.h"
 #include "bl2/include/tfm_boot_status.h"
 #include "bl2/include/boot_record.h"
+#include "bl2/include/boot_time.h"
 #include "security_cnt.h"
+#ifdef MCUBOOT_VALIDATION_CACHE
+#include "validation_cache.h"
+#endif
+#if defined(MCUBOOT_DELTA_UPDATE) || defined(MCUBOOT_COMPRESSED_IMAGES)
+#include "delta_update.h"
+#endif
 
 static struct boot_loader_state boot_data;
 
@@ -68,6 +76,7 @@ static int boot_status_fails = 0;
 #define BOOT_STATUS_ASSERT(x) ASSERT(x)
 #endif
 
+#ifndef MCUBOOT_SWAP_USING_MOVE
 struct boot_status_table {
     uint8_t bst_magic_primary_slot;
     uint8_t bst_magic_scratch;
@@ -147,6 +156,7 @@ static const struct boot_status_table boot_status_tables[] = {
 
 #define BOOT_STATUS_TABLES_COUNT \
     (sizeof(boot_status_tables) / sizeof(boot_status_tables[0]))
+#endif /* !MCUBOOT_SWAP_USING_MOVE */
 
 #define BOOT_LOG_SWAP_STATE(area, state)                            \
     BOOT_LOG_INF("%s: magic=%5s, swap_type=0x%x, copy_done=0x%x, "  \
@@ -185,6 +195,12 @@ boot_verify_image_header(struct image_header *hdr)
         return BOOT_EBADIMAGE;
     }
 
+#ifndef MCUBOOT_COMPRESSED_IMAGES
+    if (hdr->ih_flags & IMAGE_F_COMPRESSED) {
+        return BOOT_EBADIMAGE;
+    }
+#endif
+
 #if MCUBOOT_RAM_LOADING
     if (!(hdr->ih_flags & IMAGE_F_RAM_LOAD)) {
         return BOOT_EBADIMAGE;
@@ -248,6 +264,7 @@ boot_read_image_headers(struct boot_loader_state *state, bool require_all)
              * Failure to read any headers is a fatal error.
              */
             if (i > 0 && !require_all) {
+                BOOT_TIME_RECORD(TFM_BOOT_TIME_BL2_HEADERS_READ);
                 return 0;
             } else {
                 return rc;
@@ -255,6 +272,8 @@ boot_read_image_headers(struct boot_loader_state *state, bool require_all)
         }
     }
 
+    BOOT_TIME_RECORD(TFM_BOOT_TIME_BL2_HEADERS_READ);
+
     return 0;
 }
 
@@ -277,7 +296,48 @@ boot_write_sz(struct boot_loader_state *state)
     return elem_sz;
 }
 
-#ifndef MCUBOOT_USE_FLASH_AREA_GET_SECTORS
+#if defined(MCUBOOT_UNIFORM_SECTORS)
+static int
+boot_initialize_area(struct boot_loader_state *state, int flash_area)
+{
+    const struct flash_area *fap;
+    size_t *out_num_sectors;
+    uint32_t num_sectors;
+    int rc;
+
+    if (flash_area == FLASH_AREA_IMAGE_PRIMARY(BOOT_CURR_IMG(state))) {
+        out_num_sectors = &BOOT_IMG(state, BOOT_PRIMARY_SLOT).num_sectors;
+    } else if (flash_area == FLASH_AREA_IMAGE_SECONDARY(BOOT_CURR_IMG(state))) {
+        out_num_sectors = &BOOT_IMG(state, BOOT_SECONDARY_SLOT).num_sectors;
+    } else if (flash_area == FLASH_AREA_IMAGE_SCRATCH) {
+        out_num_sectors = &state->scratch.num_sectors;
+    } else {
+        return BOOT_EFLASH;
+    }
+
+    /* The sector layout follows from the size of the area, no need to fill in
+     * the sector array.
+     */
+    rc = flash_area_open(flash_area, &fap);
+    if (rc != 0) {
+        return rc;
+    }
+    num_sectors = fap->fa_size / FLASH_AREA_IMAGE_SECTOR_SIZE;
+    if ((fap->fa_size % FLASH_AREA_IMAGE_SECTOR_SIZE != 0) ||
+        (num_sectors > BOOT_MAX_IMG_SECTORS)) {
+        BOOT_LOG_ERR("area %d size 0x%x is not a valid number of sectors",
+                     flash_area, fap->fa_size);
+        rc = BOOT_EFLASH;
+    }
+    flash_area_close(fap);
+    if (rc != 0) {
+        return rc;
+    }
+
+    *out_num_sectors = num_sectors;
+    return 0;
+}
+#elif !defined(MCUBOOT_USE_FLASH_AREA_GET_SECTORS)
 static int
 boot_initialize_area(struct boot_loader_state *state, int flash_area)
 {
@@ -335,7 +395,7 @@ boot_initialize_area(struct boot_loader_state *state, int flash_area)
     *out_num_sectors = num_sectors;
     return 0;
 }
-#endif  /* !defined(MCUBOOT_USE_FLASH_AREA_GET_SECTORS) */
+#endif  /* MCUBOOT_UNIFORM_SECTORS */
 
 /**
  * Determines the sector layout of both image slots and the scratch area.
@@ -389,6 +449,15 @@ boot_image_check(struct boot_loader_state *state, struct image_header *hdr,
 
     image_index = BOOT_CURR_IMG(state);
 
+#ifdef MCUBOOT_ENC_IMAGES
+    /* The image in the secondary slot is decrypted while it is hashed */
+    if (fap->fa_id == FLASH_AREA_IMAGE_SECONDARY(image_index)) {
+        if (boot_enc_load(image_index, BOOT_SECONDARY_SLOT, hdr, fap) < 0) {
+            return BOOT_EBADIMAGE;
+        }
+    }
+#endif
+
     if (bootutil_img_validate(image_index, hdr, fap, tmpbuf,
                               BOOT_TMPBUF_SZ, NULL, 0, NULL)) {
         return BOOT_EBADIMAGE;
@@ -471,6 +540,24 @@ boot_validate_slot(struct boot_loader_state *state, int slot,
         goto out;
     }
 
+#if defined(MCUBOOT_COMPRESSED_IMAGES) && !defined(MCUBOOT_RAM_LOADING)
+    if ((slot == BOOT_PRIMARY_SLOT) && (hdr->ih_flags & IMAGE_F_COMPRESSED)) {
+        /* A compressed image cannot be run in place */
+        BOOT_LOG_ERR("Image in the primary slot is compressed!");
+        rc = -1;
+        goto out;
+    }
+#endif
+
+#ifdef MCUBOOT_VALIDATION_CACHE
+    if ((slot == BOOT_PRIMARY_SLOT) && BOOT_IMG_HDR_IS_VALID(state, slot) &&
+        (boot_validation_cache_check(BOOT_CURR_IMG(state), hdr, fap) == 0)) {
+        /* Image has not changed since its last full validation. */
+        rc = 0;
+        goto out;
+    }
+#endif /* MCUBOOT_VALIDATION_CACHE */
+
     if ((!BOOT_IMG_HDR_IS_VALID(state, slot)) ||
          (boot_image_check(state, hdr, fap, bs) != 0)) {
         if (slot != BOOT_PRIMARY_SLOT) {
@@ -485,6 +572,12 @@ boot_validate_slot(struct boot_loader_state *state, int slot,
         goto out;
     }
 
+#ifdef MCUBOOT_VALIDATION_CACHE
+    if (slot == BOOT_PRIMARY_SLOT) {
+        (void)boot_validation_cache_update(BOOT_CURR_IMG(state), hdr, fap);
+    }
+#endif /* MCUBOOT_VALIDATION_CACHE */
+
     /* Image in the secondary slot is valid. */
     rc = 0;
 
@@ -535,7 +628,8 @@ done:
     return rc;
 }
 
-#if !defined(MCUBOOT_NO_SWAP) && !defined(MCUBOOT_OVERWRITE_ONLY)
+#if !defined(MCUBOOT_NO_SWAP) && \
+    (!defined(MCUBOOT_OVERWRITE_ONLY) || defined(MCUBOOT_OVERWRITE_ONLY_FAST))
 /*
  * Compute the total size of the given image.  Includes the size of
  * the TLVs.
@@ -596,7 +690,9 @@ done:
     flash_area_close(fap);
     return rc;
 }
-#endif /* !MCUBOOT_NO_SWAP && !MCUBOOT_OVERWRITE_ONLY */
+#endif /* !MCUBOOT_NO_SWAP &&
+        * (!MCUBOOT_OVERWRITE_ONLY || MCUBOOT_OVERWRITE_ONLY_FAST)
+        */
 
 #if !defined(MCUBOOT_NO_SWAP) && !defined(MCUBOOT_RAM_LOADING)
 /**
@@ -607,6 +703,37 @@ done:
  * @return      A BOOT_STATUS_SOURCE_[...] code indicating where status should
  *              be read from.
  */
+#ifdef MCUBOOT_SWAP_USING_MOVE
+static int
+boot_status_source(struct boot_loader_state *state)
+{
+    struct boot_swap_state state_primary_slot;
+    int rc;
+
+#if (BOOT_IMAGE_NUMBER == 1)
+    (void)state;
+#endif
+
+    rc = boot_read_swap_state_by_id(
+                                FLASH_AREA_IMAGE_PRIMARY(BOOT_CURR_IMG(state)),
+                                &state_primary_slot);
+    assert(rc == 0);
+
+    BOOT_LOG_SWAP_STATE("Primary image", &state_primary_slot);
+
+    /* Without a scratch area the status is only written to the primary slot,
+     * where it is valid until the swap is marked as done.
+     */
+    if (state_primary_slot.magic == BOOT_MAGIC_GOOD &&
+        state_primary_slot.copy_done == BOOT_FLAG_UNSET) {
+        BOOT_LOG_INF("Boot source: primary slot");
+        return BOOT_STATUS_SOURCE_PRIMARY_SLOT;
+    }
+
+    BOOT_LOG_INF("Boot source: none");
+    return BOOT_STATUS_SOURCE_NONE;
+}
+#else
 static int
 boot_status_source(struct boot_loader_state *state)
 {
@@ -668,7 +795,46 @@ boot_status_source(struct boot_loader_state *state)
     BOOT_LOG_INF("Boot source: none");
     return BOOT_STATUS_SOURCE_NONE;
 }
+#endif /* MCUBOOT_SWAP_USING_MOVE */
 
+#ifdef MCUBOOT_SWAP_USING_MOVE
+/*
+ * Slots are compatible when they have the same number of sectors, all of the
+ * same size, as the images are moved and swapped one sector at a time.
+ */
+static int
+boot_slots_compatible(struct boot_loader_state *state)
+{
+    size_t num_sectors;
+    size_t sector_sz;
+    size_t i;
+
+    num_sectors = boot_img_num_sectors(state, BOOT_PRIMARY_SLOT);
+    if (num_sectors != boot_img_num_sectors(state, BOOT_SECONDARY_SLOT)) {
+        BOOT_LOG_WRN("Cannot upgrade: slots don't have the same number of"
+                     " sectors");
+        return 0;
+    }
+
+    if ((num_sectors > BOOT_MAX_IMG_SECTORS) ||
+        (num_sectors > BOOT_STATUS_MAX_ENTRIES)) {
+        BOOT_LOG_WRN("Cannot upgrade: more sectors than allowed");
+        return 0;
+    }
+
+    sector_sz = boot_img_sector_size(state, BOOT_PRIMARY_SLOT, 0);
+    for (i = 0; i < num_sectors; i++) {
+        if ((boot_img_sector_size(state, BOOT_PRIMARY_SLOT, i) != sector_sz) ||
+            (boot_img_sector_size(state, BOOT_SECONDARY_SLOT, i) !=
+                                                                 sector_sz)) {
+            BOOT_LOG_WRN("Cannot upgrade: sectors don't have the same size");
+            return 0;
+        }
+    }
+
+    return 1;
+}
+#else
 /*
  * Slots are compatible when all sectors that store up to to size of the image
  * round up to sector size, in both slot's are able to fit in the scratch
@@ -767,18 +933,134 @@ boot_slots_compatible(struct boot_loader_state *state)
 
     return 1;
 }
+#endif /* MCUBOOT_SWAP_USING_MOVE */
 
 static uint32_t
-boot_status_internal_off(int idx, int state, int elem_sz)
+boot_status_internal_off(const struct boot_status *bs, int elem_sz)
 {
     int idx_sz;
 
+#ifdef MCUBOOT_SWAP_USING_MOVE
+    if (bs->op != BOOT_STATUS_OP_SWAP) {
+        idx_sz = elem_sz * BOOT_STATUS_MOVE_STATE_COUNT;
+
+        return (bs->idx - BOOT_STATUS_IDX_0) * idx_sz;
+    }
+
+    idx_sz = elem_sz * BOOT_STATUS_SWAP_STATE_COUNT;
+
+    return BOOT_STATUS_MAX_ENTRIES * BOOT_STATUS_MOVE_STATE_COUNT * elem_sz +
+           (bs->idx - BOOT_STATUS_IDX_0) * idx_sz +
+           (bs->state - BOOT_STATUS_STATE_0) * elem_sz;
+#else
     idx_sz = elem_sz * BOOT_STATUS_STATE_COUNT;
 
-    return (idx - BOOT_STATUS_IDX_0) * idx_sz +
-           (state - BOOT_STATUS_STATE_0) * elem_sz;
+    return (bs->idx - BOOT_STATUS_IDX_0) * idx_sz +
+           (bs->state - BOOT_STATUS_STATE_0) * elem_sz;
+#endif
 }
 
+#ifdef MCUBOOT_SWAP_USING_MOVE
+/**
+ * Counts the status entries written in a part of the status area.
+ *
+ * @param off                   Offset of the first entry.
+ * @param entries               Number of entries in the part.
+ * @param invalid               Set to 1 if an entry is written after an
+ *                                  erased one.
+ *
+ * @return                      Index of the last written entry plus one, or
+ *                                  a negative error code.
+ */
+static int
+boot_count_status_bytes(const struct flash_area *fap,
+        struct boot_loader_state *state, uint32_t off, int entries,
+        int *invalid)
+{
+    uint8_t status;
+    int count;
+    int rc;
+    int i;
+
+    count = 0;
+    for (i = 0; i < entries; i++) {
+        rc = flash_area_read_is_empty(fap, off + i * BOOT_WRITE_SZ(state),
+                &status, 1);
+        if (rc < 0) {
+            return BOOT_EFLASH;
+        }
+
+        if (rc == 0) {
+            if (i != count) {
+                *invalid = 1;
+            }
+            count = i + 1;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * Reads the status of a partially-completed move or swap, if any.  This is
+ * necessary to recover in case the boot loader was reset in the middle of
+ * the operation.
+ */
+static int
+boot_read_status_bytes(const struct flash_area *fap,
+        struct boot_loader_state *state, struct boot_status *bs)
+{
+    uint32_t off;
+    int move_entries;
+    int moved;
+    int swapped;
+    int invalid;
+
+    off = boot_status_off(fap);
+    move_entries = BOOT_STATUS_MAX_ENTRIES * BOOT_STATUS_MOVE_STATE_COUNT;
+    invalid = 0;
+
+    moved = boot_count_status_bytes(fap, state, off, move_entries, &invalid);
+    if (moved < 0) {
+        return moved;
+    }
+
+    swapped = boot_count_status_bytes(fap, state,
+                    off + move_entries * BOOT_WRITE_SZ(state),
+                    BOOT_STATUS_MAX_ENTRIES * BOOT_STATUS_SWAP_STATE_COUNT,
+                    &invalid);
+    if (swapped < 0) {
+        return swapped;
+    }
+
+    if (invalid) {
+        /* This means there was an error writing status on the last
+         * swap. Tell user and move on to validation!
+         */
+        BOOT_LOG_ERR("Detected inconsistent status!");
+
+#if !defined(MCUBOOT_VALIDATE_PRIMARY_SLOT)
+        /* With validation of the primary slot disabled, there is no way
+         * to be sure the swapped primary slot is OK, so abort!
+         */
+        assert(0);
+#endif
+    }
+
+    if (swapped > 0) {
+        bs->op = BOOT_STATUS_OP_SWAP;
+        bs->idx = (swapped / BOOT_STATUS_SWAP_STATE_COUNT) + BOOT_STATUS_IDX_0;
+        bs->state = (swapped % BOOT_STATUS_SWAP_STATE_COUNT) +
+                    BOOT_STATUS_STATE_0;
+    } else if (moved > 0) {
+        bs->op = BOOT_STATUS_OP_MOVE;
+        bs->idx = moved + BOOT_STATUS_IDX_0;
+        bs->state = BOOT_STATUS_STATE_0;
+    }
+
+    return 0;
+}
+#else
 /**
  * Reads the status of a partially-completed swap, if any.  This is necessary
  * to recover in case the boot lodaer was reset in the middle of a swap
@@ -849,6 +1131,7 @@ boot_read_status_bytes(const struct flash_area *fap,
 
     return 0;
 }
+#endif /* MCUBOOT_SWAP_USING_MOVE */
 
 /**
  * Reads the boot status from the flash.  The boot status contains
@@ -870,6 +1153,9 @@ boot_read_status(struct boot_loader_state *state, struct boot_status *bs)
     bs->idx = BOOT_STATUS_IDX_0;
     bs->state = BOOT_STATUS_STATE_0;
     bs->swap_type = BOOT_SWAP_TYPE_NONE;
+#ifdef MCUBOOT_SWAP_USING_MOVE
+    bs->op = BOOT_STATUS_OP_MOVE;
+#endif
 
 #ifdef MCUBOOT_OVERWRITE_ONLY
     /* Overwrite-only doesn't make use of the swap status area. */
@@ -877,6 +1163,9 @@ boot_read_status(struct boot_loader_state *state, struct boot_status *bs)
 #endif
 
     status_loc = boot_status_source(state);
+#ifdef MCUBOOT_SWAP_USING_MOVE
+    bs->source = status_loc;
+#endif
     switch (status_loc) {
     case BOOT_STATUS_SOURCE_NONE:
         return 0;
@@ -912,6 +1201,15 @@ boot_read_status(struct boot_loader_state *state, struct boot_status *bs)
         bs->swap_type = BOOT_GET_SWAP_TYPE(swap_info);
     }
 
+#ifdef MCUBOOT_ENC_IMAGES
+    if (rc == 0) {
+        rc = boot_read_enc_rec(fap, BOOT_PRIMARY_SLOT, &bs->enc[0]);
+    }
+    if (rc == 0) {
+        rc = boot_read_enc_rec(fap, BOOT_SECONDARY_SLOT, &bs->enc[1]);
+    }
+#endif
+
     flash_area_close(fap);
 
     return rc;
@@ -957,7 +1255,7 @@ boot_write_status(struct boot_loader_state *state, struct boot_status *bs)
     }
 
     off = boot_status_off(fap) +
-          boot_status_internal_off(bs->idx, bs->state, BOOT_WRITE_SZ(state));
+          boot_status_internal_off(bs, BOOT_WRITE_SZ(state));
     align = flash_area_align(fap);
     erased_val = flash_area_erased_val(fap);
     memset(buf, erased_val, BOOT_MAX_ALIGN);
@@ -1020,7 +1318,7 @@ boot_validated_swap_type(struct boot_loader_state *state,
  * @return                      The number of bytes comprised by the
  *                                  [first-sector, last-sector] range.
  */
-#ifndef MCUBOOT_OVERWRITE_ONLY
+#if !defined(MCUBOOT_OVERWRITE_ONLY) && !defined(MCUBOOT_SWAP_USING_MOVE)
 static uint32_t
 boot_copy_sz(struct boot_loader_state *state, int last_sector_idx,
              int *out_first_sector_idx)
@@ -1052,7 +1350,7 @@ boot_copy_sz(struct boot_loader_state *state, int last_sector_idx,
     *out_first_sector_idx = i + 1;
     return sz;
 }
-#endif /* !MCUBOOT_OVERWRITE_ONLY */
+#endif /* !MCUBOOT_OVERWRITE_ONLY && !MCUBOOT_SWAP_USING_MOVE */
 
 /**
  * Erases a region of flash.
@@ -1094,7 +1392,10 @@ boot_copy_region(struct boot_loader_state *state,
     int chunk_sz;
     int rc;
 
-    static uint8_t buf[1024];
+    static uint8_t buf[MCUBOOT_COPY_BUF_SIZE];
+#ifdef MCUBOOT_ENC_IMAGES
+    uint8_t image_index = BOOT_CURR_IMG(state);
+#endif
 
     (void)state;
 
@@ -1111,6 +1412,25 @@ boot_copy_region(struct boot_loader_state *state,
             return BOOT_EFLASH;
         }
 
+#ifdef MCUBOOT_ENC_IMAGES
+        /* Images are decrypted when they leave the secondary slot, and
+         * encrypted again with their own key when they enter it. The offset
+         * of a sector in the image is its offset in the secondary slot.
+         */
+        if (fap_src->fa_id == FLASH_AREA_IMAGE_SECONDARY(image_index) &&
+            fap_dst->fa_id != FLASH_AREA_IMAGE_SECONDARY(image_index)) {
+            rc = boot_enc_crypt(image_index, BOOT_SECONDARY_SLOT,
+                                off_src + bytes_copied, buf, chunk_sz);
+        } else if (fap_dst->fa_id == FLASH_AREA_IMAGE_SECONDARY(image_index) &&
+                   fap_src->fa_id != FLASH_AREA_IMAGE_SECONDARY(image_index)) {
+            rc = boot_enc_crypt(image_index, BOOT_PRIMARY_SLOT,
+                                off_dst + bytes_copied, buf, chunk_sz);
+        }
+        if (rc != 0) {
+            return BOOT_EBADIMAGE;
+        }
+#endif
+
         rc = flash_area_write(fap_dst, off_dst + bytes_copied, buf, chunk_sz);
         if (rc != 0) {
             return BOOT_EFLASH;
@@ -1130,6 +1450,9 @@ boot_status_init(const struct boot_loader_state *state,
 {
     struct boot_swap_state swap_state;
     uint8_t image_index;
+#ifdef MCUBOOT_ENC_IMAGES
+    uint8_t slot;
+#endif
     int rc;
 
 #if (BOOT_IMAGE_NUMBER == 1)
@@ -1157,6 +1480,15 @@ boot_status_init(const struct boot_loader_state *state,
     rc = boot_write_swap_size(fap, bs->swap_size);
     assert(rc == 0);
 
+#ifdef MCUBOOT_ENC_IMAGES
+    for (slot = 0; slot < BOOT_NUM_SLOTS; slot++) {
+        if (bs->enc[slot].body_size != 0) {
+            rc = boot_write_enc_rec(fap, slot, &bs->enc[slot]);
+            assert(rc == 0);
+        }
+    }
+#endif
+
     rc = boot_write_magic(fap);
     assert(rc == 0);
 
@@ -1211,6 +1543,248 @@ boot_erase_trailer_sectors(const struct boot_loader_state *state,
     return rc;
 }
 
+#ifdef MCUBOOT_SWAP_USING_MOVE
+/**
+ * Moves a sector of the image in the primary slot one sector up, to make room
+ * for the matching sector of the image in the secondary slot.
+ *
+ * @param idx                   The index of the destination sector.
+ * @param sz                    The size of the sector.
+ * @param bs                    The current boot status.  This struct gets
+ *                                  updated according to the outcome.
+ * @param fap_primary_slot      The flash area of the primary slot.
+ * @param fap_secondary_slot    The flash area of the secondary slot.
+ */
+static void
+boot_move_sector_up(uint32_t idx, uint32_t sz, struct boot_loader_state *state,
+        struct boot_status *bs, const struct flash_area *fap_primary_slot,
+        const struct flash_area *fap_secondary_slot)
+{
+    uint32_t new_off;
+    uint32_t old_off;
+    int rc;
+
+    new_off = boot_img_sector_off(state, BOOT_PRIMARY_SLOT, idx);
+    old_off = boot_img_sector_off(state, BOOT_PRIMARY_SLOT, idx - 1);
+
+    if (bs->idx == BOOT_STATUS_IDX_0) {
+        if (bs->source != BOOT_STATUS_SOURCE_PRIMARY_SLOT) {
+            /* The trailer sectors of the primary slot are not used by the
+             * moved image, so the status is written there from the start.
+             */
+            rc = boot_erase_trailer_sectors(state, fap_primary_slot);
+            assert(rc == 0);
+
+            rc = boot_status_init(state, fap_primary_slot, bs);
+            assert(rc == 0);
+        }
+
+        rc = boot_erase_trailer_sectors(state, fap_secondary_slot);
+        assert(rc == 0);
+    }
+
+    rc = boot_erase_region(fap_primary_slot, new_off, sz);
+    assert(rc == 0);
+
+    rc = boot_copy_region(state, fap_primary_slot, fap_primary_slot,
+                          old_off, new_off, sz);
+    assert(rc == 0);
+
+    rc = boot_write_status(state, bs);
+    bs->idx++;
+    BOOT_STATUS_ASSERT(rc == 0);
+}
+
+/**
+ * Swaps a sector of the image in the secondary slot with the matching sector
+ * of the image in the primary slot, which has been moved one sector up.  The
+ * sector of the secondary slot is copied to the free sector of the primary
+ * slot, then the moved sector is copied to the secondary slot.
+ *
+ * @param idx                   The index of the sector in the secondary slot,
+ *                                  plus one.
+ * @param sz                    The size of the sector.
+ * @param bs                    The current boot status.  This struct gets
+ *                                  updated according to the outcome.
+ * @param fap_primary_slot      The flash area of the primary slot.
+ * @param fap_secondary_slot    The flash area of the secondary slot.
+ */
+static void
+boot_swap_sectors(uint32_t idx, uint32_t sz, struct boot_loader_state *state,
+        struct boot_status *bs, const struct flash_area *fap_primary_slot,
+        const struct flash_area *fap_secondary_slot)
+{
+    uint32_t pri_off;
+    uint32_t pri_up_off;
+    uint32_t sec_off;
+    int rc;
+
+    pri_up_off = boot_img_sector_off(state, BOOT_PRIMARY_SLOT, idx);
+    pri_off = boot_img_sector_off(state, BOOT_PRIMARY_SLOT, idx - 1);
+    sec_off = boot_img_sector_off(state, BOOT_SECONDARY_SLOT, idx - 1);
+
+    if (bs->state == BOOT_STATUS_STATE_0) {
+        rc = boot_erase_region(fap_primary_slot, pri_off, sz);
+        assert(rc == 0);
+
+        rc = boot_copy_region(state, fap_secondary_slot, fap_primary_slot,
+                              sec_off, pri_off, sz);
+        assert(rc == 0);
+
+        rc = boot_write_status(state, bs);
+        bs->state = BOOT_STATUS_STATE_1;
+        BOOT_STATUS_ASSERT(rc == 0);
+    }
+
+    if (bs->state == BOOT_STATUS_STATE_1) {
+        rc = boot_erase_region(fap_secondary_slot, sec_off, sz);
+        assert(rc == 0);
+
+        rc = boot_copy_region(state, fap_primary_slot, fap_secondary_slot,
+                              pri_up_off, sec_off, sz);
+        assert(rc == 0);
+
+        rc = boot_write_status(state, bs);
+        bs->idx++;
+        bs->state = BOOT_STATUS_STATE_0;
+        BOOT_STATUS_ASSERT(rc == 0);
+    }
+}
+
+/**
+ * Writes a trailer to the secondary slot before a revert is started.  The
+ * trailer of the primary slot is erased by the first move, so the revert
+ * would be lost if the boot loader is reset before the trailer is rewritten.
+ * With the image_ok flag set in the secondary slot, the revert is then
+ * performed as a permanent swap instead.
+ *
+ * @param bs                    The current boot status.
+ * @param fap_secondary_slot    The flash area of the secondary slot.
+ */
+static void
+boot_fixup_revert(const struct boot_loader_state *state,
+        const struct boot_status *bs,
+        const struct flash_area *fap_secondary_slot)
+{
+    struct boot_swap_state swap_state;
+    int rc;
+
+    if (bs->swap_type != BOOT_SWAP_TYPE_REVERT ||
+        bs->op == BOOT_STATUS_OP_SWAP ||
+        bs->idx != BOOT_STATUS_IDX_0) {
+        /* Not a new revert */
+        return;
+    }
+
+    rc = boot_read_swap_state(fap_secondary_slot, &swap_state);
+    assert(rc == 0);
+
+    BOOT_LOG_SWAP_STATE("Secondary image", &swap_state);
+
+    if (swap_state.magic == BOOT_MAGIC_UNSET) {
+        rc = boot_erase_trailer_sectors(state, fap_secondary_slot);
+        assert(rc == 0);
+
+        rc = boot_write_image_ok(fap_secondary_slot);
+        assert(rc == 0);
+
+        rc = boot_write_swap_size(fap_secondary_slot, bs->swap_size);
+        assert(rc == 0);
+
+        rc = boot_write_magic(fap_secondary_slot);
+        assert(rc == 0);
+    }
+}
+
+/**
+ * Swaps the images by moving the image in the primary slot one sector up,
+ * then swapping each sector of the image in the secondary slot with the
+ * matching moved sector.  No scratch area is used, and each sector is erased
+ * once per slot, plus once for the move in the primary slot.
+ *
+ * @param bs                    The current boot status.  This function reads
+ *                                  this struct to determine if it is resuming
+ *                                  an interrupted operation.
+ * @param copy_size             The size of the larger of the two images.
+ */
+static void
+boot_swap_run(struct boot_loader_state *state, struct boot_status *bs,
+              uint32_t copy_size)
+{
+    const struct flash_area *fap_primary_slot;
+    const struct flash_area *fap_secondary_slot;
+    uint32_t sector_sz;
+    uint32_t trailer_sz;
+    uint32_t first_trailer_idx;
+    uint32_t last_idx;
+    uint32_t idx;
+    uint32_t sz;
+    uint8_t image_index;
+    int rc;
+
+    /* All the sectors have the same size, see boot_slots_compatible() */
+    sector_sz = boot_img_sector_size(state, BOOT_PRIMARY_SLOT, 0);
+    last_idx = (copy_size + sector_sz - 1) / sector_sz;
+
+    if (bs->op != BOOT_STATUS_OP_SWAP && bs->idx == BOOT_STATUS_IDX_0) {
+        /* The image moved one sector up must not reach the trailer of the
+         * primary slot.
+         */
+        trailer_sz = boot_trailer_sz(BOOT_WRITE_SZ(state));
+        first_trailer_idx = boot_img_num_sectors(state, BOOT_PRIMARY_SLOT);
+        sz = 0;
+        while (sz < trailer_sz && first_trailer_idx > 0) {
+            first_trailer_idx--;
+            sz += sector_sz;
+        }
+
+        if (last_idx >= first_trailer_idx) {
+            BOOT_LOG_WRN("Cannot upgrade: no free sector to move the image;"
+                         " Image=%u", BOOT_CURR_IMG(state));
+            BOOT_SWAP_TYPE(state) = BOOT_SWAP_TYPE_NONE;
+            return;
+        }
+    }
+
+    image_index = BOOT_CURR_IMG(state);
+
+    rc = flash_area_open(FLASH_AREA_IMAGE_PRIMARY(image_index),
+            &fap_primary_slot);
+    assert (rc == 0);
+
+    rc = flash_area_open(FLASH_AREA_IMAGE_SECONDARY(image_index),
+            &fap_secondary_slot);
+    assert (rc == 0);
+
+    boot_fixup_revert(state, bs, fap_secondary_slot);
+
+    if (bs->op != BOOT_STATUS_OP_SWAP) {
+        /* Start from the last sector, each one is moved to the sector freed
+         * by the previous move.
+         */
+        for (idx = last_idx; idx > 0; idx--) {
+            if (idx + bs->idx <= last_idx + BOOT_STATUS_IDX_0) {
+                boot_move_sector_up(idx, sector_sz, state, bs,
+                                    fap_primary_slot, fap_secondary_slot);
+            }
+        }
+
+        bs->op = BOOT_STATUS_OP_SWAP;
+        bs->idx = BOOT_STATUS_IDX_0;
+        bs->state = BOOT_STATUS_STATE_0;
+    }
+
+    for (idx = BOOT_STATUS_IDX_0; idx <= last_idx; idx++) {
+        if (idx >= bs->idx) {
+            boot_swap_sectors(idx, sector_sz, state, bs,
+                              fap_primary_slot, fap_secondary_slot);
+        }
+    }
+
+    flash_area_close(fap_primary_slot);
+    flash_area_close(fap_secondary_slot);
+}
+#else
 /**
  * Swaps the contents of two flash regions within the two image slots.
  *
@@ -1237,6 +1811,9 @@ boot_swap_sectors(int idx, uint32_t sz, struct boot_loader_state *state,
     size_t last_sector;
     bool erase_scratch;
     uint8_t image_index;
+#ifdef MCUBOOT_ENC_IMAGES
+    uint8_t slot;
+#endif
     int rc;
 
     /* Calculate offset from start of image area. */
@@ -1374,6 +1951,16 @@ boot_swap_sectors(int idx, uint32_t sz, struct boot_loader_state *state,
             rc = boot_write_swap_size(fap_primary_slot, bs->swap_size);
             assert(rc == 0);
 
+#ifdef MCUBOOT_ENC_IMAGES
+            for (slot = 0; slot < BOOT_NUM_SLOTS; slot++) {
+                if (bs->enc[slot].body_size != 0) {
+                    rc = boot_write_enc_rec(fap_primary_slot, slot,
+                                            &bs->enc[slot]);
+                    assert(rc == 0);
+                }
+            }
+#endif
+
             rc = boot_write_magic(fap_primary_slot);
             assert(rc == 0);
         }
@@ -1401,6 +1988,7 @@ boot_swap_sectors(int idx, uint32_t sz, struct boot_loader_state *state,
     flash_area_close(fap_secondary_slot);
     flash_area_close(fap_scratch);
 }
+#endif /* MCUBOOT_SWAP_USING_MOVE */
 #endif /* !MCUBOOT_OVERWRITE_ONLY */
 
 /**
@@ -1429,6 +2017,17 @@ boot_copy_image(struct boot_loader_state *state, struct boot_status *bs)
     const struct flash_area *fap_primary_slot;
     const struct flash_area *fap_secondary_slot;
     uint8_t image_index;
+    uint32_t src_size;
+    int counter_slot = BOOT_PRIMARY_SLOT;
+#ifdef MCUBOOT_OVERWRITE_ONLY_FAST
+    uint32_t trailer_sz;
+    uint32_t off;
+#endif
+#ifdef MCUBOOT_COMPRESSED_IMAGES
+    struct image_header *hdr_secondary = boot_img_hdr(state,
+                                                      BOOT_SECONDARY_SLOT);
+    struct boot_delta_dst dst;
+#endif
 
     (void)bs;
 
@@ -1445,8 +2044,40 @@ boot_copy_image(struct boot_loader_state *state, struct boot_status *bs)
             &fap_secondary_slot);
     assert (rc == 0);
 
+#ifdef MCUBOOT_ENC_IMAGES
+    /* The image is decrypted while it is copied to the primary slot */
+    rc = boot_enc_load(image_index, BOOT_SECONDARY_SLOT,
+                       boot_img_hdr(state, BOOT_SECONDARY_SLOT),
+                       fap_secondary_slot);
+    if (rc < 0) {
+        return BOOT_EBADIMAGE;
+    }
+#endif
+
+#ifdef MCUBOOT_OVERWRITE_ONLY_FAST
+    /* Only erase and copy the sectors which hold the new image. */
+    rc = boot_read_image_size(state, BOOT_SECONDARY_SLOT, &src_size);
+    if (rc != 0) {
+        return rc;
+    }
+#else
+    src_size = fap_primary_slot->fa_size;
+#endif
+
+#if defined(MCUBOOT_COMPRESSED_IMAGES) && defined(MCUBOOT_OVERWRITE_ONLY_FAST)
+    if (hdr_secondary->ih_flags & IMAGE_F_COMPRESSED) {
+        /* Only erase the sectors which hold the decompressed image. */
+        rc = boot_compressed_image_size(hdr_secondary, fap_secondary_slot,
+                                        &src_size);
+        if (rc != 0) {
+            return BOOT_EBADIMAGE;
+        }
+    }
+#endif
+
     sect_count = boot_img_num_sectors(state, BOOT_PRIMARY_SLOT);
-    for (sect = 0, size = 0; sect < sect_count; sect++) {
+    for (sect = 0, size = 0; (sect < sect_count) && (size < src_size);
+         sect++) {
         this_size = boot_img_sector_size(state, BOOT_PRIMARY_SLOT, sect);
         rc = boot_erase_region(fap_primary_slot, size, this_size);
         assert(rc == 0);
@@ -1454,17 +2085,65 @@ boot_copy_image(struct boot_loader_state *state, struct boot_status *bs)
         size += this_size;
     }
 
-    BOOT_LOG_INF("Copying the secondary slot to the primary slot: 0x%zx bytes",
-                 size);
-    rc = boot_copy_region(state, fap_secondary_slot, fap_primary_slot,
-                          0, 0, size);
+#ifdef MCUBOOT_OVERWRITE_ONLY_FAST
+    /* Erase the sectors of the primary slot's trailer which do not hold the
+     * new image, so that no stale trailer is left behind.
+     */
+    trailer_sz = boot_trailer_sz(BOOT_WRITE_SZ(state));
+    last_sector = sect_count;
+    while (last_sector > sect) {
+        last_sector--;
+        off = boot_img_sector_off(state, BOOT_PRIMARY_SLOT, last_sector);
+        this_size = boot_img_sector_size(state, BOOT_PRIMARY_SLOT, last_sector);
+        rc = boot_erase_region(fap_primary_slot, off, this_size);
+        assert(rc == 0);
+
+        if (fap_primary_slot->fa_size - off >= trailer_sz) {
+            break;
+        }
+    }
+#endif
+
+#ifdef MCUBOOT_COMPRESSED_IMAGES
+    if (hdr_secondary->ih_flags & IMAGE_F_COMPRESSED) {
+        BOOT_LOG_INF("Decompressing the secondary slot to the primary slot");
+        dst.fap = fap_primary_slot;
+        dst.off = 0;
+        dst.ram = NULL;
+        if (size > fap_primary_slot->fa_size -
+                   boot_trailer_sz(BOOT_WRITE_SZ(state))) {
+            size = fap_primary_slot->fa_size -
+                   boot_trailer_sz(BOOT_WRITE_SZ(state));
+        }
+        rc = boot_decompress_image(hdr_secondary, fap_secondary_slot, &dst,
+                                   size);
+        if (rc != 0) {
+            BOOT_LOG_ERR("Failed to decompress the image");
+            return BOOT_EBADIMAGE;
+        }
+
+        /* The compressed image holds the security counter of the image it
+         * decompresses to, at the offsets given by its header.
+         */
+        counter_slot = BOOT_SECONDARY_SLOT;
+    } else
+#endif
+    {
+        BOOT_LOG_INF("Copying the secondary slot to the primary slot: "
+                     "0x%zx bytes", size);
+        rc = boot_copy_region(state, fap_secondary_slot, fap_primary_slot,
+                              0, 0, size);
+#ifdef MCUBOOT_ENC_IMAGES
+        boot_enc_clear(image_index, BOOT_SECONDARY_SLOT);
+#endif
+    }
 
     /* Update the stored security counter with the new image's security counter
      * value. Both slots hold the new image at this point, but the secondary
      * slot's image header must be passed because the read image headers in the
      * boot_data structure have not been updated yet.
      */
-    rc = boot_update_security_counter(BOOT_CURR_IMG(state), BOOT_PRIMARY_SLOT,
+    rc = boot_update_security_counter(BOOT_CURR_IMG(state), counter_slot,
                                 boot_img_hdr(state, BOOT_SECONDARY_SLOT));
     if (rc != 0) {
         BOOT_LOG_ERR("Security counter update failed after image upgrade.");
@@ -1498,6 +2177,59 @@ boot_copy_image(struct boot_loader_state *state, struct boot_status *bs)
     return 0;
 }
 #else
+#ifdef MCUBOOT_ENC_IMAGES
+/**
+ * Sets up the keys of the slots for a swap. When a swap starts, the
+ * encryption data is read from the images and saved in the boot status, which
+ * then persists it in the trailer. When a swap is resumed, the images are
+ * partially swapped, so the data read back from the trailer is used instead.
+ *
+ * @param bs                    The boot status of the swap.
+ * @param resume                True if a swap is being resumed.
+ *
+ * @return                      0 on success; nonzero on failure.
+ */
+static int
+boot_enc_init_swap(struct boot_loader_state *state, struct boot_status *bs,
+                   bool resume)
+{
+    struct image_header *hdr;
+    uint8_t image_index;
+    int slot;
+    int rc;
+
+    image_index = BOOT_CURR_IMG(state);
+
+    for (slot = 0; slot < BOOT_NUM_SLOTS; slot++) {
+        if (!resume) {
+            hdr = boot_img_hdr(state, slot);
+            rc = 1;
+            if (hdr->ih_magic == IMAGE_MAGIC) {
+                rc = boot_enc_read_rec(hdr, BOOT_IMG_AREA(state, slot),
+                                       &bs->enc[slot]);
+                if (rc < 0) {
+                    return BOOT_EBADIMAGE;
+                }
+            }
+            if (rc != 0) {
+                memset(&bs->enc[slot], 0, sizeof(bs->enc[slot]));
+            }
+        }
+
+        if (bs->enc[slot].body_size != 0) {
+            rc = boot_enc_set_key(image_index, slot, &bs->enc[slot]);
+            if (rc != 0) {
+                return BOOT_EBADIMAGE;
+            }
+        } else {
+            boot_enc_clear(image_index, slot);
+        }
+    }
+
+    return 0;
+}
+#endif /* MCUBOOT_ENC_IMAGES */
+
 /**
  * Swaps the two images in flash.  If a prior copy operation was interrupted
  * by a system reset, this function completes that operation.
@@ -1513,16 +2245,18 @@ boot_copy_image(struct boot_loader_state *state, struct boot_status *bs)
 static int
 boot_swap_image(struct boot_loader_state *state, struct boot_status *bs)
 {
+#ifndef MCUBOOT_SWAP_USING_MOVE
     uint32_t sz;
     int first_sector_idx;
     int last_sector_idx;
     int last_idx_secondary_slot;
     uint32_t swap_idx;
+    uint32_t primary_slot_size;
+    uint32_t secondary_slot_size;
+#endif
     struct image_header *hdr;
     uint32_t size;
     uint32_t copy_size;
-    uint32_t primary_slot_size;
-    uint32_t secondary_slot_size;
     uint8_t image_index;
     int rc;
 
@@ -1553,6 +2287,13 @@ boot_swap_image(struct boot_loader_state *state, struct boot_status *bs)
         }
 
         bs->swap_size = copy_size;
+
+#ifdef MCUBOOT_ENC_IMAGES
+        rc = boot_enc_init_swap(state, bs, false);
+        if (rc != 0) {
+            return rc;
+        }
+#endif
     } else {
         /*
          * If a swap was under way, the swap_size should already be present
@@ -1562,8 +2303,19 @@ boot_swap_image(struct boot_loader_state *state, struct boot_status *bs)
         assert(rc == 0);
 
         copy_size = bs->swap_size;
+
+#ifdef MCUBOOT_ENC_IMAGES
+        /* ...and so should the encryption data of both images. */
+        rc = boot_enc_init_swap(state, bs, true);
+        if (rc != 0) {
+            return rc;
+        }
+#endif
     }
 
+#ifdef MCUBOOT_SWAP_USING_MOVE
+    boot_swap_run(state, bs, copy_size);
+#else
     primary_slot_size = 0;
     secondary_slot_size = 0;
     last_sector_idx = 0;
@@ -1607,6 +2359,7 @@ boot_swap_image(struct boot_loader_state *state, struct boot_status *bs)
         last_sector_idx = first_sector_idx - 1;
         swap_idx++;
     }
+#endif /* MCUBOOT_SWAP_USING_MOVE */
 
 #ifdef MCUBOOT_VALIDATE_PRIMARY_SLOT
     if (boot_status_fails > 0) {
@@ -1615,6 +2368,11 @@ boot_swap_image(struct boot_loader_state *state, struct boot_status *bs)
     }
 #endif
 
+#ifdef MCUBOOT_ENC_IMAGES
+    boot_enc_clear(image_index, BOOT_PRIMARY_SLOT);
+    boot_enc_clear(image_index, BOOT_SECONDARY_SLOT);
+#endif
+
     return 0;
 }
 #endif
@@ -1886,6 +2644,11 @@ boot_perform_update(struct boot_loader_state *state, struct boot_status *bs)
     uint8_t swap_type;
 #endif
 
+    /* The slots are rewritten, the manifest data read during their validation
+     * does not describe them any more.
+     */
+    bootutil_clear_img_manifest(BOOT_CURR_IMG(state));
+
     /* At this point there are no aborted swaps. */
 #if defined(MCUBOOT_OVERWRITE_ONLY)
     rc = boot_copy_image(state, bs);
@@ -1937,6 +2700,8 @@ boot_perform_update(struct boot_loader_state *state, struct boot_status *bs)
     }
 #endif /* !MCUBOOT_OVERWRITE_ONLY */
 
+    BOOT_TIME_RECORD(TFM_BOOT_TIME_BL2_UPDATE);
+
     return rc;
 }
 
@@ -1954,6 +2719,8 @@ boot_complete_partial_swap(struct boot_loader_state *state,
 {
     int rc;
 
+    bootutil_clear_img_manifest(BOOT_CURR_IMG(state));
+
     /* Determine the type of swap operation being resumed from the
      * `swap-type` trailer field.
      */
@@ -2065,6 +2832,7 @@ boot_prepare_image_for_update(struct boot_loader_state *state,
                               struct boot_status *bs)
 {
     int rc;
+    int hdr_rc;
 
     /* Determine the sector layout of the image slots and scratch area. */
     rc = boot_read_sectors(state);
@@ -2078,15 +2846,19 @@ boot_prepare_image_for_update(struct boot_loader_state *state,
         return;
     }
 
-    /* Attempt to read an image header from each slot. */
-    rc = boot_read_image_headers(state, false);
-    if (rc != 0) {
-        /* Continue with next image if there is one. */
-        BOOT_LOG_WRN("Failed reading image headers; Image=%u",
-                BOOT_CURR_IMG(state));
-        BOOT_SWAP_TYPE(state) = BOOT_SWAP_TYPE_NONE;
-        return;
-    }
+#ifdef MCUBOOT_DELTA_UPDATE
+    /* Replace a delta image in the secondary slot with the image it describes,
+     * before the headers are read. A failure leaves no image to install.
+     */
+    (void)boot_delta_update(BOOT_CURR_IMG(state));
+#endif
+
+    /* Attempt to read an image header from each slot. The header of the
+     * primary slot is not valid if the boot loader was reset while its first
+     * sector was being rewritten, so a failure is only reported if there is no
+     * partial swap to complete.
+     */
+    hdr_rc = boot_read_image_headers(state, false);
 
     /* If the current image's slots aren't compatible, no swap is possible.
      * Just boot into primary slot.
@@ -2130,6 +2902,11 @@ boot_prepare_image_for_update(struct boot_loader_state *state,
 
             /* Swap has finished set to NONE */
             BOOT_SWAP_TYPE(state) = BOOT_SWAP_TYPE_NONE;
+        } else if (hdr_rc != 0) {
+            /* Continue with next image if there is one. */
+            BOOT_LOG_WRN("Failed reading image headers; Image=%u",
+                    BOOT_CURR_IMG(state));
+            BOOT_SWAP_TYPE(state) = BOOT_SWAP_TYPE_NONE;
         } else {
             /* There was no partial swap, determine swap type. */
             if (bs->swap_type == BOOT_SWAP_TYPE_NONE) {
@@ -2362,6 +3139,7 @@ context_boot_go(struct boot_loader_state *state, struct boot_rsp *rsp)
                                    BOOT_IMG_AREA(state, BOOT_PRIMARY_SLOT)
                                   );
 #endif
+        BOOT_TIME_RECORD(TFM_BOOT_TIME_BL2_BOOT_STATUS);
         if (rc) {
             BOOT_LOG_ERR("Failed to add Image %u data to shared area",
                          BOOT_CURR_IMG(state));
@@ -2495,6 +3273,16 @@ boot_get_boot_sequence(struct boot_loader_state *state,
         }
 
         if (BOOT_IMG_HDR_IS_VALID(state, slot)) {
+#ifdef MCUBOOT_NO_SWAP_REVERT
+            if (slot_state.magic     == BOOT_MAGIC_GOOD &&
+                slot_state.image_ok  != BOOT_FLAG_SET &&
+                slot_state.copy_done == BOOT_FLAG_SET) {
+                /* The image was booted in test mode and didn't confirm */
+                BOOT_LOG_INF("Image %u: Not confirmed after its test boot, "
+                             "reverted", slot);
+                continue;
+            }
+#endif /* MCUBOOT_NO_SWAP_REVERT */
             if (slot_state.magic    == BOOT_MAGIC_GOOD ||
                 slot_state.image_ok == BOOT_FLAG_SET) {
                 /* Valid cases:
@@ -2526,6 +3314,54 @@ boot_get_boot_sequence(struct boot_loader_state *state,
     return image_cnt;
 }
 
+#ifdef MCUBOOT_NO_SWAP_REVERT
+/**
+ * Records in the image trailer that an image in test mode is being booted.
+ * The copy_done flag, otherwise unused without swapping, marks the test boot.
+ * Unless the image sets its image_ok flag before the next reset, it is not
+ * booted again and the older image in the other slot is booted instead.
+ *
+ * @param state           Boot loader status information.
+ * @param slot            The slot of the image about to be booted.
+ * @param is_test         Set to true if the image is booted in test mode.
+ *
+ * @return                0 on success; nonzero on failure.
+ */
+static int
+boot_no_swap_mark_test_boot(struct boot_loader_state *state, int slot,
+                            bool *is_test)
+{
+    const struct flash_area *fap = BOOT_IMG_AREA(state, slot);
+    struct boot_swap_state slot_state;
+    int rc;
+
+    *is_test = false;
+
+    rc = boot_read_swap_state(fap, &slot_state);
+    if (rc != 0) {
+        return BOOT_EFLASH;
+    }
+
+    if (slot_state.magic    != BOOT_MAGIC_GOOD ||
+        slot_state.image_ok == BOOT_FLAG_SET) {
+        /* A permanent image, nothing to revert */
+        return 0;
+    }
+
+    *is_test = true;
+
+    rc = boot_write_copy_done(fap);
+    if (rc != 0) {
+        return BOOT_EFLASH;
+    }
+
+    BOOT_LOG_INF("Image %u: Test boot, reverted on the next reset unless "
+                 "confirmed", slot);
+
+    return 0;
+}
+#endif /* MCUBOOT_NO_SWAP_REVERT */
+
 #ifdef MCUBOOT_RAM_LOADING
 
 /**
@@ -2563,6 +3399,9 @@ boot_verify_ram_loading_address(uint32_t img_dst, uint32_t img_sz)
  * Copies an image from a slot in the flash to an SRAM address, where the load
  * address has already been inserted into the image header by this point and is
  * extracted from it within this method. The copying is done sector-by-sector.
+ * Each sector is hashed right after it is copied, and the digest is handed
+ * over to the validation of the image, which then doesn't read the whole copy
+ * a second time.
  *
  * @param state           Boot loader status information.
  * @param slot            The flash slot of the image to be copied to SRAM.
@@ -2585,8 +3424,15 @@ boot_copy_image_to_sram(struct boot_loader_state *state, int slot,
     uint32_t sect_sz;
     uint32_t sect = 0;
     uint32_t bytes_copied = 0;
+    uint32_t bytes_hashed = 0;
+    uint32_t hash_sz;
+    uint32_t chunk_sz;
+    uint8_t hash[32];
+    bootutil_sha256_context sha256_ctx;
     const struct flash_area *fap_src = NULL;
 
+    bootutil_set_img_ram_hash(BOOT_CURR_IMG(state), hdr, NULL);
+
     if (img_dst % 4 != 0) {
         BOOT_LOG_INF("Cannot copy the image to the SRAM address 0x%x "
         "- the load address must be aligned with 4 bytes due to SRAM "
@@ -2599,6 +3445,10 @@ boot_copy_image_to_sram(struct boot_loader_state *state, int slot,
         return BOOT_EFLASH;
     }
 
+    /* The same range as bootutil_img_hash() */
+    hash_sz = BOOT_TLV_OFF(hdr) + hdr->ih_protect_tlv_size;
+    bootutil_sha256_init(&sha256_ctx);
+
     while (bytes_copied < img_sz) {
         sect_sz = boot_img_sector_size(state, slot, sect);
         /*
@@ -2616,6 +3466,24 @@ boot_copy_image_to_sram(struct boot_loader_state *state, int slot,
             bytes_copied += sect_sz;
         }
         sect++;
+
+        /*
+         * Hash the SRAM copy of the sector while it is still in the data
+         * cache, if any. The copy is what gets validated and booted.
+         */
+        if (bytes_hashed < hash_sz) {
+            chunk_sz = ((bytes_copied < hash_sz) ? bytes_copied : hash_sz) -
+                       bytes_hashed;
+            bootutil_sha256_update(&sha256_ctx,
+                                   (const void *)(img_dst + bytes_hashed),
+                                   chunk_sz);
+            bytes_hashed += chunk_sz;
+        }
+    }
+
+    if ((rc == 0) && (bytes_hashed == hash_sz)) {
+        bootutil_sha256_finish(&sha256_ctx, hash);
+        bootutil_set_img_ram_hash(BOOT_CURR_IMG(state), hdr, hash);
     }
 
     if (fap_src) {
@@ -2643,6 +3511,61 @@ boot_remove_image_from_sram(uint32_t img_dst, uint32_t img_sz)
 
     return 0;
 }
+
+#ifdef MCUBOOT_COMPRESSED_IMAGES
+/**
+ * Validates a compressed image in its slot in the flash, then decompresses it
+ * to its load address in SRAM. The decompressed image must have the same load
+ * address and header size as the compressed image.
+ *
+ * @param state           Boot loader status information.
+ * @param slot            The flash slot of the compressed image.
+ * @param hdr             Pointer to the image header structure of the
+ *                        compressed image.
+ *
+ * @return                0 on success; nonzero on failure.
+ */
+static int
+boot_decompress_image_to_sram(struct boot_loader_state *state, int slot,
+                              struct image_header *hdr)
+{
+    const struct flash_area *fap = BOOT_IMG_AREA(state, slot);
+    const struct image_header *ram_hdr;
+    struct boot_delta_dst dst;
+    uint32_t img_dst = hdr->ih_load_addr;
+    uint32_t img_sz;
+
+    if (boot_validate_slot(state, slot, NULL) != 0) {
+        return BOOT_EBADIMAGE;
+    }
+
+    if ((img_dst % 4 != 0) ||
+        (boot_compressed_image_size(hdr, fap, &img_sz) != 0) ||
+        (img_sz < sizeof(*ram_hdr)) ||
+        (boot_verify_ram_loading_address(img_dst, img_sz) != 0)) {
+        return BOOT_EBADIMAGE;
+    }
+
+    dst.fap = NULL;
+    dst.off = 0;
+    dst.ram = (uint8_t *)img_dst;
+    ram_hdr = (const struct image_header *)img_dst;
+    if ((boot_decompress_image(hdr, fap, &dst, img_sz) != 0) ||
+        (ram_hdr->ih_magic != IMAGE_MAGIC) ||
+        (ram_hdr->ih_load_addr != img_dst) ||
+        (ram_hdr->ih_hdr_size != hdr->ih_hdr_size)) {
+        boot_remove_image_from_sram(img_dst, img_sz);
+        return BOOT_EBADIMAGE;
+    }
+
+    BOOT_LOG_INF("Image has been decompressed from the %s slot in the flash "
+                 "to SRAM address 0x%x",
+                 (slot == BOOT_PRIMARY_SLOT) ? "primary" : "secondary",
+                 img_dst);
+
+    return 0;
+}
+#endif /* MCUBOOT_COMPRESSED_IMAGES */
 #endif /* MCUBOOT_RAM_LOADING */
 
 /**
@@ -2669,6 +3592,9 @@ context_boot_go(struct boot_loader_state *state, struct boot_rsp *rsp)
     uint32_t img_dst = 0;
     uint32_t img_sz  = 0;
 #endif /* MCUBOOT_RAM_LOADING */
+#ifdef MCUBOOT_NO_SWAP_REVERT
+    bool test_boot;
+#endif /* MCUBOOT_NO_SWAP_REVERT */
 
     static boot_sector_t primary_slot_sectors[BOOT_MAX_IMG_SECTORS];
     static boot_sector_t secondary_slot_sectors[BOOT_MAX_IMG_SECTORS];
@@ -2710,6 +3636,18 @@ context_boot_go(struct boot_loader_state *state, struct boot_rsp *rsp)
 #ifdef MCUBOOT_RAM_LOADING
             if (selected_image_header->ih_flags & IMAGE_F_RAM_LOAD) {
 
+#ifdef MCUBOOT_COMPRESSED_IMAGES
+                if (selected_image_header->ih_flags & IMAGE_F_COMPRESSED) {
+                    rc = boot_decompress_image_to_sram(state, slot,
+                                                   selected_image_header);
+                    if (rc == 0) {
+                        BOOT_TIME_RECORD(TFM_BOOT_TIME_BL2_RAM_LOAD);
+                        break;
+                    }
+                    continue;
+                }
+#endif /* MCUBOOT_COMPRESSED_IMAGES */
+
                 img_dst = selected_image_header->ih_load_addr;
 
                 rc = boot_read_image_size(state, slot, &img_sz);
@@ -2754,6 +3692,7 @@ context_boot_go(struct boot_loader_state *state, struct boot_rsp *rsp)
                                  "primary" : "secondary",
                                  selected_image_header->ih_load_addr);
                     image_copied = 1;
+                    BOOT_TIME_RECORD(TFM_BOOT_TIME_BL2_RAM_LOAD);
                 }
             } else {
                 /* Only images that support IMAGE_F_RAM_LOAD are allowed if
@@ -2787,17 +3726,28 @@ context_boot_go(struct boot_loader_state *state, struct boot_rsp *rsp)
             goto out;
         }
 
-        /* Update the security counter with the newest image's security
-         * counter value.
-         */
-        rc = boot_update_security_counter(BOOT_CURR_IMG(state), slot,
-                                          selected_image_header);
+#ifdef MCUBOOT_NO_SWAP_REVERT
+        rc = boot_no_swap_mark_test_boot(state, slot, &test_boot);
         if (rc != 0) {
-            BOOT_LOG_ERR("Security counter update failed after image "
-                         "validation.");
             goto out;
         }
 
+        /* The older image must still be bootable if the test boot fails */
+        if (!test_boot)
+#endif /* MCUBOOT_NO_SWAP_REVERT */
+        {
+            /* Update the security counter with the newest image's security
+             * counter value.
+             */
+            rc = boot_update_security_counter(BOOT_CURR_IMG(state), slot,
+                                              selected_image_header);
+            if (rc != 0) {
+                BOOT_LOG_ERR("Security counter update failed after image "
+                             "validation.");
+                goto out;
+            }
+        }
+
 
 #ifdef MCUBOOT_RAM_LOADING
         BOOT_LOG_INF("Booting image from SRAM at address 0x%x",
@@ -2820,6 +3770,7 @@ context_boot_go(struct boot_loader_state *state, struct boot_rsp *rsp)
     rc = boot_save_boot_status(SW_S_NS,
                                rsp->br_hdr,
                                BOOT_IMG_AREA(state, slot));
+    BOOT_TIME_RECORD(TFM_BOOT_TIME_BL2_BOOT_STATUS);
     if (rc) {
         BOOT_LOG_ERR("Failed to add data to shared area");
     }
@@ -1,7 +1,7 @@
 /*
  *  Minimal configuration for using TLS in the bootloader
  *
- *  Copyright (C) 2006-2019, Arm Limited. All rights reserved.
+ *  Copyright (C) 2006-2020, Arm Limited. All rights reserved.
  *  Copyright (C) 2016, Linaro Ltd
  *
  *  SPDX-License-Identifier: Apache-2.0
@@ -31,6 +31,8 @@
  * Minimal configuration for using TLS in the bootloader
  *
  * - RSA signature verification
+ * - ECDSA P-256 signature verification, if MCUBOOT_SIGN_EC256 is defined
+ * - AES key unwrapping and AES-CTR decryption, if MCUBOOT_ENC_IMAGES is defined
  */
 
 #ifndef MCUBOOT_MBEDTLS_CONFIG_RSA
@@ -46,8 +48,22 @@
 #define MBEDTLS_PLATFORM_EXIT_ALT
 #define MBEDTLS_PLATFORM_PRINTF_ALT
 
+#ifdef MCUBOOT_SIGN_EC256
+#define MBEDTLS_ECDSA_C
+#define MBEDTLS_ECP_C
+#define MBEDTLS_ECP_DP_SECP256R1_ENABLED
+#define MBEDTLS_ECP_NIST_OPTIM
+#else
 #define MBEDTLS_RSA_C
 #define MBEDTLS_PKCS1_V15
+#endif
+
+#ifdef MCUBOOT_ENC_IMAGES
+#define MBEDTLS_AES_C
+#define MBEDTLS_CIPHER_C
+#define MBEDTLS_CIPHER_MODE_CTR
+#define MBEDTLS_NIST_KW_C
+#endif
 
 /* mbed TLS modules */
 #define MBEDTLS_ASN1_PARSE_C
@@ -58,7 +74,9 @@
 #define MBEDTLS_SHA256_C
 
 /* Save RAM by adjusting to our exact needs */
-#if MCUBOOT_SIGN_RSA_LEN == 3072
+#if defined(MCUBOOT_SIGN_EC256)
+#define MBEDTLS_MPI_MAX_SIZE 64
+#elif MCUBOOT_SIGN_RSA_LEN == 3072
 #define MBEDTLS_MPI_MAX_SIZE 384
 #else /* RSA2048 */
 #define MBEDTLS_MPI_MAX_SIZE 256
@@ -83,6 +101,9 @@
 #include "mbedtls_accelerator_config.h"
 #endif
 
+/* Bignum kernels for the cores with the DSP extension */
+#include "tfm_mbedtls_bn_mul.h"
+
 #include "mbedtls/check_config.h"
 
 #endif /* MCUBOOT_MBEDTLS_CONFIG_RSA */
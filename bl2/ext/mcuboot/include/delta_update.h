@@ -0,0 +1,138 @@
+/*
+ *  Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ *  SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __DELTA_UPDATE_H__
+#define __DELTA_UPDATE_H__
+
+/**
+ * @file delta_update.h
+ *
+ * @note A delta image holds the changes between the image in the primary
+ *       slot, the base image, and a new signed image. It is written to the
+ *       secondary slot instead of the new image and is generated by the
+ *       "delta" command of imgtool.py. The bootloader rebuilds the new image
+ *       in the scratch area from the base image and the delta image, checks
+ *       its hash, then copies it to the secondary slot, from where it is
+ *       validated and installed like a full image.
+ *
+ *       The delta image is a boot_delta_header followed by a sequence of
+ *       commands. Each command is an opcode byte followed by its arguments,
+ *       which are LEB128 encoded unsigned integers:
+ *       - BOOT_DELTA_OP_LITERAL, length: the next length bytes of the delta
+ *         image are added to the new image.
+ *       - BOOT_DELTA_OP_COPY_BASE, length, offset: length bytes of the base
+ *         image are added to the new image. The offset of the bytes in the
+ *         base image, relative to the current size of the new image, is
+ *         zigzag encoded.
+ *       - BOOT_DELTA_OP_COPY_NEW, length, distance: length bytes of the new
+ *         image, starting distance bytes before its end, are added to it.
+ *
+ *       A compressed image, generated by the "sign --compress" command of
+ *       imgtool.py, is a signed image with the IMAGE_F_COMPRESSED flag whose
+ *       body is a delta image without base image: its base_hash is all zeros
+ *       and it does not use BOOT_DELTA_OP_COPY_BASE. The body decompresses to
+ *       the signed image which is run.
+ */
+
+#include <stdint.h>
+#include "bootutil/image.h"
+#include "flash_map/flash_map.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BOOT_DELTA_MAGIC            0xd3e1a5c4
+
+#define BOOT_DELTA_OP_LITERAL       0x00
+#define BOOT_DELTA_OP_COPY_BASE     0x01
+#define BOOT_DELTA_OP_COPY_NEW      0x02
+
+/** Header of a delta image */
+struct boot_delta_header {
+    uint32_t magic;             /* BOOT_DELTA_MAGIC */
+    uint32_t hdr_size;          /* Size of this header */
+    uint32_t patch_size;        /* Size of the commands after the header */
+    uint32_t image_size;        /* Size of the new image */
+    uint8_t base_hash[32];      /* SHA256 TLV of the base image */
+    uint8_t image_hash[32];     /* SHA256 of the whole new image */
+};
+
+/** Destination of an image rebuilt from a delta image */
+struct boot_delta_dst {
+    const struct flash_area *fap;   /* Erased flash area, or NULL for RAM */
+    uint32_t off;                   /* Offset of the image in the area */
+    uint8_t *ram;                   /* Address of the image if fap is NULL */
+};
+
+/**
+ * Rebuilds the image described by a delta image and checks its SHA-256.
+ *
+ * @param hdr               Header of the delta image.
+ * @param fap_base          Flash area of the base image, or NULL if the
+ *                          delta image has no base image.
+ * @param fap_src           Flash area of the delta image.
+ * @param src_off           Offset of the delta image in fap_src.
+ * @param dst               Destination of the rebuilt image, large enough to
+ *                          hold it.
+ *
+ * @return                  0 on success; nonzero on failure.
+ */
+int32_t boot_delta_decode(const struct boot_delta_header *hdr,
+                          const struct flash_area *fap_base,
+                          const struct flash_area *fap_src, uint32_t src_off,
+                          const struct boot_delta_dst *dst);
+
+/**
+ * Replaces the delta image in the secondary slot with the new image it
+ * describes, if the secondary slot is marked for an upgrade. Also completes
+ * the copy of a new image to the secondary slot which was interrupted by a
+ * reset.
+ *
+ * A delta image which does not apply to the image in the primary slot, or
+ * which does not produce the expected image, is erased.
+ *
+ * @param image_index       Index of the image (from 0).
+ *
+ * @return                  0 on success or if there is nothing to do;
+ *                          nonzero on failure.
+ */
+int32_t boot_delta_update(uint8_t image_index);
+
+/**
+ * Reads the size of the image a compressed image decompresses to.
+ *
+ * @param hdr               Header of the compressed image.
+ * @param fap               Flash area of the compressed image.
+ * @param size              Pointer to store the size of the image.
+ *
+ * @return                  0 on success; nonzero on failure.
+ */
+int32_t boot_compressed_image_size(const struct image_header *hdr,
+                                   const struct flash_area *fap,
+                                   uint32_t *size);
+
+/**
+ * Decompresses a compressed image and checks the SHA-256 of the output. The
+ * compressed image must have been validated.
+ *
+ * @param hdr               Header of the compressed image.
+ * @param fap               Flash area of the compressed image.
+ * @param dst               Destination of the decompressed image.
+ * @param dst_size          Size available at the destination.
+ *
+ * @return                  0 on success; nonzero on failure.
+ */
+int32_t boot_decompress_image(const struct image_header *hdr,
+                              const struct flash_area *fap,
+                              const struct boot_delta_dst *dst,
+                              uint32_t dst_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __DELTA_UPDATE_H__ */
@@ -0,0 +1,63 @@
+/*
+ *  Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ *  SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __VALIDATION_CACHE_H__
+#define __VALIDATION_CACHE_H__
+
+/**
+ * @file validation_cache.h
+ *
+ * @note The validation cache lets the bootloader skip the full hash and
+ *       signature check of an image in the primary slot which has not changed
+ *       since its last full validation. An image is considered unchanged if
+ *       the fingerprint of its header and TLV area, the flash write counter of
+ *       the platform and the image's stored security counter all match the
+ *       validation record, see the boot_platform_*_validation_record()
+ *       functions of boot_hal.h. The full validation is still forced after
+ *       MCUBOOT_VALIDATION_CACHE_MAX_SKIP boots.
+ */
+
+#include <stdint.h>
+#include "bootutil/image.h"
+#include "flash_map/flash_map.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Checks whether the image has not changed since its last full validation,
+ * and counts the boot on which the validation is skipped.
+ *
+ * @param image_id          Index of the image (from 0).
+ * @param hdr               Pointer to the header of the image.
+ * @param fap               Flash area of the image.
+ *
+ * @return                  0 if the full validation can be skipped; nonzero
+ *                          if the image must be fully validated.
+ */
+int32_t boot_validation_cache_check(uint32_t image_id,
+                                    const struct image_header *hdr,
+                                    const struct flash_area *fap);
+
+/**
+ * Records that the image has been fully validated.
+ *
+ * @param image_id          Index of the image (from 0).
+ * @param hdr               Pointer to the header of the image.
+ * @param fap               Flash area of the image.
+ *
+ * @return                  0 on success; nonzero on failure.
+ */
+int32_t boot_validation_cache_update(uint32_t image_id,
+                                     const struct image_header *hdr,
+                                     const struct flash_area *fap);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __VALIDATION_CACHE_H__ */
@@ -0,0 +1,56 @@
+/*
+ *  Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ *  SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __WARM_BOOT_H__
+#define __WARM_BOOT_H__
+
+/**
+ * @file warm_boot.h
+ *
+ * @note The warm boot cache lets the bootloader boot the image of the
+ *       previous boot right after a warm reset, without reading the image
+ *       headers, validating the images or generating the boot records again.
+ *       The boot response and the boot records of the shared data area are
+ *       kept in a retained RAM area, see boot_platform_get_retained_area() in
+ *       boot_hal.h, together with the flash write counter and the stored
+ *       security counters of the images. The record is only used after a warm
+ *       reset, if its digest is intact and all counters still match.
+ */
+
+#include <stdint.h>
+#include "bootutil/bootutil.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Loads the boot response of the previous boot, and restores the boot records
+ * of the shared data area, if the last reset was a warm reset and nothing
+ * has changed since the previous boot. Otherwise the record is invalidated.
+ *
+ * @param rsp               Pointer to store the boot response.
+ *
+ * @return                  0 if the image can be booted with the loaded boot
+ *                          response; nonzero if the boot sequence must run.
+ */
+int32_t boot_warm_boot_load(struct boot_rsp *rsp);
+
+/**
+ * Saves the boot response and the boot records of the shared data area of a
+ * completed boot sequence, to be used after the next warm reset.
+ *
+ * @param rsp               Pointer to the boot response.
+ *
+ * @return                  0 on success; nonzero on failure.
+ */
+int32_t boot_warm_boot_save(const struct boot_rsp *rsp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __WARM_BOOT_H__ */
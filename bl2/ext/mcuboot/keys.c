@@ -21,7 +21,7 @@
  * Original code taken from mcuboot project at:
  * https://github.com/JuulLabs-OSS/mcuboot
  * Git SHA of the original version: ac55554059147fff718015be9f4bd3108123f50a
- * Modifications are Copyright (c) 2019 Arm Limited.
+ * Modifications are Copyright (c) 2019-2020 Arm Limited.
  */
 
 #include <bootutil/sign_key.h>
@@ -217,12 +217,47 @@ const unsigned char rsa_pub_key_1[] = {
 const unsigned int rsa_pub_key_len_1 = 398;
 #endif
 #endif
+#elif defined(MCUBOOT_SIGN_EC256)
+#define HAVE_KEYS
+const unsigned char ecdsa_pub_key[] = {
+    0x30, 0x59, 0x30, 0x13, 0x06, 0x07, 0x2a, 0x86,
+    0x48, 0xce, 0x3d, 0x02, 0x01, 0x06, 0x08, 0x2a,
+    0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07, 0x03,
+    0x42, 0x00, 0x04, 0xbb, 0x01, 0x50, 0x41, 0x0b,
+    0x99, 0x8e, 0x54, 0x8f, 0xe8, 0x39, 0xd2, 0xe3,
+    0xb4, 0x8e, 0x83, 0x45, 0x44, 0x53, 0xa5, 0x17,
+    0x88, 0x3b, 0x8f, 0xe1, 0x65, 0xb9, 0x51, 0xb9,
+    0x57, 0xec, 0x97, 0x31, 0xbd, 0xea, 0x80, 0x4c,
+    0xfa, 0x6f, 0x0a, 0x09, 0x48, 0x6d, 0x17, 0x4c,
+    0x9e, 0x07, 0x89, 0xf7, 0x34, 0xf2, 0x6f, 0x4f,
+    0xb3, 0x3b, 0x56, 0x08, 0xdd, 0x81, 0xaa, 0xf9,
+    0xa4, 0x22, 0x9e,
+};
+const unsigned int ecdsa_pub_key_len = 91;
+#if (MCUBOOT_IMAGE_NUMBER == 2)
+const unsigned char ecdsa_pub_key_1[] = {
+    0x30, 0x59, 0x30, 0x13, 0x06, 0x07, 0x2a, 0x86,
+    0x48, 0xce, 0x3d, 0x02, 0x01, 0x06, 0x08, 0x2a,
+    0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07, 0x03,
+    0x42, 0x00, 0x04, 0x99, 0xdd, 0xf1, 0x2e, 0xd4,
+    0x05, 0x84, 0x88, 0x21, 0xcd, 0x30, 0x00, 0x8b,
+    0x89, 0x24, 0x92, 0x5e, 0x10, 0x79, 0x91, 0x78,
+    0xd3, 0xb4, 0xea, 0xde, 0x69, 0x14, 0x66, 0x61,
+    0x7a, 0x30, 0xd1, 0xb7, 0xde, 0xca, 0x6c, 0x37,
+    0xb7, 0x63, 0x46, 0xfd, 0x39, 0xe3, 0x2a, 0xe4,
+    0x2a, 0xcc, 0xa5, 0x04, 0x31, 0x15, 0xab, 0x2e,
+    0x42, 0x98, 0x59, 0x42, 0x36, 0xeb, 0x12, 0x0c,
+    0x62, 0x77, 0xcd,
+};
+const unsigned int ecdsa_pub_key_len_1 = 91;
+#endif
 #else
 #error "No public key available for given signing algorithm."
 #endif
 
 #if defined(HAVE_KEYS)
 const struct bootutil_key bootutil_keys[] = {
+#if defined(MCUBOOT_SIGN_RSA)
     {
         .key = rsa_pub_key,
         .len = &rsa_pub_key_len,
@@ -233,6 +268,18 @@ const struct bootutil_key bootutil_keys[] = {
         .len = &rsa_pub_key_len_1,
     },
 #endif
+#else /* MCUBOOT_SIGN_EC256 */
+    {
+        .key = ecdsa_pub_key,
+        .len = &ecdsa_pub_key_len,
+    },
+#if (MCUBOOT_IMAGE_NUMBER == 2)
+    {
+        .key = ecdsa_pub_key_1,
+        .len = &ecdsa_pub_key_len_1,
+    },
+#endif
+#endif /* MCUBOOT_SIGN_RSA */
 };
 const int bootutil_key_cnt = MCUBOOT_IMAGE_NUMBER;
 #endif /* HAVE_KEYS */
@@ -1,7 +1,7 @@
 #! /usr/bin/env python3
 #
 # Copyright 2017 Linaro Limited
-# Copyright (c) 2018-2019, Arm Limited.
+# Copyright (c) 2018-2020, Arm Limited.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -19,9 +19,11 @@ from __future__ import print_function
 import os
 import re
 import argparse
+import base64
 from imgtool_lib import keys
 from imgtool_lib import image
 from imgtool_lib import version
+from imgtool_lib import delta
 import sys
 import macro_parser
 
@@ -70,9 +72,13 @@ def gen_rsa2048(args):
 def gen_rsa3072(args):
     keys.RSAutil.generate(key_size=3072).export_private(args.key)
 
+def gen_ecdsa_p256(args):
+    keys.ECDSA256P1.generate().export_private(args.key)
+
 keygens = {
         'rsa-2048': gen_rsa2048,
-        'rsa-3072': gen_rsa3072, }
+        'rsa-3072': gen_rsa3072,
+        'ecdsa-p256': gen_ecdsa_p256, }
 
 def do_keygen(args):
     if args.type not in keygens:
@@ -110,26 +116,70 @@ def do_sign(args):
     else:
         sw_type = "NSPE_SPE"
 
+    if args.encrypt and args.compress:
+        raise argparse.ArgumentTypeError("--encrypt cannot be used with "
+                                         "--compress")
+    enckey = None
+    if args.encrypt:
+        with open(args.encrypt, 'r') as f:
+            enckey = base64.b64decode(f.read())
+
     pad_size = macro_parser.evaluate_macro(args.layout, sign_bin_size_re, 0, 1)
     img = image.Image.load(args.infile,
                            version=version_num,
                            header_size=args.header_size,
                            security_cnt=args.security_counter,
                            included_header=args.included_header,
-                           pad=pad_size)
+                           pad=pad_size,
+                           enckey=enckey)
     key = keys.load(args.key, args.public_key_format) if args.key else None
     ram_load_address = macro_parser.evaluate_macro(args.layout, image_load_address_re, 0, 1)
     img.sign(sw_type, key, ram_load_address, args.dependencies)
 
+    if args.compress:
+        # The compressed image is signed as well, with the version, security
+        # counter and dependencies of the image it decompresses to.
+        body = delta.compress(img.payload)
+        img = image.Image(version=version_num,
+                          header_size=args.header_size,
+                          security_cnt=args.security_counter,
+                          pad=pad_size,
+                          compressed=True)
+        img.payload = bytes(img.header_size) + body
+        img.sign(sw_type, key, ram_load_address, args.dependencies)
+        print("**[INFO]** Compressed image size: {} bytes".format(
+              len(img.payload)))
+
     if pad_size:
         img.pad_to(pad_size, args.align)
 
     img.save(args.outfile)
 
+def do_delta(args):
+    with open(args.base, 'rb') as f:
+        base = f.read()
+    with open(args.infile, 'rb') as f:
+        new = f.read()
+
+    img = image.Image(version=None)
+    img.payload = delta.generate(base, new)
+    print("**[INFO]** Delta image size: {} bytes".format(len(img.payload)))
+
+    if args.layout:
+        if args.align is None:
+            raise argparse.ArgumentTypeError("--align is needed with --layout")
+        pad_size = macro_parser.evaluate_macro(args.layout, sign_bin_size_re,
+                                               0, 1)
+        if pad_size:
+            img.pad_to(pad_size, args.align)
+
+    img.save(args.outfile)
+
 subcmds = {
         'keygen': do_keygen,
         'getpub': do_getpub,
-        'sign': do_sign, }
+        'sign': do_sign,
+        'delta': do_delta, }
 
 
 def get_dependencies(text):
@@ -202,9 +252,26 @@ def args():
     sign.add_argument("--rsa-pkcs1-15",
                       help='Use old PKCS#1 v1.5 signature algorithm',
                       default=False, action='store_true')
+    sign.add_argument("--compress", default=False, action='store_true',
+                      help='Output a compressed image, which the bootloader '
+                           'decompresses to the primary slot or to RAM')
+    sign.add_argument("-E", "--encrypt", metavar='filename',
+                      help='Encrypt the image body with a random key, wrapped '
+                           'with the base64 encoded AES-128 key encryption '
+                           'key in this file')
     sign.add_argument("infile")
     sign.add_argument("outfile")
 
+    deltap = subs.add_parser('delta', help='Generate the delta image which '
+                             'updates a base signed image to a new one')
+    deltap.add_argument('-l', '--layout',
+                        help='Location of the file that contains preprocessed '
+                             'macros, to pad the delta image to the slot size')
+    deltap.add_argument("--align", type=alignment_value)
+    deltap.add_argument("base", help='Signed image in the primary slot')
+    deltap.add_argument("infile", help='New signed image')
+    deltap.add_argument("outfile")
+
     args = parser.parse_args()
     if args.subcmd is None:
         print('Must specify a subcommand', file=sys.stderr)
@@ -0,0 +1,190 @@
+# Copyright (c) 2020, Arm Limited.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+Generates the delta images, which hold the changes between the signed image in
+the primary slot, the base image, and a new signed image. The format is
+described in bl2/ext/mcuboot/include/delta_update.h. The same encoding,
+without base image, compresses the signed images.
+
+The new image is encoded as literal bytes and as copies of the byte sequences
+it shares with the base image, or with its own start. The base image acts as
+the dictionary of the encoding, so the size of the delta image depends on how
+much of the code is unchanged.
+"""
+
+import hashlib
+import struct
+from . import image
+
+DELTA_MAGIC = 0xd3e1a5c4
+DELTA_HEADER_SIZE = 80
+
+OP_LITERAL = 0x00
+OP_COPY_BASE = 0x01
+OP_COPY_NEW = 0x02
+
+# Number of bytes which identify a candidate match
+KEY_SIZE = 8
+# Shortest copy worth a command
+MIN_MATCH = 8
+# Number of candidate positions kept for each key
+MAX_CANDIDATES = 8
+
+
+def signed_image(data):
+    """
+    Returns the signed image at the start of data, without the padding and
+    the trailer, and the payload of its SHA256 TLV.
+    """
+    magic, _, hdr_size, prot_tlv_size, img_size = \
+        struct.unpack_from('<IIHHI', data, 0)
+    if magic != image.IMAGE_MAGIC:
+        raise Exception("Not a signed image")
+
+    tlv_off = hdr_size + img_size + prot_tlv_size
+    info_magic, tlv_tot = struct.unpack_from('<HH', data, tlv_off)
+    if info_magic != image.TLV_INFO_MAGIC:
+        raise Exception("The image has no TLV area")
+
+    sha256 = None
+    pos = tlv_off + image.TLV_INFO_SIZE
+    while pos < tlv_off + tlv_tot:
+        kind, _, length = struct.unpack_from('<BBH', data, pos)
+        if kind == image.TLV_VALUES['SHA256']:
+            sha256 = bytes(data[pos + image.TLV_HEADER_SIZE:
+                                pos + image.TLV_HEADER_SIZE + length])
+        pos += image.TLV_HEADER_SIZE + length
+    if sha256 is None or len(sha256) != image.PAYLOAD_DIGEST_SIZE:
+        raise Exception("The image has no SHA256 TLV")
+
+    return bytes(data[:tlv_off + tlv_tot]), sha256
+
+
+def encode_uint(value):
+    """LEB128 encoding of an unsigned integer."""
+    out = bytearray()
+    while True:
+        byte = value & 0x7F
+        value >>= 7
+        if value == 0:
+            out.append(byte)
+            return out
+        out.append(byte | 0x80)
+
+
+def encode_int(value):
+    """Zigzag encoding of a signed integer, followed by LEB128 encoding."""
+    return encode_uint((value << 1) if value >= 0 else ((-value << 1) - 1))
+
+
+def match_len(src, src_pos, dst, dst_pos):
+    n = 0
+    limit = min(len(src) - src_pos, len(dst) - dst_pos)
+    # Compare blocks first, as most of the matches are long
+    while n + 64 <= limit and \
+            src[src_pos + n:src_pos + n + 64] == dst[dst_pos + n:dst_pos + n + 64]:
+        n += 64
+    while n < limit and src[src_pos + n] == dst[dst_pos + n]:
+        n += 1
+    return n
+
+
+def add_candidate(index, key, pos):
+    candidates = index.setdefault(key, [])
+    if len(candidates) == MAX_CANDIDATES:
+        candidates.pop(0)
+    candidates.append(pos)
+
+
+def encode(base, new):
+    """
+    Returns the commands which rebuild new from base, which can be empty.
+    """
+    base_index = {}
+    for pos in range(len(base) - KEY_SIZE + 1):
+        add_candidate(base_index, base[pos:pos + KEY_SIZE], pos)
+    new_index = {}
+    indexed = 0
+
+    patch = bytearray()
+    literal = bytearray()
+    pos = 0
+    while pos < len(new):
+        # Index the positions of the new image which are already encoded
+        while indexed + KEY_SIZE <= pos:
+            add_candidate(new_index, new[indexed:indexed + KEY_SIZE], indexed)
+            indexed += 1
+
+        key = new[pos:pos + KEY_SIZE]
+        best = (0, None, None)
+        if len(key) == KEY_SIZE:
+            for src_pos in base_index.get(key, []):
+                n = match_len(base, src_pos, new, pos)
+                # Prefer the closest match, its offset is shorter
+                if n > best[0] or (n == best[0] and
+                                   abs(src_pos - pos) < abs(best[2] - pos)):
+                    best = (n, OP_COPY_BASE, src_pos)
+            for src_pos in new_index.get(key, []):
+                n = match_len(new, src_pos, new, pos)
+                if n > best[0]:
+                    best = (n, OP_COPY_NEW, src_pos)
+
+        length, op, src_pos = best
+        if length < MIN_MATCH:
+            literal.append(new[pos])
+            pos += 1
+            continue
+
+        if literal:
+            patch += bytes([OP_LITERAL]) + encode_uint(len(literal)) + literal
+            literal = bytearray()
+        patch += bytes([op]) + encode_uint(length)
+        if op == OP_COPY_BASE:
+            patch += encode_int(src_pos - pos)
+        else:
+            patch += encode_uint(pos - src_pos)
+        pos += length
+
+    if literal:
+        patch += bytes([OP_LITERAL]) + encode_uint(len(literal)) + literal
+
+    return bytes(patch)
+
+
+def delta_image(base_hash, new, patch):
+    header = struct.pack('<IIII', DELTA_MAGIC, DELTA_HEADER_SIZE, len(patch),
+                         len(new))
+    header += base_hash + hashlib.sha256(new).digest()
+    return header + patch
+
+
+def generate(base, new):
+    """
+    Returns the delta image which rebuilds the new signed image from the base
+    signed image. Both can be padded to the slot size.
+    """
+    base, base_hash = signed_image(base)
+    new, _ = signed_image(new)
+
+    return delta_image(base_hash, new, encode(base, new))
+
+
+def compress(new):
+    """
+    Returns the body of the compressed image of a signed image: a delta image
+    without base image.
+    """
+    return delta_image(bytes(image.PAYLOAD_DIGEST_SIZE), new,
+                       encode(b'', new))
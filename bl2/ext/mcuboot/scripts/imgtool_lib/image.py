@@ -1,5 +1,5 @@
 # Copyright 2017 Linaro Limited
-# Copyright (c) 2018-2019, Arm Limited.
+# Copyright (c) 2018-2020, Arm Limited.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -19,7 +19,11 @@ Image signing and management.
 
 from . import version as versmod
 from . import boot_record as br
+from cryptography.hazmat.backends import default_backend
+from cryptography.hazmat.primitives.ciphers import Cipher, algorithms, modes
+from cryptography.hazmat.primitives.keywrap import aes_key_wrap
 import hashlib
+import os
 import struct
 
 IMAGE_MAGIC = 0x96f3b83d
@@ -33,14 +37,18 @@ DEP_VERSIONS_KEY = "versions"
 # Image header flags.
 IMAGE_F = {
         'PIC':                   0x0000001,
+        'ENCRYPTED':             0x0000004,
         'NON_BOOTABLE':          0x0000010,
-        'RAM_LOAD':              0x0000020, }
+        'RAM_LOAD':              0x0000020,
+        'COMPRESSED':            0x0000040, }
 TLV_VALUES = {
         'KEYHASH': 0x01,
         'KEY'    : 0x02,
         'SHA256' : 0x10,
         'RSA2048': 0x20,
+        'ECDSA256': 0x22,
         'RSA3072': 0x23,
+        'ENC_KW128': 0x31,
         'DEPENDENCY': 0x40,
         'SEC_CNT': 0x50,
         'BOOT_RECORD': 0x60, }
@@ -55,6 +63,10 @@ trailer_sizes = {
     for write_size in [1, 2, 4, 8]
 }
 
+# Size of the encryption data of both slots in the trailer of encrypted images
+ENC_TRAILER_SIZE = 2 * 32
+ENC_KEY_SIZE = 16
+
 boot_magic = bytearray([
     0x77, 0xc2, 0x95, 0xf3,
     0x60, 0xd2, 0xef, 0x7f,
@@ -100,11 +112,13 @@ class Image():
         return obj
 
     def __init__(self, version, header_size=IMAGE_HEADER_SIZE, security_cnt=0,
-                 pad=0):
+                 pad=0, compressed=False, enckey=None):
         self.version = version
         self.header_size = header_size or IMAGE_HEADER_SIZE
         self.security_cnt = security_cnt
         self.pad = pad
+        self.compressed = compressed
+        self.enckey = enckey
 
     def __repr__(self):
         return "<Image version={}, header_size={}, security_counter={}, \
@@ -169,6 +183,8 @@ class Image():
             dependencies_num = len(dependencies[DEP_IMAGES_KEY])
             protected_tlv_size += (dependencies_num * 16)
 
+        img_size = len(self.payload) - self.header_size
+
         # At this point the image is already on the payload, this adds
         # the header to the payload as well
         self.add_header(key, protected_tlv_size, ramLoadAddress)
@@ -212,6 +228,20 @@ class Image():
             sig = key.sign(self.payload)
             tlv.add(key.sig_tlv(), sig)
 
+        if self.enckey is not None:
+            # The body is encrypted with a random key after the image is
+            # hashed and signed, the bootloader decrypts it to validate it.
+            plainkey = os.urandom(ENC_KEY_SIZE)
+            tlv.add('ENC_KW128', aes_key_wrap(self.enckey, plainkey,
+                                              default_backend()))
+            cipher = Cipher(algorithms.AES(plainkey), modes.CTR(bytes(16)),
+                            backend=default_backend())
+            encryptor = cipher.encryptor()
+            body_end = self.header_size + img_size
+            self.payload[self.header_size:body_end] = \
+                encryptor.update(bytes(self.payload[self.header_size:body_end]))\
+                + encryptor.finalize()
+
         self.payload += tlv.get()
 
     def add_header(self, key, protected_tlv_size, ramLoadAddress):
@@ -225,6 +255,11 @@ class Image():
             # add the load address flag to the header to indicate that an SRAM
             # load address macro has been defined
             flags |= IMAGE_F["RAM_LOAD"]
+        if self.compressed:
+            # the image body is a compressed image, see delta.py
+            flags |= IMAGE_F["COMPRESSED"]
+        if self.enckey is not None:
+            flags |= IMAGE_F["ENCRYPTED"]
 
         fmt = ('<' +
             # type ImageHdr struct {
@@ -256,6 +291,8 @@ class Image():
     def pad_to(self, size, align):
         """Pad the image to the given size, with the given flash alignment."""
         tsize = trailer_sizes[align]
+        if self.enckey is not None:
+            tsize += ENC_TRAILER_SIZE
         padding = size - (len(self.payload) + tsize)
         if padding < 0:
             msg = "Image size (0x{:x}) + trailer (0x{:x}) exceeds requested size 0x{:x}".format(
@@ -1,5 +1,5 @@
 # Copyright (c) 2017,2019 Linaro Limited.
-# Copyright (c) 2017-2019, Arm Limited.
+# Copyright (c) 2017-2020, Arm Limited.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -21,7 +21,7 @@ from __future__ import print_function
 from cryptography.hazmat.backends import default_backend
 from cryptography.hazmat.primitives import serialization
 from cryptography.hazmat.primitives.hashes import SHA256
-from cryptography.hazmat.primitives.asymmetric import rsa
+from cryptography.hazmat.primitives.asymmetric import rsa, ec
 from cryptography.hazmat.primitives.asymmetric.padding import PSS, PKCS1v15
 from cryptography.hazmat.primitives.asymmetric.padding import MGF1
 import hashlib
@@ -43,6 +43,9 @@ AUTOGEN_MESSAGE = "/* Autogenerated by imgtool.py, do not edit. */"
 class RSAUsageError(Exception):
     pass
 
+class ECDSAUsageError(Exception):
+    pass
+
 class RSAutil():
     def __init__(self, key, public_key_format='hash'):
         """Construct an RSA key with the given key data"""
@@ -122,6 +125,69 @@ class RSAutil():
         assert len(signature) == self.sig_len()
         return signature
 
+class ECDSA256P1():
+    def __init__(self, key, public_key_format='hash'):
+        """Construct an ECDSA P-256 key with the given key data"""
+        self.key = key
+        self.public_key_format = public_key_format
+
+    def key_size(self):
+        return self.key.key_size
+
+    def get_public_key_format(self):
+        return self.public_key_format
+
+    @staticmethod
+    def generate():
+        return ECDSA256P1(ec.generate_private_key(
+                ec.SECP256R1(),
+                backend=default_backend()))
+
+    def export_private(self, path):
+        with open(path, 'wb') as f:
+            f.write(self.key.private_bytes(
+                    encoding=serialization.Encoding.PEM,
+                    format=serialization.PrivateFormat.TraditionalOpenSSL,
+                    encryption_algorithm=serialization.NoEncryption()))
+
+    def get_public_bytes(self):
+        # BL2 parses the SubjectPublicKeyInfo, which names the curve
+        return self.key.public_key().public_bytes(
+                encoding=serialization.Encoding.DER,
+                format=serialization.PublicFormat.SubjectPublicKeyInfo)
+
+    def emit_c(self):
+        print(AUTOGEN_MESSAGE)
+        print("const unsigned char ecdsa_pub_key[] = {", end='')
+        encoded = self.get_public_bytes()
+        for count, b in enumerate(encoded):
+            if count % 8 == 0:
+                print("\n\t", end='')
+            else:
+                print(" ", end='')
+            print("0x{:02x},".format(b), end='')
+        print("\n};")
+        print("const unsigned int ecdsa_pub_key_len = {};".format(len(encoded)))
+
+    def sig_type(self):
+        """Return the type of this signature (as a string)"""
+        return "ECDSA256_SHA256"
+
+    def sig_len(self):
+        # The DER encoding of the signature is 70 to 72 bytes long
+        return 72
+
+    def sig_tlv(self):
+        return "ECDSA256"
+
+    def sign(self, payload):
+        signature = self.key.sign(
+            data=payload,
+            signature_algorithm=ec.ECDSA(SHA256())
+        )
+        assert len(signature) <= self.sig_len()
+        return signature
+
 def load(path, public_key_format='hash'):
     with open(path, 'rb') as f:
         pem = f.read()
@@ -131,6 +197,13 @@ def load(path, public_key_format='hash'):
             password=None,
             backend=default_backend()
         )
-        return RSAutil(key, public_key_format)
     except ValueError:
-        raise Exception("Unsupported RSA key file")
+        raise Exception("Unsupported key file")
+    if isinstance(key, rsa.RSAPrivateKey):
+        return RSAutil(key, public_key_format)
+    if isinstance(key, ec.EllipticCurvePrivateKey):
+        if key.curve.name != 'secp256r1':
+            raise ECDSAUsageError("Curve {} is not supported by MCUboot"
+                                  .format(key.curve.name))
+        return ECDSA256P1(key, public_key_format)
+    raise Exception("Unsupported key file")
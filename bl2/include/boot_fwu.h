@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __BOOT_FWU_H__
+#define __BOOT_FWU_H__
+
+/* Include header section */
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Magic number of the image trailer, which marks the image of a secondary
+ * slot for installation. Copy of the boot_img_magic of MCUBoot.
+ */
+#define BOOT_FWU_TRAILER_MAGIC  { 0xf395c277U, 0x7fefd260U, \
+                                  0x0f505235U, 0x8079b62cU }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BOOT_FWU_H__ */
@@ -9,6 +9,7 @@
 #define __BOOT_HAL_H__
 
 /* Include header section */
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -40,6 +41,88 @@ void boot_clear_bl2_ram_area(void);
  */
 int32_t boot_platform_init(void);
 
+#ifdef MCUBOOT_VALIDATION_CACHE
+/**
+ * \brief Record of the last full validation of the image in a primary slot
+ */
+struct boot_validation_record {
+    uint8_t  fingerprint[32];  /*!< SHA-256 of the image header and TLV area */
+    uint32_t flash_write_cnt;  /*!< Flash write counter at validation time */
+    uint32_t security_cnt;     /*!< Stored security counter of the image */
+    uint32_t skip_cnt;         /*!< Boots which skipped the full validation */
+};
+
+/**
+ * \brief Reads the validation record of an image.
+ *
+ * \note  The record must be stored where only the bootloader can write it,
+ *        e.g. in a flash area locked before the secure image is started. The
+ *        platform must discard the records on tamper events, so that the
+ *        images are fully validated again.
+ *
+ * \param[in]  image_id  Index of the image (from 0)
+ * \param[out] record    Pointer to store the record
+ *
+ * \return Returns 0 on success, non-zero if there is no valid record
+ */
+int32_t boot_platform_read_validation_record(uint32_t image_id,
+                                     struct boot_validation_record *record);
+
+/**
+ * \brief Writes the validation record of an image.
+ *
+ * \param[in] image_id  Index of the image (from 0)
+ * \param[in] record    Pointer to the record
+ *
+ * \return Returns 0 on success, non-zero otherwise
+ */
+int32_t boot_platform_write_validation_record(uint32_t image_id,
+                               const struct boot_validation_record *record);
+#endif /* MCUBOOT_VALIDATION_CACHE */
+
+#if defined(MCUBOOT_VALIDATION_CACHE) || defined(MCUBOOT_WARM_BOOT_CACHE)
+/**
+ * \brief Reads the flash write counter of the platform.
+ *
+ * \note  The counter must be incremented by the hardware, or by a component
+ *        which cannot be bypassed, on every program or erase operation of the
+ *        image flash areas, and must never decrease.
+ *
+ * \param[out] count  Pointer to store the counter value
+ *
+ * \return Returns 0 on success, non-zero if there is no such counter
+ */
+int32_t boot_platform_get_flash_write_count(uint32_t *count);
+#endif /* MCUBOOT_VALIDATION_CACHE || MCUBOOT_WARM_BOOT_CACHE */
+
+#ifdef MCUBOOT_WARM_BOOT_CACHE
+/**
+ * \brief Tells whether the last reset was a warm reset, e.g. a watchdog or a
+ *        software reset, which kept the content of the retained RAM.
+ *
+ * \note  This must return 0 after a power-on or any reset which can change
+ *        the content of the retained RAM or of the image flash areas
+ *        without incrementing the flash write counter.
+ *
+ * \return Returns 1 on a warm reset, 0 otherwise
+ */
+int32_t boot_platform_is_warm_reset(void);
+
+/**
+ * \brief Gets the retained RAM area which holds the warm boot record.
+ *
+ * \note  The area must keep its content over warm resets, must not be
+ *        accessible by the non-secure side, and must not overlap the RAM
+ *        cleared by \ref boot_clear_bl2_ram_area or the shared data area.
+ *
+ * \param[out] area  Pointer to store the base address of the area
+ * \param[out] size  Pointer to store the size of the area in bytes
+ *
+ * \return Returns 0 on success, non-zero if there is no such area
+ */
+int32_t boot_platform_get_retained_area(void **area, uint32_t *size);
+#endif /* MCUBOOT_WARM_BOOT_CACHE */
+
 #ifdef __cplusplus
 }
 #endif
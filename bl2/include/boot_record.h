@@ -60,6 +60,18 @@ boot_add_data_to_shared_area(uint8_t        major_type,
                              size_t         size,
                              const uint8_t *data);
 
+/*!
+ * \brief Replace the content of the shared data area between bootloader and
+ *        runtime SW with a copy saved on a previous boot
+ *
+ * \param[in] data  Pointer to the copy, starting with the TLV header
+ * \param[in] size  Length of the copy
+ *
+ * \return Returns error code as specified in \ref shared_memory_err_t
+ */
+enum shared_memory_err_t
+boot_restore_shared_area(const uint8_t *data, size_t size);
+
 /*!
  * \brief Add an image's all boot status information to the shared data area
  *        between bootloader and runtime SW
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __BOOT_TIME_H__
+#define __BOOT_TIME_H__
+
+#include <stdint.h>
+#include "tfm_boot_time_defs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef TFM_BOOT_TIME
+/*!
+ * \brief Records the end of a boot stage with the DWT cycle counter. The
+ *        first call starts the counter from zero.
+ *
+ * \param[in] stage  Boot stage, as specified in \ref tfm_boot_time_stage_t
+ */
+void boot_time_record(uint32_t stage);
+
+/*!
+ * \brief Records the TFM_BOOT_TIME_BL2_JUMP stage, then adds the recorded
+ *        stages to the shared data area between bootloader and runtime SW.
+ */
+void boot_time_save(void);
+
+#define BOOT_TIME_RECORD(stage) boot_time_record(stage)
+#else
+#define BOOT_TIME_RECORD(stage)
+#endif /* TFM_BOOT_TIME */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BOOT_TIME_H__ */
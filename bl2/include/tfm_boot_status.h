@@ -19,8 +19,9 @@ extern "C" {
 /* Major numbers (4 bit) to identify
  * the consumer of shared data in runtime SW
  */
-#define TLV_MAJOR_CORE     0x0
-#define TLV_MAJOR_IAS      0x1
+#define TLV_MAJOR_CORE      0x0
+#define TLV_MAJOR_IAS       0x1
+#define TLV_MAJOR_BOOT_TIME 0x2
 
 /**
  * The shared data between boot loader and runtime SW is TLV encoded. The
@@ -58,6 +59,8 @@ extern "C" {
  * |---------------------------------------|
  * | MAJOR_CORE  |          TBD            |
  * |---------------------------------------|
+ * | MAJOR_BOOT_TIME |  recorder(12)       |
+ * |---------------------------------------|
  */
 
 /* Initial attestation: SW components / SW modules
@@ -139,6 +142,12 @@ extern "C" {
 #define TLV_MINOR_IAS_S_NS_SIGNER_ID     ((SW_S_NS << 6) | SW_SIGNER_ID)
 #define TLV_MINOR_IAS_S_NS_TYPE          ((SW_S_NS << 6) | SW_TYPE)
 
+/* Boot time: recorder of the boot stage timestamps. The data of the entries
+ * is an array of struct tfm_boot_time_entry_t.
+ */
+#define TLV_MINOR_BOOT_TIME_BL2       0x000
+#define TLV_MINOR_BOOT_TIME_SPE       0x001
+
 /* General macros to handle TLV type */
 #define MAJOR_MASK 0xF     /* 4  bit */
 #define MAJOR_POS  12      /* 12 bit */
@@ -20,6 +20,8 @@
 #define SHA256_HASH_SIZE    (32u)
 #if defined(MCUBOOT_SIGN_RSA) && defined(MCUBOOT_HW_KEY)
 #   define SIG_BUF_SIZE     (MCUBOOT_SIGN_RSA_LEN / 8)
+#elif defined(MCUBOOT_SIGN_EC256) && defined(MCUBOOT_HW_KEY)
+#   define SIG_BUF_SIZE     128
 #endif
 
 /*!
@@ -34,7 +36,7 @@
  * type of the software component. In case of single image boot it is
  * "NSPE_SPE" which results the maximum boot record size of 96.
  */
-#define MAX_BOOT_RECORD_SZ  (96u)
+#define MAX_BOOT_RECORD_SZ  IMAGE_BOOT_RECORD_MAX_SIZE
 
 /*!
  * \var shared_memory_init_done
@@ -68,57 +70,45 @@ static uint32_t shared_memory_init_done;
 #error "Shared data area and non-secure data area is overlapping"
 #endif
 
-#ifdef MCUBOOT_INDIVIDUAL_CLAIMS
 /*!
- * \brief Add the measurement data of SW component to the shared memory area
+ * \brief Read the manifest data of an image from its TLV area
  *
- * Measurements data are:
- *  - measurement value:  Hash of the image, read out from the image's manifest
- *                        section.
- *  - measurement type:   Short test description: SHA256, etc.
- *  - signer ID:          Hash of the image public key, read out from the
- *                        image's manifest section.
+ * Only used if the manifest data was not collected during the validation of
+ * the image, e.g. when the validation was skipped.
  *
- * \param[in]  sw_module  Identifier of the SW component
  * \param[in]  hdr        Pointer to the image header stored in RAM
  * \param[in]  fap        Pointer to the flash area where image is stored
+ * \param[out] manifest   Pointer to store the manifest data
  *
  * \return Returns error code as specified in \ref boot_status_err_t
  */
 static enum boot_status_err_t
-boot_save_sw_measurements(uint8_t sw_module,
-                          const struct image_header *hdr,
-                          const struct flash_area *fap)
+boot_read_img_manifest(const struct image_header *hdr,
+                       const struct flash_area *fap,
+                       struct image_manifest *manifest)
 {
     struct image_tlv_iter it;
     uint32_t offset;
     uint16_t len;
     uint8_t type;
-    uint8_t buf[32];
     int32_t res;
-    uint16_t ias_minor;
-    enum shared_memory_err_t res2;
-    char measure_type[] = "SHA256";
-#if defined(MCUBOOT_SIGN_RSA) && defined(MCUBOOT_HW_KEY)
+    uint32_t hash_found = 0;
+#if defined(SIG_BUF_SIZE)
     /* Few extra bytes for encoding and for public exponent */
     uint8_t key_buf[SIG_BUF_SIZE + 24];
     bootutil_sha256_context sha256_ctx;
 #endif
 
-    /* Manifest data is concatenated to the end of the image. It is encoded in
-     * TLV format.
-     */
+    memset(manifest, 0, sizeof(*manifest));
 
+    /* Manifest data is concatenated to the end of the image.
+     * It is encoded in TLV format.
+     */
     res = bootutil_tlv_iter_begin(&it, hdr, fap, IMAGE_TLV_ANY, false);
     if (res) {
         return BOOT_STATUS_ERROR;
     }
 
-    /* Iterates over the manifest data and copy the relevant attributes to the
-     * shared data area:
-     *  - image hash:      SW component measurement value
-     *  - public key hash: Signer ID
-     */
     while (true) {
         res = bootutil_tlv_iter_next(&it, &offset, &len, &type);
         if (res < 0) {
@@ -127,49 +117,41 @@ boot_save_sw_measurements(uint8_t sw_module,
             break;
         }
 
-        if (type == IMAGE_TLV_SHA256) {
-            /* Get the image's hash value from the manifest section */
-            if (len != sizeof(buf)) { /* SHA256 - 32 bytes */
+        if (type == IMAGE_TLV_BOOT_RECORD) {
+            if (len > sizeof(manifest->boot_record)) {
                 return BOOT_STATUS_ERROR;
             }
-
-            res = LOAD_IMAGE_DATA(hdr, fap, offset, buf, len);
+            res = LOAD_IMAGE_DATA(hdr, fap, offset, manifest->boot_record,
+                                  len);
             if (res) {
                 return BOOT_STATUS_ERROR;
             }
+            manifest->boot_record_len = len;
 
-            /* Add the image's hash value to the shared data area */
-            ias_minor = SET_IAS_MINOR(sw_module, SW_MEASURE_VALUE);
-            res2 = boot_add_data_to_shared_area(TLV_MAJOR_IAS,
-                                                ias_minor,
-                                                len,
-                                                buf);
-            if (res2) {
+        } else if (type == IMAGE_TLV_SHA256) {
+            /* Get the image's hash value from the manifest section */
+            if (len != sizeof(manifest->image_hash)) { /* SHA256 - 32 bytes */
                 return BOOT_STATUS_ERROR;
             }
-
-            /* Add the measurement type to the shared data area */
-            ias_minor = SET_IAS_MINOR(sw_module, SW_MEASURE_TYPE);
-            res2 = boot_add_data_to_shared_area(TLV_MAJOR_IAS,
-                                                ias_minor,
-                                                sizeof(measure_type) - 1,
-                                                (const uint8_t *)measure_type);
-            if (res2) {
+            res = LOAD_IMAGE_DATA(hdr, fap, offset, manifest->image_hash,
+                                  len);
+            if (res) {
                 return BOOT_STATUS_ERROR;
             }
+            hash_found = 1;
 
-#ifdef MCUBOOT_SIGN_RSA
+#if defined(MCUBOOT_SIGN_RSA) || defined(MCUBOOT_SIGN_EC256)
 #ifndef MCUBOOT_HW_KEY
         } else if (type == IMAGE_TLV_KEYHASH) {
             /* Get the hash of the public key from the manifest section */
-            if (len != sizeof(buf)) { /* SHA256 - 32 bytes */
+            if (len != sizeof(manifest->signer_id)) { /* SHA256 - 32 bytes */
                 return BOOT_STATUS_ERROR;
             }
-
-            res = LOAD_IMAGE_DATA(hdr, fap, offset, buf, len);
+            res = LOAD_IMAGE_DATA(hdr, fap, offset, manifest->signer_id, len);
             if (res) {
                 return BOOT_STATUS_ERROR;
             }
+            manifest->signer_id_valid = 1;
 #else /* MCUBOOT_HW_KEY */
         } else if (type == IMAGE_TLV_KEY) {
             /* Get the public key from the manifest section. */
@@ -184,19 +166,73 @@ boot_save_sw_measurements(uint8_t sw_module,
             /* Calculate the hash of the public key. */
             bootutil_sha256_init(&sha256_ctx);
             bootutil_sha256_update(&sha256_ctx, key_buf, len);
-            bootutil_sha256_finish(&sha256_ctx, buf);
+            bootutil_sha256_finish(&sha256_ctx, manifest->signer_id);
+            manifest->signer_id_valid = 1;
 #endif /* MCUBOOT_HW_KEY */
+#endif /* MCUBOOT_SIGN_RSA || MCUBOOT_SIGN_EC256 */
+        }
+    }
 
-            /* Add the hash of the public key to the shared data area */
-            ias_minor = SET_IAS_MINOR(sw_module, SW_SIGNER_ID);
-            res2 = boot_add_data_to_shared_area(TLV_MAJOR_IAS,
-                                                ias_minor,
-                                                SHA256_HASH_SIZE,
-                                                buf);
-            if (res2) {
-                return BOOT_STATUS_ERROR;
-            }
-#endif
+    if (!hash_found) {
+        return BOOT_STATUS_ERROR;
+    }
+
+    return BOOT_STATUS_OK;
+}
+
+#ifdef MCUBOOT_INDIVIDUAL_CLAIMS
+/*!
+ * \brief Add the measurement data of SW component to the shared memory area
+ *
+ * Measurements data are:
+ *  - measurement value:  Hash of the image, read out from the image's manifest
+ *                        section.
+ *  - measurement type:   Short test description: SHA256, etc.
+ *  - signer ID:          Hash of the image public key, read out from the
+ *                        image's manifest section.
+ *
+ * \param[in]  sw_module  Identifier of the SW component
+ * \param[in]  manifest   Pointer to the manifest data of the image
+ *
+ * \return Returns error code as specified in \ref boot_status_err_t
+ */
+static enum boot_status_err_t
+boot_save_sw_measurements(uint8_t sw_module,
+                          const struct image_manifest *manifest)
+{
+    uint16_t ias_minor;
+    enum shared_memory_err_t res2;
+    char measure_type[] = "SHA256";
+
+    /* Add the image's hash value to the shared data area */
+    ias_minor = SET_IAS_MINOR(sw_module, SW_MEASURE_VALUE);
+    res2 = boot_add_data_to_shared_area(TLV_MAJOR_IAS,
+                                        ias_minor,
+                                        sizeof(manifest->image_hash),
+                                        manifest->image_hash);
+    if (res2) {
+        return BOOT_STATUS_ERROR;
+    }
+
+    /* Add the measurement type to the shared data area */
+    ias_minor = SET_IAS_MINOR(sw_module, SW_MEASURE_TYPE);
+    res2 = boot_add_data_to_shared_area(TLV_MAJOR_IAS,
+                                        ias_minor,
+                                        sizeof(measure_type) - 1,
+                                        (const uint8_t *)measure_type);
+    if (res2) {
+        return BOOT_STATUS_ERROR;
+    }
+
+    if (manifest->signer_id_valid) {
+        /* Add the hash of the public key to the shared data area */
+        ias_minor = SET_IAS_MINOR(sw_module, SW_SIGNER_ID);
+        res2 = boot_add_data_to_shared_area(TLV_MAJOR_IAS,
+                                            ias_minor,
+                                            SHA256_HASH_SIZE,
+                                            manifest->signer_id);
+        if (res2) {
+            return BOOT_STATUS_ERROR;
         }
     }
 
@@ -356,19 +392,64 @@ boot_add_data_to_shared_area(uint8_t        major_type,
     return SHARED_MEMORY_OK;
 }
 
+/* See in boot_record.h */
+enum shared_memory_err_t
+boot_restore_shared_area(const uint8_t *data, size_t size)
+{
+    struct shared_data_tlv_header header;
+
+    if ((size < SHARED_DATA_HEADER_SIZE) ||
+        (size > BOOT_TFM_SHARED_DATA_SIZE)) {
+        return SHARED_MEMORY_OVERFLOW;
+    }
+
+    memcpy(&header, data, SHARED_DATA_HEADER_SIZE);
+    if ((header.tlv_magic != SHARED_DATA_TLV_INFO_MAGIC) ||
+        (header.tlv_tot_len != size)) {
+        return SHARED_MEMORY_GEN_ERROR;
+    }
+
+    memset((void *)BOOT_TFM_SHARED_DATA_BASE, 0, BOOT_TFM_SHARED_DATA_SIZE);
+    memcpy((void *)BOOT_TFM_SHARED_DATA_BASE, data, size);
+    shared_memory_init_done = SHARED_MEMORY_INITIALZED;
+
+    return SHARED_MEMORY_OK;
+}
+
 /* See in boot_record.h */
 enum boot_status_err_t
 boot_save_boot_status(uint8_t sw_module,
                       const struct image_header *hdr,
                       const struct flash_area *fap)
 {
+    const struct image_manifest *manifest;
+    struct image_manifest tlv_manifest;
+    enum boot_status_err_t res;
+#ifndef MCUBOOT_INDIVIDUAL_CLAIMS
+    size_t record_len;
+    uint8_t buf[MAX_BOOT_RECORD_SZ];
+    uint32_t offset;
+    uint16_t ias_minor;
+    enum shared_memory_err_t res2;
+#endif
+
+    /* The manifest data is normally collected while the image is validated,
+     * the TLV area is only read again if the validation was skipped.
+     */
+    manifest = bootutil_get_img_manifest(fap);
+    if (manifest == NULL) {
+        res = boot_read_img_manifest(hdr, fap, &tlv_manifest);
+        if (res) {
+            return res;
+        }
+        manifest = &tlv_manifest;
+    }
+
 #ifdef MCUBOOT_INDIVIDUAL_CLAIMS
     /* This implementation is deprecated and will probably
      * be removed in the future.
      */
 
-    enum boot_status_err_t res;
-
     res = boot_save_sw_type(sw_module);
     if (res) {
         return res;
@@ -379,7 +460,7 @@ boot_save_boot_status(uint8_t sw_module,
         return res;
     }
 
-    res = boot_save_sw_measurements(sw_module, hdr, fap);
+    res = boot_save_sw_measurements(sw_module, manifest);
     if (res) {
         return res;
     }
@@ -388,76 +469,11 @@ boot_save_boot_status(uint8_t sw_module,
 
 #else /* MCUBOOT_INDIVIDUAL_CLAIMS */
 
-    struct image_tlv_iter it;
-    uint32_t offset;
-    uint16_t len;
-    uint8_t type;
-    size_t record_len = 0;
-    uint8_t image_hash[32]; /* SHA256 - 32 Bytes */
-    uint8_t buf[MAX_BOOT_RECORD_SZ];
-    uint32_t boot_record_found = 0;
-    uint32_t hash_found = 0;
-    uint16_t ias_minor;
-    int32_t res;
-    enum shared_memory_err_t res2;
-
-    /* Manifest data is concatenated to the end of the image.
-     * It is encoded in TLV format.
-     */
-
-    res = bootutil_tlv_iter_begin(&it, hdr, fap, IMAGE_TLV_ANY, false);
-    if (res) {
-        return BOOT_STATUS_ERROR;
-    }
-
-    /* Traverse through the TLV area to find the boot record
-     * and image hash TLVs.
-     */
-    while (true) {
-        res = bootutil_tlv_iter_next(&it, &offset, &len, &type);
-        if (res < 0) {
-            return BOOT_STATUS_ERROR;
-        } else if (res > 0) {
-            break;
-        }
-
-        if (type == IMAGE_TLV_BOOT_RECORD) {
-            if (len > sizeof(buf)) {
-                return BOOT_STATUS_ERROR;
-            }
-            res = LOAD_IMAGE_DATA(hdr, fap, offset, buf, len);
-            if (res) {
-                return BOOT_STATUS_ERROR;
-            }
-
-            record_len = len;
-            boot_record_found = 1;
-
-        } else if (type == IMAGE_TLV_SHA256) {
-            /* Get the image's hash value from the manifest section. */
-            if (len > sizeof(image_hash)) {
-                return BOOT_STATUS_ERROR;
-            }
-            res = LOAD_IMAGE_DATA(hdr, fap, offset, image_hash, len);
-            if (res) {
-                return BOOT_STATUS_ERROR;
-            }
-
-            hash_found = 1;
-
-            /* The boot record TLV is part of the protected TLV area which is
-             * located before the other parts of the TLV area (including the
-             * image hash) so at this point it is okay to break the loop
-             * as the boot record TLV should have already been found.
-             */
-            break;
-        }
-    }
-
-
-    if (!boot_record_found || !hash_found) {
+    if (manifest->boot_record_len == 0) {
         return BOOT_STATUS_ERROR;
     }
+    record_len = manifest->boot_record_len;
+    memcpy(buf, manifest->boot_record, record_len);
 
     /* Update the measurement value (hash of the image) data item in the
      * boot record. It is always the last item in the structure to make
@@ -467,12 +483,11 @@ boot_save_boot_status(uint8_t sw_module,
      * part of the boot record TLV). For this reason this field has been
      * filled with zeros during the image signing process.
      */
-    offset = record_len - sizeof(image_hash);
-    /* Avoid buffer overflow. */
-    if ((offset + sizeof(image_hash)) > sizeof(buf)) {
+    if (record_len < sizeof(manifest->image_hash)) {
         return BOOT_STATUS_ERROR;
     }
-    memcpy(buf + offset, image_hash, sizeof(image_hash));
+    offset = record_len - sizeof(manifest->image_hash);
+    memcpy(buf + offset, manifest->image_hash, sizeof(manifest->image_hash));
 
     /* Add the CBOR encoded boot record to the shared data area. */
     ias_minor = SET_IAS_MINOR(sw_module, SW_BOOT_RECORD);
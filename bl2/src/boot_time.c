@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdint.h>
+#include "boot_time.h"
+#include "boot_record.h"
+#include "tfm_boot_status.h"
+#include "secure_fw/core/include/tfm_cycle_counter.h"
+
+static struct tfm_boot_time_entry_t boot_time_entries[TFM_BOOT_TIME_BL2_ENTRIES];
+static uint32_t boot_time_cnt;
+
+void boot_time_record(uint32_t stage)
+{
+    if (boot_time_cnt == 0) {
+        /* The counter keeps running in the secure image, which records its
+         * own stages on the same time base.
+         */
+        (void)tfm_cycle_counter_start(true);
+    }
+
+    /* The stages which do not fit are dropped */
+    if (boot_time_cnt < TFM_BOOT_TIME_BL2_ENTRIES) {
+        boot_time_entries[boot_time_cnt].stage = stage;
+        boot_time_entries[boot_time_cnt].cycles = tfm_cycle_counter_read();
+        boot_time_cnt++;
+    }
+}
+
+void boot_time_save(void)
+{
+    boot_time_record(TFM_BOOT_TIME_BL2_JUMP);
+
+    /* A missing timeline does not prevent booting */
+    (void)boot_add_data_to_shared_area(TLV_MAJOR_BOOT_TIME,
+                                       TLV_MINOR_BOOT_TIME_BL2,
+                                       boot_time_cnt *
+                                       sizeof(boot_time_entries[0]),
+                                       (const uint8_t *)boot_time_entries);
+}
@@ -0,0 +1,615 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "../ext/mcuboot/include/delta_update.h"
+#include "../ext/mcuboot/bootutil/src/bootutil_priv.h"
+#include "bootutil/bootutil.h"
+#include "bootutil/bootutil_log.h"
+#include "bootutil/image.h"
+#include "bootutil/sha256.h"
+#include "flash_map/flash_map.h"
+#include "flash_map_backend/flash_map_backend.h"
+#include "sysflash/sysflash.h"
+#include "target.h"
+
+/* Offset of the new image in the scratch area, after the rebuild record */
+#define DELTA_IMAGE_OFF         64
+
+/* Size of the buffer the new image is written through, a multiple of the
+ * flash write alignment.
+ */
+#define DELTA_OUT_BUF_SIZE      256
+
+/* Size of the buffers the images are read through */
+#define DELTA_BUF_SIZE          64
+
+#define DELTA_RECORD_MAGIC      0xd3e1a5c5
+
+#define DELTA_MIN(a, b)         (((a) < (b)) ? (a) : (b))
+#define DELTA_ROUND_UP(x, a)    ((((x) + (a) - 1) / (a)) * (a))
+
+/* Written to the start of the scratch area once the new image is rebuilt */
+struct delta_record {
+    uint32_t magic;
+    uint32_t image_size;
+    uint8_t image_hash[32];
+};
+
+/* The commands of the delta image, read from the flash */
+struct delta_input {
+    const struct flash_area *fap;
+    uint32_t pos;               /* Offset of the next byte to read */
+    uint32_t end;               /* Offset of the end of the commands */
+    uint32_t buf_off;           /* Offset of the buffered bytes */
+    uint32_t buf_len;           /* Number of buffered bytes */
+    uint8_t buf[DELTA_BUF_SIZE];
+};
+
+/* The new image, written to a flash area or to the RAM */
+struct delta_output {
+    const struct flash_area *fap;
+    uint32_t off;               /* Offset of the image in the flash area */
+    uint8_t *ram;               /* Address of the image if fap is NULL */
+    uint32_t size;              /* Number of bytes added */
+    uint32_t flushed;           /* Number of bytes written to the flash */
+    bootutil_sha256_context sha256_ctx;
+    uint8_t buf[DELTA_OUT_BUF_SIZE];
+};
+
+static int32_t delta_read_byte(struct delta_input *in, uint8_t *byte)
+{
+    if (in->pos >= in->end) {
+        return -1;
+    }
+
+    if ((in->pos < in->buf_off) || (in->pos - in->buf_off >= in->buf_len)) {
+        in->buf_off = in->pos;
+        in->buf_len = DELTA_MIN(sizeof(in->buf), in->end - in->pos);
+        if (flash_area_read(in->fap, in->buf_off, in->buf, in->buf_len) != 0) {
+            return -1;
+        }
+    }
+
+    *byte = in->buf[in->pos - in->buf_off];
+    in->pos++;
+
+    return 0;
+}
+
+/* Reads a LEB128 encoded unsigned integer */
+static int32_t delta_read_uint(struct delta_input *in, uint32_t *val)
+{
+    uint32_t shift;
+    uint8_t byte;
+
+    *val = 0;
+    for (shift = 0; shift < 32; shift += 7) {
+        if (delta_read_byte(in, &byte) != 0) {
+            return -1;
+        }
+        if ((shift == 28) && (byte & 0x70)) {
+            return -1;
+        }
+
+        *val |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+/* Writes the buffered bytes of the new image to the flash, padded to the
+ * write alignment.
+ */
+static int32_t delta_output_flush(struct delta_output *out)
+{
+    uint32_t len = out->size - out->flushed;
+    uint32_t align = flash_area_align(out->fap);
+    uint32_t pad;
+
+    if ((out->fap == NULL) || (len == 0)) {
+        return 0;
+    }
+
+    pad = DELTA_ROUND_UP(len, align) - len;
+    memset(out->buf + len, flash_area_erased_val(out->fap), pad);
+    if (flash_area_write(out->fap, out->off + out->flushed,
+                         out->buf, len + pad) != 0) {
+        return -1;
+    }
+    out->flushed = out->size;
+
+    return 0;
+}
+
+static int32_t delta_output_add(struct delta_output *out,
+                                const uint8_t *data, uint32_t len)
+{
+    uint32_t fill;
+    uint32_t n;
+
+    bootutil_sha256_update(&out->sha256_ctx, data, len);
+
+    if (out->fap == NULL) {
+        memcpy(out->ram + out->size, data, len);
+        out->size += len;
+        return 0;
+    }
+
+    while (len > 0) {
+        fill = out->size - out->flushed;
+        n = DELTA_MIN(len, sizeof(out->buf) - fill);
+        memcpy(out->buf + fill, data, n);
+        out->size += n;
+        data += n;
+        len -= n;
+
+        if (out->size - out->flushed == sizeof(out->buf)) {
+            if (delta_output_flush(out) != 0) {
+                return -1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/* Reads back a part of the new image, which must have been added already */
+static int32_t delta_output_read(struct delta_output *out, uint32_t off,
+                                 uint8_t *dst, uint32_t len)
+{
+    uint32_t n;
+
+    if (out->fap == NULL) {
+        memcpy(dst, out->ram + off, len);
+        return 0;
+    }
+
+    if (off < out->flushed) {
+        n = DELTA_MIN(len, out->flushed - off);
+        if (flash_area_read(out->fap, out->off + off, dst, n) != 0) {
+            return -1;
+        }
+        off += n;
+        dst += n;
+        len -= n;
+    }
+
+    memcpy(dst, out->buf + (off - out->flushed), len);
+
+    return 0;
+}
+
+int32_t boot_delta_decode(const struct boot_delta_header *hdr,
+                          const struct flash_area *fap_base,
+                          const struct flash_area *fap_src, uint32_t src_off,
+                          const struct boot_delta_dst *dst)
+{
+    struct delta_input in;
+    struct delta_output out;
+    uint8_t chunk[DELTA_BUF_SIZE];
+    uint8_t hash[32];
+    uint32_t len;
+    uint32_t arg;
+    uint32_t src;
+    uint32_t n;
+    uint8_t op;
+
+    in.fap = fap_src;
+    in.pos = src_off + hdr->hdr_size;
+    in.end = in.pos + hdr->patch_size;
+    in.buf_off = 0;
+    in.buf_len = 0;
+
+    out.fap = dst->fap;
+    out.off = dst->off;
+    out.ram = dst->ram;
+    out.size = 0;
+    out.flushed = 0;
+    bootutil_sha256_init(&out.sha256_ctx);
+
+    while (in.pos < in.end) {
+        if ((delta_read_byte(&in, &op) != 0) ||
+            (delta_read_uint(&in, &len) != 0) ||
+            (len > hdr->image_size - out.size)) {
+            return -1;
+        }
+
+        switch (op) {
+        case BOOT_DELTA_OP_LITERAL:
+            while (len > 0) {
+                n = DELTA_MIN(len, sizeof(chunk));
+                for (src = 0; src < n; src++) {
+                    if (delta_read_byte(&in, &chunk[src]) != 0) {
+                        return -1;
+                    }
+                }
+                if (delta_output_add(&out, chunk, n) != 0) {
+                    return -1;
+                }
+                len -= n;
+            }
+            break;
+
+        case BOOT_DELTA_OP_COPY_BASE:
+            if ((fap_base == NULL) || (delta_read_uint(&in, &arg) != 0)) {
+                return -1;
+            }
+            /* Zigzag decoding of the offset relative to the new image size */
+            src = out.size + ((arg >> 1) ^ (0u - (arg & 1)));
+            if ((src > fap_base->fa_size) || (len > fap_base->fa_size - src)) {
+                return -1;
+            }
+            while (len > 0) {
+                n = DELTA_MIN(len, sizeof(chunk));
+                if ((flash_area_read(fap_base, src, chunk, n) != 0) ||
+                    (delta_output_add(&out, chunk, n) != 0)) {
+                    return -1;
+                }
+                src += n;
+                len -= n;
+            }
+            break;
+
+        case BOOT_DELTA_OP_COPY_NEW:
+            if ((delta_read_uint(&in, &arg) != 0) ||
+                (arg == 0) || (arg > out.size)) {
+                return -1;
+            }
+            /* The source can overlap the copied bytes, so at most distance
+             * bytes are copied at once.
+             */
+            src = out.size - arg;
+            while (len > 0) {
+                n = DELTA_MIN(DELTA_MIN(len, sizeof(chunk)), arg);
+                if ((delta_output_read(&out, src, chunk, n) != 0) ||
+                    (delta_output_add(&out, chunk, n) != 0)) {
+                    return -1;
+                }
+                src += n;
+                len -= n;
+            }
+            break;
+
+        default:
+            return -1;
+        }
+    }
+
+    if ((out.size != hdr->image_size) || (delta_output_flush(&out) != 0)) {
+        return -1;
+    }
+
+    bootutil_sha256_finish(&out.sha256_ctx, hash);
+
+    return (memcmp(hash, hdr->image_hash, sizeof(hash)) == 0) ? 0 : -1;
+}
+
+
+#ifdef MCUBOOT_DELTA_UPDATE
+/**
+ * Checks that the delta image applies to the image in the primary slot, by
+ * comparing the hash of the base image with the SHA256 TLV of this image.
+ */
+static int32_t delta_check_base(const struct flash_area *fap_base,
+                                const uint8_t *base_hash)
+{
+    struct image_header hdr;
+    struct image_tlv_iter it;
+    uint8_t hash[32];
+    uint32_t off;
+    uint16_t len;
+
+    if (flash_area_read(fap_base, 0, &hdr, sizeof(hdr)) != 0) {
+        return -1;
+    }
+    if (hdr.ih_magic != IMAGE_MAGIC) {
+        return -1;
+    }
+
+    if (bootutil_tlv_iter_begin(&it, &hdr, fap_base, IMAGE_TLV_SHA256,
+                                false) != 0) {
+        return -1;
+    }
+    if ((bootutil_tlv_iter_next(&it, &off, &len, NULL) != 0) ||
+        (len != sizeof(hash))) {
+        return -1;
+    }
+    if (flash_area_read(fap_base, off, hash, sizeof(hash)) != 0) {
+        return -1;
+    }
+
+    return (memcmp(hash, base_hash, sizeof(hash)) == 0) ? 0 : -1;
+}
+
+/**
+ * Rebuilds the new image in the scratch area from the base image and the
+ * commands of the delta image, then writes the rebuild record.
+ */
+static int32_t delta_rebuild(const struct boot_delta_header *hdr,
+                             const struct flash_area *fap_base,
+                             const struct flash_area *fap_delta,
+                             const struct flash_area *fap_scratch)
+{
+    struct boot_delta_dst dst = { fap_scratch, DELTA_IMAGE_OFF, NULL };
+    struct delta_record record;
+
+    if (flash_area_erase(fap_scratch, 0,
+                         DELTA_ROUND_UP(DELTA_IMAGE_OFF + hdr->image_size,
+                                        FLASH_AREA_IMAGE_SECTOR_SIZE)) != 0) {
+        return -1;
+    }
+
+    if (boot_delta_decode(hdr, fap_base, fap_delta, 0, &dst) != 0) {
+        return -1;
+    }
+
+    record.magic = DELTA_RECORD_MAGIC;
+    record.image_size = hdr->image_size;
+    memcpy(record.image_hash, hdr->image_hash, sizeof(record.image_hash));
+
+    return flash_area_write(fap_scratch, 0, &record, sizeof(record));
+}
+
+/* Checks that the rebuilt image in the scratch area is complete */
+static int32_t delta_check_record(const struct delta_record *record,
+                                  const struct flash_area *fap_scratch)
+{
+    bootutil_sha256_context sha256_ctx;
+    uint8_t chunk[DELTA_BUF_SIZE];
+    uint8_t hash[32];
+    uint32_t off;
+    uint32_t n;
+
+    if ((fap_scratch->fa_size < DELTA_IMAGE_OFF) ||
+        (record->image_size > fap_scratch->fa_size - DELTA_IMAGE_OFF)) {
+        return -1;
+    }
+
+    bootutil_sha256_init(&sha256_ctx);
+    for (off = 0; off < record->image_size; off += n) {
+        n = DELTA_MIN(record->image_size - off, sizeof(chunk));
+        if (flash_area_read(fap_scratch, DELTA_IMAGE_OFF + off, chunk, n)) {
+            return -1;
+        }
+        bootutil_sha256_update(&sha256_ctx, chunk, n);
+    }
+    bootutil_sha256_finish(&sha256_ctx, hash);
+
+    return (memcmp(hash, record->image_hash, sizeof(hash)) == 0) ? 0 : -1;
+}
+
+static int32_t delta_copy_sector(const struct flash_area *fap_scratch,
+                                 const struct flash_area *fap_sec,
+                                 uint32_t off, uint32_t copy_sz)
+{
+    uint8_t chunk[DELTA_BUF_SIZE];
+    uint32_t end;
+    uint32_t n;
+
+    if (flash_area_erase(fap_sec, off, FLASH_AREA_IMAGE_SECTOR_SIZE) != 0) {
+        return -1;
+    }
+
+    end = DELTA_MIN(off + FLASH_AREA_IMAGE_SECTOR_SIZE, copy_sz);
+    for (; off < end; off += n) {
+        n = DELTA_MIN(end - off, sizeof(chunk));
+        if ((flash_area_read(fap_scratch, DELTA_IMAGE_OFF + off, chunk, n)) ||
+            (flash_area_write(fap_sec, off, chunk, n))) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * Copies the rebuilt image from the scratch area to the secondary slot. The
+ * first sector is copied last, so that the secondary slot holds a valid image
+ * header only once the rest of the image has been copied.
+ */
+static int32_t delta_copy_image(const struct flash_area *fap_scratch,
+                                const struct flash_area *fap_sec,
+                                uint32_t image_size)
+{
+    uint32_t copy_sz;
+    uint32_t off;
+
+    /* The bytes after the image up to the write alignment are padding */
+    copy_sz = DELTA_ROUND_UP(image_size, flash_area_align(fap_sec));
+
+    for (off = FLASH_AREA_IMAGE_SECTOR_SIZE; off < copy_sz;
+         off += FLASH_AREA_IMAGE_SECTOR_SIZE) {
+        if (delta_copy_sector(fap_scratch, fap_sec, off, copy_sz) != 0) {
+            return -1;
+        }
+    }
+
+    return delta_copy_sector(fap_scratch, fap_sec, 0, copy_sz);
+}
+
+/* Checks that the sizes in the header of the delta image are consistent */
+static int32_t delta_check_header(const struct boot_delta_header *hdr,
+                                  const struct flash_area *fap_sec,
+                                  const struct flash_area *fap_scratch)
+{
+    uint32_t image_end;
+
+    if ((hdr->hdr_size < sizeof(*hdr)) ||
+        (hdr->hdr_size > fap_sec->fa_size) ||
+        (hdr->patch_size > fap_sec->fa_size - hdr->hdr_size)) {
+        return -1;
+    }
+
+    /* The new image must neither reach the trailer of the secondary slot,
+     * nor overflow the scratch area.
+     */
+    image_end = (boot_status_off(fap_sec) / FLASH_AREA_IMAGE_SECTOR_SIZE) *
+                FLASH_AREA_IMAGE_SECTOR_SIZE;
+    if ((hdr->image_size > image_end) ||
+        (DELTA_ROUND_UP(hdr->image_size, FLASH_AREA_IMAGE_SECTOR_SIZE) >
+                                                                image_end) ||
+        (fap_scratch->fa_size < DELTA_IMAGE_OFF) ||
+        (hdr->image_size > fap_scratch->fa_size - DELTA_IMAGE_OFF)) {
+        return -1;
+    }
+
+    return 0;
+}
+
+int32_t boot_delta_update(uint8_t image_index)
+{
+    const struct flash_area *fap_base = NULL;
+    const struct flash_area *fap_sec = NULL;
+    const struct flash_area *fap_scratch = NULL;
+    struct boot_delta_header hdr;
+    struct delta_record record;
+    int swap_type;
+    int32_t rc = -1;
+
+    if ((flash_area_open(FLASH_AREA_IMAGE_PRIMARY(image_index),
+                         &fap_base) != 0) ||
+        (flash_area_open(FLASH_AREA_IMAGE_SECONDARY(image_index),
+                         &fap_sec) != 0) ||
+        (flash_area_open(FLASH_AREA_IMAGE_SCRATCH, &fap_scratch) != 0)) {
+        goto done;
+    }
+
+    if ((flash_area_read(fap_sec, 0, &hdr, sizeof(hdr)) != 0) ||
+        (flash_area_read(fap_scratch, 0, &record, sizeof(record)) != 0)) {
+        goto done;
+    }
+
+    if ((record.magic == DELTA_RECORD_MAGIC) &&
+        (delta_check_record(&record, fap_scratch) == 0)) {
+        /* The boot loader was reset while the new image was copied to the
+         * secondary slot, or before the record was erased: the secondary slot
+         * might hold parts of both images, so the copy is started again.
+         */
+        BOOT_LOG_INF("Resuming the copy of the rebuilt image; Image=%u",
+                     image_index);
+    } else if (hdr.magic == BOOT_DELTA_MAGIC) {
+        swap_type = boot_swap_type_multi(image_index);
+        if ((swap_type != BOOT_SWAP_TYPE_TEST) &&
+            (swap_type != BOOT_SWAP_TYPE_PERM)) {
+            /* Not marked for upgrade, the delta image might be incomplete */
+            rc = 0;
+            goto done;
+        }
+
+        BOOT_LOG_INF("Rebuilding the image from the delta image; Image=%u",
+                     image_index);
+        if ((delta_check_header(&hdr, fap_sec, fap_scratch) != 0) ||
+            (delta_check_base(fap_base, hdr.base_hash) != 0) ||
+            (delta_rebuild(&hdr, fap_base, fap_sec, fap_scratch) != 0)) {
+            BOOT_LOG_ERR("Invalid delta image, erasing it; Image=%u",
+                         image_index);
+            (void)flash_area_erase(fap_sec, 0, FLASH_AREA_IMAGE_SECTOR_SIZE);
+            goto done;
+        }
+        record.image_size = hdr.image_size;
+    } else {
+        rc = 0;
+        goto done;
+    }
+
+    if (delta_copy_image(fap_scratch, fap_sec, record.image_size) != 0) {
+        goto done;
+    }
+
+    /* Erase the record so that the image is not copied again */
+    rc = flash_area_erase(fap_scratch, 0, FLASH_AREA_IMAGE_SECTOR_SIZE);
+
+done:
+    flash_area_close(fap_base);
+    flash_area_close(fap_sec);
+    flash_area_close(fap_scratch);
+
+    return rc;
+}
+#endif /* MCUBOOT_DELTA_UPDATE */
+
+#ifdef MCUBOOT_COMPRESSED_IMAGES
+/**
+ * Reads and checks the header of the delta image, without base image, which
+ * is the body of a compressed image.
+ */
+static int32_t compressed_read_header(const struct image_header *hdr,
+                                      const struct flash_area *fap,
+                                      struct boot_delta_header *delta_hdr)
+{
+    uint32_t i;
+
+    if (!(hdr->ih_flags & IMAGE_F_COMPRESSED) ||
+        (hdr->ih_hdr_size > fap->fa_size) ||
+        (hdr->ih_img_size > fap->fa_size - hdr->ih_hdr_size)) {
+        return -1;
+    }
+
+    if (flash_area_read(fap, hdr->ih_hdr_size, delta_hdr,
+                        sizeof(*delta_hdr)) != 0) {
+        return -1;
+    }
+    if ((delta_hdr->magic != BOOT_DELTA_MAGIC) ||
+        (delta_hdr->hdr_size < sizeof(*delta_hdr)) ||
+        (delta_hdr->hdr_size > hdr->ih_img_size) ||
+        (delta_hdr->patch_size > hdr->ih_img_size - delta_hdr->hdr_size)) {
+        return -1;
+    }
+
+    for (i = 0; i < sizeof(delta_hdr->base_hash); i++) {
+        if (delta_hdr->base_hash[i] != 0) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+int32_t boot_compressed_image_size(const struct image_header *hdr,
+                                   const struct flash_area *fap,
+                                   uint32_t *size)
+{
+    struct boot_delta_header delta_hdr;
+
+    if (compressed_read_header(hdr, fap, &delta_hdr) != 0) {
+        return -1;
+    }
+    *size = delta_hdr.image_size;
+
+    return 0;
+}
+
+int32_t boot_decompress_image(const struct image_header *hdr,
+                              const struct flash_area *fap,
+                              const struct boot_delta_dst *dst,
+                              uint32_t dst_size)
+{
+    struct boot_delta_header delta_hdr;
+    uint32_t size;
+
+    if (compressed_read_header(hdr, fap, &delta_hdr) != 0) {
+        return -1;
+    }
+
+    /* The end of the image is padded to the write alignment in the flash */
+    size = delta_hdr.image_size;
+    if (dst->fap != NULL) {
+        size = DELTA_ROUND_UP(size, flash_area_align(dst->fap));
+    }
+    if (size > dst_size) {
+        return -1;
+    }
+
+    return boot_delta_decode(&delta_hdr, NULL, fap, hdr->ih_hdr_size, dst);
+}
+#endif /* MCUBOOT_COMPRESSED_IMAGES */
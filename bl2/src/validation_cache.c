@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "../ext/mcuboot/include/validation_cache.h"
+#include "../ext/mcuboot/include/security_cnt.h"
+#include "../ext/mcuboot/bootutil/src/bootutil_priv.h"
+#include "bootutil/image.h"
+#include "bootutil/sha256.h"
+#include "flash_map/flash_map.h"
+#include "boot_hal.h"
+#include "cmsis_compiler.h"
+
+#ifndef MCUBOOT_VALIDATION_CACHE_MAX_SKIP
+#define MCUBOOT_VALIDATION_CACHE_MAX_SKIP 16
+#endif
+
+/* The platforms without a validation record storage or a flash write counter
+ * always validate the images fully.
+ */
+__WEAK int32_t
+boot_platform_read_validation_record(uint32_t image_id,
+                                     struct boot_validation_record *record)
+{
+    (void)image_id;
+    (void)record;
+
+    return -1;
+}
+
+__WEAK int32_t
+boot_platform_write_validation_record(uint32_t image_id,
+                               const struct boot_validation_record *record)
+{
+    (void)image_id;
+    (void)record;
+
+    return -1;
+}
+
+#ifndef MCUBOOT_WARM_BOOT_CACHE
+__WEAK int32_t boot_platform_get_flash_write_count(uint32_t *count)
+{
+    (void)count;
+
+    return -1;
+}
+#endif /* !MCUBOOT_WARM_BOOT_CACHE */
+
+/**
+ * Hashes a part of the flash area.
+ *
+ * @param ctx               Pointer to the hash context.
+ * @param fap               Flash area to read.
+ * @param off               Offset of the part in the flash area.
+ * @param len               Length of the part.
+ *
+ * @return                  0 on success; nonzero on failure.
+ */
+static int32_t hash_flash(bootutil_sha256_context *ctx,
+                          const struct flash_area *fap,
+                          uint32_t off, uint32_t len)
+{
+    uint8_t buf[64];
+    uint32_t blk_sz;
+
+    if ((off > fap->fa_size) || (len > fap->fa_size - off)) {
+        return -1;
+    }
+
+    while (len > 0) {
+        blk_sz = (len > sizeof(buf)) ? sizeof(buf) : len;
+        if (flash_area_read(fap, off, buf, blk_sz) != 0) {
+            return -1;
+        }
+        bootutil_sha256_update(ctx, buf, blk_sz);
+        off += blk_sz;
+        len -= blk_sz;
+    }
+
+    return 0;
+}
+
+/**
+ * Computes the fingerprint of the image, the hash of its header and of its TLV
+ * area. The TLV area holds the hash and the signature of the image, so the
+ * fingerprint identifies it without hashing the whole image.
+ *
+ * @param hdr               Pointer to the header of the image.
+ * @param fap               Flash area of the image.
+ * @param fingerprint       Buffer to store the 32 byte fingerprint.
+ *
+ * @return                  0 on success; nonzero on failure.
+ */
+static int32_t get_fingerprint(const struct image_header *hdr,
+                               const struct flash_area *fap,
+                               uint8_t *fingerprint)
+{
+    bootutil_sha256_context sha256_ctx;
+    struct image_tlv_info info;
+    uint32_t tlv_off = BOOT_TLV_OFF(hdr);
+
+    if (flash_area_read(fap, tlv_off + hdr->ih_protect_tlv_size,
+                        &info, sizeof(info)) != 0) {
+        return -1;
+    }
+    if (info.it_magic != IMAGE_TLV_INFO_MAGIC) {
+        return -1;
+    }
+
+    bootutil_sha256_init(&sha256_ctx);
+    if ((hash_flash(&sha256_ctx, fap, 0, hdr->ih_hdr_size) != 0) ||
+        (hash_flash(&sha256_ctx, fap, tlv_off,
+                    hdr->ih_protect_tlv_size + info.it_tlv_tot) != 0)) {
+        return -1;
+    }
+    bootutil_sha256_finish(&sha256_ctx, fingerprint);
+
+    return 0;
+}
+
+int32_t boot_validation_cache_check(uint32_t image_id,
+                                    const struct image_header *hdr,
+                                    const struct flash_area *fap)
+{
+    struct boot_validation_record record;
+    uint8_t fingerprint[sizeof(record.fingerprint)];
+    uint32_t flash_write_cnt;
+    uint32_t security_cnt;
+
+    if ((boot_platform_read_validation_record(image_id, &record) != 0) ||
+        (boot_platform_get_flash_write_count(&flash_write_cnt) != 0) ||
+        (boot_nv_security_counter_get(image_id, &security_cnt) != 0) ||
+        (get_fingerprint(hdr, fap, fingerprint) != 0)) {
+        return -1;
+    }
+
+    if ((record.flash_write_cnt != flash_write_cnt) ||
+        (record.security_cnt != security_cnt) ||
+        (record.skip_cnt >= MCUBOOT_VALIDATION_CACHE_MAX_SKIP) ||
+        (memcmp(record.fingerprint, fingerprint, sizeof(fingerprint)) != 0)) {
+        return -1;
+    }
+
+    /* Count the skipped validation before booting, so that a failure to
+     * store it cannot extend the schedule of the full validation.
+     */
+    record.skip_cnt++;
+    if (boot_platform_write_validation_record(image_id, &record) != 0) {
+        return -1;
+    }
+
+    return 0;
+}
+
+int32_t boot_validation_cache_update(uint32_t image_id,
+                                     const struct image_header *hdr,
+                                     const struct flash_area *fap)
+{
+    struct boot_validation_record record;
+
+    if ((boot_platform_get_flash_write_count(&record.flash_write_cnt) != 0) ||
+        (boot_nv_security_counter_get(image_id, &record.security_cnt) != 0) ||
+        (get_fingerprint(hdr, fap, record.fingerprint) != 0)) {
+        return -1;
+    }
+    record.skip_cnt = 0;
+
+    return boot_platform_write_validation_record(image_id, &record);
+}
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "../ext/mcuboot/include/warm_boot.h"
+#include "../ext/mcuboot/include/security_cnt.h"
+#include "boot_record.h"
+#include "boot_hal.h"
+#include "region_defs.h"
+#include "tfm_boot_status.h"
+#include "bootutil/image.h"
+#include "bootutil/sha256.h"
+#include "cmsis_compiler.h"
+
+#define BOOT_WARM_BOOT_MAGIC 0x5741524Du /* "WARM" */
+
+/**
+ * Record of the previous boot, kept in the retained RAM area
+ */
+struct boot_warm_boot_record {
+    uint32_t magic;
+    uint32_t flash_write_cnt;  /* Flash write counter after the boot */
+    uint32_t security_cnt[MCUBOOT_IMAGE_NUMBER];
+    struct image_header hdr;   /* Header of the booted image */
+    uint32_t image_off;
+    uint32_t flash_dev_id;
+    uint32_t shared_data_size;
+    uint8_t  shared_data[BOOT_TFM_SHARED_DATA_SIZE];
+    uint8_t  digest[32];       /* SHA-256 of all the fields above */
+};
+
+/* Header of the booted image, referenced by the boot response */
+static struct image_header warm_boot_hdr;
+
+/* The platforms without a retained RAM area, a flash write counter or a way to
+ * tell a warm reset always run the boot sequence.
+ */
+__WEAK int32_t boot_platform_is_warm_reset(void)
+{
+    return 0;
+}
+
+__WEAK int32_t boot_platform_get_retained_area(void **area, uint32_t *size)
+{
+    (void)area;
+    (void)size;
+
+    return -1;
+}
+
+__WEAK int32_t boot_platform_get_flash_write_count(uint32_t *count)
+{
+    (void)count;
+
+    return -1;
+}
+
+/**
+ * Gets the warm boot record in the retained RAM area.
+ *
+ * @return                  Pointer to the record; NULL if there is no
+ *                          suitable retained RAM area.
+ */
+static struct boot_warm_boot_record *get_record(void)
+{
+    void *area;
+    uint32_t size;
+
+    if ((boot_platform_get_retained_area(&area, &size) != 0) ||
+        (area == NULL) || (size < sizeof(struct boot_warm_boot_record)) ||
+        (((uintptr_t)area & (sizeof(uint32_t) - 1)) != 0)) {
+        return NULL;
+    }
+
+    return (struct boot_warm_boot_record *)area;
+}
+
+/**
+ * Computes the digest of the record, over all its fields but the digest.
+ *
+ * @param record            Pointer to the record.
+ * @param digest            Buffer to store the 32 byte digest.
+ */
+static void get_digest(const struct boot_warm_boot_record *record,
+                       uint8_t *digest)
+{
+    bootutil_sha256_context sha256_ctx;
+
+    bootutil_sha256_init(&sha256_ctx);
+    bootutil_sha256_update(&sha256_ctx, record,
+                           offsetof(struct boot_warm_boot_record, digest));
+    bootutil_sha256_finish(&sha256_ctx, digest);
+}
+
+/**
+ * Reads the counters which must not change between the boot recorded and the
+ * boot using the record.
+ *
+ * @param flash_write_cnt   Pointer to store the flash write counter.
+ * @param security_cnt      Array to store the security counter of each image.
+ *
+ * @return                  0 on success; nonzero on failure.
+ */
+static int32_t get_counters(uint32_t *flash_write_cnt, uint32_t *security_cnt)
+{
+    uint32_t i;
+
+    if (boot_platform_get_flash_write_count(flash_write_cnt) != 0) {
+        return -1;
+    }
+
+    for (i = 0; i < MCUBOOT_IMAGE_NUMBER; i++) {
+        if (boot_nv_security_counter_get(i, &security_cnt[i]) != 0) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+int32_t boot_warm_boot_load(struct boot_rsp *rsp)
+{
+    struct boot_warm_boot_record *record = get_record();
+    uint32_t flash_write_cnt;
+    uint32_t security_cnt[MCUBOOT_IMAGE_NUMBER];
+    uint8_t digest[sizeof(record->digest)];
+
+    if (record == NULL) {
+        return -1;
+    }
+
+    if ((boot_platform_is_warm_reset() != 1) ||
+        (record->magic != BOOT_WARM_BOOT_MAGIC) ||
+        (record->shared_data_size > sizeof(record->shared_data)) ||
+        (get_counters(&flash_write_cnt, security_cnt) != 0)) {
+        goto invalidate;
+    }
+
+    get_digest(record, digest);
+    if ((memcmp(record->digest, digest, sizeof(digest)) != 0) ||
+        (record->flash_write_cnt != flash_write_cnt) ||
+        (memcmp(record->security_cnt, security_cnt,
+                sizeof(security_cnt)) != 0)) {
+        goto invalidate;
+    }
+
+    if (boot_restore_shared_area(record->shared_data,
+                                 record->shared_data_size) !=
+        SHARED_MEMORY_OK) {
+        goto invalidate;
+    }
+
+    memcpy(&warm_boot_hdr, &record->hdr, sizeof(warm_boot_hdr));
+    rsp->br_hdr = &warm_boot_hdr;
+    rsp->br_flash_dev_id = (uint8_t)record->flash_dev_id;
+    rsp->br_image_off = record->image_off;
+
+    return 0;
+
+invalidate:
+    /* The record is only saved again once the boot sequence has completed */
+    record->magic = 0;
+
+    return -1;
+}
+
+int32_t boot_warm_boot_save(const struct boot_rsp *rsp)
+{
+    struct boot_warm_boot_record *record = get_record();
+    const struct tfm_boot_data *boot_data =
+                        (const struct tfm_boot_data *)BOOT_TFM_SHARED_DATA_BASE;
+
+    if (record == NULL) {
+        return -1;
+    }
+
+    record->magic = 0;
+
+    if ((boot_data->header.tlv_magic != SHARED_DATA_TLV_INFO_MAGIC) ||
+        (boot_data->header.tlv_tot_len > sizeof(record->shared_data)) ||
+        (get_counters(&record->flash_write_cnt, record->security_cnt) != 0)) {
+        return -1;
+    }
+
+    memcpy(&record->hdr, rsp->br_hdr, sizeof(record->hdr));
+    record->image_off = rsp->br_image_off;
+    record->flash_dev_id = rsp->br_flash_dev_id;
+    record->shared_data_size = boot_data->header.tlv_tot_len;
+    memset(record->shared_data, 0, sizeof(record->shared_data));
+    memcpy(record->shared_data, boot_data, record->shared_data_size);
+
+    record->magic = BOOT_WARM_BOOT_MAGIC;
+    get_digest(record, record->digest);
+
+    return 0;
+}
@@ -1,5 +1,5 @@
 #-------------------------------------------------------------------------------
-# Copyright (c) 2017-2019, Arm Limited. All rights reserved.
+# Copyright (c) 2017-2020, Arm Limited. All rights reserved.
 #
 # SPDX-License-Identifier: BSD-3-Clause
 #
@@ -60,6 +60,20 @@ function(compiler_get_preinclude_option_string INCLUDE RES)
 	set(${RES} "-include ${INCLUDE}" PARENT_SCOPE)
 endfunction()
 
+#Return the option enabling the DSP extension on top of the CPU options set by
+#this file, or an empty string if the architecture has no DSP extension.
+function(compiler_get_dsp_option_string RES)
+	if(NOT DEFINED ARM_CPU_ARCHITECTURE)
+		set(${RES} "" PARENT_SCOPE)
+	elseif(${ARM_CPU_ARCHITECTURE} STREQUAL "ARMv8-M.MAIN")
+		set(${RES} "-march=armv8-m.main+dsp" PARENT_SCOPE)
+	elseif(${ARM_CPU_ARCHITECTURE} STREQUAL "ARMv7-M")
+		set(${RES} "-march=armv7e-m" PARENT_SCOPE)
+	else()
+		set(${RES} "" PARENT_SCOPE)
+	endif()
+endfunction()
+
 function(compiler_set_preinclude_file)
 	#Option (on/off) arguments.
 	set( _OPTIONS_ARGS GLOBAL)
@@ -1,5 +1,5 @@
 #-------------------------------------------------------------------------------
-# Copyright (c) 2017-2018, Arm Limited. All rights reserved.
+# Copyright (c) 2017-2020, Arm Limited. All rights reserved.
 #
 # SPDX-License-Identifier: BSD-3-Clause
 #
@@ -9,3 +9,11 @@
 set(ARM_CPU_ARCHITECTURE "ARMv8-M.MAIN")
 
 set(ARM_CPU_TYPE "Cortex-M33")
+
+#The DSP extension is optional on the Cortex-M33. When it is set, the Mbed
+#Crypto library is built with it, to use the multiply-accumulate kernels of
+#platform/ext/common/tfm_mbedtls_bn_mul.h. A platform whose core does not
+#implement the extension must set ARM_CPU_DSP to OFF before including this file.
+if(NOT DEFINED ARM_CPU_DSP)
+	set(ARM_CPU_DSP ON)
+endif()
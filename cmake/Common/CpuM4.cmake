@@ -1,5 +1,5 @@
 #-------------------------------------------------------------------------------
-# Copyright (c) 2017-2019, Arm Limited. All rights reserved.
+# Copyright (c) 2017-2020, Arm Limited. All rights reserved.
 #
 # SPDX-License-Identifier: BSD-3-Clause
 #
@@ -13,3 +13,9 @@
 #setting of architecture type and leave it to compiler cmake files.
 
 set(ARM_CPU_TYPE "Cortex-M4")
+
+#The DSP extension is always implemented by the Cortex-M4. The Mbed Crypto
+#library is built with it, see cmake/Common/CpuM33.cmake.
+if(NOT DEFINED ARM_CPU_DSP)
+	set(ARM_CPU_DSP ON)
+endif()
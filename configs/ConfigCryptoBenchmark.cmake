@@ -0,0 +1,63 @@
+#-------------------------------------------------------------------------------
+# Copyright (c) 2020, Arm Limited. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+#-------------------------------------------------------------------------------
+
+#This file holds information of a specific build configuration of this project.
+
+if(NOT DEFINED TFM_ROOT_DIR)
+	message(FATAL_ERROR "Variable TFM_ROOT_DIR is not set!")
+endif()
+
+#Include board specific config (CPU, etc...), select platform specific build
+#system settings file
+if(NOT DEFINED TARGET_PLATFORM)
+	message(FATAL_ERROR "ERROR: TARGET_PLATFORM is not set in command line")
+elseif(${TARGET_PLATFORM} STREQUAL "AN521")
+	set(PLATFORM_CMAKE_FILE "${TFM_ROOT_DIR}/platform/ext/Mps2AN521.cmake")
+elseif(${TARGET_PLATFORM} STREQUAL "AN519")
+	set (PLATFORM_CMAKE_FILE "${TFM_ROOT_DIR}/platform/ext/Mps2AN519.cmake")
+elseif(${TARGET_PLATFORM} STREQUAL "AN539")
+	set (PLATFORM_CMAKE_FILE "${TFM_ROOT_DIR}/platform/ext/Mps2AN539.cmake")
+elseif(${TARGET_PLATFORM} STREQUAL "AN524")
+	set (PLATFORM_CMAKE_FILE "${TFM_ROOT_DIR}/platform/ext/Mps3AN524.cmake")
+elseif(${TARGET_PLATFORM} STREQUAL "MUSCA_A")
+	set(PLATFORM_CMAKE_FILE "${TFM_ROOT_DIR}/platform/ext/musca_a.cmake")
+elseif(${TARGET_PLATFORM} STREQUAL "MUSCA_B1")
+	set(PLATFORM_CMAKE_FILE "${TFM_ROOT_DIR}/platform/ext/musca_b1.cmake")
+elseif(${TARGET_PLATFORM} STREQUAL "MUSCA_S1")
+	set(PLATFORM_CMAKE_FILE "${TFM_ROOT_DIR}/platform/ext/musca_s1.cmake")
+elseif(${TARGET_PLATFORM} STREQUAL "SSE-200_AWS")
+	set(PLATFORM_CMAKE_FILE "${TFM_ROOT_DIR}/platform/ext/SSE-200_AWS.cmake")
+else()
+	message(FATAL_ERROR "ERROR: Target \"${TARGET_PLATFORM}\" is not supported.")
+endif()
+
+##These variables select how the projects are built. Each project will set
+#various project specific settings (e.g. what files to build, macro
+#definitions) based on these.
+set (REGRESSION True)
+set (CORE_TEST False)
+set (CORE_IPC False)
+set (PSA_API_TEST False)
+
+# TF-M isolation level: 1, the secure benchmark needs a privileged test
+# partition to read the cycle counter
+set (TFM_LVL 1)
+
+#Only run the crypto benchmark, the functional test suites would lengthen the
+#run without adding to the results.
+set(ENABLE_CRYPTO_BENCHMARK_TESTS True CACHE BOOL "Option for crypto service benchmark")
+set(ENABLE_SECURE_STORAGE_SERVICE_TESTS False CACHE BOOL "Option for secure storage service tests")
+set(ENABLE_INTERNAL_TRUSTED_STORAGE_SERVICE_TESTS False CACHE BOOL "Option for internal trusted storage services tests")
+set(ENABLE_AUDIT_LOGGING_SERVICE_TESTS False CACHE BOOL "Option for audit logging service tests")
+set(ENABLE_CRYPTO_SERVICE_TESTS False CACHE BOOL "Option for crypto service tests")
+set(ENABLE_ATTESTATION_SERVICE_TESTS False CACHE BOOL "Option for attestation service tests")
+set(ENABLE_PLATFORM_SERVICE_TESTS False CACHE BOOL "Option for platform service tests")
+set(ENABLE_QCBOR_TESTS False CACHE BOOL "Option for QCBOR tests")
+set(ENABLE_T_COSE_TESTS False CACHE BOOL "Option for T_COSE tests")
+set(ENABLE_CORE_UTILS_TESTS False CACHE BOOL "Option for core utility tests")
+
+include ("${TFM_ROOT_DIR}/CommonConfig.cmake")
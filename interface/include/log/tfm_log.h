@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -12,6 +12,26 @@
 
 /* Functions and macros in this file is for 'thread mode' usage. */
 
+#if defined(TFM_LOG_DEFERRED) && !(defined(__DOMAIN_NS) && (__DOMAIN_NS == 1))
+/* Number of arguments after the format string, up to TFM_LOG_MAX_ARGS */
+#define TFM_LOG_NARGS(...) \
+    _TFM_LOG_NARGS(_, ##__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define _TFM_LOG_NARGS(_, _1, _2, _3, _4, _5, _6, _7, _8, N, ...) N
+
+/* The format strings are placed in the .tfm_log_fmt section, which is only
+ * kept in the ELF file when the linker script supports it.
+ */
+#define TFM_LOG_FMT(fmt) __extension__({                                     \
+        static const char _tfm_log_fmt[]                                     \
+            __attribute__((section(".tfm_log_fmt"), used)) = fmt;           \
+        _tfm_log_fmt;                                                        \
+    })
+
+#define LOG_MSG(fmt, ...) \
+    tfm_log_deferred(TFM_LOG_FMT(fmt), TFM_LOG_NARGS(__VA_ARGS__), \
+                     ##__VA_ARGS__)
+#else
 #define LOG_MSG(...) tfm_log_printf(__VA_ARGS__)
+#endif
 
 #endif /* __TFM_LOG_H__ */
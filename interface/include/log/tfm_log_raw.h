@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -8,6 +8,8 @@
 #ifndef __TFM_LOG_RAW_H__
 #define __TFM_LOG_RAW_H__
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -37,6 +39,38 @@ extern "C" {
  */
 int tfm_log_printf(const char *fmt, ...);
 
+#ifdef TFM_LOG_DEFERRED
+/**
+ * \brief Marker of the deferred log frames in the output
+ */
+#define TFM_LOG_FRAME_MARKER 0xA5
+
+/**
+ * \brief Maximum number of arguments of a deferred log message
+ */
+#define TFM_LOG_MAX_ARGS 8
+
+/**
+ * \brief Outputs a deferred log message, which is formatted by the host
+ *
+ * \param[in]   fmt     Format string, whose address identifies the message
+ * \param[in]   nargs   Number of arguments, at most \ref TFM_LOG_MAX_ARGS
+ * \param[in]   ...     32-bit arguments of the message
+ *
+ * \return              Number of bytes output
+ *
+ * \note                The format string isn't read: the output is a frame
+ *                      made of \ref TFM_LOG_FRAME_MARKER, the number of
+ *                      arguments on one byte, then the address of the format
+ *                      string and each argument on four bytes, in the byte
+ *                      order of the target. The tools/tfm_log_decode.py
+ *                      script formats the frames with the format strings of
+ *                      the image. The argument of %s is the address of the
+ *                      string, which is only printed if it is in the image.
+ */
+int tfm_log_deferred(const char *fmt, uint32_t nargs, ...);
+#endif /* TFM_LOG_DEFERRED */
+
 #ifdef __cplusplus
 }
 #endif
@@ -76,6 +76,18 @@ typedef struct psa_outvec {
     size_t len;                 /*!< the size in bytes                      */
 } psa_outvec;
 
+/**
+ * A request of a batch submitted with \ref psa_call_batch.
+ */
+typedef struct psa_batch_call_t {
+    int32_t type;               /*!< the request type                       */
+    const psa_invec *in_vec;    /*!< array of input vectors                 */
+    size_t in_len;              /*!< number of input vectors                */
+    psa_outvec *out_vec;        /*!< array of output vectors                */
+    size_t out_len;             /*!< number of output vectors               */
+    psa_status_t status;        /*!< status of the request, set by the SPM  */
+} psa_batch_call_t;
+
 /*************************** PSA Client API **********************************/
 
 /**
@@ -126,7 +138,7 @@ psa_handle_t psa_connect(uint32_t sid, uint32_t version);
  * \brief Call an RoT Service on an established connection.
  *
  * \param[in] handle            A handle to an established connection.
- * \param[in] type              The reuqest type.
+ * \param[in] type              The request type.
  *                              Must be zero( \ref PSA_IPC_CALL) or positive.
  * \param[in] in_vec            Array of input \ref psa_invec structures.
  * \param[in] in_len            Number of input \ref psa_invec structures.
@@ -152,6 +164,139 @@ psa_status_t psa_call(psa_handle_t handle, int32_t type,
                       psa_outvec *out_vec,
                       size_t out_len);
 
+/**
+ * \brief Call an RoT Service with several requests on the same connection.
+ *
+ * \details The requests are delivered to the RoT Service one after the
+ *          other, in order. The caller is only resumed after the last request
+ *          has been replied, so the batch costs a single context switch into
+ *          the SPM. The status returned by the RoT Service for each request is
+ *          written to the status field of its entry.
+ *
+ * \param[in] handle            A handle to an established connection.
+ * \param[in/out] calls         Array of \ref psa_batch_call_t structures.
+ * \param[in] num_calls         Number of \ref psa_batch_call_t structures.
+ *
+ * \retval PSA_SUCCESS          All the requests have been handled.
+ * \retval PSA_ERROR_CONNECTION_BUSY The SPM cannot carry the requests to a
+ *                              stateless RoT Service, or holds as many
+ *                              batches as it can, at the moment.
+ * \retval PSA_ERROR_PROGRAMMER_ERROR The connection has been terminated by the
+ *                              RoT Service. The requests following the one
+ *                              that terminated the connection are not
+ *                              delivered.
+ * \retval "PROGRAMMER ERROR"   The call is a PROGRAMMER ERROR if any of the
+ *                              requests is invalid for \ref psa_call, if the
+ *                              batch holds more requests than the SPM
+ *                              supports, or if an invalid memory reference
+ *                              was provided for the array of requests.
+ */
+psa_status_t psa_call_batch(psa_handle_t handle, psa_batch_call_t *calls,
+                            size_t num_calls);
+
+#ifdef TFM_MAILBOX_SG
+/**
+ * \brief Call an RoT Service with client vectors scattered over several
+ *        segments.
+ *
+ * \details Each input vector is made of the next in_nr_segs[i] segments of
+ *          in_segs, and each output vector of the next out_nr_segs[i]
+ *          segments of out_segs. The RoT Service sees every vector as a
+ *          single contiguous one through \ref psa_read, \ref psa_skip and
+ *          \ref psa_write.
+ *
+ * \note Only available to the NSPE in the multi-core topology. There can be
+ *       at most MAILBOX_SG_MAX_SEGS input segments, and as many output
+ *       segments.
+ *
+ * \param[in] handle            A handle to an established connection, or the
+ *                              static handle of a stateless RoT Service.
+ * \param[in] type              The request type.
+ *                              Must be zero( \ref PSA_IPC_CALL) or positive.
+ * \param[in] in_segs           Array of the input segments.
+ * \param[in] in_nr_segs        Number of segments of each input vector.
+ * \param[in] in_len            Number of input vectors.
+ * \param[in] out_segs          Array of the output segments.
+ * \param[in] out_nr_segs       Number of segments of each output vector.
+ * \param[in] out_len           Number of output vectors.
+ * \param[out] out_written      Number of bytes written to each output
+ *                              vector.
+ *
+ * \retval >=0                  RoT Service-specific status value.
+ * \retval <0                   RoT Service-specific error code.
+ * \retval PSA_ERROR_PROGRAMMER_ERROR The connection has been terminated by the
+ *                              RoT Service.
+ * \retval "PROGRAMMER ERROR"   The call is a PROGRAMMER ERROR if the call is
+ *                              invalid for \ref psa_call, if there are too
+ *                              many segments, or if a segment is invalid.
+ */
+psa_status_t psa_call_sg(psa_handle_t handle, int32_t type,
+                         const psa_invec *in_segs, const size_t *in_nr_segs,
+                         size_t in_len,
+                         const psa_outvec *out_segs,
+                         const size_t *out_nr_segs, size_t out_len,
+                         size_t *out_written);
+#endif
+
+#ifdef TFM_PSA_ASYNC_CALL
+/**
+ * \brief Call an RoT Service on an established connection without waiting
+ *        for the reply.
+ *
+ * \details The request is queued to the RoT Service and the caller resumes
+ *          while it is handled. Completion is signalled by the interrupt set
+ *          with \ref tfm_nspm_register_async_call_irq, and the status is
+ *          collected with \ref psa_call_async_result. The vectors and the
+ *          buffers they reference must stay valid until then. Only one call
+ *          can be outstanding on a connection, while a stateless RoT Service
+ *          can have several.
+ *
+ * \note Only available to the NSPE in the single-core topology.
+ *
+ * \param[in] handle            A handle to an established connection, or the
+ *                              static handle of a stateless RoT Service.
+ * \param[in] type              The request type.
+ *                              Must be zero( \ref PSA_IPC_CALL) or positive.
+ * \param[in] in_vec            Array of input \ref psa_invec structures.
+ * \param[in] in_len            Number of input \ref psa_invec structures.
+ * \param[in/out] out_vec       Array of output \ref psa_outvec structures.
+ * \param[in] out_len           Number of output \ref psa_outvec structures.
+ * \param[out] token            Identifies the call in
+ *                              \ref psa_call_async_result. It is the handle
+ *                              itself for an established connection.
+ *
+ * \retval PSA_SUCCESS          The request has been queued.
+ * \retval PSA_ERROR_CONNECTION_BUSY The SPM cannot carry a call to a
+ *                              stateless RoT Service at the moment.
+ * \retval PSA_ERROR_PROGRAMMER_ERROR The connection has been terminated by the
+ *                              RoT Service.
+ * \retval "PROGRAMMER ERROR"   The call is a PROGRAMMER ERROR if the call is
+ *                              invalid for \ref psa_call.
+ */
+psa_status_t psa_call_async(psa_handle_t handle, int32_t type,
+                            const psa_invec *in_vec,
+                            size_t in_len,
+                            psa_outvec *out_vec,
+                            size_t out_len,
+                            psa_handle_t *token);
+
+/**
+ * \brief Collect the status of an asynchronous call.
+ *
+ * \param[in] token             The token returned by \ref psa_call_async.
+ * \param[out] status           The status returned by the RoT Service, as
+ *                              \ref psa_call would have returned it.
+ *
+ * \retval PSA_SUCCESS          The call is complete and *status is set.
+ * \retval PSA_ERROR_CONNECTION_BUSY The call has not been replied yet.
+ * \retval PSA_ERROR_DOES_NOT_EXIST No call is outstanding on the connection.
+ * \retval "PROGRAMMER ERROR"   The call is a PROGRAMMER ERROR if token is
+ *                              invalid or status is an invalid memory
+ *                              reference.
+ */
+psa_status_t psa_call_async_result(psa_handle_t token, psa_status_t *status);
+#endif
+
 /**
  * \brief Close a connection to an RoT Service.
  *
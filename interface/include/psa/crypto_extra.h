@@ -24,6 +24,185 @@
 extern "C" {
 #endif
 
+/* Defined in tfm_crypto_defs.h */
+struct tfm_crypto_aead_batch_entry;
+struct tfm_crypto_verify_batch_entry;
+struct tfm_crypto_engine_mem_stats;
+
+/**
+ * \brief Process an authenticated encryption operation on each message of a
+ *        batch, with the same key and algorithm.
+ *
+ * The whole batch is served by a single request to the Crypto service. The
+ * input buffer holds the messages back to back, each of them as its
+ * additional data immediately followed by its plaintext. The ciphertext and
+ * tag of each message are written back to back in the output buffer, in the
+ * order of the messages.
+ *
+ * \param[in]     handle        Handle to the key to use for the operation.
+ * \param[in]     alg           The AEAD algorithm to compute.
+ * \param[in,out] entries       Descriptors of the messages. On success, the
+ *                              status and the output length of each message
+ *                              are filled in.
+ * \param[in]     entry_count   Number of messages, at most
+ *                              #TFM_CRYPTO_AEAD_BATCH_MAX_ENTRIES.
+ * \param[in]     input         Buffer holding the data of the messages.
+ * \param[in]     input_length  Size of the \p input buffer in bytes.
+ * \param[out]    output        Buffer where the outputs are to be written.
+ * \param[in]     output_size   Size of the \p output buffer in bytes.
+ *
+ * \retval #PSA_SUCCESS
+ *         The batch has been processed. The result of each message is given
+ *         by the status of its descriptor.
+ * \retval #PSA_ERROR_INVALID_HANDLE
+ * \retval #PSA_ERROR_NOT_PERMITTED
+ * \retval #PSA_ERROR_INVALID_ARGUMENT
+ * \retval #PSA_ERROR_NOT_SUPPORTED
+ */
+psa_status_t psa_aead_encrypt_batch(psa_key_handle_t handle,
+                                    psa_algorithm_t alg,
+                                    struct tfm_crypto_aead_batch_entry *entries,
+                                    size_t entry_count,
+                                    const uint8_t *input,
+                                    size_t input_length,
+                                    uint8_t *output,
+                                    size_t output_size);
+
+/**
+ * \brief Process an authenticated decryption operation on each message of a
+ *        batch, with the same key and algorithm.
+ *
+ * The whole batch is served by a single request to the Crypto service. The
+ * input buffer holds the messages back to back, each of them as its
+ * additional data immediately followed by its ciphertext and tag. The
+ * plaintext of each message is written back to back in the output buffer, in
+ * the order of the messages. A message which fails to be authenticated has
+ * no output and does not prevent the others from being processed.
+ *
+ * \param[in]     handle        Handle to the key to use for the operation.
+ * \param[in]     alg           The AEAD algorithm to compute.
+ * \param[in,out] entries       Descriptors of the messages. On success, the
+ *                              status and the output length of each message
+ *                              are filled in.
+ * \param[in]     entry_count   Number of messages, at most
+ *                              #TFM_CRYPTO_AEAD_BATCH_MAX_ENTRIES.
+ * \param[in]     input         Buffer holding the data of the messages.
+ * \param[in]     input_length  Size of the \p input buffer in bytes.
+ * \param[out]    output        Buffer where the outputs are to be written.
+ * \param[in]     output_size   Size of the \p output buffer in bytes.
+ *
+ * \retval #PSA_SUCCESS
+ *         The batch has been processed. The result of each message is given
+ *         by the status of its descriptor.
+ * \retval #PSA_ERROR_INVALID_HANDLE
+ * \retval #PSA_ERROR_NOT_PERMITTED
+ * \retval #PSA_ERROR_INVALID_ARGUMENT
+ * \retval #PSA_ERROR_NOT_SUPPORTED
+ */
+psa_status_t psa_aead_decrypt_batch(psa_key_handle_t handle,
+                                    psa_algorithm_t alg,
+                                    struct tfm_crypto_aead_batch_entry *entries,
+                                    size_t entry_count,
+                                    const uint8_t *input,
+                                    size_t input_length,
+                                    uint8_t *output,
+                                    size_t output_size);
+
+/**
+ * \brief Verify the signature of each hash of a batch.
+ *
+ * The whole batch is served by a single request to the Crypto service. Each
+ * item names its own key and algorithm, and the key handles and policies are
+ * only checked once for the items sharing a key. The input buffer holds the
+ * items back to back, each of them as its hash immediately followed by its
+ * signature. A signature which fails to verify does not prevent the others
+ * from being verified.
+ *
+ * \param[in]  entries       Descriptors of the items.
+ * \param[in]  entry_count   Number of items, at most
+ *                           #TFM_CRYPTO_VERIFY_BATCH_MAX_ENTRIES.
+ * \param[in]  input         Buffer holding the hashes and signatures.
+ * \param[in]  input_length  Size of the \p input buffer in bytes.
+ * \param[out] verified      On success, bit \c i is set if the signature of
+ *                           item \c i is valid, and clear otherwise.
+ *
+ * \retval #PSA_SUCCESS
+ *         The batch has been processed. The result of each item is given by
+ *         \p verified.
+ * \retval #PSA_ERROR_INVALID_ARGUMENT
+ * \retval #PSA_ERROR_NOT_SUPPORTED
+ */
+psa_status_t psa_verify_hash_batch(
+                            const struct tfm_crypto_verify_batch_entry *entries,
+                            size_t entry_count,
+                            const uint8_t *input,
+                            size_t input_length,
+                            uint32_t *verified);
+
+/**
+ * \brief Generate random bytes into each buffer of a batch.
+ *
+ * Each request to the Crypto service fills up to
+ * #TFM_CRYPTO_RANDOM_BATCH_MAX_OUTPUTS buffers, so that the cost of a request
+ * is shared across many small random values. The buffers of size 0 are
+ * skipped. The content of the buffers is unspecified if an error is returned.
+ *
+ * \param[out] outputs       Buffers to fill with random bytes.
+ * \param[in]  output_sizes  Size of each buffer in bytes.
+ * \param[in]  count         Number of buffers.
+ *
+ * \retval #PSA_SUCCESS
+ * \retval #PSA_ERROR_INVALID_ARGUMENT
+ * \retval #PSA_ERROR_NOT_SUPPORTED
+ * \retval #PSA_ERROR_INSUFFICIENT_ENTROPY
+ */
+psa_status_t psa_generate_random_batch(uint8_t *const outputs[],
+                                       const size_t output_sizes[],
+                                       size_t count);
+
+/**
+ * \brief Clone a MAC operation.
+ *
+ * This function copies the state of an ongoing MAC operation to a new
+ * operation object, like psa_hash_clone() does for a hash operation. The
+ * input common to several MAC computations under the same key is then only
+ * processed once. After this function returns, the two objects are
+ * independent. Only the HMAC algorithms are supported.
+ *
+ * \param[in] source_operation      The active MAC operation to clone.
+ * \param[in,out] target_operation  The operation object to set up.
+ *                                  It must be initialized but not active.
+ *
+ * \retval #PSA_SUCCESS
+ * \retval #PSA_ERROR_BAD_STATE
+ *         The \p source_operation state is not valid (it must be active).
+ * \retval #PSA_ERROR_BAD_STATE
+ *         The \p target_operation state is not valid (it must be inactive).
+ * \retval #PSA_ERROR_NOT_SUPPORTED
+ *         The algorithm of \p source_operation is not an HMAC algorithm.
+ * \retval #PSA_ERROR_INSUFFICIENT_MEMORY
+ */
+psa_status_t psa_mac_clone(const psa_mac_operation_t *source_operation,
+                           psa_mac_operation_t *target_operation);
+
+/**
+ * \brief Retrieve the statistics of the memory used by the cryptography
+ *        engine of the Crypto service for its dynamic allocations.
+ *
+ * This is a debug function, which is only supported when the service is
+ * built with CRYPTO_ENGINE_MEM_STATS enabled. The peak usage and the
+ * fragmentation reported can be used to size the buffer of the engine.
+ *
+ * \param[out] stats  Statistics of the memory of the engine.
+ *
+ * \retval #PSA_SUCCESS
+ * \retval #PSA_ERROR_INVALID_ARGUMENT
+ * \retval #PSA_ERROR_NOT_SUPPORTED
+ *         The service does not keep statistics of the memory of the engine.
+ */
+psa_status_t psa_crypto_get_engine_mem_stats(
+                                     struct tfm_crypto_engine_mem_stats *stats);
+
 #ifdef __cplusplus
 }
 #endif
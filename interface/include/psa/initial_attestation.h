@@ -48,6 +48,14 @@ extern "C" {
  */
 #define PSA_INITIAL_ATTEST_MAX_TOKEN_SIZE (0x400)
 
+/**
+ * The maximum number of challenges which can be attested by one batch token,
+ * see \ref tfm_initial_attest_get_batch_token.
+ */
+#ifndef TFM_INITIAL_ATTEST_BATCH_MAX_CHALLENGES
+#define TFM_INITIAL_ATTEST_BATCH_MAX_CHALLENGES (16u)
+#endif
+
 /**
  * The list of fixed claims in the initial attestation token is still evolving,
  * you can expect slight changes in the future.
@@ -221,6 +229,109 @@ tfm_initial_attest_get_public_key(uint8_t         *public_key,
                                   size_t          *public_key_len,
                                   psa_ecc_curve_t *elliptic_curve_type);
 
+/**
+ * \brief Get one initial attestation token which attests a batch of
+ *        challenges.
+ *
+ * The challenges are the leaves of a binary SHA-256 Merkle tree, and the
+ * challenge claim of the token is the root of the tree, which is 32 bytes
+ * long. The tree is built as follows:
+ *  - each leaf is SHA-256(0x00 || challenge), in the order of the challenges
+ *  - each node is SHA-256(0x01 || left child || right child)
+ *  - a node without a right sibling is moved up to the next level unchanged
+ *
+ * A verifier checks one challenge of the batch with the token and the
+ * siblings of the path from its leaf up to the root. The token is signed once
+ * for the whole batch.
+ *
+ * \param[in]     auth_challenges  Pointer to the buffer where the challenges
+ *                                 are stored one after the other.
+ * \param[in]     challenge_size   Size of each challenge in bytes. Must be one
+ *                                 of the allowed challenge sizes.
+ * \param[in]     num_challenges   Number of challenges, from 1 to
+ *                                 \ref TFM_INITIAL_ATTEST_BATCH_MAX_CHALLENGES.
+ * \param[out]    token_buf        Pointer to the buffer where attestation
+ *                                 token will be stored.
+ * \param[in]     token_buf_size   Size of allocated buffer for token, in
+ *                                 bytes.
+ * \param[out]    token_size       Size of the token that has been returned,
+ *                                 in bytes.
+ *
+ * \note This function is a TF-M extension of the PSA Initial Attestation API.
+ *       The size of the token is the size returned by
+ *       \ref psa_initial_attest_get_token_size for a challenge of
+ *       \ref PSA_INITIAL_ATTEST_CHALLENGE_SIZE_32 bytes.
+ *
+ * \return Returns error code as specified in \ref psa_status_t.
+ *         PSA_ERROR_NOT_SUPPORTED is returned if the service is built without
+ *         batch tokens.
+ */
+psa_status_t
+tfm_initial_attest_get_batch_token(const uint8_t *auth_challenges,
+                                   size_t         challenge_size,
+                                   size_t         num_challenges,
+                                   uint8_t       *token_buf,
+                                   size_t         token_buf_size,
+                                   size_t        *token_size);
+
+/**
+ * \enum tfm_initial_attest_stage_t
+ *
+ * \brief Stages of the creation of a token, which are profiled separately
+ *        when the service is built with profiling.
+ */
+enum tfm_initial_attest_stage_t {
+    /** Registration of the attestation key, done by the first token only */
+    TFM_INITIAL_ATTEST_STAGE_KEY = 0,
+    /** Gathering of the claims which do not change after boot, from the boot
+     *  data and the platform, done by the first token only
+     */
+    TFM_INITIAL_ATTEST_STAGE_CLAIMS,
+    /** CBOR encoding of the COSE headers and of the claims */
+    TFM_INITIAL_ATTEST_STAGE_ENCODE,
+    /** Hash of the payload and signature */
+    TFM_INITIAL_ATTEST_STAGE_SIGN,
+    /** Number of stages */
+    TFM_INITIAL_ATTEST_STAGE_NUM
+};
+
+/**
+ * \struct tfm_initial_attest_profile_t
+ *
+ * \brief Counters of the tokens created by the service since the counters
+ *        were last reset.
+ *
+ * The cycles are read from the DWT cycle counter of the core, and are 0 on the
+ * cores which do not have one. Only the tokens which are signed are counted,
+ * the encodings done to compute the size of a token are not.
+ */
+struct tfm_initial_attest_profile_t {
+    uint32_t num_tokens;    /*!< Number of tokens created */
+    uint64_t total_cycles;  /*!< Cycles taken by the creation of the tokens */
+    uint64_t stage_cycles[TFM_INITIAL_ATTEST_STAGE_NUM];
+                            /*!< Cycles taken by each stage, indexed by
+                             *   \ref tfm_initial_attest_stage_t
+                             */
+};
+
+/**
+ * \brief Get the profiling counters of the token creation.
+ *
+ * \param[out]  profile  Pointer to the structure where the counters will be
+ *                       stored.
+ * \param[in]   reset    If not 0, the counters are reset after being read.
+ *
+ * \note This function is a TF-M extension of the PSA Initial Attestation API,
+ *       meant for debugging and benchmarking.
+ *
+ * \return Returns error code as specified in \ref psa_status_t.
+ *         PSA_ERROR_NOT_SUPPORTED is returned if the service is built without
+ *         profiling.
+ */
+psa_status_t
+tfm_initial_attest_get_profile(struct tfm_initial_attest_profile_t *profile,
+                               uint32_t reset);
+
 #ifdef __cplusplus
 }
 #endif
@@ -157,6 +157,66 @@ psa_status_t psa_its_get_info(psa_storage_uid_t uid,
  */
 psa_status_t psa_its_remove(psa_storage_uid_t uid);
 
+/**
+ * \brief Lists the UIDs stored by the caller, in batches
+ *
+ * Starting from \p cursor, writes the UIDs of the assets of the caller to
+ * \p uids and updates \p cursor so that the next call lists the following
+ * ones. The assets of the other clients are not listed.
+ *
+ * \note This function is a TF-M extension of the PSA Internal Trusted Storage API.
+ *       The UIDs are listed in no particular order. Each asset which is
+ *       neither set nor removed while the enumeration is in progress is
+ *       listed exactly once.
+ *
+ * \param[in,out] cursor     TFM_STORAGE_LIST_START to list the first UIDs,
+ *                           or the cursor returned by the previous call. It
+ *                           is set to TFM_STORAGE_LIST_END once all the UIDs
+ *                           are listed.
+ * \param[out]    uids       Buffer to write the UIDs to
+ * \param[in]     max_uids   Number of UIDs that \p uids can hold
+ * \param[out]    uid_count  Number of UIDs written to \p uids
+ *
+ * \return A status indicating the success/failure of the operation
+ *
+ * \retval PSA_SUCCESS                 The operation completed successfully
+ * \retval PSA_ERROR_INVALID_ARGUMENT  The operation failed because one of the
+ *                                     provided pointers is invalid, for
+ *                                     example is `NULL` or references memory
+ *                                     the caller cannot access
+ * \retval PSA_ERROR_STORAGE_FAILURE   The operation failed because the physical
+ *                                     storage has failed (Fatal error)
+ */
+psa_status_t psa_its_list(uint32_t *cursor,
+                          psa_storage_uid_t *uids,
+                          size_t max_uids,
+                          size_t *uid_count);
+
+/**
+ * \brief Writes to flash the assets of the hot tier which have been set since
+ *        they were last flushed
+ *
+ * The assets created with TFM_STORAGE_FLAG_HOT are held in RAM and flushed to
+ * flash after a number of writes. This function flushes them all at once,
+ * for example before the device is put in a low power state in which the RAM
+ * is not retained.
+ *
+ * \note This function is a TF-M extension of the PSA Internal Trusted Storage API.
+ *       It flushes the hot assets of all the clients. It does nothing when
+ *       the hot tier is not enabled.
+ *
+ * \return A status indicating the success/failure of the operation
+ *
+ * \retval PSA_SUCCESS                     The operation completed successfully
+ * \retval PSA_ERROR_INSUFFICIENT_STORAGE  The operation failed because there
+ *                                         was insufficient space on the
+ *                                         storage medium
+ * \retval PSA_ERROR_STORAGE_FAILURE       The operation failed because the
+ *                                         physical storage has failed (Fatal
+ *                                         error)
+ */
+psa_status_t psa_its_sync(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -275,6 +275,148 @@ psa_status_t psa_ps_set_extended(psa_storage_uid_t uid,
  */
 uint32_t psa_ps_get_support(void);
 
+/**
+ * \brief Begins a transaction of the caller. The assets which the caller sets
+ *        or removes until the transaction is committed are made persistent
+ *        together, with one update of the storage metadata.
+ *
+ * \note This function is a TF-M extension of the PSA Protected Storage API.
+ *       Only one transaction can be open at a time. While it is open, the
+ *       other clients cannot set or remove assets.
+ *
+ * \return A status indicating the success/failure of the operation
+ *
+ * \retval PSA_SUCCESS              The transaction has begun
+ * \retval PSA_ERROR_BAD_STATE      A transaction is already open
+ * \retval PSA_ERROR_NOT_SUPPORTED  The implementation of the API does not
+ *                                  support this function
+ */
+psa_status_t psa_ps_begin_transaction(void);
+
+/**
+ * \brief Commits the transaction of the caller. Either all the changes made
+ *        in the transaction are written in the physical storage, or none of
+ *        them is.
+ *
+ * \note This function is a TF-M extension of the PSA Protected Storage API.
+ *
+ * \return A status indicating the success/failure of the operation
+ *
+ * \retval PSA_SUCCESS                The changes are written in the physical
+ *                                    storage
+ * \retval PSA_ERROR_BAD_STATE        The caller has no open transaction
+ * \retval PSA_ERROR_STORAGE_FAILURE  The changes were not written correctly
+ *                                    in the physical storage, so the
+ *                                    transaction has been aborted
+ * \retval PSA_ERROR_NOT_SUPPORTED    The implementation of the API does not
+ *                                    support this function
+ * \retval PSA_ERROR_GENERIC_ERROR    The operation failed due to an
+ *                                    unspecified error
+ */
+psa_status_t psa_ps_commit_transaction(void);
+
+/**
+ * \brief Aborts the transaction of the caller, discarding all the changes
+ *        made in it.
+ *
+ * \note This function is a TF-M extension of the PSA Protected Storage API.
+ *
+ * \return A status indicating the success/failure of the operation
+ *
+ * \retval PSA_SUCCESS              The changes are discarded
+ * \retval PSA_ERROR_BAD_STATE      The caller has no open transaction
+ * \retval PSA_ERROR_NOT_SUPPORTED  The implementation of the API does not
+ *                                  support this function
+ */
+psa_status_t psa_ps_abort_transaction(void);
+
+/**
+ * \brief Queues the creation of a new asset, or the modification of an
+ *        existing asset, and returns without waiting for the asset to be
+ *        written in the physical storage.
+ *
+ * \param[in] uid           The identifier for the data
+ * \param[in] data_length   The size in bytes of the data in `p_data`
+ * \param[in] p_data        A buffer containing the data
+ * \param[in] create_flags  The flags indicating the properties of the data
+ *
+ * \note This function is a TF-M extension of the PSA Protected Storage API.
+ *       The write is made persistent later, at the latest when the caller
+ *       calls \ref psa_ps_flush, which reports its errors. The asset reads
+ *       of the caller return the queued data. If the implementation does not
+ *       queue the write, it is made persistent before this function returns.
+ *
+ * \return A status indicating the success/failure of the operation
+ *
+ * \retval PSA_SUCCESS                The write is queued or made persistent
+ * \retval PSA_ERROR_INVALID_ARGUMENT The operation failed because one of the
+ *                                    provided pointers(`p_data`) is invalid,
+ *                                    for example is `NULL` or references
+ *                                    memory the caller cannot access
+ * \retval PSA_ERROR_NOT_SUPPORTED    The operation failed because one or more
+ *                                    of the flags provided in `create_flags`
+ *                                    is not supported or is not valid
+ * \retval PSA_ERROR_BAD_STATE        Another caller has an open transaction
+ * \retval PSA_ERROR_GENERIC_ERROR    The operation failed because of an
+ *                                    unspecified internal failure
+ */
+psa_status_t psa_ps_set_async(psa_storage_uid_t uid,
+                              size_t data_length,
+                              const void *p_data,
+                              psa_storage_create_flags_t create_flags);
+
+/**
+ * \brief Writes all the queued asset writes in the physical storage, and
+ *        reports whether the writes queued by the caller are persistent.
+ *
+ * \note This function is a TF-M extension of the PSA Protected Storage API.
+ *
+ * \return A status indicating the success/failure of the operation
+ *
+ * \retval PSA_SUCCESS                All the writes queued by the caller since
+ *                                    its last flush are persistent
+ * \retval Any other error            The error of the first write queued by
+ *                                    the caller since its last flush that
+ *                                    failed, as \ref psa_ps_set would return
+ *                                    it
+ */
+psa_status_t psa_ps_flush(void);
+
+/**
+ * \brief Lists the UIDs stored by the caller, in batches
+ *
+ * Starting from \p cursor, writes the UIDs of the assets of the caller to
+ * \p uids and updates \p cursor so that the next call lists the following
+ * ones. The assets of the other clients are not listed.
+ *
+ * \note This function is a TF-M extension of the PSA Protected Storage API.
+ *       The UIDs are listed in no particular order. Each asset which is
+ *       neither set nor removed while the enumeration is in progress is
+ *       listed exactly once.
+ *
+ * \param[in,out] cursor     TFM_STORAGE_LIST_START to list the first UIDs,
+ *                           or the cursor returned by the previous call. It
+ *                           is set to TFM_STORAGE_LIST_END once all the UIDs
+ *                           are listed.
+ * \param[out]    uids       Buffer to write the UIDs to
+ * \param[in]     max_uids   Number of UIDs that \p uids can hold
+ * \param[out]    uid_count  Number of UIDs written to \p uids
+ *
+ * \return A status indicating the success/failure of the operation
+ *
+ * \retval PSA_SUCCESS                 The operation completed successfully
+ * \retval PSA_ERROR_INVALID_ARGUMENT  The operation failed because one of the
+ *                                     provided pointers is invalid, for
+ *                                     example is `NULL` or references memory
+ *                                     the caller cannot access
+ * \retval PSA_ERROR_STORAGE_FAILURE   The operation failed because the physical
+ *                                     storage has failed (Fatal error)
+ */
+psa_status_t psa_ps_list(uint32_t *cursor,
+                         psa_storage_uid_t *uids,
+                         size_t max_uids,
+                         size_t *uid_count);
+
 #ifdef __cplusplus
 }
 #endif
@@ -49,6 +49,14 @@ extern "C" {
 /* Store a set of one or more Secure Partition signals */
 typedef uint32_t psa_signal_t;
 
+/* Value returned by a first-level interrupt handler */
+typedef uint32_t psa_flih_result_t;
+
+/* The interrupt is handled, its signal is not asserted */
+#define PSA_FLIH_NO_SIGNAL      ((psa_flih_result_t)0u)
+/* The interrupt signal is asserted, to defer work to the Secure Partition */
+#define PSA_FLIH_SIGNAL         ((psa_flih_result_t)1u)
+
 /**
  * Describe a message received by an RoT Service after calling \ref psa_get().
  */
@@ -202,6 +210,107 @@ size_t psa_skip(psa_handle_t msg_handle, uint32_t invec_idx, size_t num_bytes);
 void psa_write(psa_handle_t msg_handle, uint32_t outvec_idx,
                const void *buffer, size_t num_bytes);
 
+/**
+ * \brief Map a client input vector for direct access by the RoT Service.
+ *
+ * \param[in] msg_handle        Handle for the client's message.
+ * \param[in] invec_idx         Index of the input vector to map. Must be
+ *                              less than \ref PSA_MAX_IOVEC.
+ *
+ * \retval "Not NULL"           Address of the input vector, which the RoT
+ *                              Service can read msg->in_size[invec_idx]
+ *                              bytes from until psa_unmap_invec() or
+ *                              psa_reply() is called.
+ * \retval NULL                 The input vector has length zero.
+ * \retval "PROGRAMMER ERROR"   The call is invalid, one or more of the
+ *                              following are true:
+ * \arg                           msg_handle is invalid.
+ * \arg                           msg_handle does not refer to a request
+ *                                message.
+ * \arg                           invec_idx is equal to or greater than
+ *                                \ref PSA_MAX_IOVEC.
+ * \arg                           The RoT Service does not run privileged.
+ * \arg                           The input vector has already been mapped, or
+ *                                accessed with psa_read() or psa_skip().
+ *
+ * \note The mapping avoids the copy made by psa_read(). It is only available
+ *       to privileged RoT Services, which can reach the client memory
+ *       directly.
+ */
+const void *psa_map_invec(psa_handle_t msg_handle, uint32_t invec_idx);
+
+/**
+ * \brief Unmap a client input vector mapped by \ref psa_map_invec().
+ *
+ * \param[in] msg_handle        Handle for the client's message.
+ * \param[in] invec_idx         Index of the input vector to unmap. Must be
+ *                              less than \ref PSA_MAX_IOVEC.
+ *
+ * \retval void                 Success.
+ * \retval "PROGRAMMER ERROR"   The call is invalid, one or more of the
+ *                              following are true:
+ * \arg                           msg_handle is invalid.
+ * \arg                           msg_handle does not refer to a request
+ *                                message.
+ * \arg                           invec_idx is equal to or greater than
+ *                                \ref PSA_MAX_IOVEC.
+ * \arg                           The input vector is not mapped, or has
+ *                                already been unmapped.
+ */
+void psa_unmap_invec(psa_handle_t msg_handle, uint32_t invec_idx);
+
+/**
+ * \brief Map a client output vector for direct access by the RoT Service.
+ *
+ * \param[in] msg_handle        Handle for the client's message.
+ * \param[in] outvec_idx        Index of the output vector to map. Must be
+ *                              less than \ref PSA_MAX_IOVEC.
+ *
+ * \retval "Not NULL"           Address of the output vector, which the RoT
+ *                              Service can write msg->out_size[outvec_idx]
+ *                              bytes to until psa_unmap_outvec() or
+ *                              psa_reply() is called.
+ * \retval NULL                 The output vector has length zero.
+ * \retval "PROGRAMMER ERROR"   The call is invalid, one or more of the
+ *                              following are true:
+ * \arg                           msg_handle is invalid.
+ * \arg                           msg_handle does not refer to a request
+ *                                message.
+ * \arg                           outvec_idx is equal to or greater than
+ *                                \ref PSA_MAX_IOVEC.
+ * \arg                           The RoT Service does not run privileged.
+ * \arg                           The output vector has already been mapped, or
+ *                                written with psa_write().
+ *
+ * \note The number of bytes written is only reported to the client by
+ *       psa_unmap_outvec(). An output vector which is still mapped on
+ *       psa_reply() is reported as empty.
+ */
+void *psa_map_outvec(psa_handle_t msg_handle, uint32_t outvec_idx);
+
+/**
+ * \brief Unmap a client output vector mapped by \ref psa_map_outvec().
+ *
+ * \param[in] msg_handle        Handle for the client's message.
+ * \param[in] outvec_idx        Index of the output vector to unmap. Must be
+ *                              less than \ref PSA_MAX_IOVEC.
+ * \param[in] len               Number of bytes written to the output vector.
+ *
+ * \retval void                 Success.
+ * \retval "PROGRAMMER ERROR"   The call is invalid, one or more of the
+ *                              following are true:
+ * \arg                           msg_handle is invalid.
+ * \arg                           msg_handle does not refer to a request
+ *                                message.
+ * \arg                           outvec_idx is equal to or greater than
+ *                                \ref PSA_MAX_IOVEC.
+ * \arg                           The output vector is not mapped, or has
+ *                                already been unmapped.
+ * \arg                           len is greater than the output vector size.
+ */
+void psa_unmap_outvec(psa_handle_t msg_handle, uint32_t outvec_idx,
+                      size_t len);
+
 /**
  * \brief Complete handling of a specific message and unblock the client.
  *
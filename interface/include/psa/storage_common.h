@@ -29,6 +29,11 @@ typedef uint64_t psa_storage_uid_t;
 #define PSA_STORAGE_FLAG_NO_CONFIDENTIALITY (1u << 1)
 #define PSA_STORAGE_FLAG_NO_REPLAY_PROTECTION (1u << 2)
 
+/* Flag of the assets which are rewritten often, held in the RAM hot tier of
+ * the ITS service when it is enabled, a TF-M extension
+ */
+#define TFM_STORAGE_FLAG_HOT (1u << 16)
+
 /* A container for metadata associated with a specific uid */
 
 struct psa_storage_info_t {
@@ -39,6 +44,10 @@ struct psa_storage_info_t {
 
 #define PSA_STORAGE_SUPPORT_SET_EXTENDED (1u << 0)
 
+/* Cursors of the enumeration of the stored UIDs, a TF-M extension */
+#define TFM_STORAGE_LIST_START 0u
+#define TFM_STORAGE_LIST_END   0xFFFFFFFFu
+
 #define PSA_ERROR_INVALID_SIGNATURE     ((psa_status_t)-149)
 #define PSA_ERROR_DATA_CORRUPT          ((psa_status_t)-152)
 
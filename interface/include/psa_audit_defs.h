@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -15,6 +15,34 @@ extern "C" {
 #include <stdint.h>
 #include "tfm_api.h"
 
+/*!
+ * \def PSA_AUDIT_SEVERITY_SHIFT
+ *
+ * \brief The 4 most significant bits of the ID of a record give its severity,
+ *        which the Audit logging service can filter on. The IDs without
+ *        severity bits have the lowest one.
+ */
+#define PSA_AUDIT_SEVERITY_SHIFT    (28U)
+
+#define PSA_AUDIT_SEVERITY_DEBUG    (0U)
+#define PSA_AUDIT_SEVERITY_INFO     (1U)
+#define PSA_AUDIT_SEVERITY_WARNING  (2U)
+#define PSA_AUDIT_SEVERITY_ERROR    (3U)
+#define PSA_AUDIT_SEVERITY_CRITICAL (4U)
+
+/*!
+ * \brief Gets the severity of a record from its ID
+ */
+#define PSA_AUDIT_SEVERITY(id)      ((uint32_t)(id) >> PSA_AUDIT_SEVERITY_SHIFT)
+
+/*!
+ * \brief Builds the ID of a record from its severity and a code of at most
+ *        28 bits
+ */
+#define PSA_AUDIT_ID(severity, code)                                 \
+    (((uint32_t)(severity) << PSA_AUDIT_SEVERITY_SHIFT) |            \
+     ((uint32_t)(code) & ((1U << PSA_AUDIT_SEVERITY_SHIFT) - 1U)))
+
 /*!
  * \struct psa_audit_record
  *
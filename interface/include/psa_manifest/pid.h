@@ -20,6 +20,8 @@ extern "C" {
 #define TFM_SP_CRYPTO                                                  (259)
 #define TFM_SP_PLATFORM                                                (260)
 #define TFM_SP_INITIAL_ATTESTATION                                     (261)
+#define TFM_SP_FWU                                                     (271)
+#define TFM_SP_TLS_RECORD                                              (272)
 #define TFM_SP_CORE_TEST                                               (262)
 #define TFM_SP_CORE_TEST_2                                             (263)
 #define TFM_SP_SECURE_TEST_PARTITION                                   (264)
@@ -30,7 +32,7 @@ extern "C" {
 #define TFM_SP_SECURE_CLIENT_2                                         (269)
 #define TFM_SP_MULTI_CORE_TEST                                         (270)
 
-#define TFM_MAX_USER_PARTITIONS                                        (15)
+#define TFM_MAX_USER_PARTITIONS                                        (17)
 
 #ifdef __cplusplus
 }
@@ -17,42 +17,130 @@ extern "C" {
 /******** TFM_SP_STORAGE ********/
 #define TFM_SST_SET_SID                                            (0x00000060U)
 #define TFM_SST_SET_VERSION                                        (1U)
+#define TFM_SST_SET_HANDLE                                         ((psa_handle_t)0x40000060)
 #define TFM_SST_GET_SID                                            (0x00000061U)
 #define TFM_SST_GET_VERSION                                        (1U)
+#define TFM_SST_GET_HANDLE                                         ((psa_handle_t)0x40000061)
 #define TFM_SST_GET_INFO_SID                                       (0x00000062U)
 #define TFM_SST_GET_INFO_VERSION                                   (1U)
+#define TFM_SST_GET_INFO_HANDLE                                    ((psa_handle_t)0x40000062)
 #define TFM_SST_REMOVE_SID                                         (0x00000063U)
 #define TFM_SST_REMOVE_VERSION                                     (1U)
+#define TFM_SST_REMOVE_HANDLE                                      ((psa_handle_t)0x40000063)
 #define TFM_SST_GET_SUPPORT_SID                                    (0x00000064U)
 #define TFM_SST_GET_SUPPORT_VERSION                                (1U)
+#define TFM_SST_GET_SUPPORT_HANDLE                                 ((psa_handle_t)0x40000064)
+#define TFM_SST_TRANSACTION_SID                                    (0x00000065U)
+#define TFM_SST_TRANSACTION_VERSION                                (1U)
+#define TFM_SST_TRANSACTION_HANDLE                                 ((psa_handle_t)0x40000065)
+#define TFM_SST_SET_ASYNC_SID                                      (0x00000066U)
+#define TFM_SST_SET_ASYNC_VERSION                                  (1U)
+#define TFM_SST_SET_ASYNC_HANDLE                                   ((psa_handle_t)0x40000066)
+#define TFM_SST_FLUSH_SID                                          (0x00000067U)
+#define TFM_SST_FLUSH_VERSION                                      (1U)
+#define TFM_SST_FLUSH_HANDLE                                       ((psa_handle_t)0x40000067)
+#define TFM_SST_LIST_SID                                           (0x00000068U)
+#define TFM_SST_LIST_VERSION                                       (1U)
+#define TFM_SST_LIST_HANDLE                                        ((psa_handle_t)0x40000068)
 
 /******** TFM_SP_ITS ********/
 #define TFM_ITS_SET_SID                                            (0x00000070U)
 #define TFM_ITS_SET_VERSION                                        (1U)
+#define TFM_ITS_SET_HANDLE                                         ((psa_handle_t)0x40000070)
 #define TFM_ITS_GET_SID                                            (0x00000071U)
 #define TFM_ITS_GET_VERSION                                        (1U)
+#define TFM_ITS_GET_HANDLE                                         ((psa_handle_t)0x40000071)
 #define TFM_ITS_GET_INFO_SID                                       (0x00000072U)
 #define TFM_ITS_GET_INFO_VERSION                                   (1U)
+#define TFM_ITS_GET_INFO_HANDLE                                    ((psa_handle_t)0x40000072)
 #define TFM_ITS_REMOVE_SID                                         (0x00000073U)
 #define TFM_ITS_REMOVE_VERSION                                     (1U)
+#define TFM_ITS_REMOVE_HANDLE                                      ((psa_handle_t)0x40000073)
+#define TFM_ITS_LIST_SID                                           (0x00000074U)
+#define TFM_ITS_LIST_VERSION                                       (1U)
+#define TFM_ITS_LIST_HANDLE                                        ((psa_handle_t)0x40000074)
+#define TFM_ITS_SYNC_SID                                           (0x00000075U)
+#define TFM_ITS_SYNC_VERSION                                       (1U)
+#define TFM_ITS_SYNC_HANDLE                                        ((psa_handle_t)0x40000075)
 
 /******** TFM_SP_CRYPTO ********/
 #define TFM_CRYPTO_SID                                             (0x00000080U)
 #define TFM_CRYPTO_VERSION                                         (1U)
+#define TFM_CRYPTO_HANDLE                                          ((psa_handle_t)0x40000080)
+#define TFM_CRYPTO_ASYM_SID                                        (0x00000081U)
+#define TFM_CRYPTO_ASYM_VERSION                                    (1U)
+#define TFM_CRYPTO_ASYM_HANDLE                                     ((psa_handle_t)0x40000081)
 
 /******** TFM_SP_PLATFORM ********/
 #define TFM_SP_PLATFORM_SYSTEM_RESET_SID                           (0x00000040U)
 #define TFM_SP_PLATFORM_SYSTEM_RESET_VERSION                       (1U)
+#define TFM_SP_PLATFORM_SYSTEM_RESET_HANDLE                        ((psa_handle_t)0x40000040)
 #define TFM_SP_PLATFORM_IOCTL_SID                                  (0x00000041U)
 #define TFM_SP_PLATFORM_IOCTL_VERSION                              (1U)
+#define TFM_SP_PLATFORM_IOCTL_HANDLE                               ((psa_handle_t)0x40000041)
+#define TFM_SP_PLATFORM_IPC_TRACE_SID                              (0x00000042U)
+#define TFM_SP_PLATFORM_IPC_TRACE_VERSION                          (1U)
+#define TFM_SP_PLATFORM_IPC_TRACE_HANDLE                           ((psa_handle_t)0x40000042)
+#define TFM_SP_PLATFORM_BOOT_TIME_SID                              (0x00000043U)
+#define TFM_SP_PLATFORM_BOOT_TIME_VERSION                          (1U)
+#define TFM_SP_PLATFORM_BOOT_TIME_HANDLE                           ((psa_handle_t)0x40000043)
+#define TFM_SP_PLATFORM_SPM_STATS_SID                              (0x00000044U)
+#define TFM_SP_PLATFORM_SPM_STATS_VERSION                          (1U)
+#define TFM_SP_PLATFORM_SPM_STATS_HANDLE                           ((psa_handle_t)0x40000044)
+#define TFM_SP_PLATFORM_IOCTL_VECTOR_SID                           (0x00000045U)
+#define TFM_SP_PLATFORM_IOCTL_VECTOR_VERSION                       (1U)
+#define TFM_SP_PLATFORM_IOCTL_VECTOR_HANDLE                        ((psa_handle_t)0x40000045)
+#define TFM_SP_PLATFORM_SPM_PROFILE_SID                            (0x00000046U)
+#define TFM_SP_PLATFORM_SPM_PROFILE_VERSION                        (1U)
+#define TFM_SP_PLATFORM_SPM_PROFILE_HANDLE                         ((psa_handle_t)0x40000046)
+#define TFM_SP_PLATFORM_RESOURCE_USAGE_SID                         (0x00000047U)
+#define TFM_SP_PLATFORM_RESOURCE_USAGE_VERSION                     (1U)
+#define TFM_SP_PLATFORM_RESOURCE_USAGE_HANDLE                      ((psa_handle_t)0x40000047)
 
 /******** TFM_SP_INITIAL_ATTESTATION ********/
 #define TFM_ATTEST_GET_TOKEN_SID                                   (0x00000020U)
 #define TFM_ATTEST_GET_TOKEN_VERSION                               (1U)
+#define TFM_ATTEST_GET_TOKEN_HANDLE                                ((psa_handle_t)0x40000020)
 #define TFM_ATTEST_GET_TOKEN_SIZE_SID                              (0x00000021U)
 #define TFM_ATTEST_GET_TOKEN_SIZE_VERSION                          (1U)
+#define TFM_ATTEST_GET_TOKEN_SIZE_HANDLE                           ((psa_handle_t)0x40000021)
 #define TFM_ATTEST_GET_PUBLIC_KEY_SID                              (0x00000022U)
 #define TFM_ATTEST_GET_PUBLIC_KEY_VERSION                          (1U)
+#define TFM_ATTEST_GET_PUBLIC_KEY_HANDLE                           ((psa_handle_t)0x40000022)
+#define TFM_ATTEST_GET_BATCH_TOKEN_SID                             (0x00000023U)
+#define TFM_ATTEST_GET_BATCH_TOKEN_VERSION                         (1U)
+#define TFM_ATTEST_GET_BATCH_TOKEN_HANDLE                          ((psa_handle_t)0x40000023)
+#define TFM_ATTEST_GET_PROFILE_SID                                 (0x00000024U)
+#define TFM_ATTEST_GET_PROFILE_VERSION                             (1U)
+#define TFM_ATTEST_GET_PROFILE_HANDLE                              ((psa_handle_t)0x40000024)
+
+/******** TFM_SP_FWU ********/
+#define TFM_FWU_WRITE_SID                                          (0x000000A0U)
+#define TFM_FWU_WRITE_VERSION                                      (1U)
+#define TFM_FWU_WRITE_HANDLE                                       ((psa_handle_t)0x400000A0)
+#define TFM_FWU_INSTALL_SID                                        (0x000000A1U)
+#define TFM_FWU_INSTALL_VERSION                                    (1U)
+#define TFM_FWU_INSTALL_HANDLE                                     ((psa_handle_t)0x400000A1)
+#define TFM_FWU_ABORT_SID                                          (0x000000A2U)
+#define TFM_FWU_ABORT_VERSION                                      (1U)
+#define TFM_FWU_ABORT_HANDLE                                       ((psa_handle_t)0x400000A2)
+#define TFM_FWU_QUERY_SID                                          (0x000000A3U)
+#define TFM_FWU_QUERY_VERSION                                      (1U)
+#define TFM_FWU_QUERY_HANDLE                                       ((psa_handle_t)0x400000A3)
+
+/******** TFM_SP_TLS_RECORD ********/
+#define TFM_TLS_RECORD_SETUP_SID                                   (0x000000B0U)
+#define TFM_TLS_RECORD_SETUP_VERSION                               (1U)
+#define TFM_TLS_RECORD_SETUP_HANDLE                                ((psa_handle_t)0x400000B0)
+#define TFM_TLS_RECORD_PROTECT_SID                                 (0x000000B1U)
+#define TFM_TLS_RECORD_PROTECT_VERSION                             (1U)
+#define TFM_TLS_RECORD_PROTECT_HANDLE                              ((psa_handle_t)0x400000B1)
+#define TFM_TLS_RECORD_UNPROTECT_SID                               (0x000000B2U)
+#define TFM_TLS_RECORD_UNPROTECT_VERSION                           (1U)
+#define TFM_TLS_RECORD_UNPROTECT_HANDLE                            ((psa_handle_t)0x400000B2)
+#define TFM_TLS_RECORD_ABORT_SID                                   (0x000000B3U)
+#define TFM_TLS_RECORD_ABORT_VERSION                               (1U)
+#define TFM_TLS_RECORD_ABORT_HANDLE                                ((psa_handle_t)0x400000B3)
 
 /******** TFM_SP_CORE_TEST ********/
 #define SPM_CORE_TEST_INIT_SUCCESS_SID                             (0x0000F020U)
@@ -105,6 +193,11 @@ extern "C" {
 #define IPC_SERVICE_TEST_APP_ACCESS_PSA_MEM_VERSION                (1U)
 #define IPC_SERVICE_TEST_CLIENT_PROGRAMMER_ERROR_SID               (0x0000F084U)
 #define IPC_SERVICE_TEST_CLIENT_PROGRAMMER_ERROR_VERSION           (1U)
+#define IPC_SERVICE_TEST_BENCH_SID                                 (0x0000F085U)
+#define IPC_SERVICE_TEST_BENCH_VERSION                             (1U)
+#define IPC_SERVICE_TEST_STATELESS_SID                             (0x0000F086U)
+#define IPC_SERVICE_TEST_STATELESS_VERSION                         (1U)
+#define IPC_SERVICE_TEST_STATELESS_HANDLE                          ((psa_handle_t)0x4000F086)
 
 /******** TFM_SP_IPC_CLIENT_TEST ********/
 #define IPC_CLIENT_TEST_BASIC_SID                                  (0x0000F060U)
@@ -117,6 +210,8 @@ extern "C" {
 #define IPC_CLIENT_TEST_APP_ACCESS_PSA_MEM_VERSION                 (1U)
 #define IPC_CLIENT_TEST_MEM_CHECK_SID                              (0x0000F064U)
 #define IPC_CLIENT_TEST_MEM_CHECK_VERSION                          (1U)
+#define IPC_CLIENT_TEST_BENCH_SID                                  (0x0000F065U)
+#define IPC_CLIENT_TEST_BENCH_VERSION                              (1U)
 
 /******** TFM_IRQ_TEST_1 ********/
 #define SPM_CORE_IRQ_TEST_1_PREPARE_TEST_SCENARIO_SID              (0x0000F0A0U)
@@ -138,6 +233,11 @@ extern "C" {
 #define MULTI_CORE_MULTI_CLIENT_CALL_TEST_1_SID                    (0x0000F101U)
 #define MULTI_CORE_MULTI_CLIENT_CALL_TEST_1_VERSION                (1U)
 
+/******** Shared memory channels ********/
+#define IPC_SERVICE_TEST_SHM_ID                                    (0U)
+#define IPC_SERVICE_TEST_SHM_SIZE                                  (0x40U)
+#define TFM_SHM_NUM                                                (1U)
+
 #ifdef __cplusplus
 }
 #endif
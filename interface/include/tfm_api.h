@@ -68,6 +68,16 @@ struct tfm_control_parameter_t {
    size_t out_len;
 };
 
+#ifdef TFM_PSA_ASYNC_CALL
+/* The secure side returns the token of an asynchronous call in it */
+struct tfm_async_control_parameter_t {
+   int32_t type;
+   size_t in_len;
+   size_t out_len;
+   psa_handle_t token;
+};
+#endif
+
 /********************* Secure function declarations ***************************/
 
 /**
@@ -82,6 +92,22 @@ struct tfm_control_parameter_t {
  */
 enum tfm_status_e tfm_register_client_id (int32_t ns_client_id);
 
+/**
+ * \brief Register the word in which NS RTOS publishes the TZ context ID of the
+ *        running thread.
+ *
+ * \param[in] slot              The context slot, in NS memory which only
+ *                              privileged NS software can write. NULL to
+ *                              unregister it.
+ * \retval TFM_SUCCESS          The slot registered successfully.
+ * \retval error code           The slot registration failed, an error code
+ *                              returned according to \ref tfm_status_e.
+ * \note This function have to be called from handler mode. Once the slot is
+ *       registered, TF-M reads it on each secure call and NS RTOS can stop
+ *       calling TZ_LoadContext_S() and TZ_StoreContext_S() on thread switch.
+ */
+enum tfm_status_e tfm_register_ns_ctx_slot(const volatile uint32_t *slot);
+
 /**
  * \brief Retrieve the version of the PSA Framework API that is implemented.
  *
@@ -124,6 +150,60 @@ psa_status_t tfm_psa_call_veneer(psa_handle_t handle,
                                const psa_invec *in_vec,
                                psa_outvec *out_vec);
 
+/**
+ * \brief Call a secure function with a batch of requests on a connection.
+ *
+ * \param[in] handle            Handle to connection.
+ * \param[in/out] calls         Array of \ref psa_batch_call_t structures.
+ * \param[in] num_calls         Number of \ref psa_batch_call_t structures.
+ *
+ * \return Returns \ref psa_status_t status code.
+ */
+psa_status_t tfm_psa_call_batch_veneer(psa_handle_t handle,
+                                       psa_batch_call_t *calls,
+                                       size_t num_calls);
+
+#ifdef TFM_PSA_ASYNC_CALL
+/**
+ * \brief Call a secure function referenced by a connection handle without
+ *        waiting for the reply.
+ *
+ * \param[in] handle            Handle to connection.
+ * \param[in/out] ctrl_param    Parameter structure, includes request type,
+ *                              in_num and out_num. The token of the call is
+ *                              returned in it.
+ * \param[in] in_vec            Array of input \ref psa_invec structures.
+ * \param[in/out] out_vec       Array of output \ref psa_outvec structures.
+ *
+ * \return Returns \ref psa_status_t status code.
+ */
+psa_status_t tfm_psa_call_async_veneer(psa_handle_t handle,
+                               struct tfm_async_control_parameter_t *ctrl_param,
+                               const psa_invec *in_vec,
+                               psa_outvec *out_vec);
+
+/**
+ * \brief Collect the status of an asynchronous call.
+ *
+ * \param[in] handle            Token of the call.
+ * \param[out] status           Status replied by the secure function.
+ *
+ * \return Returns \ref psa_status_t status code.
+ */
+psa_status_t tfm_psa_call_async_result_veneer(psa_handle_t handle,
+                                              psa_status_t *status);
+
+/**
+ * \brief Set the non-secure interrupt pended when an asynchronous call
+ *        completes.
+ *
+ * \param[in] irq_line          Interrupt line, negative to disable.
+ *
+ * \return Returns \ref psa_status_t status code.
+ */
+psa_status_t tfm_psa_call_async_set_irq_veneer(int32_t irq_line);
+#endif
+
 /**
  * \brief Close connection to secure function referenced by a connection handle.
  *
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __TFM_BOOT_TIME_DEFS_H__
+#define __TFM_BOOT_TIME_DEFS_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Maximum number of stages recorded by BL2 and by the secure image */
+#define TFM_BOOT_TIME_BL2_ENTRIES       24
+#define TFM_BOOT_TIME_S_ENTRIES         4
+#define TFM_BOOT_TIME_ENTRIES           (TFM_BOOT_TIME_BL2_ENTRIES + \
+                                         TFM_BOOT_TIME_S_ENTRIES)
+
+/* Boot stages, recorded when they end. The BL2 stages which are done per
+ * image or per slot can be recorded several times.
+ */
+enum tfm_boot_time_stage_t {
+    TFM_BOOT_TIME_BL2_START = 0x01,     /* BL2 main() entry                 */
+    TFM_BOOT_TIME_BL2_PLATFORM_INIT,    /* Platform and flash initialized   */
+    TFM_BOOT_TIME_BL2_HEADERS_READ,     /* Image headers of the slots read  */
+    TFM_BOOT_TIME_BL2_IMAGE_HASH,       /* Image hash computed              */
+    TFM_BOOT_TIME_BL2_IMAGE_SIG,        /* Image signature verified         */
+    TFM_BOOT_TIME_BL2_UPDATE,           /* Image swapped or copied          */
+    TFM_BOOT_TIME_BL2_RAM_LOAD,         /* Image loaded to RAM              */
+    TFM_BOOT_TIME_BL2_BOOT_STATUS,      /* Boot status saved                */
+    TFM_BOOT_TIME_BL2_JUMP,             /* Jump to the secure image         */
+
+    TFM_BOOT_TIME_S_START = 0x20,       /* Secure image main() entry        */
+    TFM_BOOT_TIME_S_CORE_INIT,          /* tfm_core_init() done             */
+    TFM_BOOT_TIME_S_SPM_INIT,           /* Partitions initialized (library
+                                         * model), or scheduler started (IPC
+                                         * model)                           */
+    TFM_BOOT_TIME_S_NS_START,           /* Jump to the non-secure image     */
+};
+
+/* A boot stage record */
+struct tfm_boot_time_entry_t {
+    uint32_t stage;                 /* \ref tfm_boot_time_stage_t          */
+    uint32_t cycles;                /* DWT cycle counter at the stage end  */
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TFM_BOOT_TIME_DEFS_H__ */
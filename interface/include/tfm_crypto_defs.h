@@ -29,6 +29,65 @@ struct tfm_crypto_aead_pack_input {
     uint32_t nonce_length;
 };
 
+/**
+ * \brief Maximum number of messages which can be processed by a single batch
+ *        AEAD request
+ */
+#define TFM_CRYPTO_AEAD_BATCH_MAX_ENTRIES (16u)
+
+/**
+ * \brief Descriptor of a message processed by a batch AEAD request
+ *
+ * The messages of a batch are laid out back to back in a single input buffer,
+ * each of them as its additional data immediately followed by its plaintext
+ * (encryption) or its ciphertext and tag (decryption). Their outputs are
+ * written back to back in a single output buffer, in the same order.
+ */
+struct tfm_crypto_aead_batch_entry {
+    uint8_t nonce[TFM_CRYPTO_MAX_NONCE_LENGTH]; /*!< Nonce of the message */
+    uint32_t nonce_length;           /*!< Length of the nonce in bytes */
+    uint32_t additional_data_length; /*!< Length of the additional data in the
+                                      *   input buffer
+                                      */
+    uint32_t input_length;           /*!< Length of the plaintext or ciphertext
+                                      *   in the input buffer
+                                      */
+    uint32_t output_length;          /*!< Output: length of the output of the
+                                      *   message in the output buffer
+                                      */
+    psa_status_t status;             /*!< Output: status of the message */
+};
+
+/**
+ * \brief Result of a message processed by a batch AEAD request, as returned
+ *        by the service
+ */
+struct tfm_crypto_aead_batch_result {
+    psa_status_t status;    /*!< Status of the message */
+    uint32_t output_length; /*!< Length of the output of the message */
+};
+
+/**
+ * \brief Maximum number of signatures which can be verified by a single batch
+ *        verification request, one per bit of the result bitmap
+ */
+#define TFM_CRYPTO_VERIFY_BATCH_MAX_ENTRIES (32u)
+
+/**
+ * \brief Descriptor of a signature verified by a batch verification request
+ *
+ * The items of a batch are laid out back to back in a single input buffer,
+ * each of them as its hash immediately followed by its signature.
+ */
+struct tfm_crypto_verify_batch_entry {
+    psa_key_handle_t key_handle; /*!< Handle of the key to verify with */
+    psa_algorithm_t alg;         /*!< Signature algorithm */
+    uint32_t hash_length;        /*!< Length of the hash in the input buffer */
+    uint32_t signature_length;   /*!< Length of the signature in the input
+                                  *   buffer
+                                  */
+};
+
 /**
  * \brief Structure used to pack non-pointer types in a call
  *
@@ -81,6 +140,7 @@ enum {
     TFM_CRYPTO_MAC_SIGN_FINISH_SID,
     TFM_CRYPTO_MAC_VERIFY_FINISH_SID,
     TFM_CRYPTO_MAC_ABORT_SID,
+    TFM_CRYPTO_MAC_CLONE_SID,
     TFM_CRYPTO_CIPHER_ENCRYPT_SID,
     TFM_CRYPTO_CIPHER_DECRYPT_SID,
     TFM_CRYPTO_CIPHER_ENCRYPT_SETUP_SID,
@@ -102,8 +162,11 @@ enum {
     TFM_CRYPTO_AEAD_FINISH_SID,
     TFM_CRYPTO_AEAD_VERIFY_SID,
     TFM_CRYPTO_AEAD_ABORT_SID,
+    TFM_CRYPTO_AEAD_ENCRYPT_BATCH_SID,
+    TFM_CRYPTO_AEAD_DECRYPT_BATCH_SID,
     TFM_CRYPTO_SIGN_HASH_SID,
     TFM_CRYPTO_VERIFY_HASH_SID,
+    TFM_CRYPTO_VERIFY_HASH_BATCH_SID,
     TFM_CRYPTO_ASYMMETRIC_ENCRYPT_SID,
     TFM_CRYPTO_ASYMMETRIC_DECRYPT_SID,
     TFM_CRYPTO_KEY_DERIVATION_SETUP_SID,
@@ -120,15 +183,84 @@ enum {
     TFM_CRYPTO_GENERATE_KEY_SID,
     TFM_CRYPTO_SET_KEY_DOMAIN_PARAMETERS_SID,
     TFM_CRYPTO_GET_KEY_DOMAIN_PARAMETERS_SID,
+    TFM_CRYPTO_GET_ENGINE_MEM_STATS_SID,
     TFM_CRYPTO_SID_MAX,
 };
 
+/**
+ * \brief Number of size classes of the pool allocator which serves the
+ *        dynamic allocations of Mbed Crypto
+ */
+#define TFM_CRYPTO_ENGINE_MEM_CLASS_NUM (9u)
+
+/**
+ * \brief Statistics of the memory used by Mbed Crypto for its dynamic
+ *        allocations, as returned by the service
+ *
+ * Only the fields up to \ref peak_in_use are filled when the default Mbed
+ * Crypto buffer allocator is used, provided it is built with
+ * MBEDTLS_MEMORY_DEBUG. The other ones are specific to the pool allocator.
+ */
+struct tfm_crypto_engine_mem_stats {
+    uint32_t buf_size;          /*!< Bytes of the buffer available to the
+                                 *   allocations of Mbed Crypto
+                                 */
+    uint32_t in_use;            /*!< Bytes currently allocated */
+    uint32_t peak_in_use;       /*!< Highest number of bytes allocated at the
+                                 *   same time
+                                 */
+    uint32_t largest_free;      /*!< Size of the largest free block, i.e. of
+                                 *   the largest allocation which can succeed.
+                                 *   The further below buf_size - in_use, the
+                                 *   more fragmented the buffer.
+                                 */
+    uint32_t alloc_count;       /*!< Number of successful allocations */
+    uint32_t failed_count;      /*!< Number of allocations which failed */
+    uint32_t class_alloc_count[TFM_CRYPTO_ENGINE_MEM_CLASS_NUM];
+                                /*!< Number of allocations served by each size
+                                 *   class, from the smallest one
+                                 */
+    uint32_t sfn_alloc_count[TFM_CRYPTO_SID_MAX];
+                                /*!< Number of allocations made while serving
+                                 *   each function of the service, indexed by
+                                 *   SID
+                                 */
+    uint32_t other_alloc_count; /*!< Number of allocations made outside of the
+                                 *   requests dispatched by the service, e.g.
+                                 *   during its initialisation
+                                 */
+};
+
+/**
+ * \brief Maximum number of buffers filled by a single random generation
+ *        request to the service, one for each output vector left next to the
+ *        input vector of the request
+ *
+ */
+#define TFM_CRYPTO_RANDOM_BATCH_MAX_OUTPUTS (PSA_MAX_IOVEC - 1)
+
 /**
  * \brief Define an invalid value for an SID
  *
  */
 #define TFM_CRYPTO_SID_INVALID (~0x0u)
 
+/**
+ * \brief Tells whether a function of the service runs a public key operation,
+ *        which can take much longer than any other request. In IPC mode, these
+ *        functions are requested through the TFM_CRYPTO_ASYM RoT Service, so
+ *        that the service can serve the short requests ahead of them.
+ *
+ */
+#define TFM_CRYPTO_IS_ASYM_SID(sfn_id)                           \
+    (((sfn_id) == TFM_CRYPTO_SIGN_HASH_SID) ||                   \
+     ((sfn_id) == TFM_CRYPTO_VERIFY_HASH_SID) ||                 \
+     ((sfn_id) == TFM_CRYPTO_ASYMMETRIC_ENCRYPT_SID) ||          \
+     ((sfn_id) == TFM_CRYPTO_ASYMMETRIC_DECRYPT_SID) ||          \
+     ((sfn_id) == TFM_CRYPTO_KEY_DERIVATION_KEY_AGREEMENT_SID) || \
+     ((sfn_id) == TFM_CRYPTO_RAW_KEY_AGREEMENT_SID) ||           \
+     ((sfn_id) == TFM_CRYPTO_GENERATE_KEY_SID))
+
 /**
  * \brief This value is used to mark an handle as invalid.
  *
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __TFM_FWU_API_H__
+#define __TFM_FWU_API_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "psa/client.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief TFM secure partition firmware update API version
+ */
+#define TFM_FWU_API_VERSION_MAJOR (0)
+#define TFM_FWU_API_VERSION_MINOR (1)
+
+/* Images which can be updated, in the order of the images of MCUBoot */
+#define TFM_FWU_IMAGE_ID_S      (0U) /* Secure image, or the combined image */
+#define TFM_FWU_IMAGE_ID_NS     (1U) /* Non-secure image                    */
+
+/*!
+ * \enum tfm_fwu_state_t
+ *
+ * \brief State of the update of an image
+ *
+ */
+enum tfm_fwu_state_t {
+    TFM_FWU_STATE_IDLE = 0,     /*!< No update in progress */
+    TFM_FWU_STATE_WRITING,      /*!< The image is being written */
+    TFM_FWU_STATE_VERIFIED,     /*!< The image is written and its hash is
+                                 *   verified
+                                 */
+    TFM_FWU_STATE_INSTALLED,    /*!< The image is installed at the next boot */
+    TFM_FWU_STATE_FAILED,       /*!< The image is not valid, the update must
+                                 *   be started again or aborted
+                                 */
+};
+
+/*!
+ * \struct tfm_fwu_info_t
+ *
+ * \brief Progress of the update of an image
+ *
+ */
+struct tfm_fwu_info_t {
+    uint32_t state;         /*!< \ref tfm_fwu_state_t */
+    uint32_t written;       /*!< Number of bytes of the image written */
+    uint32_t image_size;    /*!< Size of the image, header and TLVs included,
+                             *   0 until the header and the TLV info are
+                             *   written
+                             */
+};
+
+/**
+ * \brief Writes the next block of a signed image to the secondary slot.
+ *
+ * \details The image is written in order: a block at offset 0 starts a new
+ *          update, erasing the previous one, and the next blocks follow it
+ *          without gaps. The service hashes the blocks as they are
+ *          written and verifies the hash of the image once its last TLV is
+ *          written. Only one image is updated at a time.
+ *
+ * \param[in] image_id    \ref TFM_FWU_IMAGE_ID_S or \ref TFM_FWU_IMAGE_ID_NS
+ * \param[in] offset      Offset of the block in the image, the number of
+ *                        bytes already written
+ * \param[in] block       Block of the image
+ * \param[in] block_size  Size of the block
+ *
+ * \return PSA_SUCCESS if the block is written. PSA_ERROR_INVALID_SIGNATURE if
+ *         it is the last block and the hash of the image does not match its
+ *         SHA256 TLV. PSA_ERROR_INVALID_ARGUMENT if the offset is not the next
+ *         one or the image is malformed, PSA_ERROR_NOT_SUPPORTED if it is
+ *         encrypted, PSA_ERROR_INSUFFICIENT_STORAGE if it does not fit the
+ *         slot. PSA_ERROR_BAD_STATE if another client is updating an image.
+ */
+psa_status_t tfm_fwu_write(uint32_t image_id, size_t offset,
+                           const void *block, size_t block_size);
+
+/**
+ * \brief Marks a verified image for installation at the next boot.
+ *
+ * \param[in] image_id    \ref TFM_FWU_IMAGE_ID_S or \ref TFM_FWU_IMAGE_ID_NS
+ * \param[in] permanent   With the SWAP upgrade strategies, true to keep the
+ *                        image, false to revert to the previous image at the
+ *                        boot after next unless the new image is confirmed
+ *
+ * \return PSA_SUCCESS if the image is marked. PSA_ERROR_BAD_STATE if the
+ *         image is not verified.
+ */
+psa_status_t tfm_fwu_install(uint32_t image_id, bool permanent);
+
+/**
+ * \brief Aborts the update of an image, written or installed. The image in
+ *        the secondary slot is not installed at the next boot.
+ *
+ * \param[in] image_id    \ref TFM_FWU_IMAGE_ID_S or \ref TFM_FWU_IMAGE_ID_NS
+ *
+ * \return PSA_SUCCESS if the update is aborted, or there was none.
+ */
+psa_status_t tfm_fwu_abort(uint32_t image_id);
+
+/**
+ * \brief Reads the progress of the update of an image.
+ *
+ * \param[in]  image_id   \ref TFM_FWU_IMAGE_ID_S or \ref TFM_FWU_IMAGE_ID_NS
+ * \param[out] info       Progress of the update
+ *
+ * \return PSA_SUCCESS if the progress is read.
+ */
+psa_status_t tfm_fwu_query(uint32_t image_id, struct tfm_fwu_info_t *info);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TFM_FWU_API_H__ */
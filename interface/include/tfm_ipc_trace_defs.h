@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __TFM_IPC_TRACE_DEFS_H__
+#define __TFM_IPC_TRACE_DEFS_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Number of entries in the trace ring buffer, must be a power of two */
+#ifndef TFM_IPC_TRACE_ENTRIES
+#define TFM_IPC_TRACE_ENTRIES           64
+#endif
+
+/* Points of the IPC path which are traced */
+enum tfm_ipc_trace_event_t {
+    TFM_IPC_TRACE_SVC_ENTER = 1,    /* SVC handler entry, arg: SVC number  */
+    TFM_IPC_TRACE_SEND_EVENT,       /* Message queued, arg: service SID    */
+    TFM_IPC_TRACE_SWITCH_IN,        /* Thread switched in, arg: partition  */
+    TFM_IPC_TRACE_PSA_GET,          /* Message retrieved, arg: msg type    */
+    TFM_IPC_TRACE_PSA_REPLY,        /* Message replied, arg: status        */
+    TFM_IPC_TRACE_SVC_EXIT,         /* SVC handler exit, arg: SVC number   */
+    TFM_IPC_TRACE_IRQ_SIGNAL,       /* IRQ signal asserted, arg: signal    */
+    TFM_IPC_TRACE_IRQ_EOI,          /* IRQ signal cleared, arg: signal     */
+};
+
+/* A trace record */
+struct tfm_ipc_trace_entry_t {
+    uint32_t cycles;                /* DWT cycle counter at the event      */
+    uint32_t event;                 /* \ref tfm_ipc_trace_event_t          */
+    uint32_t arg;                   /* Event specific argument             */
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TFM_IPC_TRACE_DEFS_H__ */
@@ -63,6 +63,18 @@ extern "C" {
 #define MAILBOX_PSA_CONNECT                 (0x3)
 #define MAILBOX_PSA_CALL                    (0x4)
 #define MAILBOX_PSA_CLOSE                   (0x5)
+#ifdef TFM_MAILBOX_SG
+#define MAILBOX_PSA_CALL_SG                 (0x6)
+#endif
+#ifdef TFM_MAILBOX_NS_WINDOWS
+/* Shared memory window requests, not PSA client calls */
+#define MAILBOX_NS_WINDOW_REGISTER          (0x7)
+#define MAILBOX_NS_WINDOW_UNREGISTER        (0x8)
+
+/* Access granted to the client vectors within a shared memory window */
+#define MAILBOX_NS_WINDOW_RO                (0x1)
+#define MAILBOX_NS_WINDOW_RW                (0x2)
+#endif
 
 /* Return code of mailbox APIs */
 #define MAILBOX_SUCCESS                     (0)
@@ -74,6 +86,43 @@ extern "C" {
 #define MAILBOX_CALLBACK_REG_ERROR          (INT32_MIN + 6)
 #define MAILBOX_INIT_ERROR                  (INT32_MIN + 7)
 
+#ifdef TFM_MAILBOX_SG
+/*
+ * The maximum number of input segments, and of output segments, in the
+ * scatter-gather descriptor table of a PSA client call. The platform can set
+ * MAILBOX_SG_MAX_SEGS in device_cfg.h.
+ */
+#ifndef MAILBOX_SG_MAX_SEGS
+#define MAILBOX_SG_MAX_SEGS                 (8)
+#endif
+
+#if (MAILBOX_SG_MAX_SEGS < 1)
+#error "Error: Invalid MAILBOX_SG_MAX_SEGS. The value should be at least 1"
+#endif
+
+/*
+ * Scatter-gather descriptor table of a PSA client call. Each client vector is
+ * made of the next nr_segs segments, input vectors first in in_segs and output
+ * vectors first in out_segs. SPE copies the table once into secure memory.
+ */
+struct mailbox_sg_table_t {
+    size_t          in_len;                        /* Number of input
+                                                    * vectors
+                                                    */
+    size_t          out_len;                       /* Number of output
+                                                    * vectors
+                                                    */
+    size_t          in_nr_segs[PSA_MAX_IOVEC];     /* Segments of each input
+                                                    * vector
+                                                    */
+    size_t          out_nr_segs[PSA_MAX_IOVEC];    /* Segments of each
+                                                    * output vector
+                                                    */
+    psa_invec       in_segs[MAILBOX_SG_MAX_SEGS];
+    psa_outvec      out_segs[MAILBOX_SG_MAX_SEGS];
+};
+#endif
+
 /*
  * This structure holds the parameters used in a PSA client call.
  */
@@ -100,6 +149,27 @@ struct psa_client_params_t {
         struct {
             psa_handle_t    handle;
         } psa_close_params;
+
+#ifdef TFM_MAILBOX_SG
+        struct {
+            psa_handle_t    handle;
+            int32_t         type;
+            const struct mailbox_sg_table_t *sg_table;
+            size_t          *out_written;
+        } psa_call_sg_params;
+#endif
+
+#ifdef TFM_MAILBOX_NS_WINDOWS
+        struct {
+            const void      *base;
+            size_t          len;
+            uint32_t        access;
+        } ns_window_register_params;
+
+        struct {
+            int32_t         window_id;
+        } ns_window_unregister_params;
+#endif
     };
 };
 
@@ -123,18 +193,84 @@ typedef int32_t    mailbox_msg_handle_t;
 
 #define MAILBOX_MSG_NULL_HANDLE          ((mailbox_msg_handle_t)0)
 
+#ifdef TFM_MAILBOX_INLINE_REPLY
+/*
+ * A PSA call with at most MAILBOX_REPLY_INLINE_VECS output vectors, which
+ * fit MAILBOX_REPLY_INLINE_SIZE bytes once each is rounded up to 4 bytes,
+ * gets its output data in the reply slot. NSPE mailbox copies it to the
+ * caller buffers. The defaults make the reply 64 bytes long.
+ * They can be set by the platform in device_cfg.h, the same on both cores.
+ */
+#ifndef MAILBOX_REPLY_INLINE_VECS
+#define MAILBOX_REPLY_INLINE_VECS           (2)
+#endif
+#ifndef MAILBOX_REPLY_INLINE_SIZE
+#define MAILBOX_REPLY_INLINE_SIZE           (40)
+#endif
+#if (MAILBOX_REPLY_INLINE_SIZE % 4)
+#error "MAILBOX_REPLY_INLINE_SIZE must be a multiple of 4"
+#endif
+#endif
+
 /*
  * Mailbox reply structure in non-secure memory
  * to hold the PSA client call return result from SPE
  */
 struct mailbox_reply_t {
     int32_t return_val;
+#ifdef TFM_MAILBOX_STATS
+    uint32_t dispatch_time;     /* Timer ticks spent by SPE on the request */
+#endif
+#ifdef TFM_MAILBOX_INLINE_REPLY
+    psa_outvec inline_vec[MAILBOX_REPLY_INLINE_VECS];
+                                /* Output vectors of an inline PSA call, set
+                                 * by NSPE into payload. SPM writes back the
+                                 * number of bytes written to each.
+                                 */
+    uint8_t payload[MAILBOX_REPLY_INLINE_SIZE];
+                                /* Output data of an inline PSA call */
+#endif
 };
 
+#if defined(TFM_MAILBOX_RING) || defined(TFM_MAILBOX_CACHE_MAINT)
+#ifndef MAILBOX_CACHE_LINE_SIZE
+#define MAILBOX_CACHE_LINE_SIZE             (32)
+#endif
+#endif
+
+#ifdef TFM_MAILBOX_CACHE_MAINT
+/*
+ * Start a member of the shared mailbox queue on a cache line of its own. Each
+ * line of the queue is then written by one core only, or only within the
+ * mailbox critical section, and the other core reads it after invalidating
+ * its copy.
+ */
+#define MAILBOX_CACHE_ALIGNED \
+                        __attribute__((aligned(MAILBOX_CACHE_LINE_SIZE)))
+
+/* The cache lines holding [addr, addr + size) */
+#define MAILBOX_CACHE_LINE_DOWN(addr)                                    \
+        ((uintptr_t)(addr) & ~((uintptr_t)MAILBOX_CACHE_LINE_SIZE - 1))
+#define MAILBOX_CACHE_LINE_UP(addr)                                      \
+        MAILBOX_CACHE_LINE_DOWN((uintptr_t)(addr) + MAILBOX_CACHE_LINE_SIZE - 1)
+
+/*
+ * Clean, or invalidate, the data cache lines holding size bytes at addr of
+ * the memory shared by NSPE and SPE. NSPE and SPE mailbox each implement them
+ * with the cache hooks of their platform HAL.
+ */
+void mailbox_cache_clean(const volatile void *addr, size_t size);
+void mailbox_cache_invalidate(const volatile void *addr, size_t size);
+#else
+#define MAILBOX_CACHE_ALIGNED
+#define mailbox_cache_clean(addr, size)         do {} while (0)
+#define mailbox_cache_invalidate(addr, size)    do {} while (0)
+#endif
+
 /* A single slot structure in NSPE mailbox queue */
 struct ns_mailbox_slot_t {
-    struct mailbox_msg_t   msg;
-    struct mailbox_reply_t reply;
+    struct mailbox_msg_t   msg                  /* Written by NSPE only */
+                                MAILBOX_CACHE_ALIGNED;
     const void             *owner;          /* Handle of the owner task of this
                                              * slot
                                              */
@@ -142,23 +278,75 @@ struct ns_mailbox_slot_t {
                                              * or should be woken up, after the
                                              * replied is received.
                                              */
+#ifdef TFM_MAILBOX_STATS
+    uint32_t               tx_time;         /* Timer value when the request
+                                             * is submitted
+                                             */
+#endif
+#ifdef TFM_MAILBOX_INLINE_REPLY
+    psa_outvec             *caller_out_vec; /* Output vectors the inline
+                                             * payload is copied to, NULL if
+                                             * the call is not inline
+                                             */
+#endif
+    struct mailbox_reply_t reply                /* Written by SPE only */
+                                MAILBOX_CACHE_ALIGNED;
 };
 
 typedef uint32_t   mailbox_queue_status_t;
 
+#ifdef TFM_MAILBOX_RING
+/* A ring holds each slot index once, plus an entry to tell full from empty */
+#define MAILBOX_RING_SIZE                   (NUM_MAILBOX_QUEUE_SLOT + 1)
+
+/*
+ * Single-producer/single-consumer ring of NSPE mailbox queue slot indices.
+ * The head is only written by the producer and the tail only by the consumer,
+ * so the ring is shared between the cores with memory barriers and no lock.
+ * The indices sit in separate cache lines to avoid false sharing.
+ */
+struct mailbox_ring_t {
+    volatile uint32_t head
+                        __attribute__((aligned(MAILBOX_CACHE_LINE_SIZE)));
+    volatile uint32_t tail
+                        __attribute__((aligned(MAILBOX_CACHE_LINE_SIZE)));
+    volatile uint8_t  entries[MAILBOX_RING_SIZE]
+                        __attribute__((aligned(MAILBOX_CACHE_LINE_SIZE)));
+};
+#endif
+
 /* NSPE mailbox queue */
 struct ns_mailbox_queue_t {
-    mailbox_queue_status_t   empty_slots;       /* Bitmask of empty slots */
-    mailbox_queue_status_t   pend_slots;        /* Bitmask of slots pending
+    mailbox_queue_status_t   empty_slots        /* Bitmask of empty slots */
+                                MAILBOX_CACHE_ALIGNED;
+    mailbox_queue_status_t   pend_slots         /* Bitmask of slots pending
                                                  * for SPE handling
                                                  */
-    mailbox_queue_status_t   replied_slots;     /* Bitmask of active slots
+                                MAILBOX_CACHE_ALIGNED;
+    mailbox_queue_status_t   replied_slots      /* Bitmask of active slots
                                                  * containing PSA client call
                                                  * return result
                                                  */
+                                MAILBOX_CACHE_ALIGNED;
+#ifdef TFM_MAILBOX_POLL
+    volatile uint32_t        spe_polling        /* Set by SPE while it polls
+                                                 * the queue. NSPE skips the
+                                                 * doorbell meanwhile.
+                                                 */
+                                MAILBOX_CACHE_ALIGNED;
+#endif
 
     struct ns_mailbox_slot_t queue[NUM_MAILBOX_QUEUE_SLOT];
 
+#ifdef TFM_MAILBOX_RING
+    /*
+     * The rings replace pend_slots and replied_slots between the cores.
+     * The status bitmasks are then only used by NSPE.
+     */
+    struct mailbox_ring_t    req_ring;          /* Requests, NSPE to SPE */
+    struct mailbox_ring_t    reply_ring;        /* Replies, SPE to NSPE */
+#endif
+
 #ifdef TFM_MULTI_CORE_TEST
     uint32_t                 nr_tx;             /* The total number of
                                                  * submission of NS PSA Client
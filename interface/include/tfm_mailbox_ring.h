@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/* Single-producer/single-consumer ring shared by NSPE and SPE mailbox */
+
+#ifndef __TFM_MAILBOX_RING_H__
+#define __TFM_MAILBOX_RING_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "cmsis_compiler.h"
+#include "tfm_mailbox.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef TFM_MAILBOX_RING
+/*
+ * The ring lives in non-secure memory, so the indices are always reduced
+ * modulo the ring size before they are used.
+ */
+
+/**
+ * \brief Add an entry to a ring. Only called by the producer of the ring.
+ *
+ * \param[in] ring              The ring.
+ * \param[in] entry             The NSPE mailbox queue slot index to add.
+ *
+ * \retval true                 The entry has been added.
+ * \retval false                The ring is full.
+ */
+static inline bool mailbox_ring_push(struct mailbox_ring_t *ring,
+                                     uint8_t entry)
+{
+    uint32_t head = ring->head % MAILBOX_RING_SIZE;
+    uint32_t next = (head + 1) % MAILBOX_RING_SIZE;
+
+    mailbox_cache_invalidate(&ring->tail, sizeof(ring->tail));
+    if (next == (ring->tail % MAILBOX_RING_SIZE)) {
+        return false;
+    }
+
+    ring->entries[head] = entry;
+    mailbox_cache_clean(&ring->entries[head], sizeof(ring->entries[head]));
+
+    /* The entry must be visible to the consumer before the new head */
+    __DMB();
+
+    ring->head = next;
+    mailbox_cache_clean(&ring->head, sizeof(ring->head));
+
+    return true;
+}
+
+/**
+ * \brief Read the oldest entry of a ring without removing it. Only called by
+ *        the consumer of the ring.
+ *
+ * \param[in] ring              The ring.
+ * \param[out] entry            The oldest entry.
+ *
+ * \retval true                 An entry has been read.
+ * \retval false                The ring is empty.
+ */
+static inline bool mailbox_ring_peek(const struct mailbox_ring_t *ring,
+                                     uint8_t *entry)
+{
+    uint32_t tail = ring->tail % MAILBOX_RING_SIZE;
+
+    mailbox_cache_invalidate(&ring->head, sizeof(ring->head));
+    if (tail == (ring->head % MAILBOX_RING_SIZE)) {
+        return false;
+    }
+
+    /* Do not read the entry before the head which published it */
+    __DMB();
+
+    mailbox_cache_invalidate(&ring->entries[tail], sizeof(ring->entries[tail]));
+    *entry = ring->entries[tail];
+
+    return true;
+}
+
+/**
+ * \brief Remove the oldest entry of a ring, after \ref mailbox_ring_peek
+ *        returned it. Only called by the consumer of the ring.
+ *
+ * \param[in] ring              The ring.
+ */
+static inline void mailbox_ring_pop(struct mailbox_ring_t *ring)
+{
+    /* The entry must be read before the producer can overwrite it */
+    __DMB();
+
+    ring->tail = ((ring->tail % MAILBOX_RING_SIZE) + 1) % MAILBOX_RING_SIZE;
+    mailbox_cache_clean(&ring->tail, sizeof(ring->tail));
+}
+#endif /* TFM_MAILBOX_RING */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TFM_MAILBOX_RING_H__ */
@@ -12,6 +12,7 @@
 extern "C" {
 #endif
 
+#include <stddef.h>
 #include <stdint.h>
 
 /**
@@ -54,6 +55,40 @@ uint32_t tfm_ns_multi_core_lock_acquire(void);
  */
 uint32_t tfm_ns_multi_core_lock_release(void);
 
+#ifdef TFM_MAILBOX_NS_WINDOWS
+/**
+ * \brief Called on the non-secure CPU.
+ *        Registers a window of non-secure memory shared with the secure CPU.
+ *        SPE checks the window once. The client vectors of the later PSA
+ *        client calls which lie within the window only need a bounds check.
+ *
+ * \param[in] base          Base address of the window
+ * \param[in] len           Length of the window in bytes
+ * \param[in] access        \ref MAILBOX_NS_WINDOW_RO if the secure services
+ *                          only read the buffers within the window,
+ *                          \ref MAILBOX_NS_WINDOW_RW if they also write them
+ *
+ * \return Return the window ID, greater than 0, if succeeds.
+ * \return Otherwise, return a negative PSA error code.
+ *
+ * \note The window must stay allocated to the shared buffers until it is
+ *       unregistered.
+ */
+int32_t tfm_ns_mailbox_window_register(const void *base, size_t len,
+                                       uint32_t access);
+
+/**
+ * \brief Called on the non-secure CPU.
+ *        Unregisters a window of non-secure memory.
+ *
+ * \param[in] window_id     ID returned by \ref tfm_ns_mailbox_window_register
+ *
+ * \return Return PSA_SUCCESS if succeeds.
+ * \return Otherwise, return a negative PSA error code.
+ */
+int32_t tfm_ns_mailbox_window_unregister(int32_t window_id);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -47,6 +47,66 @@ int32_t tfm_ns_interface_dispatch(veneer_fn fn,
  * \return  A value according to \ref enum tfm_status_e
  */
 enum tfm_status_e tfm_ns_interface_init(void);
+
+#ifdef TFM_NS_CONCURRENT_CALLS
+#ifndef TFM_NS_CONCURRENT_CALLS_MAX
+/**
+ * \brief Number of NS threads that can wait for a reply at the same time
+ */
+#define TFM_NS_CONCURRENT_CALLS_MAX     4
+#endif
+
+/**
+ * \brief Thread flag used to wake up a thread waiting for a reply
+ */
+#define TFM_NS_CALL_DONE_FLAG           0x40000000U
+
+/**
+ * \brief NS interface, let NS threads wait for replies outside of TF-M
+ *
+ * \details psa_call() is then submitted as an asynchronous call and the
+ *          calling thread waits in the NS OS. The NS interface is only held
+ *          while the request goes through the SVC entry path, so other NS
+ *          threads can call other RoT Services in the meantime. Before this
+ *          function is called, and when all the waiters are in use, psa_call()
+ *          waits for the reply inside TF-M.
+ *
+ * \param[in] irq_line  Non-secure interrupt TF-M pends on completion of a
+ *                      call. Its handler must call
+ *                      \ref tfm_ns_interface_async_call_irq_handler.
+ *
+ * \return  A value according to \ref enum tfm_status_e
+ */
+enum tfm_status_e tfm_ns_interface_enable_concurrent_calls(int32_t irq_line);
+
+/**
+ * \brief NS interface, reserve a waiter for the current thread
+ *
+ * \return  Index of the waiter, or -1 if none is available
+ */
+int32_t tfm_ns_interface_waiter_get(void);
+
+/**
+ * \brief NS interface, wait until an asynchronous call may have completed
+ */
+void tfm_ns_interface_waiter_wait(void);
+
+/**
+ * \brief NS interface, release a waiter
+ *
+ * \param[in] idx  Index returned by \ref tfm_ns_interface_waiter_get
+ */
+void tfm_ns_interface_waiter_put(int32_t idx);
+
+/**
+ * \brief NS interface, wake up the waiting threads on completion of an
+ *        asynchronous call
+ *
+ * \note To be called from the handler of the interrupt passed to
+ *       \ref tfm_ns_interface_enable_concurrent_calls.
+ */
+void tfm_ns_interface_async_call_irq_handler(void);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -34,6 +34,88 @@ struct ns_mailbox_stats_res_t {
 };
 #endif
 
+#ifdef TFM_MAILBOX_STATS
+/* The call types are numbered from MAILBOX_PSA_FRAMEWORK_VERSION */
+#ifdef TFM_MAILBOX_SG
+#define MAILBOX_STATS_NR_CALL_TYPES         (MAILBOX_PSA_CALL_SG)
+#else
+#define MAILBOX_STATS_NR_CALL_TYPES         (MAILBOX_PSA_CLOSE)
+#endif
+
+/*
+ * Bin i of a latency histogram counts the latencies from 2^i to 2^(i+1) - 1
+ * timer ticks. Bin 0 also counts the latencies of 0 tick.
+ */
+#define MAILBOX_STATS_NR_HIST_BINS          (32)
+
+/**
+ * \brief The latency statistics of a kind of mailbox operation
+ */
+struct ns_mailbox_lat_stats_t {
+    uint32_t nr;                        /* Number of samples */
+    uint32_t min;                       /* Minimum latency in timer ticks */
+    uint32_t max;                       /* Maximum latency in timer ticks */
+    uint64_t total;                     /* Sum of the latencies, for the
+                                         * average
+                                         */
+};
+
+/**
+ * \brief The statistics of a PSA client call type
+ */
+struct ns_mailbox_call_stats_t {
+    struct ns_mailbox_lat_stats_t round_trip;   /* From submission to reply
+                                                 * collection in NSPE
+                                                 */
+    struct ns_mailbox_lat_stats_t dispatch;     /* Spent by SPE */
+    uint32_t round_trip_hist[MAILBOX_STATS_NR_HIST_BINS];
+};
+
+/**
+ * \brief The statistics of NSPE mailbox
+ */
+struct ns_mailbox_stats_t {
+    struct ns_mailbox_call_stats_t call[MAILBOX_STATS_NR_CALL_TYPES];
+                                        /* Indexed by call type - 1 */
+    uint32_t nr_queue_full;             /* Requests rejected with
+                                         * MAILBOX_QUEUE_FULL
+                                         */
+    uint32_t nr_queue_waits;            /* Requests which waited in NS OS
+                                         * for a free queue slot
+                                         */
+};
+#endif
+
+#ifdef TFM_MAILBOX_COALESCE
+/*
+ * The number of requests NSPE mailbox submits before notifying SPE. A thread
+ * waiting for the reply of a request held back notifies SPE anyway after
+ * MAILBOX_DOORBELL_TIMEOUT NS OS ticks.
+ */
+#ifndef MAILBOX_DOORBELL_BATCH
+#define MAILBOX_DOORBELL_BATCH              (2)
+#endif
+
+#ifndef MAILBOX_DOORBELL_TIMEOUT
+#define MAILBOX_DOORBELL_TIMEOUT            (1)
+#endif
+
+#if (MAILBOX_DOORBELL_BATCH < 1)
+#error "Error: Invalid MAILBOX_DOORBELL_BATCH. The value should be at least 1"
+#endif
+
+/**
+ * \brief The counters to tune the coalescing of NSPE mailbox notifications
+ */
+struct ns_mailbox_doorbell_stats_t {
+    uint32_t nr_reqs;                   /* Requests submitted to SPE */
+    uint32_t nr_doorbells;              /* Notifications sent to SPE */
+    uint32_t nr_timeout_doorbells;      /* Notifications sent after a
+                                         * waiting thread timed out
+                                         */
+};
+#endif
+
 /**
  * \brief Prepare and send PSA client request to SPE via mailbox.
  *
@@ -120,6 +202,31 @@ static inline const void *tfm_ns_mailbox_get_task_handle(void)
  */
 mailbox_msg_handle_t tfm_ns_mailbox_fetch_reply_msg_isr(void);
 
+/* A replied mailbox message and the task waiting for it */
+struct ns_mailbox_replied_msg_t {
+    mailbox_msg_handle_t handle;
+    const void           *owner;
+};
+
+/**
+ * \brief Fetch all the replied mailbox messages in the NSPE mailbox queue at
+ *        once.
+ *        This function is intended to be called inside platform specific
+ *        notification IRQ handler, instead of calling
+ *        \ref tfm_ns_mailbox_fetch_reply_msg_isr in a loop.
+ *
+ * \note The replied status of all the fetched messages is cleared in a single
+ *       critical section. Their owner tasks can check the result without
+ *       entering the critical section again.
+ *
+ * \param[out] msgs             The array to fill with the fetched messages.
+ *                              It must hold \ref NUM_MAILBOX_QUEUE_SLOT
+ *                              entries.
+ *
+ * \return Return the number of fetched messages.
+ */
+uint8_t tfm_ns_mailbox_fetch_replies_isr(struct ns_mailbox_replied_msg_t *msgs);
+
 /**
  * \brief Return the handle of owner task of a mailbox message according to the
  *        \ref mailbox_msg_handle_t
@@ -193,6 +300,25 @@ void tfm_ns_mailbox_hal_enter_critical_isr(void);
  */
 void tfm_ns_mailbox_hal_exit_critical_isr(void);
 
+#ifdef TFM_MAILBOX_RING
+/**
+ * \brief Enter critical section of NSPE mailbox on the local core only.
+ *
+ * \note This function is implemented by platform-specific NSPE mailbox HAL.
+ *       With the ring transport, the rings are the only state shared with
+ *       SPE. The section only protects the NSPE status from the other NS
+ *       threads and from the mailbox interrupt, e.g. by masking interrupts.
+ */
+void tfm_ns_mailbox_hal_enter_local_critical(void);
+
+/**
+ * \brief Exit critical section of NSPE mailbox on the local core only.
+ *
+ * \note This function is implemented by platform-specific NSPE mailbox HAL.
+ */
+void tfm_ns_mailbox_hal_exit_local_critical(void);
+#endif
+
 #ifdef TFM_MULTI_CORE_MULTI_CLIENT_CALL
 /**
  * \brief Performs platform and NS OS specific waiting mechanism to wait for
@@ -204,6 +330,112 @@ void tfm_ns_mailbox_hal_exit_critical_isr(void);
  * \param[in] handle            The handle of mailbox message.
  */
 void tfm_ns_mailbox_hal_wait_reply(mailbox_msg_handle_t handle);
+
+#ifdef TFM_MAILBOX_COALESCE
+/**
+ * \brief Performs platform and NS OS specific waiting mechanism to wait for
+ *        the reply of the specified mailbox message to be returned from SPE,
+ *        for at most the specified time.
+ *
+ * \note This function is implemented by platform and NS OS specific waiting
+ *       mechanism according to use scenario. It may return before the reply
+ *       is returned.
+ *
+ * \param[in] handle            The handle of the mailbox message.
+ * \param[in] timeout           The time to wait for, in NS OS ticks.
+ */
+void tfm_ns_mailbox_hal_wait_reply_timeout(mailbox_msg_handle_t handle,
+                                           uint32_t timeout);
+#endif
+#endif
+
+#ifdef TFM_MAILBOX_CACHE_MAINT
+/**
+ * \brief Write the data cache lines of a range of NSPE mailbox queue back to
+ *        memory, so that SPE reads what NSPE wrote there.
+ *
+ * \note This function is implemented by platform-specific NSPE mailbox HAL.
+ *       It must not touch any other line than those of the range.
+ *
+ * \param[in] addr              Start of the range, aligned on
+ *                              \ref MAILBOX_CACHE_LINE_SIZE.
+ * \param[in] size              Size of the range, a multiple of
+ *                              \ref MAILBOX_CACHE_LINE_SIZE.
+ */
+void tfm_ns_mailbox_hal_cache_clean(void *addr, size_t size);
+
+/**
+ * \brief Invalidate the data cache lines of a range of NSPE mailbox queue,
+ *        so that NSPE reads what SPE wrote there.
+ *
+ * \note This function is implemented by platform-specific NSPE mailbox HAL.
+ *       It must not touch any other line than those of the range.
+ *
+ * \param[in] addr              Start of the range, aligned on
+ *                              \ref MAILBOX_CACHE_LINE_SIZE.
+ * \param[in] size              Size of the range, a multiple of
+ *                              \ref MAILBOX_CACHE_LINE_SIZE.
+ */
+void tfm_ns_mailbox_hal_cache_invalidate(void *addr, size_t size);
+#endif
+
+#ifdef TFM_MAILBOX_STATS
+/**
+ * \brief Read the current value of the timer shared by NSPE and SPE.
+ *
+ * \note This function is implemented by platform-specific NSPE mailbox HAL.
+ *       It must read the same timer, in the same unit, as
+ *       tfm_mailbox_hal_get_timestamp() in SPE.
+ *
+ * \return The timer value, in timer ticks.
+ */
+uint32_t tfm_ns_mailbox_hal_get_timestamp(void);
+
+/**
+ * \brief Read the statistics of NSPE mailbox.
+ *
+ * \param[out] stats            The buffer to be written with
+ *                              \ref ns_mailbox_stats_t.
+ */
+void tfm_ns_mailbox_get_stats(struct ns_mailbox_stats_t *stats);
+
+/**
+ * \brief Clear the statistics of NSPE mailbox.
+ */
+void tfm_ns_mailbox_reset_stats(void);
+
+/**
+ * \brief Record that a request had to wait for a free NSPE mailbox queue slot
+ *        before it could be submitted.
+ *
+ * \note This function is called by the NS interface which serializes the
+ *       PSA client calls, when the calls in flight hold every slot.
+ */
+void tfm_ns_mailbox_stats_queue_wait(void);
+
+/**
+ * \brief Estimate a percentile of the round-trip latency of a call type.
+ *
+ * \param[in] call              The statistics of the call type.
+ * \param[in] percent           The percentile, from 1 to 100.
+ *
+ * \return The upper bound, in timer ticks, of the histogram bin which holds
+ *         the percentile. 0 if no latency is recorded.
+ */
+uint32_t tfm_ns_mailbox_stats_percentile(
+                                    const struct ns_mailbox_call_stats_t *call,
+                                    uint32_t percent);
+#endif
+
+#ifdef TFM_MAILBOX_COALESCE
+/**
+ * \brief Read the counters of NSPE mailbox notification coalescing.
+ *
+ * \param[out] stats            The buffer to be written with
+ *                              \ref ns_mailbox_doorbell_stats_t.
+ */
+void tfm_ns_mailbox_get_doorbell_stats(
+                                    struct ns_mailbox_doorbell_stats_t *stats);
 #endif
 
 #ifdef TFM_MULTI_CORE_TEST
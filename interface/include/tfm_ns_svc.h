@@ -36,6 +36,7 @@ extern "C" {
  */
 #define LIST_SVC_NSPM \
     X(SVC_TFM_NSPM_REGISTER_CLIENT_ID, tfm_nspm_svc_register_client_id) \
+    X(SVC_TFM_NSPM_REGISTER_CTX_SLOT, tfm_nspm_svc_register_ctx_slot) \
 
 /**
  * \brief Numbers associated to each SVC available
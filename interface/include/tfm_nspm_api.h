@@ -21,6 +21,37 @@ extern "C" {
  */
 uint32_t tfm_nspm_register_client_id(void);
 
+/**
+ * \brief Reports the word in which the NS RTOS publishes the TZ context ID of
+ *        the running thread
+ *
+ * \details The NS RTOS writes the TZ_MemoryId_t of the thread switched in, or
+ *          0, to the slot, instead of calling TZ_LoadContext_S() and
+ *          TZ_StoreContext_S(). The slot must not be writable by unprivileged
+ *          threads.
+ *
+ * \param[in] slot  The context slot, NULL to unregister it
+ *
+ * \return Returns 1 if the slot was successfully reported 0 otherwise
+ */
+uint32_t tfm_nspm_register_ctx_slot(volatile uint32_t *slot);
+
+#ifdef TFM_PSA_ASYNC_CALL
+/**
+ * \brief Registers the interrupt TF-M pends when an asynchronous call
+ *        completes
+ *
+ * \details The handler of the interrupt is the completion callback: it
+ *          collects the status of the outstanding calls with
+ *          psa_call_async_result(). The interrupt must target Non-Secure.
+ *
+ * \param[in] irq_line  Interrupt line, negative to stop the notification
+ *
+ * \return Returns 1 if the interrupt was successfully registered 0 otherwise
+ */
+uint32_t tfm_nspm_register_async_call_irq(int32_t irq_line);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -23,6 +23,15 @@ extern "C" {
  */
 uint32_t tfm_nspm_svc_register_client_id(uint32_t client_id);
 
+/**
+ * \brief Reports the context slot of NS RTOS to TF-M (SVC function)
+ *
+ * \param [in] slot Address of the context slot, 0 to unregister it.
+ *
+ * \return Returns 1 if the slot was successfully reported 0 otherwise
+ */
+uint32_t tfm_nspm_svc_register_ctx_slot(uint32_t slot);
+
 #ifdef __cplusplus
 }
 #endif
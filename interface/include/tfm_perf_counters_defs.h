@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __TFM_PERF_COUNTERS_DEFS_H__
+#define __TFM_PERF_COUNTERS_DEFS_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Platform service requests of the performance counters. They are handled by
+ * the platform service itself, for every target, so they are negative to
+ * stay out of the requests of the targets.
+ */
+#define TFM_PLATFORM_IOCTL_PERF_INFO    (-1)  /* out: tfm_perf_info_t      */
+#define TFM_PLATFORM_IOCTL_PERF_CONFIG  (-2)  /* in:  tfm_perf_config_t    */
+#define TFM_PLATFORM_IOCTL_PERF_START   (-3)  /* Reset and start counting  */
+#define TFM_PLATFORM_IOCTL_PERF_STOP    (-4)  /* Stop counting             */
+#define TFM_PLATFORM_IOCTL_PERF_READ    (-5)  /* out: tfm_perf_values_t    */
+#define TFM_PLATFORM_IOCTL_PERF_RELEASE (-6)  /* Give the counters back    */
+
+/* Maximum number of event counters configured at a time */
+#define TFM_PERF_MAX_COUNTERS           8
+
+/* Capabilities of the counters, in tfm_perf_info_t::flags */
+#define TFM_PERF_HAS_CYCLES             (1U << 0) /* Cycle counter         */
+#define TFM_PERF_HAS_PMU                (1U << 1) /* Armv8.1-M PMU events  */
+
+/*
+ * Events of the Armv8.1-M PMU. Any other event number of the core can be
+ * configured as well, see its Technical Reference Manual.
+ */
+#define TFM_PERF_EVENT_L1I_CACHE_REFILL 0x0001U
+#define TFM_PERF_EVENT_L1D_CACHE_REFILL 0x0003U
+#define TFM_PERF_EVENT_L1D_CACHE        0x0004U
+#define TFM_PERF_EVENT_INST_RETIRED     0x0008U
+#define TFM_PERF_EVENT_BR_MIS_PRED      0x0010U
+#define TFM_PERF_EVENT_CPU_CYCLES       0x0011U
+#define TFM_PERF_EVENT_BR_PRED          0x0012U
+#define TFM_PERF_EVENT_MEM_ACCESS       0x0013U
+#define TFM_PERF_EVENT_L1I_CACHE        0x0014U
+#define TFM_PERF_EVENT_CHAIN            0x001EU
+#define TFM_PERF_EVENT_STALL_FRONTEND   0x0023U
+#define TFM_PERF_EVENT_STALL_BACKEND    0x0024U
+
+/*
+ * Events of the DWT profiling counters of Armv7-M and Armv8-M Mainline. The
+ * DWT counters are 8 bits wide and each of them counts one event only.
+ */
+#define TFM_PERF_EVENT_DWT_CPI          0x10000U /* Multi-cycle instructions */
+#define TFM_PERF_EVENT_DWT_EXC          0x10001U /* Exception overhead       */
+#define TFM_PERF_EVENT_DWT_SLEEP        0x10002U /* Sleep cycles             */
+#define TFM_PERF_EVENT_DWT_LSU          0x10003U /* Load/store extra cycles  */
+#define TFM_PERF_EVENT_DWT_FOLD         0x10004U /* Folded instructions      */
+
+/* Performance counters of the platform */
+struct tfm_perf_info_t {
+    uint32_t num_counters;          /* Number of event counters            */
+    uint32_t flags;                 /* TFM_PERF_HAS_* flags                */
+};
+
+/* Events to count, one per event counter */
+struct tfm_perf_config_t {
+    uint32_t num;                   /* Number of events                    */
+    uint32_t events[TFM_PERF_MAX_COUNTERS];
+};
+
+/* Values of the counters */
+struct tfm_perf_values_t {
+    uint32_t cycles;                /* Cycle counter, 0 if not available   */
+    uint32_t counters[TFM_PERF_MAX_COUNTERS]; /* In configuration order    */
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TFM_PERF_COUNTERS_DEFS_H__ */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -12,6 +12,12 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include "tfm_api.h"
+#include "tfm_ipc_trace_defs.h"
+#include "tfm_boot_time_defs.h"
+#include "tfm_spm_stats_defs.h"
+#include "tfm_spm_profile_defs.h"
+#include "tfm_perf_counters_defs.h"
+#include "tfm_resource_usage_defs.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -21,7 +27,7 @@ extern "C" {
  * \brief TFM secure partition platform API version
  */
 #define TFM_PLATFORM_API_VERSION_MAJOR (0)
-#define TFM_PLATFORM_API_VERSION_MINOR (3)
+#define TFM_PLATFORM_API_VERSION_MINOR (6)
 
 /*!
  * \enum tfm_platform_err_t
@@ -41,6 +47,22 @@ enum tfm_platform_err_t {
 
 typedef int32_t tfm_platform_ioctl_req_t;
 
+/*!
+ * \struct tfm_platform_ioctl_vec_t
+ *
+ * \brief One of the requests of a vectored platform-specific service call
+ *
+ */
+struct tfm_platform_ioctl_vec_t {
+    tfm_platform_ioctl_req_t request; /*!< Request identifier */
+    uint32_t input_len;               /*!< Size of the input of the request,
+                                       *   0 for none
+                                       */
+    uint32_t output_len;              /*!< Size of the output of the request,
+                                       *   0 for none
+                                       */
+};
+
 /*!
  * \brief Resets the system.
  *
@@ -62,6 +84,125 @@ enum tfm_platform_err_t tfm_platform_ioctl(tfm_platform_ioctl_req_t request,
                                            psa_invec *input,
                                            psa_outvec *output);
 
+/*!
+ * \brief Performs a batch of platform-specific services in one call
+ *
+ * The requests are performed in order, as with one \ref tfm_platform_ioctl
+ * call each. The inputs of the requests are packed back to back in the input
+ * buffer, in the order of the requests, and so are their outputs in the output
+ * buffer. Each output takes output_len bytes of the output buffer, even if the
+ * request returns less.
+ *
+ * \param[in]  requests      Array of the requests
+ * \param[in]  num_requests  Number of requests in the array, at least 1
+ * \param[in]  input         Input buffer holding the inputs of the requests
+ *                           (or NULL if none of them has an input)
+ * \param[in,out] output     Output buffer for the outputs of the requests
+ *                           (or NULL if none of them has an output)
+ * \param[out] status        Array of num_requests entries, filled with the
+ *                           status of each request
+ *
+ * \return Returns TFM_PLATFORM_ERR_SUCCESS if the requests were performed,
+ *         whatever their status. If a request does not fit in what is left
+ *         of the input or output buffers, it and the following requests are
+ *         not performed, their status is TFM_PLATFORM_ERR_INVALID_PARAM and so
+ *         is the return value. Other errors are returned as specified by the
+ *         \ref tfm_platform_err_t
+ */
+enum tfm_platform_err_t
+tfm_platform_ioctl_vector(const struct tfm_platform_ioctl_vec_t *requests,
+                          size_t num_requests,
+                          psa_invec *input,
+                          psa_outvec *output,
+                          enum tfm_platform_err_t *status);
+
+/*!
+ * \brief Reads the cycle count trace of the IPC path recorded by SPM
+ *
+ * \param[out]    entries  Buffer to hold the trace entries, oldest first
+ * \param[in,out] num      Number of entries the buffer can hold on input,
+ *                         number of entries read on output
+ *
+ * \return Returns values as specified by the \ref tfm_platform_err_t.
+ *         TFM_PLATFORM_ERR_NOT_SUPPORTED is returned if TF-M is not built
+ *         with TFM_IPC_TRACE.
+ */
+enum tfm_platform_err_t
+tfm_platform_ipc_trace_read(struct tfm_ipc_trace_entry_t *entries,
+                            size_t *num);
+
+/*!
+ * \brief Reads the boot stages recorded by BL2 and by the secure image
+ *
+ * \param[out]    entries  Buffer to hold the boot stages, BL2 stages first
+ * \param[in,out] num      Number of entries the buffer can hold on input,
+ *                         number of entries read on output
+ *
+ * \return Returns values as specified by the \ref tfm_platform_err_t.
+ *         TFM_PLATFORM_ERR_NOT_SUPPORTED is returned if TF-M is not built
+ *         with TFM_BOOT_TIME.
+ */
+enum tfm_platform_err_t
+tfm_platform_boot_time_read(struct tfm_boot_time_entry_t *entries,
+                            size_t *num);
+
+/*!
+ * \brief Reads the load statistics of the partitions and of the RoT Services
+ *
+ * \param[out]    partitions      Buffer to hold the partition statistics,
+ *                                the idle time last
+ * \param[in,out] num_partitions  Number of entries the partition buffer can
+ *                                hold on input, number of entries read on
+ *                                output
+ * \param[out]    services        Buffer to hold the RoT Service statistics
+ * \param[in,out] num_services    Number of entries the service buffer can
+ *                                hold on input, number of entries read on
+ *                                output
+ *
+ * \return Returns values as specified by the \ref tfm_platform_err_t.
+ *         TFM_PLATFORM_ERR_NOT_SUPPORTED is returned if TF-M is not built
+ *         with TFM_SPM_STATS.
+ */
+enum tfm_platform_err_t
+tfm_platform_spm_stats_read(struct tfm_spm_partition_stats_t *partitions,
+                            size_t *num_partitions,
+                            struct tfm_spm_service_stats_t *services,
+                            size_t *num_services);
+
+/*!
+ * \brief Reads the PC samples of the secure image recorded by SPM. The samples
+ *        read are removed, so each call returns the samples taken since the
+ *        previous one.
+ *
+ * \param[out]    samples  Buffer to hold the samples, oldest first
+ * \param[in,out] num      Number of samples the buffer can hold on input,
+ *                         number of samples read on output
+ *
+ * \return Returns values as specified by the \ref tfm_platform_err_t.
+ *         TFM_PLATFORM_ERR_NOT_SUPPORTED is returned if TF-M is not built
+ *         with TFM_SPM_PROFILE.
+ */
+enum tfm_platform_err_t
+tfm_platform_spm_profile_read(struct tfm_spm_profile_sample_t *samples,
+                              size_t *num);
+
+/*!
+ * \brief Reads the usage of the resource pools of the secure image, as their
+ *        current and peak use and their capacity. The pools are those of
+ *        SPM and of the partitions which registered them.
+ *
+ * \param[out]    entries  Buffer to hold the usage of the pools
+ * \param[in,out] num      Number of entries the buffer can hold on input,
+ *                         number of entries read on output
+ *
+ * \return Returns values as specified by the \ref tfm_platform_err_t.
+ *         TFM_PLATFORM_ERR_NOT_SUPPORTED is returned if TF-M is not built
+ *         with TFM_RESOURCE_USAGE.
+ */
+enum tfm_platform_err_t
+tfm_platform_resource_usage_read(struct tfm_resource_usage_t *entries,
+                                 size_t *num);
+
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __TFM_RESOURCE_USAGE_DEFS_H__
+#define __TFM_RESOURCE_USAGE_DEFS_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Resource pools of the secure image, with the unit of their usage */
+#define TFM_RESOURCE_CONN_HANDLES       0x01U /* SPM connections (IPC)     */
+#define TFM_RESOURCE_CRYPTO_OPERATIONS  0x10U /* Crypto operations         */
+#define TFM_RESOURCE_CRYPTO_KEY_HANDLES 0x11U /* Crypto key handles        */
+#define TFM_RESOURCE_CRYPTO_ENGINE_MEM  0x12U /* Mbed Crypto heap, bytes   */
+#define TFM_RESOURCE_CRYPTO_SCRATCH     0x13U /* Crypto scratch, bytes     */
+#define TFM_RESOURCE_SST_OBJECTS        0x20U /* SST object table entries  */
+#define TFM_RESOURCE_ITS_FILES          0x21U /* ITS files                 */
+#define TFM_RESOURCE_AUDIT_LOG          0x30U /* Audit log, bytes          */
+
+/* First ID of the pools of the partitions which are not part of TF-M */
+#define TFM_RESOURCE_USER_BASE          0x1000U
+
+/* Usage of a resource pool */
+struct tfm_resource_usage_t {
+    uint32_t resource_id;           /* TFM_RESOURCE_* ID of the pool       */
+    int32_t partition_id;           /* Partition owning the pool, set by
+                                     * SPM                                 */
+    uint32_t used;                  /* Current use                         */
+    uint32_t peak;                  /* Highest use since boot              */
+    uint32_t capacity;              /* Size of the pool                    */
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TFM_RESOURCE_USAGE_DEFS_H__ */
@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __TFM_SPM_PROFILE_DEFS_H__
+#define __TFM_SPM_PROFILE_DEFS_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Partition ID of the samples taken in a secure exception handler */
+#define TFM_SPM_PROFILE_HANDLER_ID      (-1)
+
+/* PC sample of the secure image */
+struct tfm_spm_profile_sample_t {
+    uint32_t pc;                    /* Interrupted PC, 0 in the NSPE       */
+    int32_t partition_id;           /* Running partition, the non-secure
+                                     * partition in the NSPE, or the
+                                     * handler ID                          */
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TFM_SPM_PROFILE_DEFS_H__ */
@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __TFM_SPM_STATS_DEFS_H__
+#define __TFM_SPM_STATS_DEFS_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Partition ID of the entry which accounts the time the SPM spent idle */
+#define TFM_SPM_STATS_IDLE_ID           (-1)
+
+/* Load statistics of a partition */
+struct tfm_spm_partition_stats_t {
+    int32_t partition_id;           /* Partition ID, or the idle ID        */
+    uint32_t runs;                  /* Number of times it was switched in  */
+    uint64_t cycles;                /* Cycles spent running                */
+};
+
+/* Load statistics of a RoT Service */
+struct tfm_spm_service_stats_t {
+    uint32_t sid;                   /* SID of the RoT Service              */
+    uint32_t requests;              /* Number of messages replied to       */
+    uint64_t cycles;                /* Cycles from psa_get() to psa_reply()
+                                     * of the messages, summed up          */
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TFM_SPM_STATS_DEFS_H__ */
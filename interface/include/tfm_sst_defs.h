@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2017-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -15,6 +15,11 @@ extern "C" {
 /* Invalid UID */
 #define TFM_SST_INVALID_UID 0
 
+/* Operations of the SST transaction request */
+#define TFM_SST_TRANSACTION_BEGIN  1U
+#define TFM_SST_TRANSACTION_COMMIT 2U
+#define TFM_SST_TRANSACTION_ABORT  3U
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __TFM_TLS_RECORD_API_H__
+#define __TFM_TLS_RECORD_API_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "psa/client.h"
+#include "psa/crypto.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief TFM secure partition TLS record API version
+ */
+#define TFM_TLS_RECORD_API_VERSION_MAJOR (0)
+#define TFM_TLS_RECORD_API_VERSION_MINOR (1)
+
+/* Protocol versions of the connections, as carried by the TLS handshake */
+#define TFM_TLS_RECORD_VERSION_1_2          (0x0303U)
+#define TFM_TLS_RECORD_VERSION_1_3          (0x0304U)
+
+/* Handle which does not refer to any connection */
+#define TFM_TLS_RECORD_INVALID_HANDLE       (0U)
+
+/**
+ * \brief Lengths of the parts of an AEAD record. The explicit nonce is only
+ *        carried by the AES-GCM records of TLS 1.2 (RFC 5288), the other
+ *        suites build the whole nonce from the sequence number.
+ */
+#define TFM_TLS_RECORD_HEADER_LENGTH        (5u)
+#define TFM_TLS_RECORD_EXPLICIT_NONCE_LENGTH (8u)
+#define TFM_TLS_RECORD_TAG_LENGTH           (16u)
+
+/**
+ * \brief Maximum length of the plaintext of a record, 2^14 bytes
+ */
+#define TFM_TLS_RECORD_MAX_PLAINTEXT_LENGTH (16384u)
+
+/**
+ * \brief Length of the master secret of TLS 1.2 and of the concatenated
+ *        ServerHello.random and ClientHello.random, RFC 5246 section 8.1
+ */
+#define TFM_TLS_RECORD_MASTER_SECRET_LENGTH (48u)
+#define TFM_TLS_RECORD_RANDOMS_LENGTH       (64u)
+
+/**
+ * \brief Size of the buffer needed for the record protecting a plaintext of
+ *        the given length, with any of the supported versions and
+ *        algorithms. The explicit nonce of TLS 1.2 is longer than the inner
+ *        content type of TLS 1.3, so it covers both.
+ */
+#define TFM_TLS_RECORD_SIZE(plaintext_length)      \
+    (TFM_TLS_RECORD_HEADER_LENGTH +                \
+     TFM_TLS_RECORD_EXPLICIT_NONCE_LENGTH +        \
+     (plaintext_length) + TFM_TLS_RECORD_TAG_LENGTH)
+
+/*!
+ * \struct tfm_tls_record_params
+ *
+ * \brief Cipher suite and side of a connection
+ *
+ */
+struct tfm_tls_record_params {
+    uint32_t version;         /*!< TFM_TLS_RECORD_VERSION_1_2 or
+                               *   TFM_TLS_RECORD_VERSION_1_3
+                               */
+    psa_algorithm_t alg;      /*!< PSA_ALG_GCM or PSA_ALG_CHACHA20_POLY1305 */
+    psa_algorithm_t hash_alg; /*!< Hash of the suite, PSA_ALG_SHA_256 or
+                               *   PSA_ALG_SHA_384, used by the PRF of
+                               *   TLS 1.2 and the HKDF of TLS 1.3
+                               */
+    uint32_t key_bits;        /*!< Size of the keys, 128 or 256 for AES-GCM
+                               *   and 256 for ChaCha20-Poly1305
+                               */
+    uint32_t is_server;       /*!< Non-zero for the server end of the
+                               *   connection, which writes with the server
+                               *   keys
+                               */
+};
+
+/**
+ * \brief Sets up the record protection of a connection.
+ *
+ * \details The partition derives the traffic keys and the IVs of both
+ *          directions and keeps them, with the sequence numbers, until the
+ *          connection is aborted. The keys are created in the key slots of
+ *          the partition, so they never leave the SPE.
+ *
+ *          For TLS 1.2, \p secret is the master secret and \p randoms is
+ *          ServerHello.random followed by ClientHello.random: the key block
+ *          is expanded with the PRF of \p params, RFC 5246 section 6.3.
+ *
+ *          For TLS 1.3, \p secret is the client application traffic secret
+ *          followed by the server application traffic secret, each of the
+ *          length of the hash of \p params, and \p randoms is empty: the keys
+ *          and IVs are derived with HKDF-Expand-Label, RFC 8446 section 7.3.
+ *          After a KeyUpdate, the connection is set up again with the new
+ *          secrets, as the sequence numbers restart from zero.
+ *
+ * \param[out] connection      Handle of the connection
+ * \param[in]  params          Version, cipher suite and side of the
+ *                             connection
+ * \param[in]  secret          Secret the keys are derived from
+ * \param[in]  secret_length   Size of \p secret
+ * \param[in]  randoms         Randoms of the handshake, for TLS 1.2
+ * \param[in]  randoms_length  Size of \p randoms
+ *
+ * \return PSA_SUCCESS if the connection is set up. PSA_ERROR_NOT_SUPPORTED if
+ *         the version or the algorithms are not supported,
+ *         PSA_ERROR_INVALID_ARGUMENT if the key size or the length of the
+ *         secrets does not match them. PSA_ERROR_INSUFFICIENT_MEMORY if all
+ *         the connections are in use.
+ */
+psa_status_t psa_tls_record_setup(uint32_t *connection,
+                                  const struct tfm_tls_record_params *params,
+                                  const uint8_t *secret,
+                                  size_t secret_length,
+                                  const uint8_t *randoms,
+                                  size_t randoms_length);
+
+/**
+ * \brief Protects one record with the write key of a connection.
+ *
+ * \details The record is written with its header, the explicit nonce if the
+ *          suite has one, the ciphertext and the tag, ready to be sent. With
+ *          TLS 1.3 the content type is protected with the plaintext and the
+ *          record is of the application_data type. The write sequence number
+ *          is incremented.
+ *
+ * \param[in]  connection        Handle of the connection
+ * \param[in]  content_type      TLS content type of the record
+ * \param[in]  plaintext         Fragment to protect
+ * \param[in]  plaintext_length  Size of the fragment, at most
+ *                               \ref TFM_TLS_RECORD_MAX_PLAINTEXT_LENGTH
+ * \param[out] record            Buffer to write the record to
+ * \param[in]  record_size       Size of the \p record buffer, see
+ *                               \ref TFM_TLS_RECORD_SIZE
+ * \param[out] record_length     Size of the record written
+ *
+ * \return PSA_SUCCESS if the record is written. PSA_ERROR_INVALID_HANDLE if
+ *         the connection is not one of the caller. PSA_ERROR_BAD_STATE if
+ *         the sequence number is exhausted.
+ */
+psa_status_t psa_tls_record_protect(uint32_t connection,
+                                    uint8_t content_type,
+                                    const uint8_t *plaintext,
+                                    size_t plaintext_length,
+                                    uint8_t *record,
+                                    size_t record_size,
+                                    size_t *record_length);
+
+/**
+ * \brief Checks and decrypts one record with the read key of a connection.
+ *
+ * \details The read sequence number is only incremented if the record is
+ *          authentic. The fragment is decrypted into \p plaintext as the
+ *          record is checked, so its content must be discarded if the call
+ *          fails. With TLS 1.3 the content type and the padding of the inner
+ *          plaintext are also written after the fragment, so \p plaintext
+ *          must hold the record less its header and tag.
+ *
+ * \param[in]  connection        Handle of the connection
+ * \param[in]  record            Record as received, header included
+ * \param[in]  record_length     Size of the record
+ * \param[out] content_type      TLS content type of the record
+ * \param[out] plaintext         Buffer to write the fragment to
+ * \param[in]  plaintext_size    Size of the \p plaintext buffer
+ * \param[out] plaintext_length  Size of the fragment
+ *
+ * \return PSA_SUCCESS if the record is authentic.
+ *         PSA_ERROR_INVALID_SIGNATURE if it is not.
+ *         PSA_ERROR_INVALID_ARGUMENT if the record is malformed.
+ *         PSA_ERROR_INVALID_HANDLE if the connection is not one of the
+ *         caller.
+ */
+psa_status_t psa_tls_record_unprotect(uint32_t connection,
+                                      const uint8_t *record,
+                                      size_t record_length,
+                                      uint8_t *content_type,
+                                      uint8_t *plaintext,
+                                      size_t plaintext_size,
+                                      size_t *plaintext_length);
+
+/**
+ * \brief Releases a connection and destroys its keys.
+ *
+ * \param[in,out] connection  Handle of the connection. It is set to
+ *                            \ref TFM_TLS_RECORD_INVALID_HANDLE on return.
+ *
+ * \return PSA_SUCCESS, also if the connection does not exist.
+ */
+psa_status_t psa_tls_record_abort(uint32_t *connection);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TFM_TLS_RECORD_API_H__ */
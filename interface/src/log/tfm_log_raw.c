@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -8,6 +8,7 @@
 #include <stdarg.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 #include "log/tfm_log_raw.h"
 #include "uart_stdout.h"
 
@@ -169,3 +170,35 @@ int tfm_log_printf(const char *fmt, ...)
 
     return count;
 }
+
+#ifdef TFM_LOG_DEFERRED
+int tfm_log_deferred(const char *fmt, uint32_t nargs, ...)
+{
+    uint8_t frame[2 + sizeof(uint32_t) * (1 + TFM_LOG_MAX_ARGS)];
+    uint32_t pos = 0;
+    uint32_t word;
+    uint32_t i;
+    va_list ap;
+
+    if (nargs > TFM_LOG_MAX_ARGS) {
+        nargs = TFM_LOG_MAX_ARGS;
+    }
+
+    frame[pos++] = TFM_LOG_FRAME_MARKER;
+    frame[pos++] = (uint8_t)nargs;
+
+    word = (uint32_t)(uintptr_t)fmt;
+    (void)memcpy(&frame[pos], &word, sizeof(word));
+    pos += sizeof(word);
+
+    va_start(ap, nargs);
+    for (i = 0; i < nargs; i++) {
+        word = va_arg(ap, uint32_t);
+        (void)memcpy(&frame[pos], &word, sizeof(word));
+        pos += sizeof(word);
+    }
+    va_end(ap);
+
+    return stdio_output_string(frame, pos);
+}
+#endif /* TFM_LOG_DEFERRED */
@@ -59,6 +59,15 @@ psa_status_t psa_call(psa_handle_t handle,
     return psa_call_param_pack(handle, &ctrl_param, in_vec, out_vec);
 }
 
+__attribute__((naked))
+psa_status_t psa_call_batch(psa_handle_t handle, psa_batch_call_t *calls,
+                            size_t num_calls)
+{
+    __ASM volatile("SVC %0           \n"
+                   "BX LR            \n"
+                   : : "I" (TFM_SVC_PSA_CALL_BATCH));
+}
+
 __attribute__((naked))
 void psa_close(psa_handle_t handle)
 {
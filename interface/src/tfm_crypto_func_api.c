@@ -686,6 +686,32 @@ psa_status_t psa_mac_abort(psa_mac_operation_t *operation)
     return status;
 }
 
+psa_status_t psa_mac_clone(const psa_mac_operation_t *source_operation,
+                           psa_mac_operation_t *target_operation)
+{
+    psa_status_t status;
+    struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_MAC_CLONE_SID,
+        .op_handle = source_operation->handle,
+    };
+
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+    };
+    psa_outvec out_vec[] = {
+        {.base = target_operation, .len = sizeof(psa_mac_operation_t)},
+    };
+
+    if (target_operation && (target_operation->handle != 0)) {
+        return PSA_ERROR_BAD_STATE;
+    }
+
+    status = API_DISPATCH(tfm_crypto_mac_clone,
+                          TFM_CRYPTO_MAC_CLONE);
+
+    return status;
+}
+
 psa_status_t psa_aead_encrypt(psa_key_handle_t handle,
                               psa_algorithm_t alg,
                               const uint8_t *nonce,
@@ -1098,6 +1124,48 @@ psa_status_t psa_generate_random(uint8_t *output,
     return status;
 }
 
+psa_status_t psa_generate_random_batch(uint8_t *const outputs[],
+                                       const size_t output_sizes[],
+                                       size_t count)
+{
+    psa_status_t status = PSA_SUCCESS;
+    struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_GENERATE_RANDOM_SID,
+    };
+
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+    };
+
+    psa_outvec out_vec[TFM_CRYPTO_RANDOM_BATCH_MAX_OUTPUTS];
+    size_t out_len = 0;
+    size_t i;
+
+    if ((count != 0) && ((outputs == NULL) || (output_sizes == NULL))) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    /* Each request fills up to TFM_CRYPTO_RANDOM_BATCH_MAX_OUTPUTS buffers */
+    for (i = 0; (i < count) && (status == PSA_SUCCESS); i++) {
+        if (output_sizes[i] != 0) {
+            out_vec[out_len].base = outputs[i];
+            out_vec[out_len].len = output_sizes[i];
+            out_len++;
+        }
+
+        if ((out_len == ARRAY_SIZE(out_vec)) ||
+            ((i == count - 1) && (out_len != 0))) {
+            status = tfm_ns_interface_dispatch(
+                         (veneer_fn)tfm_tfm_crypto_generate_random_veneer,
+                         (uint32_t)in_vec, ARRAY_SIZE(in_vec),
+                         (uint32_t)out_vec, out_len);
+            out_len = 0;
+        }
+    }
+
+    return status;
+}
+
 psa_status_t psa_generate_key(const psa_key_attributes_t *attributes,
                               psa_key_handle_t *handle)
 {
@@ -1164,8 +1232,21 @@ psa_status_t psa_aead_update_ad(psa_aead_operation_t *operation,
                                 size_t input_length)
 {
     psa_status_t status;
+    struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_AEAD_UPDATE_AD_SID,
+        .op_handle = operation->handle,
+    };
 
-    status = PSA_ERROR_NOT_SUPPORTED;
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+        {.base = input, .len = input_length},
+    };
+    psa_outvec out_vec[] = {
+        {.base = &(operation->handle), .len = sizeof(uint32_t)},
+    };
+
+    status = API_DISPATCH(tfm_crypto_aead_update_ad,
+                          TFM_CRYPTO_AEAD_UPDATE_AD);
 
     return status;
 }
@@ -1179,8 +1260,25 @@ psa_status_t psa_aead_finish(psa_aead_operation_t *operation,
                              size_t *tag_length)
 {
     psa_status_t status;
+    struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_AEAD_FINISH_SID,
+        .op_handle = operation->handle,
+    };
 
-    status = PSA_ERROR_NOT_SUPPORTED;
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+    };
+    psa_outvec out_vec[] = {
+        {.base = &(operation->handle), .len = sizeof(uint32_t)},
+        {.base = ciphertext, .len = ciphertext_size},
+        {.base = tag, .len = tag_size},
+    };
+
+    status = API_DISPATCH(tfm_crypto_aead_finish,
+                          TFM_CRYPTO_AEAD_FINISH);
+
+    *ciphertext_length = out_vec[1].len;
+    *tag_length = out_vec[2].len;
 
     return status;
 }
@@ -1193,8 +1291,24 @@ psa_status_t psa_aead_verify(psa_aead_operation_t *operation,
                              size_t tag_length)
 {
     psa_status_t status;
+    struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_AEAD_VERIFY_SID,
+        .op_handle = operation->handle,
+    };
 
-    status = PSA_ERROR_NOT_SUPPORTED;
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+        {.base = tag, .len = tag_length},
+    };
+    psa_outvec out_vec[] = {
+        {.base = &(operation->handle), .len = sizeof(uint32_t)},
+        {.base = plaintext, .len = plaintext_size},
+    };
+
+    status = API_DISPATCH(tfm_crypto_aead_verify,
+                          TFM_CRYPTO_AEAD_VERIFY);
+
+    *plaintext_length = out_vec[1].len;
 
     return status;
 }
@@ -1202,8 +1316,180 @@ psa_status_t psa_aead_verify(psa_aead_operation_t *operation,
 psa_status_t psa_aead_abort(psa_aead_operation_t *operation)
 {
     psa_status_t status;
+    struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_AEAD_ABORT_SID,
+        .op_handle = operation->handle,
+    };
 
-    status = PSA_ERROR_NOT_SUPPORTED;
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+    };
+    psa_outvec out_vec[] = {
+        {.base = &(operation->handle), .len = sizeof(uint32_t)},
+    };
+
+    status = API_DISPATCH(tfm_crypto_aead_abort,
+                          TFM_CRYPTO_AEAD_ABORT);
+
+    return status;
+}
+
+psa_status_t psa_aead_encrypt_batch(psa_key_handle_t handle,
+                                    psa_algorithm_t alg,
+                                    struct tfm_crypto_aead_batch_entry *entries,
+                                    size_t entry_count,
+                                    const uint8_t *input,
+                                    size_t input_length,
+                                    uint8_t *output,
+                                    size_t output_size)
+{
+    psa_status_t status;
+    const struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_AEAD_ENCRYPT_BATCH_SID,
+        .key_handle = handle,
+        .alg = alg,
+    };
+    struct tfm_crypto_aead_batch_result
+                                results[TFM_CRYPTO_AEAD_BATCH_MAX_ENTRIES];
+    size_t idx;
+
+    if ((entries == NULL) || (entry_count == 0) ||
+        (entry_count > TFM_CRYPTO_AEAD_BATCH_MAX_ENTRIES)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+        {.base = entries,
+         .len = entry_count * sizeof(struct tfm_crypto_aead_batch_entry)},
+        {.base = input, .len = input_length},
+    };
+    psa_outvec out_vec[] = {
+        {.base = output, .len = output_size},
+        {.base = results,
+         .len = entry_count * sizeof(struct tfm_crypto_aead_batch_result)},
+    };
+
+    status = API_DISPATCH(tfm_crypto_aead_encrypt_batch,
+                          TFM_CRYPTO_AEAD_ENCRYPT_BATCH);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    for (idx = 0; idx < entry_count; idx++) {
+        entries[idx].status = results[idx].status;
+        entries[idx].output_length = results[idx].output_length;
+    }
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t psa_aead_decrypt_batch(psa_key_handle_t handle,
+                                    psa_algorithm_t alg,
+                                    struct tfm_crypto_aead_batch_entry *entries,
+                                    size_t entry_count,
+                                    const uint8_t *input,
+                                    size_t input_length,
+                                    uint8_t *output,
+                                    size_t output_size)
+{
+    psa_status_t status;
+    const struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_AEAD_DECRYPT_BATCH_SID,
+        .key_handle = handle,
+        .alg = alg,
+    };
+    struct tfm_crypto_aead_batch_result
+                                results[TFM_CRYPTO_AEAD_BATCH_MAX_ENTRIES];
+    size_t idx;
+
+    if ((entries == NULL) || (entry_count == 0) ||
+        (entry_count > TFM_CRYPTO_AEAD_BATCH_MAX_ENTRIES)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+        {.base = entries,
+         .len = entry_count * sizeof(struct tfm_crypto_aead_batch_entry)},
+        {.base = input, .len = input_length},
+    };
+    psa_outvec out_vec[] = {
+        {.base = output, .len = output_size},
+        {.base = results,
+         .len = entry_count * sizeof(struct tfm_crypto_aead_batch_result)},
+    };
+
+    status = API_DISPATCH(tfm_crypto_aead_decrypt_batch,
+                          TFM_CRYPTO_AEAD_DECRYPT_BATCH);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    for (idx = 0; idx < entry_count; idx++) {
+        entries[idx].status = results[idx].status;
+        entries[idx].output_length = results[idx].output_length;
+    }
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t psa_verify_hash_batch(
+                            const struct tfm_crypto_verify_batch_entry *entries,
+                            size_t entry_count,
+                            const uint8_t *input,
+                            size_t input_length,
+                            uint32_t *verified)
+{
+    psa_status_t status;
+    const struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_VERIFY_HASH_BATCH_SID,
+    };
+
+    if ((entries == NULL) || (entry_count == 0) ||
+        (entry_count > TFM_CRYPTO_VERIFY_BATCH_MAX_ENTRIES) ||
+        (verified == NULL)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+        {.base = entries,
+         .len = entry_count * sizeof(struct tfm_crypto_verify_batch_entry)},
+        {.base = input, .len = input_length},
+    };
+    psa_outvec out_vec[] = {
+        {.base = verified, .len = sizeof(uint32_t)},
+    };
+
+    status = API_DISPATCH(tfm_crypto_verify_hash_batch,
+                          TFM_CRYPTO_VERIFY_HASH_BATCH);
+
+    return status;
+}
+
+psa_status_t psa_crypto_get_engine_mem_stats(
+                                      struct tfm_crypto_engine_mem_stats *stats)
+{
+    psa_status_t status;
+    struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_GET_ENGINE_MEM_STATS_SID,
+    };
+
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+    };
+
+    psa_outvec out_vec[] = {
+        {.base = stats, .len = sizeof(struct tfm_crypto_engine_mem_stats)},
+    };
+
+    if (stats == NULL) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    status = API_DISPATCH(tfm_crypto_get_engine_mem_stats,
+                          TFM_CRYPTO_GET_ENGINE_MEM_STATS);
 
     return status;
 }
@@ -1408,8 +1694,22 @@ psa_status_t psa_aead_encrypt_setup(psa_aead_operation_t *operation,
                                     psa_algorithm_t alg)
 {
     psa_status_t status;
+    struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_AEAD_ENCRYPT_SETUP_SID,
+        .key_handle = handle,
+        .alg = alg,
+        .op_handle = operation->handle,
+    };
 
-    status = PSA_ERROR_NOT_SUPPORTED;
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+    };
+    psa_outvec out_vec[] = {
+        {.base = &(operation->handle), .len = sizeof(uint32_t)},
+    };
+
+    status = API_DISPATCH(tfm_crypto_aead_encrypt_setup,
+                          TFM_CRYPTO_AEAD_ENCRYPT_SETUP);
 
     return status;
 }
@@ -1419,8 +1719,22 @@ psa_status_t psa_aead_decrypt_setup(psa_aead_operation_t *operation,
                                     psa_algorithm_t alg)
 {
     psa_status_t status;
+    struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_AEAD_DECRYPT_SETUP_SID,
+        .key_handle = handle,
+        .alg = alg,
+        .op_handle = operation->handle,
+    };
 
-    status = PSA_ERROR_NOT_SUPPORTED;
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+    };
+    psa_outvec out_vec[] = {
+        {.base = &(operation->handle), .len = sizeof(uint32_t)},
+    };
+
+    status = API_DISPATCH(tfm_crypto_aead_decrypt_setup,
+                          TFM_CRYPTO_AEAD_DECRYPT_SETUP);
 
     return status;
 }
@@ -1431,8 +1745,23 @@ psa_status_t psa_aead_generate_nonce(psa_aead_operation_t *operation,
                                      size_t *nonce_length)
 {
     psa_status_t status;
+    struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_AEAD_GENERATE_NONCE_SID,
+        .op_handle = operation->handle,
+    };
 
-    status = PSA_ERROR_NOT_SUPPORTED;
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+    };
+    psa_outvec out_vec[] = {
+        {.base = &(operation->handle), .len = sizeof(uint32_t)},
+        {.base = nonce, .len = nonce_size},
+    };
+
+    status = API_DISPATCH(tfm_crypto_aead_generate_nonce,
+                          TFM_CRYPTO_AEAD_GENERATE_NONCE);
+
+    *nonce_length = out_vec[1].len;
 
     return status;
 }
@@ -1442,8 +1771,21 @@ psa_status_t psa_aead_set_nonce(psa_aead_operation_t *operation,
                                 size_t nonce_length)
 {
     psa_status_t status;
+    struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_AEAD_SET_NONCE_SID,
+        .op_handle = operation->handle,
+    };
 
-    status = PSA_ERROR_NOT_SUPPORTED;
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+        {.base = nonce, .len = nonce_length},
+    };
+    psa_outvec out_vec[] = {
+        {.base = &(operation->handle), .len = sizeof(uint32_t)},
+    };
+
+    status = API_DISPATCH(tfm_crypto_aead_set_nonce,
+                          TFM_CRYPTO_AEAD_SET_NONCE);
 
     return status;
 }
@@ -1453,8 +1795,22 @@ psa_status_t psa_aead_set_lengths(psa_aead_operation_t *operation,
                                   size_t plaintext_length)
 {
     psa_status_t status;
+    struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_AEAD_SET_LENGTHS_SID,
+        .op_handle = operation->handle,
+    };
+    size_t lengths[2] = {ad_length, plaintext_length};
 
-    status = PSA_ERROR_NOT_SUPPORTED;
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+        {.base = lengths, .len = sizeof(lengths)},
+    };
+    psa_outvec out_vec[] = {
+        {.base = &(operation->handle), .len = sizeof(uint32_t)},
+    };
+
+    status = API_DISPATCH(tfm_crypto_aead_set_lengths,
+                          TFM_CRYPTO_AEAD_SET_LENGTHS);
 
     return status;
 }
@@ -1467,8 +1823,24 @@ psa_status_t psa_aead_update(psa_aead_operation_t *operation,
                              size_t *output_length)
 {
     psa_status_t status;
+    struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_AEAD_UPDATE_SID,
+        .op_handle = operation->handle,
+    };
 
-    status = PSA_ERROR_NOT_SUPPORTED;
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+        {.base = input, .len = input_length},
+    };
+    psa_outvec out_vec[] = {
+        {.base = &(operation->handle), .len = sizeof(uint32_t)},
+        {.base = output, .len = output_size},
+    };
+
+    status = API_DISPATCH(tfm_crypto_aead_update,
+                          TFM_CRYPTO_AEAD_UPDATE);
+
+    *output_length = out_vec[1].len;
 
     return status;
 }
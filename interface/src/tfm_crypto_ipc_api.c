@@ -14,22 +14,18 @@
 
 #define ARRAY_SIZE(arr) (sizeof(arr)/sizeof(arr[0]))
 
-#define PSA_CONNECT(service)                                    \
-    psa_handle_t ipc_handle;                                    \
-    ipc_handle = psa_connect(service##_SID, service##_VERSION); \
-    if (!PSA_HANDLE_IS_VALID(ipc_handle)) {                     \
-        return PSA_ERROR_GENERIC_ERROR;                         \
-    }                                                           \
-
-#define PSA_CLOSE() psa_close(ipc_handle)
+/* Public key operations are queued apart from the other requests */
+#define API_HANDLE(sfn_id)                                      \
+    (TFM_CRYPTO_IS_ASYM_SID(sfn_id##_SID) ?                     \
+        TFM_CRYPTO_ASYM_HANDLE : TFM_CRYPTO_HANDLE)
 
 #define API_DISPATCH(sfn_name, sfn_id)                          \
-    psa_call(ipc_handle, PSA_IPC_CALL,                          \
+    psa_call(API_HANDLE(sfn_id), PSA_IPC_CALL,                  \
         in_vec, ARRAY_SIZE(in_vec),                             \
         out_vec, ARRAY_SIZE(out_vec))
 
 #define API_DISPATCH_NO_OUTVEC(sfn_name, sfn_id)                \
-    psa_call(ipc_handle, PSA_IPC_CALL,                          \
+    psa_call(API_HANDLE(sfn_id), PSA_IPC_CALL,                  \
         in_vec, ARRAY_SIZE(in_vec),                             \
         (psa_outvec *)NULL, 0)
 
@@ -59,13 +55,9 @@ psa_status_t psa_open_key(psa_key_id_t id,
         {.base = handle, .len = sizeof(psa_key_handle_t)},
     };
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     status = API_DISPATCH(tfm_crypto_open_key,
                           TFM_CRYPTO_OPEN_KEY);
 
-    PSA_CLOSE();
-
     return status;
 #endif /* TFM_CRYPTO_KEY_MODULE_DISABLED */
 }
@@ -84,13 +76,9 @@ psa_status_t psa_close_key(psa_key_handle_t handle)
         {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
     };
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     status = API_DISPATCH_NO_OUTVEC(tfm_crypto_close_key,
                                     TFM_CRYPTO_CLOSE_KEY);;
 
-    PSA_CLOSE();
-
     return status;
 #endif /* TFM_CRYPTO_KEY_MODULE_DISABLED */
 }
@@ -116,11 +104,8 @@ psa_status_t psa_import_key(const psa_key_attributes_t *attributes,
         {.base = handle, .len = sizeof(psa_key_handle_t)}
     };
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     status = API_DISPATCH(tfm_crypto_import_key,
                           TFM_CRYPTO_IMPORT_KEY);
-    PSA_CLOSE();
 
     return status;
 #endif /* TFM_CRYPTO_KEY_MODULE_DISABLED */
@@ -140,11 +125,8 @@ psa_status_t psa_destroy_key(psa_key_handle_t handle)
         {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
     };
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     status = API_DISPATCH_NO_OUTVEC(tfm_crypto_destroy_key,
                                     TFM_CRYPTO_DESTROY_KEY);
-    PSA_CLOSE();
 
     return status;
 #endif /* TFM_CRYPTO_KEY_MODULE_DISABLED */
@@ -168,11 +150,8 @@ psa_status_t psa_get_key_attributes(psa_key_handle_t handle,
         {.base = attributes, .len = sizeof(psa_key_attributes_t)},
     };
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     status = API_DISPATCH(tfm_crypto_get_key_attributes,
                           TFM_CRYPTO_GET_KEY_ATTRIBUTES);
-    PSA_CLOSE();
 
     return status;
 #endif /* TFM_CRYPTO_KEY_MODULE_DISABLED */
@@ -193,15 +172,8 @@ void psa_reset_key_attributes(psa_key_attributes_t *attributes)
         {.base = attributes, .len = sizeof(psa_key_attributes_t)},
     };
 
-    psa_handle_t ipc_handle;
-    ipc_handle = psa_connect(TFM_CRYPTO_SID, TFM_CRYPTO_VERSION);
-    if (!PSA_HANDLE_IS_VALID(ipc_handle)) {
-        return;
-    }
-
     (void)API_DISPATCH(tfm_crypto_reset_key_attributes,
                           TFM_CRYPTO_RESET_KEY_ATTRIBUTES);
-    PSA_CLOSE();
 
     return;
 #endif /* TFM_CRYPTO_KEY_MODULE_DISABLED */
@@ -227,15 +199,11 @@ psa_status_t psa_export_key(psa_key_handle_t handle,
         {.base = data, .len = data_size}
     };
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     status = API_DISPATCH(tfm_crypto_export_key,
                           TFM_CRYPTO_EXPORT_KEY);
 
     *data_length = out_vec[0].len;
 
-    PSA_CLOSE();
-
     return status;
 #endif /* TFM_CRYPTO_KEY_MODULE_DISABLED */
 }
@@ -261,15 +229,11 @@ psa_status_t psa_export_public_key(psa_key_handle_t handle,
         {.base = data, .len = data_size}
     };
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     status = API_DISPATCH(tfm_crypto_export_public_key,
                           TFM_CRYPTO_EXPORT_PUBLIC_KEY);
 
     *data_length = out_vec[0].len;
 
-    PSA_CLOSE();
-
     return status;
 #endif /* TFM_CRYPTO_KEY_MODULE_DISABLED */
 }
@@ -297,13 +261,9 @@ psa_status_t psa_copy_key(psa_key_handle_t source_handle,
         {.base = target_handle, .len = sizeof(psa_key_handle_t)},
     };
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     status = API_DISPATCH(tfm_crypto_copy_key,
                           TFM_CRYPTO_COPY_KEY);
 
-    PSA_CLOSE();
-
     return status;
 #endif /* TFM_CRYPTO_KEY_MODULE_DISABLED */
 }
@@ -330,15 +290,11 @@ psa_status_t psa_cipher_generate_iv(psa_cipher_operation_t *operation,
         {.base = iv, .len = iv_size},
     };
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     status = API_DISPATCH(tfm_crypto_cipher_generate_iv,
                           TFM_CRYPTO_CIPHER_GENERATE_IV);
 
     *iv_length = out_vec[1].len;
 
-    PSA_CLOSE();
-
     return status;
 #endif /* TFM_CRYPTO_CIPHER_MODULE_DISABLED */
 }
@@ -364,13 +320,9 @@ psa_status_t psa_cipher_set_iv(psa_cipher_operation_t *operation,
         {.base = &(operation->handle), .len = sizeof(uint32_t)},
     };
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     status = API_DISPATCH(tfm_crypto_cipher_set_iv,
                           TFM_CRYPTO_CIPHER_SET_IV);
 
-    PSA_CLOSE();
-
     return status;
 #endif /* TFM_CRYPTO_CIPHER_MODULE_DISABLED */
 }
@@ -397,13 +349,9 @@ psa_status_t psa_cipher_encrypt_setup(psa_cipher_operation_t *operation,
         {.base = &(operation->handle), .len = sizeof(uint32_t)},
     };
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     status = API_DISPATCH(tfm_crypto_cipher_encrypt_setup,
                           TFM_CRYPTO_CIPHER_ENCRYPT_SETUP);
 
-    PSA_CLOSE();
-
     return status;
 #endif /* TFM_CRYPTO_CIPHER_MODULE_DISABLED */
 }
@@ -430,13 +378,9 @@ psa_status_t psa_cipher_decrypt_setup(psa_cipher_operation_t *operation,
         {.base = &(operation->handle), .len = sizeof(uint32_t)},
     };
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     status = API_DISPATCH(tfm_crypto_cipher_decrypt_setup,
                           TFM_CRYPTO_CIPHER_DECRYPT_SETUP);
 
-    PSA_CLOSE();
-
     return status;
 #endif /* TFM_CRYPTO_CIPHER_MODULE_DISABLED */
 }
@@ -466,15 +410,11 @@ psa_status_t psa_cipher_update(psa_cipher_operation_t *operation,
         {.base = output, .len = output_size}
     };
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     status = API_DISPATCH(tfm_crypto_cipher_update,
                           TFM_CRYPTO_CIPHER_UPDATE);
 
     *output_length = out_vec[1].len;
 
-    PSA_CLOSE();
-
     return status;
 #endif /* TFM_CRYPTO_CIPHER_MODULE_DISABLED */
 }
@@ -497,13 +437,9 @@ psa_status_t psa_cipher_abort(psa_cipher_operation_t *operation)
         {.base = &(operation->handle), .len = sizeof(uint32_t)},
     };
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     status = API_DISPATCH(tfm_crypto_cipher_abort,
                           TFM_CRYPTO_CIPHER_ABORT);
 
-    PSA_CLOSE();
-
     return status;
 #endif /* TFM_CRYPTO_CIPHER_MODULE_DISABLED */
 }
@@ -530,15 +466,11 @@ psa_status_t psa_cipher_finish(psa_cipher_operation_t *operation,
         {.base = output, .len = output_size},
     };
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     status = API_DISPATCH(tfm_crypto_cipher_finish,
                           TFM_CRYPTO_CIPHER_FINISH);
 
     *output_length = out_vec[1].len;
 
-    PSA_CLOSE();
-
     return status;
 #endif /* TFM_CRYPTO_CIPHER_MODULE_DISABLED */
 }
@@ -563,13 +495,9 @@ psa_status_t psa_hash_setup(psa_hash_operation_t *operation,
         {.base = &(operation->handle), .len = sizeof(uint32_t)},
     };
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     status = API_DISPATCH(tfm_crypto_hash_setup,
                           TFM_CRYPTO_HASH_SETUP);
 
-    PSA_CLOSE();
-
     return status;
 #endif /* TFM_CRYPTO_HASH_MODULE_DISABLED */
 }
@@ -595,13 +523,9 @@ psa_status_t psa_hash_update(psa_hash_operation_t *operation,
         {.base = &(operation->handle), .len = sizeof(uint32_t)},
     };
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     status = API_DISPATCH(tfm_crypto_hash_update,
                           TFM_CRYPTO_HASH_UPDATE);
 
-    PSA_CLOSE();
-
     return status;
 #endif /* TFM_CRYPTO_HASH_MODULE_DISABLED */
 }
@@ -628,15 +552,11 @@ psa_status_t psa_hash_finish(psa_hash_operation_t *operation,
         {.base = hash, .len = hash_size},
     };
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     status = API_DISPATCH(tfm_crypto_hash_finish,
                           TFM_CRYPTO_HASH_FINISH);
 
     *hash_length = out_vec[1].len;
 
-    PSA_CLOSE();
-
     return status;
 #endif /* TFM_CRYPTO_HASH_MODULE_DISABLED */
 }
@@ -662,13 +582,9 @@ psa_status_t psa_hash_verify(psa_hash_operation_t *operation,
         {.base = &(operation->handle), .len = sizeof(uint32_t)},
     };
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     status = API_DISPATCH(tfm_crypto_hash_verify,
                           TFM_CRYPTO_HASH_VERIFY);
 
-    PSA_CLOSE();
-
     return status;
 #endif /* TFM_CRYPTO_HASH_MODULE_DISABLED */
 }
@@ -691,13 +607,9 @@ psa_status_t psa_hash_abort(psa_hash_operation_t *operation)
         {.base = &(operation->handle), .len = sizeof(uint32_t)},
     };
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     status = API_DISPATCH(tfm_crypto_hash_abort,
                           TFM_CRYPTO_HASH_ABORT);
 
-    PSA_CLOSE();
-
     return status;
 #endif /* TFM_CRYPTO_HASH_MODULE_DISABLED */
 }
@@ -725,13 +637,9 @@ psa_status_t psa_hash_clone(const psa_hash_operation_t *source_operation,
         return PSA_ERROR_BAD_STATE;
     }
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     status = API_DISPATCH(tfm_crypto_hash_clone,
                           TFM_CRYPTO_HASH_CLONE);
 
-    PSA_CLOSE();
-
     return status;
 #endif /* TFM_CRYPTO_HASH_MODULE_DISABLED */
 }
@@ -758,13 +666,9 @@ psa_status_t psa_mac_sign_setup(psa_mac_operation_t *operation,
         {.base = &(operation->handle), .len = sizeof(uint32_t)},
     };
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     status = API_DISPATCH(tfm_crypto_mac_sign_setup,
                           TFM_CRYPTO_MAC_SIGN_SETUP);
 
-    PSA_CLOSE();
-
     return status;
 #endif /* TFM_CRYPTO_MAC_MODULE_DISABLED */
 }
@@ -791,13 +695,9 @@ psa_status_t psa_mac_verify_setup(psa_mac_operation_t *operation,
         {.base = &(operation->handle), .len = sizeof(uint32_t)},
     };
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     status = API_DISPATCH(tfm_crypto_mac_verify_setup,
                           TFM_CRYPTO_MAC_VERIFY_SETUP);
 
-    PSA_CLOSE();
-
     return status;
 #endif /* TFM_CRYPTO_MAC_MODULE_DISABLED */
 }
@@ -823,13 +723,9 @@ psa_status_t psa_mac_update(psa_mac_operation_t *operation,
         {.base = &(operation->handle), .len = sizeof(uint32_t)},
     };
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     status = API_DISPATCH(tfm_crypto_mac_update,
                           TFM_CRYPTO_MAC_UPDATE);
 
-    PSA_CLOSE();
-
     return status;
 #endif /* TFM_CRYPTO_MAC_MODULE_DISABLED */
 }
@@ -856,15 +752,11 @@ psa_status_t psa_mac_sign_finish(psa_mac_operation_t *operation,
         {.base = mac, .len = mac_size},
     };
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     status = API_DISPATCH(tfm_crypto_mac_sign_finish,
                           TFM_CRYPTO_MAC_SIGN_FINISH);
 
     *mac_length = out_vec[1].len;
 
-    PSA_CLOSE();
-
     return status;
 #endif /* TFM_CRYPTO_MAC_MODULE_DISABLED */
 }
@@ -890,13 +782,9 @@ psa_status_t psa_mac_verify_finish(psa_mac_operation_t *operation,
         {.base = &(operation->handle), .len = sizeof(uint32_t)},
     };
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     status = API_DISPATCH(tfm_crypto_mac_verify_finish,
                           TFM_CRYPTO_MAC_VERIFY_FINISH);
 
-    PSA_CLOSE();
-
     return status;
 #endif /* TFM_CRYPTO_MAC_MODULE_DISABLED */
 }
@@ -919,12 +807,38 @@ psa_status_t psa_mac_abort(psa_mac_operation_t *operation)
         {.base = &(operation->handle), .len = sizeof(uint32_t)},
     };
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     status = API_DISPATCH(tfm_crypto_mac_abort,
                           TFM_CRYPTO_MAC_ABORT);
 
-    PSA_CLOSE();
+    return status;
+#endif /* TFM_CRYPTO_MAC_MODULE_DISABLED */
+}
+
+psa_status_t psa_mac_clone(const psa_mac_operation_t *source_operation,
+                           psa_mac_operation_t *target_operation)
+{
+#ifdef TFM_CRYPTO_MAC_MODULE_DISABLED
+    return PSA_ERROR_NOT_SUPPORTED;
+#else
+    psa_status_t status;
+    struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_MAC_CLONE_SID,
+        .op_handle = source_operation->handle,
+    };
+
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+    };
+    psa_outvec out_vec[] = {
+        {.base = target_operation, .len = sizeof(psa_mac_operation_t)},
+    };
+
+    if (target_operation && (target_operation->handle != 0)) {
+        return PSA_ERROR_BAD_STATE;
+    }
+
+    status = API_DISPATCH(tfm_crypto_mac_clone,
+                          TFM_CRYPTO_MAC_CLONE);
 
     return status;
 #endif /* TFM_CRYPTO_MAC_MODULE_DISABLED */
@@ -978,19 +892,15 @@ psa_status_t psa_aead_encrypt(psa_key_handle_t handle,
         }
     }
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     size_t in_len = ARRAY_SIZE(in_vec);
     if (additional_data == NULL) {
         in_len--;
     }
-    status = psa_call(ipc_handle, PSA_IPC_CALL, in_vec, in_len,
+    status = psa_call(TFM_CRYPTO_HANDLE, PSA_IPC_CALL, in_vec, in_len,
                       out_vec, ARRAY_SIZE(out_vec));
 
     *ciphertext_length = out_vec[0].len;
 
-    PSA_CLOSE();
-
     return status;
 #endif /* TFM_CRYPTO_AEAD_MODULE_DISABLED */
 }
@@ -1043,19 +953,15 @@ psa_status_t psa_aead_decrypt(psa_key_handle_t handle,
         }
     }
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     size_t in_len = ARRAY_SIZE(in_vec);
     if (additional_data == NULL) {
         in_len--;
     }
-    status = psa_call(ipc_handle, PSA_IPC_CALL, in_vec, in_len,
+    status = psa_call(TFM_CRYPTO_HANDLE, PSA_IPC_CALL, in_vec, in_len,
                       out_vec, ARRAY_SIZE(out_vec));
 
     *plaintext_length = out_vec[0].len;
 
-    PSA_CLOSE();
-
     return status;
 #endif /* TFM_CRYPTO_AEAD_MODULE_DISABLED */
 }
@@ -1097,15 +1003,11 @@ psa_status_t psa_sign_hash(psa_key_handle_t handle,
         {.base = signature, .len = signature_size},
     };
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     status = API_DISPATCH(tfm_crypto_sign_hash,
                           TFM_CRYPTO_SIGN_HASH);
 
     *signature_length = out_vec[0].len;
 
-    PSA_CLOSE();
-
     return status;
 #endif /* TFM_CRYPTO_ASYMMETRIC_MODULE_DISABLED */
 }
@@ -1143,13 +1045,9 @@ psa_status_t psa_verify_hash(psa_key_handle_t handle,
         {.base = signature, .len = signature_length}
     };
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     status = API_DISPATCH_NO_OUTVEC(tfm_crypto_verify_hash,
                                     TFM_CRYPTO_VERIFY_HASH);
 
-    PSA_CLOSE();
-
     return status;
 #endif /* TFM_CRYPTO_ASYMMETRIC_MODULE_DISABLED */
 }
@@ -1189,19 +1087,15 @@ psa_status_t psa_asymmetric_encrypt(psa_key_handle_t handle,
         {.base = output, .len = output_size},
     };
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     size_t in_len = ARRAY_SIZE(in_vec);
     if (salt == NULL) {
         in_len--;
     }
-    status = psa_call(ipc_handle, PSA_IPC_CALL, in_vec, in_len,
+    status = psa_call(TFM_CRYPTO_ASYM_HANDLE, PSA_IPC_CALL, in_vec, in_len,
                       out_vec, ARRAY_SIZE(out_vec));
 
     *output_length = out_vec[0].len;
 
-    PSA_CLOSE();
-
     return status;
 #endif /* TFM_CRYPTO_ASYMMETRIC_MODULE_DISABLED */
 }
@@ -1241,19 +1135,15 @@ psa_status_t psa_asymmetric_decrypt(psa_key_handle_t handle,
         {.base = output, .len = output_size},
     };
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     size_t in_len = ARRAY_SIZE(in_vec);
     if (salt == NULL) {
         in_len--;
     }
-    status = psa_call(ipc_handle, PSA_IPC_CALL, in_vec, in_len,
+    status = psa_call(TFM_CRYPTO_ASYM_HANDLE, PSA_IPC_CALL, in_vec, in_len,
                       out_vec, ARRAY_SIZE(out_vec));
 
     *output_length = out_vec[0].len;
 
-    PSA_CLOSE();
-
     return status;
 #endif /* TFM_CRYPTO_ASYMMETRIC_MODULE_DISABLED */
 }
@@ -1279,13 +1169,9 @@ psa_status_t psa_key_derivation_get_capacity(
         {.base = capacity, .len = sizeof(size_t)},
     };
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     status = API_DISPATCH(tfm_crypto_key_derivation_get_capacity,
                           TFM_CRYPTO_KEY_DERIVATION_GET_CAPACITY);
 
-    PSA_CLOSE();
-
     return status;
 #endif /* TFM_CRYPTO_GENERATOR_MODULE_DISABLED */
 }
@@ -1312,13 +1198,9 @@ psa_status_t psa_key_derivation_output_bytes(
         {.base = output, .len = output_length},
     };
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     status = API_DISPATCH(tfm_crypto_key_derivation_output_bytes,
                           TFM_CRYPTO_KEY_DERIVATION_OUTPUT_BYTES);
 
-    PSA_CLOSE();
-
     return status;
 #endif /* TFM_CRYPTO_GENERATOR_MODULE_DISABLED */
 }
@@ -1343,13 +1225,9 @@ psa_status_t psa_key_derivation_input_key(
         {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
     };
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     status = API_DISPATCH_NO_OUTVEC(tfm_crypto_key_derivation_input_key,
                                     TFM_CRYPTO_KEY_DERIVATION_INPUT_KEY);
 
-    PSA_CLOSE();
-
     return status;
 #endif /* TFM_CRYPTO_GENERATOR_MODULE_DISABLED */
 }
@@ -1374,13 +1252,9 @@ psa_status_t psa_key_derivation_abort(
         {.base = &(operation->handle), .len = sizeof(uint32_t)},
     };
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     status = API_DISPATCH(tfm_crypto_key_derivation_abort,
                           TFM_CRYPTO_KEY_DERIVATION_ABORT);
 
-    PSA_CLOSE();
-
     return status;
 #endif /* TFM_CRYPTO_GENERATOR_MODULE_DISABLED */
 }
@@ -1408,13 +1282,9 @@ psa_status_t psa_key_derivation_key_agreement(
         {.base = peer_key, .len = peer_key_length},
     };
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     status = API_DISPATCH_NO_OUTVEC(tfm_crypto_key_derivation_key_agreement,
                                     TFM_CRYPTO_KEY_DERIVATION_KEY_AGREEMENT);
 
-    PSA_CLOSE();
-
     return status;
 #endif /* TFM_CRYPTO_GENERATOR_MODULE_DISABLED */
 }
@@ -1442,12 +1312,52 @@ psa_status_t psa_generate_random(uint8_t *output,
         return PSA_SUCCESS;
     }
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     status = API_DISPATCH(tfm_crypto_generate_random,
                           TFM_CRYPTO_GENERATE_RANDOM);
 
-    PSA_CLOSE();
+    return status;
+#endif /* TFM_CRYPTO_GENERATOR_MODULE_DISABLED */
+}
+
+psa_status_t psa_generate_random_batch(uint8_t *const outputs[],
+                                       const size_t output_sizes[],
+                                       size_t count)
+{
+#ifdef TFM_CRYPTO_GENERATOR_MODULE_DISABLED
+    return PSA_ERROR_NOT_SUPPORTED;
+#else
+    psa_status_t status = PSA_SUCCESS;
+    struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_GENERATE_RANDOM_SID,
+    };
+
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+    };
+
+    psa_outvec out_vec[TFM_CRYPTO_RANDOM_BATCH_MAX_OUTPUTS];
+    size_t out_len = 0;
+    size_t i;
+
+    if ((count != 0) && ((outputs == NULL) || (output_sizes == NULL))) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    /* Each request fills up to TFM_CRYPTO_RANDOM_BATCH_MAX_OUTPUTS buffers */
+    for (i = 0; (i < count) && (status == PSA_SUCCESS); i++) {
+        if (output_sizes[i] != 0) {
+            out_vec[out_len].base = outputs[i];
+            out_vec[out_len].len = output_sizes[i];
+            out_len++;
+        }
+
+        if ((out_len == ARRAY_SIZE(out_vec)) ||
+            ((i == count - 1) && (out_len != 0))) {
+            status = psa_call(TFM_CRYPTO_HANDLE, PSA_IPC_CALL,
+                              in_vec, ARRAY_SIZE(in_vec), out_vec, out_len);
+            out_len = 0;
+        }
+    }
 
     return status;
 #endif /* TFM_CRYPTO_GENERATOR_MODULE_DISABLED */
@@ -1473,11 +1383,8 @@ psa_status_t psa_generate_key(const psa_key_attributes_t *attributes,
         {.base = handle, .len = sizeof(psa_key_handle_t)},
     };
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     status = API_DISPATCH(tfm_crypto_generate_key,
                           TFM_CRYPTO_GENERATE_KEY);
-    PSA_CLOSE();
 
     return status;
 #endif /* TFM_CRYPTO_GENERATOR_MODULE_DISABLED */
@@ -1525,11 +1432,28 @@ psa_status_t psa_aead_update_ad(psa_aead_operation_t *operation,
                                 const uint8_t *input,
                                 size_t input_length)
 {
+#ifdef TFM_CRYPTO_AEAD_MODULE_DISABLED
+    return PSA_ERROR_NOT_SUPPORTED;
+#else
     psa_status_t status;
+    struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_AEAD_UPDATE_AD_SID,
+        .op_handle = operation->handle,
+    };
 
-    status = PSA_ERROR_NOT_SUPPORTED;
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+        {.base = input, .len = input_length},
+    };
+    psa_outvec out_vec[] = {
+        {.base = &(operation->handle), .len = sizeof(uint32_t)},
+    };
+
+    status = API_DISPATCH(tfm_crypto_aead_update_ad,
+                          TFM_CRYPTO_AEAD_UPDATE_AD);
 
     return status;
+#endif /* TFM_CRYPTO_AEAD_MODULE_DISABLED */
 }
 
 psa_status_t psa_aead_finish(psa_aead_operation_t *operation,
@@ -1540,11 +1464,32 @@ psa_status_t psa_aead_finish(psa_aead_operation_t *operation,
                              size_t tag_size,
                              size_t *tag_length)
 {
+#ifdef TFM_CRYPTO_AEAD_MODULE_DISABLED
+    return PSA_ERROR_NOT_SUPPORTED;
+#else
     psa_status_t status;
+    struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_AEAD_FINISH_SID,
+        .op_handle = operation->handle,
+    };
 
-    status = PSA_ERROR_NOT_SUPPORTED;
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+    };
+    psa_outvec out_vec[] = {
+        {.base = &(operation->handle), .len = sizeof(uint32_t)},
+        {.base = ciphertext, .len = ciphertext_size},
+        {.base = tag, .len = tag_size},
+    };
+
+    status = API_DISPATCH(tfm_crypto_aead_finish,
+                          TFM_CRYPTO_AEAD_FINISH);
+
+    *ciphertext_length = out_vec[1].len;
+    *tag_length = out_vec[2].len;
 
     return status;
+#endif /* TFM_CRYPTO_AEAD_MODULE_DISABLED */
 }
 
 psa_status_t psa_aead_verify(psa_aead_operation_t *operation,
@@ -1554,18 +1499,226 @@ psa_status_t psa_aead_verify(psa_aead_operation_t *operation,
                              const uint8_t *tag,
                              size_t tag_length)
 {
+#ifdef TFM_CRYPTO_AEAD_MODULE_DISABLED
+    return PSA_ERROR_NOT_SUPPORTED;
+#else
     psa_status_t status;
+    struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_AEAD_VERIFY_SID,
+        .op_handle = operation->handle,
+    };
 
-    status = PSA_ERROR_NOT_SUPPORTED;
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+        {.base = tag, .len = tag_length},
+    };
+    psa_outvec out_vec[] = {
+        {.base = &(operation->handle), .len = sizeof(uint32_t)},
+        {.base = plaintext, .len = plaintext_size},
+    };
+
+    status = API_DISPATCH(tfm_crypto_aead_verify,
+                          TFM_CRYPTO_AEAD_VERIFY);
+
+    *plaintext_length = out_vec[1].len;
 
     return status;
+#endif /* TFM_CRYPTO_AEAD_MODULE_DISABLED */
 }
 
 psa_status_t psa_aead_abort(psa_aead_operation_t *operation)
 {
+#ifdef TFM_CRYPTO_AEAD_MODULE_DISABLED
+    return PSA_ERROR_NOT_SUPPORTED;
+#else
     psa_status_t status;
+    struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_AEAD_ABORT_SID,
+        .op_handle = operation->handle,
+    };
 
-    status = PSA_ERROR_NOT_SUPPORTED;
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+    };
+    psa_outvec out_vec[] = {
+        {.base = &(operation->handle), .len = sizeof(uint32_t)},
+    };
+
+    status = API_DISPATCH(tfm_crypto_aead_abort,
+                          TFM_CRYPTO_AEAD_ABORT);
+
+    return status;
+#endif /* TFM_CRYPTO_AEAD_MODULE_DISABLED */
+}
+
+psa_status_t psa_aead_encrypt_batch(psa_key_handle_t handle,
+                                    psa_algorithm_t alg,
+                                    struct tfm_crypto_aead_batch_entry *entries,
+                                    size_t entry_count,
+                                    const uint8_t *input,
+                                    size_t input_length,
+                                    uint8_t *output,
+                                    size_t output_size)
+{
+#ifdef TFM_CRYPTO_AEAD_MODULE_DISABLED
+    return PSA_ERROR_NOT_SUPPORTED;
+#else
+    psa_status_t status;
+    const struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_AEAD_ENCRYPT_BATCH_SID,
+        .key_handle = handle,
+        .alg = alg,
+    };
+    struct tfm_crypto_aead_batch_result
+                                results[TFM_CRYPTO_AEAD_BATCH_MAX_ENTRIES];
+    size_t idx;
+
+    if ((entries == NULL) || (entry_count == 0) ||
+        (entry_count > TFM_CRYPTO_AEAD_BATCH_MAX_ENTRIES)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+        {.base = entries,
+         .len = entry_count * sizeof(struct tfm_crypto_aead_batch_entry)},
+        {.base = input, .len = input_length},
+    };
+    psa_outvec out_vec[] = {
+        {.base = output, .len = output_size},
+        {.base = results,
+         .len = entry_count * sizeof(struct tfm_crypto_aead_batch_result)},
+    };
+
+    status = API_DISPATCH(tfm_crypto_aead_encrypt_batch,
+                          TFM_CRYPTO_AEAD_ENCRYPT_BATCH);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    for (idx = 0; idx < entry_count; idx++) {
+        entries[idx].status = results[idx].status;
+        entries[idx].output_length = results[idx].output_length;
+    }
+
+    return PSA_SUCCESS;
+#endif /* TFM_CRYPTO_AEAD_MODULE_DISABLED */
+}
+
+psa_status_t psa_aead_decrypt_batch(psa_key_handle_t handle,
+                                    psa_algorithm_t alg,
+                                    struct tfm_crypto_aead_batch_entry *entries,
+                                    size_t entry_count,
+                                    const uint8_t *input,
+                                    size_t input_length,
+                                    uint8_t *output,
+                                    size_t output_size)
+{
+#ifdef TFM_CRYPTO_AEAD_MODULE_DISABLED
+    return PSA_ERROR_NOT_SUPPORTED;
+#else
+    psa_status_t status;
+    const struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_AEAD_DECRYPT_BATCH_SID,
+        .key_handle = handle,
+        .alg = alg,
+    };
+    struct tfm_crypto_aead_batch_result
+                                results[TFM_CRYPTO_AEAD_BATCH_MAX_ENTRIES];
+    size_t idx;
+
+    if ((entries == NULL) || (entry_count == 0) ||
+        (entry_count > TFM_CRYPTO_AEAD_BATCH_MAX_ENTRIES)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+        {.base = entries,
+         .len = entry_count * sizeof(struct tfm_crypto_aead_batch_entry)},
+        {.base = input, .len = input_length},
+    };
+    psa_outvec out_vec[] = {
+        {.base = output, .len = output_size},
+        {.base = results,
+         .len = entry_count * sizeof(struct tfm_crypto_aead_batch_result)},
+    };
+
+    status = API_DISPATCH(tfm_crypto_aead_decrypt_batch,
+                          TFM_CRYPTO_AEAD_DECRYPT_BATCH);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    for (idx = 0; idx < entry_count; idx++) {
+        entries[idx].status = results[idx].status;
+        entries[idx].output_length = results[idx].output_length;
+    }
+
+    return PSA_SUCCESS;
+#endif /* TFM_CRYPTO_AEAD_MODULE_DISABLED */
+}
+
+psa_status_t psa_verify_hash_batch(
+                            const struct tfm_crypto_verify_batch_entry *entries,
+                            size_t entry_count,
+                            const uint8_t *input,
+                            size_t input_length,
+                            uint32_t *verified)
+{
+#ifdef TFM_CRYPTO_ASYMMETRIC_MODULE_DISABLED
+    return PSA_ERROR_NOT_SUPPORTED;
+#else
+    psa_status_t status;
+    const struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_VERIFY_HASH_BATCH_SID,
+    };
+
+    if ((entries == NULL) || (entry_count == 0) ||
+        (entry_count > TFM_CRYPTO_VERIFY_BATCH_MAX_ENTRIES) ||
+        (verified == NULL)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+        {.base = entries,
+         .len = entry_count * sizeof(struct tfm_crypto_verify_batch_entry)},
+        {.base = input, .len = input_length},
+    };
+    psa_outvec out_vec[] = {
+        {.base = verified, .len = sizeof(uint32_t)},
+    };
+
+    status = API_DISPATCH(tfm_crypto_verify_hash_batch,
+                          TFM_CRYPTO_VERIFY_HASH_BATCH);
+
+    return status;
+#endif /* TFM_CRYPTO_ASYMMETRIC_MODULE_DISABLED */
+}
+
+psa_status_t psa_crypto_get_engine_mem_stats(
+                                      struct tfm_crypto_engine_mem_stats *stats)
+{
+    psa_status_t status;
+    struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_GET_ENGINE_MEM_STATS_SID,
+    };
+
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+    };
+
+    psa_outvec out_vec[] = {
+        {.base = stats, .len = sizeof(struct tfm_crypto_engine_mem_stats)},
+    };
+
+    if (stats == NULL) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    status = API_DISPATCH(tfm_crypto_get_engine_mem_stats,
+                          TFM_CRYPTO_GET_ENGINE_MEM_STATS);
 
     return status;
 }
@@ -1656,15 +1809,11 @@ psa_status_t psa_raw_key_agreement(psa_algorithm_t alg,
         {.base = output, .len = output_size},
     };
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     status = API_DISPATCH(tfm_crypto_raw_key_agreement,
                           TFM_CRYPTO_RAW_KEY_AGREEMENT);
 
     *output_length = out_vec[0].len;
 
-    PSA_CLOSE();
-
     return status;
 #endif /* TFM_CRYPTO_GENERATOR_MODULE_DISABLED */
 }
@@ -1689,11 +1838,8 @@ psa_status_t psa_key_derivation_setup(psa_key_derivation_operation_t *operation,
         {.base = &(operation->handle), .len = sizeof(uint32_t)},
     };
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     status = API_DISPATCH(tfm_crypto_key_derivation_setup,
                           TFM_CRYPTO_KEY_DERIVATION_SETUP);
-    PSA_CLOSE();
 
     return status;
 #endif /* TFM_CRYPTO_GENERATOR_MODULE_DISABLED */
@@ -1717,11 +1863,8 @@ psa_status_t psa_key_derivation_set_capacity(
         {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
     };
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     status = API_DISPATCH_NO_OUTVEC(tfm_crypto_key_derivation_set_capacity,
                                     TFM_CRYPTO_KEY_DERIVATION_SET_CAPACITY);
-    PSA_CLOSE();
 
     return status;
 #endif /* TFM_CRYPTO_GENERATOR_MODULE_DISABLED */
@@ -1748,11 +1891,8 @@ psa_status_t psa_key_derivation_input_bytes(
         {.base = data, .len = data_length},
     };
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     status = API_DISPATCH_NO_OUTVEC(tfm_crypto_key_derivation_input_bytes,
                                     TFM_CRYPTO_KEY_DERIVATION_INPUT_BYTES);
-    PSA_CLOSE();
 
     return status;
 #endif /* TFM_CRYPTO_GENERATOR_MODULE_DISABLED */
@@ -1781,11 +1921,8 @@ psa_status_t psa_key_derivation_output_key(
         {.base = handle, .len = sizeof(psa_key_handle_t)}
     };
 
-    PSA_CONNECT(TFM_CRYPTO);
-
     status = API_DISPATCH(tfm_crypto_key_derivation_output_key,
                           TFM_CRYPTO_KEY_DERIVATION_OUTPUT_KEY);
-    PSA_CLOSE();
 
     return status;
 #endif /* TFM_CRYPTO_GENERATOR_MODULE_DISABLED */
@@ -1809,22 +1946,58 @@ psa_status_t psa_aead_encrypt_setup(psa_aead_operation_t *operation,
                                     psa_key_handle_t handle,
                                     psa_algorithm_t alg)
 {
+#ifdef TFM_CRYPTO_AEAD_MODULE_DISABLED
+    return PSA_ERROR_NOT_SUPPORTED;
+#else
     psa_status_t status;
+    struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_AEAD_ENCRYPT_SETUP_SID,
+        .key_handle = handle,
+        .alg = alg,
+        .op_handle = operation->handle,
+    };
 
-    status = PSA_ERROR_NOT_SUPPORTED;
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+    };
+    psa_outvec out_vec[] = {
+        {.base = &(operation->handle), .len = sizeof(uint32_t)},
+    };
+
+    status = API_DISPATCH(tfm_crypto_aead_encrypt_setup,
+                          TFM_CRYPTO_AEAD_ENCRYPT_SETUP);
 
     return status;
+#endif /* TFM_CRYPTO_AEAD_MODULE_DISABLED */
 }
 
 psa_status_t psa_aead_decrypt_setup(psa_aead_operation_t *operation,
                                     psa_key_handle_t handle,
                                     psa_algorithm_t alg)
 {
+#ifdef TFM_CRYPTO_AEAD_MODULE_DISABLED
+    return PSA_ERROR_NOT_SUPPORTED;
+#else
     psa_status_t status;
+    struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_AEAD_DECRYPT_SETUP_SID,
+        .key_handle = handle,
+        .alg = alg,
+        .op_handle = operation->handle,
+    };
 
-    status = PSA_ERROR_NOT_SUPPORTED;
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+    };
+    psa_outvec out_vec[] = {
+        {.base = &(operation->handle), .len = sizeof(uint32_t)},
+    };
+
+    status = API_DISPATCH(tfm_crypto_aead_decrypt_setup,
+                          TFM_CRYPTO_AEAD_DECRYPT_SETUP);
 
     return status;
+#endif /* TFM_CRYPTO_AEAD_MODULE_DISABLED */
 }
 
 psa_status_t psa_aead_generate_nonce(psa_aead_operation_t *operation,
@@ -1832,33 +2005,87 @@ psa_status_t psa_aead_generate_nonce(psa_aead_operation_t *operation,
                                      size_t nonce_size,
                                      size_t *nonce_length)
 {
+#ifdef TFM_CRYPTO_AEAD_MODULE_DISABLED
+    return PSA_ERROR_NOT_SUPPORTED;
+#else
     psa_status_t status;
+    struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_AEAD_GENERATE_NONCE_SID,
+        .op_handle = operation->handle,
+    };
 
-    status = PSA_ERROR_NOT_SUPPORTED;
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+    };
+    psa_outvec out_vec[] = {
+        {.base = &(operation->handle), .len = sizeof(uint32_t)},
+        {.base = nonce, .len = nonce_size},
+    };
+
+    status = API_DISPATCH(tfm_crypto_aead_generate_nonce,
+                          TFM_CRYPTO_AEAD_GENERATE_NONCE);
+
+    *nonce_length = out_vec[1].len;
 
     return status;
+#endif /* TFM_CRYPTO_AEAD_MODULE_DISABLED */
 }
 
 psa_status_t psa_aead_set_nonce(psa_aead_operation_t *operation,
                                 const uint8_t *nonce,
                                 size_t nonce_length)
 {
+#ifdef TFM_CRYPTO_AEAD_MODULE_DISABLED
+    return PSA_ERROR_NOT_SUPPORTED;
+#else
     psa_status_t status;
+    struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_AEAD_SET_NONCE_SID,
+        .op_handle = operation->handle,
+    };
 
-    status = PSA_ERROR_NOT_SUPPORTED;
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+        {.base = nonce, .len = nonce_length},
+    };
+    psa_outvec out_vec[] = {
+        {.base = &(operation->handle), .len = sizeof(uint32_t)},
+    };
+
+    status = API_DISPATCH(tfm_crypto_aead_set_nonce,
+                          TFM_CRYPTO_AEAD_SET_NONCE);
 
     return status;
+#endif /* TFM_CRYPTO_AEAD_MODULE_DISABLED */
 }
 
 psa_status_t psa_aead_set_lengths(psa_aead_operation_t *operation,
                                   size_t ad_length,
                                   size_t plaintext_length)
 {
+#ifdef TFM_CRYPTO_AEAD_MODULE_DISABLED
+    return PSA_ERROR_NOT_SUPPORTED;
+#else
     psa_status_t status;
+    struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_AEAD_SET_LENGTHS_SID,
+        .op_handle = operation->handle,
+    };
+    size_t lengths[2] = {ad_length, plaintext_length};
 
-    status = PSA_ERROR_NOT_SUPPORTED;
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+        {.base = lengths, .len = sizeof(lengths)},
+    };
+    psa_outvec out_vec[] = {
+        {.base = &(operation->handle), .len = sizeof(uint32_t)},
+    };
+
+    status = API_DISPATCH(tfm_crypto_aead_set_lengths,
+                          TFM_CRYPTO_AEAD_SET_LENGTHS);
 
     return status;
+#endif /* TFM_CRYPTO_AEAD_MODULE_DISABLED */
 }
 
 psa_status_t psa_aead_update(psa_aead_operation_t *operation,
@@ -1868,9 +2095,29 @@ psa_status_t psa_aead_update(psa_aead_operation_t *operation,
                              size_t output_size,
                              size_t *output_length)
 {
+#ifdef TFM_CRYPTO_AEAD_MODULE_DISABLED
+    return PSA_ERROR_NOT_SUPPORTED;
+#else
     psa_status_t status;
+    struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_AEAD_UPDATE_SID,
+        .op_handle = operation->handle,
+    };
 
-    status = PSA_ERROR_NOT_SUPPORTED;
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+        {.base = input, .len = input_length},
+    };
+    psa_outvec out_vec[] = {
+        {.base = &(operation->handle), .len = sizeof(uint32_t)},
+        {.base = output, .len = output_size},
+    };
+
+    status = API_DISPATCH(tfm_crypto_aead_update,
+                          TFM_CRYPTO_AEAD_UPDATE);
+
+    *output_length = out_vec[1].len;
 
     return status;
+#endif /* TFM_CRYPTO_AEAD_MODULE_DISABLED */
 }
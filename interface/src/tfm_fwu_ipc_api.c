@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include "tfm_fwu_api.h"
+#include "tfm_ns_interface.h"
+#include "psa/client.h"
+#include "psa_manifest/sid.h"
+
+#define IOVEC_LEN(x) (sizeof(x)/sizeof(x[0]))
+
+psa_status_t tfm_fwu_write(uint32_t image_id, size_t offset,
+                           const void *block, size_t block_size)
+{
+    uint32_t off = (uint32_t)offset;
+    psa_invec in_vec[] = {
+        {&image_id, sizeof(image_id)},
+        {&off, sizeof(off)},
+        {block, block_size}
+    };
+
+    if ((size_t)off != offset) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    return psa_call(TFM_FWU_WRITE_HANDLE, PSA_IPC_CALL,
+                    in_vec, IOVEC_LEN(in_vec), NULL, 0);
+}
+
+psa_status_t tfm_fwu_install(uint32_t image_id, bool permanent)
+{
+    uint32_t perm = permanent ? 1U : 0U;
+    psa_invec in_vec[] = {
+        {&image_id, sizeof(image_id)},
+        {&perm, sizeof(perm)}
+    };
+
+    return psa_call(TFM_FWU_INSTALL_HANDLE, PSA_IPC_CALL,
+                    in_vec, IOVEC_LEN(in_vec), NULL, 0);
+}
+
+psa_status_t tfm_fwu_abort(uint32_t image_id)
+{
+    psa_invec in_vec[] = {
+        {&image_id, sizeof(image_id)}
+    };
+
+    return psa_call(TFM_FWU_ABORT_HANDLE, PSA_IPC_CALL,
+                    in_vec, IOVEC_LEN(in_vec), NULL, 0);
+}
+
+psa_status_t tfm_fwu_query(uint32_t image_id, struct tfm_fwu_info_t *info)
+{
+    psa_invec in_vec[] = {
+        {&image_id, sizeof(image_id)}
+    };
+    psa_outvec out_vec[] = {
+        {info, sizeof(*info)}
+    };
+
+    return psa_call(TFM_FWU_QUERY_HANDLE, PSA_IPC_CALL,
+                    in_vec, IOVEC_LEN(in_vec),
+                    out_vec, IOVEC_LEN(out_vec));
+}
@@ -80,3 +80,55 @@ tfm_initial_attest_get_public_key(uint8_t         *public_key,
 
     return (psa_status_t) res;
 }
+
+psa_status_t
+tfm_initial_attest_get_batch_token(const uint8_t *auth_challenges,
+                                   size_t         challenge_size,
+                                   size_t         num_challenges,
+                                   uint8_t       *token_buf,
+                                   size_t         token_buf_size,
+                                   size_t        *token_size)
+{
+    int32_t res;
+
+    if (num_challenges == 0 ||
+        num_challenges > TFM_INITIAL_ATTEST_BATCH_MAX_CHALLENGES) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    psa_invec in_vec[] = {
+        {auth_challenges, challenge_size * num_challenges},
+        {&challenge_size, sizeof(challenge_size)}
+    };
+    psa_outvec out_vec[] = {
+        {token_buf, token_buf_size}
+    };
+
+    res = tfm_ns_interface_dispatch(
+                          (veneer_fn)tfm_initial_attest_get_batch_token_veneer,
+                          (uint32_t)in_vec,  IOVEC_LEN(in_vec),
+                          (uint32_t)out_vec, IOVEC_LEN(out_vec));
+
+    if (res == (int32_t)PSA_SUCCESS) {
+        *token_size = out_vec[0].len;
+    }
+
+    return res;
+}
+
+psa_status_t
+tfm_initial_attest_get_profile(struct tfm_initial_attest_profile_t *profile,
+                               uint32_t reset)
+{
+    psa_invec in_vec[] = {
+        {&reset, sizeof(reset)}
+    };
+    psa_outvec out_vec[] = {
+        {profile, sizeof(*profile)}
+    };
+
+    return tfm_ns_interface_dispatch(
+                              (veneer_fn)tfm_initial_attest_get_profile_veneer,
+                              (uint32_t)in_vec,  IOVEC_LEN(in_vec),
+                              (uint32_t)out_vec, IOVEC_LEN(out_vec));
+}
@@ -21,7 +21,6 @@ psa_initial_attest_get_token(const uint8_t *auth_challenge,
                              size_t         token_buf_size,
                              size_t        *token_size)
 {
-    psa_handle_t handle = PSA_NULL_HANDLE;
     psa_status_t status;
 
     psa_invec in_vec[] = {
@@ -31,16 +30,9 @@ psa_initial_attest_get_token(const uint8_t *auth_challenge,
         {token_buf, token_buf_size}
     };
 
-    handle = psa_connect(TFM_ATTEST_GET_TOKEN_SID,
-                         TFM_ATTEST_GET_TOKEN_VERSION);
-    if (!PSA_HANDLE_IS_VALID(handle)) {
-        return PSA_HANDLE_TO_ERROR(handle);
-    }
-
-    status = psa_call(handle, PSA_IPC_CALL,
+    status = psa_call(TFM_ATTEST_GET_TOKEN_HANDLE, PSA_IPC_CALL,
                       in_vec, IOVEC_LEN(in_vec),
                       out_vec, IOVEC_LEN(out_vec));
-    psa_close(handle);
 
     if (status == PSA_SUCCESS) {
         *token_size = out_vec[0].len;
@@ -53,7 +45,6 @@ psa_status_t
 psa_initial_attest_get_token_size(size_t  challenge_size,
                                   size_t *token_size)
 {
-    psa_handle_t handle = PSA_NULL_HANDLE;
     psa_status_t status;
     psa_invec in_vec[] = {
         {&challenge_size, sizeof(challenge_size)}
@@ -62,16 +53,9 @@ psa_initial_attest_get_token_size(size_t  challenge_size,
         {token_size, sizeof(size_t)}
     };
 
-    handle = psa_connect(TFM_ATTEST_GET_TOKEN_SIZE_SID,
-                         TFM_ATTEST_GET_TOKEN_SIZE_VERSION);
-    if (!PSA_HANDLE_IS_VALID(handle)) {
-        return PSA_HANDLE_TO_ERROR(handle);
-    }
-
-    status = psa_call(handle, PSA_IPC_CALL,
+    status = psa_call(TFM_ATTEST_GET_TOKEN_SIZE_HANDLE, PSA_IPC_CALL,
                       in_vec, IOVEC_LEN(in_vec),
                       out_vec, IOVEC_LEN(out_vec));
-    psa_close(handle);
 
     return status;
 }
@@ -82,7 +66,6 @@ tfm_initial_attest_get_public_key(uint8_t         *public_key,
                                   size_t          *public_key_len,
                                   psa_ecc_curve_t *elliptic_curve_type)
 {
-    psa_handle_t handle = PSA_NULL_HANDLE;
     psa_status_t status;
 
     psa_outvec out_vec[] = {
@@ -91,16 +74,63 @@ tfm_initial_attest_get_public_key(uint8_t         *public_key,
         {.base = public_key_len,      .len = sizeof(*public_key_len)}
     };
 
-    handle = psa_connect(TFM_ATTEST_GET_PUBLIC_KEY_SID,
-                         TFM_ATTEST_GET_PUBLIC_KEY_VERSION);
-    if (!PSA_HANDLE_IS_VALID(handle)) {
-        return PSA_HANDLE_TO_ERROR(handle);
+    status = psa_call(TFM_ATTEST_GET_PUBLIC_KEY_HANDLE, PSA_IPC_CALL,
+                      NULL, 0,
+                      out_vec, IOVEC_LEN(out_vec));
+
+    return status;
+}
+
+psa_status_t
+tfm_initial_attest_get_batch_token(const uint8_t *auth_challenges,
+                                   size_t         challenge_size,
+                                   size_t         num_challenges,
+                                   uint8_t       *token_buf,
+                                   size_t         token_buf_size,
+                                   size_t        *token_size)
+{
+    psa_status_t status;
+
+    if (num_challenges == 0 ||
+        num_challenges > TFM_INITIAL_ATTEST_BATCH_MAX_CHALLENGES) {
+        return PSA_ERROR_INVALID_ARGUMENT;
     }
 
-    status = psa_call(handle, PSA_IPC_CALL,
-                      NULL, 0,
+    psa_invec in_vec[] = {
+        {auth_challenges, challenge_size * num_challenges},
+        {&challenge_size, sizeof(challenge_size)}
+    };
+    psa_outvec out_vec[] = {
+        {token_buf, token_buf_size}
+    };
+
+    status = psa_call(TFM_ATTEST_GET_BATCH_TOKEN_HANDLE, PSA_IPC_CALL,
+                      in_vec, IOVEC_LEN(in_vec),
+                      out_vec, IOVEC_LEN(out_vec));
+
+    if (status == PSA_SUCCESS) {
+        *token_size = out_vec[0].len;
+    }
+
+    return status;
+}
+
+psa_status_t
+tfm_initial_attest_get_profile(struct tfm_initial_attest_profile_t *profile,
+                               uint32_t reset)
+{
+    psa_status_t status;
+
+    psa_invec in_vec[] = {
+        {&reset, sizeof(reset)}
+    };
+    psa_outvec out_vec[] = {
+        {profile, sizeof(*profile)}
+    };
+
+    status = psa_call(TFM_ATTEST_GET_PROFILE_HANDLE, PSA_IPC_CALL,
+                      in_vec, IOVEC_LEN(in_vec),
                       out_vec, IOVEC_LEN(out_vec));
-    psa_close(handle);
 
     return status;
 }
@@ -106,3 +106,43 @@ psa_status_t psa_its_remove(psa_storage_uid_t uid)
                                      (uint32_t)in_vec, IOVEC_LEN(in_vec),
                                      (uint32_t)NULL, 0);
 }
+
+psa_status_t psa_its_list(uint32_t *cursor,
+                          psa_storage_uid_t *uids,
+                          size_t max_uids,
+                          size_t *uid_count)
+{
+    psa_status_t status;
+
+    psa_invec in_vec[] = {
+        { .base = cursor, .len = sizeof(*cursor) }
+    };
+
+    psa_outvec out_vec[] = {
+        { .base = uids, .len = max_uids * sizeof(psa_storage_uid_t) },
+        { .base = cursor, .len = sizeof(*cursor) }
+    };
+
+    if ((cursor == NULL) || (uid_count == NULL)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    status = tfm_ns_interface_dispatch((veneer_fn)tfm_tfm_its_list_req_veneer,
+                                       (uint32_t)in_vec, IOVEC_LEN(in_vec),
+                                       (uint32_t)out_vec, IOVEC_LEN(out_vec));
+
+    if (status == (psa_status_t)TFM_ERROR_INVALID_PARAMETER) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    *uid_count = out_vec[0].len / sizeof(psa_storage_uid_t);
+
+    return status;
+}
+
+psa_status_t psa_its_sync(void)
+{
+    return tfm_ns_interface_dispatch((veneer_fn)tfm_tfm_its_sync_req_veneer,
+                                     (uint32_t)NULL, 0,
+                                     (uint32_t)NULL, 0);
+}
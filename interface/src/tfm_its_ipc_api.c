@@ -19,7 +19,6 @@ psa_status_t psa_its_set(psa_storage_uid_t uid,
                          psa_storage_create_flags_t create_flags)
 {
     psa_status_t status;
-    psa_handle_t handle;
 
     psa_invec in_vec[] = {
         { .base = &uid, .len = sizeof(uid) },
@@ -27,14 +26,8 @@ psa_status_t psa_its_set(psa_storage_uid_t uid,
         { .base = &create_flags, .len = sizeof(create_flags) }
     };
 
-    handle = psa_connect(TFM_ITS_SET_SID, TFM_ITS_SET_VERSION);
-    if (!PSA_HANDLE_IS_VALID(handle)) {
-        return PSA_ERROR_GENERIC_ERROR;
-    }
-
-    status = psa_call(handle, PSA_IPC_CALL, in_vec, IOVEC_LEN(in_vec), NULL, 0);
-
-    psa_close(handle);
+    status = psa_call(TFM_ITS_SET_HANDLE, PSA_IPC_CALL,
+                      in_vec, IOVEC_LEN(in_vec), NULL, 0);
 
     if (status == (psa_status_t)TFM_ERROR_INVALID_PARAMETER) {
         return PSA_ERROR_INVALID_ARGUMENT;
@@ -50,7 +43,6 @@ psa_status_t psa_its_get(psa_storage_uid_t uid,
                          size_t *p_data_length)
 {
     psa_status_t status;
-    psa_handle_t handle;
 
     psa_invec in_vec[] = {
         { .base = &uid, .len = sizeof(uid) },
@@ -65,15 +57,8 @@ psa_status_t psa_its_get(psa_storage_uid_t uid,
         return PSA_ERROR_INVALID_ARGUMENT;
     }
 
-    handle = psa_connect(TFM_ITS_GET_SID, TFM_ITS_GET_VERSION);
-    if (!PSA_HANDLE_IS_VALID(handle)) {
-        return PSA_ERROR_GENERIC_ERROR;
-    }
-
-    status = psa_call(handle, PSA_IPC_CALL, in_vec, IOVEC_LEN(in_vec), out_vec,
-                      IOVEC_LEN(out_vec));
-
-    psa_close(handle);
+    status = psa_call(TFM_ITS_GET_HANDLE, PSA_IPC_CALL,
+                      in_vec, IOVEC_LEN(in_vec), out_vec, IOVEC_LEN(out_vec));
 
     if (status == (psa_status_t)TFM_ERROR_INVALID_PARAMETER) {
         return PSA_ERROR_INVALID_ARGUMENT;
@@ -88,7 +73,6 @@ psa_status_t psa_its_get_info(psa_storage_uid_t uid,
                               struct psa_storage_info_t *p_info)
 {
     psa_status_t status;
-    psa_handle_t handle;
 
     psa_invec in_vec[] = {
         { .base = &uid, .len = sizeof(uid) }
@@ -98,15 +82,8 @@ psa_status_t psa_its_get_info(psa_storage_uid_t uid,
         { .base = p_info, .len = sizeof(*p_info) }
     };
 
-    handle = psa_connect(TFM_ITS_GET_INFO_SID, TFM_ITS_GET_INFO_VERSION);
-    if (!PSA_HANDLE_IS_VALID(handle)) {
-        return PSA_ERROR_GENERIC_ERROR;
-    }
-
-    status = psa_call(handle, PSA_IPC_CALL, in_vec, IOVEC_LEN(in_vec), out_vec,
-                      IOVEC_LEN(out_vec));
-
-    psa_close(handle);
+    status = psa_call(TFM_ITS_GET_INFO_HANDLE, PSA_IPC_CALL,
+                      in_vec, IOVEC_LEN(in_vec), out_vec, IOVEC_LEN(out_vec));
 
     if (status == (psa_status_t)TFM_ERROR_INVALID_PARAMETER) {
         return PSA_ERROR_INVALID_ARGUMENT;
@@ -118,20 +95,55 @@ psa_status_t psa_its_get_info(psa_storage_uid_t uid,
 psa_status_t psa_its_remove(psa_storage_uid_t uid)
 {
     psa_status_t status;
-    psa_handle_t handle;
 
     psa_invec in_vec[] = {
         { .base = &uid, .len = sizeof(uid) }
     };
 
-    handle = psa_connect(TFM_ITS_REMOVE_SID, TFM_ITS_REMOVE_VERSION);
-    if (!PSA_HANDLE_IS_VALID(handle)) {
-        return PSA_ERROR_GENERIC_ERROR;
+    status = psa_call(TFM_ITS_REMOVE_HANDLE, PSA_IPC_CALL,
+                      in_vec, IOVEC_LEN(in_vec), NULL, 0);
+
+    return status;
+}
+
+psa_status_t psa_its_list(uint32_t *cursor,
+                          psa_storage_uid_t *uids,
+                          size_t max_uids,
+                          size_t *uid_count)
+{
+    psa_status_t status;
+
+    psa_invec in_vec[] = {
+        { .base = cursor, .len = sizeof(*cursor) }
+    };
+
+    psa_outvec out_vec[] = {
+        { .base = uids, .len = max_uids * sizeof(psa_storage_uid_t) },
+        { .base = cursor, .len = sizeof(*cursor) }
+    };
+
+    if ((cursor == NULL) || (uid_count == NULL)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
     }
 
-    status = psa_call(handle, PSA_IPC_CALL, in_vec, IOVEC_LEN(in_vec), NULL, 0);
+    status = psa_call(TFM_ITS_LIST_HANDLE, PSA_IPC_CALL,
+                      in_vec, IOVEC_LEN(in_vec), out_vec, IOVEC_LEN(out_vec));
+
+    if (status == (psa_status_t)TFM_ERROR_INVALID_PARAMETER) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    *uid_count = out_vec[0].len / sizeof(psa_storage_uid_t);
+
+    return status;
+}
+
+psa_status_t psa_its_sync(void)
+{
+    psa_status_t status;
 
-    psa_close(handle);
+    status = psa_call(TFM_ITS_SYNC_HANDLE, PSA_IPC_CALL,
+                      NULL, 0, NULL, 0);
 
     return status;
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -10,6 +10,9 @@
 #include "tfm_api.h"
 #include "tfm_mailbox.h"
 #include "tfm_multi_core_api.h"
+#ifdef TFM_MAILBOX_STATS
+#include "tfm_ns_mailbox.h"
+#endif
 
 #define MAX_SEMAPHORE_COUNT            NUM_MAILBOX_QUEUE_SLOT
 
@@ -35,6 +38,15 @@ int32_t tfm_ns_wait_for_s_cpu_ready(void)
 
 uint32_t tfm_ns_multi_core_lock_acquire(void)
 {
+#ifdef TFM_MAILBOX_STATS
+    /* Count the requests which find every mailbox queue slot in use */
+    if (os_wrapper_semaphore_acquire(ns_lock_handle, 0) ==
+        OS_WRAPPER_SUCCESS) {
+        return OS_WRAPPER_SUCCESS;
+    }
+    tfm_ns_mailbox_stats_queue_wait();
+#endif
+
     return os_wrapper_semaphore_acquire(ns_lock_handle,
                                         OS_WRAPPER_WAIT_FOREVER);
 }
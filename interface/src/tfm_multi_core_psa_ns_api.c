@@ -7,6 +7,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include "os_wrapper/mutex.h"
 
@@ -199,6 +200,100 @@ psa_status_t psa_call(psa_handle_t handle, int32_t type,
     return status;
 }
 
+#ifdef TFM_MAILBOX_SG
+psa_status_t psa_call_sg(psa_handle_t handle, int32_t type,
+                         const psa_invec *in_segs, const size_t *in_nr_segs,
+                         size_t in_len,
+                         const psa_outvec *out_segs,
+                         const size_t *out_nr_segs, size_t out_len,
+                         size_t *out_written)
+{
+    struct psa_client_params_t params;
+    struct mailbox_sg_table_t sg_table;
+    mailbox_msg_handle_t msg_handle;
+    size_t nr_in = 0, nr_out = 0;
+    size_t i;
+    int32_t ret;
+    psa_status_t status;
+
+    if ((in_len > PSA_MAX_IOVEC) || (out_len > PSA_MAX_IOVEC - in_len)) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    for (i = 0; i < in_len; i++) {
+        if (in_nr_segs[i] > MAILBOX_SG_MAX_SEGS - nr_in) {
+            return PSA_ERROR_PROGRAMMER_ERROR;
+        }
+        sg_table.in_nr_segs[i] = in_nr_segs[i];
+        nr_in += in_nr_segs[i];
+    }
+
+    for (i = 0; i < out_len; i++) {
+        if (out_nr_segs[i] > MAILBOX_SG_MAX_SEGS - nr_out) {
+            return PSA_ERROR_PROGRAMMER_ERROR;
+        }
+        sg_table.out_nr_segs[i] = out_nr_segs[i];
+        nr_out += out_nr_segs[i];
+    }
+
+    /* Only the used part of the table is filled, SPE copies it whole */
+    sg_table.in_len = in_len;
+    sg_table.out_len = out_len;
+    memcpy(sg_table.in_segs, in_segs, nr_in * sizeof(psa_invec));
+    memcpy(sg_table.out_segs, out_segs, nr_out * sizeof(psa_outvec));
+
+    params.psa_call_sg_params.handle = handle;
+    params.psa_call_sg_params.type = type;
+    params.psa_call_sg_params.sg_table = &sg_table;
+    params.psa_call_sg_params.out_written = out_written;
+
+    if (tfm_ns_multi_core_lock_acquire() != OS_WRAPPER_SUCCESS) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    msg_handle = tfm_ns_mailbox_tx_client_req(MAILBOX_PSA_CALL_SG, &params,
+                                              NON_SECURE_CLIENT_ID);
+    if (msg_handle < 0) {
+        tfm_ns_multi_core_lock_release();
+        return PSA_INTER_CORE_COMM_ERR;
+    }
+
+    mailbox_wait_reply(msg_handle);
+
+    ret = tfm_ns_mailbox_rx_client_reply(msg_handle, (int32_t *)&status);
+    if (ret != MAILBOX_SUCCESS) {
+        status = PSA_INTER_CORE_COMM_ERR;
+    }
+
+    if (tfm_ns_multi_core_lock_release() != OS_WRAPPER_SUCCESS) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    return status;
+}
+#endif
+
+/*
+ * The mailbox carries a single request per message, so the requests of the
+ * batch are sent one after the other.
+ */
+psa_status_t psa_call_batch(psa_handle_t handle, psa_batch_call_t *calls,
+                            size_t num_calls)
+{
+    size_t i;
+
+    for (i = 0; i < num_calls; i++) {
+        calls[i].status = psa_call(handle, calls[i].type,
+                                   calls[i].in_vec, calls[i].in_len,
+                                   calls[i].out_vec, calls[i].out_len);
+        if (calls[i].status == PSA_ERROR_PROGRAMMER_ERROR) {
+            return PSA_ERROR_PROGRAMMER_ERROR;
+        }
+    }
+
+    return PSA_SUCCESS;
+}
+
 void psa_close(psa_handle_t handle)
 {
     struct psa_client_params_t params;
@@ -224,3 +319,57 @@ void psa_close(psa_handle_t handle)
 
     tfm_ns_multi_core_lock_release();
 }
+
+#ifdef TFM_MAILBOX_NS_WINDOWS
+static int32_t mailbox_ns_window_req(uint32_t call_type,
+                                     const struct psa_client_params_t *params)
+{
+    mailbox_msg_handle_t msg_handle;
+    int32_t reply;
+
+    if (tfm_ns_multi_core_lock_acquire() != OS_WRAPPER_SUCCESS) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    msg_handle = tfm_ns_mailbox_tx_client_req(call_type, params,
+                                              NON_SECURE_CLIENT_ID);
+    if (msg_handle < 0) {
+        tfm_ns_multi_core_lock_release();
+        return PSA_INTER_CORE_COMM_ERR;
+    }
+
+    mailbox_wait_reply(msg_handle);
+
+    if (tfm_ns_mailbox_rx_client_reply(msg_handle, &reply) !=
+        MAILBOX_SUCCESS) {
+        reply = PSA_INTER_CORE_COMM_ERR;
+    }
+
+    if (tfm_ns_multi_core_lock_release() != OS_WRAPPER_SUCCESS) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    return reply;
+}
+
+int32_t tfm_ns_mailbox_window_register(const void *base, size_t len,
+                                       uint32_t access)
+{
+    struct psa_client_params_t params;
+
+    params.ns_window_register_params.base = base;
+    params.ns_window_register_params.len = len;
+    params.ns_window_register_params.access = access;
+
+    return mailbox_ns_window_req(MAILBOX_NS_WINDOW_REGISTER, &params);
+}
+
+int32_t tfm_ns_mailbox_window_unregister(int32_t window_id)
+{
+    struct psa_client_params_t params;
+
+    params.ns_window_unregister_params.window_id = window_id;
+
+    return mailbox_ns_window_req(MAILBOX_NS_WINDOW_UNREGISTER, &params);
+}
+#endif
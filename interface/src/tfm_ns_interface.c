@@ -8,21 +8,43 @@
 #include <stdbool.h>
 
 #include "os_wrapper/mutex.h"
+#ifdef TFM_NS_CONCURRENT_CALLS
+#include "os_wrapper/thread.h"
+#include "tfm_nspm_api.h"
+#endif
 
 #include "tfm_api.h"
 #include "tfm_ns_interface.h"
+#ifdef PSA_API_TEST_TIMING
+#include "psa_api_test.h"
+#endif
 
 /**
  * \brief the ns_lock ID
  */
 static void *ns_lock_handle = NULL;
 
+#ifdef TFM_NS_CONCURRENT_CALLS
+/**
+ * \brief Threads waiting for an asynchronous call, NULL for a free waiter
+ */
+static void *ns_waiters[TFM_NS_CONCURRENT_CALLS_MAX];
+
+/**
+ * \brief Set once TF-M notifies the completion of asynchronous calls
+ */
+static bool ns_concurrent_calls_enabled = false;
+#endif
+
 __attribute__((weak))
 int32_t tfm_ns_interface_dispatch(veneer_fn fn,
                                   uint32_t arg0, uint32_t arg1,
                                   uint32_t arg2, uint32_t arg3)
 {
     int32_t result;
+#ifdef PSA_API_TEST_TIMING
+    uint32_t start;
+#endif
 
     /* TFM request protected by NS lock */
     if (os_wrapper_mutex_acquire(ns_lock_handle, OS_WRAPPER_WAIT_FOREVER)
@@ -30,8 +52,16 @@ int32_t tfm_ns_interface_dispatch(veneer_fn fn,
         return (int32_t)TFM_ERROR_GENERIC;
     }
 
+#ifdef PSA_API_TEST_TIMING
+    start = psa_api_test_timing_start();
+#endif
+
     result = fn(arg0, arg1, arg2, arg3);
 
+#ifdef PSA_API_TEST_TIMING
+    psa_api_test_timing_record(fn, arg0, arg1, arg2, result, start);
+#endif
+
     if (os_wrapper_mutex_release(ns_lock_handle) != OS_WRAPPER_SUCCESS) {
         return (int32_t)TFM_ERROR_GENERIC;
     }
@@ -52,3 +82,77 @@ enum tfm_status_e tfm_ns_interface_init(void)
     ns_lock_handle = handle;
     return TFM_SUCCESS;
 }
+
+#ifdef TFM_NS_CONCURRENT_CALLS
+__attribute__((weak))
+enum tfm_status_e tfm_ns_interface_enable_concurrent_calls(int32_t irq_line)
+{
+    if (!tfm_nspm_register_async_call_irq(irq_line)) {
+        return TFM_ERROR_GENERIC;
+    }
+
+    ns_concurrent_calls_enabled = true;
+    return TFM_SUCCESS;
+}
+
+__attribute__((weak))
+int32_t tfm_ns_interface_waiter_get(void)
+{
+    int32_t i, idx = -1;
+
+    if (!ns_concurrent_calls_enabled) {
+        return -1;
+    }
+
+    if (os_wrapper_mutex_acquire(ns_lock_handle, OS_WRAPPER_WAIT_FOREVER)
+            != OS_WRAPPER_SUCCESS) {
+        return -1;
+    }
+
+    for (i = 0; i < TFM_NS_CONCURRENT_CALLS_MAX; i++) {
+        if (ns_waiters[i] == NULL) {
+            ns_waiters[i] = os_wrapper_thread_get_handle();
+            idx = i;
+            break;
+        }
+    }
+
+    (void)os_wrapper_mutex_release(ns_lock_handle);
+
+    return idx;
+}
+
+__attribute__((weak))
+void tfm_ns_interface_waiter_wait(void)
+{
+    (void)os_wrapper_thread_wait_flag(TFM_NS_CALL_DONE_FLAG,
+                                      OS_WRAPPER_WAIT_FOREVER);
+}
+
+__attribute__((weak))
+void tfm_ns_interface_waiter_put(int32_t idx)
+{
+    if ((idx >= 0) && (idx < TFM_NS_CONCURRENT_CALLS_MAX)) {
+        ns_waiters[idx] = NULL;
+    }
+}
+
+__attribute__((weak))
+void tfm_ns_interface_async_call_irq_handler(void)
+{
+    int32_t i;
+    void *thread;
+
+    /*
+     * The interrupt does not tell which call completed. Every waiter checks
+     * its own call, the others go back to wait.
+     */
+    for (i = 0; i < TFM_NS_CONCURRENT_CALLS_MAX; i++) {
+        thread = ns_waiters[i];
+        if (thread != NULL) {
+            (void)os_wrapper_thread_set_flag_isr(thread,
+                                                 TFM_NS_CALL_DONE_FLAG);
+        }
+    }
+}
+#endif
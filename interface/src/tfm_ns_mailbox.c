@@ -8,10 +8,69 @@
 #include <string.h>
 #include "tfm_ns_mailbox.h"
 #include "tfm_plat_ns.h"
+#ifdef TFM_MAILBOX_RING
+#include "tfm_mailbox_ring.h"
+#endif
+#include "cmsis_compiler.h"
+
+#ifdef TFM_MAILBOX_RING
+/*
+ * Only the rings are shared with SPE. The status bitmasks are private to NSPE,
+ * they are only protected from the other NS threads. The mailbox interrupt
+ * cannot preempt a thread in a local critical section.
+ */
+#define mailbox_enter_critical()     tfm_ns_mailbox_hal_enter_local_critical()
+#define mailbox_exit_critical()      tfm_ns_mailbox_hal_exit_local_critical()
+#define mailbox_enter_critical_isr() do {} while (0)
+#define mailbox_exit_critical_isr()  do {} while (0)
+#else
+#define mailbox_enter_critical()     tfm_ns_mailbox_hal_enter_critical()
+#define mailbox_exit_critical()      tfm_ns_mailbox_hal_exit_critical()
+#define mailbox_enter_critical_isr() tfm_ns_mailbox_hal_enter_critical_isr()
+#define mailbox_exit_critical_isr()  tfm_ns_mailbox_hal_exit_critical_isr()
+#endif
 
 /* The pointer to NSPE mailbox queue */
 static struct ns_mailbox_queue_t *mailbox_queue_ptr = NULL;
 
+#ifdef TFM_MAILBOX_STATS
+static struct ns_mailbox_stats_t mailbox_stats;
+#endif
+
+#ifdef TFM_MAILBOX_COALESCE
+/*
+ * A doorbell makes SPE handle every pending request. More requests than slots
+ * can never be held back.
+ */
+#if (MAILBOX_DOORBELL_BATCH > NUM_MAILBOX_QUEUE_SLOT)
+#define MAILBOX_DOORBELL_THRESHOLD          NUM_MAILBOX_QUEUE_SLOT
+#else
+#define MAILBOX_DOORBELL_THRESHOLD          MAILBOX_DOORBELL_BATCH
+#endif
+
+/* The number of requests submitted since the last doorbell */
+static uint32_t nr_deferred_reqs = 0;
+static struct ns_mailbox_doorbell_stats_t doorbell_stats;
+#endif
+
+#ifdef TFM_MAILBOX_CACHE_MAINT
+void mailbox_cache_clean(const volatile void *addr, size_t size)
+{
+    uintptr_t start = MAILBOX_CACHE_LINE_DOWN(addr);
+
+    tfm_ns_mailbox_hal_cache_clean((void *)start,
+                        MAILBOX_CACHE_LINE_UP((uintptr_t)addr + size) - start);
+}
+
+void mailbox_cache_invalidate(const volatile void *addr, size_t size)
+{
+    uintptr_t start = MAILBOX_CACHE_LINE_DOWN(addr);
+
+    tfm_ns_mailbox_hal_cache_invalidate((void *)start,
+                        MAILBOX_CACHE_LINE_UP((uintptr_t)addr + size) - start);
+}
+#endif
+
 static inline void clear_queue_slot_empty(uint8_t idx)
 {
     if (idx < NUM_MAILBOX_QUEUE_SLOT) {
@@ -29,7 +88,19 @@ static inline void set_queue_slot_empty(uint8_t idx)
 static inline void set_queue_slot_pend(uint8_t idx)
 {
     if (idx < NUM_MAILBOX_QUEUE_SLOT) {
+#ifdef TFM_MAILBOX_RING
+        /*
+         * The ring cannot be full, it has room for every slot. The NS threads
+         * are the producer, serialized by the critical section.
+         */
+        (void)mailbox_ring_push(&mailbox_queue_ptr->req_ring, idx);
+#else
+        mailbox_cache_invalidate(&mailbox_queue_ptr->pend_slots,
+                                 sizeof(mailbox_queue_ptr->pend_slots));
         mailbox_queue_ptr->pend_slots |= (1 << idx);
+        mailbox_cache_clean(&mailbox_queue_ptr->pend_slots,
+                            sizeof(mailbox_queue_ptr->pend_slots));
+#endif
     }
 }
 
@@ -57,10 +128,36 @@ static inline int32_t get_mailbox_msg_idx(mailbox_msg_handle_t handle,
     return MAILBOX_SUCCESS;
 }
 
+/*
+ * Read the replied status. Without the rings, SPE sets it, so the copy in the
+ * cache is dropped first.
+ */
+static inline mailbox_queue_status_t get_queue_replied_status(void)
+{
+#ifndef TFM_MAILBOX_RING
+    mailbox_cache_invalidate(&mailbox_queue_ptr->replied_slots,
+                             sizeof(mailbox_queue_ptr->replied_slots));
+#endif
+    return mailbox_queue_ptr->replied_slots;
+}
+
+static inline void clear_queue_replied_status(mailbox_queue_status_t mask)
+{
+#ifdef TFM_MAILBOX_RING
+    mailbox_queue_ptr->replied_slots &= ~mask;
+#else
+    mailbox_cache_invalidate(&mailbox_queue_ptr->replied_slots,
+                             sizeof(mailbox_queue_ptr->replied_slots));
+    mailbox_queue_ptr->replied_slots &= ~mask;
+    mailbox_cache_clean(&mailbox_queue_ptr->replied_slots,
+                        sizeof(mailbox_queue_ptr->replied_slots));
+#endif
+}
+
 static inline void clear_queue_slot_replied(uint8_t idx)
 {
     if (idx < NUM_MAILBOX_QUEUE_SLOT) {
-        mailbox_queue_ptr->replied_slots &= ~(1 << idx);
+        clear_queue_replied_status(1 << idx);
     }
 }
 
@@ -74,7 +171,7 @@ static inline void set_queue_slot_woken(uint8_t idx)
 static inline bool is_queue_slot_woken(uint8_t idx)
 {
     if (idx < NUM_MAILBOX_QUEUE_SLOT) {
-        return mailbox_queue_ptr->queue[idx].is_woken;
+        return *(volatile bool *)&mailbox_queue_ptr->queue[idx].is_woken;
     }
 
     return false;
@@ -87,17 +184,36 @@ static inline void clear_queue_slot_woken(uint8_t idx)
     }
 }
 
+#ifdef TFM_MAILBOX_RING
+/*
+ * Move the replies received on the reply ring to the replied status. The
+ * caller is the only consumer of the ring at a time.
+ */
+static void mailbox_fetch_reply_ring(void)
+{
+    uint8_t idx;
+
+    while (mailbox_ring_peek(&mailbox_queue_ptr->reply_ring, &idx)) {
+        mailbox_ring_pop(&mailbox_queue_ptr->reply_ring);
+
+        if (idx < NUM_MAILBOX_QUEUE_SLOT) {
+            mailbox_queue_ptr->replied_slots |= (1 << idx);
+        }
+    }
+}
+#endif
+
 static uint8_t acquire_empty_slot(const struct ns_mailbox_queue_t *queue)
 {
     uint8_t idx;
     mailbox_queue_status_t status;
 
-    tfm_ns_mailbox_hal_enter_critical();
+    mailbox_enter_critical();
     status = queue->empty_slots;
 
     if (!status) {
         /* No empty slot */
-        tfm_ns_mailbox_hal_exit_critical();
+        mailbox_exit_critical();
         return NUM_MAILBOX_QUEUE_SLOT;
     }
 
@@ -109,7 +225,7 @@ static uint8_t acquire_empty_slot(const struct ns_mailbox_queue_t *queue)
 
     clear_queue_slot_empty(idx);
 
-    tfm_ns_mailbox_hal_exit_critical();
+    mailbox_exit_critical();
 
     return idx;
 }
@@ -121,6 +237,186 @@ static void set_msg_owner(uint8_t idx, const void *owner)
     }
 }
 
+#ifdef TFM_MAILBOX_COALESCE
+/*
+ * Account a request submitted to SPE. Return true if the doorbell can be
+ * held back. Called inside the mailbox critical section.
+ */
+static bool mailbox_defer_doorbell(void)
+{
+    doorbell_stats.nr_reqs++;
+
+    nr_deferred_reqs++;
+    if (nr_deferred_reqs < MAILBOX_DOORBELL_THRESHOLD) {
+        return true;
+    }
+
+    nr_deferred_reqs = 0;
+    doorbell_stats.nr_doorbells++;
+
+    return false;
+}
+
+#ifdef TFM_MULTI_CORE_MULTI_CLIENT_CALL
+/* Ring the doorbell for the requests held back, if any */
+static void mailbox_flush_doorbell(void)
+{
+    bool ring = false;
+
+    mailbox_enter_critical();
+    if (nr_deferred_reqs) {
+        nr_deferred_reqs = 0;
+        doorbell_stats.nr_doorbells++;
+        doorbell_stats.nr_timeout_doorbells++;
+        ring = true;
+    }
+    mailbox_exit_critical();
+
+    if (ring) {
+        tfm_ns_mailbox_hal_notify_peer();
+    }
+}
+#endif
+
+void tfm_ns_mailbox_get_doorbell_stats(
+                                    struct ns_mailbox_doorbell_stats_t *stats)
+{
+    if (!stats) {
+        return;
+    }
+
+    mailbox_enter_critical();
+    *stats = doorbell_stats;
+    mailbox_exit_critical();
+}
+#else
+#define mailbox_defer_doorbell()            (false)
+#endif
+
+#ifdef TFM_MAILBOX_POLL
+/*
+ * Return true if SPE polls the queue, so that the doorbell can be skipped.
+ * The barrier orders the pending request before the read of the flag. It
+ * pairs with the one in SPE between clearing the flag and its last check.
+ */
+static inline bool mailbox_spe_polling(void)
+{
+    __DMB();
+    mailbox_cache_invalidate(&mailbox_queue_ptr->spe_polling,
+                             sizeof(mailbox_queue_ptr->spe_polling));
+    return mailbox_queue_ptr->spe_polling != 0;
+}
+#else
+#define mailbox_spe_polling()               (false)
+#endif
+
+#ifdef TFM_MAILBOX_STATS
+static void mailbox_stats_clear(void)
+{
+    uint8_t i;
+
+    memset(&mailbox_stats, 0, sizeof(mailbox_stats));
+    for (i = 0; i < MAILBOX_STATS_NR_CALL_TYPES; i++) {
+        mailbox_stats.call[i].round_trip.min = UINT32_MAX;
+        mailbox_stats.call[i].dispatch.min = UINT32_MAX;
+    }
+}
+
+static void mailbox_stats_add(struct ns_mailbox_lat_stats_t *lat,
+                              uint32_t ticks)
+{
+    lat->nr++;
+    lat->total += ticks;
+    if (ticks < lat->min) {
+        lat->min = ticks;
+    }
+    if (ticks > lat->max) {
+        lat->max = ticks;
+    }
+}
+
+/*
+ * Record the reply of a call. The timer may wrap around between the sampling
+ * points, which the unsigned subtraction handles. Called inside the mailbox
+ * critical section.
+ */
+static void mailbox_stats_record(uint32_t call_type, uint32_t round_trip,
+                                 uint32_t dispatch)
+{
+    struct ns_mailbox_call_stats_t *call;
+    uint32_t bin;
+
+    if ((call_type < MAILBOX_PSA_FRAMEWORK_VERSION) ||
+        (call_type > MAILBOX_STATS_NR_CALL_TYPES)) {
+        return;
+    }
+
+    call = &mailbox_stats.call[call_type - MAILBOX_PSA_FRAMEWORK_VERSION];
+
+    mailbox_stats_add(&call->round_trip, round_trip);
+    mailbox_stats_add(&call->dispatch, dispatch);
+
+    bin = round_trip ? (31U - __CLZ(round_trip)) : 0;
+    call->round_trip_hist[bin]++;
+}
+
+void tfm_ns_mailbox_get_stats(struct ns_mailbox_stats_t *stats)
+{
+    if (!mailbox_queue_ptr || !stats) {
+        return;
+    }
+
+    mailbox_enter_critical();
+    *stats = mailbox_stats;
+    mailbox_exit_critical();
+}
+
+void tfm_ns_mailbox_stats_queue_wait(void)
+{
+    if (!mailbox_queue_ptr) {
+        return;
+    }
+
+    mailbox_enter_critical();
+    mailbox_stats.nr_queue_waits++;
+    mailbox_exit_critical();
+}
+
+void tfm_ns_mailbox_reset_stats(void)
+{
+    if (!mailbox_queue_ptr) {
+        return;
+    }
+
+    mailbox_enter_critical();
+    mailbox_stats_clear();
+    mailbox_exit_critical();
+}
+
+uint32_t tfm_ns_mailbox_stats_percentile(
+                                    const struct ns_mailbox_call_stats_t *call,
+                                    uint32_t percent)
+{
+    uint32_t bin, target, count = 0;
+
+    if (!call || !call->round_trip.nr || !percent || (percent > 100)) {
+        return 0;
+    }
+
+    /* The rank of the percentile sample, rounded up */
+    target = (uint32_t)(((uint64_t)call->round_trip.nr * percent + 99) / 100);
+
+    for (bin = 0; bin < MAILBOX_STATS_NR_HIST_BINS - 1; bin++) {
+        count += call->round_trip_hist[bin];
+        if (count >= target) {
+            return (2U << bin) - 1;
+        }
+    }
+
+    return UINT32_MAX;
+}
+#endif
+
 #ifdef TFM_MULTI_CORE_TEST
 void tfm_ns_mailbox_tx_stats_init(void)
 {
@@ -128,12 +424,12 @@ void tfm_ns_mailbox_tx_stats_init(void)
         return;
     }
 
-    tfm_ns_mailbox_hal_enter_critical();
+    mailbox_enter_critical();
 
     mailbox_queue_ptr->nr_tx = 0;
     mailbox_queue_ptr->nr_used_slots = 0;
 
-    tfm_ns_mailbox_hal_exit_critical();
+    mailbox_exit_critical();
 }
 
 static void mailbox_tx_stats_update(struct ns_mailbox_queue_t *ns_queue)
@@ -145,13 +441,13 @@ static void mailbox_tx_stats_update(struct ns_mailbox_queue_t *ns_queue)
         return;
     }
 
-    tfm_ns_mailbox_hal_enter_critical();
+    mailbox_enter_critical();
 
     ns_queue->nr_tx++;
 
     /* Count the number of used slots when this tx arrives */
     empty_status = ns_queue->empty_slots;
-    tfm_ns_mailbox_hal_exit_critical();
+    mailbox_exit_critical();
 
     if (empty_status) {
         for (idx = 0; idx < NUM_MAILBOX_QUEUE_SLOT; idx++) {
@@ -161,9 +457,9 @@ static void mailbox_tx_stats_update(struct ns_mailbox_queue_t *ns_queue)
         }
     }
 
-    tfm_ns_mailbox_hal_enter_critical();
+    mailbox_enter_critical();
     ns_queue->nr_used_slots += (NUM_MAILBOX_QUEUE_SLOT - nr_empty);
-    tfm_ns_mailbox_hal_exit_critical();
+    mailbox_exit_critical();
 }
 
 void tfm_ns_mailbox_stats_avg_slot(struct ns_mailbox_stats_res_t *stats_res)
@@ -174,10 +470,10 @@ void tfm_ns_mailbox_stats_avg_slot(struct ns_mailbox_stats_res_t *stats_res)
         return;
     }
 
-    tfm_ns_mailbox_hal_enter_critical();
+    mailbox_enter_critical();
     nr_used_slots = mailbox_queue_ptr->nr_used_slots;
     nr_tx = mailbox_queue_ptr->nr_tx;
-    tfm_ns_mailbox_hal_exit_critical();
+    mailbox_exit_critical();
 
     stats_res->avg_nr_slots = nr_used_slots / nr_tx;
     nr_used_slots %= nr_tx;
@@ -185,6 +481,83 @@ void tfm_ns_mailbox_stats_avg_slot(struct ns_mailbox_stats_res_t *stats_res)
 }
 #endif
 
+#ifdef TFM_MAILBOX_INLINE_REPLY
+/* Size taken in the inline payload by an output vector of len bytes */
+#define MAILBOX_INLINE_VEC_SIZE(len)        (((len) + 3) & ~(size_t)3)
+
+/*
+ * Redirect the output vectors of the PSA call in slot idx to the payload of
+ * its reply, if they fit. The caller output vectors are kept to copy the
+ * payload back on reply.
+ */
+static void mailbox_inline_out_vec(uint8_t idx)
+{
+    struct ns_mailbox_slot_t *slot = &mailbox_queue_ptr->queue[idx];
+    psa_outvec *out_vec = slot->msg.params.psa_call_params.out_vec;
+    size_t out_len = slot->msg.params.psa_call_params.out_len;
+    size_t i, offset = 0;
+
+    slot->caller_out_vec = NULL;
+
+    if ((out_len == 0) || (out_len > MAILBOX_REPLY_INLINE_VECS)) {
+        return;
+    }
+
+    for (i = 0; i < out_len; i++) {
+        if (out_vec[i].len > MAILBOX_REPLY_INLINE_SIZE - offset) {
+            return;
+        }
+        offset += MAILBOX_INLINE_VEC_SIZE(out_vec[i].len);
+    }
+
+    offset = 0;
+    for (i = 0; i < out_len; i++) {
+        slot->reply.inline_vec[i].base = &slot->reply.payload[offset];
+        slot->reply.inline_vec[i].len = out_vec[i].len;
+        offset += MAILBOX_INLINE_VEC_SIZE(out_vec[i].len);
+    }
+    mailbox_cache_clean(slot->reply.inline_vec,
+                        sizeof(slot->reply.inline_vec));
+
+    slot->caller_out_vec = out_vec;
+    slot->msg.params.psa_call_params.out_vec = slot->reply.inline_vec;
+}
+
+/*
+ * Copy the inline payload of the reply in slot idx to the caller output
+ * vectors, together with the number of bytes written to each. The caller
+ * output vectors are left untouched if the call failed, as the request may
+ * not have reached the RoT Service.
+ */
+static void mailbox_inline_copy_back(uint8_t idx, int32_t reply)
+{
+    struct ns_mailbox_slot_t *slot = &mailbox_queue_ptr->queue[idx];
+    psa_outvec *out_vec = slot->caller_out_vec;
+    size_t out_len = slot->msg.params.psa_call_params.out_len;
+    size_t i, len, offset = 0;
+
+    if (!out_vec) {
+        return;
+    }
+
+    slot->caller_out_vec = NULL;
+
+    if (reply < PSA_SUCCESS) {
+        return;
+    }
+
+    for (i = 0; i < out_len; i++) {
+        len = slot->reply.inline_vec[i].len;
+        if (len > out_vec[i].len) {
+            len = out_vec[i].len;
+        }
+        memcpy(out_vec[i].base, &slot->reply.payload[offset], len);
+        offset += MAILBOX_INLINE_VEC_SIZE(out_vec[i].len);
+        out_vec[i].len = len;
+    }
+}
+#endif
+
 mailbox_msg_handle_t tfm_ns_mailbox_tx_client_req(uint32_t call_type,
                                        const struct psa_client_params_t *params,
                                        int32_t client_id)
@@ -193,6 +566,7 @@ mailbox_msg_handle_t tfm_ns_mailbox_tx_client_req(uint32_t call_type,
     struct mailbox_msg_t *msg_ptr;
     mailbox_msg_handle_t handle;
     const void *task_handle;
+    bool deferred;
 
     if (!mailbox_queue_ptr) {
         return MAILBOX_MSG_NULL_HANDLE;
@@ -204,6 +578,11 @@ mailbox_msg_handle_t tfm_ns_mailbox_tx_client_req(uint32_t call_type,
 
     idx = acquire_empty_slot(mailbox_queue_ptr);
     if (idx >= NUM_MAILBOX_QUEUE_SLOT) {
+#ifdef TFM_MAILBOX_STATS
+        mailbox_enter_critical();
+        mailbox_stats.nr_queue_full++;
+        mailbox_exit_critical();
+#endif
         return MAILBOX_QUEUE_FULL;
     }
 
@@ -217,6 +596,14 @@ mailbox_msg_handle_t tfm_ns_mailbox_tx_client_req(uint32_t call_type,
     msg_ptr->call_type = call_type;
     memcpy(&msg_ptr->params, params, sizeof(msg_ptr->params));
     msg_ptr->client_id = client_id;
+#ifdef TFM_MAILBOX_INLINE_REPLY
+    if (call_type == MAILBOX_PSA_CALL) {
+        mailbox_inline_out_vec(idx);
+    } else {
+        mailbox_queue_ptr->queue[idx].caller_out_vec = NULL;
+    }
+#endif
+    mailbox_cache_clean(msg_ptr, sizeof(*msg_ptr));
 
     /*
      * Fetch the current task handle. The task will be woken up according the
@@ -227,11 +614,18 @@ mailbox_msg_handle_t tfm_ns_mailbox_tx_client_req(uint32_t call_type,
 
     get_mailbox_msg_handle(idx, &handle);
 
-    tfm_ns_mailbox_hal_enter_critical();
+#ifdef TFM_MAILBOX_STATS
+    mailbox_queue_ptr->queue[idx].tx_time = tfm_ns_mailbox_hal_get_timestamp();
+#endif
+
+    mailbox_enter_critical();
     set_queue_slot_pend(idx);
-    tfm_ns_mailbox_hal_exit_critical();
+    deferred = mailbox_defer_doorbell();
+    mailbox_exit_critical();
 
-    tfm_ns_mailbox_hal_notify_peer();
+    if (!deferred && !mailbox_spe_polling()) {
+        tfm_ns_mailbox_hal_notify_peer();
+    }
 
     return handle;
 }
@@ -241,6 +635,9 @@ int32_t tfm_ns_mailbox_rx_client_reply(mailbox_msg_handle_t handle,
 {
     uint8_t idx;
     int32_t ret;
+#ifdef TFM_MAILBOX_STATS
+    uint32_t round_trip;
+#endif
 
     if (!mailbox_queue_ptr) {
         return MAILBOX_INVAL_PARAMS;
@@ -255,12 +652,28 @@ int32_t tfm_ns_mailbox_rx_client_reply(mailbox_msg_handle_t handle,
         return ret;
     }
 
+    mailbox_cache_invalidate(&mailbox_queue_ptr->queue[idx].reply,
+                             sizeof(mailbox_queue_ptr->queue[idx].reply));
     *reply = mailbox_queue_ptr->queue[idx].reply.return_val;
 
+#ifdef TFM_MAILBOX_INLINE_REPLY
+    mailbox_inline_copy_back(idx, *reply);
+#endif
+
+#ifdef TFM_MAILBOX_STATS
+    round_trip = tfm_ns_mailbox_hal_get_timestamp() -
+                 mailbox_queue_ptr->queue[idx].tx_time;
+#endif
+
     /* Clear up the owner field */
     set_msg_owner(idx, NULL);
 
-    tfm_ns_mailbox_hal_enter_critical();
+    mailbox_enter_critical();
+#ifdef TFM_MAILBOX_STATS
+    mailbox_stats_record(mailbox_queue_ptr->queue[idx].msg.call_type,
+                         round_trip,
+                         mailbox_queue_ptr->queue[idx].reply.dispatch_time);
+#endif
     clear_queue_slot_replied(idx);
     clear_queue_slot_woken(idx);
     /*
@@ -268,7 +681,7 @@ int32_t tfm_ns_mailbox_rx_client_reply(mailbox_msg_handle_t handle,
      * re-initialized.
      */
     set_queue_slot_empty(idx);
-    tfm_ns_mailbox_hal_exit_critical();
+    mailbox_exit_critical();
 
     return MAILBOX_SUCCESS;
 }
@@ -292,9 +705,12 @@ bool tfm_ns_mailbox_is_msg_replied(mailbox_msg_handle_t handle)
         return false;
     }
 
-    tfm_ns_mailbox_hal_enter_critical();
-    status = mailbox_queue_ptr->replied_slots;
-    tfm_ns_mailbox_hal_exit_critical();
+    mailbox_enter_critical();
+#ifdef TFM_MAILBOX_RING
+    mailbox_fetch_reply_ring();
+#endif
+    status = get_queue_replied_status();
+    mailbox_exit_critical();
 
     if (status & (1 << idx)) {
         return true;
@@ -313,9 +729,12 @@ mailbox_msg_handle_t tfm_ns_mailbox_fetch_reply_msg_isr(void)
         return MAILBOX_MSG_NULL_HANDLE;
     }
 
-    tfm_ns_mailbox_hal_enter_critical_isr();
-    replied_status = mailbox_queue_ptr->replied_slots;
-    tfm_ns_mailbox_hal_exit_critical_isr();
+    mailbox_enter_critical_isr();
+#ifdef TFM_MAILBOX_RING
+    mailbox_fetch_reply_ring();
+#endif
+    replied_status = get_queue_replied_status();
+    mailbox_exit_critical_isr();
 
     if (!replied_status) {
         return MAILBOX_MSG_NULL_HANDLE;
@@ -324,10 +743,10 @@ mailbox_msg_handle_t tfm_ns_mailbox_fetch_reply_msg_isr(void)
     for (idx = 0; idx < NUM_MAILBOX_QUEUE_SLOT; idx++) {
         /* Find the first replied message in queue */
         if (replied_status & (0x1UL << idx)) {
-            tfm_ns_mailbox_hal_enter_critical_isr();
+            mailbox_enter_critical_isr();
             clear_queue_slot_replied(idx);
             set_queue_slot_woken(idx);
-            tfm_ns_mailbox_hal_exit_critical_isr();
+            mailbox_exit_critical_isr();
 
             if (get_mailbox_msg_handle(idx, &handle) == MAILBOX_SUCCESS) {
                 return handle;
@@ -338,6 +757,49 @@ mailbox_msg_handle_t tfm_ns_mailbox_fetch_reply_msg_isr(void)
     return MAILBOX_MSG_NULL_HANDLE;
 }
 
+uint8_t tfm_ns_mailbox_fetch_replies_isr(
+                                    struct ns_mailbox_replied_msg_t *msgs)
+{
+    uint8_t idx, nr_msgs = 0;
+    mailbox_queue_status_t replied_status;
+
+    if (!mailbox_queue_ptr || !msgs) {
+        return 0;
+    }
+
+    /* Take and clear all the replied status in a single critical section */
+    mailbox_enter_critical_isr();
+#ifdef TFM_MAILBOX_RING
+    mailbox_fetch_reply_ring();
+#endif
+    replied_status = get_queue_replied_status();
+    if (replied_status) {
+        clear_queue_replied_status(replied_status);
+    }
+    mailbox_exit_critical_isr();
+
+    for (idx = 0; idx < NUM_MAILBOX_QUEUE_SLOT; idx++) {
+        if (!(replied_status & (0x1UL << idx))) {
+            continue;
+        }
+
+        /*
+         * The woken flag is only written here and by the owner after it has
+         * seen the flag set. It must be visible before the owner is woken up.
+         */
+        set_queue_slot_woken(idx);
+        __COMPILER_BARRIER();
+
+        if (get_mailbox_msg_handle(idx, &msgs[nr_msgs].handle) ==
+                                                            MAILBOX_SUCCESS) {
+            msgs[nr_msgs].owner = mailbox_queue_ptr->queue[idx].owner;
+            nr_msgs++;
+        }
+    }
+
+    return nr_msgs;
+}
+
 const void *tfm_ns_mailbox_get_msg_owner(mailbox_msg_handle_t handle)
 {
     uint8_t idx;
@@ -374,8 +836,15 @@ int32_t tfm_ns_mailbox_init(struct ns_mailbox_queue_t *queue)
     queue->empty_slots +=
             (mailbox_queue_status_t)(1UL << (NUM_MAILBOX_QUEUE_SLOT - 1));
 
+    /* SPE must not find stale lines of the queue in memory */
+    mailbox_cache_clean(queue, sizeof(*queue));
+
     mailbox_queue_ptr = queue;
 
+#ifdef TFM_MAILBOX_STATS
+    mailbox_stats_clear();
+#endif
+
     /* Platform specific initialization. */
     ret = tfm_ns_mailbox_hal_init(queue);
 
@@ -406,19 +875,32 @@ int32_t tfm_ns_mailbox_wait_reply(mailbox_msg_handle_t handle)
     }
 
     while (1) {
+#ifdef TFM_MAILBOX_COALESCE
+        if (nr_deferred_reqs) {
+            /*
+             * Give other threads a short while to join the held back
+             * doorbell before ringing it.
+             */
+            tfm_ns_mailbox_hal_wait_reply_timeout(handle,
+                                                  MAILBOX_DOORBELL_TIMEOUT);
+            mailbox_flush_doorbell();
+        } else {
+            tfm_ns_mailbox_hal_wait_reply(handle);
+        }
+#else
         tfm_ns_mailbox_hal_wait_reply(handle);
+#endif
 
         /*
          * Woken up from sleep
          * Check the completed flag to make sure that the current thread is
          * woken up by reply event, rather than other events.
+         * The flag is a single byte only set by the mailbox interrupt, and
+         * only cleared by this thread afterwards. Reading it needs no lock.
          */
-        tfm_ns_mailbox_hal_enter_critical();
         if (is_queue_slot_woken(idx)) {
-            tfm_ns_mailbox_hal_exit_critical();
             break;
         }
-        tfm_ns_mailbox_hal_exit_critical();
     }
 
     return MAILBOX_SUCCESS;
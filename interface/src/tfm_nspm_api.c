@@ -12,6 +12,10 @@
 
 #include "cmsis_os2.h"
 #include "tfm_ns_svc.h"
+#ifdef TFM_PSA_ASYNC_CALL
+#include "tfm_api.h"
+#include "tfm_ns_interface.h"
+#endif
 
 #ifdef TFM_NS_CLIENT_IDENTIFICATION
 
@@ -81,4 +85,32 @@ uint32_t tfm_nspm_register_client_id(void)
     return tfm_nspm_svc_register_client(client_id);
 }
 
+__attribute__ ((naked))
+static uint32_t tfm_nspm_svc_register_slot(uint32_t slot)
+{
+    SVC(SVC_TFM_NSPM_REGISTER_CTX_SLOT);
+    __ASM volatile("BX LR");
+}
+
+uint32_t tfm_nspm_register_ctx_slot(volatile uint32_t *slot)
+{
+    return tfm_nspm_svc_register_slot((uint32_t)slot);
+}
+
+#endif
+
+#ifdef TFM_PSA_ASYNC_CALL
+uint32_t tfm_nspm_register_async_call_irq(int32_t irq_line)
+{
+    psa_status_t status;
+
+    status = (psa_status_t)tfm_ns_interface_dispatch(
+                            (veneer_fn)tfm_psa_call_async_set_irq_veneer,
+                            (uint32_t)irq_line,
+                            0,
+                            0,
+                            0);
+
+    return (status == PSA_SUCCESS) ? 1 : 0;
+}
 #endif
@@ -21,4 +21,14 @@ uint32_t tfm_nspm_svc_register_client_id(uint32_t client_id)
     return 0;
 }
 
+uint32_t tfm_nspm_svc_register_ctx_slot(uint32_t slot)
+{
+    if (tfm_register_ns_ctx_slot((const volatile uint32_t *)slot) ==
+                                                                TFM_SUCCESS) {
+        return 1;
+    }
+
+    return 0;
+}
+
 #endif
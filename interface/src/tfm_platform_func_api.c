@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -50,3 +50,154 @@ tfm_platform_ioctl(tfm_platform_ioctl_req_t request,
                                 (uint32_t)output, (uint32_t)outlen);
 }
 
+enum tfm_platform_err_t
+tfm_platform_ioctl_vector(const struct tfm_platform_ioctl_vec_t *requests,
+                          size_t num_requests,
+                          psa_invec *input,
+                          psa_outvec *output,
+                          enum tfm_platform_err_t *status)
+{
+    psa_invec in_vec[2];
+    psa_outvec out_vec[2];
+    size_t inlen, outlen;
+
+    if ((requests == NULL) || (num_requests == 0) || (status == NULL)) {
+        return TFM_PLATFORM_ERR_INVALID_PARAM;
+    }
+
+    in_vec[0].base = requests;
+    in_vec[0].len = num_requests * sizeof(struct tfm_platform_ioctl_vec_t);
+    if (input != NULL) {
+        in_vec[1] = *input;
+        inlen = 2;
+    } else {
+        inlen = 1;
+    }
+
+    out_vec[0].base = status;
+    out_vec[0].len = num_requests * sizeof(enum tfm_platform_err_t);
+    if (output != NULL) {
+        out_vec[1] = *output;
+        outlen = 2;
+    } else {
+        outlen = 1;
+    }
+
+    return (enum tfm_platform_err_t) tfm_ns_interface_dispatch(
+                                (veneer_fn)tfm_platform_sp_ioctl_vector_veneer,
+                                (uint32_t)in_vec, (uint32_t)inlen,
+                                (uint32_t)out_vec, (uint32_t)outlen);
+}
+
+enum tfm_platform_err_t
+tfm_platform_ipc_trace_read(struct tfm_ipc_trace_entry_t *entries,
+                            size_t *num)
+{
+    (void)entries;
+    (void)num;
+
+    /* The IPC trace is only recorded by the SPM of the IPC model */
+    return TFM_PLATFORM_ERR_NOT_SUPPORTED;
+}
+
+enum tfm_platform_err_t
+tfm_platform_boot_time_read(struct tfm_boot_time_entry_t *entries,
+                            size_t *num)
+{
+    psa_outvec out_vec;
+    enum tfm_platform_err_t ret;
+
+    if (num == NULL) {
+        return TFM_PLATFORM_ERR_INVALID_PARAM;
+    }
+
+    out_vec.base = entries;
+    out_vec.len = *num * sizeof(struct tfm_boot_time_entry_t);
+
+    ret = (enum tfm_platform_err_t) tfm_ns_interface_dispatch(
+                            (veneer_fn)tfm_platform_sp_boot_time_read_veneer,
+                            0, 0, (uint32_t)&out_vec, 1);
+    if (ret == TFM_PLATFORM_ERR_SUCCESS) {
+        *num = out_vec.len / sizeof(struct tfm_boot_time_entry_t);
+    }
+
+    return ret;
+}
+
+enum tfm_platform_err_t
+tfm_platform_spm_stats_read(struct tfm_spm_partition_stats_t *partitions,
+                            size_t *num_partitions,
+                            struct tfm_spm_service_stats_t *services,
+                            size_t *num_services)
+{
+    psa_outvec out_vec[2];
+    enum tfm_platform_err_t ret;
+
+    if ((num_partitions == NULL) || (num_services == NULL)) {
+        return TFM_PLATFORM_ERR_INVALID_PARAM;
+    }
+
+    out_vec[0].base = partitions;
+    out_vec[0].len = *num_partitions * sizeof(struct tfm_spm_partition_stats_t);
+    out_vec[1].base = services;
+    out_vec[1].len = *num_services * sizeof(struct tfm_spm_service_stats_t);
+
+    ret = (enum tfm_platform_err_t) tfm_ns_interface_dispatch(
+                            (veneer_fn)tfm_platform_sp_spm_stats_read_veneer,
+                            0, 0, (uint32_t)out_vec, 2);
+    if (ret == TFM_PLATFORM_ERR_SUCCESS) {
+        *num_partitions =
+                    out_vec[0].len / sizeof(struct tfm_spm_partition_stats_t);
+        *num_services = out_vec[1].len / sizeof(struct tfm_spm_service_stats_t);
+    }
+
+    return ret;
+}
+
+enum tfm_platform_err_t
+tfm_platform_spm_profile_read(struct tfm_spm_profile_sample_t *samples,
+                              size_t *num)
+{
+    psa_outvec out_vec;
+    enum tfm_platform_err_t ret;
+
+    if (num == NULL) {
+        return TFM_PLATFORM_ERR_INVALID_PARAM;
+    }
+
+    out_vec.base = samples;
+    out_vec.len = *num * sizeof(struct tfm_spm_profile_sample_t);
+
+    ret = (enum tfm_platform_err_t) tfm_ns_interface_dispatch(
+                            (veneer_fn)tfm_platform_sp_spm_profile_read_veneer,
+                            0, 0, (uint32_t)&out_vec, 1);
+    if (ret == TFM_PLATFORM_ERR_SUCCESS) {
+        *num = out_vec.len / sizeof(struct tfm_spm_profile_sample_t);
+    }
+
+    return ret;
+}
+
+enum tfm_platform_err_t
+tfm_platform_resource_usage_read(struct tfm_resource_usage_t *entries,
+                                 size_t *num)
+{
+    psa_outvec out_vec;
+    enum tfm_platform_err_t ret;
+
+    if (num == NULL) {
+        return TFM_PLATFORM_ERR_INVALID_PARAM;
+    }
+
+    out_vec.base = entries;
+    out_vec.len = *num * sizeof(struct tfm_resource_usage_t);
+
+    ret = (enum tfm_platform_err_t) tfm_ns_interface_dispatch(
+                        (veneer_fn)tfm_platform_sp_resource_usage_read_veneer,
+                        0, 0, (uint32_t)&out_vec, 1);
+    if (ret == TFM_PLATFORM_ERR_SUCCESS) {
+        *num = out_vec.len / sizeof(struct tfm_resource_usage_t);
+    }
+
+    return ret;
+}
@@ -41,11 +41,19 @@ psa_handle_t psa_connect(uint32_t sid, uint32_t version)
                                 0);
 }
 
+#ifdef TFM_NS_CONCURRENT_CALLS
+static psa_status_t psa_call_blocking(psa_handle_t handle, int32_t type,
+                                      const psa_invec *in_vec,
+                                      size_t in_len,
+                                      psa_outvec *out_vec,
+                                      size_t out_len)
+#else
 psa_status_t psa_call(psa_handle_t handle, int32_t type,
                       const psa_invec *in_vec,
                       size_t in_len,
                       psa_outvec *out_vec,
                       size_t out_len)
+#endif
 {
     /* FixMe: sanity check can be added to offload some NS thread checks from
      * TFM secure API
@@ -68,6 +76,99 @@ psa_status_t psa_call(psa_handle_t handle, int32_t type,
                                 (uint32_t)out_vec);
 }
 
+psa_status_t psa_call_batch(psa_handle_t handle, psa_batch_call_t *calls,
+                            size_t num_calls)
+{
+    return tfm_ns_interface_dispatch(
+                                (veneer_fn)tfm_psa_call_batch_veneer,
+                                (uint32_t)handle,
+                                (uint32_t)calls,
+                                (uint32_t)num_calls,
+                                0);
+}
+
+#ifdef TFM_PSA_ASYNC_CALL
+psa_status_t psa_call_async(psa_handle_t handle, int32_t type,
+                            const psa_invec *in_vec,
+                            size_t in_len,
+                            psa_outvec *out_vec,
+                            size_t out_len,
+                            psa_handle_t *token)
+{
+    struct tfm_async_control_parameter_t ctrl_param = {
+        .type = type,
+        .in_len = in_len,
+        .out_len = out_len,
+        .token = PSA_NULL_HANDLE,
+    };
+    psa_status_t status;
+
+    /*
+     * The veneer returns once the request is queued, so the NS interface is
+     * only held for the submission and not for the service time.
+     */
+    status = tfm_ns_interface_dispatch(
+                                (veneer_fn)tfm_psa_call_async_veneer,
+                                (uint32_t)handle,
+                                (uint32_t)&ctrl_param,
+                                (uint32_t)in_vec,
+                                (uint32_t)out_vec);
+
+    *token = ctrl_param.token;
+    return status;
+}
+
+psa_status_t psa_call_async_result(psa_handle_t token, psa_status_t *status)
+{
+    return tfm_ns_interface_dispatch(
+                                (veneer_fn)tfm_psa_call_async_result_veneer,
+                                (uint32_t)token,
+                                (uint32_t)status,
+                                0,
+                                0);
+}
+#endif
+
+#ifdef TFM_NS_CONCURRENT_CALLS
+psa_status_t psa_call(psa_handle_t handle, int32_t type,
+                      const psa_invec *in_vec,
+                      size_t in_len,
+                      psa_outvec *out_vec,
+                      size_t out_len)
+{
+    psa_handle_t token;
+    psa_status_t status;
+    psa_status_t ret;
+    int32_t waiter;
+
+    waiter = tfm_ns_interface_waiter_get();
+    if (waiter < 0) {
+        return psa_call_blocking(handle, type, in_vec, in_len,
+                                 out_vec, out_len);
+    }
+
+    /*
+     * The thread waits in the NS OS, so that other threads can call other
+     * RoT Services while this one is handled.
+     */
+    ret = psa_call_async(handle, type, in_vec, in_len, out_vec, out_len,
+                         &token);
+    if (ret == PSA_SUCCESS) {
+        while ((ret = psa_call_async_result(token, &status)) ==
+               PSA_ERROR_CONNECTION_BUSY) {
+            tfm_ns_interface_waiter_wait();
+        }
+        if (ret == PSA_SUCCESS) {
+            ret = status;
+        }
+    }
+
+    tfm_ns_interface_waiter_put(waiter);
+
+    return ret;
+}
+#endif
+
 void psa_close(psa_handle_t handle)
 {
     (void)tfm_ns_interface_dispatch(
@@ -8,6 +8,7 @@
 #include "psa/protected_storage.h"
 
 #include "tfm_ns_interface.h"
+#include "tfm_sst_defs.h"
 #include "tfm_veneers.h"
 
 #define IOVEC_LEN(x) (uint32_t)(sizeof(x)/sizeof(x[0]))
@@ -144,3 +145,104 @@ uint32_t psa_ps_get_support(void)
 
     return support_flags;
 }
+
+/**
+ * \brief Sends an SST transaction request.
+ *
+ * \param[in] operation  Transaction operation, TFM_SST_TRANSACTION_*
+ *
+ * \return A status indicating the success/failure of the operation
+ */
+static psa_status_t sst_transaction_request(uint32_t operation)
+{
+    psa_invec in_vec[] = {
+        { .base = &operation, .len = sizeof(operation) }
+    };
+
+    return tfm_ns_interface_dispatch(
+                               (veneer_fn)tfm_tfm_sst_transaction_req_veneer,
+                               (uint32_t)in_vec,  IOVEC_LEN(in_vec),
+                               (uint32_t)NULL, 0);
+}
+
+psa_status_t psa_ps_begin_transaction(void)
+{
+    return sst_transaction_request(TFM_SST_TRANSACTION_BEGIN);
+}
+
+psa_status_t psa_ps_commit_transaction(void)
+{
+    return sst_transaction_request(TFM_SST_TRANSACTION_COMMIT);
+}
+
+psa_status_t psa_ps_abort_transaction(void)
+{
+    return sst_transaction_request(TFM_SST_TRANSACTION_ABORT);
+}
+
+psa_status_t psa_ps_set_async(psa_storage_uid_t uid,
+                              size_t data_length,
+                              const void *p_data,
+                              psa_storage_create_flags_t create_flags)
+{
+    psa_status_t status;
+    psa_invec in_vec[] = {
+        { .base = &uid,   .len = sizeof(uid) },
+        { .base = p_data, .len = data_length },
+        { .base = &create_flags, .len = sizeof(create_flags) }
+    };
+
+    status = tfm_ns_interface_dispatch(
+                                  (veneer_fn)tfm_tfm_sst_set_async_req_veneer,
+                                  (uint32_t)in_vec,  IOVEC_LEN(in_vec),
+                                  (uint32_t)NULL, 0);
+
+    /* A parameter with a buffer pointer pointer that has data length longer
+     * than maximum permitted is treated as a secure violation.
+     * TF-M framework rejects the request with TFM_ERROR_INVALID_PARAMETER.
+     */
+    if (status == (psa_status_t)TFM_ERROR_INVALID_PARAMETER) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+    return status;
+}
+
+psa_status_t psa_ps_flush(void)
+{
+    return tfm_ns_interface_dispatch((veneer_fn)tfm_tfm_sst_flush_req_veneer,
+                                     (uint32_t)NULL, 0,
+                                     (uint32_t)NULL, 0);
+}
+
+psa_status_t psa_ps_list(uint32_t *cursor,
+                         psa_storage_uid_t *uids,
+                         size_t max_uids,
+                         size_t *uid_count)
+{
+    psa_status_t status;
+
+    psa_invec in_vec[] = {
+        { .base = cursor, .len = sizeof(*cursor) }
+    };
+
+    psa_outvec out_vec[] = {
+        { .base = uids, .len = max_uids * sizeof(psa_storage_uid_t) },
+        { .base = cursor, .len = sizeof(*cursor) }
+    };
+
+    if ((cursor == NULL) || (uid_count == NULL)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    status = tfm_ns_interface_dispatch((veneer_fn)tfm_tfm_sst_list_req_veneer,
+                                       (uint32_t)in_vec, IOVEC_LEN(in_vec),
+                                       (uint32_t)out_vec, IOVEC_LEN(out_vec));
+
+    if (status == (psa_status_t)TFM_ERROR_INVALID_PARAMETER) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    *uid_count = out_vec[0].len / sizeof(psa_storage_uid_t);
+
+    return status;
+}
@@ -8,6 +8,7 @@
 #include "psa/protected_storage.h"
 
 #include "tfm_ns_interface.h"
+#include "tfm_sst_defs.h"
 #include "tfm_veneers.h"
 #include "psa_manifest/sid.h"
 
@@ -19,7 +20,6 @@ psa_status_t psa_ps_set(psa_storage_uid_t uid,
                         psa_storage_create_flags_t create_flags)
 {
     psa_status_t status;
-    psa_handle_t handle;
 
     psa_invec in_vec[] = {
         { .base = &uid,   .len = sizeof(uid) },
@@ -27,15 +27,8 @@ psa_status_t psa_ps_set(psa_storage_uid_t uid,
         { .base = &create_flags, .len = sizeof(create_flags) }
     };
 
-    handle = psa_connect(TFM_SST_SET_SID, TFM_SST_SET_VERSION);
-    if (!PSA_HANDLE_IS_VALID(handle)) {
-        return PSA_ERROR_GENERIC_ERROR;
-    }
-
-    status = psa_call(handle, PSA_IPC_CALL, in_vec, IOVEC_LEN(in_vec),
-                      NULL, 0);
-
-    psa_close(handle);
+    status = psa_call(TFM_SST_SET_HANDLE, PSA_IPC_CALL,
+                      in_vec, IOVEC_LEN(in_vec), NULL, 0);
 
     /* A parameter with a buffer pointer pointer that has data length longer
      * than maximum permitted is treated as a secure violation.
@@ -55,7 +48,6 @@ psa_status_t psa_ps_get(psa_storage_uid_t uid,
                         size_t *p_data_length)
 {
     psa_status_t status;
-    psa_handle_t handle;
 
     psa_invec in_vec[] = {
         { .base = &uid, .len = sizeof(uid) },
@@ -70,15 +62,8 @@ psa_status_t psa_ps_get(psa_storage_uid_t uid,
         return PSA_ERROR_INVALID_ARGUMENT;
     }
 
-    handle = psa_connect(TFM_SST_GET_SID, TFM_SST_GET_VERSION);
-    if (!PSA_HANDLE_IS_VALID(handle)) {
-        return PSA_ERROR_GENERIC_ERROR;
-    }
-
-    status = psa_call(handle, PSA_IPC_CALL, in_vec, IOVEC_LEN(in_vec), out_vec,
-                      IOVEC_LEN(out_vec));
-
-    psa_close(handle);
+    status = psa_call(TFM_SST_GET_HANDLE, PSA_IPC_CALL,
+                      in_vec, IOVEC_LEN(in_vec), out_vec, IOVEC_LEN(out_vec));
 
     *p_data_length = out_vec[0].len;
 
@@ -89,7 +74,6 @@ psa_status_t psa_ps_get_info(psa_storage_uid_t uid,
                              struct psa_storage_info_t *p_info)
 {
     psa_status_t status;
-    psa_handle_t handle;
 
     psa_invec in_vec[] = {
         { .base = &uid, .len = sizeof(uid) }
@@ -99,15 +83,8 @@ psa_status_t psa_ps_get_info(psa_storage_uid_t uid,
         { .base = p_info, .len = sizeof(*p_info) }
     };
 
-    handle = psa_connect(TFM_SST_GET_INFO_SID, TFM_SST_GET_INFO_VERSION);
-    if (!PSA_HANDLE_IS_VALID(handle)) {
-        return PSA_ERROR_GENERIC_ERROR;
-    }
-
-    status = psa_call(handle, PSA_IPC_CALL, in_vec, IOVEC_LEN(in_vec), out_vec,
-                      IOVEC_LEN(out_vec));
-
-    psa_close(handle);
+    status = psa_call(TFM_SST_GET_INFO_HANDLE, PSA_IPC_CALL,
+                      in_vec, IOVEC_LEN(in_vec), out_vec, IOVEC_LEN(out_vec));
 
     return status;
 }
@@ -115,22 +92,13 @@ psa_status_t psa_ps_get_info(psa_storage_uid_t uid,
 psa_status_t psa_ps_remove(psa_storage_uid_t uid)
 {
     psa_status_t status;
-    psa_handle_t handle;
 
     psa_invec in_vec[] = {
         { .base = &uid, .len = sizeof(uid) }
     };
 
-
-    handle = psa_connect(TFM_SST_REMOVE_SID, TFM_SST_REMOVE_VERSION);
-    if (!PSA_HANDLE_IS_VALID(handle)) {
-        return PSA_ERROR_GENERIC_ERROR;
-    }
-
-    status = psa_call(handle, PSA_IPC_CALL, in_vec, IOVEC_LEN(in_vec),
-                      NULL, 0);
-
-    psa_close(handle);
+    status = psa_call(TFM_SST_REMOVE_HANDLE, PSA_IPC_CALL,
+                      in_vec, IOVEC_LEN(in_vec), NULL, 0);
 
     return status;
 }
@@ -162,7 +130,6 @@ uint32_t psa_ps_get_support(void)
      * uninitialised value in case the secure function fails.
      */
     uint32_t support_flags = 0;
-    psa_handle_t handle;
 
     psa_outvec out_vec[] = {
         { .base = &support_flags, .len = sizeof(support_flags) }
@@ -171,14 +138,113 @@ uint32_t psa_ps_get_support(void)
     /* The PSA API does not return an error, so any error from TF-M is
      * ignored.
      */
-    handle = psa_connect(TFM_SST_GET_SUPPORT_SID, TFM_SST_GET_SUPPORT_VERSION);
-    if (!PSA_HANDLE_IS_VALID(handle)) {
-        return support_flags;
+    (void)psa_call(TFM_SST_GET_SUPPORT_HANDLE, PSA_IPC_CALL,
+                   NULL, 0, out_vec, IOVEC_LEN(out_vec));
+
+    return support_flags;
+}
+
+/**
+ * \brief Sends an SST transaction request.
+ *
+ * \param[in] operation  Transaction operation, TFM_SST_TRANSACTION_*
+ *
+ * \return A status indicating the success/failure of the operation
+ */
+static psa_status_t sst_transaction_request(uint32_t operation)
+{
+    psa_status_t status;
+
+    psa_invec in_vec[] = {
+        { .base = &operation, .len = sizeof(operation) }
+    };
+
+    status = psa_call(TFM_SST_TRANSACTION_HANDLE, PSA_IPC_CALL,
+                      in_vec, IOVEC_LEN(in_vec), NULL, 0);
+
+    return status;
+}
+
+psa_status_t psa_ps_begin_transaction(void)
+{
+    return sst_transaction_request(TFM_SST_TRANSACTION_BEGIN);
+}
+
+psa_status_t psa_ps_commit_transaction(void)
+{
+    return sst_transaction_request(TFM_SST_TRANSACTION_COMMIT);
+}
+
+psa_status_t psa_ps_abort_transaction(void)
+{
+    return sst_transaction_request(TFM_SST_TRANSACTION_ABORT);
+}
+
+psa_status_t psa_ps_set_async(psa_storage_uid_t uid,
+                              size_t data_length,
+                              const void *p_data,
+                              psa_storage_create_flags_t create_flags)
+{
+    psa_status_t status;
+
+    psa_invec in_vec[] = {
+        { .base = &uid,   .len = sizeof(uid) },
+        { .base = p_data, .len = data_length },
+        { .base = &create_flags, .len = sizeof(create_flags) }
+    };
+
+    status = psa_call(TFM_SST_SET_ASYNC_HANDLE, PSA_IPC_CALL,
+                      in_vec, IOVEC_LEN(in_vec), NULL, 0);
+
+    /* A parameter with a buffer pointer pointer that has data length longer
+     * than maximum permitted is treated as a secure violation.
+     * TF-M framework rejects the request with TFM_ERROR_INVALID_PARAMETER.
+     */
+    if (status == (psa_status_t)TFM_ERROR_INVALID_PARAMETER) {
+        return PSA_ERROR_INVALID_ARGUMENT;
     }
 
-    (void)psa_call(handle, PSA_IPC_CALL, NULL, 0, out_vec, IOVEC_LEN(out_vec));
+    return status;
+}
+
+psa_status_t psa_ps_flush(void)
+{
+    psa_status_t status;
 
-    psa_close(handle);
+    status = psa_call(TFM_SST_FLUSH_HANDLE, PSA_IPC_CALL,
+                      NULL, 0, NULL, 0);
 
-    return support_flags;
+    return status;
+}
+
+psa_status_t psa_ps_list(uint32_t *cursor,
+                         psa_storage_uid_t *uids,
+                         size_t max_uids,
+                         size_t *uid_count)
+{
+    psa_status_t status;
+
+    psa_invec in_vec[] = {
+        { .base = cursor, .len = sizeof(*cursor) }
+    };
+
+    psa_outvec out_vec[] = {
+        { .base = uids, .len = max_uids * sizeof(psa_storage_uid_t) },
+        { .base = cursor, .len = sizeof(*cursor) }
+    };
+
+    if ((cursor == NULL) || (uid_count == NULL)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    status = psa_call(TFM_SST_LIST_HANDLE, PSA_IPC_CALL,
+                      in_vec, IOVEC_LEN(in_vec), out_vec, IOVEC_LEN(out_vec));
+
+    if (status == (psa_status_t)TFM_ERROR_INVALID_PARAMETER) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    *uid_count = out_vec[0].len / sizeof(psa_storage_uid_t);
+
+    return status;
 }
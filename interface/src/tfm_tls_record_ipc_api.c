@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include "tfm_tls_record_api.h"
+#include "tfm_ns_interface.h"
+#include "psa/client.h"
+#include "psa_manifest/sid.h"
+
+#define IOVEC_LEN(x) (sizeof(x)/sizeof(x[0]))
+
+psa_status_t psa_tls_record_setup(uint32_t *connection,
+                                  const struct tfm_tls_record_params *params,
+                                  const uint8_t *secret,
+                                  size_t secret_length,
+                                  const uint8_t *randoms,
+                                  size_t randoms_length)
+{
+    psa_invec in_vec[] = {
+        {params, sizeof(*params)},
+        {secret, secret_length},
+        {randoms, randoms_length}
+    };
+    psa_outvec out_vec[] = {
+        {connection, sizeof(*connection)}
+    };
+
+    *connection = TFM_TLS_RECORD_INVALID_HANDLE;
+
+    return psa_call(TFM_TLS_RECORD_SETUP_HANDLE, PSA_IPC_CALL,
+                    in_vec, IOVEC_LEN(in_vec),
+                    out_vec, IOVEC_LEN(out_vec));
+}
+
+psa_status_t psa_tls_record_protect(uint32_t connection,
+                                    uint8_t content_type,
+                                    const uint8_t *plaintext,
+                                    size_t plaintext_length,
+                                    uint8_t *record,
+                                    size_t record_size,
+                                    size_t *record_length)
+{
+    psa_status_t status;
+    psa_invec in_vec[] = {
+        {&connection, sizeof(connection)},
+        {&content_type, sizeof(content_type)},
+        {plaintext, plaintext_length}
+    };
+    psa_outvec out_vec[] = {
+        {record, record_size}
+    };
+
+    status = psa_call(TFM_TLS_RECORD_PROTECT_HANDLE, PSA_IPC_CALL,
+                      in_vec, IOVEC_LEN(in_vec),
+                      out_vec, IOVEC_LEN(out_vec));
+
+    *record_length = (status == PSA_SUCCESS) ? out_vec[0].len : 0;
+
+    return status;
+}
+
+psa_status_t psa_tls_record_unprotect(uint32_t connection,
+                                      const uint8_t *record,
+                                      size_t record_length,
+                                      uint8_t *content_type,
+                                      uint8_t *plaintext,
+                                      size_t plaintext_size,
+                                      size_t *plaintext_length)
+{
+    psa_status_t status;
+    uint32_t length = 0;
+    psa_invec in_vec[] = {
+        {&connection, sizeof(connection)},
+        {record, record_length}
+    };
+    psa_outvec out_vec[] = {
+        {content_type, sizeof(*content_type)},
+        {&length, sizeof(length)},
+        {plaintext, plaintext_size}
+    };
+
+    status = psa_call(TFM_TLS_RECORD_UNPROTECT_HANDLE, PSA_IPC_CALL,
+                      in_vec, IOVEC_LEN(in_vec),
+                      out_vec, IOVEC_LEN(out_vec));
+
+    *plaintext_length = (status == PSA_SUCCESS) ? length : 0;
+
+    return status;
+}
+
+psa_status_t psa_tls_record_abort(uint32_t *connection)
+{
+    psa_status_t status;
+    psa_invec in_vec[] = {
+        {connection, sizeof(*connection)}
+    };
+
+    status = psa_call(TFM_TLS_RECORD_ABORT_HANDLE, PSA_IPC_CALL,
+                      in_vec, IOVEC_LEN(in_vec), NULL, 0);
+
+    *connection = TFM_TLS_RECORD_INVALID_HANDLE;
+
+    return status;
+}
@@ -56,8 +56,15 @@
 #endif // DEBUG
 
 
-int mbedtls_hardware_poll( void *data,
-                           unsigned char *output, size_t len, size_t *olen )
+#if CC_RND_TRNG_POOL_SIZE_BYTES > 0
+/* Entropy collected ahead of time by CC_RndTrngPoolRefill(). It is consumed
+ * from the end, and the consumed bytes are cleared. */
+static unsigned char trngPool[CC_RND_TRNG_POOL_SIZE_BYTES];
+static size_t trngPoolLen = 0;
+#endif
+
+/* Collects up to len bytes from the TRNG. This waits for the TRNG. */
+static int trngCollect( unsigned char *output, size_t len, size_t *olen )
 {
     CCRndWorkBuff_t  *rndWorkBuff_ptr;
     CCRndState_t rndState;
@@ -65,25 +72,6 @@ int mbedtls_hardware_poll( void *data,
     int ret, Error = 0;
     uint32_t  *entrSource_ptr;
 
-    CC_UNUSED_PARAM(data);
-
-    if ( NULL == output )
-    {
-        CC_PAL_LOG_ERR( "output cannot be NULL\n" );
-        GOTO_END( -1 );
-    }
-    if ( NULL == olen )
-    {
-        CC_PAL_LOG_ERR( "olen cannot be NULL\n" );
-        GOTO_END( -1 );
-
-    }
-    if ( 0 == len )
-    {
-        CC_PAL_LOG_ERR( "len cannot be zero\n" );
-        GOTO_END( -1 );
-    }
-
     rndWorkBuff_ptr = ( CCRndWorkBuff_t * )mbedtls_calloc( 1, sizeof ( CCRndWorkBuff_t ) );
     if ( NULL == rndWorkBuff_ptr )
     {
@@ -129,3 +117,71 @@ Cleanup:
 End:
     return Error;
 }
+
+int mbedtls_hardware_poll( void *data,
+                           unsigned char *output, size_t len, size_t *olen )
+{
+    int Error = 0;
+
+    CC_UNUSED_PARAM(data);
+
+    if ( NULL == output )
+    {
+        CC_PAL_LOG_ERR( "output cannot be NULL\n" );
+        GOTO_END( -1 );
+    }
+    if ( NULL == olen )
+    {
+        CC_PAL_LOG_ERR( "olen cannot be NULL\n" );
+        GOTO_END( -1 );
+
+    }
+    if ( 0 == len )
+    {
+        CC_PAL_LOG_ERR( "len cannot be zero\n" );
+        GOTO_END( -1 );
+    }
+
+#if CC_RND_TRNG_POOL_SIZE_BYTES > 0
+    /* Serve the request from the pool when it has entropy, the entropy
+     * module polls again if it needs more. */
+    if ( trngPoolLen > 0 )
+    {
+        if ( len > trngPoolLen )
+        {
+            len = trngPoolLen;
+        }
+        trngPoolLen -= len;
+        CC_PalMemCopy( output, trngPool + trngPoolLen, len );
+        mbedtls_zeroize_internal( trngPool + trngPoolLen, len );
+        *olen = len;
+        return 0;
+    }
+#endif
+
+    return trngCollect( output, len, olen );
+
+End:
+    return Error;
+}
+
+int CC_RndTrngPoolRefill( void )
+{
+#if CC_RND_TRNG_POOL_SIZE_BYTES > 0
+    size_t olen = 0;
+
+    if ( trngPoolLen == sizeof( trngPool ) )
+    {
+        return 0;
+    }
+
+    if ( trngCollect( trngPool + trngPoolLen, sizeof( trngPool ) - trngPoolLen,
+                      &olen ) != 0 )
+    {
+        return -1;
+    }
+    trngPoolLen += olen;
+#endif
+
+    return 0;
+}
@@ -6,20 +6,38 @@
 
 #include "cc_pal_types.h"
 
+/* Number of operations in progress in CryptoCell. There is no concurrent
+ * caller without an OS, so the counter is not protected. */
+static int32_t g_pmCntr;
 
 void CC_PalPowerSaveModeInit(void)
 {
+    g_pmCntr = 0;
     return;
 }
 
-void CC_PalPowerSaveModeStatus(void)
+int32_t CC_PalPowerSaveModeStatus(void)
 {
-    return;
+    return g_pmCntr;
 }
 
 CCError_t CC_PalPowerSaveModeSelect(CCBool isPowerSaveMode)
 {
-    CC_UNUSED_PARAM(isPowerSaveMode);
+    switch (isPowerSaveMode){
+    case CC_FALSE:
+        g_pmCntr++;
+        break;
+    case CC_TRUE:
+        g_pmCntr--;
+        break;
+    default:
+        return CC_FAIL;
+    }
+
+    if(g_pmCntr < 0 ){
+        /* illegal state - exit with error */
+        return CC_FAIL;
+    }
 
-    return 0;
+    return CC_OK;
 }
@@ -103,6 +103,12 @@ typedef struct
 #define CC_RND_TRNG_SRC_INNER_OFFSET_BYTES    (CC_RND_TRNG_SRC_INNER_OFFSET_WORDS*sizeof(uint32_t))
 
 
+/*! The size of the TRNG entropy pool in bytes, 0 to disable the pool. */
+#ifndef CC_RND_TRNG_POOL_SIZE_BYTES
+#define CC_RND_TRNG_POOL_SIZE_BYTES    64
+#endif
+
+
 /************************ Enumerators  ****************************/
 
 /*! The definition of the random operation modes. */
@@ -236,6 +242,21 @@ CCError_t CC_RndSetGenerateVectorFunc(
 
 
 
+/****************************************************************************************/
+/*!
+ @brief This function tops up the TRNG entropy pool.
+
+ The entropy source of Mbed TLS (\c mbedtls_hardware_poll) is served from the
+ pool while it has entropy, and only waits for the TRNG once it is empty.
+ This function should be called when waiting for the TRNG is harmless, for
+ example when the caller has no request to serve.
+
+ @return \c 0 on success.
+ @return A non-zero value on failure.
+ */
+int CC_RndTrngPoolRefill(void);
+
+
 #ifdef __cplusplus
 }
 #endif
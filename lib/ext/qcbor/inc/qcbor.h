@@ -120,8 +120,8 @@ extern "C" {
  double if size_t was used instead.
 
  Size approximation (varies with CPU/compiler):
-    64-bit machine: (15 + 1) * (4 + 2 + 1 + 1 pad) + 8 = 136 bytes
-    32-bit machine: (15 + 1) * (4 + 2 + 1 + 1 pad) + 4 = 132 bytes
+    64-bit machine: (15 + 1) * (4 + 2 + 2 + 1 + 1 + 2 pad) + 8 = 200 bytes
+    32-bit machine: (15 + 1) * (4 + 2 + 2 + 1 + 1 + 2 pad) + 4 = 196 bytes
 */
 typedef struct __QCBORTrackNesting {
    // PRIVATE DATA STRUCTURE
@@ -130,7 +130,10 @@ typedef struct __QCBORTrackNesting {
       uint32_t  uStart;   // uStart is the byte position where the array starts
       uint16_t  uCount;   // Number of items in the arrary or map; counts items
                           // in a map, not pairs of items
+      uint16_t  uFixedCount; // Number of items given when opened with a
+                             // count; counts items in a map, not pairs
       uint8_t   uMajorType; // Indicates if item is a map or an array
+      uint8_t   bFixedCount; // Head already encoded when opened with a count
    } pArrays[QCBOR_MAX_ARRAY_NESTING1+1], // stored state for the nesting levels
    *pCurrentNesting; // the current nesting level
 } QCBORTrackNesting;
@@ -143,8 +146,8 @@ typedef struct __QCBORTrackNesting {
  form a public "object" that does the job of encdoing.
 
  Size approximation (varies with CPU/compiler):
-   64-bit machine: 27 + 1 (+ 4 padding) + 136 = 32 + 136 = 168 bytes
-   32-bit machine: 15 + 1 + 132 = 148 bytes
+   64-bit machine: 27 + 1 (+ 4 padding) + 200 = 32 + 200 = 232 bytes
+   32-bit machine: 15 + 1 + 196 = 212 bytes
 */
 struct _QCBOREncodeContext {
    // PRIVATE DATA STRUCTURE
@@ -781,7 +784,13 @@ typedef enum {
     should be treated as such. The strange situation is a CPU with a very
     small size_t (e.g., a 16-bit CPU) and a large string (e.g., > 65KB).
     */
-    QCBOR_ERR_STRING_TOO_LONG = 24
+    QCBOR_ERR_STRING_TOO_LONG = 24,
+
+   /** During encoding, an array or map opened with
+       QCBOREncode_OpenArrayWithCount() or QCBOREncode_OpenMapWithCount()
+       was closed with a different number of items than given when it
+       was opened. */
+   QCBOR_ERR_ITEM_COUNT_MISMATCH = 25
 
 } QCBORError;
 
@@ -1857,6 +1866,32 @@ static void QCBOREncode_OpenArrayInMapN(QCBOREncodeContext *pCtx,  int64_t nLabe
 static void QCBOREncode_CloseArray(QCBOREncodeContext *pCtx);
 
 
+/**
+ @brief  Indicates that the next items added are in an array of known
+         length.
+
+ @param[in] pCtx    The encoding context to open the array in.
+ @param[in] uCount  The number of items that will be added to the array.
+
+ This is the same as QCBOREncode_OpenArray() except that the array
+ head is encoded right away from @c uCount. QCBOREncode_CloseArray()
+ then has nothing to insert, so the items encoded in the array are
+ not moved in the output buffer when it is closed. This saves a copy
+ of the whole content of the array, which adds up for large or deeply
+ nested arrays.
+
+ The encoded CBOR is the same as with QCBOREncode_OpenArray(). If the
+ number of items added is not @c uCount, @ref
+ QCBOR_ERR_ITEM_COUNT_MISMATCH will be returned when
+ QCBOREncode_Finish() is called.
+ */
+static void QCBOREncode_OpenArrayWithCount(QCBOREncodeContext *pCtx, uint16_t uCount);
+
+static void QCBOREncode_OpenArrayWithCountInMap(QCBOREncodeContext *pCtx, const char *szLabel, uint16_t uCount);
+
+static void QCBOREncode_OpenArrayWithCountInMapN(QCBOREncodeContext *pCtx, int64_t nLabel, uint16_t uCount);
+
+
 /**
  @brief  Indicates that the next items added are in a map.
 
@@ -1918,6 +1953,26 @@ static void QCBOREncode_OpenMapInMapN(QCBOREncodeContext *pCtx, int64_t nLabel);
 static void QCBOREncode_CloseMap(QCBOREncodeContext *pCtx);
 
 
+/**
+ @brief  Indicates that the next items added are in a map of known
+         length.
+
+ @param[in] pCtx    The encoding context to open the map in.
+ @param[in] uCount  The number of label/value pairs that will be added
+                    to the map.
+
+ This is the same as QCBOREncode_OpenMap() except that the map head is
+ encoded right away from @c uCount, so the items encoded in the map
+ are not moved in the output buffer when it is closed. See
+ QCBOREncode_OpenArrayWithCount().
+ */
+static void QCBOREncode_OpenMapWithCount(QCBOREncodeContext *pCtx, uint16_t uCount);
+
+static void QCBOREncode_OpenMapWithCountInMap(QCBOREncodeContext *pCtx, const char *szLabel, uint16_t uCount);
+
+static void QCBOREncode_OpenMapWithCountInMapN(QCBOREncodeContext *pCtx, int64_t nLabel, uint16_t uCount);
+
+
 /**
  @brief Indicate start of encoded CBOR to be wrapped in a bstr.
 
@@ -2575,6 +2630,22 @@ int QCBORDecode_IsTagged(QCBORDecodeContext *pCtx, const QCBORItem *pItem, uint6
 QCBORError QCBORDecode_Finish(QCBORDecodeContext *pCtx);
 
 
+/**
+ Get the offset in the input of the next data item to be decoded.
+
+ @param[in]  pCtx  The decoder context.
+
+ @return The offset from the start of the input given to
+         QCBORDecode_Init(), in bytes.
+
+ After QCBORDecode_GetNext() returns a non-empty definite-length
+ array or map, this is the offset of its first member. The encoded input from there can be
+ passed to QCBORDecode_Init() to decode the members again without
+ decoding what comes before them.
+ */
+size_t QCBORDecode_Tell(QCBORDecodeContext *pCtx);
+
+
 
 
 /**
@@ -2732,6 +2803,19 @@ void QCBOREncode_AddBuffer(QCBOREncodeContext *pCtx, uint8_t uMajorType, UsefulB
 void QCBOREncode_OpenMapOrArray(QCBOREncodeContext *pCtx, uint8_t uMajorType);
 
 
+/**
+ @brief Semi-private method to open a map or array of known length
+
+ @param[in] pCtx        The context to add to.
+ @param[in] uMajorType  The major CBOR type to open
+ @param[in] uCount      The number of items, or of pairs for a map
+
+ Call QCBOREncode_OpenArrayWithCount() or
+ QCBOREncode_OpenMapWithCount() instead of this.
+ */
+void QCBOREncode_OpenMapOrArrayWithCount(QCBOREncodeContext *pCtx, uint8_t uMajorType, uint16_t uCount);
+
+
 /**
  @brief Semi-private method to open a map, array with indefinite length
 
@@ -3388,6 +3472,23 @@ static inline void QCBOREncode_CloseArray(QCBOREncodeContext *pCtx)
    QCBOREncode_CloseMapOrArray(pCtx, CBOR_MAJOR_TYPE_ARRAY, NULL);
 }
 
+static inline void QCBOREncode_OpenArrayWithCount(QCBOREncodeContext *pCtx, uint16_t uCount)
+{
+   QCBOREncode_OpenMapOrArrayWithCount(pCtx, CBOR_MAJOR_TYPE_ARRAY, uCount);
+}
+
+static inline void QCBOREncode_OpenArrayWithCountInMap(QCBOREncodeContext *pCtx, const char *szLabel, uint16_t uCount)
+{
+   QCBOREncode_AddSZString(pCtx, szLabel);
+   QCBOREncode_OpenArrayWithCount(pCtx, uCount);
+}
+
+static inline void QCBOREncode_OpenArrayWithCountInMapN(QCBOREncodeContext *pCtx, int64_t nLabel, uint16_t uCount)
+{
+   QCBOREncode_AddInt64(pCtx, nLabel);
+   QCBOREncode_OpenArrayWithCount(pCtx, uCount);
+}
+
 
 static inline void QCBOREncode_OpenMap(QCBOREncodeContext *pCtx)
 {
@@ -3411,6 +3512,23 @@ static inline void QCBOREncode_CloseMap(QCBOREncodeContext *pCtx)
    QCBOREncode_CloseMapOrArray(pCtx, CBOR_MAJOR_TYPE_MAP, NULL);
 }
 
+static inline void QCBOREncode_OpenMapWithCount(QCBOREncodeContext *pCtx, uint16_t uCount)
+{
+   QCBOREncode_OpenMapOrArrayWithCount(pCtx, CBOR_MAJOR_TYPE_MAP, uCount);
+}
+
+static inline void QCBOREncode_OpenMapWithCountInMap(QCBOREncodeContext *pCtx, const char *szLabel, uint16_t uCount)
+{
+   QCBOREncode_AddSZString(pCtx, szLabel);
+   QCBOREncode_OpenMapWithCount(pCtx, uCount);
+}
+
+static inline void QCBOREncode_OpenMapWithCountInMapN(QCBOREncodeContext *pCtx, int64_t nLabel, uint16_t uCount)
+{
+   QCBOREncode_AddInt64(pCtx, nLabel);
+   QCBOREncode_OpenMapWithCount(pCtx, uCount);
+}
+
 static inline void QCBOREncode_OpenArrayIndefiniteLength(QCBOREncodeContext *pCtx)
 {
    QCBOREncode_OpenMapOrArrayIndefiniteLength(pCtx, CBOR_MAJOR_NONE_TYPE_ARRAY_INDEFINITE_LEN);
@@ -1533,6 +1533,15 @@ Done:
 }
 
 
+/*
+ Public function, see header qcbor.h file
+ */
+size_t QCBORDecode_Tell(QCBORDecodeContext *me)
+{
+   return UsefulInputBuf_Tell(&(me->InBuf));
+}
+
+
 
 /*
 
@@ -116,9 +116,10 @@ inline static QCBORError Nesting_Increase(QCBORTrackNesting *pNesting,
       nReturn = QCBOR_ERR_ARRAY_NESTING_TOO_DEEP;
    } else {
       pNesting->pCurrentNesting++;
-      pNesting->pCurrentNesting->uCount     = 0;
-      pNesting->pCurrentNesting->uStart     = uPos;
-      pNesting->pCurrentNesting->uMajorType = uMajorType;
+      pNesting->pCurrentNesting->uCount      = 0;
+      pNesting->pCurrentNesting->uStart      = uPos;
+      pNesting->pCurrentNesting->uMajorType  = uMajorType;
+      pNesting->pCurrentNesting->bFixedCount = false;
    }
    return nReturn;
 }
@@ -172,6 +173,25 @@ inline static bool Nesting_IsInNest(QCBORTrackNesting *pNesting)
    return pNesting->pCurrentNesting == &pNesting->pArrays[0] ? false : true;
 }
 
+inline static void Nesting_SetFixedCount(QCBORTrackNesting *pNesting,
+                                         uint16_t uFixedCount)
+{
+   pNesting->pCurrentNesting->uFixedCount = uFixedCount;
+   pNesting->pCurrentNesting->bFixedCount = true;
+}
+
+inline static bool Nesting_IsFixedCount(QCBORTrackNesting *pNesting)
+{
+   return pNesting->pCurrentNesting->bFixedCount ? true : false;
+}
+
+inline static bool Nesting_IsFixedCountMet(QCBORTrackNesting *pNesting)
+{
+   // Both count individual items, so a map with a label missing its
+   // value does not match
+   return pNesting->pCurrentNesting->uCount == pNesting->pCurrentNesting->uFixedCount;
+}
+
 
 
 
@@ -649,6 +669,39 @@ void QCBOREncode_OpenMapOrArray(QCBOREncodeContext *me, uint8_t uMajorType)
 }
 
 
+/*
+ Semi-public function. It is exposed to user of the interface,
+ but they will usually call one of the inline wrappers rather than this.
+
+ See qcbor.h
+*/
+void QCBOREncode_OpenMapOrArrayWithCount(QCBOREncodeContext *me,
+                                         uint8_t uMajorType,
+                                         uint16_t uCount)
+{
+   // Maps count label/value pairs, the nesting counts individual items
+   const uint32_t uItems = uMajorType == CBOR_MAJOR_TYPE_MAP ? 2 * (uint32_t)uCount
+                                                             : uCount;
+
+   if(uItems >= QCBOR_MAX_ITEMS_IN_ARRAY - 1) {
+      me->uError = QCBOR_ERR_ARRAY_TOO_LONG;
+      return;
+   }
+
+   QCBOREncode_OpenMapOrArray(me, uMajorType);
+   if(me->uError == QCBOR_SUCCESS) {
+      /*
+       The head goes at the start position recorded for the nesting
+       level, which is the current end of the output buffer. As it is
+       appended now, nothing needs to be inserted and slid to the right
+       when the map or array is closed.
+       */
+      AppendEncodedTypeAndNumber(me, uMajorType, uCount);
+      Nesting_SetFixedCount(&(me->nesting), (uint16_t)uItems);
+   }
+}
+
+
 /*
  Semi-public function. It is exposed to user of the interface,
  but they will usually call one of the inline wrappers rather than this.
@@ -676,6 +729,20 @@ void QCBOREncode_CloseMapOrArray(QCBOREncodeContext *me,
          me->uError = QCBOR_ERR_TOO_MANY_CLOSES;
       } else if(Nesting_GetMajorType(&(me->nesting)) != uMajorType) {
          me->uError = QCBOR_ERR_CLOSE_MISMATCH;
+      } else if(Nesting_IsFixedCount(&(me->nesting))) {
+         /*
+          The head was encoded when the map or array was opened with a
+          count, there is nothing to insert.
+          */
+         if(!Nesting_IsFixedCountMet(&(me->nesting))) {
+            me->uError = QCBOR_ERR_ITEM_COUNT_MISMATCH;
+         } else {
+            if(pWrappedCBOR) {
+               const UsefulBufC PartialResult = UsefulOutBuf_OutUBuf(&(me->OutBuf));
+               *pWrappedCBOR = UsefulBuf_Tail(PartialResult, Nesting_GetStartPos(&(me->nesting)));
+            }
+            Nesting_Decrease(&(me->nesting));
+         }
       } else {
          /*
           When the array, map or bstr wrap was started, nothing was
@@ -737,7 +804,8 @@ void QCBOREncode_CloseMapOrArrayIndefiniteLength(QCBOREncodeContext *me,
    if(me->uError == QCBOR_SUCCESS) {
       if(!Nesting_IsInNest(&(me->nesting))) {
          me->uError = QCBOR_ERR_TOO_MANY_CLOSES;
-      } else if(Nesting_GetMajorType(&(me->nesting)) != uMajorType) {
+      } else if(Nesting_GetMajorType(&(me->nesting)) != uMajorType ||
+                Nesting_IsFixedCount(&(me->nesting))) {
          me->uError = QCBOR_ERR_CLOSE_MISMATCH;
       } else {
          // insert the break marker (0xff for both arrays and maps)
@@ -1168,6 +1168,88 @@ int32_t EncodeLengthThirtyoneTest()
 }
 
 
+/*
+ Same encoding as EncodeLengthThirtyoneTest() with the maps and arrays
+ opened with their counts, plus the error cases of the counts.
+ */
+int32_t EncodeWithCountTest()
+{
+   QCBOREncodeContext ECtx;
+   UsefulBufC ECBOR;
+
+   QCBOREncode_Init(&ECtx, UsefulBuf_FROM_BYTE_ARRAY(spBigBuf));
+   QCBOREncode_OpenMapWithCount(&ECtx, 5);
+
+   QCBOREncode_OpenArrayWithCountInMap(&ECtx, "arr", 31);
+   for (size_t ix = 0; ix < 31; ix++) {
+      QCBOREncode_AddInt64(&ECtx, (int64_t)ix);
+   }
+   QCBOREncode_CloseArray(&ECtx);
+
+   QCBOREncode_OpenMapWithCountInMap(&ECtx, "map", 31);
+   for (int ix = 0; ix < 31; ix++) {
+      int c = 'a';
+      if (ix < 26) c = c + ix;
+      else c = 'A' + (ix - 26);
+      char buffer[2] = { (char)c, 0 };
+      QCBOREncode_AddInt64ToMap(&ECtx, buffer, ix);
+   }
+   QCBOREncode_CloseMap(&ECtx);
+
+   QCBOREncode_AddInt64ToMap(&ECtx, "min31", -31);
+   QCBOREncode_AddInt64ToMap(&ECtx, "plus31", 31);
+
+   const char *str = "testtesttesttesttesttestqcbor11";
+   UsefulBufC str_b = { str, 31 };
+   QCBOREncode_AddTextToMap(&ECtx, "str", str_b);
+
+   QCBOREncode_CloseMap(&ECtx);
+
+   if(QCBOREncode_Finish(&ECtx, &ECBOR)) {
+      return -1;
+   }
+
+   if(CheckResults(ECBOR, EncodeLengthThirtyone))
+      return -2;
+
+   // Fewer items than the count
+   QCBOREncode_Init(&ECtx, UsefulBuf_FROM_BYTE_ARRAY(spBigBuf));
+   QCBOREncode_OpenArrayWithCount(&ECtx, 2);
+   QCBOREncode_AddInt64(&ECtx, 1);
+   QCBOREncode_CloseArray(&ECtx);
+   if(QCBOREncode_Finish(&ECtx, &ECBOR) != QCBOR_ERR_ITEM_COUNT_MISMATCH) {
+      return -3;
+   }
+
+   // A map label without its value
+   QCBOREncode_Init(&ECtx, UsefulBuf_FROM_BYTE_ARRAY(spBigBuf));
+   QCBOREncode_OpenMapWithCount(&ECtx, 1);
+   QCBOREncode_AddInt64ToMapN(&ECtx, 1, 1);
+   QCBOREncode_AddInt64(&ECtx, 2);
+   QCBOREncode_CloseMap(&ECtx);
+   if(QCBOREncode_Finish(&ECtx, &ECBOR) != QCBOR_ERR_ITEM_COUNT_MISMATCH) {
+      return -4;
+   }
+
+   // Closed as an indefinite length array
+   QCBOREncode_Init(&ECtx, UsefulBuf_FROM_BYTE_ARRAY(spBigBuf));
+   QCBOREncode_OpenArrayWithCount(&ECtx, 0);
+   QCBOREncode_CloseArrayIndefiniteLength(&ECtx);
+   if(QCBOREncode_Finish(&ECtx, &ECBOR) != QCBOR_ERR_CLOSE_MISMATCH) {
+      return -5;
+   }
+
+   // Too many items for an array
+   QCBOREncode_Init(&ECtx, UsefulBuf_FROM_BYTE_ARRAY(spBigBuf));
+   QCBOREncode_OpenMapWithCount(&ECtx, QCBOR_MAX_ITEMS_IN_ARRAY / 2);
+   if(QCBOREncode_Finish(&ECtx, &ECBOR) != QCBOR_ERR_ARRAY_TOO_LONG) {
+      return -6;
+   }
+
+   return 0;
+}
+
+
 /*
  83                                      # array(3)
    C0                                   # tag(0)
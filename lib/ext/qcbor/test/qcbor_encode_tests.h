@@ -124,6 +124,12 @@ int32_t SimpleValuesIndefiniteLengthTest1(void);
 int32_t EncodeLengthThirtyoneTest(void);
 
 
+/*
+ Encodes maps and arrays opened with their counts
+ */
+int32_t EncodeWithCountTest(void);
+
+
 /*
  Encodes most data formats that are supported */
 int32_t EncodeDateTest(void);
@@ -264,3 +264,120 @@ Done:
     return return_value;
 }
 
+
+/*
+ * Public function. See qcbor_util.h
+ */
+enum attest_token_err_t
+qcbor_util_index_map(struct q_useful_buf_c payload,
+                     struct qcbor_util_map_index_t *index)
+{
+    QCBORDecodeContext             decode_context;
+    QCBORItem                      item;
+    struct qcbor_util_map_entry_t *entry;
+    enum attest_token_err_t        return_value;
+    QCBORError                     cbor_error;
+    uint_fast8_t                   map_nest_level;
+    uint_fast8_t                   next_nest_level;
+
+    index->map = payload;
+    index->num_entries = 0;
+
+    if(q_useful_buf_c_is_null(payload)) {
+        return_value = ATTEST_TOKEN_ERR_COSE_SIGN1_VALIDATION;
+        goto Done;
+    }
+
+    QCBORDecode_Init(&decode_context, payload, QCBOR_DECODE_MODE_NORMAL);
+
+    /* Get the data item that is the map that is being indexed */
+    QCBORDecode_GetNext(&decode_context, &item);
+    if(item.uDataType != QCBOR_TYPE_MAP) {
+        return_value = ATTEST_TOKEN_ERR_CBOR_STRUCTURE;
+        goto Done;
+    }
+
+    /* See qcbor_util_get_items_in_map() for the use of nest levels */
+    map_nest_level  = item.uNestingLevel;
+    next_nest_level = item.uNextNestLevel;
+
+    while(next_nest_level > map_nest_level) {
+        if(QCBORDecode_GetNext(&decode_context, &item) != QCBOR_SUCCESS) {
+            return_value = ATTEST_TOKEN_ERR_CBOR_NOT_WELL_FORMED;
+            goto Done;
+        }
+
+        if(item.uLabelType == QCBOR_TYPE_INT64 &&
+           item.label.int64 >= INT32_MIN && item.label.int64 <= INT32_MAX) {
+            if(index->num_entries >= QCBOR_UTIL_MAP_INDEX_MAX_ITEMS) {
+                return_value = ATTEST_TOKEN_ERR_INSUFFICIENT_MEMORY;
+                goto Done;
+            }
+
+            entry = &index->entries[index->num_entries++];
+            memset(entry, 0, sizeof(*entry));
+            entry->label     = (int32_t)item.label.int64;
+            entry->data_type = item.uDataType;
+
+            switch(item.uDataType) {
+            case QCBOR_TYPE_BYTE_STRING:
+            case QCBOR_TYPE_TEXT_STRING:
+                entry->val.string = item.val.string;
+                break;
+            case QCBOR_TYPE_INT64:
+                entry->val.int64 = item.val.int64;
+                break;
+            case QCBOR_TYPE_UINT64:
+                entry->val.uint64 = item.val.uint64;
+                break;
+            case QCBOR_TYPE_ARRAY:
+            case QCBOR_TYPE_MAP:
+                entry->count  = item.val.uCount;
+                entry->offset = (uint32_t)QCBORDecode_Tell(&decode_context);
+                break;
+            default:
+                break;
+            }
+        }
+
+        if(qcbor_util_consume_item(&decode_context, &item, &next_nest_level)) {
+            return_value = ATTEST_TOKEN_ERR_CBOR_NOT_WELL_FORMED;
+            goto Done;
+        }
+    }
+
+    cbor_error = QCBORDecode_Finish(&decode_context);
+    if(cbor_error == QCBOR_ERR_ARRAY_OR_MAP_STILL_OPEN) {
+        return_value = ATTEST_TOKEN_ERR_CBOR_STRUCTURE;
+    } else if(cbor_error != QCBOR_SUCCESS) {
+        /* This is usually due to extra bytes at the end */
+        return_value = ATTEST_TOKEN_ERR_CBOR_NOT_WELL_FORMED;
+    } else {
+        return_value = ATTEST_TOKEN_ERR_SUCCESS;
+    }
+
+Done:
+    if(return_value != ATTEST_TOKEN_ERR_SUCCESS) {
+        index->num_entries = 0;
+    }
+    return return_value;
+}
+
+
+/*
+ * Public function. See qcbor_util.h
+ */
+const struct qcbor_util_map_entry_t *
+qcbor_util_find_in_map_index(const struct qcbor_util_map_index_t *index,
+                             int32_t label)
+{
+    uint32_t i;
+
+    for(i = index->num_entries; i > 0; i--) {
+        if(index->entries[i - 1].label == label) {
+            return &index->entries[i - 1];
+        }
+    }
+
+    return NULL;
+}
@@ -228,6 +228,100 @@ qcbor_util_get_top_level_item_in_map(struct q_useful_buf_c payload,
                                      QCBORItem *item);
 
 
+/**
+ * The maximum number of integer-labeled items recorded by
+ * qcbor_util_index_map().
+ */
+#ifndef QCBOR_UTIL_MAP_INDEX_MAX_ITEMS
+#define QCBOR_UTIL_MAP_INDEX_MAX_ITEMS 16
+#endif
+
+
+/**
+ * One top-level integer-labeled item of a map, as recorded by
+ * qcbor_util_index_map().
+ */
+struct qcbor_util_map_entry_t {
+    /** The integer label of the item. */
+    int32_t  label;
+    /** One of \c QCBOR_TYPE_xxx, the type of the item. */
+    uint8_t  data_type;
+    /** For arrays and maps, the number of members. */
+    uint16_t count;
+    /** For arrays and maps, the offset of the first member from the
+     *  start of the indexed map. */
+    uint32_t offset;
+    /** The value of the item for strings and integers. */
+    union {
+        struct q_useful_buf_c string;
+        int64_t               int64;
+        uint64_t              uint64;
+    } val;
+};
+
+
+/**
+ * The index of the top-level integer-labeled items of a map. Filled
+ * in by qcbor_util_index_map().
+ */
+struct qcbor_util_map_index_t {
+    /** The encoded map which was indexed. */
+    struct q_useful_buf_c         map;
+    /** The number of entries used in \c entries. */
+    uint32_t                      num_entries;
+    /** The items in the order they are in the map. */
+    struct qcbor_util_map_entry_t entries[QCBOR_UTIL_MAP_INDEX_MAX_ITEMS];
+};
+
+
+/**
+ * \brief Decode a map once, recording all its top-level
+ *        integer-labeled items.
+ *
+ * \param[in] payload  Encoded map to index.
+ * \param[out] index   The index to fill in.
+ *
+ * \retval ATTEST_TOKEN_ERR_SUCCESS
+ *         The whole map was indexed.
+ * \retval ATTEST_TOKEN_ERR_CBOR_NOT_WELL_FORMED
+ *         CBOR was not well-formed.
+ * \retval ATTEST_TOKEN_ERR_CBOR_STRUCTURE
+ *         A map was expected.
+ * \retval ATTEST_TOKEN_ERR_INSUFFICIENT_MEMORY
+ *         The map has more than \ref QCBOR_UTIL_MAP_INDEX_MAX_ITEMS
+ *         integer-labeled items.
+ *
+ * This does the same checks of \c payload as
+ * qcbor_util_get_top_level_item_in_map(). After it succeeded, each
+ * item is found with qcbor_util_find_in_map_index() without decoding
+ * \c payload again. The members of a labeled array or map can be
+ * decoded on their own by passing \c payload from the \c offset of
+ * its entry to \c QCBORDecode_Init().
+ *
+ * Strings are not copied, \c payload must stay valid as long as the
+ * index is used.
+ */
+enum attest_token_err_t
+qcbor_util_index_map(struct q_useful_buf_c payload,
+                     struct qcbor_util_map_index_t *index);
+
+
+/**
+ * \brief Find a labeled item in an index made by
+ *        qcbor_util_index_map().
+ *
+ * \param[in] index  The index to search.
+ * \param[in] label  Integer label of item to look for.
+ *
+ * \return The entry of the item, or \c NULL if it is not in the map.
+ *         If \c label occurs several times, the last one is returned,
+ *         like qcbor_util_get_items_in_map() does.
+ */
+const struct qcbor_util_map_entry_t *
+qcbor_util_find_in_map_index(const struct qcbor_util_map_index_t *index,
+                             int32_t label);
+
+
 #ifdef __cplusplus
 }
 #endif
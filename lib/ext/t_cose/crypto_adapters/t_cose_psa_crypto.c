@@ -407,3 +407,93 @@ t_cose_crypto_hash_finish(struct t_cose_crypto_hash *hash_ctx,
 Done:
     return psa_status_to_t_cose_error_hash(hash_ctx->status);
 }
+
+
+/**
+ * \brief Map a PSA error into a t_cose error for MACs.
+ *
+ * \param[in] status   The PSA status.
+ *
+ * \return The \ref t_cose_err_t.
+ */
+static enum t_cose_err_t
+psa_status_to_t_cose_error_hmac(psa_status_t status)
+{
+    return status == PSA_SUCCESS                   ? T_COSE_SUCCESS :
+           status == PSA_ERROR_NOT_SUPPORTED       ? T_COSE_ERR_UNSUPPORTED_SIGNING_ALG :
+           status == PSA_ERROR_INVALID_ARGUMENT    ? T_COSE_ERR_WRONG_TYPE_OF_KEY :
+           status == PSA_ERROR_INVALID_HANDLE      ? T_COSE_ERR_UNKNOWN_KEY :
+           status == PSA_ERROR_BUFFER_TOO_SMALL    ? T_COSE_ERR_SIG_BUFFER_SIZE :
+           status == PSA_ERROR_INSUFFICIENT_MEMORY ? T_COSE_ERR_INSUFFICIENT_MEMORY :
+           status == PSA_ERROR_TAMPERING_DETECTED  ? T_COSE_ERR_TAMPERING_DETECTED :
+                                                     T_COSE_ERR_SIG_FAIL;
+}
+
+
+/*
+ * See documentation in t_cose_crypto.h
+ */
+enum t_cose_err_t
+t_cose_crypto_hmac_sign_setup(struct t_cose_crypto_hmac *hmac_ctx,
+                              struct t_cose_key          signing_key,
+                              int32_t                    cose_alg_id)
+{
+    /* Only HMAC 256/256 is supported, which is enough for the short
+     * symmetric tokens it is used for.
+     */
+    if(cose_alg_id != COSE_ALGORITHM_HMAC256) {
+        return T_COSE_ERR_UNSUPPORTED_SIGNING_ALG;
+    }
+
+    hmac_ctx->ctx = psa_mac_operation_init();
+
+    hmac_ctx->status = psa_mac_sign_setup(&(hmac_ctx->ctx),
+                                          (psa_key_handle_t)signing_key.k.key_handle,
+                                          PSA_ALG_HMAC(PSA_ALG_SHA_256));
+
+    return psa_status_to_t_cose_error_hmac(hmac_ctx->status);
+}
+
+
+/*
+ * See documentation in t_cose_crypto.h
+ */
+void
+t_cose_crypto_hmac_update(struct t_cose_crypto_hmac *hmac_ctx,
+                          struct q_useful_buf_c      payload)
+{
+    if(hmac_ctx->status != PSA_SUCCESS) {
+        /* In error state. Nothing to do. */
+        return;
+    }
+
+    hmac_ctx->status = psa_mac_update(&(hmac_ctx->ctx),
+                                      payload.ptr,
+                                      payload.len);
+}
+
+
+/*
+ * See documentation in t_cose_crypto.h
+ */
+enum t_cose_err_t
+t_cose_crypto_hmac_sign_finish(struct t_cose_crypto_hmac *hmac_ctx,
+                               struct q_useful_buf        tag_buf,
+                               struct q_useful_buf_c     *tag)
+{
+    if(hmac_ctx->status != PSA_SUCCESS) {
+        /* Error state. Release the operation and report it */
+        (void)psa_mac_abort(&(hmac_ctx->ctx));
+        goto Done;
+    }
+
+    hmac_ctx->status = psa_mac_sign_finish(&(hmac_ctx->ctx),
+                                           tag_buf.ptr,
+                                           tag_buf.len,
+                                         &(tag->len));
+
+    tag->ptr = tag_buf.ptr;
+
+Done:
+    return psa_status_to_t_cose_error_hmac(hmac_ctx->status);
+}
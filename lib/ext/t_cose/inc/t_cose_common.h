@@ -88,6 +88,19 @@ extern "C" {
  */
 #define T_COSE_ALGORITHM_ES512 -36
 
+/**
+ * \def T_COSE_ALGORITHM_HMAC256
+ *
+ * \brief Indicates HMAC with SHA-256, with the tag truncated to 256 bits.
+ *
+ * This value comes from the
+ * [IANA COSE Registry](https://www.iana.org/assignments/cose/cose.xhtml).
+ *
+ * This is a symmetric algorithm, only used to create \c COSE_Mac0
+ * messages with t_cose_mac0_sign.h.
+ */
+#define T_COSE_ALGORITHM_HMAC256 5
+
 
 
 
@@ -0,0 +1,159 @@
+/*
+ * t_cose_mac0_sign.h
+ *
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * See BSD-3-Clause license in README.md
+ */
+
+#ifndef __T_COSE_MAC0_H__
+#define __T_COSE_MAC0_H__
+
+#include <stdint.h>
+#include <string.h>
+#include "qcbor.h"
+#include "t_cose_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * \file t_cose_mac0_sign.h
+ *
+ * \brief Create a \c COSE_Mac0 message, usually for EAT or CWT Token.
+ *
+ * This creates a \c COSE_Mac0 message in compliance with
+ * [COSE (RFC 8152)](https://tools.ietf.org/html/rfc8152), section
+ * 6.2. A \c COSE_Mac0 has the same layout as a \c COSE_Sign1, but the
+ * last element is a tag computed with a symmetric key shared with the
+ * recipient, rather than a signature. It is a lot cheaper to make
+ * than a public key signature, at the cost of the recipient being
+ * able to forge messages.
+ *
+ * Only \ref T_COSE_ALGORITHM_HMAC256 is supported. The \c
+ * MAC_structure is streamed into the MAC in the same way as the \c
+ * Sig_structure is hashed by t_cose_sign1_sign.h, so the payload is
+ * never copied.
+ *
+ * The option flags of t_cose_sign1_sign.h apply, except \ref
+ * T_COSE_OPT_SHORT_CIRCUIT_SIG which is ignored: the symmetric key
+ * must always be given.
+ */
+
+
+/**
+ * This is the context for creating a \c COSE_Mac0 structure. The
+ * caller should allocate it and pass it to the functions here. It is
+ * about 60 bytes.
+ */
+struct t_cose_mac0_sign_ctx {
+    /* Private data structure */
+    uint8_t               protected_parameters_buffer[T_COSE_SIGN1_MAX_SIZE_PROTECTED_PARAMETERS];
+    struct q_useful_buf_c protected_parameters; /* The encoded protected parameters */
+    int32_t               cose_algorithm_id;
+    struct t_cose_key     signing_key;
+    int32_t               option_flags;
+    struct q_useful_buf_c kid;
+};
+
+
+/**
+ * \brief  Initialize to start creating a \c COSE_Mac0.
+ *
+ * \param[in] context            The t_cose MAC context.
+ * \param[in] option_flags       One of \c T_COSE_OPT_XXXX.
+ * \param[in] cose_algorithm_id  The MAC algorithm, \ref
+ *                               T_COSE_ALGORITHM_HMAC256.
+ *
+ * An unsupported \c cose_algorithm_id is reported when
+ * t_cose_mac0_encode_parameters() is called.
+ */
+static void
+t_cose_mac0_sign_init(struct t_cose_mac0_sign_ctx *context,
+                      int32_t                      option_flags,
+                      int32_t                      cose_algorithm_id);
+
+
+/**
+ * \brief  Set the key and kid (key ID) for computing the tag.
+ *
+ * \param[in] context      The t_cose MAC context.
+ * \param[in] signing_key  The symmetric key to compute the tag with.
+ * \param[in] kid          COSE kid (key ID) parameter or \c NULL_Q_USEFUL_BUF_C.
+ */
+static void
+t_cose_mac0_set_signing_key(struct t_cose_mac0_sign_ctx *context,
+                            struct t_cose_key            signing_key,
+                            struct q_useful_buf_c        kid);
+
+
+/**
+ * \brief  Output first part and parameters for a \c COSE_Mac0 message.
+ *
+ * \param[in] context          The t_cose MAC context.
+ * \param[in] cbor_encode_ctx  Encoding context to output to.
+ *
+ * \return This returns one of the error codes defined by \ref t_cose_err_t.
+ *
+ * This works like t_cose_sign1_encode_parameters(). After it is
+ * called, the CBOR-formatted payload is written to the \c
+ * cbor_encode_ctx, and the message is completed with
+ * t_cose_mac0_encode_tag().
+ */
+enum t_cose_err_t
+t_cose_mac0_encode_parameters(struct t_cose_mac0_sign_ctx *context,
+                              QCBOREncodeContext          *cbor_encode_ctx);
+
+
+/**
+ * \brief Finish a \c COSE_Mac0 message by outputting the tag.
+ *
+ * \param[in] context          The t_cose MAC context.
+ * \param[in] cbor_encode_ctx  Encoding context to output to.
+ *
+ * \return This returns one of the error codes defined by \ref t_cose_err_t.
+ *
+ * This is when the MAC is computed. As with
+ * t_cose_sign1_encode_signature(), if the encoder context has a \c
+ * NULL buffer only the size of the tag is accounted for.
+ */
+enum t_cose_err_t
+t_cose_mac0_encode_tag(struct t_cose_mac0_sign_ctx *context,
+                       QCBOREncodeContext          *cbor_encode_ctx);
+
+
+
+
+/* ------------------------------------------------------------------------
+ * Inline implementations of public functions defined above.
+ */
+static inline void
+t_cose_mac0_sign_init(struct t_cose_mac0_sign_ctx *me,
+                      int32_t                      option_flags,
+                      int32_t                      cose_algorithm_id)
+{
+    memset(me, 0, sizeof(*me));
+
+    me->cose_algorithm_id = cose_algorithm_id;
+    me->option_flags      = option_flags;
+}
+
+
+static inline void
+t_cose_mac0_set_signing_key(struct t_cose_mac0_sign_ctx *me,
+                            struct t_cose_key            signing_key,
+                            struct q_useful_buf_c        kid)
+{
+    me->kid         = kid;
+    me->signing_key = signing_key;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __T_COSE_MAC0_H__ */
@@ -503,6 +503,101 @@ t_cose_crypto_hash_finish(struct t_cose_crypto_hash *hash_ctx,
                           struct q_useful_buf_c     *hash_result);
 
 
+/**
+ * The context for use with the MAC adaptation layer here.
+ *
+ * As with the hash context, the implementation of the MAC is in a
+ * separate .c file that is specific to the cryptographic library.
+ */
+struct t_cose_crypto_hmac {
+
+    #ifdef T_COSE_USE_PSA_CRYPTO
+        /* --- The context for PSA Crypto (MBed Crypto) --- */
+        psa_mac_operation_t ctx;
+        psa_status_t        status;
+
+   #else
+    /* --- Default: generic pointer / handle --- */
+
+        union {
+            void    *ptr;
+            uint64_t handle;
+        } context;
+        int64_t status;
+   #endif
+
+};
+
+
+/**
+ * The size of the tag of HMAC 256/256, which is not truncated.
+ */
+#define T_COSE_CRYPTO_HMAC256_TAG_SIZE T_COSE_CRYPTO_SHA256_SIZE
+
+
+/**
+ * \brief Start computing an HMAC. Part of the t_cose crypto
+ * adaptation layer.
+ *
+ * \param[in,out] hmac_ctx      Pointer to the MAC context that will be
+ *                              initialized.
+ * \param[in] signing_key       The symmetric key to compute the MAC
+ *                              with.
+ * \param[in] cose_alg_id       COSE algorithm ID of the MAC, for
+ *                              example \ref COSE_ALGORITHM_HMAC256.
+ *
+ * \retval T_COSE_ERR_UNSUPPORTED_SIGNING_ALG
+ *         The requested algorithm is unknown or unsupported.
+ * \retval T_COSE_ERR_WRONG_TYPE_OF_KEY
+ *         The key can't be used for this MAC algorithm.
+ * \retval T_COSE_ERR_SIG_FAIL
+ *         Some general failure of the MAC function.
+ * \retval T_COSE_SUCCESS
+ *         Success.
+ */
+enum t_cose_err_t
+t_cose_crypto_hmac_sign_setup(struct t_cose_crypto_hmac *hmac_ctx,
+                              struct t_cose_key          signing_key,
+                              int32_t                    cose_alg_id);
+
+
+/**
+ * \brief Feed data into an HMAC. Part of the t_cose crypto adaptation
+ * layer.
+ *
+ * \param[in,out] hmac_ctx  Pointer to the MAC context.
+ * \param[in] payload       Pointer and length of the data to feed in.
+ *
+ * Like t_cose_crypto_hash_update(), any error is remembered in \c
+ * hmac_ctx and returned by t_cose_crypto_hmac_sign_finish().
+ */
+void
+t_cose_crypto_hmac_update(struct t_cose_crypto_hmac *hmac_ctx,
+                          struct q_useful_buf_c      payload);
+
+
+/**
+ * \brief Finish computing an HMAC. Part of the t_cose crypto
+ * adaptation layer.
+ *
+ * \param[in,out] hmac_ctx  Pointer to the MAC context.
+ * \param[in] tag_buf       Pointer and length of the buffer into which
+ *                          the tag is put.
+ * \param[out] tag          Pointer and length of the resulting tag.
+ *
+ * \retval T_COSE_ERR_SIG_BUFFER_SIZE
+ *         \c tag_buf is too small for the tag.
+ * \retval T_COSE_ERR_SIG_FAIL
+ *         Some general failure of the MAC function.
+ * \retval T_COSE_SUCCESS
+ *         Success.
+ */
+enum t_cose_err_t
+t_cose_crypto_hmac_sign_finish(struct t_cose_crypto_hmac *hmac_ctx,
+                               struct q_useful_buf        tag_buf,
+                               struct q_useful_buf_c     *tag);
+
+
 
 /**
  * \brief Indicate whether a COSE algorithm is ECDSA or not.
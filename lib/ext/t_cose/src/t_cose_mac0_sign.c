@@ -0,0 +1,206 @@
+/*
+ * t_cose_mac0_sign.c
+ *
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * See BSD-3-Clause license in README.md
+ */
+
+#include "t_cose_mac0_sign.h"
+#include "t_cose_sign1_sign.h"
+#include "qcbor.h"
+#include "t_cose_standard_constants.h"
+#include "t_cose_crypto.h"
+
+
+/**
+ * \file t_cose_mac0_sign.c
+ *
+ * \brief This implements t_cose \c COSE_Mac0 creation
+ *
+ * Format of the bytes the tag is computed over. This is defined in
+ * COSE (RFC 8152) section 6.3.
+ *
+ * MAC_structure = [
+ *    context : "MAC" / "MAC0",
+ *    protected : empty_or_serialized_map,
+ *    external_aad : bstr,
+ *    payload : bstr
+ * ]
+ *
+ * external_aad is not supported, so it is an empty bstr.
+ */
+
+
+#if T_COSE_ALGORITHM_HMAC256 != COSE_ALGORITHM_HMAC256
+#error COSE algorithm identifier definitions are in error
+#endif
+
+
+/**
+ * This is the size of the first part of the CBOR encoded \c
+ * MAC_structure. See compute_tag().
+ */
+#define T_COSE_SIZE_OF_TBM \
+    1 + /* For opening the array */ \
+    sizeof(COSE_MAC_CONTEXT_STRING_MAC0) + /* "MAC0" */ \
+    2 + /* Overhead for encoding string */ \
+    T_COSE_SIGN1_MAX_SIZE_PROTECTED_PARAMETERS + /* entire protected params */ \
+    1 + /* Empty bstr for absent external_aad */ \
+    1 /* Empty bstr standing for the payload */
+
+
+/**
+ * \brief Compute the tag over the \c MAC_structure.
+ *
+ * \param[in] me               The t_cose MAC context.
+ * \param[in] payload          The bstr-wrapped payload, as returned by
+ *                             \c QCBOREncode_CloseBstrWrap().
+ * \param[in] tag_buf          Buffer for the tag.
+ * \param[out] tag             Pointer and length of the tag.
+ *
+ * \return This returns one of the error codes defined by \ref t_cose_err_t.
+ *
+ * As in create_tbs_hash(), the first part of the structure is encoded
+ * with an empty bstr for the payload, which is left out of the MAC,
+ * and the wrapped payload from the output buffer is fed in after it.
+ */
+static enum t_cose_err_t
+compute_tag(const struct t_cose_mac0_sign_ctx *me,
+            struct q_useful_buf_c              payload,
+            struct q_useful_buf                tag_buf,
+            struct q_useful_buf_c             *tag)
+{
+    enum t_cose_err_t          return_value;
+    QCBOREncodeContext         cbor_encode_ctx;
+    UsefulBuf_MAKE_STACK_UB(   buffer_for_tbm_first_part, T_COSE_SIZE_OF_TBM);
+    struct q_useful_buf_c      tbm_first_part;
+    struct t_cose_crypto_hmac  hmac_ctx;
+
+    QCBOREncode_Init(&cbor_encode_ctx, buffer_for_tbm_first_part);
+    QCBOREncode_OpenArray(&cbor_encode_ctx);
+    QCBOREncode_AddSZString(&cbor_encode_ctx, COSE_MAC_CONTEXT_STRING_MAC0);
+    QCBOREncode_AddBytes(&cbor_encode_ctx, me->protected_parameters);
+    /* external_aad. There is none so an empty bstr */
+    QCBOREncode_AddBytes(&cbor_encode_ctx, NULL_Q_USEFUL_BUF_C);
+    /* The fake payload, omitted from the MAC below */
+    QCBOREncode_AddBytes(&cbor_encode_ctx, NULL_Q_USEFUL_BUF_C);
+    QCBOREncode_CloseArray(&cbor_encode_ctx);
+
+    if(QCBOREncode_Finish(&cbor_encode_ctx, &tbm_first_part)) {
+        return_value = T_COSE_ERR_SIG_STRUCT;
+        goto Done;
+    }
+
+    return_value = t_cose_crypto_hmac_sign_setup(&hmac_ctx,
+                                                 me->signing_key,
+                                                 me->cose_algorithm_id);
+    if(return_value) {
+        goto Done;
+    }
+
+    t_cose_crypto_hmac_update(&hmac_ctx,
+                              q_useful_buf_head(tbm_first_part,
+                                                tbm_first_part.len - 1));
+    t_cose_crypto_hmac_update(&hmac_ctx, payload);
+
+    return_value = t_cose_crypto_hmac_sign_finish(&hmac_ctx, tag_buf, tag);
+
+Done:
+    return return_value;
+}
+
+
+/*
+ * Public function. See t_cose_mac0_sign.h
+ */
+enum t_cose_err_t
+t_cose_mac0_encode_parameters(struct t_cose_mac0_sign_ctx *me,
+                              QCBOREncodeContext          *cbor_encode_ctx)
+{
+    QCBOREncodeContext  protected_ctx;
+
+    if(me->cose_algorithm_id != COSE_ALGORITHM_HMAC256) {
+        return T_COSE_ERR_UNSUPPORTED_SIGNING_ALG;
+    }
+
+    if(!(me->option_flags & T_COSE_OPT_OMIT_CBOR_TAG)) {
+        QCBOREncode_AddTag(cbor_encode_ctx, CBOR_TAG_COSE_MAC0);
+    }
+
+    QCBOREncode_OpenArrayWithCount(cbor_encode_ctx, 4);
+
+    /* The protected parameters only hold the algorithm ID */
+    QCBOREncode_Init(&protected_ctx,
+                     Q_USEFUL_BUF_FROM_BYTE_ARRAY(me->protected_parameters_buffer));
+    QCBOREncode_OpenMap(&protected_ctx);
+    QCBOREncode_AddInt64ToMapN(&protected_ctx,
+                               COSE_HEADER_PARAM_ALG,
+                               me->cose_algorithm_id);
+    QCBOREncode_CloseMap(&protected_ctx);
+    if(QCBOREncode_Finish(&protected_ctx, &me->protected_parameters)) {
+        return T_COSE_ERR_MAKING_PROTECTED;
+    }
+    QCBOREncode_AddBytes(cbor_encode_ctx, me->protected_parameters);
+
+    /* The unprotected parameters */
+    QCBOREncode_OpenMap(cbor_encode_ctx);
+    if(!q_useful_buf_c_is_null_or_empty(me->kid)) {
+        QCBOREncode_AddBytesToMapN(cbor_encode_ctx,
+                                   COSE_HEADER_PARAM_KID,
+                                   me->kid);
+    }
+    QCBOREncode_CloseMap(cbor_encode_ctx);
+
+    QCBOREncode_BstrWrap(cbor_encode_ctx);
+
+    /* CBOR encoding errors are caught when the tag is added */
+    return T_COSE_SUCCESS;
+}
+
+
+/*
+ * Public function. See t_cose_mac0_sign.h
+ */
+enum t_cose_err_t
+t_cose_mac0_encode_tag(struct t_cose_mac0_sign_ctx *me,
+                       QCBOREncodeContext          *cbor_encode_ctx)
+{
+    enum t_cose_err_t           return_value;
+    QCBORError                  cbor_err;
+    struct q_useful_buf_c       tag;
+    Q_USEFUL_BUF_MAKE_STACK_UB( buffer_for_tag, T_COSE_CRYPTO_HMAC256_TAG_SIZE);
+    struct q_useful_buf_c       maced_payload;
+
+    QCBOREncode_CloseBstrWrap(cbor_encode_ctx, &maced_payload);
+
+    cbor_err = QCBOREncode_GetErrorState(cbor_encode_ctx);
+    if(cbor_err == QCBOR_ERR_BUFFER_TOO_SMALL) {
+        return_value = T_COSE_ERR_TOO_SMALL;
+        goto Done;
+    } else if(cbor_err != QCBOR_SUCCESS) {
+        return_value = T_COSE_ERR_CBOR_FORMATTING;
+        goto Done;
+    }
+
+    if(QCBOREncode_IsBufferNULL(cbor_encode_ctx)) {
+        /* Just calculating sizes */
+        tag.ptr = NULL;
+        tag.len = T_COSE_CRYPTO_HMAC256_TAG_SIZE;
+    } else {
+        return_value = compute_tag(me, maced_payload, buffer_for_tag, &tag);
+        if(return_value) {
+            goto Done;
+        }
+    }
+
+    QCBOREncode_AddBytes(cbor_encode_ctx, tag);
+    QCBOREncode_CloseArray(cbor_encode_ctx);
+
+    return_value = T_COSE_SUCCESS;
+
+Done:
+    return return_value;
+}
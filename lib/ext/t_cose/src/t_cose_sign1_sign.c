@@ -257,8 +257,9 @@ t_cose_sign1_encode_parameters(struct t_cose_sign1_sign_ctx *me,
     }
 
     /* Get started with the tagged array that holds the four parts of
-     * a cose single signed message */
-    QCBOREncode_OpenArray(cbor_encode_ctx);
+     * a cose single signed message. The count is known, so closing
+     * the array does not slide the whole message to insert its head. */
+    QCBOREncode_OpenArrayWithCount(cbor_encode_ctx, 4);
 
     /* The protected parameters, which are added as a wrapped bstr  */
     buffer_for_protected_parameters = Q_USEFUL_BUF_FROM_BYTE_ARRAY(me->protected_parameters_buffer);
@@ -364,6 +365,13 @@ t_cose_sign1_encode_signature(struct t_cose_sign1_sign_ctx *me,
          * getting signed, the cose signature alg from which the hash
          * alg is determined. The cose_algorithm_id was checked in
          * t_cose_sign1_init() so it doesn't need to be checked here.
+         *
+         * The payload is hashed here in one pass, rather than while
+         * it is encoded, because QCBOR writes the head of each map,
+         * array and wrapping byte string when it is closed, moving
+         * the bytes already encoded. None of the payload bytes are
+         * final until the byte string wrapping it has been closed
+         * above.
          */
         return_value = create_tbs_hash(me->cose_algorithm_id,
                                        me->protected_parameters,
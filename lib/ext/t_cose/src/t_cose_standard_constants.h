@@ -189,6 +189,16 @@
  */
 #define COSE_ALGORITHM_ES512 -36
 
+/**
+ * \def COSE_ALGORITHM_HMAC256
+ *
+ * \brief Indicates HMAC with SHA-256, with a 256-bit tag.
+ *
+ * Value for \ref COSE_HEADER_PARAM_ALG in a \c COSE_Mac0 to indicate
+ * HMAC 256/256. See RFC 8152 section 9.1.
+ */
+#define COSE_ALGORITHM_HMAC256 5
+
 
 /**
  * \def COSE_ALGORITHM_SHA_256
@@ -401,5 +411,13 @@
  */
 #define COSE_SIG_CONTEXT_STRING_SIGNATURE1 "Signature1"
 
+/**
+ * \def COSE_MAC_CONTEXT_STRING_MAC0
+ *
+ * \brief This is a string constant used by COSE to label \c
+ * COSE_Mac0 structures. See RFC 8152, section 6.3.
+ */
+#define COSE_MAC_CONTEXT_STRING_MAC0 "MAC0"
+
 
 #endif /* __T_COSE_STANDARD_CONSTANTS_H__ */
@@ -49,6 +49,9 @@ if (BL2)
   if (${MCUBOOT_SIGNATURE_TYPE} STREQUAL "RSA-3072")
       add_definitions(-DMCUBOOT_SIGN_RSA_LEN=3072)
   endif()
+  if (${MCUBOOT_SIGNATURE_TYPE} STREQUAL "EC-P256")
+      add_definitions(-DMCUBOOT_SIGN_EC256)
+  endif()
 endif()
 
 embedded_include_directories(PATH "${PLATFORM_DIR}/cmsis" ABSOLUTE)
@@ -163,7 +166,11 @@ elseif(BUILD_TARGET_NV_COUNTERS)
   # NOTE: This non-volatile counters implementation is a dummy
   #       implementation. Platform vendors have to implement the
   #       API ONLY if the target has non-volatile counters.
-  list(APPEND ALL_SRC_C "${PLATFORM_DIR}/common/template/nv_counters.c")
+  if (TFM_NV_COUNTERS_LOG)
+    list(APPEND ALL_SRC_C "${PLATFORM_DIR}/common/template/nv_counters_log.c")
+  else()
+    list(APPEND ALL_SRC_C "${PLATFORM_DIR}/common/template/nv_counters.c")
+  endif()
   set(TARGET_NV_COUNTERS_ENABLE ON)
   # Sets SST_ROLLBACK_PROTECTION flag to compile in the SST services
   # rollback protection code as the target supports nv counters.
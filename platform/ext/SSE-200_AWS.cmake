@@ -49,6 +49,9 @@ if (BL2)
   if (${MCUBOOT_SIGNATURE_TYPE} STREQUAL "RSA-3072")
       add_definitions(-DMCUBOOT_SIGN_RSA_LEN=3072)
   endif()
+  if (${MCUBOOT_SIGNATURE_TYPE} STREQUAL "EC-P256")
+      add_definitions(-DMCUBOOT_SIGN_EC256)
+  endif()
 endif()
 
 embedded_include_directories(PATH "${PLATFORM_DIR}/cmsis" ABSOLUTE)
@@ -73,6 +73,8 @@ if (${PROJECT_NAME} STREQUAL "mcuboot")
 		string(APPEND CC312_C_FLAGS " -DMCUBOOT_SIGN_RSA_LEN=3072")
 	elseif(MCUBOOT_SIGNATURE_TYPE STREQUAL "RSA-2048")
 		string(APPEND CC312_C_FLAGS " -DMCUBOOT_SIGN_RSA_LEN=2048")
+	elseif(MCUBOOT_SIGNATURE_TYPE STREQUAL "EC-P256")
+		string(APPEND CC312_C_FLAGS " -DMCUBOOT_SIGN_EC256")
 	endif()
 endif()
 
@@ -7,6 +7,8 @@
 
 #include "crypto_hw.h"
 
+#include <stdbool.h>
+
 #include "cc_lib.h"
 #include "cc_pal_buff_attr.h"
 #include "cc_rnd_common.h"
@@ -27,6 +29,10 @@ CCRndWorkBuff_t*          CC312_pRndWorkBuff    = NULL;
 mbedtls_ctr_drbg_context* CC312_pRndState       = NULL;
 mbedtls_entropy_context*  CC312_pMbedtlsEntropy = NULL;
 
+/* Number of users of the CC312, it is powered down when it drops to zero */
+static uint32_t cc312_users = 0;
+static bool cc312_powered_down = false;
+
 CCError_t CC_PalDataBufferAttrGet(const unsigned char *pDataBuffer,
                                   size_t buffSize, uint8_t buffType,
                                   uint8_t *pBuffNs)
@@ -81,6 +87,10 @@ int crypto_hw_accelerator_init(void)
         return ret;
     }
 
+    /* The caller holds the accelerator until it powers it down */
+    cc312_users = 1;
+    cc312_powered_down = false;
+
     return 0;
 }
 
@@ -91,6 +101,14 @@ int crypto_hw_accelerator_finish(void)
 {
     int ret = 0;
 
+    if (cc312_powered_down) {
+        ret = mbedtls_mng_resume(NULL, 0);
+        if (ret != CC_OK) {
+            return ret;
+        }
+        cc312_powered_down = false;
+    }
+
     ret = CC_LibFini(CC312_pRndCtx);
     if(ret != CC_LIB_RET_OK) {
         return ret;
@@ -104,9 +122,59 @@ int crypto_hw_accelerator_finish(void)
     return 0;
 }
 
+int crypto_hw_accelerator_entropy_refill(void)
+{
+    return CC_RndTrngPoolRefill();
+}
+
+int crypto_hw_accelerator_power_up(void)
+{
+    int ret;
+
+    if ((cc312_users == 0) && cc312_powered_down) {
+        ret = mbedtls_mng_resume(NULL, 0);
+        if (ret != CC_OK) {
+            return ret;
+        }
+        cc312_powered_down = false;
+    }
+    cc312_users++;
+
+    return 0;
+}
+
+int crypto_hw_accelerator_power_down(void)
+{
+    if (cc312_users == 0) {
+        return -1;
+    }
+
+    cc312_users--;
+    if (cc312_users == 0) {
+        /* This fails while an operation is in progress in the CC312, which
+         * is then left powered until the next time it is released.
+         */
+        if (mbedtls_mng_suspend(NULL, 0) == CC_OK) {
+            cc312_powered_down = true;
+        }
+    }
+
+    return 0;
+}
+
 int crypto_hw_accelerator_get_lcs(uint32_t *lcs)
 {
-    return mbedtls_mng_lcsGet(lcs);
+    int ret;
+
+    ret = crypto_hw_accelerator_power_up();
+    if (ret) {
+        return ret;
+    }
+
+    ret = mbedtls_mng_lcsGet(lcs);
+    (void)crypto_hw_accelerator_power_down();
+
+    return ret;
 }
 
 int crypto_hw_accelerator_huk_derive_key(const uint8_t *label,
@@ -117,6 +185,8 @@ int crypto_hw_accelerator_huk_derive_key(const uint8_t *label,
                                          size_t key_size)
 {
 
+    int ret;
+
     if (context == NULL || context_size == 0) {
         /* The CC312 requires the context to not be null, so a default
          * is given.
@@ -125,10 +195,18 @@ int crypto_hw_accelerator_huk_derive_key(const uint8_t *label,
         context_size = sizeof(CC312_NULL_CONTEXT);
     }
 
-    return mbedtls_util_key_derivation_cmac(CC_UTIL_ROOT_KEY, NULL,
-                                            label, label_size,
-                                            context, context_size,
-                                            key, key_size);
+    ret = crypto_hw_accelerator_power_up();
+    if (ret) {
+        return ret;
+    }
+
+    ret = mbedtls_util_key_derivation_cmac(CC_UTIL_ROOT_KEY, NULL,
+                                           label, label_size,
+                                           context, context_size,
+                                           key, key_size);
+    (void)crypto_hw_accelerator_power_down();
+
+    return ret;
 }
 
 /*
@@ -181,6 +259,10 @@ int crypto_hw_accelerator_get_attestation_private_key(uint8_t  *buf,
     }
     *size = CC_OTP_ATTESTATION_KEY_SIZE_IN_WORDS * sizeof(uint32_t);
 
+    if (crypto_hw_accelerator_power_up()) {
+        return -1;
+    }
+
     /* Get provisioned key from OTP, 8 words */
     for (i = 0; i < CC_OTP_ATTESTATION_KEY_SIZE_IN_WORDS; i++) {
         CC_PROD_OTP_READ(otp_val, CC_OTP_ATTESTATION_KEY_OFFSET + i);
@@ -188,6 +270,9 @@ int crypto_hw_accelerator_get_attestation_private_key(uint8_t  *buf,
         key++;
     }
 
+    CC_PROD_OTP_READ(otp_zero_count, CC_OTP_ATTESTATION_KEY_ZERO_COUNT_OFFSET);
+    (void)crypto_hw_accelerator_power_down();
+
     /* Verify the zero number of private key */
     rc = get_zero_bits_count((uint32_t *)buf,
                              CC_OTP_ATTESTATION_KEY_SIZE_IN_WORDS,
@@ -196,7 +281,6 @@ int crypto_hw_accelerator_get_attestation_private_key(uint8_t  *buf,
         return -1;
     }
 
-    CC_PROD_OTP_READ(otp_zero_count, CC_OTP_ATTESTATION_KEY_ZERO_COUNT_OFFSET);
     if (otp_zero_count != zero_count) {
         return -1;
     }
@@ -232,8 +316,14 @@ int crypto_hw_accelerator_get_rotpk_hash(uint8_t image_id,
     }
     *rotpk_hash_size = rotpk_hash_size_in_words * sizeof(uint32_t);
 
+    ret = crypto_hw_accelerator_power_up();
+    if (ret) {
+        return ret;
+    }
+
     ret = mbedtls_mng_pubKeyHashGet(key_index, (uint32_t *)rotpk_hash,
                                     rotpk_hash_size_in_words);
+    (void)crypto_hw_accelerator_power_down();
     if (ret) {
         return ret;
     }
@@ -41,6 +41,37 @@ int crypto_hw_accelerator_init(void);
  */
 int crypto_hw_accelerator_finish(void);
 
+/**
+ * \brief Take a reference on the CC312 crypto accelerator, powering it up if
+ *        it was powered down
+ *
+ * The accelerator is held by the caller of crypto_hw_accelerator_init() until
+ * it calls crypto_hw_accelerator_power_down(). The functions of this API which
+ * use the accelerator take a reference for their own duration.
+ *
+ * \return 0 on success, non-zero otherwise
+ */
+int crypto_hw_accelerator_power_up(void);
+
+/**
+ * \brief Release a reference on the CC312 crypto accelerator, which is
+ *        powered down when no reference is left
+ *
+ * \return 0 on success, non-zero otherwise
+ */
+int crypto_hw_accelerator_power_down(void);
+
+/**
+ * \brief Top up the entropy pool of the CC312 TRNG
+ *
+ * The DRBG reseeds from the pool without waiting for the TRNG, as long as the
+ * pool has entropy. This waits for the TRNG, so it should be called when no
+ * request is being served.
+ *
+ * \return 0 on success, non-zero otherwise
+ */
+int crypto_hw_accelerator_entropy_refill(void);
+
 /*
  * \brief  This function performs key derivation
  *
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2019 Arm Limited. All rights reserved.
+ * Copyright (c) 2017-2020 Arm Limited. All rights reserved.
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -24,11 +24,16 @@
  * pair and keep the private key is secret.
  */
 
-#define TFM_KEY_LEN_BYTES  16
+/* Long enough for the 256-bit keys of ChaCha20. The keys of 128 bits are the
+ * first half of it, as before.
+ */
+#define TFM_KEY_LEN_BYTES  32
 
 static const uint8_t sample_tfm_key[TFM_KEY_LEN_BYTES] =
              {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, \
-              0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F};
+              0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, \
+              0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, \
+              0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F};
 
 extern const psa_ecc_curve_t initial_attestation_curve_type;
 extern const uint8_t  initial_attestation_private_key[];
@@ -130,4 +135,29 @@ tfm_plat_get_rotpk_hash(uint8_t image_id,
 
     return TFM_PLAT_ERR_SUCCESS;
 }
+
+/* The key encryption key of the firmware images, in bl2/ext/mcuboot/
+ * enc-aes128kw.b64.
+ */
+static const uint8_t sample_enc_image_kek[ENC_IMAGE_KEK_LEN] =
+             {0x6A, 0x65, 0x73, 0x33, 0x68, 0xA6, 0x14, 0x7F, \
+              0xE5, 0xF1, 0x98, 0x50, 0x71, 0x6E, 0xD2, 0x1A};
+
+enum tfm_plat_err_t
+tfm_plat_get_enc_image_kek(uint8_t image_id,
+                           uint8_t *kek,
+                           uint32_t *kek_size)
+{
+    /* The same key encryption key is used for all the images */
+    (void)image_id;
+
+    if (*kek_size < ENC_IMAGE_KEK_LEN) {
+        return TFM_PLAT_ERR_SYSTEM_ERR;
+    }
+
+    *kek_size = ENC_IMAGE_KEK_LEN;
+    copy_key(kek, sample_enc_image_kek, *kek_size);
+
+    return TFM_PLAT_ERR_SUCCESS;
+}
 #endif
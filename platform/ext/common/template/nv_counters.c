@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -23,6 +23,8 @@
 #include "platform/include/tfm_plat_nv_counters.h"
 
 #include <limits.h>
+#include <stdbool.h>
+#include <string.h>
 #include "Driver_Flash.h"
 #include "flash_layout.h"
 
@@ -68,6 +70,37 @@ struct nv_counters_t {
 /* Import the CMSIS flash device driver */
 extern ARM_DRIVER_FLASH FLASH_DEV_NAME;
 
+/* RAM shadow of the NV counters area. It is filled once the area is known to
+ * be initialised, and updated after each successful write of the area, so
+ * that the reads do not go through the flash driver. When a write fails, the
+ * content of the flash is unknown and the shadow is dropped until the next
+ * initialisation.
+ */
+static struct nv_counters_t nv_counters_shadow;
+static bool nv_counters_shadow_valid = false;
+
+/**
+ * \brief Checks whether the RAM shadow can be used instead of the flash.
+ *
+ * \return true if the shadow holds an initialised copy of the NV counters area
+ */
+static bool nv_counters_shadow_is_valid(void)
+{
+    return nv_counters_shadow_valid &&
+           (nv_counters_shadow.init_value == NV_COUNTERS_INITIALIZED);
+}
+
+/**
+ * \brief Records the content of the NV counters area, as now held in flash.
+ *
+ * \param[in] nv_counters  Content of the NV counters area
+ */
+static void nv_counters_shadow_update(const struct nv_counters_t *nv_counters)
+{
+    (void)memcpy(&nv_counters_shadow, nv_counters, sizeof(nv_counters_shadow));
+    nv_counters_shadow_valid = true;
+}
+
 enum tfm_plat_err_t tfm_plat_init_nv_counter(void)
 {
     int32_t err;
@@ -89,9 +122,12 @@ enum tfm_plat_err_t tfm_plat_init_nv_counter(void)
     }
 
     if (nv_counters.init_value == NV_COUNTERS_INITIALIZED) {
+        nv_counters_shadow_update(&nv_counters);
         return TFM_PLAT_ERR_SUCCESS;
     }
 
+    nv_counters_shadow_valid = false;
+
     /* Add watermark, at the end of the NV counters area, to indicate that NV
      * counters have been initialized.
      */
@@ -115,6 +151,8 @@ enum tfm_plat_err_t tfm_plat_init_nv_counter(void)
         return TFM_PLAT_ERR_SYSTEM_ERR;
     }
 
+    nv_counters_shadow_update(&nv_counters);
+
     return TFM_PLAT_ERR_SUCCESS;
 }
 
@@ -124,10 +162,16 @@ enum tfm_plat_err_t tfm_plat_read_nv_counter(enum tfm_nv_counter_t counter_id,
     int32_t  err;
     uint32_t flash_addr;
 
-    if (size != NV_COUNTER_SIZE) {
+    if ((size != NV_COUNTER_SIZE) || (counter_id >= NUM_NV_COUNTERS)) {
         return TFM_PLAT_ERR_SYSTEM_ERR;
     }
 
+    if (nv_counters_shadow_is_valid()) {
+        (void)memcpy(val, &nv_counters_shadow.counters[counter_id],
+                     NV_COUNTER_SIZE);
+        return TFM_PLAT_ERR_SUCCESS;
+    }
+
     flash_addr = TFM_NV_COUNTERS_AREA_ADDR + (counter_id * NV_COUNTER_SIZE);
 
     err = FLASH_DEV_NAME.ReadData(flash_addr, val, NV_COUNTER_SIZE);
@@ -144,13 +188,21 @@ enum tfm_plat_err_t tfm_plat_set_nv_counter(enum tfm_nv_counter_t counter_id,
     int32_t err;
     struct nv_counters_t nv_counters = {{0}};
 
-    /* Read the NV counter area to be able to erase the sector and write later
+    if (counter_id >= NUM_NV_COUNTERS) {
+        return TFM_PLAT_ERR_SYSTEM_ERR;
+    }
+
+    /* Get the NV counter area to be able to erase the sector and write later
      * in the flash.
      */
-    err = FLASH_DEV_NAME.ReadData(TFM_NV_COUNTERS_AREA_ADDR, &nv_counters,
-                                  TFM_NV_COUNTERS_AREA_SIZE);
-    if (err != ARM_DRIVER_OK) {
-        return TFM_PLAT_ERR_SYSTEM_ERR;
+    if (nv_counters_shadow_is_valid()) {
+        (void)memcpy(&nv_counters, &nv_counters_shadow, sizeof(nv_counters));
+    } else {
+        err = FLASH_DEV_NAME.ReadData(TFM_NV_COUNTERS_AREA_ADDR, &nv_counters,
+                                      TFM_NV_COUNTERS_AREA_SIZE);
+        if (err != ARM_DRIVER_OK) {
+            return TFM_PLAT_ERR_SYSTEM_ERR;
+        }
     }
 
     if (value != nv_counters.counters[counter_id]) {
@@ -161,6 +213,9 @@ enum tfm_plat_err_t tfm_plat_set_nv_counter(enum tfm_nv_counter_t counter_id,
             return TFM_PLAT_ERR_INVALID_INPUT;
         }
 
+        /* The flash content is unknown from now on, until written */
+        nv_counters_shadow_valid = false;
+
         /* Erase sector before write in it */
         err = FLASH_DEV_NAME.EraseSector(TFM_NV_COUNTERS_SECTOR_ADDR);
         if (err != ARM_DRIVER_OK) {
@@ -174,6 +229,8 @@ enum tfm_plat_err_t tfm_plat_set_nv_counter(enum tfm_nv_counter_t counter_id,
         if (err != ARM_DRIVER_OK) {
             return TFM_PLAT_ERR_SYSTEM_ERR;
         }
+
+        nv_counters_shadow_update(&nv_counters);
     }
 
     return TFM_PLAT_ERR_SUCCESS;
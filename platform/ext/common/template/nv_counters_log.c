@@ -0,0 +1,427 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/* NOTE: This API should be implemented by platform vendor. For the security of
+ * the secure storage system's and the bootloader's rollback protection etc. it
+ * is CRITICAL to use a internal (in-die) persistent memory for multiple time
+ * programmable (MTP) non-volatile counters or use a One-time Programmable (OTP)
+ * non-volatile counters solution.
+ *
+ * This reference implementation keeps the NV counters in a log of records in
+ * flash, so that an increment programs a single record instead of erasing and
+ * reprogramming a flash sector. It uses two flash sectors, allocated
+ * exclusively for the NV counters:
+ *  - The active sector starts with a header, followed by the records. Each
+ *    record holds the new value of a counter, the value of a counter is the
+ *    largest value of its records. Records are appended to the first erased
+ *    record slot.
+ *  - When the active sector is full, the other sector is erased and gets one
+ *    record per counter, then its header with the next sequence number. It
+ *    becomes the active sector once its header is programmed.
+ *
+ * The value of a record is programmed before its tag, and the sequence number
+ * of a header before its magic. A record or header interrupted by a power
+ * failure is ignored, so a counter holds either its old or its new value. The
+ * sectors are only erased when the active sector is full.
+ *
+ * Each word is programmed once after an erase, so the flash program unit must
+ * not be larger than a word.
+ */
+
+#include "platform/include/tfm_plat_nv_counters.h"
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include "Driver_Flash.h"
+#include "flash_layout.h"
+
+/* Compilation time checks to be sure the defines are well defined */
+#ifndef TFM_NV_COUNTERS_SECTOR_ADDR
+#error "TFM_NV_COUNTERS_SECTOR_ADDR must be defined in flash_layout.h"
+#endif
+
+#ifndef TFM_NV_COUNTERS_BACKUP_SECTOR_ADDR
+#error "TFM_NV_COUNTERS_BACKUP_SECTOR_ADDR must be defined in flash_layout.h"
+#endif
+
+#ifndef TFM_NV_COUNTERS_SECTOR_SIZE
+#error "TFM_NV_COUNTERS_SECTOR_SIZE must be defined in flash_layout.h"
+#endif
+
+#ifndef FLASH_DEV_NAME
+#error "FLASH_DEV_NAME must be defined in flash_layout.h"
+#endif
+/* End of compilation time checks to be sure the defines are well defined */
+
+#define NV_COUNTER_SIZE  sizeof(uint32_t)
+#define NUM_NV_COUNTERS  PLAT_NV_COUNTER_MAX
+
+#define NV_COUNTERS_LOG_MAGIC   0xC0DE0043U
+#define NV_COUNTERS_ERASED_WORD 0xFFFFFFFFU
+
+/* Tag of a record of a counter. The counter ID is stored along with its
+ * complement, so that a partially programmed tag is not valid.
+ */
+#define NV_COUNTERS_RECORD_TAG(id) (0x5A000000U | \
+                                    ((~(uint32_t)(id) & 0xFFU) << 8) | \
+                                    ((uint32_t)(id) & 0xFFU))
+
+/**
+ * \brief Header at the start of a sector of the NV counter log.
+ */
+struct nv_counters_log_hdr_t {
+    uint32_t seq;   /**< Sequence number, the largest one is the active sector */
+    uint32_t magic; /**< NV_COUNTERS_LOG_MAGIC, programmed last */
+};
+
+/**
+ * \brief Record of the NV counter log.
+ */
+struct nv_counters_log_record_t {
+    uint32_t value; /**< New value of the counter */
+    uint32_t tag;   /**< NV_COUNTERS_RECORD_TAG() of the counter, programmed
+                     *   last
+                     */
+};
+
+#define NV_COUNTERS_LOG_RECORDS_OFFSET sizeof(struct nv_counters_log_hdr_t)
+#define NV_COUNTERS_LOG_RECORD_SIZE    sizeof(struct nv_counters_log_record_t)
+
+/**
+ * \brief State of the NV counter log, read from flash once.
+ */
+struct nv_counters_log_t {
+    bool loaded;                        /**< The state was read from flash */
+    uint32_t sector_addr;               /**< Address of the active sector */
+    uint32_t seq;                       /**< Sequence number of the sector */
+    uint32_t next_off;                  /**< Offset of the next record */
+    uint32_t counters[NUM_NV_COUNTERS]; /**< Value of the NV counters */
+};
+
+static struct nv_counters_log_t nv_log;
+
+/* Import the CMSIS flash device driver */
+extern ARM_DRIVER_FLASH FLASH_DEV_NAME;
+
+static enum tfm_plat_err_t nv_counters_program_word(uint32_t addr,
+                                                    uint32_t word)
+{
+    int32_t err;
+
+    err = FLASH_DEV_NAME.ProgramData(addr, &word, sizeof(word));
+    if (err != ARM_DRIVER_OK) {
+        return TFM_PLAT_ERR_SYSTEM_ERR;
+    }
+
+    return TFM_PLAT_ERR_SUCCESS;
+}
+
+/**
+ * \brief Reads the sequence number of a sector.
+ *
+ * \return Returns true if the sector has a valid header.
+ */
+static bool nv_counters_read_hdr(uint32_t sector_addr, uint32_t *seq)
+{
+    struct nv_counters_log_hdr_t hdr;
+    int32_t err;
+
+    err = FLASH_DEV_NAME.ReadData(sector_addr, &hdr, sizeof(hdr));
+    if ((err != ARM_DRIVER_OK) || (hdr.magic != NV_COUNTERS_LOG_MAGIC)) {
+        return false;
+    }
+
+    *seq = hdr.seq;
+    return true;
+}
+
+/**
+ * \brief Programs the header of a sector, which makes it the active sector.
+ */
+static enum tfm_plat_err_t nv_counters_write_hdr(uint32_t sector_addr,
+                                                 uint32_t seq)
+{
+    enum tfm_plat_err_t err;
+
+    err = nv_counters_program_word(sector_addr +
+                                 offsetof(struct nv_counters_log_hdr_t, seq),
+                                 seq);
+    if (err != TFM_PLAT_ERR_SUCCESS) {
+        return err;
+    }
+
+    return nv_counters_program_word(sector_addr +
+                                 offsetof(struct nv_counters_log_hdr_t, magic),
+                                 NV_COUNTERS_LOG_MAGIC);
+}
+
+/**
+ * \brief Programs a record at an offset of a sector.
+ */
+static enum tfm_plat_err_t nv_counters_write_record(uint32_t sector_addr,
+                                                    uint32_t off,
+                                                    uint32_t counter_id,
+                                                    uint32_t value)
+{
+    enum tfm_plat_err_t err;
+
+    err = nv_counters_program_word(sector_addr + off +
+                             offsetof(struct nv_counters_log_record_t, value),
+                             value);
+    if (err != TFM_PLAT_ERR_SUCCESS) {
+        return err;
+    }
+
+    return nv_counters_program_word(sector_addr + off +
+                             offsetof(struct nv_counters_log_record_t, tag),
+                             NV_COUNTERS_RECORD_TAG(counter_id));
+}
+
+/**
+ * \brief Reads the records of the active sector to get the value of the
+ *        counters and the offset of the next record.
+ */
+static enum tfm_plat_err_t nv_counters_read_records(void)
+{
+    struct nv_counters_log_record_t record;
+    uint32_t off;
+    uint32_t id;
+    int32_t err;
+
+    for (id = 0; id < NUM_NV_COUNTERS; id++) {
+        nv_log.counters[id] = 0;
+    }
+
+    for (off = NV_COUNTERS_LOG_RECORDS_OFFSET;
+         off + NV_COUNTERS_LOG_RECORD_SIZE <= TFM_NV_COUNTERS_SECTOR_SIZE;
+         off += NV_COUNTERS_LOG_RECORD_SIZE) {
+        err = FLASH_DEV_NAME.ReadData(nv_log.sector_addr + off, &record,
+                                      sizeof(record));
+        if (err != ARM_DRIVER_OK) {
+            return TFM_PLAT_ERR_SYSTEM_ERR;
+        }
+
+        /* Records are appended, the first erased slot ends the log */
+        if ((record.value == NV_COUNTERS_ERASED_WORD) &&
+            (record.tag == NV_COUNTERS_ERASED_WORD)) {
+            break;
+        }
+
+        /* Interrupted records are skipped */
+        id = record.tag & 0xFFU;
+        if ((id < NUM_NV_COUNTERS) &&
+            (record.tag == NV_COUNTERS_RECORD_TAG(id)) &&
+            (record.value > nv_log.counters[id])) {
+            nv_log.counters[id] = record.value;
+        }
+    }
+
+    nv_log.next_off = off;
+
+    return TFM_PLAT_ERR_SUCCESS;
+}
+
+/**
+ * \brief Reads the state of the NV counter log from flash, on first use.
+ *        Creates an empty log if there is none.
+ */
+static enum tfm_plat_err_t nv_counters_load(void)
+{
+    ARM_FLASH_INFO *info;
+    uint32_t seq0, seq1;
+    bool valid0, valid1;
+    int32_t err;
+
+    if (nv_log.loaded) {
+        return TFM_PLAT_ERR_SUCCESS;
+    }
+
+    err = FLASH_DEV_NAME.Initialize(NULL);
+    if (err != ARM_DRIVER_OK) {
+        return TFM_PLAT_ERR_SYSTEM_ERR;
+    }
+
+    /* A compacted sector must leave room to append records */
+    if (NV_COUNTERS_LOG_RECORDS_OFFSET +
+        (NUM_NV_COUNTERS + 1) * NV_COUNTERS_LOG_RECORD_SIZE >
+        TFM_NV_COUNTERS_SECTOR_SIZE) {
+        return TFM_PLAT_ERR_SYSTEM_ERR;
+    }
+
+    info = FLASH_DEV_NAME.GetInfo();
+    if ((info->program_unit > NV_COUNTER_SIZE) ||
+        (info->erased_value != 0xFFU)) {
+        return TFM_PLAT_ERR_SYSTEM_ERR;
+    }
+
+    valid0 = nv_counters_read_hdr(TFM_NV_COUNTERS_SECTOR_ADDR, &seq0);
+    valid1 = nv_counters_read_hdr(TFM_NV_COUNTERS_BACKUP_SECTOR_ADDR, &seq1);
+
+    if (valid0 && (!valid1 || (seq0 > seq1))) {
+        nv_log.sector_addr = TFM_NV_COUNTERS_SECTOR_ADDR;
+        nv_log.seq = seq0;
+    } else if (valid1) {
+        nv_log.sector_addr = TFM_NV_COUNTERS_BACKUP_SECTOR_ADDR;
+        nv_log.seq = seq1;
+    } else {
+        /* No log yet, all the counters are 0 */
+        err = FLASH_DEV_NAME.EraseSector(TFM_NV_COUNTERS_SECTOR_ADDR);
+        if (err != ARM_DRIVER_OK) {
+            return TFM_PLAT_ERR_SYSTEM_ERR;
+        }
+
+        if (nv_counters_write_hdr(TFM_NV_COUNTERS_SECTOR_ADDR, 1) !=
+            TFM_PLAT_ERR_SUCCESS) {
+            return TFM_PLAT_ERR_SYSTEM_ERR;
+        }
+
+        nv_log.sector_addr = TFM_NV_COUNTERS_SECTOR_ADDR;
+        nv_log.seq = 1;
+    }
+
+    if (nv_counters_read_records() != TFM_PLAT_ERR_SUCCESS) {
+        return TFM_PLAT_ERR_SYSTEM_ERR;
+    }
+
+    nv_log.loaded = true;
+
+    return TFM_PLAT_ERR_SUCCESS;
+}
+
+/**
+ * \brief Moves the value of the counters to the other sector, which becomes
+ *        the active sector.
+ */
+static enum tfm_plat_err_t nv_counters_compact(void)
+{
+    enum tfm_plat_err_t err;
+    uint32_t sector_addr;
+    uint32_t off = NV_COUNTERS_LOG_RECORDS_OFFSET;
+    uint32_t id;
+
+    sector_addr = (nv_log.sector_addr == TFM_NV_COUNTERS_SECTOR_ADDR) ?
+                  TFM_NV_COUNTERS_BACKUP_SECTOR_ADDR :
+                  TFM_NV_COUNTERS_SECTOR_ADDR;
+
+    if (FLASH_DEV_NAME.EraseSector(sector_addr) != ARM_DRIVER_OK) {
+        return TFM_PLAT_ERR_SYSTEM_ERR;
+    }
+
+    for (id = 0; id < NUM_NV_COUNTERS; id++) {
+        if (nv_log.counters[id] == 0) {
+            continue;
+        }
+
+        err = nv_counters_write_record(sector_addr, off, id,
+                                       nv_log.counters[id]);
+        if (err != TFM_PLAT_ERR_SUCCESS) {
+            return err;
+        }
+        off += NV_COUNTERS_LOG_RECORD_SIZE;
+    }
+
+    /* The active sector stays valid until this header is programmed */
+    err = nv_counters_write_hdr(sector_addr, nv_log.seq + 1);
+    if (err != TFM_PLAT_ERR_SUCCESS) {
+        return err;
+    }
+
+    nv_log.sector_addr = sector_addr;
+    nv_log.seq++;
+    nv_log.next_off = off;
+
+    return TFM_PLAT_ERR_SUCCESS;
+}
+
+enum tfm_plat_err_t tfm_plat_init_nv_counter(void)
+{
+    return nv_counters_load();
+}
+
+enum tfm_plat_err_t tfm_plat_read_nv_counter(enum tfm_nv_counter_t counter_id,
+                                             uint32_t size, uint8_t *val)
+{
+    enum tfm_plat_err_t err;
+
+    if ((size != NV_COUNTER_SIZE) || (counter_id >= NUM_NV_COUNTERS)) {
+        return TFM_PLAT_ERR_SYSTEM_ERR;
+    }
+
+    err = nv_counters_load();
+    if (err != TFM_PLAT_ERR_SUCCESS) {
+        return err;
+    }
+
+    memcpy(val, &nv_log.counters[counter_id], NV_COUNTER_SIZE);
+
+    return TFM_PLAT_ERR_SUCCESS;
+}
+
+enum tfm_plat_err_t tfm_plat_set_nv_counter(enum tfm_nv_counter_t counter_id,
+                                            uint32_t value)
+{
+    enum tfm_plat_err_t err;
+
+    if (counter_id >= NUM_NV_COUNTERS) {
+        return TFM_PLAT_ERR_SYSTEM_ERR;
+    }
+
+    err = nv_counters_load();
+    if (err != TFM_PLAT_ERR_SUCCESS) {
+        return err;
+    }
+
+    if (value == nv_log.counters[counter_id]) {
+        return TFM_PLAT_ERR_SUCCESS;
+    }
+
+    if (value < nv_log.counters[counter_id]) {
+        return TFM_PLAT_ERR_INVALID_INPUT;
+    }
+
+    if (nv_log.next_off + NV_COUNTERS_LOG_RECORD_SIZE >
+        TFM_NV_COUNTERS_SECTOR_SIZE) {
+        err = nv_counters_compact();
+        if (err != TFM_PLAT_ERR_SUCCESS) {
+            return err;
+        }
+    }
+
+    err = nv_counters_write_record(nv_log.sector_addr, nv_log.next_off,
+                                   counter_id, value);
+    /* The slot is not reused, even if the record was not fully programmed */
+    nv_log.next_off += NV_COUNTERS_LOG_RECORD_SIZE;
+    if (err != TFM_PLAT_ERR_SUCCESS) {
+        return err;
+    }
+
+    nv_log.counters[counter_id] = value;
+
+    return TFM_PLAT_ERR_SUCCESS;
+}
+
+enum tfm_plat_err_t tfm_plat_increment_nv_counter(
+                                           enum tfm_nv_counter_t counter_id)
+{
+    uint32_t security_cnt;
+    enum tfm_plat_err_t err;
+
+    err = tfm_plat_read_nv_counter(counter_id,
+                                   sizeof(security_cnt),
+                                   (uint8_t *)&security_cnt);
+    if (err != TFM_PLAT_ERR_SUCCESS) {
+        return err;
+    }
+
+    if (security_cnt == UINT32_MAX) {
+        return TFM_PLAT_ERR_MAX_VALUE;
+    }
+
+    return tfm_plat_set_nv_counter(counter_id, security_cnt + 1u);
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -23,7 +23,25 @@
  */
 
 #if defined(BL2)
-#if (MCUBOOT_SIGN_RSA_LEN == 2048)
+#if defined(MCUBOOT_SIGN_EC256)
+/* Hash of public key: bl2/ext/mcuboot/root-ec-p256.pem */
+uint8_t rotpk_hash_0[ROTPK_HASH_LEN] = {
+    0x37, 0x83, 0x19, 0xe8, 0x6a, 0x22, 0x2f, 0x30,
+    0xd9, 0xe4, 0xea, 0x79, 0x43, 0xb8, 0xfd, 0x3d,
+    0xee, 0x8c, 0x64, 0x3c, 0x6b, 0x62, 0x9d, 0xf2,
+    0xe9, 0xf5, 0xb1, 0xb9, 0x22, 0x10, 0x1e, 0x44,
+};
+/* Hash of public key: bl2/ext/mcuboot/root-ec-p256_1.pem */
+#if (MCUBOOT_IMAGE_NUMBER == 2)
+uint8_t rotpk_hash_1[ROTPK_HASH_LEN] = {
+    0x13, 0xb4, 0x83, 0x2c, 0x11, 0x5b, 0xf8, 0xcb,
+    0xa0, 0x0c, 0x7d, 0x78, 0x2a, 0x46, 0x0b, 0x65,
+    0x30, 0xa8, 0x07, 0x67, 0xc4, 0x15, 0xf1, 0x83,
+    0x1e, 0x7e, 0xb9, 0x7d, 0xf4, 0x92, 0xf2, 0xd4,
+};
+#endif /* MCUBOOT_IMAGE_NUMBER */
+
+#elif (MCUBOOT_SIGN_RSA_LEN == 2048)
 /* Hash of public key: bl2/ext/mcuboot/root-rsa-2048.pem */
 uint8_t rotpk_hash_0[ROTPK_HASH_LEN] = {
     0xfc, 0x57, 0x01, 0xdc, 0x61, 0x35, 0xe1, 0x32,
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/**
+ * \file tfm_mbedtls_bn_mul.h
+ *
+ * \brief Multiply-accumulate kernels of the Mbed TLS bignum module for the
+ *        cores implementing the DSP extension (Cortex-M4, Cortex-M33 with
+ *        DSP). It is included at the end of the Mbed TLS configurations of
+ *        the Crypto service and of BL2, so the kernels are seen by bn_mul.h.
+ *
+ * All the bignum multiplications of Mbed TLS, including the Montgomery
+ * multiplication of the RSA modular exponentiation and the multiplications of
+ * the ECP arithmetic, go through mpi_mul_hlp(), which computes
+ * d[] += s[] * b with the MULADDC_* macros. Without the DSP extension Mbed
+ * TLS uses UMLAL followed by two additions and a carry update per word. UMAAL
+ * adds both the destination word and the carry to the product in a single
+ * instruction, which takes the kernel down to one load of each operand, one
+ * UMAAL and one store per word.
+ *
+ * The generic Arm kernels of bn_mul.h are only built with MBEDTLS_HAVE_ASM
+ * and would redefine the macros below, so MBEDTLS_HAVE_ASM is undefined when
+ * these kernels are used. None of the other users of MBEDTLS_HAVE_ASM (the
+ * x86 AES-NI and PadLock modules, the timing module) are built for Arm
+ * M-profile cores.
+ *
+ * The DSP extension is enabled for the Mbed Crypto library by the build
+ * system when ARM_CPU_DSP is set, see cmake/Common/CpuM33.cmake.
+ */
+
+#ifndef __TFM_MBEDTLS_BN_MUL_H__
+#define __TFM_MBEDTLS_BN_MUL_H__
+
+#if defined(__GNUC__) && defined(__ARM_FEATURE_DSP) && \
+    (__ARM_FEATURE_DSP == 1) && !defined(TFM_MBEDTLS_BN_MUL_GENERIC)
+
+#undef MBEDTLS_HAVE_ASM
+
+/*
+ * In mpi_mul_hlp(), s points to the words of the multiplicand, d to the words
+ * of the destination, b is the multiplier and c the carry. The registers
+ * r0-r3 are used as scratch registers, r7 is left alone as it may be the
+ * frame pointer.
+ */
+#define MULADDC_INIT                                    \
+    __asm__ volatile (
+
+/* d[0] = lo(s[0] * b + d[0] + c), c = hi(s[0] * b + d[0] + c) */
+#define MULADDC_CORE                                    \
+        "ldr    r0, [%0], #4            \n\t"           \
+        "ldr    r1, [%1]                \n\t"           \
+        "umaal  r1, %2, r0, %3          \n\t"           \
+        "str    r1, [%1], #4            \n\t"
+
+/* Eight words, two at a time to keep the number of scratch registers low */
+#define MULADDC_PAIR                                    \
+        "ldm    %0!, {r0, r1}           \n\t"           \
+        "ldm    %1, {r2, r3}            \n\t"           \
+        "umaal  r2, %2, r0, %3          \n\t"           \
+        "umaal  r3, %2, r1, %3          \n\t"           \
+        "stm    %1!, {r2, r3}           \n\t"
+
+#define MULADDC_HUIT                                    \
+        MULADDC_PAIR                                    \
+        MULADDC_PAIR                                    \
+        MULADDC_PAIR                                    \
+        MULADDC_PAIR
+
+#define MULADDC_STOP                                    \
+        : "+r" (s), "+r" (d), "+r" (c)                  \
+        : "r" (b)                                       \
+        : "r0", "r1", "r2", "r3", "memory"              \
+    );
+
+#endif /* __GNUC__ && __ARM_FEATURE_DSP && !TFM_MBEDTLS_BN_MUL_GENERIC */
+
+#endif /* __TFM_MBEDTLS_BN_MUL_H__ */
@@ -0,0 +1,331 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "cmsis.h"
+#include "platform/include/tfm_plat_perf_counters.h"
+#include "secure_fw/core/include/tfm_cycle_counter.h"
+
+/* The DWT profiling counters come with the cycle counter */
+#ifdef TFM_HAS_CYCLE_COUNTER
+#define PERF_HAS_DWT
+#endif
+
+#if defined(__ARM_ARCH_8M_MAIN__) || defined(__ARM_ARCH_8_1M_MAIN__)
+#define PERF_HAS_SECURITY
+#endif
+
+#if defined(__ARM_ARCH_8_1M_MAIN__) && defined(__PMU_PRESENT) && \
+    (__PMU_PRESENT == 1U)
+#define PERF_HAS_PMU
+
+/* Armv8.1-M PMU registers, which the CMSIS headers of the tree do not have */
+#define PERF_PMU_BASE           0xE0003000UL
+#define PERF_PMU_REG(offset)    (*(volatile uint32_t *)(PERF_PMU_BASE + \
+                                                        (offset)))
+#define PERF_PMU_EVCNTR(n)      PERF_PMU_REG(0x000UL + 4UL * (n))
+#define PERF_PMU_EVTYPER(n)     PERF_PMU_REG(0x400UL + 4UL * (n))
+#define PERF_PMU_CNTENSET       PERF_PMU_REG(0xC00UL)
+#define PERF_PMU_CNTENCLR       PERF_PMU_REG(0xC20UL)
+#define PERF_PMU_OVSCLR         PERF_PMU_REG(0xC80UL)
+#define PERF_PMU_TYPE           PERF_PMU_REG(0xE00UL)
+#define PERF_PMU_CTRL           PERF_PMU_REG(0xE04UL)
+
+#define PERF_PMU_CTRL_E         (1UL << 0)  /* Enable                    */
+#define PERF_PMU_CTRL_P         (1UL << 1)  /* Reset the event counters  */
+#define PERF_PMU_TYPE_N_MSK     0xFFUL      /* Event counters minus one  */
+#define PERF_PMU_EVENT_MSK      0xFFFFUL
+#endif /* PERF_HAS_PMU */
+
+/* The DWT profiling counters, in the order of the TFM_PERF_EVENT_DWT_* */
+#define PERF_DWT_EVENTS         5
+#define PERF_DWT_COUNTER_MSK    0xFFUL
+
+struct perf_counter_t {
+    bool dwt;                       /* DWT or PMU counter                  */
+    uint32_t idx;                   /* Index among the DWT or PMU counters */
+};
+
+struct perf_state_t {
+    uint32_t num;                   /* Number of configured counters       */
+    struct perf_counter_t counters[TFM_PERF_MAX_COUNTERS];
+    uint32_t dwt_ena;               /* DWT_CTRL enable bits of the events  */
+    uint32_t pmu_mask;              /* PMU counters in use                 */
+    bool running;
+    uint32_t cyc_start;             /* CYCCNT at start                     */
+    uint32_t cyc_stop;              /* CYCCNT at stop                      */
+    bool dauthctrl_saved;
+    uint32_t dauthctrl;             /* DAUTHCTRL before the first start    */
+};
+
+static struct perf_state_t perf;
+
+#ifdef PERF_HAS_DWT
+static const uint32_t perf_dwt_ena[PERF_DWT_EVENTS] = {
+    DWT_CTRL_CPIEVTENA_Msk,
+    DWT_CTRL_EXCEVTENA_Msk,
+    DWT_CTRL_SLEEPEVTENA_Msk,
+    DWT_CTRL_LSUEVTENA_Msk,
+    DWT_CTRL_FOLDEVTENA_Msk,
+};
+
+static volatile uint32_t *perf_dwt_counter(uint32_t idx)
+{
+    switch (idx) {
+    case 0:
+        return &DWT->CPICNT;
+    case 1:
+        return &DWT->EXCCNT;
+    case 2:
+        return &DWT->SLEEPCNT;
+    case 3:
+        return &DWT->LSUCNT;
+    default:
+        return &DWT->FOLDCNT;
+    }
+}
+#endif
+
+/* The DWT and the PMU are only accessible with the trace enabled */
+static void perf_enable_trace(void)
+{
+#ifdef PERF_HAS_DWT
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+#endif
+}
+
+static bool perf_has_cycles(void)
+{
+#ifdef PERF_HAS_DWT
+    return !(DWT->CTRL & DWT_CTRL_NOCYCCNT_Msk);
+#else
+    return false;
+#endif
+}
+
+static uint32_t perf_dwt_num(void)
+{
+#ifdef PERF_HAS_DWT
+    return (DWT->CTRL & DWT_CTRL_NOPRFCNT_Msk) ? 0 : PERF_DWT_EVENTS;
+#else
+    return 0;
+#endif
+}
+
+static uint32_t perf_pmu_num(void)
+{
+#if defined(PERF_HAS_PMU) && defined(__PMU_NUM_EVENTCNT)
+    return __PMU_NUM_EVENTCNT;
+#elif defined(PERF_HAS_PMU)
+    return (PERF_PMU_TYPE & PERF_PMU_TYPE_N_MSK) + 1;
+#else
+    return 0;
+#endif
+}
+
+/*
+ * The counters only count in the secure state if secure non-invasive debug
+ * is allowed, which the secure image can do itself on Armv8-M.
+ */
+static void perf_allow_secure(void)
+{
+#ifdef PERF_HAS_SECURITY
+    if (!perf.dauthctrl_saved) {
+        perf.dauthctrl = CoreDebug->DAUTHCTRL;
+        perf.dauthctrl_saved = true;
+    }
+    CoreDebug->DAUTHCTRL = perf.dauthctrl |
+                           CoreDebug_DAUTHCTRL_SPNIDENSEL_Msk |
+                           CoreDebug_DAUTHCTRL_INTSPNIDEN_Msk;
+#endif
+}
+
+static void perf_restore_secure(void)
+{
+#ifdef PERF_HAS_SECURITY
+    if (perf.dauthctrl_saved) {
+        CoreDebug->DAUTHCTRL = perf.dauthctrl;
+        perf.dauthctrl_saved = false;
+    }
+#endif
+}
+
+__WEAK enum tfm_plat_err_t tfm_plat_perf_get_info(struct tfm_perf_info_t *info)
+{
+    uint32_t num;
+
+    perf_enable_trace();
+
+    num = perf_dwt_num() + perf_pmu_num();
+    info->num_counters = (num > TFM_PERF_MAX_COUNTERS) ?
+                         TFM_PERF_MAX_COUNTERS : num;
+    info->flags = 0;
+    if (perf_has_cycles()) {
+        info->flags |= TFM_PERF_HAS_CYCLES;
+    }
+    if (perf_pmu_num() > 0) {
+        info->flags |= TFM_PERF_HAS_PMU;
+    }
+
+    return TFM_PLAT_ERR_SUCCESS;
+}
+
+__WEAK enum tfm_plat_err_t
+tfm_plat_perf_config(const struct tfm_perf_config_t *config)
+{
+    uint32_t i, event, idx, pmu_num = 0;
+
+    if (config->num > TFM_PERF_MAX_COUNTERS) {
+        return TFM_PLAT_ERR_INVALID_INPUT;
+    }
+
+    (void)tfm_plat_perf_stop();
+    perf_enable_trace();
+
+    perf.num = 0;
+    perf.dwt_ena = 0;
+    perf.pmu_mask = 0;
+
+    for (i = 0; i < config->num; i++) {
+        event = config->events[i];
+        if (event >= TFM_PERF_EVENT_DWT_CPI) {
+            /* Each DWT counter counts its own event */
+            idx = event - TFM_PERF_EVENT_DWT_CPI;
+            if (idx >= perf_dwt_num()) {
+                return TFM_PLAT_ERR_INVALID_INPUT;
+            }
+#ifdef PERF_HAS_DWT
+            if (perf.dwt_ena & perf_dwt_ena[idx]) {
+                return TFM_PLAT_ERR_INVALID_INPUT;
+            }
+            perf.dwt_ena |= perf_dwt_ena[idx];
+#endif
+            perf.counters[i].dwt = true;
+        } else {
+            /* The PMU counters are assigned in order */
+            idx = pmu_num;
+            if (idx >= perf_pmu_num()) {
+                return TFM_PLAT_ERR_INVALID_INPUT;
+            }
+#ifdef PERF_HAS_PMU
+            if (event > PERF_PMU_EVENT_MSK) {
+                return TFM_PLAT_ERR_INVALID_INPUT;
+            }
+            PERF_PMU_EVTYPER(idx) = event;
+            perf.pmu_mask |= 1UL << idx;
+#endif
+            perf.counters[i].dwt = false;
+            pmu_num++;
+        }
+        perf.counters[i].idx = idx;
+    }
+
+    perf.num = config->num;
+
+    return TFM_PLAT_ERR_SUCCESS;
+}
+
+__WEAK enum tfm_plat_err_t tfm_plat_perf_start(void)
+{
+    uint32_t i;
+
+    (void)tfm_plat_perf_stop();
+    perf_allow_secure();
+
+#ifdef PERF_HAS_DWT
+    for (i = 0; i < perf.num; i++) {
+        if (perf.counters[i].dwt) {
+            *perf_dwt_counter(perf.counters[i].idx) = 0;
+        }
+    }
+    (void)tfm_cycle_counter_start(false);
+    DWT->CTRL |= perf.dwt_ena;
+#else
+    (void)i;
+#endif
+
+#ifdef PERF_HAS_PMU
+    if (perf.pmu_mask) {
+        PERF_PMU_CTRL |= PERF_PMU_CTRL_E | PERF_PMU_CTRL_P;
+        PERF_PMU_OVSCLR = perf.pmu_mask;
+        PERF_PMU_CNTENSET = perf.pmu_mask;
+    }
+#endif
+
+    /*
+     * The cycle counter is shared with the rest of the image, the cycles are
+     * counted from the value at start.
+     */
+    perf.cyc_start = tfm_cycle_counter_read();
+    perf.running = true;
+
+    return TFM_PLAT_ERR_SUCCESS;
+}
+
+__WEAK enum tfm_plat_err_t tfm_plat_perf_stop(void)
+{
+    if (!perf.running) {
+        return TFM_PLAT_ERR_SUCCESS;
+    }
+
+    perf.cyc_stop = tfm_cycle_counter_read();
+
+#ifdef PERF_HAS_DWT
+    DWT->CTRL &= ~perf.dwt_ena;
+#endif
+#ifdef PERF_HAS_PMU
+    PERF_PMU_CNTENCLR = perf.pmu_mask;
+#endif
+
+    perf.running = false;
+
+    return TFM_PLAT_ERR_SUCCESS;
+}
+
+__WEAK enum tfm_plat_err_t tfm_plat_perf_read(struct tfm_perf_values_t *values)
+{
+    uint32_t i;
+
+    values->cycles = (perf.running ? tfm_cycle_counter_read() :
+                                     perf.cyc_stop) - perf.cyc_start;
+
+    for (i = 0; i < TFM_PERF_MAX_COUNTERS; i++) {
+        values->counters[i] = 0;
+        if (i >= perf.num) {
+            continue;
+        }
+#ifdef PERF_HAS_DWT
+        if (perf.counters[i].dwt) {
+            values->counters[i] = *perf_dwt_counter(perf.counters[i].idx) &
+                                  PERF_DWT_COUNTER_MSK;
+        }
+#endif
+#ifdef PERF_HAS_PMU
+        if (!perf.counters[i].dwt) {
+            values->counters[i] = PERF_PMU_EVCNTR(perf.counters[i].idx);
+        }
+#endif
+    }
+
+    return TFM_PLAT_ERR_SUCCESS;
+}
+
+__WEAK enum tfm_plat_err_t tfm_plat_perf_release(void)
+{
+    (void)tfm_plat_perf_stop();
+
+    perf.num = 0;
+    perf.dwt_ena = 0;
+    perf.pmu_mask = 0;
+    perf.cyc_start = 0;
+    perf.cyc_stop = 0;
+
+    perf_restore_secure();
+
+    return TFM_PLAT_ERR_SUCCESS;
+}
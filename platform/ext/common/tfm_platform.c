@@ -30,3 +30,15 @@ __WEAK void tfm_spm_hal_system_reset(void)
 {
     NVIC_SystemReset();
 }
+
+#ifdef TFM_PSA_API
+__WEAK enum tfm_plat_err_t tfm_spm_hal_dma_copy(void *dst, const void *src,
+                                                size_t size)
+{
+    (void)dst;
+    (void)src;
+    (void)size;
+
+    return TFM_PLAT_ERR_UNSUPPORTED;
+}
+#endif /* TFM_PSA_API */
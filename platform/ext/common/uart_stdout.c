@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2019 ARM Limited
+ * Copyright (c) 2017-2020 ARM Limited
  *
  * Licensed under the Apace License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -19,13 +19,173 @@
 #include <assert.h>
 #include <stdio.h>
 #include <stdint.h>
+#include <string.h>
 #include "Driver_USART.h"
+#ifdef TFM_STDIO_BUFFERED
+#include "cmsis_compiler.h"
+#endif
 
 #define ASSERT_HIGH(X)  assert(X == ARM_DRIVER_OK)
 
 /* Imports USART driver */
 extern ARM_DRIVER_USART TFM_DRIVER_STDIO;
 
+#ifdef TFM_STDIO_BUFFERED
+/* Size of the output ring buffer, must be a power of 2 */
+#ifndef STDIO_BUFFER_SIZE
+#define STDIO_BUFFER_SIZE 1024
+#endif
+
+#if (STDIO_BUFFER_SIZE & (STDIO_BUFFER_SIZE - 1)) != 0
+#error "STDIO_BUFFER_SIZE must be a power of 2"
+#endif
+
+/* Output waiting to be sent, from stdio_tail to stdio_head. The positions are
+ * free running and wrap at 2^32.
+ */
+static uint8_t stdio_buf[STDIO_BUFFER_SIZE];
+static volatile uint32_t stdio_head;
+static volatile uint32_t stdio_tail;
+
+/* Number of bytes of the transfer in progress, which start at stdio_tail, or
+ * 0 if the UART is idle. stdio_tx_seq counts the transfers started.
+ */
+static volatile uint32_t stdio_tx_len;
+static volatile uint32_t stdio_tx_seq;
+
+/* Claims the next transfer if the UART is idle, and returns its size or 0.
+ * Must be called with the interrupts disabled.
+ */
+static uint32_t stdio_claim_tx(uint32_t *idx)
+{
+    uint32_t pending = stdio_head - stdio_tail;
+    uint32_t len;
+
+    if ((stdio_tx_len != 0) || (pending == 0)) {
+        return 0;
+    }
+
+    /* Send up to the end of the buffer, the rest is sent next */
+    *idx = stdio_tail & (STDIO_BUFFER_SIZE - 1);
+    len = STDIO_BUFFER_SIZE - *idx;
+    if (len > pending) {
+        len = pending;
+    }
+
+    stdio_tx_len = len;
+    stdio_tx_seq++;
+
+    return len;
+}
+
+static void stdio_tx_done(void)
+{
+    stdio_tail += stdio_tx_len;
+    stdio_tx_len = 0;
+}
+
+/* Starts sending the buffered output if the UART is idle. With a driver which
+ * sends in the background and signals ARM_USART_EVENT_SEND_COMPLETE, the next
+ * transfer is started from the event. With a driver whose Send() returns once
+ * the data is sent, the buffer is sent here until it is empty.
+ */
+static void stdio_start_tx(void)
+{
+    uint32_t primask;
+    uint32_t len, idx = 0, seq;
+    int32_t ret;
+
+    for (;;) {
+        primask = __get_PRIMASK();
+        __disable_irq();
+        len = stdio_claim_tx(&idx);
+        seq = stdio_tx_seq;
+        __set_PRIMASK(primask);
+
+        if (len == 0) {
+            return;
+        }
+
+        ret = TFM_DRIVER_STDIO.Send(&stdio_buf[idx], len);
+
+        primask = __get_PRIMASK();
+        __disable_irq();
+        if (ret != ARM_DRIVER_OK) {
+            /* The output can't be sent, drop it rather than retry forever */
+            if ((stdio_tx_seq == seq) && (stdio_tx_len != 0)) {
+                stdio_tx_done();
+            }
+        } else if ((stdio_tx_seq == seq) && (stdio_tx_len != 0) &&
+                   !TFM_DRIVER_STDIO.GetStatus().tx_busy) {
+            /* Sent synchronously, the driver signals no event */
+            stdio_tx_done();
+        } else {
+            /* The send complete event continues the transfers */
+            len = 0;
+        }
+        __set_PRIMASK(primask);
+
+        if (len == 0) {
+            return;
+        }
+    }
+}
+
+static void stdio_event(uint32_t event)
+{
+    if ((event & ARM_USART_EVENT_SEND_COMPLETE) && (stdio_tx_len != 0)) {
+        stdio_tx_done();
+        stdio_start_tx();
+    }
+}
+
+int stdio_output_string(const unsigned char *str, uint32_t len)
+{
+    uint32_t primask;
+    uint32_t written = 0;
+    uint32_t space, chunk, idx;
+
+    while (written < len) {
+        primask = __get_PRIMASK();
+        __disable_irq();
+        space = STDIO_BUFFER_SIZE - (stdio_head - stdio_tail);
+        chunk = len - written;
+        if (chunk > space) {
+            chunk = space;
+        }
+        /* Copy in at most two parts, at the end and start of the buffer */
+        idx = stdio_head & (STDIO_BUFFER_SIZE - 1);
+        if (chunk > STDIO_BUFFER_SIZE - idx) {
+            (void)memcpy(&stdio_buf[idx], &str[written],
+                         STDIO_BUFFER_SIZE - idx);
+            (void)memcpy(stdio_buf, &str[written + STDIO_BUFFER_SIZE - idx],
+                         chunk - (STDIO_BUFFER_SIZE - idx));
+        } else {
+            (void)memcpy(&stdio_buf[idx], &str[written], chunk);
+        }
+        stdio_head += chunk;
+        __set_PRIMASK(primask);
+
+        written += chunk;
+        stdio_start_tx();
+
+#ifdef TFM_STDIO_OVERFLOW_DROP
+        /* Drop the output which doesn't fit in the buffer */
+        break;
+#endif
+    }
+
+    return (int)written;
+}
+
+/* Waits until the buffered output is sent */
+static void stdio_flush(void)
+{
+    while (stdio_head != stdio_tail) {
+        stdio_start_tx();
+    }
+}
+#else /* TFM_STDIO_BUFFERED */
 int stdio_output_string(const unsigned char *str, uint32_t len)
 {
     int32_t ret;
@@ -39,6 +199,7 @@ int stdio_output_string(const unsigned char *str, uint32_t len)
 
     return TFM_DRIVER_STDIO.GetTxCount();
 }
+#endif /* TFM_STDIO_BUFFERED */
 
 /* Redirects printf to TFM_DRIVER_STDIO in case of ARMCLANG*/
 #if defined(__ARMCC_VERSION)
@@ -80,7 +241,11 @@ int putchar(int ch)
 void stdio_init(void)
 {
     int32_t ret;
+#ifdef TFM_STDIO_BUFFERED
+    ret = TFM_DRIVER_STDIO.Initialize(stdio_event);
+#else
     ret = TFM_DRIVER_STDIO.Initialize(NULL);
+#endif
     ASSERT_HIGH(ret);
 
     ret = TFM_DRIVER_STDIO.PowerControl(ARM_POWER_FULL);
@@ -97,6 +262,10 @@ void stdio_uninit(void)
 {
     int32_t ret;
 
+#ifdef TFM_STDIO_BUFFERED
+    stdio_flush();
+#endif
+
     (void)TFM_DRIVER_STDIO.PowerControl(ARM_POWER_OFF);
 
     ret = TFM_DRIVER_STDIO.Uninitialize();
@@ -34,7 +34,8 @@
 
 #define DEFAULT_UART_BAUDRATE  115200
 
-#ifdef TFM_MULTI_CORE_MULTI_CLIENT_CALL
+#if defined(TFM_MULTI_CORE_MULTI_CLIENT_CALL) && \
+    !defined(NUM_MAILBOX_QUEUE_SLOT)
 #define NUM_MAILBOX_QUEUE_SLOT      4
 #endif
 
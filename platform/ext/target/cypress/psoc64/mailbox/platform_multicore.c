@@ -13,6 +13,10 @@
 
 #include "cy_ipc_drv.h"
 #include "cy_sysint.h"
+#ifdef TFM_MAILBOX_STATS
+#include "cy_sysclk.h"
+#include "cy_tcpwm_counter.h"
+#endif
 #if CY_SYSTEM_CPU_CM0P
 #include "spe_ipc_config.h"
 #else
@@ -103,6 +107,57 @@ void platform_mailbox_wait_for_notify(void)
                               0, IPC_RX_INT_MASK);
 }
 
+#ifdef TFM_MAILBOX_STATS
+int platform_mailbox_stats_timer_init(void)
+{
+    cy_stc_tcpwm_counter_config_t config = {
+        .period             = UINT32_MAX,   /* Wrap around at 32 bits */
+        .clockPrescaler     = CY_TCPWM_COUNTER_PRESCALER_DIVBY_1,
+        .runMode            = CY_TCPWM_COUNTER_CONTINUOUS,
+        .countDirection     = CY_TCPWM_COUNTER_COUNT_UP,
+        .compareOrCapture   = CY_TCPWM_COUNTER_MODE_COMPARE,
+        .compare0           = UINT32_MAX,
+        .compare1           = 0,
+        .enableCompareSwap  = false,
+        .interruptSources   = CY_TCPWM_INT_NONE,
+        .captureInputMode   = CY_TCPWM_INPUT_RISINGEDGE,
+        .captureInput       = CY_TCPWM_INPUT_0,
+        .reloadInputMode    = CY_TCPWM_INPUT_RISINGEDGE,
+        .reloadInput        = CY_TCPWM_INPUT_0,
+        .startInputMode     = CY_TCPWM_INPUT_RISINGEDGE,
+        .startInput         = CY_TCPWM_INPUT_0,
+        .stopInputMode      = CY_TCPWM_INPUT_RISINGEDGE,
+        .stopInput          = CY_TCPWM_INPUT_0,
+        .countInputMode     = CY_TCPWM_INPUT_LEVEL,
+        .countInput         = CY_TCPWM_INPUT_1,
+    };
+
+    /* Share the peripheral clock divider of the other TCPWM0 counters */
+    if (Cy_SysClk_PeriphAssignDivider(MAILBOX_STATS_TCPWM_CLOCK,
+                                      CY_SYSCLK_DIV_8_BIT, 1U) !=
+        CY_SYSCLK_SUCCESS) {
+        return PLATFORM_MAILBOX_INIT_ERROR;
+    }
+
+    if (Cy_TCPWM_Counter_Init(MAILBOX_STATS_TCPWM, MAILBOX_STATS_TCPWM_CNT,
+                              &config) != CY_TCPWM_SUCCESS) {
+        return PLATFORM_MAILBOX_INIT_ERROR;
+    }
+
+    Cy_TCPWM_Counter_Enable(MAILBOX_STATS_TCPWM, MAILBOX_STATS_TCPWM_CNT);
+    Cy_TCPWM_TriggerStart(MAILBOX_STATS_TCPWM,
+                          (1UL << MAILBOX_STATS_TCPWM_CNT));
+
+    return PLATFORM_MAILBOX_SUCCESS;
+}
+
+uint32_t platform_mailbox_stats_timer_read(void)
+{
+    return Cy_TCPWM_Counter_GetCounter(MAILBOX_STATS_TCPWM,
+                                       MAILBOX_STATS_TCPWM_CNT);
+}
+#endif
+
 int platform_ns_ipc_init(void)
 {
     Cy_IPC_Drv_SetInterruptMask(Cy_IPC_Drv_GetIntrBaseAddr(IPC_RX_INTR_STRUCT),
@@ -46,6 +46,11 @@
 
 #define IPC_SYNC_MAGIC                   0x7DADE011
 
+/* TCPWM counter free-running as the timer shared by both cores */
+#define MAILBOX_STATS_TCPWM              TCPWM0
+#define MAILBOX_STATS_TCPWM_CNT          (2)
+#define MAILBOX_STATS_TCPWM_CLOCK        PCLK_TCPWM0_CLOCKS2
+
 /**
  * \brief Fetch a pointer from mailbox message
  *
@@ -91,6 +96,23 @@ int platform_mailbox_send_msg_data(uint32_t data);
  */
 void platform_mailbox_wait_for_notify(void);
 
+#ifdef TFM_MAILBOX_STATS
+/**
+ * \brief Start the timer shared by both cores. Called by SPE only.
+ *
+ * \retval 0               The operation succeeds.
+ * \retval else            The operation fails.
+ */
+int platform_mailbox_stats_timer_init(void);
+
+/**
+ * \brief Read the timer shared by both cores.
+ *
+ * \return The timer value.
+ */
+uint32_t platform_mailbox_stats_timer_read(void);
+#endif
+
 /**
  * \brief IPC initialization
  *
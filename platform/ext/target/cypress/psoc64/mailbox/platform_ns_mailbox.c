@@ -128,6 +128,36 @@ void tfm_ns_mailbox_hal_wait_reply(mailbox_msg_handle_t handle)
     os_wrapper_thread_wait_flag((uint32_t)handle, OS_WRAPPER_WAIT_FOREVER);
 }
 
+#ifdef TFM_MAILBOX_STATS
+uint32_t tfm_ns_mailbox_hal_get_timestamp(void)
+{
+    return platform_mailbox_stats_timer_read();
+}
+#endif
+
+#ifdef TFM_MAILBOX_CACHE_MAINT
+/* CM4 accesses the shared SRAM without a data cache. Nothing to maintain. */
+void tfm_ns_mailbox_hal_cache_clean(void *addr, size_t size)
+{
+    (void)addr;
+    (void)size;
+}
+
+void tfm_ns_mailbox_hal_cache_invalidate(void *addr, size_t size)
+{
+    (void)addr;
+    (void)size;
+}
+#endif
+
+#ifdef TFM_MAILBOX_COALESCE
+void tfm_ns_mailbox_hal_wait_reply_timeout(mailbox_msg_handle_t handle,
+                                           uint32_t timeout)
+{
+    os_wrapper_thread_wait_flag((uint32_t)handle, timeout);
+}
+#endif
+
 static cy_en_ipcsema_status_t mailbox_raw_spin_lock(uint32_t ipc_channel,
                                                     uint32_t sema_num)
 {
@@ -257,6 +287,18 @@ void tfm_ns_mailbox_hal_exit_critical_isr(void)
     mailbox_raw_spin_unlock(CY_IPC_CHAN_SEMA, MAILBOX_SEMAPHORE_NUM);
 }
 
+#ifdef TFM_MAILBOX_RING
+void tfm_ns_mailbox_hal_enter_local_critical(void)
+{
+    saved_irq_state = Cy_SysLib_EnterCriticalSection();
+}
+
+void tfm_ns_mailbox_hal_exit_local_critical(void)
+{
+    Cy_SysLib_ExitCriticalSection(saved_irq_state);
+}
+#endif
+
 static bool mailbox_clear_intr(void)
 {
     uint32_t status;
@@ -276,24 +318,20 @@ static bool mailbox_clear_intr(void)
 void cpuss_interrupts_ipc_5_IRQHandler(void)
 {
     uint32_t magic;
-    mailbox_msg_handle_t handle;
-    void *task_handle;
+    struct ns_mailbox_replied_msg_t msgs[NUM_MAILBOX_QUEUE_SLOT];
+    uint8_t i, nr_msgs;
 
     if (!mailbox_clear_intr())
         return;
 
     platform_mailbox_fetch_msg_data(&magic);
     if (magic == PSA_CLIENT_CALL_REPLY_MAGIC) {
-        /* Handle all the pending replies */
-        while (1) {
-            handle = tfm_ns_mailbox_fetch_reply_msg_isr();
-            if (handle == MAILBOX_MSG_NULL_HANDLE) {
-                break;
-            }
-
-            task_handle = (void *)tfm_ns_mailbox_get_msg_owner(handle);
-            if (task_handle) {
-                os_wrapper_thread_set_flag_isr(task_handle, (uint32_t)handle);
+        /* Handle all the pending replies in one pass */
+        nr_msgs = tfm_ns_mailbox_fetch_replies_isr(msgs);
+        for (i = 0; i < nr_msgs; i++) {
+            if (msgs[i].owner) {
+                os_wrapper_thread_set_flag_isr((void *)msgs[i].owner,
+                                               (uint32_t)msgs[i].handle);
             }
         }
     }
@@ -71,6 +71,13 @@ int32_t tfm_mailbox_hal_init(struct secure_mailbox_queue_t *s_queue)
     if (tfm_mailbox_sema_init() != PLATFORM_MAILBOX_SUCCESS)
         return MAILBOX_INIT_ERROR;
 
+#ifdef TFM_MAILBOX_STATS
+    /* Start the shared timer before NSPE can submit any request */
+    if (platform_mailbox_stats_timer_init() != PLATFORM_MAILBOX_SUCCESS) {
+        return MAILBOX_INIT_ERROR;
+    }
+#endif
+
     /* Inform NSPE that NSPE mailbox initialization can start */
     platform_mailbox_send_msg_data(NS_MAILBOX_INIT_ENABLE);
 
@@ -85,7 +92,12 @@ int32_t tfm_mailbox_hal_init(struct secure_mailbox_queue_t *s_queue)
      * be implemented there.
      */
 
-    s_queue->ns_queue = ns_queue;
+    (void)s_queue;
+
+    /* The single NS core owns the only NSPE mailbox queue */
+    if (tfm_mailbox_register_ns_queue(0, ns_queue, 1) != MAILBOX_SUCCESS) {
+        return MAILBOX_INIT_ERROR;
+    }
 
     mailbox_ipc_config();
 
@@ -95,6 +107,28 @@ int32_t tfm_mailbox_hal_init(struct secure_mailbox_queue_t *s_queue)
     return MAILBOX_SUCCESS;
 }
 
+#ifdef TFM_MAILBOX_STATS
+uint32_t tfm_mailbox_hal_get_timestamp(void)
+{
+    return platform_mailbox_stats_timer_read();
+}
+#endif
+
+#ifdef TFM_MAILBOX_CACHE_MAINT
+/* CM0+ has no data cache. Nothing to maintain. */
+void tfm_mailbox_hal_cache_clean(void *addr, size_t size)
+{
+    (void)addr;
+    (void)size;
+}
+
+void tfm_mailbox_hal_cache_invalidate(void *addr, size_t size)
+{
+    (void)addr;
+    (void)size;
+}
+#endif
+
 void tfm_mailbox_hal_enter_critical(void)
 {
     while (CY_IPC_SEMA_SUCCESS !=
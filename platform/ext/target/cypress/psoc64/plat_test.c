@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2020, Arm Limited. All rights reserved.
  * Copyright (c) 2019-2020, Cypress Semiconductor Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
@@ -52,6 +52,22 @@ void tfm_plat_test_secure_timer_stop(void)
     );
 }
 
+void tfm_plat_test_secure_timer_clear_intr(void)
+{
+    Cy_TCPWM_ClearInterrupt(CY_TCPWM0_TIMER0_DEV_S.tcpwm_base,
+                            CY_TCPWM0_TIMER0_DEV_S.tcpwm_counter_num,
+                            CY_TCPWM_INT_ON_CC);
+}
+
+uint32_t tfm_plat_test_secure_timer_get_elapsed(void)
+{
+    /* The counter counts up and wraps around when it asserts its interrupt */
+    return Cy_TCPWM_Counter_GetCounter(
+        CY_TCPWM0_TIMER0_DEV_S.tcpwm_base,
+        CY_TCPWM0_TIMER0_DEV_S.tcpwm_counter_num
+    );
+}
+
 void tfm_plat_test_non_secure_timer_start(void)
 {
     cy_en_tcpwm_status_t rc;
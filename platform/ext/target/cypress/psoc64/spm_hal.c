@@ -216,6 +216,16 @@ uint32_t tfm_spm_hal_get_ns_entry_point(void)
     return *((uint32_t *)(memory_regions.non_secure_code_start+ 4));
 }
 
+#ifdef TFM_PSA_API
+uint32_t tfm_spm_hal_enter_idle(void)
+{
+    /* Only sleep until the next interrupt, no deeper state is used */
+    __WFI();
+
+    return 0;
+}
+#endif
+
 void tfm_spm_hal_boot_ns_cpu(uintptr_t start_addr)
 {
     smpu_print_config();
@@ -349,6 +359,11 @@ void tfm_spm_hal_clear_pending_irq(int32_t irq_line)
     NVIC_ClearPendingIRQ(irq_line);
 }
 
+void tfm_spm_hal_set_pending_irq(int32_t irq_line)
+{
+    NVIC_SetPendingIRQ(irq_line);
+}
+
 void tfm_spm_hal_enable_irq(int32_t irq_line)
 {
     NVIC_EnableIRQ(irq_line);
@@ -369,6 +384,13 @@ enum irq_target_state_t tfm_spm_hal_set_irq_target_state(
     return TFM_IRQ_TARGET_STATE_SECURE;
 }
 
+enum irq_target_state_t tfm_spm_hal_get_irq_target_state(int32_t irq_line)
+{
+    (void)irq_line;
+
+    return TFM_IRQ_TARGET_STATE_SECURE;
+}
+
 enum tfm_plat_err_t tfm_spm_hal_nvic_interrupt_target_state_cfg(void)
 {
     return nvic_interrupt_target_state_cfg();
@@ -97,17 +97,39 @@ static int32_t is_sector_aligned(struct arm_flash_dev_t *flash_dev,
 
 static int32_t is_flash_ready_to_write(const uint8_t *start_addr, uint32_t cnt)
 {
-    int32_t rc = 0;
-    uint32_t i;
+    const uint32_t erased_word = ARM_FLASH_DRV_ERASE_VALUE * 0x01010101u;
+    const uint32_t *word_addr;
+
+    /* Check the bytes up to the first word boundary byte by byte, the bulk of
+     * the area a word at a time, then the remaining bytes.
+     */
+    while ((cnt > 0) && (((uintptr_t)start_addr % sizeof(uint32_t)) != 0)) {
+        if (*start_addr != ARM_FLASH_DRV_ERASE_VALUE) {
+            return -1;
+        }
+        start_addr++;
+        cnt--;
+    }
 
-    for (i = 0; i < cnt; i++) {
-        if(start_addr[i] != ARM_FLASH_DRV_ERASE_VALUE) {
-            rc = -1;
-            break;
+    word_addr = (const uint32_t *)start_addr;
+    while (cnt >= sizeof(uint32_t)) {
+        if (*word_addr != erased_word) {
+            return -1;
         }
+        word_addr++;
+        cnt -= sizeof(uint32_t);
     }
 
-    return rc;
+    start_addr = (const uint8_t *)word_addr;
+    while (cnt > 0) {
+        if (*start_addr != ARM_FLASH_DRV_ERASE_VALUE) {
+            return -1;
+        }
+        start_addr++;
+        cnt--;
+    }
+
+    return 0;
 }
 
 #if (RTE_FLASH0)
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -72,6 +72,17 @@ void tfm_plat_test_secure_timer_stop(void)
     cmsdk_timer_clear_interrupt(&CMSDK_TIMER0_DEV_S);
 }
 
+void tfm_plat_test_secure_timer_clear_intr(void)
+{
+    cmsdk_timer_clear_interrupt(&CMSDK_TIMER0_DEV_S);
+}
+
+uint32_t tfm_plat_test_secure_timer_get_elapsed(void)
+{
+    /* The timer reloads when it asserts its interrupt */
+    return cmsdk_timer_get_elapsed_value(&CMSDK_TIMER0_DEV_S);
+}
+
 void tfm_plat_test_non_secure_timer_start(void)
 {
     if (!cmsdk_timer_is_initialized(&CMSDK_TIMER1_DEV_NS)) {
@@ -268,7 +268,12 @@ const struct sau_cfg_t sau_cfg[] = {
     },
     {
         NS_DATA_START,
+#ifdef TFM_CRYPTO_CONTEXT_SPILL
+        /* The spill area of the Crypto service follows the NS data */
+        TFM_CRYPTO_SPILL_AREA_LIMIT,
+#else
         NS_DATA_LIMIT,
+#endif
         0U,
     },
     {
@@ -352,8 +357,14 @@ int32_t mpc_init_cfg(void)
         return ret;
     }
 
+#ifdef TFM_CRYPTO_CONTEXT_SPILL
+    ret = Driver_SRAM2_MPC.ConfigRegion(NS_DATA_START,
+                                        TFM_CRYPTO_SPILL_AREA_LIMIT,
+                                        ARM_MPC_ATTR_NONSECURE);
+#else
     ret = Driver_SRAM2_MPC.ConfigRegion(NS_DATA_START, NS_DATA_LIMIT,
                                         ARM_MPC_ATTR_NONSECURE);
+#endif
     if (ret != ARM_DRIVER_OK) {
         return ret;
     }
@@ -115,7 +115,18 @@
 #define NS_CODE_LIMIT   (NS_CODE_START + NS_CODE_SIZE - 1)
 
 #define NS_DATA_START   (NS_RAM_ALIAS(TOTAL_RAM_SIZE / 2))
+#ifdef TFM_CRYPTO_CONTEXT_SPILL
+/* The Crypto service seals its idle operation contexts to the top of the
+ * non-secure RAM, which is left out of the non-secure data.
+ */
+#define TFM_CRYPTO_SPILL_AREA_SIZE  (0x20000)
+#define NS_DATA_SIZE    (TOTAL_RAM_SIZE / 2 - TFM_CRYPTO_SPILL_AREA_SIZE)
+#define TFM_CRYPTO_SPILL_AREA_START (NS_DATA_START + NS_DATA_SIZE)
+#define TFM_CRYPTO_SPILL_AREA_LIMIT \
+            (TFM_CRYPTO_SPILL_AREA_START + TFM_CRYPTO_SPILL_AREA_SIZE - 1)
+#else
 #define NS_DATA_SIZE    (TOTAL_RAM_SIZE / 2)
+#endif
 #define NS_DATA_LIMIT   (NS_DATA_START + NS_DATA_SIZE - 1)
 
 /* NS partition information is used for MPC and SAU configuration */
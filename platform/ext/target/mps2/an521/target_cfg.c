@@ -333,7 +333,12 @@ const struct sau_cfg_t sau_cfg[] = {
     },
     {
         NS_DATA_START,
+#ifdef TFM_CRYPTO_CONTEXT_SPILL
+        /* The spill area of the Crypto service follows the NS data */
+        TFM_CRYPTO_SPILL_AREA_LIMIT,
+#else
         NS_DATA_LIMIT,
+#endif
         0U,
     },
     {
@@ -365,7 +370,8 @@ const struct sau_cfg_t sau_cfg[] = {
         PERIPHERALS_BASE_NS_END,
         0U,
     },
-#ifdef BL2
+#if defined(BL2) && !defined(TFM_PARTITION_FIRMWARE_UPDATE)
+    /* The firmware update partition owns the secondary slots */
     {
         (uint32_t)&REGION_NAME(Load$$LR$$, LR_SECONDARY_PARTITION, $$Base),
         (uint32_t)&REGION_NAME(Load$$LR$$, LR_SECONDARY_PARTITION, $$Base) +
@@ -414,23 +420,31 @@ int32_t mpc_init_cfg(void)
         return ret;
     }
 
-#ifdef BL2
-    /* Secondary image region */
+#if defined(BL2) && !defined(TFM_PARTITION_FIRMWARE_UPDATE)
+    /* Secondary image region, left secure when the firmware update partition
+     * writes it, so that the non-secure image cannot alter an update.
+     */
     ret = Driver_SRAM1_MPC.ConfigRegion(memory_regions.secondary_partition_base,
                                   memory_regions.secondary_partition_limit,
                                   ARM_MPC_ATTR_NONSECURE);
     if (ret != ARM_DRIVER_OK) {
         return ret;
     }
-#endif /* BL2 */
+#endif
 
     ret = Driver_SRAM2_MPC.Initialize();
     if (ret != ARM_DRIVER_OK) {
         return ret;
     }
 
+#ifdef TFM_CRYPTO_CONTEXT_SPILL
+    ret = Driver_SRAM2_MPC.ConfigRegion(NS_DATA_START,
+                                        TFM_CRYPTO_SPILL_AREA_LIMIT,
+                                        ARM_MPC_ATTR_NONSECURE);
+#else
     ret = Driver_SRAM2_MPC.ConfigRegion(NS_DATA_START, NS_DATA_LIMIT,
                                         ARM_MPC_ATTR_NONSECURE);
+#endif
     if (ret != ARM_DRIVER_OK) {
         return ret;
     }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -74,6 +74,20 @@ void tfm_plat_test_secure_timer_stop(void)
     systimer_armv8_m_clear_autoinc_interrupt(&SYSTIMER0_ARMV8_M_DEV_S);
 }
 
+void tfm_plat_test_secure_timer_clear_intr(void)
+{
+    systimer_armv8_m_clear_autoinc_interrupt(&SYSTIMER0_ARMV8_M_DEV_S);
+}
+
+uint32_t tfm_plat_test_secure_timer_get_elapsed(void)
+{
+    /* The compare value moves by the reload value when the interrupt is
+     * asserted, and the timer value counts down to it
+     */
+    return systimer_armv8_m_get_autoinc_reload(&SYSTIMER0_ARMV8_M_DEV_S) -
+           systimer_armv8_m_get_timer_value(&SYSTIMER0_ARMV8_M_DEV_S);
+}
+
 void tfm_plat_test_non_secure_timer_start(void)
 {
     systimer_armv8_m_init(&SYSTIMER1_ARMV8_M_DEV_NS);
@@ -235,6 +235,16 @@ uint32_t tfm_spm_hal_get_ns_entry_point(void)
     return *((uint32_t *)(memory_regions.non_secure_code_start + 4));
 }
 
+#ifdef TFM_PSA_API
+uint32_t tfm_spm_hal_enter_idle(void)
+{
+    /* Only sleep until the next interrupt, no deeper state is used */
+    __WFI();
+
+    return 0;
+}
+#endif
+
 enum tfm_plat_err_t tfm_spm_hal_init_debug(void)
 {
     volatile struct sysctrl_t *sys_ctrl =
@@ -287,6 +297,11 @@ void tfm_spm_hal_clear_pending_irq(int32_t irq_line)
     NVIC_ClearPendingIRQ(irq_line);
 }
 
+void tfm_spm_hal_set_pending_irq(int32_t irq_line)
+{
+    NVIC_SetPendingIRQ(irq_line);
+}
+
 void tfm_spm_hal_enable_irq(int32_t irq_line)
 {
     NVIC_EnableIRQ(irq_line);
@@ -316,6 +331,20 @@ enum irq_target_state_t tfm_spm_hal_set_irq_target_state(
     }
 }
 
+enum irq_target_state_t tfm_spm_hal_get_irq_target_state(int32_t irq_line)
+{
+    /* Lines beyond the NVIC are reported as Secure, they cannot be used */
+    if ((irq_line < 0) || (irq_line >= (int32_t)(sizeof(NVIC->ITNS) * 8U))) {
+        return TFM_IRQ_TARGET_STATE_SECURE;
+    }
+
+    if (NVIC_GetTargetState(irq_line)) {
+        return TFM_IRQ_TARGET_STATE_NON_SECURE;
+    } else {
+        return TFM_IRQ_TARGET_STATE_SECURE;
+    }
+}
+
 enum tfm_plat_err_t tfm_spm_hal_enable_fault_handlers(void)
 {
     return enable_fault_handlers();
@@ -52,4 +52,12 @@
 #define EFLASH0_DEV         GFC100_EFLASH0_DEV_S
 #define FLASH0_DEV          MT25QL_DEV_S
 
+/* Set to 1 to program the embedded flash with row writes, which are
+ * significantly faster but run with the interrupts disabled. See
+ * Driver_GFC100_EFlash.c.
+ */
+#ifndef EFLASH_ROW_WRITE
+#define EFLASH_ROW_WRITE    0
+#endif
+
 #endif  /* __CMSIS_DRIVER_CONFIG_H__ */
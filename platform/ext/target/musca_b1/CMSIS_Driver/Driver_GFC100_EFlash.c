@@ -36,6 +36,13 @@
 #define ARG_NOT_USED    0U
 #endif
 
+/* Maximum number of bytes written by one row write burst, which bounds the
+ * time the interrupts are disabled for.
+ */
+#ifndef EFLASH_ROW_WRITE_BURST_SIZE
+#define EFLASH_ROW_WRITE_BURST_SIZE    (256u)
+#endif
+
 /* Driver version */
 #define ARM_FLASH_DRV_VERSION   ARM_DRIVER_VERSION_MAJOR_MINOR(1, 0)
 
@@ -192,17 +199,41 @@ static int32_t ARM_Flashx_ProgramData(ARM_FLASHx_Resources *ARM_FLASHx_DEV,
                                       uint32_t cnt)
 {
     enum gfc100_error_t err = GFC100_ERROR_NONE;
+#if EFLASH_ROW_WRITE
+    uint32_t burst_len;
+    uint32_t primask;
+#endif
 
     ARM_FLASHx_DEV->status.error = DRIVER_STATUS_NO_ERROR;
     ARM_FLASHx_DEV->status.busy = DRIVER_STATUS_BUSY;
 
+#if EFLASH_ROW_WRITE
+    /* The row write command keeps the transfer open between consecutive
+     * words, which is significantly faster than the simple write. It is
+     * sensitive to timing, so the interrupts are disabled for each burst.
+     */
+    while ((cnt > 0) && (err == GFC100_ERROR_NONE)) {
+        burst_len = (cnt > EFLASH_ROW_WRITE_BURST_SIZE) ?
+                    EFLASH_ROW_WRITE_BURST_SIZE : cnt;
+
+        primask = __get_PRIMASK();
+        __disable_irq();
+        err = gfc100_eflash_row_write(ARM_FLASHx_DEV->dev, addr, data,
+                                      &burst_len);
+        __set_PRIMASK(primask);
+
+        addr += burst_len;
+        data = (const uint8_t *)data + burst_len;
+        cnt -= burst_len;
+    }
+#else
     /* Note: There is a significantly faster way to write to the flash using
-     * gfc100_eflash_row_write. It has the disadvantage that all IRQs have
-     * to be disabled, because the implementation is sensitive to timing.
-     * For applications where timing can be guaranteed this can be replaced
-     * with gfc100_eflash_row_write. For generic use, simple write is used here.
+     * gfc100_eflash_row_write, see EFLASH_ROW_WRITE. It has the disadvantage
+     * that all IRQs have to be disabled, because the implementation is
+     * sensitive to timing. For generic use, simple write is used here.
      */
     err = gfc100_eflash_write(ARM_FLASHx_DEV->dev, addr, data, &cnt);
+#endif
 
     ARM_FLASHx_DEV->status.busy = DRIVER_STATUS_IDLE;
 
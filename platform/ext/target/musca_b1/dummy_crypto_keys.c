@@ -177,4 +177,29 @@ tfm_plat_get_rotpk_hash(uint8_t image_id,
 
     return TFM_PLAT_ERR_SUCCESS;
 }
+
+/* The key encryption key of the firmware images, in bl2/ext/mcuboot/
+ * enc-aes128kw.b64.
+ */
+static const uint8_t sample_enc_image_kek[ENC_IMAGE_KEK_LEN] =
+             {0x6A, 0x65, 0x73, 0x33, 0x68, 0xA6, 0x14, 0x7F, \
+              0xE5, 0xF1, 0x98, 0x50, 0x71, 0x6E, 0xD2, 0x1A};
+
+enum tfm_plat_err_t
+tfm_plat_get_enc_image_kek(uint8_t image_id,
+                           uint8_t *kek,
+                           uint32_t *kek_size)
+{
+    /* The same key encryption key is used for all the images */
+    (void)image_id;
+
+    if (*kek_size < ENC_IMAGE_KEK_LEN) {
+        return TFM_PLAT_ERR_SYSTEM_ERR;
+    }
+
+    *kek_size = ENC_IMAGE_KEK_LEN;
+    copy_key(kek, sample_enc_image_kek, *kek_size);
+
+    return TFM_PLAT_ERR_SUCCESS;
+}
 #endif /* BL2 */
@@ -49,6 +49,7 @@ struct ecc_key_t {
 };
 
 #define ROTPK_HASH_LEN (32u) /* SHA256 */
+#define ENC_IMAGE_KEK_LEN (16u) /* AES-128 */
 
 /**
  * Structure to store the hard-coded (embedded in secure firmware) hash of ROTPK
@@ -130,6 +131,22 @@ tfm_plat_get_rotpk_hash(uint8_t image_id,
                         uint8_t *rotpk_hash,
                         uint32_t *rotpk_hash_size);
 
+/**
+ * \brief Get the key encryption key, which unwraps the AES keys of the
+ *        encrypted firmware images.
+ *
+ * \param[in]      image_id  The identifier of firmware image
+ * \param[out]     kek       Buffer to store the key in
+ * \param[in,out]  kek_size  As input the size of the buffer. As output the
+ *                           actual key length.
+ *
+ * \return Returns error code specified in \ref tfm_plat_err_t
+ */
+enum tfm_plat_err_t
+tfm_plat_get_enc_image_kek(uint8_t image_id,
+                           uint8_t *kek,
+                           uint32_t *kek_size);
+
 #ifdef __cplusplus
 }
 #endif
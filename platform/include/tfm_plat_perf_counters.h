@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __TFM_PLAT_PERF_COUNTERS_H__
+#define __TFM_PLAT_PERF_COUNTERS_H__
+/**
+ * \note A common implementation of these interfaces, for the DWT of Armv7-M
+ *       and Armv8-M Mainline and the PMU of Armv8.1-M Mainline, is in
+ *       platform/ext/common/tfm_plat_perf_counters.c. Its functions are weak,
+ *       a target can replace them to use other counters.
+ */
+
+#include "tfm_plat_defs.h"
+#include "tfm_perf_counters_defs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Gets the performance counters of the platform.
+ *
+ * \param[out] info  Number of event counters and capabilities
+ *
+ * \return Returns values as specified by the \ref tfm_plat_err_t
+ */
+TFM_LINK_SET_RO_IN_PARTITION_SECTION("TFM_SP_PLATFORM")
+enum tfm_plat_err_t tfm_plat_perf_get_info(struct tfm_perf_info_t *info);
+
+/**
+ * \brief Assigns the events to count to the event counters. The counters
+ *        are stopped.
+ *
+ * \param[in] config  Events to count, one counter each
+ *
+ * \return Returns TFM_PLAT_ERR_INVALID_INPUT if there are more events than
+ *         counters, or if an event is not supported or asked twice when its
+ *         counter is dedicated to it. Other values are returned as specified
+ *         by the \ref tfm_plat_err_t
+ */
+TFM_LINK_SET_RO_IN_PARTITION_SECTION("TFM_SP_PLATFORM")
+enum tfm_plat_err_t
+tfm_plat_perf_config(const struct tfm_perf_config_t *config);
+
+/**
+ * \brief Resets the configured counters and the cycle count, and starts them.
+ *        The events are counted in both security states.
+ *
+ * \return Returns values as specified by the \ref tfm_plat_err_t
+ */
+TFM_LINK_SET_RO_IN_PARTITION_SECTION("TFM_SP_PLATFORM")
+enum tfm_plat_err_t tfm_plat_perf_start(void);
+
+/**
+ * \brief Stops the counters, which keep their values.
+ *
+ * \return Returns values as specified by the \ref tfm_plat_err_t
+ */
+TFM_LINK_SET_RO_IN_PARTITION_SECTION("TFM_SP_PLATFORM")
+enum tfm_plat_err_t tfm_plat_perf_stop(void);
+
+/**
+ * \brief Reads the counters, running or stopped.
+ *
+ * \param[out] values  Cycle count and counters, in configuration order. The
+ *                     counters which are not configured read 0.
+ *
+ * \return Returns values as specified by the \ref tfm_plat_err_t
+ */
+TFM_LINK_SET_RO_IN_PARTITION_SECTION("TFM_SP_PLATFORM")
+enum tfm_plat_err_t tfm_plat_perf_read(struct tfm_perf_values_t *values);
+
+/**
+ * \brief Stops the counters, drops their configuration and restores what was
+ *        changed to count in the secure state.
+ *
+ * \return Returns values as specified by the \ref tfm_plat_err_t
+ */
+TFM_LINK_SET_RO_IN_PARTITION_SECTION("TFM_SP_PLATFORM")
+enum tfm_plat_err_t tfm_plat_perf_release(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TFM_PLAT_PERF_COUNTERS_H__ */
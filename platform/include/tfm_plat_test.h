@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -63,6 +63,25 @@ void tfm_plat_test_secure_timer_start(void);
 TFM_LINK_SET_RO_IN_PARTITION_SECTION("TFM_IRQ_TEST_1")
 void tfm_plat_test_secure_timer_stop(void);
 
+/**
+ * \brief Clears the Secure timer interrupt, the timer keeps counting.
+ */
+TFM_LINK_SET_RO_IN_PARTITION_SECTION("TFM_IRQ_TEST_1")
+void tfm_plat_test_secure_timer_clear_intr(void);
+
+/**
+ * \brief Gets the time elapsed since the Secure timer interrupt was last
+ *        asserted
+ *
+ * The timer is periodic, so this is the time since the timer was started
+ * until its first interrupt. It is used to measure the interrupt latency
+ * without the cycle counter, which unprivileged partitions cannot read.
+ *
+ * \return Returns the number of timer ticks since the last timer interrupt
+ */
+TFM_LINK_SET_RO_IN_PARTITION_SECTION("TFM_IRQ_TEST_1")
+uint32_t tfm_plat_test_secure_timer_get_elapsed(void);
+
 /**
  * \brief starts Non-secure timer
  *
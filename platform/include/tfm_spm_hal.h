@@ -231,6 +231,13 @@ enum tfm_plat_err_t tfm_spm_hal_set_secure_irq_priority(int32_t irq_line,
  */
 void tfm_spm_hal_clear_pending_irq(int32_t irq_line);
 
+/**
+ * \brief Sets an IRQ pending
+ *
+ * \param[in] irq_line    The IRQ to set pending.
+ */
+void tfm_spm_hal_set_pending_irq(int32_t irq_line);
+
 /**
  * \brief Enables an IRQ
  *
@@ -260,6 +267,54 @@ enum irq_target_state_t tfm_spm_hal_set_irq_target_state(
                                           int32_t irq_line,
                                           enum irq_target_state_t target_state);
 
+/**
+ * \brief Get the target state of an IRQ
+ *
+ * \param[in] irq_line      The IRQ to get the target state of.
+ *
+ * \return                TFM_IRQ_TARGET_STATE_SECURE if interrupt is assigned
+ *                        to Secure
+ *                        TFM_IRQ_TARGET_STATE_NON_SECURE if interrupt is
+ *                        assigned to Non-Secure
+ */
+enum irq_target_state_t tfm_spm_hal_get_irq_target_state(int32_t irq_line);
+
+#ifdef TFM_PSA_API
+/**
+ * \brief Puts the secure CPU in a low power state while SPM is idle.
+ *
+ * \details Called by SPM when no secure partition is ready to run. Returns
+ *          once an interrupt is pending. A WFI is enough, but the platform may
+ *          enter a deeper sleep state instead.
+ *
+ * \return Returns the wake-up latency of the low power state entered, in
+ *         microseconds. 0 if the state has no significant wake-up latency.
+ */
+uint32_t tfm_spm_hal_enter_idle(void);
+
+/**
+ * \brief Copies a buffer with a DMA engine of the platform.
+ *
+ * \details Called by SPM for the copies of psa_read() and psa_write() which
+ *          are at least TFM_SPM_DMA_COPY_THRESHOLD bytes long. The copy is
+ *          complete when the function returns. The platform allocates a secure
+ *          channel of the engine for the copy. Either buffer may be in
+ *          non-secure memory; SPM has already checked that the caller is
+ *          allowed to access both of them.
+ *
+ * \param[out] dst             Destination of the copy
+ * \param[in]  src             Source of the copy
+ * \param[in]  size            Size of the copy in bytes
+ *
+ * \return Returns values as specified by the \ref tfm_plat_err_t. SPM copies
+ *         the buffer with the CPU if the return value is not
+ *         TFM_PLAT_ERR_SUCCESS, so the platforms without a DMA engine return
+ *         TFM_PLAT_ERR_UNSUPPORTED.
+ */
+enum tfm_plat_err_t tfm_spm_hal_dma_copy(void *dst, const void *src,
+                                         size_t size);
+#endif /* defined(TFM_PSA_API) */
+
 #ifdef TFM_MULTI_CORE_TOPOLOGY
 /**
  * \brief Performs the necessary actions to start the non-secure CPU running
@@ -17,7 +17,7 @@
 #define MCUBOOT_UPGRADE_STRATEGY    1
 
 //   <o>Signature Type
-//     <1=> RSA-3072 <2=> RSA-2048
+//     <1=> RSA-3072 <2=> RSA-2048 <3=> EC-P256
 #define MCUBOOT_SIGNATURE_TYPE      1
 
 //   <o>Number of Images
@@ -60,6 +60,8 @@
 #elif  (MCUBOOT_SIGNATURE_TYPE == 2)
 #define MCUBOOT_SIGN_RSA
 #define MCUBOOT_SIGN_RSA_LEN 2048
+#elif  (MCUBOOT_SIGNATURE_TYPE == 3)
+#define MCUBOOT_SIGN_EC256
 #else
 #error "MCUBoot Configuration: Invalid Signature Type!"
 #endif
@@ -80,6 +80,12 @@ __STATIC_INLINE void __set_CONTROL_SPSEL(uint32_t SPSEL)
     __ISB();
 }
 
+/*
+ * Copy nwords 32-bit words between word-aligned buffers, using the widest
+ * LDM/STM bursts the architecture can encode.
+ */
+void tfm_arch_copy_words(uint32_t *dest, const uint32_t *src, size_t nwords);
+
 /*
  * Initialize CPU architecture specific thread context extension
  */
@@ -91,6 +97,12 @@ void tfm_arch_init_actx(struct tfm_arch_ctx_t *p_actx,
  */
 void tfm_arch_prioritize_secure_exception(void);
 
+/*
+ * Enable the lazy preservation of the float point context, when the image is
+ * built for the FPU.
+ */
+void tfm_arch_configure_fp(void);
+
 /*
  * Clear float point status.
  */
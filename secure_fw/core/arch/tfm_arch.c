@@ -8,6 +8,37 @@
 #include "tfm_arch.h"
 #include "tfm_core_utils.h"
 
+void tfm_arch_copy_words(uint32_t *dest, const uint32_t *src, size_t nwords)
+{
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || \
+    defined(__ARM_ARCH_8M_MAIN__) || defined(__ARM_ARCH_8_1M_MAIN__)
+    /* Mainline can list high registers, move 8 words per burst */
+    while (nwords >= 8) {
+        __ASM volatile("ldmia %0!, {r2-r6, r8, r10, r12}    \n"
+                       "stmia %1!, {r2-r6, r8, r10, r12}    \n"
+                       : "+r" (src), "+r" (dest)
+                       :
+                       : "r2", "r3", "r4", "r5", "r6", "r8", "r10", "r12",
+                         "memory");
+        nwords -= 8;
+    }
+#endif
+
+    /* Baseline only encodes low registers, move 4 words per burst */
+    while (nwords >= 4) {
+        __ASM volatile("ldmia %0!, {r2-r5}                  \n"
+                       "stmia %1!, {r2-r5}                  \n"
+                       : "+l" (src), "+l" (dest)
+                       :
+                       : "r2", "r3", "r4", "r5", "memory");
+        nwords -= 4;
+    }
+
+    while (nwords--) {
+        *dest++ = *src++;
+    }
+}
+
 #ifdef TFM_PSA_API
 static void tfm_arch_init_state_ctx(struct tfm_state_context_t *p_stat_ctx,
                                     void *param, uintptr_t pfn)
@@ -14,6 +14,10 @@
 #error "Unsupported ARM Architecture."
 #endif
 
+#if defined(__ARM_FP) && !(defined(__FPU_USED) && (__FPU_USED == 1U))
+#error "The image is built for the FPU, but the platform does not have one."
+#endif
+
 extern uint32_t SVCHandler_main(uint32_t *svc_args, uint32_t lr);
 
 /*
@@ -43,11 +47,20 @@ extern uint32_t SVCHandler_main(uint32_t *svc_args, uint32_t lr);
  * replace stacked context with context of next thread.
  *
  * Scheduler does not support handler mode thread so take PSP as thread SP.
+ *
+ * With the FPU, a thread which has an active FP context (bit 4 of EXC_RETURN
+ * cleared) also gets S16-S31 pushed below its exception frame, and the PSP
+ * saved points to them. Threads which never touched the FPU skip this.
  */
 __attribute__((naked)) void PendSV_Handler(void)
 {
     __ASM volatile(
         "MRS     r0, psp                    \n"
+#if defined(__FPU_USED) && (__FPU_USED == 1U)
+        "TST     lr, #0x10                  \n"
+        "IT      EQ                         \n"
+        "VSTMDBEQ r0!, {s16-s31}            \n"
+#endif
         "PUSH    {r0, lr}                   \n"
         "PUSH    {r4-r7}                    \n"
         "MOV     r4, r8                     \n"
@@ -65,6 +78,11 @@ __attribute__((naked)) void PendSV_Handler(void)
         "POP     {r4-r7}                    \n"
         "POP     {r0, r1}                   \n"
         "MOV     lr, r1                     \n"
+#if defined(__FPU_USED) && (__FPU_USED == 1U)
+        "TST     lr, #0x10                  \n"
+        "IT      EQ                         \n"
+        "VLDMIAEQ r0!, {s16-s31}            \n"
+#endif
         "MSR     psp, r0                    \n"
         "BX      lr                         \n"
     );
@@ -138,6 +156,20 @@ void tfm_arch_prioritize_secure_exception(void)
 {
 }
 
+void tfm_arch_configure_fp(void)
+{
+#if defined(__FPU_USED) && (__FPU_USED == 1U)
+    /*
+     * Lazy state preservation: exception entry only reserves the room for the
+     * FP context, the registers are stacked when the handler first uses the
+     * FPU.
+     */
+    FPU->FPCCR |= FPU_FPCCR_ASPEN_Msk | FPU_FPCCR_LSPEN_Msk;
+    __DSB();
+    __ISB();
+#endif
+}
+
 /* There is no FPCA in v6m */
 #ifndef __ARM_ARCH_6M__
 __attribute__((naked, noinline)) void tfm_arch_clear_fp_status(void)
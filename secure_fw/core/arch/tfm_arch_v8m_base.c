@@ -235,6 +235,11 @@ void tfm_arch_prioritize_secure_exception(void)
                  (AIRCR & ~SCB_AIRCR_VECTKEY_Msk);
 }
 
+/* There is no FPU in baseline. */
+void tfm_arch_configure_fp(void)
+{
+}
+
 /* There is no FPCA in baseline. */
 void tfm_arch_clear_fp_status(void)
 {
@@ -20,6 +20,10 @@
 #error "Unsupported ARM Architecture."
 #endif
 
+#if defined(__ARM_FP) && !(defined(__FPU_USED) && (__FPU_USED == 1U))
+#error "The image is built for the FPU, but the platform does not have one."
+#endif
+
 struct tfm_fault_context_s {
     uint32_t R0;
     uint32_t R1;
@@ -60,18 +64,56 @@ struct tfm_fault_context_s {
  * Scheduler does not support handler mode thread so take PSP/PSP_LIMIT as
  * thread SP/SP_LIMIT. R2 holds dummy data due to stack operation is 8 bytes
  * aligned.
+ *
+ * With the FPU, a thread which has an active FP context (bit 4 of EXC_RETURN
+ * cleared) also gets S16-S31 pushed below its exception frame, and the PSP
+ * saved points to them. Threads which never touched the FPU skip this, and
+ * lazy state preservation leaves S0-S15 and FPSCR to the hardware. Before
+ * returning to the Non-secure thread, the FP registers are cleared so that
+ * no Secure FP data is left to the Non-secure code.
  */
 __attribute__((naked)) void PendSV_Handler(void)
 {
     __ASM volatile(
         "mrs     r0, psp                    \n"
         "mrs     r1, psplim                 \n"
+#if defined(__FPU_USED) && (__FPU_USED == 1U)
+        "tst     lr, #0x10                  \n"
+        "it      eq                         \n"
+        "vstmdbeq r0!, {s16-s31}            \n"
+#endif
         "push    {r0, r1, r2, lr}           \n"
         "push    {r4-r11}                   \n"
         "mov     r0, sp                     \n"
         "bl      tfm_pendsv_do_schedule     \n"
         "pop     {r4-r11}                   \n"
         "pop     {r0, r1, r2, lr}           \n"
+#if defined(__FPU_USED) && (__FPU_USED == 1U)
+        "tst     lr, #0x40                  \n"
+        "bne     1f                         \n"
+        "mov     r2, #0                     \n"
+        "vmov    s0, s1, r2, r2             \n"
+        "vmov    s2, s3, r2, r2             \n"
+        "vmov    s4, s5, r2, r2             \n"
+        "vmov    s6, s7, r2, r2             \n"
+        "vmov    s8, s9, r2, r2             \n"
+        "vmov    s10, s11, r2, r2           \n"
+        "vmov    s12, s13, r2, r2           \n"
+        "vmov    s14, s15, r2, r2           \n"
+        "vmov    s16, s17, r2, r2           \n"
+        "vmov    s18, s19, r2, r2           \n"
+        "vmov    s20, s21, r2, r2           \n"
+        "vmov    s22, s23, r2, r2           \n"
+        "vmov    s24, s25, r2, r2           \n"
+        "vmov    s26, s27, r2, r2           \n"
+        "vmov    s28, s29, r2, r2           \n"
+        "vmov    s30, s31, r2, r2           \n"
+        "vmsr    fpscr, r2                  \n"
+        "1:                                 \n"
+        "tst     lr, #0x10                  \n"
+        "it      eq                         \n"
+        "vldmiaeq r0!, {s16-s31}            \n"
+#endif
         "msr     psp, r0                    \n"
         "msr     psplim, r1                 \n"
         "bx      lr                         \n"
@@ -225,6 +267,28 @@ void tfm_arch_prioritize_secure_exception(void)
                  (AIRCR & ~SCB_AIRCR_VECTKEY_Msk);
 }
 
+void tfm_arch_configure_fp(void)
+{
+#if defined(__FPU_USED) && (__FPU_USED == 1U)
+    /* The Non-secure image is built with the same FP settings */
+    SCB->NSACR |= SCB_NSACR_CP10_Msk | SCB_NSACR_CP11_Msk;
+
+    /*
+     * Lazy state preservation: exception entry only reserves the room for the
+     * FP context, the registers are stacked when the handler first uses the
+     * FPU. TS treats the Secure FP context as secure, so that it is stacked
+     * and cleared before a Non-secure handler runs, and CLRONRET clears the
+     * caller saved registers on exception return. LSPENS and CLRONRETS keep
+     * the Non-secure code from changing these settings.
+     */
+    FPU->FPCCR |= FPU_FPCCR_ASPEN_Msk | FPU_FPCCR_LSPEN_Msk |
+                  FPU_FPCCR_LSPENS_Msk | FPU_FPCCR_TS_Msk |
+                  FPU_FPCCR_CLRONRET_Msk | FPU_FPCCR_CLRONRETS_Msk;
+    __DSB();
+    __ISB();
+#endif
+}
+
 __attribute__((naked, noinline)) void tfm_arch_clear_fp_status(void)
 {
     __ASM volatile(
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * DWT cycle counter of the secure side, shared by the code which timestamps
+ * or profiles events. Starting the counter needs privileged code, reading it
+ * does not.
+ */
+
+#ifndef __TFM_CYCLE_COUNTER_H__
+#define __TFM_CYCLE_COUNTER_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "tfm_hal_device_header.h"
+
+/* Armv6-M and Armv8-M Baseline have no cycle counter */
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || \
+    defined(__ARM_ARCH_8M_MAIN__) || defined(__ARM_ARCH_8_1M_MAIN__)
+#define TFM_HAS_CYCLE_COUNTER
+#endif
+
+/**
+ * \brief   Start the cycle counter, which keeps running if it already is
+ *
+ * \param[in]  reset        Restart the count from 0
+ *
+ * \retval true             The counter runs
+ * \retval false            The core has no cycle counter
+ */
+static inline bool tfm_cycle_counter_start(bool reset)
+{
+#ifdef TFM_HAS_CYCLE_COUNTER
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    if (DWT->CTRL & DWT_CTRL_NOCYCCNT_Msk) {
+        return false;
+    }
+    if (reset) {
+        DWT->CYCCNT = 0;
+    }
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    return true;
+#else
+    (void)reset;
+
+    return false;
+#endif
+}
+
+/**
+ * \brief   Read the cycle counter, which wraps around
+ *
+ * \retval                  Current cycle count, 0 if there is no counter
+ */
+static inline uint32_t tfm_cycle_counter_read(void)
+{
+#ifdef TFM_HAS_CYCLE_COUNTER
+    return DWT->CYCCNT;
+#else
+    return 0;
+#endif
+}
+
+#endif /* __TFM_CYCLE_COUNTER_H__ */
@@ -97,6 +97,25 @@ void tfm_core_get_boot_data_handler(uint32_t args[]);
  */
 void tfm_core_validate_boot_data(void);
 
+#ifdef TFM_BOOT_TIME
+/**
+ * \brief Records the end of a boot stage of the secure image with the DWT
+ *        cycle counter started by the bootloader.
+ *
+ * \param[in] stage  Boot stage, as specified in \ref tfm_boot_time_stage_t
+ */
+void tfm_core_boot_time_record(uint32_t stage);
+
+/**
+ * \brief Records the last boot stage of the secure image, then appends the
+ *        recorded stages to the shared data area, after the stages recorded
+ *        by the bootloader.
+ *
+ * \param[in] stage  Boot stage, as specified in \ref tfm_boot_time_stage_t
+ */
+void tfm_core_boot_time_save(uint32_t stage);
+#endif /* TFM_BOOT_TIME */
+
 /**
  * \brief Handle deprivileged request
  */
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Usage of the resource pools of the secure image. SPM reads the pools of the
+ * core through a function, and the pools of the partitions from a record the
+ * partition registers and keeps up to date in its own memory. The platform
+ * partition reads the usage of all the pools registered.
+ */
+
+#ifndef __TFM_RESOURCE_USAGE_H__
+#define __TFM_RESOURCE_USAGE_H__
+
+#ifdef TFM_RESOURCE_USAGE
+
+#include <stdint.h>
+#include "tfm_resource_usage_defs.h"
+
+/* Number of resource pools which can be registered */
+#ifndef TFM_RESOURCE_USAGE_ENTRIES
+#define TFM_RESOURCE_USAGE_ENTRIES      16
+#endif
+
+/**
+ * \brief Function of the core which fills the used, peak and capacity fields
+ *        of the usage of one of its pools.
+ */
+typedef void (*tfm_resource_usage_get_t)(struct tfm_resource_usage_t *usage);
+
+/**
+ * \brief Register a resource pool of the core.
+ *
+ * \param[in] resource_id       TFM_RESOURCE_* ID of the pool
+ * \param[in] get               Function reading the usage of the pool
+ *
+ * \retval TFM_SUCCESS          The pool is registered.
+ * \retval TFM_ERROR_GENERIC    The pool is already registered, or there is
+ *                              no room for another one.
+ */
+int32_t tfm_resource_usage_add_core(uint32_t resource_id,
+                                    tfm_resource_usage_get_t get);
+
+/**
+ * \brief SVC handler to register a resource pool of the caller partition.
+ *
+ * \param[in] args              Include all input arguments: usage.
+ *
+ * \retval TFM_SUCCESS          The pool is registered.
+ * \retval TFM_ERROR_GENERIC    The pool is already registered, or there is
+ *                              no room for another one.
+ * \retval "Does not return"    The record is not a valid memory reference
+ *                              of the caller.
+ */
+uint32_t tfm_resource_usage_register_handler(uint32_t *args);
+
+/**
+ * \brief SVC handler to copy the usage of the registered pools, in the order
+ *        of their registration.
+ *
+ * \param[in] args              Include all input arguments:
+ *                              first, entries, num.
+ *
+ * \retval >=0                  Number of entries copied.
+ * \retval "Does not return"    The caller is not the platform partition, or
+ *                              the caller buffer is not a valid memory
+ *                              reference.
+ */
+uint32_t tfm_resource_usage_get_handler(uint32_t *args);
+
+#endif /* TFM_RESOURCE_USAGE */
+
+#endif /* __TFM_RESOURCE_USAGE_H__ */
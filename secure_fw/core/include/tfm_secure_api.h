@@ -77,6 +77,21 @@ int32_t tfm_core_sfn_request(const struct tfm_sfn_req_s *desc_ptr);
 
 int32_t tfm_core_sfn_request_thread_mode(struct tfm_sfn_req_s *desc_ptr);
 
+#ifdef TFM_SFN_FAST_PATH
+/**
+ * \brief Call a secure function from the non-secure world on the SPM stack.
+ *
+ * The iovecs and the partition states are checked as for a secure function
+ * call through \ref tfm_core_sfn_request, but the secure function is called
+ * directly in thread mode, without switching to the partition stack.
+ *
+ * \param[in] desc_ptr  The secure function request descriptor
+ *
+ * \return The return value of the secure function.
+ */
+int32_t tfm_core_sfn_request_fast(struct tfm_sfn_req_s *desc_ptr);
+#endif
+
 /**
  * \brief Check whether a memory range is inside a memory region.
  *
@@ -108,13 +123,23 @@ void tfm_disable_irq(psa_signal_t irq_signal);
             /* This point never reached */                           \
             return (int32_t)TFM_ERROR_GENERIC;                       \
         } while (0)
+
+#define TFM_CORE_IOVEC_SFN_FAST_REQUEST(id, fn, a, b, c, d)          \
+        TFM_CORE_IOVEC_SFN_REQUEST(id, fn, a, b, c, d)
 #else
 #define TFM_CORE_IOVEC_SFN_REQUEST(id, fn, a, b, c, d)               \
-        return tfm_core_partition_request(id, fn,                    \
+        return tfm_core_partition_request(id, fn, false,             \
+                (int32_t)a, (int32_t)b, (int32_t)c, (int32_t)d)
+
+/* A fast path request is served on the SPM stack if called from the
+ * non-secure world, see \ref tfm_core_sfn_request_fast.
+ */
+#define TFM_CORE_IOVEC_SFN_FAST_REQUEST(id, fn, a, b, c, d)          \
+        return tfm_core_partition_request(id, fn, true,              \
                 (int32_t)a, (int32_t)b, (int32_t)c, (int32_t)d)
 
 __attribute__ ((always_inline)) __STATIC_INLINE
-int32_t tfm_core_partition_request(uint32_t id, void *fn,
+int32_t tfm_core_partition_request(uint32_t id, void *fn, bool fast_path,
             int32_t arg1, int32_t arg2, int32_t arg3, int32_t arg4)
 {
     int32_t args[4] = {arg1, arg2, arg3, arg4};
@@ -156,6 +181,13 @@ int32_t tfm_core_partition_request(uint32_t id, void *fn,
         tfm_core_panic();
     } else {
         if (desc.ns_caller) {
+#ifdef TFM_SFN_FAST_PATH
+            if (fast_path) {
+                return tfm_core_sfn_request_fast(desc_ptr);
+            }
+#else
+            (void)fast_path;
+#endif
             return tfm_core_sfn_request(desc_ptr);
         } else {
             return tfm_core_sfn_request_thread_mode(desc_ptr);
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Statistical PC sampling of the secure image. The secure SysTick interrupts
+ * the running code at a fixed rate, and the stacked PC is recorded with the
+ * partition running at that time. The samples are kept in a ring buffer until
+ * the platform partition reads them.
+ */
+
+#ifndef __TFM_SPM_PROFILE_H__
+#define __TFM_SPM_PROFILE_H__
+
+#ifdef TFM_SPM_PROFILE
+
+#include <stdint.h>
+#include "tfm_spm_profile_defs.h"
+
+/* Sampling rate, in Hz */
+#ifndef TFM_SPM_PROFILE_HZ
+#define TFM_SPM_PROFILE_HZ              1000
+#endif
+
+/* Number of samples kept until they are read, the oldest are overwritten */
+#ifndef TFM_SPM_PROFILE_SAMPLES
+#define TFM_SPM_PROFILE_SAMPLES         512
+#endif
+
+/**
+ * \brief Clear the samples and start the sampling timer.
+ */
+void tfm_spm_profile_init(void);
+
+/**
+ * \brief Record a sample, called by the SysTick handler.
+ *
+ * \param[in] exc_return        EXC_RETURN of the SysTick exception
+ * \param[in] frame             Stack frame of the interrupted code
+ */
+void tfm_spm_profile_sample(uint32_t exc_return, const uint32_t *frame);
+
+/**
+ * \brief SVC handler to move the samples to the caller, oldest first.
+ *
+ * \param[in] args              Include all input arguments: samples, num.
+ *
+ * \retval >=0                  Number of samples moved.
+ * \retval "Does not return"    The caller is not the platform partition, or
+ *                              the caller buffer is not a valid memory
+ *                              reference.
+ */
+uint32_t tfm_spm_profile_get_handler(uint32_t *args);
+
+#endif /* TFM_SPM_PROFILE */
+
+#endif /* __TFM_SPM_PROFILE_H__ */
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Load statistics of the SPM. The DWT cycle counter is sampled each time
+ * another partition is switched in, and the elapsed cycles are charged to the
+ * partition which was running. The time the SPM spends idle is charged to a
+ * separate entry.
+ */
+
+#ifndef __TFM_SPM_STATS_H__
+#define __TFM_SPM_STATS_H__
+
+#ifdef TFM_SPM_STATS
+
+#include <stdint.h>
+#include "tfm_spm_stats_defs.h"
+
+/**
+ * \brief Start the cycle counter and clear the statistics.
+ */
+void tfm_spm_stats_init(void);
+
+/**
+ * \brief Read the cycle counter used for the statistics.
+ *
+ * \return Current cycle count, 0 on Armv8-M Baseline which has no counter
+ */
+uint32_t tfm_spm_stats_get_cycles(void);
+
+/**
+ * \brief Charge the cycles elapsed since the last switch to the partition
+ *        which was running, and account a run of the partition switched in.
+ *
+ * \param[in] partition_idx     Index of the partition switched in. Nothing is
+ *                              done if it is already running.
+ */
+void tfm_spm_stats_switch(uint32_t partition_idx);
+
+/**
+ * \brief Charge the cycles elapsed since the last switch to the running
+ *        partition, and start accounting idle time.
+ */
+void tfm_spm_stats_idle_enter(void);
+
+/**
+ * \brief Charge the cycles elapsed since \ref tfm_spm_stats_idle_enter to the
+ *        idle entry, then resume accounting the running partition.
+ */
+void tfm_spm_stats_idle_exit(void);
+
+/**
+ * \brief SVC handler to copy the statistics to the caller.
+ *
+ * \param[in] args              Include all input arguments: type, first,
+ *                              entries, num.
+ *
+ * \retval >=0                  Number of entries copied.
+ * \retval "Does not return"    The caller is not the platform partition, or
+ *                              the caller buffer is not a valid memory
+ *                              reference.
+ */
+uint32_t tfm_spm_stats_get_handler(uint32_t *args);
+
+#endif /* TFM_SPM_STATS */
+
+#endif /* __TFM_SPM_STATS_H__ */
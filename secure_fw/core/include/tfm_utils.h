@@ -28,6 +28,29 @@ void tfm_core_panic(void);
 #define TFM_CORE_ASSERT(cond)
 #endif
 
+/*
+ * Marks a function of the IPC call path. With TFM_HOT_CODE_IN_RAM, the linker
+ * script copies these functions to RAM, which has no flash wait states.
+ */
+#ifdef TFM_HOT_CODE_IN_RAM
+#define TFM_HOT_CODE __attribute__((section(".tfm_hot_code")))
+#else
+#define TFM_HOT_CODE
+#endif
+
+/*
+ * Marks a runtime data structure of SPM which is accessed on each IPC call.
+ * With TFM_HOT_DATA_IN_FAST_RAM, the linker script places these structures in
+ * the fast RAM of the platform, defined by S_FAST_DATA_START and
+ * S_FAST_DATA_SIZE. A const object must not be marked, as it would conflict
+ * with the writable data of the section.
+ */
+#ifdef TFM_HOT_DATA_IN_FAST_RAM
+#define TFM_HOT_DATA __attribute__((section(".tfm_hot_data")))
+#else
+#define TFM_HOT_DATA
+#endif
+
 /* Get container structure start address from member */
 #define TFM_GET_CONTAINER_PTR(ptr, type, member) \
     (type *)((unsigned long)(ptr) - offsetof(type, member))
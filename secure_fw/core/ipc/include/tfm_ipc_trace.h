@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Cycle count tracing of the IPC path. Each trace point records the DWT
+ * cycle counter into a ring buffer placed in its own secure RAM section, so
+ * the time spent between two points of one psa_call() can be measured.
+ */
+
+#ifndef __TFM_IPC_TRACE_H__
+#define __TFM_IPC_TRACE_H__
+
+#ifdef TFM_IPC_TRACE
+
+#include <stdint.h>
+#include "tfm_ipc_trace_defs.h"
+
+/**
+ * \brief Start the cycle counter and empty the trace buffer.
+ */
+void tfm_ipc_trace_init(void);
+
+/**
+ * \brief Record a trace point.
+ *
+ * \param[in] event             Trace point, \ref tfm_ipc_trace_event_t
+ * \param[in] arg               Event specific argument.
+ *
+ * \note This function can be called from any exception priority. The oldest
+ *       entry is overwritten once the ring buffer is full.
+ */
+void tfm_ipc_trace_record(uint32_t event, uint32_t arg);
+
+/**
+ * \brief SVC handler to copy the trace buffer to the caller.
+ *
+ * \param[in] args              Include all input arguments: entries, num.
+ *
+ * \retval >=0                  Number of entries copied, oldest first. The
+ *                              most recent entries are copied if the caller
+ *                              buffer cannot hold all of them.
+ * \retval "Does not return"    The caller buffer is not a valid memory
+ *                              reference.
+ */
+uint32_t tfm_ipc_trace_get_handler(uint32_t *args);
+
+#define TFM_IPC_TRACE_POINT(event, arg) \
+    tfm_ipc_trace_record((event), (uint32_t)(arg))
+
+#else /* TFM_IPC_TRACE */
+
+#define TFM_IPC_TRACE_POINT(event, arg)
+
+#endif /* TFM_IPC_TRACE */
+
+#endif /* __TFM_IPC_TRACE_H__ */
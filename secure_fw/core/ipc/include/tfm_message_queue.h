@@ -11,6 +11,42 @@
 #include "tfm_wait.h"
 
 #define TFM_MSG_MAGIC               0x15154343
+
+/* Status flags of a client vector, kept in tfm_msg_body_t::iovec_status */
+#define TFM_IOVEC_ACCESSED          (1U << 0) /* psa_read/skip/write used */
+#define TFM_IOVEC_MAPPED            (1U << 1) /* psa_map_invec/outvec used */
+#define TFM_IOVEC_UNMAPPED          (1U << 2) /* psa_unmap_invec/outvec used */
+#define TFM_IOVEC_STATUS_BITS       4
+
+/* Position the status flags of the input or output vector at the index */
+#define TFM_INVEC_STATUS(flags, idx)                                \
+    ((uint32_t)(flags) << ((idx) * TFM_IOVEC_STATUS_BITS))
+#define TFM_OUTVEC_STATUS(flags, idx)                               \
+    ((uint32_t)(flags) << (((idx) + PSA_MAX_IOVEC) * TFM_IOVEC_STATUS_BITS))
+
+#ifdef TFM_MAILBOX_SG
+/*
+ * Segments of the client vectors of a scatter-gather request. The current
+ * input segment is tracked by tfm_msg_body_t::invec and its length, the
+ * current output segment by out_cur.
+ */
+struct tfm_msg_sg_t {
+    const psa_invec *in_segs[PSA_MAX_IOVEC];  /* Next input segments     */
+    size_t in_nr_segs[PSA_MAX_IOVEC];         /* Input segments left     */
+    psa_outvec out_cur[PSA_MAX_IOVEC];        /* Unwritten part of the
+                                               * current output segment
+                                               */
+    psa_outvec *out_segs[PSA_MAX_IOVEC];      /* Next output segments    */
+    size_t out_nr_segs[PSA_MAX_IOVEC];        /* Output segments left    */
+    size_t out_len;                           /* Number of out vectors   */
+    size_t *out_written;                      /*
+                                               * Caller buffer for the
+                                               * written lengths, NULL if
+                                               * not a scatter-gather call
+                                               */
+};
+#endif
+
 /* Message struct to collect parameter from client */
 struct tfm_msg_body_t {
     int32_t magic;
@@ -24,12 +60,35 @@ struct tfm_msg_body_t {
                                      * Save caller outvec pointer for
                                      * write length update
                                      */
+    uint32_t iovec_status;          /*
+                                     * Access and mapping status of the
+                                     * in/out vectors, TFM_INVEC_STATUS and
+                                     * TFM_OUTVEC_STATUS
+                                     */
+#ifdef TFM_MSG_QUEUE_PRIORITY
+    uint32_t prior;                 /* Priority inherited from client   */
+#endif
+#ifdef TFM_SPM_STATS
+    uint32_t get_cycles;            /* Cycle count at psa_get()         */
+#endif
 #ifdef TFM_MULTI_CORE_TOPOLOGY
     const void *caller_data;        /*
                                      * Pointer to the private data of the caller
                                      * It identifies the NSPE PSA client calls
                                      * in multi-core topology
                                      */
+#endif
+#ifdef TFM_MAILBOX_SG
+    struct tfm_msg_sg_t sg;         /* Scatter-gather client vectors    */
+#endif
+#ifdef TFM_SFN_PARTITIONS
+    uint32_t sfn_ret_lr;            /* Client LR, PC and xPSR at the    */
+    uint32_t sfn_ret_pc;            /* psa_call() of a secure function  */
+    uint32_t sfn_ret_xpsr;
+    struct tfm_msg_body_t *sfn_prev;/*
+                                     * Previous secure function request
+                                     * on the same thread
+                                     */
 #endif
     struct tfm_msg_body_t *next;    /* List operators                   */
 };
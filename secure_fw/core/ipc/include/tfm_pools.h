@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -8,6 +8,9 @@
 #define __TFM_POOLS_H__
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "tfm_utils.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -21,17 +24,32 @@ extern "C" {
 /*
  * Pool Instance:
  *  [ Pool Instance ] + N * [ Pool Chunks ]
+ *
+ * Free chunks are kept in a stack of chunk indexes, so allocation and free
+ * are O(1). The stack head is updated with exclusive accesses, which makes
+ * both operations safe to call from any exception priority without masking
+ * interrupts.
  */
+#define TFM_POOL_NIL_IDX        0xFFFFFFFFU /* End of the free stack      */
+
 struct tfm_pool_chunk_t {
-    struct tfm_list_node_t list;        /* Chunk list                     */
+    uint32_t next_free;                 /* Next free chunk index          */
     void *pool;                         /* Point to the parent pool       */
     uint8_t data[0];                    /* Data indicator                 */
 };
 
+/* Usage statistics of a pool */
+struct tfm_pool_stats_t {
+    uint32_t in_use;                    /* Chunks currently allocated     */
+    uint32_t max_in_use;                /* High-water mark of in_use      */
+    uint32_t alloc_failures;            /* Allocations failed, pool empty */
+};
+
 struct tfm_pool_instance_t {
     size_t chunksz;                     /* Chunks size of pool member     */
     size_t chunk_count;                 /* A number of chunks in the pool */
-    struct tfm_list_node_t chunks_list; /* Chunk list head in pool        */
+    uint32_t free_head;                 /* Index of the first free chunk  */
+    struct tfm_pool_stats_t stats;      /* Usage statistics               */
     struct tfm_pool_chunk_t chunks[0];  /* Data indicator                 */
 };
 
@@ -43,6 +61,7 @@ struct tfm_pool_instance_t {
  *  num         -   Number of chunks
  */
 #define TFM_POOL_DECLARE(name, chunksz, num)                                \
+    TFM_HOT_DATA                                                            \
     static uint8_t name##_pool_buf[((chunksz) +                             \
                                    sizeof(struct tfm_pool_chunk_t)) * (num) \
                                    + sizeof(struct tfm_pool_instance_t)]    \
@@ -89,6 +108,19 @@ void *tfm_pool_alloc(struct tfm_pool_instance_t *pool);
  */
 void tfm_pool_free(void *ptr);
 
+/**
+ * \brief Get the usage statistics of a pool.
+ *
+ * \param[in] pool              Pointer to memory pool declared by
+ *                              \ref TFM_POOL_DECLARE.
+ * \param[out] stats            Statistics of the pool.
+ *
+ * \note The high-water mark gives the number of chunks a configuration
+ *       really needs, for example to size TFM_CONN_HANDLE_MAX_NUM.
+ */
+void tfm_pool_get_stats(struct tfm_pool_instance_t *pool,
+                        struct tfm_pool_stats_t *stats);
+
 /**
  * \brief Checks whether a pointer points to a chunk data in the pool.
  *
@@ -48,8 +48,8 @@ uint32_t tfm_psa_version(uint32_t sid, bool ns_caller);
  * \retval PSA_ERROR_CONNECTION_BUSY The SPM or RoT Service cannot make the
  *                              connection at the moment.
  * \retval "Does not return"    The RoT Service ID and version are not
- *                              supported, or the caller is not permitted to
- *                              access the service.
+ *                              supported, the RoT Service is stateless, or the
+ *                              caller is not permitted to access the service.
  */
 psa_status_t tfm_psa_connect(uint32_t sid, uint32_t version, bool ns_caller);
 
@@ -57,7 +57,8 @@ psa_status_t tfm_psa_connect(uint32_t sid, uint32_t version, bool ns_caller);
  * \brief handler for \ref psa_call.
  *
  * \param[in] handle            Service handle to the established connection,
- *                              \ref psa_handle_t
+ *                              or the static handle of a stateless RoT
+ *                              Service, \ref psa_handle_t
  * \param[in] type              The request type.
  *                              Must be zero( \ref PSA_IPC_CALL) or positive.
  * \param[in] inptr             Array of input psa_invec structures.
@@ -73,8 +74,16 @@ psa_status_t tfm_psa_connect(uint32_t sid, uint32_t version, bool ns_caller);
  * \param[in] privileged        Privileged mode or unprivileged mode:
  *                              \ref TFM_PARTITION_UNPRIVILEGED_MODE
  *                              \ref TFM_PARTITION_PRIVILEGED_MODE
+ * \param[in] ctx               Stacked context of the psa_call() SVC, on
+ *                              which the secure function of a service of an
+ *                              SFN partition is run. NULL if the call was not
+ *                              made through an SVC.
  *
  * \retval PSA_SUCCESS          Success.
+ * \retval PSA_ERROR_CONNECTION_BUSY The SPM cannot carry a call to a
+ *                              stateless RoT Service at the moment.
+ * \retval other                The call is made to a secure function, see
+ *                              \ref tfm_sfn_call.
  * \retval "Does not return"    The call is invalid, one or more of the
  *                              following are true:
  * \arg                           An invalid handle was passed.
@@ -87,7 +96,190 @@ psa_status_t tfm_psa_connect(uint32_t sid, uint32_t version, bool ns_caller);
 psa_status_t tfm_psa_call(psa_handle_t handle, int32_t type,
                           const psa_invec *inptr, size_t in_num,
                           psa_outvec *outptr, size_t out_num,
-                          bool ns_caller, uint32_t privileged);
+                          bool ns_caller, uint32_t privileged,
+                          uint32_t *ctx);
+
+#ifdef TFM_MAILBOX_SG
+/**
+ * \brief handler for a \ref psa_call whose client vectors are described by
+ *        scatter-gather segment lists.
+ *
+ * \param[in] handle            Service handle to the established connection,
+ *                              or the static handle of a stateless RoT
+ *                              Service, \ref psa_handle_t
+ * \param[in] type              The request type.
+ *                              Must be zero( \ref PSA_IPC_CALL) or positive.
+ * \param[in] in_segs           Segments of all the input vectors, one input
+ *                              vector after the other. It must be a copy in
+ *                              secure memory which is kept until the reply.
+ * \param[in] in_nr_segs        Number of segments of each input vector.
+ * \param[in] in_num            Number of input vectors.
+ * \param[in] out_segs          Segments of all the output vectors, one output
+ *                              vector after the other. It must be a copy in
+ *                              secure memory which is kept until the reply.
+ * \param[in] out_nr_segs       Number of segments of each output vector.
+ * \param[in] out_num           Number of output vectors.
+ * \param[out] out_written      Client buffer which receives the number of
+ *                              bytes written to each output vector.
+ * \param[in] ns_caller         If 'true', call from non-secure client.
+ *                              Otherwise from secure client.
+ * \param[in] privileged        Privileged mode or unprivileged mode:
+ *                              \ref TFM_PARTITION_UNPRIVILEGED_MODE
+ *                              \ref TFM_PARTITION_PRIVILEGED_MODE
+ *
+ * \retval PSA_SUCCESS          Success.
+ * \retval PSA_ERROR_CONNECTION_BUSY The SPM cannot carry a call to a
+ *                              stateless RoT Service at the moment.
+ * \retval "Does not return"    The call is invalid, as in \ref tfm_psa_call,
+ *                              or a segment is invalid, input segments
+ *                              overlap, or the size of a vector overflows.
+ */
+psa_status_t tfm_psa_call_sg(psa_handle_t handle, int32_t type,
+                             const psa_invec *in_segs,
+                             const size_t *in_nr_segs, size_t in_num,
+                             psa_outvec *out_segs,
+                             const size_t *out_nr_segs, size_t out_num,
+                             size_t *out_written,
+                             bool ns_caller, uint32_t privileged);
+#endif
+
+/**
+ * \brief handler for \ref psa_call_batch.
+ *
+ * \param[in] handle            Service handle to the established connection,
+ *                              or the static handle of a stateless RoT
+ *                              Service, \ref psa_handle_t
+ * \param[in] calls             Array of requests, \ref psa_batch_call_t
+ * \param[in] num_calls         Number of requests in the array.
+ * \param[in] ns_caller         If 'true', call from non-secure client.
+ *                              Otherwise from secure client.
+ * \param[in] privileged        Privileged mode or unprivileged mode:
+ *                              \ref TFM_PARTITION_UNPRIVILEGED_MODE
+ *                              \ref TFM_PARTITION_PRIVILEGED_MODE
+ *
+ * \retval PSA_SUCCESS          Success.
+ * \retval PSA_ERROR_CONNECTION_BUSY The SPM cannot carry a call to a
+ *                              stateless RoT Service at the moment, or
+ *                              already holds \ref TFM_BATCH_MAX_NUM batches.
+ * \retval "Does not return"    The batch is invalid or holds more than
+ *                              \ref TFM_BATCH_MAX_CALLS requests, an invalid
+ *                              memory reference was provided for the requests
+ *                              or one of the requests is invalid for
+ *                              \ref tfm_psa_call.
+ */
+psa_status_t tfm_psa_call_batch(psa_handle_t handle, psa_batch_call_t *calls,
+                                size_t num_calls, bool ns_caller,
+                                uint32_t privileged);
+
+/**
+ * \brief Deliver the next request of a batch once the RoT Service has replied
+ *        to the current one.
+ *
+ * \param[in] handle            Service handle of the connection.
+ * \param[in,out] p_status      Status replied by the RoT Service. It is
+ *                              replaced by the status of the whole batch
+ *                              when the last request has been replied.
+ *
+ * \retval true                 The next request has been delivered, the
+ *                              client must stay blocked.
+ * \retval false                There is no batch on the connection or the
+ *                              batch is complete, the client can be woken
+ *                              up with *p_status.
+ */
+bool tfm_psa_call_batch_continue(psa_handle_t handle, psa_status_t *p_status);
+
+#ifdef TFM_PSA_ASYNC_CALL
+/**
+ * \brief handler for \ref psa_call_async.
+ *
+ * \param[in] handle            Service handle to the established connection,
+ *                              \ref psa_handle_t
+ * \param[in] type              The request type.
+ *                              Must be zero( \ref PSA_IPC_CALL) or positive.
+ * \param[in] inptr             Array of input psa_invec structures.
+ *                              \ref psa_invec
+ * \param[in] in_num            Number of input psa_invec structures.
+ *                              \ref psa_invec
+ * \param[in] outptr            Array of output psa_outvec structures.
+ *                              \ref psa_outvec
+ * \param[in] out_num           Number of outut psa_outvec structures.
+ *                              \ref psa_outvec
+ * \param[in] privileged        Privileged mode or unprivileged mode:
+ *                              \ref TFM_PARTITION_UNPRIVILEGED_MODE
+ *                              \ref TFM_PARTITION_PRIVILEGED_MODE
+ * \param[out] p_token          Handle of the connection carrying the call,
+ *                              to collect its status with.
+ *
+ * \retval PSA_SUCCESS          The request has been queued to the RoT Service.
+ * \retval PSA_ERROR_CONNECTION_BUSY The SPM cannot carry a call to a
+ *                              stateless RoT Service at the moment.
+ * \retval PSA_ERROR_PROGRAMMER_ERROR The connection has been terminated by the
+ *                              RoT Service.
+ * \retval "Does not return"    The call is invalid for \ref tfm_psa_call.
+ *
+ * \note Only non-secure clients can call an RoT Service asynchronously.
+ */
+psa_status_t tfm_psa_call_async(psa_handle_t handle, int32_t type,
+                                const psa_invec *inptr, size_t in_num,
+                                psa_outvec *outptr, size_t out_num,
+                                uint32_t privileged, psa_handle_t *p_token);
+
+/**
+ * \brief handler for \ref psa_call_async_result.
+ *
+ * \param[in] handle            Handle of the connection carrying the call.
+ * \param[out] p_status         Status replied by the RoT Service.
+ *
+ * \retval PSA_SUCCESS          The call is complete, *p_status is set. The
+ *                              connection carrying a call to a stateless RoT
+ *                              Service is freed.
+ * \retval PSA_ERROR_CONNECTION_BUSY The call has not been replied yet.
+ * \retval PSA_ERROR_DOES_NOT_EXIST No call is outstanding on the connection.
+ * \retval "Does not return"    An invalid handle was provided.
+ */
+psa_status_t tfm_psa_call_async_result(psa_handle_t handle,
+                                       psa_status_t *p_status);
+
+/**
+ * \brief Set the non-secure interrupt pended when an asynchronous call
+ *        completes.
+ *
+ * \param[in] irq_line          The interrupt line, negative to disable the
+ *                              notification.
+ *
+ * \retval PSA_SUCCESS          Success.
+ * \retval PSA_ERROR_NOT_PERMITTED The interrupt does not target the NSPE.
+ */
+psa_status_t tfm_psa_call_async_set_irq(int32_t irq_line);
+
+/**
+ * \brief Check if an asynchronous call is outstanding on a connection.
+ *
+ * \param[in] handle            Service handle of the connection.
+ *
+ * \retval true                 The call has not been replied yet.
+ * \retval false                Otherwise.
+ */
+bool tfm_psa_call_async_pending(psa_handle_t handle);
+
+/**
+ * \brief Complete the asynchronous call of a connection once the RoT Service
+ *        has replied, and notify the NSPE.
+ *
+ * \param[in] handle            Service handle of the connection.
+ * \param[in] status            Status replied by the RoT Service.
+ *
+ * \retval true                 The call was asynchronous, there is no
+ *                              client to wake up.
+ * \retval false                There is no asynchronous call on the
+ *                              connection.
+ */
+bool tfm_psa_call_async_complete(psa_handle_t handle, psa_status_t status);
+#else /* TFM_PSA_ASYNC_CALL */
+#define tfm_psa_call_async_pending(handle)              (false)
+
+#define tfm_psa_call_async_complete(handle, status)     (false)
+#endif /* TFM_PSA_ASYNC_CALL */
 
 /**
  * \brief handler for \ref psa_close.
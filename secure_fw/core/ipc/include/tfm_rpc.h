@@ -41,6 +41,11 @@ struct client_call_params_t {
     psa_outvec      *out_vec;
     size_t          out_len;
     uint32_t        version;
+#ifdef TFM_MAILBOX_SG
+    const size_t    *in_nr_segs;    /* Segments of each input vector */
+    const size_t    *out_nr_segs;   /* Segments of each output vector */
+    size_t          *out_written;   /* Written lengths of output vectors */
+#endif
 };
 
 /*
@@ -53,11 +58,17 @@ struct client_call_params_t {
  *                owner identifies the owner of the PSA client call.
  * get_caller_data() - Get the private data of NSPE client from mailbox to
  *                     identify the PSA client call.
+ * get_client_id() - Get the client ID of the NSPE client of the PSA client
+ *                   call under processing, in the namespace of its NS core.
+ *                   Return false if no PSA client call is under processing.
  */
 struct tfm_rpc_ops_t {
     void (*handle_req)(void);
     void (*reply)(const void *owner, int32_t ret);
     const void * (*get_caller_data)(int32_t client_id);
+#ifdef TFM_MULTI_NS_MAILBOX
+    bool (*get_client_id)(int32_t *client_id);
+#endif
 };
 
 /**
@@ -116,6 +127,23 @@ psa_status_t tfm_rpc_psa_connect(const struct client_call_params_t *params,
 psa_status_t tfm_rpc_psa_call(const struct client_call_params_t *params,
                               bool ns_caller);
 
+#ifdef TFM_MAILBOX_SG
+/**
+ * \brief RPC handler for a \ref psa_call with scatter-gather client vectors.
+ *
+ * \param[in] params            Base address of parameters. in_vec and out_vec
+ *                              point to the segments of the vectors, which
+ *                              must be kept in secure memory until the reply.
+ * \param[in] ns_caller         If 'true', indicate the non-secure caller
+ *
+ * \retval PSA_SUCCESS          Success.
+ * \retval "Does not return"    The call is invalid, as in
+ *                              \ref tfm_rpc_psa_call, or a segment is invalid.
+ */
+psa_status_t tfm_rpc_psa_call_sg(const struct client_call_params_t *params,
+                                 bool ns_caller);
+#endif
+
 /**
  * \brief RPC handler for \ref psa_close.
  *
@@ -205,6 +233,19 @@ __STATIC_INLINE bool is_tfm_rpc_msg(const struct tfm_msg_body_t *msg)
  */
 void tfm_rpc_set_caller_data(struct tfm_msg_body_t *msg, int32_t client_id);
 
+#ifdef TFM_MULTI_NS_MAILBOX
+/*
+ * \brief Get the client ID of the NS caller of the PSA client call under
+ *        processing.
+ *
+ * \param[out] client_id    The client ID of the NS caller.
+ *
+ * \retval true             The client ID is returned.
+ * \retval false            No PSA client call from NSPE is under processing.
+ */
+bool tfm_rpc_get_client_id(int32_t *client_id);
+#endif
+
 #else /* TFM_MULTI_CORE_TOPOLOGY */
 
 /* RPC is only available in multi-core scenario */
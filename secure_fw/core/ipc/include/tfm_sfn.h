@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Secure function (SFN) partitions. The RoT Services of an SFN partition are
+ * functions which the SPM calls on the thread of the client once the request
+ * has been validated, instead of queueing a message for a partition thread.
+ * The value returned by the function is the reply to the request.
+ */
+
+#ifndef __TFM_SFN_H__
+#define __TFM_SFN_H__
+
+#ifdef TFM_SFN_PARTITIONS
+
+#include <stdint.h>
+#include "psa/client.h"
+#include "tfm_message_queue.h"
+
+/**
+ * \brief Run the secure function of a request on the thread of the client.
+ *        The stacked context of the psa_call() SVC is changed so that the
+ *        exception returns to the secure function instead of the client.
+ *
+ * \param[in] msg               Request, filled by \ref tfm_spm_fill_msg
+ * \param[in] ctx               Stacked context of the psa_call() SVC, or NULL
+ *                              if the request was not made through an SVC.
+ *
+ * \retval PSA_ERROR_CONNECTION_BUSY The SFN partition is handling another
+ *                              request, on this thread or another one.
+ * \retval other                Value of r0 on return from the SVC, the
+ *                              secure function is given the PSA message.
+ * \retval "Does not return"    The request was not made through an SVC.
+ */
+psa_status_t tfm_sfn_call(struct tfm_msg_body_t *msg, uint32_t *ctx);
+
+/**
+ * \brief SVC handler for the return from a secure function. Replies to the
+ *        request with the status returned by the secure function and
+ *        returns to the client of the request.
+ *
+ * \param[in] ctx               Stacked context of the SVC
+ *
+ * \retval >=0                  RoT Service-specific status value.
+ * \retval <0                   RoT Service-specific error code.
+ * \retval "Does not return"    No secure function runs on the thread, or
+ *                              the secure function of a secure client
+ *                              returned PSA_ERROR_PROGRAMMER_ERROR.
+ */
+psa_status_t tfm_sfn_return(uint32_t *ctx);
+
+#endif /* TFM_SFN_PARTITIONS */
+
+#endif /* __TFM_SFN_H__ */
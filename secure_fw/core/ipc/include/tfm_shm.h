@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Shared memory channels between Secure Partitions. The producer of a channel
+ * declares it in its manifest with the consumer, and the buffer is placed in
+ * the data of the producer, which both partitions can access at the same
+ * isolation level. SPM only checks once that a partition may use the buffer,
+ * the data itself is not copied or checked by SPM.
+ */
+
+#ifndef __TFM_SHM_H__
+#define __TFM_SHM_H__
+
+#ifdef TFM_SHM_CHANNELS
+
+#include <stdint.h>
+
+/**
+ * \brief SVC handler of \ref tfm_shm_get.
+ *
+ * \param[in] args              Stacked arguments, the channel ID in args[0]
+ *
+ * \return Returns the address of the buffer, or 0 if the channel does not
+ *         exist or the running partition is neither its producer nor its
+ *         consumer.
+ */
+uint32_t tfm_shm_get_handler(uint32_t *args);
+
+#endif /* TFM_SHM_CHANNELS */
+
+#endif /* __TFM_SHM_H__ */
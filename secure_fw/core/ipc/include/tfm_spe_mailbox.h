@@ -9,25 +9,178 @@
 #define __TFM_SPE_MAILBOX_H__
 
 #include "tfm_mailbox.h"
+#ifdef TFM_MULTI_NS_MAILBOX
+#include "device_cfg.h"
+#endif
+
+/*
+ * The SPE mailbox queue can be shallower than the NSPE mailbox queue, to save
+ * secure memory. An NSPE request stays pending in the NSPE mailbox queue until
+ * an SPE slot is free. The platform can set NUM_SPE_MAILBOX_QUEUE_SLOT in
+ * device_cfg.h, otherwise both queues have the same depth.
+ */
+#ifndef NUM_SPE_MAILBOX_QUEUE_SLOT
+#define NUM_SPE_MAILBOX_QUEUE_SLOT          NUM_MAILBOX_QUEUE_SLOT
+#endif
+
+#if (NUM_SPE_MAILBOX_QUEUE_SLOT < 1) || \
+    (NUM_SPE_MAILBOX_QUEUE_SLOT > NUM_MAILBOX_QUEUE_SLOT)
+#error "Error: Invalid NUM_SPE_MAILBOX_QUEUE_SLOT. The value should be between 1 and NUM_MAILBOX_QUEUE_SLOT"
+#endif
+
+/*
+ * If SPE serves the NSPE mailbox queues of several NS cores, the platform
+ * should define the number of NSPE mailbox queues NUM_NS_MAILBOX_QUEUE in
+ * platform device_cfg.h. Otherwise, NUM_NS_MAILBOX_QUEUE is defined as 1.
+ */
+#ifdef TFM_MULTI_NS_MAILBOX
+#ifndef NUM_NS_MAILBOX_QUEUE
+#error "Error: Platform doesn't define NUM_NS_MAILBOX_QUEUE for NSPE mailbox queues"
+#endif
+
+#if (NUM_NS_MAILBOX_QUEUE < 2) || (NUM_NS_MAILBOX_QUEUE > 127)
+#error "Error: Invalid NUM_NS_MAILBOX_QUEUE. The value should be between 2 and 127"
+#endif
+
+/*
+ * Each NSPE mailbox queue has its own range of NS client IDs, so that the NS
+ * clients of different NS cores cannot use the connections of each other.
+ * The client ID in a mailbox message is reduced modulo the range size.
+ */
+#define MAILBOX_NS_CLIENT_ID_RANGE          (0x1000000)
+
+#define MAILBOX_NS_CLIENT_ID(ns_queue_idx, client_id)                        \
+    (-1 - (int32_t)((uint32_t)(ns_queue_idx) * MAILBOX_NS_CLIENT_ID_RANGE +  \
+                    ((uint32_t)(client_id) & (MAILBOX_NS_CLIENT_ID_RANGE - 1))))
+#else /* TFM_MULTI_NS_MAILBOX */
+/* Force the number of NSPE mailbox queues as 1. */
+#undef NUM_NS_MAILBOX_QUEUE
+#define NUM_NS_MAILBOX_QUEUE                (1)
+#endif /* TFM_MULTI_NS_MAILBOX */
+
+#ifdef TFM_MAILBOX_COALESCE
+/*
+ * The number of replies SPE mailbox holds back before notifying NSPE. The
+ * replies held back are notified anyway when the secure core goes idle.
+ */
+#ifndef MAILBOX_REPLY_BATCH
+#define MAILBOX_REPLY_BATCH                 (2)
+#endif
+
+#if (MAILBOX_REPLY_BATCH < 1)
+#error "Error: Invalid MAILBOX_REPLY_BATCH. The value should be at least 1"
+#endif
+
+/* Counters to tune the coalescing of SPE mailbox notifications */
+struct spe_mailbox_coalesce_stats_t {
+    uint32_t nr_handle_msg;         /* Passes of tfm_mailbox_handle_msg()
+                                     * which found requests
+                                     */
+    uint32_t nr_msgs;               /* NSPE requests taken */
+    uint32_t nr_replies;            /* Replies written to NSPE */
+    uint32_t nr_notify;             /* Notifications of replies to NSPE */
+    uint32_t nr_idle_notify;        /* Notifications sent when going idle */
+};
+#endif
+
+#ifdef TFM_MAILBOX_POLL
+/*
+ * The number of consecutive empty checks of the NSPE queues after which SPE
+ * stops polling and waits for the doorbell interrupt again.
+ */
+#ifndef MAILBOX_POLL_IDLE_THRESHOLD
+#define MAILBOX_POLL_IDLE_THRESHOLD         (4096)
+#endif
+
+/*
+ * The maximum delay between two empty checks, in loop iterations. The delay
+ * starts at 1 and doubles after each empty check.
+ */
+#ifndef MAILBOX_POLL_MAX_BACKOFF
+#define MAILBOX_POLL_MAX_BACKOFF            (64)
+#endif
+
+#if (MAILBOX_POLL_IDLE_THRESHOLD < 1)
+#error "Error: Invalid MAILBOX_POLL_IDLE_THRESHOLD. The value should be at least 1"
+#endif
+
+/* Counters to tune the polling of NSPE mailbox queues */
+struct spe_mailbox_poll_stats_t {
+    uint32_t nr_polls;              /* Checks of the NSPE queues */
+    uint32_t nr_hits;               /* Checks which found requests */
+    uint32_t nr_late_hits;          /* Requests found by the last check,
+                                     * after polling has been stopped
+                                     */
+    uint32_t nr_fallbacks;          /* Falls back to the doorbell */
+};
+#endif
+
+/* An NSPE mailbox queue served by SPE */
+struct secure_mailbox_ns_src_t {
+    struct ns_mailbox_queue_t *ns_queue;        /* NULL if not registered */
+    uint8_t                   ns_next_idx;      /*
+                                                 * The NSPE mailbox queue
+                                                 * slot to check first.
+                                                 */
+    uint8_t                   weight;           /*
+                                                 * The number of requests
+                                                 * taken in a round of the
+                                                 * NSPE mailbox queues.
+                                                 */
+#ifdef TFM_MAILBOX_COALESCE
+    uint32_t                  nr_deferred_replies; /*
+                                                    * Replies written to this
+                                                    * NSPE queue but not
+                                                    * notified yet.
+                                                    */
+#endif
+};
 
 /* A single slot structure in SPE mailbox queue */
 struct secure_mailbox_slot_t {
     struct mailbox_msg_t msg;
 
+    uint8_t              ns_src_idx;    /* The NSPE mailbox queue */
     uint8_t              ns_slot_idx;
     mailbox_msg_handle_t msg_handle;
+#ifdef TFM_MAILBOX_SG
+    struct mailbox_sg_table_t sg_table; /* Copy of the NSPE scatter-gather
+                                         * descriptor table, kept until the
+                                         * reply
+                                         */
+#endif
+#ifdef TFM_MAILBOX_STATS
+    uint32_t             start_time;    /* Timer value when the request is
+                                         * taken
+                                         */
+#endif
 };
 
 struct secure_mailbox_queue_t {
     mailbox_queue_status_t       empty_slots;      /* bitmask of empty slots */
 
-    struct secure_mailbox_slot_t queue[NUM_MAILBOX_QUEUE_SLOT];
-    struct ns_mailbox_queue_t    *ns_queue;
+    struct secure_mailbox_slot_t queue[NUM_SPE_MAILBOX_QUEUE_SLOT];
+    struct secure_mailbox_ns_src_t ns_srcs[NUM_NS_MAILBOX_QUEUE];
     uint8_t                      cur_proc_slot_idx; /*
                                                      * The index of mailbox
                                                      * queue slot currently
                                                      * under processing.
                                                      */
+    uint8_t                      next_src_idx;      /*
+                                                     * The NSPE mailbox queue
+                                                     * to serve first.
+                                                     */
+    bool                         ns_backlog;        /*
+                                                     * NSPE requests are left
+                                                     * pending for lack of an
+                                                     * empty SPE slot.
+                                                     */
+#ifdef TFM_MAILBOX_COALESCE
+    struct spe_mailbox_coalesce_stats_t stats;
+#endif
+#ifdef TFM_MAILBOX_POLL
+    struct spe_mailbox_poll_stats_t     poll_stats;
+#endif
 };
 
 /**
@@ -50,6 +203,46 @@ int32_t tfm_mailbox_handle_msg(void);
  */
 int32_t tfm_mailbox_reply_msg(mailbox_msg_handle_t handle, int32_t reply);
 
+#ifdef TFM_MAILBOX_COALESCE
+/**
+ * \brief Notify NSPE of the replies held back by coalescing.
+ *
+ * \note The caller must mask interrupts, since the replies are otherwise
+ *       only updated in handler mode.
+ */
+void tfm_mailbox_flush_reply(void);
+
+/**
+ * \brief Read the counters of SPE mailbox notification coalescing.
+ *
+ * \param[out] stats            The buffer to be written with the counters.
+ */
+void tfm_mailbox_get_coalesce_stats(struct spe_mailbox_coalesce_stats_t *stats);
+#endif
+
+#ifdef TFM_MAILBOX_POLL
+/**
+ * \brief Poll the NSPE mailbox queues for requests instead of waiting for
+ *        the doorbell interrupt.
+ *
+ * \details NSPE skips the doorbell while SPE polls. The requests found are
+ *          handled through PendSV, as for a doorbell. The function returns
+ *          after \ref MAILBOX_POLL_IDLE_THRESHOLD empty checks in a row, once
+ *          NSPE rings the doorbell again. The caller can then let the secure
+ *          core sleep.
+ *
+ * \note Called in thread mode, by the lowest priority thread.
+ */
+void tfm_mailbox_poll(void);
+
+/**
+ * \brief Read the counters of NSPE mailbox queue polling.
+ *
+ * \param[out] stats            The buffer to be written with the counters.
+ */
+void tfm_mailbox_get_poll_stats(struct spe_mailbox_poll_stats_t *stats);
+#endif
+
 /**
  * \brief SPE mailbox initialization
  *
@@ -58,8 +251,27 @@ int32_t tfm_mailbox_reply_msg(mailbox_msg_handle_t handle, int32_t reply);
  */
 int32_t tfm_mailbox_init(void);
 
+/**
+ * \brief Register an NSPE mailbox queue to be served by SPE mailbox.
+ *        Called by the platform in \ref tfm_mailbox_hal_init.
+ *
+ * \param[in] ns_queue_idx      The index of the NSPE mailbox queue, less than
+ *                              NUM_NS_MAILBOX_QUEUE.
+ * \param[in] ns_queue          The base address of the NSPE mailbox queue.
+ * \param[in] weight            The number of requests taken from the queue in
+ *                              each round of the NSPE mailbox queues.
+ *
+ * \retval MAILBOX_SUCCESS      Operation succeeded.
+ * \retval MAILBOX_INVAL_PARAMS The parameters are invalid.
+ */
+int32_t tfm_mailbox_register_ns_queue(uint8_t ns_queue_idx,
+                                      struct ns_mailbox_queue_t *ns_queue,
+                                      uint8_t weight);
+
 /**
  * \brief Platform specific initialization of SPE mailbox.
+ *        Register the NSPE mailbox queues with
+ *        \ref tfm_mailbox_register_ns_queue.
  *
  * \param[in] s_queue           The base address of SPE mailbox queue.
  *
@@ -77,8 +289,65 @@ int32_t tfm_mailbox_hal_init(struct secure_mailbox_queue_t *s_queue);
  */
 int32_t tfm_mailbox_hal_notify_peer(void);
 
+#ifdef TFM_MULTI_NS_MAILBOX
+/**
+ * \brief Notify the NS core of an NSPE mailbox queue that PSA client call
+ *        return results are replied. It replaces
+ *        \ref tfm_mailbox_hal_notify_peer when several NS cores are served.
+ *        Implemented by platform specific inter-processor communication driver.
+ *
+ * \param[in] ns_queue_idx      The index of the NSPE mailbox queue.
+ *
+ * \retval MAILBOX_SUCCESS      The notification is successfully sent out.
+ * \retval Other return code    Operation failed with an error code.
+ */
+int32_t tfm_mailbox_hal_notify_ns_peer(uint8_t ns_queue_idx);
+#endif
+
+#ifdef TFM_MAILBOX_STATS
+/**
+ * \brief Read the current value of the timer shared by NSPE and SPE.
+ *        Implemented by platform specific SPE mailbox HAL.
+ *
+ * \return The timer value, in the same timer ticks as
+ *         tfm_ns_mailbox_hal_get_timestamp() in NSPE.
+ */
+uint32_t tfm_mailbox_hal_get_timestamp(void);
+#endif
+
+#ifdef TFM_MAILBOX_CACHE_MAINT
+/**
+ * \brief Write the data cache lines of a range of an NSPE mailbox queue back
+ *        to memory, so that NSPE reads what SPE wrote there.
+ *        Implemented by platform specific SPE mailbox HAL. It must not touch
+ *        any other line than those of the range.
+ *
+ * \param[in] addr              Start of the range, aligned on
+ *                              \ref MAILBOX_CACHE_LINE_SIZE.
+ * \param[in] size              Size of the range, a multiple of
+ *                              \ref MAILBOX_CACHE_LINE_SIZE.
+ */
+void tfm_mailbox_hal_cache_clean(void *addr, size_t size);
+
+/**
+ * \brief Invalidate the data cache lines of a range of an NSPE mailbox queue,
+ *        so that SPE reads what NSPE wrote there.
+ *        Implemented by platform specific SPE mailbox HAL. It must not touch
+ *        any other line than those of the range.
+ *
+ * \param[in] addr              Start of the range, aligned on
+ *                              \ref MAILBOX_CACHE_LINE_SIZE.
+ * \param[in] size              Size of the range, a multiple of
+ *                              \ref MAILBOX_CACHE_LINE_SIZE.
+ */
+void tfm_mailbox_hal_cache_invalidate(void *addr, size_t size);
+#endif
+
 /**
  * \brief Enter critical section of NSPE mailbox
+ *
+ * \note When several NS cores are served, the critical section must exclude
+ *       all of them.
  */
 void tfm_mailbox_hal_enter_critical(void);
 
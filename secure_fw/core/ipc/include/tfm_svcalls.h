@@ -74,6 +74,75 @@ psa_status_t tfm_svcall_psa_connect(uint32_t *args, bool ns_caller);
  */
 psa_status_t tfm_svcall_psa_call(uint32_t *args, bool ns_caller, uint32_t lr);
 
+/**
+ * \brief SVC handler for \ref psa_call_batch.
+ *
+ * \param[in] args              Include all input arguments:
+ *                              handle, calls, num_calls.
+ * \param[in] ns_caller         If 'true', call from non-secure client.
+ *                              Or from secure client.
+ *
+ * \retval PSA_SUCCESS          All the requests have been handled.
+ * \retval PSA_ERROR_CONNECTION_BUSY The SPM cannot carry the requests to a
+ *                              stateless RoT Service at the moment.
+ * \retval PSA_ERROR_PROGRAMMER_ERROR The connection has been terminated by the
+ *                              RoT Service.
+ * \retval "PROGRAMMER ERROR"   An invalid memory reference was provided or
+ *                              one of the requests is invalid.
+ */
+psa_status_t tfm_svcall_psa_call_batch(uint32_t *args, bool ns_caller);
+
+#ifdef TFM_PSA_ASYNC_CALL
+/**
+ * \brief SVC handler for \ref psa_call_async.
+ *
+ * \param[in] args              Include all input arguments:
+ *                              handle, ctrl_param, in_vec, out_vec.
+ *                              The token of the call is returned in
+ *                              ctrl_param.
+ * \param[in] ns_caller         If 'true', call from non-secure client.
+ *                              Or from secure client.
+ *
+ * \retval PSA_SUCCESS          The request has been queued.
+ * \retval PSA_ERROR_CONNECTION_BUSY The SPM cannot carry a call to a
+ *                              stateless RoT Service at the moment.
+ * \retval PSA_ERROR_PROGRAMMER_ERROR The connection has been terminated by the
+ *                              RoT Service.
+ * \retval "PROGRAMMER ERROR"   The call is invalid or comes from a secure
+ *                              client.
+ */
+psa_status_t tfm_svcall_psa_call_async(uint32_t *args, bool ns_caller);
+
+/**
+ * \brief SVC handler for \ref psa_call_async_result.
+ *
+ * \param[in] args              Include all input arguments:
+ *                              handle, status.
+ * \param[in] ns_caller         If 'true', call from non-secure client.
+ *                              Or from secure client.
+ *
+ * \retval PSA_SUCCESS          The call is complete, the status is written.
+ * \retval PSA_ERROR_CONNECTION_BUSY The call has not been replied yet.
+ * \retval PSA_ERROR_DOES_NOT_EXIST No call is outstanding on the connection.
+ * \retval "PROGRAMMER ERROR"   An invalid handle or memory reference was
+ *                              provided, or the caller is a secure client.
+ */
+psa_status_t tfm_svcall_psa_call_async_result(uint32_t *args, bool ns_caller);
+
+/**
+ * \brief SVC handler to set the non-secure interrupt pended on completion of
+ *        an asynchronous call.
+ *
+ * \param[in] args              Include all input arguments: irq_line.
+ * \param[in] ns_caller         If 'true', call from non-secure client.
+ *                              Or from secure client.
+ *
+ * \retval PSA_SUCCESS          Success.
+ * \retval PSA_ERROR_NOT_PERMITTED The interrupt does not target the NSPE.
+ */
+psa_status_t tfm_svcall_psa_call_async_set_irq(uint32_t *args, bool ns_caller);
+#endif
+
 /**
  * \brief SVC handler for \ref psa_close.
  *
@@ -11,6 +11,7 @@
 #include <stddef.h>
 #include "tfm_arch.h"
 #include "cmsis_compiler.h"
+#include "tfm_list.h"
 
 /* State code */
 #define THRD_STATE_CREATING       0
@@ -30,6 +31,17 @@
 #define THRD_PRIOR_MEDIUM         0x7F
 #define THRD_PRIOR_LOWEST         0xFF
 
+/* Priorities are grouped into levels for the scheduler ready queue */
+#define THRD_PRIOR_LEVEL_SHIFT    3
+#define THRD_PRIOR_LEVEL_NUM      ((THRD_PRIOR_MASK >> THRD_PRIOR_LEVEL_SHIFT) + 1)
+
+#ifdef TFM_THRD_TIME_SLICE
+/* Quantum of the threads of equal priority, in microseconds */
+#ifndef TFM_THRD_TIME_SLICE_US
+#define TFM_THRD_TIME_SLICE_US    10000
+#endif
+#endif
+
 /* Error code */
 #define THRD_SUCCESS              0
 #define THRD_ERR_INVALID_PARAM    1
@@ -47,7 +59,7 @@ struct tfm_core_thread_t {
     uint32_t        state;              /* state                        */
 
     struct tfm_arch_ctx_t    arch_ctx;  /* State context                */
-    struct tfm_core_thread_t *next;     /* next thread in list          */
+    struct tfm_list_node_t   rdy_node;  /* node in ready queue          */
 };
 
 /*
@@ -77,7 +89,8 @@ void tfm_core_thrd_init(struct tfm_core_thread_t *pth,
  *
  * Notes :
  *  Set thread priority. Priority is set to THRD_PRIOR_MEDIUM in
- *  tfm_core_thrd_init().
+ *  tfm_core_thrd_init(). Priority must be set before the thread is
+ *  started by tfm_core_thrd_start().
  */
 void __STATIC_INLINE tfm_core_thrd_set_priority(struct tfm_core_thread_t *pth,
                                                 uint32_t prior)
@@ -86,6 +99,31 @@ void __STATIC_INLINE tfm_core_thrd_set_priority(struct tfm_core_thread_t *pth,
     pth->prior |= prior & THRD_PRIOR_MASK;
 }
 
+/*
+ * Change the priority of a started thread.
+ *
+ * Parameters :
+ *  pth         -     pointer of thread context
+ *  prior       -     priority value (0~255)
+ *
+ * Notes :
+ *  A RUNNING thread is moved in the ready queue according to the new
+ *  priority. Scheduling is not triggered.
+ */
+void tfm_core_thrd_change_priority(struct tfm_core_thread_t *pth,
+                                   uint32_t prior);
+
+/*
+ * Move a RUNNING thread behind the other threads of its priority level.
+ *
+ * Parameters :
+ *  pth         -     pointer of thread context
+ *
+ * Notes :
+ *  Scheduling is not triggered.
+ */
+void tfm_core_thrd_yield(struct tfm_core_thread_t *pth);
+
 /*
  * Set thread security attribute.
  *
@@ -176,7 +214,11 @@ struct tfm_core_thread_t *tfm_core_thrd_get_curr_thread(void);
  * Get next running thread in list.
  *
  * Return :
- *  Pointer of next thread to be run.
+ *  Pointer of next thread to be run, or NULL if no thread is RUNNING.
+ *
+ * Notes :
+ *  The highest priority RUNNING thread is found in constant time, no matter
+ *  how many threads exist or are blocked.
  */
 struct tfm_core_thread_t *tfm_core_thrd_get_next_thread(void);
 
@@ -201,6 +243,20 @@ void tfm_core_thrd_start_scheduler(struct tfm_core_thread_t *pth);
  */
 void tfm_core_thrd_activate_schedule(void);
 
+#ifdef TFM_THRD_TIME_SLICE
+/*
+ * Rotate the current thread behind the threads of equal priority if its
+ * quantum has expired.
+ *
+ * Notes :
+ *  This function should be called by the scheduler before it looks for the
+ *  next thread to run. The threads in the lowest priority level are not
+ *  rotated, as the non-secure thread shares that level and runs until it
+ *  blocks.
+ */
+void tfm_core_thrd_time_slice(void);
+#endif
+
 /*
  * Save current architecture context into 'prev' thread and switch to 'next'.
  *
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "tfm_arch.h"
+#include "tfm_cycle_counter.h"
+#include "tfm_ipc_trace.h"
+#include "tfm_core_utils.h"
+#include "tfm_internal_defines.h"
+#include "tfm_utils.h"
+#include "spm_api.h"
+#include "spm_db.h"
+#include "psa_manifest/pid.h"
+
+#if (TFM_IPC_TRACE_ENTRIES & (TFM_IPC_TRACE_ENTRIES - 1)) != 0
+#error "TFM_IPC_TRACE_ENTRIES must be a power of two!"
+#endif
+
+/*
+ * The trace buffer sits in its own section, so that the linker can keep it
+ * out of the partition data and a debugger can find it by symbol.
+ */
+struct tfm_ipc_trace_buf_t {
+    uint32_t head;                  /* Number of entries recorded           */
+    struct tfm_ipc_trace_entry_t entries[TFM_IPC_TRACE_ENTRIES];
+};
+
+__attribute__((section(".bss.TFM_IPC_TRACE")))
+static struct tfm_ipc_trace_buf_t ipc_trace_buf;
+
+/* Claim the next entry of the ring buffer without masking exceptions */
+static uint32_t ipc_trace_claim(void)
+{
+    uint32_t idx;
+
+#if defined(__ARM_ARCH_6M__)
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    idx = ipc_trace_buf.head++;
+    __set_PRIMASK(primask);
+#else
+    do {
+        idx = __LDREXW(&ipc_trace_buf.head);
+    } while (__STREXW(idx + 1, &ipc_trace_buf.head) != 0);
+#endif
+
+    return idx;
+}
+
+void tfm_ipc_trace_init(void)
+{
+#ifdef TFM_BOOT_TIME
+    /* The boot stages are timed from the start of BL2 with the same counter */
+    (void)tfm_cycle_counter_start(false);
+#else
+    (void)tfm_cycle_counter_start(true);
+#endif
+
+    tfm_core_util_memset(&ipc_trace_buf, 0, sizeof(ipc_trace_buf));
+}
+
+void tfm_ipc_trace_record(uint32_t event, uint32_t arg)
+{
+    uint32_t cycles = tfm_cycle_counter_read();
+    struct tfm_ipc_trace_entry_t *entry;
+
+    entry = &ipc_trace_buf.entries[ipc_trace_claim() &
+                                   (TFM_IPC_TRACE_ENTRIES - 1)];
+    entry->cycles = cycles;
+    entry->event = event;
+    entry->arg = arg;
+}
+
+uint32_t tfm_ipc_trace_get_handler(uint32_t *args)
+{
+    struct tfm_ipc_trace_entry_t *entries;
+    struct spm_partition_desc_t *partition;
+    uint32_t num, head, first, i;
+    uint32_t privileged;
+
+    TFM_CORE_ASSERT(args != NULL);
+    entries = (struct tfm_ipc_trace_entry_t *)args[0];
+    num = args[1];
+
+    /* The trace is only handed out through the platform service */
+    partition = tfm_spm_get_running_partition();
+    if (!partition ||
+        partition->static_data->partition_id != TFM_SP_PLATFORM) {
+        tfm_core_panic();
+    }
+    privileged = tfm_spm_partition_get_privileged_mode(
+        partition->static_data->partition_flags);
+
+    if (num > TFM_IPC_TRACE_ENTRIES) {
+        num = TFM_IPC_TRACE_ENTRIES;
+    }
+
+    if (tfm_memory_check(entries, num * sizeof(*entries), false,
+                         TFM_MEMORY_ACCESS_RW, privileged) != IPC_SUCCESS) {
+        tfm_core_panic();
+    }
+
+    /*
+     * Entries recorded by a higher priority exception while copying may show
+     * up in the copy, which is acceptable for a debug facility.
+     */
+    head = ipc_trace_buf.head;
+    if (num > head) {
+        num = head;
+    }
+    first = head - num;
+
+    for (i = 0; i < num; i++) {
+        entries[i] = ipc_trace_buf.entries[(first + i) &
+                                           (TFM_IPC_TRACE_ENTRIES - 1)];
+    }
+
+    return num;
+}
@@ -6,15 +6,46 @@
  */
 #include "tfm_internal_defines.h"
 #include "tfm_message_queue.h"
+#include "tfm_utils.h"
 
 /* Message queue process */
+TFM_HOT_CODE
 int32_t tfm_msg_enqueue(struct tfm_msg_queue_t *queue,
                         struct tfm_msg_body_t *node)
 {
+#ifdef TFM_MSG_QUEUE_PRIORITY
+    struct tfm_msg_body_t *prev;
+#endif
+
     if (!queue || !node) {
         return IPC_ERROR_BAD_PARAMETERS;
     }
 
+#ifdef TFM_MSG_QUEUE_PRIORITY
+    /*
+     * Messages are kept in priority order, and in arrival order for equal
+     * priority. A message which does not have a higher priority than the tail
+     * is appended in constant time, which covers all the non-secure requests.
+     * Each secure client has at most one message pending, so the walk below
+     * is bounded by the number of secure partitions.
+     */
+    if ((queue->size != 0) && (node->prior < queue->tail->prior)) {
+        if (node->prior < queue->head->prior) {
+            node->next = queue->head;
+            queue->head = node;
+        } else {
+            prev = queue->head;
+            while (prev->next->prior <= node->prior) {
+                prev = prev->next;
+            }
+            node->next = prev->next;
+            prev->next = node;
+        }
+        queue->size++;
+        return IPC_SUCCESS;
+    }
+#endif
+
     if (queue->size == 0) {
         queue->head = node;
         queue->tail = node;
@@ -26,6 +57,7 @@ int32_t tfm_msg_enqueue(struct tfm_msg_queue_t *queue,
     return IPC_SUCCESS;
 }
 
+TFM_HOT_CODE
 struct tfm_msg_body_t *tfm_msg_dequeue(struct tfm_msg_queue_t *queue)
 {
     struct tfm_msg_body_t *pop_node;
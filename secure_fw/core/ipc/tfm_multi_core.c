@@ -1,14 +1,16 @@
 /*
- * Copyright (c) 2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include "cmsis_compiler.h"
 #include "platform/include/tfm_spm_hal.h"
 #include "psa/client.h"
 #include "tfm_internal.h"
 #include "tfm_nspm.h"
 #include "tfm_spe_mailbox.h"
+#include "spm_api.h"
 #include "tfm_utils.h"
 #include "log/tfm_assert.h"
 #include "log/tfm_log.h"
@@ -38,12 +40,28 @@ void tfm_nspm_thread_entry(void)
     tfm_mailbox_init();
 
     /*
-     * TODO
-     * The infinite-loop can be replaced with low-power sleep and resume
-     * operation. It may require privileged access to platform specific
-     * hardware.
+     * The non-secure agent thread has the lowest priority, it only runs when
+     * every secure partition is blocked. Mailbox messages and secure
+     * interrupts are handled in exception context and preempt this thread.
      */
     while (1) {
+#ifdef TFM_MAILBOX_POLL
+        /* Only sleep after NSPE has been quiet for a while */
+        tfm_mailbox_poll();
+#endif
+#ifdef TFM_MAILBOX_COALESCE
+        /*
+         * Notify the replies held back before going idle. Interrupts are
+         * masked so that no reply can be held back after the flush. A pending
+         * interrupt still wakes the core up.
+         */
+        __disable_irq();
+        tfm_mailbox_flush_reply();
+        tfm_spm_idle();
+        __enable_irq();
+#else
+        tfm_spm_idle();
+#endif
     }
 
     /* Should not run here */
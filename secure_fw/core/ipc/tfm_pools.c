@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -14,18 +14,74 @@
 #include "tfm_internal_defines.h"
 #include "cmsis_compiler.h"
 #include "tfm_utils.h"
-#include "tfm_list.h"
 #include "tfm_pools.h"
 #include "tfm_memory_utils.h"
 #include "tfm_core_utils.h"
 
+/* Address of the chunk at the index in the pool */
+TFM_HOT_CODE
+static struct tfm_pool_chunk_t *pool_chunk(struct tfm_pool_instance_t *pool,
+                                           uint32_t idx)
+{
+    return (struct tfm_pool_chunk_t *)((uint8_t *)pool->chunks +
+                   idx * (pool->chunksz + sizeof(struct tfm_pool_chunk_t)));
+}
+
+/*
+ * Atomically add 'inc' to the counter and return the new value. Armv6-M has
+ * no exclusive access instructions, so interrupts are masked instead.
+ */
+TFM_HOT_CODE
+static uint32_t pool_atomic_add(uint32_t *counter, uint32_t inc)
+{
+    uint32_t val;
+
+#if defined(__ARM_ARCH_6M__)
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    val = *counter + inc;
+    *counter = val;
+    __set_PRIMASK(primask);
+#else
+    do {
+        val = __LDREXW(counter) + inc;
+    } while (__STREXW(val, counter) != 0);
+#endif
+
+    return val;
+}
+
+/* Raise the high-water mark of the pool to 'in_use' if needed */
+TFM_HOT_CODE
+static void pool_update_max_in_use(struct tfm_pool_instance_t *pool,
+                                   uint32_t in_use)
+{
+#if defined(__ARM_ARCH_6M__)
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    if (pool->stats.max_in_use < in_use) {
+        pool->stats.max_in_use = in_use;
+    }
+    __set_PRIMASK(primask);
+#else
+    do {
+        if (__LDREXW(&pool->stats.max_in_use) >= in_use) {
+            __CLREX();
+            return;
+        }
+    } while (__STREXW(in_use, &pool->stats.max_in_use) != 0);
+#endif
+}
+
 int32_t tfm_pool_init(struct tfm_pool_instance_t *pool, size_t poolsz,
                       size_t chunksz, size_t num)
 {
     struct tfm_pool_chunk_t *pchunk;
     size_t i;
 
-    if (!pool || num == 0) {
+    if (!pool || num == 0 || num >= TFM_POOL_NIL_IDX) {
         return IPC_ERROR_BAD_PARAMETERS;
     }
 
@@ -38,76 +94,121 @@ int32_t tfm_pool_init(struct tfm_pool_instance_t *pool, size_t poolsz,
     /* Buffer should be BSS cleared but clear it again */
     tfm_core_util_memset(pool, 0, poolsz);
 
-    /* Chain pool chunks */
-    tfm_list_init(&pool->chunks_list);
+    /* Prepare instance */
+    pool->chunksz = chunksz;
+    pool->chunk_count = num;
 
-    pchunk = (struct tfm_pool_chunk_t *)pool->chunks;
+    /* Stack all the chunks as free, the first chunk on top */
     for (i = 0; i < num; i++) {
+        pchunk = pool_chunk(pool, i);
         pchunk->pool = pool;
-        tfm_list_add_tail(&pool->chunks_list, &pchunk->list);
-        pchunk = (struct tfm_pool_chunk_t *)&pchunk->data[chunksz];
+        pchunk->next_free = (i + 1 < num) ? i + 1 : TFM_POOL_NIL_IDX;
     }
-
-    /* Prepare instance and insert to pool list */
-    pool->chunksz = chunksz;
-    pool->chunk_count = num;
+    pool->free_head = 0;
 
     return IPC_SUCCESS;
 }
 
+TFM_HOT_CODE
 void *tfm_pool_alloc(struct tfm_pool_instance_t *pool)
 {
-    struct tfm_list_node_t *node;
     struct tfm_pool_chunk_t *pchunk;
+    uint32_t idx;
 
     if (!pool) {
         return NULL;
     }
 
-    if (tfm_list_is_empty(&pool->chunks_list)) {
+    /* Pop the free stack head */
+#if defined(__ARM_ARCH_6M__)
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    idx = pool->free_head;
+    if (idx != TFM_POOL_NIL_IDX) {
+        pool->free_head = pool_chunk(pool, idx)->next_free;
+    }
+    __set_PRIMASK(primask);
+#else
+    do {
+        idx = __LDREXW(&pool->free_head);
+        if (idx == TFM_POOL_NIL_IDX) {
+            __CLREX();
+            break;
+        }
+    } while (__STREXW(pool_chunk(pool, idx)->next_free,
+                      &pool->free_head) != 0);
+#endif
+
+    if (idx == TFM_POOL_NIL_IDX) {
+        (void)pool_atomic_add(&pool->stats.alloc_failures, 1);
         return NULL;
     }
 
-    node = tfm_list_first_node(&pool->chunks_list);
-    pchunk = TFM_GET_CONTAINER_PTR(node, struct tfm_pool_chunk_t, list);
+    pool_update_max_in_use(pool, pool_atomic_add(&pool->stats.in_use, 1));
 
-    /* Remove node from list node, it will be added when pool free */
-    tfm_list_del_node(node);
+    pchunk = pool_chunk(pool, idx);
 
     return &pchunk->data;
 }
 
+TFM_HOT_CODE
 void tfm_pool_free(void *ptr)
 {
     struct tfm_pool_chunk_t *pchunk;
     struct tfm_pool_instance_t *pool;
+    uint32_t idx;
 
     pchunk = TFM_GET_CONTAINER_PTR(ptr, struct tfm_pool_chunk_t, data);
     pool = (struct tfm_pool_instance_t *)pchunk->pool;
-    tfm_list_add_tail(&pool->chunks_list, &pchunk->list);
+    idx = ((uintptr_t)pchunk - (uintptr_t)pool->chunks) /
+          (pool->chunksz + sizeof(struct tfm_pool_chunk_t));
+
+    /* Push the chunk on the free stack */
+#if defined(__ARM_ARCH_6M__)
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    pchunk->next_free = pool->free_head;
+    pool->free_head = idx;
+    __set_PRIMASK(primask);
+#else
+    do {
+        pchunk->next_free = __LDREXW(&pool->free_head);
+    } while (__STREXW(idx, &pool->free_head) != 0);
+#endif
+
+    (void)pool_atomic_add(&pool->stats.in_use, (uint32_t)-1);
+}
+
+void tfm_pool_get_stats(struct tfm_pool_instance_t *pool,
+                        struct tfm_pool_stats_t *stats)
+{
+    TFM_CORE_ASSERT(pool && stats);
+
+    *stats = pool->stats;
 }
 
+TFM_HOT_CODE
 bool is_valid_chunk_data_in_pool(struct tfm_pool_instance_t *pool,
                                  uint8_t *data)
 {
-    const uintptr_t chunks_start = (uintptr_t)(pool->chunks);
     const size_t chunks_size = pool->chunksz + sizeof(struct tfm_pool_chunk_t);
-    const size_t chunk_count = pool->chunk_count;
-    const uintptr_t chunks_end = chunks_start + chunks_size * chunk_count;
-    uintptr_t pool_chunk_address = 0;
+    uintptr_t offset;
+
+    /*
+     * Data of the chunk at index 'i' is at offset
+     * 'i * chunks_size + sizeof(struct tfm_pool_chunk_t)' from the first
+     * chunk. The unsigned subtraction wraps for pointers below the pool.
+     */
+    offset = (uintptr_t)data - (uintptr_t)pool->chunks -
+             sizeof(struct tfm_pool_chunk_t);
 
     /* Check that the message was allocated from the pool. */
-    if ((uintptr_t)data < chunks_start || (uintptr_t)data >= chunks_end) {
+    if (offset >= chunks_size * pool->chunk_count) {
         return false;
     }
 
-    pool_chunk_address =
-    (uint32_t)TFM_GET_CONTAINER_PTR(data, struct tfm_pool_chunk_t, data);
-
-    /* Make sure that the chunk containing the message is aligned on */
-    /* chunk boundary in the pool. */
-    if ((pool_chunk_address - chunks_start) % chunks_size != 0) {
-        return false;
-    }
-    return true;
+    /* Make sure that the data is aligned on chunk boundary in the pool. */
+    return (offset % chunks_size) == 0;
 }
@@ -5,6 +5,7 @@
  *
  */
 
+#include <stdint.h>
 #include <stdlib.h>
 #include "psa/service.h"
 #include "spm_api.h"
@@ -13,9 +14,11 @@
 #include "tfm_memory_utils.h"
 #include "tfm_message_queue.h"
 #include "tfm_psa_client_call.h"
+#include "tfm_sfn.h"
 #include "tfm_utils.h"
 #include "tfm_wait.h"
 #include "tfm_nspm.h"
+#include "tfm_spm_hal.h"
 
 uint32_t tfm_psa_framework_version(void)
 {
@@ -53,9 +56,13 @@ psa_status_t tfm_psa_connect(uint32_t sid, uint32_t version, bool ns_caller)
     psa_handle_t connect_handle;
     int32_t client_id;
 
-    /* It is a fatal error if the RoT Service does not exist on the platform */
+    /*
+     * It is a fatal error if the RoT Service does not exist on the platform, or
+     * if it is a stateless RoT Service which is only called through its static
+     * handle.
+     */
     service = tfm_spm_get_service_by_sid(sid);
-    if (!service) {
+    if (!service || !service->service_db->connection_based) {
         tfm_core_panic();
     }
 
@@ -109,39 +116,55 @@ psa_status_t tfm_psa_connect(uint32_t sid, uint32_t version, bool ns_caller)
     return PSA_SUCCESS;
 }
 
-psa_status_t tfm_psa_call(psa_handle_t handle, int32_t type,
-                          const psa_invec *inptr, size_t in_num,
-                          psa_outvec *outptr, size_t out_num,
-                          bool ns_caller, uint32_t privileged)
+/*
+ * Resolve the connection a request is made on. A connection is created to
+ * carry the request if the handle is the static handle of a stateless RoT
+ * Service.
+ */
+TFM_HOT_CODE
+static psa_status_t tfm_psa_get_call_conn(psa_handle_t *p_handle,
+                                          int32_t client_id, bool ns_caller,
+                                          struct tfm_spm_service_t **p_service)
 {
-    psa_invec invecs[PSA_MAX_IOVEC];
-    psa_outvec outvecs[PSA_MAX_IOVEC];
     struct tfm_spm_service_t *service;
-    struct tfm_msg_body_t *msg;
-    int i, j;
-    int32_t client_id;
+    psa_handle_t handle = *p_handle;
+    uint32_t sid;
+
+    if (TFM_HANDLE_IS_STATELESS(handle)) {
+        /*
+         * It is a fatal error if the static handle does not refer to a
+         * stateless RoT Service, or if the caller is not authorized to access
+         * the RoT Service.
+         */
+        sid = TFM_STATELESS_HANDLE_TO_SID(handle);
+        service = tfm_spm_get_service_by_sid(sid);
+        if (!service || service->service_db->connection_based) {
+            tfm_core_panic();
+        }
 
-    /* It is a fatal error if in_len + out_len > PSA_MAX_IOVEC. */
-    if ((in_num > PSA_MAX_IOVEC) ||
-        (out_num > PSA_MAX_IOVEC) ||
-        (in_num + out_num > PSA_MAX_IOVEC)) {
-        tfm_core_panic();
-    }
+        if (tfm_spm_check_authorization(sid, service, ns_caller) !=
+            IPC_SUCCESS) {
+            tfm_core_panic();
+        }
 
-    if (ns_caller) {
-        client_id = tfm_nspm_get_current_client_id();
+        /*
+         * The call does not go through a connect message. A connection is
+         * only created to carry the message and it is freed on psa_reply().
+         */
+        handle = tfm_spm_create_conn_handle(service, client_id);
+        if (handle == PSA_NULL_HANDLE) {
+            return PSA_ERROR_CONNECTION_BUSY;
+        }
     } else {
-        client_id = tfm_spm_partition_get_running_partition_id();
-    }
-
-    /* It is a fatal error if an invalid handle was passed. */
-    if (tfm_spm_validate_conn_handle(handle, client_id) != IPC_SUCCESS) {
-        tfm_core_panic();
-    }
-    service = tfm_spm_get_service_by_handle(handle);
-    if (!service) {
-        /* FixMe: Need to implement one mechanism to resolve this failure. */
-        tfm_core_panic();
+        /* It is a fatal error if an invalid handle was passed. */
+        if (tfm_spm_validate_conn_handle(handle, client_id) != IPC_SUCCESS) {
+            tfm_core_panic();
+        }
+        service = tfm_spm_get_service_by_handle(handle);
+        if (!service) {
+            /* FixMe: Need to implement one mechanism to resolve this failure */
+            tfm_core_panic();
+        }
     }
 
     /* It is a fatal error if the connection is currently handling a request. */
@@ -159,6 +182,31 @@ psa_status_t tfm_psa_call(psa_handle_t handle, int32_t type,
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
+    *p_handle = handle;
+    *p_service = service;
+
+    return PSA_SUCCESS;
+}
+
+/*
+ * Check the client vectors of a request and copy them to invecs and outvecs.
+ * It is a fatal error if any of them is invalid.
+ */
+TFM_HOT_CODE
+static void tfm_psa_check_call_vecs(const psa_invec *inptr, size_t in_num,
+                                    psa_outvec *outptr, size_t out_num,
+                                    bool ns_caller, uint32_t privileged,
+                                    psa_invec *invecs, psa_outvec *outvecs)
+{
+    int i, j;
+
+    /* It is a fatal error if in_len + out_len > PSA_MAX_IOVEC. */
+    if ((in_num > PSA_MAX_IOVEC) ||
+        (out_num > PSA_MAX_IOVEC) ||
+        (in_num + out_num > PSA_MAX_IOVEC)) {
+        tfm_core_panic();
+    }
+
     /*
      * Read client invecs from the wrap input vector. It is a fatal error
      * if the memory reference for the wrap input vector is invalid or not
@@ -179,8 +227,8 @@ psa_status_t tfm_psa_call(psa_handle_t handle, int32_t type,
         tfm_core_panic();
     }
 
-    tfm_core_util_memset(invecs, 0, sizeof(invecs));
-    tfm_core_util_memset(outvecs, 0, sizeof(outvecs));
+    tfm_core_util_memset(invecs, 0, PSA_MAX_IOVEC * sizeof(psa_invec));
+    tfm_core_util_memset(outvecs, 0, PSA_MAX_IOVEC * sizeof(psa_outvec));
 
     /* Copy the address out to avoid TOCTOU attacks. */
     tfm_core_util_memcpy(invecs, inptr, in_num * sizeof(psa_invec));
@@ -221,6 +269,35 @@ psa_status_t tfm_psa_call(psa_handle_t handle, int32_t type,
             tfm_core_panic();
         }
     }
+}
+
+TFM_HOT_CODE
+psa_status_t tfm_psa_call(psa_handle_t handle, int32_t type,
+                          const psa_invec *inptr, size_t in_num,
+                          psa_outvec *outptr, size_t out_num,
+                          bool ns_caller, uint32_t privileged,
+                          uint32_t *ctx)
+{
+    psa_invec invecs[PSA_MAX_IOVEC];
+    psa_outvec outvecs[PSA_MAX_IOVEC];
+    struct tfm_spm_service_t *service;
+    struct tfm_msg_body_t *msg;
+    int32_t client_id;
+    psa_status_t status;
+
+    if (ns_caller) {
+        client_id = tfm_nspm_get_current_client_id();
+    } else {
+        client_id = tfm_spm_partition_get_running_partition_id();
+    }
+
+    status = tfm_psa_get_call_conn(&handle, client_id, ns_caller, &service);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    tfm_psa_check_call_vecs(inptr, in_num, outptr, out_num, ns_caller,
+                            privileged, invecs, outvecs);
 
     /*
      * FixMe: Need to check if the message is unrecognized by the RoT
@@ -235,6 +312,15 @@ psa_status_t tfm_psa_call(psa_handle_t handle, int32_t type,
     tfm_spm_fill_msg(msg, service, handle, type, client_id, invecs,
                      in_num, outvecs, out_num, outptr);
 
+#ifdef TFM_SFN_PARTITIONS
+    /* The secure function is run on the context of the client */
+    if (service->service_db->sfn) {
+        return tfm_sfn_call(msg, ctx);
+    }
+#else
+    (void)ctx;
+#endif
+
     /*
      * Send message and wake up the SP who is waiting on message queue,
      * and scheduler triggered
@@ -246,14 +332,465 @@ psa_status_t tfm_psa_call(psa_handle_t handle, int32_t type,
     return PSA_SUCCESS;
 }
 
+#ifdef TFM_MAILBOX_SG
+/*
+ * Check the segments of the client vectors of a scatter-gather request and
+ * the sizes of the vectors. It is a fatal error if any of them is invalid.
+ * The segment lists are already in secure memory.
+ */
+static void tfm_psa_check_call_segs(const psa_invec *in_segs,
+                                    const size_t *in_nr_segs, size_t in_num,
+                                    const psa_outvec *out_segs,
+                                    const size_t *out_nr_segs, size_t out_num,
+                                    bool ns_caller, uint32_t privileged)
+{
+    size_t nr_in = 0, nr_out = 0, size;
+    size_t i, j;
+
+    /* It is a fatal error if in_len + out_len > PSA_MAX_IOVEC. */
+    if ((in_num > PSA_MAX_IOVEC) ||
+        (out_num > PSA_MAX_IOVEC) ||
+        (in_num + out_num > PSA_MAX_IOVEC)) {
+        tfm_core_panic();
+    }
+
+    /* It is a fatal error if the size of a vector overflows. */
+    for (i = 0; i < in_num; i++) {
+        size = 0;
+        for (j = 0; j < in_nr_segs[i]; j++) {
+            if (in_segs[nr_in + j].len > SIZE_MAX - size) {
+                tfm_core_panic();
+            }
+            size += in_segs[nr_in + j].len;
+        }
+        nr_in += in_nr_segs[i];
+    }
+
+    for (i = 0; i < out_num; i++) {
+        size = 0;
+        for (j = 0; j < out_nr_segs[i]; j++) {
+            if (out_segs[nr_out + j].len > SIZE_MAX - size) {
+                tfm_core_panic();
+            }
+            size += out_segs[nr_out + j].len;
+        }
+        nr_out += out_nr_segs[i];
+    }
+
+    /*
+     * For client input segments, it is a fatal error if the provided payload
+     * memory reference was invalid or not readable.
+     */
+    for (i = 0; i < nr_in; i++) {
+        if (tfm_memory_check(in_segs[i].base, in_segs[i].len, ns_caller,
+            TFM_MEMORY_ACCESS_RO, privileged) != IPC_SUCCESS) {
+            tfm_core_panic();
+        }
+    }
+
+    /*
+     * Clients must never overlap input parameters because of the risk of a
+     * double-fetch inconsistency. It holds for the segments of one input
+     * vector as well.
+     */
+    for (i = 0; i + 1 < nr_in; i++) {
+        for (j = i + 1; j < nr_in; j++) {
+            if (!(in_segs[j].base + in_segs[j].len <= in_segs[i].base ||
+                  in_segs[j].base >= in_segs[i].base + in_segs[i].len)) {
+                tfm_core_panic();
+            }
+        }
+    }
+
+    /*
+     * For client output segments, it is a fatal error if the provided payload
+     * memory reference was invalid or not read-write.
+     */
+    for (i = 0; i < nr_out; i++) {
+        if (tfm_memory_check(out_segs[i].base, out_segs[i].len,
+            ns_caller, TFM_MEMORY_ACCESS_RW, privileged) != IPC_SUCCESS) {
+            tfm_core_panic();
+        }
+    }
+}
+
+psa_status_t tfm_psa_call_sg(psa_handle_t handle, int32_t type,
+                             const psa_invec *in_segs,
+                             const size_t *in_nr_segs, size_t in_num,
+                             psa_outvec *out_segs,
+                             const size_t *out_nr_segs, size_t out_num,
+                             size_t *out_written,
+                             bool ns_caller, uint32_t privileged)
+{
+    struct tfm_spm_service_t *service;
+    struct tfm_msg_body_t *msg;
+    int32_t client_id;
+    psa_status_t status;
+
+    if (ns_caller) {
+        client_id = tfm_nspm_get_current_client_id();
+    } else {
+        client_id = tfm_spm_partition_get_running_partition_id();
+    }
+
+    status = tfm_psa_get_call_conn(&handle, client_id, ns_caller, &service);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    tfm_psa_check_call_segs(in_segs, in_nr_segs, in_num, out_segs,
+                            out_nr_segs, out_num, ns_caller, privileged);
+
+    /*
+     * The written lengths are reported on reply. It is a fatal error if the
+     * memory reference for them is invalid or not read-write.
+     */
+    if (tfm_memory_check(out_written, out_num * sizeof(size_t), ns_caller,
+        TFM_MEMORY_ACCESS_RW, privileged) != IPC_SUCCESS) {
+        tfm_core_panic();
+    }
+
+    msg = tfm_spm_get_msg_buffer_from_conn_handle(handle);
+    if (!msg) {
+        tfm_core_panic();
+    }
+
+    tfm_spm_fill_msg(msg, service, handle, type, client_id, NULL, 0, NULL, 0,
+                     NULL);
+    tfm_spm_fill_msg_sg(msg, in_segs, in_nr_segs, in_num, out_segs,
+                        out_nr_segs, out_num, out_written);
+
+    if (tfm_spm_send_event(service, msg) != IPC_SUCCESS) {
+        tfm_core_panic();
+    }
+    return PSA_SUCCESS;
+}
+#endif
+
+/* Checked requests of the batches being delivered */
+static struct tfm_batch_reqs_t batch_reqs[TFM_BATCH_MAX_NUM];
+
+static struct tfm_batch_reqs_t *tfm_psa_alloc_batch_reqs(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < TFM_BATCH_MAX_NUM; i++) {
+        if (!batch_reqs[i].in_use) {
+            batch_reqs[i].in_use = true;
+            return &batch_reqs[i];
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Fill the connection message with the current request of the batch. The
+ * request has been checked and copied out of the client memory when the
+ * batch was submitted, as the memory checks of a secure client depend on the
+ * isolation context, which is the one of the RoT Service once the batch runs.
+ */
+static struct tfm_msg_body_t *tfm_psa_fill_batch_msg(
+                                              struct tfm_conn_handle_t *conn)
+{
+    struct tfm_conn_batch_t *batch = &conn->batch;
+    struct tfm_batch_req_t *req = &batch->reqs->req[batch->idx];
+    struct tfm_msg_body_t *msg;
+
+    msg = tfm_spm_get_msg_buffer_from_conn_handle((psa_handle_t)conn);
+    if (!msg) {
+        tfm_core_panic();
+    }
+
+    tfm_spm_fill_msg(msg, conn->service, (psa_handle_t)conn, req->type,
+                     conn->client_id, req->in_vec, req->in_len, req->out_vec,
+                     req->out_len, req->caller_outvec);
+
+    return msg;
+}
+
+psa_status_t tfm_psa_call_batch(psa_handle_t handle, psa_batch_call_t *calls,
+                                size_t num_calls, bool ns_caller,
+                                uint32_t privileged)
+{
+    psa_batch_call_t call;
+    struct tfm_batch_reqs_t *reqs;
+    struct tfm_batch_req_t *req;
+    struct tfm_spm_service_t *service;
+    struct tfm_conn_handle_t *conn;
+    struct tfm_msg_body_t *msg;
+    int32_t client_id;
+    psa_status_t status;
+    size_t i;
+
+    if (num_calls == 0) {
+        return PSA_SUCCESS;
+    }
+
+    /*
+     * The requests are read when they are submitted and their status is
+     * written back. It is a fatal error if the batch is larger than SPM can
+     * hold or if its memory reference is invalid or not read-write.
+     */
+    if ((num_calls > TFM_BATCH_MAX_CALLS) ||
+        (tfm_memory_check(calls, num_calls * sizeof(psa_batch_call_t),
+                          ns_caller, TFM_MEMORY_ACCESS_RW, privileged) !=
+         IPC_SUCCESS)) {
+        tfm_core_panic();
+    }
+
+    reqs = tfm_psa_alloc_batch_reqs();
+    if (!reqs) {
+        return PSA_ERROR_CONNECTION_BUSY;
+    }
+
+    /*
+     * Check every request while the memory checks run in the context of the
+     * client, so that an invalid batch is rejected before any request is
+     * delivered. The checked requests are copied to SPM memory, and are not
+     * read from the client memory again.
+     */
+    for (i = 0; i < num_calls; i++) {
+        req = &reqs->req[i];
+        tfm_core_util_memcpy(&call, &calls[i], sizeof(call));
+        if (call.type < 0) {
+            tfm_core_panic();
+        }
+        tfm_psa_check_call_vecs(call.in_vec, call.in_len, call.out_vec,
+                                call.out_len, ns_caller, privileged,
+                                req->in_vec, req->out_vec);
+        req->type = call.type;
+        req->in_len = call.in_len;
+        req->out_len = call.out_len;
+        req->caller_outvec = call.out_vec;
+    }
+
+    if (ns_caller) {
+        client_id = tfm_nspm_get_current_client_id();
+    } else {
+        client_id = tfm_spm_partition_get_running_partition_id();
+    }
+
+    status = tfm_psa_get_call_conn(&handle, client_id, ns_caller, &service);
+    if (status != PSA_SUCCESS) {
+        reqs->in_use = false;
+        return status;
+    }
+
+    conn = (struct tfm_conn_handle_t *)handle;
+    conn->batch.calls = calls;
+    conn->batch.reqs = reqs;
+    conn->batch.num_calls = num_calls;
+    conn->batch.idx = 0;
+
+    msg = tfm_psa_fill_batch_msg(conn);
+
+    /*
+     * The client is blocked until the last request of the batch is replied,
+     * see tfm_psa_call_batch_continue().
+     */
+    if (tfm_spm_send_event(service, msg) != IPC_SUCCESS) {
+        tfm_core_panic();
+    }
+    return PSA_SUCCESS;
+}
+
+bool tfm_psa_call_batch_continue(psa_handle_t handle, psa_status_t *p_status)
+{
+    struct tfm_conn_handle_t *conn = (struct tfm_conn_handle_t *)handle;
+    struct tfm_conn_batch_t *batch = &conn->batch;
+    struct tfm_msg_body_t *msg;
+    struct tfm_core_thread_t *owner;
+#ifdef TFM_MSG_QUEUE_PRIORITY
+    uint32_t prior;
+#endif
+
+    if (!batch->calls) {
+        return false;
+    }
+
+    batch->calls[batch->idx].status = *p_status;
+    batch->idx++;
+
+    /*
+     * A terminated connection cannot take the remaining requests, which are
+     * not delivered.
+     */
+    if (*p_status == PSA_ERROR_PROGRAMMER_ERROR ||
+        batch->idx == batch->num_calls) {
+        batch->calls = NULL;
+        batch->reqs->in_use = false;
+        if (*p_status != PSA_ERROR_PROGRAMMER_ERROR) {
+            *p_status = PSA_SUCCESS;
+        }
+        return false;
+    }
+
+    /*
+     * Hand the next request to the RoT Service without returning to the
+     * client. The client stays the owner of the acknowledge event.
+     */
+    owner = conn->internal_msg.ack_evnt.owner;
+#ifdef TFM_MSG_QUEUE_PRIORITY
+    prior = conn->internal_msg.prior;
+#endif
+    msg = tfm_psa_fill_batch_msg(conn);
+    msg->ack_evnt.owner = owner;
+#ifdef TFM_MSG_QUEUE_PRIORITY
+    msg->prior = prior;
+#endif
+
+    if (tfm_spm_queue_msg(conn->service, msg) != IPC_SUCCESS) {
+        tfm_core_panic();
+    }
+
+    return true;
+}
+
+#ifdef TFM_PSA_ASYNC_CALL
+/* Non-secure interrupt pended on completion of an asynchronous call */
+static int32_t async_call_ns_irq = -1;
+
+psa_status_t tfm_psa_call_async(psa_handle_t handle, int32_t type,
+                                const psa_invec *inptr, size_t in_num,
+                                psa_outvec *outptr, size_t out_num,
+                                uint32_t privileged, psa_handle_t *p_token)
+{
+    psa_invec invecs[PSA_MAX_IOVEC];
+    psa_outvec outvecs[PSA_MAX_IOVEC];
+    struct tfm_spm_service_t *service;
+    struct tfm_conn_handle_t *conn;
+    struct tfm_msg_body_t *msg;
+    int32_t client_id;
+    psa_status_t status;
+
+    client_id = tfm_nspm_get_current_client_id();
+
+    status = tfm_psa_get_call_conn(&handle, client_id, true, &service);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    tfm_psa_check_call_vecs(inptr, in_num, outptr, out_num, true, privileged,
+                            invecs, outvecs);
+
+    msg = tfm_spm_get_msg_buffer_from_conn_handle(handle);
+    if (!msg) {
+        tfm_core_panic();
+    }
+
+    tfm_spm_fill_msg(msg, service, handle, type, client_id, invecs,
+                     in_num, outvecs, out_num, outptr);
+#ifdef TFM_MSG_QUEUE_PRIORITY
+    msg->prior = tfm_core_thrd_get_curr_thread()->prior;
+#endif
+
+    /*
+     * The status is kept on the connection until it is collected, so the
+     * connection identifies the call. The connection carrying a call to a
+     * stateless RoT Service lives until then.
+     */
+    conn = (struct tfm_conn_handle_t *)handle;
+    conn->async.pending = true;
+    conn->async.done = false;
+    *p_token = handle;
+
+    /*
+     * The client is not blocked on the acknowledge event, which has no owner.
+     * It is notified on psa_reply(), see tfm_psa_call_async_complete().
+     */
+    if (tfm_spm_queue_msg(service, msg) != IPC_SUCCESS) {
+        tfm_core_panic();
+    }
+    return PSA_SUCCESS;
+}
+
+psa_status_t tfm_psa_call_async_result(psa_handle_t handle,
+                                       psa_status_t *p_status)
+{
+    struct tfm_conn_handle_t *conn = (struct tfm_conn_handle_t *)handle;
+
+    /* It is a fatal error if an invalid handle was passed. */
+    if (TFM_HANDLE_IS_STATELESS(handle) ||
+        tfm_spm_validate_conn_handle(handle,
+                                     tfm_nspm_get_current_client_id()) !=
+        IPC_SUCCESS) {
+        tfm_core_panic();
+    }
+
+    if (conn->async.pending) {
+        return PSA_ERROR_CONNECTION_BUSY;
+    }
+
+    if (!conn->async.done) {
+        return PSA_ERROR_DOES_NOT_EXIST;
+    }
+
+    conn->async.done = false;
+    *p_status = conn->async.status;
+
+    if (!conn->service->service_db->connection_based) {
+        tfm_spm_free_conn_handle(conn->service, handle);
+    }
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t tfm_psa_call_async_set_irq(int32_t irq_line)
+{
+    if (irq_line < 0) {
+        async_call_ns_irq = -1;
+        return PSA_SUCCESS;
+    }
+
+    /* A secure interrupt must not be raised on behalf of the NSPE. */
+    if (tfm_spm_hal_get_irq_target_state(irq_line) !=
+        TFM_IRQ_TARGET_STATE_NON_SECURE) {
+        return PSA_ERROR_NOT_PERMITTED;
+    }
+
+    async_call_ns_irq = irq_line;
+
+    return PSA_SUCCESS;
+}
+
+bool tfm_psa_call_async_pending(psa_handle_t handle)
+{
+    return (handle != PSA_NULL_HANDLE) &&
+           ((struct tfm_conn_handle_t *)handle)->async.pending;
+}
+
+bool tfm_psa_call_async_complete(psa_handle_t handle, psa_status_t status)
+{
+    struct tfm_conn_handle_t *conn = (struct tfm_conn_handle_t *)handle;
+
+    if (!tfm_psa_call_async_pending(handle)) {
+        return false;
+    }
+
+    conn->async.status = status;
+    conn->async.pending = false;
+    conn->async.done = true;
+
+    if (async_call_ns_irq >= 0) {
+        tfm_spm_hal_set_pending_irq(async_call_ns_irq);
+    }
+
+    return true;
+}
+#endif /* TFM_PSA_ASYNC_CALL */
+
 void tfm_psa_close(psa_handle_t handle, bool ns_caller)
 {
     struct tfm_spm_service_t *service;
     struct tfm_msg_body_t *msg;
     int32_t client_id;
 
-    /* It will have no effect if called with the NULL handle */
-    if (handle == PSA_NULL_HANDLE) {
+    /*
+     * It will have no effect if called with the NULL handle or with the static
+     * handle of a stateless RoT Service, which has no connection to close.
+     */
+    if (handle == PSA_NULL_HANDLE || TFM_HANDLE_IS_STATELESS(handle)) {
         return;
     }
 
@@ -288,6 +825,11 @@ void tfm_psa_close(psa_handle_t handle, bool ns_caller)
         tfm_core_panic();
     }
 
+    /* The connection only carries a call to a stateless RoT Service. */
+    if (!service->service_db->connection_based) {
+        tfm_core_panic();
+    }
+
     /* No input or output needed for close message */
     tfm_spm_fill_msg(msg, service, handle, PSA_IPC_DISCONNECT, client_id,
                      NULL, 0, NULL, 0, NULL);
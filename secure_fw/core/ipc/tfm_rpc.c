@@ -27,10 +27,22 @@ static const void *default_get_caller_data(int32_t client_id)
     return NULL;
 }
 
+#ifdef TFM_MULTI_NS_MAILBOX
+static bool default_get_client_id(int32_t *client_id)
+{
+    (void)client_id;
+
+    return false;
+}
+#endif
+
 static struct tfm_rpc_ops_t rpc_ops = {
     .handle_req = default_handle_req,
     .reply      = default_mailbox_reply,
     .get_caller_data = default_get_caller_data,
+#ifdef TFM_MULTI_NS_MAILBOX
+    .get_client_id = default_get_client_id,
+#endif
 };
 
 uint32_t tfm_rpc_psa_framework_version(void)
@@ -62,8 +74,22 @@ psa_status_t tfm_rpc_psa_call(const struct client_call_params_t *params,
     return tfm_psa_call(params->handle, params->type,
                         params->in_vec, params->in_len,
                         params->out_vec, params->out_len, ns_caller,
-                        TFM_PARTITION_UNPRIVILEGED_MODE);
+                        TFM_PARTITION_UNPRIVILEGED_MODE, NULL);
+}
+
+#ifdef TFM_MAILBOX_SG
+psa_status_t tfm_rpc_psa_call_sg(const struct client_call_params_t *params,
+                                 bool ns_caller)
+{
+    TFM_CORE_ASSERT(params != NULL);
+
+    return tfm_psa_call_sg(params->handle, params->type,
+                           params->in_vec, params->in_nr_segs, params->in_len,
+                           params->out_vec, params->out_nr_segs,
+                           params->out_len, params->out_written, ns_caller,
+                           TFM_PARTITION_UNPRIVILEGED_MODE);
 }
+#endif
 
 void tfm_rpc_psa_close(const struct client_call_params_t *params,
                        bool ns_caller)
@@ -83,6 +109,12 @@ int32_t tfm_rpc_register_ops(const struct tfm_rpc_ops_t *ops_ptr)
         return TFM_RPC_INVAL_PARAM;
     }
 
+#ifdef TFM_MULTI_NS_MAILBOX
+    if (!ops_ptr->get_client_id) {
+        return TFM_RPC_INVAL_PARAM;
+    }
+#endif
+
     /* Currently, one and only one mailbox implementation is supported. */
     if ((rpc_ops.handle_req != default_handle_req) ||
         (rpc_ops.reply != default_mailbox_reply) || \
@@ -93,6 +125,9 @@ int32_t tfm_rpc_register_ops(const struct tfm_rpc_ops_t *ops_ptr)
     rpc_ops.handle_req = ops_ptr->handle_req;
     rpc_ops.reply = ops_ptr->reply;
     rpc_ops.get_caller_data = ops_ptr->get_caller_data;
+#ifdef TFM_MULTI_NS_MAILBOX
+    rpc_ops.get_client_id = ops_ptr->get_client_id;
+#endif
 
     return TFM_RPC_SUCCESS;
 }
@@ -102,6 +137,9 @@ void tfm_rpc_unregister_ops(void)
     rpc_ops.handle_req = default_handle_req;
     rpc_ops.reply = default_mailbox_reply;
     rpc_ops.get_caller_data = default_get_caller_data;
+#ifdef TFM_MULTI_NS_MAILBOX
+    rpc_ops.get_client_id = default_get_client_id;
+#endif
 }
 
 void tfm_rpc_client_call_handler(void)
@@ -120,3 +158,12 @@ void tfm_rpc_set_caller_data(struct tfm_msg_body_t *msg, int32_t client_id)
 {
     msg->caller_data = rpc_ops.get_caller_data(client_id);
 }
+
+#ifdef TFM_MULTI_NS_MAILBOX
+bool tfm_rpc_get_client_id(int32_t *client_id)
+{
+    TFM_CORE_ASSERT(client_id != NULL);
+
+    return rpc_ops.get_client_id(client_id);
+}
+#endif
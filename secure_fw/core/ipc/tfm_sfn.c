@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "core/tfm_core_svc.h"
+#include "psa/service.h"
+#include "tfm_api.h"
+#include "tfm_arch.h"
+#include "tfm_ipc_trace.h"
+#include "tfm_sfn.h"
+#include "tfm_utils.h"
+#include "spm_api.h"
+#include "spm_db.h"
+
+/* Stack realignment bit of the stacked xPSR */
+#define TFM_SFN_XPSR_SPREALIGN  (1U << 9)
+
+/*
+ * Entry of a secure function on the thread of the client, with the PSA
+ * message in r0, the secure function in r1 and the initialisation function of
+ * the partition in r2, or 0 if the partition is initialised. The stack is
+ * aligned to 8 bytes for the calls. The functions follow the procedure call
+ * standard, so only the status is left in r0 when the SVC returns to the
+ * client.
+ */
+__attribute__((naked))
+static void tfm_sfn_trampoline(void)
+{
+    __ASM volatile(
+        ".syntax unified               \n"
+        "push    {r4, r5}              \n"
+        "mov     r4, sp                \n"
+        "mov     r5, sp                \n"
+        "lsrs    r5, r5, #3            \n"
+        "lsls    r5, r5, #3            \n"
+        "mov     sp, r5                \n"
+        "cmp     r2, #0                \n"
+        "beq     1f                    \n"
+        "push    {r0, r1}              \n"
+        "blx     r2                    \n"
+        "pop     {r0, r1}              \n"
+        "1:                            \n"
+        "blx     r1                    \n"
+        "mov     sp, r4                \n"
+        "pop     {r4, r5}              \n"
+        "svc     %0                    \n"
+        : : "I" (TFM_SVC_PSA_SFN_RETURN));
+}
+
+TFM_HOT_CODE
+psa_status_t tfm_sfn_call(struct tfm_msg_body_t *msg, uint32_t *ctx)
+{
+    struct tfm_spm_service_t *service = msg->service;
+    struct spm_partition_desc_t *partition = service->partition;
+    struct spm_partition_desc_t *thrd_partition;
+    uint32_t init = 0;
+
+    /*
+     * FixMe: the requests of the NSPE via RPC and the batched or
+     * asynchronous requests have no client context to run the secure
+     * function on.
+     */
+    if (!ctx) {
+        tfm_core_panic();
+    }
+
+    /*
+     * The secure functions of a partition share its data. They are not
+     * entered again while a request is handled, from another thread or from
+     * a request the partition made.
+     */
+    if (partition->runtime_data.sfn_msg) {
+        tfm_spm_free_conn_handle(service, msg->handle);
+        return PSA_ERROR_CONNECTION_BUSY;
+    }
+
+    if (!partition->runtime_data.sfn_init_done) {
+        partition->runtime_data.sfn_init_done = true;
+        init = (uint32_t)partition->static_data->partition_init;
+    }
+
+    ((struct tfm_conn_handle_t *)(msg->handle))->status =
+                                                       TFM_HANDLE_STATUS_ACTIVE;
+    partition->runtime_data.sfn_msg = msg;
+
+    /* From now on, the thread runs on behalf of the SFN partition */
+    thrd_partition = tfm_spm_get_thread_partition();
+    msg->sfn_prev = thrd_partition->runtime_data.sfn_top;
+    thrd_partition->runtime_data.sfn_top = msg;
+
+    msg->sfn_ret_lr = ctx[5];
+    msg->sfn_ret_pc = ctx[6];
+    msg->sfn_ret_xpsr = ctx[7];
+
+    ctx[1] = (uint32_t)service->service_db->sfn;
+    ctx[2] = init;
+    ctx[6] = (uint32_t)tfm_sfn_trampoline & ~1U;
+    ctx[7] = (ctx[7] & TFM_SFN_XPSR_SPREALIGN) | XPSR_T32;
+
+    return (psa_status_t)(uintptr_t)&msg->msg;
+}
+
+TFM_HOT_CODE
+psa_status_t tfm_sfn_return(uint32_t *ctx)
+{
+    struct spm_partition_desc_t *thrd_partition;
+    struct tfm_spm_service_t *service;
+    struct tfm_msg_body_t *msg;
+    psa_status_t status = (psa_status_t)ctx[0];
+    uint32_t i;
+
+    thrd_partition = tfm_spm_get_thread_partition();
+    msg = thrd_partition->runtime_data.sfn_top;
+    if (!msg) {
+        tfm_core_panic();
+    }
+
+    TFM_IPC_TRACE_POINT(TFM_IPC_TRACE_PSA_REPLY, status);
+
+    /*
+     * The SPM must panic a Secure Partition in response to a PROGRAMMER
+     * ERROR. The connection of a NS client is freed below in any case.
+     */
+    if (status == PSA_ERROR_PROGRAMMER_ERROR &&
+        !TFM_CLIENT_ID_IS_NS(msg->msg.client_id)) {
+        tfm_core_panic();
+    }
+
+    service = msg->service;
+    thrd_partition->runtime_data.sfn_top = msg->sfn_prev;
+    service->partition->runtime_data.sfn_msg = NULL;
+
+    /* Report the number of bytes written to each output vector */
+    for (i = 0; i < PSA_MAX_IOVEC; i++) {
+        if (msg->msg.out_size[i] != 0) {
+            msg->caller_outvec[i].len = msg->outvec[i].len;
+        }
+    }
+
+    /* Return to the client of the request, as from the psa_call() SVC */
+    ctx[1] = 0;
+    ctx[2] = 0;
+    ctx[3] = 0;
+    ctx[4] = 0;
+    ctx[5] = msg->sfn_ret_lr;
+    ctx[6] = msg->sfn_ret_pc;
+    ctx[7] = (msg->sfn_ret_xpsr & ~TFM_SFN_XPSR_SPREALIGN) |
+             (ctx[7] & TFM_SFN_XPSR_SPREALIGN);
+
+    /* The connection of a call to a stateless RoT Service is not used anymore */
+    tfm_spm_free_conn_handle(service, msg->handle);
+
+    return status;
+}
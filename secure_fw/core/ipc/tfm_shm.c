@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include "psa_manifest/sid.h"
+#include "spm_api.h"
+#include "spm_db.h"
+#include "tfm_shm.h"
+
+uint32_t tfm_shm_get_handler(uint32_t *args)
+{
+    uint32_t shm_id = args[0];
+    int32_t partition_id;
+    const struct tfm_spm_shm_t *shm;
+
+    if (shm_id >= TFM_SHM_NUM) {
+        return 0;
+    }
+
+    shm = &shm_list[shm_id];
+    if (shm->base == NULL) {
+        return 0;
+    }
+
+    partition_id = (int32_t)tfm_spm_partition_get_running_partition_id();
+    if (partition_id != shm->producer_id && partition_id != shm->consumer_id) {
+        return 0;
+    }
+
+    return (uint32_t)shm->base;
+}
@@ -11,10 +11,23 @@
 #include "tfm_core_utils.h"
 #include "tfm_utils.h"
 #include "tfm_spe_mailbox.h"
+#ifdef TFM_MAILBOX_RING
+#include "tfm_mailbox_ring.h"
+#endif
 #include "tfm_rpc.h"
+#if defined(TFM_MAILBOX_SG) || defined(TFM_MAILBOX_NS_WINDOWS)
+#include "spm_api.h"
+#endif
+#ifdef TFM_MAILBOX_SG
+#include "tfm_internal_defines.h"
+#endif
+#ifdef TFM_MAILBOX_POLL
+#include "tfm_arch.h"
+#endif
 
 #define NS_CALLER_FLAG          (true)
 
+TFM_HOT_DATA
 static struct secure_mailbox_queue_t spe_mailbox_queue;
 
 static int32_t tfm_mailbox_dispatch(uint32_t call_type,
@@ -22,6 +35,12 @@ static int32_t tfm_mailbox_dispatch(uint32_t call_type,
                                     int32_t client_id, uint32_t *psa_ret)
 {
     struct client_call_params_t spm_params = {0};
+#ifdef TFM_MAILBOX_SG
+    const struct mailbox_sg_table_t *sg_table;
+#endif
+#ifdef TFM_MAILBOX_NS_WINDOWS
+    enum tfm_memory_access_e access;
+#endif
 
     TFM_CORE_ASSERT(params != NULL);
     TFM_CORE_ASSERT(psa_ret != NULL);
@@ -54,28 +73,85 @@ static int32_t tfm_mailbox_dispatch(uint32_t call_type,
         spm_params.handle = params->psa_close_params.handle;
         tfm_rpc_psa_close(&spm_params, NS_CALLER_FLAG);
         return MAILBOX_SUCCESS;
+#ifdef TFM_MAILBOX_SG
+    case MAILBOX_PSA_CALL_SG:
+        /* The table has been copied into the SPE slot */
+        sg_table = params->psa_call_sg_params.sg_table;
+        spm_params.handle = params->psa_call_sg_params.handle;
+        spm_params.type = params->psa_call_sg_params.type;
+        spm_params.in_vec = sg_table->in_segs;
+        spm_params.in_len = sg_table->in_len;
+        spm_params.in_nr_segs = sg_table->in_nr_segs;
+        spm_params.out_vec = (psa_outvec *)sg_table->out_segs;
+        spm_params.out_len = sg_table->out_len;
+        spm_params.out_nr_segs = sg_table->out_nr_segs;
+        spm_params.out_written = params->psa_call_sg_params.out_written;
+        *psa_ret = (uint32_t)tfm_rpc_psa_call_sg(&spm_params, NS_CALLER_FLAG);
+        return MAILBOX_SUCCESS;
+#endif
+#ifdef TFM_MAILBOX_NS_WINDOWS
+    case MAILBOX_NS_WINDOW_REGISTER:
+        switch (params->ns_window_register_params.access) {
+        case MAILBOX_NS_WINDOW_RO:
+            access = TFM_MEMORY_ACCESS_RO;
+            break;
+        case MAILBOX_NS_WINDOW_RW:
+            access = TFM_MEMORY_ACCESS_RW;
+            break;
+        default:
+            *psa_ret = (uint32_t)PSA_ERROR_INVALID_ARGUMENT;
+            return MAILBOX_SUCCESS;
+        }
+        *psa_ret = (uint32_t)tfm_spm_ns_window_register(
+                                    params->ns_window_register_params.base,
+                                    params->ns_window_register_params.len,
+                                    access);
+        return MAILBOX_SUCCESS;
+    case MAILBOX_NS_WINDOW_UNREGISTER:
+        *psa_ret = (uint32_t)tfm_spm_ns_window_unregister(
+                            params->ns_window_unregister_params.window_id);
+        return MAILBOX_SUCCESS;
+#endif
     default:
         return MAILBOX_INVAL_PARAMS;
     }
 }
 
+#ifdef TFM_MAILBOX_CACHE_MAINT
+void mailbox_cache_clean(const volatile void *addr, size_t size)
+{
+    uintptr_t start = MAILBOX_CACHE_LINE_DOWN(addr);
+
+    tfm_mailbox_hal_cache_clean((void *)start,
+                        MAILBOX_CACHE_LINE_UP((uintptr_t)addr + size) - start);
+}
+
+void mailbox_cache_invalidate(const volatile void *addr, size_t size)
+{
+    uintptr_t start = MAILBOX_CACHE_LINE_DOWN(addr);
+
+    tfm_mailbox_hal_cache_invalidate((void *)start,
+                        MAILBOX_CACHE_LINE_UP((uintptr_t)addr + size) - start);
+}
+#endif
+
 __STATIC_INLINE void set_spe_queue_empty_status(uint8_t idx)
 {
-    if (idx < NUM_MAILBOX_QUEUE_SLOT) {
+    if (idx < NUM_SPE_MAILBOX_QUEUE_SLOT) {
         spe_mailbox_queue.empty_slots |= (1 << idx);
     }
 }
 
 __STATIC_INLINE void clear_spe_queue_empty_status(uint8_t idx)
 {
-    if (idx < NUM_MAILBOX_QUEUE_SLOT) {
+    if (idx < NUM_SPE_MAILBOX_QUEUE_SLOT) {
         spe_mailbox_queue.empty_slots &= ~(1 << idx);
     }
 }
 
 __STATIC_INLINE bool get_spe_queue_empty_status(uint8_t idx)
 {
-    if ((idx < NUM_MAILBOX_QUEUE_SLOT) &&
+    if ((idx < NUM_SPE_MAILBOX_QUEUE_SLOT) &&
         (spe_mailbox_queue.empty_slots & (1 << idx))) {
         return true;
     }
@@ -83,9 +159,25 @@ __STATIC_INLINE bool get_spe_queue_empty_status(uint8_t idx)
     return false;
 }
 
+/* Return the index of an empty SPE slot, or NUM_SPE_MAILBOX_QUEUE_SLOT */
+__STATIC_INLINE uint8_t get_spe_queue_empty_slot(void)
+{
+    uint8_t idx;
+
+    for (idx = 0; idx < NUM_SPE_MAILBOX_QUEUE_SLOT; idx++) {
+        if (spe_mailbox_queue.empty_slots & (1 << idx)) {
+            break;
+        }
+    }
+
+    return idx;
+}
+
 __STATIC_INLINE mailbox_queue_status_t get_nspe_queue_pend_status(
                                     const struct ns_mailbox_queue_t *ns_queue)
 {
+    mailbox_cache_invalidate(&ns_queue->pend_slots,
+                             sizeof(ns_queue->pend_slots));
     return ns_queue->pend_slots;
 }
 
@@ -93,20 +185,27 @@ __STATIC_INLINE void set_nspe_queue_replied_status(
                                             struct ns_mailbox_queue_t *ns_queue,
                                             mailbox_queue_status_t mask)
 {
+    mailbox_cache_invalidate(&ns_queue->replied_slots,
+                             sizeof(ns_queue->replied_slots));
     ns_queue->replied_slots |= mask;
+    mailbox_cache_clean(&ns_queue->replied_slots,
+                        sizeof(ns_queue->replied_slots));
 }
 
 __STATIC_INLINE void clear_nspe_queue_pend_status(
                                             struct ns_mailbox_queue_t *ns_queue,
                                             mailbox_queue_status_t mask)
 {
+    mailbox_cache_invalidate(&ns_queue->pend_slots,
+                             sizeof(ns_queue->pend_slots));
     ns_queue->pend_slots &= ~mask;
+    mailbox_cache_clean(&ns_queue->pend_slots, sizeof(ns_queue->pend_slots));
 }
 
 __STATIC_INLINE int32_t get_spe_mailbox_msg_handle(uint8_t idx,
                                                    mailbox_msg_handle_t *handle)
 {
-    if ((idx >= NUM_MAILBOX_QUEUE_SLOT) || !handle) {
+    if ((idx >= NUM_SPE_MAILBOX_QUEUE_SLOT) || !handle) {
         return MAILBOX_INVAL_PARAMS;
     }
 
@@ -129,7 +228,7 @@ __STATIC_INLINE int32_t get_spe_mailbox_msg_idx(mailbox_msg_handle_t handle,
 
 static void mailbox_clean_queue_slot(uint8_t idx)
 {
-    if (idx >= NUM_MAILBOX_QUEUE_SLOT) {
+    if (idx >= NUM_SPE_MAILBOX_QUEUE_SLOT) {
         return;
     }
 
@@ -140,27 +239,40 @@ static void mailbox_clean_queue_slot(uint8_t idx)
 
 __STATIC_INLINE struct mailbox_reply_t *get_nspe_reply_addr(uint8_t idx)
 {
-    uint8_t ns_slot_idx;
+    uint8_t ns_src_idx, ns_slot_idx;
 
-    if (idx >= NUM_MAILBOX_QUEUE_SLOT) {
+    if (idx >= NUM_SPE_MAILBOX_QUEUE_SLOT) {
         return NULL;
     }
 
+    ns_src_idx = spe_mailbox_queue.queue[idx].ns_src_idx;
     ns_slot_idx = spe_mailbox_queue.queue[idx].ns_slot_idx;
 
-    return &spe_mailbox_queue.ns_queue->queue[ns_slot_idx].reply;
+    return &spe_mailbox_queue.ns_srcs[ns_src_idx].ns_queue->
+                                                    queue[ns_slot_idx].reply;
 }
 
 static void mailbox_direct_reply(uint8_t idx, uint32_t result)
 {
     struct mailbox_reply_t *reply_ptr;
     uint32_t ret_result = result;
+#ifdef TFM_MAILBOX_STATS
+    uint32_t dispatch_time;
+#endif
 
     /* Get reply address */
     reply_ptr = get_nspe_reply_addr(idx);
     tfm_core_util_memcpy(&reply_ptr->return_val, &ret_result,
                          sizeof(reply_ptr->return_val));
 
+#ifdef TFM_MAILBOX_STATS
+    dispatch_time = tfm_mailbox_hal_get_timestamp() -
+                    spe_mailbox_queue.queue[idx].start_time;
+    tfm_core_util_memcpy(&reply_ptr->dispatch_time, &dispatch_time,
+                         sizeof(reply_ptr->dispatch_time));
+#endif
+    mailbox_cache_clean(reply_ptr, sizeof(*reply_ptr));
+
     mailbox_clean_queue_slot(idx);
 
     /*
@@ -169,6 +281,104 @@ static void mailbox_direct_reply(uint8_t idx, uint32_t result)
      */
 }
 
+/*
+ * Copy a mailbox message from non-secure memory. Only the parameters of the
+ * call type are copied, the remaining parameters of the cleaned SPE slot stay
+ * zero.
+ */
+static int32_t mailbox_copy_msg(struct mailbox_msg_t *msg,
+                                const struct mailbox_msg_t *ns_msg)
+{
+    size_t params_size;
+
+    msg->call_type = ns_msg->call_type;
+    msg->client_id = ns_msg->client_id;
+
+    switch (msg->call_type) {
+    case MAILBOX_PSA_FRAMEWORK_VERSION:
+        return MAILBOX_SUCCESS;
+    case MAILBOX_PSA_VERSION:
+        params_size = sizeof(msg->params.psa_version_params);
+        break;
+    case MAILBOX_PSA_CONNECT:
+        params_size = sizeof(msg->params.psa_connect_params);
+        break;
+    case MAILBOX_PSA_CALL:
+        params_size = sizeof(msg->params.psa_call_params);
+        break;
+    case MAILBOX_PSA_CLOSE:
+        params_size = sizeof(msg->params.psa_close_params);
+        break;
+#ifdef TFM_MAILBOX_SG
+    case MAILBOX_PSA_CALL_SG:
+        params_size = sizeof(msg->params.psa_call_sg_params);
+        break;
+#endif
+#ifdef TFM_MAILBOX_NS_WINDOWS
+    case MAILBOX_NS_WINDOW_REGISTER:
+        params_size = sizeof(msg->params.ns_window_register_params);
+        break;
+    case MAILBOX_NS_WINDOW_UNREGISTER:
+        params_size = sizeof(msg->params.ns_window_unregister_params);
+        break;
+#endif
+    default:
+        return MAILBOX_INVAL_PARAMS;
+    }
+
+    tfm_core_util_memcpy(&msg->params, &ns_msg->params, params_size);
+
+    return MAILBOX_SUCCESS;
+}
+
+#ifdef TFM_MAILBOX_SG
+/*
+ * Copy the scatter-gather descriptor table of the request in SPE slot idx from
+ * non-secure memory, and point the request to the copy. The segments
+ * themselves are checked by SPM.
+ */
+static int32_t mailbox_copy_sg_table(uint8_t idx)
+{
+    struct secure_mailbox_slot_t *slot = &spe_mailbox_queue.queue[idx];
+    const struct mailbox_sg_table_t *ns_table;
+    struct mailbox_sg_table_t *table = &slot->sg_table;
+    size_t nr_in = 0, nr_out = 0;
+    size_t i;
+
+    ns_table = slot->msg.params.psa_call_sg_params.sg_table;
+    if (tfm_memory_check(ns_table, sizeof(*ns_table), NS_CALLER_FLAG,
+                         TFM_MEMORY_ACCESS_RO,
+                         TFM_PARTITION_UNPRIVILEGED_MODE) != IPC_SUCCESS) {
+        return MAILBOX_INVAL_PARAMS;
+    }
+
+    tfm_core_util_memcpy(table, ns_table, sizeof(*table));
+
+    if ((table->in_len > PSA_MAX_IOVEC) ||
+        (table->out_len > PSA_MAX_IOVEC - table->in_len)) {
+        return MAILBOX_INVAL_PARAMS;
+    }
+
+    for (i = 0; i < table->in_len; i++) {
+        if (table->in_nr_segs[i] > MAILBOX_SG_MAX_SEGS - nr_in) {
+            return MAILBOX_INVAL_PARAMS;
+        }
+        nr_in += table->in_nr_segs[i];
+    }
+
+    for (i = 0; i < table->out_len; i++) {
+        if (table->out_nr_segs[i] > MAILBOX_SG_MAX_SEGS - nr_out) {
+            return MAILBOX_INVAL_PARAMS;
+        }
+        nr_out += table->out_nr_segs[i];
+    }
+
+    slot->msg.params.psa_call_sg_params.sg_table = table;
+
+    return MAILBOX_SUCCESS;
+}
+#endif
+
 __STATIC_INLINE int32_t check_mailbox_msg(const struct mailbox_msg_t *msg)
 {
     /*
@@ -179,125 +389,335 @@ __STATIC_INLINE int32_t check_mailbox_msg(const struct mailbox_msg_t *msg)
     return MAILBOX_SUCCESS;
 }
 
-int32_t tfm_mailbox_handle_msg(void)
+__STATIC_INLINE void mailbox_notify_peer(uint8_t src_idx)
+{
+#ifdef TFM_MULTI_NS_MAILBOX
+    tfm_mailbox_hal_notify_ns_peer(src_idx);
+#else
+    (void)src_idx;
+    tfm_mailbox_hal_notify_peer();
+#endif
+}
+
+/*
+ * Notify the NS core of NSPE queue src_idx of nr_replies new replies, unless
+ * they can be held back
+ */
+static void mailbox_notify_replies(uint8_t src_idx, uint32_t nr_replies)
+{
+#ifdef TFM_MAILBOX_COALESCE
+    struct secure_mailbox_ns_src_t *src = &spe_mailbox_queue.ns_srcs[src_idx];
+
+    spe_mailbox_queue.stats.nr_replies += nr_replies;
+    src->nr_deferred_replies += nr_replies;
+    if (src->nr_deferred_replies < MAILBOX_REPLY_BATCH) {
+        return;
+    }
+
+    src->nr_deferred_replies = 0;
+    spe_mailbox_queue.stats.nr_notify++;
+#else
+    (void)nr_replies;
+#endif
+
+    mailbox_notify_peer(src_idx);
+}
+
+/*
+ * Take the request of slot ns_idx of NSPE queue src_idx into the empty SPE
+ * slot idx and deliver it to SPM. Return true if the request has already been
+ * replied.
+ */
+static bool mailbox_take_ns_req(uint8_t idx, uint8_t src_idx, uint8_t ns_idx)
 {
-    uint8_t idx;
     int32_t result;
     uint32_t psa_ret = PSA_ERROR_GENERIC_ERROR;
-    mailbox_queue_status_t mask_bits, pend_slots, reply_slots = 0;
-    struct ns_mailbox_queue_t *ns_queue = spe_mailbox_queue.ns_queue;
+    struct ns_mailbox_queue_t *ns_queue =
+                                    spe_mailbox_queue.ns_srcs[src_idx].ns_queue;
     struct mailbox_msg_t *msg_ptr;
 
-    TFM_CORE_ASSERT(ns_queue != NULL);
+    clear_spe_queue_empty_status(idx);
+    spe_mailbox_queue.queue[idx].ns_src_idx = src_idx;
+    spe_mailbox_queue.queue[idx].ns_slot_idx = ns_idx;
+#ifdef TFM_MAILBOX_STATS
+    spe_mailbox_queue.queue[idx].start_time = tfm_mailbox_hal_get_timestamp();
+#endif
+
+    msg_ptr = &spe_mailbox_queue.queue[idx].msg;
+    mailbox_cache_invalidate(&ns_queue->queue[ns_idx].msg,
+                             sizeof(ns_queue->queue[ns_idx].msg));
+    if (mailbox_copy_msg(msg_ptr, &ns_queue->queue[ns_idx].msg) !=
+        MAILBOX_SUCCESS) {
+        mailbox_clean_queue_slot(idx);
+        return false;
+    }
 
-    tfm_mailbox_hal_enter_critical();
+#ifdef TFM_MAILBOX_INLINE_REPLY
+    /*
+     * The output vectors of an inline PSA call are set by NSPE in the reply.
+     * SPM reads them there, and RoT Service writes the payload next to them.
+     */
+    if (msg_ptr->call_type == MAILBOX_PSA_CALL) {
+        mailbox_cache_invalidate(&ns_queue->queue[ns_idx].reply,
+                                 sizeof(ns_queue->queue[ns_idx].reply));
+    }
+#endif
 
-    /* Check if NSPE mailbox did assert a PSA client call request */
-    if (!ns_queue->pend_slots) {
-        tfm_mailbox_hal_exit_critical();
-        return MAILBOX_NO_PEND_EVENT;
+#ifdef TFM_MAILBOX_SG
+    if ((msg_ptr->call_type == MAILBOX_PSA_CALL_SG) &&
+        (mailbox_copy_sg_table(idx) != MAILBOX_SUCCESS)) {
+        mailbox_clean_queue_slot(idx);
+        return false;
     }
+#endif
 
-    pend_slots = get_nspe_queue_pend_status(ns_queue);
+    if (check_mailbox_msg(msg_ptr) != MAILBOX_SUCCESS) {
+        mailbox_clean_queue_slot(idx);
+        return false;
+    }
 
-    tfm_mailbox_hal_exit_critical();
+    get_spe_mailbox_msg_handle(idx, &spe_mailbox_queue.queue[idx].msg_handle);
 
-    for (idx = 0; idx < NUM_MAILBOX_QUEUE_SLOT; idx++) {
-        mask_bits = (1 << idx);
-        /* Check if current NSPE mailbox queue slot is pending for handling */
-        if (!(pend_slots & mask_bits)) {
-            continue;
-        }
+    /*
+     * Set the current slot index under processing.
+     * The value is used in mailbox_get_caller_data() to identify the
+     * mailbox queue slot.
+     */
+    spe_mailbox_queue.cur_proc_slot_idx = idx;
+
+    result = tfm_mailbox_dispatch(msg_ptr->call_type, &msg_ptr->params,
+                                  msg_ptr->client_id, &psa_ret);
+    if (result != MAILBOX_SUCCESS) {
+        mailbox_clean_queue_slot(idx);
+        return false;
+    }
 
+    /* Clean up the current slot index under processing */
+    spe_mailbox_queue.cur_proc_slot_idx = NUM_SPE_MAILBOX_QUEUE_SLOT;
+
+    if ((msg_ptr->call_type == MAILBOX_PSA_FRAMEWORK_VERSION) ||
+#ifdef TFM_MAILBOX_NS_WINDOWS
+        (msg_ptr->call_type == MAILBOX_NS_WINDOW_REGISTER) ||
+        (msg_ptr->call_type == MAILBOX_NS_WINDOW_UNREGISTER) ||
+#endif
+        (msg_ptr->call_type == MAILBOX_PSA_VERSION)) {
+        /*
+         * Directly write the result to NSPE for psa_framework_version(),
+         * psa_version() and the shared memory window requests.
+         */
+        mailbox_direct_reply(idx, psa_ret);
+        return true;
+    } else if ((msg_ptr->call_type == MAILBOX_PSA_CONNECT) ||
+#ifdef TFM_MAILBOX_SG
+               (msg_ptr->call_type == MAILBOX_PSA_CALL_SG) ||
+#endif
+               (msg_ptr->call_type == MAILBOX_PSA_CALL)) {
         /*
-         * TODO
-         * The operations are simplified here. Use the SPE mailbox queue
-         * slot with the same idx as that of the NSPE mailbox queue slot.
-         * A more general implementation should dynamically search and
-         * select an empty SPE mailbox queue slot.
+         * If it failed to deliver psa_connect() or psa_call() request to
+         * TF-M IPC SPM, the failure result should be returned immediately.
          */
-        clear_spe_queue_empty_status(idx);
-        spe_mailbox_queue.queue[idx].ns_slot_idx = idx;
+        if (psa_ret != PSA_SUCCESS) {
+            mailbox_direct_reply(idx, psa_ret);
+            return true;
+        }
+    }
+    /*
+     * Skip checking psa_call() since it neither returns immediately nor
+     * has return value.
+     */
 
-        msg_ptr = &spe_mailbox_queue.queue[idx].msg;
-        tfm_core_util_memcpy(msg_ptr, &ns_queue->queue[idx].msg,
-                             sizeof(*msg_ptr));
+    return false;
+}
 
-        if (check_mailbox_msg(msg_ptr) != MAILBOX_SUCCESS) {
-            mailbox_clean_queue_slot(idx);
+#ifdef TFM_MAILBOX_RING
+/*
+ * Take up to max_reqs requests of NSPE queue src_idx into SPE slots and return
+ * the number of requests taken.
+ *
+ * SPE is the only consumer of the request ring and the only producer of the
+ * reply ring. Both tfm_mailbox_handle_msg() and tfm_mailbox_reply_msg() run
+ * in handler mode at a priority which cannot preempt each other, so no
+ * critical section is required.
+ */
+static uint32_t mailbox_handle_src_msg(uint8_t src_idx, uint32_t max_reqs)
+{
+    uint8_t idx, ns_idx;
+    uint32_t nr_taken = 0, nr_replied = 0;
+    struct ns_mailbox_queue_t *ns_queue =
+                                    spe_mailbox_queue.ns_srcs[src_idx].ns_queue;
+
+    while ((nr_taken < max_reqs) &&
+           mailbox_ring_peek(&ns_queue->req_ring, &ns_idx)) {
+        /* The entry is written by NSPE. Drop an invalid one. */
+        if (ns_idx >= NUM_MAILBOX_QUEUE_SLOT) {
+            mailbox_ring_pop(&ns_queue->req_ring);
             continue;
         }
 
-        get_spe_mailbox_msg_handle(idx,
-                                   &spe_mailbox_queue.queue[idx].msg_handle);
-
         /*
-         * Set the current slot index under processing.
-         * The value is used in mailbox_get_caller_data() to identify the
-         * mailbox queue slot.
+         * Leave the request in the ring until an SPE slot is freed by a
+         * reply.
          */
-        spe_mailbox_queue.cur_proc_slot_idx = idx;
+        idx = get_spe_queue_empty_slot();
+        if (idx >= NUM_SPE_MAILBOX_QUEUE_SLOT) {
+            spe_mailbox_queue.ns_backlog = true;
+            break;
+        }
 
-        result = tfm_mailbox_dispatch(msg_ptr->call_type, &msg_ptr->params,
-                                      msg_ptr->client_id, &psa_ret);
-        if (result != MAILBOX_SUCCESS) {
-            mailbox_clean_queue_slot(idx);
-            continue;
+        mailbox_ring_pop(&ns_queue->req_ring);
+        nr_taken++;
+#ifdef TFM_MAILBOX_COALESCE
+        spe_mailbox_queue.stats.nr_msgs++;
+#endif
+
+        if (mailbox_take_ns_req(idx, src_idx, ns_idx)) {
+            /* The reply ring has room for every NSPE slot */
+            (void)mailbox_ring_push(&ns_queue->reply_ring, ns_idx);
+            nr_replied++;
         }
+    }
 
-        /* Clean up the current slot index under processing */
-        spe_mailbox_queue.cur_proc_slot_idx = NUM_MAILBOX_QUEUE_SLOT;
+    if (nr_replied) {
+        mailbox_notify_replies(src_idx, nr_replied);
+    }
 
-        if ((msg_ptr->call_type == MAILBOX_PSA_FRAMEWORK_VERSION) ||
-            (msg_ptr->call_type == MAILBOX_PSA_VERSION)) {
-            /*
-             * Directly write the result to NSPE for psa_framework_version() and
-             * psa_version().
-             */
-            reply_slots |= (1 << idx);
+    return nr_taken;
+}
+#else /* TFM_MAILBOX_RING */
+/*
+ * Take up to max_reqs requests of NSPE queue src_idx into SPE slots and return
+ * the number of requests taken.
+ */
+static uint32_t mailbox_handle_src_msg(uint8_t src_idx, uint32_t max_reqs)
+{
+    uint8_t idx, ns_idx, i;
+    uint32_t nr_taken = 0, nr_replied = 0;
+    mailbox_queue_status_t mask_bits, pend_slots, taken_slots = 0;
+    mailbox_queue_status_t reply_slots = 0;
+    struct secure_mailbox_ns_src_t *src = &spe_mailbox_queue.ns_srcs[src_idx];
+    struct ns_mailbox_queue_t *ns_queue = src->ns_queue;
 
-            mailbox_direct_reply(idx, psa_ret);
-        } else if ((msg_ptr->call_type == MAILBOX_PSA_CONNECT) ||
-                   (msg_ptr->call_type == MAILBOX_PSA_CALL)) {
-            /*
-             * If it failed to deliver psa_connect() or psa_call() request to
-             * TF-M IPC SPM, the failure result should be returned immediately.
-             */
-            if (psa_ret != PSA_SUCCESS) {
-                reply_slots |= (1 << idx);
-                mailbox_direct_reply(idx, psa_ret);
-            }
+    tfm_mailbox_hal_enter_critical();
+
+    /* Check if NSPE mailbox did assert a PSA client call request */
+    pend_slots = get_nspe_queue_pend_status(ns_queue);
+
+    tfm_mailbox_hal_exit_critical();
+
+    if (!pend_slots) {
+        return 0;
+    }
+
+    /*
+     * Start after the last NSPE slot taken, so that the NSPE slots share the
+     * SPE slots fairly when the SPE mailbox queue is full.
+     */
+    for (i = 0; (i < NUM_MAILBOX_QUEUE_SLOT) && (nr_taken < max_reqs); i++) {
+        ns_idx = (src->ns_next_idx + i) % NUM_MAILBOX_QUEUE_SLOT;
+        mask_bits = (1 << ns_idx);
+        /* Check if current NSPE mailbox queue slot is pending for handling */
+        if (!(pend_slots & mask_bits)) {
+            continue;
         }
+
         /*
-         * Skip checking psa_call() since it neither returns immediately nor
-         * has return value.
+         * Leave the request pending in the NSPE mailbox queue until an SPE
+         * slot is freed by a reply.
          */
+        idx = get_spe_queue_empty_slot();
+        if (idx >= NUM_SPE_MAILBOX_QUEUE_SLOT) {
+            spe_mailbox_queue.ns_backlog = true;
+            break;
+        }
+
+        taken_slots |= mask_bits;
+        nr_taken++;
+#ifdef TFM_MAILBOX_COALESCE
+        spe_mailbox_queue.stats.nr_msgs++;
+#endif
+
+        if (mailbox_take_ns_req(idx, src_idx, ns_idx)) {
+            reply_slots |= mask_bits;
+            nr_replied++;
+        }
     }
 
+    /* The scan goes on from the slot after the last one checked */
+    src->ns_next_idx = (src->ns_next_idx + i) % NUM_MAILBOX_QUEUE_SLOT;
+
     tfm_mailbox_hal_enter_critical();
 
-    /* Clean the NSPE mailbox pending status. */
-    clear_nspe_queue_pend_status(ns_queue, pend_slots);
+    /* Clean the pending status of the NSPE requests taken into SPE slots. */
+    clear_nspe_queue_pend_status(ns_queue, taken_slots);
 
     /* Set the NSPE mailbox replied status */
     set_nspe_queue_replied_status(ns_queue, reply_slots);
 
     tfm_mailbox_hal_exit_critical();
 
-    if (reply_slots) {
-        tfm_mailbox_hal_notify_peer();
+    if (nr_replied) {
+        mailbox_notify_replies(src_idx, nr_replied);
+    }
+
+    return nr_taken;
+}
+#endif /* TFM_MAILBOX_RING */
+
+/*
+ * Serve the registered NSPE queues in weighted round-robin order. Each round
+ * takes up to the weight of every queue in turn, starting after the last
+ * queue served, so that a busy NS core cannot starve the others of SPE slots.
+ * The rounds go on until the queues are drained or the SPE slots run out, but
+ * no more requests are taken than there are NSPE slots in total.
+ */
+int32_t tfm_mailbox_handle_msg(void)
+{
+    uint8_t src_idx, i;
+    uint32_t nr_taken, nr_round, nr_total = 0;
+    struct secure_mailbox_ns_src_t *src;
+
+    spe_mailbox_queue.ns_backlog = false;
+
+    do {
+        nr_round = 0;
+
+        for (i = 0; (i < NUM_NS_MAILBOX_QUEUE) &&
+                    !spe_mailbox_queue.ns_backlog; i++) {
+            src_idx = (spe_mailbox_queue.next_src_idx + i) %
+                      NUM_NS_MAILBOX_QUEUE;
+            src = &spe_mailbox_queue.ns_srcs[src_idx];
+            if (!src->ns_queue) {
+                continue;
+            }
+
+            nr_taken = mailbox_handle_src_msg(src_idx, src->weight);
+            if (nr_taken) {
+                spe_mailbox_queue.next_src_idx = (src_idx + 1) %
+                                                 NUM_NS_MAILBOX_QUEUE;
+                nr_round += nr_taken;
+            }
+        }
+
+        nr_total += nr_round;
+    } while (nr_round && !spe_mailbox_queue.ns_backlog &&
+             (nr_total < NUM_NS_MAILBOX_QUEUE * NUM_MAILBOX_QUEUE_SLOT));
+
+    if (!nr_total && !spe_mailbox_queue.ns_backlog) {
+        return MAILBOX_NO_PEND_EVENT;
     }
 
+#ifdef TFM_MAILBOX_COALESCE
+    spe_mailbox_queue.stats.nr_handle_msg++;
+#endif
+
     return MAILBOX_SUCCESS;
 }
 
 int32_t tfm_mailbox_reply_msg(mailbox_msg_handle_t handle, int32_t reply)
 {
-    uint8_t idx;
+    uint8_t idx, src_idx, ns_idx;
     int32_t ret;
-    struct ns_mailbox_queue_t *ns_queue = spe_mailbox_queue.ns_queue;
-
-    TFM_CORE_ASSERT(ns_queue != NULL);
+    struct ns_mailbox_queue_t *ns_queue;
 
     /*
      * If handle == MAILBOX_MSG_NULL_HANDLE, reply to the mailbox message
@@ -314,24 +734,183 @@ int32_t tfm_mailbox_reply_msg(mailbox_msg_handle_t handle, int32_t reply)
         }
     }
 
-    if (get_spe_queue_empty_status(idx)) {
+    if ((idx >= NUM_SPE_MAILBOX_QUEUE_SLOT) ||
+        get_spe_queue_empty_status(idx)) {
         return MAILBOX_NO_PEND_EVENT;
     }
 
+    /* The SPE slot is cleaned by the reply */
+    src_idx = spe_mailbox_queue.queue[idx].ns_src_idx;
+    ns_idx = spe_mailbox_queue.queue[idx].ns_slot_idx;
+    ns_queue = spe_mailbox_queue.ns_srcs[src_idx].ns_queue;
+
     mailbox_direct_reply(idx, (uint32_t)reply);
 
+#ifdef TFM_MAILBOX_RING
+    (void)mailbox_ring_push(&ns_queue->reply_ring, ns_idx);
+#else
     tfm_mailbox_hal_enter_critical();
 
     /* Set the NSPE mailbox replied status */
-    set_nspe_queue_replied_status(ns_queue, (1 << idx));
+    set_nspe_queue_replied_status(ns_queue, (1 << ns_idx));
 
     tfm_mailbox_hal_exit_critical();
+#endif
 
-    tfm_mailbox_hal_notify_peer();
+    mailbox_notify_replies(src_idx, 1);
 
     return MAILBOX_SUCCESS;
 }
 
+#ifdef TFM_MAILBOX_COALESCE
+void tfm_mailbox_flush_reply(void)
+{
+    uint8_t src_idx;
+    struct secure_mailbox_ns_src_t *src;
+
+    for (src_idx = 0; src_idx < NUM_NS_MAILBOX_QUEUE; src_idx++) {
+        src = &spe_mailbox_queue.ns_srcs[src_idx];
+        if (!src->nr_deferred_replies) {
+            continue;
+        }
+
+        src->nr_deferred_replies = 0;
+        spe_mailbox_queue.stats.nr_notify++;
+        spe_mailbox_queue.stats.nr_idle_notify++;
+
+        mailbox_notify_peer(src_idx);
+    }
+}
+
+void tfm_mailbox_get_coalesce_stats(struct spe_mailbox_coalesce_stats_t *stats)
+{
+    TFM_CORE_ASSERT(stats != NULL);
+
+    *stats = spe_mailbox_queue.stats;
+}
+#endif
+
+#ifdef TFM_MAILBOX_POLL
+/* Return true if a registered NSPE queue holds requests SPE can take now */
+static bool mailbox_has_ns_req(void)
+{
+    uint8_t src_idx;
+    struct ns_mailbox_queue_t *ns_queue;
+#ifdef TFM_MAILBOX_RING
+    uint8_t ns_idx;
+#endif
+
+    /* Requests left for lack of an SPE slot are taken by the next reply */
+    if (spe_mailbox_queue.ns_backlog) {
+        return false;
+    }
+
+    for (src_idx = 0; src_idx < NUM_NS_MAILBOX_QUEUE; src_idx++) {
+        ns_queue = spe_mailbox_queue.ns_srcs[src_idx].ns_queue;
+        if (!ns_queue) {
+            continue;
+        }
+
+#ifdef TFM_MAILBOX_RING
+        if (mailbox_ring_peek(&ns_queue->req_ring, &ns_idx)) {
+            return true;
+        }
+#else
+        if (get_nspe_queue_pend_status(ns_queue)) {
+            return true;
+        }
+#endif
+    }
+
+    return false;
+}
+
+static void mailbox_set_polling(uint32_t polling)
+{
+    uint8_t src_idx;
+    struct ns_mailbox_queue_t *ns_queue;
+
+    for (src_idx = 0; src_idx < NUM_NS_MAILBOX_QUEUE; src_idx++) {
+        ns_queue = spe_mailbox_queue.ns_srcs[src_idx].ns_queue;
+        if (ns_queue) {
+            ns_queue->spe_polling = polling;
+            mailbox_cache_clean(&ns_queue->spe_polling,
+                                sizeof(ns_queue->spe_polling));
+        }
+    }
+}
+
+/*
+ * Let NSPE ring the doorbell again. The barrier orders the flag before the
+ * next check of the queues. It pairs with the one in NSPE between a new
+ * pending request and the read of the flag, so that either NSPE rings the
+ * doorbell or the next check finds the request.
+ */
+static void mailbox_stop_polling(void)
+{
+    mailbox_set_polling(0);
+    __DMB();
+}
+
+/* Take the requests in PendSV, as for a doorbell */
+static void mailbox_poll_take_req(void)
+{
+    tfm_arch_trigger_pendsv();
+    /* PendSV preempts this thread before the next instruction */
+    __DSB();
+    __ISB();
+}
+
+void tfm_mailbox_poll(void)
+{
+    uint32_t nr_idle = 0, backoff = 1, i;
+
+    mailbox_set_polling(1);
+
+    while (nr_idle < MAILBOX_POLL_IDLE_THRESHOLD) {
+        spe_mailbox_queue.poll_stats.nr_polls++;
+
+        if (mailbox_has_ns_req()) {
+            spe_mailbox_queue.poll_stats.nr_hits++;
+            /*
+             * Nobody polls while the secure partitions serve the requests,
+             * so NSPE has to ring the doorbell meanwhile.
+             */
+            mailbox_stop_polling();
+            mailbox_poll_take_req();
+            /* Every secure partition is blocked again */
+            mailbox_set_polling(1);
+            nr_idle = 0;
+            backoff = 1;
+            continue;
+        }
+
+        nr_idle++;
+        for (i = 0; i < backoff; i++) {
+            __NOP();
+        }
+        if (backoff < MAILBOX_POLL_MAX_BACKOFF) {
+            backoff <<= 1;
+        }
+    }
+
+    mailbox_stop_polling();
+    if (mailbox_has_ns_req()) {
+        spe_mailbox_queue.poll_stats.nr_late_hits++;
+        mailbox_poll_take_req();
+    }
+
+    spe_mailbox_queue.poll_stats.nr_fallbacks++;
+}
+
+void tfm_mailbox_get_poll_stats(struct spe_mailbox_poll_stats_t *stats)
+{
+    TFM_CORE_ASSERT(stats != NULL);
+
+    *stats = spe_mailbox_queue.poll_stats;
+}
+#endif
+
 /* RPC handle_req() callback */
 static void mailbox_handle_req(void)
 {
@@ -349,6 +928,11 @@ static void mailbox_reply(const void *owner, int32_t ret)
     }
 
     (void)tfm_mailbox_reply_msg(handle, ret);
+
+    /* Take the NSPE requests left pending now that an SPE slot is free */
+    if (spe_mailbox_queue.ns_backlog) {
+        (void)tfm_mailbox_handle_msg();
+    }
 }
 
 /* RPC get_caller_data() callback */
@@ -359,30 +943,76 @@ static const void *mailbox_get_caller_data(int32_t client_id)
     (void)client_id;
 
     idx = spe_mailbox_queue.cur_proc_slot_idx;
-    if (idx < NUM_MAILBOX_QUEUE_SLOT) {
+    if (idx < NUM_SPE_MAILBOX_QUEUE_SLOT) {
         return (const void *)&spe_mailbox_queue.queue[idx].msg_handle;
     }
 
     return NULL;
 }
 
+#ifdef TFM_MULTI_NS_MAILBOX
+/* RPC get_client_id() callback */
+static bool mailbox_get_client_id(int32_t *client_id)
+{
+    uint8_t idx;
+    struct secure_mailbox_slot_t *slot;
+
+    idx = spe_mailbox_queue.cur_proc_slot_idx;
+    if (idx >= NUM_SPE_MAILBOX_QUEUE_SLOT) {
+        return false;
+    }
+
+    slot = &spe_mailbox_queue.queue[idx];
+    *client_id = MAILBOX_NS_CLIENT_ID(slot->ns_src_idx, slot->msg.client_id);
+
+    return true;
+}
+#endif
+
 /* Mailbox specific operations callback for TF-M RPC */
 static const struct tfm_rpc_ops_t mailbox_rpc_ops = {
     .handle_req = mailbox_handle_req,
     .reply      = mailbox_reply,
     .get_caller_data = mailbox_get_caller_data,
+#ifdef TFM_MULTI_NS_MAILBOX
+    .get_client_id = mailbox_get_client_id,
+#endif
 };
 
+int32_t tfm_mailbox_register_ns_queue(uint8_t ns_queue_idx,
+                                      struct ns_mailbox_queue_t *ns_queue,
+                                      uint8_t weight)
+{
+    struct secure_mailbox_ns_src_t *src;
+
+    if ((ns_queue_idx >= NUM_NS_MAILBOX_QUEUE) || !ns_queue || !weight) {
+        return MAILBOX_INVAL_PARAMS;
+    }
+
+    /* Drop any stale lines left over from before the NS side set it up */
+    mailbox_cache_invalidate(ns_queue, sizeof(*ns_queue));
+
+    src = &spe_mailbox_queue.ns_srcs[ns_queue_idx];
+    src->ns_queue = ns_queue;
+    src->ns_next_idx = 0;
+    src->weight = weight;
+
+    return MAILBOX_SUCCESS;
+}
+
 int32_t tfm_mailbox_init(void)
 {
     int32_t ret;
+    uint8_t src_idx;
 
     tfm_core_util_memset(&spe_mailbox_queue, 0, sizeof(spe_mailbox_queue));
 
-    spe_mailbox_queue.empty_slots =
-            (mailbox_queue_status_t)((1UL << (NUM_MAILBOX_QUEUE_SLOT - 1)) - 1);
+    spe_mailbox_queue.cur_proc_slot_idx = NUM_SPE_MAILBOX_QUEUE_SLOT;
+
+    spe_mailbox_queue.empty_slots = (mailbox_queue_status_t)
+                            ((1UL << (NUM_SPE_MAILBOX_QUEUE_SLOT - 1)) - 1);
     spe_mailbox_queue.empty_slots +=
-            (mailbox_queue_status_t)(1UL << (NUM_MAILBOX_QUEUE_SLOT - 1));
+            (mailbox_queue_status_t)(1UL << (NUM_SPE_MAILBOX_QUEUE_SLOT - 1));
 
     /* Register RPC callbacks */
     ret = tfm_rpc_register_ops(&mailbox_rpc_ops);
@@ -392,8 +1022,8 @@ int32_t tfm_mailbox_init(void)
 
     /*
      * Platform specific initialization.
-     * Initialize Inter-Processor Communication and achieve the base address of
-     * NSPE mailbox queue
+     * Initialize Inter-Processor Communication and register the NSPE mailbox
+     * queues
      */
     ret = tfm_mailbox_hal_init(&spe_mailbox_queue);
     if (ret != MAILBOX_SUCCESS) {
@@ -402,5 +1032,13 @@ int32_t tfm_mailbox_init(void)
         return ret;
     }
 
-    return MAILBOX_SUCCESS;
+    for (src_idx = 0; src_idx < NUM_NS_MAILBOX_QUEUE; src_idx++) {
+        if (spe_mailbox_queue.ns_srcs[src_idx].ns_queue) {
+            return MAILBOX_SUCCESS;
+        }
+    }
+
+    tfm_rpc_unregister_ops();
+
+    return MAILBOX_INIT_ERROR;
 }
@@ -29,15 +29,35 @@
 #include "tfm_rpc.h"
 #include "tfm_internal.h"
 #include "tfm_core_trustzone.h"
+#include "tfm_ipc_trace.h"
+#include "tfm_spm_stats.h"
+#include "tfm_sfn.h"
 
 #ifdef PLATFORM_SVC_HANDLERS
 extern int32_t platform_svc_handlers(tfm_svc_number_t svc_num,
                                      uint32_t *ctx, uint32_t lr);
 #endif
 
+/* Size from which the copies of psa_read() and psa_write() are offered to the
+ * DMA engine of the platform.
+ */
+#ifndef TFM_SPM_DMA_COPY_THRESHOLD
+#define TFM_SPM_DMA_COPY_THRESHOLD 1024
+#endif
+
 void tfm_irq_handler(uint32_t partition_id, psa_signal_t signal,
                      int32_t irq_line);
 
+/* Copies the payload of a message, with the DMA engine if the copy is large */
+TFM_HOT_CODE
+static void tfm_spm_copy_payload(void *dst, const void *src, size_t size)
+{
+    if ((size < TFM_SPM_DMA_COPY_THRESHOLD) ||
+        (tfm_spm_hal_dma_copy(dst, src, size) != TFM_PLAT_ERR_SUCCESS)) {
+        tfm_core_util_memcpy(dst, src, size);
+    }
+}
+
 #include "tfm_secure_irq_handlers_ipc.inc"
 
 /* The section names come from the scatter file */
@@ -73,6 +93,7 @@ psa_status_t tfm_svcall_psa_connect(uint32_t *args, bool ns_caller)
     return tfm_psa_connect(sid, version, ns_caller);
 }
 
+TFM_HOT_CODE
 psa_status_t tfm_svcall_psa_call(uint32_t *args, bool ns_caller, uint32_t lr)
 {
     psa_handle_t handle;
@@ -120,8 +141,129 @@ psa_status_t tfm_svcall_psa_call(uint32_t *args, bool ns_caller, uint32_t lr)
     }
 
     return tfm_psa_call(handle, type, inptr, in_num, outptr, out_num, ns_caller,
-                        privileged);
+                        privileged, args);
+}
+
+psa_status_t tfm_svcall_psa_call_batch(uint32_t *args, bool ns_caller)
+{
+    psa_handle_t handle;
+    psa_batch_call_t *calls;
+    size_t num_calls;
+    struct spm_partition_desc_t *partition = NULL;
+    uint32_t privileged;
+
+    TFM_CORE_ASSERT(args != NULL);
+    handle = (psa_handle_t)args[0];
+    calls = (psa_batch_call_t *)args[1];
+    num_calls = (size_t)args[2];
+
+    partition = tfm_spm_get_running_partition();
+    if (!partition) {
+        tfm_core_panic();
+    }
+    privileged = tfm_spm_partition_get_privileged_mode(
+        partition->static_data->partition_flags);
+
+    return tfm_psa_call_batch(handle, calls, num_calls, ns_caller, privileged);
+}
+
+#ifdef TFM_PSA_ASYNC_CALL
+psa_status_t tfm_svcall_psa_call_async(uint32_t *args, bool ns_caller)
+{
+    psa_handle_t handle;
+    struct tfm_async_control_parameter_t ctrl_param;
+    struct tfm_async_control_parameter_t *p_ctrl_param;
+    struct spm_partition_desc_t *partition = NULL;
+    uint32_t privileged;
+    psa_status_t status;
+
+    TFM_CORE_ASSERT(args != NULL);
+    handle = (psa_handle_t)args[0];
+    p_ctrl_param = (struct tfm_async_control_parameter_t *)args[1];
+
+    /* Secure clients are threads, they can simply block on psa_call(). */
+    if (!ns_caller) {
+        tfm_core_panic();
+    }
+
+    partition = tfm_spm_get_running_partition();
+    if (!partition) {
+        tfm_core_panic();
+    }
+    privileged = tfm_spm_partition_get_privileged_mode(
+        partition->static_data->partition_flags);
+
+    /*
+     * The token of the call is written back to the parameters. It is a fatal
+     * error if the memory reference for them is invalid or not read-write.
+     */
+    if (tfm_memory_check(p_ctrl_param, sizeof(*p_ctrl_param), ns_caller,
+        TFM_MEMORY_ACCESS_RW, privileged) != IPC_SUCCESS) {
+        tfm_core_panic();
+    }
+
+    tfm_core_util_memcpy(&ctrl_param, p_ctrl_param, sizeof(ctrl_param));
+
+    /* The request type must be zero or positive. */
+    if (ctrl_param.type < 0) {
+        tfm_core_panic();
+    }
+
+    status = tfm_psa_call_async(handle, ctrl_param.type,
+                                (const psa_invec *)args[2], ctrl_param.in_len,
+                                (psa_outvec *)args[3], ctrl_param.out_len,
+                                privileged, &ctrl_param.token);
+    if (status == PSA_SUCCESS) {
+        p_ctrl_param->token = ctrl_param.token;
+    }
+
+    return status;
+}
+
+psa_status_t tfm_svcall_psa_call_async_result(uint32_t *args, bool ns_caller)
+{
+    psa_handle_t handle;
+    psa_status_t *p_status;
+    psa_status_t status = PSA_SUCCESS;
+    psa_status_t ret;
+
+    TFM_CORE_ASSERT(args != NULL);
+    handle = (psa_handle_t)args[0];
+    p_status = (psa_status_t *)args[1];
+
+    if (!ns_caller) {
+        tfm_core_panic();
+    }
+
+    /*
+     * It is a fatal error if the memory reference for the status is invalid
+     * or not read-write.
+     */
+    if (tfm_memory_check(p_status, sizeof(*p_status), ns_caller,
+                         TFM_MEMORY_ACCESS_RW,
+                         TFM_PARTITION_UNPRIVILEGED_MODE) != IPC_SUCCESS) {
+        tfm_core_panic();
+    }
+
+    ret = tfm_psa_call_async_result(handle, &status);
+    if (ret == PSA_SUCCESS) {
+        *p_status = status;
+    }
+
+    return ret;
+}
+
+psa_status_t tfm_svcall_psa_call_async_set_irq(uint32_t *args, bool ns_caller)
+{
+    TFM_CORE_ASSERT(args != NULL);
+
+    if (!ns_caller) {
+        tfm_core_panic();
+    }
+
+    return tfm_psa_call_async_set_irq((int32_t)args[0]);
 }
+#endif /* TFM_PSA_ASYNC_CALL */
 
 void tfm_svcall_psa_close(uint32_t *args, bool ns_caller)
 {
@@ -138,6 +280,17 @@ uint32_t tfm_svcall_get_lifecycle_state(void)
     return tfm_spm_get_lifecycle_state();
 }
 
+/**
+ * \brief SVC handler for \ref tfm_yield. The caller is moved behind the other
+ *        ready threads of its priority level, and the scheduler runs once the
+ *        SVC returns.
+ */
+static void tfm_svcall_yield(void)
+{
+    tfm_core_thrd_yield(tfm_core_thrd_get_curr_thread());
+    tfm_core_thrd_activate_schedule();
+}
+
 /*********************** SVC handler for PSA Service APIs ********************/
 
 /**
@@ -150,6 +303,7 @@ uint32_t tfm_svcall_get_lifecycle_state(void)
  * \retval 0                    No signals are asserted. This is only seen when
  *                              a polling timeout is used.
  */
+TFM_HOT_CODE
 static psa_signal_t tfm_svcall_psa_wait(uint32_t *args)
 {
     psa_signal_t signal_mask;
@@ -171,11 +325,18 @@ static psa_signal_t tfm_svcall_psa_wait(uint32_t *args)
         tfm_core_panic();
     }
 
+#ifdef TFM_SFN_PARTITIONS
+    /* A secure function runs on the thread of its client, it cannot wait */
+    if (partition->static_data->partition_flags & SPM_PART_FLAG_SFN) {
+        tfm_core_panic();
+    }
+#endif
+
     /*
      * It is a PROGRAMMER ERROR if the signal_mask does not include any assigned
      * signals.
      */
-    if ((partition->runtime_data.assigned_signals & signal_mask) == 0) {
+    if ((partition->static_data->assigned_signals & signal_mask) == 0) {
         tfm_core_panic();
     }
 
@@ -186,6 +347,13 @@ static psa_signal_t tfm_svcall_psa_wait(uint32_t *args)
      */
     partition->runtime_data.signal_mask = signal_mask;
 
+#ifdef TFM_DEFERRED_INIT
+    /* A partition waits for signals once it is initialized */
+    if (partition->runtime_data.init_state != SPM_INIT_STATE_DONE) {
+        tfm_spm_partition_init_done(partition);
+    }
+#endif
+
     /*
      * tfm_event_wait() blocks the caller thread if no signals are available.
      * In this case, the return value of this function is temporary set into
@@ -217,6 +385,7 @@ static psa_signal_t tfm_svcall_psa_wait(uint32_t *args)
  * \arg                           The msg pointer provided is not a valid memory
  *                                reference.
  */
+TFM_HOT_CODE
 static psa_status_t tfm_svcall_psa_get(uint32_t *args)
 {
     psa_signal_t signal;
@@ -284,6 +453,12 @@ static psa_status_t tfm_svcall_psa_get(uint32_t *args)
         return PSA_ERROR_DOES_NOT_EXIST;
     }
 
+    TFM_IPC_TRACE_POINT(TFM_IPC_TRACE_PSA_GET, tmp_msg->msg.type);
+
+#ifdef TFM_SPM_STATS
+    tmp_msg->get_cycles = tfm_spm_stats_get_cycles();
+#endif
+
     ((struct tfm_conn_handle_t *)(tmp_msg->handle))->status =
                                                        TFM_HANDLE_STATUS_ACTIVE;
 
@@ -333,6 +508,68 @@ static void tfm_svcall_psa_set_rhandle(uint32_t *args)
     tfm_spm_set_rhandle(msg->service, msg->handle, rhandle);
 }
 
+#ifdef TFM_MAILBOX_SG
+/*
+ * Consume num_bytes of an input vector, moving on to the next segment each
+ * time the current one is used up. The data is copied to buffer unless it is
+ * NULL. The caller checks num_bytes against the remaining size of the vector.
+ */
+static void consume_invec_segs(struct tfm_msg_body_t *msg, uint32_t invec_idx,
+                               uint8_t *buffer, size_t num_bytes)
+{
+    psa_invec *cur = &msg->invec[invec_idx];
+    size_t bytes;
+
+    while (num_bytes) {
+        if (cur->len == 0) {
+            TFM_CORE_ASSERT(msg->sg.in_nr_segs[invec_idx] != 0);
+            *cur = *msg->sg.in_segs[invec_idx]++;
+            msg->sg.in_nr_segs[invec_idx]--;
+            continue;
+        }
+
+        bytes = num_bytes > cur->len ? cur->len : num_bytes;
+        if (buffer) {
+            tfm_spm_copy_payload(buffer, cur->base, bytes);
+            buffer += bytes;
+        }
+
+        cur->base += bytes;
+        cur->len -= bytes;
+        num_bytes -= bytes;
+    }
+}
+
+/*
+ * Write num_bytes to an output vector, moving on to the next segment each
+ * time the current one is full. The caller checks num_bytes against the
+ * remaining size of the vector.
+ */
+static void fill_outvec_segs(struct tfm_msg_body_t *msg, uint32_t outvec_idx,
+                             const uint8_t *buffer, size_t num_bytes)
+{
+    psa_outvec *cur = &msg->sg.out_cur[outvec_idx];
+    size_t bytes;
+
+    while (num_bytes) {
+        if (cur->len == 0) {
+            TFM_CORE_ASSERT(msg->sg.out_nr_segs[outvec_idx] != 0);
+            *cur = *msg->sg.out_segs[outvec_idx]++;
+            msg->sg.out_nr_segs[outvec_idx]--;
+            continue;
+        }
+
+        bytes = num_bytes > cur->len ? cur->len : num_bytes;
+        tfm_spm_copy_payload(cur->base, buffer, bytes);
+
+        buffer += bytes;
+        cur->base += bytes;
+        cur->len -= bytes;
+        num_bytes -= bytes;
+    }
+}
+#endif
+
 /**
  * \brief SVC handler for \ref psa_read.
  *
@@ -352,6 +589,7 @@ static void tfm_svcall_psa_set_rhandle(uint32_t *args)
  * \arg                           the memory reference for buffer is invalid or
  *                                not writable.
  */
+TFM_HOT_CODE
 static size_t tfm_svcall_psa_read(uint32_t *args)
 {
     psa_handle_t msg_handle;
@@ -395,6 +633,12 @@ static size_t tfm_svcall_psa_read(uint32_t *args)
         tfm_core_panic();
     }
 
+    /* It is a fatal error if the input vector has been mapped */
+    if (msg->iovec_status & TFM_INVEC_STATUS(TFM_IOVEC_MAPPED, invec_idx)) {
+        tfm_core_panic();
+    }
+    msg->iovec_status |= TFM_INVEC_STATUS(TFM_IOVEC_ACCESSED, invec_idx);
+
     /* There was no remaining data in this input vector */
     if (msg->msg.in_size[invec_idx] == 0) {
         return 0;
@@ -412,10 +656,14 @@ static size_t tfm_svcall_psa_read(uint32_t *args)
     bytes = num_bytes > msg->msg.in_size[invec_idx] ?
                         msg->msg.in_size[invec_idx] : num_bytes;
 
-    tfm_core_util_memcpy(buffer, msg->invec[invec_idx].base, bytes);
+#ifdef TFM_MAILBOX_SG
+    consume_invec_segs(msg, invec_idx, buffer, bytes);
+#else
+    tfm_spm_copy_payload(buffer, msg->invec[invec_idx].base, bytes);
 
     /* There maybe some remaining data */
     msg->invec[invec_idx].base += bytes;
+#endif
     msg->msg.in_size[invec_idx] -= bytes;
 
     return bytes;
@@ -472,6 +720,12 @@ static size_t tfm_svcall_psa_skip(uint32_t *args)
         tfm_core_panic();
     }
 
+    /* It is a fatal error if the input vector has been mapped */
+    if (msg->iovec_status & TFM_INVEC_STATUS(TFM_IOVEC_MAPPED, invec_idx)) {
+        tfm_core_panic();
+    }
+    msg->iovec_status |= TFM_INVEC_STATUS(TFM_IOVEC_ACCESSED, invec_idx);
+
     /* There was no remaining data in this input vector */
     if (msg->msg.in_size[invec_idx] == 0) {
         return 0;
@@ -485,8 +739,12 @@ static size_t tfm_svcall_psa_skip(uint32_t *args)
         num_bytes = msg->msg.in_size[invec_idx];
     }
 
+#ifdef TFM_MAILBOX_SG
+    consume_invec_segs(msg, invec_idx, NULL, num_bytes);
+#else
     /* There maybe some remaining data */
     msg->invec[invec_idx].base += num_bytes;
+#endif
     msg->msg.in_size[invec_idx] -= num_bytes;
 
     return num_bytes;
@@ -510,6 +768,7 @@ static size_t tfm_svcall_psa_skip(uint32_t *args)
  * \arg                           The call attempts to write data past the end
  *                                of the client output vector.
  */
+TFM_HOT_CODE
 static void tfm_svcall_psa_write(uint32_t *args)
 {
     psa_handle_t msg_handle;
@@ -552,6 +811,12 @@ static void tfm_svcall_psa_write(uint32_t *args)
         tfm_core_panic();
     }
 
+    /* It is a fatal error if the output vector has been mapped */
+    if (msg->iovec_status & TFM_OUTVEC_STATUS(TFM_IOVEC_MAPPED, outvec_idx)) {
+        tfm_core_panic();
+    }
+    msg->iovec_status |= TFM_OUTVEC_STATUS(TFM_IOVEC_ACCESSED, outvec_idx);
+
     /*
      * It is a fatal error if the call attempts to write data past the end of
      * the client output vector
@@ -570,13 +835,255 @@ static void tfm_svcall_psa_write(uint32_t *args)
         tfm_core_panic();
     }
 
-    tfm_core_util_memcpy(msg->outvec[outvec_idx].base +
+#ifdef TFM_MAILBOX_SG
+    fill_outvec_segs(msg, outvec_idx, buffer, num_bytes);
+#else
+    tfm_spm_copy_payload(msg->outvec[outvec_idx].base +
                          msg->outvec[outvec_idx].len, buffer, num_bytes);
+#endif
 
     /* Update the write number */
     msg->outvec[outvec_idx].len += num_bytes;
 }
 
+/**
+ * \brief Get the request message whose client vector is to be mapped or
+ *        unmapped.
+ *
+ * \param[in] msg_handle        Handle for the client's message.
+ * \param[in] iovec_idx         Index of the input or output vector.
+ *
+ * \retval "Not NULL"           The request message.
+ * \retval "Does not return"    msg_handle is invalid or does not refer to a
+ *                              request message, iovec_idx is equal to or
+ *                              greater than \ref PSA_MAX_IOVEC, or the RoT
+ *                              Service does not run privileged and so cannot
+ *                              access the client memory directly.
+ */
+static struct tfm_msg_body_t *get_iovec_map_msg(psa_handle_t msg_handle,
+                                                uint32_t iovec_idx)
+{
+    struct tfm_msg_body_t *msg = NULL;
+    struct spm_partition_desc_t *partition = NULL;
+
+    /* It is a fatal error if message handle is invalid */
+    msg = tfm_spm_get_msg_from_handle(msg_handle);
+    if (!msg) {
+        tfm_core_panic();
+    }
+
+    /*
+     * It is a fatal error if message handle does not refer to a request
+     * message
+     */
+    if (msg->msg.type < PSA_IPC_CALL) {
+        tfm_core_panic();
+    }
+
+    /*
+     * It is a fatal error if iovec_idx is equal to or greater than
+     * PSA_MAX_IOVEC
+     */
+    if (iovec_idx >= PSA_MAX_IOVEC) {
+        tfm_core_panic();
+    }
+
+    /*
+     * The client vectors have been checked against the client on psa_call(),
+     * but only a privileged RoT Service can reach the client memory directly.
+     */
+    partition = msg->service->partition;
+    if (tfm_spm_partition_get_privileged_mode(
+            partition->static_data->partition_flags) !=
+        TFM_PARTITION_PRIVILEGED_MODE) {
+        tfm_core_panic();
+    }
+
+    return msg;
+}
+
+/**
+ * \brief SVC handler for \ref psa_map_invec.
+ *
+ * \param[in] args              Include all input arguments:
+ *                              msg_handle, invec_idx.
+ *
+ * \retval "Not NULL"           Pointer to the client input vector.
+ * \retval NULL                 The input vector has length zero.
+ * \retval "Does not return"    The call is invalid, one or more of the
+ *                              following are true:
+ * \arg                           msg_handle is invalid.
+ * \arg                           msg_handle does not refer to a request
+ *                                message.
+ * \arg                           invec_idx is equal to or greater than
+ *                                \ref PSA_MAX_IOVEC.
+ * \arg                           The RoT Service is not privileged.
+ * \arg                           The input vector has already been mapped, or
+ *                                accessed with psa_read() or psa_skip().
+ * \arg                           The input vector is scattered over several
+ *                                segments.
+ */
+static const void *tfm_svcall_psa_map_invec(uint32_t *args)
+{
+    uint32_t invec_idx;
+    struct tfm_msg_body_t *msg = NULL;
+
+    TFM_CORE_ASSERT(args != NULL);
+    invec_idx = args[1];
+    msg = get_iovec_map_msg((psa_handle_t)args[0], invec_idx);
+
+    if (msg->iovec_status & TFM_INVEC_STATUS(TFM_IOVEC_ACCESSED |
+                                             TFM_IOVEC_MAPPED, invec_idx)) {
+        tfm_core_panic();
+    }
+#ifdef TFM_MAILBOX_SG
+    /* A vector scattered over several segments cannot be mapped */
+    if (msg->sg.in_nr_segs[invec_idx] != 0) {
+        tfm_core_panic();
+    }
+#endif
+    msg->iovec_status |= TFM_INVEC_STATUS(TFM_IOVEC_MAPPED, invec_idx);
+
+    if (msg->msg.in_size[invec_idx] == 0) {
+        return NULL;
+    }
+
+    return msg->invec[invec_idx].base;
+}
+
+/**
+ * \brief SVC handler for \ref psa_unmap_invec.
+ *
+ * \param[in] args              Include all input arguments:
+ *                              msg_handle, invec_idx.
+ *
+ * \retval void                 Success.
+ * \retval "Does not return"    The call is invalid, one or more of the
+ *                              following are true:
+ * \arg                           msg_handle is invalid.
+ * \arg                           msg_handle does not refer to a request
+ *                                message.
+ * \arg                           invec_idx is equal to or greater than
+ *                                \ref PSA_MAX_IOVEC.
+ * \arg                           The input vector is not mapped, or has
+ *                                already been unmapped.
+ */
+static void tfm_svcall_psa_unmap_invec(uint32_t *args)
+{
+    uint32_t invec_idx;
+    struct tfm_msg_body_t *msg = NULL;
+
+    TFM_CORE_ASSERT(args != NULL);
+    invec_idx = args[1];
+    msg = get_iovec_map_msg((psa_handle_t)args[0], invec_idx);
+
+    if ((msg->iovec_status & TFM_INVEC_STATUS(TFM_IOVEC_MAPPED |
+                                              TFM_IOVEC_UNMAPPED, invec_idx)) !=
+        TFM_INVEC_STATUS(TFM_IOVEC_MAPPED, invec_idx)) {
+        tfm_core_panic();
+    }
+    msg->iovec_status |= TFM_INVEC_STATUS(TFM_IOVEC_UNMAPPED, invec_idx);
+
+    /* The input vector has been consumed */
+    msg->invec[invec_idx].base += msg->msg.in_size[invec_idx];
+    msg->msg.in_size[invec_idx] = 0;
+}
+
+/**
+ * \brief SVC handler for \ref psa_map_outvec.
+ *
+ * \param[in] args              Include all input arguments:
+ *                              msg_handle, outvec_idx.
+ *
+ * \retval "Not NULL"           Pointer to the client output vector.
+ * \retval NULL                 The output vector has length zero.
+ * \retval "Does not return"    The call is invalid, one or more of the
+ *                              following are true:
+ * \arg                           msg_handle is invalid.
+ * \arg                           msg_handle does not refer to a request
+ *                                message.
+ * \arg                           outvec_idx is equal to or greater than
+ *                                \ref PSA_MAX_IOVEC.
+ * \arg                           The RoT Service is not privileged.
+ * \arg                           The output vector has already been mapped, or
+ *                                written with psa_write().
+ * \arg                           The output vector is scattered over several
+ *                                segments.
+ */
+static void *tfm_svcall_psa_map_outvec(uint32_t *args)
+{
+    uint32_t outvec_idx;
+    struct tfm_msg_body_t *msg = NULL;
+
+    TFM_CORE_ASSERT(args != NULL);
+    outvec_idx = args[1];
+    msg = get_iovec_map_msg((psa_handle_t)args[0], outvec_idx);
+
+    if (msg->iovec_status & TFM_OUTVEC_STATUS(TFM_IOVEC_ACCESSED |
+                                              TFM_IOVEC_MAPPED, outvec_idx)) {
+        tfm_core_panic();
+    }
+#ifdef TFM_MAILBOX_SG
+    /* A vector scattered over several segments cannot be mapped */
+    if (msg->sg.out_nr_segs[outvec_idx] != 0) {
+        tfm_core_panic();
+    }
+#endif
+    msg->iovec_status |= TFM_OUTVEC_STATUS(TFM_IOVEC_MAPPED, outvec_idx);
+
+    if (msg->msg.out_size[outvec_idx] == 0) {
+        return NULL;
+    }
+
+    return msg->outvec[outvec_idx].base;
+}
+
+/**
+ * \brief SVC handler for \ref psa_unmap_outvec.
+ *
+ * \param[in] args              Include all input arguments:
+ *                              msg_handle, outvec_idx, len.
+ *
+ * \retval void                 Success.
+ * \retval "Does not return"    The call is invalid, one or more of the
+ *                              following are true:
+ * \arg                           msg_handle is invalid.
+ * \arg                           msg_handle does not refer to a request
+ *                                message.
+ * \arg                           outvec_idx is equal to or greater than
+ *                                \ref PSA_MAX_IOVEC.
+ * \arg                           The output vector is not mapped, or has
+ *                                already been unmapped.
+ * \arg                           len is greater than the output vector size.
+ */
+static void tfm_svcall_psa_unmap_outvec(uint32_t *args)
+{
+    uint32_t outvec_idx;
+    size_t len;
+    struct tfm_msg_body_t *msg = NULL;
+
+    TFM_CORE_ASSERT(args != NULL);
+    outvec_idx = args[1];
+    len = (size_t)args[2];
+    msg = get_iovec_map_msg((psa_handle_t)args[0], outvec_idx);
+
+    if ((msg->iovec_status & TFM_OUTVEC_STATUS(TFM_IOVEC_MAPPED |
+                                               TFM_IOVEC_UNMAPPED,
+                                               outvec_idx)) !=
+        TFM_OUTVEC_STATUS(TFM_IOVEC_MAPPED, outvec_idx)) {
+        tfm_core_panic();
+    }
+
+    if (len > msg->msg.out_size[outvec_idx]) {
+        tfm_core_panic();
+    }
+    msg->iovec_status |= TFM_OUTVEC_STATUS(TFM_IOVEC_UNMAPPED, outvec_idx);
+
+    /* Report the number of bytes the RoT Service wrote in place */
+    msg->outvec[outvec_idx].len = len;
+}
+
+TFM_HOT_CODE
 static void update_caller_outvec_len(struct tfm_msg_body_t *msg)
 {
     uint32_t i;
@@ -585,11 +1092,24 @@ static void update_caller_outvec_len(struct tfm_msg_body_t *msg)
      * FixeMe: abstract these part into dedicated functions to avoid
      * accessing thread context in psa layer
      */
-    /* If it is a NS request via RPC, the owner of this message is not set */
-    if (!is_tfm_rpc_msg(msg)) {
+    /*
+     * If it is a NS request via RPC or an asynchronous call, the owner of this
+     * message is not set
+     */
+    if (!is_tfm_rpc_msg(msg) && !tfm_psa_call_async_pending(msg->handle)) {
         TFM_CORE_ASSERT(msg->ack_evnt.owner->state == THRD_STATE_BLOCK);
     }
 
+#ifdef TFM_MAILBOX_SG
+    /* A scatter-gather caller gets the written lengths in its own buffer */
+    if (msg->sg.out_written) {
+        for (i = 0; i < msg->sg.out_len; i++) {
+            msg->sg.out_written[i] = msg->outvec[i].len;
+        }
+        return;
+    }
+#endif
+
     for (i = 0; i < PSA_MAX_IOVEC; i++) {
         if (msg->msg.out_size[i] == 0) {
             continue;
@@ -613,6 +1133,7 @@ static void update_caller_outvec_len(struct tfm_msg_body_t *msg)
  * \arg                         An invalid status code is specified for the
  *                              type of message.
  */
+TFM_HOT_CODE
 static void tfm_svcall_psa_reply(uint32_t *args)
 {
     psa_handle_t msg_handle;
@@ -631,6 +1152,15 @@ static void tfm_svcall_psa_reply(uint32_t *args)
         tfm_core_panic();
     }
 
+#ifdef TFM_SFN_PARTITIONS
+    /* The reply to a secure function request is its return value */
+    if (msg->service->service_db->sfn) {
+        tfm_core_panic();
+    }
+#endif
+
+    TFM_IPC_TRACE_POINT(TFM_IPC_TRACE_PSA_REPLY, status);
+
     /*
      * RoT Service information is needed in this function, stored it in message
      * body structure. Only two parameters are passed in this function: handle
@@ -641,6 +1171,11 @@ static void tfm_svcall_psa_reply(uint32_t *args)
         tfm_core_panic();
     }
 
+#ifdef TFM_SPM_STATS
+    service->stats_requests++;
+    service->stats_cycles += tfm_spm_stats_get_cycles() - msg->get_cycles;
+#endif
+
     /*
      * Three type of message are passed in this function: CONNECTION, REQUEST,
      * DISCONNECTION. It needs to process differently for each type.
@@ -706,11 +1241,41 @@ static void tfm_svcall_psa_reply(uint32_t *args)
                                                          TFM_HANDLE_STATUS_IDLE;
     }
 
+    /*
+     * The client of a batch stays blocked until the last request has been
+     * replied.
+     */
+    if (msg->msg.type >= PSA_IPC_CALL &&
+        tfm_psa_call_batch_continue(msg->handle, &ret)) {
+        return;
+    }
+
+#ifdef TFM_MSG_QUEUE_PRIORITY
+    /* The request is done, drop the priority inherited from the client */
+    tfm_spm_partition_restore_priority(service->partition);
+#endif
+
     if (is_tfm_rpc_msg(msg)) {
         tfm_rpc_client_call_reply(msg, ret);
+    } else if (msg->msg.type >= PSA_IPC_CALL &&
+               tfm_psa_call_async_complete(msg->handle, ret)) {
+        /*
+         * The client of an asynchronous call is notified by an interrupt.
+         * The connection keeps the status until the client collects it.
+         */
+        return;
     } else {
         tfm_event_wake(&msg->ack_evnt, ret);
     }
+
+    /*
+     * The connection of a call to a stateless RoT Service only lives as long
+     * as the call itself.
+     */
+    if (!service->service_db->connection_based &&
+        msg->msg.type >= PSA_IPC_CALL) {
+        tfm_spm_free_conn_handle(service, msg->handle);
+    }
 }
 
 /**
@@ -745,6 +1310,12 @@ static void notify_with_signal(int32_t partition_id, psa_signal_t signal)
 
     partition->runtime_data.signals |= signal;
 
+#ifdef TFM_DEFERRED_INIT
+    if (partition->runtime_data.init_state != SPM_INIT_STATE_DONE) {
+        tfm_spm_partition_demand(partition);
+    }
+#endif
+
     /*
      * The target partition may be blocked with waiting for signals after
      * called psa_wait(). Set the return value with the available signals
@@ -787,6 +1358,8 @@ static void tfm_svcall_psa_notify(uint32_t *args)
 void tfm_irq_handler(uint32_t partition_id, psa_signal_t signal,
                      int32_t irq_line)
 {
+    TFM_IPC_TRACE_POINT(TFM_IPC_TRACE_IRQ_SIGNAL, signal);
+
     tfm_spm_hal_disable_irq(irq_line);
     notify_with_signal(partition_id, signal);
 }
@@ -916,6 +1489,8 @@ static void tfm_svcall_psa_eoi(uint32_t *args)
 
     tfm_spm_hal_clear_pending_irq(irq_line);
     tfm_spm_hal_enable_irq(irq_line);
+
+    TFM_IPC_TRACE_POINT(TFM_IPC_TRACE_IRQ_EOI, irq_signal);
 }
 
 void tfm_svcall_enable_irq(uint32_t *args)
@@ -1027,6 +1602,7 @@ static void tfm_core_validate_caller(struct spm_partition_desc_t *p_cur_sp,
     }
 }
 
+TFM_HOT_CODE
 int32_t SVC_Handler_IPC(tfm_svc_number_t svc_num, uint32_t *ctx, uint32_t lr)
 {
     bool ns_caller = false;
@@ -1064,6 +1640,16 @@ int32_t SVC_Handler_IPC(tfm_svc_number_t svc_num, uint32_t *ctx, uint32_t lr)
         return tfm_svcall_psa_connect(ctx, ns_caller);
     case TFM_SVC_PSA_CALL:
         return tfm_svcall_psa_call(ctx, ns_caller, lr);
+    case TFM_SVC_PSA_CALL_BATCH:
+        return tfm_svcall_psa_call_batch(ctx, ns_caller);
+#ifdef TFM_PSA_ASYNC_CALL
+    case TFM_SVC_PSA_CALL_ASYNC:
+        return tfm_svcall_psa_call_async(ctx, ns_caller);
+    case TFM_SVC_PSA_CALL_ASYNC_RESULT:
+        return tfm_svcall_psa_call_async_result(ctx, ns_caller);
+    case TFM_SVC_PSA_CALL_ASYNC_SET_IRQ:
+        return tfm_svcall_psa_call_async_set_irq(ctx, ns_caller);
+#endif
     case TFM_SVC_PSA_CLOSE:
         tfm_svcall_psa_close(ctx, ns_caller);
         break;
@@ -1081,6 +1667,16 @@ int32_t SVC_Handler_IPC(tfm_svc_number_t svc_num, uint32_t *ctx, uint32_t lr)
     case TFM_SVC_PSA_WRITE:
         tfm_svcall_psa_write(ctx);
         break;
+    case TFM_SVC_PSA_MAP_INVEC:
+        return (int32_t)(uintptr_t)tfm_svcall_psa_map_invec(ctx);
+    case TFM_SVC_PSA_UNMAP_INVEC:
+        tfm_svcall_psa_unmap_invec(ctx);
+        break;
+    case TFM_SVC_PSA_MAP_OUTVEC:
+        return (int32_t)(uintptr_t)tfm_svcall_psa_map_outvec(ctx);
+    case TFM_SVC_PSA_UNMAP_OUTVEC:
+        tfm_svcall_psa_unmap_outvec(ctx);
+        break;
     case TFM_SVC_PSA_REPLY:
         tfm_svcall_psa_reply(ctx);
         break;
@@ -1107,6 +1703,13 @@ int32_t SVC_Handler_IPC(tfm_svc_number_t svc_num, uint32_t *ctx, uint32_t lr)
         break;
     case TFM_SVC_PSA_LIFECYCLE:
         return tfm_svcall_get_lifecycle_state();
+    case TFM_SVC_YIELD:
+        tfm_svcall_yield();
+        break;
+#ifdef TFM_SFN_PARTITIONS
+    case TFM_SVC_PSA_SFN_RETURN:
+        return tfm_sfn_return(ctx);
+#endif
     default:
 #ifdef PLATFORM_SVC_HANDLERS
         return (platform_svc_handlers(svc_num, ctx, lr));
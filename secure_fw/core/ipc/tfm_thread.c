@@ -13,73 +13,111 @@
 #include "spm_api.h"
 #include "tfm_core_utils.h"
 
+/*
+ * Ready queue: one list of RUNNING threads per priority level, and a bitmap
+ * with one bit set for each non-empty level. The bit of level 'n' is bit
+ * (31 - n), so counting the leading zeros of the bitmap directly gives the
+ * highest priority level that has a thread ready to run.
+ *
+ * A list head is only initialized while its level bit is set.
+ */
+TFM_HOT_DATA
+static struct tfm_list_node_t rdy_list[THRD_PRIOR_LEVEL_NUM];
+TFM_HOT_DATA
+static uint32_t rdy_bitmap = 0;
+
 /* Force ZERO in case ZI(bss) clear is missing */
-static struct tfm_core_thread_t *p_thrd_head = NULL;
-static struct tfm_core_thread_t *p_runn_head = NULL;
+TFM_HOT_DATA
 static struct tfm_core_thread_t *p_curr_thrd = NULL;
 
 /* Define Macro to fetch global to support future expansion (PERCPU e.g.) */
-#define LIST_HEAD   p_thrd_head
-#define RUNN_HEAD   p_runn_head
 #define CURR_THRD   p_curr_thrd
 
-static struct tfm_core_thread_t *find_next_running_thread(
-                                                struct tfm_core_thread_t *pth)
+#if THRD_PRIOR_LEVEL_NUM > 32
+#error "The ready queue bitmap can not hold all the priority levels!"
+#endif
+
+#define RDY_LEVEL_BIT(level)    (1UL << (31 - (level)))
+
+#ifdef TFM_THRD_TIME_SLICE
+/* Set by SysTick when the quantum of the current thread expires */
+TFM_HOT_DATA
+static volatile uint32_t time_slice_expired = 0;
+#endif
+
+/* Non-secure threads are shifted down to the lowest priority level */
+TFM_HOT_CODE
+static uint32_t get_prior_level(struct tfm_core_thread_t *pth)
 {
-    while (pth && pth->state != THRD_STATE_RUNNING) {
-        pth = pth->next;
+    if (pth->prior & THRD_ATTR_NON_SECURE) {
+        return THRD_PRIOR_LEVEL_NUM - 1;
     }
 
-    return pth;
+    return (pth->prior & THRD_PRIOR_MASK) >> THRD_PRIOR_LEVEL_SHIFT;
 }
 
-/* To get next running thread for scheduler */
-struct tfm_core_thread_t *tfm_core_thrd_get_next_thread(void)
+/*
+ * Append a thread into the list of its priority level. Threads in one level
+ * are kept in ascending order of priority value (highest at head) and threads
+ * with equal priority are served in first-in first-out order.
+ */
+TFM_HOT_CODE
+static void rdy_queue_insert(struct tfm_core_thread_t *pth)
 {
-    /*
-     * First RUNNING thread has highest priority since threads are sorted with
-     * priority.
-     */
-    return find_next_running_thread(RUNN_HEAD);
+    uint32_t level = get_prior_level(pth);
+    struct tfm_list_node_t *head = &rdy_list[level];
+    struct tfm_list_node_t *node;
+    struct tfm_core_thread_t *iter;
+
+    if (!(rdy_bitmap & RDY_LEVEL_BIT(level))) {
+        tfm_list_init(head);
+        rdy_bitmap |= RDY_LEVEL_BIT(level);
+    }
+
+    TFM_LIST_FOR_EACH(node, head) {
+        iter = TFM_GET_CONTAINER_PTR(node, struct tfm_core_thread_t, rdy_node);
+        if (iter->prior > pth->prior) {
+            break;
+        }
+    }
+
+    /* Insert before 'node', which is the list head for a tail insertion */
+    tfm_list_add_tail(node, &pth->rdy_node);
 }
 
-/* To get current thread for caller */
-struct tfm_core_thread_t *tfm_core_thrd_get_curr_thread(void)
+TFM_HOT_CODE
+static void rdy_queue_remove(struct tfm_core_thread_t *pth)
 {
-    return CURR_THRD;
+    uint32_t level = get_prior_level(pth);
+
+    tfm_list_del_node(&pth->rdy_node);
+
+    if (tfm_list_is_empty(&rdy_list[level])) {
+        rdy_bitmap &= ~RDY_LEVEL_BIT(level);
+    }
 }
 
-/* Insert a new thread into list by descending priority (Highest at head) */
-static void insert_by_prior(struct tfm_core_thread_t **head,
-                            struct tfm_core_thread_t *node)
+/* To get next running thread for scheduler */
+TFM_HOT_CODE
+struct tfm_core_thread_t *tfm_core_thrd_get_next_thread(void)
 {
-    if (*head == NULL || (node->prior <= (*head)->prior)) {
-        node->next = *head;
-        *head = node;
-    } else {
-        struct tfm_core_thread_t *iter = *head;
+    struct tfm_list_node_t *node;
 
-        while (iter->next && (node->prior > iter->next->prior)) {
-            iter = iter->next;
-        }
-        node->next = iter->next;
-        iter->next = node;
+    if (rdy_bitmap == 0) {
+        return NULL;
     }
+
+    /* First thread of the highest non-empty level has highest priority */
+    node = tfm_list_first_node(&rdy_list[__CLZ(rdy_bitmap)]);
+
+    return TFM_GET_CONTAINER_PTR(node, struct tfm_core_thread_t, rdy_node);
 }
 
-/*
- * Set first running thread as head to reduce enumerate
- * depth while searching for a first running thread.
- */
-static void update_running_head(struct tfm_core_thread_t **runn,
-                                struct tfm_core_thread_t *node)
+/* To get current thread for caller */
+TFM_HOT_CODE
+struct tfm_core_thread_t *tfm_core_thrd_get_curr_thread(void)
 {
-    if ((node->state == THRD_STATE_RUNNING) &&
-        (*runn == NULL || (node->prior < (*runn)->prior))) {
-        *runn = node;
-    } else {
-        *runn = LIST_HEAD;
-    }
+    return CURR_THRD;
 }
 
 /* Set context members only. No validation here */
@@ -109,24 +147,89 @@ uint32_t tfm_core_thrd_start(struct tfm_core_thread_t *pth)
     tfm_arch_init_context(&pth->arch_ctx, pth->param, (uintptr_t)pth->pfn,
                           pth->stk_btm, pth->stk_top);
 
-    /* Insert a new thread with priority */
-    insert_by_prior(&LIST_HEAD, pth);
-
-    /* Mark it as RUNNING after insertion */
+    /* Mark it as RUNNING, which inserts it into the ready queue */
     tfm_core_thrd_set_state(pth, THRD_STATE_RUNNING);
 
     return THRD_SUCCESS;
 }
 
+TFM_HOT_CODE
 void tfm_core_thrd_set_state(struct tfm_core_thread_t *pth, uint32_t new_state)
 {
     TFM_CORE_ASSERT(pth != NULL && new_state < THRD_STATE_INVALID);
 
+    /* Only the transitions from or to RUNNING change the ready queue */
+    if (pth->state != THRD_STATE_RUNNING && new_state == THRD_STATE_RUNNING) {
+        rdy_queue_insert(pth);
+    } else if (pth->state == THRD_STATE_RUNNING &&
+               new_state != THRD_STATE_RUNNING) {
+        rdy_queue_remove(pth);
+    }
+
     pth->state = new_state;
-    update_running_head(&RUNN_HEAD, pth);
 }
 
+void tfm_core_thrd_change_priority(struct tfm_core_thread_t *pth,
+                                   uint32_t prior)
+{
+    TFM_CORE_ASSERT(pth != NULL);
+
+    if (pth->state == THRD_STATE_RUNNING) {
+        rdy_queue_remove(pth);
+        tfm_core_thrd_set_priority(pth, prior);
+        rdy_queue_insert(pth);
+    } else {
+        tfm_core_thrd_set_priority(pth, prior);
+    }
+}
+
+void tfm_core_thrd_yield(struct tfm_core_thread_t *pth)
+{
+    TFM_CORE_ASSERT(pth != NULL);
+
+    /* Threads of equal priority are inserted after the ones already queued */
+    if (pth->state == THRD_STATE_RUNNING) {
+        rdy_queue_remove(pth);
+        rdy_queue_insert(pth);
+    }
+}
+
+#ifdef TFM_THRD_TIME_SLICE
+/*
+ * SysTick has the priority of PendSV, so the scheduler sees the expiry once
+ * the exception returns, as for any other scheduling request.
+ */
+void SysTick_Handler(void)
+{
+    time_slice_expired = 1;
+    tfm_core_thrd_activate_schedule();
+}
+
+TFM_HOT_CODE
+void tfm_core_thrd_time_slice(void)
+{
+    struct tfm_core_thread_t *pth = CURR_THRD;
+    uint32_t primask;
+
+    if (!time_slice_expired) {
+        return;
+    }
+    time_slice_expired = 0;
+
+    if (!pth || get_prior_level(pth) == THRD_PRIOR_LEVEL_NUM - 1) {
+        return;
+    }
+
+    /* Secure interrupt handlers may change the ready queue as well */
+    primask = __get_PRIMASK();
+    __disable_irq();
+    tfm_core_thrd_yield(pth);
+    __set_PRIMASK(primask);
+}
+#endif
+
 /* Scheduling won't happen immediately but after the exception returns */
+TFM_HOT_CODE
 void tfm_core_thrd_activate_schedule(void)
 {
     tfm_arch_trigger_pendsv();
@@ -148,9 +251,18 @@ void tfm_core_thrd_start_scheduler(struct tfm_core_thread_t *pth)
 
     CURR_THRD = pth;
 
+#ifdef TFM_THRD_TIME_SLICE
+    if (SysTick_Config(SystemCoreClock / 1000000U * TFM_THRD_TIME_SLICE_US)) {
+        tfm_core_panic();
+    }
+    /* Keep the tick unmaskable by the NSPE, as PendSV is */
+    NVIC_SetPriority(SysTick_IRQn, NVIC_GetPriority(PendSV_IRQn));
+#endif
+
     tfm_core_thrd_activate_schedule();
 }
 
+TFM_HOT_CODE
 void tfm_core_thrd_switch_context(struct tfm_arch_ctx_t *p_actx,
                                   struct tfm_core_thread_t *prev,
                                   struct tfm_core_thread_t *next)
@@ -167,4 +279,9 @@ void tfm_core_thrd_switch_context(struct tfm_arch_ctx_t *p_actx,
 
     /* Update current thread indicator */
     CURR_THRD = next;
+
+#ifdef TFM_THRD_TIME_SLICE
+    /* The thread switched in starts a full quantum */
+    SysTick->VAL = 0;
+#endif
 }
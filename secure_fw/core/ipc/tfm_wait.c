@@ -8,6 +8,7 @@
 #include "tfm_utils.h"
 #include "tfm_wait.h"
 
+TFM_HOT_CODE
 void tfm_event_wait(struct tfm_event_t *pevnt)
 {
     TFM_CORE_ASSERT(pevnt && pevnt->magic == TFM_EVENT_MAGIC);
@@ -17,6 +18,7 @@ void tfm_event_wait(struct tfm_event_t *pevnt)
     tfm_core_thrd_activate_schedule();
 }
 
+TFM_HOT_CODE
 void tfm_event_wake(struct tfm_event_t *pevnt, uint32_t retval)
 {
     TFM_CORE_ASSERT(pevnt && pevnt->magic == TFM_EVENT_MAGIC);
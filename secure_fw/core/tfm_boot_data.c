@@ -14,6 +14,11 @@
 #include "secure_fw/spm/spm_api.h"
 #include "tfm_core_utils.h"
 #include "spm_partition_defs.h"
+#ifdef TFM_BOOT_TIME
+#include "tfm_arch.h"
+#include "tfm_boot_time_defs.h"
+#include "tfm_cycle_counter.h"
+#endif
 #ifdef TFM_PSA_API
 #include "tfm_internal_defines.h"
 #include "tfm_utils.h"
@@ -70,6 +75,9 @@ struct boot_data_access_policy {
  */
 static const struct boot_data_access_policy access_policy_table[] = {
     {TFM_SP_INITIAL_ATTESTATION, TLV_MAJOR_IAS},
+#ifdef TFM_BOOT_TIME
+    {TFM_SP_PLATFORM, TLV_MAJOR_BOOT_TIME},
+#endif
 };
 
 /*!
@@ -118,6 +126,62 @@ static int32_t tfm_core_check_boot_data_access_policy(uint8_t major_type)
 #error "Shared data area and non-secure data area is overlapping"
 #endif
 
+#ifdef TFM_BOOT_TIME
+/*!
+ * \var boot_time_entries
+ *
+ * \brief Boot stages of the secure image, added to the shared data area by
+ *        \ref tfm_core_boot_time_save.
+ */
+static struct tfm_boot_time_entry_t boot_time_entries[TFM_BOOT_TIME_S_ENTRIES];
+static uint32_t boot_time_cnt;
+
+void tfm_core_boot_time_record(uint32_t stage)
+{
+    if (boot_time_cnt >= TFM_BOOT_TIME_S_ENTRIES) {
+        return;
+    }
+
+    boot_time_entries[boot_time_cnt].stage = stage;
+    /* The counter was started by BL2 and has kept running since */
+    boot_time_entries[boot_time_cnt].cycles = tfm_cycle_counter_read();
+    boot_time_cnt++;
+}
+
+void tfm_core_boot_time_save(uint32_t stage)
+{
+    struct tfm_boot_data *boot_data;
+    struct shared_data_tlv_entry tlv_entry;
+    uint8_t *next_tlv;
+
+    tfm_core_boot_time_record(stage);
+
+    boot_data = (struct tfm_boot_data *)BOOT_TFM_SHARED_DATA_BASE;
+    tlv_entry.tlv_type = SET_TLV_TYPE(TLV_MAJOR_BOOT_TIME,
+                                      TLV_MINOR_BOOT_TIME_SPE);
+    tlv_entry.tlv_len = SHARED_DATA_ENTRY_SIZE(boot_time_cnt *
+                                               sizeof(boot_time_entries[0]));
+
+    /* The timeline is appended to the entries added by the bootloader, if
+     * they are valid and there is room left.
+     */
+    if ((is_boot_data_valid != BOOT_DATA_VALID) ||
+        (boot_data->header.tlv_tot_len >
+         BOOT_TFM_SHARED_DATA_SIZE - tlv_entry.tlv_len)) {
+        return;
+    }
+
+    next_tlv = (uint8_t *)boot_data + boot_data->header.tlv_tot_len;
+    (void)tfm_core_util_memcpy(next_tlv, &tlv_entry,
+                               SHARED_DATA_ENTRY_HEADER_SIZE);
+    (void)tfm_core_util_memcpy(next_tlv + SHARED_DATA_ENTRY_HEADER_SIZE,
+                               boot_time_entries,
+                               tlv_entry.tlv_len -
+                               SHARED_DATA_ENTRY_HEADER_SIZE);
+    boot_data->header.tlv_tot_len += tlv_entry.tlv_len;
+}
+#endif /* TFM_BOOT_TIME */
+
 void tfm_core_validate_boot_data(void)
 {
 #ifdef BOOT_DATA_AVAILABLE
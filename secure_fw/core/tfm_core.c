@@ -20,6 +20,9 @@
 #include "tfm_version.h"
 #include "spm_db.h"
 #include "log/tfm_log.h"
+#ifdef TFM_BOOT_TIME
+#include "tfm_boot_time_defs.h"
+#endif
 #ifdef TFM_PSA_API
 #include "psa/client.h"
 #include "psa/service.h"
@@ -58,6 +61,9 @@ int32_t tfm_core_init(void)
     enum tfm_plat_err_t plat_err = TFM_PLAT_ERR_SYSTEM_ERR;
     enum irq_target_state_t irq_target_state = TFM_IRQ_TARGET_STATE_SECURE;
 
+    /* Enables lazy preservation of the FP context */
+    tfm_arch_configure_fp();
+
     /* Enables fault handlers */
     plat_err = tfm_spm_hal_enable_fault_handlers();
     if (plat_err != TFM_PLAT_ERR_SUCCESS) {
@@ -201,9 +207,17 @@ int main(void)
     tfm_arch_set_msplim((uint32_t)&REGION_NAME(Image$$, ARM_LIB_STACK_MSP,
                                                $$ZI$$Base));
 
+#ifdef TFM_BOOT_TIME
+    tfm_core_boot_time_record(TFM_BOOT_TIME_S_START);
+#endif
+
     if (tfm_core_init() != TFM_SUCCESS) {
         tfm_core_panic();
     }
+
+#ifdef TFM_BOOT_TIME
+    tfm_core_boot_time_record(TFM_BOOT_TIME_S_CORE_INIT);
+#endif
     /* Print the TF-M version */
     LOG_MSG("\033[1;34mBooting TFM v%d.%d %s\033[0m\r\n",
             VERSION_MAJOR, VERSION_MINOR, VERSION_STRING);
@@ -233,6 +247,10 @@ int main(void)
          */
     }
 
+#ifdef TFM_BOOT_TIME
+    tfm_core_boot_time_record(TFM_BOOT_TIME_S_SPM_INIT);
+#endif
+
     /*
      * Prioritise secure exceptions to avoid NS being able to pre-empt
      * secure SVC or SecureFault. Do it before PSA API initialization.
@@ -253,6 +271,10 @@ int main(void)
     LOG_MSG("\033[1;34mJumping to non-secure code...\033[0m\r\n");
 #endif
 
+#ifdef TFM_BOOT_TIME
+    tfm_core_boot_time_save(TFM_BOOT_TIME_S_NS_START);
+#endif
+
     jump_to_ns_code();
 #else /* !defined(TFM_PSA_API) */
     /*
@@ -18,6 +18,9 @@
 #include "tfm_arch.h"
 #include "tfm_peripherals_def.h"
 #include "tfm_irq_list.h"
+#include "tfm_spm_stats.h"
+#include "tfm_spm_profile.h"
+#include "tfm_resource_usage.h"
 
 #ifdef PLATFORM_SVC_HANDLERS
 extern int32_t platform_svc_handlers(tfm_svc_number_t svc_num,
@@ -86,6 +89,24 @@ uint32_t tfm_core_svc_handler(uint32_t *svc_args, uint32_t lr, uint32_t *msp)
     case TFM_SVC_GET_BOOT_DATA:
         tfm_core_get_boot_data_handler(svc_args);
         break;
+#ifdef TFM_SPM_STATS
+    case TFM_SVC_GET_SPM_STATS:
+        svc_args[0] = tfm_spm_stats_get_handler(svc_args);
+        break;
+#endif
+#ifdef TFM_SPM_PROFILE
+    case TFM_SVC_GET_SPM_PROFILE:
+        svc_args[0] = tfm_spm_profile_get_handler(svc_args);
+        break;
+#endif
+#ifdef TFM_RESOURCE_USAGE
+    case TFM_SVC_RESOURCE_USAGE_REGISTER:
+        svc_args[0] = tfm_resource_usage_register_handler(svc_args);
+        break;
+    case TFM_SVC_GET_RESOURCE_USAGE:
+        svc_args[0] = tfm_resource_usage_get_handler(svc_args);
+        break;
+#endif
     default:
 #ifdef PLATFORM_SVC_HANDLERS
         svc_args[0] = platform_svc_handlers(svc_num, svc_args, lr);
@@ -13,6 +13,11 @@
 #include "tfm_utils.h"
 #include "tfm_svcalls.h"
 #include "spm_api.h"
+#include "tfm_ipc_trace.h"
+#include "tfm_spm_stats.h"
+#include "tfm_spm_profile.h"
+#include "tfm_resource_usage.h"
+#include "tfm_shm.h"
 
 uint32_t tfm_core_svc_handler(uint32_t *svc_args, uint32_t exc_return)
 {
@@ -34,6 +39,9 @@ uint32_t tfm_core_svc_handler(uint32_t *svc_args, uint32_t exc_return)
          */
         tfm_core_panic();
     }
+
+    TFM_IPC_TRACE_POINT(TFM_IPC_TRACE_SVC_ENTER, svc_number);
+
     switch (svc_number) {
     case TFM_SVC_HANDLER_MODE:
         tfm_arch_clear_fp_status();
@@ -42,11 +50,41 @@ uint32_t tfm_core_svc_handler(uint32_t *svc_args, uint32_t exc_return)
     case TFM_SVC_GET_BOOT_DATA:
         tfm_core_get_boot_data_handler(svc_args);
         break;
+#ifdef TFM_IPC_TRACE
+    case TFM_SVC_GET_IPC_TRACE:
+        svc_args[0] = tfm_ipc_trace_get_handler(svc_args);
+        break;
+#endif
+#ifdef TFM_SPM_STATS
+    case TFM_SVC_GET_SPM_STATS:
+        svc_args[0] = tfm_spm_stats_get_handler(svc_args);
+        break;
+#endif
+#ifdef TFM_SPM_PROFILE
+    case TFM_SVC_GET_SPM_PROFILE:
+        svc_args[0] = tfm_spm_profile_get_handler(svc_args);
+        break;
+#endif
+#ifdef TFM_RESOURCE_USAGE
+    case TFM_SVC_RESOURCE_USAGE_REGISTER:
+        svc_args[0] = tfm_resource_usage_register_handler(svc_args);
+        break;
+    case TFM_SVC_GET_RESOURCE_USAGE:
+        svc_args[0] = tfm_resource_usage_get_handler(svc_args);
+        break;
+#endif
+#ifdef TFM_SHM_CHANNELS
+    case TFM_SVC_SHM_GET:
+        svc_args[0] = tfm_shm_get_handler(svc_args);
+        break;
+#endif
     default:
         svc_args[0] = SVC_Handler_IPC(svc_number, svc_args, exc_return);
         break;
     }
 
+    TFM_IPC_TRACE_POINT(TFM_IPC_TRACE_SVC_EXIT, svc_number);
+
     return exc_return;
 }
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -8,6 +8,10 @@
 #include <stdint.h>
 #include "tfm_utils.h"
 #include "tfm_core_utils.h"
+#include "tfm_arch.h"
+
+/* Copies shorter than this are done byte by byte */
+#define TFM_CORE_UTIL_WORD_COPY_MIN     (4 * sizeof(uint32_t))
 
 union tfm_core_addr_t {
     uintptr_t uint_addr;
@@ -15,37 +19,69 @@ union tfm_core_addr_t {
     uint32_t *p_word;
 };
 
+/*
+ * Copy words from a source which is not word-aligned to a word-aligned
+ * destination. Each destination word is merged from two aligned source words,
+ * so only aligned words holding at least one source byte are loaded.
+ */
+TFM_HOT_CODE
+static void copy_words_shift_merge(uint32_t *dest, const uint8_t *src,
+                                   size_t nwords)
+{
+    union tfm_core_addr_t p_src;
+    uint32_t shift;
+    uint32_t prev, next;
+
+    p_src.p_byte = (uint8_t *)src;
+    shift = (p_src.uint_addr & (sizeof(uint32_t) - 1)) * 8;
+    p_src.uint_addr &= ~(sizeof(uint32_t) - 1);
+
+    prev = *p_src.p_word++;
+    while (nwords--) {
+        next = *p_src.p_word++;
+        /* Little-endian: lower addressed bytes go to lower bits */
+        *dest++ = (prev >> shift) | (next << (32 - shift));
+        prev = next;
+    }
+}
+
+TFM_HOT_CODE
 void *tfm_core_util_memcpy(void *dest, const void *src, size_t n)
 {
     union tfm_core_addr_t p_dest;
     union tfm_core_addr_t p_src;
+    size_t nwords;
 
     TFM_CORE_ASSERT(dest != src);
 
     p_dest.p_byte = (uint8_t *)dest;
     p_src.p_byte = (uint8_t *)src;
 
-    /*
-     * Check src and dest address value to see if word-copy is applicable.
-     * If applicable, use byte-copy for the first several unaligned bytes,
-     * and then, word-copy for aligned memory.
-     */
-    if (!((p_dest.uint_addr ^ p_src.uint_addr) & (sizeof(uint32_t) - 1))) {
-        while (n && (p_dest.uint_addr & (sizeof(uint32_t) - 1))) {
+    /* Short copies do not pay back the alignment work */
+    if (n >= TFM_CORE_UTIL_WORD_COPY_MIN) {
+        /* Use byte-copy until the destination is word-aligned */
+        while (p_dest.uint_addr & (sizeof(uint32_t) - 1)) {
             *p_dest.p_byte++ = *p_src.p_byte++;
             n--;
         }
 
-        while (n >= sizeof(uint32_t)) {
-            *p_dest.p_word++ = *p_src.p_word++;
-            n -= sizeof(uint32_t);
+        nwords = n / sizeof(uint32_t);
+        if (!(p_src.uint_addr & (sizeof(uint32_t) - 1))) {
+            /* Both aligned, copy in bursts of words */
+            tfm_arch_copy_words(p_dest.p_word, p_src.p_word, nwords);
+        } else {
+#if defined(__ARM_BIG_ENDIAN)
+            nwords = 0;
+#else
+            copy_words_shift_merge(p_dest.p_word, p_src.p_byte, nwords);
+#endif
         }
+        p_dest.p_word += nwords;
+        p_src.p_byte += nwords * sizeof(uint32_t);
+        n -= nwords * sizeof(uint32_t);
     }
 
-    /*
-     * Word-copy is not applicable, use byte-copy for the remaining
-     * unaligned memory.
-     */
+    /* Use byte-copy for the remaining bytes */
     while (n--) {
         *p_dest.p_byte++ = *p_src.p_byte++;
     }
@@ -67,6 +103,16 @@ void *tfm_core_util_memset(void *s, int c, size_t n)
         n--;
     }
 
+    /* Unrolled so that the compiler can merge the stores into STM/STRD */
+    while (n >= 4 * sizeof(uint32_t)) {
+        p_mem.p_word[0] = quad_pattern;
+        p_mem.p_word[1] = quad_pattern;
+        p_mem.p_word[2] = quad_pattern;
+        p_mem.p_word[3] = quad_pattern;
+        p_mem.p_word += 4;
+        n -= 4 * sizeof(uint32_t);
+    }
+
     while (n >= sizeof(uint32_t)) {
         *p_mem.p_word++ = quad_pattern;
         n -= sizeof(uint32_t);
@@ -30,6 +30,13 @@
 #error TFM_LVL is not defined!
 #endif
 
+#if defined(TFM_SFN_TRUSTED_CALLS) && (TFM_LVL != 1)
+/* Above isolation level 1 the partitions cannot access each other's memory,
+ * so the iovecs passed between them must always be checked.
+ */
+#error "TFM_SFN_TRUSTED_CALLS is only supported with TFM_LVL 1!"
+#endif
+
 /* Macros to pick linker symbols and allow references to sections */
 #define REGION(a, b, c) a##b##c
 #define REGION_NAME(a, b, c) REGION(a, b, c)
@@ -148,6 +155,19 @@ static enum tfm_status_e tfm_core_check_sfn_parameters(
         return TFM_ERROR_INVALID_PARAMETER;
     }
 
+#ifdef TFM_SFN_TRUSTED_CALLS
+    /* In isolation level 1 a secure partition has access to all the secure
+     * partition memory anyway, so the buffer access checks are skipped if the
+     * caller declared the called partition as trusted in its manifest.
+     */
+    if (!desc_ptr->ns_caller &&
+        (desc_ptr->caller_part_idx != SPM_INVALID_PARTITION_IDX) &&
+        tfm_spm_partition_is_trusted_callee(desc_ptr->caller_part_idx,
+                                            desc_ptr->sp_id)) {
+        return TFM_SUCCESS;
+    }
+#endif
+
     /* Check whether the caller partition has at write access to the iovec
      * structures themselves. Use the TT instruction for this.
      */
@@ -413,6 +433,73 @@ static enum tfm_status_e tfm_start_partition(
     return TFM_SUCCESS;
 }
 
+#ifdef TFM_SFN_FAST_PATH
+/**
+ * \brief Enter the partition of a fast path secure function called from the
+ *        non-secure world.
+ *
+ * The partition state is updated in the same way as in
+ * \ref tfm_start_partition, but there is no stack or context switch: the
+ * secure function is to be called on the current (SPM) stack.
+ *
+ * \param[in]  desc_ptr    The secure function request descriptor
+ * \param[out] iovec_args  Where the validated iovecs are copied to
+ *
+ * \return \ref TFM_SUCCESS if the partition is entered, error otherwise.
+ */
+static enum tfm_status_e tfm_start_partition_fast(
+                                           const struct tfm_sfn_req_s *desc_ptr,
+                                           struct iovec_args_t *iovec_args)
+{
+    enum tfm_status_e res;
+    uint32_t caller_partition_idx = desc_ptr->caller_part_idx;
+    const struct spm_partition_runtime_data_t *curr_part_data;
+    const struct spm_partition_runtime_data_t *caller_part_data;
+    uint32_t partition_idx;
+    int32_t client_id;
+
+    if (!desc_ptr->ns_caller ||
+        (tfm_spm_partition_get_flags(caller_partition_idx) &
+         SPM_PART_FLAG_APP_ROT)) {
+        /* Partition state inconsistency detected */
+        return TFM_SECURE_LOCK_FAILED;
+    }
+
+    partition_idx = get_partition_idx(desc_ptr->sp_id);
+
+    curr_part_data = tfm_spm_partition_get_runtime_data(partition_idx);
+    caller_part_data = tfm_spm_partition_get_runtime_data(caller_partition_idx);
+
+    res = check_partition_state(curr_part_data->partition_state,
+                                caller_part_data->partition_state);
+    if (res != TFM_SUCCESS) {
+        return res;
+    }
+
+    client_id = tfm_nspm_get_current_client_id();
+    if (client_id >= 0) {
+        return TFM_SECURE_LOCK_FAILED;
+    }
+
+    if (tfm_spm_partition_set_iovec(partition_idx, desc_ptr->args) !=
+        SPM_ERR_OK) {
+        return TFM_ERROR_GENERIC;
+    }
+    tfm_copy_iovec_parameters(iovec_args, &(curr_part_data->iovec_args));
+
+    tfm_spm_partition_set_caller_partition_idx(partition_idx,
+                                               caller_partition_idx);
+    tfm_spm_partition_set_caller_client_id(partition_idx, client_id);
+
+    tfm_spm_partition_set_state(caller_partition_idx,
+                                SPM_PARTITION_STATE_BLOCKED);
+    tfm_spm_partition_set_state(partition_idx, SPM_PARTITION_STATE_RUNNING);
+    tfm_secure_lock++;
+
+    return TFM_SUCCESS;
+}
+#endif /* TFM_SFN_FAST_PATH */
+
 static enum tfm_status_e tfm_start_partition_for_irq_handling(
                                                 uint32_t excReturn,
                                                 struct tfm_state_context_t *svc_ctx)
@@ -538,6 +625,53 @@ static enum tfm_status_e tfm_return_from_partition(uint32_t *excReturn)
     return TFM_SUCCESS;
 }
 
+#ifdef TFM_SFN_FAST_PATH
+/**
+ * \brief Leave the partition of a fast path secure function, and pass the
+ *        written output lengths back to the non-secure caller.
+ *
+ * \param[in,out] iovec_args  The iovecs the secure function was called with
+ *
+ * \return \ref TFM_SUCCESS if the partition is left, error otherwise.
+ */
+static enum tfm_status_e tfm_return_from_partition_fast(
+                                                struct iovec_args_t *iovec_args)
+{
+    uint32_t current_partition_idx =
+            tfm_spm_partition_get_running_partition_idx();
+    const struct spm_partition_runtime_data_t *curr_part_data;
+    uint32_t return_partition_idx;
+    size_t i;
+
+    if (current_partition_idx == SPM_INVALID_PARTITION_IDX) {
+        return TFM_SECURE_UNLOCK_FAILED;
+    }
+
+    curr_part_data = tfm_spm_partition_get_runtime_data(current_partition_idx);
+    return_partition_idx = curr_part_data->caller_partition_idx;
+
+    if (return_partition_idx == SPM_INVALID_PARTITION_IDX) {
+        return TFM_SECURE_UNLOCK_FAILED;
+    }
+
+    tfm_secure_lock--;
+
+    for (i = 0; i < curr_part_data->iovec_args.out_len; ++i) {
+        curr_part_data->orig_outvec[i].len = iovec_args->out_vec[i].len;
+    }
+    tfm_clear_iovec_parameters(iovec_args);
+
+    tfm_spm_partition_cleanup_context(current_partition_idx);
+
+    tfm_spm_partition_set_state(current_partition_idx,
+                                SPM_PARTITION_STATE_IDLE);
+    tfm_spm_partition_set_state(return_partition_idx,
+                                SPM_PARTITION_STATE_RUNNING);
+
+    return TFM_SUCCESS;
+}
+#endif /* TFM_SFN_FAST_PATH */
+
 static enum tfm_status_e tfm_return_from_partition_irq_handling(
                                                             uint32_t *excReturn)
 {
@@ -675,6 +809,11 @@ int32_t tfm_core_sfn_request_thread_mode(struct tfm_sfn_req_s *desc_ptr)
     int32_t *args;
     int32_t retVal;
 
+#ifdef TFM_SFN_TRUSTED_CALLS
+    /* The caller is needed to find out whether the callee is trusted */
+    desc_ptr->caller_part_idx = tfm_spm_partition_get_running_partition_idx();
+#endif
+
     res = tfm_core_check_sfn_parameters(desc_ptr);
     if (res != TFM_SUCCESS) {
         /* The sanity check of iovecs failed. */
@@ -707,6 +846,74 @@ int32_t tfm_core_sfn_request_thread_mode(struct tfm_sfn_req_s *desc_ptr)
     return (int32_t)res;
 }
 
+#ifdef TFM_SFN_FAST_PATH
+int32_t tfm_core_sfn_request_fast(struct tfm_sfn_req_s *desc_ptr)
+{
+    enum tfm_status_e res;
+    struct iovec_args_t iovec_args;
+    int32_t retVal;
+
+    res = tfm_check_sfn_req_integrity(desc_ptr);
+    if (res != TFM_SUCCESS) {
+        ERROR_MSG("Invalid service request!");
+        tfm_secure_api_error_handler();
+    }
+
+    __disable_irq();
+
+    desc_ptr->caller_part_idx = tfm_spm_partition_get_running_partition_idx();
+
+    res = tfm_core_check_sfn_parameters(desc_ptr);
+    if (res != TFM_SUCCESS) {
+        /* The sanity check of iovecs failed. */
+        __enable_irq();
+        tfm_secure_api_error_handler();
+    }
+
+    res = tfm_core_check_sfn_req_rules(desc_ptr);
+    if (res != TFM_SUCCESS) {
+        /* FixMe: error compartmentalization TBD */
+        tfm_spm_partition_set_state(
+            desc_ptr->caller_part_idx, SPM_PARTITION_STATE_CLOSED);
+        __enable_irq();
+        ERROR_MSG("Unauthorized service request!");
+        tfm_secure_api_error_handler();
+    }
+
+    /* The iovecs are copied to this stack frame while the interrupts are
+     * still disabled, so the secure function only sees the validated copy.
+     */
+    res = tfm_start_partition_fast(desc_ptr, &iovec_args);
+    if (res != TFM_SUCCESS) {
+        __enable_irq();
+        ERROR_MSG("Failed to process service request!");
+        tfm_secure_api_error_handler();
+    }
+
+    __enable_irq();
+
+    /* Call the secure function directly on the SPM stack */
+    retVal = desc_ptr->sfn((int32_t)iovec_args.in_vec,
+                           (int32_t)iovec_args.in_len,
+                           (int32_t)iovec_args.out_vec,
+                           (int32_t)iovec_args.out_len);
+
+    __disable_irq();
+    res = tfm_return_from_partition_fast(&iovec_args);
+    __enable_irq();
+
+    if (res != TFM_SUCCESS) {
+        /* Unlock errors indicate ctx database corruption or unknown
+         * anomalies. Halt execution
+         */
+        ERROR_MSG("Secure API error during unlock!");
+        tfm_secure_api_error_handler();
+    }
+
+    return retVal;
+}
+#endif /* TFM_SFN_FAST_PATH */
+
 void tfm_core_validate_secure_caller_handler(uint32_t *svc_args)
 {
 
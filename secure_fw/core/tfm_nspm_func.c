@@ -35,6 +35,13 @@ static struct ns_client_list_t {
 static int32_t free_index = 0U;
 static int32_t active_ns_client_idx = INVALID_NS_CLIENT_IDX;
 
+/*
+ * The word in which NS RTOS publishes the TZ context ID of the running thread,
+ * instead of calling TZ_LoadContext_S() and TZ_StoreContext_S(). NULL until
+ * NS RTOS registers it.
+ */
+static const volatile TZ_MemoryId_t *ns_ctx_slot = NULL;
+
 static int get_next_ns_client_id()
 {
     static int32_t next_ns_client_id = DEFAULT_NS_CLIENT_ID;
@@ -44,6 +51,30 @@ static int get_next_ns_client_id()
     }
     return next_ns_client_id--;
 }
+
+/*
+ * Take the active client from the context slot if NS RTOS publishes it there.
+ * The slot is only read on a secure call, so that an NS thread switch costs no
+ * secure entry.
+ */
+static void sync_active_ns_client(void)
+{
+    TZ_MemoryId_t id;
+
+    if (!ns_ctx_slot) {
+        return;
+    }
+
+    id = *ns_ctx_slot;
+    if ((id == 0U) || (id > TFM_MAX_NS_THREAD_COUNT) ||
+        (NsClientIdList[id - 1].ns_client_id == INVALID_CLIENT_ID)) {
+        /* The thread has no secure context */
+        active_ns_client_idx = DEFAULT_NS_CLIENT_IDX;
+        return;
+    }
+
+    active_ns_client_idx = id - 1;
+}
 #endif /* TFM_NS_CLIENT_IDENTIFICATION */
 
 void tfm_nspm_configure_clients(void)
@@ -64,6 +95,8 @@ void tfm_nspm_configure_clients(void)
 int32_t tfm_nspm_get_current_client_id(void)
 {
 #ifdef TFM_NS_CLIENT_IDENTIFICATION
+    sync_active_ns_client();
+
     if (active_ns_client_idx == INVALID_NS_CLIENT_IDX) {
         return 0;
     } else {
@@ -282,6 +315,8 @@ enum tfm_status_e tfm_register_client_id (int32_t ns_client_id)
         return TFM_ERROR_INVALID_PARAMETER;
     }
 
+    sync_active_ns_client();
+
     if (active_ns_client_idx < 0) {
         /* No client is active */
         return TFM_ERROR_GENERIC;
@@ -297,6 +332,42 @@ enum tfm_status_e tfm_register_client_id (int32_t ns_client_id)
 
     return TFM_SUCCESS;
 }
+
+__attribute__((cmse_nonsecure_entry))
+enum tfm_status_e tfm_register_ns_ctx_slot(const volatile uint32_t *slot)
+{
+    if (__get_active_exc_num() == EXC_NUM_THREAD_MODE) {
+        /* This veneer should only be called by NS RTOS in handler mode */
+        return TFM_ERROR_NS_THREAD_MODE_CALL;
+    }
+
+    if (!slot) {
+        /* Back to TZ_LoadContext_S() and TZ_StoreContext_S() */
+        ns_ctx_slot = NULL;
+        return TFM_SUCCESS;
+    }
+
+    if (((uintptr_t)slot & (sizeof(*slot) - 1)) != 0) {
+        return TFM_ERROR_INVALID_PARAMETER;
+    }
+
+    /* The slot must be readable by NS RTOS */
+    if (cmse_check_address_range((void *)slot, sizeof(*slot),
+                                 CMSE_NONSECURE | CMSE_MPU_READ) == NULL) {
+        return TFM_ERROR_INVALID_PARAMETER;
+    }
+
+    /* An unprivileged NS thread must not be able to pose as another one */
+    if (cmse_check_address_range((void *)slot, sizeof(*slot),
+                                 CMSE_NONSECURE | CMSE_MPU_UNPRIV |
+                                 CMSE_MPU_READWRITE) != NULL) {
+        return TFM_ERROR_INVALID_PARAMETER;
+    }
+
+    ns_ctx_slot = (const volatile TZ_MemoryId_t *)slot;
+
+    return TFM_SUCCESS;
+}
 #endif
 
 void configure_ns_code(void)
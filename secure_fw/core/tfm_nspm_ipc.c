@@ -13,6 +13,9 @@
 #include "tfm_internal.h"
 #include "log/tfm_assert.h"
 #include "log/tfm_log.h"
+#ifdef TFM_MULTI_NS_MAILBOX
+#include "tfm_rpc.h"
+#endif
 
 #define DEFAULT_NS_CLIENT_ID ((int32_t)-1)
 
@@ -26,6 +29,15 @@ void tfm_nspm_configure_clients(void)
 
 int32_t tfm_nspm_get_current_client_id(void)
 {
+#ifdef TFM_MULTI_NS_MAILBOX
+    int32_t client_id;
+
+    /* Each NS core has its own range of client IDs */
+    if (tfm_rpc_get_client_id(&client_id)) {
+        return client_id;
+    }
+#endif
+
     return DEFAULT_NS_CLIENT_ID;
 }
 
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "tfm_api.h"
+#include "tfm_resource_usage.h"
+#include "tfm_internal.h"
+#include "tfm_utils.h"
+#include "spm_api.h"
+#include "spm_db.h"
+#include "spm_partition_defs.h"
+#include "psa_manifest/pid.h"
+#ifdef TFM_PSA_API
+#include "tfm_internal_defines.h"
+#endif
+
+struct tfm_resource_usage_entry_t {
+    uint32_t resource_id;           /* TFM_RESOURCE_* ID of the pool       */
+    int32_t partition_id;           /* Partition owning the pool           */
+    const struct tfm_resource_usage_t *usage; /* Record of a partition     */
+    tfm_resource_usage_get_t get;   /* Function reading a pool of the core */
+};
+
+static struct tfm_resource_usage_entry_t
+    resource_usage[TFM_RESOURCE_USAGE_ENTRIES];
+static uint32_t resource_usage_num;
+
+static int32_t resource_usage_add(uint32_t resource_id, int32_t partition_id,
+                                  const struct tfm_resource_usage_t *usage,
+                                  tfm_resource_usage_get_t get)
+{
+    uint32_t i;
+
+    if (resource_usage_num >= TFM_RESOURCE_USAGE_ENTRIES) {
+        return TFM_ERROR_GENERIC;
+    }
+
+    /* A pool is only reported once */
+    for (i = 0; i < resource_usage_num; i++) {
+        if ((resource_usage[i].resource_id == resource_id) &&
+            (resource_usage[i].partition_id == partition_id)) {
+            return TFM_ERROR_GENERIC;
+        }
+    }
+
+    resource_usage[resource_usage_num].resource_id = resource_id;
+    resource_usage[resource_usage_num].partition_id = partition_id;
+    resource_usage[resource_usage_num].usage = usage;
+    resource_usage[resource_usage_num].get = get;
+    resource_usage_num++;
+
+    return TFM_SUCCESS;
+}
+
+int32_t tfm_resource_usage_add_core(uint32_t resource_id,
+                                    tfm_resource_usage_get_t get)
+{
+    if (get == NULL) {
+        return TFM_ERROR_GENERIC;
+    }
+
+    return resource_usage_add(resource_id, TFM_SP_CORE_ID, NULL, get);
+}
+
+uint32_t tfm_resource_usage_register_handler(uint32_t *args)
+{
+    struct tfm_resource_usage_t *usage;
+    int32_t partition_id;
+#ifdef TFM_PSA_API
+    struct spm_partition_desc_t *partition;
+    uint32_t privileged;
+#else
+    uint32_t running_idx;
+#endif
+
+    TFM_CORE_ASSERT(args != NULL);
+    usage = (struct tfm_resource_usage_t *)args[0];
+
+    /*
+     * The record stays in the memory of the partition, which updates it as
+     * the pool is used.
+     */
+#ifdef TFM_PSA_API
+    partition = tfm_spm_get_running_partition();
+    if (!partition) {
+        tfm_core_panic();
+    }
+    privileged = tfm_spm_partition_get_privileged_mode(
+        partition->static_data->partition_flags);
+
+    if (tfm_memory_check(usage, sizeof(*usage), false,
+                         TFM_MEMORY_ACCESS_RW, privileged) != IPC_SUCCESS) {
+        tfm_core_panic();
+    }
+    partition_id = (int32_t)partition->static_data->partition_id;
+#else
+    running_idx = tfm_spm_partition_get_running_partition_idx();
+    if (!tfm_core_check_buffer_access(running_idx, usage, sizeof(*usage),
+                                      2)) { /* Check 4 bytes alignment */
+        tfm_core_panic();
+    }
+    partition_id = (int32_t)tfm_spm_partition_get_partition_id(running_idx);
+#endif
+
+    usage->partition_id = partition_id;
+
+    return (uint32_t)resource_usage_add(usage->resource_id, partition_id,
+                                        usage, NULL);
+}
+
+uint32_t tfm_resource_usage_get_handler(uint32_t *args)
+{
+    struct tfm_resource_usage_t *entries;
+    const struct tfm_resource_usage_entry_t *entry;
+    uint32_t first, num, i;
+#ifdef TFM_PSA_API
+    struct spm_partition_desc_t *partition;
+    uint32_t privileged;
+#else
+    uint32_t running_idx;
+#endif
+
+    TFM_CORE_ASSERT(args != NULL);
+    first = args[0];
+    entries = (struct tfm_resource_usage_t *)args[1];
+    num = args[2];
+
+    /* Bound the copy, the caller reads the rest from a later first index */
+    if (num > TFM_RESOURCE_USAGE_ENTRIES) {
+        num = TFM_RESOURCE_USAGE_ENTRIES;
+    }
+
+    /* The usage is only handed out through the platform service */
+#ifdef TFM_PSA_API
+    partition = tfm_spm_get_running_partition();
+    if (!partition ||
+        partition->static_data->partition_id != TFM_SP_PLATFORM) {
+        tfm_core_panic();
+    }
+    privileged = tfm_spm_partition_get_privileged_mode(
+        partition->static_data->partition_flags);
+
+    if (tfm_memory_check(entries, num * sizeof(*entries), false,
+                         TFM_MEMORY_ACCESS_RW, privileged) != IPC_SUCCESS) {
+        tfm_core_panic();
+    }
+#else
+    running_idx = tfm_spm_partition_get_running_partition_idx();
+    if (tfm_spm_partition_get_partition_id(running_idx) != TFM_SP_PLATFORM) {
+        tfm_core_panic();
+    }
+
+    if (!tfm_core_check_buffer_access(running_idx, entries,
+                                      num * sizeof(*entries),
+                                      2)) { /* Check 4 bytes alignment */
+        tfm_core_panic();
+    }
+#endif
+
+    for (i = 0; (i < num) && (first + i < resource_usage_num); i++) {
+        entry = &resource_usage[first + i];
+        if (entry->get) {
+            entry->get(&entries[i]);
+        } else {
+            entries[i].used = entry->usage->used;
+            entries[i].peak = entry->usage->peak;
+            entries[i].capacity = entry->usage->capacity;
+        }
+        /* Not taken from the record, which the partition can change */
+        entries[i].resource_id = entry->resource_id;
+        entries[i].partition_id = entry->partition_id;
+    }
+
+    return i;
+}
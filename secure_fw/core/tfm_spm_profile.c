@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "tfm_arch.h"
+#include "tfm_spm_profile.h"
+#include "tfm_internal.h"
+#include "tfm_utils.h"
+#include "spm_api.h"
+#include "spm_db.h"
+#include "spm_partition_defs.h"
+#include "psa_manifest/pid.h"
+#ifdef TFM_PSA_API
+#include "tfm_internal_defines.h"
+#endif
+
+/*
+ * Armv6-M and Armv7-M have no Security Extension: the EXC_RETURN bits below
+ * read as one, the interrupted code is secure and uses the basic frame.
+ */
+#ifndef EXC_RETURN_SECURE_STACK
+#define EXC_RETURN_SECURE_STACK     (1 << 6)
+#endif
+#ifndef EXC_RETURN_STACK_RULE
+#define EXC_RETURN_STACK_RULE       (1 << 5)
+#endif
+#ifndef EXC_RETURN_MODE_THREAD
+#define EXC_RETURN_MODE_THREAD      (1 << 3)
+#endif
+
+/* Words of the additional state context stacked below the basic frame */
+#define ADDITIONAL_STATE_CTX_WORDS  10
+
+struct tfm_spm_profile_t {
+    uint32_t first;                 /* Index of the oldest sample           */
+    uint32_t count;                 /* Number of samples not read yet       */
+    struct tfm_spm_profile_sample_t samples[TFM_SPM_PROFILE_SAMPLES];
+};
+
+static struct tfm_spm_profile_t spm_profile;
+
+/*
+ * The stacked frame of the interrupted code is passed to the sampling
+ * function, from the PSP or the MSP as EXC_RETURN tells.
+ */
+__attribute__((naked)) void SysTick_Handler(void)
+{
+    __ASM volatile(
+        ".syntax unified                    \n"
+        "mov     r0, lr                     \n"
+        "mrs     r1, msp                    \n"
+        "movs    r2, #4                     \n"
+        "tst     r0, r2                     \n"
+        "beq     1f                         \n"
+        "mrs     r1, psp                    \n"
+        "1:                                 \n"
+        "push    {r0, lr}                   \n"
+        "bl      tfm_spm_profile_sample     \n"
+        "pop     {r0, pc}                   \n"
+    );
+}
+
+void tfm_spm_profile_init(void)
+{
+    spm_profile.first = 0;
+    spm_profile.count = 0;
+
+    if (SysTick_Config(SystemCoreClock / TFM_SPM_PROFILE_HZ)) {
+        tfm_core_panic();
+    }
+    /* Sample the lower priority secure handlers and PendSV too */
+    NVIC_SetPriority(SysTick_IRQn, 0);
+}
+
+void tfm_spm_profile_sample(uint32_t exc_return, const uint32_t *frame)
+{
+    struct tfm_spm_profile_sample_t *sample;
+    uint32_t idx;
+
+    idx = spm_profile.first + spm_profile.count;
+    if (idx >= TFM_SPM_PROFILE_SAMPLES) {
+        idx -= TFM_SPM_PROFILE_SAMPLES;
+    }
+
+    /* Overwrite the oldest sample once the buffer is full */
+    if (spm_profile.count == TFM_SPM_PROFILE_SAMPLES) {
+        spm_profile.first = (idx + 1) % TFM_SPM_PROFILE_SAMPLES;
+    } else {
+        spm_profile.count++;
+    }
+    sample = &spm_profile.samples[idx];
+
+    /* The stack of the NSPE is not read */
+    if (!(exc_return & EXC_RETURN_SECURE_STACK)) {
+        sample->pc = 0;
+        sample->partition_id = TFM_SP_NON_SECURE_ID;
+        return;
+    }
+
+    if (!(exc_return & EXC_RETURN_STACK_RULE)) {
+        frame += ADDITIONAL_STATE_CTX_WORDS;
+    }
+    sample->pc = frame[6];
+
+    if (!(exc_return & EXC_RETURN_MODE_THREAD)) {
+        sample->partition_id = TFM_SPM_PROFILE_HANDLER_ID;
+    } else {
+#ifdef TFM_PSA_API
+        sample->partition_id =
+            (int32_t)tfm_spm_partition_get_running_partition_id();
+#else
+        sample->partition_id = (int32_t)tfm_spm_partition_get_partition_id(
+            tfm_spm_partition_get_running_partition_idx());
+#endif
+    }
+}
+
+uint32_t tfm_spm_profile_get_handler(uint32_t *args)
+{
+    struct tfm_spm_profile_sample_t *samples;
+    uint32_t num, i, primask;
+#ifdef TFM_PSA_API
+    struct spm_partition_desc_t *partition;
+    uint32_t privileged;
+#else
+    uint32_t running_idx;
+#endif
+
+    TFM_CORE_ASSERT(args != NULL);
+    samples = (struct tfm_spm_profile_sample_t *)args[0];
+    num = args[1];
+
+    if (num > TFM_SPM_PROFILE_SAMPLES) {
+        num = TFM_SPM_PROFILE_SAMPLES;
+    }
+
+    /* The samples are only handed out through the platform service */
+#ifdef TFM_PSA_API
+    partition = tfm_spm_get_running_partition();
+    if (!partition ||
+        partition->static_data->partition_id != TFM_SP_PLATFORM) {
+        tfm_core_panic();
+    }
+    privileged = tfm_spm_partition_get_privileged_mode(
+        partition->static_data->partition_flags);
+
+    if (tfm_memory_check(samples, num * sizeof(*samples), false,
+                         TFM_MEMORY_ACCESS_RW, privileged) != IPC_SUCCESS) {
+        tfm_core_panic();
+    }
+#else
+    running_idx = tfm_spm_partition_get_running_partition_idx();
+    if (tfm_spm_partition_get_partition_id(running_idx) != TFM_SP_PLATFORM) {
+        tfm_core_panic();
+    }
+
+    if (!tfm_core_check_buffer_access(running_idx, samples,
+                                      num * sizeof(*samples),
+                                      2)) { /* Check 4 bytes alignment */
+        tfm_core_panic();
+    }
+#endif
+
+    /* Keep the sampling out while the ring buffer is updated */
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (num > spm_profile.count) {
+        num = spm_profile.count;
+    }
+    for (i = 0; i < num; i++) {
+        samples[i] = spm_profile.samples[spm_profile.first];
+        spm_profile.first = (spm_profile.first + 1) % TFM_SPM_PROFILE_SAMPLES;
+    }
+    spm_profile.count -= num;
+
+    __set_PRIMASK(primask);
+
+    return num;
+}
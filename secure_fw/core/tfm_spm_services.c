@@ -61,6 +61,21 @@ int32_t tfm_spm_request_reset_vote(void)
         : : "I" (TFM_SPM_REQUEST_RESET_VOTE));
 }
 
+#ifdef TFM_PSA_API
+__attribute__((naked))
+void tfm_yield(void)
+{
+    __ASM volatile(
+        "SVC    %0\n"
+        "BX     lr\n"
+        : : "I" (TFM_SVC_YIELD));
+}
+#else
+void tfm_yield(void)
+{
+}
+#endif
+
 __attribute__((naked))
 int32_t tfm_core_get_boot_data(uint8_t major_type,
                                struct tfm_boot_data *boot_status,
@@ -72,6 +87,75 @@ int32_t tfm_core_get_boot_data(uint8_t major_type,
         : : "I" (TFM_SVC_GET_BOOT_DATA));
 }
 
+#ifdef TFM_IPC_TRACE
+__attribute__((naked))
+uint32_t tfm_core_get_ipc_trace(struct tfm_ipc_trace_entry_t *entries,
+                                uint32_t num)
+{
+    __ASM volatile(
+        "SVC    %0\n"
+        "BX     lr\n"
+        : : "I" (TFM_SVC_GET_IPC_TRACE));
+}
+#endif
+
+#ifdef TFM_SPM_STATS
+__attribute__((naked))
+uint32_t tfm_core_get_spm_stats(uint32_t type, uint32_t first, void *entries,
+                                uint32_t num)
+{
+    __ASM volatile(
+        "SVC    %0\n"
+        "BX     lr\n"
+        : : "I" (TFM_SVC_GET_SPM_STATS));
+}
+#endif
+
+#ifdef TFM_SHM_CHANNELS
+__attribute__((naked))
+void *tfm_shm_get(uint32_t shm_id)
+{
+    __ASM volatile(
+        "SVC    %0\n"
+        "BX     lr\n"
+        : : "I" (TFM_SVC_SHM_GET));
+}
+#endif
+
+#ifdef TFM_SPM_PROFILE
+__attribute__((naked))
+uint32_t tfm_core_get_spm_profile(struct tfm_spm_profile_sample_t *samples,
+                                  uint32_t num)
+{
+    __ASM volatile(
+        "SVC    %0\n"
+        "BX     lr\n"
+        : : "I" (TFM_SVC_GET_SPM_PROFILE));
+}
+#endif
+
+#ifdef TFM_RESOURCE_USAGE
+__attribute__((naked))
+int32_t tfm_core_resource_usage_register(struct tfm_resource_usage_t *usage)
+{
+    __ASM volatile(
+        "SVC    %0\n"
+        "BX     lr\n"
+        : : "I" (TFM_SVC_RESOURCE_USAGE_REGISTER));
+}
+
+__attribute__((naked))
+uint32_t tfm_core_get_resource_usage(uint32_t first,
+                                     struct tfm_resource_usage_t *entries,
+                                     uint32_t num)
+{
+    __ASM volatile(
+        "SVC    %0\n"
+        "BX     lr\n"
+        : : "I" (TFM_SVC_GET_RESOURCE_USAGE));
+}
+#endif
+
 __attribute__((naked))
 void tfm_enable_irq(psa_signal_t irq_signal)
 {
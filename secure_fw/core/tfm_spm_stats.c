@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "tfm_arch.h"
+#include "tfm_cycle_counter.h"
+#include "tfm_spm_stats.h"
+#include "tfm_internal.h"
+#include "tfm_utils.h"
+#include "tfm_core_utils.h"
+#include "secure_fw/include/tfm_spm_services_api.h"
+#include "spm_api.h"
+#include "spm_db.h"
+#include "spm_partition_defs.h"
+#include "psa_manifest/pid.h"
+#ifdef TFM_PSA_API
+#include "tfm_internal_defines.h"
+#endif
+
+/* The idle time is accounted after the partitions */
+#define SPM_STATS_IDLE_IDX          SPM_MAX_PARTITIONS
+
+extern struct spm_partition_db_t g_spm_partition_db;
+
+struct tfm_spm_stats_t {
+    uint32_t curr_idx;              /* Index of the entry being charged     */
+    uint32_t idle_prev_idx;         /* Entry charged before going idle      */
+    uint32_t mark;                  /* Cycle count of the last charge       */
+    uint32_t runs[SPM_MAX_PARTITIONS + 1];
+    uint64_t cycles[SPM_MAX_PARTITIONS + 1];
+};
+
+static struct tfm_spm_stats_t spm_stats;
+
+uint32_t tfm_spm_stats_get_cycles(void)
+{
+    return tfm_cycle_counter_read();
+}
+
+/* Charge the cycles elapsed since the last charge to the current entry */
+static void spm_stats_charge(void)
+{
+    uint32_t now = tfm_spm_stats_get_cycles();
+
+    if (spm_stats.curr_idx <= SPM_STATS_IDLE_IDX) {
+        spm_stats.cycles[spm_stats.curr_idx] += now - spm_stats.mark;
+    }
+    spm_stats.mark = now;
+}
+
+void tfm_spm_stats_init(void)
+{
+    (void)tfm_cycle_counter_start(false);
+
+    tfm_core_util_memset(&spm_stats, 0, sizeof(spm_stats));
+    /* Nothing is charged until the first partition is switched in */
+    spm_stats.curr_idx = SPM_INVALID_PARTITION_IDX;
+    spm_stats.idle_prev_idx = SPM_INVALID_PARTITION_IDX;
+}
+
+void tfm_spm_stats_switch(uint32_t partition_idx)
+{
+    if ((partition_idx == spm_stats.curr_idx) ||
+        (partition_idx >= SPM_MAX_PARTITIONS)) {
+        return;
+    }
+
+    spm_stats_charge();
+    spm_stats.curr_idx = partition_idx;
+    spm_stats.runs[partition_idx]++;
+}
+
+void tfm_spm_stats_idle_enter(void)
+{
+    spm_stats_charge();
+    spm_stats.idle_prev_idx = spm_stats.curr_idx;
+    spm_stats.curr_idx = SPM_STATS_IDLE_IDX;
+    spm_stats.runs[SPM_STATS_IDLE_IDX]++;
+}
+
+void tfm_spm_stats_idle_exit(void)
+{
+    spm_stats_charge();
+    spm_stats.curr_idx = spm_stats.idle_prev_idx;
+}
+
+/* Copy the statistics of the partitions, the idle entry last */
+static uint32_t spm_stats_get_partitions(struct tfm_spm_partition_stats_t *out,
+                                         uint32_t first, uint32_t num)
+{
+    uint32_t count = g_spm_partition_db.partition_count;
+    uint32_t i, idx;
+
+    /* Charge the running partition up to now, the caller included */
+    spm_stats_charge();
+
+    for (i = 0; (i < num) && (first + i <= count); i++) {
+        idx = first + i;
+        if (idx == count) {
+            out[i].partition_id = TFM_SPM_STATS_IDLE_ID;
+            idx = SPM_STATS_IDLE_IDX;
+        } else {
+            out[i].partition_id =
+                (int32_t)tfm_spm_partition_get_partition_id(idx);
+        }
+        out[i].runs = spm_stats.runs[idx];
+        out[i].cycles = spm_stats.cycles[idx];
+    }
+
+    return i;
+}
+
+uint32_t tfm_spm_stats_get_handler(uint32_t *args)
+{
+    uint32_t type, first, num, size;
+    void *entries;
+#ifdef TFM_PSA_API
+    struct spm_partition_desc_t *partition;
+    uint32_t privileged;
+#else
+    uint32_t running_idx;
+#endif
+
+    TFM_CORE_ASSERT(args != NULL);
+    type = args[0];
+    first = args[1];
+    entries = (void *)args[2];
+    num = args[3];
+
+    if (type == TFM_SPM_STATS_PARTITIONS) {
+        size = sizeof(struct tfm_spm_partition_stats_t);
+    } else if (type == TFM_SPM_STATS_SERVICES) {
+        size = sizeof(struct tfm_spm_service_stats_t);
+    } else {
+        return 0;
+    }
+
+    /* Bound the copy, the caller reads the rest from a later first index */
+    if (num > SPM_MAX_PARTITIONS + 1) {
+        num = SPM_MAX_PARTITIONS + 1;
+    }
+
+    /* The statistics are only handed out through the platform service */
+#ifdef TFM_PSA_API
+    partition = tfm_spm_get_running_partition();
+    if (!partition ||
+        partition->static_data->partition_id != TFM_SP_PLATFORM) {
+        tfm_core_panic();
+    }
+    privileged = tfm_spm_partition_get_privileged_mode(
+        partition->static_data->partition_flags);
+
+    if (tfm_memory_check(entries, num * size, false,
+                         TFM_MEMORY_ACCESS_RW, privileged) != IPC_SUCCESS) {
+        tfm_core_panic();
+    }
+#else
+    running_idx = tfm_spm_partition_get_running_partition_idx();
+    if (tfm_spm_partition_get_partition_id(running_idx) != TFM_SP_PLATFORM) {
+        tfm_core_panic();
+    }
+
+    if (!tfm_core_check_buffer_access(running_idx, entries, num * size,
+                                      2)) { /* Check 4 bytes alignment */
+        tfm_core_panic();
+    }
+#endif
+
+    if (type == TFM_SPM_STATS_PARTITIONS) {
+        return spm_stats_get_partitions(entries, first, num);
+    }
+
+#ifdef TFM_PSA_API
+    return tfm_spm_get_service_stats(entries, first, num);
+#else
+    /* Requests are not queued to RoT Services in the library model */
+    return 0;
+#endif
+}
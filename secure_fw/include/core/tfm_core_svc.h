@@ -30,6 +30,7 @@ typedef enum {
     TFM_SVC_PSA_VERSION,
     TFM_SVC_PSA_CONNECT,
     TFM_SVC_PSA_CALL,
+    TFM_SVC_PSA_CALL_BATCH,
     TFM_SVC_PSA_CLOSE,
     /* PSA Service SVC */
     TFM_SVC_PSA_GET,
@@ -37,11 +38,40 @@ typedef enum {
     TFM_SVC_PSA_READ,
     TFM_SVC_PSA_SKIP,
     TFM_SVC_PSA_WRITE,
+    TFM_SVC_PSA_MAP_INVEC,
+    TFM_SVC_PSA_UNMAP_INVEC,
+    TFM_SVC_PSA_MAP_OUTVEC,
+    TFM_SVC_PSA_UNMAP_OUTVEC,
     TFM_SVC_PSA_REPLY,
     TFM_SVC_PSA_NOTIFY,
     TFM_SVC_PSA_CLEAR,
     TFM_SVC_PSA_PANIC,
     TFM_SVC_PSA_LIFECYCLE,
+    TFM_SVC_YIELD,
+#ifdef TFM_IPC_TRACE
+    TFM_SVC_GET_IPC_TRACE,
+#endif
+#ifdef TFM_PSA_ASYNC_CALL
+    TFM_SVC_PSA_CALL_ASYNC,
+    TFM_SVC_PSA_CALL_ASYNC_RESULT,
+    TFM_SVC_PSA_CALL_ASYNC_SET_IRQ,
+#endif
+#ifdef TFM_SFN_PARTITIONS
+    TFM_SVC_PSA_SFN_RETURN,
+#endif
+#ifdef TFM_SHM_CHANNELS
+    TFM_SVC_SHM_GET,
+#endif
+#endif
+#ifdef TFM_SPM_STATS
+    TFM_SVC_GET_SPM_STATS,
+#endif
+#ifdef TFM_SPM_PROFILE
+    TFM_SVC_GET_SPM_PROFILE,
+#endif
+#ifdef TFM_RESOURCE_USAGE
+    TFM_SVC_RESOURCE_USAGE_REGISTER,
+    TFM_SVC_GET_RESOURCE_USAGE,
 #endif
     TFM_SVC_PLATFORM_BASE = 50 /* leave room for additional Core handlers */
 } tfm_svc_number_t;
@@ -19,4 +19,139 @@ enum tfm_spm_request_type_t {
  */
 int32_t tfm_spm_request_reset_vote(void);
 
+/**
+ * \brief Let the other secure partitions which are ready to run, and have the
+ *        same or a higher priority than the caller, run before the caller
+ *        continues.
+ *
+ * \details A partition calls it between the steps of a long operation, so
+ *          that the requests to the other partitions are not held until the
+ *          operation completes. It returns at once if no such partition is
+ *          ready. It does nothing in the library model, which has no threads.
+ */
+void tfm_yield(void);
+
+#ifdef TFM_IPC_TRACE
+#include "tfm_ipc_trace_defs.h"
+
+/**
+ * \brief Copy the IPC trace recorded by SPM, oldest entry first. Only the
+ *        platform partition is allowed to read the trace.
+ *
+ * \param[out] entries  Buffer to hold the trace entries
+ * \param[in]  num      Number of entries the buffer can hold
+ *
+ * \return Returns the number of entries copied
+ */
+uint32_t tfm_core_get_ipc_trace(struct tfm_ipc_trace_entry_t *entries,
+                                uint32_t num);
+#endif
+
+#ifdef TFM_SPM_STATS
+#include "tfm_spm_stats_defs.h"
+
+enum tfm_spm_stats_type_t {
+    TFM_SPM_STATS_PARTITIONS,   /* struct tfm_spm_partition_stats_t entries */
+    TFM_SPM_STATS_SERVICES,     /* struct tfm_spm_service_stats_t entries   */
+};
+
+/**
+ * \brief Copy the load statistics recorded by SPM. Only the platform
+ *        partition is allowed to read them.
+ *
+ * \param[in]  type     Statistics to copy, \ref tfm_spm_stats_type_t
+ * \param[in]  first    Index of the first entry to copy
+ * \param[out] entries  Buffer to hold the entries
+ * \param[in]  num      Number of entries the buffer can hold
+ *
+ * \return Returns the number of entries copied, less than num once the last
+ *         entry is copied
+ */
+uint32_t tfm_core_get_spm_stats(uint32_t type, uint32_t first, void *entries,
+                                uint32_t num);
+#endif
+
+#ifdef TFM_SPM_PROFILE
+#include "tfm_spm_profile_defs.h"
+
+/**
+ * \brief Move the PC samples recorded by SPM to the caller, oldest first.
+ *        Only the platform partition is allowed to read the samples.
+ *
+ * \param[out] samples  Buffer to hold the samples
+ * \param[in]  num      Number of samples the buffer can hold
+ *
+ * \return Returns the number of samples moved, less than num once no sample
+ *         is left
+ */
+uint32_t tfm_core_get_spm_profile(struct tfm_spm_profile_sample_t *samples,
+                                  uint32_t num);
+#endif
+
+#ifdef TFM_RESOURCE_USAGE
+#include "tfm_resource_usage_defs.h"
+
+/**
+ * \brief Register a resource pool of the caller partition, to be reported by
+ *        the platform service. The partition sets the resource_id and
+ *        capacity fields of the record before registering it, and keeps the
+ *        used and peak fields up to date with \ref tfm_resource_usage_set.
+ *
+ * \param[in] usage  Record of the pool, which must stay in the memory of the
+ *                   partition
+ *
+ * \return Returns TFM_SUCCESS, or TFM_ERROR_GENERIC if the pool is already
+ *         registered or SPM has no room for another pool
+ */
+int32_t tfm_core_resource_usage_register(struct tfm_resource_usage_t *usage);
+
+/**
+ * \brief Update the current use of a registered resource pool, and its peak.
+ *
+ * \param[in,out] usage  Record of the pool
+ * \param[in]     used   Current use
+ */
+static inline void tfm_resource_usage_set(struct tfm_resource_usage_t *usage,
+                                          uint32_t used)
+{
+    usage->used = used;
+    if (used > usage->peak) {
+        usage->peak = used;
+    }
+}
+
+/**
+ * \brief Copy the usage of the registered resource pools. Only the platform
+ *        partition is allowed to read it.
+ *
+ * \param[in]  first    Index of the first pool to copy
+ * \param[out] entries  Buffer to hold the entries
+ * \param[in]  num      Number of entries the buffer can hold
+ *
+ * \return Returns the number of entries copied, less than num once the last
+ *         entry is copied
+ */
+uint32_t tfm_core_get_resource_usage(uint32_t first,
+                                     struct tfm_resource_usage_t *entries,
+                                     uint32_t num);
+#endif
+
+#ifdef TFM_SHM_CHANNELS
+/**
+ * \brief Get the buffer of a shared memory channel declared in the manifest
+ *        of its producer. Only the producer and the consumer of the channel
+ *        are given the buffer.
+ *
+ * \details The size of the buffer is <name>_SHM_SIZE. The partitions move
+ *          data through the buffer without copies by SPM, and signal each
+ *          other with \ref psa_notify.
+ *
+ * \param[in] shm_id   ID of the channel, <name>_SHM_ID
+ *
+ * \return Returns the buffer, or NULL if the caller is not the producer or
+ *         the consumer of the channel, or the producer is not built
+ */
+void *tfm_shm_get(uint32_t shm_id);
+#endif
+
 #endif /* __TFM_SPM_SERVICES_API_H__ */
@@ -60,6 +60,46 @@ psa_status_t tfm_psa_call_veneer(psa_handle_t handle,
                     : : "I" (TFM_SVC_PSA_CALL));
 }
 
+__tfm_psa_secure_gateway_attributes__
+psa_status_t tfm_psa_call_batch_veneer(psa_handle_t handle,
+                                       psa_batch_call_t *calls,
+                                       size_t num_calls)
+{
+    __ASM volatile("SVC %0           \n"
+                   "BXNS LR          \n"
+                    : : "I" (TFM_SVC_PSA_CALL_BATCH));
+}
+
+#ifdef TFM_PSA_ASYNC_CALL
+__tfm_psa_secure_gateway_attributes__
+psa_status_t tfm_psa_call_async_veneer(psa_handle_t handle,
+                               struct tfm_async_control_parameter_t *ctrl_param,
+                               const psa_invec *in_vec,
+                               psa_outvec *out_vec)
+{
+    __ASM volatile("SVC %0           \n"
+                   "BXNS LR          \n"
+                    : : "I" (TFM_SVC_PSA_CALL_ASYNC));
+}
+
+__tfm_psa_secure_gateway_attributes__
+psa_status_t tfm_psa_call_async_result_veneer(psa_handle_t handle,
+                                              psa_status_t *status)
+{
+    __ASM volatile("SVC %0           \n"
+                   "BXNS LR          \n"
+                    : : "I" (TFM_SVC_PSA_CALL_ASYNC_RESULT));
+}
+
+__tfm_psa_secure_gateway_attributes__
+psa_status_t tfm_psa_call_async_set_irq_veneer(int32_t irq_line)
+{
+    __ASM volatile("SVC %0           \n"
+                   "BXNS LR          \n"
+                    : : "I" (TFM_SVC_PSA_CALL_ASYNC_SET_IRQ));
+}
+#endif
+
 __tfm_psa_secure_gateway_attributes__
 void tfm_psa_close_veneer(psa_handle_t handle)
 {
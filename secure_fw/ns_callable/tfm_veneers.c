@@ -17,6 +17,10 @@ psa_status_t tfm_sst_get_req(psa_invec *, size_t, psa_outvec *, size_t);
 psa_status_t tfm_sst_get_info_req(psa_invec *, size_t, psa_outvec *, size_t);
 psa_status_t tfm_sst_remove_req(psa_invec *, size_t, psa_outvec *, size_t);
 psa_status_t tfm_sst_get_support_req(psa_invec *, size_t, psa_outvec *, size_t);
+psa_status_t tfm_sst_transaction_req(psa_invec *, size_t, psa_outvec *, size_t);
+psa_status_t tfm_sst_set_async_req(psa_invec *, size_t, psa_outvec *, size_t);
+psa_status_t tfm_sst_flush_req(psa_invec *, size_t, psa_outvec *, size_t);
+psa_status_t tfm_sst_list_req(psa_invec *, size_t, psa_outvec *, size_t);
 #endif /* TFM_PARTITION_SECURE_STORAGE */
 
 #ifdef TFM_PARTITION_INTERNAL_TRUSTED_STORAGE
@@ -25,6 +29,8 @@ psa_status_t tfm_its_set_req(psa_invec *, size_t, psa_outvec *, size_t);
 psa_status_t tfm_its_get_req(psa_invec *, size_t, psa_outvec *, size_t);
 psa_status_t tfm_its_get_info_req(psa_invec *, size_t, psa_outvec *, size_t);
 psa_status_t tfm_its_remove_req(psa_invec *, size_t, psa_outvec *, size_t);
+psa_status_t tfm_its_list_req(psa_invec *, size_t, psa_outvec *, size_t);
+psa_status_t tfm_its_sync_req(psa_invec *, size_t, psa_outvec *, size_t);
 #endif /* TFM_PARTITION_INTERNAL_TRUSTED_STORAGE */
 
 #ifdef TFM_PARTITION_AUDIT_LOG
@@ -63,6 +69,7 @@ psa_status_t tfm_crypto_mac_update(psa_invec *, size_t, psa_outvec *, size_t);
 psa_status_t tfm_crypto_mac_sign_finish(psa_invec *, size_t, psa_outvec *, size_t);
 psa_status_t tfm_crypto_mac_verify_finish(psa_invec *, size_t, psa_outvec *, size_t);
 psa_status_t tfm_crypto_mac_abort(psa_invec *, size_t, psa_outvec *, size_t);
+psa_status_t tfm_crypto_mac_clone(psa_invec *, size_t, psa_outvec *, size_t);
 psa_status_t tfm_crypto_cipher_encrypt(psa_invec *, size_t, psa_outvec *, size_t);
 psa_status_t tfm_crypto_cipher_decrypt(psa_invec *, size_t, psa_outvec *, size_t);
 psa_status_t tfm_crypto_cipher_encrypt_setup(psa_invec *, size_t, psa_outvec *, size_t);
@@ -84,8 +91,11 @@ psa_status_t tfm_crypto_aead_update(psa_invec *, size_t, psa_outvec *, size_t);
 psa_status_t tfm_crypto_aead_finish(psa_invec *, size_t, psa_outvec *, size_t);
 psa_status_t tfm_crypto_aead_verify(psa_invec *, size_t, psa_outvec *, size_t);
 psa_status_t tfm_crypto_aead_abort(psa_invec *, size_t, psa_outvec *, size_t);
+psa_status_t tfm_crypto_aead_encrypt_batch(psa_invec *, size_t, psa_outvec *, size_t);
+psa_status_t tfm_crypto_aead_decrypt_batch(psa_invec *, size_t, psa_outvec *, size_t);
 psa_status_t tfm_crypto_sign_hash(psa_invec *, size_t, psa_outvec *, size_t);
 psa_status_t tfm_crypto_verify_hash(psa_invec *, size_t, psa_outvec *, size_t);
+psa_status_t tfm_crypto_verify_hash_batch(psa_invec *, size_t, psa_outvec *, size_t);
 psa_status_t tfm_crypto_asymmetric_encrypt(psa_invec *, size_t, psa_outvec *, size_t);
 psa_status_t tfm_crypto_asymmetric_decrypt(psa_invec *, size_t, psa_outvec *, size_t);
 psa_status_t tfm_crypto_key_derivation_setup(psa_invec *, size_t, psa_outvec *, size_t);
@@ -100,12 +110,18 @@ psa_status_t tfm_crypto_key_derivation_abort(psa_invec *, size_t, psa_outvec *,
 psa_status_t tfm_crypto_raw_key_agreement(psa_invec *, size_t, psa_outvec *, size_t);
 psa_status_t tfm_crypto_generate_random(psa_invec *, size_t, psa_outvec *, size_t);
 psa_status_t tfm_crypto_generate_key(psa_invec *, size_t, psa_outvec *, size_t);
+psa_status_t tfm_crypto_get_engine_mem_stats(psa_invec *, size_t, psa_outvec *, size_t);
 #endif /* TFM_PARTITION_CRYPTO */
 
 #ifdef TFM_PARTITION_PLATFORM
 /******** TFM_SP_PLATFORM ********/
 psa_status_t platform_sp_system_reset(psa_invec *, size_t, psa_outvec *, size_t);
 psa_status_t platform_sp_ioctl(psa_invec *, size_t, psa_outvec *, size_t);
+psa_status_t platform_sp_boot_time_read(psa_invec *, size_t, psa_outvec *, size_t);
+psa_status_t platform_sp_spm_stats_read(psa_invec *, size_t, psa_outvec *, size_t);
+psa_status_t platform_sp_ioctl_vector(psa_invec *, size_t, psa_outvec *, size_t);
+psa_status_t platform_sp_spm_profile_read(psa_invec *, size_t, psa_outvec *, size_t);
+psa_status_t platform_sp_resource_usage_read(psa_invec *, size_t, psa_outvec *, size_t);
 #endif /* TFM_PARTITION_PLATFORM */
 
 #ifdef TFM_PARTITION_INITIAL_ATTESTATION
@@ -113,6 +129,8 @@ psa_status_t platform_sp_ioctl(psa_invec *, size_t, psa_outvec *, size_t);
 psa_status_t initial_attest_get_token(psa_invec *, size_t, psa_outvec *, size_t);
 psa_status_t initial_attest_get_token_size(psa_invec *, size_t, psa_outvec *, size_t);
 psa_status_t initial_attest_get_public_key(psa_invec *, size_t, psa_outvec *, size_t);
+psa_status_t initial_attest_get_batch_token(psa_invec *, size_t, psa_outvec *, size_t);
+psa_status_t initial_attest_get_profile(psa_invec *, size_t, psa_outvec *, size_t);
 #endif /* TFM_PARTITION_INITIAL_ATTESTATION */
 
 #ifdef TFM_PARTITION_TEST_CORE
@@ -178,6 +196,18 @@ psa_status_t tfm_secure_client_2_call(psa_invec *, size_t, psa_outvec *, size_t)
                                    in_vec, in_len, out_vec, out_len); \
     }
 
+#define TFM_VENEER_FUNCTION_FAST(partition_name, sfn_name) \
+    __tfm_secure_gateway_attributes__ \
+    psa_status_t tfm_##sfn_name##_veneer(psa_invec *in_vec, \
+                                         size_t in_len, \
+                                         psa_outvec *out_vec, \
+                                         size_t out_len) \
+    { \
+        TFM_CORE_IOVEC_SFN_FAST_REQUEST(partition_name, \
+                                        (void *) sfn_name, \
+                                        in_vec, in_len, out_vec, out_len); \
+    }
+
 #ifdef TFM_PARTITION_SECURE_STORAGE
 /******** TFM_SP_STORAGE ********/
 TFM_VENEER_FUNCTION(TFM_SP_STORAGE, tfm_sst_set_req)
@@ -185,14 +215,20 @@ TFM_VENEER_FUNCTION(TFM_SP_STORAGE, tfm_sst_get_req)
 TFM_VENEER_FUNCTION(TFM_SP_STORAGE, tfm_sst_get_info_req)
 TFM_VENEER_FUNCTION(TFM_SP_STORAGE, tfm_sst_remove_req)
 TFM_VENEER_FUNCTION(TFM_SP_STORAGE, tfm_sst_get_support_req)
+TFM_VENEER_FUNCTION(TFM_SP_STORAGE, tfm_sst_transaction_req)
+TFM_VENEER_FUNCTION(TFM_SP_STORAGE, tfm_sst_set_async_req)
+TFM_VENEER_FUNCTION(TFM_SP_STORAGE, tfm_sst_flush_req)
+TFM_VENEER_FUNCTION(TFM_SP_STORAGE, tfm_sst_list_req)
 #endif /* TFM_PARTITION_SECURE_STORAGE */
 
 #ifdef TFM_PARTITION_INTERNAL_TRUSTED_STORAGE
 /******** TFM_SP_ITS ********/
 TFM_VENEER_FUNCTION(TFM_SP_ITS, tfm_its_set_req)
 TFM_VENEER_FUNCTION(TFM_SP_ITS, tfm_its_get_req)
-TFM_VENEER_FUNCTION(TFM_SP_ITS, tfm_its_get_info_req)
+TFM_VENEER_FUNCTION_FAST(TFM_SP_ITS, tfm_its_get_info_req)
 TFM_VENEER_FUNCTION(TFM_SP_ITS, tfm_its_remove_req)
+TFM_VENEER_FUNCTION(TFM_SP_ITS, tfm_its_list_req)
+TFM_VENEER_FUNCTION(TFM_SP_ITS, tfm_its_sync_req)
 #endif /* TFM_PARTITION_INTERNAL_TRUSTED_STORAGE */
 
 #ifdef TFM_PARTITION_AUDIT_LOG
@@ -231,6 +267,7 @@ TFM_VENEER_FUNCTION(TFM_SP_CRYPTO, tfm_crypto_mac_update)
 TFM_VENEER_FUNCTION(TFM_SP_CRYPTO, tfm_crypto_mac_sign_finish)
 TFM_VENEER_FUNCTION(TFM_SP_CRYPTO, tfm_crypto_mac_verify_finish)
 TFM_VENEER_FUNCTION(TFM_SP_CRYPTO, tfm_crypto_mac_abort)
+TFM_VENEER_FUNCTION(TFM_SP_CRYPTO, tfm_crypto_mac_clone)
 TFM_VENEER_FUNCTION(TFM_SP_CRYPTO, tfm_crypto_cipher_encrypt)
 TFM_VENEER_FUNCTION(TFM_SP_CRYPTO, tfm_crypto_cipher_decrypt)
 TFM_VENEER_FUNCTION(TFM_SP_CRYPTO, tfm_crypto_cipher_encrypt_setup)
@@ -252,8 +289,11 @@ TFM_VENEER_FUNCTION(TFM_SP_CRYPTO, tfm_crypto_aead_update)
 TFM_VENEER_FUNCTION(TFM_SP_CRYPTO, tfm_crypto_aead_finish)
 TFM_VENEER_FUNCTION(TFM_SP_CRYPTO, tfm_crypto_aead_verify)
 TFM_VENEER_FUNCTION(TFM_SP_CRYPTO, tfm_crypto_aead_abort)
+TFM_VENEER_FUNCTION(TFM_SP_CRYPTO, tfm_crypto_aead_encrypt_batch)
+TFM_VENEER_FUNCTION(TFM_SP_CRYPTO, tfm_crypto_aead_decrypt_batch)
 TFM_VENEER_FUNCTION(TFM_SP_CRYPTO, tfm_crypto_sign_hash)
 TFM_VENEER_FUNCTION(TFM_SP_CRYPTO, tfm_crypto_verify_hash)
+TFM_VENEER_FUNCTION(TFM_SP_CRYPTO, tfm_crypto_verify_hash_batch)
 TFM_VENEER_FUNCTION(TFM_SP_CRYPTO, tfm_crypto_asymmetric_encrypt)
 TFM_VENEER_FUNCTION(TFM_SP_CRYPTO, tfm_crypto_asymmetric_decrypt)
 TFM_VENEER_FUNCTION(TFM_SP_CRYPTO, tfm_crypto_key_derivation_setup)
@@ -268,12 +308,18 @@ TFM_VENEER_FUNCTION(TFM_SP_CRYPTO, tfm_crypto_key_derivation_abort)
 TFM_VENEER_FUNCTION(TFM_SP_CRYPTO, tfm_crypto_raw_key_agreement)
 TFM_VENEER_FUNCTION(TFM_SP_CRYPTO, tfm_crypto_generate_random)
 TFM_VENEER_FUNCTION(TFM_SP_CRYPTO, tfm_crypto_generate_key)
+TFM_VENEER_FUNCTION(TFM_SP_CRYPTO, tfm_crypto_get_engine_mem_stats)
 #endif /* TFM_PARTITION_CRYPTO */
 
 #ifdef TFM_PARTITION_PLATFORM
 /******** TFM_SP_PLATFORM ********/
 TFM_VENEER_FUNCTION(TFM_SP_PLATFORM, platform_sp_system_reset)
 TFM_VENEER_FUNCTION(TFM_SP_PLATFORM, platform_sp_ioctl)
+TFM_VENEER_FUNCTION(TFM_SP_PLATFORM, platform_sp_boot_time_read)
+TFM_VENEER_FUNCTION(TFM_SP_PLATFORM, platform_sp_spm_stats_read)
+TFM_VENEER_FUNCTION(TFM_SP_PLATFORM, platform_sp_ioctl_vector)
+TFM_VENEER_FUNCTION(TFM_SP_PLATFORM, platform_sp_spm_profile_read)
+TFM_VENEER_FUNCTION(TFM_SP_PLATFORM, platform_sp_resource_usage_read)
 #endif /* TFM_PARTITION_PLATFORM */
 
 #ifdef TFM_PARTITION_INITIAL_ATTESTATION
@@ -281,6 +327,8 @@ TFM_VENEER_FUNCTION(TFM_SP_PLATFORM, platform_sp_ioctl)
 TFM_VENEER_FUNCTION(TFM_SP_INITIAL_ATTESTATION, initial_attest_get_token)
 TFM_VENEER_FUNCTION(TFM_SP_INITIAL_ATTESTATION, initial_attest_get_token_size)
 TFM_VENEER_FUNCTION(TFM_SP_INITIAL_ATTESTATION, initial_attest_get_public_key)
+TFM_VENEER_FUNCTION(TFM_SP_INITIAL_ATTESTATION, initial_attest_get_batch_token)
+TFM_VENEER_FUNCTION(TFM_SP_INITIAL_ATTESTATION, initial_attest_get_profile)
 #endif /* TFM_PARTITION_INITIAL_ATTESTATION */
 
 #ifdef TFM_PARTITION_TEST_CORE
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -11,6 +11,19 @@
 #include "audit_core.h"
 #include "psa_audit_defs.h"
 #include "tfm_secure_api.h"
+#include "tfm_memory_utils.h"
+#ifdef AUDIT_PERSISTENT_LOG
+#include "audit_persist.h"
+#endif
+#ifdef AUDIT_ASYNC_ADD_RECORD
+#include "audit_queue.h"
+#endif
+#ifdef AUDIT_RECORD_FILTER
+#include "audit_filter.h"
+#endif
+#ifdef TFM_RESOURCE_USAGE
+#include "secure_fw/include/tfm_spm_services_api.h"
+#endif
 
 /*!
  * \def AUDIT_UART_REDIRECTION
@@ -104,6 +117,23 @@ static uint8_t log_buffer[LOG_SIZE] = {0};
  */
 static uint64_t scratch_buffer[(LOG_SIZE)/8] = {0};
 
+/*!
+ * \def LOG_MAX_RECORDS
+ *
+ * \brief Maximum number of records which can be stored in the log at the same
+ *        time, i.e. when all of them have an empty payload
+ */
+#define LOG_MAX_RECORDS (LOG_SIZE / (LOG_FIXED_FIELD_SIZE + LOG_MAC_SIZE))
+
+/*!
+ * \var record_offsets
+ *
+ * \brief Ring of the byte indexes in the log of the stored records, in
+ *        chronological order starting from log_state.first_el_slot, so that
+ *        each record is reached without walking through the older ones
+ */
+static uint16_t record_offsets[LOG_MAX_RECORDS] = {0};
+
 /*!
  * \struct log_vars
  *
@@ -120,6 +150,8 @@ struct log_vars {
                                 zero after a reset, i.e. log is empty */
     uint32_t stored_size;  /*!< Indicates the total size of the items
                                 currently stored in the log */
+    uint32_t first_el_slot; /*!< Slot in record_offsets of the first
+                                 element in chronological order */
 };
 
 /*!
@@ -129,6 +161,18 @@ struct log_vars {
  */
 static struct log_vars log_state = {0};
 
+#ifdef TFM_RESOURCE_USAGE
+/*!
+ * \var log_usage
+ *
+ * \brief Usage of the log, in bytes, reported by SPM
+ */
+static struct tfm_resource_usage_t log_usage = {
+    .resource_id = TFM_RESOURCE_AUDIT_LOG,
+    .capacity = LOG_SIZE,
+};
+#endif
+
 /*!
  * \var global_timestamp
  *
@@ -198,30 +242,65 @@ uint32_t GET_NEXT_LOG_INDEX(const uint32_t idx)
                                    *GET_SIZE_FIELD_POINTER(idx)) ) % LOG_SIZE );
 }
 
+/*!
+ * \brief Static inline function to get the slot in record_offsets which
+ *        follows a given slot
+ *
+ * \param[in] slot Current slot
+ *
+ * \return Next slot, wrapping at the end of the ring
+ */
+__attribute__ ((always_inline)) __STATIC_INLINE
+uint32_t GET_NEXT_RECORD_SLOT(const uint32_t slot)
+{
+    return (slot + 1) % LOG_MAX_RECORDS;
+}
+
+/*!
+ * \brief Static inline function to get the index in the log of a record
+ *
+ * \param[in] record_index Index of the record in chronological order, which
+ *                         must be less than the number of stored records
+ *
+ * \return Byte index of the record in the log
+ */
+__attribute__ ((always_inline)) __STATIC_INLINE
+uint32_t GET_RECORD_LOG_INDEX(const uint32_t record_index)
+{
+    return record_offsets[(log_state.first_el_slot + record_index) %
+                          LOG_MAX_RECORDS];
+}
+
 /*!
  * \brief Static function to update the state variables of the log after the
  *        addition of a new log record of a given size
  *
- * \param[in] first_el_idx First element index
- * \param[in] last_el_idx  Last element index
- * \param[in] stored_size  New value of the stored size
- * \param[in] num_records  Number of elements stored
+ * \param[in] first_el_idx  First element index
+ * \param[in] last_el_idx   Last element index
+ * \param[in] stored_size   New value of the stored size
+ * \param[in] num_records   Number of elements stored
+ * \param[in] first_el_slot Slot of the first element in record_offsets
  *
  */
 static void audit_update_state(const uint32_t first_el_idx,
                                const uint32_t last_el_idx,
                                const uint32_t stored_size,
-                               const uint32_t num_records)
+                               const uint32_t num_records,
+                               const uint32_t first_el_slot)
 {
     /* Update the indexes */
     log_state.first_el_idx = first_el_idx;
     log_state.last_el_idx = last_el_idx;
+    log_state.first_el_slot = first_el_slot;
 
     /* Update the number of records stored */
     log_state.num_records = num_records;
 
     /* Update the size of the stored records */
     log_state.stored_size = stored_size;
+#ifdef TFM_RESOURCE_USAGE
+    tfm_resource_usage_set(&log_usage, stored_size);
+#endif
 }
 
 /*!
@@ -241,12 +320,14 @@ static void audit_replace_record(const uint32_t size,
     uint32_t first_el_idx = 0, last_el_idx = 0;
     uint32_t num_items = 0, stored_size = 0;
     uint32_t start_pos = 0, stop_pos = 0;
+    uint32_t first_el_slot = 0;
 
     /* Retrieve the current state variables of the log */
     first_el_idx = log_state.first_el_idx;
     last_el_idx = log_state.last_el_idx;
     num_items = log_state.num_records;
     stored_size = log_state.stored_size;
+    first_el_slot = log_state.first_el_slot;
 
     /* If there is not enough size, remove older entries */
     while (size > (LOG_SIZE - stored_size)) {
@@ -257,6 +338,7 @@ static void audit_replace_record(const uint32_t size,
             last_el_idx = 0;
             num_items = 0;
             stored_size = 0;
+            first_el_slot = 0;
             break;
         }
 
@@ -265,6 +347,7 @@ static void audit_replace_record(const uint32_t size,
                            *GET_SIZE_FIELD_POINTER(first_el_idx) );
         num_items--;
         first_el_idx = GET_NEXT_LOG_INDEX(first_el_idx);
+        first_el_slot = GET_NEXT_RECORD_SLOT(first_el_slot);
     }
 
     /* Get the start and stop positions */
@@ -279,14 +362,22 @@ static void audit_replace_record(const uint32_t size,
     *begin = start_pos;
     *end = stop_pos;
 
+    /* Record the position of the new record in the slot after the last one */
+    record_offsets[(first_el_slot + num_items) % LOG_MAX_RECORDS] =
+                                                          (uint16_t)start_pos;
+
     /* Update the state with the new values of variables */
-    audit_update_state(first_el_idx, last_el_idx, stored_size, num_items);
+    audit_update_state(first_el_idx, last_el_idx, stored_size, num_items,
+                       first_el_slot);
 }
 
 /*!
  * \brief Static function to perform memory copying into the log buffer. It
  *        takes into account circular wrapping on the log buffer size.
  *
+ * \details The copy is split in at most two contiguous parts, before and
+ *          after the end of the log buffer.
+ *
  * \param[in]  src  Pointer to the source buffer
  * \param[in]  size Size in bytes to be copied
  * \param[out] dest Pointer to the destination buffer
@@ -296,44 +387,48 @@ static psa_status_t audit_buffer_copy(const uint8_t *src,
                                       const uint32_t size,
                                       uint8_t *dest)
 {
-    uint32_t idx = 0;
     uint32_t dest_idx = (uint32_t)dest - (uint32_t)&log_buffer[0];
+    uint32_t head_size;
 
     if ((dest_idx >= LOG_SIZE) || (size > LOG_SIZE)) {
         return PSA_ERROR_BUFFER_TOO_SMALL;
     }
 
-    /* TODO: This can be an optimized copy using uint32_t
-     *       and enforcing the condition that wrapping
-     *       happens only on 4-byte boundaries
-     */
-
-    for (idx = 0; idx < size; idx++) {
-        log_buffer[(dest_idx + idx) % LOG_SIZE] = src[idx];
+    head_size = LOG_SIZE - dest_idx;
+    if (size <= head_size) {
+        (void)tfm_memcpy(&log_buffer[dest_idx], src, size);
+    } else {
+        (void)tfm_memcpy(&log_buffer[dest_idx], src, head_size);
+        (void)tfm_memcpy(&log_buffer[0], &src[head_size], size - head_size);
     }
 
     return PSA_SUCCESS;
 }
 
 /*!
- * \brief Static function to emulate memcpy
+ * \brief Static function to perform memory copying out of the log buffer. It
+ *        takes into account circular wrapping on the log buffer size.
  *
- * \param[in]  src  Pointer to the source buffer
- * \param[in]  size Size in bytes to be copied
- * \param[out] dest Pointer to the destination buffer
+ * \details The copy is split in at most two contiguous parts, before and
+ *          after the end of the log buffer.
+ *
+ * \param[in]  start_idx Byte index in the log from where to start copying
+ * \param[in]  size      Size in bytes to be copied, not greater than LOG_SIZE
+ * \param[out] dest      Pointer to the destination buffer
  *
  */
-static psa_status_t audit_memcpy(const uint8_t *src,
-                                 const uint32_t size,
-                                 uint8_t *dest)
+static void audit_buffer_read(const uint32_t start_idx,
+                              const uint32_t size,
+                              uint8_t *dest)
 {
-    uint32_t idx = 0;
+    uint32_t head_size = LOG_SIZE - start_idx;
 
-    for (idx = 0; idx < size; idx++) {
-        dest[idx] = src[idx];
+    if (size <= head_size) {
+        (void)tfm_memcpy(dest, &log_buffer[start_idx], size);
+    } else {
+        (void)tfm_memcpy(dest, &log_buffer[start_idx], head_size);
+        (void)tfm_memcpy(&dest[head_size], &log_buffer[0], size - head_size);
     }
-
-    return PSA_SUCCESS;
 }
 
 /*!
@@ -353,7 +448,6 @@ static psa_status_t audit_format_buffer(const struct psa_audit_record *record,
     struct log_tlr *tlr = NULL;
     uint32_t size;
     uint8_t idx;
-    psa_status_t status;
 
     /* Get the size from the record */
     size = record->size;
@@ -374,12 +468,7 @@ static psa_status_t audit_format_buffer(const struct psa_audit_record *record,
     hdr->partition_id = partition_id;
 
     /* Copy the record into the scratch buffer */
-    status = audit_memcpy((const uint8_t *) record,
-                          size+4,
-                          (uint8_t *) &(hdr->size));
-    if (status != PSA_SUCCESS) {
-        return status;
-    }
+    (void)tfm_memcpy(&(hdr->size), record, size+4);
 
     /* FIXME: The MAC here is just a dummy value for prototyping. It will be
      *        filled by a call to the crypto interface directly when available.
@@ -422,33 +511,212 @@ static void audit_uart_redirection(const uint32_t start_idx)
 #endif
 }
 
-static psa_status_t _audit_core_get_info(uint32_t *num_records, uint32_t *size)
+/*!
+ * \brief Static function to store a formatted entry in the log, replacing the
+ *        oldest records if there is not enough space for it
+ *
+ * \param[in]  entry       Pointer to the formatted log entry
+ * \param[out] last_el_idx Byte index in the log of the stored entry
+ *
+ * \return Returns PSA_SUCCESS if the entry has been stored, otherwise error as
+ *         specified in \ref psa_status_t
+ */
+static psa_status_t audit_store_entry(const uint8_t *entry,
+                                      uint32_t *last_el_idx)
 {
-    /* Return the number of records that are currently stored */
-    *num_records = log_state.num_records;
+    uint32_t start_pos = 0, stop_pos = 0;
+    uint32_t size = ((const struct log_hdr *)entry)->size;
+    psa_status_t status;
 
-    /* Return the size of the records currently stored */
-    *size = log_state.stored_size;
+    if (log_state.num_records == 0) {
+
+        start_pos = 0;
+
+        /* The log is empty, the new record goes in the first slot */
+        log_state.first_el_slot = 0;
+        record_offsets[0] = 0;
+
+    } else {
+
+        /* The log is not empty, need to decide the candidate position
+         * and invalidate older entries in case there is not enough space
+         */
+        audit_replace_record(COMPUTE_LOG_ENTRY_SIZE(size),
+                             &start_pos,
+                             &stop_pos);
+    }
+
+    /* Do the copy of the log item to be added in the log */
+    status = audit_buffer_copy(entry, COMPUTE_LOG_ENTRY_SIZE(size),
+                               (uint8_t *) &log_buffer[start_pos]);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    /* The last element is the one we just added, update the number of items
+     * and stored size
+     */
+    audit_update_state(log_state.first_el_idx, start_pos,
+                       log_state.stored_size + COMPUTE_LOG_ENTRY_SIZE(size),
+                       log_state.num_records + 1, log_state.first_el_slot);
+
+    *last_el_idx = start_pos;
 
     return PSA_SUCCESS;
 }
 
+#ifdef AUDIT_PERSISTENT_LOG
+/*!
+ * \var log_restored
+ *
+ * \brief This variable is 1 once the records of the persistent log have been
+ *        restored in the log, 0 otherwise.
+ */
+static uint8_t log_restored = 0U;
+
+/*!
+ * \brief Static function called for each record restored from the persistent
+ *        log, which stores it in the log without streaming it to the UART
+ */
+static void audit_replay_entry(const uint8_t *entry, uint32_t entry_size)
+{
+    const struct log_hdr *hdr = (const struct log_hdr *)entry;
+    uint32_t last_el_idx;
+
+    (void)entry_size;
+
+    if (audit_store_entry(entry, &last_el_idx) != PSA_SUCCESS) {
+        return;
+    }
+
+    /* The new records are timestamped after the restored ones */
+    if (hdr->timestamp >= global_timestamp) {
+        global_timestamp = hdr->timestamp + 1;
+    }
+}
+#endif
+
+/*!
+ * \brief Static function to restore the records of the persistent log, if
+ *        built. This is done on the first request to the service, as the
+ *        Internal Trusted Storage and Crypto services can't be called during
+ *        its initialization.
+ */
+static void audit_restore_log(void)
+{
+#ifdef AUDIT_PERSISTENT_LOG
+    if (log_restored == 1U) {
+        return;
+    }
+    log_restored = 1U;
+
+    /* The records which can't be restored are not available in the log, but
+     * the service keeps on logging in any case
+     */
+    (void)audit_persist_restore((uint8_t *) &scratch_buffer[0],
+                                sizeof(scratch_buffer), audit_replay_entry);
+#endif
+}
+
+/*!
+ * \brief Static function to add a record to the log, and to the persistent
+ *        log if built
+ *
+ * \param[in] record       Pointer to the record to be added
+ * \param[in] partition_id Value of the partition ID for the partition which
+ *                         originated the audit logging request
+ *
+ * \return Returns PSA_SUCCESS if the record has been added, otherwise error as
+ *         specified in \ref psa_status_t
+ *
+ * \note The size of the record must have been validated by the caller
+ */
+static psa_status_t audit_add_entry(const struct psa_audit_record *record,
+                                    const int32_t partition_id)
+{
+    uint32_t last_el_idx = 0;
+    uint32_t size = record->size;
+    psa_status_t status;
+    psa_status_t persist_status = PSA_SUCCESS;
+
+    /* Format the scratch buffer with the complete log item */
+    status = audit_format_buffer(record, partition_id, &scratch_buffer[0]);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    /* TODO: At this point, encryption should be called if supported */
+
+#ifdef AUDIT_PERSISTENT_LOG
+    /* Chain the MAC of the log item and append it to the persistent log. The
+     * item is still added to the log if it could not be written to the
+     * storage, and the error is returned to the caller.
+     */
+    persist_status = audit_persist_add((uint8_t *) &scratch_buffer[0],
+                                       COMPUTE_LOG_ENTRY_SIZE(size));
+    if ((persist_status != PSA_SUCCESS) &&
+        (persist_status != PSA_ERROR_STORAGE_FAILURE)) {
+        return persist_status;
+    }
+#endif
+
+    /* Store the log item in the log */
+    status = audit_store_entry((const uint8_t *) &scratch_buffer[0],
+                               &last_el_idx);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    /* Stream to a secure UART if available for the platform and built */
+    audit_uart_redirection(last_el_idx);
+
+    return persist_status;
+}
+
+#ifdef AUDIT_ASYNC_ADD_RECORD
+/*!
+ * \brief Static function called for each record drained from the queue. An
+ *        error can't be returned to the partition which queued the record,
+ *        which is then dropped.
+ */
+static void audit_queue_consumer(const struct psa_audit_record *record,
+                                 int32_t partition_id)
+{
+#ifdef AUDIT_RECORD_FILTER
+    if (!audit_filter_accept(record, partition_id)) {
+        return;
+    }
+#endif
+
+    (void)audit_add_entry(record, partition_id);
+}
+#endif
+
+/*!
+ * \brief Static function to bring the log up to date before a request is
+ *        served: the persistent log is restored on the first request, and the
+ *        queued records are added, if built
+ */
+static void audit_sync_log(void)
+{
+    audit_restore_log();
+
+#ifdef AUDIT_ASYNC_ADD_RECORD
+    audit_queue_drain(audit_queue_consumer);
+#endif
+}
+
 static psa_status_t _audit_core_get_record_info(const uint32_t record_index,
                                                 uint32_t *size)
 {
-    uint32_t start_idx, idx;
+    uint32_t start_idx;
 
     if (record_index >= log_state.num_records) {
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
-    /* First element to read from the log */
-    start_idx = log_state.first_el_idx;
-
-    /* Move the start_idx index to the desired element */
-    for (idx = 0; idx < record_index; idx++) {
-        start_idx = GET_NEXT_LOG_INDEX(start_idx);
-    }
+    /* Index of the requested element in the log */
+    start_idx = GET_RECORD_LOG_INDEX(record_index);
 
     /* Get the size of the requested record */
     *size = COMPUTE_LOG_ENTRY_SIZE(*GET_SIZE_FIELD_POINTER(start_idx));
@@ -483,7 +751,15 @@ psa_status_t audit_core_init(void)
 #endif
 
     /* Clear the log state variables */
-    audit_update_state(0,0,0,0);
+    audit_update_state(0,0,0,0,0);
+
+#ifdef TFM_RESOURCE_USAGE
+    (void)tfm_core_resource_usage_register(&log_usage);
+#endif
+
+#ifdef AUDIT_RECORD_FILTER
+    audit_filter_init();
+#endif
 
     return PSA_SUCCESS;
 }
@@ -499,6 +775,8 @@ psa_status_t audit_core_delete_record(psa_invec in_vec[],
         return PSA_ERROR_CONNECTION_REFUSED;
     }
 
+    audit_sync_log();
+
     if (in_vec[0].len != sizeof(uint32_t)) {
         return PSA_ERROR_CONNECTION_REFUSED;
     }
@@ -532,7 +810,7 @@ psa_status_t audit_core_delete_record(psa_invec in_vec[],
     if (log_state.num_records == 1) {
 
         /* Clear the log state variables */
-        audit_update_state(0,0,0,0);
+        audit_update_state(0,0,0,0,0);
 
         return PSA_SUCCESS;
     }
@@ -551,8 +829,12 @@ psa_status_t audit_core_delete_record(psa_invec in_vec[],
     /* Update the state with the new head and decrease the number of records
      * currently stored and the new size of the stored records */
     log_state.first_el_idx = first_el_idx;
+    log_state.first_el_slot = GET_NEXT_RECORD_SLOT(log_state.first_el_slot);
     log_state.num_records--;
     log_state.stored_size -= size_removed;
+#ifdef TFM_RESOURCE_USAGE
+    tfm_resource_usage_set(&log_usage, log_state.stored_size);
+#endif
 
     return PSA_SUCCESS;
 }
@@ -566,6 +848,8 @@ psa_status_t audit_core_get_info(psa_invec in_vec[],
         return PSA_ERROR_CONNECTION_REFUSED;
     }
 
+    audit_sync_log();
+
     if ((out_vec[0].len != sizeof(uint32_t)) ||
 	(out_vec[1].len != sizeof(uint32_t))) {
         return PSA_ERROR_CONNECTION_REFUSED;
@@ -588,12 +872,14 @@ psa_status_t audit_core_get_record_info(psa_invec in_vec[],
                                         psa_outvec out_vec[],
                                         size_t out_len)
 {
-    uint32_t start_idx, idx;
+    uint32_t start_idx;
 
     if ((in_len != 1) || (out_len != 1)) {
         return PSA_ERROR_CONNECTION_REFUSED;
     }
 
+    audit_sync_log();
+
     if ((in_vec[0].len != sizeof(uint32_t)) ||
         (out_vec[0].len != sizeof(uint32_t))) {
         return PSA_ERROR_CONNECTION_REFUSED;
@@ -606,13 +892,8 @@ psa_status_t audit_core_get_record_info(psa_invec in_vec[],
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
-    /* First element to read from the log */
-    start_idx = log_state.first_el_idx;
-
-    /* Move the start_idx index to the desired element */
-    for (idx = 0; idx < record_index; idx++) {
-        start_idx = GET_NEXT_LOG_INDEX(start_idx);
-    }
+    /* Index of the requested element in the log */
+    start_idx = GET_RECORD_LOG_INDEX(record_index);
 
     /* Get the size of the requested record */
     *size = COMPUTE_LOG_ENTRY_SIZE(*GET_SIZE_FIELD_POINTER(start_idx));
@@ -625,11 +906,8 @@ psa_status_t audit_core_add_record(psa_invec in_vec[],
                                    psa_outvec out_vec[],
                                    size_t out_len)
 {
-    uint32_t start_pos = 0, stop_pos = 0;
-    uint32_t first_el_idx = 0, last_el_idx = 0, size = 0;
-    uint32_t num_items = 0, stored_size = 0;
+    uint32_t size = 0;
     int32_t partition_id;
-    psa_status_t status;
 
     if ((in_len != 1) || (out_len != 0)) {
         return PSA_ERROR_CONNECTION_REFUSED;
@@ -666,65 +944,18 @@ psa_status_t audit_core_add_record(psa_invec in_vec[],
         return PSA_ERROR_INSUFFICIENT_MEMORY;
     }
 
-    /* Get the size in bytes and num of elements present in the log */
-    status = _audit_core_get_info(&num_items, &stored_size);
-    if (status !=  PSA_SUCCESS) {
-        return status;
-    }
-
-    if (num_items == 0) {
-
-        start_pos = 0;
-
-    } else {
-
-        /* The log is not empty, need to decide the candidate position
-         * and invalidate older entries in case there is not enough space
-         */
-        audit_replace_record(COMPUTE_LOG_ENTRY_SIZE(size),
-                             &start_pos,
-                             &stop_pos);
-    }
-
-    /* Format the scratch buffer with the complete log item */
-    status = audit_format_buffer(record, partition_id, &scratch_buffer[0]);
-    if (status != PSA_SUCCESS) {
-        return status;
-    }
-
-    /* TODO: At this point, encryption should be called if supported */
-
-    /* Do the copy of the log item to be added in the log */
-    status = audit_buffer_copy((const uint8_t *) &scratch_buffer[0],
-                               COMPUTE_LOG_ENTRY_SIZE(size),
-                               (uint8_t *) &log_buffer[start_pos]);
-    if (status != PSA_SUCCESS) {
-        return status;
-    }
-
-    /* Retrieve current log state */
-    first_el_idx = log_state.first_el_idx;
-    num_items = log_state.num_records;
-    stored_size = log_state.stored_size;
-
-    /* The last element is the one we just added */
-    last_el_idx = start_pos;
-
-    /* Update the number of items and stored size */
-    num_items++;
-    stored_size += COMPUTE_LOG_ENTRY_SIZE(size);
-
-    /* Update the log state */
-    audit_update_state(first_el_idx, last_el_idx, stored_size, num_items);
-
-    /* TODO: At this point, we would need to update the stored copy in
-     *       persistent storage. Need to define a strategy for this
+#ifdef AUDIT_RECORD_FILTER
+    /* A dropped record is not an error of the caller, and costs neither the
+     * formatting nor the eviction of older records
      */
+    if (!audit_filter_accept(record, partition_id)) {
+        return PSA_SUCCESS;
+    }
+#endif
 
-    /* Stream to a secure UART if available for the platform and built */
-    audit_uart_redirection(last_el_idx);
+    audit_sync_log();
 
-    return PSA_SUCCESS;
+    return audit_add_entry(record, partition_id);
 }
 
 psa_status_t audit_core_retrieve_record(psa_invec in_vec[],
@@ -732,13 +963,15 @@ psa_status_t audit_core_retrieve_record(psa_invec in_vec[],
                                         psa_outvec out_vec[],
                                         size_t out_len)
 {
-    uint32_t idx, start_idx, record_size_tmp;
+    uint32_t start_idx, record_size_tmp;
     psa_status_t status;
 
     if ((in_len != 2) || (out_len != 1)) {
         return PSA_ERROR_CONNECTION_REFUSED;
     }
 
+    audit_sync_log();
+
     if (in_vec[0].len != sizeof(uint32_t)) {
         return PSA_ERROR_CONNECTION_REFUSED;
     }
@@ -772,18 +1005,11 @@ psa_status_t audit_core_retrieve_record(psa_invec in_vec[],
         return PSA_ERROR_BUFFER_TOO_SMALL;
     }
 
-    /* First element to read from the log */
-    start_idx = log_state.first_el_idx;
-
-    /* Move the start_idx index to the desired element */
-    for (idx=0; idx<record_index; idx++) {
-        start_idx = GET_NEXT_LOG_INDEX(start_idx);
-    }
+    /* Index of the requested element in the log */
+    start_idx = GET_RECORD_LOG_INDEX(record_index);
 
     /* Do the copy */
-    for (idx=0; idx<record_size_tmp; idx++) {
-        buffer[idx] = log_buffer[(start_idx + idx) % LOG_SIZE];
-    }
+    audit_buffer_read(start_idx, record_size_tmp, buffer);
 
     /* Update the retrieved size */
     out_vec[0].len = record_size_tmp;
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "audit_filter.h"
+#include "tfm_hal_device_header.h"
+#include "secure_fw/core/include/tfm_cycle_counter.h"
+
+/*!
+ * \var filter_rules
+ *
+ * \brief Rules of the filter, in the order they are checked. System
+ *        integrators can replace the default rules, which keep the errors,
+ *        limit the rate of the other records and drop the ones below
+ *        AUDIT_FILTER_MIN_SEVERITY.
+ */
+static const struct audit_filter_rule filter_rules[] = {
+    {
+        .id_mask = 0,
+        .id_value = 0,
+        .partition_id = AUDIT_FILTER_ANY_PARTITION,
+        .min_severity = PSA_AUDIT_SEVERITY_ERROR,
+        .action = AUDIT_FILTER_ACCEPT,
+    },
+    {
+        .id_mask = 0,
+        .id_value = 0,
+        .partition_id = AUDIT_FILTER_ANY_PARTITION,
+        .min_severity = AUDIT_FILTER_MIN_SEVERITY,
+        .action = AUDIT_FILTER_LIMIT,
+        .burst = AUDIT_FILTER_BURST,
+        .rate = AUDIT_FILTER_RATE,
+    },
+    {
+        .id_mask = 0,
+        .id_value = 0,
+        .partition_id = AUDIT_FILTER_ANY_PARTITION,
+        .min_severity = PSA_AUDIT_SEVERITY_DEBUG,
+        .action = AUDIT_FILTER_DROP,
+    },
+};
+
+#define AUDIT_FILTER_NUM_RULES (sizeof(filter_rules) / sizeof(filter_rules[0]))
+
+#ifdef TFM_HAS_CYCLE_COUNTER
+/*!
+ * \struct audit_filter_bucket
+ *
+ * \brief Token bucket of an AUDIT_FILTER_LIMIT rule, kept as the time the
+ *        bucket is full again: a record is accepted when the bucket would be
+ *        full again within (burst - 1) intervals, which then moves by one
+ *        interval.
+ */
+struct audit_filter_bucket {
+    uint32_t interval;  /*!< Cycles between two records at the rule rate */
+    uint32_t tolerance; /*!< Cycles of (burst - 1) intervals */
+    uint32_t full_at;   /*!< Cycle count when the bucket is full again */
+};
+
+/*!
+ * \var filter_buckets
+ *
+ * \brief Token buckets of the rules, of which only the AUDIT_FILTER_LIMIT
+ *        ones are used
+ */
+static struct audit_filter_bucket filter_buckets[AUDIT_FILTER_NUM_RULES];
+
+/*!
+ * \brief Static function to check a record against the token bucket of a
+ *        rule
+ *
+ * \note The cycle counter wraps around, so a bucket emptied by a burst can
+ *       refill late after 2^31 cycles without records.
+ */
+static bool audit_filter_take_token(struct audit_filter_bucket *bucket)
+{
+    uint32_t now = tfm_cycle_counter_read();
+
+    if (bucket->interval == 0) {
+        return true;
+    }
+
+    /* The bucket is full */
+    if ((int32_t)(bucket->full_at - now) < 0) {
+        bucket->full_at = now;
+    }
+
+    /* The bucket is empty */
+    if (bucket->full_at - now > bucket->tolerance) {
+        return false;
+    }
+
+    bucket->full_at += bucket->interval;
+
+    return true;
+}
+#endif
+
+void audit_filter_init(void)
+{
+#ifdef TFM_HAS_CYCLE_COUNTER
+    uint32_t i;
+
+    /* The partition is a PSA RoT one, so it runs privileged and can start the
+     * cycle counter itself. Without it, the buckets are left unlimited.
+     */
+    if (!tfm_cycle_counter_start(false)) {
+        return;
+    }
+
+    for (i = 0; i < AUDIT_FILTER_NUM_RULES; i++) {
+        if ((filter_rules[i].action != AUDIT_FILTER_LIMIT) ||
+            (filter_rules[i].rate == 0) || (filter_rules[i].burst == 0)) {
+            continue;
+        }
+        filter_buckets[i].interval = SystemCoreClock / filter_rules[i].rate;
+        filter_buckets[i].tolerance = filter_buckets[i].interval *
+                                      (filter_rules[i].burst - 1U);
+        filter_buckets[i].full_at = tfm_cycle_counter_read();
+    }
+#endif
+}
+
+bool audit_filter_accept(const struct psa_audit_record *record,
+                         int32_t partition_id)
+{
+    const struct audit_filter_rule *rule;
+    uint32_t severity = PSA_AUDIT_SEVERITY(record->id);
+    uint32_t i;
+
+    for (i = 0; i < AUDIT_FILTER_NUM_RULES; i++) {
+        rule = &filter_rules[i];
+
+        if (((record->id & rule->id_mask) != rule->id_value) ||
+            ((rule->partition_id != AUDIT_FILTER_ANY_PARTITION) &&
+             (rule->partition_id != partition_id)) ||
+            (severity < rule->min_severity)) {
+            continue;
+        }
+
+        switch (rule->action) {
+        case AUDIT_FILTER_DROP:
+            return false;
+        case AUDIT_FILTER_LIMIT:
+#ifdef TFM_HAS_CYCLE_COUNTER
+            return audit_filter_take_token(&filter_buckets[i]);
+#else
+            return true;
+#endif
+        default:
+            return true;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __AUDIT_FILTER_H__
+#define __AUDIT_FILTER_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "psa_audit_defs.h"
+
+/*!
+ * \def AUDIT_FILTER_MIN_SEVERITY
+ *
+ * \brief Severity below which the records are dropped by the default rules
+ */
+#ifndef AUDIT_FILTER_MIN_SEVERITY
+#define AUDIT_FILTER_MIN_SEVERITY (PSA_AUDIT_SEVERITY_DEBUG)
+#endif
+
+/*!
+ * \def AUDIT_FILTER_RATE
+ *
+ * \brief Number of records per second accepted by the default rules, the
+ *        records of severity PSA_AUDIT_SEVERITY_ERROR and above excepted
+ */
+#ifndef AUDIT_FILTER_RATE
+#define AUDIT_FILTER_RATE (32)
+#endif
+
+/*!
+ * \def AUDIT_FILTER_BURST
+ *
+ * \brief Number of records the default rules accept at once, after a period
+ *        without records
+ */
+#ifndef AUDIT_FILTER_BURST
+#define AUDIT_FILTER_BURST (8)
+#endif
+
+/*!
+ * \def AUDIT_FILTER_ANY_PARTITION
+ *
+ * \brief Partition ID of a rule which applies to all the partitions
+ */
+#define AUDIT_FILTER_ANY_PARTITION (-1)
+
+/*!
+ * \enum audit_filter_action
+ *
+ * \brief What is done with the records matching a rule
+ */
+enum audit_filter_action {
+    AUDIT_FILTER_ACCEPT = 0, /*!< The records are added to the log */
+    AUDIT_FILTER_DROP,       /*!< The records are dropped */
+    AUDIT_FILTER_LIMIT,      /*!< The records are added up to the rate of the
+                              *   rule, the others are dropped
+                              */
+};
+
+/*!
+ * \struct audit_filter_rule
+ *
+ * \brief Rule of the record filter. A record matches the rule when
+ *        (id & id_mask) == id_value, it comes from the partition of the rule
+ *        and its severity is at least min_severity. The first rule matched
+ *        by a record gives its action, a record which matches no rule is
+ *        added to the log.
+ */
+struct audit_filter_rule {
+    uint32_t id_mask;       /*!< Bits of the record ID compared */
+    uint32_t id_value;      /*!< Value of the compared bits */
+    int32_t partition_id;   /*!< Partition of the records, or
+                             *   \ref AUDIT_FILTER_ANY_PARTITION
+                             */
+    uint8_t min_severity;   /*!< Lowest severity of the records */
+    uint8_t action;         /*!< \ref audit_filter_action */
+    uint16_t burst;         /*!< AUDIT_FILTER_LIMIT: records accepted at once */
+    uint32_t rate;          /*!< AUDIT_FILTER_LIMIT: records per second */
+};
+
+/*!
+ * \brief Initializes the rate limits of the filter
+ */
+void audit_filter_init(void);
+
+/*!
+ * \brief Checks a record against the filter rules, before it is formatted
+ *        and added to the log
+ *
+ * \details The rate limits are token buckets, refilled with the cycle
+ *          counter of the core. On cores without a cycle counter, the
+ *          AUDIT_FILTER_LIMIT rules accept all the records.
+ *
+ * \param[in] record       Pointer to the record to be added
+ * \param[in] partition_id ID of the partition which requests the addition
+ *
+ * \return Returns true if the record has to be added to the log, false if it
+ *         is dropped
+ */
+bool audit_filter_accept(const struct psa_audit_record *record,
+                         int32_t partition_id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AUDIT_FILTER_H__ */
@@ -0,0 +1,441 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include "audit_core.h"
+#include "audit_persist.h"
+#include "flash_layout.h"
+#include "psa/crypto.h"
+#include "psa/internal_trusted_storage.h"
+#include "platform/include/tfm_plat_crypto_keys.h"
+#include "tfm_memory_utils.h"
+
+/*!
+ * \def AUDIT_SEGMENT_SIZE
+ *
+ * \brief Size in bytes of a segment of the persistent log, header included.
+ *        Each segment is stored as one ITS asset.
+ */
+#ifndef AUDIT_SEGMENT_SIZE
+#define AUDIT_SEGMENT_SIZE (ITS_MAX_ASSET_SIZE)
+#endif
+
+/*!
+ * \def AUDIT_NUM_SEGMENTS
+ *
+ * \brief Number of segments of the persistent log. When all of them are
+ *        written, the oldest one is replaced.
+ */
+#ifndef AUDIT_NUM_SEGMENTS
+#define AUDIT_NUM_SEGMENTS (4)
+#endif
+
+/*!
+ * \def AUDIT_SEGMENT_UID_BASE
+ *
+ * \brief ITS UID of the first segment, the others follow it
+ */
+#define AUDIT_SEGMENT_UID_BASE (0x41554400UL)
+
+/*!
+ * \def AUDIT_CHAIN_SIZE
+ *
+ * \brief Size in bytes of a value of the MAC chain, an HMAC-SHA256 output
+ */
+#define AUDIT_CHAIN_SIZE (32)
+
+/*!
+ * \def AUDIT_MAC_KEY_SIZE
+ *
+ * \brief Size in bytes of the key of the MAC chain, derived from the HUK
+ */
+#define AUDIT_MAC_KEY_SIZE (16)
+
+/*!
+ * \def AUDIT_ENTRY_HDR_SIZE
+ *
+ * \brief Size in bytes of the start of a log entry which gives its size, i.e.
+ *        [TIMESTAMP][IV_COUNTER][PARTITION_ID][SIZE]
+ */
+#define AUDIT_ENTRY_HDR_SIZE (offsetof(struct log_hdr, id))
+
+/*!
+ * \def AUDIT_NO_RECORD_START
+ *
+ * \brief Value of first_rec_off for a segment in which no record starts
+ */
+#define AUDIT_NO_RECORD_START (0xFFFFU)
+
+/*!
+ * \struct audit_segment_hdr
+ *
+ * \brief Header of a segment of the persistent log. The records are appended
+ *        back to back after it, and can continue in the next segment.
+ */
+struct audit_segment_hdr {
+    uint32_t seq;           /*!< Sequence number of the segment, from 1 */
+    uint16_t data_size;     /*!< Size in bytes of the records after the
+                             *   header
+                             */
+    uint16_t first_rec_off; /*!< Offset of the first record which starts in
+                             *   the segment, or AUDIT_NO_RECORD_START
+                             */
+    uint8_t chain[AUDIT_CHAIN_SIZE]; /*!< Chain value before that record */
+};
+
+/*!
+ * \def AUDIT_SEGMENT_DATA_SIZE
+ *
+ * \brief Size in bytes of the records a segment can hold
+ */
+#define AUDIT_SEGMENT_DATA_SIZE (AUDIT_SEGMENT_SIZE - \
+                                 sizeof(struct audit_segment_hdr))
+
+/*!
+ * \var audit_stage
+ *
+ * \brief RAM copy of the segment being filled, written to ITS when it is full.
+ *        Also used to read the segments back when the log is restored.
+ */
+static struct {
+    struct audit_segment_hdr hdr;
+    uint8_t data[AUDIT_SEGMENT_DATA_SIZE];
+} audit_stage;
+
+/*!
+ * \var audit_chain
+ *
+ * \brief Chain value of the last record
+ */
+static uint8_t audit_chain[AUDIT_CHAIN_SIZE];
+
+/*!
+ * \var audit_mac_key
+ *
+ * \brief Handle of the key of the MAC chain, imported on first use
+ */
+static psa_key_handle_t audit_mac_key;
+static uint32_t audit_mac_key_loaded;
+
+/*!
+ * \struct audit_restore_ctx
+ *
+ * \brief State of the assembly of a record read back from the segments
+ */
+struct audit_restore_ctx {
+    uint8_t *buf;                  /*!< Buffer of the record */
+    uint32_t buf_size;             /*!< Size in bytes of the buffer */
+    uint32_t asm_len;              /*!< Bytes of the record assembled */
+    uint32_t rec_len;              /*!< Size in bytes of the record, valid
+                                    *   once its header is assembled
+                                    */
+    uint32_t in_sync;              /*!< 1 if the chain value before the
+                                    *   record being assembled is known
+                                    */
+    audit_persist_replay_t replay; /*!< Function called for each record */
+};
+
+static psa_status_t audit_load_mac_key(void)
+{
+    static const uint8_t label[] = "TFM_AUDIT_LOG_MAC";
+    uint8_t key[AUDIT_MAC_KEY_SIZE];
+    psa_key_attributes_t key_attributes = psa_key_attributes_init();
+    psa_status_t status;
+
+    if (audit_mac_key_loaded) {
+        return PSA_SUCCESS;
+    }
+
+    if (tfm_plat_get_huk_derived_key(label, sizeof(label) - 1, NULL, 0,
+                                     key, sizeof(key)) !=
+                                                        TFM_PLAT_ERR_SUCCESS) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    psa_set_key_usage_flags(&key_attributes, PSA_KEY_USAGE_SIGN_HASH);
+    psa_set_key_algorithm(&key_attributes, PSA_ALG_HMAC(PSA_ALG_SHA_256));
+    psa_set_key_type(&key_attributes, PSA_KEY_TYPE_HMAC);
+
+    status = psa_import_key(&key_attributes, key, sizeof(key), &audit_mac_key);
+    (void)tfm_memset(key, 0, sizeof(key));
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    audit_mac_key_loaded = 1;
+
+    return PSA_SUCCESS;
+}
+
+/*!
+ * \brief Computes the chain value of a log entry
+ *
+ * \param[in]  chain      Chain value of the previous entry
+ * \param[in]  entry      Pointer to the log entry
+ * \param[in]  entry_size Size in bytes of the log entry, MAC included
+ * \param[out] next_chain Chain value of the entry
+ *
+ * \return Returns PSA_SUCCESS if the value has been computed, otherwise error
+ *         as specified in \ref psa_status_t
+ */
+static psa_status_t audit_chain_entry(const uint8_t *chain,
+                                      const uint8_t *entry,
+                                      uint32_t entry_size,
+                                      uint8_t *next_chain)
+{
+    psa_mac_operation_t operation = psa_mac_operation_init();
+    psa_status_t status;
+    size_t mac_len;
+
+    status = psa_mac_sign_setup(&operation, audit_mac_key,
+                                PSA_ALG_HMAC(PSA_ALG_SHA_256));
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    status = psa_mac_update(&operation, chain, AUDIT_CHAIN_SIZE);
+    if (status == PSA_SUCCESS) {
+        status = psa_mac_update(&operation, entry, entry_size - LOG_MAC_SIZE);
+    }
+    if (status == PSA_SUCCESS) {
+        status = psa_mac_sign_finish(&operation, next_chain, AUDIT_CHAIN_SIZE,
+                                     &mac_len);
+    }
+    if (status != PSA_SUCCESS) {
+        (void)psa_mac_abort(&operation);
+    }
+
+    return status;
+}
+
+static inline psa_storage_uid_t audit_segment_uid(uint32_t seq)
+{
+    return AUDIT_SEGMENT_UID_BASE + (seq % AUDIT_NUM_SEGMENTS);
+}
+
+static void audit_stage_reset(uint32_t seq)
+{
+    audit_stage.hdr.seq = seq;
+    audit_stage.hdr.data_size = 0;
+    audit_stage.hdr.first_rec_off = AUDIT_NO_RECORD_START;
+}
+
+/*!
+ * \brief Writes the staged segment to ITS and starts the next one. The
+ *        segment is dropped if it cannot be written, which leaves a gap in
+ *        the sequence numbers.
+ */
+static psa_status_t audit_flush_segment(void)
+{
+    psa_status_t status;
+
+    status = psa_its_set(audit_segment_uid(audit_stage.hdr.seq),
+                         sizeof(audit_stage.hdr) + audit_stage.hdr.data_size,
+                         &audit_stage, PSA_STORAGE_FLAG_NONE);
+
+    audit_stage_reset(audit_stage.hdr.seq + 1);
+
+    return status;
+}
+
+/*!
+ * \brief Feeds bytes of the segments to the record being assembled, and
+ *        replays each complete record whose MAC is right
+ *
+ * \return Returns PSA_SUCCESS, or the error of the Crypto service. A record
+ *         which is malformed or whose MAC is wrong puts the context out of
+ *         sync, and the remaining bytes are ignored.
+ */
+static psa_status_t audit_restore_feed(struct audit_restore_ctx *ctx,
+                                       const uint8_t *data, uint32_t size)
+{
+    uint8_t next_chain[AUDIT_CHAIN_SIZE];
+    uint32_t pos = 0;
+    uint32_t need, len;
+    uint32_t rec_size;
+    psa_status_t status;
+
+    while (ctx->in_sync && (pos < size)) {
+        if (ctx->asm_len < AUDIT_ENTRY_HDR_SIZE) {
+            need = AUDIT_ENTRY_HDR_SIZE - ctx->asm_len;
+        } else {
+            need = ctx->rec_len - ctx->asm_len;
+        }
+        len = (size - pos < need) ? (size - pos) : need;
+
+        (void)tfm_memcpy(&ctx->buf[ctx->asm_len], &data[pos], len);
+        ctx->asm_len += len;
+        pos += len;
+
+        if (ctx->asm_len == AUDIT_ENTRY_HDR_SIZE) {
+            rec_size = ((const struct log_hdr *)ctx->buf)->size;
+            ctx->rec_len = AUDIT_ENTRY_HDR_SIZE + rec_size + LOG_MAC_SIZE;
+            if ((rec_size % 4) || (ctx->rec_len > ctx->buf_size)) {
+                ctx->in_sync = 0;
+                ctx->asm_len = 0;
+                break;
+            }
+        }
+
+        if ((ctx->asm_len > AUDIT_ENTRY_HDR_SIZE) &&
+            (ctx->asm_len == ctx->rec_len)) {
+            status = audit_chain_entry(audit_chain, ctx->buf, ctx->rec_len,
+                                       next_chain);
+            if (status != PSA_SUCCESS) {
+                return status;
+            }
+
+            ctx->asm_len = 0;
+            if (tfm_memcmp(next_chain, &ctx->buf[ctx->rec_len - LOG_MAC_SIZE],
+                           LOG_MAC_SIZE) != 0) {
+                ctx->in_sync = 0;
+                break;
+            }
+
+            (void)tfm_memcpy(audit_chain, next_chain, AUDIT_CHAIN_SIZE);
+            ctx->replay(ctx->buf, ctx->rec_len);
+        }
+    }
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t audit_persist_restore(uint8_t *buf, uint32_t buf_size,
+                                   audit_persist_replay_t replay)
+{
+    struct audit_restore_ctx ctx = {buf, buf_size, 0, 0, 0, replay};
+    struct audit_segment_hdr *hdr = &audit_stage.hdr;
+    uint32_t max_seq = 0, seq, idx;
+    uint32_t first_off, cont_size;
+    size_t len;
+    psa_status_t status;
+
+    (void)tfm_memset(audit_chain, 0, sizeof(audit_chain));
+
+    status = audit_load_mac_key();
+    if (status != PSA_SUCCESS) {
+        audit_stage_reset(1);
+        return status;
+    }
+
+    /* Find the most recent segment */
+    for (idx = 0; idx < AUDIT_NUM_SEGMENTS; idx++) {
+        status = psa_its_get(AUDIT_SEGMENT_UID_BASE + idx, 0, sizeof(*hdr),
+                             hdr, &len);
+        if ((status == PSA_SUCCESS) && (len == sizeof(*hdr)) &&
+            ((hdr->seq % AUDIT_NUM_SEGMENTS) == idx) && (hdr->seq > max_seq)) {
+            max_seq = hdr->seq;
+        }
+    }
+
+    seq = (max_seq > AUDIT_NUM_SEGMENTS) ? (max_seq - AUDIT_NUM_SEGMENTS + 1)
+                                         : 1;
+    for (; (max_seq != 0) && (seq <= max_seq); seq++) {
+        status = psa_its_get(audit_segment_uid(seq), 0, sizeof(audit_stage),
+                             &audit_stage, &len);
+        if ((status != PSA_SUCCESS) || (len < sizeof(*hdr)) ||
+            (hdr->seq != seq) || (hdr->data_size > AUDIT_SEGMENT_DATA_SIZE) ||
+            (len != sizeof(*hdr) + hdr->data_size)) {
+            /* Missing segment, the chain resumes at the next record start */
+            ctx.in_sync = 0;
+            ctx.asm_len = 0;
+            continue;
+        }
+
+        first_off = hdr->first_rec_off;
+        if ((first_off != AUDIT_NO_RECORD_START) &&
+            (first_off > hdr->data_size)) {
+            ctx.in_sync = 0;
+            ctx.asm_len = 0;
+            continue;
+        }
+
+        /* The bytes before the first record start end the pending record */
+        if (ctx.asm_len > 0) {
+            cont_size = (first_off == AUDIT_NO_RECORD_START) ? hdr->data_size
+                                                             : first_off;
+            status = audit_restore_feed(&ctx, audit_stage.data, cont_size);
+            if (status != PSA_SUCCESS) {
+                break;
+            }
+        }
+
+        if (first_off == AUDIT_NO_RECORD_START) {
+            continue;
+        }
+
+        /* A record which does not end where the next one starts was not
+         * completely written, and is dropped.
+         */
+        ctx.asm_len = 0;
+        ctx.in_sync = 1;
+        (void)tfm_memcpy(audit_chain, hdr->chain, AUDIT_CHAIN_SIZE);
+
+        status = audit_restore_feed(&ctx, &audit_stage.data[first_off],
+                                    hdr->data_size - first_off);
+        if (status != PSA_SUCCESS) {
+            break;
+        }
+    }
+
+    /* The new records go to a new segment, chained to the last restored
+     * record.
+     */
+    audit_stage_reset(max_seq + 1);
+
+    return status;
+}
+
+psa_status_t audit_persist_add(uint8_t *entry, uint32_t entry_size)
+{
+    uint8_t next_chain[AUDIT_CHAIN_SIZE];
+    uint32_t copied = 0, len;
+    psa_status_t status;
+    psa_status_t flush_status = PSA_SUCCESS;
+
+    status = audit_load_mac_key();
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    status = audit_chain_entry(audit_chain, entry, entry_size, next_chain);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    (void)tfm_memcpy(&entry[entry_size - LOG_MAC_SIZE], next_chain,
+                     LOG_MAC_SIZE);
+
+    if (audit_stage.hdr.first_rec_off == AUDIT_NO_RECORD_START) {
+        audit_stage.hdr.first_rec_off = audit_stage.hdr.data_size;
+        (void)tfm_memcpy(audit_stage.hdr.chain, audit_chain,
+                         AUDIT_CHAIN_SIZE);
+    }
+    (void)tfm_memcpy(audit_chain, next_chain, AUDIT_CHAIN_SIZE);
+
+    /* Stage the entry, writing each segment it fills */
+    while (copied < entry_size) {
+        len = AUDIT_SEGMENT_DATA_SIZE - audit_stage.hdr.data_size;
+        if (len > entry_size - copied) {
+            len = entry_size - copied;
+        }
+
+        (void)tfm_memcpy(&audit_stage.data[audit_stage.hdr.data_size],
+                         &entry[copied], len);
+        audit_stage.hdr.data_size += len;
+        copied += len;
+
+        if (audit_stage.hdr.data_size == AUDIT_SEGMENT_DATA_SIZE) {
+            if (audit_flush_segment() != PSA_SUCCESS) {
+                flush_status = PSA_ERROR_STORAGE_FAILURE;
+            }
+        }
+    }
+
+    return flush_status;
+}
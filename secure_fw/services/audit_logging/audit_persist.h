@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __AUDIT_PERSIST_H__
+#define __AUDIT_PERSIST_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#include "psa/error.h"
+
+/*!
+ * \brief Function called for each record restored from the persistent log
+ *
+ * \param[in] entry      Pointer to the log entry, MAC included
+ * \param[in] entry_size Size in bytes of the log entry
+ */
+typedef void (*audit_persist_replay_t)(const uint8_t *entry,
+                                       uint32_t entry_size);
+
+/*!
+ * \brief Restores the records of the persistent log, oldest first
+ *
+ * \details Each record is checked against the MAC chain before it is passed
+ *          to the replay function. The records which cannot be checked, or
+ *          whose MAC is wrong, are skipped up to the next record whose chain
+ *          value is known. The records appended afterwards continue the chain
+ *          from the last restored record.
+ *
+ * \param[out] buf      Buffer used to assemble the records, which must be able
+ *                      to hold the largest log entry
+ * \param[in]  buf_size Size in bytes of the buffer
+ * \param[in]  replay   Function called for each restored record
+ *
+ * \return Returns PSA_SUCCESS if the log has been restored, otherwise error as
+ *         specified in \ref psa_status_t
+ */
+psa_status_t audit_persist_restore(uint8_t *buf, uint32_t buf_size,
+                                   audit_persist_replay_t replay);
+
+/*!
+ * \brief Chains a new log entry to the previous one and appends it to the
+ *        persistent log
+ *
+ * \details The MAC field of the entry is set to the first bytes of
+ *          HMAC-SHA256(K, chain || entry without MAC), where chain is the full
+ *          value computed for the previous entry. The entry is staged in RAM,
+ *          and written to the Internal Trusted Storage one full segment at a
+ *          time.
+ *
+ * \param[in,out] entry      Pointer to the formatted log entry
+ * \param[in]     entry_size Size in bytes of the log entry
+ *
+ * \return Returns PSA_SUCCESS if the entry has been chained and staged.
+ *         PSA_ERROR_STORAGE_FAILURE if it has been chained but a segment
+ *         could not be written, otherwise error as specified in
+ *         \ref psa_status_t
+ */
+psa_status_t audit_persist_add(uint8_t *entry, uint32_t entry_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AUDIT_PERSIST_H__ */
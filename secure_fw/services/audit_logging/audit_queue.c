@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdint.h>
+#include "audit_queue.h"
+#include "tfm_memory_utils.h"
+
+#if (AUDIT_QUEUE_LEN & (AUDIT_QUEUE_LEN - 1)) != 0
+#error "AUDIT_QUEUE_LEN must be a power of 2"
+#endif
+
+#if (AUDIT_QUEUE_RECORD_SIZE % 4) != 0
+#error "AUDIT_QUEUE_RECORD_SIZE must be a multiple of 4 bytes"
+#endif
+
+/*!
+ * \struct audit_queue_slot
+ *
+ * \brief Slot of the queue. The slot is free for the producer which claims
+ *        position pos when tag + index == pos, and holds the record queued at
+ *        position pos when tag + index == pos + 1, index being the index of
+ *        the slot. This way the zero initialised queue is empty.
+ */
+struct audit_queue_slot {
+    uint32_t tag;          /*!< Position tag of the slot, see above */
+    int32_t partition_id;  /*!< ID of the partition which queued the record */
+    uint32_t record[AUDIT_QUEUE_RECORD_SIZE / 4]; /*!< Queued record */
+};
+
+/*!
+ * \var queue_slots
+ *
+ * \brief Slots of the queue, written by the producers and read by the Audit
+ *        logging service
+ */
+static struct audit_queue_slot queue_slots[AUDIT_QUEUE_LEN];
+
+/*!
+ * \var queue_head
+ *
+ * \brief Position of the next slot to be claimed by a producer, only updated
+ *        with a compare and swap
+ */
+static uint32_t queue_head = 0;
+
+/*!
+ * \var queue_tail
+ *
+ * \brief Position of the next slot to be drained, only accessed by the Audit
+ *        logging service
+ */
+static uint32_t queue_tail = 0;
+
+psa_status_t audit_queue_push(const struct psa_audit_record *record,
+                              int32_t partition_id)
+{
+    struct audit_queue_slot *slot;
+    uint32_t size = record->size;
+    uint32_t pos, idx, seq;
+    int32_t diff;
+
+    if ((size % 4) || (size > AUDIT_QUEUE_RECORD_SIZE - sizeof(uint32_t))) {
+        return PSA_ERROR_NOT_SUPPORTED;
+    }
+
+    /* Claim the slot at the head position */
+    pos = __atomic_load_n(&queue_head, __ATOMIC_RELAXED);
+    for (;;) {
+        idx = pos % AUDIT_QUEUE_LEN;
+        slot = &queue_slots[idx];
+        seq = __atomic_load_n(&slot->tag, __ATOMIC_ACQUIRE) + idx;
+        diff = (int32_t)(seq - pos);
+
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&queue_head, &pos, pos + 1, 1,
+                                            __ATOMIC_RELAXED,
+                                            __ATOMIC_RELAXED)) {
+                break;
+            }
+            /* Another producer has claimed it, pos is the new head */
+        } else if (diff < 0) {
+            /* The slot still holds a record which is not drained */
+            return PSA_ERROR_INSUFFICIENT_MEMORY;
+        } else {
+            pos = __atomic_load_n(&queue_head, __ATOMIC_RELAXED);
+        }
+    }
+
+    /* Copy the size field read above, then the id and payload */
+    slot->partition_id = partition_id;
+    slot->record[0] = size;
+    (void)tfm_memcpy(&slot->record[1], &record->id, size);
+
+    /* Publish the record to the service */
+    __atomic_store_n(&slot->tag, pos + 1 - idx, __ATOMIC_RELEASE);
+
+    return PSA_SUCCESS;
+}
+
+void audit_queue_drain(audit_queue_consumer_t consumer)
+{
+    struct audit_queue_slot *slot;
+    uint32_t idx;
+
+    for (;;) {
+        idx = queue_tail % AUDIT_QUEUE_LEN;
+        slot = &queue_slots[idx];
+
+        if (__atomic_load_n(&slot->tag, __ATOMIC_ACQUIRE) + idx !=
+                                                             queue_tail + 1) {
+            /* Empty, or the producer has not finished writing the slot */
+            break;
+        }
+
+        consumer((const struct psa_audit_record *)slot->record,
+                 slot->partition_id);
+
+        /* Free the slot for the position one lap ahead */
+        __atomic_store_n(&slot->tag, queue_tail + AUDIT_QUEUE_LEN - idx,
+                         __ATOMIC_RELEASE);
+        queue_tail++;
+    }
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __AUDIT_QUEUE_H__
+#define __AUDIT_QUEUE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#include "psa_audit_defs.h"
+#include "psa/error.h"
+
+/*!
+ * \def AUDIT_QUEUE_LEN
+ *
+ * \brief Number of records the queue can hold before they are added to the
+ *        log
+ */
+#ifndef AUDIT_QUEUE_LEN
+#define AUDIT_QUEUE_LEN (8)
+#endif
+
+/*!
+ * \def AUDIT_QUEUE_RECORD_SIZE
+ *
+ * \brief Maximum size in bytes of a queued record, i.e. of its size, id and
+ *        payload fields. Larger records are added synchronously.
+ *
+ * \note Must be a multiple of 4 bytes.
+ */
+#ifndef AUDIT_QUEUE_RECORD_SIZE
+#define AUDIT_QUEUE_RECORD_SIZE (64)
+#endif
+
+/*!
+ * \brief Function called for each record drained from the queue
+ *
+ * \param[in] record       Pointer to the queued record
+ * \param[in] partition_id ID of the partition which queued the record
+ */
+typedef void (*audit_queue_consumer_t)(const struct psa_audit_record *record,
+                                       int32_t partition_id);
+
+/*!
+ * \brief Queues a record to be added to the log by the Audit logging service
+ *
+ * \details This is called by any secure partition, in its own context, and
+ *          does not wait for the service: the record is copied to the next
+ *          free slot of the queue, claimed with an atomic compare and swap.
+ *
+ * \param[in] record       Pointer to the record to be queued
+ * \param[in] partition_id ID of the partition which requests the addition
+ *
+ * \return Returns PSA_SUCCESS if the record has been queued.
+ *         PSA_ERROR_INSUFFICIENT_MEMORY if the queue is full, and
+ *         PSA_ERROR_NOT_SUPPORTED if the record is larger than
+ *         \ref AUDIT_QUEUE_RECORD_SIZE or malformed, in which cases the record
+ *         has to be added synchronously.
+ */
+psa_status_t audit_queue_push(const struct psa_audit_record *record,
+                              int32_t partition_id);
+
+/*!
+ * \brief Drains the queue, passing the records to the consumer in the order
+ *        they have been queued
+ *
+ * \details Only the Audit logging service drains the queue. It stops at the
+ *          first slot which has been claimed but is not completely written
+ *          yet.
+ *
+ * \param[in] consumer Function called for each queued record
+ */
+void audit_queue_drain(audit_queue_consumer_t consumer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AUDIT_QUEUE_H__ */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -7,6 +7,10 @@
 
 #include "psa_audit_api.h"
 #include "tfm_veneers.h"
+#ifdef AUDIT_ASYNC_ADD_RECORD
+#include "audit_queue.h"
+#include "spm_api.h"
+#endif
 
 #define ARRAY_SIZE(arr) (sizeof(arr)/sizeof(arr[0]))
 
@@ -103,6 +107,21 @@ psa_status_t psa_audit_add_record(const struct psa_audit_record *record)
     psa_invec in_vec[] = {
         {.base = record, .len = sizeof(struct psa_audit_record)},
     };
+#ifdef AUDIT_ASYNC_ADD_RECORD
+    int32_t partition_id;
+
+    /* With isolation level 1 the caller can read its own partition ID and
+     * write to the queue, so the record is queued without entering the SPM.
+     * It is added synchronously when the queue is full, the record doesn't
+     * fit in a slot, or the caller is the non-secure partition.
+     */
+    partition_id = (int32_t)tfm_spm_partition_get_partition_id(
+                               tfm_spm_partition_get_running_partition_idx());
+    if ((partition_id != TFM_SP_NON_SECURE_ID) &&
+        (audit_queue_push(record, partition_id) == PSA_SUCCESS)) {
+        return PSA_SUCCESS;
+    }
+#endif
 
     status = API_DISPATCH_NO_OUTVEC(audit_core_add_record);
 
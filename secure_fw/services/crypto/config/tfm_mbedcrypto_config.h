@@ -1200,7 +1200,7 @@
  *
  * Module:  library/chacha20.c
  */
-//#define MBEDTLS_CHACHA20_C
+#define MBEDTLS_CHACHA20_C
 
 /**
  * \def MBEDTLS_CHACHAPOLY_C
@@ -1211,7 +1211,7 @@
  *
  * This module requires: MBEDTLS_CHACHA20_C, MBEDTLS_POLY1305_C
  */
-//#define MBEDTLS_CHACHAPOLY_C
+#define MBEDTLS_CHACHAPOLY_C
 
 /**
  * \def MBEDTLS_CIPHER_C
@@ -1695,7 +1695,7 @@
  * Module:  library/poly1305.c
  * Caller:  library/chachapoly.c
  */
-//#define MBEDTLS_POLY1305_C
+#define MBEDTLS_POLY1305_C
 
 /**
  * \def MBEDTLS_PSA_CRYPTO_C
@@ -1991,6 +1991,9 @@
 
 /* \} name SECTION: Customisation configuration options */
 
+/* Speed and size trade-off selected for the build */
+#include "tfm_mbedcrypto_profile.h"
+
 #ifdef CRYPTO_HW_ACCELERATOR
 #include "mbedtls_accelerator_config.h"
 #endif
@@ -2004,6 +2007,9 @@
 #include MBEDTLS_USER_CONFIG_FILE
 #endif
 
+/* Bignum kernels for the cores with the DSP extension */
+#include "tfm_mbedtls_bn_mul.h"
+
 #include "mbedtls/check_config.h"
 
 #endif /* MBEDTLS_CONFIG_H */
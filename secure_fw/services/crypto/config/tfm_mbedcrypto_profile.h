@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/**
+ * \file tfm_mbedcrypto_profile.h
+ *
+ * \brief Options of the Mbed Crypto configuration which trade the speed of
+ *        the primitives against their flash and RAM footprint. One profile
+ *        is selected at build time through the MBEDCRYPTO_PROFILE CMake
+ *        option, which defines exactly one of TFM_MBEDCRYPTO_PROFILE_SPEED,
+ *        TFM_MBEDCRYPTO_PROFILE_BALANCED and TFM_MBEDCRYPTO_PROFILE_SIZE.
+ *        This file is included by tfm_mbedcrypto_config.h, before the
+ *        accelerator and user configurations which can still override it.
+ */
+
+#ifndef __TFM_MBEDCRYPTO_PROFILE_H__
+#define __TFM_MBEDCRYPTO_PROFILE_H__
+
+#if defined(TFM_MBEDCRYPTO_PROFILE_SPEED)
+/* The AES tables are generated in RAM at the first AES operation, the
+ * unrolled SHA-256 is used, and the bignum and ECP windows are the widest
+ * that the Mbed Crypto defaults allow. This is the configuration used before
+ * the profiles were introduced.
+ */
+#define MBEDTLS_MPI_WINDOW_SIZE            6
+#define MBEDTLS_ECP_WINDOW_SIZE            6
+#define MBEDTLS_ECP_FIXED_POINT_OPTIM      1
+
+#elif defined(TFM_MBEDCRYPTO_PROFILE_BALANCED)
+/* The AES tables are read from flash, which saves ~8 KB of RAM and their
+ * generation at the first AES operation. The bignum window of 3 bits needs 4
+ * precomputed values instead of 32 for a modular exponentiation, and the ECP
+ * window of 4 bits 8 precomputed points instead of 32 for a multiplication.
+ */
+#define MBEDTLS_AES_ROM_TABLES
+#define MBEDTLS_MPI_WINDOW_SIZE            3
+#define MBEDTLS_ECP_WINDOW_SIZE            4
+#define MBEDTLS_ECP_FIXED_POINT_OPTIM      1
+
+#elif defined(TFM_MBEDCRYPTO_PROFILE_SIZE)
+/* A quarter of the AES tables is kept in flash and the rest is computed on
+ * the fly (~2 KB of flash and no RAM), SHA-256 is not unrolled (~1.5 KB less
+ * flash, ~30% slower), the bignum exponentiation uses no window and the ECP
+ * multiplication the narrowest one, without the fixed point speed-up.
+ */
+#define MBEDTLS_AES_ROM_TABLES
+#define MBEDTLS_AES_FEWER_TABLES
+#define MBEDTLS_SHA256_SMALLER
+#define MBEDTLS_MPI_WINDOW_SIZE            1
+#define MBEDTLS_ECP_WINDOW_SIZE            2
+#define MBEDTLS_ECP_FIXED_POINT_OPTIM      0
+
+#endif /* TFM_MBEDCRYPTO_PROFILE_SPEED */
+
+#endif /* __TFM_MBEDCRYPTO_PROFILE_H__ */
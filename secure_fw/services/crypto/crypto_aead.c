@@ -5,6 +5,7 @@
  *
  */
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -17,6 +18,681 @@
 
 #include "tfm_crypto_api.h"
 #include "tfm_crypto_defs.h"
+#include "tfm_memory_utils.h"
+
+#ifndef TFM_CRYPTO_AEAD_MODULE_DISABLED
+/* Mbed Crypto internals, to get at the material of the key of a multipart
+ * operation, as Mbed Crypto only provides the single-part AEAD functions.
+ */
+#include "psa_crypto_core.h"
+#include "psa_crypto_slot_management.h"
+
+/**
+ * \brief Processes the messages of a batch AEAD request in turn
+ *
+ * The key handle is checked once for the whole batch. Each message gets its
+ * own status in the results, so that a message which fails, e.g. on a tag
+ * mismatch, does not prevent the others from being processed.
+ *
+ * \param[in]  in_vec   Array of invec parameters
+ * \param[in]  in_len   Length of the valid entries in in_vec
+ * \param[out] out_vec  Array of outvec parameters
+ * \param[in]  out_len  Length of the valid entries in out_vec
+ * \param[in]  encrypt  True to encrypt the messages, false to decrypt them
+ *
+ * \return Return values as described in \ref psa_status_t
+ */
+static psa_status_t tfm_crypto_aead_batch(psa_invec in_vec[],
+                                          size_t in_len,
+                                          psa_outvec out_vec[],
+                                          size_t out_len,
+                                          bool encrypt)
+{
+    psa_status_t status = PSA_SUCCESS;
+
+    if (!((in_len == 2) || (in_len == 3)) || (out_len != 2)) {
+        return PSA_ERROR_CONNECTION_REFUSED;
+    }
+
+    if ((in_vec[0].len != sizeof(struct tfm_crypto_pack_iovec)) ||
+        (in_vec[1].len == 0) ||
+        (in_vec[1].len % sizeof(struct tfm_crypto_aead_batch_entry) != 0)) {
+        return PSA_ERROR_CONNECTION_REFUSED;
+    }
+    const struct tfm_crypto_pack_iovec *iov = in_vec[0].base;
+    psa_key_handle_t key_handle = iov->key_handle;
+    psa_algorithm_t alg = iov->alg;
+    const struct tfm_crypto_aead_batch_entry *entries = in_vec[1].base;
+    size_t entry_count = in_vec[1].len /
+                         sizeof(struct tfm_crypto_aead_batch_entry);
+    const uint8_t *input = NULL;
+    size_t input_length = 0;
+    uint8_t *output = out_vec[0].base;
+    size_t output_size = out_vec[0].len;
+    struct tfm_crypto_aead_batch_result *results = out_vec[1].base;
+    size_t in_offset = 0, out_offset = 0, i;
+    size_t data_length, output_length;
+
+    if ((entry_count > TFM_CRYPTO_AEAD_BATCH_MAX_ENTRIES) ||
+        (out_vec[1].len !=
+         entry_count * sizeof(struct tfm_crypto_aead_batch_result))) {
+        return PSA_ERROR_CONNECTION_REFUSED;
+    }
+
+    /* The input buffer is empty if no message has any data */
+    if (in_len == 3) {
+        input = in_vec[2].base;
+        input_length = in_vec[2].len;
+    }
+
+    /* Initialise the output length to zero */
+    out_vec[0].len = 0;
+
+    status = tfm_crypto_check_handle_owner(&key_handle, NULL);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    for (i = 0; i < entry_count; i++) {
+        results[i].output_length = 0;
+
+        data_length = entries[i].additional_data_length +
+                      entries[i].input_length;
+        if ((entries[i].nonce_length > TFM_CRYPTO_MAX_NONCE_LENGTH) ||
+            (data_length < entries[i].input_length) ||
+            (data_length > input_length - in_offset)) {
+            results[i].status = PSA_ERROR_INVALID_ARGUMENT;
+            /* The layout of the following messages is unknown */
+            for (i++; i < entry_count; i++) {
+                results[i].status = PSA_ERROR_INVALID_ARGUMENT;
+                results[i].output_length = 0;
+            }
+            break;
+        }
+
+        if (encrypt) {
+            results[i].status = psa_aead_encrypt(
+                                key_handle, alg,
+                                entries[i].nonce, entries[i].nonce_length,
+                                &input[in_offset],
+                                entries[i].additional_data_length,
+                                &input[in_offset +
+                                       entries[i].additional_data_length],
+                                entries[i].input_length,
+                                &output[out_offset], output_size - out_offset,
+                                &output_length);
+        } else {
+            results[i].status = psa_aead_decrypt(
+                                key_handle, alg,
+                                entries[i].nonce, entries[i].nonce_length,
+                                &input[in_offset],
+                                entries[i].additional_data_length,
+                                &input[in_offset +
+                                       entries[i].additional_data_length],
+                                entries[i].input_length,
+                                &output[out_offset], output_size - out_offset,
+                                &output_length);
+        }
+
+        in_offset += data_length;
+
+        if (results[i].status == PSA_SUCCESS) {
+            results[i].output_length = output_length;
+            out_offset += output_length;
+        }
+    }
+
+    out_vec[0].len = out_offset;
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Stages of a multipart AEAD operation
+ */
+#define TFM_CRYPTO_AEAD_STATE_NONCE (0u) /*!< Waiting for the nonce */
+#define TFM_CRYPTO_AEAD_STATE_AD    (1u) /*!< Taking the additional data */
+#define TFM_CRYPTO_AEAD_STATE_DATA  (2u) /*!< Taking the input data */
+
+/**
+ * \brief Length of the nonces made by psa_aead_generate_nonce(), the one
+ *        recommended for GCM and the only one of ChaCha20-Poly1305
+ */
+#define TFM_CRYPTO_AEAD_GCM_NONCE_LENGTH (12u)
+
+#define TFM_CRYPTO_AEAD_GCM_BLOCK_SIZE (16u)
+
+/**
+ * \brief Length of the keys and tags of ChaCha20-Poly1305
+ */
+#define TFM_CRYPTO_AEAD_CHACHAPOLY_KEY_LENGTH (32u)
+#define TFM_CRYPTO_AEAD_CHACHAPOLY_TAG_LENGTH (16u)
+
+#ifdef MBEDTLS_CHACHAPOLY_C
+/**
+ * \brief Tells whether a multipart AEAD operation is a ChaCha20-Poly1305 one
+ */
+#define TFM_CRYPTO_AEAD_IS_CHACHAPOLY(operation) \
+    (PSA_ALG_AEAD_WITH_DEFAULT_TAG_LENGTH((operation)->alg) == \
+     PSA_ALG_CHACHA20_POLY1305)
+#else
+#define TFM_CRYPTO_AEAD_IS_CHACHAPOLY(operation) (false)
+#endif
+
+/**
+ * \brief Converts an error of the GCM or ChaCha20-Poly1305 modules of Mbed
+ *        Crypto
+ */
+static psa_status_t tfm_crypto_aead_mbedtls_error(int ret)
+{
+    switch (ret) {
+    case 0:
+        return PSA_SUCCESS;
+    case MBEDTLS_ERR_GCM_BAD_INPUT:
+#ifdef MBEDTLS_CHACHAPOLY_C
+    case MBEDTLS_ERR_CHACHA20_BAD_INPUT_DATA:
+    case MBEDTLS_ERR_POLY1305_BAD_INPUT_DATA:
+#endif
+        return PSA_ERROR_INVALID_ARGUMENT;
+#ifdef MBEDTLS_CHACHAPOLY_C
+    case MBEDTLS_ERR_CHACHAPOLY_BAD_STATE:
+        return PSA_ERROR_BAD_STATE;
+#endif
+    default:
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+}
+
+/**
+ * \brief Frees the Mbed Crypto context of a multipart AEAD operation, then
+ *        releases the operation context
+ *
+ * \param[in,out] handle     Handle of the operation, set to
+ *                           TFM_CRYPTO_INVALID_HANDLE once released
+ * \param[in]     operation  Context of the operation
+ *
+ * \return Return values as described in \ref psa_status_t
+ */
+static psa_status_t tfm_crypto_aead_release(
+                                uint32_t *handle,
+                                struct tfm_crypto_aead_operation_s *operation)
+{
+#ifdef MBEDTLS_CHACHAPOLY_C
+    if (TFM_CRYPTO_AEAD_IS_CHACHAPOLY(operation)) {
+        mbedtls_chachapoly_free(&operation->ctx.chachapoly);
+        return tfm_crypto_operation_release(handle);
+    }
+#endif
+    /* The GCM context holds memory allocated by Mbed Crypto */
+    mbedtls_gcm_free(&operation->ctx.gcm);
+
+    return tfm_crypto_operation_release(handle);
+}
+
+#ifdef MBEDTLS_CHACHAPOLY_C
+/**
+ * \brief Keys the ChaCha20-Poly1305 context of a multipart AEAD operation
+ *
+ * \param[in,out] operation   Context of the operation, with the algorithm set
+ * \param[in]     key_handle  Mbed Crypto handle of the key
+ * \param[in]     usage       Usage the key policy must allow
+ *
+ * \return Return values as described in \ref psa_status_t
+ */
+static psa_status_t tfm_crypto_aead_set_key_chachapoly(
+                                  struct tfm_crypto_aead_operation_s *operation,
+                                  psa_key_handle_t key_handle,
+                                  psa_key_usage_t usage)
+{
+    psa_status_t status;
+    psa_key_slot_t *slot = NULL;
+    psa_algorithm_t alg = operation->alg;
+
+    /* As for the single-part functions of Mbed Crypto, the tag can't be
+     * truncated
+     */
+    if (PSA_AEAD_TAG_LENGTH(alg) != TFM_CRYPTO_AEAD_CHACHAPOLY_TAG_LENGTH) {
+        return PSA_ERROR_NOT_SUPPORTED;
+    }
+
+    status = psa_get_key_slot(key_handle, &slot);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    if (((slot->attr.policy.usage & usage) == 0) ||
+        ((alg != slot->attr.policy.alg) && (alg != slot->attr.policy.alg2))) {
+        return PSA_ERROR_NOT_PERMITTED;
+    }
+
+    if (slot->attr.type != PSA_KEY_TYPE_CHACHA20) {
+        return PSA_ERROR_NOT_SUPPORTED;
+    }
+
+    if (slot->data.raw.bytes != TFM_CRYPTO_AEAD_CHACHAPOLY_KEY_LENGTH) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    return tfm_crypto_aead_mbedtls_error(
+                  mbedtls_chachapoly_setkey(&operation->ctx.chachapoly,
+                                            slot->data.raw.data));
+}
+#endif /* MBEDTLS_CHACHAPOLY_C */
+
+/**
+ * \brief Keys the Mbed Crypto context of a multipart AEAD operation, once the
+ *        key policy has been checked as Mbed Crypto would for a single-part
+ *        operation
+ *
+ * \param[out] operation   Context of the operation
+ * \param[in]  key_handle  Mbed Crypto handle of the key
+ * \param[in]  alg         AEAD algorithm
+ * \param[in]  encrypt     True for an encryption, false for a decryption
+ *
+ * \return Return values as described in \ref psa_status_t
+ */
+static psa_status_t tfm_crypto_aead_set_key(
+                                  struct tfm_crypto_aead_operation_s *operation,
+                                  psa_key_handle_t key_handle,
+                                  psa_algorithm_t alg,
+                                  bool encrypt)
+{
+    psa_status_t status;
+    psa_key_slot_t *slot = NULL;
+    psa_key_usage_t usage = encrypt ? PSA_KEY_USAGE_ENCRYPT :
+                                      PSA_KEY_USAGE_DECRYPT;
+    size_t tag_length = PSA_AEAD_TAG_LENGTH(alg);
+
+    operation->encrypt = encrypt ? 1 : 0;
+    operation->state = TFM_CRYPTO_AEAD_STATE_NONCE;
+    operation->tag_length = (uint8_t)tag_length;
+    operation->ad_expected = SIZE_MAX;
+    operation->input_expected = SIZE_MAX;
+
+    if (!PSA_ALG_IS_AEAD(alg)) {
+        mbedtls_gcm_init(&operation->ctx.gcm);
+        return PSA_ERROR_NOT_SUPPORTED;
+    }
+
+#ifdef MBEDTLS_CHACHAPOLY_C
+    if (PSA_ALG_AEAD_WITH_DEFAULT_TAG_LENGTH(alg) ==
+        PSA_ALG_CHACHA20_POLY1305) {
+        /* Set first, for the release to free the right context */
+        operation->alg = alg;
+        mbedtls_chachapoly_init(&operation->ctx.chachapoly);
+        return tfm_crypto_aead_set_key_chachapoly(operation, key_handle,
+                                                  usage);
+    }
+#endif
+
+    mbedtls_gcm_init(&operation->ctx.gcm);
+
+    /* CCM needs all the lengths up front, and Mbed Crypto has no multipart
+     * CCM, so only GCM and ChaCha20-Poly1305 are supported
+     */
+    if (PSA_ALG_AEAD_WITH_DEFAULT_TAG_LENGTH(alg) != PSA_ALG_GCM) {
+        return PSA_ERROR_NOT_SUPPORTED;
+    }
+
+    if ((tag_length < 4) || (tag_length > TFM_CRYPTO_AEAD_GCM_BLOCK_SIZE)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    status = psa_get_key_slot(key_handle, &slot);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    if (((slot->attr.policy.usage & usage) == 0) ||
+        ((alg != slot->attr.policy.alg) && (alg != slot->attr.policy.alg2))) {
+        return PSA_ERROR_NOT_PERMITTED;
+    }
+
+    if (slot->attr.type != PSA_KEY_TYPE_AES) {
+        return PSA_ERROR_NOT_SUPPORTED;
+    }
+
+    status = tfm_crypto_aead_mbedtls_error(
+                  mbedtls_gcm_setkey(&operation->ctx.gcm, MBEDTLS_CIPHER_ID_AES,
+                                     slot->data.raw.data,
+                                     PSA_BYTES_TO_BITS(slot->data.raw.bytes)));
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    operation->alg = alg;
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Sets the nonce of a multipart AEAD operation
+ *
+ * ChaCha20-Poly1305 starts there, so that the additional data can be fed to
+ * it as it comes. GCM takes the additional data all at once when it starts,
+ * so it only starts with the first input data, see tfm_crypto_aead_start().
+ *
+ * \param[in,out] operation     Context of the operation
+ * \param[in]     nonce         Nonce
+ * \param[in]     nonce_length  Length of the nonce
+ *
+ * \return Return values as described in \ref psa_status_t
+ */
+static psa_status_t tfm_crypto_aead_nonce(
+                                  struct tfm_crypto_aead_operation_s *operation,
+                                  const uint8_t *nonce,
+                                  size_t nonce_length)
+{
+    psa_status_t status = PSA_SUCCESS;
+
+    if (operation->state != TFM_CRYPTO_AEAD_STATE_NONCE) {
+        return PSA_ERROR_BAD_STATE;
+    }
+
+    if ((nonce_length == 0) || (nonce_length > TFM_CRYPTO_MAX_NONCE_LENGTH)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+#ifdef MBEDTLS_CHACHAPOLY_C
+    if (TFM_CRYPTO_AEAD_IS_CHACHAPOLY(operation)) {
+        if (nonce_length != TFM_CRYPTO_AEAD_GCM_NONCE_LENGTH) {
+            return PSA_ERROR_NOT_SUPPORTED;
+        }
+
+        status = tfm_crypto_aead_mbedtls_error(
+                  mbedtls_chachapoly_starts(&operation->ctx.chachapoly, nonce,
+                                            operation->encrypt ?
+                                            MBEDTLS_CHACHAPOLY_ENCRYPT :
+                                            MBEDTLS_CHACHAPOLY_DECRYPT));
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+    }
+#endif
+
+    if (operation->nonce != nonce) {
+        (void)tfm_memcpy(operation->nonce, nonce, nonce_length);
+    }
+    operation->nonce_length = (uint8_t)nonce_length;
+    operation->state = TFM_CRYPTO_AEAD_STATE_AD;
+
+    return status;
+}
+
+/**
+ * \brief Ends the additional data of a multipart AEAD operation when the
+ *        first input data comes. GCM starts there with the nonce and the
+ *        additional data, which it takes all at once.
+ *
+ * \param[in,out] operation  Context of the operation
+ *
+ * \return Return values as described in \ref psa_status_t
+ */
+static psa_status_t tfm_crypto_aead_start(
+                                  struct tfm_crypto_aead_operation_s *operation)
+{
+    psa_status_t status;
+
+    if (operation->state == TFM_CRYPTO_AEAD_STATE_DATA) {
+        return PSA_SUCCESS;
+    }
+
+    if (operation->state != TFM_CRYPTO_AEAD_STATE_AD) {
+        return PSA_ERROR_BAD_STATE;
+    }
+
+    if ((operation->ad_expected != SIZE_MAX) &&
+        (operation->ad_length != operation->ad_expected)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    operation->state = TFM_CRYPTO_AEAD_STATE_DATA;
+
+    if (TFM_CRYPTO_AEAD_IS_CHACHAPOLY(operation)) {
+        /* Started with the nonce, and fed the additional data as it came */
+        return PSA_SUCCESS;
+    }
+
+    status = tfm_crypto_aead_mbedtls_error(
+                  mbedtls_gcm_starts(&operation->ctx.gcm,
+                                     operation->encrypt ? MBEDTLS_GCM_ENCRYPT :
+                                                          MBEDTLS_GCM_DECRYPT,
+                                     operation->nonce, operation->nonce_length,
+                                     operation->ad, operation->ad_length));
+
+    (void)tfm_memset(operation->ad, 0, sizeof(operation->ad));
+
+    return status;
+}
+
+/**
+ * \brief Feeds input data to a multipart AEAD operation
+ *
+ * GCM takes whole blocks, except for the last call, so the bytes past the
+ * last whole block are kept in the context and processed with the next
+ * input, or when the operation finishes. ChaCha20-Poly1305 takes any length,
+ * and its output always has the length of the input.
+ *
+ * \param[in,out] operation      Context of the operation
+ * \param[in]     input          Input data
+ * \param[in]     input_length   Length of the input data
+ * \param[out]    output         Output buffer
+ * \param[in]     output_size    Size of the output buffer
+ * \param[out]    output_length  Length of the output
+ *
+ * \return Return values as described in \ref psa_status_t
+ */
+static psa_status_t tfm_crypto_aead_process(
+                                  struct tfm_crypto_aead_operation_s *operation,
+                                  const uint8_t *input,
+                                  size_t input_length,
+                                  uint8_t *output,
+                                  size_t output_size,
+                                  size_t *output_length)
+{
+    psa_status_t status;
+    size_t fill, length;
+
+    *output_length = 0;
+
+    status = tfm_crypto_aead_start(operation);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    if ((input_length > SIZE_MAX - operation->input_length) ||
+        ((operation->input_expected != SIZE_MAX) &&
+         (operation->input_length + input_length >
+          operation->input_expected))) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+#ifdef MBEDTLS_CHACHAPOLY_C
+    if (TFM_CRYPTO_AEAD_IS_CHACHAPOLY(operation)) {
+        if (output_size < input_length) {
+            return PSA_ERROR_BUFFER_TOO_SMALL;
+        }
+
+        status = tfm_crypto_aead_mbedtls_error(
+                  mbedtls_chachapoly_update(&operation->ctx.chachapoly,
+                                            input_length, input, output));
+        if (status == PSA_SUCCESS) {
+            operation->input_length += input_length;
+            *output_length = input_length;
+        }
+        return status;
+    }
+#endif
+
+    length = operation->block_length + input_length;
+    if (output_size < length - (length % TFM_CRYPTO_AEAD_GCM_BLOCK_SIZE)) {
+        return PSA_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    operation->input_length += input_length;
+
+    /* Complete the block held from the previous input first */
+    if ((operation->block_length > 0) &&
+        (length >= TFM_CRYPTO_AEAD_GCM_BLOCK_SIZE)) {
+        fill = TFM_CRYPTO_AEAD_GCM_BLOCK_SIZE - operation->block_length;
+        (void)tfm_memcpy(&operation->block[operation->block_length], input,
+                         fill);
+        input += fill;
+        input_length -= fill;
+        operation->block_length = 0;
+
+        status = tfm_crypto_aead_mbedtls_error(
+                  mbedtls_gcm_update(&operation->ctx.gcm,
+                                     TFM_CRYPTO_AEAD_GCM_BLOCK_SIZE,
+                                     operation->block, output));
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+        output += TFM_CRYPTO_AEAD_GCM_BLOCK_SIZE;
+        *output_length += TFM_CRYPTO_AEAD_GCM_BLOCK_SIZE;
+    }
+
+    length = input_length - (input_length % TFM_CRYPTO_AEAD_GCM_BLOCK_SIZE);
+    if (length > 0) {
+        status = tfm_crypto_aead_mbedtls_error(
+                  mbedtls_gcm_update(&operation->ctx.gcm, length, input,
+                                     output));
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+        input += length;
+        input_length -= length;
+        *output_length += length;
+    }
+
+    (void)tfm_memcpy(&operation->block[operation->block_length], input,
+                     input_length);
+    operation->block_length += input_length;
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Processes the last input bytes of a multipart AEAD operation and
+ *        computes its tag
+ *
+ * \param[in,out] operation      Context of the operation
+ * \param[out]    output         Output buffer
+ * \param[in]     output_size    Size of the output buffer
+ * \param[out]    output_length  Length of the output
+ * \param[out]    tag            Buffer of TFM_CRYPTO_AEAD_GCM_BLOCK_SIZE bytes
+ *                               for the tag
+ *
+ * \return Return values as described in \ref psa_status_t
+ */
+static psa_status_t tfm_crypto_aead_complete(
+                                  struct tfm_crypto_aead_operation_s *operation,
+                                  uint8_t *output,
+                                  size_t output_size,
+                                  size_t *output_length,
+                                  uint8_t *tag)
+{
+    psa_status_t status;
+
+    *output_length = 0;
+
+    status = tfm_crypto_aead_start(operation);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    if ((operation->input_expected != SIZE_MAX) &&
+        (operation->input_length != operation->input_expected)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+#ifdef MBEDTLS_CHACHAPOLY_C
+    if (TFM_CRYPTO_AEAD_IS_CHACHAPOLY(operation)) {
+        /* Nothing is held back, so there is no output left */
+        return tfm_crypto_aead_mbedtls_error(
+                  mbedtls_chachapoly_finish(&operation->ctx.chachapoly, tag));
+    }
+#endif
+
+    if (output_size < operation->block_length) {
+        return PSA_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    if (operation->block_length > 0) {
+        status = tfm_crypto_aead_mbedtls_error(
+                  mbedtls_gcm_update(&operation->ctx.gcm,
+                                     operation->block_length,
+                                     operation->block, output));
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+        *output_length = operation->block_length;
+    }
+
+    return tfm_crypto_aead_mbedtls_error(
+                  mbedtls_gcm_finish(&operation->ctx.gcm, tag,
+                                     operation->tag_length));
+}
+
+/**
+ * \brief Sets up a multipart AEAD operation
+ *
+ * \param[in]  in_vec   Array of invec parameters
+ * \param[in]  in_len   Length of the valid entries in in_vec
+ * \param[out] out_vec  Array of outvec parameters
+ * \param[in]  out_len  Length of the valid entries in out_vec
+ * \param[in]  encrypt  True for an encryption, false for a decryption
+ *
+ * \return Return values as described in \ref psa_status_t
+ */
+static psa_status_t tfm_crypto_aead_setup(psa_invec in_vec[],
+                                          size_t in_len,
+                                          psa_outvec out_vec[],
+                                          size_t out_len,
+                                          bool encrypt)
+{
+    psa_status_t status = PSA_SUCCESS;
+    struct tfm_crypto_aead_operation_s *operation = NULL;
+
+    if ((in_len != 1) || (out_len != 1)) {
+        return PSA_ERROR_CONNECTION_REFUSED;
+    }
+
+    if ((out_vec[0].len != sizeof(uint32_t)) ||
+        (in_vec[0].len != sizeof(struct tfm_crypto_pack_iovec))) {
+        return PSA_ERROR_CONNECTION_REFUSED;
+    }
+    const struct tfm_crypto_pack_iovec *iov = in_vec[0].base;
+    uint32_t handle = iov->op_handle;
+    uint32_t *handle_out = out_vec[0].base;
+    psa_key_handle_t key_handle = iov->key_handle;
+    psa_algorithm_t alg = iov->alg;
+
+    status = tfm_crypto_check_handle_owner(&key_handle, NULL);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    /* Allocate the operation context in the secure world */
+    status = tfm_crypto_operation_alloc(TFM_CRYPTO_AEAD_OPERATION,
+                                        &handle,
+                                        (void **)&operation);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    *handle_out = handle;
+
+    status = tfm_crypto_aead_set_key(operation, key_handle, alg, encrypt);
+    if (status != PSA_SUCCESS) {
+        /* Release the operation context, ignore if the operation fails. */
+        (void)tfm_crypto_aead_release(handle_out, operation);
+        return status;
+    }
+
+    return status;
+}
+#endif /* TFM_CRYPTO_AEAD_MODULE_DISABLED */
 
 /*!
  * \defgroup public_psa Public functions, PSA
@@ -63,7 +739,7 @@ psa_status_t tfm_crypto_aead_encrypt(psa_invec in_vec[],
     /* Initialise ciphertext_length to zero */
     out_vec[0].len = 0;
 
-    status = tfm_crypto_check_handle_owner(key_handle, NULL);
+    status = tfm_crypto_check_handle_owner(&key_handle, NULL);
     if (status == PSA_SUCCESS) {
 
         status = psa_aead_encrypt(key_handle, alg, nonce, nonce_length,
@@ -115,7 +791,7 @@ psa_status_t tfm_crypto_aead_decrypt(psa_invec in_vec[],
     /* Initialise plaintext_length to zero */
     out_vec[0].len = 0;
 
-    status = tfm_crypto_check_handle_owner(key_handle, NULL);
+    status = tfm_crypto_check_handle_owner(&key_handle, NULL);
     if (status == PSA_SUCCESS) {
 
         status = psa_aead_decrypt(key_handle, alg, nonce, nonce_length,
@@ -133,8 +809,11 @@ psa_status_t tfm_crypto_aead_encrypt_setup(psa_invec in_vec[],
                                            psa_outvec out_vec[],
                                            size_t out_len)
 {
-    /* FixMe: To be implemented */
+#ifdef TFM_CRYPTO_AEAD_MODULE_DISABLED
     return PSA_ERROR_NOT_SUPPORTED;
+#else
+    return tfm_crypto_aead_setup(in_vec, in_len, out_vec, out_len, true);
+#endif /* TFM_CRYPTO_AEAD_MODULE_DISABLED */
 }
 
 psa_status_t tfm_crypto_aead_decrypt_setup(psa_invec in_vec[],
@@ -142,8 +821,11 @@ psa_status_t tfm_crypto_aead_decrypt_setup(psa_invec in_vec[],
                                            psa_outvec out_vec[],
                                            size_t out_len)
 {
-    /* FixMe: To be implemented */
+#ifdef TFM_CRYPTO_AEAD_MODULE_DISABLED
     return PSA_ERROR_NOT_SUPPORTED;
+#else
+    return tfm_crypto_aead_setup(in_vec, in_len, out_vec, out_len, false);
+#endif /* TFM_CRYPTO_AEAD_MODULE_DISABLED */
 }
 
 psa_status_t tfm_crypto_aead_abort(psa_invec in_vec[],
@@ -151,8 +833,38 @@ psa_status_t tfm_crypto_aead_abort(psa_invec in_vec[],
                                    psa_outvec out_vec[],
                                    size_t out_len)
 {
-    /* FixMe: To be implemented */
+#ifdef TFM_CRYPTO_AEAD_MODULE_DISABLED
     return PSA_ERROR_NOT_SUPPORTED;
+#else
+    psa_status_t status = PSA_SUCCESS;
+    struct tfm_crypto_aead_operation_s *operation = NULL;
+
+    if ((in_len != 1) || (out_len != 1)) {
+        return PSA_ERROR_CONNECTION_REFUSED;
+    }
+
+    if ((out_vec[0].len != sizeof(uint32_t)) ||
+        (in_vec[0].len != sizeof(struct tfm_crypto_pack_iovec))) {
+        return PSA_ERROR_CONNECTION_REFUSED;
+    }
+    const struct tfm_crypto_pack_iovec *iov = in_vec[0].base;
+    uint32_t handle = iov->op_handle;
+    uint32_t *handle_out = out_vec[0].base;
+
+    /* Init the handle in the operation with the one passed from the iov */
+    *handle_out = iov->op_handle;
+
+    /* Look up the corresponding operation context */
+    status = tfm_crypto_operation_lookup(TFM_CRYPTO_AEAD_OPERATION,
+                                         handle,
+                                         (void **)&operation);
+    if (status != PSA_SUCCESS) {
+        /* Operation does not exist, so abort has no effect */
+        return PSA_SUCCESS;
+    }
+
+    return tfm_crypto_aead_release(handle_out, operation);
+#endif /* TFM_CRYPTO_AEAD_MODULE_DISABLED */
 }
 
 psa_status_t tfm_crypto_aead_finish(psa_invec in_vec[],
@@ -160,8 +872,66 @@ psa_status_t tfm_crypto_aead_finish(psa_invec in_vec[],
                                     psa_outvec out_vec[],
                                     size_t out_len)
 {
-    /* FixMe: To be implemented */
+#ifdef TFM_CRYPTO_AEAD_MODULE_DISABLED
     return PSA_ERROR_NOT_SUPPORTED;
+#else
+    psa_status_t status = PSA_SUCCESS;
+    struct tfm_crypto_aead_operation_s *operation = NULL;
+    uint8_t tag[TFM_CRYPTO_AEAD_GCM_BLOCK_SIZE];
+
+    if ((in_len != 1) || (out_len != 3)) {
+        return PSA_ERROR_CONNECTION_REFUSED;
+    }
+
+    if ((in_vec[0].len != sizeof(struct tfm_crypto_pack_iovec)) ||
+        (out_vec[0].len != sizeof(uint32_t))) {
+        return PSA_ERROR_CONNECTION_REFUSED;
+    }
+    const struct tfm_crypto_pack_iovec *iov = in_vec[0].base;
+    uint32_t handle = iov->op_handle;
+    uint32_t *handle_out = out_vec[0].base;
+    uint8_t *ciphertext = out_vec[1].base;
+    size_t ciphertext_size = out_vec[1].len;
+    uint8_t *tag_out = out_vec[2].base;
+    size_t tag_size = out_vec[2].len;
+
+    /* Init the handle in the operation with the one passed from the iov */
+    *handle_out = iov->op_handle;
+
+    /* Initialise the output lengths to zero */
+    out_vec[1].len = 0;
+    out_vec[2].len = 0;
+
+    /* Look up the corresponding operation context */
+    status = tfm_crypto_operation_lookup(TFM_CRYPTO_AEAD_OPERATION,
+                                         handle,
+                                         (void **)&operation);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    if (!operation->encrypt) {
+        status = PSA_ERROR_BAD_STATE;
+    } else if (tag_size < operation->tag_length) {
+        status = PSA_ERROR_BUFFER_TOO_SMALL;
+    } else {
+        status = tfm_crypto_aead_complete(operation, ciphertext,
+                                          ciphertext_size, &out_vec[1].len,
+                                          tag);
+    }
+
+    if (status == PSA_SUCCESS) {
+        (void)tfm_memcpy(tag_out, tag, operation->tag_length);
+        out_vec[2].len = operation->tag_length;
+    } else {
+        out_vec[1].len = 0;
+    }
+
+    /* Release the operation context, ignore if the operation fails. */
+    (void)tfm_crypto_aead_release(handle_out, operation);
+
+    return status;
+#endif /* TFM_CRYPTO_AEAD_MODULE_DISABLED */
 }
 
 psa_status_t tfm_crypto_aead_generate_nonce(psa_invec in_vec[],
@@ -169,8 +939,66 @@ psa_status_t tfm_crypto_aead_generate_nonce(psa_invec in_vec[],
                                             psa_outvec out_vec[],
                                             size_t out_len)
 {
-    /* FixMe: To be implemented */
+#ifdef TFM_CRYPTO_AEAD_MODULE_DISABLED
     return PSA_ERROR_NOT_SUPPORTED;
+#else
+    psa_status_t status = PSA_SUCCESS;
+    struct tfm_crypto_aead_operation_s *operation = NULL;
+
+    if ((in_len != 1) || (out_len != 2)) {
+        return PSA_ERROR_CONNECTION_REFUSED;
+    }
+
+    if ((in_vec[0].len != sizeof(struct tfm_crypto_pack_iovec)) ||
+        (out_vec[0].len != sizeof(uint32_t))) {
+        return PSA_ERROR_CONNECTION_REFUSED;
+    }
+    const struct tfm_crypto_pack_iovec *iov = in_vec[0].base;
+    uint32_t handle = iov->op_handle;
+    uint32_t *handle_out = out_vec[0].base;
+    uint8_t *nonce = out_vec[1].base;
+    size_t nonce_size = out_vec[1].len;
+
+    /* Init the handle in the operation with the one passed from the iov */
+    *handle_out = iov->op_handle;
+
+    /* Initialise the nonce_length to zero */
+    out_vec[1].len = 0;
+
+    /* Look up the corresponding operation context */
+    status = tfm_crypto_operation_lookup(TFM_CRYPTO_AEAD_OPERATION,
+                                         handle,
+                                         (void **)&operation);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    if (!operation->encrypt ||
+        (operation->state != TFM_CRYPTO_AEAD_STATE_NONCE)) {
+        status = PSA_ERROR_BAD_STATE;
+    } else if (nonce_size < TFM_CRYPTO_AEAD_GCM_NONCE_LENGTH) {
+        status = PSA_ERROR_BUFFER_TOO_SMALL;
+    } else {
+        status = psa_generate_random(operation->nonce,
+                                     TFM_CRYPTO_AEAD_GCM_NONCE_LENGTH);
+    }
+
+    if (status == PSA_SUCCESS) {
+        status = tfm_crypto_aead_nonce(operation, operation->nonce,
+                                       TFM_CRYPTO_AEAD_GCM_NONCE_LENGTH);
+    }
+
+    if (status != PSA_SUCCESS) {
+        /* Release the operation context, ignore if the operation fails. */
+        (void)tfm_crypto_aead_release(handle_out, operation);
+        return status;
+    }
+
+    (void)tfm_memcpy(nonce, operation->nonce, operation->nonce_length);
+    out_vec[1].len = operation->nonce_length;
+
+    return status;
+#endif /* TFM_CRYPTO_AEAD_MODULE_DISABLED */
 }
 
 psa_status_t tfm_crypto_aead_set_nonce(psa_invec in_vec[],
@@ -178,8 +1006,46 @@ psa_status_t tfm_crypto_aead_set_nonce(psa_invec in_vec[],
                                        psa_outvec out_vec[],
                                        size_t out_len)
 {
-    /* FixMe: To be implemented */
+#ifdef TFM_CRYPTO_AEAD_MODULE_DISABLED
     return PSA_ERROR_NOT_SUPPORTED;
+#else
+    psa_status_t status = PSA_SUCCESS;
+    struct tfm_crypto_aead_operation_s *operation = NULL;
+
+    if ((in_len != 2) || (out_len != 1)) {
+        return PSA_ERROR_CONNECTION_REFUSED;
+    }
+
+    if ((in_vec[0].len != sizeof(struct tfm_crypto_pack_iovec)) ||
+        (out_vec[0].len != sizeof(uint32_t))) {
+        return PSA_ERROR_CONNECTION_REFUSED;
+    }
+    const struct tfm_crypto_pack_iovec *iov = in_vec[0].base;
+    uint32_t handle = iov->op_handle;
+    uint32_t *handle_out = out_vec[0].base;
+    const uint8_t *nonce = in_vec[1].base;
+    size_t nonce_length = in_vec[1].len;
+
+    /* Init the handle in the operation with the one passed from the iov */
+    *handle_out = iov->op_handle;
+
+    /* Look up the corresponding operation context */
+    status = tfm_crypto_operation_lookup(TFM_CRYPTO_AEAD_OPERATION,
+                                         handle,
+                                         (void **)&operation);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    status = tfm_crypto_aead_nonce(operation, nonce, nonce_length);
+    if (status != PSA_SUCCESS) {
+        /* Release the operation context, ignore if the operation fails. */
+        (void)tfm_crypto_aead_release(handle_out, operation);
+        return status;
+    }
+
+    return status;
+#endif /* TFM_CRYPTO_AEAD_MODULE_DISABLED */
 }
 
 psa_status_t tfm_crypto_aead_set_lengths(psa_invec in_vec[],
@@ -187,8 +1053,59 @@ psa_status_t tfm_crypto_aead_set_lengths(psa_invec in_vec[],
                                          psa_outvec out_vec[],
                                          size_t out_len)
 {
-    /* FixMe: To be implemented */
+#ifdef TFM_CRYPTO_AEAD_MODULE_DISABLED
     return PSA_ERROR_NOT_SUPPORTED;
+#else
+    psa_status_t status = PSA_SUCCESS;
+    struct tfm_crypto_aead_operation_s *operation = NULL;
+
+    if ((in_len != 2) || (out_len != 1)) {
+        return PSA_ERROR_CONNECTION_REFUSED;
+    }
+
+    if ((in_vec[0].len != sizeof(struct tfm_crypto_pack_iovec)) ||
+        (in_vec[1].len != 2 * sizeof(size_t)) ||
+        (out_vec[0].len != sizeof(uint32_t))) {
+        return PSA_ERROR_CONNECTION_REFUSED;
+    }
+    const struct tfm_crypto_pack_iovec *iov = in_vec[0].base;
+    uint32_t handle = iov->op_handle;
+    uint32_t *handle_out = out_vec[0].base;
+    const size_t *lengths = in_vec[1].base;
+
+    /* Init the handle in the operation with the one passed from the iov */
+    *handle_out = iov->op_handle;
+
+    /* Look up the corresponding operation context */
+    status = tfm_crypto_operation_lookup(TFM_CRYPTO_AEAD_OPERATION,
+                                         handle,
+                                         (void **)&operation);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    if ((operation->state == TFM_CRYPTO_AEAD_STATE_DATA) ||
+        (operation->ad_length > 0) ||
+        (operation->ad_expected != SIZE_MAX)) {
+        status = PSA_ERROR_BAD_STATE;
+    } else if (!TFM_CRYPTO_AEAD_IS_CHACHAPOLY(operation) &&
+               (lengths[0] > TFM_CRYPTO_AEAD_MAX_AD_LENGTH)) {
+        status = PSA_ERROR_NOT_SUPPORTED;
+    } else if ((lengths[0] == SIZE_MAX) || (lengths[1] == SIZE_MAX)) {
+        status = PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (status != PSA_SUCCESS) {
+        /* Release the operation context, ignore if the operation fails. */
+        (void)tfm_crypto_aead_release(handle_out, operation);
+        return status;
+    }
+
+    operation->ad_expected = lengths[0];
+    operation->input_expected = lengths[1];
+
+    return status;
+#endif /* TFM_CRYPTO_AEAD_MODULE_DISABLED */
 }
 
 psa_status_t tfm_crypto_aead_update(psa_invec in_vec[],
@@ -196,8 +1113,53 @@ psa_status_t tfm_crypto_aead_update(psa_invec in_vec[],
                                     psa_outvec out_vec[],
                                     size_t out_len)
 {
-    /* FixMe: To be implemented */
+#ifdef TFM_CRYPTO_AEAD_MODULE_DISABLED
     return PSA_ERROR_NOT_SUPPORTED;
+#else
+    psa_status_t status = PSA_SUCCESS;
+    struct tfm_crypto_aead_operation_s *operation = NULL;
+
+    if ((in_len != 2) || (out_len != 2)) {
+        return PSA_ERROR_CONNECTION_REFUSED;
+    }
+
+    if ((in_vec[0].len != sizeof(struct tfm_crypto_pack_iovec)) ||
+        (out_vec[0].len != sizeof(uint32_t))) {
+        return PSA_ERROR_CONNECTION_REFUSED;
+    }
+    const struct tfm_crypto_pack_iovec *iov = in_vec[0].base;
+    uint32_t handle = iov->op_handle;
+    uint32_t *handle_out = out_vec[0].base;
+    const uint8_t *input = in_vec[1].base;
+    size_t input_length = in_vec[1].len;
+    uint8_t *output = out_vec[1].base;
+    size_t output_size = out_vec[1].len;
+
+    /* Init the handle in the operation with the one passed from the iov */
+    *handle_out = iov->op_handle;
+
+    /* Initialise the output_length to zero */
+    out_vec[1].len = 0;
+
+    /* Look up the corresponding operation context */
+    status = tfm_crypto_operation_lookup(TFM_CRYPTO_AEAD_OPERATION,
+                                         handle,
+                                         (void **)&operation);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    status = tfm_crypto_aead_process(operation, input, input_length,
+                                     output, output_size, &out_vec[1].len);
+    if (status != PSA_SUCCESS) {
+        out_vec[1].len = 0;
+        /* Release the operation context, ignore if the operation fails. */
+        (void)tfm_crypto_aead_release(handle_out, operation);
+        return status;
+    }
+
+    return status;
+#endif /* TFM_CRYPTO_AEAD_MODULE_DISABLED */
 }
 
 psa_status_t tfm_crypto_aead_update_ad(psa_invec in_vec[],
@@ -205,8 +1167,74 @@ psa_status_t tfm_crypto_aead_update_ad(psa_invec in_vec[],
                                        psa_outvec out_vec[],
                                        size_t out_len)
 {
-    /* FixMe: To be implemented */
+#ifdef TFM_CRYPTO_AEAD_MODULE_DISABLED
     return PSA_ERROR_NOT_SUPPORTED;
+#else
+    psa_status_t status = PSA_SUCCESS;
+    struct tfm_crypto_aead_operation_s *operation = NULL;
+
+    if ((in_len != 2) || (out_len != 1)) {
+        return PSA_ERROR_CONNECTION_REFUSED;
+    }
+
+    if ((in_vec[0].len != sizeof(struct tfm_crypto_pack_iovec)) ||
+        (out_vec[0].len != sizeof(uint32_t))) {
+        return PSA_ERROR_CONNECTION_REFUSED;
+    }
+    const struct tfm_crypto_pack_iovec *iov = in_vec[0].base;
+    uint32_t handle = iov->op_handle;
+    uint32_t *handle_out = out_vec[0].base;
+    const uint8_t *input = in_vec[1].base;
+    size_t input_length = in_vec[1].len;
+
+    /* Init the handle in the operation with the one passed from the iov */
+    *handle_out = iov->op_handle;
+
+    /* Look up the corresponding operation context */
+    status = tfm_crypto_operation_lookup(TFM_CRYPTO_AEAD_OPERATION,
+                                         handle,
+                                         (void **)&operation);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    /* GCM takes the additional data in one go when it starts, so it is
+     * buffered until the first input data comes. ChaCha20-Poly1305 takes it
+     * straight away, so its length is not limited by the buffer.
+     */
+    if (operation->state != TFM_CRYPTO_AEAD_STATE_AD) {
+        status = PSA_ERROR_BAD_STATE;
+    } else if ((input_length > SIZE_MAX - operation->ad_length) ||
+               ((operation->ad_expected != SIZE_MAX) &&
+                (input_length >
+                 operation->ad_expected - operation->ad_length))) {
+        status = PSA_ERROR_INVALID_ARGUMENT;
+#ifdef MBEDTLS_CHACHAPOLY_C
+    } else if (TFM_CRYPTO_AEAD_IS_CHACHAPOLY(operation)) {
+        status = tfm_crypto_aead_mbedtls_error(
+                  mbedtls_chachapoly_update_aad(&operation->ctx.chachapoly,
+                                                input, input_length));
+        if (status == PSA_SUCCESS) {
+            operation->ad_length += input_length;
+            return status;
+        }
+#endif
+    } else if (input_length > sizeof(operation->ad) - operation->ad_length) {
+        status = PSA_ERROR_NOT_SUPPORTED;
+    }
+
+    if (status != PSA_SUCCESS) {
+        /* Release the operation context, ignore if the operation fails. */
+        (void)tfm_crypto_aead_release(handle_out, operation);
+        return status;
+    }
+
+    (void)tfm_memcpy(&operation->ad[operation->ad_length], input,
+                     input_length);
+    operation->ad_length += input_length;
+
+    return status;
+#endif /* TFM_CRYPTO_AEAD_MODULE_DISABLED */
 }
 
 psa_status_t tfm_crypto_aead_verify(psa_invec in_vec[],
@@ -214,7 +1242,98 @@ psa_status_t tfm_crypto_aead_verify(psa_invec in_vec[],
                                     psa_outvec out_vec[],
                                     size_t out_len)
 {
-    /* FixMe: To be implemented */
+#ifdef TFM_CRYPTO_AEAD_MODULE_DISABLED
+    return PSA_ERROR_NOT_SUPPORTED;
+#else
+    psa_status_t status = PSA_SUCCESS;
+    struct tfm_crypto_aead_operation_s *operation = NULL;
+    uint8_t tag[TFM_CRYPTO_AEAD_GCM_BLOCK_SIZE];
+    uint8_t diff = 0;
+    size_t i;
+
+    if ((in_len != 2) || (out_len != 2)) {
+        return PSA_ERROR_CONNECTION_REFUSED;
+    }
+
+    if ((in_vec[0].len != sizeof(struct tfm_crypto_pack_iovec)) ||
+        (out_vec[0].len != sizeof(uint32_t))) {
+        return PSA_ERROR_CONNECTION_REFUSED;
+    }
+    const struct tfm_crypto_pack_iovec *iov = in_vec[0].base;
+    uint32_t handle = iov->op_handle;
+    uint32_t *handle_out = out_vec[0].base;
+    const uint8_t *tag_in = in_vec[1].base;
+    size_t tag_length = in_vec[1].len;
+    uint8_t *plaintext = out_vec[1].base;
+    size_t plaintext_size = out_vec[1].len;
+
+    /* Init the handle in the operation with the one passed from the iov */
+    *handle_out = iov->op_handle;
+
+    /* Initialise the plaintext_length to zero */
+    out_vec[1].len = 0;
+
+    /* Look up the corresponding operation context */
+    status = tfm_crypto_operation_lookup(TFM_CRYPTO_AEAD_OPERATION,
+                                         handle,
+                                         (void **)&operation);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    if (operation->encrypt) {
+        status = PSA_ERROR_BAD_STATE;
+    } else {
+        status = tfm_crypto_aead_complete(operation, plaintext,
+                                          plaintext_size, &out_vec[1].len,
+                                          tag);
+    }
+
+    if (status == PSA_SUCCESS) {
+        /* Compare in constant time, to not leak how much of the tag matched */
+        for (i = 0; i < operation->tag_length; i++) {
+            diff |= tag[i] ^ ((i < tag_length) ? tag_in[i] : 0);
+        }
+
+        if ((diff != 0) || (tag_length != operation->tag_length)) {
+            status = PSA_ERROR_INVALID_SIGNATURE;
+        }
+    }
+
+    if (status != PSA_SUCCESS) {
+        /* Do not leave the plaintext of the last block out */
+        (void)tfm_memset(plaintext, 0, out_vec[1].len);
+        out_vec[1].len = 0;
+    }
+
+    /* Release the operation context, ignore if the operation fails. */
+    (void)tfm_crypto_aead_release(handle_out, operation);
+
+    return status;
+#endif /* TFM_CRYPTO_AEAD_MODULE_DISABLED */
+}
+
+psa_status_t tfm_crypto_aead_encrypt_batch(psa_invec in_vec[],
+                                           size_t in_len,
+                                           psa_outvec out_vec[],
+                                           size_t out_len)
+{
+#ifdef TFM_CRYPTO_AEAD_MODULE_DISABLED
     return PSA_ERROR_NOT_SUPPORTED;
+#else
+    return tfm_crypto_aead_batch(in_vec, in_len, out_vec, out_len, true);
+#endif /* TFM_CRYPTO_AEAD_MODULE_DISABLED */
+}
+
+psa_status_t tfm_crypto_aead_decrypt_batch(psa_invec in_vec[],
+                                           size_t in_len,
+                                           psa_outvec out_vec[],
+                                           size_t out_len)
+{
+#ifdef TFM_CRYPTO_AEAD_MODULE_DISABLED
+    return PSA_ERROR_NOT_SUPPORTED;
+#else
+    return tfm_crypto_aead_batch(in_vec, in_len, out_vec, out_len, false);
+#endif /* TFM_CRYPTO_AEAD_MODULE_DISABLED */
 }
 /*!@}*/
@@ -14,70 +14,588 @@
 #include "tfm_crypto_defs.h"
 #include "tfm_memory_utils.h"
 
+#ifdef TFM_RESOURCE_USAGE
+#include "secure_fw/include/tfm_spm_services_api.h"
+#endif
+
+#ifdef TFM_CRYPTO_CONTEXT_SPILL
+#include "mbedtls/gcm.h"
+#include "platform/include/tfm_plat_crypto_keys.h"
+#include "region_defs.h"
+#endif
+
+#ifdef TFM_RESOURCE_USAGE
+/**
+ * \brief Usage of the operations of all the pools, reported by SPM
+ */
+static struct tfm_resource_usage_t oper_usage = {
+    .resource_id = TFM_RESOURCE_CRYPTO_OPERATIONS,
+};
+
+#define TFM_CRYPTO_OPER_USAGE_ADD(n) \
+    tfm_resource_usage_set(&oper_usage, oper_usage.used + (n))
+#else
+#define TFM_CRYPTO_OPER_USAGE_ADD(n)
+#endif
+
 /**
  * \def TFM_CRYPTO_CONC_OPER_NUM
  *
  * \brief This is the default value for the maximum number of concurrent
- *        operations that can be active (allocated) at any time, supported
- *        by the implementation
+ *        operations of each type that can be active (allocated) at any time,
+ *        supported by the implementation
  */
 #ifndef TFM_CRYPTO_CONC_OPER_NUM
 #define TFM_CRYPTO_CONC_OPER_NUM (8)
 #endif
 
+/**
+ * \brief Maximum number of concurrent operations of each type. The contexts of
+ *        each type are allocated from a pool of their own size.
+ */
+#ifndef TFM_CRYPTO_CONC_CIPHER_OPER_NUM
+#define TFM_CRYPTO_CONC_CIPHER_OPER_NUM      TFM_CRYPTO_CONC_OPER_NUM
+#endif
+#ifndef TFM_CRYPTO_CONC_MAC_OPER_NUM
+#define TFM_CRYPTO_CONC_MAC_OPER_NUM         TFM_CRYPTO_CONC_OPER_NUM
+#endif
+#ifndef TFM_CRYPTO_CONC_HASH_OPER_NUM
+#define TFM_CRYPTO_CONC_HASH_OPER_NUM        TFM_CRYPTO_CONC_OPER_NUM
+#endif
+#ifndef TFM_CRYPTO_CONC_KEY_DERIV_OPER_NUM
+#define TFM_CRYPTO_CONC_KEY_DERIV_OPER_NUM   TFM_CRYPTO_CONC_OPER_NUM
+#endif
+/* An AEAD context holds the GCM tables and the buffered additional data, so
+ * fewer of them are provided by default.
+ */
+#ifndef TFM_CRYPTO_CONC_AEAD_OPER_NUM
+#define TFM_CRYPTO_CONC_AEAD_OPER_NUM        (2)
+#endif
+
+#if (TFM_CRYPTO_CONC_CIPHER_OPER_NUM < 1) || \
+    (TFM_CRYPTO_CONC_MAC_OPER_NUM < 1) || \
+    (TFM_CRYPTO_CONC_HASH_OPER_NUM < 1) || \
+    (TFM_CRYPTO_CONC_KEY_DERIV_OPER_NUM < 1) || \
+    (TFM_CRYPTO_CONC_AEAD_OPER_NUM < 1)
+#error "Each operation type needs at least one concurrent operation context!"
+#endif
+
+#ifdef TFM_CRYPTO_CONTEXT_SPILL
+#if !defined(TFM_CRYPTO_SPILL_AREA_START) || !defined(TFM_CRYPTO_SPILL_AREA_SIZE)
+#error "TFM_CRYPTO_CONTEXT_SPILL needs TFM_CRYPTO_SPILL_AREA_START and TFM_CRYPTO_SPILL_AREA_SIZE in region_defs.h"
+#endif
+
+/* The context in use by the current request is never spilled, so each pool
+ * needs a second context to spill the others through.
+ */
+#if (TFM_CRYPTO_CONC_CIPHER_OPER_NUM < 2) || \
+    (TFM_CRYPTO_CONC_MAC_OPER_NUM < 2) || \
+    (TFM_CRYPTO_CONC_HASH_OPER_NUM < 2) || \
+    (TFM_CRYPTO_CONC_KEY_DERIV_OPER_NUM < 2) || \
+    (TFM_CRYPTO_CONC_AEAD_OPER_NUM < 2)
+#error "TFM_CRYPTO_CONTEXT_SPILL needs at least two contexts of each type!"
+#endif
+
+/**
+ * \brief Number of operations of each type which can be spilled out of the
+ *        secure RAM, on top of the ones held by the contexts of the pool
+ */
+#ifndef TFM_CRYPTO_SPILL_OPER_NUM
+#define TFM_CRYPTO_SPILL_OPER_NUM (24)
+#endif
+
+/**
+ * \brief Size of the nonce and of the tag of a sealed context
+ */
+#define TFM_CRYPTO_SPILL_NONCE_SIZE (12)
+#define TFM_CRYPTO_SPILL_TAG_SIZE   (16)
+
+/**
+ * \brief Size of the key the contexts are sealed with
+ */
+#define TFM_CRYPTO_SPILL_KEY_BITS   (256)
+
+/**
+ * \brief Size of the random salt the sealing key is derived with at each boot
+ */
+#define TFM_CRYPTO_SPILL_SALT_SIZE  (16)
+
+/**
+ * \brief Value of slot for an operation which has been spilled
+ */
+#define TFM_CRYPTO_SPILLED          (UINT32_MAX)
+#else
+#define TFM_CRYPTO_SPILL_OPER_NUM   (0)
+#endif /* TFM_CRYPTO_CONTEXT_SPILL */
+
+/**
+ * \brief A handle holds the operation type in its upper bits and the index
+ *        of the context in the pool of that type, plus one, in its lower bits.
+ */
+#define TFM_CRYPTO_HANDLE_TYPE_POS   (16)
+#define TFM_CRYPTO_HANDLE_INDEX_MASK ((1UL << TFM_CRYPTO_HANDLE_TYPE_POS) - 1)
+
+#define TFM_CRYPTO_HANDLE(type, index) \
+    (((uint32_t)(type) << TFM_CRYPTO_HANDLE_TYPE_POS) | ((index) + 1))
+
+/**
+ * \brief Number of operations of each type, which is the number of contexts
+ *        plus the number of operations which can be spilled
+ */
+#define TFM_CRYPTO_CIPHER_OPER_NUM \
+    (TFM_CRYPTO_CONC_CIPHER_OPER_NUM + TFM_CRYPTO_SPILL_OPER_NUM)
+#define TFM_CRYPTO_MAC_OPER_NUM \
+    (TFM_CRYPTO_CONC_MAC_OPER_NUM + TFM_CRYPTO_SPILL_OPER_NUM)
+#define TFM_CRYPTO_HASH_OPER_NUM \
+    (TFM_CRYPTO_CONC_HASH_OPER_NUM + TFM_CRYPTO_SPILL_OPER_NUM)
+#define TFM_CRYPTO_KEY_DERIV_OPER_NUM \
+    (TFM_CRYPTO_CONC_KEY_DERIV_OPER_NUM + TFM_CRYPTO_SPILL_OPER_NUM)
+#define TFM_CRYPTO_AEAD_OPER_NUM \
+    (TFM_CRYPTO_CONC_AEAD_OPER_NUM + TFM_CRYPTO_SPILL_OPER_NUM)
+
+#if (TFM_CRYPTO_CIPHER_OPER_NUM >= TFM_CRYPTO_HANDLE_INDEX_MASK) || \
+    (TFM_CRYPTO_MAC_OPER_NUM >= TFM_CRYPTO_HANDLE_INDEX_MASK) || \
+    (TFM_CRYPTO_HASH_OPER_NUM >= TFM_CRYPTO_HANDLE_INDEX_MASK) || \
+    (TFM_CRYPTO_KEY_DERIV_OPER_NUM >= TFM_CRYPTO_HANDLE_INDEX_MASK) || \
+    (TFM_CRYPTO_AEAD_OPER_NUM >= TFM_CRYPTO_HANDLE_INDEX_MASK)
+#error "Too many concurrent operation contexts to be encoded in a handle!"
+#endif
+
+/**
+ * \brief Value of next_free for a context which is in use
+ */
+#define TFM_CRYPTO_NO_NEXT_FREE (UINT32_MAX)
+
 struct tfm_crypto_operation_s {
     uint32_t in_use;                /*!< Indicates if the operation is in use */
     int32_t owner;                  /*!< Indicates an ID of the owner of
                                      *   the context
                                      */
-    enum tfm_crypto_operation_type type; /*!< Type of the operation */
-    union {
-        psa_cipher_operation_t cipher;    /*!< Cipher operation context */
-        psa_mac_operation_t mac;          /*!< MAC operation context */
-        psa_hash_operation_t hash;        /*!< Hash operation context */
-        psa_key_derivation_operation_t key_deriv; /*!< Key derivation operation context */
-    } operation;
+    uint32_t next_free;             /*!< Index of the next free operation of
+                                     *   the pool, when not in use
+                                     */
+#ifdef TFM_CRYPTO_CONTEXT_SPILL
+    uint32_t slot;                  /*!< Index of the context holding the
+                                     *   operation, or TFM_CRYPTO_SPILLED
+                                     */
+    uint32_t last_use;              /*!< Value of the use counter of the pool
+                                     *   when the operation was last used
+                                     */
+    uint32_t seal_count;            /*!< Number of times the operation has
+                                     *   been sealed, part of the nonce
+                                     */
+#endif
+};
+
+/**
+ * \brief A pool of contexts of a single operation type
+ */
+struct tfm_crypto_pool_s {
+    uint8_t *ctx;                        /*!< Contexts of the pool */
+    size_t ctx_size;                     /*!< Size of a context */
+    struct tfm_crypto_operation_s *oper; /*!< State of each operation */
+    uint32_t num;                        /*!< Number of operations */
+    uint32_t free_head;                  /*!< Index of the first free
+                                          *   operation, or
+                                          *   TFM_CRYPTO_NO_NEXT_FREE
+                                          */
+#ifdef TFM_CRYPTO_CONTEXT_SPILL
+    uint32_t *resident;                  /*!< Index of the operation held by
+                                          *   each context, or
+                                          *   TFM_CRYPTO_NO_NEXT_FREE
+                                          */
+    uint32_t ctx_num;                    /*!< Number of contexts */
+    uint32_t use_count;                  /*!< Incremented at each use of an
+                                          *   operation of the pool
+                                          */
+    uint8_t *spill;                      /*!< Sealed operations of the pool,
+                                          *   in the spill area
+                                          */
+#endif
+};
+
+static psa_cipher_operation_t cipher_ctx[TFM_CRYPTO_CONC_CIPHER_OPER_NUM];
+static psa_mac_operation_t mac_ctx[TFM_CRYPTO_CONC_MAC_OPER_NUM];
+static psa_hash_operation_t hash_ctx[TFM_CRYPTO_CONC_HASH_OPER_NUM];
+static psa_key_derivation_operation_t
+                            key_deriv_ctx[TFM_CRYPTO_CONC_KEY_DERIV_OPER_NUM];
+static struct tfm_crypto_aead_operation_s
+                            aead_ctx[TFM_CRYPTO_CONC_AEAD_OPER_NUM];
+
+static struct tfm_crypto_operation_s cipher_oper[TFM_CRYPTO_CIPHER_OPER_NUM];
+static struct tfm_crypto_operation_s mac_oper[TFM_CRYPTO_MAC_OPER_NUM];
+static struct tfm_crypto_operation_s hash_oper[TFM_CRYPTO_HASH_OPER_NUM];
+static struct tfm_crypto_operation_s
+                            key_deriv_oper[TFM_CRYPTO_KEY_DERIV_OPER_NUM];
+static struct tfm_crypto_operation_s aead_oper[TFM_CRYPTO_AEAD_OPER_NUM];
+
+#ifdef TFM_CRYPTO_CONTEXT_SPILL
+static uint32_t cipher_resident[TFM_CRYPTO_CONC_CIPHER_OPER_NUM];
+static uint32_t mac_resident[TFM_CRYPTO_CONC_MAC_OPER_NUM];
+static uint32_t hash_resident[TFM_CRYPTO_CONC_HASH_OPER_NUM];
+static uint32_t key_deriv_resident[TFM_CRYPTO_CONC_KEY_DERIV_OPER_NUM];
+static uint32_t aead_resident[TFM_CRYPTO_CONC_AEAD_OPER_NUM];
+
+#define TFM_CRYPTO_POOL_SPILL(resident, ctx_num) \
+    , (resident), (ctx_num), 0, NULL
+#else
+#define TFM_CRYPTO_POOL_SPILL(resident, ctx_num)
+#endif
+
+/**
+ * \brief The pools, indexed by operation type
+ */
+static struct tfm_crypto_pool_s pool[] = {
+    [TFM_CRYPTO_CIPHER_OPERATION] = {
+        (uint8_t *)cipher_ctx, sizeof(cipher_ctx[0]), cipher_oper,
+        TFM_CRYPTO_CIPHER_OPER_NUM, 0
+        TFM_CRYPTO_POOL_SPILL(cipher_resident,
+                              TFM_CRYPTO_CONC_CIPHER_OPER_NUM)},
+    [TFM_CRYPTO_MAC_OPERATION] = {
+        (uint8_t *)mac_ctx, sizeof(mac_ctx[0]), mac_oper,
+        TFM_CRYPTO_MAC_OPER_NUM, 0
+        TFM_CRYPTO_POOL_SPILL(mac_resident, TFM_CRYPTO_CONC_MAC_OPER_NUM)},
+    [TFM_CRYPTO_HASH_OPERATION] = {
+        (uint8_t *)hash_ctx, sizeof(hash_ctx[0]), hash_oper,
+        TFM_CRYPTO_HASH_OPER_NUM, 0
+        TFM_CRYPTO_POOL_SPILL(hash_resident, TFM_CRYPTO_CONC_HASH_OPER_NUM)},
+    [TFM_CRYPTO_KEY_DERIVATION_OPERATION] = {
+        (uint8_t *)key_deriv_ctx, sizeof(key_deriv_ctx[0]), key_deriv_oper,
+        TFM_CRYPTO_KEY_DERIV_OPER_NUM, 0
+        TFM_CRYPTO_POOL_SPILL(key_deriv_resident,
+                              TFM_CRYPTO_CONC_KEY_DERIV_OPER_NUM)},
+    [TFM_CRYPTO_AEAD_OPERATION] = {
+        (uint8_t *)aead_ctx, sizeof(aead_ctx[0]), aead_oper,
+        TFM_CRYPTO_AEAD_OPER_NUM, 0
+        TFM_CRYPTO_POOL_SPILL(aead_resident, TFM_CRYPTO_CONC_AEAD_OPER_NUM)},
 };
 
-static struct tfm_crypto_operation_s operation[TFM_CRYPTO_CONC_OPER_NUM] ={{0}};
+#define TFM_CRYPTO_POOL_NUM (sizeof(pool) / sizeof(pool[0]))
+
+/*
+ * \brief Function used to get the pool and the index of the context that a
+ *        handle refers to
+ *
+ * \param[in]  handle Handle of the operation
+ * \param[out] index  Index of the context in the pool
+ *
+ * \return Pointer to the pool, or NULL if the handle is not valid
+ *
+ */
+static struct tfm_crypto_pool_s *get_handle_pool(uint32_t handle,
+                                                 uint32_t *index)
+{
+    uint32_t type = handle >> TFM_CRYPTO_HANDLE_TYPE_POS;
+    uint32_t idx = handle & TFM_CRYPTO_HANDLE_INDEX_MASK;
+
+    if ((type == TFM_CRYPTO_OPERATION_NONE) || (type >= TFM_CRYPTO_POOL_NUM) ||
+        (idx == 0) || (idx > pool[type].num)) {
+        return NULL;
+    }
+
+    *index = idx - 1;
+    return &pool[type];
+}
 
 /*
- * \brief Function used to clear the memory associated to a backend context
+ * \brief Function used to get the context holding an operation, which must
+ *        be resident
+ *
+ * \param[in] p     Pool of the operation
+ * \param[in] index Index of the operation in the pool
  *
- * \param[in] index Numerical index in the database of the backend contexts
+ * \return Pointer to the context
  *
- * \return None
+ */
+static void *get_oper_ctx(const struct tfm_crypto_pool_s *p, uint32_t index)
+{
+#ifdef TFM_CRYPTO_CONTEXT_SPILL
+    index = p->oper[index].slot;
+#endif
+    return (void *)&p->ctx[index * p->ctx_size];
+}
+
+#ifdef TFM_CRYPTO_CONTEXT_SPILL
+/**
+ * \brief Label of the key derived from the HUK to seal the spilled contexts
+ */
+static const uint8_t spill_key_label[] = "TFM_CRYPTO_SPILL";
+
+static mbedtls_gcm_context spill_gcm;
+static uint32_t spill_key_loaded = 0;
+
+/*
+ * \brief Derive the key the contexts are sealed with. This is done on the
+ *        first spill rather than at init time, as the random generator is
+ *        only available once Mbed Crypto has been initialised.
+ *
+ * A random salt is mixed in the derivation, so that the key is different at
+ * each boot, and the seal counters restarting from zero never reuse a nonce
+ * with the same key.
  *
+ * \return Return values as described in \ref psa_status_t
  */
-static void memset_operation_context(uint32_t index)
+static psa_status_t tfm_crypto_spill_load_key(void)
 {
-    uint32_t mem_size;
-
-    uint8_t *mem_ptr = (uint8_t *) &(operation[index].operation);
-
-    switch(operation[index].type) {
-    case TFM_CRYPTO_CIPHER_OPERATION:
-        mem_size = sizeof(psa_cipher_operation_t);
-        break;
-    case TFM_CRYPTO_MAC_OPERATION:
-        mem_size = sizeof(psa_mac_operation_t);
-        break;
-    case TFM_CRYPTO_HASH_OPERATION:
-        mem_size = sizeof(psa_hash_operation_t);
-        break;
-    case TFM_CRYPTO_KEY_DERIVATION_OPERATION:
-        mem_size = sizeof(psa_key_derivation_operation_t);
-        break;
-    case TFM_CRYPTO_OPERATION_NONE:
-    default:
-        mem_size = 0;
-        break;
-    }
-
-    /* Clear the contents of the backend context */
-    (void)tfm_memset(mem_ptr, 0, mem_size);
+    uint8_t salt[TFM_CRYPTO_SPILL_SALT_SIZE];
+    uint8_t key[TFM_CRYPTO_SPILL_KEY_BITS / 8];
+    psa_status_t status;
+    int ret;
+
+    if (spill_key_loaded) {
+        return PSA_SUCCESS;
+    }
+
+    status = psa_generate_random(salt, sizeof(salt));
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    if (tfm_plat_get_huk_derived_key(spill_key_label,
+                                     sizeof(spill_key_label) - 1,
+                                     salt, sizeof(salt),
+                                     key, sizeof(key)) !=
+                                                        TFM_PLAT_ERR_SUCCESS) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    mbedtls_gcm_init(&spill_gcm);
+    ret = mbedtls_gcm_setkey(&spill_gcm, MBEDTLS_CIPHER_ID_AES, key,
+                             TFM_CRYPTO_SPILL_KEY_BITS);
+    (void)tfm_memset(key, 0, sizeof(key));
+    if (ret != 0) {
+        mbedtls_gcm_free(&spill_gcm);
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    spill_key_loaded = 1;
+
+    return PSA_SUCCESS;
 }
 
+/*
+ * \brief Build the nonce and the additional data an operation is sealed
+ *        with. The nonce holds the seal counter of the operation, so an old
+ *        sealed copy is rejected, and the additional data binds the sealed
+ *        copy to the operation and to its owner.
+ *
+ * \param[in]  p     Pool of the operation
+ * \param[in]  index Index of the operation in the pool
+ * \param[out] nonce Nonce, of TFM_CRYPTO_SPILL_NONCE_SIZE bytes
+ * \param[out] ad    Additional data, of three words
+ *
+ */
+static void tfm_crypto_spill_params(const struct tfm_crypto_pool_s *p,
+                                    uint32_t index,
+                                    uint8_t *nonce,
+                                    uint32_t *ad)
+{
+    ad[0] = (uint32_t)(p - pool);
+    ad[1] = index;
+    ad[2] = (uint32_t)p->oper[index].owner;
+
+    (void)tfm_memcpy(nonce, &ad[0], sizeof(ad[0]));
+    (void)tfm_memcpy(&nonce[4], &index, sizeof(index));
+    (void)tfm_memcpy(&nonce[8], &p->oper[index].seal_count,
+                     sizeof(p->oper[index].seal_count));
+}
+
+/*
+ * \brief Function used to get the location of the sealed copy of an
+ *        operation in the spill area
+ */
+static uint8_t *tfm_crypto_spill_blob(const struct tfm_crypto_pool_s *p,
+                                      uint32_t index)
+{
+    return &p->spill[index * (p->ctx_size + TFM_CRYPTO_SPILL_TAG_SIZE)];
+}
+
+/*
+ * \brief Seal the operation held by a context to the spill area, and free
+ *        the context
+ *
+ * \param[in] p    Pool of the operation
+ * \param[in] slot Index of the context
+ *
+ * \return Return values as described in \ref psa_status_t
+ */
+static psa_status_t tfm_crypto_spill_seal(struct tfm_crypto_pool_s *p,
+                                          uint32_t slot)
+{
+    uint32_t index = p->resident[slot];
+    uint8_t nonce[TFM_CRYPTO_SPILL_NONCE_SIZE];
+    uint32_t ad[3];
+    uint8_t *ctx = &p->ctx[slot * p->ctx_size];
+    uint8_t *blob = tfm_crypto_spill_blob(p, index);
+    psa_status_t status;
+
+    status = tfm_crypto_spill_load_key();
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    p->oper[index].seal_count++;
+    tfm_crypto_spill_params(p, index, nonce, ad);
+
+    if (mbedtls_gcm_crypt_and_tag(&spill_gcm, MBEDTLS_GCM_ENCRYPT,
+                                  p->ctx_size, nonce, sizeof(nonce),
+                                  (const uint8_t *)ad, sizeof(ad),
+                                  ctx, blob,
+                                  TFM_CRYPTO_SPILL_TAG_SIZE,
+                                  &blob[p->ctx_size]) != 0) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    (void)tfm_memset(ctx, 0, p->ctx_size);
+    p->oper[index].slot = TFM_CRYPTO_SPILLED;
+    p->resident[slot] = TFM_CRYPTO_NO_NEXT_FREE;
+
+    return PSA_SUCCESS;
+}
+
+/*
+ * \brief Get a free context, spilling the least recently used operation if
+ *        all the contexts of the pool are taken. The operation used last is
+ *        never spilled, as its context may still be in use by the request
+ *        being served, for example as the source of a hash clone.
+ *
+ * \param[in]  p    Pool of the operation
+ * \param[out] slot Index of the free context
+ *
+ * \return Return values as described in \ref psa_status_t
+ */
+static psa_status_t tfm_crypto_spill_get_slot(struct tfm_crypto_pool_s *p,
+                                              uint32_t *slot)
+{
+    uint32_t i, index;
+    uint32_t lru = TFM_CRYPTO_NO_NEXT_FREE;
+    uint32_t lru_age = 0;
+
+    for (i = 0; i < p->ctx_num; i++) {
+        index = p->resident[i];
+        if (index == TFM_CRYPTO_NO_NEXT_FREE) {
+            *slot = i;
+            return PSA_SUCCESS;
+        }
+
+        /* The counter is part of the nonce, it must not wrap */
+        if ((p->oper[index].last_use == p->use_count) ||
+            (p->oper[index].seal_count == UINT32_MAX)) {
+            continue;
+        }
+
+        if ((lru == TFM_CRYPTO_NO_NEXT_FREE) ||
+            (p->use_count - p->oper[index].last_use > lru_age)) {
+            lru = i;
+            lru_age = p->use_count - p->oper[index].last_use;
+        }
+    }
+
+    if (lru == TFM_CRYPTO_NO_NEXT_FREE) {
+        return PSA_ERROR_INSUFFICIENT_MEMORY;
+    }
+
+    *slot = lru;
+    return tfm_crypto_spill_seal(p, lru);
+}
+
+/*
+ * \brief Make an operation resident, restoring it from the spill area if
+ *        it has been spilled, and mark it as the operation used last
+ *
+ * A sealed copy which does not authenticate, because it has been modified,
+ * replayed, or moved to another operation, is discarded and the operation is
+ * freed, so that the handle can not be used any more.
+ *
+ * \param[in] p     Pool of the operation
+ * \param[in] index Index of the operation in the pool
+ *
+ * \return Return values as described in \ref psa_status_t
+ */
+static psa_status_t tfm_crypto_spill_restore(struct tfm_crypto_pool_s *p,
+                                             uint32_t index)
+{
+    uint8_t nonce[TFM_CRYPTO_SPILL_NONCE_SIZE];
+    uint8_t tag[TFM_CRYPTO_SPILL_TAG_SIZE];
+    uint32_t ad[3];
+    uint32_t slot;
+    uint8_t *ctx;
+    const uint8_t *blob;
+    psa_status_t status;
+
+    if (p->oper[index].slot == TFM_CRYPTO_SPILLED) {
+        status = tfm_crypto_spill_get_slot(p, &slot);
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+
+        /* The sealed copy is outside of the secure RAM, copy it in first
+         * so that it can not be changed while it is decrypted
+         */
+        ctx = &p->ctx[slot * p->ctx_size];
+        blob = tfm_crypto_spill_blob(p, index);
+        (void)tfm_memcpy(ctx, blob, p->ctx_size);
+        (void)tfm_memcpy(tag, &blob[p->ctx_size], sizeof(tag));
+
+        tfm_crypto_spill_params(p, index, nonce, ad);
+        if (mbedtls_gcm_auth_decrypt(&spill_gcm, p->ctx_size,
+                                     nonce, sizeof(nonce),
+                                     (const uint8_t *)ad, sizeof(ad),
+                                     tag, sizeof(tag), ctx, ctx) != 0) {
+            (void)tfm_memset(ctx, 0, p->ctx_size);
+            p->oper[index].in_use = TFM_CRYPTO_NOT_IN_USE;
+            p->oper[index].owner = 0;
+            p->oper[index].next_free = p->free_head;
+            p->free_head = index;
+            TFM_CRYPTO_OPER_USAGE_ADD(-1);
+            return PSA_ERROR_CORRUPTION_DETECTED;
+        }
+
+        p->oper[index].slot = slot;
+        p->resident[slot] = index;
+    }
+
+    p->oper[index].last_use = ++p->use_count;
+
+    return PSA_SUCCESS;
+}
+
+/*
+ * \brief Lay out the sealed copies of the operations of each pool in the
+ *        spill area
+ *
+ * \return Return values as described in \ref psa_status_t
+ */
+static psa_status_t tfm_crypto_spill_init(void)
+{
+    uint32_t type, i;
+    size_t offset = 0;
+    struct tfm_crypto_pool_s *p;
+
+    for (type = TFM_CRYPTO_CIPHER_OPERATION; type < TFM_CRYPTO_POOL_NUM;
+         type++) {
+        p = &pool[type];
+
+        p->spill = (uint8_t *)TFM_CRYPTO_SPILL_AREA_START + offset;
+        offset += (p->ctx_size + TFM_CRYPTO_SPILL_TAG_SIZE) * p->num;
+        p->use_count = 0;
+
+        for (i = 0; i < p->ctx_num; i++) {
+            p->resident[i] = TFM_CRYPTO_NO_NEXT_FREE;
+        }
+        for (i = 0; i < p->num; i++) {
+            p->oper[i].slot = TFM_CRYPTO_SPILLED;
+        }
+    }
+
+    if (offset > TFM_CRYPTO_SPILL_AREA_SIZE) {
+        return PSA_ERROR_INSUFFICIENT_MEMORY;
+    }
+
+    return PSA_SUCCESS;
+}
+#endif /* TFM_CRYPTO_CONTEXT_SPILL */
+
 /*!
  * \defgroup public Public functions
  *
@@ -86,18 +604,51 @@ static void memset_operation_context(uint32_t index)
 /*!@{*/
 psa_status_t tfm_crypto_init_alloc(void)
 {
-    /* Clear the contents of the local contexts */
-    (void)tfm_memset(operation, 0, sizeof(operation));
+    uint32_t type, i;
+    struct tfm_crypto_pool_s *p;
+
+    for (type = TFM_CRYPTO_CIPHER_OPERATION; type < TFM_CRYPTO_POOL_NUM;
+         type++) {
+        p = &pool[type];
+
+        /* Clear the contents of the local contexts */
+        (void)tfm_memset(p->ctx, 0,
+                         p->ctx_size * (p->num - TFM_CRYPTO_SPILL_OPER_NUM));
+        (void)tfm_memset(p->oper, 0, sizeof(p->oper[0]) * p->num);
+
+        /* Chain all the operations in the free list */
+        for (i = 0; i < p->num - 1; i++) {
+            p->oper[i].next_free = i + 1;
+        }
+        p->oper[p->num - 1].next_free = TFM_CRYPTO_NO_NEXT_FREE;
+        p->free_head = 0;
+#ifdef TFM_RESOURCE_USAGE
+        oper_usage.capacity += p->num;
+#endif
+    }
+
+#ifdef TFM_RESOURCE_USAGE
+    (void)tfm_core_resource_usage_register(&oper_usage);
+#endif
+
+#ifdef TFM_CRYPTO_CONTEXT_SPILL
+    return tfm_crypto_spill_init();
+#else
     return PSA_SUCCESS;
+#endif
 }
 
 psa_status_t tfm_crypto_operation_alloc(enum tfm_crypto_operation_type type,
                                         uint32_t *handle,
                                         void **ctx)
 {
-    uint32_t i = 0;
+    uint32_t i;
+#ifdef TFM_CRYPTO_CONTEXT_SPILL
+    uint32_t slot;
+#endif
     int32_t partition_id = 0;
     psa_status_t status;
+    struct tfm_crypto_pool_s *p;
 
     status = tfm_crypto_get_caller_id(&partition_id);
     if (status != PSA_SUCCESS) {
@@ -115,40 +666,78 @@ psa_status_t tfm_crypto_operation_alloc(enum tfm_crypto_operation_type type,
     }
     *ctx = NULL;
 
-    for (i=0; i<TFM_CRYPTO_CONC_OPER_NUM; i++) {
-        if (operation[i].in_use == TFM_CRYPTO_NOT_IN_USE) {
-            operation[i].in_use = TFM_CRYPTO_IN_USE;
-            operation[i].owner = partition_id;
-            operation[i].type = type;
-            *handle = i + 1;
-            *ctx = (void *) &(operation[i].operation);
-            return PSA_SUCCESS;
-        }
+    if ((type == TFM_CRYPTO_OPERATION_NONE) ||
+        ((uint32_t)type >= TFM_CRYPTO_POOL_NUM)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    p = &pool[type];
+    i = p->free_head;
+    if (i == TFM_CRYPTO_NO_NEXT_FREE) {
+        return PSA_ERROR_NOT_PERMITTED;
     }
 
-    return PSA_ERROR_NOT_PERMITTED;
+#ifdef TFM_CRYPTO_CONTEXT_SPILL
+    /* Make room for the operation if all the contexts are taken */
+    status = tfm_crypto_spill_get_slot(p, &slot);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+    p->oper[i].slot = slot;
+    p->oper[i].last_use = ++p->use_count;
+    p->resident[slot] = i;
+#endif
+
+    /* Take the first operation of the free list */
+    p->free_head = p->oper[i].next_free;
+    p->oper[i].next_free = TFM_CRYPTO_NO_NEXT_FREE;
+    p->oper[i].in_use = TFM_CRYPTO_IN_USE;
+    p->oper[i].owner = partition_id;
+    TFM_CRYPTO_OPER_USAGE_ADD(1);
+
+    *handle = TFM_CRYPTO_HANDLE(type, i);
+    *ctx = get_oper_ctx(p, i);
+
+    return PSA_SUCCESS;
 }
 
 psa_status_t tfm_crypto_operation_release(uint32_t *handle)
 {
-    uint32_t h_val = *handle;
+    uint32_t i;
     int32_t partition_id = 0;
     psa_status_t status;
+    struct tfm_crypto_pool_s *p;
 
     status = tfm_crypto_get_caller_id(&partition_id);
     if (status != PSA_SUCCESS) {
         return status;
     }
 
-    if ( (h_val != TFM_CRYPTO_INVALID_HANDLE) &&
-         (h_val <= TFM_CRYPTO_CONC_OPER_NUM) &&
-         (operation[h_val - 1].in_use == TFM_CRYPTO_IN_USE) &&
-         (operation[h_val - 1].owner == partition_id)) {
+    p = get_handle_pool(*handle, &i);
+    if ((p != NULL) &&
+        (p->oper[i].in_use == TFM_CRYPTO_IN_USE) &&
+        (p->oper[i].owner == partition_id)) {
+
+        /* Clear the contents of the backend context. A spilled operation
+         * has no context, its sealed copy is left to be overwritten.
+         */
+#ifdef TFM_CRYPTO_CONTEXT_SPILL
+        if (p->oper[i].slot != TFM_CRYPTO_SPILLED) {
+            (void)tfm_memset(get_oper_ctx(p, i), 0, p->ctx_size);
+            p->resident[p->oper[i].slot] = TFM_CRYPTO_NO_NEXT_FREE;
+            p->oper[i].slot = TFM_CRYPTO_SPILLED;
+        }
+#else
+        (void)tfm_memset(get_oper_ctx(p, i), 0, p->ctx_size);
+#endif
+        p->oper[i].in_use = TFM_CRYPTO_NOT_IN_USE;
+        p->oper[i].owner = 0;
+
+        /* Put the operation back at the head of the free list */
+        p->oper[i].next_free = p->free_head;
+        p->free_head = i;
+        TFM_CRYPTO_OPER_USAGE_ADD(-1);
 
-        memset_operation_context(h_val - 1);
-        operation[h_val - 1].in_use = TFM_CRYPTO_NOT_IN_USE;
-        operation[h_val - 1].type = TFM_CRYPTO_OPERATION_NONE;
-        operation[h_val - 1].owner = 0;
         *handle = TFM_CRYPTO_INVALID_HANDLE;
         return PSA_SUCCESS;
     }
@@ -160,21 +749,30 @@ psa_status_t tfm_crypto_operation_lookup(enum tfm_crypto_operation_type type,
                                          uint32_t handle,
                                          void **ctx)
 {
+    uint32_t i;
     int32_t partition_id = 0;
     psa_status_t status;
+    struct tfm_crypto_pool_s *p;
 
     status = tfm_crypto_get_caller_id(&partition_id);
     if (status != PSA_SUCCESS) {
         return status;
     }
 
-    if ( (handle != TFM_CRYPTO_INVALID_HANDLE) &&
-         (handle <= TFM_CRYPTO_CONC_OPER_NUM) &&
-         (operation[handle - 1].in_use == TFM_CRYPTO_IN_USE) &&
-         (operation[handle - 1].type == type) &&
-         (operation[handle - 1].owner == partition_id)) {
+    /* The type of the operation is encoded in the handle */
+    p = get_handle_pool(handle, &i);
+    if ((p != NULL) &&
+        ((handle >> TFM_CRYPTO_HANDLE_TYPE_POS) == (uint32_t)type) &&
+        (p->oper[i].in_use == TFM_CRYPTO_IN_USE) &&
+        (p->oper[i].owner == partition_id)) {
 
-        *ctx = (void *) &(operation[handle - 1].operation);
+#ifdef TFM_CRYPTO_CONTEXT_SPILL
+        status = tfm_crypto_spill_restore(p, i);
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+#endif
+        *ctx = get_oper_ctx(p, i);
         return PSA_SUCCESS;
     }
 
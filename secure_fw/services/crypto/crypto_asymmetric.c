@@ -18,6 +18,56 @@
 #include "tfm_crypto_api.h"
 #include "tfm_crypto_defs.h"
 
+#ifndef TFM_CRYPTO_ASYMMETRIC_MODULE_DISABLED
+/**
+ * \brief Key of a batch verification request, checked once for all the items
+ *        using it
+ */
+struct tfm_crypto_verify_batch_key {
+    psa_key_handle_t client_handle; /*!< Handle as given by the client */
+    psa_key_handle_t handle;        /*!< Handle of the key in Mbed Crypto */
+    psa_status_t status;            /*!< Result of the owner check */
+};
+
+/**
+ * \brief Checks the owner of a key of a batch verification request, unless
+ *        the key has been checked for a previous item of the batch
+ *
+ * Mbed Crypto keeps the public key parsed in its key slot, along with the
+ * curve and the precomputed multiples of its generator once the key has been
+ * used, so the items of a batch which share a key only pay for the key setup
+ * once.
+ *
+ * \param[in,out] keys       Keys checked so far
+ * \param[in,out] key_count  Number of entries in keys
+ * \param[in,out] handle     Handle given by the client, replaced by the
+ *                           handle of the key in Mbed Crypto
+ *
+ * \return Return values as described in \ref psa_status_t
+ */
+static psa_status_t tfm_crypto_verify_batch_key(
+                                       struct tfm_crypto_verify_batch_key *keys,
+                                       size_t *key_count,
+                                       psa_key_handle_t *handle)
+{
+    size_t i;
+
+    for (i = 0; i < *key_count; i++) {
+        if (keys[i].client_handle == *handle) {
+            *handle = keys[i].handle;
+            return keys[i].status;
+        }
+    }
+
+    keys[i].client_handle = *handle;
+    keys[i].status = tfm_crypto_check_handle_owner(handle, NULL);
+    keys[i].handle = *handle;
+    (*key_count)++;
+
+    return keys[i].status;
+}
+#endif /* TFM_CRYPTO_ASYMMETRIC_MODULE_DISABLED */
+
 /*!
  * \defgroup public_psa Public functions, PSA
  *
@@ -47,7 +97,7 @@ psa_status_t tfm_crypto_sign_hash(psa_invec in_vec[],
     size_t hash_length = in_vec[1].len;
     uint8_t *signature = out_vec[0].base;
     size_t signature_size = out_vec[0].len;
-    psa_status_t status = tfm_crypto_check_handle_owner(handle, NULL);
+    psa_status_t status = tfm_crypto_check_handle_owner(&handle, NULL);
 
     if (status != PSA_SUCCESS) {
         return status;
@@ -81,7 +131,7 @@ psa_status_t tfm_crypto_verify_hash(psa_invec in_vec[],
     size_t hash_length = in_vec[1].len;
     const uint8_t *signature = in_vec[2].base;
     size_t signature_length = in_vec[2].len;
-    psa_status_t status = tfm_crypto_check_handle_owner(handle, NULL);
+    psa_status_t status = tfm_crypto_check_handle_owner(&handle, NULL);
 
     if (status != PSA_SUCCESS) {
         return status;
@@ -92,6 +142,74 @@ psa_status_t tfm_crypto_verify_hash(psa_invec in_vec[],
 #endif /* TFM_CRYPTO_ASYMMETRIC_MODULE_DISABLED */
 }
 
+psa_status_t tfm_crypto_verify_hash_batch(psa_invec in_vec[],
+                                          size_t in_len,
+                                          psa_outvec out_vec[],
+                                          size_t out_len)
+{
+#ifdef TFM_CRYPTO_ASYMMETRIC_MODULE_DISABLED
+    return PSA_ERROR_NOT_SUPPORTED;
+#else
+    struct tfm_crypto_verify_batch_key
+                                    keys[TFM_CRYPTO_VERIFY_BATCH_MAX_ENTRIES];
+    size_t key_count = 0, offset = 0, i;
+    size_t item_length;
+    psa_key_handle_t handle;
+    psa_status_t status;
+
+    if ((in_len != 3) || (out_len != 1)) {
+        return PSA_ERROR_CONNECTION_REFUSED;
+    }
+
+    if ((in_vec[0].len != sizeof(struct tfm_crypto_pack_iovec)) ||
+        (in_vec[1].len == 0) ||
+        (in_vec[1].len % sizeof(struct tfm_crypto_verify_batch_entry) != 0) ||
+        (out_vec[0].len != sizeof(uint32_t))) {
+        return PSA_ERROR_CONNECTION_REFUSED;
+    }
+    const struct tfm_crypto_verify_batch_entry *entries = in_vec[1].base;
+    size_t entry_count = in_vec[1].len /
+                         sizeof(struct tfm_crypto_verify_batch_entry);
+    const uint8_t *input = in_vec[2].base;
+    size_t input_length = in_vec[2].len;
+    uint32_t *verified = out_vec[0].base;
+
+    if (entry_count > TFM_CRYPTO_VERIFY_BATCH_MAX_ENTRIES) {
+        return PSA_ERROR_CONNECTION_REFUSED;
+    }
+
+    *verified = 0;
+
+    for (i = 0; i < entry_count; i++) {
+        item_length = entries[i].hash_length + entries[i].signature_length;
+        if ((item_length < entries[i].signature_length) ||
+            (item_length > input_length - offset)) {
+            /* The layout of the following items is unknown, so they are
+             * left unverified
+             */
+            break;
+        }
+
+        handle = entries[i].key_handle;
+        status = tfm_crypto_verify_batch_key(keys, &key_count, &handle);
+        if (status == PSA_SUCCESS) {
+            status = psa_verify_hash(handle, entries[i].alg,
+                                     &input[offset], entries[i].hash_length,
+                                     &input[offset + entries[i].hash_length],
+                                     entries[i].signature_length);
+        }
+
+        if (status == PSA_SUCCESS) {
+            *verified |= (1u << i);
+        }
+
+        offset += item_length;
+    }
+
+    return PSA_SUCCESS;
+#endif /* TFM_CRYPTO_ASYMMETRIC_MODULE_DISABLED */
+}
+
 psa_status_t tfm_crypto_asymmetric_encrypt(psa_invec in_vec[],
                                            size_t in_len,
                                            psa_outvec out_vec[],
@@ -128,7 +246,7 @@ psa_status_t tfm_crypto_asymmetric_encrypt(psa_invec in_vec[],
         salt_length = in_vec[2].len;
     }
 
-    status = tfm_crypto_check_handle_owner(handle, NULL);
+    status = tfm_crypto_check_handle_owner(&handle, NULL);
     if (status != PSA_SUCCESS) {
         return status;
     }
@@ -186,7 +304,7 @@ psa_status_t tfm_crypto_asymmetric_decrypt(psa_invec in_vec[],
         salt_length = in_vec[2].len;
     }
 
-    status = tfm_crypto_check_handle_owner(handle, NULL);
+    status = tfm_crypto_check_handle_owner(&handle, NULL);
     if (status != PSA_SUCCESS) {
         return status;
     }
@@ -146,7 +146,7 @@ psa_status_t tfm_crypto_cipher_encrypt_setup(psa_invec in_vec[],
     psa_key_handle_t key_handle = iov->key_handle;
     psa_algorithm_t alg = iov->alg;
 
-    status = tfm_crypto_check_handle_owner(key_handle, NULL);
+    status = tfm_crypto_check_handle_owner(&key_handle, NULL);
     if (status != PSA_SUCCESS) {
         return status;
     }
@@ -197,7 +197,7 @@ psa_status_t tfm_crypto_cipher_decrypt_setup(psa_invec in_vec[],
     psa_key_handle_t key_handle = iov->key_handle;
     psa_algorithm_t alg = iov->alg;
 
-    status = tfm_crypto_check_handle_owner(key_handle, NULL);
+    status = tfm_crypto_check_handle_owner(&key_handle, NULL);
     if (status != PSA_SUCCESS) {
         return status;
     }
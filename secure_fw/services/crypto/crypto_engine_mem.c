@@ -0,0 +1,456 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "tfm_mbedcrypto_include.h"
+
+#include "tfm_crypto_api.h"
+#include "tfm_crypto_defs.h"
+#include "tfm_memory_utils.h"
+
+#ifdef TFM_RESOURCE_USAGE
+#include "secure_fw/include/tfm_spm_services_api.h"
+#endif
+
+/*
+ * \brief These Mbed TLS includes are needed to provide the Mbed TLS layer of
+ *        Mbed Crypto with its memory allocator
+ */
+#include "mbedtls/platform.h"
+#include "mbedtls/memory_buffer_alloc.h"
+
+#ifdef TFM_CRYPTO_ENGINE_MEM_POOL
+/**
+ * \brief Size in bytes of the blocks of the smallest size class. The blocks of
+ *        each of the following classes are twice as large as the previous one,
+ *        so that the bignums of Mbed Crypto, whose sizes are powers of two,
+ *        fill their block entirely. The largest allocation which can be served
+ *        is of (TFM_CRYPTO_ENGINE_MEM_MIN_SIZE << (CLASS_NUM - 1)) bytes.
+ */
+#ifndef TFM_CRYPTO_ENGINE_MEM_MIN_SIZE
+#define TFM_CRYPTO_ENGINE_MEM_MIN_SIZE (16u)
+#endif
+
+#if (TFM_CRYPTO_ENGINE_MEM_MIN_SIZE < 16) || \
+    (TFM_CRYPTO_ENGINE_MEM_MIN_SIZE & (TFM_CRYPTO_ENGINE_MEM_MIN_SIZE - 1))
+#error "TFM_CRYPTO_ENGINE_MEM_MIN_SIZE must be a power of two, at least 16!"
+#endif
+
+#if (TFM_CRYPTO_ENGINE_MEM_CLASS_NUM > 16)
+#error "Too many size classes to be encoded in the map of the pool!"
+#endif
+
+#define TFM_CRYPTO_ENGINE_MEM_CLASS_SIZE(size_class) \
+    ((size_t)TFM_CRYPTO_ENGINE_MEM_MIN_SIZE << (size_class))
+
+#define TFM_CRYPTO_ENGINE_MEM_CLASS_UNITS(size_class) (1UL << (size_class))
+
+#define TFM_CRYPTO_ENGINE_MEM_MAX_CLASS (TFM_CRYPTO_ENGINE_MEM_CLASS_NUM - 1)
+
+/**
+ * \brief Alignment of the start of the pool
+ */
+#define TFM_CRYPTO_ENGINE_MEM_ALIGN (8u)
+
+/**
+ * \brief The map of the pool holds a byte for each unit of
+ *        TFM_CRYPTO_ENGINE_MEM_MIN_SIZE bytes. The byte of the first unit of a
+ *        block holds its size class and whether it is in use, the bytes of
+ *        the other units of the block are zero.
+ */
+#define TFM_CRYPTO_ENGINE_MEM_MAP_HEAD       (0x40u)
+#define TFM_CRYPTO_ENGINE_MEM_MAP_USED       (0x80u)
+#define TFM_CRYPTO_ENGINE_MEM_MAP_CLASS_MASK (0x0Fu)
+
+/**
+ * \brief A free block holds the links of the free list of its size class
+ */
+struct tfm_crypto_engine_mem_free_block {
+    struct tfm_crypto_engine_mem_free_block *next;
+    struct tfm_crypto_engine_mem_free_block *prev;
+};
+
+/**
+ * \brief State of the pool. The pool is a buddy allocator: a block is split
+ *        in two halves when smaller blocks are needed, and merged back with
+ *        its other half, its buddy, as soon as both are free.
+ */
+static struct {
+    uint8_t *map;    /*!< Byte map of the units of the pool */
+    uint8_t *base;   /*!< Start of the first unit of the pool */
+    uint32_t units;  /*!< Number of units of the pool */
+    struct tfm_crypto_engine_mem_free_block
+        *free_list[TFM_CRYPTO_ENGINE_MEM_CLASS_NUM]; /*!< Free blocks of each
+                                                      *   size class
+                                                      */
+    uint32_t sfn_id; /*!< Function being served by the service */
+    struct tfm_crypto_engine_mem_stats stats; /*!< Statistics of the pool */
+} engine_mem = {0};
+
+static void tfm_crypto_engine_mem_push(uint32_t unit, uint32_t size_class)
+{
+    struct tfm_crypto_engine_mem_free_block *block =
+        (struct tfm_crypto_engine_mem_free_block *)
+            &engine_mem.base[unit * TFM_CRYPTO_ENGINE_MEM_MIN_SIZE];
+
+    engine_mem.map[unit] = TFM_CRYPTO_ENGINE_MEM_MAP_HEAD | size_class;
+
+    block->prev = NULL;
+    block->next = engine_mem.free_list[size_class];
+    if (block->next != NULL) {
+        block->next->prev = block;
+    }
+    engine_mem.free_list[size_class] = block;
+}
+
+static void tfm_crypto_engine_mem_remove(
+                                 struct tfm_crypto_engine_mem_free_block *block,
+                                 uint32_t size_class)
+{
+    if (block->prev != NULL) {
+        block->prev->next = block->next;
+    } else {
+        engine_mem.free_list[size_class] = block->next;
+    }
+    if (block->next != NULL) {
+        block->next->prev = block->prev;
+    }
+}
+
+static uint32_t tfm_crypto_engine_mem_unit(const void *ptr)
+{
+    return (uint32_t)(((const uint8_t *)ptr - engine_mem.base) /
+                      TFM_CRYPTO_ENGINE_MEM_MIN_SIZE);
+}
+
+/**
+ * \brief Returns the smallest size class holding blocks large enough for
+ *        the given size, or TFM_CRYPTO_ENGINE_MEM_CLASS_NUM if the size is too
+ *        large for any class
+ */
+static uint32_t tfm_crypto_engine_mem_size_class(size_t size)
+{
+    uint32_t size_class = 0;
+
+    while ((size_class < TFM_CRYPTO_ENGINE_MEM_CLASS_NUM) &&
+           (TFM_CRYPTO_ENGINE_MEM_CLASS_SIZE(size_class) < size)) {
+        size_class++;
+    }
+
+    return size_class;
+}
+
+static void *tfm_crypto_engine_mem_calloc(size_t nmemb, size_t size)
+{
+    struct tfm_crypto_engine_mem_free_block *block = NULL;
+    uint32_t size_class, i, unit;
+    size_t total;
+
+    /* Check for overflows of the size of the allocation */
+    if ((nmemb == 0) || (size == 0) || (size > (SIZE_MAX / nmemb))) {
+        engine_mem.stats.failed_count++;
+        return NULL;
+    }
+    total = nmemb * size;
+
+    /* Take the smallest free block which is large enough */
+    size_class = tfm_crypto_engine_mem_size_class(total);
+    for (i = size_class; i < TFM_CRYPTO_ENGINE_MEM_CLASS_NUM; i++) {
+        block = engine_mem.free_list[i];
+        if (block != NULL) {
+            break;
+        }
+    }
+
+    if (block == NULL) {
+        engine_mem.stats.failed_count++;
+        return NULL;
+    }
+    tfm_crypto_engine_mem_remove(block, i);
+    unit = tfm_crypto_engine_mem_unit(block);
+
+    /* Split it, releasing its upper halves, down to the size needed */
+    while (i > size_class) {
+        i--;
+        tfm_crypto_engine_mem_push(unit + TFM_CRYPTO_ENGINE_MEM_CLASS_UNITS(i),
+                                   i);
+    }
+    engine_mem.map[unit] = TFM_CRYPTO_ENGINE_MEM_MAP_HEAD |
+                           TFM_CRYPTO_ENGINE_MEM_MAP_USED | size_class;
+    (void)tfm_memset(block, 0, total);
+
+    /* Update the statistics */
+    engine_mem.stats.in_use += TFM_CRYPTO_ENGINE_MEM_CLASS_SIZE(size_class);
+    if (engine_mem.stats.in_use > engine_mem.stats.peak_in_use) {
+        engine_mem.stats.peak_in_use = engine_mem.stats.in_use;
+    }
+    engine_mem.stats.alloc_count++;
+    engine_mem.stats.class_alloc_count[size_class]++;
+    if (engine_mem.sfn_id < TFM_CRYPTO_SID_MAX) {
+        engine_mem.stats.sfn_alloc_count[engine_mem.sfn_id]++;
+    } else {
+        engine_mem.stats.other_alloc_count++;
+    }
+
+    return block;
+}
+
+static void tfm_crypto_engine_mem_free(void *ptr)
+{
+    const uint8_t *addr = ptr;
+    uint32_t unit, buddy, size_class;
+
+    if (ptr == NULL) {
+        return;
+    }
+
+    /* Ignore any pointer which has not been returned by the allocator */
+    if ((addr < engine_mem.base) ||
+        (addr >= (engine_mem.base +
+                  (engine_mem.units * TFM_CRYPTO_ENGINE_MEM_MIN_SIZE))) ||
+        (((addr - engine_mem.base) % TFM_CRYPTO_ENGINE_MEM_MIN_SIZE) != 0)) {
+        return;
+    }
+    unit = tfm_crypto_engine_mem_unit(ptr);
+    if ((engine_mem.map[unit] & (TFM_CRYPTO_ENGINE_MEM_MAP_HEAD |
+                                 TFM_CRYPTO_ENGINE_MEM_MAP_USED)) !=
+        (TFM_CRYPTO_ENGINE_MEM_MAP_HEAD | TFM_CRYPTO_ENGINE_MEM_MAP_USED)) {
+        return;
+    }
+    size_class = engine_mem.map[unit] & TFM_CRYPTO_ENGINE_MEM_MAP_CLASS_MASK;
+    engine_mem.stats.in_use -= TFM_CRYPTO_ENGINE_MEM_CLASS_SIZE(size_class);
+
+    /* Merge the block with its buddy for as long as the buddy is free */
+    while (size_class < TFM_CRYPTO_ENGINE_MEM_MAX_CLASS) {
+        buddy = unit ^ TFM_CRYPTO_ENGINE_MEM_CLASS_UNITS(size_class);
+        if (((buddy + TFM_CRYPTO_ENGINE_MEM_CLASS_UNITS(size_class)) >
+             engine_mem.units) ||
+            (engine_mem.map[buddy] !=
+             (TFM_CRYPTO_ENGINE_MEM_MAP_HEAD | size_class))) {
+            break;
+        }
+        tfm_crypto_engine_mem_remove(
+            (struct tfm_crypto_engine_mem_free_block *)
+                &engine_mem.base[buddy * TFM_CRYPTO_ENGINE_MEM_MIN_SIZE],
+            size_class);
+        engine_mem.map[unit] = 0;
+        engine_mem.map[buddy] = 0;
+        if (buddy < unit) {
+            unit = buddy;
+        }
+        size_class++;
+    }
+
+    tfm_crypto_engine_mem_push(unit, size_class);
+}
+
+static psa_status_t tfm_crypto_engine_mem_pool_init(uint8_t *buf, size_t size)
+{
+    uintptr_t offset = ((uintptr_t)buf) & (TFM_CRYPTO_ENGINE_MEM_ALIGN - 1);
+    uint32_t unit = 0, size_class, units;
+
+    if (offset != 0) {
+        offset = TFM_CRYPTO_ENGINE_MEM_ALIGN - offset;
+    }
+    if (size <= offset) {
+        return PSA_ERROR_INSUFFICIENT_MEMORY;
+    }
+    buf += offset;
+    size -= offset;
+
+    /* The map takes a byte for each unit at the start of the buffer, and the
+     * units of the pool take the rest of it
+     */
+    units = (uint32_t)(size / (TFM_CRYPTO_ENGINE_MEM_MIN_SIZE + 1));
+    while ((units > 0) &&
+           ((((units + TFM_CRYPTO_ENGINE_MEM_ALIGN - 1) &
+              ~(TFM_CRYPTO_ENGINE_MEM_ALIGN - 1)) +
+             (units * TFM_CRYPTO_ENGINE_MEM_MIN_SIZE)) > size)) {
+        units--;
+    }
+    if (units == 0) {
+        return PSA_ERROR_INSUFFICIENT_MEMORY;
+    }
+
+    engine_mem.map = buf;
+    engine_mem.base = buf + ((units + TFM_CRYPTO_ENGINE_MEM_ALIGN - 1) &
+                             ~(TFM_CRYPTO_ENGINE_MEM_ALIGN - 1));
+    engine_mem.units = units;
+    engine_mem.sfn_id = TFM_CRYPTO_SID_INVALID;
+    engine_mem.stats.buf_size = units * TFM_CRYPTO_ENGINE_MEM_MIN_SIZE;
+    (void)tfm_memset(engine_mem.map, 0, units);
+
+    /* Release the pool as the largest blocks aligned on their own size */
+    while (unit < units) {
+        size_class = TFM_CRYPTO_ENGINE_MEM_MAX_CLASS;
+        while ((size_class > 0) &&
+               (((unit & (TFM_CRYPTO_ENGINE_MEM_CLASS_UNITS(size_class) - 1))
+                                                                      != 0) ||
+                ((unit + TFM_CRYPTO_ENGINE_MEM_CLASS_UNITS(size_class)) >
+                 units))) {
+            size_class--;
+        }
+        tfm_crypto_engine_mem_push(unit, size_class);
+        unit += TFM_CRYPTO_ENGINE_MEM_CLASS_UNITS(size_class);
+    }
+
+    /* Provide Mbed Crypto with the allocation functions of the pool */
+    if (mbedtls_platform_set_calloc_free(tfm_crypto_engine_mem_calloc,
+                                         tfm_crypto_engine_mem_free) != 0) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    return PSA_SUCCESS;
+}
+#else
+/**
+ * \brief Size of the buffer given to the Mbed Crypto buffer allocator
+ */
+static size_t engine_mem_buf_size = 0;
+#endif /* TFM_CRYPTO_ENGINE_MEM_POOL */
+
+#ifdef TFM_CRYPTO_ENGINE_MEM_STATS
+static psa_status_t tfm_crypto_engine_mem_get_stats(
+                                      struct tfm_crypto_engine_mem_stats *stats)
+{
+#ifdef TFM_CRYPTO_ENGINE_MEM_POOL
+    uint32_t i;
+
+    (void)tfm_memcpy(stats, &engine_mem.stats, sizeof(*stats));
+
+    /* The largest free block is the measure of the fragmentation */
+    stats->largest_free = 0;
+    for (i = TFM_CRYPTO_ENGINE_MEM_CLASS_NUM; i > 0; i--) {
+        if (engine_mem.free_list[i - 1] != NULL) {
+            stats->largest_free = TFM_CRYPTO_ENGINE_MEM_CLASS_SIZE(i - 1);
+            break;
+        }
+    }
+
+    return PSA_SUCCESS;
+#elif defined(MBEDTLS_MEMORY_DEBUG)
+    size_t used, blocks;
+
+    (void)tfm_memset(stats, 0, sizeof(*stats));
+    stats->buf_size = (uint32_t)engine_mem_buf_size;
+    mbedtls_memory_buffer_alloc_cur_get(&used, &blocks);
+    stats->in_use = (uint32_t)used;
+    mbedtls_memory_buffer_alloc_max_get(&used, &blocks);
+    stats->peak_in_use = (uint32_t)used;
+
+    return PSA_SUCCESS;
+#else
+    /* The Mbed Crypto buffer allocator keeps no statistics */
+    (void)stats;
+
+    return PSA_ERROR_NOT_SUPPORTED;
+#endif
+}
+#endif /* TFM_CRYPTO_ENGINE_MEM_STATS */
+
+#ifdef TFM_RESOURCE_USAGE
+/**
+ * \brief Usage of the memory of Mbed Crypto, in bytes, reported by SPM
+ */
+static struct tfm_resource_usage_t engine_mem_usage = {
+    .resource_id = TFM_RESOURCE_CRYPTO_ENGINE_MEM,
+};
+
+/**
+ * \brief Bring the usage reported by SPM up to date. It is called at the
+ *        boundaries of the requests, so that the allocator is not slowed down.
+ *        The Mbed Crypto buffer allocator only reports its use with
+ *        MBEDTLS_MEMORY_DEBUG, its capacity is reported in any case.
+ */
+static void tfm_crypto_engine_mem_update_usage(void)
+{
+#ifdef TFM_CRYPTO_ENGINE_MEM_POOL
+    engine_mem_usage.used = engine_mem.stats.in_use;
+    engine_mem_usage.peak = engine_mem.stats.peak_in_use;
+#elif defined(MBEDTLS_MEMORY_DEBUG)
+    size_t used, blocks;
+
+    mbedtls_memory_buffer_alloc_cur_get(&used, &blocks);
+    engine_mem_usage.used = (uint32_t)used;
+    mbedtls_memory_buffer_alloc_max_get(&used, &blocks);
+    engine_mem_usage.peak = (uint32_t)used;
+#endif
+}
+#endif /* TFM_RESOURCE_USAGE */
+
+/*!
+ * \defgroup public Public functions
+ *
+ */
+
+/*!@{*/
+psa_status_t tfm_crypto_init_engine_mem(uint8_t *buf, size_t size)
+{
+#ifdef TFM_CRYPTO_ENGINE_MEM_POOL
+    psa_status_t status;
+
+    status = tfm_crypto_engine_mem_pool_init(buf, size);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+#ifdef TFM_RESOURCE_USAGE
+    engine_mem_usage.capacity = engine_mem.stats.buf_size;
+#endif
+#else
+    /* Initialise the Mbed Crypto memory allocator to use static
+     * memory allocation from the provided buffer instead of using
+     * the heap
+     */
+    mbedtls_memory_buffer_alloc_init(buf, size);
+    engine_mem_buf_size = size;
+#ifdef TFM_RESOURCE_USAGE
+    engine_mem_usage.capacity = (uint32_t)size;
+#endif
+#endif /* TFM_CRYPTO_ENGINE_MEM_POOL */
+
+#ifdef TFM_RESOURCE_USAGE
+    (void)tfm_core_resource_usage_register(&engine_mem_usage);
+#endif
+
+    return PSA_SUCCESS;
+}
+
+void tfm_crypto_engine_mem_set_sfn(uint32_t sfn_id)
+{
+#ifdef TFM_CRYPTO_ENGINE_MEM_POOL
+    engine_mem.sfn_id = sfn_id;
+#else
+    (void)sfn_id;
+#endif
+#ifdef TFM_RESOURCE_USAGE
+    tfm_crypto_engine_mem_update_usage();
+#endif
+}
+
+psa_status_t tfm_crypto_get_engine_mem_stats(psa_invec in_vec[],
+                                             size_t in_len,
+                                             psa_outvec out_vec[],
+                                             size_t out_len)
+{
+#ifndef TFM_CRYPTO_ENGINE_MEM_STATS
+    return PSA_ERROR_NOT_SUPPORTED;
+#else
+    if ((in_len != 1) || (out_len != 1)) {
+        return PSA_ERROR_CONNECTION_REFUSED;
+    }
+
+    if ((in_vec[0].len != sizeof(struct tfm_crypto_pack_iovec)) ||
+        (out_vec[0].len != sizeof(struct tfm_crypto_engine_mem_stats))) {
+        return PSA_ERROR_CONNECTION_REFUSED;
+    }
+
+    return tfm_crypto_engine_mem_get_stats(out_vec[0].base);
+#endif /* TFM_CRYPTO_ENGINE_MEM_STATS */
+}
+/*!@}*/
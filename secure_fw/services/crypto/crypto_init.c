@@ -5,17 +5,13 @@
  *
  */
 
+#include <stdbool.h>
+
 #include "tfm_mbedcrypto_include.h"
 
 #include "tfm_crypto_api.h"
 #include "tfm_crypto_defs.h"
 
-/*
- * \brief This Mbed TLS include is needed to initialise the memory allocator
- *        inside the Mbed TLS layer of Mbed Crypto
- */
-#include "mbedtls/memory_buffer_alloc.h"
-
 #ifndef TFM_PSA_API
 #include "tfm_secure_api.h"
 #endif
@@ -24,6 +20,10 @@
 #include "crypto_hw.h"
 #endif /* CRYPTO_HW_ACCLERATOR */
 
+#ifdef TFM_RESOURCE_USAGE
+#include "secure_fw/include/tfm_spm_services_api.h"
+#endif
+
 #ifdef TFM_PSA_API
 #include "psa/service.h"
 #include "psa_manifest/tfm_crypto.h"
@@ -58,34 +58,151 @@ LIST_TFM_CRYPTO_UNIFORM_SIGNATURE_API
 #define TFM_CRYPTO_IOVEC_BUFFER_SIZE (5120)
 #endif
 
+/**
+ * \brief Maximum number of requests which can hold a region of the internal
+ *        scratch at the same time
+ */
+#ifndef TFM_CRYPTO_SCRATCH_MAX_REGIONS
+#define TFM_CRYPTO_SCRATCH_MAX_REGIONS (2)
+#endif
+
+/**
+ * \brief Size of the chunks in which the input of a streaming request is read
+ *        into the internal scratch
+ */
+#ifndef TFM_CRYPTO_STREAM_CHUNK_SIZE
+#define TFM_CRYPTO_STREAM_CHUNK_SIZE (1024)
+#endif
+
+#if (TFM_CRYPTO_STREAM_CHUNK_SIZE == 0) || \
+    (TFM_CRYPTO_STREAM_CHUNK_SIZE > TFM_CRYPTO_IOVEC_BUFFER_SIZE)
+#error "TFM_CRYPTO_STREAM_CHUNK_SIZE must fit in the internal scratch!"
+#endif
+
+/**
+ * \brief Size in bytes of the buffer on the stack of a request in which its
+ *        small IOVecs are allocated instead of the internal scratch
+ */
+#ifndef TFM_CRYPTO_IOVEC_STACK_SIZE
+#define TFM_CRYPTO_IOVEC_STACK_SIZE (64)
+#endif
+
+#if (TFM_CRYPTO_IOVEC_STACK_SIZE % TFM_CRYPTO_IOVEC_ALIGNMENT) != 0
+#error "TFM_CRYPTO_IOVEC_STACK_SIZE must be a multiple of the IOVec alignment!"
+#endif
+
+/**
+ * \brief Number of requests to the TFM_CRYPTO RoT Service which can be served
+ *        in a row while a request to the TFM_CRYPTO_ASYM RoT Service is
+ *        pending
+ */
+#ifndef TFM_CRYPTO_ASYM_MAX_DEFER
+#define TFM_CRYPTO_ASYM_MAX_DEFER (4)
+#endif
+
+/**
+ * \brief Region of the internal scratch used by a single request
+ */
+struct tfm_crypto_scratch_region {
+    uint32_t base;        /*!< Offset of the region in the scratch buffer */
+    uint32_t alloc_index; /*!< Number of bytes allocated in the region */
+    int32_t owner;        /*!< Client ID of the request */
+#if TFM_CRYPTO_IOVEC_STACK_SIZE > 0
+    uint8_t *stack_buf;   /*!< Buffer of TFM_CRYPTO_IOVEC_STACK_SIZE bytes
+                           *   on the stack of the request
+                           */
+    uint32_t stack_index; /*!< Number of bytes allocated in stack_buf */
+#endif
+};
+
 /**
  * \brief Internal scratch used for IOVec allocations
  *
+ * The scratch is an arena of regions, one for each request being served. The
+ * regions are opened and closed in LIFO order, and only the last region opened
+ * can allocate, so the regions are always contiguous and the buffer space of
+ * a request is only as large as its IOVecs.
  */
 static struct tfm_crypto_scratch {
     __attribute__((__aligned__(TFM_CRYPTO_IOVEC_ALIGNMENT)))
     uint8_t buf[TFM_CRYPTO_IOVEC_BUFFER_SIZE];
-    uint32_t alloc_index;
-    int32_t owner;
-} scratch = {.buf = {0}, .alloc_index = 0};
+    uint32_t alloc_index; /*!< Number of bytes allocated by all the regions */
+    uint32_t nr_regions;
+    struct tfm_crypto_scratch_region region[TFM_CRYPTO_SCRATCH_MAX_REGIONS];
+} scratch = {.buf = {0}, .alloc_index = 0, .nr_regions = 0};
 
-static psa_status_t tfm_crypto_set_scratch_owner(int32_t id)
+#ifdef TFM_RESOURCE_USAGE
+/**
+ * \brief Usage of the internal scratch, in bytes, reported by SPM
+ */
+static struct tfm_resource_usage_t scratch_usage = {
+    .resource_id = TFM_RESOURCE_CRYPTO_SCRATCH,
+    .capacity = TFM_CRYPTO_IOVEC_BUFFER_SIZE,
+};
+#endif
+
+static psa_status_t tfm_crypto_open_scratch(
+                                  int32_t owner,
+                                  uint8_t *stack_buf,
+                                  struct tfm_crypto_scratch_region **region)
 {
-    scratch.owner = id;
+    struct tfm_crypto_scratch_region *new_region;
+
+    if (scratch.nr_regions >= TFM_CRYPTO_SCRATCH_MAX_REGIONS) {
+        return PSA_ERROR_INSUFFICIENT_MEMORY;
+    }
+
+    new_region = &scratch.region[scratch.nr_regions++];
+    new_region->base = scratch.alloc_index;
+    new_region->alloc_index = 0;
+    new_region->owner = owner;
+#if TFM_CRYPTO_IOVEC_STACK_SIZE > 0
+    new_region->stack_buf = stack_buf;
+    new_region->stack_index = 0;
+#else
+    (void)stack_buf;
+#endif
+
+    *region = new_region;
+
     return PSA_SUCCESS;
 }
 
 static psa_status_t tfm_crypto_get_scratch_owner(int32_t *id)
 {
-    *id = scratch.owner;
+    /* The last region opened belongs to the request being served */
+    if (scratch.nr_regions == 0) {
+        return PSA_ERROR_BAD_STATE;
+    }
+
+    *id = scratch.region[scratch.nr_regions - 1].owner;
     return PSA_SUCCESS;
 }
 
-static psa_status_t tfm_crypto_alloc_scratch(size_t requested_size, void **buf)
+static psa_status_t tfm_crypto_alloc_scratch(
+                                  struct tfm_crypto_scratch_region *region,
+                                  size_t requested_size, void **buf)
 {
+    /* Only the last region opened can grow */
+    if ((scratch.nr_regions == 0) ||
+        (region != &scratch.region[scratch.nr_regions - 1])) {
+        return PSA_ERROR_BAD_STATE;
+    }
+
     /* Ensure alloc_index remains aligned to the required iovec alignment */
     requested_size = ALIGN(requested_size, TFM_CRYPTO_IOVEC_ALIGNMENT);
 
+#if TFM_CRYPTO_IOVEC_STACK_SIZE > 0
+    /* The fixed size parameters, handles and digests of the short calls are
+     * kept on the stack, only the larger buffers take scratch space
+     */
+    if (requested_size <= (TFM_CRYPTO_IOVEC_STACK_SIZE - region->stack_index)) {
+        *buf = (void *)&region->stack_buf[region->stack_index];
+        region->stack_index += requested_size;
+        return PSA_SUCCESS;
+    }
+#endif
+
     if (requested_size > (sizeof(scratch.buf) - scratch.alloc_index)) {
         return PSA_ERROR_INSUFFICIENT_MEMORY;
     }
@@ -95,19 +212,124 @@ static psa_status_t tfm_crypto_alloc_scratch(size_t requested_size, void **buf)
 
     /* Increase the allocated size */
     scratch.alloc_index += requested_size;
+    region->alloc_index += requested_size;
+#ifdef TFM_RESOURCE_USAGE
+    tfm_resource_usage_set(&scratch_usage, scratch.alloc_index);
+#endif
 
     return PSA_SUCCESS;
 }
 
-static psa_status_t tfm_crypto_clear_scratch(void)
+static psa_status_t tfm_crypto_close_scratch(
+                                  struct tfm_crypto_scratch_region *region)
 {
-    scratch.alloc_index = 0;
-    scratch.owner = 0;
-    (void)tfm_memset(scratch.buf, 0, sizeof(scratch.buf));
+    if ((scratch.nr_regions == 0) ||
+        (region != &scratch.region[scratch.nr_regions - 1])) {
+        return PSA_ERROR_BAD_STATE;
+    }
+
+    /* Only wipe the bytes the request actually used */
+    (void)tfm_memset(&scratch.buf[region->base], 0, region->alloc_index);
+#if TFM_CRYPTO_IOVEC_STACK_SIZE > 0
+    (void)tfm_memset(region->stack_buf, 0, region->stack_index);
+    region->stack_buf = NULL;
+    region->stack_index = 0;
+#endif
+
+    scratch.alloc_index = region->base;
+    region->alloc_index = 0;
+    region->owner = 0;
+    scratch.nr_regions--;
+#ifdef TFM_RESOURCE_USAGE
+    tfm_resource_usage_set(&scratch_usage, scratch.alloc_index);
+#endif
 
     return PSA_SUCCESS;
 }
 
+/**
+ * \brief Checks if the input data of a request can be consumed in chunks
+ *
+ * The multipart update of a hash or MAC operation gives the same result
+ * whether its input comes in one or several calls, so the input of such a
+ * request does not need to fit in the internal scratch: it is read in chunks
+ * of \ref TFM_CRYPTO_STREAM_CHUNK_SIZE bytes, each of them being fed to the
+ * operation in turn, all within the same PSA call.
+ *
+ * \param[in] sfn_id ID of the requested function
+ *
+ * \return true if the request can be streamed, false otherwise
+ */
+static bool tfm_crypto_is_stream_sfn(uint32_t sfn_id)
+{
+    return (sfn_id == TFM_CRYPTO_HASH_UPDATE_SID) ||
+           (sfn_id == TFM_CRYPTO_MAC_UPDATE_SID);
+}
+
+/**
+ * \brief Checks if the output of a request can be produced in place of its
+ *        input in the internal scratch
+ *
+ * CTR, GCM, CCM and ChaCha20-Poly1305 process the data as a stream, so the
+ * output for a block of data is written at the same offset as the block it
+ * comes from, once the block has been read. Such a request only needs one
+ * buffer of the larger of the two sizes: the input is read into it, the
+ * operation overwrites it with the output, and the output is written back to
+ * the client from it.
+ *
+ * \param[in]  iov     IOV of the request
+ * \param[in]  sfn_id  ID of the requested function
+ * \param[out] in_idx  Index of the in_vec holding the input data
+ * \param[out] out_idx Index of the out_vec receiving the output data
+ *
+ * \return true if the output can overwrite the input, false otherwise
+ */
+static bool tfm_crypto_is_in_place_sfn(const struct tfm_crypto_pack_iovec *iov,
+                                       uint32_t sfn_id,
+                                       size_t *in_idx,
+                                       size_t *out_idx)
+{
+    psa_algorithm_t alg;
+    psa_cipher_operation_t *operation = NULL;
+    struct tfm_crypto_aead_operation_s *aead_operation = NULL;
+
+    switch (sfn_id) {
+    case TFM_CRYPTO_AEAD_ENCRYPT_SID:
+    case TFM_CRYPTO_AEAD_DECRYPT_SID:
+        alg = PSA_ALG_AEAD_WITH_DEFAULT_TAG_LENGTH(iov->alg);
+        *in_idx = 1;
+        *out_idx = 0;
+        return (alg == PSA_ALG_GCM) || (alg == PSA_ALG_CCM) ||
+               (alg == PSA_ALG_CHACHA20_POLY1305);
+    case TFM_CRYPTO_AEAD_UPDATE_SID:
+        /* GCM holds back the last partial block, only ChaCha20-Poly1305
+         * writes its output over its input as it goes
+         */
+        if (tfm_crypto_operation_lookup(TFM_CRYPTO_AEAD_OPERATION,
+                                        iov->op_handle,
+                                        (void **)&aead_operation) !=
+            PSA_SUCCESS) {
+            return false;
+        }
+        *in_idx = 1;
+        *out_idx = 1;
+        return PSA_ALG_AEAD_WITH_DEFAULT_TAG_LENGTH(aead_operation->alg) ==
+               PSA_ALG_CHACHA20_POLY1305;
+    case TFM_CRYPTO_CIPHER_UPDATE_SID:
+        /* The algorithm is only known by the operation context */
+        if (tfm_crypto_operation_lookup(TFM_CRYPTO_CIPHER_OPERATION,
+                                        iov->op_handle,
+                                        (void **)&operation) != PSA_SUCCESS) {
+            return false;
+        }
+        *in_idx = 1;
+        *out_idx = 1;
+        return operation->alg == PSA_ALG_CTR;
+    default:
+        return false;
+    }
+}
+
 static psa_status_t tfm_crypto_call_sfn(psa_msg_t *msg,
                                         struct tfm_crypto_pack_iovec *iov,
                                         const uint32_t sfn_id)
@@ -117,6 +339,16 @@ static psa_status_t tfm_crypto_call_sfn(psa_msg_t *msg,
     psa_invec in_vec[PSA_MAX_IOVEC] = { {0} };
     psa_outvec out_vec[PSA_MAX_IOVEC] = { {0} };
     void *alloc_buf_ptr = NULL;
+    struct tfm_crypto_scratch_region *region;
+    void *stream_buf = NULL;
+    size_t stream_size = 0;
+    void *in_place_buf = NULL;
+    size_t in_place_in = 0, in_place_out = 0, alloc_size;
+#if TFM_CRYPTO_IOVEC_STACK_SIZE > 0
+    uint32_t stack_buf[TFM_CRYPTO_IOVEC_STACK_SIZE / sizeof(uint32_t)];
+#else
+    uint32_t *stack_buf = NULL;
+#endif
 
     /* Check the number of in_vec filled */
     while ((in_len > 0) && (msg->in_size[in_len - 1] == 0)) {
@@ -131,14 +363,55 @@ static psa_status_t tfm_crypto_call_sfn(psa_msg_t *msg,
     in_vec[0].base = iov;
     in_vec[0].len = sizeof(struct tfm_crypto_pack_iovec);
 
+    /* Open a region of the internal scratch owned by the caller */
+    status = tfm_crypto_open_scratch(msg->client_id, (uint8_t *)stack_buf,
+                                     &region);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    /* The data of a streaming request is read chunk by chunk when calling */
+    if ((in_len == 2) && tfm_crypto_is_stream_sfn(sfn_id) &&
+        (msg->in_size[1] > TFM_CRYPTO_STREAM_CHUNK_SIZE)) {
+        status = tfm_crypto_alloc_scratch(region, TFM_CRYPTO_STREAM_CHUNK_SIZE,
+                                          &stream_buf);
+        if (status != PSA_SUCCESS) {
+            (void)tfm_crypto_close_scratch(region);
+            return status;
+        }
+        in_vec[1].base = stream_buf;
+        stream_size = msg->in_size[1];
+    }
+
+    /* Check the number of out_vec filled */
+    while ((out_len > 0) && (msg->out_size[out_len - 1] == 0)) {
+        out_len--;
+    }
+
+    /* The output of CTR, GCM, CCM and ChaCha20-Poly1305 requests overwrites
+     * their input
+     */
+    if ((stream_size != 0) ||
+        !tfm_crypto_is_in_place_sfn(iov, sfn_id, &in_place_in, &in_place_out) ||
+        (in_place_in >= in_len) || (in_place_out >= out_len)) {
+        in_place_in = 0;
+    }
+
     /* Alloc/read from the second element as the first is read when parsing */
-    for (i = 1; i < in_len; i++) {
+    for (i = 1; (stream_size == 0) && (i < in_len); i++) {
+        alloc_size = msg->in_size[i];
+        if ((i == in_place_in) && (msg->out_size[in_place_out] > alloc_size)) {
+            alloc_size = msg->out_size[in_place_out];
+        }
         /* Allocate necessary space in the internal scratch */
-        status = tfm_crypto_alloc_scratch(msg->in_size[i], &alloc_buf_ptr);
+        status = tfm_crypto_alloc_scratch(region, alloc_size, &alloc_buf_ptr);
         if (status != PSA_SUCCESS) {
-            (void)tfm_crypto_clear_scratch();
+            (void)tfm_crypto_close_scratch(region);
             return status;
         }
+        if (i == in_place_in) {
+            in_place_buf = alloc_buf_ptr;
+        }
         /* Read from the IPC framework inputs into the scratch */
         read_size = psa_read(msg->handle, i, alloc_buf_ptr, msg->in_size[i]);
         /* Populate the fields of the input to the secure function */
@@ -146,16 +419,17 @@ static psa_status_t tfm_crypto_call_sfn(psa_msg_t *msg,
         in_vec[i].len = msg->in_size[i];
     }
 
-    /* Check the number of out_vec filled */
-    while ((out_len > 0) && (msg->out_size[out_len - 1] == 0)) {
-        out_len--;
-    }
-
     for (i = 0; i < out_len; i++) {
+        if ((in_place_buf != NULL) && (i == in_place_out)) {
+            out_vec[i].base = in_place_buf;
+            out_vec[i].len = msg->out_size[i];
+            continue;
+        }
         /* Allocate necessary space for the output in the internal scratch */
-        status = tfm_crypto_alloc_scratch(msg->out_size[i], &alloc_buf_ptr);
+        status = tfm_crypto_alloc_scratch(region, msg->out_size[i],
+                                          &alloc_buf_ptr);
         if (status != PSA_SUCCESS) {
-            (void)tfm_crypto_clear_scratch();
+            (void)tfm_crypto_close_scratch(region);
             return status;
         }
         /* Populate the fields of the output to the secure function */
@@ -163,19 +437,37 @@ static psa_status_t tfm_crypto_call_sfn(psa_msg_t *msg,
         out_vec[i].len = msg->out_size[i];
     }
 
-    /* Set the owner of the data in the scratch */
-    (void)tfm_crypto_set_scratch_owner(msg->client_id);
+    /* Account the allocations of Mbed Crypto to the function being served */
+    tfm_crypto_engine_mem_set_sfn(sfn_id);
+
+    if (stream_size == 0) {
+        /* Call the uniform signature API */
+        status = sfid_func_table[sfn_id](in_vec, in_len, out_vec, out_len);
+    }
+
+    /* Feed the operation with each chunk of a streaming request in turn */
+    while ((stream_size > 0) && (status == PSA_SUCCESS)) {
+        read_size = psa_read(msg->handle, 1, stream_buf,
+                             TFM_CRYPTO_STREAM_CHUNK_SIZE);
+        if (read_size == 0) {
+            status = PSA_ERROR_GENERIC_ERROR;
+            break;
+        }
+        in_vec[1].len = read_size;
+        stream_size -= read_size;
+
+        status = sfid_func_table[sfn_id](in_vec, in_len, out_vec, out_len);
+    }
 
-    /* Call the uniform signature API */
-    status = sfid_func_table[sfn_id](in_vec, in_len, out_vec, out_len);
+    tfm_crypto_engine_mem_set_sfn(TFM_CRYPTO_SID_INVALID);
 
     /* Write into the IPC framework outputs from the scratch */
     for (i = 0; i < out_len; i++) {
         psa_write(msg->handle, i, out_vec[i].base, out_vec[i].len);
     }
 
-    /* Clear the allocated internal scratch before returning */
-    if (tfm_crypto_clear_scratch() != PSA_SUCCESS) {
+    /* Clear the region of the internal scratch before returning */
+    if (tfm_crypto_close_scratch(region) != PSA_SUCCESS) {
         return PSA_ERROR_GENERIC_ERROR;
     }
 
@@ -208,48 +500,98 @@ static psa_status_t tfm_crypto_parse_msg(psa_msg_t *msg,
     return PSA_SUCCESS;
 }
 
-static void tfm_crypto_ipc_handler(void)
+static void tfm_crypto_serve_msg(psa_signal_t signal)
 {
-    psa_signal_t signals = 0;
     psa_msg_t msg;
     psa_status_t status = PSA_SUCCESS;
     uint32_t sfn_id = TFM_CRYPTO_SID_INVALID;
     struct tfm_crypto_pack_iovec iov = {0};
 
+    /* Extract the message */
+    if (psa_get(signal, &msg) != PSA_SUCCESS) {
+        /* FIXME: Should be replaced by TF-M error handling */
+        while (1) {
+            ;
+        }
+    }
+
+    /* Process the message type */
+    switch (msg.type) {
+    case PSA_IPC_CONNECT:
+    case PSA_IPC_DISCONNECT:
+        psa_reply(msg.handle, PSA_SUCCESS);
+        break;
+    case PSA_IPC_CALL:
+        /* Parse the message */
+        status = tfm_crypto_parse_msg(&msg, &iov, &sfn_id);
+        /* Call the dispatcher based on the SID passed as type */
+        if (sfn_id != TFM_CRYPTO_SID_INVALID) {
+            status = tfm_crypto_call_sfn(&msg, &iov, sfn_id);
+        } else {
+            status = PSA_ERROR_GENERIC_ERROR;
+        }
+        psa_reply(msg.handle, status);
+        /* The client is released, top up the random pool in the meantime */
+        (void)tfm_crypto_refill_random_pool();
+        break;
+    default:
+        /* FIXME: Should be replaced by TF-M error handling */
+        while (1) {
+            ;
+        }
+    }
+}
+
+static void tfm_crypto_ipc_handler(void)
+{
+    psa_signal_t signals = 0;
+    uint32_t asym_deferred = 0;
+#if defined(CRYPTO_HW_ACCELERATOR) && defined(TFM_CRYPTO_HW_IDLE_POWER_DOWN)
+    bool hw_released = false;
+#endif
+
     while (1) {
+#ifdef CRYPTO_HW_ACCELERATOR
+        /* Top up the entropy pool while there is no request to serve, so that
+         * a DRBG reseed does not wait for the TRNG in the middle of a request.
+         */
+        if (psa_wait(PSA_WAIT_ANY, PSA_POLL) == 0) {
+            (void)crypto_hw_accelerator_entropy_refill();
+#ifdef TFM_CRYPTO_HW_IDLE_POWER_DOWN
+            /* The accelerator is released only when the partition goes idle,
+             * so that it stays powered through a burst of requests.
+             */
+            hw_released = (crypto_hw_accelerator_power_down() == 0);
+#endif
+        }
+#endif /* CRYPTO_HW_ACCELERATOR */
         signals = psa_wait(PSA_WAIT_ANY, PSA_BLOCK);
-        if (signals & TFM_CRYPTO_SIGNAL) {
-            /* Extract the message */
-            if (psa_get(TFM_CRYPTO_SIGNAL, &msg) != PSA_SUCCESS) {
+#if defined(CRYPTO_HW_ACCELERATOR) && defined(TFM_CRYPTO_HW_IDLE_POWER_DOWN)
+        if (hw_released) {
+            if (crypto_hw_accelerator_power_up() != 0) {
                 /* FIXME: Should be replaced by TF-M error handling */
                 while (1) {
                     ;
                 }
             }
-
-            /* Process the message type */
-            switch (msg.type) {
-            case PSA_IPC_CONNECT:
-            case PSA_IPC_DISCONNECT:
-                psa_reply(msg.handle, PSA_SUCCESS);
-                break;
-            case PSA_IPC_CALL:
-                /* Parse the message */
-                status = tfm_crypto_parse_msg(&msg, &iov, &sfn_id);
-                /* Call the dispatcher based on the SID passed as type */
-                if (sfn_id != TFM_CRYPTO_SID_INVALID) {
-                    status = tfm_crypto_call_sfn(&msg, &iov, sfn_id);
-                } else {
-                    status = PSA_ERROR_GENERIC_ERROR;
-                }
-                psa_reply(msg.handle, status);
-                break;
-            default:
-                /* FIXME: Should be replaced by TF-M error handling */
-                while (1) {
-                    ;
-                }
+            hw_released = false;
+        }
+#endif
+        /* A public key operation keeps the partition busy for much longer
+         * than any other request, so the pending short requests are served
+         * first. After TFM_CRYPTO_ASYM_MAX_DEFER of them, the public key
+         * operation goes ahead so that it is not starved.
+         */
+        if ((signals & TFM_CRYPTO_ASYM_SIGNAL) &&
+            (!(signals & TFM_CRYPTO_SIGNAL) ||
+             (asym_deferred >= TFM_CRYPTO_ASYM_MAX_DEFER))) {
+            asym_deferred = 0;
+            tfm_crypto_serve_msg(TFM_CRYPTO_ASYM_SIGNAL);
+        } else if (signals & TFM_CRYPTO_SIGNAL) {
+            if (signals & TFM_CRYPTO_ASYM_SIGNAL) {
+                asym_deferred++;
             }
+            tfm_crypto_serve_msg(TFM_CRYPTO_SIGNAL);
         } else {
             /* FIXME: Should be replaced by TF-M error handling */
             while (1) {
@@ -279,12 +621,17 @@ static uint8_t mbedtls_mem_buf[TFM_CRYPTO_ENGINE_BUF_SIZE] = {0};
 
 static psa_status_t tfm_crypto_engine_init(void)
 {
+    psa_status_t status;
+
     /* Initialise the Mbed Crypto memory allocator to use static
      * memory allocation from the provided buffer instead of using
      * the heap
      */
-    mbedtls_memory_buffer_alloc_init(mbedtls_mem_buf,
-                                     TFM_CRYPTO_ENGINE_BUF_SIZE);
+    status = tfm_crypto_init_engine_mem(mbedtls_mem_buf,
+                                        TFM_CRYPTO_ENGINE_BUF_SIZE);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
 
     /* Initialise the crypto accelerator if one is enabled */
 #ifdef CRYPTO_HW_ACCELERATOR
@@ -296,13 +643,35 @@ static psa_status_t tfm_crypto_engine_init(void)
     /* Previous function does not return any value, so just call the
      * initialisation function of the Mbed Crypto layer
      */
-    return psa_crypto_init();
+    status = psa_crypto_init();
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+#ifdef CRYPTO_HW_ACCELERATOR
+    /* The initial seeding of the DRBG has drained the entropy pool, fill it
+     * again for the next reseed.
+     */
+    if (crypto_hw_accelerator_entropy_refill() != 0) {
+        return PSA_ERROR_HARDWARE_FAILURE;
+    }
+#endif /* CRYPTO_HW_ACCELERATOR */
+
+    return PSA_SUCCESS;
 }
 
 static psa_status_t tfm_crypto_module_init(void)
 {
+    psa_status_t status;
+
     /* Init the Alloc module */
-    return tfm_crypto_init_alloc();
+    status = tfm_crypto_init_alloc();
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    /* Init the Key module */
+    return tfm_crypto_init_key();
 }
 
 psa_status_t tfm_crypto_get_caller_id(int32_t *id)
@@ -338,6 +707,10 @@ psa_status_t tfm_crypto_init(void)
     }
 
 #ifdef TFM_PSA_API
+#ifdef TFM_RESOURCE_USAGE
+    (void)tfm_core_resource_usage_register(&scratch_usage);
+#endif
+
     /* Should not return in normal operations */
     tfm_crypto_ipc_handler();
 #endif
@@ -5,6 +5,7 @@
  *
  */
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -17,20 +18,218 @@
 
 #include "tfm_crypto_api.h"
 #include "tfm_crypto_defs.h"
-#include <stdbool.h>
+#include "tfm_memory_utils.h"
+
+#ifdef TFM_RESOURCE_USAGE
+#include "secure_fw/include/tfm_spm_services_api.h"
+#endif
 
 #ifndef TFM_CRYPTO_MAX_KEY_HANDLES
 #define TFM_CRYPTO_MAX_KEY_HANDLES (16)
 #endif
+
+/**
+ * \brief A key handle given to a client holds the generation of the local
+ *        storage entry in its upper bits, and the index of the entry plus one
+ *        in its lower bits. The generation changes each time the entry is
+ *        released, so a stale handle does not match the key now stored.
+ */
+#define TFM_CRYPTO_KEY_HANDLE_INDEX_BITS (8)
+#define TFM_CRYPTO_KEY_HANDLE_INDEX_MASK \
+    ((1U << TFM_CRYPTO_KEY_HANDLE_INDEX_BITS) - 1)
+#define TFM_CRYPTO_KEY_HANDLE_GEN_MASK \
+    ((1U << ((sizeof(psa_key_handle_t) * 8) - \
+             TFM_CRYPTO_KEY_HANDLE_INDEX_BITS)) - 1)
+
+#define TFM_CRYPTO_KEY_HANDLE(gen, index) \
+    ((psa_key_handle_t)(((gen) << TFM_CRYPTO_KEY_HANDLE_INDEX_BITS) | \
+                        ((index) + 1)))
+
+#if (TFM_CRYPTO_MAX_KEY_HANDLES < 1) || \
+    (TFM_CRYPTO_MAX_KEY_HANDLES >= TFM_CRYPTO_KEY_HANDLE_INDEX_MASK)
+#error "TFM_CRYPTO_MAX_KEY_HANDLES does not fit in a key handle!"
+#endif
+
+/**
+ * \brief Number of persistent keys which are kept loaded once all the handles
+ *        of the clients to them are closed, so that opening them again does
+ *        not read them back from storage. Set to 0 to disable the cache.
+ */
+#ifndef TFM_CRYPTO_PERSISTENT_KEY_CACHE_SIZE
+#define TFM_CRYPTO_PERSISTENT_KEY_CACHE_SIZE (4)
+#endif
+
+/**
+ * \brief Value of next_free for the last free entry, or for an entry in use
+ */
+#define TFM_CRYPTO_NO_NEXT_FREE (UINT16_MAX)
+
 struct tfm_crypto_handle_owner_s {
     int32_t owner;           /*!< Owner of the allocated handle */
     psa_key_handle_t handle; /*!< Allocated handle */
     uint8_t in_use;          /*!< Flag to indicate if this in use */
+    uint8_t generation;      /*!< Generation of the entry */
+    uint16_t next_free;      /*!< Index of the next free entry */
 };
 
 #ifndef TFM_CRYPTO_KEY_MODULE_DISABLED
 static struct tfm_crypto_handle_owner_s
                                  handle_owner[TFM_CRYPTO_MAX_KEY_HANDLES] = {0};
+
+/**
+ * \brief Index of the first free entry of handle_owner
+ */
+static uint16_t handle_owner_free_head = TFM_CRYPTO_NO_NEXT_FREE;
+
+#ifdef TFM_RESOURCE_USAGE
+/**
+ * \brief Usage of handle_owner, reported by SPM
+ */
+static struct tfm_resource_usage_t handle_owner_usage = {
+    .resource_id = TFM_RESOURCE_CRYPTO_KEY_HANDLES,
+    .capacity = TFM_CRYPTO_MAX_KEY_HANDLES,
+};
+#endif
+
+/*
+ * \brief Function used to release the local storage of a key handle
+ *
+ * \param[in] index Index of the local storage entry to release
+ *
+ * \return None
+ *
+ */
+static void tfm_crypto_release_key_storage(uint32_t index)
+{
+    handle_owner[index].owner = 0;
+    handle_owner[index].handle = 0;
+    handle_owner[index].in_use = TFM_CRYPTO_NOT_IN_USE;
+    handle_owner[index].generation = (handle_owner[index].generation + 1) &
+                                     TFM_CRYPTO_KEY_HANDLE_GEN_MASK;
+
+    /* Put the entry back at the head of the free list */
+    handle_owner[index].next_free = handle_owner_free_head;
+    handle_owner_free_head = (uint16_t)index;
+
+#ifdef TFM_RESOURCE_USAGE
+    tfm_resource_usage_set(&handle_owner_usage, handle_owner_usage.used - 1);
+#endif
+}
+
+#if TFM_CRYPTO_PERSISTENT_KEY_CACHE_SIZE > 0
+struct tfm_crypto_persistent_key_s {
+    psa_key_id_t id;         /*!< Identifier and owner of the key */
+    psa_key_handle_t handle; /*!< Mbed Crypto handle of the loaded key, 0 if
+                              *   the entry is unused
+                              */
+    uint32_t last_use;       /*!< Value of the use counter when the key was
+                              *   last opened
+                              */
+};
+
+static struct tfm_crypto_persistent_key_s
+               persistent_key_cache[TFM_CRYPTO_PERSISTENT_KEY_CACHE_SIZE] = {0};
+
+/**
+ * \brief Counter of the opens of cached keys, to find the least recently used
+ */
+static uint32_t persistent_key_use_count;
+
+static bool tfm_crypto_key_has_handles(psa_key_handle_t key)
+{
+    uint32_t i;
+
+    for (i = 0; i < TFM_CRYPTO_MAX_KEY_HANDLES; i++) {
+        if (handle_owner[i].in_use && (handle_owner[i].handle == key)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static struct tfm_crypto_persistent_key_s *tfm_crypto_persistent_key_find(
+                                                         const psa_key_id_t *id,
+                                                         psa_key_handle_t key)
+{
+    uint32_t i;
+
+    for (i = 0; i < TFM_CRYPTO_PERSISTENT_KEY_CACHE_SIZE; i++) {
+        if (persistent_key_cache[i].handle == 0) {
+            continue;
+        }
+
+        if ((id != NULL) &&
+            (persistent_key_cache[i].id.key_id == id->key_id) &&
+            (persistent_key_cache[i].id.owner == id->owner)) {
+            return &persistent_key_cache[i];
+        }
+
+        if ((id == NULL) && (persistent_key_cache[i].handle == key)) {
+            return &persistent_key_cache[i];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * \brief Closes the least recently used cached key to which no client holds
+ *        a handle. Persistent keys cannot be modified, so the key material is
+ *        simply dropped and read again from storage at the next open.
+ *
+ * \return true if a key was closed, false if all the cached keys are in use
+ */
+static bool tfm_crypto_persistent_key_evict(void)
+{
+    struct tfm_crypto_persistent_key_s *lru = NULL;
+    uint32_t i;
+
+    for (i = 0; i < TFM_CRYPTO_PERSISTENT_KEY_CACHE_SIZE; i++) {
+        if ((persistent_key_cache[i].handle == 0) ||
+            tfm_crypto_key_has_handles(persistent_key_cache[i].handle)) {
+            continue;
+        }
+
+        if ((lru == NULL) || ((int32_t)(persistent_key_cache[i].last_use -
+                                        lru->last_use) < 0)) {
+            lru = &persistent_key_cache[i];
+        }
+    }
+
+    if (lru == NULL) {
+        return false;
+    }
+
+    (void)psa_close_key(lru->handle);
+    (void)tfm_memset(lru, 0, sizeof(*lru));
+
+    return true;
+}
+
+/**
+ * \brief Records a loaded persistent key in the cache, evicting the least
+ *        recently used key if the cache is full. The key is left out of the
+ *        cache if all the cached keys are in use.
+ */
+static void tfm_crypto_persistent_key_insert(const psa_key_id_t *id,
+                                             psa_key_handle_t key)
+{
+    uint32_t i;
+    bool evicted = false;
+
+    do {
+        for (i = 0; i < TFM_CRYPTO_PERSISTENT_KEY_CACHE_SIZE; i++) {
+            if (persistent_key_cache[i].handle == 0) {
+                persistent_key_cache[i].id = *id;
+                persistent_key_cache[i].handle = key;
+                persistent_key_cache[i].last_use = ++persistent_key_use_count;
+                return;
+            }
+        }
+    } while (!evicted && (evicted = tfm_crypto_persistent_key_evict()));
+}
+#endif /* TFM_CRYPTO_PERSISTENT_KEY_CACHE_SIZE > 0 */
 #endif
 
 /*!
@@ -91,14 +290,35 @@ psa_status_t tfm_crypto_key_attributes_to_app(
     return PSA_SUCCESS;
 }
 
-psa_status_t tfm_crypto_check_handle_owner(psa_key_handle_t handle,
+psa_status_t tfm_crypto_init_key(void)
+{
+#ifndef TFM_CRYPTO_KEY_MODULE_DISABLED
+    uint32_t i;
+
+    /* Chain all the local storage entries in the free list */
+    for (i = 0; i < TFM_CRYPTO_MAX_KEY_HANDLES; i++) {
+        handle_owner[i].next_free = (i + 1 < TFM_CRYPTO_MAX_KEY_HANDLES) ?
+                                    (uint16_t)(i + 1) : TFM_CRYPTO_NO_NEXT_FREE;
+    }
+    handle_owner_free_head = 0;
+
+#ifdef TFM_RESOURCE_USAGE
+    (void)tfm_core_resource_usage_register(&handle_owner_usage);
+#endif
+#endif /* TFM_CRYPTO_KEY_MODULE_DISABLED */
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t tfm_crypto_check_handle_owner(psa_key_handle_t *handle,
                                            uint32_t *index)
 {
 #ifdef TFM_CRYPTO_KEY_MODULE_DISABLED
     return PSA_ERROR_NOT_SUPPORTED;
 #else
     int32_t partition_id = 0;
-    uint32_t i = 0;
+    uint32_t i = (*handle & TFM_CRYPTO_KEY_HANDLE_INDEX_MASK);
+    uint32_t gen = (*handle >> TFM_CRYPTO_KEY_HANDLE_INDEX_BITS);
     psa_status_t status;
 
     status = tfm_crypto_get_caller_id(&partition_id);
@@ -106,20 +326,26 @@ psa_status_t tfm_crypto_check_handle_owner(psa_key_handle_t handle,
         return status;
     }
 
-    for (i = 0; i < TFM_CRYPTO_MAX_KEY_HANDLES; i++) {
-        if (handle_owner[i].in_use && handle_owner[i].handle == handle) {
-            if (handle_owner[i].owner == partition_id) {
-                if (index != NULL) {
-                    *index = i;
-                }
-                return PSA_SUCCESS;
-            } else {
-                return PSA_ERROR_NOT_PERMITTED;
-            }
-        }
+    /* The handle points straight at its local storage entry */
+    if ((i == 0) || (i > TFM_CRYPTO_MAX_KEY_HANDLES)) {
+        return PSA_ERROR_INVALID_HANDLE;
+    }
+    i--;
+
+    if (!handle_owner[i].in_use || (handle_owner[i].generation != gen)) {
+        return PSA_ERROR_INVALID_HANDLE;
     }
 
-    return PSA_ERROR_INVALID_HANDLE;
+    if (handle_owner[i].owner != partition_id) {
+        return PSA_ERROR_NOT_PERMITTED;
+    }
+
+    if (index != NULL) {
+        *index = i;
+    }
+    *handle = handle_owner[i].handle;
+
+    return PSA_SUCCESS;
 #endif /* TFM_CRYPTO_KEY_MODULE_DISABLED */
 }
 
@@ -128,21 +354,18 @@ psa_status_t tfm_crypto_check_key_storage(uint32_t *index)
 #ifdef TFM_CRYPTO_KEY_MODULE_DISABLED
     return PSA_ERROR_NOT_SUPPORTED;
 #else
-    uint32_t i;
-
-    for (i = 0; i < TFM_CRYPTO_MAX_KEY_HANDLES; i++) {
-        if (handle_owner[i].in_use == TFM_CRYPTO_NOT_IN_USE) {
-            *index = i;
-            return PSA_SUCCESS;
-        }
+    if (handle_owner_free_head == TFM_CRYPTO_NO_NEXT_FREE) {
+        return PSA_ERROR_INSUFFICIENT_MEMORY;
     }
 
-    return PSA_ERROR_INSUFFICIENT_MEMORY;
+    *index = handle_owner_free_head;
+
+    return PSA_SUCCESS;
 #endif /* TFM_CRYPTO_KEY_MODULE_DISABLED */
 }
 
 psa_status_t tfm_crypto_set_key_storage(uint32_t index,
-                                        psa_key_handle_t key_handle)
+                                        psa_key_handle_t *key_handle)
 {
 #ifdef TFM_CRYPTO_KEY_MODULE_DISABLED
     return PSA_ERROR_NOT_SUPPORTED;
@@ -150,19 +373,47 @@ psa_status_t tfm_crypto_set_key_storage(uint32_t index,
     psa_status_t status;
     int32_t partition_id;
 
+    /* The index must come from tfm_crypto_check_key_storage() */
+    if (index != handle_owner_free_head) {
+        return PSA_ERROR_BAD_STATE;
+    }
+
     status = tfm_crypto_get_caller_id(&partition_id);
     if (status != PSA_SUCCESS) {
         return status;
     }
 
+    handle_owner_free_head = handle_owner[index].next_free;
+    handle_owner[index].next_free = TFM_CRYPTO_NO_NEXT_FREE;
     handle_owner[index].owner = partition_id;
-    handle_owner[index].handle = key_handle;
+    handle_owner[index].handle = *key_handle;
     handle_owner[index].in_use = TFM_CRYPTO_IN_USE;
 
+#ifdef TFM_RESOURCE_USAGE
+    tfm_resource_usage_set(&handle_owner_usage, handle_owner_usage.used + 1);
+#endif
+
+    /* Give the client a handle to the local storage entry */
+    *key_handle = TFM_CRYPTO_KEY_HANDLE(handle_owner[index].generation, index);
+
     return PSA_SUCCESS;
 #endif /* TFM_CRYPTO_KEY_MODULE_DISABLED */
 }
 
+void tfm_crypto_release_key_handles(psa_key_handle_t key_handle)
+{
+#ifndef TFM_CRYPTO_KEY_MODULE_DISABLED
+    uint32_t i;
+
+    for (i = 0; i < TFM_CRYPTO_MAX_KEY_HANDLES; i++) {
+        if (handle_owner[i].in_use &&
+            (handle_owner[i].handle == key_handle)) {
+            tfm_crypto_release_key_storage(i);
+        }
+    }
+#endif /* TFM_CRYPTO_KEY_MODULE_DISABLED */
+}
+
 psa_status_t tfm_crypto_set_key_domain_parameters(psa_invec in_vec[],
                                    size_t in_len,
                                    psa_outvec out_vec[],
@@ -215,17 +466,10 @@ psa_status_t tfm_crypto_import_key(psa_invec in_vec[],
     psa_key_attributes_t key_attributes = PSA_KEY_ATTRIBUTES_INIT;
     uint32_t i = 0;
     int32_t partition_id = 0;
-    bool empty_found = false;
-
-    for (i = 0; i < TFM_CRYPTO_MAX_KEY_HANDLES; i++) {
-        if (handle_owner[i].in_use == TFM_CRYPTO_NOT_IN_USE) {
-            empty_found = true;
-            break;
-        }
-    }
 
-    if (!empty_found) {
-        return PSA_ERROR_INSUFFICIENT_MEMORY;
+    status = tfm_crypto_check_key_storage(&i);
+    if (status != PSA_SUCCESS) {
+        return status;
     }
 
     status = tfm_crypto_get_caller_id(&partition_id);
@@ -240,11 +484,24 @@ psa_status_t tfm_crypto_import_key(psa_invec in_vec[],
     }
 
     status = psa_import_key(&key_attributes, data, data_length, key_handle);
+#if TFM_CRYPTO_PERSISTENT_KEY_CACHE_SIZE > 0
+    /* Make room in the key slots of Mbed Crypto by closing a cached key */
+    if ((status == PSA_ERROR_INSUFFICIENT_MEMORY) &&
+        tfm_crypto_persistent_key_evict()) {
+        status = psa_import_key(&key_attributes, data, data_length,
+                                key_handle);
+    }
+
+    if ((status == PSA_SUCCESS) &&
+        (psa_get_key_lifetime(&key_attributes) != PSA_KEY_LIFETIME_VOLATILE)) {
+        psa_key_id_t id = psa_get_key_id(&key_attributes);
+
+        tfm_crypto_persistent_key_insert(&id, *key_handle);
+    }
+#endif
 
     if (status == PSA_SUCCESS) {
-        handle_owner[i].owner = partition_id;
-        handle_owner[i].handle = *key_handle;
-        handle_owner[i].in_use = TFM_CRYPTO_IN_USE;
+        status = tfm_crypto_set_key_storage(i, key_handle);
     }
 
     return status;
@@ -275,15 +532,13 @@ psa_status_t tfm_crypto_open_key(psa_invec in_vec[],
     psa_key_id_t id;
     int32_t partition_id;
     uint32_t i;
+#if TFM_CRYPTO_PERSISTENT_KEY_CACHE_SIZE > 0
+    struct tfm_crypto_persistent_key_s *cached;
+#endif
 
-    for (i = 0; i < TFM_CRYPTO_MAX_KEY_HANDLES; i++) {
-        if (handle_owner[i].in_use == TFM_CRYPTO_NOT_IN_USE) {
-            break;
-        }
-    }
-
-    if (i == TFM_CRYPTO_MAX_KEY_HANDLES) {
-        return PSA_ERROR_INSUFFICIENT_MEMORY;
+    status = tfm_crypto_check_key_storage(&i);
+    if (status != PSA_SUCCESS) {
+        return status;
     }
 
     status = tfm_crypto_get_caller_id(&partition_id);
@@ -294,12 +549,30 @@ psa_status_t tfm_crypto_open_key(psa_invec in_vec[],
     /* Use the app key id as the key_id and its partition id as the owner */
     id = (psa_key_id_t){ .key_id = app_id, .owner = partition_id };
 
+#if TFM_CRYPTO_PERSISTENT_KEY_CACHE_SIZE > 0
+    /* The key is only read from storage if it is not loaded already */
+    cached = tfm_crypto_persistent_key_find(&id, 0);
+    if (cached != NULL) {
+        cached->last_use = ++persistent_key_use_count;
+        *key_handle = cached->handle;
+        return tfm_crypto_set_key_storage(i, key_handle);
+    }
+
+    status = psa_open_key(id, key_handle);
+    if ((status == PSA_ERROR_INSUFFICIENT_MEMORY) &&
+        tfm_crypto_persistent_key_evict()) {
+        status = psa_open_key(id, key_handle);
+    }
+
+    if (status == PSA_SUCCESS) {
+        tfm_crypto_persistent_key_insert(&id, *key_handle);
+    }
+#else
     status = psa_open_key(id, key_handle);
+#endif
 
     if (status == PSA_SUCCESS) {
-        handle_owner[i].owner = partition_id;
-        handle_owner[i].handle = *key_handle;
-        handle_owner[i].in_use = TFM_CRYPTO_IN_USE;
+        status = tfm_crypto_set_key_storage(i, key_handle);
     }
 
     return status;
@@ -327,18 +600,32 @@ psa_status_t tfm_crypto_close_key(psa_invec in_vec[],
 
     psa_key_handle_t key = iov->key_handle;
     uint32_t index;
-    psa_status_t status = tfm_crypto_check_handle_owner(key, &index);
+    psa_status_t status = tfm_crypto_check_handle_owner(&key, &index);
 
     if (status != PSA_SUCCESS) {
         return status;
     }
 
+    /* A key held by the cache of HUK derived keys stays loaded, only the
+     * handle of the client is released.
+     */
+    if (tfm_crypto_huk_key_cache_holds(key)) {
+        tfm_crypto_release_key_storage(index);
+        return PSA_SUCCESS;
+    }
+
+#if TFM_CRYPTO_PERSISTENT_KEY_CACHE_SIZE > 0
+    /* A cached persistent key stays loaded until it is evicted */
+    if (tfm_crypto_persistent_key_find(NULL, key) != NULL) {
+        tfm_crypto_release_key_storage(index);
+        return PSA_SUCCESS;
+    }
+#endif
+
     status = psa_close_key(key);
 
     if (status == PSA_SUCCESS) {
-        handle_owner[index].owner = 0;
-        handle_owner[index].handle = 0;
-        handle_owner[index].in_use = TFM_CRYPTO_NOT_IN_USE;
+        tfm_crypto_release_key_storage(index);
     }
 
     return status;
@@ -366,18 +653,40 @@ psa_status_t tfm_crypto_destroy_key(psa_invec in_vec[],
 
     psa_key_handle_t key = iov->key_handle;
     uint32_t index;
-    psa_status_t status = tfm_crypto_check_handle_owner(key, &index);
+    psa_status_t status = tfm_crypto_check_handle_owner(&key, &index);
 
     if (status != PSA_SUCCESS) {
         return status;
     }
 
+    /* A key held by the cache of HUK derived keys stays loaded, only the
+     * handle of the client is released.
+     */
+    if (tfm_crypto_huk_key_cache_holds(key)) {
+        tfm_crypto_release_key_storage(index);
+        return PSA_SUCCESS;
+    }
+
+#if TFM_CRYPTO_PERSISTENT_KEY_CACHE_SIZE > 0
+    /* Other clients may hold a handle to a cached persistent key, the
+     * handles of all of them become stale.
+     */
+    struct tfm_crypto_persistent_key_s *cached =
+                                   tfm_crypto_persistent_key_find(NULL, key);
+    if (cached != NULL) {
+        status = psa_destroy_key(key);
+        if (status == PSA_SUCCESS) {
+            (void)tfm_memset(cached, 0, sizeof(*cached));
+            tfm_crypto_release_key_handles(key);
+        }
+        return status;
+    }
+#endif
+
     status = psa_destroy_key(key);
 
     if (status == PSA_SUCCESS) {
-        handle_owner[index].owner = 0;
-        handle_owner[index].handle = 0;
-        handle_owner[index].in_use = TFM_CRYPTO_NOT_IN_USE;
+        tfm_crypto_release_key_storage(index);
     }
 
     return status;
@@ -407,7 +716,7 @@ psa_status_t tfm_crypto_get_key_attributes(psa_invec in_vec[],
     psa_status_t status;
     psa_key_attributes_t key_attributes = PSA_KEY_ATTRIBUTES_INIT;
 
-    status = tfm_crypto_check_handle_owner(key, NULL);
+    status = tfm_crypto_check_handle_owner(&key, NULL);
     if (status != PSA_SUCCESS) {
         return status;
     }
@@ -482,6 +791,12 @@ psa_status_t tfm_crypto_export_key(psa_invec in_vec[],
     psa_key_handle_t key = iov->key_handle;
     uint8_t *data = out_vec[0].base;
     size_t data_size = out_vec[0].len;
+    psa_status_t status;
+
+    status = tfm_crypto_check_handle_owner(&key, NULL);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
 
     return psa_export_key(key, data, data_size, &(out_vec[0].len));
 #endif /* TFM_CRYPTO_KEY_MODULE_DISABLED */
@@ -507,6 +822,12 @@ psa_status_t tfm_crypto_export_public_key(psa_invec in_vec[],
     psa_key_handle_t key = iov->key_handle;
     uint8_t *data = out_vec[0].base;
     size_t data_size = out_vec[0].len;
+    psa_status_t status;
+
+    status = tfm_crypto_check_handle_owner(&key, NULL);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
 
     return psa_export_public_key(key, data, data_size, &(out_vec[0].len));
 #endif /* TFM_CRYPTO_KEY_MODULE_DISABLED */
@@ -539,17 +860,10 @@ psa_status_t tfm_crypto_copy_key(psa_invec in_vec[],
     psa_key_attributes_t key_attributes = PSA_KEY_ATTRIBUTES_INIT;
     uint32_t i = 0;
     int32_t partition_id = 0;
-    bool empty_found = false;
-
-    for (i = 0; i < TFM_CRYPTO_MAX_KEY_HANDLES; i++) {
-        if (handle_owner[i].in_use == TFM_CRYPTO_NOT_IN_USE) {
-            empty_found = true;
-            break;
-        }
-    }
 
-    if (!empty_found) {
-        return PSA_ERROR_INSUFFICIENT_MEMORY;
+    status = tfm_crypto_check_key_storage(&i);
+    if (status != PSA_SUCCESS) {
+        return status;
     }
 
     status = tfm_crypto_get_caller_id(&partition_id);
@@ -563,12 +877,15 @@ psa_status_t tfm_crypto_copy_key(psa_invec in_vec[],
         return status;
     }
 
+    status = tfm_crypto_check_handle_owner(&source_handle, NULL);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
     status = psa_copy_key(source_handle, &key_attributes, target_handle);
 
     if (status == PSA_SUCCESS) {
-        handle_owner[i].owner = partition_id;
-        handle_owner[i].handle = *target_handle;
-        handle_owner[i].in_use = TFM_CRYPTO_IN_USE;
+        status = tfm_crypto_set_key_storage(i, target_handle);
     }
 
     return status;
@@ -599,17 +916,10 @@ psa_status_t tfm_crypto_generate_key(psa_invec in_vec[],
     psa_key_attributes_t key_attributes = PSA_KEY_ATTRIBUTES_INIT;
     uint32_t i = 0;
     int32_t partition_id = 0;
-    bool empty_found = false;
 
-    for (i = 0; i < TFM_CRYPTO_MAX_KEY_HANDLES; i++) {
-        if (handle_owner[i].in_use == TFM_CRYPTO_NOT_IN_USE) {
-            empty_found = true;
-            break;
-        }
-    }
-
-    if (!empty_found) {
-        return PSA_ERROR_INSUFFICIENT_MEMORY;
+    status = tfm_crypto_check_key_storage(&i);
+    if (status != PSA_SUCCESS) {
+        return status;
     }
 
     status = tfm_crypto_get_caller_id(&partition_id);
@@ -626,9 +936,7 @@ psa_status_t tfm_crypto_generate_key(psa_invec in_vec[],
     status = psa_generate_key(&key_attributes, key_handle);
 
     if (status == PSA_SUCCESS) {
-        handle_owner[i].owner = partition_id;
-        handle_owner[i].handle = *key_handle;
-        handle_owner[i].in_use = TFM_CRYPTO_IN_USE;
+        status = tfm_crypto_set_key_storage(i, key_handle);
     }
 
     return status;
@@ -23,11 +23,157 @@
 #include "tfm_memory_utils.h"
 
 #include "platform/include/tfm_plat_crypto_keys.h"
+#include "platform/include/tfm_attest_hal.h"
 
 #ifdef TFM_PARTITION_TEST_SST
 #include "psa_manifest/pid.h"
 #endif /* TFM_PARTITION_TEST_SST */
 
+/**
+ * \brief Number of keys derived from the HUK which are kept loaded, so that a
+ *        partition deriving the same key again gets it without a new
+ *        derivation. Set to 0 to disable the cache.
+ */
+#ifndef TFM_CRYPTO_HUK_KEY_CACHE_SIZE
+#define TFM_CRYPTO_HUK_KEY_CACHE_SIZE (2)
+#endif
+
+/**
+ * \brief Longest label of a cached key, including the partition ID
+ *        which prefixes the label supplied by the client
+ */
+#ifndef TFM_CRYPTO_HUK_KEY_CACHE_LABEL_MAX
+#define TFM_CRYPTO_HUK_KEY_CACHE_LABEL_MAX (32)
+#endif
+
+/**
+ * \brief Size in bytes of the pool of random bytes from which the random
+ *        generation requests are served. Set to 0 to disable the pool.
+ */
+#ifndef TFM_CRYPTO_RANDOM_POOL_SIZE
+#define TFM_CRYPTO_RANDOM_POOL_SIZE (128)
+#endif
+
+#if (TFM_CRYPTO_HUK_KEY_CACHE_SIZE > 0) && \
+    !defined(TFM_CRYPTO_KEY_DERIVATION_MODULE_DISABLED)
+struct tfm_crypto_huk_key_cache_entry_s {
+    psa_key_handle_t key;   /*!< Mbed Crypto handle of the key, 0 if unused */
+    psa_key_type_t type;    /*!< Type of the key */
+    size_t bits;            /*!< Size of the key in bits */
+    psa_key_usage_t usage;  /*!< Usage flags of the key */
+    psa_algorithm_t alg;    /*!< Permitted algorithm of the key */
+    size_t label_length;    /*!< Length of the label */
+    /*! Partition ID of the caller followed by the label it supplied */
+    uint8_t label[TFM_CRYPTO_HUK_KEY_CACHE_LABEL_MAX];
+};
+
+static struct tfm_crypto_huk_key_cache_entry_s
+                       huk_key_cache[TFM_CRYPTO_HUK_KEY_CACHE_SIZE] = {{0}};
+
+/**
+ * \brief Security lifecycle of the device when the cached keys were derived
+ */
+static enum tfm_security_lifecycle_t huk_key_cache_lifecycle = TFM_SLC_UNKNOWN;
+
+/**
+ * \brief Destroys all the cached keys. The handles given to the clients for
+ *        them become stale.
+ */
+static void tfm_crypto_huk_key_cache_wipe(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < TFM_CRYPTO_HUK_KEY_CACHE_SIZE; i++) {
+        if (huk_key_cache[i].key != 0) {
+            tfm_crypto_release_key_handles(huk_key_cache[i].key);
+            (void)psa_destroy_key(huk_key_cache[i].key);
+        }
+    }
+
+    (void)tfm_memset(huk_key_cache, 0, sizeof(huk_key_cache));
+}
+
+static bool tfm_crypto_huk_key_cache_match(
+                          const struct tfm_crypto_huk_key_cache_entry_s *entry,
+                          const psa_key_attributes_t *attributes,
+                          const psa_key_derivation_operation_t *operation)
+{
+    return (entry->key != 0) &&
+           (entry->type == psa_get_key_type(attributes)) &&
+           (entry->bits == psa_get_key_bits(attributes)) &&
+           (entry->usage == psa_get_key_usage_flags(attributes)) &&
+           (entry->alg == psa_get_key_algorithm(attributes)) &&
+           (entry->label_length == operation->ctx.tls12_prf.label_length) &&
+           (tfm_memcmp(entry->label, operation->ctx.tls12_prf.label,
+                       entry->label_length) == 0);
+}
+
+/**
+ * \brief Looks up the cached key derived with the label of the operation and
+ *        the given attributes. The cache is wiped first if the security
+ *        lifecycle of the device has changed since the keys were derived.
+ *
+ * \return The Mbed Crypto handle of the key, or 0 if the key is not cached
+ */
+static psa_key_handle_t tfm_crypto_huk_key_cache_lookup(
+                               const psa_key_attributes_t *attributes,
+                               const psa_key_derivation_operation_t *operation)
+{
+    enum tfm_security_lifecycle_t lifecycle;
+    uint32_t i;
+
+    lifecycle = tfm_attest_hal_get_security_lifecycle();
+    if (lifecycle != huk_key_cache_lifecycle) {
+        tfm_crypto_huk_key_cache_wipe();
+        huk_key_cache_lifecycle = lifecycle;
+        return 0;
+    }
+
+    for (i = 0; i < TFM_CRYPTO_HUK_KEY_CACHE_SIZE; i++) {
+        if (tfm_crypto_huk_key_cache_match(&huk_key_cache[i], attributes,
+                                           operation)) {
+            return huk_key_cache[i].key;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Keeps a newly derived key in the cache, if there is a free entry.
+ *        Only the volatile keys are cached.
+ */
+static void tfm_crypto_huk_key_cache_insert(
+                               const psa_key_attributes_t *attributes,
+                               const psa_key_derivation_operation_t *operation,
+                               psa_key_handle_t key)
+{
+    uint32_t i;
+
+    if ((psa_get_key_lifetime(attributes) != PSA_KEY_LIFETIME_VOLATILE) ||
+        (operation->ctx.tls12_prf.label_length >
+         TFM_CRYPTO_HUK_KEY_CACHE_LABEL_MAX)) {
+        return;
+    }
+
+    for (i = 0; i < TFM_CRYPTO_HUK_KEY_CACHE_SIZE; i++) {
+        if (huk_key_cache[i].key == 0) {
+            huk_key_cache[i].key = key;
+            huk_key_cache[i].type = psa_get_key_type(attributes);
+            huk_key_cache[i].bits = psa_get_key_bits(attributes);
+            huk_key_cache[i].usage = psa_get_key_usage_flags(attributes);
+            huk_key_cache[i].alg = psa_get_key_algorithm(attributes);
+            huk_key_cache[i].label_length =
+                                         operation->ctx.tls12_prf.label_length;
+            (void)tfm_memcpy(huk_key_cache[i].label,
+                             operation->ctx.tls12_prf.label,
+                             operation->ctx.tls12_prf.label_length);
+            return;
+        }
+    }
+}
+#endif /* TFM_CRYPTO_HUK_KEY_CACHE_SIZE > 0 && ... */
+
 #ifndef TFM_CRYPTO_KEY_DERIVATION_MODULE_DISABLED
 static psa_status_t tfm_crypto_huk_derivation_setup(
                                       psa_key_derivation_operation_t *operation,
@@ -90,12 +236,21 @@ static psa_status_t tfm_crypto_huk_derivation_output_key(
                                       psa_key_handle_t *handle)
 {
     enum tfm_plat_err_t err;
+    psa_status_t status;
     size_t bytes = PSA_BITS_TO_BYTES(psa_get_key_bits(attributes));
 
     if (sizeof(operation->ctx.tls12_prf.output_block) < bytes) {
         return PSA_ERROR_INSUFFICIENT_MEMORY;
     }
 
+#if TFM_CRYPTO_HUK_KEY_CACHE_SIZE > 0
+    /* The same partition deriving the same key gets the key derived before */
+    *handle = tfm_crypto_huk_key_cache_lookup(attributes, operation);
+    if (*handle != 0) {
+        return PSA_SUCCESS;
+    }
+#endif
+
     /* Derive key material from the HUK and output it to the operation buffer */
     err = tfm_plat_get_huk_derived_key(operation->ctx.tls12_prf.label,
                                        operation->ctx.tls12_prf.label_length,
@@ -106,8 +261,16 @@ static psa_status_t tfm_crypto_huk_derivation_output_key(
         return PSA_ERROR_HARDWARE_FAILURE;
     }
 
-    return psa_import_key(attributes, operation->ctx.tls12_prf.output_block,
-                          bytes, handle);
+    status = psa_import_key(attributes, operation->ctx.tls12_prf.output_block,
+                            bytes, handle);
+
+#if TFM_CRYPTO_HUK_KEY_CACHE_SIZE > 0
+    if (status == PSA_SUCCESS) {
+        tfm_crypto_huk_key_cache_insert(attributes, operation, *handle);
+    }
+#endif
+
+    return status;
 }
 
 static psa_status_t tfm_crypto_huk_derivation_abort(
@@ -125,6 +288,25 @@ static psa_status_t tfm_crypto_huk_derivation_abort(
 }
 #endif /* TFM_CRYPTO_KEY_DERIVATION_MODULE_DISABLED */
 
+bool tfm_crypto_huk_key_cache_holds(psa_key_handle_t key_handle)
+{
+#if (TFM_CRYPTO_HUK_KEY_CACHE_SIZE > 0) && \
+    !defined(TFM_CRYPTO_KEY_DERIVATION_MODULE_DISABLED)
+    uint32_t i;
+
+    for (i = 0; i < TFM_CRYPTO_HUK_KEY_CACHE_SIZE; i++) {
+        if ((huk_key_cache[i].key != 0) &&
+            (huk_key_cache[i].key == key_handle)) {
+            return true;
+        }
+    }
+#else
+    (void)key_handle;
+#endif
+
+    return false;
+}
+
 /*!
  * \defgroup public_psa Public functions, PSA
  *
@@ -350,7 +532,7 @@ psa_status_t tfm_crypto_key_derivation_input_key(psa_invec in_vec[],
     psa_key_derivation_step_t step = iov->step;
     psa_key_derivation_operation_t *operation = NULL;
 
-    status = tfm_crypto_check_handle_owner(key_handle, NULL);
+    status = tfm_crypto_check_handle_owner(&key_handle, NULL);
     if (status != PSA_SUCCESS) {
         return status;
     }
@@ -427,7 +609,7 @@ psa_status_t tfm_crypto_key_derivation_output_key(psa_invec in_vec[],
                                                key_handle);
     }
     if (status == PSA_SUCCESS) {
-        status = tfm_crypto_set_key_storage(index, *key_handle);
+        status = tfm_crypto_set_key_storage(index, key_handle);
     }
 
     return status;
@@ -513,7 +695,7 @@ psa_status_t tfm_crypto_key_derivation_key_agreement(psa_invec in_vec[],
     psa_key_derivation_operation_t *operation = NULL;
     psa_key_derivation_step_t step = iov->step;
 
-    status = tfm_crypto_check_handle_owner(private_key, NULL);
+    status = tfm_crypto_check_handle_owner(&private_key, NULL);
     if (status != PSA_SUCCESS) {
         return status;
     }
@@ -533,6 +715,79 @@ psa_status_t tfm_crypto_key_derivation_key_agreement(psa_invec in_vec[],
 #endif /* TFM_CRYPTO_KEY_DERIVATION_MODULE_DISABLED */
 }
 
+#if (TFM_CRYPTO_RANDOM_POOL_SIZE > 0) && \
+    !defined(TFM_CRYPTO_KEY_DERIVATION_MODULE_DISABLED)
+/**
+ * \brief Pool of random bytes generated ahead of the requests. The bytes
+ *        available are the last ones of the buffer, and the bytes handed out
+ *        are cleared.
+ */
+static struct tfm_crypto_random_pool_s {
+    uint8_t buf[TFM_CRYPTO_RANDOM_POOL_SIZE];
+    size_t avail; /*!< Number of bytes available at the end of buf */
+} random_pool;
+
+static psa_status_t tfm_crypto_random_pool_get(uint8_t *output,
+                                               size_t output_size)
+{
+    psa_status_t status;
+    size_t offset, len;
+
+    /* A large request would drain the pool, it is generated directly */
+    if (output_size > TFM_CRYPTO_RANDOM_POOL_SIZE) {
+        return psa_generate_random(output, output_size);
+    }
+
+    while (output_size > 0) {
+        if (random_pool.avail == 0) {
+            status = tfm_crypto_refill_random_pool();
+            if (status != PSA_SUCCESS) {
+                return status;
+            }
+        }
+
+        len = (output_size < random_pool.avail) ? output_size
+                                                : random_pool.avail;
+        offset = TFM_CRYPTO_RANDOM_POOL_SIZE - random_pool.avail;
+
+        (void)tfm_memcpy(output, &random_pool.buf[offset], len);
+        (void)tfm_memset(&random_pool.buf[offset], 0, len);
+
+        random_pool.avail -= len;
+        output += len;
+        output_size -= len;
+    }
+
+    return PSA_SUCCESS;
+}
+#endif
+
+psa_status_t tfm_crypto_refill_random_pool(void)
+{
+#if (TFM_CRYPTO_RANDOM_POOL_SIZE == 0) || \
+    defined(TFM_CRYPTO_KEY_DERIVATION_MODULE_DISABLED)
+    return PSA_SUCCESS;
+#else
+    psa_status_t status;
+    size_t used = TFM_CRYPTO_RANDOM_POOL_SIZE - random_pool.avail;
+
+    /* The pool is topped up once three quarters of it have been used, so
+     * that a DRBG call is shared by many small requests.
+     */
+    if (random_pool.avail >= (TFM_CRYPTO_RANDOM_POOL_SIZE / 4)) {
+        return PSA_SUCCESS;
+    }
+
+    status = psa_generate_random(random_pool.buf, used);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+    random_pool.avail = TFM_CRYPTO_RANDOM_POOL_SIZE;
+
+    return PSA_SUCCESS;
+#endif
+}
+
 psa_status_t tfm_crypto_generate_random(psa_invec in_vec[],
                                         size_t in_len,
                                         psa_outvec out_vec[],
@@ -541,17 +796,28 @@ psa_status_t tfm_crypto_generate_random(psa_invec in_vec[],
 #ifdef TFM_CRYPTO_KEY_DERIVATION_MODULE_DISABLED
     return PSA_ERROR_NOT_SUPPORTED;
 #else
-    if ((in_len != 1) || (out_len != 1)) {
+    psa_status_t status = PSA_SUCCESS;
+    size_t i;
+
+    if ((in_len != 1) || (out_len < 1) ||
+        (out_len > TFM_CRYPTO_RANDOM_BATCH_MAX_OUTPUTS)) {
         return PSA_ERROR_CONNECTION_REFUSED;
     }
 
     if (in_vec[0].len != sizeof(struct tfm_crypto_pack_iovec)) {
         return PSA_ERROR_CONNECTION_REFUSED;
     }
-    uint8_t *output = out_vec[0].base;
-    size_t output_size = out_vec[0].len;
 
-    return psa_generate_random(output, output_size);
+    /* Each output vector is a buffer of a batch request */
+    for (i = 0; (i < out_len) && (status == PSA_SUCCESS); i++) {
+#if TFM_CRYPTO_RANDOM_POOL_SIZE > 0
+        status = tfm_crypto_random_pool_get(out_vec[i].base, out_vec[i].len);
+#else
+        status = psa_generate_random(out_vec[i].base, out_vec[i].len);
+#endif
+    }
+
+    return status;
 #endif /* TFM_CRYPTO_KEY_DERIVATION_MODULE_DISABLED */
 }
 
@@ -577,6 +843,12 @@ psa_status_t tfm_crypto_raw_key_agreement(psa_invec in_vec[],
     psa_key_handle_t private_key = iov->key_handle;
     const uint8_t *peer_key = in_vec[1].base;
     size_t peer_key_length = in_vec[1].len;
+    psa_status_t status;
+
+    status = tfm_crypto_check_handle_owner(&private_key, NULL);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
 
     return psa_raw_key_agreement(alg, private_key, peer_key, peer_key_length,
                                  output, output_size, &out_vec[0].len);
@@ -18,6 +18,41 @@
 #include "tfm_crypto_api.h"
 #include "tfm_crypto_defs.h"
 
+#ifndef TFM_CRYPTO_MAC_MODULE_DISABLED
+/**
+ * \brief Copies the state of an HMAC operation to another operation context
+ *
+ * Mbed Crypto provides no MAC clone, but the state of an HMAC operation is
+ * the hash operation over the inner key and the input so far, plus the outer
+ * key. It is copied as a whole, then the hash operation is cloned through
+ * psa_hash_clone(). A CMAC operation holds a cipher context allocated by
+ * Mbed Crypto, which cannot be duplicated in the same way.
+ *
+ * \param[in]  source HMAC operation to copy
+ * \param[out] target Operation context receiving the copy, not set up
+ *
+ * \return Return values as described in \ref psa_status_t
+ */
+static psa_status_t tfm_crypto_hmac_clone(const psa_mac_operation_t *source,
+                                          psa_mac_operation_t *target)
+{
+#if defined(MBEDTLS_MD_C)
+    psa_hash_operation_t hash_init = PSA_HASH_OPERATION_INIT;
+
+    *target = *source;
+    target->ctx.hmac.hash_ctx = hash_init;
+
+    return psa_hash_clone(&source->ctx.hmac.hash_ctx,
+                          &target->ctx.hmac.hash_ctx);
+#else
+    (void)source;
+    (void)target;
+
+    return PSA_ERROR_NOT_SUPPORTED;
+#endif /* MBEDTLS_MD_C */
+}
+#endif /* TFM_CRYPTO_MAC_MODULE_DISABLED */
+
 /*!
  * \defgroup public_psa Public functions, PSA
  *
@@ -49,7 +84,7 @@ psa_status_t tfm_crypto_mac_sign_setup(psa_invec in_vec[],
     psa_key_handle_t key_handle = iov->key_handle;
     psa_algorithm_t alg = iov->alg;
 
-    status = tfm_crypto_check_handle_owner(key_handle, NULL);
+    status = tfm_crypto_check_handle_owner(&key_handle, NULL);
     if (status != PSA_SUCCESS) {
         return status;
     }
@@ -103,7 +138,7 @@ psa_status_t tfm_crypto_mac_verify_setup(psa_invec in_vec[],
     psa_key_handle_t key_handle = iov->key_handle;
     psa_algorithm_t alg = iov->alg;
 
-    status = tfm_crypto_check_handle_owner(key_handle, NULL);
+    status = tfm_crypto_check_handle_owner(&key_handle, NULL);
     if (status != PSA_SUCCESS) {
         return status;
     }
@@ -329,6 +364,65 @@ psa_status_t tfm_crypto_mac_abort(psa_invec in_vec[],
 #endif /* TFM_CRYPTO_MAC_MODULE_DISABLED */
 }
 
+psa_status_t tfm_crypto_mac_clone(psa_invec in_vec[],
+                                  size_t in_len,
+                                  psa_outvec out_vec[],
+                                  size_t out_len)
+{
+#ifdef TFM_CRYPTO_MAC_MODULE_DISABLED
+    return PSA_ERROR_NOT_SUPPORTED;
+#else
+    psa_status_t status = PSA_SUCCESS;
+    psa_mac_operation_t *source_operation = NULL;
+    psa_mac_operation_t *target_operation = NULL;
+
+    if ((in_len != 1) || (out_len != 1)) {
+        return PSA_ERROR_CONNECTION_REFUSED;
+    }
+
+    if ((in_vec[0].len != sizeof(struct tfm_crypto_pack_iovec)) ||
+        (out_vec[0].len != sizeof(uint32_t))) {
+        return PSA_ERROR_CONNECTION_REFUSED;
+    }
+    const struct tfm_crypto_pack_iovec *iov = in_vec[0].base;
+    uint32_t source_handle = iov->op_handle;
+    uint32_t *target_handle = out_vec[0].base;
+
+    /* Look up the corresponding source operation context */
+    status = tfm_crypto_operation_lookup(TFM_CRYPTO_MAC_OPERATION,
+                                         source_handle,
+                                         (void **)&source_operation);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    if (source_operation->alg == 0) {
+        return PSA_ERROR_BAD_STATE;
+    }
+
+    if (!PSA_ALG_IS_HMAC(source_operation->alg)) {
+        return PSA_ERROR_NOT_SUPPORTED;
+    }
+
+    /* Allocate the target operation context in the secure world */
+    status = tfm_crypto_operation_alloc(TFM_CRYPTO_MAC_OPERATION,
+                                        target_handle,
+                                        (void **)&target_operation);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    status = tfm_crypto_hmac_clone(source_operation, target_operation);
+    if (status != PSA_SUCCESS) {
+        /* Release the target operation context, ignore if it fails. */
+        (void)tfm_crypto_operation_release(target_handle);
+        return status;
+    }
+
+    return status;
+#endif /* TFM_CRYPTO_MAC_MODULE_DISABLED */
+}
+
 psa_status_t tfm_crypto_mac_compute(psa_invec in_vec[],
                                     size_t in_len,
                                     psa_outvec out_vec[],
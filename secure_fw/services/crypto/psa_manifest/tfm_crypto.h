@@ -15,6 +15,7 @@ extern "C" {
 #endif
 
 #define TFM_CRYPTO_SIGNAL                                       (1U << (0 + 4))
+#define TFM_CRYPTO_ASYM_SIGNAL                                  (1U << (1 + 4))
 
 #ifdef __cplusplus
 }
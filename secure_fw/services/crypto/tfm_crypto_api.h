@@ -12,8 +12,11 @@
 extern "C" {
 #endif
 
+#include <stdbool.h>
 #include <stdint.h>
 #include "tfm_crypto_defs.h"
+#include "mbedtls/gcm.h"
+#include "mbedtls/chachapoly.h"
 #ifdef TFM_PSA_API
 #include "psa/service.h"
 
@@ -39,11 +42,58 @@ enum tfm_crypto_operation_type {
     TFM_CRYPTO_MAC_OPERATION = 2,
     TFM_CRYPTO_HASH_OPERATION = 3,
     TFM_CRYPTO_KEY_DERIVATION_OPERATION = 4,
+    TFM_CRYPTO_AEAD_OPERATION = 5,
 
     /* Used to force the enum size */
     TFM_CRYPTO_OPERATION_TYPE_MAX = INT_MAX
 };
 
+/**
+ * \brief Longest additional data of a multipart AEAD operation. The additional
+ *        data is kept in the operation context until the first update, as
+ *        GCM takes it all at once when it starts.
+ */
+#ifndef TFM_CRYPTO_AEAD_MAX_AD_LENGTH
+#define TFM_CRYPTO_AEAD_MAX_AD_LENGTH (64u)
+#endif
+
+/**
+ * \brief Context of a multipart AEAD operation. Mbed Crypto only provides the
+ *        single-part AEAD functions, so the service drives the GCM and
+ *        ChaCha20-Poly1305 modules of Mbed Crypto itself.
+ */
+struct tfm_crypto_aead_operation_s {
+    union {
+        mbedtls_gcm_context gcm;               /*!< GCM context */
+        mbedtls_chachapoly_context chachapoly; /*!< ChaCha20-Poly1305
+                                                *   context
+                                                */
+    } ctx;                       /*!< Context of the algorithm, keyed at
+                                  *   setup
+                                  */
+    psa_algorithm_t alg;         /*!< Algorithm of the operation */
+    uint8_t encrypt;             /*!< 1 for an encryption, 0 for a decryption */
+    uint8_t state;               /*!< Stage the operation has reached */
+    uint8_t tag_length;          /*!< Length of the tag in bytes */
+    uint8_t nonce_length;        /*!< Length of the nonce in bytes */
+    uint8_t nonce[TFM_CRYPTO_MAX_NONCE_LENGTH]; /*!< Nonce, until GCM starts */
+    uint8_t ad[TFM_CRYPTO_AEAD_MAX_AD_LENGTH];  /*!< Additional data, until
+                                                 *   GCM starts
+                                                 */
+    size_t ad_length;            /*!< Additional data supplied so far */
+    size_t input_length;         /*!< Input data supplied so far */
+    size_t ad_expected;          /*!< Additional data length announced by
+                                  *   psa_aead_set_lengths(), or SIZE_MAX
+                                  */
+    size_t input_expected;       /*!< Input data length announced by
+                                  *   psa_aead_set_lengths(), or SIZE_MAX
+                                  */
+    uint8_t block[16];           /*!< Input not processed yet, as GCM takes
+                                  *   whole blocks until the last one
+                                  */
+    uint8_t block_length;        /*!< Number of bytes in block */
+};
+
 /**
  * \brief Core key attributes struct as seen by the application, with
  *        psa_app_key_id_t as the key ID type.
@@ -81,6 +131,33 @@ psa_status_t tfm_crypto_init(void);
  */
 psa_status_t tfm_crypto_init_alloc(void);
 
+/**
+ * \brief Initialise the Key module
+ *
+ * \return Return values as described in \ref psa_status_t
+ */
+psa_status_t tfm_crypto_init_key(void);
+
+/**
+ * \brief Initialise the Engine memory module, which provides Mbed Crypto with
+ *        its dynamic allocations from a static buffer
+ *
+ * \param[in] buf   Buffer to allocate from
+ * \param[in] size  Size of the buffer in bytes
+ *
+ * \return Return values as described in \ref psa_status_t
+ */
+psa_status_t tfm_crypto_init_engine_mem(uint8_t *buf, size_t size);
+
+/**
+ * \brief Sets the function of the service on behalf of which the following
+ *        allocations of Mbed Crypto are made, for the allocation statistics
+ *
+ * \param[in] sfn_id  SID of the function being served, or
+ *                    TFM_CRYPTO_SID_INVALID once it has returned
+ */
+void tfm_crypto_engine_mem_set_sfn(uint32_t sfn_id);
+
 /**
  * \brief Returns the ID of the caller
  *
@@ -118,17 +195,19 @@ psa_status_t tfm_crypto_key_attributes_to_app(
 
 /**
  * \brief Checks that the requested handle belongs to the requesting
- *        partition
+ *        partition, and gets the corresponding Mbed Crypto key handle
  *
- * \param[in]  handle Handle given as input
- * \param[out] index  Optionally, pointer to hold the internal index
- *                    corresponding to the input handle. Valid only
- *                    on PSA_SUCCESS, it's returned only if the input
- *                    parameter is not NULL.
+ * \param[in,out] handle Handle given as input by the client. On
+ *                       PSA_SUCCESS, it is replaced by the Mbed Crypto
+ *                       key handle to be used with the PSA Crypto API.
+ * \param[out]    index  Optionally, pointer to hold the internal index
+ *                       corresponding to the input handle. Valid only
+ *                       on PSA_SUCCESS, it's returned only if the input
+ *                       parameter is not NULL.
  *
  * \return Return values as described in \ref psa_status_t
  */
-psa_status_t tfm_crypto_check_handle_owner(psa_key_handle_t handle,
+psa_status_t tfm_crypto_check_handle_owner(psa_key_handle_t *handle,
                                            uint32_t *index);
 
 /**
@@ -145,13 +224,45 @@ psa_status_t tfm_crypto_check_key_storage(uint32_t *index);
  * \brief Sets the index of the local storage in use with a key requested by the
  *        calling partition, and stores the corresponding key_handle.
  *
- * \param[in] index       Index of the local storage to use
- * \param[in] key_handle  Corresponding key handle to associate
+ * \param[in]     index       Index of the local storage to use, as returned
+ *                            by \ref tfm_crypto_check_key_storage
+ * \param[in,out] key_handle  Mbed Crypto key handle to associate. On
+ *                            PSA_SUCCESS, it is replaced by the handle to be
+ *                            given to the client.
  *
  * \return Return values as described in \ref psa_status_t
  */
 psa_status_t tfm_crypto_set_key_storage(uint32_t index,
-                                        psa_key_handle_t key_handle);
+                                        psa_key_handle_t *key_handle);
+
+/**
+ * \brief Releases every local storage entry which refers to a key, so that
+ *        the handles given to the clients for that key become stale.
+ *
+ * \param[in] key_handle  Mbed Crypto key handle
+ */
+void tfm_crypto_release_key_handles(psa_key_handle_t key_handle);
+
+/**
+ * \brief Tops up the pool of random bytes of the service once most of it has
+ *        been handed out. It is called when a request has been replied to, so
+ *        that the next requests are served from the pool.
+ *
+ * \return Return values as described in \ref psa_status_t
+ */
+psa_status_t tfm_crypto_refill_random_pool(void);
+
+/**
+ * \brief Checks whether a key is held by the cache of the keys derived from
+ *        the HUK. Such a key outlives the handles given to the clients, and is
+ *        only destroyed when the cache is wiped.
+ *
+ * \param[in] key_handle  Mbed Crypto key handle
+ *
+ * \return true if the key is held by the cache, false otherwise
+ */
+bool tfm_crypto_huk_key_cache_holds(psa_key_handle_t key_handle);
+
 /**
  * \brief Allocate an operation context in the backend
  *
@@ -212,6 +323,7 @@ psa_status_t tfm_crypto_operation_lookup(enum tfm_crypto_operation_type type,
     X(tfm_crypto_mac_sign_finish)             \
     X(tfm_crypto_mac_verify_finish)           \
     X(tfm_crypto_mac_abort)                   \
+    X(tfm_crypto_mac_clone)                   \
     X(tfm_crypto_cipher_encrypt)              \
     X(tfm_crypto_cipher_decrypt)              \
     X(tfm_crypto_cipher_encrypt_setup)        \
@@ -233,8 +345,11 @@ psa_status_t tfm_crypto_operation_lookup(enum tfm_crypto_operation_type type,
     X(tfm_crypto_aead_finish)                 \
     X(tfm_crypto_aead_verify)                 \
     X(tfm_crypto_aead_abort)                  \
+    X(tfm_crypto_aead_encrypt_batch)          \
+    X(tfm_crypto_aead_decrypt_batch)          \
     X(tfm_crypto_sign_hash)                   \
     X(tfm_crypto_verify_hash)                 \
+    X(tfm_crypto_verify_hash_batch)           \
     X(tfm_crypto_asymmetric_encrypt)          \
     X(tfm_crypto_asymmetric_decrypt)          \
     X(tfm_crypto_key_derivation_setup)        \
@@ -251,6 +366,7 @@ psa_status_t tfm_crypto_operation_lookup(enum tfm_crypto_operation_type type,
     X(tfm_crypto_generate_key)                \
     X(tfm_crypto_set_key_domain_parameters)   \
     X(tfm_crypto_get_key_domain_parameters)   \
+    X(tfm_crypto_get_engine_mem_stats)        \
 
 #define X(api_name) UNIFORM_SIGNATURE_API(api_name);
 LIST_TFM_CRYPTO_UNIFORM_SIGNATURE_API
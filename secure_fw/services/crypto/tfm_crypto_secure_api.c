@@ -17,22 +17,18 @@
 #ifdef TFM_PSA_API
 #include "psa/client.h"
 
-#define PSA_CONNECT(service)                                    \
-    psa_handle_t ipc_handle;                                    \
-    ipc_handle = psa_connect(service##_SID, service##_VERSION); \
-    if (!PSA_HANDLE_IS_VALID(ipc_handle)) {                     \
-        return PSA_ERROR_GENERIC_ERROR;                         \
-    }                                                           \
-
-#define PSA_CLOSE() psa_close(ipc_handle)
+/* Public key operations are queued apart from the other requests */
+#define API_HANDLE(sfn_id)                                     \
+    (TFM_CRYPTO_IS_ASYM_SID(sfn_id##_SID) ?                    \
+        TFM_CRYPTO_ASYM_HANDLE : TFM_CRYPTO_HANDLE)
 
 #define API_DISPATCH(sfn_name, sfn_id)                         \
-    psa_call(ipc_handle, PSA_IPC_CALL,                         \
+    psa_call(API_HANDLE(sfn_id), PSA_IPC_CALL,                 \
         in_vec, ARRAY_SIZE(in_vec),                            \
         out_vec, ARRAY_SIZE(out_vec))
 
 #define API_DISPATCH_NO_OUTVEC(sfn_name, sfn_id)               \
-    psa_call(ipc_handle, PSA_IPC_CALL,                         \
+    psa_call(API_HANDLE(sfn_id), PSA_IPC_CALL,                 \
         in_vec, ARRAY_SIZE(in_vec),                            \
         (psa_outvec *)NULL, 0)
 #else
@@ -76,17 +72,9 @@ psa_status_t psa_open_key(psa_key_id_t id,
         {.base = handle, .len = sizeof(psa_key_handle_t)},
     };
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
     status = API_DISPATCH(tfm_crypto_open_key,
                           TFM_CRYPTO_OPEN_KEY);
 
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
-
     return status;
 #endif /* TFM_CRYPTO_KEY_MODULE_DISABLED */
 }
@@ -106,17 +94,9 @@ psa_status_t psa_close_key(psa_key_handle_t handle)
         {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
     };
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
     status = API_DISPATCH_NO_OUTVEC(tfm_crypto_close_key,
                                     TFM_CRYPTO_CLOSE_KEY);;
 
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
-
     return status;
 #endif /* TFM_CRYPTO_KEY_MODULE_DISABLED */
 }
@@ -143,15 +123,8 @@ psa_status_t psa_import_key(const psa_key_attributes_t *attributes,
         {.base = handle, .len = sizeof(psa_key_handle_t)}
     };
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
     status = API_DISPATCH(tfm_crypto_import_key,
                           TFM_CRYPTO_IMPORT_KEY);
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
 
     return status;
 #endif /* TFM_CRYPTO_KEY_MODULE_DISABLED */
@@ -172,15 +145,8 @@ psa_status_t psa_destroy_key(psa_key_handle_t handle)
         {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
     };
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
     status = API_DISPATCH_NO_OUTVEC(tfm_crypto_destroy_key,
                                     TFM_CRYPTO_DESTROY_KEY);
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
 
     return status;
 #endif /* TFM_CRYPTO_KEY_MODULE_DISABLED */
@@ -205,15 +171,8 @@ psa_status_t psa_get_key_attributes(psa_key_handle_t handle,
         {.base = attributes, .len = sizeof(psa_key_attributes_t)},
     };
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
     status = API_DISPATCH(tfm_crypto_get_key_attributes,
                           TFM_CRYPTO_GET_KEY_ATTRIBUTES);
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
 
     return status;
 #endif /* TFM_CRYPTO_KEY_MODULE_DISABLED */
@@ -234,19 +193,8 @@ void psa_reset_key_attributes(psa_key_attributes_t *attributes)
         {.base = attributes, .len = sizeof(psa_key_attributes_t)},
     };
 
-#ifdef TFM_PSA_API
-    psa_handle_t ipc_handle;
-    ipc_handle = psa_connect(TFM_CRYPTO_SID, TFM_CRYPTO_VERSION);
-    if (!PSA_HANDLE_IS_VALID(ipc_handle)) {
-        return;
-    }
-#endif
-
     (void)API_DISPATCH(tfm_crypto_reset_key_attributes,
                           TFM_CRYPTO_RESET_KEY_ATTRIBUTES);
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
 
     return;
 #endif /* TFM_CRYPTO_KEY_MODULE_DISABLED */
@@ -273,19 +221,11 @@ psa_status_t psa_export_key(psa_key_handle_t handle,
         {.base = data, .len = data_size}
     };
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
     status = API_DISPATCH(tfm_crypto_export_key,
                           TFM_CRYPTO_EXPORT_KEY);
 
     *data_length = out_vec[0].len;
 
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
-
     return status;
 #endif /* TFM_CRYPTO_KEY_MODULE_DISABLED */
 }
@@ -312,19 +252,11 @@ psa_status_t psa_export_public_key(psa_key_handle_t handle,
         {.base = data, .len = data_size}
     };
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
     status = API_DISPATCH(tfm_crypto_export_public_key,
                           TFM_CRYPTO_EXPORT_PUBLIC_KEY);
 
     *data_length = out_vec[0].len;
 
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
-
     return status;
 #endif /* TFM_CRYPTO_KEY_MODULE_DISABLED */
 }
@@ -352,15 +284,8 @@ psa_status_t psa_copy_key(psa_key_handle_t source_handle,
         {.base = target_handle, .len = sizeof(psa_key_handle_t)},
     };
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
     status = API_DISPATCH(tfm_crypto_copy_key,
                           TFM_CRYPTO_COPY_KEY);
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
 
     return status;
 #endif /* TFM_CRYPTO_KEY_MODULE_DISABLED */
@@ -389,19 +314,11 @@ psa_status_t psa_cipher_generate_iv(psa_cipher_operation_t *operation,
         {.base = iv, .len = iv_size},
     };
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
     status = API_DISPATCH(tfm_crypto_cipher_generate_iv,
                           TFM_CRYPTO_CIPHER_GENERATE_IV);
 
     *iv_length = out_vec[1].len;
 
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
-
     return status;
 #endif /* TFM_CRYPTO_CIPHER_MODULE_DISABLED */
 }
@@ -428,15 +345,8 @@ psa_status_t psa_cipher_set_iv(psa_cipher_operation_t *operation,
         {.base = &(operation->handle), .len = sizeof(uint32_t)},
     };
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
     status = API_DISPATCH(tfm_crypto_cipher_set_iv,
                           TFM_CRYPTO_CIPHER_SET_IV);
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
 
     return status;
 #endif /* TFM_CRYPTO_CIPHER_MODULE_DISABLED */
@@ -465,15 +375,8 @@ psa_status_t psa_cipher_encrypt_setup(psa_cipher_operation_t *operation,
         {.base = &(operation->handle), .len = sizeof(uint32_t)},
     };
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
     status = API_DISPATCH(tfm_crypto_cipher_encrypt_setup,
                           TFM_CRYPTO_CIPHER_ENCRYPT_SETUP);
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
 
     return status;
 #endif /* TFM_CRYPTO_CIPHER_MODULE_DISABLED */
@@ -502,15 +405,8 @@ psa_status_t psa_cipher_decrypt_setup(psa_cipher_operation_t *operation,
         {.base = &(operation->handle), .len = sizeof(uint32_t)},
     };
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
     status = API_DISPATCH(tfm_crypto_cipher_decrypt_setup,
                           TFM_CRYPTO_CIPHER_DECRYPT_SETUP);
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
 
     return status;
 #endif /* TFM_CRYPTO_CIPHER_MODULE_DISABLED */
@@ -542,19 +438,11 @@ psa_status_t psa_cipher_update(psa_cipher_operation_t *operation,
         {.base = output, .len = output_size}
     };
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
     status = API_DISPATCH(tfm_crypto_cipher_update,
                           TFM_CRYPTO_CIPHER_UPDATE);
 
     *output_length = out_vec[1].len;
 
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
-
     return status;
 #endif /* TFM_CRYPTO_CIPHER_MODULE_DISABLED */
 }
@@ -578,15 +466,8 @@ psa_status_t psa_cipher_abort(psa_cipher_operation_t *operation)
         {.base = &(operation->handle), .len = sizeof(uint32_t)},
     };
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
     status = API_DISPATCH(tfm_crypto_cipher_abort,
                           TFM_CRYPTO_CIPHER_ABORT);
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
 
     return status;
 #endif /* TFM_CRYPTO_CIPHER_MODULE_DISABLED */
@@ -615,19 +496,11 @@ psa_status_t psa_cipher_finish(psa_cipher_operation_t *operation,
         {.base = output, .len = output_size},
     };
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
     status = API_DISPATCH(tfm_crypto_cipher_finish,
                           TFM_CRYPTO_CIPHER_FINISH);
 
     *output_length = out_vec[1].len;
 
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
-
     return status;
 #endif /* TFM_CRYPTO_CIPHER_MODULE_DISABLED */
 }
@@ -653,17 +526,9 @@ psa_status_t psa_hash_setup(psa_hash_operation_t *operation,
         {.base = &(operation->handle), .len = sizeof(uint32_t)},
     };
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
     status = API_DISPATCH(tfm_crypto_hash_setup,
                           TFM_CRYPTO_HASH_SETUP);
 
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
-
     return status;
 #endif /* TFM_CRYPTO_HASH_MODULE_DISABLED */
 }
@@ -690,17 +555,9 @@ psa_status_t psa_hash_update(psa_hash_operation_t *operation,
         {.base = &(operation->handle), .len = sizeof(uint32_t)},
     };
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
     status = API_DISPATCH(tfm_crypto_hash_update,
                           TFM_CRYPTO_HASH_UPDATE);
 
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
-
     return status;
 #endif /* TFM_CRYPTO_HASH_MODULE_DISABLED */
 }
@@ -728,19 +585,11 @@ psa_status_t psa_hash_finish(psa_hash_operation_t *operation,
         {.base = hash, .len = hash_size},
     };
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
     status = API_DISPATCH(tfm_crypto_hash_finish,
                           TFM_CRYPTO_HASH_FINISH);
 
     *hash_length = out_vec[1].len;
 
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
-
     return status;
 #endif /* TFM_CRYPTO_HASH_MODULE_DISABLED */
 }
@@ -767,15 +616,8 @@ psa_status_t psa_hash_verify(psa_hash_operation_t *operation,
         {.base = &(operation->handle), .len = sizeof(uint32_t)},
     };
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
     status = API_DISPATCH(tfm_crypto_hash_verify,
                           TFM_CRYPTO_HASH_VERIFY);
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
 
     return status;
 #endif /* TFM_CRYPTO_HASH_MODULE_DISABLED */
@@ -800,15 +642,8 @@ psa_status_t psa_hash_abort(psa_hash_operation_t *operation)
         {.base = &(operation->handle), .len = sizeof(uint32_t)},
     };
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
     status = API_DISPATCH(tfm_crypto_hash_abort,
                           TFM_CRYPTO_HASH_ABORT);
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
 
     return status;
 #endif /* TFM_CRYPTO_HASH_MODULE_DISABLED */
@@ -838,15 +673,8 @@ psa_status_t psa_hash_clone(const psa_hash_operation_t *source_operation,
         return PSA_ERROR_BAD_STATE;
     }
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
     status = API_DISPATCH(tfm_crypto_hash_clone,
                           TFM_CRYPTO_HASH_CLONE);
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
 
     return status;
 #endif /* TFM_CRYPTO_HASH_MODULE_DISABLED */
@@ -875,15 +703,8 @@ psa_status_t psa_mac_sign_setup(psa_mac_operation_t *operation,
         {.base = &(operation->handle), .len = sizeof(uint32_t)},
     };
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
     status = API_DISPATCH(tfm_crypto_mac_sign_setup,
                           TFM_CRYPTO_MAC_SIGN_SETUP);
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
 
     return status;
 #endif /* TFM_CRYPTO_MAC_MODULE_DISABLED */
@@ -912,15 +733,8 @@ psa_status_t psa_mac_verify_setup(psa_mac_operation_t *operation,
         {.base = &(operation->handle), .len = sizeof(uint32_t)},
     };
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
     status = API_DISPATCH(tfm_crypto_mac_verify_setup,
                           TFM_CRYPTO_MAC_VERIFY_SETUP);
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
 
     return status;
 #endif /* TFM_CRYPTO_MAC_MODULE_DISABLED */
@@ -948,15 +762,8 @@ psa_status_t psa_mac_update(psa_mac_operation_t *operation,
         {.base = &(operation->handle), .len = sizeof(uint32_t)},
     };
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
     status = API_DISPATCH(tfm_crypto_mac_update,
                           TFM_CRYPTO_MAC_UPDATE);
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
 
     return status;
 #endif /* TFM_CRYPTO_MAC_MODULE_DISABLED */
@@ -985,19 +792,11 @@ psa_status_t psa_mac_sign_finish(psa_mac_operation_t *operation,
         {.base = mac, .len = mac_size},
     };
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
     status = API_DISPATCH(tfm_crypto_mac_sign_finish,
                           TFM_CRYPTO_MAC_SIGN_FINISH);
 
     *mac_length = out_vec[1].len;
 
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
-
     return status;
 #endif /* TFM_CRYPTO_MAC_MODULE_DISABLED */
 }
@@ -1024,17 +823,9 @@ psa_status_t psa_mac_verify_finish(psa_mac_operation_t *operation,
         {.base = &(operation->handle), .len = sizeof(uint32_t)},
     };
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
     status = API_DISPATCH(tfm_crypto_mac_verify_finish,
                           TFM_CRYPTO_MAC_VERIFY_FINISH);
 
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
-
     return status;
 #endif /* TFM_CRYPTO_MAC_MODULE_DISABLED */
 }
@@ -1058,15 +849,39 @@ psa_status_t psa_mac_abort(psa_mac_operation_t *operation)
         {.base = &(operation->handle), .len = sizeof(uint32_t)},
     };
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
     status = API_DISPATCH(tfm_crypto_mac_abort,
                           TFM_CRYPTO_MAC_ABORT);
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
+
+    return status;
+#endif /* TFM_CRYPTO_MAC_MODULE_DISABLED */
+}
+
+__attribute__((section("SFN")))
+psa_status_t psa_mac_clone(const psa_mac_operation_t *source_operation,
+                           psa_mac_operation_t *target_operation)
+{
+#ifdef TFM_CRYPTO_MAC_MODULE_DISABLED
+    return PSA_ERROR_NOT_SUPPORTED;
+#else
+    psa_status_t status;
+    struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_MAC_CLONE_SID,
+        .op_handle = source_operation->handle,
+    };
+
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+    };
+    psa_outvec out_vec[] = {
+        {.base = target_operation, .len = sizeof(psa_mac_operation_t)},
+    };
+
+    if (target_operation && (target_operation->handle != 0)) {
+        return PSA_ERROR_BAD_STATE;
+    }
+
+    status = API_DISPATCH(tfm_crypto_mac_clone,
+                          TFM_CRYPTO_MAC_CLONE);
 
     return status;
 #endif /* TFM_CRYPTO_MAC_MODULE_DISABLED */
@@ -1121,16 +936,12 @@ psa_status_t psa_aead_encrypt(psa_key_handle_t handle,
         }
     }
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
 #ifdef TFM_PSA_API
     size_t in_len = ARRAY_SIZE(in_vec);
     if (additional_data == NULL) {
         in_len--;
     }
-    status = psa_call(ipc_handle, PSA_IPC_CALL, in_vec, in_len,
+    status = psa_call(TFM_CRYPTO_HANDLE, PSA_IPC_CALL, in_vec, in_len,
                       out_vec, ARRAY_SIZE(out_vec));
 #else
     status = API_DISPATCH(tfm_crypto_aead_encrypt,
@@ -1139,10 +950,6 @@ psa_status_t psa_aead_encrypt(psa_key_handle_t handle,
 
     *ciphertext_length = out_vec[0].len;
 
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
-
     return status;
 #endif /* TFM_CRYPTO_AEAD_MODULE_DISABLED */
 }
@@ -1196,16 +1003,12 @@ psa_status_t psa_aead_decrypt(psa_key_handle_t handle,
         }
     }
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
 #ifdef TFM_PSA_API
     size_t in_len = ARRAY_SIZE(in_vec);
     if (additional_data == NULL) {
         in_len--;
     }
-    status = psa_call(ipc_handle, PSA_IPC_CALL, in_vec, in_len,
+    status = psa_call(TFM_CRYPTO_HANDLE, PSA_IPC_CALL, in_vec, in_len,
                       out_vec, ARRAY_SIZE(out_vec));
 #else
     status = API_DISPATCH(tfm_crypto_aead_decrypt,
@@ -1214,10 +1017,6 @@ psa_status_t psa_aead_decrypt(psa_key_handle_t handle,
 
     *plaintext_length = out_vec[0].len;
 
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
-
     return status;
 #endif /* TFM_CRYPTO_AEAD_MODULE_DISABLED */
 }
@@ -1261,18 +1060,11 @@ psa_status_t psa_sign_hash(psa_key_handle_t handle,
         {.base = signature, .len = signature_size},
     };
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
     status = API_DISPATCH(tfm_crypto_sign_hash,
                           TFM_CRYPTO_SIGN_HASH);
 
     *signature_length = out_vec[0].len;
 
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
-
     return status;
 #endif /* TFM_CRYPTO_ASYMMETRIC_MODULE_DISABLED */
 }
@@ -1312,15 +1104,8 @@ psa_status_t psa_verify_hash(psa_key_handle_t handle,
         {.base = signature, .len = signature_length}
     };
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
     status = API_DISPATCH_NO_OUTVEC(tfm_crypto_verify_hash,
                                     TFM_CRYPTO_VERIFY_HASH);
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
 
     return status;
 #endif /* TFM_CRYPTO_ASYMMETRIC_MODULE_DISABLED */
@@ -1362,16 +1147,12 @@ psa_status_t psa_asymmetric_encrypt(psa_key_handle_t handle,
         {.base = output, .len = output_size},
     };
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
 #ifdef TFM_PSA_API
     size_t in_len = ARRAY_SIZE(in_vec);
     if (salt == NULL) {
         in_len--;
     }
-    status = psa_call(ipc_handle, PSA_IPC_CALL, in_vec, in_len,
+    status = psa_call(TFM_CRYPTO_ASYM_HANDLE, PSA_IPC_CALL, in_vec, in_len,
                       out_vec, ARRAY_SIZE(out_vec));
 #else
     status = API_DISPATCH(tfm_crypto_asymmetric_encrypt,
@@ -1380,10 +1161,6 @@ psa_status_t psa_asymmetric_encrypt(psa_key_handle_t handle,
 
     *output_length = out_vec[0].len;
 
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
-
     return status;
 #endif /* TFM_CRYPTO_ASYMMETRIC_MODULE_DISABLED */
 }
@@ -1424,16 +1201,12 @@ psa_status_t psa_asymmetric_decrypt(psa_key_handle_t handle,
         {.base = output, .len = output_size},
     };
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
 #ifdef TFM_PSA_API
     size_t in_len = ARRAY_SIZE(in_vec);
     if (salt == NULL) {
         in_len--;
     }
-    status = psa_call(ipc_handle, PSA_IPC_CALL, in_vec, in_len,
+    status = psa_call(TFM_CRYPTO_ASYM_HANDLE, PSA_IPC_CALL, in_vec, in_len,
                       out_vec, ARRAY_SIZE(out_vec));
 #else
     status = API_DISPATCH(tfm_crypto_asymmetric_decrypt,
@@ -1442,10 +1215,6 @@ psa_status_t psa_asymmetric_decrypt(psa_key_handle_t handle,
 
     *output_length = out_vec[0].len;
 
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
-
     return status;
 #endif /* TFM_CRYPTO_ASYMMETRIC_MODULE_DISABLED */
 }
@@ -1472,15 +1241,8 @@ psa_status_t psa_key_derivation_get_capacity(
         {.base = capacity, .len = sizeof(size_t)},
     };
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
     status = API_DISPATCH(tfm_crypto_key_derivation_get_capacity,
                           TFM_CRYPTO_KEY_DERIVATION_GET_CAPACITY);
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
 
     return status;
 #endif /* TFM_CRYPTO_GENERATOR_MODULE_DISABLED */
@@ -1509,15 +1271,8 @@ psa_status_t psa_key_derivation_output_bytes(
         {.base = output, .len = output_length},
     };
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
     status = API_DISPATCH(tfm_crypto_key_derivation_output_bytes,
                           TFM_CRYPTO_KEY_DERIVATION_OUTPUT_BYTES);
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
 
     return status;
 #endif /* TFM_CRYPTO_GENERATOR_MODULE_DISABLED */
@@ -1544,15 +1299,8 @@ psa_status_t psa_key_derivation_input_key(
         {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
     };
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
     status = API_DISPATCH_NO_OUTVEC(tfm_crypto_key_derivation_input_key,
                                     TFM_CRYPTO_KEY_DERIVATION_INPUT_KEY);
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
 
     return status;
 #endif /* TFM_CRYPTO_GENERATOR_MODULE_DISABLED */
@@ -1578,15 +1326,8 @@ psa_status_t psa_key_derivation_abort(psa_key_derivation_operation_t *operation)
         {.base = &(operation->handle), .len = sizeof(uint32_t)},
     };
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
     status = API_DISPATCH(tfm_crypto_key_derivation_abort,
                           TFM_CRYPTO_KEY_DERIVATION_ABORT);
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
 
     return status;
 #endif /* TFM_CRYPTO_GENERATOR_MODULE_DISABLED */
@@ -1620,17 +1361,9 @@ psa_status_t psa_key_derivation_key_agreement(
         {.base = &(operation->handle), .len = sizeof(uint32_t)},
     };
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
     status = API_DISPATCH(tfm_crypto_key_derivation_key_agreement,
                           TFM_CRYPTO_KEY_DERIVATION_KEY_AGREEMENT);
 
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
-
     return status;
 #endif /* TFM_CRYPTO_GENERATOR_MODULE_DISABLED */
 }
@@ -1659,51 +1392,86 @@ psa_status_t psa_generate_random(uint8_t *output,
         return PSA_SUCCESS;
     }
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
     status = API_DISPATCH(tfm_crypto_generate_random,
                           TFM_CRYPTO_GENERATE_RANDOM);
 
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
-
     return status;
 #endif /* TFM_CRYPTO_GENERATOR_MODULE_DISABLED */
 }
 
 __attribute__((section("SFN")))
-psa_status_t psa_generate_key(const psa_key_attributes_t *attributes,
-                              psa_key_handle_t *handle)
+psa_status_t psa_generate_random_batch(uint8_t *const outputs[],
+                                       const size_t output_sizes[],
+                                       size_t count)
 {
 #ifdef TFM_CRYPTO_GENERATOR_MODULE_DISABLED
     return PSA_ERROR_NOT_SUPPORTED;
 #else
-    psa_status_t status;
+    psa_status_t status = PSA_SUCCESS;
     struct tfm_crypto_pack_iovec iov = {
-        .sfn_id = TFM_CRYPTO_GENERATE_KEY_SID,
+        .sfn_id = TFM_CRYPTO_GENERATE_RANDOM_SID,
     };
 
     psa_invec in_vec[] = {
         {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
-        {.base = attributes, .len = sizeof(psa_key_attributes_t)},
     };
 
-    psa_outvec out_vec[] = {
-        {.base = handle, .len = sizeof(psa_key_handle_t)},
-    };
+    psa_outvec out_vec[TFM_CRYPTO_RANDOM_BATCH_MAX_OUTPUTS];
+    size_t out_len = 0;
+    size_t i;
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
+    if ((count != 0) && ((outputs == NULL) || (output_sizes == NULL))) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
 
-    status = API_DISPATCH(tfm_crypto_generate_key,
-                          TFM_CRYPTO_GENERATE_KEY);
+    /* Each request fills up to TFM_CRYPTO_RANDOM_BATCH_MAX_OUTPUTS buffers */
+    for (i = 0; (i < count) && (status == PSA_SUCCESS); i++) {
+        if (output_sizes[i] != 0) {
+            out_vec[out_len].base = outputs[i];
+            out_vec[out_len].len = output_sizes[i];
+            out_len++;
+        }
+
+        if ((out_len == ARRAY_SIZE(out_vec)) ||
+            ((i == count - 1) && (out_len != 0))) {
 #ifdef TFM_PSA_API
-    PSA_CLOSE();
+            status = psa_call(TFM_CRYPTO_HANDLE, PSA_IPC_CALL,
+                              in_vec, ARRAY_SIZE(in_vec), out_vec, out_len);
+#else
+            status = tfm_tfm_crypto_generate_random_veneer(
+                                  in_vec, ARRAY_SIZE(in_vec), out_vec, out_len);
 #endif
+            out_len = 0;
+        }
+    }
+
+    return status;
+#endif /* TFM_CRYPTO_GENERATOR_MODULE_DISABLED */
+}
+
+__attribute__((section("SFN")))
+psa_status_t psa_generate_key(const psa_key_attributes_t *attributes,
+                              psa_key_handle_t *handle)
+{
+#ifdef TFM_CRYPTO_GENERATOR_MODULE_DISABLED
+    return PSA_ERROR_NOT_SUPPORTED;
+#else
+    psa_status_t status;
+    struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_GENERATE_KEY_SID,
+    };
+
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+        {.base = attributes, .len = sizeof(psa_key_attributes_t)},
+    };
+
+    psa_outvec out_vec[] = {
+        {.base = handle, .len = sizeof(psa_key_handle_t)},
+    };
+
+    status = API_DISPATCH(tfm_crypto_generate_key,
+                          TFM_CRYPTO_GENERATE_KEY);
 
     return status;
 #endif /* TFM_CRYPTO_GENERATOR_MODULE_DISABLED */
@@ -1755,11 +1523,28 @@ psa_status_t psa_aead_update_ad(psa_aead_operation_t *operation,
                                 const uint8_t *input,
                                 size_t input_length)
 {
+#ifdef TFM_CRYPTO_AEAD_MODULE_DISABLED
+    return PSA_ERROR_NOT_SUPPORTED;
+#else
     psa_status_t status;
+    struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_AEAD_UPDATE_AD_SID,
+        .op_handle = operation->handle,
+    };
 
-    status = PSA_ERROR_NOT_SUPPORTED;
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+        {.base = input, .len = input_length},
+    };
+    psa_outvec out_vec[] = {
+        {.base = &(operation->handle), .len = sizeof(uint32_t)},
+    };
+
+    status = API_DISPATCH(tfm_crypto_aead_update_ad,
+                          TFM_CRYPTO_AEAD_UPDATE_AD);
 
     return status;
+#endif /* TFM_CRYPTO_AEAD_MODULE_DISABLED */
 }
 
 __attribute__((section("SFN")))
@@ -1771,11 +1556,32 @@ psa_status_t psa_aead_finish(psa_aead_operation_t *operation,
                              size_t tag_size,
                              size_t *tag_length)
 {
+#ifdef TFM_CRYPTO_AEAD_MODULE_DISABLED
+    return PSA_ERROR_NOT_SUPPORTED;
+#else
     psa_status_t status;
+    struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_AEAD_FINISH_SID,
+        .op_handle = operation->handle,
+    };
 
-    status = PSA_ERROR_NOT_SUPPORTED;
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+    };
+    psa_outvec out_vec[] = {
+        {.base = &(operation->handle), .len = sizeof(uint32_t)},
+        {.base = ciphertext, .len = ciphertext_size},
+        {.base = tag, .len = tag_size},
+    };
+
+    status = API_DISPATCH(tfm_crypto_aead_finish,
+                          TFM_CRYPTO_AEAD_FINISH);
+
+    *ciphertext_length = out_vec[1].len;
+    *tag_length = out_vec[2].len;
 
     return status;
+#endif /* TFM_CRYPTO_AEAD_MODULE_DISABLED */
 }
 
 __attribute__((section("SFN")))
@@ -1786,19 +1592,231 @@ psa_status_t psa_aead_verify(psa_aead_operation_t *operation,
                              const uint8_t *tag,
                              size_t tag_length)
 {
+#ifdef TFM_CRYPTO_AEAD_MODULE_DISABLED
+    return PSA_ERROR_NOT_SUPPORTED;
+#else
     psa_status_t status;
+    struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_AEAD_VERIFY_SID,
+        .op_handle = operation->handle,
+    };
 
-    status = PSA_ERROR_NOT_SUPPORTED;
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+        {.base = tag, .len = tag_length},
+    };
+    psa_outvec out_vec[] = {
+        {.base = &(operation->handle), .len = sizeof(uint32_t)},
+        {.base = plaintext, .len = plaintext_size},
+    };
+
+    status = API_DISPATCH(tfm_crypto_aead_verify,
+                          TFM_CRYPTO_AEAD_VERIFY);
+
+    *plaintext_length = out_vec[1].len;
 
     return status;
+#endif /* TFM_CRYPTO_AEAD_MODULE_DISABLED */
 }
 
 __attribute__((section("SFN")))
 psa_status_t psa_aead_abort(psa_aead_operation_t *operation)
 {
+#ifdef TFM_CRYPTO_AEAD_MODULE_DISABLED
+    return PSA_ERROR_NOT_SUPPORTED;
+#else
     psa_status_t status;
+    struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_AEAD_ABORT_SID,
+        .op_handle = operation->handle,
+    };
 
-    status = PSA_ERROR_NOT_SUPPORTED;
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+    };
+    psa_outvec out_vec[] = {
+        {.base = &(operation->handle), .len = sizeof(uint32_t)},
+    };
+
+    status = API_DISPATCH(tfm_crypto_aead_abort,
+                          TFM_CRYPTO_AEAD_ABORT);
+
+    return status;
+#endif /* TFM_CRYPTO_AEAD_MODULE_DISABLED */
+}
+
+__attribute__((section("SFN")))
+psa_status_t psa_aead_encrypt_batch(psa_key_handle_t handle,
+                                    psa_algorithm_t alg,
+                                    struct tfm_crypto_aead_batch_entry *entries,
+                                    size_t entry_count,
+                                    const uint8_t *input,
+                                    size_t input_length,
+                                    uint8_t *output,
+                                    size_t output_size)
+{
+#ifdef TFM_CRYPTO_AEAD_MODULE_DISABLED
+    return PSA_ERROR_NOT_SUPPORTED;
+#else
+    psa_status_t status;
+    const struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_AEAD_ENCRYPT_BATCH_SID,
+        .key_handle = handle,
+        .alg = alg,
+    };
+    struct tfm_crypto_aead_batch_result
+                                results[TFM_CRYPTO_AEAD_BATCH_MAX_ENTRIES];
+    size_t idx;
+
+    if ((entries == NULL) || (entry_count == 0) ||
+        (entry_count > TFM_CRYPTO_AEAD_BATCH_MAX_ENTRIES)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+        {.base = entries,
+         .len = entry_count * sizeof(struct tfm_crypto_aead_batch_entry)},
+        {.base = input, .len = input_length},
+    };
+    psa_outvec out_vec[] = {
+        {.base = output, .len = output_size},
+        {.base = results,
+         .len = entry_count * sizeof(struct tfm_crypto_aead_batch_result)},
+    };
+
+    status = API_DISPATCH(tfm_crypto_aead_encrypt_batch,
+                          TFM_CRYPTO_AEAD_ENCRYPT_BATCH);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    for (idx = 0; idx < entry_count; idx++) {
+        entries[idx].status = results[idx].status;
+        entries[idx].output_length = results[idx].output_length;
+    }
+
+    return PSA_SUCCESS;
+#endif /* TFM_CRYPTO_AEAD_MODULE_DISABLED */
+}
+
+__attribute__((section("SFN")))
+psa_status_t psa_aead_decrypt_batch(psa_key_handle_t handle,
+                                    psa_algorithm_t alg,
+                                    struct tfm_crypto_aead_batch_entry *entries,
+                                    size_t entry_count,
+                                    const uint8_t *input,
+                                    size_t input_length,
+                                    uint8_t *output,
+                                    size_t output_size)
+{
+#ifdef TFM_CRYPTO_AEAD_MODULE_DISABLED
+    return PSA_ERROR_NOT_SUPPORTED;
+#else
+    psa_status_t status;
+    const struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_AEAD_DECRYPT_BATCH_SID,
+        .key_handle = handle,
+        .alg = alg,
+    };
+    struct tfm_crypto_aead_batch_result
+                                results[TFM_CRYPTO_AEAD_BATCH_MAX_ENTRIES];
+    size_t idx;
+
+    if ((entries == NULL) || (entry_count == 0) ||
+        (entry_count > TFM_CRYPTO_AEAD_BATCH_MAX_ENTRIES)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+        {.base = entries,
+         .len = entry_count * sizeof(struct tfm_crypto_aead_batch_entry)},
+        {.base = input, .len = input_length},
+    };
+    psa_outvec out_vec[] = {
+        {.base = output, .len = output_size},
+        {.base = results,
+         .len = entry_count * sizeof(struct tfm_crypto_aead_batch_result)},
+    };
+
+    status = API_DISPATCH(tfm_crypto_aead_decrypt_batch,
+                          TFM_CRYPTO_AEAD_DECRYPT_BATCH);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    for (idx = 0; idx < entry_count; idx++) {
+        entries[idx].status = results[idx].status;
+        entries[idx].output_length = results[idx].output_length;
+    }
+
+    return PSA_SUCCESS;
+#endif /* TFM_CRYPTO_AEAD_MODULE_DISABLED */
+}
+
+__attribute__((section("SFN")))
+psa_status_t psa_verify_hash_batch(
+                            const struct tfm_crypto_verify_batch_entry *entries,
+                            size_t entry_count,
+                            const uint8_t *input,
+                            size_t input_length,
+                            uint32_t *verified)
+{
+#ifdef TFM_CRYPTO_ASYMMETRIC_MODULE_DISABLED
+    return PSA_ERROR_NOT_SUPPORTED;
+#else
+    psa_status_t status;
+    const struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_VERIFY_HASH_BATCH_SID,
+    };
+
+    if ((entries == NULL) || (entry_count == 0) ||
+        (entry_count > TFM_CRYPTO_VERIFY_BATCH_MAX_ENTRIES) ||
+        (verified == NULL)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+        {.base = entries,
+         .len = entry_count * sizeof(struct tfm_crypto_verify_batch_entry)},
+        {.base = input, .len = input_length},
+    };
+    psa_outvec out_vec[] = {
+        {.base = verified, .len = sizeof(uint32_t)},
+    };
+
+    status = API_DISPATCH(tfm_crypto_verify_hash_batch,
+                          TFM_CRYPTO_VERIFY_HASH_BATCH);
+
+    return status;
+#endif /* TFM_CRYPTO_ASYMMETRIC_MODULE_DISABLED */
+}
+
+__attribute__((section("SFN")))
+psa_status_t psa_crypto_get_engine_mem_stats(
+                                      struct tfm_crypto_engine_mem_stats *stats)
+{
+    psa_status_t status;
+    struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_GET_ENGINE_MEM_STATS_SID,
+    };
+
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+    };
+
+    psa_outvec out_vec[] = {
+        {.base = stats, .len = sizeof(struct tfm_crypto_engine_mem_stats)},
+    };
+
+    if (stats == NULL) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    status = API_DISPATCH(tfm_crypto_get_engine_mem_stats,
+                          TFM_CRYPTO_GET_ENGINE_MEM_STATS);
 
     return status;
 }
@@ -1894,18 +1912,11 @@ psa_status_t psa_raw_key_agreement(psa_algorithm_t alg,
         {.base = output, .len = output_size},
     };
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
     status = API_DISPATCH(tfm_crypto_raw_key_agreement,
                           TFM_CRYPTO_RAW_KEY_AGREEMENT);
 
     *output_length = out_vec[0].len;
 
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
-
     return status;
 #endif /* TFM_CRYPTO_GENERATOR_MODULE_DISABLED */
 }
@@ -1931,15 +1942,8 @@ psa_status_t psa_key_derivation_setup(psa_key_derivation_operation_t *operation,
         {.base = &(operation->handle), .len = sizeof(uint32_t)},
     };
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
     status = API_DISPATCH(tfm_crypto_key_derivation_setup,
                           TFM_CRYPTO_KEY_DERIVATION_SETUP);
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
 
     return status;
 #endif /* TFM_CRYPTO_GENERATOR_MODULE_DISABLED */
@@ -1964,15 +1968,8 @@ psa_status_t psa_key_derivation_set_capacity(
         {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
     };
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
     status = API_DISPATCH_NO_OUTVEC(tfm_crypto_key_derivation_set_capacity,
                                     TFM_CRYPTO_KEY_DERIVATION_SET_CAPACITY);
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
 
     return status;
 #endif /* TFM_CRYPTO_GENERATOR_MODULE_DISABLED */
@@ -2000,15 +1997,8 @@ psa_status_t psa_key_derivation_input_bytes(
         {.base = data, .len = data_length},
     };
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
     status = API_DISPATCH_NO_OUTVEC(tfm_crypto_key_derivation_input_bytes,
                                     TFM_CRYPTO_KEY_DERIVATION_INPUT_BYTES);
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
 
     return status;
 #endif /* TFM_CRYPTO_GENERATOR_MODULE_DISABLED */
@@ -2038,15 +2028,8 @@ psa_status_t psa_key_derivation_output_key(
         {.base = handle, .len = sizeof(psa_key_handle_t)}
     };
 
-#ifdef TFM_PSA_API
-    PSA_CONNECT(TFM_CRYPTO);
-#endif
-
     status = API_DISPATCH(tfm_crypto_key_derivation_output_key,
                           TFM_CRYPTO_KEY_DERIVATION_OUTPUT_KEY);
-#ifdef TFM_PSA_API
-    PSA_CLOSE();
-#endif
 
     return status;
 #endif /* TFM_CRYPTO_GENERATOR_MODULE_DISABLED */
@@ -2072,11 +2055,29 @@ psa_status_t psa_aead_encrypt_setup(psa_aead_operation_t *operation,
                                     psa_key_handle_t handle,
                                     psa_algorithm_t alg)
 {
+#ifdef TFM_CRYPTO_AEAD_MODULE_DISABLED
+    return PSA_ERROR_NOT_SUPPORTED;
+#else
     psa_status_t status;
+    struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_AEAD_ENCRYPT_SETUP_SID,
+        .key_handle = handle,
+        .alg = alg,
+        .op_handle = operation->handle,
+    };
 
-    status = PSA_ERROR_NOT_SUPPORTED;
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+    };
+    psa_outvec out_vec[] = {
+        {.base = &(operation->handle), .len = sizeof(uint32_t)},
+    };
+
+    status = API_DISPATCH(tfm_crypto_aead_encrypt_setup,
+                          TFM_CRYPTO_AEAD_ENCRYPT_SETUP);
 
     return status;
+#endif /* TFM_CRYPTO_AEAD_MODULE_DISABLED */
 }
 
 __attribute__((section("SFN")))
@@ -2084,11 +2085,29 @@ psa_status_t psa_aead_decrypt_setup(psa_aead_operation_t *operation,
                                     psa_key_handle_t handle,
                                     psa_algorithm_t alg)
 {
+#ifdef TFM_CRYPTO_AEAD_MODULE_DISABLED
+    return PSA_ERROR_NOT_SUPPORTED;
+#else
     psa_status_t status;
+    struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_AEAD_DECRYPT_SETUP_SID,
+        .key_handle = handle,
+        .alg = alg,
+        .op_handle = operation->handle,
+    };
 
-    status = PSA_ERROR_NOT_SUPPORTED;
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+    };
+    psa_outvec out_vec[] = {
+        {.base = &(operation->handle), .len = sizeof(uint32_t)},
+    };
+
+    status = API_DISPATCH(tfm_crypto_aead_decrypt_setup,
+                          TFM_CRYPTO_AEAD_DECRYPT_SETUP);
 
     return status;
+#endif /* TFM_CRYPTO_AEAD_MODULE_DISABLED */
 }
 
 __attribute__((section("SFN")))
@@ -2097,11 +2116,30 @@ psa_status_t psa_aead_generate_nonce(psa_aead_operation_t *operation,
                                      size_t nonce_size,
                                      size_t *nonce_length)
 {
+#ifdef TFM_CRYPTO_AEAD_MODULE_DISABLED
+    return PSA_ERROR_NOT_SUPPORTED;
+#else
     psa_status_t status;
+    struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_AEAD_GENERATE_NONCE_SID,
+        .op_handle = operation->handle,
+    };
 
-    status = PSA_ERROR_NOT_SUPPORTED;
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+    };
+    psa_outvec out_vec[] = {
+        {.base = &(operation->handle), .len = sizeof(uint32_t)},
+        {.base = nonce, .len = nonce_size},
+    };
+
+    status = API_DISPATCH(tfm_crypto_aead_generate_nonce,
+                          TFM_CRYPTO_AEAD_GENERATE_NONCE);
+
+    *nonce_length = out_vec[1].len;
 
     return status;
+#endif /* TFM_CRYPTO_AEAD_MODULE_DISABLED */
 }
 
 __attribute__((section("SFN")))
@@ -2109,11 +2147,28 @@ psa_status_t psa_aead_set_nonce(psa_aead_operation_t *operation,
                                 const uint8_t *nonce,
                                 size_t nonce_length)
 {
+#ifdef TFM_CRYPTO_AEAD_MODULE_DISABLED
+    return PSA_ERROR_NOT_SUPPORTED;
+#else
     psa_status_t status;
+    struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_AEAD_SET_NONCE_SID,
+        .op_handle = operation->handle,
+    };
 
-    status = PSA_ERROR_NOT_SUPPORTED;
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+        {.base = nonce, .len = nonce_length},
+    };
+    psa_outvec out_vec[] = {
+        {.base = &(operation->handle), .len = sizeof(uint32_t)},
+    };
+
+    status = API_DISPATCH(tfm_crypto_aead_set_nonce,
+                          TFM_CRYPTO_AEAD_SET_NONCE);
 
     return status;
+#endif /* TFM_CRYPTO_AEAD_MODULE_DISABLED */
 }
 
 __attribute__((section("SFN")))
@@ -2121,11 +2176,29 @@ psa_status_t psa_aead_set_lengths(psa_aead_operation_t *operation,
                                   size_t ad_length,
                                   size_t plaintext_length)
 {
+#ifdef TFM_CRYPTO_AEAD_MODULE_DISABLED
+    return PSA_ERROR_NOT_SUPPORTED;
+#else
     psa_status_t status;
+    struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_AEAD_SET_LENGTHS_SID,
+        .op_handle = operation->handle,
+    };
+    size_t lengths[2] = {ad_length, plaintext_length};
 
-    status = PSA_ERROR_NOT_SUPPORTED;
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+        {.base = lengths, .len = sizeof(lengths)},
+    };
+    psa_outvec out_vec[] = {
+        {.base = &(operation->handle), .len = sizeof(uint32_t)},
+    };
+
+    status = API_DISPATCH(tfm_crypto_aead_set_lengths,
+                          TFM_CRYPTO_AEAD_SET_LENGTHS);
 
     return status;
+#endif /* TFM_CRYPTO_AEAD_MODULE_DISABLED */
 }
 
 __attribute__((section("SFN")))
@@ -2136,9 +2209,29 @@ psa_status_t psa_aead_update(psa_aead_operation_t *operation,
                              size_t output_size,
                              size_t *output_length)
 {
+#ifdef TFM_CRYPTO_AEAD_MODULE_DISABLED
+    return PSA_ERROR_NOT_SUPPORTED;
+#else
     psa_status_t status;
+    struct tfm_crypto_pack_iovec iov = {
+        .sfn_id = TFM_CRYPTO_AEAD_UPDATE_SID,
+        .op_handle = operation->handle,
+    };
 
-    status = PSA_ERROR_NOT_SUPPORTED;
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+        {.base = input, .len = input_length},
+    };
+    psa_outvec out_vec[] = {
+        {.base = &(operation->handle), .len = sizeof(uint32_t)},
+        {.base = output, .len = output_size},
+    };
+
+    status = API_DISPATCH(tfm_crypto_aead_update,
+                          TFM_CRYPTO_AEAD_UPDATE);
+
+    *output_length = out_vec[1].len;
 
     return status;
+#endif /* TFM_CRYPTO_AEAD_MODULE_DISABLED */
 }
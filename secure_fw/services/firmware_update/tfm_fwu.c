@@ -0,0 +1,623 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "psa/client.h"
+#include "psa/service.h"
+#include "psa/crypto.h"
+#include "psa_manifest/tfm_firmware_update.h"
+#include "tfm_fwu_api.h"
+#include "secure_fw/include/tfm_spm_services_api.h"
+#include "flash_layout.h"
+#include "sysflash/sysflash.h"
+#include "flash_map_backend/flash_map_backend.h"
+#include "bootutil/bootutil.h"
+#include "bootutil/image.h"
+#include "bl2/include/boot_fwu.h"
+
+/* Size of the buffer the blocks of the image are read through */
+#ifndef TFM_FWU_BUF_SIZE
+#define TFM_FWU_BUF_SIZE        512
+#endif
+
+/* Size of the buffer of the unprotected TLV area of the image */
+#ifndef TFM_FWU_TLV_BUF_SIZE
+#define TFM_FWU_TLV_BUF_SIZE    1024
+#endif
+
+#define FWU_MAGIC_SIZE          16U
+#define FWU_SWAP_TYPE_TEST      2U  /* BOOT_SWAP_TYPE_TEST of MCUBoot */
+#define FWU_SWAP_TYPE_PERM      3U  /* BOOT_SWAP_TYPE_PERM of MCUBoot */
+#define FWU_FLAG_SET            1U  /* BOOT_FLAG_SET of MCUBoot */
+
+/*
+ * Upper bound of the size of the MCUBoot trailer at the end of a slot: the
+ * swap status written with the largest alignment, the swap size, swap info,
+ * copy done and image ok fields, the key records of an encrypted swap and the
+ * magic number.
+ */
+#define FWU_TRAILER_MAX_SIZE    (MCUBOOT_STATUS_MAX_ENTRIES * 3 *            \
+                                 BOOT_MAX_ALIGN + 4 * BOOT_MAX_ALIGN +       \
+                                 2 * 32 + FWU_MAGIC_SIZE)
+
+/* Size of the sectors of the slot holding the trailer */
+#define FWU_TRAILER_AREA_SIZE   (((FWU_TRAILER_MAX_SIZE +                    \
+                                   FLASH_AREA_IMAGE_SECTOR_SIZE - 1) /       \
+                                  FLASH_AREA_IMAGE_SECTOR_SIZE) *            \
+                                 FLASH_AREA_IMAGE_SECTOR_SIZE)
+
+/* Signature TLVs, one of which is verified by MCUBoot */
+#define FWU_IS_SIG_TLV(type)    (((type) == IMAGE_TLV_RSA2048_PSS) ||        \
+                                 ((type) == IMAGE_TLV_ECDSA256) ||           \
+                                 ((type) == IMAGE_TLV_RSA3072_PSS))
+
+typedef psa_status_t (*fwu_func_t)(const psa_msg_t *msg);
+
+/* The update in progress, of one image at a time */
+static struct {
+    uint32_t state;                 /* TFM_FWU_STATE_* */
+    uint32_t image_id;              /* Image being updated */
+    int32_t client_id;              /* Client which started the update */
+    const struct flash_area *fap;   /* Secondary slot of the image */
+    uint32_t limit;                 /* End of the slot before the trailer */
+    uint32_t written;               /* Bytes of the image received */
+    uint32_t programmed;            /* Bytes of the image programmed */
+    uint32_t erased;                /* End of the erased part of the slot */
+    uint32_t hash_size;             /* Header, body and protected TLVs */
+    uint32_t image_size;            /* Image and TLVs, 0 until known */
+    uint32_t align;                 /* Write alignment of the flash */
+    uint32_t tail_len;              /* Bytes waiting for a full write unit */
+    uint8_t tail[BOOT_MAX_ALIGN];
+    uint8_t hash[32];
+    struct image_header hdr;
+    psa_hash_operation_t hash_op;
+} fwu;
+
+static uint8_t fwu_tlv_buf[TFM_FWU_TLV_BUF_SIZE];
+static uint8_t fwu_data_buf[TFM_FWU_BUF_SIZE];
+
+static uint32_t fwu_min(uint32_t a, uint32_t b)
+{
+    return (a < b) ? a : b;
+}
+
+static void fwu_reset(uint32_t state)
+{
+    /* Also valid once the hash is finished */
+    if (fwu.state == TFM_FWU_STATE_WRITING) {
+        psa_hash_abort(&fwu.hash_op);
+    }
+    fwu.state = state;
+}
+
+/**
+ * \brief Programs a part of the image, erasing the sectors it reaches first.
+ */
+static psa_status_t fwu_flash_write(uint32_t off, const void *data,
+                                    uint32_t len)
+{
+    while (fwu.erased < off + len) {
+        if (flash_area_erase(fwu.fap, fwu.erased,
+                             FLASH_AREA_IMAGE_SECTOR_SIZE) != 0) {
+            return PSA_ERROR_STORAGE_FAILURE;
+        }
+        fwu.erased += FLASH_AREA_IMAGE_SECTOR_SIZE;
+        tfm_yield();
+    }
+
+    if (flash_area_write(fwu.fap, off, data, len) != 0) {
+        return PSA_ERROR_STORAGE_FAILURE;
+    }
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Programs the next bytes of the image in whole write units, keeping
+ *        the last partial unit until the following bytes are received.
+ */
+static psa_status_t fwu_program(const uint8_t *data, uint32_t len)
+{
+    psa_status_t status;
+    uint32_t chunk;
+
+    if (fwu.tail_len > 0) {
+        chunk = fwu_min(fwu.align - fwu.tail_len, len);
+        memcpy(&fwu.tail[fwu.tail_len], data, chunk);
+        fwu.tail_len += chunk;
+        data += chunk;
+        len -= chunk;
+        if (fwu.tail_len < fwu.align) {
+            return PSA_SUCCESS;
+        }
+        status = fwu_flash_write(fwu.programmed, fwu.tail, fwu.align);
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+        fwu.programmed += fwu.align;
+        fwu.tail_len = 0;
+    }
+
+    chunk = len - (len % fwu.align);
+    if (chunk > 0) {
+        status = fwu_flash_write(fwu.programmed, data, chunk);
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+        fwu.programmed += chunk;
+    }
+
+    fwu.tail_len = len - chunk;
+    memcpy(fwu.tail, &data[chunk], fwu.tail_len);
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Programs the last partial write unit, padded with the erased value.
+ */
+static psa_status_t fwu_program_flush(void)
+{
+    psa_status_t status;
+
+    if (fwu.tail_len == 0) {
+        return PSA_SUCCESS;
+    }
+
+    memset(&fwu.tail[fwu.tail_len], flash_area_erased_val(fwu.fap),
+           fwu.align - fwu.tail_len);
+    status = fwu_flash_write(fwu.programmed, fwu.tail, fwu.align);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+    fwu.programmed += fwu.align;
+    fwu.tail_len = 0;
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Erases the sectors of the slot holding the trailer, so that the
+ *        image of the slot is not installed.
+ */
+static psa_status_t fwu_erase_trailer(const struct flash_area *fap)
+{
+    uint32_t off;
+
+    for (off = fap->fa_size - FWU_TRAILER_AREA_SIZE; off < fap->fa_size;
+         off += FLASH_AREA_IMAGE_SECTOR_SIZE) {
+        if (flash_area_erase(fap, off, FLASH_AREA_IMAGE_SECTOR_SIZE) != 0) {
+            return PSA_ERROR_STORAGE_FAILURE;
+        }
+    }
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Writes a field of the trailer, padded to the write alignment.
+ */
+static psa_status_t fwu_write_trailer_flag(uint32_t off, uint8_t val)
+{
+    uint8_t buf[BOOT_MAX_ALIGN];
+
+    memset(buf, flash_area_erased_val(fwu.fap), sizeof(buf));
+    buf[0] = val;
+    if (flash_area_write(fwu.fap, off, buf, fwu.align) != 0) {
+        return PSA_ERROR_STORAGE_FAILURE;
+    }
+
+    return PSA_SUCCESS;
+}
+
+static psa_status_t fwu_start(uint32_t image_id, int32_t client_id)
+{
+    const struct flash_area *fap;
+    psa_status_t status;
+
+    fwu_reset(TFM_FWU_STATE_IDLE);
+
+    if (flash_area_open(FLASH_AREA_IMAGE_SECONDARY(image_id), &fap) != 0) {
+        return PSA_ERROR_STORAGE_FAILURE;
+    }
+
+    /* The previous image of the slot is no longer installed, also if this
+     * update does not complete.
+     */
+    status = fwu_erase_trailer(fap);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    memset(&fwu, 0, sizeof(fwu));
+    fwu.image_id = image_id;
+    fwu.client_id = client_id;
+    fwu.fap = fap;
+    fwu.limit = fap->fa_size - FWU_TRAILER_AREA_SIZE;
+    fwu.align = flash_area_align(fap);
+    if ((fwu.align == 0) || (fwu.align > BOOT_MAX_ALIGN)) {
+        return PSA_ERROR_NOT_SUPPORTED;
+    }
+
+    status = psa_hash_setup(&fwu.hash_op, PSA_ALG_SHA_256);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+    fwu.state = TFM_FWU_STATE_WRITING;
+
+    return PSA_SUCCESS;
+}
+
+static psa_status_t fwu_parse_header(void)
+{
+    const struct image_header *hdr = &fwu.hdr;
+
+    if ((hdr->ih_magic != IMAGE_MAGIC) ||
+        (hdr->ih_hdr_size < IMAGE_HEADER_SIZE)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    /* MCUBoot hashes an encrypted image in its plaintext form */
+    if (hdr->ih_flags & IMAGE_F_ENCRYPTED) {
+        return PSA_ERROR_NOT_SUPPORTED;
+    }
+
+    if (hdr->ih_img_size > fwu.limit) {
+        return PSA_ERROR_INSUFFICIENT_STORAGE;
+    }
+    fwu.hash_size = hdr->ih_hdr_size + hdr->ih_img_size +
+                    hdr->ih_protect_tlv_size;
+    if (fwu.hash_size + sizeof(struct image_tlv_info) > fwu.limit) {
+        return PSA_ERROR_INSUFFICIENT_STORAGE;
+    }
+
+    return PSA_SUCCESS;
+}
+
+static psa_status_t fwu_parse_tlv_info(void)
+{
+    struct image_tlv_info info;
+
+    memcpy(&info, fwu_tlv_buf, sizeof(info));
+    if ((info.it_magic != IMAGE_TLV_INFO_MAGIC) ||
+        (info.it_tlv_tot < sizeof(info))) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+    if (info.it_tlv_tot > sizeof(fwu_tlv_buf)) {
+        return PSA_ERROR_NOT_SUPPORTED;
+    }
+
+    fwu.image_size = fwu.hash_size + info.it_tlv_tot;
+    if (fwu.image_size > fwu.limit) {
+        return PSA_ERROR_INSUFFICIENT_STORAGE;
+    }
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Checks the hash of the image against its SHA256 TLV, and that the
+ *        image has a signature for MCUBoot to verify.
+ */
+static psa_status_t fwu_verify(void)
+{
+    struct image_tlv tlv;
+    uint32_t tlv_tot = fwu.image_size - fwu.hash_size;
+    uint32_t off = sizeof(struct image_tlv_info);
+    bool hash_valid = false;
+    bool sig_found = false;
+    psa_status_t status;
+    size_t hash_len;
+    uint8_t diff;
+    uint32_t i;
+
+    status = psa_hash_finish(&fwu.hash_op, fwu.hash, sizeof(fwu.hash),
+                             &hash_len);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    while (off < tlv_tot) {
+        if (tlv_tot - off < sizeof(tlv)) {
+            return PSA_ERROR_INVALID_ARGUMENT;
+        }
+        memcpy(&tlv, &fwu_tlv_buf[off], sizeof(tlv));
+        off += sizeof(tlv);
+        if (tlv_tot - off < tlv.it_len) {
+            return PSA_ERROR_INVALID_ARGUMENT;
+        }
+
+        if ((tlv.it_type == IMAGE_TLV_SHA256) &&
+            (tlv.it_len == sizeof(fwu.hash))) {
+            diff = 0;
+            for (i = 0; i < sizeof(fwu.hash); i++) {
+                diff |= fwu.hash[i] ^ fwu_tlv_buf[off + i];
+            }
+            hash_valid = (diff == 0);
+        } else if (FWU_IS_SIG_TLV(tlv.it_type)) {
+            sig_found = true;
+        }
+        off += tlv.it_len;
+    }
+
+    if (!hash_valid || !sig_found) {
+        return PSA_ERROR_INVALID_SIGNATURE;
+    }
+
+    return fwu_program_flush();
+}
+
+/**
+ * \brief Hashes, parses and programs the next bytes of the image.
+ */
+static psa_status_t fwu_consume(const uint8_t *data, uint32_t len)
+{
+    psa_status_t status;
+    uint32_t off, chunk;
+
+    while (len > 0) {
+        off = fwu.written;
+        if (off < IMAGE_HEADER_SIZE) {
+            chunk = fwu_min(len, IMAGE_HEADER_SIZE - off);
+            memcpy((uint8_t *)&fwu.hdr + off, data, chunk);
+            status = psa_hash_update(&fwu.hash_op, data, chunk);
+            if ((status == PSA_SUCCESS) &&
+                (off + chunk == IMAGE_HEADER_SIZE)) {
+                status = fwu_parse_header();
+            }
+        } else if (off < fwu.hash_size) {
+            chunk = fwu_min(len, fwu.hash_size - off);
+            status = psa_hash_update(&fwu.hash_op, data, chunk);
+        } else if (fwu.image_size == 0) {
+            /* The TLV info gives the size of the TLV area */
+            chunk = fwu_min(len, fwu.hash_size +
+                            sizeof(struct image_tlv_info) - off);
+            memcpy(&fwu_tlv_buf[off - fwu.hash_size], data, chunk);
+            status = PSA_SUCCESS;
+            if (off + chunk ==
+                fwu.hash_size + sizeof(struct image_tlv_info)) {
+                status = fwu_parse_tlv_info();
+            }
+        } else if (off < fwu.image_size) {
+            chunk = fwu_min(len, fwu.image_size - off);
+            memcpy(&fwu_tlv_buf[off - fwu.hash_size], data, chunk);
+            status = PSA_SUCCESS;
+        } else {
+            /* Beyond the end of the image */
+            return PSA_ERROR_INVALID_ARGUMENT;
+        }
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+
+        status = fwu_program(data, chunk);
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+        fwu.written += chunk;
+        data += chunk;
+        len -= chunk;
+    }
+
+    if ((fwu.image_size != 0) && (fwu.written == fwu.image_size)) {
+        status = fwu_verify();
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+        fwu.state = TFM_FWU_STATE_VERIFIED;
+    }
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Whether an unfinished update of another client prevents the client
+ *        from changing the update in progress.
+ */
+static bool fwu_is_busy(int32_t client_id)
+{
+    return ((fwu.state == TFM_FWU_STATE_WRITING) ||
+            (fwu.state == TFM_FWU_STATE_VERIFIED)) &&
+           (fwu.client_id != client_id);
+}
+
+static psa_status_t fwu_read_u32(const psa_msg_t *msg, uint32_t idx,
+                                 uint32_t *val)
+{
+    if ((msg->in_size[idx] != sizeof(*val)) ||
+        (psa_read(msg->handle, idx, val, sizeof(*val)) != sizeof(*val))) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    return PSA_SUCCESS;
+}
+
+static psa_status_t fwu_read_image_id(const psa_msg_t *msg,
+                                      uint32_t *image_id)
+{
+    if ((fwu_read_u32(msg, 0, image_id) != PSA_SUCCESS) ||
+        (*image_id >= MCUBOOT_IMAGE_NUMBER)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    return PSA_SUCCESS;
+}
+
+static psa_status_t fwu_write_ipc(const psa_msg_t *msg)
+{
+    uint32_t image_id, offset;
+    psa_status_t status;
+    size_t num;
+
+    if ((fwu_read_image_id(msg, &image_id) != PSA_SUCCESS) ||
+        (fwu_read_u32(msg, 1, &offset) != PSA_SUCCESS)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (fwu_is_busy(msg->client_id)) {
+        return PSA_ERROR_BAD_STATE;
+    }
+
+    if (offset == 0) {
+        status = fwu_start(image_id, msg->client_id);
+        if (status != PSA_SUCCESS) {
+            fwu_reset(TFM_FWU_STATE_IDLE);
+            return status;
+        }
+    } else if ((fwu.state != TFM_FWU_STATE_WRITING) ||
+               (fwu.image_id != image_id) || (fwu.written != offset)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    while ((num = psa_read(msg->handle, 2, fwu_data_buf,
+                           sizeof(fwu_data_buf))) > 0) {
+        status = fwu_consume(fwu_data_buf, num);
+        if (status != PSA_SUCCESS) {
+            fwu_reset(TFM_FWU_STATE_FAILED);
+            return status;
+        }
+    }
+
+    return PSA_SUCCESS;
+}
+
+static psa_status_t fwu_install_ipc(const psa_msg_t *msg)
+{
+    static const uint32_t magic[] = BOOT_FWU_TRAILER_MAGIC;
+    uint32_t image_id, permanent;
+    uint32_t magic_off;
+    psa_status_t status;
+
+    if ((fwu_read_image_id(msg, &image_id) != PSA_SUCCESS) ||
+        (fwu_read_u32(msg, 1, &permanent) != PSA_SUCCESS)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    if ((fwu.state != TFM_FWU_STATE_VERIFIED) || (fwu.image_id != image_id) ||
+        (fwu.client_id != msg->client_id)) {
+        return PSA_ERROR_BAD_STATE;
+    }
+
+    /* Same trailer fields, in the same order, as boot_set_pending(). MCUBoot
+     * hashes the image and verifies its signature again before installing it.
+     */
+    status = PSA_SUCCESS;
+    magic_off = fwu.fap->fa_size - FWU_MAGIC_SIZE;
+    if (flash_area_write(fwu.fap, magic_off, magic, FWU_MAGIC_SIZE) != 0) {
+        status = PSA_ERROR_STORAGE_FAILURE;
+    }
+    if ((status == PSA_SUCCESS) && permanent) {
+        status = fwu_write_trailer_flag(magic_off - BOOT_MAX_ALIGN,
+                                        FWU_FLAG_SET);
+    }
+    if (status == PSA_SUCCESS) {
+        status = fwu_write_trailer_flag(magic_off - 3 * BOOT_MAX_ALIGN,
+                                        (uint8_t)((image_id << 4) |
+                                                  (permanent ?
+                                                   FWU_SWAP_TYPE_PERM :
+                                                   FWU_SWAP_TYPE_TEST)));
+    }
+    if (status != PSA_SUCCESS) {
+        fwu_reset(TFM_FWU_STATE_FAILED);
+        return status;
+    }
+
+    fwu.state = TFM_FWU_STATE_INSTALLED;
+
+    return PSA_SUCCESS;
+}
+
+static psa_status_t fwu_abort_ipc(const psa_msg_t *msg)
+{
+    uint32_t image_id;
+    psa_status_t status;
+
+    if (fwu_read_image_id(msg, &image_id) != PSA_SUCCESS) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    if ((fwu.state == TFM_FWU_STATE_IDLE) || (fwu.image_id != image_id)) {
+        return PSA_SUCCESS;
+    }
+
+    if (fwu_is_busy(msg->client_id)) {
+        return PSA_ERROR_BAD_STATE;
+    }
+
+    status = fwu_erase_trailer(fwu.fap);
+    fwu_reset(TFM_FWU_STATE_IDLE);
+
+    return status;
+}
+
+static psa_status_t fwu_query_ipc(const psa_msg_t *msg)
+{
+    struct tfm_fwu_info_t info;
+    uint32_t image_id;
+
+    if ((fwu_read_image_id(msg, &image_id) != PSA_SUCCESS) ||
+        (msg->out_size[0] != sizeof(info))) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    memset(&info, 0, sizeof(info));
+    info.state = TFM_FWU_STATE_IDLE;
+    if ((fwu.state != TFM_FWU_STATE_IDLE) && (fwu.image_id == image_id)) {
+        info.state = fwu.state;
+        info.written = fwu.written;
+        info.image_size = fwu.image_size;
+    }
+    psa_write(msg->handle, 0, &info, sizeof(info));
+
+    return PSA_SUCCESS;
+}
+
+static void fwu_signal_handle(psa_signal_t signal, fwu_func_t pfn)
+{
+    psa_msg_t msg;
+    psa_status_t status;
+
+    status = psa_get(signal, &msg);
+    if (status != PSA_SUCCESS) {
+        return;
+    }
+
+    switch (msg.type) {
+    case PSA_IPC_CONNECT:
+    case PSA_IPC_DISCONNECT:
+        psa_reply(msg.handle, PSA_SUCCESS);
+        break;
+    case PSA_IPC_CALL:
+        psa_reply(msg.handle, pfn(&msg));
+        break;
+    default:
+        psa_panic();
+    }
+}
+
+void tfm_fwu_init(void)
+{
+    psa_signal_t signals;
+
+    while (1) {
+        signals = psa_wait(PSA_WAIT_ANY, PSA_BLOCK);
+        if (signals & TFM_FWU_WRITE_SIGNAL) {
+            fwu_signal_handle(TFM_FWU_WRITE_SIGNAL, fwu_write_ipc);
+        } else if (signals & TFM_FWU_INSTALL_SIGNAL) {
+            fwu_signal_handle(TFM_FWU_INSTALL_SIGNAL, fwu_install_ipc);
+        } else if (signals & TFM_FWU_ABORT_SIGNAL) {
+            fwu_signal_handle(TFM_FWU_ABORT_SIGNAL, fwu_abort_ipc);
+        } else if (signals & TFM_FWU_QUERY_SIGNAL) {
+            fwu_signal_handle(TFM_FWU_QUERY_SIGNAL, fwu_query_ipc);
+        } else {
+            psa_panic();
+        }
+    }
+}
@@ -12,6 +12,9 @@
 #include "attest_token.h"
 #include "qcbor.h"
 #include "t_cose_sign1_sign.h"
+#ifdef ATTEST_TOKEN_MAC0
+#include "t_cose_mac0_sign.h"
+#endif
 #include "t_cose_common.h"
 #include "q_useful_buf.h"
 #include "psa/crypto.h"
@@ -50,6 +53,11 @@
  *   - Run ECDSA
  * - Write signature into the CBOR output
  * - Close CBOR array holding the \c COSE_Sign1
+ *
+ * With \c ATTEST_TOKEN_MAC0 and \c T_COSE_ALGORITHM_HMAC256, the token is
+ * a \c COSE_Mac0 instead. It is laid out in the same way, but the last
+ * element is an HMAC-SHA256 tag over the \c MAC_structure, computed with a
+ * key derived from the HUK, rather than an ECDSA signature.
  */
 
 /*
@@ -83,6 +91,49 @@ static enum attest_token_err_t t_cose_err_to_attest_err(enum t_cose_err_t err)
 }
 
 
+#ifdef ATTEST_TOKEN_MAC0
+/**
+ * \brief Start a \c COSE_Mac0 token with the key derived from the HUK.
+ *
+ * \param[in] me       The token creation context.
+ * \param[in] out_buf  The output buffer to write the encoded token into.
+ *
+ * \return one of the \ref attest_token_err_t errors.
+ */
+static enum attest_token_err_t
+attest_token_start_mac0(struct attest_token_ctx *me,
+                        const struct q_useful_buf *out_buf)
+{
+    enum t_cose_err_t cose_ret;
+    enum attest_token_err_t return_value = ATTEST_TOKEN_ERR_SUCCESS;
+    struct t_cose_key mac_key;
+    psa_key_handle_t key_handle;
+
+    if (attest_get_mac0_key_handle(&key_handle) != PSA_ATTEST_ERR_SUCCESS) {
+        return ATTEST_TOKEN_ERR_SIGNING_KEY;
+    }
+    mac_key.crypto_lib = T_COSE_CRYPTO_LIB_PSA;
+    mac_key.k.key_handle = key_handle;
+
+    me->use_mac = true;
+    t_cose_mac0_sign_init(&(me->mac_ctx), 0, T_COSE_ALGORITHM_HMAC256);
+    t_cose_mac0_set_signing_key(&(me->mac_ctx), mac_key, NULL_Q_USEFUL_BUF_C);
+
+    QCBOREncode_Init(&(me->cbor_enc_ctx), *out_buf);
+
+    cose_ret = t_cose_mac0_encode_parameters(&(me->mac_ctx),
+                                             &(me->cbor_enc_ctx));
+    if (cose_ret) {
+        return_value = t_cose_err_to_attest_err(cose_ret);
+    }
+
+    QCBOREncode_OpenMap(&(me->cbor_enc_ctx));
+
+    return return_value;
+}
+#endif /* ATTEST_TOKEN_MAC0 */
+
+
 /*
  Public function. See attest_token.h
  */
@@ -104,6 +155,19 @@ enum attest_token_err_t attest_token_start(struct attest_token_ctx *me,
     me->opt_flags  = opt_flags;
     me->key_select = key_select;
 
+#ifdef ATTEST_TOKEN_MAC0
+    me->use_mac = false;
+    if (cose_alg_id == T_COSE_ALGORITHM_HMAC256) {
+        if (opt_flags & TOKEN_OPT_SHORT_CIRCUIT_SIGN) {
+            /* There is no short-circuit MAC. The test mode needs no key, so
+             * it makes a short-circuit COSE_Sign1 as without the option.
+             */
+            cose_alg_id = T_COSE_ALGORITHM_ES256;
+        } else {
+            return attest_token_start_mac0(me, out_buf);
+        }
+    }
+#endif
 
     if (opt_flags & TOKEN_OPT_SHORT_CIRCUIT_SIGN) {
         t_cose_options |= T_COSE_OPT_SHORT_CIRCUIT_SIG;
@@ -218,6 +282,19 @@ attest_token_finish(struct attest_token_ctx *me,
 
     QCBOREncode_CloseMap(&(me->cbor_enc_ctx));
 
+#ifdef ATTEST_TOKEN_MAC0
+    if (me->use_mac) {
+        /* -- Finish up the COSE_Mac0. This is where the MAC happens -- */
+        cose_return_value = t_cose_mac0_encode_tag(&(me->mac_ctx),
+                                                   &(me->cbor_enc_ctx));
+        if (cose_return_value == T_COSE_ERR_UNKNOWN_KEY) {
+            /* The key was released by the Crypto service, derive it again
+             * for the next token.
+             */
+            attest_drop_mac0_key_handle();
+        }
+    } else
+#endif
     /* -- Finish up the COSE_Sign1. This is where the signing happens -- */
     cose_return_value = t_cose_sign1_encode_signature(&(me->signer_ctx),
                                                       &(me->cbor_enc_ctx));
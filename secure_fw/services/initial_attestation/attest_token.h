@@ -15,6 +15,9 @@
 #include <stdint.h>
 #include "qcbor.h"
 #include "t_cose_sign1_sign.h"
+#ifdef ATTEST_TOKEN_MAC0
+#include "t_cose_mac0_sign.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -121,7 +124,8 @@ enum attest_token_err_t {
  *
  * The structure is opaque for the caller.
  *
- * This is roughly 148 + 8 + 32 = 188 bytes
+ * This is roughly 148 + 8 + 32 = 188 bytes, plus about 64 bytes with
+ * \c ATTEST_TOKEN_MAC0.
  */
 struct attest_token_ctx {
     /* Private data structure */
@@ -129,6 +133,10 @@ struct attest_token_ctx {
     uint32_t                     opt_flags;
     int32_t                      key_select;
     struct t_cose_sign1_sign_ctx signer_ctx;
+#ifdef ATTEST_TOKEN_MAC0
+    bool                         use_mac;
+    struct t_cose_mac0_sign_ctx  mac_ctx;
+#endif
 };
 
 
@@ -144,6 +152,10 @@ struct attest_token_ctx {
  *                        (https://tools.ietf.org/html/rfc8152) or
  *                        in the [IANA COSE Registry]
  *                        (https://www.iana.org/assignments/cose/cose.xhtml).
+ *                        With \c ATTEST_TOKEN_MAC0, \c
+ *                        T_COSE_ALGORITHM_HMAC256 makes a \c COSE_Mac0
+ *                        token with the key derived from the HUK, unless
+ *                        \ref TOKEN_OPT_SHORT_CIRCUIT_SIGN is set.
  * \param[out] out_buffer The output buffer to write the encoded token into.
  *
  * \return one of the \ref attest_token_err_t errors.
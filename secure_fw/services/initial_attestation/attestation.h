@@ -125,6 +125,39 @@ psa_status_t
 initial_attest_get_public_key(const psa_invec  *in_vec,  uint32_t num_invec,
                                     psa_outvec *out_vec, uint32_t num_outvec);
 
+/**
+ * \brief Get an initial attestation token whose challenge claim is the root of
+ *        the Merkle tree of a batch of challenges
+ *
+ * \param[in]     in_vec     Pointer to in_vec array, which contains the
+ *                           challenges and the size of each challenge
+ * \param[in]     num_invec  Number of elements in in_vec array
+ * \param[in,out] out_vec    Pointer out_vec array, which contains output data
+ *                           to attestation service
+ * \param[in]     num_outvec Number of elements in out_vec array
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+psa_status_t
+initial_attest_get_batch_token(const psa_invec  *in_vec,  uint32_t num_invec,
+                                     psa_outvec *out_vec, uint32_t num_outvec);
+
+/**
+ * \brief Get the profiling counters of the token creation
+ *
+ * \param[in]     in_vec     Pointer to in_vec array, which contains the flag
+ *                           which requests the reset of the counters
+ * \param[in]     num_invec  Number of elements in in_vec array
+ * \param[out]    out_vec    Pointer to out_vec array, which contains pointer
+ *                           where to store the counters
+ * \param[in]     num_outvec Number of elements in out_vec array
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+psa_status_t
+initial_attest_get_profile(const psa_invec  *in_vec,  uint32_t num_invec,
+                                 psa_outvec *out_vec, uint32_t num_outvec);
+
 #ifdef __cplusplus
 }
 #endif
@@ -21,6 +21,9 @@
 #include "t_cose_common.h"
 #include "tfm_memory_utils.h"
 #include "platform/include/tfm_plat_crypto_keys.h"
+#ifdef ATTEST_PROFILING
+#include "secure_fw/core/include/tfm_cycle_counter.h"
+#endif
 
 #define MAX_BOOT_STATUS 512
 
@@ -28,6 +31,15 @@
 #define EAT_SW_COMPONENT_NESTED     1  /* Nested map */
 #define EAT_SW_COMPONENT_NOT_NESTED 0  /* Flat structure */
 
+/* COSE algorithm of the tokens: an HMAC-SHA256 COSE_Mac0 with
+ * ATTEST_TOKEN_MAC0, an ES256 COSE_Sign1 otherwise.
+ */
+#ifdef ATTEST_TOKEN_MAC0
+#define ATTEST_TOKEN_COSE_ALG T_COSE_ALGORITHM_HMAC256
+#else
+#define ATTEST_TOKEN_COSE_ALG T_COSE_ALGORITHM_ES256
+#endif
+
 /*!
  * \struct attest_boot_data
  *
@@ -54,6 +66,59 @@ struct attest_boot_data {
 __attribute__ ((aligned(4)))
 static struct attest_boot_data boot_data;
 
+/*!
+ * \var boot_data_module_offset
+ *
+ * \brief Offset from the start of \ref boot_data of the first TLV entry of
+ *        each SW module, or 0 if the boot status has no entry of the module.
+ *
+ * \details Filled in once, by \ref attest_index_boot_data, so that the look
+ *          up of the entries of a module starts at its first entry instead of
+ *          at the beginning of the boot status.
+ */
+static uint16_t boot_data_module_offset[SW_MAX];
+
+/*!
+ * \brief Static function to record the first TLV entry of each SW module in
+ *        the boot status.
+ *
+ * The index is left empty if the boot status is malformed, which is then
+ * reported by the look ups.
+ */
+static void attest_index_boot_data(void)
+{
+    struct shared_data_tlv_entry tlv_entry;
+    uint8_t *tlv_end;
+    uint8_t *tlv_curr;
+    uint8_t module;
+
+    (void)tfm_memset(boot_data_module_offset, 0,
+                     sizeof(boot_data_module_offset));
+
+    if (boot_data.header.tlv_magic != SHARED_DATA_TLV_INFO_MAGIC ||
+        boot_data.header.tlv_tot_len > sizeof(boot_data)) {
+        return;
+    }
+
+    tlv_end = (uint8_t *)&boot_data + boot_data.header.tlv_tot_len;
+    for (tlv_curr = boot_data.data;
+         tlv_curr < tlv_end;
+         tlv_curr += tlv_entry.tlv_len) {
+        /* Create local copy to avoid unaligned access */
+        (void)tfm_memcpy(&tlv_entry, tlv_curr, SHARED_DATA_ENTRY_HEADER_SIZE);
+        if (tlv_entry.tlv_len < SHARED_DATA_ENTRY_HEADER_SIZE) {
+            /* Malformed entry, the entries after it cannot be found */
+            break;
+        }
+
+        module = GET_IAS_MODULE(tlv_entry.tlv_type);
+        if (module < SW_MAX && boot_data_module_offset[module] == 0) {
+            boot_data_module_offset[module] =
+                                (uint16_t)(tlv_curr - (uint8_t *)&boot_data);
+        }
+    }
+}
+
 /*!
  * \brief Static function to map return values between \ref psa_attest_err_t
  *        and \ref psa_status_t
@@ -89,6 +154,147 @@ error_mapping_to_psa_status_t(enum psa_attest_err_t attest_err)
     }
 }
 
+/*!
+ * \brief Static function to make sure that the initial attestation key is
+ *        registered to the Crypto service.
+ *
+ * The key is registered on first use and then kept loaded, so that it is
+ * parsed and its public key is computed by the Crypto service only once,
+ * rather than for each token being signed.
+ *
+ * \return Returns error code as specified in \ref psa_attest_err_t
+ */
+static enum psa_attest_err_t attest_load_initial_attestation_key(void)
+{
+    psa_key_handle_t key_handle;
+
+    if (attest_get_initial_attestation_private_key_handle(&key_handle) ==
+        PSA_ATTEST_ERR_SUCCESS) {
+        return PSA_ATTEST_ERR_SUCCESS;
+    }
+
+    return attest_register_initial_attestation_key();
+}
+
+static enum psa_attest_err_t attest_fill_claim_cache(void);
+
+#ifdef ATTEST_PROFILING
+/*!
+ * \var attest_profile
+ *
+ * \brief Profiling counters of the tokens, read and reset by
+ *        \ref initial_attest_get_profile.
+ */
+static struct tfm_initial_attest_profile_t attest_profile;
+
+static void attest_profile_init(void)
+{
+    /* The partition is a PSA RoT one, so it runs privileged and can start the
+     * cycle counter itself. Without one, only the tokens are counted.
+     */
+    (void)tfm_cycle_counter_start(false);
+}
+
+static inline uint32_t attest_profile_cycles(void)
+{
+    return tfm_cycle_counter_read();
+}
+
+/*!
+ * \brief Static function to add the cycles taken by a stage of the creation of
+ *        a token to its counter.
+ *
+ * \param[in]     token  Structure to carry the token info, no stage is counted
+ *                       when the token is only encoded to compute its size
+ * \param[in]     stage  Stage which has just completed
+ * \param[in,out] since  Cycle count at the start of the stage, updated to the
+ *                       start of the next stage
+ */
+static void attest_profile_stage(const struct q_useful_buf *token,
+                                 enum tfm_initial_attest_stage_t stage,
+                                 uint32_t *since)
+{
+    uint32_t now = attest_profile_cycles();
+
+    if (token->ptr != NULL) {
+        attest_profile.stage_cycles[stage] += (uint32_t)(now - *since);
+    }
+    *since = now;
+}
+
+/*!
+ * \brief Static function to count a token which has been created.
+ *
+ * \param[in] token  Structure to carry the token info
+ * \param[in] start  Cycle count at the start of the creation of the token
+ */
+static void attest_profile_token(const struct q_useful_buf *token,
+                                 uint32_t start)
+{
+    if (token->ptr != NULL) {
+        attest_profile.num_tokens++;
+        attest_profile.total_cycles +=
+                                  (uint32_t)(attest_profile_cycles() - start);
+    }
+}
+
+psa_status_t
+initial_attest_get_profile(const psa_invec  *in_vec,  uint32_t num_invec,
+                                 psa_outvec *out_vec, uint32_t num_outvec)
+{
+    if (num_invec != 1 || num_outvec != 1 ||
+        in_vec[0].len != sizeof(uint32_t) ||
+        out_vec[0].len != sizeof(attest_profile)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    (void)tfm_memcpy(out_vec[0].base, &attest_profile, sizeof(attest_profile));
+
+    if (*(const uint32_t *)in_vec[0].base != 0) {
+        (void)tfm_memset(&attest_profile, 0, sizeof(attest_profile));
+    }
+
+    return PSA_SUCCESS;
+}
+#else /* ATTEST_PROFILING */
+static inline void attest_profile_init(void)
+{
+}
+
+static inline uint32_t attest_profile_cycles(void)
+{
+    return 0;
+}
+
+static inline void attest_profile_stage(const struct q_useful_buf *token,
+                                        enum tfm_initial_attest_stage_t stage,
+                                        uint32_t *since)
+{
+    (void)token;
+    (void)stage;
+    (void)since;
+}
+
+static inline void attest_profile_token(const struct q_useful_buf *token,
+                                        uint32_t start)
+{
+    (void)token;
+    (void)start;
+}
+
+psa_status_t
+initial_attest_get_profile(const psa_invec  *in_vec,  uint32_t num_invec,
+                                 psa_outvec *out_vec, uint32_t num_outvec)
+{
+    (void)in_vec;
+    (void)num_invec;
+    (void)out_vec;
+    (void)num_outvec;
+
+    return PSA_ERROR_NOT_SUPPORTED;
+}
+#endif /* ATTEST_PROFILING */
+
 psa_status_t attest_init(void)
 {
     enum psa_attest_err_t res;
@@ -96,6 +302,28 @@ psa_status_t attest_init(void)
     res = attest_get_boot_data(TLV_MAJOR_IAS,
                                (struct tfm_boot_data *)&boot_data,
                                MAX_BOOT_STATUS);
+    if (res == PSA_ATTEST_ERR_SUCCESS) {
+        attest_index_boot_data();
+    }
+
+    attest_profile_init();
+
+#ifdef TFM_PSA_API
+    /* In library mode, the key is registered by the first request instead,
+     * as calls to the Crypto service are not possible during initialisation.
+     */
+    if (res == PSA_ATTEST_ERR_SUCCESS) {
+        res = attest_load_initial_attestation_key();
+    }
+
+    /* Gather the claims which do not change after boot, so that the first
+     * token does not have to. A failure is left to be reported by the token
+     * requests, which try again.
+     */
+    if (res == PSA_ATTEST_ERR_SUCCESS) {
+        (void)attest_fill_claim_cache();
+    }
+#endif
 
     return error_mapping_to_psa_status_t(res);
 }
@@ -197,8 +425,11 @@ static int32_t attest_get_tlv_by_module(uint8_t    module,
     /* Get the boundaries of TLV section where to lookup*/
     tlv_end = (uint8_t *)&boot_data + boot_data.header.tlv_tot_len;
     if (*tlv_ptr == NULL) {
-        /* At first call set to the beginning of the TLV section */
-        tlv_curr = boot_data.data;
+        /* At first call set to the first TLV entry of the module */
+        if (module >= SW_MAX || boot_data_module_offset[module] == 0) {
+            return 0;
+        }
+        tlv_curr = (uint8_t *)&boot_data + boot_data_module_offset[module];
     } else {
         /* Any subsequent call set to the next TLV entry */
         (void)tfm_memcpy(&tlv_entry, *tlv_ptr, SHARED_DATA_ENTRY_HEADER_SIZE);
@@ -264,6 +495,83 @@ static int32_t attest_get_tlv_by_id(uint8_t    claim,
     return found;
 }
 
+/*!
+ * \def ATTEST_SW_COMPONENTS_BUF_SIZE
+ *
+ * \brief Size of the buffer of the encoded SW components claim. The claim is
+ *        encoded from the boot status, and each TLV entry header is at least
+ *        as long as the CBOR headers which replace it, so only the headers of
+ *        the array and of the maps are added.
+ */
+#define ATTEST_SW_COMPONENTS_BUF_SIZE (MAX_BOOT_STATUS + 16)
+
+/*!
+ * \struct attest_claim_cache
+ *
+ * \brief Claims which do not change after boot, gathered once and then added
+ *        to each token.
+ *
+ * \details The claim values point either into \ref boot_data or into the
+ *          buffers of this structure.
+ */
+struct attest_claim_cache {
+    uint32_t valid;                        /*!< Whether the claims are
+                                            *   gathered
+                                            */
+    uint32_t check;                        /*!< Check value of the rest of
+                                            *   the structure, see
+                                            *   \ref attest_claim_cache_check
+                                            */
+    struct q_useful_buf_c boot_seed;       /*!< Boot seed */
+    struct q_useful_buf_c instance_id;     /*!< Instance ID */
+    struct q_useful_buf_c implementation_id; /*!< Implementation ID */
+    uint32_t security_lifecycle;           /*!< Security lifecycle */
+    struct q_useful_buf_c sw_components;   /*!< Encoded array of the SW
+                                            *   components, or NULL if there
+                                            *   is no SW component
+                                            */
+#ifdef INCLUDE_OPTIONAL_CLAIMS
+    struct q_useful_buf_c verification_service; /*!< Verification service
+                                                 *   indicator, or NULL
+                                                 */
+    struct q_useful_buf_c profile_definition;   /*!< Profile definition, or
+                                                 *   NULL
+                                                 */
+    struct q_useful_buf_c hw_version;           /*!< Hardware version */
+    uint8_t hw_version_buf[HW_VERSION_MAX_SIZE];
+#endif
+    uint8_t boot_seed_buf[BOOT_SEED_SIZE];
+    uint8_t instance_id_buf[INSTANCE_ID_MAX_SIZE];
+    uint8_t implementation_id_buf[IMPLEMENTATION_ID_MAX_SIZE];
+    uint8_t sw_components_buf[ATTEST_SW_COMPONENTS_BUF_SIZE];
+};
+
+static struct attest_claim_cache claim_cache;
+
+/*!
+ * \brief Static function to compute the check value of the claim cache.
+ *
+ * \details The check value is a 32-bit FNV-1a hash of the claim cache, from
+ *          the first claim to the end of the structure, which covers the
+ *          claim values held in the cache and the pointers and lengths of all
+ *          the claims. The claims are only read from the platform once, so a
+ *          corruption of the cache would otherwise be repeated in each token.
+ *
+ * \return Returns the check value
+ */
+static uint32_t attest_claim_cache_check(void)
+{
+    const uint8_t *p = (const uint8_t *)&claim_cache.boot_seed;
+    const uint8_t *end = (const uint8_t *)&claim_cache + sizeof(claim_cache);
+    uint32_t hash = 2166136261u;
+
+    while (p < end) {
+        hash = (hash ^ *p++) * 16777619u;
+    }
+
+    return hash;
+}
+
 #ifdef INDIVIDUAL_SW_COMPONENTS /* DEPRECATED */
 /*!
  * \brief Static function to add SW component related claims to attestation
@@ -271,10 +579,10 @@ static int32_t attest_get_tlv_by_id(uint8_t    claim,
  *
  *  This function translates between TLV  and CBOR encoding.
  *
- * \param[in]  token_ctx    Attestation token encoding context
- * \param[in]  tlv_id       The ID of claim
- * \param[in]  claim_value  A structure which carries a pointer and size about
- *                          the data item to be added to the token
+ * \param[in]  cbor_encode_ctx  CBOR encoding context
+ * \param[in]  tlv_id           The ID of claim
+ * \param[in]  claim_value      A structure which carries a pointer and size
+ *                              about the data item to be added to the token
  *
  * \deprecated This function is deprecated and will probably be removed
  *             in the future.
@@ -282,35 +590,35 @@ static int32_t attest_get_tlv_by_id(uint8_t    claim,
  * \return Returns error code as specified in \ref psa_attest_err_t
  */
 static enum psa_attest_err_t
-attest_add_sw_component_claim(struct attest_token_ctx *token_ctx,
+attest_add_sw_component_claim(QCBOREncodeContext *cbor_encode_ctx,
                               uint8_t tlv_id,
                               const struct q_useful_buf_c *claim_value)
 {
     switch (tlv_id) {
     case SW_MEASURE_VALUE:
-        attest_token_add_bstr(token_ctx,
-                              EAT_CBOR_SW_COMPONENT_MEASUREMENT_VALUE,
-                              claim_value);
+        QCBOREncode_AddBytesToMapN(cbor_encode_ctx,
+                                   EAT_CBOR_SW_COMPONENT_MEASUREMENT_VALUE,
+                                   *claim_value);
         break;
     case SW_MEASURE_TYPE:
-        attest_token_add_tstr(token_ctx,
-                              EAT_CBOR_SW_COMPONENT_MEASUREMENT_DESC,
-                              claim_value);
+        QCBOREncode_AddTextToMapN(cbor_encode_ctx,
+                                  EAT_CBOR_SW_COMPONENT_MEASUREMENT_DESC,
+                                  *claim_value);
         break;
     case SW_VERSION:
-        attest_token_add_tstr(token_ctx,
-                              EAT_CBOR_SW_COMPONENT_VERSION,
-                              claim_value);
+        QCBOREncode_AddTextToMapN(cbor_encode_ctx,
+                                  EAT_CBOR_SW_COMPONENT_VERSION,
+                                  *claim_value);
         break;
     case SW_SIGNER_ID:
-        attest_token_add_bstr(token_ctx,
-                              EAT_CBOR_SW_COMPONENT_SIGNER_ID,
-                              claim_value);
+        QCBOREncode_AddBytesToMapN(cbor_encode_ctx,
+                                   EAT_CBOR_SW_COMPONENT_SIGNER_ID,
+                                   *claim_value);
         break;
     case SW_TYPE:
-        attest_token_add_tstr(token_ctx,
-                              EAT_CBOR_SW_COMPONENT_MEASUREMENT_TYPE,
-                              claim_value);
+        QCBOREncode_AddTextToMapN(cbor_encode_ctx,
+                                  EAT_CBOR_SW_COMPONENT_MEASUREMENT_TYPE,
+                                  *claim_value);
         break;
     default:
         return PSA_ATTEST_ERR_GENERAL;
@@ -323,19 +631,20 @@ attest_add_sw_component_claim(struct attest_token_ctx *token_ctx,
  * \brief Static function to add the measurement data of a single SW components
  *        to the attestation token.
  *
- * \param[in]  token_ctx    Token encoding context
- * \param[in]  module       SW component identifier
- * \param[in]  tlv_address  Address of the first TLV entry in the boot status,
- *                          which belongs to this SW component.
- * \param[in]  nested_map   Flag to indicate that how to encode the SW component
- *                          measurement data: nested map or non-nested map.
+ * \param[in]  cbor_encode_ctx  CBOR encoding context
+ * \param[in]  module           SW component identifier
+ * \param[in]  tlv_address      Address of the first TLV entry in the boot
+ *                              status, which belongs to this SW component.
+ * \param[in]  nested_map       Flag to indicate that how to encode the SW
+ *                              component measurement data: nested map or
+ *                              non-nested map.
  * \deprecated This function is deprecated and will probably be removed
  *             in the future.
  *
  * \return Returns error code as specified in \ref psa_attest_err_t
  */
 static enum psa_attest_err_t
-attest_add_single_sw_measurment(struct attest_token_ctx *token_ctx,
+attest_add_single_sw_measurment(QCBOREncodeContext *cbor_encode_ctx,
                                 uint8_t module,
                                 uint8_t *tlv_address,
                                 uint32_t nested_map)
@@ -347,15 +656,12 @@ attest_add_single_sw_measurment(struct attest_token_ctx *token_ctx,
     int32_t found = 1;
     struct q_useful_buf_c claim_value;
     enum psa_attest_err_t res;
-    QCBOREncodeContext *cbor_encode_ctx;
 
     /* Create local copy to avoid unaligned access */
     (void)tfm_memcpy(&tlv_entry, tlv_address, SHARED_DATA_ENTRY_HEADER_SIZE);
     tlv_len = tlv_entry.tlv_len;
     tlv_id = GET_IAS_CLAIM(tlv_entry.tlv_type);
 
-    cbor_encode_ctx = attest_token_borrow_cbor_cntxt(token_ctx);
-
     /* Open nested map for SW component measurement claims */
     if (nested_map) {
         QCBOREncode_OpenMapInMapN(cbor_encode_ctx,
@@ -368,7 +674,7 @@ attest_add_single_sw_measurment(struct attest_token_ctx *token_ctx,
         if (GET_IAS_MEASUREMENT_CLAIM(tlv_id)) {
             claim_value.ptr = tlv_ptr + SHARED_DATA_ENTRY_HEADER_SIZE;
             claim_value.len = tlv_len - SHARED_DATA_ENTRY_HEADER_SIZE;
-            res = attest_add_sw_component_claim(token_ctx,
+            res = attest_add_sw_component_claim(cbor_encode_ctx,
                                                 tlv_id,
                                                 &claim_value);
             if (res != PSA_ATTEST_ERR_SUCCESS) {
@@ -395,10 +701,10 @@ attest_add_single_sw_measurment(struct attest_token_ctx *token_ctx,
  * \brief Static function to add the claims of a single SW components to the
  *        attestation token.
  *
- * \param[in]  token_ctx    Token encoding context
- * \param[in]  module       SW component identifier
- * \param[in]  tlv_address  Address of the first TLV entry in the boot status,
- *                          which belongs to this SW component.
+ * \param[in]  cbor_encode_ctx  CBOR encoding context
+ * \param[in]  module           SW component identifier
+ * \param[in]  tlv_address      Address of the first TLV entry in the boot
+ *                              status, which belongs to this SW component.
  *
  * \deprecated This function is deprecated and will probably be removed
  *             in the future.
@@ -406,7 +712,7 @@ attest_add_single_sw_measurment(struct attest_token_ctx *token_ctx,
  * \return Returns error code as specified in \ref psa_attest_err_t
  */
 static enum psa_attest_err_t
-attest_add_single_sw_component(struct attest_token_ctx *token_ctx,
+attest_add_single_sw_component(QCBOREncodeContext *cbor_encode_ctx,
                                uint8_t module,
                                uint8_t *tlv_address)
 {
@@ -417,7 +723,6 @@ attest_add_single_sw_component(struct attest_token_ctx *token_ctx,
     int32_t found = 1;
     uint32_t measurement_claim_cnt = 0;
     struct q_useful_buf_c claim_value;
-    QCBOREncodeContext *cbor_encode_ctx;
     enum psa_attest_err_t res;
 
     /* Create local copy to avoid unaligned access */
@@ -426,7 +731,6 @@ attest_add_single_sw_component(struct attest_token_ctx *token_ctx,
     tlv_id = GET_IAS_CLAIM(tlv_entry.tlv_type);
 
     /* Open map which stores claims belong to a SW component */
-    cbor_encode_ctx = attest_token_borrow_cbor_cntxt(token_ctx);
     QCBOREncode_OpenMap(cbor_encode_ctx);
 
     /* Look up all TLV entry which belongs to the same SW component */
@@ -437,7 +741,7 @@ attest_add_single_sw_component(struct attest_token_ctx *token_ctx,
                 /* Call only once when first measurement claim found */
                 measurement_claim_cnt++;
                 res = attest_add_single_sw_measurment(
-                                                   token_ctx,
+                                                   cbor_encode_ctx,
                                                    module,
                                                    tlv_ptr,
                                                    EAT_SW_COMPONENT_NOT_NESTED);
@@ -449,7 +753,7 @@ attest_add_single_sw_component(struct attest_token_ctx *token_ctx,
             /* Adding top level claims */
             claim_value.ptr = tlv_ptr + SHARED_DATA_ENTRY_HEADER_SIZE;
             claim_value.len = tlv_len - SHARED_DATA_ENTRY_HEADER_SIZE;
-            res = attest_add_sw_component_claim(token_ctx,
+            res = attest_add_sw_component_claim(cbor_encode_ctx,
                                                 tlv_id,
                                                 &claim_value);
             if (res != PSA_ATTEST_ERR_SUCCESS) {
@@ -473,15 +777,12 @@ attest_add_single_sw_component(struct attest_token_ctx *token_ctx,
 #endif /* INDIVIDUAL_SW_COMPONENTS */
 
 /*!
- * \brief Static function to add the claims of all SW components to the
- *        attestation token.
- *
- * \param[in]  token_ctx  Token encoding context
+ * \brief Static function to encode the claims of all SW components into the
+ *        claim cache.
  *
  * \return Returns error code as specified in \ref psa_attest_err_t
  */
-static enum psa_attest_err_t
-attest_add_all_sw_components(struct attest_token_ctx *token_ctx)
+static enum psa_attest_err_t attest_cache_sw_components_claim(void)
 {
     uint16_t tlv_len;
     uint8_t *tlv_ptr;
@@ -489,14 +790,20 @@ attest_add_all_sw_components(struct attest_token_ctx *token_ctx)
     int32_t found;
     uint32_t cnt = 0;
     uint8_t module;
-    QCBOREncodeContext *cbor_encode_ctx = NULL;
+    QCBOREncodeContext cbor_encode_ctx;
+    QCBORError qcbor_result;
 #ifdef INDIVIDUAL_SW_COMPONENTS
     enum psa_attest_err_t res;
 #else
     UsefulBufC encoded = NULLUsefulBufC;
 #endif
 
-    cbor_encode_ctx = attest_token_borrow_cbor_cntxt(token_ctx);
+    QCBOREncode_Init(&cbor_encode_ctx,
+                     (UsefulBuf){claim_cache.sw_components_buf,
+                                 sizeof(claim_cache.sw_components_buf)});
+
+    /* Open array which stores SW components claims */
+    QCBOREncode_OpenArray(&cbor_encode_ctx);
 
     /* Starting from module 1, because module 0 contains general claims which
      * are not related to SW module(i.e: boot_seed, etc.)
@@ -516,53 +823,48 @@ attest_add_all_sw_components(struct attest_token_ctx *token_ctx)
 
         if (found == 1) {
             cnt++;
-            if (cnt == 1) {
-                /* Open array which stores SW components claims */
-                QCBOREncode_OpenArrayInMapN(cbor_encode_ctx,
-                                            EAT_CBOR_ARM_LABEL_SW_COMPONENTS);
-            }
 
 #ifdef INDIVIDUAL_SW_COMPONENTS
-            res = attest_add_single_sw_component(token_ctx, module, tlv_ptr);
+            res = attest_add_single_sw_component(&cbor_encode_ctx, module,
+                                                 tlv_ptr);
             if (res != PSA_ATTEST_ERR_SUCCESS) {
                 return res;
             }
 #else
             encoded.ptr = tlv_ptr + SHARED_DATA_ENTRY_HEADER_SIZE;
             encoded.len = tlv_len - SHARED_DATA_ENTRY_HEADER_SIZE;
-            QCBOREncode_AddEncoded(cbor_encode_ctx, encoded);
+            QCBOREncode_AddEncoded(&cbor_encode_ctx, encoded);
 #endif /* INDIVIDUAL_SW_COMPONENTS */
         }
     }
 
-    if (cnt != 0) {
-        /* Close array which stores SW components claims*/
-        QCBOREncode_CloseArray(cbor_encode_ctx);
-    } else {
-        /* If there is not any SW components' measurement in the boot status
-         * then include this claim to indicate that this state is intentional
-         */
-        attest_token_add_integer(token_ctx,
-                                 EAT_CBOR_ARM_LABEL_NO_SW_COMPONENTS,
-                                 (int64_t)NO_SW_COMPONENT_FIXED_VALUE);
+    if (cnt == 0) {
+        /* There is not any SW components' measurement in the boot status */
+        claim_cache.sw_components = NULL_Q_USEFUL_BUF_C;
+        return PSA_ATTEST_ERR_SUCCESS;
+    }
+
+    /* Close array which stores SW components claims*/
+    QCBOREncode_CloseArray(&cbor_encode_ctx);
+
+    qcbor_result = QCBOREncode_Finish(&cbor_encode_ctx,
+                                      &claim_cache.sw_components);
+    if (qcbor_result != QCBOR_SUCCESS) {
+        /* Mainly means that the claim was too big for the buffer */
+        return PSA_ATTEST_ERR_GENERAL;
     }
 
     return PSA_ATTEST_ERR_SUCCESS;
 }
 
 /*!
- * \brief Static function to add boot seed claim to attestation token.
- *
- * \param[in]  token_ctx  Token encoding context
+ * \brief Static function to get the boot seed claim into the claim cache.
  *
  * \return Returns error code as specified in \ref psa_attest_err_t
  */
-static enum psa_attest_err_t
-attest_add_boot_seed_claim(struct attest_token_ctx *token_ctx)
+static enum psa_attest_err_t attest_cache_boot_seed_claim(void)
 {
-    uint8_t boot_seed[BOOT_SEED_SIZE];
     enum tfm_plat_err_t res;
-    struct q_useful_buf_c claim_value = {0};
     uint16_t tlv_len;
     uint8_t *tlv_ptr = NULL;
     int32_t found = 0;
@@ -570,31 +872,27 @@ attest_add_boot_seed_claim(struct attest_token_ctx *token_ctx)
     /* First look up BOOT_SEED in boot status, it might comes from bootloader */
     found = attest_get_tlv_by_id(BOOT_SEED, &tlv_len, &tlv_ptr);
     if (found == 1) {
-        claim_value.ptr = tlv_ptr + SHARED_DATA_ENTRY_HEADER_SIZE;
-        claim_value.len = tlv_len - SHARED_DATA_ENTRY_HEADER_SIZE;
+        claim_cache.boot_seed.ptr = tlv_ptr + SHARED_DATA_ENTRY_HEADER_SIZE;
+        claim_cache.boot_seed.len = tlv_len - SHARED_DATA_ENTRY_HEADER_SIZE;
     } else {
         /* If not found in boot status then use callback function to get it
          * from runtime SW
          */
-        res = tfm_plat_get_boot_seed(sizeof(boot_seed), boot_seed);
+        res = tfm_plat_get_boot_seed(sizeof(claim_cache.boot_seed_buf),
+                                     claim_cache.boot_seed_buf);
         if (res != TFM_PLAT_ERR_SUCCESS) {
             return PSA_ATTEST_ERR_CLAIM_UNAVAILABLE;
         }
-        claim_value.ptr = boot_seed;
-        claim_value.len = BOOT_SEED_SIZE;
+        claim_cache.boot_seed.ptr = claim_cache.boot_seed_buf;
+        claim_cache.boot_seed.len = BOOT_SEED_SIZE;
     }
 
-    attest_token_add_bstr(token_ctx,
-                          EAT_CBOR_ARM_LABEL_BOOT_SEED,
-                          &claim_value);
-
     return PSA_ATTEST_ERR_SUCCESS;
 }
 
 /*!
- * \brief Static function to add instance id claim to attestation token.
- *
- * \param[in]  token_ctx  Token encoding context
+ * \brief Static function to compute the instance id claim into the claim
+ *        cache.
  *
  * \note This mandatory claim represents the unique identifier of the instance.
  *       In the PSA definition it is a hash of the public attestation key of the
@@ -605,14 +903,12 @@ attest_add_boot_seed_claim(struct attest_token_ctx *token_ctx)
  *
  * \return Returns error code as specified in \ref psa_attest_err_t
  */
-static enum psa_attest_err_t
-attest_add_instance_id_claim(struct attest_token_ctx *token_ctx)
+static enum psa_attest_err_t attest_cache_instance_id_claim(void)
 {
     psa_status_t crypto_res;
     enum psa_attest_err_t attest_res;
-    uint8_t instance_id[INSTANCE_ID_MAX_SIZE];
+    uint8_t *instance_id = claim_cache.instance_id_buf;
     size_t instance_id_len;
-    struct q_useful_buf_c claim_value;
     uint8_t *public_key;
     size_t key_len;
     psa_ecc_curve_t psa_curve;
@@ -647,40 +943,32 @@ attest_add_instance_id_claim(struct attest_token_ctx *token_ctx)
     instance_id[0] = 0x01;
     instance_id_len += 1;
 
-    claim_value.ptr = instance_id;
-    claim_value.len = instance_id_len;
-    attest_token_add_bstr(token_ctx,
-                          EAT_CBOR_ARM_LABEL_UEID,
-                          &claim_value);
+    claim_cache.instance_id.ptr = instance_id;
+    claim_cache.instance_id.len = instance_id_len;
 
     return PSA_ATTEST_ERR_SUCCESS;
 }
 
 /*!
- * \brief Static function to add implementation id claim to attestation token.
- *
- * \param[in]  token_ctx  Token encoding context
+ * \brief Static function to get the implementation id claim into the claim
+ *        cache.
  *
  * \return Returns error code as specified in \ref psa_attest_err_t
  */
-static enum psa_attest_err_t
-attest_add_implementation_id_claim(struct attest_token_ctx *token_ctx)
+static enum psa_attest_err_t attest_cache_implementation_id_claim(void)
 {
-    uint8_t implementation_id[IMPLEMENTATION_ID_MAX_SIZE];
     enum tfm_plat_err_t res_plat;
-    uint32_t size = sizeof(implementation_id);
-    struct q_useful_buf_c claim_value;
+    uint32_t size = sizeof(claim_cache.implementation_id_buf);
 
-    res_plat = tfm_plat_get_implementation_id(&size, implementation_id);
+    res_plat = tfm_plat_get_implementation_id(
+                                            &size,
+                                            claim_cache.implementation_id_buf);
     if (res_plat != TFM_PLAT_ERR_SUCCESS) {
         return PSA_ATTEST_ERR_CLAIM_UNAVAILABLE;
     }
 
-    claim_value.ptr = implementation_id;
-    claim_value.len  = size;
-    attest_token_add_bstr(token_ctx,
-                          EAT_CBOR_ARM_LABEL_IMPLEMENTATION_ID,
-                          &claim_value);
+    claim_cache.implementation_id.ptr = claim_cache.implementation_id_buf;
+    claim_cache.implementation_id.len = size;
 
     return PSA_ATTEST_ERR_SUCCESS;
 }
@@ -711,14 +999,12 @@ attest_add_caller_id_claim(struct attest_token_ctx *token_ctx)
 }
 
 /*!
- * \brief Static function to add security lifecycle claim to attestation token.
- *
- * \param[in]  token_ctx  Token encoding context
+ * \brief Static function to get the security lifecycle claim into the claim
+ *        cache.
  *
  * \return Returns error code as specified in \ref psa_attest_err_t
  */
-static enum psa_attest_err_t
-attest_add_security_lifecycle_claim(struct attest_token_ctx *token_ctx)
+static enum psa_attest_err_t attest_cache_security_lifecycle_claim(void)
 {
     enum tfm_security_lifecycle_t security_lifecycle;
     uint32_t slc_value;
@@ -752,9 +1038,7 @@ attest_add_security_lifecycle_claim(struct attest_token_ctx *token_ctx)
         return PSA_ATTEST_ERR_GENERAL;
     }
 
-    attest_token_add_integer(token_ctx,
-                             EAT_CBOR_ARM_LABEL_SECURITY_LIFECYCLE,
-                             (int64_t)security_lifecycle);
+    claim_cache.security_lifecycle = (uint32_t)security_lifecycle;
 
     return PSA_ATTEST_ERR_SUCCESS;
 }
@@ -778,70 +1062,38 @@ attest_add_challenge_claim(struct attest_token_ctx   *token_ctx,
 
 #ifdef INCLUDE_OPTIONAL_CLAIMS /* Remove them from release build */
 /*!
- * \brief Static function to add the verification service indicator claim
- *        to the attestation token.
- *
- * \param[in]  token_ctx  Token encoding context
+ * \brief Static function to get the verification service indicator claim and
+ *        the name of the profile definition document into the claim cache.
  *
  * \return Returns error code as specified in \ref psa_attest_err_t
  */
-static enum psa_attest_err_t
-attest_add_verification_service(struct attest_token_ctx *token_ctx)
+static enum psa_attest_err_t attest_cache_service_claims(void)
 {
-    struct q_useful_buf_c service;
     uint32_t size;
 
-    service.ptr = tfm_attest_hal_get_verification_service(&size);
+    claim_cache.verification_service.ptr =
+                                tfm_attest_hal_get_verification_service(&size);
+    claim_cache.verification_service.len =
+                        claim_cache.verification_service.ptr ? size : 0;
 
-    if (service.ptr) {
-        service.len = size;
-        attest_token_add_tstr(token_ctx,
-                              EAT_CBOR_ARM_LABEL_ORIGINATION,
-                              &service);
-    }
+    claim_cache.profile_definition.ptr =
+                                tfm_attest_hal_get_profile_definition(&size);
+    claim_cache.profile_definition.len =
+                        claim_cache.profile_definition.ptr ? size : 0;
 
     return PSA_ATTEST_ERR_SUCCESS;
 }
 
 /*!
- * \brief Static function to add the name of the profile definition document
- *
- * \param[in]  token_ctx  Token encoding context
+ * \brief Static function to get the hardware version claim into the claim
+ *        cache.
  *
  * \return Returns error code as specified in \ref psa_attest_err_t
  */
-static enum psa_attest_err_t
-attest_add_profile_definition(struct attest_token_ctx *token_ctx)
+static enum psa_attest_err_t attest_cache_hw_version_claim(void)
 {
-    struct q_useful_buf_c profile;
-    uint32_t size;
-
-    profile.ptr = tfm_attest_hal_get_profile_definition(&size);
-
-    if (profile.ptr) {
-        profile.len = size;
-        attest_token_add_tstr(token_ctx,
-                              EAT_CBOR_ARM_LABEL_PROFILE_DEFINITION,
-                              &profile);
-    }
-
-    return PSA_ATTEST_ERR_SUCCESS;
-}
-
-/*!
- * \brief Static function to add hardware version claim to attestation token.
- *
- * \param[in]  token_ctx  Token encoding context
- *
- * \return Returns error code as specified in \ref psa_attest_err_t
- */
-static enum psa_attest_err_t
-attest_add_hw_version_claim(struct attest_token_ctx *token_ctx)
-{
-    uint8_t hw_version[HW_VERSION_MAX_SIZE];
     enum tfm_plat_err_t res_plat;
-    uint32_t size = sizeof(hw_version);
-    struct q_useful_buf_c claim_value = {0};
+    uint32_t size = sizeof(claim_cache.hw_version_buf);
     uint16_t tlv_len;
     uint8_t *tlv_ptr = NULL;
     int32_t found = 0;
@@ -851,27 +1103,144 @@ attest_add_hw_version_claim(struct attest_token_ctx *token_ctx)
      */
     found = attest_get_tlv_by_id(HW_VERSION, &tlv_len, &tlv_ptr);
     if (found == 1) {
-        claim_value.ptr = tlv_ptr + SHARED_DATA_ENTRY_HEADER_SIZE;
-        claim_value.len = tlv_len - SHARED_DATA_ENTRY_HEADER_SIZE;
+        claim_cache.hw_version.ptr = tlv_ptr + SHARED_DATA_ENTRY_HEADER_SIZE;
+        claim_cache.hw_version.len = tlv_len - SHARED_DATA_ENTRY_HEADER_SIZE;
     } else {
         /* If not found in boot status then use callback function to get it
          * from runtime SW
          */
-        res_plat = tfm_plat_get_hw_version(&size, hw_version);
+        res_plat = tfm_plat_get_hw_version(&size, claim_cache.hw_version_buf);
         if (res_plat != TFM_PLAT_ERR_SUCCESS) {
             return PSA_ATTEST_ERR_CLAIM_UNAVAILABLE;
         }
-        claim_value.ptr = hw_version;
-        claim_value.len = size;
+        claim_cache.hw_version.ptr = claim_cache.hw_version_buf;
+        claim_cache.hw_version.len = size;
     }
 
-    attest_token_add_tstr(token_ctx,
-                          EAT_CBOR_ARM_LABEL_HW_VERSION,
-                          &claim_value);
+    return PSA_ATTEST_ERR_SUCCESS;
+}
+#endif /* INCLUDE_OPTIONAL_CLAIMS */
+
+/*!
+ * \brief Static function to gather the claims which do not change after boot
+ *        into the claim cache, if they are not gathered yet.
+ *
+ * \note The instance id is computed from the public attestation key, so the
+ *       key must be registered first.
+ *
+ * \return Returns error code as specified in \ref psa_attest_err_t
+ */
+static enum psa_attest_err_t attest_fill_claim_cache(void)
+{
+    enum psa_attest_err_t res;
+
+    if (claim_cache.valid) {
+        if (claim_cache.check == attest_claim_cache_check()) {
+            return PSA_ATTEST_ERR_SUCCESS;
+        }
+
+        /* The cache is corrupted, gather the claims again */
+        (void)tfm_memset(&claim_cache, 0, sizeof(claim_cache));
+    }
+
+    res = attest_cache_boot_seed_claim();
+    if (res != PSA_ATTEST_ERR_SUCCESS) {
+        return res;
+    }
+
+    res = attest_cache_instance_id_claim();
+    if (res != PSA_ATTEST_ERR_SUCCESS) {
+        return res;
+    }
+
+    res = attest_cache_implementation_id_claim();
+    if (res != PSA_ATTEST_ERR_SUCCESS) {
+        return res;
+    }
+
+    res = attest_cache_security_lifecycle_claim();
+    if (res != PSA_ATTEST_ERR_SUCCESS) {
+        return res;
+    }
+
+    res = attest_cache_sw_components_claim();
+    if (res != PSA_ATTEST_ERR_SUCCESS) {
+        return res;
+    }
+
+#ifdef INCLUDE_OPTIONAL_CLAIMS
+    res = attest_cache_service_claims();
+    if (res != PSA_ATTEST_ERR_SUCCESS) {
+        return res;
+    }
+
+    res = attest_cache_hw_version_claim();
+    if (res != PSA_ATTEST_ERR_SUCCESS) {
+        return res;
+    }
+#endif
+
+    claim_cache.check = attest_claim_cache_check();
+    claim_cache.valid = 1;
 
     return PSA_ATTEST_ERR_SUCCESS;
 }
+
+/*!
+ * \brief Static function to add the claims of the claim cache to the
+ *        attestation token.
+ *
+ * \param[in]  token_ctx  Token encoding context
+ */
+static void attest_add_cached_claims(struct attest_token_ctx *token_ctx)
+{
+    /* Mandatory claims in IAT token */
+    attest_token_add_bstr(token_ctx,
+                          EAT_CBOR_ARM_LABEL_BOOT_SEED,
+                          &claim_cache.boot_seed);
+    attest_token_add_bstr(token_ctx,
+                          EAT_CBOR_ARM_LABEL_UEID,
+                          &claim_cache.instance_id);
+    attest_token_add_bstr(token_ctx,
+                          EAT_CBOR_ARM_LABEL_IMPLEMENTATION_ID,
+                          &claim_cache.implementation_id);
+    attest_token_add_integer(token_ctx,
+                             EAT_CBOR_ARM_LABEL_SECURITY_LIFECYCLE,
+                             (int64_t)claim_cache.security_lifecycle);
+
+    if (claim_cache.sw_components.ptr != NULL) {
+        /* The array of the SW components is spliced in as it is encoded */
+        attest_token_add_encoded(token_ctx,
+                                 EAT_CBOR_ARM_LABEL_SW_COMPONENTS,
+                                 &claim_cache.sw_components);
+    } else {
+        /* If there is not any SW components' measurement in the boot status
+         * then include this claim to indicate that this state is intentional
+         */
+        attest_token_add_integer(token_ctx,
+                                 EAT_CBOR_ARM_LABEL_NO_SW_COMPONENTS,
+                                 (int64_t)NO_SW_COMPONENT_FIXED_VALUE);
+    }
+
+#ifdef INCLUDE_OPTIONAL_CLAIMS
+    /* Optional claims in IAT token, remove them from release build */
+    if (claim_cache.verification_service.ptr != NULL) {
+        attest_token_add_tstr(token_ctx,
+                              EAT_CBOR_ARM_LABEL_ORIGINATION,
+                              &claim_cache.verification_service);
+    }
+
+    if (claim_cache.profile_definition.ptr != NULL) {
+        attest_token_add_tstr(token_ctx,
+                              EAT_CBOR_ARM_LABEL_PROFILE_DEFINITION,
+                              &claim_cache.profile_definition);
+    }
+
+    attest_token_add_tstr(token_ctx,
+                          EAT_CBOR_ARM_LABEL_HW_VERSION,
+                          &claim_cache.hw_version);
 #endif /* INCLUDE_OPTIONAL_CLAIMS */
+}
 
 /*!
  * \brief Static function to verify the input challenge size
@@ -972,11 +1341,14 @@ attest_create_token(struct q_useful_buf_c *challenge,
     struct attest_token_ctx attest_token_ctx;
     int32_t key_select = 0;
     uint32_t option_flags = 0;
+    uint32_t start = attest_profile_cycles();
+    uint32_t stage_start = start;
 
-    attest_err = attest_register_initial_attestation_key();
+    attest_err = attest_load_initial_attestation_key();
     if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
-        goto error;
+        return attest_err;
     }
+    attest_profile_stage(token, TFM_INITIAL_ATTEST_STAGE_KEY, &stage_start);
 
 #ifdef INCLUDE_TEST_CODE /* Remove them from release build */
     attest_get_option_flags(challenge, &option_flags, &key_select);
@@ -988,7 +1360,7 @@ attest_create_token(struct q_useful_buf_c *challenge,
     token_err = attest_token_start(&attest_token_ctx,
                                    option_flags,            /* option_flags */
                                    key_select,              /* key_select   */
-                                   T_COSE_ALGORITHM_ES256,  /* alg_select   */
+                                   ATTEST_TOKEN_COSE_ALG,   /* alg_select   */
                                    token);
 
     if (token_err != ATTEST_TOKEN_ERR_SUCCESS) {
@@ -1003,55 +1375,25 @@ attest_create_token(struct q_useful_buf_c *challenge,
     }
 
     if (!(option_flags & TOKEN_OPT_OMIT_CLAIMS)) {
-        /* Mandatory claims in IAT token */
-        attest_err = attest_add_boot_seed_claim(&attest_token_ctx);
-        if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
-            goto error;
-        }
+        attest_profile_stage(token, TFM_INITIAL_ATTEST_STAGE_ENCODE,
+                             &stage_start);
 
-        attest_err = attest_add_instance_id_claim(&attest_token_ctx);
-        if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
-            goto error;
-        }
-
-        attest_err = attest_add_implementation_id_claim(&attest_token_ctx);
+        /* The claims which do not change after boot are gathered once */
+        attest_err = attest_fill_claim_cache();
         if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
             goto error;
         }
+        attest_profile_stage(token, TFM_INITIAL_ATTEST_STAGE_CLAIMS,
+                             &stage_start);
 
         attest_err = attest_add_caller_id_claim(&attest_token_ctx);
         if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
             goto error;
         }
 
-        attest_err = attest_add_security_lifecycle_claim(&attest_token_ctx);
-        if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
-            goto error;
-        }
-
-        attest_err = attest_add_all_sw_components(&attest_token_ctx);
-        if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
-            goto error;
-        }
-
-#ifdef INCLUDE_OPTIONAL_CLAIMS
-        /* Optional claims in IAT token, remove them from release build */
-        attest_err = attest_add_verification_service(&attest_token_ctx);
-        if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
-            goto error;
-        }
-
-        attest_err = attest_add_profile_definition(&attest_token_ctx);
-        if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
-            goto error;
-        }
-
-        attest_err = attest_add_hw_version_claim(&attest_token_ctx);
-        if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
-            goto error;
-        }
-#endif /* INCLUDE_OPTIONAL_CLAIMS */
+        attest_add_cached_claims(&attest_token_ctx);
     }
+    attest_profile_stage(token, TFM_INITIAL_ATTEST_STAGE_ENCODE, &stage_start);
 
     /* Finish up creating the token. This is where the actual signature
      * is generated. This finishes up the CBOR encoding too.
@@ -1061,16 +1403,11 @@ attest_create_token(struct q_useful_buf_c *challenge,
         attest_err = error_mapping_to_psa_attest_err_t(token_err);
         goto error;
     }
+    attest_profile_stage(token, TFM_INITIAL_ATTEST_STAGE_SIGN, &stage_start);
+    attest_profile_token(token, start);
 
 error:
-    if (attest_err == PSA_ATTEST_ERR_SUCCESS) {
-        /* We got here normally and therefore care about error codes. */
-        attest_err = attest_unregister_initial_attestation_key();
-    }
-    else {
-        /* Error handler: just remove they key and preserve error. */
-        (void)attest_unregister_initial_attestation_key();
-    }
+    /* The key is kept registered for the following tokens */
     return attest_err;
 }
 
@@ -1110,6 +1447,74 @@ error:
     return error_mapping_to_psa_status_t(attest_err);
 }
 
+/* Number of allowed challenge sizes */
+#define ATTEST_CHALLENGE_SIZE_NUM 3
+
+/* Number of possible lengths of an encoded CBOR integer: 1, 2, 3, 5 or 9
+ * bytes
+ */
+#define ATTEST_CBOR_INT_LEN_NUM 5
+
+/*!
+ * \var token_size_cache
+ *
+ * \brief Size of the tokens, indexed by the size of the challenge and by the
+ *        length of the encoded caller ID.
+ *
+ * \details All the other claims are the same in every token after boot, and
+ *          the signature has a fixed size, so these are the only parts of a
+ *          token whose size varies. Each size is computed once, by encoding a
+ *          token in size-only mode, and is 0 until then.
+ */
+static uint32_t token_size_cache[ATTEST_CHALLENGE_SIZE_NUM]
+                                [ATTEST_CBOR_INT_LEN_NUM];
+
+/*!
+ * \brief Static function to get the index of an allowed challenge size.
+ *
+ * \param[in] challenge_size  Size of challenge object in bytes, which has been
+ *                            verified.
+ *
+ * \return Returns the index of the challenge size
+ */
+static uint32_t attest_challenge_size_idx(size_t challenge_size)
+{
+    switch (challenge_size) {
+    case PSA_INITIAL_ATTEST_CHALLENGE_SIZE_32:
+        return 0;
+    case PSA_INITIAL_ATTEST_CHALLENGE_SIZE_48:
+        return 1;
+    default:
+        return 2;
+    }
+}
+
+/*!
+ * \brief Static function to get the index of the length of an integer once
+ *        encoded in CBOR, as done by QCBOR.
+ *
+ * \param[in] value  Integer to encode
+ *
+ * \return Returns the index of the encoded length
+ */
+static uint32_t attest_cbor_int_len_idx(int64_t value)
+{
+    /* Negative integers are encoded as -1 - value */
+    uint64_t arg = (value < 0) ? (uint64_t)(-1 - value) : (uint64_t)value;
+
+    if (arg < 24) {
+        return 0;
+    } else if (arg <= UINT8_MAX) {
+        return 1;
+    } else if (arg <= UINT16_MAX) {
+        return 2;
+    } else if (arg <= UINT32_MAX) {
+        return 3;
+    }
+
+    return 4;
+}
+
 psa_status_t
 initial_attest_get_token_size(const psa_invec  *in_vec,  uint32_t num_invec,
                                     psa_outvec *out_vec, uint32_t num_outvec)
@@ -1120,6 +1525,8 @@ initial_attest_get_token_size(const psa_invec  *in_vec,  uint32_t num_invec,
     struct q_useful_buf_c challenge;
     struct q_useful_buf token;
     struct q_useful_buf_c completed_token;
+    uint32_t *cached_size;
+    int32_t caller_id;
 
     /* Only the size of the challenge is needed */
     challenge.ptr = NULL;
@@ -1139,16 +1546,219 @@ initial_attest_get_token_size(const psa_invec  *in_vec,  uint32_t num_invec,
         goto error;
     }
 
+    attest_err = attest_get_caller_client_id(&caller_id);
+    if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
+        goto error;
+    }
+
+    cached_size = &token_size_cache[attest_challenge_size_idx(challenge_size)]
+                                   [attest_cbor_int_len_idx(caller_id)];
+    if (*cached_size == 0) {
+        attest_err = attest_create_token(&challenge, &token, &completed_token);
+        if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
+            goto error;
+        }
+
+        *cached_size = completed_token.len;
+    }
+
+    *token_buf_size = *cached_size;
+
+error:
+    return error_mapping_to_psa_status_t(attest_err);
+}
+
+#ifdef ATTEST_BATCH_TOKEN
+/* Size of the nodes of the Merkle tree of a batch, which is also the size of
+ * the challenge claim of a batch token
+ */
+#define ATTEST_BATCH_NODE_SIZE PSA_HASH_SIZE(PSA_ALG_SHA_256)
+
+/* Prefixes which separate the hashes of the leaves from the hashes of the
+ * inner nodes of the Merkle tree
+ */
+#define ATTEST_BATCH_LEAF_PREFIX 0x00
+#define ATTEST_BATCH_NODE_PREFIX 0x01
+
+/* Nodes of the Merkle tree, the levels of the tree are computed in place */
+static uint8_t batch_nodes[TFM_INITIAL_ATTEST_BATCH_MAX_CHALLENGES]
+                          [ATTEST_BATCH_NODE_SIZE];
+
+/*!
+ * \brief Static function to hash a node of the Merkle tree of a batch
+ *
+ * \param[in]  prefix  Prefix of the node, leaf or inner node
+ * \param[in]  first   First part of the hashed data
+ * \param[in]  second  Second part of the hashed data, can be empty
+ * \param[out] node    Buffer of \ref ATTEST_BATCH_NODE_SIZE bytes to store the
+ *                     hash
+ *
+ * \return Returns error code as specified in \ref psa_attest_err_t
+ */
+static enum psa_attest_err_t
+attest_batch_hash_node(uint8_t prefix,
+                       struct q_useful_buf_c first,
+                       struct q_useful_buf_c second,
+                       uint8_t *node)
+{
+    uint8_t data[1 + PSA_INITIAL_ATTEST_CHALLENGE_SIZE_64];
+    size_t hash_len;
+    psa_status_t crypto_res;
+
+    if (first.len + second.len > sizeof(data) - 1) {
+        return PSA_ATTEST_ERR_INVALID_INPUT;
+    }
+
+    data[0] = prefix;
+    (void)tfm_memcpy(&data[1], first.ptr, first.len);
+    if (second.len != 0) {
+        (void)tfm_memcpy(&data[1 + first.len], second.ptr, second.len);
+    }
+
+    crypto_res = psa_hash_compute(PSA_ALG_SHA_256,
+                                  data, 1 + first.len + second.len,
+                                  node, ATTEST_BATCH_NODE_SIZE, &hash_len);
+    if (crypto_res != PSA_SUCCESS || hash_len != ATTEST_BATCH_NODE_SIZE) {
+        return PSA_ATTEST_ERR_GENERAL;
+    }
+
+    return PSA_ATTEST_ERR_SUCCESS;
+}
+
+/*!
+ * \brief Static function to compute the root of the Merkle tree of a batch of
+ *        challenges
+ *
+ * \param[in]  challenges      Pointer to the challenges, one after the other
+ * \param[in]  challenge_size  Size of each challenge in bytes
+ * \param[in]  num_challenges  Number of challenges
+ * \param[out] root            Buffer of \ref ATTEST_BATCH_NODE_SIZE bytes to
+ *                             store the root
+ *
+ * \return Returns error code as specified in \ref psa_attest_err_t
+ */
+static enum psa_attest_err_t
+attest_batch_merkle_root(const uint8_t *challenges, size_t challenge_size,
+                         uint32_t num_challenges, uint8_t *root)
+{
+    enum psa_attest_err_t attest_err;
+    struct q_useful_buf_c left;
+    struct q_useful_buf_c right;
+    uint32_t num_nodes = num_challenges;
+    uint32_t i;
+
+    for (i = 0; i < num_challenges; i++) {
+        left.ptr = &challenges[i * challenge_size];
+        left.len = challenge_size;
+        attest_err = attest_batch_hash_node(ATTEST_BATCH_LEAF_PREFIX,
+                                            left, NULL_Q_USEFUL_BUF_C,
+                                            batch_nodes[i]);
+        if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
+            return attest_err;
+        }
+    }
+
+    /* Each level overwrites the start of the previous one, which is not read
+     * again once its pair of nodes has been hashed.
+     */
+    while (num_nodes > 1) {
+        for (i = 0; i < num_nodes / 2; i++) {
+            left.ptr = batch_nodes[2 * i];
+            left.len = ATTEST_BATCH_NODE_SIZE;
+            right.ptr = batch_nodes[2 * i + 1];
+            right.len = ATTEST_BATCH_NODE_SIZE;
+            attest_err = attest_batch_hash_node(ATTEST_BATCH_NODE_PREFIX,
+                                                left, right, batch_nodes[i]);
+            if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
+                return attest_err;
+            }
+        }
+
+        /* A node without a sibling moves up unchanged */
+        if (num_nodes & 1) {
+            (void)tfm_memcpy(batch_nodes[num_nodes / 2],
+                             batch_nodes[num_nodes - 1],
+                             ATTEST_BATCH_NODE_SIZE);
+        }
+
+        num_nodes = (num_nodes + 1) / 2;
+    }
+
+    (void)tfm_memcpy(root, batch_nodes[0], ATTEST_BATCH_NODE_SIZE);
+
+    return PSA_ATTEST_ERR_SUCCESS;
+}
+
+psa_status_t
+initial_attest_get_batch_token(const psa_invec  *in_vec,  uint32_t num_invec,
+                                     psa_outvec *out_vec, uint32_t num_outvec)
+{
+    enum psa_attest_err_t attest_err = PSA_ATTEST_ERR_SUCCESS;
+    uint8_t root[ATTEST_BATCH_NODE_SIZE];
+    size_t challenge_size;
+    size_t num_challenges;
+    struct q_useful_buf_c challenge;
+    struct q_useful_buf token;
+    struct q_useful_buf_c completed_token;
+
+    if (num_invec != 2 || num_outvec != 1 ||
+        in_vec[1].len != sizeof(challenge_size)) {
+        attest_err = PSA_ATTEST_ERR_INVALID_INPUT;
+        goto error;
+    }
+
+    challenge_size = *(size_t *)in_vec[1].base;
+    token.ptr = out_vec[0].base;
+    token.len = out_vec[0].len;
+
+    attest_err = attest_verify_challenge_size(challenge_size);
+    if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
+        goto error;
+    }
+
+    num_challenges = in_vec[0].len / challenge_size;
+    if (num_challenges == 0 ||
+        num_challenges > TFM_INITIAL_ATTEST_BATCH_MAX_CHALLENGES ||
+        in_vec[0].len != num_challenges * challenge_size ||
+        token.len == 0) {
+        attest_err = PSA_ATTEST_ERR_INVALID_INPUT;
+        goto error;
+    }
+
+    attest_err = attest_batch_merkle_root(in_vec[0].base, challenge_size,
+                                          (uint32_t)num_challenges, root);
+    if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
+        goto error;
+    }
+
+    /* The root is signed in place of a single challenge */
+    challenge.ptr = root;
+    challenge.len = sizeof(root);
+
     attest_err = attest_create_token(&challenge, &token, &completed_token);
     if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
         goto error;
     }
 
-    *token_buf_size = completed_token.len;
+    out_vec[0].base = (void *)completed_token.ptr;
+    out_vec[0].len  = completed_token.len;
 
 error:
     return error_mapping_to_psa_status_t(attest_err);
 }
+#else /* ATTEST_BATCH_TOKEN */
+psa_status_t
+initial_attest_get_batch_token(const psa_invec  *in_vec,  uint32_t num_invec,
+                                     psa_outvec *out_vec, uint32_t num_outvec)
+{
+    (void)in_vec;
+    (void)num_invec;
+    (void)out_vec;
+    (void)num_outvec;
+
+    return PSA_ERROR_NOT_SUPPORTED;
+}
+#endif /* ATTEST_BATCH_TOKEN */
 
 psa_status_t
 initial_attest_get_public_key(const psa_invec  *in_vec,  uint32_t num_invec,
@@ -1176,6 +1786,11 @@ initial_attest_get_public_key(const psa_invec  *in_vec,  uint32_t num_invec,
         goto error;
     }
 
+    attest_err = attest_load_initial_attestation_key();
+    if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
+        goto error;
+    }
+
     attest_err = attest_get_initial_attestation_public_key(&key_source,
                                                            &key_len,
                                                            &curve_type);
@@ -15,6 +15,9 @@
 #include "t_cose_standard_constants.h"
 #include "q_useful_buf.h"
 #include "qcbor.h"
+#ifdef ATTEST_TOKEN_MAC0
+#include "tfm_crypto_defs.h"
+#endif
 
 #define ECC_P256_PUBLIC_KEY_SIZE PSA_KEY_EXPORT_ECC_PUBLIC_KEY_MAX_SIZE(256)
 
@@ -51,6 +54,18 @@ static psa_ecc_curve_t attestation_key_curve;
 static uint8_t attestation_key_id[PSA_HASH_SIZE(PSA_ALG_SHA_256)]; /* 32bytes */
 #endif
 
+#ifdef ATTEST_TOKEN_MAC0
+/* Label of the HMAC key derived from the HUK to MAC the tokens */
+static const uint8_t attestation_mac_key_label[] = "attest_mac0_key";
+
+/**
+ * Key handle for the HMAC key. It is derived on first use and then kept
+ * loaded, as it is used for each token.
+ */
+static psa_key_handle_t attestation_mac_key_handle =
+                                                  ATTEST_KEY_HANDLE_NOT_LOADED;
+#endif
+
 enum psa_attest_err_t
 attest_register_initial_attestation_key()
 {
@@ -105,6 +120,18 @@ attest_register_initial_attestation_key()
         attestation_key_curve = psa_curve;
     }
 
+#ifdef INCLUDE_COSE_KEY_ID
+    {
+        struct q_useful_buf_c attest_key_id;
+
+        /* Compute the key ID along with the registration, so that its COSE_Key
+         * encoding and hash are not left to the first token. On failure, it
+         * is computed again when a token needs it.
+         */
+        (void)attest_get_initial_attestation_key_id(&attest_key_id);
+    }
+#endif
+
     return PSA_ATTEST_ERR_SUCCESS;
 }
 
@@ -139,6 +166,60 @@ attest_get_initial_attestation_private_key_handle(psa_key_handle_t *handle)
     return PSA_ATTEST_ERR_SUCCESS;
 }
 
+#ifdef ATTEST_TOKEN_MAC0
+enum psa_attest_err_t
+attest_get_mac0_key_handle(psa_key_handle_t *handle)
+{
+    psa_status_t crypto_res;
+    psa_key_attributes_t key_attributes = psa_key_attributes_init();
+    psa_key_derivation_operation_t op = PSA_KEY_DERIVATION_OPERATION_INIT;
+    psa_key_handle_t key_handle;
+
+    if (attestation_mac_key_handle != ATTEST_KEY_HANDLE_NOT_LOADED) {
+        *handle = attestation_mac_key_handle;
+        return PSA_ATTEST_ERR_SUCCESS;
+    }
+
+    psa_set_key_usage_flags(&key_attributes, PSA_KEY_USAGE_SIGN);
+    psa_set_key_algorithm(&key_attributes, PSA_ALG_HMAC(PSA_ALG_SHA_256));
+    psa_set_key_type(&key_attributes, PSA_KEY_TYPE_HMAC);
+    psa_set_key_bits(&key_attributes, PSA_BYTES_TO_BITS(ATTEST_MAC0_KEY_LEN));
+
+    /* The Crypto service binds the key to the attestation partition, so
+     * the label only needs to tell it apart from the other keys of it.
+     */
+    crypto_res = psa_key_derivation_setup(&op, TFM_CRYPTO_ALG_HUK_DERIVATION);
+    if (crypto_res != PSA_SUCCESS) {
+        return PSA_ATTEST_ERR_GENERAL;
+    }
+
+    crypto_res = psa_key_derivation_input_bytes(&op,
+                                                PSA_KEY_DERIVATION_INPUT_LABEL,
+                                                attestation_mac_key_label,
+                                                sizeof(attestation_mac_key_label));
+    if (crypto_res == PSA_SUCCESS) {
+        crypto_res = psa_key_derivation_output_key(&key_attributes, &op,
+                                                   &key_handle);
+    }
+
+    (void)psa_key_derivation_abort(&op);
+
+    if (crypto_res != PSA_SUCCESS) {
+        return PSA_ATTEST_ERR_GENERAL;
+    }
+
+    attestation_mac_key_handle = key_handle;
+    *handle = key_handle;
+
+    return PSA_ATTEST_ERR_SUCCESS;
+}
+
+void attest_drop_mac0_key_handle(void)
+{
+    attestation_mac_key_handle = ATTEST_KEY_HANDLE_NOT_LOADED;
+}
+#endif /* ATTEST_TOKEN_MAC0 */
+
 enum psa_attest_err_t
 attest_get_initial_attestation_public_key(uint8_t **public_key,
                                           size_t *public_key_len,
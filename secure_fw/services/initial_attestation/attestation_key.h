@@ -68,6 +68,38 @@ attest_get_initial_attestation_public_key(uint8_t **public_key,
                                           size_t *public_key_len,
                                           psa_ecc_curve_t *public_key_curve);
 
+#ifdef ATTEST_TOKEN_MAC0
+/**
+ * The size of the HMAC-SHA256 key used to MAC the tokens, in bytes.
+ */
+#define ATTEST_MAC0_KEY_LEN (32u)
+
+/**
+ * \brief Get the handle of the HMAC key used to create COSE_Mac0 tokens.
+ *
+ * The key is derived from the HUK through the Crypto service on the first
+ * call, and kept loaded for the next tokens. It is specific to the device
+ * and to the attestation partition.
+ *
+ * \param[out] handle  Handle of the key
+ *
+ * \retval  PSA_ATTEST_ERR_SUCCESS   Key handle was successfully returned.
+ * \retval  PSA_ATTEST_ERR_GENERAL   Key could not be derived.
+ */
+enum psa_attest_err_t
+attest_get_mac0_key_handle(psa_key_handle_t *handle);
+
+/**
+ * \brief Forget the handle of the HMAC key, so that the key is derived
+ *        again for the next token.
+ *
+ * This is called when the Crypto service no longer knows the handle, which
+ * happens when it releases the keys derived from the HUK on a lifecycle
+ * change.
+ */
+void attest_drop_mac0_key_handle(void);
+#endif /* ATTEST_TOKEN_MAC0 */
+
 /**
  * \brief Get the attestation key ID. It is the hash (SHA256) of the COSE_Key
  *        encoded attestation public key.
@@ -17,6 +17,8 @@ extern "C" {
 #define TFM_ATTEST_GET_TOKEN_SIGNAL                             (1U << (0 + 4))
 #define TFM_ATTEST_GET_TOKEN_SIZE_SIGNAL                        (1U << (1 + 4))
 #define TFM_ATTEST_GET_PUBLIC_KEY_SIGNAL                        (1U << (2 + 4))
+#define TFM_ATTEST_GET_BATCH_TOKEN_SIGNAL                       (1U << (3 + 4))
+#define TFM_ATTEST_GET_PROFILE_SIGNAL                           (1U << (4 + 4))
 
 #ifdef __cplusplus
 }
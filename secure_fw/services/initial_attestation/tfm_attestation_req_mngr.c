@@ -23,20 +23,60 @@ typedef psa_status_t (*attest_func_t)(const psa_msg_t *msg);
 
 int32_t g_attest_caller_id;
 
+typedef psa_status_t (*attest_token_func_t)(const psa_invec *in_vec,
+                                            uint32_t num_invec,
+                                            psa_outvec *out_vec,
+                                            uint32_t num_outvec);
+
+/*
+ * The token of a secure caller is encoded straight into its output vector,
+ * which is mapped with psa_map_outvec(): the partition is a PSA RoT one, so it
+ * runs privileged. The token of a non-secure caller is encoded into the buffer
+ * of the service and then copied out, as the non-secure side could modify the
+ * encoded claims in its own buffer before they are hashed and signed.
+ */
+static psa_status_t attest_create_token(const psa_msg_t *msg,
+                                        attest_token_func_t create_token,
+                                        const psa_invec *in_vec,
+                                        uint32_t num_invec,
+                                        uint8_t *token_buff)
+{
+    psa_status_t status;
+    size_t token_size = msg->out_size[0];
+    psa_outvec out_vec[] = {
+        {token_buff, token_size}
+    };
+
+    if (msg->client_id > 0 && token_size != 0) {
+        out_vec[0].base = psa_map_outvec(msg->handle, 0);
+
+        status = create_token(in_vec, num_invec, out_vec, IOVEC_LEN(out_vec));
+
+        psa_unmap_outvec(msg->handle, 0,
+                         (status == PSA_SUCCESS) ? out_vec[0].len : 0);
+        return status;
+    }
+
+    out_vec[0].len = (token_size < PSA_INITIAL_ATTEST_TOKEN_MAX_SIZE) ?
+                      token_size : PSA_INITIAL_ATTEST_TOKEN_MAX_SIZE;
+
+    status = create_token(in_vec, num_invec, out_vec, IOVEC_LEN(out_vec));
+    if (status == PSA_SUCCESS) {
+        psa_write(msg->handle, 0, out_vec[0].base, out_vec[0].len);
+    }
+
+    return status;
+}
+
 static psa_status_t psa_attest_get_token(const psa_msg_t *msg)
 {
-    psa_status_t status = PSA_SUCCESS;
     uint8_t challenge_buff[PSA_INITIAL_ATTEST_CHALLENGE_SIZE_64];
     uint8_t token_buff[PSA_INITIAL_ATTEST_TOKEN_MAX_SIZE];
     uint32_t bytes_read = 0;
     size_t challenge_size = msg->in_size[0];
-    size_t token_size = msg->out_size[0];
     psa_invec in_vec[] = {
         {challenge_buff, challenge_size}
     };
-    psa_outvec out_vec[] = {
-        {token_buff, token_size}
-    };
 
     if (challenge_size > PSA_INITIAL_ATTEST_CHALLENGE_SIZE_64) {
         return PSA_ERROR_INVALID_ARGUMENT;
@@ -51,16 +91,8 @@ static psa_status_t psa_attest_get_token(const psa_msg_t *msg)
         return PSA_ERROR_GENERIC_ERROR;
     }
 
-    token_size = (token_size < PSA_INITIAL_ATTEST_TOKEN_MAX_SIZE) ?
-                  token_size : PSA_INITIAL_ATTEST_TOKEN_MAX_SIZE;
-
-    status = initial_attest_get_token(in_vec, IOVEC_LEN(in_vec),
-                                      out_vec, IOVEC_LEN(out_vec));
-    if (status == PSA_SUCCESS) {
-        psa_write(msg->handle, 0, out_vec[0].base, out_vec[0].len);
-    }
-
-    return status;
+    return attest_create_token(msg, initial_attest_get_token,
+                               in_vec, IOVEC_LEN(in_vec), token_buff);
 }
 
 static psa_status_t psa_attest_get_token_size(const psa_msg_t *msg)
@@ -136,6 +168,90 @@ static psa_status_t tfm_attest_get_public_key(const psa_msg_t *msg)
     return status;
 }
 
+#ifdef ATTEST_BATCH_TOKEN
+/* The challenges of a batch are too large for the stack of the partition */
+static uint8_t batch_challenge_buff[TFM_INITIAL_ATTEST_BATCH_MAX_CHALLENGES *
+                                    PSA_INITIAL_ATTEST_CHALLENGE_SIZE_64];
+
+static psa_status_t tfm_attest_get_batch_token(const psa_msg_t *msg)
+{
+    uint8_t token_buff[PSA_INITIAL_ATTEST_TOKEN_MAX_SIZE];
+    size_t challenges_size = msg->in_size[0];
+    size_t challenge_size;
+    size_t bytes_read = 0;
+    psa_invec in_vec[] = {
+        {batch_challenge_buff, challenges_size},
+        {&challenge_size, sizeof(challenge_size)}
+    };
+
+    if (challenges_size > sizeof(batch_challenge_buff) ||
+        msg->in_size[1] != sizeof(challenge_size)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    /* Store the client ID here for later use in service. */
+    g_attest_caller_id = msg->client_id;
+
+    bytes_read = psa_read(msg->handle, 0,
+                          batch_challenge_buff, challenges_size);
+    if (bytes_read != challenges_size) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    bytes_read = psa_read(msg->handle, 1,
+                          &challenge_size, sizeof(challenge_size));
+    if (bytes_read != sizeof(challenge_size)) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    return attest_create_token(msg, initial_attest_get_batch_token,
+                               in_vec, IOVEC_LEN(in_vec), token_buff);
+}
+#else /* ATTEST_BATCH_TOKEN */
+static psa_status_t tfm_attest_get_batch_token(const psa_msg_t *msg)
+{
+    (void)msg;
+
+    return PSA_ERROR_NOT_SUPPORTED;
+}
+#endif /* ATTEST_BATCH_TOKEN */
+
+/*
+ * Debug query of the profiling counters of the token creation. The service
+ * returns PSA_ERROR_NOT_SUPPORTED when it is built without ATTEST_PROFILING.
+ */
+static psa_status_t tfm_attest_get_profile(const psa_msg_t *msg)
+{
+    psa_status_t status = PSA_SUCCESS;
+    struct tfm_initial_attest_profile_t profile;
+    uint32_t reset;
+    size_t bytes_read = 0;
+    psa_invec in_vec[] = {
+        {&reset, sizeof(reset)}
+    };
+    psa_outvec out_vec[] = {
+        {&profile, sizeof(profile)}
+    };
+
+    if (msg->in_size[0] != sizeof(reset) ||
+        msg->out_size[0] != sizeof(profile)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    bytes_read = psa_read(msg->handle, 0, &reset, sizeof(reset));
+    if (bytes_read != sizeof(reset)) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    status = initial_attest_get_profile(in_vec, IOVEC_LEN(in_vec),
+                                        out_vec, IOVEC_LEN(out_vec));
+    if (status == PSA_SUCCESS) {
+        psa_write(msg->handle, 0, &profile, sizeof(profile));
+    }
+
+    return status;
+}
+
 /*
  * Fixme: Temporarily implement abort as infinite loop,
  * will replace it later.
@@ -193,6 +309,12 @@ psa_status_t attest_partition_init(void)
         } else if (signals & TFM_ATTEST_GET_PUBLIC_KEY_SIGNAL) {
             attest_signal_handle(TFM_ATTEST_GET_PUBLIC_KEY_SIGNAL,
                                  tfm_attest_get_public_key);
+        } else if (signals & TFM_ATTEST_GET_BATCH_TOKEN_SIGNAL) {
+            attest_signal_handle(TFM_ATTEST_GET_BATCH_TOKEN_SIGNAL,
+                                 tfm_attest_get_batch_token);
+        } else if (signals & TFM_ATTEST_GET_PROFILE_SIGNAL) {
+            attest_signal_handle(TFM_ATTEST_GET_PROFILE_SIGNAL,
+                                 tfm_attest_get_profile);
         } else {
             tfm_abort();
         }
@@ -7,6 +7,10 @@
 
 #include "its_flash.h"
 
+#ifdef ITS_FLASH_READ_CACHE
+#include "tfm_memory_utils.h"
+#endif
+
 #define MAX_BLOCK_DATA_COPY 256
 
 extern const struct its_flash_info_t its_flash_info_internal;
@@ -17,10 +21,316 @@ static const struct its_flash_info_t *const flash_infos[] = {
     [ITS_FLASH_ID_EXTERNAL] = &its_flash_info_external,
 };
 
-const struct its_flash_info_t *its_flash_get_info(enum its_flash_id_t id)
+#ifdef ITS_FLASH_STATS
+#define ITS_FLASH_NUM_DEVICES (sizeof(flash_infos) / sizeof(flash_infos[0]))
+
+/* Copies of the flash infos, whose functions count the operations before
+ * calling the functions of the flash device.
+ */
+static struct its_flash_info_t stats_infos[ITS_FLASH_NUM_DEVICES];
+static struct its_flash_stats_t flash_stats[ITS_FLASH_NUM_DEVICES];
+
+/**
+ * \brief Gets the index of the flash device of a flash info copy.
+ *
+ * \param[in] info  Flash info copy
+ *
+ * \return Index of the flash device
+ */
+static uint32_t stats_get_idx(const struct its_flash_info_t *info)
+{
+    return (uint32_t)(info - stats_infos);
+}
+
+static psa_status_t stats_init(const struct its_flash_info_t *info)
+{
+    const struct its_flash_info_t *dev = flash_infos[stats_get_idx(info)];
+
+    return dev->init(dev);
+}
+
+static psa_status_t stats_read(const struct its_flash_info_t *info,
+                               uint32_t block_id, uint8_t *buff,
+                               size_t offset, size_t size)
+{
+    uint32_t idx = stats_get_idx(info);
+
+    flash_stats[idx].reads++;
+    flash_stats[idx].read_bytes += size;
+
+    return flash_infos[idx]->read(flash_infos[idx], block_id, buff, offset,
+                                  size);
+}
+
+static psa_status_t stats_write(const struct its_flash_info_t *info,
+                                uint32_t block_id, const uint8_t *buff,
+                                size_t offset, size_t size)
+{
+    uint32_t idx = stats_get_idx(info);
+
+    flash_stats[idx].programs++;
+    flash_stats[idx].program_bytes += size;
+
+    return flash_infos[idx]->write(flash_infos[idx], block_id, buff, offset,
+                                   size);
+}
+
+static psa_status_t stats_flush(const struct its_flash_info_t *info)
+{
+    const struct its_flash_info_t *dev = flash_infos[stats_get_idx(info)];
+
+    return dev->flush(dev);
+}
+
+static psa_status_t stats_erase(const struct its_flash_info_t *info,
+                                uint32_t block_id)
+{
+    uint32_t idx = stats_get_idx(info);
+
+    flash_stats[idx].erases++;
+
+    return flash_infos[idx]->erase(flash_infos[idx], block_id);
+}
+
+/**
+ * \brief Gets the flash info structure of a flash device, without the read
+ *        cache.
+ *
+ * \param[in] id  Identifier of the flash device
+ *
+ * \return Pointer to the flash info struct
+ */
+static const struct its_flash_info_t *dev_get_info(enum its_flash_id_t id)
+{
+    if (stats_infos[id].init != stats_init) {
+        stats_infos[id] = *flash_infos[id];
+        stats_infos[id].init = stats_init;
+        stats_infos[id].read = stats_read;
+        stats_infos[id].write = stats_write;
+        stats_infos[id].flush = stats_flush;
+        stats_infos[id].erase = stats_erase;
+    }
+
+    return &stats_infos[id];
+}
+
+void its_flash_get_stats(enum its_flash_id_t id,
+                         struct its_flash_stats_t *stats)
+{
+    *stats = flash_stats[id];
+}
+
+void its_flash_reset_stats(enum its_flash_id_t id)
+{
+    flash_stats[id] = (struct its_flash_stats_t){0};
+}
+#else /* ITS_FLASH_STATS */
+static const struct its_flash_info_t *dev_get_info(enum its_flash_id_t id)
 {
     return flash_infos[id];
 }
+#endif /* ITS_FLASH_STATS */
+
+#ifdef ITS_FLASH_READ_CACHE
+/* The read cache is placed above the operation counts, so that the counts
+ * are the operations done on the device.
+ */
+
+/**
+ * \struct its_flash_cache_page_t
+ *
+ * \brief Copy of a page of a block of the external flash device.
+ */
+struct its_flash_cache_page_t {
+    uint32_t block_id;   /**< Block ID of the page */
+    size_t offset;       /**< Offset of the page in the block */
+    size_t size;         /**< Size of the page, 0 if the page is not valid */
+    uint32_t last_use;   /**< Value of the use counter at the last access */
+    uint8_t data[ITS_FLASH_CACHE_PAGE_SIZE]; /**< Data of the page */
+};
+
+/* Copy of the flash info of the external flash device, whose functions go
+ * through the read cache.
+ */
+static struct its_flash_info_t cache_info;
+static const struct its_flash_info_t *cache_dev;
+static struct its_flash_cache_page_t cache_pages[ITS_FLASH_CACHE_NUM_PAGES];
+static uint32_t cache_use_count;
+
+/**
+ * \brief Invalidates the cached pages of a block which overlap a range.
+ *
+ * \param[in] block_id  Block ID
+ * \param[in] offset    Offset of the range in the block
+ * \param[in] size      Size of the range
+ */
+static void cache_invalidate(uint32_t block_id, size_t offset, size_t size)
+{
+    uint32_t i;
+    struct its_flash_cache_page_t *page;
+
+    for (i = 0; i < ITS_FLASH_CACHE_NUM_PAGES; i++) {
+        page = &cache_pages[i];
+        if ((page->size != 0) && (page->block_id == block_id) &&
+            (page->offset < offset + size) &&
+            (offset < page->offset + page->size)) {
+            page->size = 0;
+        }
+    }
+}
+
+/**
+ * \brief Gets the cached page of a block at the provided offset, reading it
+ *        from the flash device in place of the least recently used page if
+ *        it is not cached.
+ *
+ * \param[in]  block_id     Block ID
+ * \param[in]  page_offset  Offset of the page in the block, a multiple of
+ *                          ITS_FLASH_CACHE_PAGE_SIZE
+ * \param[out] page         Pointer to the cached page
+ *
+ * \return Returns PSA_SUCCESS if the function is executed correctly.
+ *         Otherwise, it returns PSA_ERROR_STORAGE_FAILURE.
+ */
+static psa_status_t cache_get_page(uint32_t block_id, size_t page_offset,
+                                   struct its_flash_cache_page_t **page)
+{
+    psa_status_t status;
+    uint32_t i;
+    size_t page_size;
+    struct its_flash_cache_page_t *victim = &cache_pages[0];
+
+    cache_use_count++;
+
+    for (i = 0; i < ITS_FLASH_CACHE_NUM_PAGES; i++) {
+        if ((cache_pages[i].size != 0) &&
+            (cache_pages[i].block_id == block_id) &&
+            (cache_pages[i].offset == page_offset)) {
+            cache_pages[i].last_use = cache_use_count;
+            *page = &cache_pages[i];
+            return PSA_SUCCESS;
+        }
+
+        /* An invalid page is reused first, then the least recently used */
+        if ((victim->size != 0) &&
+            ((cache_pages[i].size == 0) ||
+             (cache_use_count - cache_pages[i].last_use
+              > cache_use_count - victim->last_use))) {
+            victim = &cache_pages[i];
+        }
+    }
+
+    /* The page is cut at the end of the block */
+    page_size = ITS_UTILS_MIN(ITS_FLASH_CACHE_PAGE_SIZE,
+                              cache_dev->block_size - page_offset);
+
+    victim->size = 0;
+    status = cache_dev->read(cache_dev, block_id, victim->data, page_offset,
+                             page_size);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    victim->block_id = block_id;
+    victim->offset = page_offset;
+    victim->size = page_size;
+    victim->last_use = cache_use_count;
+    *page = victim;
+
+    return PSA_SUCCESS;
+}
+
+static psa_status_t cache_init(const struct its_flash_info_t *info)
+{
+    uint32_t i;
+
+    for (i = 0; i < ITS_FLASH_CACHE_NUM_PAGES; i++) {
+        cache_pages[i].size = 0;
+    }
+
+    return cache_dev->init(cache_dev);
+}
+
+static psa_status_t cache_read(const struct its_flash_info_t *info,
+                               uint32_t block_id, uint8_t *buff,
+                               size_t offset, size_t size)
+{
+    psa_status_t status;
+    size_t page_offset;
+    size_t bytes_to_copy;
+    struct its_flash_cache_page_t *page;
+
+    while (size > 0) {
+        page_offset = offset - (offset % ITS_FLASH_CACHE_PAGE_SIZE);
+
+        status = cache_get_page(block_id, page_offset, &page);
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+
+        bytes_to_copy = ITS_UTILS_MIN(size,
+                                      page->size - (offset - page_offset));
+        (void)tfm_memcpy(buff, page->data + (offset - page_offset),
+                         bytes_to_copy);
+
+        buff += bytes_to_copy;
+        offset += bytes_to_copy;
+        size -= bytes_to_copy;
+    }
+
+    return PSA_SUCCESS;
+}
+
+static psa_status_t cache_write(const struct its_flash_info_t *info,
+                                uint32_t block_id, const uint8_t *buff,
+                                size_t offset, size_t size)
+{
+    /* The pages are read again from the device, which holds the data
+     * actually programmed.
+     */
+    cache_invalidate(block_id, offset, size);
+
+    return cache_dev->write(cache_dev, block_id, buff, offset, size);
+}
+
+static psa_status_t cache_flush(const struct its_flash_info_t *info)
+{
+    return cache_dev->flush(cache_dev);
+}
+
+static psa_status_t cache_erase(const struct its_flash_info_t *info,
+                                uint32_t block_id)
+{
+    cache_invalidate(block_id, 0, cache_dev->block_size);
+
+    return cache_dev->erase(cache_dev, block_id);
+}
+
+const struct its_flash_info_t *its_flash_get_info(enum its_flash_id_t id)
+{
+    /* The internal flash is fast enough to be read directly */
+    if (id != ITS_FLASH_ID_EXTERNAL) {
+        return dev_get_info(id);
+    }
+
+    if (cache_dev == NULL) {
+        cache_dev = dev_get_info(id);
+        cache_info = *cache_dev;
+        cache_info.init = cache_init;
+        cache_info.read = cache_read;
+        cache_info.write = cache_write;
+        cache_info.flush = cache_flush;
+        cache_info.erase = cache_erase;
+    }
+
+    return &cache_info;
+}
+#else /* ITS_FLASH_READ_CACHE */
+const struct its_flash_info_t *its_flash_get_info(enum its_flash_id_t id)
+{
+    return dev_get_info(id);
+}
+#endif /* ITS_FLASH_READ_CACHE */
 
 psa_status_t its_flash_block_to_block_move(const struct its_flash_info_t *info,
                                            uint32_t dst_block,
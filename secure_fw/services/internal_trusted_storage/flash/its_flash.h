@@ -42,6 +42,33 @@ extern "C" {
 #define ITS_FLASH_MAX_ALIGNMENT ITS_UTILS_MAX(ITS_FLASH_ALIGNMENT, \
                                               SST_FLASH_ALIGNMENT)
 
+#ifdef ITS_FLASH_READ_CACHE
+/*!
+ * \def ITS_FLASH_CACHE_PAGE_SIZE
+ *
+ * \brief Defines the size of a page of the read cache of the external flash
+ *        device, which is the size of each read done on the device to fill
+ *        the cache. It can be set by the target in flash_layout.h.
+ */
+#ifndef ITS_FLASH_CACHE_PAGE_SIZE
+#define ITS_FLASH_CACHE_PAGE_SIZE 256
+#endif
+
+/*!
+ * \def ITS_FLASH_CACHE_NUM_PAGES
+ *
+ * \brief Defines the number of pages of the read cache of the external flash
+ *        device. It can be set by the target in flash_layout.h.
+ */
+#ifndef ITS_FLASH_CACHE_NUM_PAGES
+#define ITS_FLASH_CACHE_NUM_PAGES 4
+#endif
+
+#if (ITS_FLASH_CACHE_PAGE_SIZE == 0) || (ITS_FLASH_CACHE_NUM_PAGES == 0)
+#error "ITS_FLASH_CACHE_PAGE_SIZE and ITS_FLASH_CACHE_NUM_PAGES must not be 0"
+#endif
+#endif /* ITS_FLASH_READ_CACHE */
+
 /**
  * \brief Enumerates the available flash devices.
  *
@@ -143,6 +170,10 @@ struct its_flash_info_t {
 
     void *flash_dev;          /**< Pointer to the flash device */
     uint32_t flash_area_addr; /**< Start address of the flash area */
+    const uint8_t *mapped_addr; /**< Address at which the flash area can be
+                                 *   read directly, or NULL if it is not
+                                 *   memory-mapped
+                                 */
     uint16_t sector_size;     /**< Size of the flash device's physical erase
                                *   unit
                                */
@@ -156,11 +187,31 @@ struct its_flash_info_t {
     uint8_t erase_val;        /**< Value of a byte after erase (usually 0xFF) */
 };
 
+/**
+ * \struct its_flash_stats_t
+ *
+ * \brief Counts of the operations done through the flash interface of a flash
+ *        device, kept when ITS_FLASH_STATS is defined.
+ *
+ * \note The reads done directly through the mapped address of a memory-mapped
+ *       flash device are not counted.
+ */
+struct its_flash_stats_t {
+    uint32_t reads;         /**< Number of read calls */
+    uint32_t read_bytes;    /**< Number of bytes read */
+    uint32_t programs;      /**< Number of write calls */
+    uint32_t program_bytes; /**< Number of bytes written */
+    uint32_t erases;        /**< Number of erased blocks */
+};
+
 /**
  * \brief Gets the flash info structure for the provided flash device.
  *
  * \param[in] id  Identifier of the flash device.
  *
+ * \note When ITS_FLASH_READ_CACHE is defined, the reads done through the flash
+ *       info of the external flash device go through its read cache.
+ *
  * \return Pointer to the flash info struct.
  */
 const struct its_flash_info_t *its_flash_get_info(enum its_flash_id_t id);
@@ -192,6 +243,26 @@ psa_status_t its_flash_block_to_block_move(const struct its_flash_info_t *info,
                                            size_t src_offset,
                                            size_t size);
 
+#ifdef ITS_FLASH_STATS
+/**
+ * \brief Gets the counts of the flash operations done on the provided flash
+ *        device since the last reset of the counts.
+ *
+ * \param[in]  id     Identifier of the flash device
+ * \param[out] stats  Pointer to the counts
+ */
+void its_flash_get_stats(enum its_flash_id_t id,
+                         struct its_flash_stats_t *stats);
+
+/**
+ * \brief Resets the counts of the flash operations done on the provided flash
+ *        device.
+ *
+ * \param[in] id  Identifier of the flash device
+ */
+void its_flash_reset_stats(enum its_flash_id_t id);
+#endif /* ITS_FLASH_STATS */
+
 #ifdef __cplusplus
 }
 #endif
@@ -89,6 +89,9 @@
 /* Maximum number of files */
 #define FLASH_INFO_MAX_NUM_FILES SST_MAX_NUM_OBJECTS
 
+/* Number of assets of the maximum size the flash area must hold */
+#define FLASH_INFO_NUM_ASSETS SST_NUM_ASSETS
+
 /* Default value of each byte in the flash when erased */
 #define FLASH_INFO_ERASE_VAL 0xFFU
 
@@ -96,10 +99,16 @@
 /* Allocate a static buffer to emulate storage in RAM */
 static uint8_t sst_block_data[FLASH_INFO_BLOCK_SIZE * FLASH_INFO_NUM_BLOCKS];
 #define FLASH_INFO_DEV sst_block_data
+#define FLASH_INFO_MAPPED_ADDR sst_block_data
 #else
 /* Import the CMSIS flash device driver */
 extern ARM_DRIVER_FLASH SST_FLASH_DEV_NAME;
 #define FLASH_INFO_DEV &SST_FLASH_DEV_NAME
+#ifdef SST_FLASH_AREA_MAPPED_ADDR
+#define FLASH_INFO_MAPPED_ADDR ((const uint8_t *)SST_FLASH_AREA_MAPPED_ADDR)
+#else
+#define FLASH_INFO_MAPPED_ADDR NULL
+#endif
 #endif
 
 const struct its_flash_info_t its_flash_info_external = {
@@ -110,6 +119,7 @@ const struct its_flash_info_t its_flash_info_external = {
     .erase = FLASH_INFO_ERASE,
     .flash_dev = (void *)FLASH_INFO_DEV,
     .flash_area_addr = SST_FLASH_AREA_ADDR,
+    .mapped_addr = FLASH_INFO_MAPPED_ADDR,
     .sector_size = SST_SECTOR_SIZE,
     .block_size = FLASH_INFO_BLOCK_SIZE,
     .num_blocks = FLASH_INFO_NUM_BLOCKS,
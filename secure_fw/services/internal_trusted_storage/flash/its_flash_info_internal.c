@@ -88,6 +88,9 @@
 /* Maximum number of files */
 #define FLASH_INFO_MAX_NUM_FILES ITS_NUM_ASSETS
 
+/* Number of assets of the maximum size the flash area must hold */
+#define FLASH_INFO_NUM_ASSETS ITS_NUM_ASSETS
+
 /* Default value of each byte in the flash when erased */
 #define FLASH_INFO_ERASE_VAL 0xFFU
 
@@ -95,10 +98,16 @@
 /* Allocate a static buffer to emulate storage in RAM */
 static uint8_t its_block_data[FLASH_INFO_BLOCK_SIZE * FLASH_INFO_NUM_BLOCKS];
 #define FLASH_INFO_DEV its_block_data
+#define FLASH_INFO_MAPPED_ADDR its_block_data
 #else
 /* Import the CMSIS flash device driver */
 extern ARM_DRIVER_FLASH ITS_FLASH_DEV_NAME;
 #define FLASH_INFO_DEV &ITS_FLASH_DEV_NAME
+#ifdef ITS_FLASH_AREA_MAPPED_ADDR
+#define FLASH_INFO_MAPPED_ADDR ((const uint8_t *)ITS_FLASH_AREA_MAPPED_ADDR)
+#else
+#define FLASH_INFO_MAPPED_ADDR NULL
+#endif
 #endif
 
 const struct its_flash_info_t its_flash_info_internal = {
@@ -109,6 +118,7 @@ const struct its_flash_info_t its_flash_info_internal = {
     .erase = FLASH_INFO_ERASE,
     .flash_dev = (void *)FLASH_INFO_DEV,
     .flash_area_addr = ITS_FLASH_AREA_ADDR,
+    .mapped_addr = FLASH_INFO_MAPPED_ADDR,
     .sector_size = ITS_SECTOR_SIZE,
     .block_size = FLASH_INFO_BLOCK_SIZE,
     .num_blocks = FLASH_INFO_NUM_BLOCKS,
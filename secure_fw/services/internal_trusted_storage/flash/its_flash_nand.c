@@ -32,6 +32,14 @@ psa_status_t its_flash_nand_init(const struct its_flash_info_t *info)
 {
     int32_t err;
 
+    /* The flash operations are expected to be complete when the driver
+     * returns, which is not the case for drivers which signal their
+     * completion with an event.
+     */
+    if (((ARM_DRIVER_FLASH *)info->flash_dev)->GetCapabilities().event_ready) {
+        return PSA_ERROR_NOT_SUPPORTED;
+    }
+
     err = ((ARM_DRIVER_FLASH *)info->flash_dev)->Initialize(NULL);
     if (err != ARM_DRIVER_OK) {
         return PSA_ERROR_STORAGE_FAILURE;
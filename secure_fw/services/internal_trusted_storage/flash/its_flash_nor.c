@@ -7,6 +7,7 @@
 
 #include "its_flash_nor.h"
 #include "Driver_Flash.h"
+#include "secure_fw/include/tfm_spm_services_api.h"
 
 /**
  * \brief Gets physical address of the given block ID.
@@ -27,6 +28,14 @@ psa_status_t its_flash_nor_init(const struct its_flash_info_t *info)
 {
     int32_t err;
 
+    /* The flash operations are expected to be complete when the driver
+     * returns, which is not the case for drivers which signal their
+     * completion with an event.
+     */
+    if (((ARM_DRIVER_FLASH *)info->flash_dev)->GetCapabilities().event_ready) {
+        return PSA_ERROR_NOT_SUPPORTED;
+    }
+
     err = ((ARM_DRIVER_FLASH *)info->flash_dev)->Initialize(NULL);
     if (err != ARM_DRIVER_OK) {
         return PSA_ERROR_STORAGE_FAILURE;
@@ -88,6 +97,11 @@ psa_status_t its_flash_nor_erase(const struct its_flash_info_t *info,
         if (err != ARM_DRIVER_OK) {
             return PSA_ERROR_STORAGE_FAILURE;
         }
+
+        /* A block can take several sector erases, let the other partitions
+         * run in between.
+         */
+        tfm_yield();
     }
 
     return PSA_SUCCESS;
@@ -7,6 +7,8 @@
 
 #include "its_flash_fs.h"
 
+#include <stdbool.h>
+
 #include "its_flash_fs_dblock.h"
 #include "tfm_memory_utils.h"
 #include "secure_fw/services/internal_trusted_storage/its_utils.h"
@@ -19,7 +21,8 @@ static psa_status_t its_flash_fs_file_write_aligned_data(
                                       const struct its_file_meta_t *file_meta,
                                       size_t offset,
                                       size_t size,
-                                      const uint8_t *data)
+                                      const uint8_t *data,
+                                      bool in_place)
 {
 #if (ITS_FLASH_MAX_ALIGNMENT != 1)
     /* Check that the offset is aligned with the flash program unit */
@@ -42,10 +45,118 @@ static psa_status_t its_flash_fs_file_write_aligned_data(
         return PSA_ERROR_INVALID_ARGUMENT;
     }
 
+#ifdef ITS_IN_PLACE_APPEND
+    if (in_place) {
+        return its_flash_fs_dblock_append_file(fs_ctx, block_meta, file_meta,
+                                               offset, size, data);
+    }
+#else
+    (void)in_place;
+#endif
+
     return its_flash_fs_dblock_write_file(fs_ctx, block_meta, file_meta, offset,
                                           size, data);
 }
 
+#ifdef ITS_WEAR_LEVELING
+/**
+ * \brief Moves the data block that has been erased the fewest times into the
+ *        scratch data block, when the scratch data block has been erased
+ *        ITS_WEAR_LEVELING_THRESHOLD times more. The least worn physical block
+ *        then becomes the scratch data block, which takes the erases of the
+ *        following updates.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ *
+ * \return Returns PSA_ERROR_DOES_NOT_EXIST if no data block needs to be
+ *         moved. Otherwise, it returns error code as specified in
+ *         \ref psa_status_t.
+ */
+static psa_status_t its_flash_fs_level_wear(struct its_flash_fs_ctx_t *fs_ctx)
+{
+    struct its_block_meta_t block_meta;
+    psa_status_t err;
+    uint32_t lblock;
+
+    /* Returns PSA_ERROR_DOES_NOT_EXIST if no data block needs to be
+     * relocated.
+     */
+    err = its_flash_fs_mblock_get_cold_lblock(fs_ctx, &lblock);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    err = its_flash_fs_mblock_read_block_metadata(fs_ctx, lblock, &block_meta);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    err = its_flash_fs_mblock_begin_update(fs_ctx);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    /* Move the whole content of the data block to the scratch data block */
+    err = its_flash_fs_dblock_compact_block(fs_ctx, lblock, 0,
+                                            block_meta.data_start,
+                                            block_meta.data_start,
+                                            fs_ctx->flash_info->block_size
+                                            - block_meta.free_size
+                                            - block_meta.data_start);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    /* The file metadata is not modified by the relocation */
+    err = its_flash_fs_mblock_cp_remaining_file_meta(fs_ctx,
+                                             fs_ctx->flash_info->max_num_files);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    err = its_flash_fs_mblock_migrate_lb0_data_to_scratch(fs_ctx);
+    if (err != PSA_SUCCESS) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    return its_flash_fs_mblock_meta_update_finalize(fs_ctx);
+}
+#endif /* ITS_WEAR_LEVELING */
+
+/**
+ * \brief Updates the metablock header, swaps scratch and active blocks and
+ *        erases scratch blocks. With ITS_WEAR_LEVELING, it then levels the
+ *        wear of the data blocks, unless that is deferred to the maintenance
+ *        with ITS_DEFERRED_ERASE.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_flash_fs_update_finalize(
+                                              struct its_flash_fs_ctx_t *fs_ctx)
+{
+    psa_status_t err;
+
+    err = its_flash_fs_mblock_meta_update_finalize(fs_ctx);
+
+#if defined(ITS_WEAR_LEVELING) && !defined(ITS_DEFERRED_ERASE)
+    if (err == PSA_SUCCESS) {
+#ifdef ITS_IN_PLACE_APPEND
+        /* The relocation leaves stale data in the scratch data block */
+        fs_ctx->keep_data_scratch = 0U;
+#endif
+        /* The update is already committed, so a failure to relocate a data
+         * block is not reported. The relocation is retried after the next
+         * update.
+         */
+        (void)its_flash_fs_level_wear(fs_ctx);
+    }
+#endif
+
+    return err;
+}
+
 psa_status_t its_flash_fs_prepare(struct its_flash_fs_ctx_t *fs_ctx,
                                   const struct its_flash_info_t *flash_info)
 {
@@ -76,12 +187,33 @@ psa_status_t its_flash_fs_file_exist(struct its_flash_fs_ctx_t *fs_ctx,
     return PSA_SUCCESS;
 }
 
-psa_status_t its_flash_fs_file_create(struct its_flash_fs_ctx_t *fs_ctx,
-                                      const uint8_t *fid,
-                                      size_t max_size,
-                                      size_t data_size,
-                                      uint32_t flags,
-                                      const uint8_t *data)
+/**
+ * \brief Creates a file in the filesystem, with initial data which is either
+ *        given in a buffer or read one chunk at a time.
+ *
+ * \param[in,out] fs_ctx     Filesystem context
+ * \param[in]     fid        File ID
+ * \param[in]     max_size   Size of the file to be created
+ * \param[in]     data_size  Size of the initial data
+ * \param[in]     flags      Flags of the file
+ * \param[in]     data       Pointer to the initial data, or NULL to read it
+ *                           with read_data
+ * \param[in]     buf        Buffer to stage each chunk read with read_data
+ * \param[in]     buf_size   Size of buf
+ * \param[in]     read_data  Function which reads the next chunk of the data
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_flash_fs_file_create_common(
+                                            struct its_flash_fs_ctx_t *fs_ctx,
+                                            const uint8_t *fid,
+                                            size_t max_size,
+                                            size_t data_size,
+                                            uint32_t flags,
+                                            const uint8_t *data,
+                                            uint8_t *buf,
+                                            size_t buf_size,
+                                            its_flash_fs_read_data_t read_data)
 {
     struct its_block_meta_t block_meta;
     uint32_t cur_phys_block;
@@ -113,14 +245,29 @@ psa_status_t its_flash_fs_file_create(struct its_flash_fs_ctx_t *fs_ctx,
         return err;
     }
 
+    err = its_flash_fs_mblock_begin_update(fs_ctx);
+    if (err != PSA_SUCCESS) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
     /* Check if data needs to be stored in the new file */
     if (data_size != 0) {
         /* Write the content into scratch data block */
-        err = its_flash_fs_file_write_aligned_data(fs_ctx, &block_meta,
-                                                   &file_meta,
-                                                   ITS_FLASH_FS_INIT_FILE,
-                                                   data_size,
-                                                   data);
+        if (data != NULL) {
+            err = its_flash_fs_file_write_aligned_data(fs_ctx, &block_meta,
+                                                       &file_meta,
+                                                       ITS_FLASH_FS_INIT_FILE,
+                                                       data_size,
+                                                       data, false);
+        } else {
+            /* All the chunks are staged in the scratch data block, which is
+             * swapped in by the single metadata update below.
+             */
+            err = its_flash_fs_dblock_write_file_chunked(fs_ctx, &block_meta,
+                                                         &file_meta, data_size,
+                                                         buf, buf_size,
+                                                         read_data);
+        }
         if (err != PSA_SUCCESS) {
             return PSA_ERROR_GENERIC_ERROR;
         }
@@ -175,7 +322,41 @@ psa_status_t its_flash_fs_file_create(struct its_flash_fs_ctx_t *fs_ctx,
     }
 
     /* Write metadata header, swap metadata blocks and erase scratch blocks */
-    return its_flash_fs_mblock_meta_update_finalize(fs_ctx);
+    return its_flash_fs_update_finalize(fs_ctx);
+}
+
+psa_status_t its_flash_fs_file_create(struct its_flash_fs_ctx_t *fs_ctx,
+                                      const uint8_t *fid,
+                                      size_t max_size,
+                                      size_t data_size,
+                                      uint32_t flags,
+                                      const uint8_t *data)
+{
+    return its_flash_fs_file_create_common(fs_ctx, fid, max_size, data_size,
+                                           flags, data, NULL, 0, NULL);
+}
+
+psa_status_t its_flash_fs_file_create_chunked(
+                                            struct its_flash_fs_ctx_t *fs_ctx,
+                                            const uint8_t *fid,
+                                            size_t max_size,
+                                            size_t data_size,
+                                            uint32_t flags,
+                                            uint8_t *buf,
+                                            size_t buf_size,
+                                            its_flash_fs_read_data_t read_data)
+{
+    /* Check that the data fits in the file and that each chunk but the last
+     * one ends on a flash program unit boundary.
+     */
+    if ((data_size > max_size) || (buf_size == 0) ||
+        !ITS_UTILS_IS_ALIGNED(buf_size, fs_ctx->flash_info->program_unit)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    return its_flash_fs_file_create_common(fs_ctx, fid, max_size, data_size,
+                                           flags, NULL, buf, buf_size,
+                                           read_data);
 }
 
 psa_status_t its_flash_fs_file_get_info(struct its_flash_fs_ctx_t *fs_ctx,
@@ -210,6 +391,29 @@ psa_status_t its_flash_fs_file_get_info(struct its_flash_fs_ctx_t *fs_ctx,
     return PSA_SUCCESS;
 }
 
+psa_status_t its_flash_fs_file_find(struct its_flash_fs_ctx_t *fs_ctx,
+                                    const uint8_t *prefix,
+                                    size_t prefix_len,
+                                    uint32_t *cursor,
+                                    uint8_t *fid)
+{
+    psa_status_t err;
+    uint32_t idx = *cursor;
+
+    if (prefix_len > ITS_FILE_ID_SIZE) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    err = its_flash_fs_mblock_find_file(fs_ctx, prefix, prefix_len, &idx, fid);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    *cursor = idx + 1;
+
+    return PSA_SUCCESS;
+}
+
 psa_status_t its_flash_fs_file_write(struct its_flash_fs_ctx_t *fs_ctx,
                                      const uint8_t *fid,
                                      size_t size,
@@ -220,6 +424,7 @@ psa_status_t its_flash_fs_file_write(struct its_flash_fs_ctx_t *fs_ctx,
     uint32_t cur_phys_block;
     psa_status_t err;
     uint32_t idx;
+    bool in_place = false;
     struct its_file_meta_t file_meta;
 
     /* Get the file index */
@@ -241,28 +446,56 @@ psa_status_t its_flash_fs_file_write(struct its_flash_fs_ctx_t *fs_ctx,
         return PSA_ERROR_GENERIC_ERROR;
     }
 
-    /* Write the content into scratch data block */
-    err = its_flash_fs_file_write_aligned_data(fs_ctx, &block_meta, &file_meta,
-                                               offset, size, data);
+    err = its_flash_fs_mblock_begin_update(fs_ctx);
     if (err != PSA_SUCCESS) {
         return PSA_ERROR_GENERIC_ERROR;
     }
 
+#ifdef ITS_IN_PLACE_APPEND
+    /* Data appended to a file outside the logical block 0 is programmed in
+     * place if that region of the data block is still erased, so that the
+     * rest of the data block is not copied to the scratch data block.
+     */
+    if ((file_meta.lblock != ITS_LOGICAL_DBLOCK0) &&
+        (offset == file_meta.cur_size)) {
+        err = its_flash_fs_file_write_aligned_data(fs_ctx, &block_meta,
+                                                   &file_meta, offset, size,
+                                                   data, true);
+        if (err == PSA_SUCCESS) {
+            in_place = true;
+        } else if (err != PSA_ERROR_NOT_SUPPORTED) {
+            return PSA_ERROR_GENERIC_ERROR;
+        }
+    }
+#endif
+
+    if (!in_place) {
+        /* Write the content into scratch data block */
+        err = its_flash_fs_file_write_aligned_data(fs_ctx, &block_meta,
+                                                   &file_meta, offset, size,
+                                                   data, false);
+        if (err != PSA_SUCCESS) {
+            return PSA_ERROR_GENERIC_ERROR;
+        }
+    }
+
     /* Update the file's current size if required */
     if (offset + size > file_meta.cur_size) {
         /* Update the file metadata */
         file_meta.cur_size = offset + size;
     }
 
-    cur_phys_block = block_meta.phy_id;
+    if (!in_place) {
+        cur_phys_block = block_meta.phy_id;
 
-    /* Cur scratch block become the active datablock */
-    block_meta.phy_id =
-        its_flash_fs_mblock_cur_data_scratch_id(fs_ctx, file_meta.lblock);
+        /* Cur scratch block become the active datablock */
+        block_meta.phy_id =
+            its_flash_fs_mblock_cur_data_scratch_id(fs_ctx, file_meta.lblock);
 
-    /* Swap the scratch data block */
-    its_flash_fs_mblock_set_data_scratch(fs_ctx, cur_phys_block,
-                                         file_meta.lblock);
+        /* Swap the scratch data block */
+        its_flash_fs_mblock_set_data_scratch(fs_ctx, cur_phys_block,
+                                             file_meta.lblock);
+    }
 
     /* Update block metadata in scratch metadata block */
     err = its_flash_fs_mblock_update_scratch_block_meta(fs_ctx,
@@ -302,7 +535,62 @@ psa_status_t its_flash_fs_file_write(struct its_flash_fs_ctx_t *fs_ctx,
     /* Update the metablock header, swap scratch and active blocks,
      * erase scratch blocks.
      */
-    return its_flash_fs_mblock_meta_update_finalize(fs_ctx);
+#ifdef ITS_IN_PLACE_APPEND
+    fs_ctx->keep_data_scratch = in_place ? 1U : 0U;
+    err = its_flash_fs_update_finalize(fs_ctx);
+    fs_ctx->keep_data_scratch = 0U;
+
+    return err;
+#else
+    return its_flash_fs_update_finalize(fs_ctx);
+#endif
+}
+
+psa_status_t its_flash_fs_file_get_addr(struct its_flash_fs_ctx_t *fs_ctx,
+                                        const uint8_t *fid,
+                                        size_t size,
+                                        size_t offset,
+                                        const uint8_t **addr)
+{
+    psa_status_t err;
+    uint32_t idx;
+    struct its_file_meta_t tmp_metadata;
+
+    if (fs_ctx->flash_info->mapped_addr == NULL) {
+        return PSA_ERROR_NOT_SUPPORTED;
+    }
+
+    /* Get the file index */
+    err = its_flash_fs_mblock_get_file_idx(fs_ctx, fid, &idx);
+    if (err != PSA_SUCCESS) {
+        return PSA_ERROR_DOES_NOT_EXIST;
+    }
+
+    /* Read file metadata */
+    err = its_flash_fs_mblock_read_file_meta(fs_ctx, idx, &tmp_metadata);
+    if (err != PSA_SUCCESS) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    /* Check if index is still referring to same file */
+    if (tfm_memcmp(fid, tmp_metadata.id, ITS_FILE_ID_SIZE)) {
+        return PSA_ERROR_DOES_NOT_EXIST;
+    }
+
+    /* Boundary check the incoming request */
+    err = its_utils_check_contained_in(tmp_metadata.cur_size, offset, size);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    /* Locate the file data in the flash mapping */
+    err = its_flash_fs_dblock_get_file_addr(fs_ctx, &tmp_metadata, offset,
+                                            addr);
+    if (err != PSA_SUCCESS) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    return PSA_SUCCESS;
 }
 
 psa_status_t its_flash_fs_file_delete(struct its_flash_fs_ctx_t *fs_ctx,
@@ -338,6 +626,11 @@ psa_status_t its_flash_fs_file_delete(struct its_flash_fs_ctx_t *fs_ctx,
     del_file_data_idx = file_meta.data_idx;
     del_file_max_size = file_meta.max_size;
 
+    err = its_flash_fs_mblock_begin_update(fs_ctx);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
     /* Remove file metadata */
     file_meta = (struct its_file_meta_t){0};
 
@@ -421,7 +714,7 @@ psa_status_t its_flash_fs_file_delete(struct its_flash_fs_ctx_t *fs_ctx,
     /* Update the metablock header, swap scratch and active blocks,
      * erase scratch blocks.
      */
-    return its_flash_fs_mblock_meta_update_finalize(fs_ctx);
+    return its_flash_fs_update_finalize(fs_ctx);
 }
 
 psa_status_t its_flash_fs_file_read(struct its_flash_fs_ctx_t *fs_ctx,
@@ -466,3 +759,33 @@ psa_status_t its_flash_fs_file_read(struct its_flash_fs_ctx_t *fs_ctx,
 
     return PSA_SUCCESS;
 }
+
+#ifdef ITS_WEAR_LEVELING
+psa_status_t its_flash_fs_get_erase_count(struct its_flash_fs_ctx_t *fs_ctx,
+                                          uint32_t block,
+                                          uint32_t *erase_count)
+{
+    return its_flash_fs_mblock_get_erase_count(fs_ctx, block, erase_count);
+}
+#endif
+
+#ifdef ITS_DEFERRED_ERASE
+psa_status_t its_flash_fs_maintain(struct its_flash_fs_ctx_t *fs_ctx)
+{
+#ifdef ITS_WEAR_LEVELING
+    psa_status_t err;
+
+    err = its_flash_fs_mblock_maintain(fs_ctx);
+    if (err != PSA_ERROR_DOES_NOT_EXIST) {
+        return err;
+    }
+
+    /* Once the scratch blocks are erased, relocate a data block if needed.
+     * The relocation leaves the erase of the scratch blocks for the next step.
+     */
+    return its_flash_fs_level_wear(fs_ctx);
+#else
+    return its_flash_fs_mblock_maintain(fs_ctx);
+#endif
+}
+#endif
@@ -19,7 +19,11 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#ifdef ITS_LOG_FS
+#include "its_flash_fs_log.h"
+#else
 #include "its_flash_fs_mblock.h"
+#endif
 #include "psa/error.h"
 #include "secure_fw/services/internal_trusted_storage/flash/its_flash.h"
 
@@ -50,6 +54,17 @@ struct its_file_info_t {
     uint32_t flags;      /*!< Flags set when the file was created */
 };
 
+/**
+ * \brief Function type which reads the next chunk of the data of a file, such
+ *        as its_req_mngr_read().
+ *
+ * \param[out] buf        Buffer to copy the data to
+ * \param[in]  num_bytes  Number of bytes to copy
+ *
+ * \return Number of bytes copied
+ */
+typedef size_t (*its_flash_fs_read_data_t)(uint8_t *buf, size_t num_bytes);
+
 /**
  * \brief Prepares the filesystem to accept operations on the files.
  *
@@ -110,6 +125,37 @@ psa_status_t its_flash_fs_file_create(its_flash_fs_ctx_t *fs_ctx,
                                       uint32_t flags,
                                       const uint8_t *data);
 
+/**
+ * \brief Creates a file in the filesystem, with initial data which is read
+ *        one chunk at a time. The file is committed with a single metadata
+ *        update once all its data has been written, so it is not created if
+ *        the operation is interrupted.
+ *
+ * \param[in,out] fs_ctx     Filesystem context
+ * \param[in]     fid        File ID
+ * \param[in]     max_size   Size of the file to be created
+ * \param[in]     data_size  Size of the initial data
+ * \param[in]     flags      Flags of the file
+ * \param[in]     buf        Buffer to stage each chunk of the initial data
+ * \param[in]     buf_size   Size of the buffer. It must be aligned to the
+ *                           flash program unit.
+ * \param[in]     read_data  Function which reads the next chunk of the initial
+ *                           data into the buffer
+ *
+ * \return Returns PSA_SUCCESS if the file has been created correctly. If the
+ *         fid is in use, it returns PSA_ERROR_INVALID_ARGUMENT. Otherwise, it
+ *         returns error code as specified in \ref psa_status_t.
+ */
+psa_status_t its_flash_fs_file_create_chunked(
+                                            its_flash_fs_ctx_t *fs_ctx,
+                                            const uint8_t *fid,
+                                            size_t max_size,
+                                            size_t data_size,
+                                            uint32_t flags,
+                                            uint8_t *buf,
+                                            size_t buf_size,
+                                            its_flash_fs_read_data_t read_data);
+
 /**
  * \brief Gets the file information referenced by the file ID.
  *
@@ -124,6 +170,29 @@ psa_status_t its_flash_fs_file_get_info(its_flash_fs_ctx_t *fs_ctx,
                                         const uint8_t *fid,
                                         struct its_file_info_t *info);
 
+/**
+ * \brief Finds the next file whose ID begins with the given prefix. The files
+ *        are found in the order of their metadata entries, so calling it
+ *        again with the cursor it returns enumerates the matching files.
+ *
+ * \param[in,out] fs_ctx      Filesystem context
+ * \param[in]     prefix      Prefix of the file ID
+ * \param[in]     prefix_len  Size of the prefix, at most ITS_FILE_ID_SIZE
+ * \param[in,out] cursor      Position to start the search from, 0 for the
+ *                            first file. On success, the position following
+ *                            the file found.
+ * \param[out]    fid         ID of the file found
+ *
+ * \return Returns PSA_ERROR_DOES_NOT_EXIST if there is no other matching
+ *         file. Otherwise, it returns error code as specified in
+ *         \ref psa_status_t
+ */
+psa_status_t its_flash_fs_file_find(its_flash_fs_ctx_t *fs_ctx,
+                                    const uint8_t *prefix,
+                                    size_t prefix_len,
+                                    uint32_t *cursor,
+                                    uint8_t *fid);
+
 /**
  * \brief Writes data to an existing file.
  *
@@ -158,6 +227,29 @@ psa_status_t its_flash_fs_file_read(its_flash_fs_ctx_t *fs_ctx,
                                     size_t offset,
                                     uint8_t *data);
 
+/**
+ * \brief Gets the address at which file data can be read directly, when the
+ *        flash area is memory-mapped.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ * \param[in]     fid     File ID
+ * \param[in]     size    Size of the data to be read
+ * \param[in]     offset  Offset in the file
+ * \param[out]    addr    Address of the data
+ *
+ * \note The address is only valid until the next operation on the
+ *       filesystem.
+ *
+ * \return Returns PSA_ERROR_NOT_SUPPORTED if the flash area is not
+ *         memory-mapped. Otherwise, it returns error code as specified in
+ *         \ref psa_status_t.
+ */
+psa_status_t its_flash_fs_file_get_addr(its_flash_fs_ctx_t *fs_ctx,
+                                        const uint8_t *fid,
+                                        size_t size,
+                                        size_t offset,
+                                        const uint8_t **addr);
+
 /**
  * \brief Deletes file referenced by the file ID.
  *
@@ -169,6 +261,40 @@ psa_status_t its_flash_fs_file_read(its_flash_fs_ctx_t *fs_ctx,
 psa_status_t its_flash_fs_file_delete(its_flash_fs_ctx_t *fs_ctx,
                                       const uint8_t *fid);
 
+#ifdef ITS_DEFERRED_ERASE
+/**
+ * \brief Does the maintenance of the filesystem which has been deferred from
+ *        the last update, which is to erase its scratch blocks. It is meant
+ *        to be called while no request is pending.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ *
+ * \return Returns PSA_ERROR_DOES_NOT_EXIST if there is nothing to do.
+ *         Otherwise, it returns error code as specified in \ref psa_status_t.
+ */
+psa_status_t its_flash_fs_maintain(its_flash_fs_ctx_t *fs_ctx);
+#endif
+
+#ifdef ITS_WEAR_LEVELING
+/**
+ * \brief Gets the number of times a physical block of the filesystem has been
+ *        erased.
+ *
+ * \param[in,out] fs_ctx       Filesystem context
+ * \param[in]     block        Physical block ID
+ * \param[out]    erase_count  Number of erases of the block
+ *
+ * \note The erases done by the last update are counted in memory, and are
+ *       only stored in flash with the next update.
+ *
+ * \return Returns PSA_ERROR_INVALID_ARGUMENT if the block does not exist.
+ *         Otherwise, it returns error code as specified in \ref psa_status_t.
+ */
+psa_status_t its_flash_fs_get_erase_count(its_flash_fs_ctx_t *fs_ctx,
+                                          uint32_t block,
+                                          uint32_t *erase_count);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -16,15 +16,53 @@
 #ifndef __ITS_FLASH_FS_CHECK_INFO_H__
 #define __ITS_FLASH_FS_CHECK_INFO_H__
 
+#ifdef ITS_LOG_FS
+#include "its_flash_fs_log.h"
+#else
 #include "its_flash_fs_mblock.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#ifdef ITS_LOG_FS
+
+#define ITS_LOG_BLOCK_FREE_SIZE (FLASH_INFO_BLOCK_SIZE \
+                                 - sizeof(struct its_log_block_header_t) \
+                                 - ITS_LOG_RECORD_SIZE(0))
+
+#define ITS_LOG_MAX_RECORD_SIZE ITS_LOG_RECORD_SIZE(FLASH_INFO_MAX_FILE_SIZE)
+
+/* Checks at compile time if the largest file fits in a block, after the block
+ * header and with a reclaim record
+ */
+ITS_UTILS_BOUND_CHECK(LARGEST_ITS_FILE_NOT_FIT_IN_LOG_BLOCK,
+                      ITS_LOG_MAX_RECORD_SIZE, ITS_LOG_BLOCK_FREE_SIZE);
+
+/* One block is kept to reclaim blocks. A reclaim copies the current records of
+ * the block which holds the fewest, at most an even share of them, to a new
+ * block, where the record being appended must fit after them. Checks at
+ * compile time if all the assets at their maximum size, while one of them is
+ * rewritten, fit in the other blocks.
+ */
+ITS_UTILS_BOUND_CHECK(ITS_LOG_ASSETS_NOT_FIT_IN_FLASH_AREA,
+                      (FLASH_INFO_NUM_ASSETS * ITS_LOG_MAX_RECORD_SIZE),
+                      ((FLASH_INFO_NUM_BLOCKS - 1) *
+                       (ITS_LOG_BLOCK_FREE_SIZE
+                        - ITS_LOG_MAX_RECORD_SIZE)));
+
+#else /* ITS_LOG_FS */
+
 #define ITS_BLOCK_META_HEADER_SIZE  sizeof(struct its_metadata_block_header_t)
-#define ITS_BLOCK_METADATA_SIZE     sizeof(struct its_block_meta_t)
-#define ITS_FILE_METADATA_SIZE      sizeof(struct its_file_meta_t)
+
+/* The mount checkpoint is followed by its consumed marker */
+#ifdef ITS_MOUNT_CHECKPOINT
+#define ITS_MOUNT_CHECKPOINT_SIZE   (sizeof(struct its_mount_checkpoint_t) \
+                                     + ITS_FLASH_MAX_ALIGNMENT)
+#else
+#define ITS_MOUNT_CHECKPOINT_SIZE   0
+#endif
 
 #if ((FLASH_INFO_NUM_BLOCKS < 2) || (FLASH_INFO_NUM_BLOCKS == 3))
   /* The minimum number of blocks is 2. In this case, metadata and data are
@@ -79,7 +117,8 @@ extern "C" {
 #define ITS_ALL_METADATA_SIZE \
     (ITS_BLOCK_META_HEADER_SIZE \
      + (ITS_NUM_ACTIVE_DBLOCKS * ITS_BLOCK_METADATA_SIZE) \
-     + (FLASH_INFO_MAX_NUM_FILES * ITS_FILE_METADATA_SIZE))
+     + (FLASH_INFO_MAX_NUM_FILES * ITS_FILE_METADATA_SIZE) \
+     + ITS_MOUNT_CHECKPOINT_SIZE)
 
 /* It is not required that all files fit in ITS flash area at the same time.
  * So, it is possible that a create action fails because flash is full.
@@ -99,6 +138,14 @@ ITS_UTILS_BOUND_CHECK(ITS_FILE_NOT_FIT_IN_DATA_AREA, FLASH_INFO_MAX_FILE_SIZE,
 ITS_UTILS_BOUND_CHECK(ITS_METADATA_NOT_FIT_IN_METADATA_BLOCK,
                       ITS_ALL_METADATA_SIZE, FLASH_INFO_BLOCK_SIZE);
 
+#ifdef ITS_WEAR_LEVELING
+/* Checks at compile time if the erase count of each block can be tracked */
+ITS_UTILS_BOUND_CHECK(ITS_ERASE_COUNTS_NOT_FIT_IN_METADATA_HEADER,
+                      FLASH_INFO_NUM_BLOCKS, ITS_WEAR_LEVELING_MAX_BLOCKS);
+#endif
+
+#endif /* ITS_LOG_FS */
+
 #ifdef __cplusplus
 }
 #endif
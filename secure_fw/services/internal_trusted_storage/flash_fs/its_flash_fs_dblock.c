@@ -9,6 +9,11 @@
 
 #include "secure_fw/services/internal_trusted_storage/flash/its_flash.h"
 
+#ifdef ITS_IN_PLACE_APPEND
+/* Number of bytes read at a time to check that a region is erased */
+#define ITS_DBLOCK_ERASE_CHECK_SIZE 32
+#endif
+
 /**
  * \brief Converts logical data block number to physical number.
  *
@@ -132,13 +137,53 @@ psa_status_t its_flash_fs_dblock_read_file(
                                     size);
 }
 
-psa_status_t its_flash_fs_dblock_write_file(
+psa_status_t its_flash_fs_dblock_get_file_addr(
+                                        struct its_flash_fs_ctx_t *fs_ctx,
+                                        const struct its_file_meta_t *file_meta,
+                                        size_t offset,
+                                        const uint8_t **addr)
+{
+    uint32_t phys_block;
+
+    phys_block = its_dblock_lo_to_phy(fs_ctx, file_meta->lblock);
+    if (phys_block == ITS_BLOCK_INVALID_ID) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    *addr = fs_ctx->flash_info->mapped_addr
+            + (phys_block * fs_ctx->flash_info->block_size)
+            + file_meta->data_idx + offset;
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Writes scratch data block content with the file data and the rest of
+ *        the data from the given logical block.
+ *
+ * \param[in,out] fs_ctx      Filesystem context
+ * \param[in]     block_meta  Block metadata
+ * \param[in]     file_meta   File metadata
+ * \param[in]     offset      Offset in the file of the incoming data
+ * \param[in]     size        Size of the incoming data
+ * \param[in]     data        Pointer to the incoming data, or NULL to read it
+ *                            with read_data
+ * \param[in]     buf         Buffer to stage each chunk read with read_data
+ * \param[in]     buf_size    Size of buf
+ * \param[in]     read_data   Function which reads the next chunk of the data
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_dblock_write_file(
                                       struct its_flash_fs_ctx_t *fs_ctx,
                                       const struct its_block_meta_t *block_meta,
                                       const struct its_file_meta_t *file_meta,
                                       size_t offset,
                                       size_t size,
-                                      const uint8_t *data)
+                                      const uint8_t *data,
+                                      uint8_t *buf,
+                                      size_t buf_size,
+                                      its_flash_fs_read_data_t read_data)
 {
     psa_status_t err;
     uint32_t scratch_id;
@@ -162,11 +207,31 @@ psa_status_t its_flash_fs_dblock_write_file(
         return err;
     }
 
-    /* Write the new file data */
-    err = fs_ctx->flash_info->write(fs_ctx->flash_info, scratch_id, data, pos,
-                                    size);
-    if (err != PSA_SUCCESS) {
-        return err;
+    if (data != NULL) {
+        /* Write the new file data */
+        err = fs_ctx->flash_info->write(fs_ctx->flash_info, scratch_id, data,
+                                        pos, size);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+    } else {
+        /* Write the new file data as it is read, one chunk at a time */
+        while (size > 0) {
+            num_bytes = ITS_UTILS_MIN(size, buf_size);
+
+            (void)read_data(buf, num_bytes);
+
+            err = fs_ctx->flash_info->write(fs_ctx->flash_info, scratch_id,
+                                            buf, pos,
+                                            ITS_UTILS_ALIGN(num_bytes,
+                                              fs_ctx->flash_info->program_unit));
+            if (err != PSA_SUCCESS) {
+                return err;
+            }
+
+            pos += num_bytes;
+            size -= num_bytes;
+        }
     }
 
     /* Calculate the position of the end of the file */
@@ -192,3 +257,76 @@ psa_status_t its_flash_fs_dblock_write_file(
 
     return err;
 }
+
+#ifdef ITS_IN_PLACE_APPEND
+psa_status_t its_flash_fs_dblock_append_file(
+                                      struct its_flash_fs_ctx_t *fs_ctx,
+                                      const struct its_block_meta_t *block_meta,
+                                      const struct its_file_meta_t *file_meta,
+                                      size_t offset,
+                                      size_t size,
+                                      const uint8_t *data)
+{
+    uint8_t buf[ITS_DBLOCK_ERASE_CHECK_SIZE];
+    psa_status_t err;
+    size_t i;
+    size_t num_bytes;
+    size_t pos = file_meta->data_idx + offset;
+    size_t remaining = size;
+
+    /* Check that the region has not been programmed since the block was
+     * erased, including by an append interrupted before its metadata update.
+     */
+    while (remaining > 0) {
+        num_bytes = ITS_UTILS_MIN(remaining, sizeof(buf));
+
+        err = fs_ctx->flash_info->read(fs_ctx->flash_info, block_meta->phy_id,
+                                       buf, pos, num_bytes);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+
+        for (i = 0; i < num_bytes; i++) {
+            if (buf[i] != fs_ctx->flash_info->erase_val) {
+                return PSA_ERROR_NOT_SUPPORTED;
+            }
+        }
+
+        pos += num_bytes;
+        remaining -= num_bytes;
+    }
+
+    err = fs_ctx->flash_info->write(fs_ctx->flash_info, block_meta->phy_id,
+                                    data, file_meta->data_idx + offset, size);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    return fs_ctx->flash_info->flush(fs_ctx->flash_info);
+}
+#endif /* ITS_IN_PLACE_APPEND */
+
+psa_status_t its_flash_fs_dblock_write_file(
+                                      struct its_flash_fs_ctx_t *fs_ctx,
+                                      const struct its_block_meta_t *block_meta,
+                                      const struct its_file_meta_t *file_meta,
+                                      size_t offset,
+                                      size_t size,
+                                      const uint8_t *data)
+{
+    return its_dblock_write_file(fs_ctx, block_meta, file_meta, offset, size,
+                                 data, NULL, 0, NULL);
+}
+
+psa_status_t its_flash_fs_dblock_write_file_chunked(
+                                      struct its_flash_fs_ctx_t *fs_ctx,
+                                      const struct its_block_meta_t *block_meta,
+                                      const struct its_file_meta_t *file_meta,
+                                      size_t size,
+                                      uint8_t *buf,
+                                      size_t buf_size,
+                                      its_flash_fs_read_data_t read_data)
+{
+    return its_dblock_write_file(fs_ctx, block_meta, file_meta, 0, size, NULL,
+                                 buf, buf_size, read_data);
+}
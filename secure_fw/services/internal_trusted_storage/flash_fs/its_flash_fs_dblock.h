@@ -12,6 +12,7 @@
 #include <stdint.h>
 
 #include "psa/error.h"
+#include "its_flash_fs.h"
 #include "its_flash_fs_mblock.h"
 
 #ifdef __cplusplus
@@ -58,6 +59,22 @@ psa_status_t its_flash_fs_dblock_read_file(
                                         size_t size,
                                         uint8_t *buf);
 
+/**
+ * \brief Gets the address at which the file content can be read directly.
+ *
+ * \param[in,out] fs_ctx     Filesystem context
+ * \param[in]     file_meta  File metadata
+ * \param[in]     offset     Offset in the file
+ * \param[out]    addr       Address of the file content at the offset
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+psa_status_t its_flash_fs_dblock_get_file_addr(
+                                        struct its_flash_fs_ctx_t *fs_ctx,
+                                        const struct its_file_meta_t *file_meta,
+                                        size_t offset,
+                                        const uint8_t **addr);
+
 /**
  * \brief Writes scratch data block content with requested data and the rest of
  *        the data from the given logical block.
@@ -81,6 +98,62 @@ psa_status_t its_flash_fs_dblock_write_file(
                                       size_t size,
                                       const uint8_t *data);
 
+#ifdef ITS_IN_PLACE_APPEND
+/**
+ * \brief Programs data appended to a file in place, in the active data block,
+ *        if that region of the block is still erased.
+ *
+ * \param[in,out] fs_ctx      Filesystem context
+ * \param[in]     block_meta  Block metadata
+ * \param[in]     file_meta   File metadata
+ * \param[in]     offset      Offset in the file of the incoming data, aligned
+ *                            to the flash program unit
+ * \param[in]     size        Size of the incoming data, aligned to the flash
+ *                            program unit
+ * \param[in]     data        Pointer to the incoming data
+ *
+ * \note The file metadata must be updated afterwards for the data to be part
+ *       of the file. Until then, the region is no longer erased, so the data
+ *       appended next is written to the scratch data block instead.
+ *
+ * \return Returns PSA_ERROR_NOT_SUPPORTED if the region is not erased.
+ *         Otherwise, it returns error code as specified in \ref psa_status_t.
+ */
+psa_status_t its_flash_fs_dblock_append_file(
+                                      struct its_flash_fs_ctx_t *fs_ctx,
+                                      const struct its_block_meta_t *block_meta,
+                                      const struct its_file_meta_t *file_meta,
+                                      size_t offset,
+                                      size_t size,
+                                      const uint8_t *data);
+#endif /* ITS_IN_PLACE_APPEND */
+
+/**
+ * \brief Writes scratch data block content with the data of a new file, read
+ *        one chunk at a time, and the rest of the data from the given logical
+ *        block.
+ *
+ * \param[in,out] fs_ctx      Filesystem context
+ * \param[in]     block_meta  Block metadata
+ * \param[in]     file_meta   File metadata
+ * \param[in]     size        Size of the file data
+ * \param[in]     buf         Buffer to stage each chunk of the file data
+ * \param[in]     buf_size    Size of the buffer, aligned to the flash program
+ *                            unit
+ * \param[in]     read_data   Function which reads the next chunk of the file
+ *                            data
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+psa_status_t its_flash_fs_dblock_write_file_chunked(
+                                      struct its_flash_fs_ctx_t *fs_ctx,
+                                      const struct its_block_meta_t *block_meta,
+                                      const struct its_file_meta_t *file_meta,
+                                      size_t size,
+                                      uint8_t *buf,
+                                      size_t buf_size,
+                                      its_flash_fs_read_data_t read_data);
+
 #ifdef __cplusplus
 }
 #endif
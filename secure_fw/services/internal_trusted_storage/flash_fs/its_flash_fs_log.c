@@ -0,0 +1,1755 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include "its_flash_fs.h"
+
+#include "psa/storage_common.h"
+#include "tfm_memory_utils.h"
+
+/* The markers of a record are programmed after the record, which a NAND
+ * device buffering the whole block cannot do.
+ */
+#if !defined(ITS_RAM_FS) && (ITS_FLASH_PROGRAM_UNIT > 16)
+#error "ITS_LOG_FS requires ITS_FLASH_PROGRAM_UNIT to be at most 16"
+#endif
+
+#if !defined(SST_RAM_FS) && (SST_FLASH_PROGRAM_UNIT > 16)
+#error "ITS_LOG_FS requires SST_FLASH_PROGRAM_UNIT to be at most 16"
+#endif
+
+/* The log spreads the erases over all blocks by design */
+#ifdef ITS_WEAR_LEVELING
+#error "ITS_WEAR_LEVELING is not supported with ITS_LOG_FS"
+#endif
+
+/* The log is replayed at every mount, and has no scratch blocks to erase */
+#ifdef ITS_MOUNT_CHECKPOINT
+#error "ITS_MOUNT_CHECKPOINT is not supported with ITS_LOG_FS"
+#endif
+
+#ifdef ITS_DEFERRED_ERASE
+#error "ITS_DEFERRED_ERASE is not supported with ITS_LOG_FS"
+#endif
+
+/* Values which identify a block in use and a record */
+#define ITS_LOG_BLOCK_MAGIC   0x474F4C49U
+#define ITS_LOG_RECORD_MAGIC  0x43455249U
+
+/* Value of the commit marker of a valid record */
+#define ITS_LOG_MARKER_COMMIT 0x54494D43U
+
+/* Types of record */
+#define ITS_LOG_RECORD_FILE     1U /* Version of a file */
+#define ITS_LOG_RECORD_RECLAIM  2U /* End of the reclaim of a block */
+#define ITS_LOG_RECORD_DELTA    3U /* Range of a version of a file */
+
+/* States of a block */
+#define ITS_LOG_BLOCK_FREE    0U /* Not in use, to be erased before use */
+#define ITS_LOG_BLOCK_ERASED  1U /* Not in use and erased */
+#define ITS_LOG_BLOCK_IN_USE  2U /* Holds records of the log */
+
+#define ITS_LOG_BLOCK_HEADER_SIZE  sizeof(struct its_log_block_header_t)
+#define ITS_LOG_RECORD_HEADER_SIZE sizeof(struct its_log_record_t)
+#define ITS_LOG_MARKER_SIZE        sizeof(struct its_log_marker_t)
+
+/* Size of the buffer which stages a record before it is programmed. It is a
+ * multiple of any flash alignment, as ITS_FLASH_MAX_ALIGNMENT is at most 16.
+ */
+#define ITS_LOG_WRITE_BUF_SIZE 64
+
+/*!
+ * \struct its_log_writer_t
+ *
+ * \brief Structure to stage the data of a record, so that the flash is always
+ *        programmed in aligned units.
+ */
+struct its_log_writer_t {
+    struct its_flash_fs_ctx_t *fs_ctx; /*!< Filesystem context */
+    size_t start;                      /*!< Offset of the record in the head
+                                        *   block
+                                        */
+    size_t pos;                        /*!< Offset in the head block where
+                                        *   the staged data is programmed
+                                        */
+    size_t fill;                       /*!< Number of bytes staged */
+    uint8_t buf[ITS_LOG_WRITE_BUF_SIZE]; /*!< Staged data */
+};
+
+/**
+ * \brief Gets the value of a 32-bit word of erased flash.
+ *
+ * \param[in] fs_ctx  Filesystem context
+ *
+ * \return The erased word
+ */
+__attribute__((always_inline))
+static inline uint32_t its_log_erased_word(struct its_flash_fs_ctx_t *fs_ctx)
+{
+    return fs_ctx->flash_info->erase_val * 0x01010101U;
+}
+
+/**
+ * \brief Gets the offset of the commit marker of a record.
+ *
+ * \param[in] pos        Offset of the record in its block
+ * \param[in] data_size  Size of the file data of the record
+ *
+ * \return The offset of the commit marker, the obsolete marker follows it
+ */
+__attribute__((always_inline))
+static inline size_t its_log_commit_offset(size_t pos, size_t data_size)
+{
+    return pos + ITS_LOG_RECORD_HEADER_SIZE
+           + ITS_UTILS_ALIGN(data_size, ITS_FLASH_MAX_ALIGNMENT);
+}
+
+/**
+ * \brief Programs a marker and commits it to flash.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ * \param[in]     block   Physical block of the marker
+ * \param[in]     offset  Offset of the marker in the block
+ * \param[in]     value   Value of the marker
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_log_write_marker(struct its_flash_fs_ctx_t *fs_ctx,
+                                         uint32_t block, size_t offset,
+                                         uint32_t value)
+{
+    psa_status_t err;
+    struct its_log_marker_t marker;
+
+    (void)tfm_memset(&marker, (uint8_t)value, ITS_LOG_MARKER_SIZE);
+    marker.value = value;
+
+    err = fs_ctx->flash_info->write(fs_ctx->flash_info, block,
+                                    (const uint8_t *)&marker, offset,
+                                    ITS_LOG_MARKER_SIZE);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    return fs_ctx->flash_info->flush(fs_ctx->flash_info);
+}
+
+/**
+ * \brief Discards a record in flash.
+ *
+ * \param[in,out] fs_ctx     Filesystem context
+ * \param[in]     block      Physical block of the record
+ * \param[in]     pos        Offset of the record in the block
+ * \param[in]     data_size  Size of the data of the record
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_log_mark_obsolete(struct its_flash_fs_ctx_t *fs_ctx,
+                                          uint32_t block, size_t pos,
+                                          size_t data_size)
+{
+    /* Any programmed bit makes the record obsolete, so a marker whose update
+     * is interrupted discards the record as well.
+     */
+    return its_log_write_marker(fs_ctx, block,
+                                its_log_commit_offset(pos, data_size)
+                                + ITS_LOG_MARKER_SIZE,
+                                ~its_log_erased_word(fs_ctx));
+}
+
+/**
+ * \brief Discards the current version of a file in flash.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ * \param[in]     file    Current version of the file
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_log_discard_file(struct its_flash_fs_ctx_t *fs_ctx,
+                                         const struct its_log_file_t *file)
+{
+    psa_status_t err;
+    uint32_t i;
+
+    /* The file record is discarded first, as delta records left without it
+     * are discarded by the replay.
+     */
+    if (file->block != ITS_BLOCK_INVALID_ID) {
+        err = its_log_mark_obsolete(fs_ctx, file->block, file->pos,
+                                    file->base_size);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+    }
+
+    for (i = 0; i < file->num_deltas; i++) {
+        err = its_log_mark_obsolete(fs_ctx, file->delta[i].block,
+                                    file->delta[i].pos, file->delta[i].size);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+    }
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Gets the version of the latest record of a file.
+ *
+ * \param[in] file  Current version of the file
+ *
+ * \return The version of the file
+ */
+__attribute__((always_inline))
+static inline uint32_t its_log_file_version(const struct its_log_file_t *file)
+{
+    return (file->num_deltas > 0) ? file->delta[file->num_deltas - 1].version
+                                  : file->version;
+}
+
+/**
+ * \brief Reads file data, with the delta records applied over the file
+ *        record.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ * \param[in]     file    Current version of the file
+ * \param[in]     offset  Offset in the file
+ * \param[in]     size    Number of bytes to read
+ * \param[out]    data    Buffer to read the data into
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_log_read_data(struct its_flash_fs_ctx_t *fs_ctx,
+                                      const struct its_log_file_t *file,
+                                      size_t offset, size_t size,
+                                      uint8_t *data)
+{
+    const struct its_flash_info_t *flash_info = fs_ctx->flash_info;
+    const struct its_log_delta_t *delta;
+    size_t end;
+    psa_status_t err;
+    uint32_t i;
+    size_t start;
+
+    /* The data past the file record is written by the delta records */
+    if (offset < file->base_size) {
+        err = flash_info->read(flash_info, file->block, data,
+                               file->pos + ITS_LOG_RECORD_HEADER_SIZE + offset,
+                               ITS_UTILS_MIN(size, file->base_size - offset));
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+    }
+
+    for (i = 0; i < file->num_deltas; i++) {
+        delta = &file->delta[i];
+        start = ITS_UTILS_MAX(offset, delta->offset);
+        end = ITS_UTILS_MIN(offset + size, delta->offset + delta->size);
+        if (start >= end) {
+            continue;
+        }
+
+        err = flash_info->read(flash_info, delta->block, data + start - offset,
+                               delta->pos + ITS_LOG_RECORD_HEADER_SIZE
+                               + start - delta->offset,
+                               end - start);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+    }
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Finds the current version of a file.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ * \param[in]     fid     ID of the file
+ *
+ * \return The file table entry of the file, or NULL if it does not exist
+ */
+static struct its_log_file_t *its_log_find_file(
+                                              struct its_flash_fs_ctx_t *fs_ctx,
+                                              const uint8_t *fid)
+{
+    uint32_t i;
+
+    if (its_utils_validate_fid(fid) != PSA_SUCCESS) {
+        return NULL;
+    }
+
+    for (i = 0; i < fs_ctx->flash_info->max_num_files; i++) {
+        if (!tfm_memcmp(fs_ctx->file[i].id, fid, ITS_FILE_ID_SIZE)) {
+            return &fs_ctx->file[i];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * \brief Gets a free entry of the file table.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ *
+ * \return The free file table entry, or NULL if the table is full
+ */
+static struct its_log_file_t *its_log_get_free_file(
+                                              struct its_flash_fs_ctx_t *fs_ctx)
+{
+    uint32_t i;
+
+    for (i = 0; i < fs_ctx->flash_info->max_num_files; i++) {
+        if (its_utils_validate_fid(fs_ctx->file[i].id) != PSA_SUCCESS) {
+            return &fs_ctx->file[i];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * \brief Gets the size of the current records stored in a block.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ * \param[in]     block   Physical block
+ *
+ * \return The number of bytes that a reclaim of the block copies
+ */
+static size_t its_log_live_size(struct its_flash_fs_ctx_t *fs_ctx,
+                                uint32_t block)
+{
+    const struct its_log_file_t *file;
+    uint32_t i;
+    uint32_t j;
+    size_t size = 0;
+
+    for (i = 0; i < fs_ctx->flash_info->max_num_files; i++) {
+        file = &fs_ctx->file[i];
+        if (its_utils_validate_fid(file->id) != PSA_SUCCESS) {
+            continue;
+        }
+
+        if (file->block == block) {
+            size += ITS_LOG_RECORD_SIZE(file->base_size);
+        }
+
+        for (j = 0; j < file->num_deltas; j++) {
+            if (file->delta[j].block == block) {
+                size += ITS_LOG_RECORD_SIZE(file->delta[j].size);
+            }
+        }
+    }
+
+    return size;
+}
+
+/**
+ * \brief Gets the number of blocks which are not in use.
+ *
+ * \param[in,out] fs_ctx     Filesystem context
+ * \param[out]    first_free First block which is not in use, preferably an
+ *                           erased one
+ *
+ * \return The number of blocks which are not in use
+ */
+static uint32_t its_log_num_free_blocks(struct its_flash_fs_ctx_t *fs_ctx,
+                                        uint32_t *first_free)
+{
+    uint32_t i;
+    uint32_t num_free = 0;
+
+    *first_free = ITS_BLOCK_INVALID_ID;
+
+    for (i = 0; i < fs_ctx->flash_info->num_blocks; i++) {
+        if (fs_ctx->block[i].state == ITS_LOG_BLOCK_IN_USE) {
+            continue;
+        }
+
+        if ((*first_free == ITS_BLOCK_INVALID_ID) ||
+            (fs_ctx->block[i].state == ITS_LOG_BLOCK_ERASED)) {
+            *first_free = i;
+        }
+        num_free++;
+    }
+
+    return num_free;
+}
+
+/**
+ * \brief Opens a block which is not in use as the head of the log.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ * \param[in]     block   Physical block
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_log_open_block(struct its_flash_fs_ctx_t *fs_ctx,
+                                       uint32_t block)
+{
+    psa_status_t err;
+    struct its_log_block_header_t header;
+
+    if (fs_ctx->block[block].state != ITS_LOG_BLOCK_ERASED) {
+        err = fs_ctx->flash_info->erase(fs_ctx->flash_info, block);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+    }
+
+    /* The block is erased again if its header is not programmed */
+    fs_ctx->block[block].state = ITS_LOG_BLOCK_FREE;
+
+    (void)tfm_memset(&header, 0, ITS_LOG_BLOCK_HEADER_SIZE);
+    header.magic = ITS_LOG_BLOCK_MAGIC;
+    header.seq = fs_ctx->next_seq;
+    header.fs_version = ITS_LOG_FS_VERSION;
+
+    err = fs_ctx->flash_info->write(fs_ctx->flash_info, block,
+                                    (const uint8_t *)&header, 0,
+                                    ITS_LOG_BLOCK_HEADER_SIZE);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    err = fs_ctx->flash_info->flush(fs_ctx->flash_info);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    fs_ctx->block[block].seq = fs_ctx->next_seq++;
+    fs_ctx->block[block].used = ITS_LOG_BLOCK_HEADER_SIZE;
+    fs_ctx->block[block].state = ITS_LOG_BLOCK_IN_USE;
+    fs_ctx->head = block;
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Starts staging a record at the end of the head block.
+ *
+ * \note The space of the record is consumed even if the record is not
+ *       committed, so that no unit which may have been partially programmed
+ *       is programmed again.
+ *
+ * \param[in,out] fs_ctx     Filesystem context
+ * \param[out]    writer     Record writer
+ * \param[in]     data_size  Size of the file data of the record
+ */
+__attribute__((always_inline))
+static inline void its_log_writer_init(struct its_flash_fs_ctx_t *fs_ctx,
+                                       struct its_log_writer_t *writer,
+                                       size_t data_size)
+{
+    writer->fs_ctx = fs_ctx;
+    writer->start = fs_ctx->block[fs_ctx->head].used;
+    writer->pos = writer->start;
+    writer->fill = 0;
+
+    fs_ctx->block[fs_ctx->head].used += ITS_LOG_RECORD_SIZE(data_size);
+}
+
+/**
+ * \brief Programs the staged data, padded to the flash alignment.
+ *
+ * \param[in,out] writer  Record writer
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_log_writer_flush(struct its_log_writer_t *writer)
+{
+    psa_status_t err;
+    size_t size = ITS_UTILS_ALIGN(writer->fill, ITS_FLASH_MAX_ALIGNMENT);
+
+    (void)tfm_memset(writer->buf + writer->fill, 0, size - writer->fill);
+
+    err = writer->fs_ctx->flash_info->write(writer->fs_ctx->flash_info,
+                                            writer->fs_ctx->head, writer->buf,
+                                            writer->pos, size);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    writer->pos += size;
+    writer->fill = 0;
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Stages data of a record.
+ *
+ * \param[in,out] writer      Record writer
+ * \param[in]     data        Data to stage, or NULL to read it from flash
+ * \param[in]     src_block   Physical block of the data when data is NULL, or
+ *                            ITS_BLOCK_INVALID_ID to stage zeros
+ * \param[in]     src_offset  Offset of the data in src_block
+ * \param[in]     size        Number of bytes to stage
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_log_writer_add(struct its_log_writer_t *writer,
+                                       const uint8_t *data, uint32_t src_block,
+                                       size_t src_offset, size_t size)
+{
+    const struct its_flash_info_t *flash_info = writer->fs_ctx->flash_info;
+    psa_status_t err;
+    size_t chunk;
+
+    while (size > 0) {
+        if (writer->fill == ITS_LOG_WRITE_BUF_SIZE) {
+            err = its_log_writer_flush(writer);
+            if (err != PSA_SUCCESS) {
+                return err;
+            }
+        }
+
+        chunk = ITS_UTILS_MIN(size, ITS_LOG_WRITE_BUF_SIZE - writer->fill);
+
+        if (data != NULL) {
+            (void)tfm_memcpy(writer->buf + writer->fill, data, chunk);
+            data += chunk;
+        } else if (src_block != ITS_BLOCK_INVALID_ID) {
+            err = flash_info->read(flash_info, src_block,
+                                   writer->buf + writer->fill, src_offset,
+                                   chunk);
+            if (err != PSA_SUCCESS) {
+                return err;
+            }
+            src_offset += chunk;
+        } else {
+            (void)tfm_memset(writer->buf + writer->fill, 0, chunk);
+        }
+
+        writer->fill += chunk;
+        size -= chunk;
+    }
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Stages file data, with the delta records applied over the file
+ *        record.
+ *
+ * \param[in,out] writer  Record writer
+ * \param[in]     file    Current version of the file
+ * \param[in]     offset  Offset in the file
+ * \param[in]     size    Number of bytes to stage
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_log_writer_add_file(struct its_log_writer_t *writer,
+                                            const struct its_log_file_t *file,
+                                            size_t offset, size_t size)
+{
+    psa_status_t err;
+    size_t chunk;
+
+    while (size > 0) {
+        if (writer->fill == ITS_LOG_WRITE_BUF_SIZE) {
+            err = its_log_writer_flush(writer);
+            if (err != PSA_SUCCESS) {
+                return err;
+            }
+        }
+
+        chunk = ITS_UTILS_MIN(size, ITS_LOG_WRITE_BUF_SIZE - writer->fill);
+
+        err = its_log_read_data(writer->fs_ctx, file, offset, chunk,
+                                writer->buf + writer->fill);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+
+        writer->fill += chunk;
+        offset += chunk;
+        size -= chunk;
+    }
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Stages the header of a record.
+ *
+ * \param[in,out] writer         Record writer
+ * \param[in]     type           Type of the record
+ * \param[in]     file           Attributes of the file version, or NULL for a
+ *                               record which does not hold a file
+ * \param[in]     offset         Offset in the file of the data of the record
+ * \param[in]     data_size      Size of the data of the record
+ * \param[in]     reclaimed_seq  Sequence number of the reclaimed block
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_log_writer_add_header(
+                                          struct its_log_writer_t *writer,
+                                          uint32_t type,
+                                          const struct its_log_file_t *file,
+                                          size_t offset, size_t data_size,
+                                          uint32_t reclaimed_seq)
+{
+    struct its_log_record_t record;
+
+    (void)tfm_memset(&record, 0, ITS_LOG_RECORD_HEADER_SIZE);
+    record.magic = ITS_LOG_RECORD_MAGIC;
+    record.type = type;
+    record.reclaimed_seq = reclaimed_seq;
+    record.offset = offset;
+    record.cur_size = data_size;
+
+    if (file != NULL) {
+        record.version = file->version;
+        record.max_size = file->max_size;
+        record.flags = file->flags;
+        (void)tfm_memcpy(record.id, file->id, ITS_FILE_ID_SIZE);
+    }
+
+    return its_log_writer_add(writer, (const uint8_t *)&record,
+                              ITS_BLOCK_INVALID_ID, 0,
+                              ITS_LOG_RECORD_HEADER_SIZE);
+}
+
+/**
+ * \brief Programs the rest of a staged record and commits it.
+ *
+ * \param[in,out] writer     Record writer
+ * \param[in]     data_size  Size of the file data of the record
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_log_writer_commit(struct its_log_writer_t *writer,
+                                          size_t data_size)
+{
+    struct its_flash_fs_ctx_t *fs_ctx = writer->fs_ctx;
+    psa_status_t err;
+
+    if (writer->fill > 0) {
+        err = its_log_writer_flush(writer);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+    }
+
+    err = fs_ctx->flash_info->flush(fs_ctx->flash_info);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    /* The commit marker is programmed once the record is in flash, so that
+     * a record interrupted by a power failure is ignored by the replay.
+     */
+    return its_log_write_marker(fs_ctx, fs_ctx->head,
+                                its_log_commit_offset(writer->start, data_size),
+                                ITS_LOG_MARKER_COMMIT);
+}
+
+/**
+ * \brief Copies a current record to the head of the log.
+ *
+ * \note The copy is newer than the original, so it is the current record if
+ *       the reclaim is interrupted.
+ *
+ * \param[in,out] fs_ctx     Filesystem context
+ * \param[in,out] block      Physical block of the record, updated to the head
+ *                           block
+ * \param[in,out] pos        Offset of the record in the block, updated to the
+ *                           offset of the copy
+ * \param[in]     data_size  Size of the data of the record
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_log_copy_record(struct its_flash_fs_ctx_t *fs_ctx,
+                                        uint32_t *block, size_t *pos,
+                                        size_t data_size)
+{
+    psa_status_t err;
+    struct its_log_writer_t writer;
+
+    its_log_writer_init(fs_ctx, &writer, data_size);
+    err = its_log_writer_add(&writer, NULL, *block, *pos,
+                             ITS_LOG_RECORD_HEADER_SIZE
+                             + ITS_UTILS_ALIGN(data_size,
+                                               ITS_FLASH_MAX_ALIGNMENT));
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    err = its_log_writer_commit(&writer, data_size);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    *block = fs_ctx->head;
+    *pos = writer.start;
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Reclaims the space of obsolete records, by copying the current
+ *        records of the block which holds the fewest to the head of the log
+ *        and erasing the block.
+ *
+ * \note When no block is free, a reclaim has been interrupted after it opened
+ *       the head block, so it is resumed by copying the records of another
+ *       block to the head block.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_log_reclaim(struct its_flash_fs_ctx_t *fs_ctx)
+{
+    psa_status_t err;
+    uint32_t first_free;
+    uint32_t i;
+    uint32_t j;
+    size_t live_size;
+    size_t min_live_size = SIZE_MAX;
+    uint32_t num_free = its_log_num_free_blocks(fs_ctx, &first_free);
+    struct its_log_file_t *file;
+    uint32_t victim = ITS_BLOCK_INVALID_ID;
+    struct its_log_writer_t writer;
+
+    for (i = 0; i < fs_ctx->flash_info->num_blocks; i++) {
+        if ((fs_ctx->block[i].state != ITS_LOG_BLOCK_IN_USE) ||
+            ((num_free == 0) && (i == fs_ctx->head))) {
+            continue;
+        }
+
+        live_size = its_log_live_size(fs_ctx, i);
+        if (live_size < min_live_size) {
+            min_live_size = live_size;
+            victim = i;
+        }
+    }
+
+    if (victim == ITS_BLOCK_INVALID_ID) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    /* Every block is full of current records */
+    if ((min_live_size + ITS_LOG_RECORD_SIZE(0)) >
+        (fs_ctx->flash_info->block_size - ITS_LOG_BLOCK_HEADER_SIZE)) {
+        return PSA_ERROR_INSUFFICIENT_STORAGE;
+    }
+
+    /* The records are copied to a new head block if they do not fit with the
+     * reclaim record in the current one.
+     */
+    if ((victim == fs_ctx->head) ||
+        ((min_live_size + ITS_LOG_RECORD_SIZE(0)) >
+         (fs_ctx->flash_info->block_size - fs_ctx->block[fs_ctx->head].used))) {
+        if (num_free == 0) {
+            return PSA_ERROR_INSUFFICIENT_STORAGE;
+        }
+
+        err = its_log_open_block(fs_ctx, first_free);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+    }
+
+    for (i = 0; i < fs_ctx->flash_info->max_num_files; i++) {
+        file = &fs_ctx->file[i];
+        if (its_utils_validate_fid(file->id) != PSA_SUCCESS) {
+            continue;
+        }
+
+        if (file->block == victim) {
+            err = its_log_copy_record(fs_ctx, &file->block, &file->pos,
+                                      file->base_size);
+            if (err != PSA_SUCCESS) {
+                return err;
+            }
+        }
+
+        for (j = 0; j < file->num_deltas; j++) {
+            if (file->delta[j].block == victim) {
+                err = its_log_copy_record(fs_ctx, &file->delta[j].block,
+                                          &file->delta[j].pos,
+                                          file->delta[j].size);
+                if (err != PSA_SUCCESS) {
+                    return err;
+                }
+            }
+        }
+    }
+
+    /* The reclaim record makes the replay ignore the records left in the
+     * block if its erase is interrupted.
+     */
+    its_log_writer_init(fs_ctx, &writer, 0);
+    err = its_log_writer_add_header(&writer, ITS_LOG_RECORD_RECLAIM, NULL, 0, 0,
+                                    fs_ctx->block[victim].seq);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    err = its_log_writer_commit(&writer, 0);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    fs_ctx->block[victim].state = ITS_LOG_BLOCK_FREE;
+
+    err = fs_ctx->flash_info->erase(fs_ctx->flash_info, victim);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    fs_ctx->block[victim].state = ITS_LOG_BLOCK_ERASED;
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Makes room for a record at the end of the head block.
+ *
+ * \note One block which is not in use is kept to reclaim blocks, so a new
+ *       head block is only opened while there are two of them.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ * \param[in]     size    Size of the record
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_log_reserve(struct its_flash_fs_ctx_t *fs_ctx,
+                                    size_t size)
+{
+    psa_status_t err;
+    uint32_t first_free;
+    uint32_t i;
+
+    for (i = 0; i < (2U * fs_ctx->flash_info->num_blocks); i++) {
+        if (size <= (fs_ctx->flash_info->block_size
+                     - fs_ctx->block[fs_ctx->head].used)) {
+            return PSA_SUCCESS;
+        }
+
+        if (its_log_num_free_blocks(fs_ctx, &first_free) > 1) {
+            err = its_log_open_block(fs_ctx, first_free);
+        } else {
+            err = its_log_reclaim(fs_ctx);
+        }
+
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+    }
+
+    return PSA_ERROR_INSUFFICIENT_STORAGE;
+}
+
+/**
+ * \brief Checks that a record of the given size can be appended to the log,
+ *        with the current records of all the files.
+ *
+ * \note When a block has to be reclaimed to make room for the record, the
+ *       block which holds the fewest current records is copied to a new block,
+ *       where the reclaim record and the record must fit after them. As the
+ *       blocks in use, which are all but the one kept to reclaim blocks, hold
+ *       all the current records, that block holds at most an even share of
+ *       them.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ * \param[in]     size    Size of the record
+ *
+ * \return Returns PSA_SUCCESS if the record fits, or
+ *         PSA_ERROR_INSUFFICIENT_STORAGE otherwise
+ */
+static psa_status_t its_log_check_space(struct its_flash_fs_ctx_t *fs_ctx,
+                                        size_t size)
+{
+    const struct its_flash_info_t *flash_info = fs_ctx->flash_info;
+    const struct its_log_file_t *file;
+    size_t free_size;
+    uint32_t i;
+    uint32_t j;
+    size_t live_size = 0;
+
+    if ((ITS_LOG_BLOCK_HEADER_SIZE + ITS_LOG_RECORD_SIZE(0) + size) >
+        flash_info->block_size) {
+        return PSA_ERROR_INSUFFICIENT_STORAGE;
+    }
+
+    free_size = flash_info->block_size - ITS_LOG_BLOCK_HEADER_SIZE
+                - ITS_LOG_RECORD_SIZE(0) - size;
+
+    for (i = 0; i < flash_info->max_num_files; i++) {
+        file = &fs_ctx->file[i];
+        if (its_utils_validate_fid(file->id) != PSA_SUCCESS) {
+            continue;
+        }
+
+        live_size += ITS_LOG_RECORD_SIZE(file->base_size);
+        for (j = 0; j < file->num_deltas; j++) {
+            live_size += ITS_LOG_RECORD_SIZE(file->delta[j].size);
+        }
+    }
+
+    if (live_size > ((flash_info->num_blocks - 1U) * free_size)) {
+        return PSA_ERROR_INSUFFICIENT_STORAGE;
+    }
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Appends a new version of a file to the log, made of the current
+ *        version with data written at an offset, and makes it current.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ * \param[in,out] file    File table entry of the file, a free entry for a new
+ *                        file
+ * \param[in]     attr    ID, flags and maximum size of the file
+ * \param[in]     offset  Offset of the data in the file
+ * \param[in]     size       Size of the data
+ * \param[in]     data       Data to write, or NULL to read it with read_data
+ * \param[in]     buf        Buffer to stage each chunk read with read_data
+ * \param[in]     buf_size   Size of buf
+ * \param[in]     read_data  Function which reads the next chunk of the data,
+ *                           or NULL
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_log_append_file(struct its_flash_fs_ctx_t *fs_ctx,
+                                        struct its_log_file_t *file,
+                                        const struct its_log_file_t *attr,
+                                        size_t offset, size_t size,
+                                        const uint8_t *data, uint8_t *buf,
+                                        size_t buf_size,
+                                        its_flash_fs_read_data_t read_data)
+{
+    size_t chunk;
+    psa_status_t err;
+    size_t remaining = size;
+    struct its_log_file_t new_file = *attr;
+    struct its_log_file_t old_file;
+    size_t old_size = 0;
+    struct its_log_writer_t writer;
+
+    if (its_utils_validate_fid(file->id) == PSA_SUCCESS) {
+        old_size = file->cur_size;
+    }
+
+    new_file.cur_size = ITS_UTILS_MAX(old_size, offset + size);
+    new_file.base_size = new_file.cur_size;
+    new_file.num_deltas = 0;
+
+    /* The current version stays in the log until the new one is committed */
+    err = its_log_check_space(fs_ctx, ITS_LOG_RECORD_SIZE(new_file.cur_size));
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    err = its_log_reserve(fs_ctx, ITS_LOG_RECORD_SIZE(new_file.cur_size));
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    /* Making room may have moved the current version */
+    old_file = *file;
+    new_file.version = its_log_file_version(&old_file) + 1U;
+
+    its_log_writer_init(fs_ctx, &writer, new_file.cur_size);
+    err = its_log_writer_add_header(&writer, ITS_LOG_RECORD_FILE, &new_file, 0,
+                                    new_file.cur_size, 0);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    /* Current data before the offset, then zeros up to the offset */
+    err = its_log_writer_add_file(&writer, &old_file, 0,
+                                  ITS_UTILS_MIN(offset, old_size));
+    if (err == PSA_SUCCESS && offset > old_size) {
+        err = its_log_writer_add(&writer, NULL, ITS_BLOCK_INVALID_ID, 0,
+                                 offset - old_size);
+    }
+
+    if (read_data == NULL) {
+        if (err == PSA_SUCCESS) {
+            err = its_log_writer_add(&writer, data, ITS_BLOCK_INVALID_ID, 0,
+                                     size);
+        }
+    } else {
+        /* The data is read one chunk at a time into the same record */
+        while ((err == PSA_SUCCESS) && (remaining > 0)) {
+            chunk = ITS_UTILS_MIN(remaining, buf_size);
+            (void)read_data(buf, chunk);
+            err = its_log_writer_add(&writer, buf, ITS_BLOCK_INVALID_ID, 0,
+                                     chunk);
+            remaining -= chunk;
+        }
+    }
+
+    /* Current data after the written data */
+    if (err == PSA_SUCCESS && (offset + size) < old_size) {
+        err = its_log_writer_add_file(&writer, &old_file, offset + size,
+                                      old_size - (offset + size));
+    }
+
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    new_file.block = fs_ctx->head;
+    new_file.pos = writer.start;
+
+    err = its_log_writer_commit(&writer, new_file.cur_size);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    *file = new_file;
+
+    /* If the previous version is not discarded, the replay discards it as the
+     * older of the two.
+     */
+    if (its_utils_validate_fid(old_file.id) == PSA_SUCCESS) {
+        return its_log_discard_file(fs_ctx, &old_file);
+    }
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Appends a delta record with data written at an offset of a file, to
+ *        be applied over its current version.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ * \param[in,out] file    File table entry of the file
+ * \param[in]     offset  Offset of the data in the file, at most its size
+ * \param[in]     size    Size of the data
+ * \param[in]     data    Data to write
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_log_append_delta(struct its_flash_fs_ctx_t *fs_ctx,
+                                         struct its_log_file_t *file,
+                                         size_t offset, size_t size,
+                                         const uint8_t *data)
+{
+    struct its_log_delta_t delta;
+    psa_status_t err;
+    struct its_log_file_t attr;
+    struct its_log_writer_t writer;
+
+    err = its_log_check_space(fs_ctx, ITS_LOG_RECORD_SIZE(size));
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    err = its_log_reserve(fs_ctx, ITS_LOG_RECORD_SIZE(size));
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    attr = *file;
+    attr.version = its_log_file_version(file) + 1U;
+
+    its_log_writer_init(fs_ctx, &writer, size);
+    err = its_log_writer_add_header(&writer, ITS_LOG_RECORD_DELTA, &attr,
+                                    offset, size, 0);
+    if (err == PSA_SUCCESS) {
+        err = its_log_writer_add(&writer, data, ITS_BLOCK_INVALID_ID, 0, size);
+    }
+
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    delta.block = fs_ctx->head;
+    delta.pos = writer.start;
+    delta.offset = offset;
+    delta.size = size;
+    delta.version = attr.version;
+
+    err = its_log_writer_commit(&writer, size);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    /* The previous version stays current, under the delta record */
+    file->delta[file->num_deltas++] = delta;
+    file->cur_size = ITS_UTILS_MAX(file->cur_size, offset + size);
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Reads and validates the record at an offset of a block.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ * \param[in]     block   Physical block
+ * \param[in]     pos     Offset of the record in the block
+ * \param[out]    record     Header of the record
+ * \param[out]    committed  Set to 1 if the record is committed, 0 if it has
+ *                           been interrupted before its commit marker
+ *
+ * \return Returns PSA_SUCCESS for a record with a valid header,
+ *         PSA_ERROR_DOES_NOT_EXIST at the end of the log of the block, or
+ *         PSA_ERROR_DATA_CORRUPT for a record whose header is not valid
+ */
+static psa_status_t its_log_read_record(struct its_flash_fs_ctx_t *fs_ctx,
+                                        uint32_t block, size_t pos,
+                                        struct its_log_record_t *record,
+                                        uint32_t *committed)
+{
+    const struct its_flash_info_t *flash_info = fs_ctx->flash_info;
+    psa_status_t err;
+    struct its_log_marker_t marker;
+
+    if ((pos + ITS_LOG_RECORD_SIZE(0)) > flash_info->block_size) {
+        return PSA_ERROR_DOES_NOT_EXIST;
+    }
+
+    err = flash_info->read(flash_info, block, (uint8_t *)record, pos,
+                           ITS_LOG_RECORD_HEADER_SIZE);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    if (record->magic != ITS_LOG_RECORD_MAGIC) {
+        return (record->magic == its_log_erased_word(fs_ctx))
+               ? PSA_ERROR_DOES_NOT_EXIST : PSA_ERROR_DATA_CORRUPT;
+    }
+
+    if ((record->type == ITS_LOG_RECORD_FILE) ||
+        (record->type == ITS_LOG_RECORD_DELTA)) {
+        if ((its_utils_validate_fid(record->id) != PSA_SUCCESS) ||
+            (record->max_size > flash_info->max_file_size) ||
+            (record->cur_size > record->max_size) ||
+            (record->offset > (record->max_size - record->cur_size))) {
+            return PSA_ERROR_DATA_CORRUPT;
+        }
+    } else if ((record->type != ITS_LOG_RECORD_RECLAIM) ||
+               (record->cur_size != 0)) {
+        return PSA_ERROR_DATA_CORRUPT;
+    }
+
+    if ((pos + ITS_LOG_RECORD_SIZE(record->cur_size)) >
+        flash_info->block_size) {
+        return PSA_ERROR_DATA_CORRUPT;
+    }
+
+    err = flash_info->read(flash_info, block, (uint8_t *)&marker,
+                           its_log_commit_offset(pos, record->cur_size),
+                           ITS_LOG_MARKER_SIZE);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    *committed = (marker.value == ITS_LOG_MARKER_COMMIT) ? 1U : 0U;
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Removes from the file table the records which are stored in blocks
+ *        that are no longer in use.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ */
+static void its_log_drop_freed(struct its_flash_fs_ctx_t *fs_ctx)
+{
+    struct its_log_file_t *file;
+    uint32_t i;
+    uint32_t j;
+    uint32_t num_deltas;
+
+    for (i = 0; i < fs_ctx->flash_info->max_num_files; i++) {
+        file = &fs_ctx->file[i];
+        if (its_utils_validate_fid(file->id) != PSA_SUCCESS) {
+            continue;
+        }
+
+        if ((file->block != ITS_BLOCK_INVALID_ID) &&
+            (fs_ctx->block[file->block].state == ITS_LOG_BLOCK_FREE)) {
+            file->block = ITS_BLOCK_INVALID_ID;
+        }
+
+        num_deltas = 0;
+        for (j = 0; j < file->num_deltas; j++) {
+            if (fs_ctx->block[file->delta[j].block].state
+                != ITS_LOG_BLOCK_FREE) {
+                file->delta[num_deltas++] = file->delta[j];
+            }
+        }
+        file->num_deltas = num_deltas;
+    }
+}
+
+/**
+ * \brief Applies a current file or delta record to the file table.
+ *
+ * \note A record is replayed more than once if a reclaim which copied it has
+ *       been interrupted, and the delta records of a file may be replayed
+ *       before its file record if a reclaim moved the file record.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ * \param[in]     block   Physical block of the record
+ * \param[in]     pos     Offset of the record in the block
+ * \param[in]     record  Header of the record
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_log_replay_file(struct its_flash_fs_ctx_t *fs_ctx,
+                                        uint32_t block, size_t pos,
+                                        const struct its_log_record_t *record)
+{
+    struct its_log_delta_t *delta;
+    psa_status_t err;
+    struct its_log_file_t *file = its_log_find_file(fs_ctx, record->id);
+    uint32_t i;
+    uint32_t num_deltas = 0;
+
+    if (file == NULL) {
+        file = its_log_get_free_file(fs_ctx);
+        if (file == NULL) {
+            return PSA_ERROR_GENERIC_ERROR;
+        }
+
+        (void)tfm_memcpy(file->id, record->id, ITS_FILE_ID_SIZE);
+        file->block = ITS_BLOCK_INVALID_ID;
+        file->max_size = record->max_size;
+        file->flags = record->flags;
+    }
+
+    /* Discard a record older than the file record, as the update which made
+     * it obsolete has been interrupted.
+     */
+    if ((file->block != ITS_BLOCK_INVALID_ID) &&
+        ((record->version < file->version) ||
+         ((record->version == file->version) &&
+          (record->type == ITS_LOG_RECORD_DELTA)))) {
+        return its_log_mark_obsolete(fs_ctx, block, pos, record->cur_size);
+    }
+
+    if (record->type == ITS_LOG_RECORD_FILE) {
+        if ((file->block != ITS_BLOCK_INVALID_ID) &&
+            (record->version > file->version)) {
+            err = its_log_mark_obsolete(fs_ctx, file->block, file->pos,
+                                        file->base_size);
+            if (err != PSA_SUCCESS) {
+                return err;
+            }
+        }
+
+        /* Only the delta records of later versions apply over this one */
+        for (i = 0; i < file->num_deltas; i++) {
+            delta = &file->delta[i];
+            if (delta->version > record->version) {
+                file->delta[num_deltas++] = *delta;
+            } else {
+                err = its_log_mark_obsolete(fs_ctx, delta->block, delta->pos,
+                                            delta->size);
+                if (err != PSA_SUCCESS) {
+                    return err;
+                }
+            }
+        }
+
+        file->num_deltas = num_deltas;
+        file->block = block;
+        file->pos = pos;
+        file->version = record->version;
+        file->base_size = record->cur_size;
+    } else {
+        /* Keep the delta records ordered from the oldest, a copy of a record
+         * replacing the original.
+         */
+        for (i = 0; i < file->num_deltas; i++) {
+            if (file->delta[i].version >= record->version) {
+                break;
+            }
+        }
+
+        if ((i == file->num_deltas) ||
+            (file->delta[i].version != record->version)) {
+            if (file->num_deltas == ITS_LOG_FS_MAX_DELTAS) {
+                return PSA_ERROR_GENERIC_ERROR;
+            }
+
+            for (num_deltas = file->num_deltas; num_deltas > i; num_deltas--) {
+                file->delta[num_deltas] = file->delta[num_deltas - 1];
+            }
+            file->num_deltas++;
+        }
+
+        delta = &file->delta[i];
+        delta->block = block;
+        delta->pos = pos;
+        delta->offset = record->offset;
+        delta->size = record->cur_size;
+        delta->version = record->version;
+    }
+
+    file->cur_size = file->base_size;
+    for (i = 0; i < file->num_deltas; i++) {
+        file->cur_size = ITS_UTILS_MAX(file->cur_size,
+                                       file->delta[i].offset
+                                       + file->delta[i].size);
+    }
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Applies the committed records of a block to the file table.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ * \param[in]     block   Physical block
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_log_replay_block(struct its_flash_fs_ctx_t *fs_ctx,
+                                         uint32_t block)
+{
+    uint32_t committed;
+    psa_status_t err;
+    uint32_t i;
+    struct its_log_marker_t marker;
+    size_t pos = ITS_LOG_BLOCK_HEADER_SIZE;
+    struct its_log_record_t record;
+
+    while ((err = its_log_read_record(fs_ctx, block, pos, &record, &committed))
+           == PSA_SUCCESS) {
+        if (!committed) {
+            /* The space of a record interrupted before its commit marker is
+             * skipped, as its units may have been partially programmed.
+             */
+        } else if (record.type == ITS_LOG_RECORD_RECLAIM) {
+            /* The records of the reclaimed block which are still current
+             * have been discarded before the block was erased.
+             */
+            for (i = 0; i < fs_ctx->flash_info->num_blocks; i++) {
+                if ((fs_ctx->block[i].state == ITS_LOG_BLOCK_IN_USE) &&
+                    (fs_ctx->block[i].seq == record.reclaimed_seq) &&
+                    (i != block)) {
+                    fs_ctx->block[i].state = ITS_LOG_BLOCK_FREE;
+                }
+            }
+
+            its_log_drop_freed(fs_ctx);
+        } else {
+            err = fs_ctx->flash_info->read(fs_ctx->flash_info, block,
+                                           (uint8_t *)&marker,
+                                           its_log_commit_offset(pos,
+                                                              record.cur_size)
+                                           + ITS_LOG_MARKER_SIZE,
+                                           ITS_LOG_MARKER_SIZE);
+            if (err != PSA_SUCCESS) {
+                return err;
+            }
+
+            if (marker.value == its_log_erased_word(fs_ctx)) {
+                err = its_log_replay_file(fs_ctx, block, pos, &record);
+                if (err != PSA_SUCCESS) {
+                    return err;
+                }
+            }
+        }
+
+        pos += ITS_LOG_RECORD_SIZE(record.cur_size);
+    }
+
+    if (err == PSA_ERROR_DATA_CORRUPT) {
+        /* Nothing is appended after a record whose header is not complete,
+         * as its size is not known.
+         */
+        pos = fs_ctx->flash_info->block_size;
+    } else if (err != PSA_ERROR_DOES_NOT_EXIST) {
+        return err;
+    }
+
+    fs_ctx->block[block].used = pos;
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t its_flash_fs_prepare(struct its_flash_fs_ctx_t *fs_ctx,
+                                  const struct its_flash_info_t *flash_info)
+{
+    psa_status_t err;
+    struct its_log_block_header_t header;
+    uint32_t first_free;
+    uint32_t i;
+    uint32_t next;
+    uint32_t last_seq = 0;
+    uint32_t num_replayed = 0;
+    uint32_t num_in_use = 0;
+
+    /* Associate the flash device info with the context */
+    fs_ctx->flash_info = flash_info;
+
+    if ((flash_info->num_blocks < 2) ||
+        (flash_info->num_blocks > ITS_LOG_FS_MAX_BLOCKS) ||
+        (flash_info->max_num_files > ITS_LOG_FS_MAX_FILES)) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    /* Initialize Flash Interface */
+    err = flash_info->init(flash_info);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    (void)tfm_memset(fs_ctx->block, 0, sizeof(fs_ctx->block));
+    (void)tfm_memset(fs_ctx->file, 0, sizeof(fs_ctx->file));
+
+    for (i = 0; i < flash_info->num_blocks; i++) {
+        err = flash_info->read(flash_info, i, (uint8_t *)&header, 0,
+                               ITS_LOG_BLOCK_HEADER_SIZE);
+        if ((err == PSA_SUCCESS) &&
+            (header.magic == ITS_LOG_BLOCK_MAGIC) &&
+            (header.fs_version == ITS_LOG_FS_VERSION)) {
+            fs_ctx->block[i].seq = header.seq;
+            fs_ctx->block[i].state = ITS_LOG_BLOCK_IN_USE;
+            num_in_use++;
+        }
+    }
+
+    if (num_in_use == 0) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    /* Replay the blocks in the order in which they have been opened */
+    while (num_replayed < num_in_use) {
+        next = ITS_BLOCK_INVALID_ID;
+        for (i = 0; i < flash_info->num_blocks; i++) {
+            if ((fs_ctx->block[i].state == ITS_LOG_BLOCK_IN_USE) &&
+                ((num_replayed == 0) || (fs_ctx->block[i].seq > last_seq)) &&
+                ((next == ITS_BLOCK_INVALID_ID) ||
+                 (fs_ctx->block[i].seq < fs_ctx->block[next].seq))) {
+                next = i;
+            }
+        }
+
+        if (next == ITS_BLOCK_INVALID_ID) {
+            /* The remaining blocks have been reclaimed */
+            break;
+        }
+
+        err = its_log_replay_block(fs_ctx, next);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+
+        last_seq = fs_ctx->block[next].seq;
+        fs_ctx->head = next;
+        num_replayed++;
+    }
+
+    fs_ctx->next_seq = last_seq + 1;
+
+    /* Finish the deletions which were interrupted after the file record was
+     * discarded.
+     */
+    for (i = 0; i < flash_info->max_num_files; i++) {
+        if ((its_utils_validate_fid(fs_ctx->file[i].id) == PSA_SUCCESS) &&
+            (fs_ctx->file[i].block == ITS_BLOCK_INVALID_ID)) {
+            err = its_log_discard_file(fs_ctx, &fs_ctx->file[i]);
+            if (err != PSA_SUCCESS) {
+                return err;
+            }
+
+            (void)tfm_memset(&fs_ctx->file[i], 0,
+                             sizeof(struct its_log_file_t));
+        }
+    }
+
+    /* Restore the block kept to reclaim blocks, if a reclaim has been
+     * interrupted after it was opened.
+     */
+    if (its_log_num_free_blocks(fs_ctx, &first_free) == 0) {
+        return its_log_reclaim(fs_ctx);
+    }
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t its_flash_fs_wipe_all(struct its_flash_fs_ctx_t *fs_ctx)
+{
+    psa_status_t err = PSA_SUCCESS;
+    uint32_t i;
+
+    (void)tfm_memset(fs_ctx->block, 0, sizeof(fs_ctx->block));
+    (void)tfm_memset(fs_ctx->file, 0, sizeof(fs_ctx->file));
+
+    /* If a flash error is detected, the code erases the rest of the blocks
+     * anyway to remove all data stored in them.
+     */
+    for (i = 0; i < fs_ctx->flash_info->num_blocks; i++) {
+        if (fs_ctx->flash_info->erase(fs_ctx->flash_info, i) == PSA_SUCCESS) {
+            fs_ctx->block[i].state = ITS_LOG_BLOCK_ERASED;
+        } else {
+            err = PSA_ERROR_STORAGE_FAILURE;
+        }
+    }
+
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    fs_ctx->next_seq = 0;
+
+    return its_log_open_block(fs_ctx, 0);
+}
+
+psa_status_t its_flash_fs_file_exist(struct its_flash_fs_ctx_t *fs_ctx,
+                                     const uint8_t *fid)
+{
+    return (its_log_find_file(fs_ctx, fid) != NULL) ? PSA_SUCCESS
+                                                    : PSA_ERROR_DOES_NOT_EXIST;
+}
+
+psa_status_t its_flash_fs_file_find(struct its_flash_fs_ctx_t *fs_ctx,
+                                    const uint8_t *prefix,
+                                    size_t prefix_len,
+                                    uint32_t *cursor,
+                                    uint8_t *fid)
+{
+    uint32_t i;
+
+    if (prefix_len > ITS_FILE_ID_SIZE) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    for (i = *cursor; i < fs_ctx->flash_info->max_num_files; i++) {
+        if ((its_utils_validate_fid(fs_ctx->file[i].id) == PSA_SUCCESS) &&
+            !tfm_memcmp(fs_ctx->file[i].id, prefix, prefix_len)) {
+            (void)tfm_memcpy(fid, fs_ctx->file[i].id, ITS_FILE_ID_SIZE);
+            *cursor = i + 1;
+            return PSA_SUCCESS;
+        }
+    }
+
+    return PSA_ERROR_DOES_NOT_EXIST;
+}
+
+/**
+ * \brief Creates a file, with initial data which is either given in a buffer
+ *        or read one chunk at a time.
+ *
+ * \param[in,out] fs_ctx     Filesystem context
+ * \param[in]     fid        File ID
+ * \param[in]     max_size   Size of the file to be created
+ * \param[in]     data_size  Size of the initial data
+ * \param[in]     flags      Flags of the file
+ * \param[in]     data       Pointer to the initial data, or NULL to read it
+ *                           with read_data
+ * \param[in]     buf        Buffer to stage each chunk read with read_data
+ * \param[in]     buf_size   Size of buf
+ * \param[in]     read_data  Function which reads the next chunk of the data,
+ *                           or NULL
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_log_create_file(struct its_flash_fs_ctx_t *fs_ctx,
+                                        const uint8_t *fid, size_t max_size,
+                                        size_t data_size, uint32_t flags,
+                                        const uint8_t *data, uint8_t *buf,
+                                        size_t buf_size,
+                                        its_flash_fs_read_data_t read_data)
+{
+    struct its_log_file_t attr;
+    struct its_log_file_t *file;
+
+    /* Check that the file's maximum size is valid */
+    if ((max_size > fs_ctx->flash_info->max_file_size) ||
+        (data_size > max_size)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    /* Check if file already exists */
+    if (its_log_find_file(fs_ctx, fid) != NULL) {
+        /* If it exits return an error as needs to be removed first */
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    file = its_log_get_free_file(fs_ctx);
+    if (file == NULL) {
+        return PSA_ERROR_INSUFFICIENT_STORAGE;
+    }
+
+    (void)tfm_memset(&attr, 0, sizeof(attr));
+    (void)tfm_memcpy(attr.id, fid, ITS_FILE_ID_SIZE);
+    attr.max_size = max_size;
+    attr.flags = flags;
+
+    /* The record is committed once all its data has been programmed */
+    return its_log_append_file(fs_ctx, file, &attr, 0, data_size, data, buf,
+                               buf_size, read_data);
+}
+
+psa_status_t its_flash_fs_file_create(struct its_flash_fs_ctx_t *fs_ctx,
+                                      const uint8_t *fid,
+                                      size_t max_size,
+                                      size_t data_size,
+                                      uint32_t flags,
+                                      const uint8_t *data)
+{
+    return its_log_create_file(fs_ctx, fid, max_size, data_size, flags, data,
+                               NULL, 0, NULL);
+}
+
+psa_status_t its_flash_fs_file_create_chunked(
+                                            struct its_flash_fs_ctx_t *fs_ctx,
+                                            const uint8_t *fid,
+                                            size_t max_size,
+                                            size_t data_size,
+                                            uint32_t flags,
+                                            uint8_t *buf,
+                                            size_t buf_size,
+                                            its_flash_fs_read_data_t read_data)
+{
+    if (buf_size == 0) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    return its_log_create_file(fs_ctx, fid, max_size, data_size, flags, NULL,
+                               buf, buf_size, read_data);
+}
+
+psa_status_t its_flash_fs_file_get_info(struct its_flash_fs_ctx_t *fs_ctx,
+                                        const uint8_t *fid,
+                                        struct its_file_info_t *info)
+{
+    const struct its_log_file_t *file = its_log_find_file(fs_ctx, fid);
+
+    if (file == NULL) {
+        return PSA_ERROR_DOES_NOT_EXIST;
+    }
+
+    info->size_max = file->max_size;
+    info->size_current = file->cur_size;
+    info->flags = file->flags;
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t its_flash_fs_file_write(struct its_flash_fs_ctx_t *fs_ctx,
+                                     const uint8_t *fid,
+                                     size_t size,
+                                     size_t offset,
+                                     const uint8_t *data)
+{
+    struct its_log_file_t *file = its_log_find_file(fs_ctx, fid);
+
+    if (file == NULL) {
+        return PSA_ERROR_DOES_NOT_EXIST;
+    }
+
+    /* Boundary check the incoming request */
+    if (its_utils_check_contained_in(file->max_size, offset, size)
+        != PSA_SUCCESS) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    /* A small write which leaves no gap in the file is appended on its own,
+     * when it takes less flash than a new version of the whole file.
+     */
+    if ((size > 0) && (size <= ITS_LOG_FS_DELTA_MAX_SIZE) &&
+        (offset <= file->cur_size) &&
+        (file->num_deltas < ITS_LOG_FS_MAX_DELTAS) &&
+        (ITS_LOG_RECORD_SIZE(size) <
+         ITS_LOG_RECORD_SIZE(ITS_UTILS_MAX(file->cur_size, offset + size)))) {
+        return its_log_append_delta(fs_ctx, file, offset, size, data);
+    }
+
+    return its_log_append_file(fs_ctx, file, file, offset, size, data, NULL, 0,
+                               NULL);
+}
+
+psa_status_t its_flash_fs_file_delete(struct its_flash_fs_ctx_t *fs_ctx,
+                                      const uint8_t *fid)
+{
+    psa_status_t err;
+    struct its_log_file_t *file = its_log_find_file(fs_ctx, fid);
+
+    if (file == NULL) {
+        return PSA_ERROR_DOES_NOT_EXIST;
+    }
+
+    err = its_log_discard_file(fs_ctx, file);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    (void)tfm_memset(file, 0, sizeof(struct its_log_file_t));
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t its_flash_fs_file_get_addr(struct its_flash_fs_ctx_t *fs_ctx,
+                                        const uint8_t *fid,
+                                        size_t size,
+                                        size_t offset,
+                                        const uint8_t **addr)
+{
+    psa_status_t err;
+    const struct its_log_file_t *file;
+    uint32_t i;
+
+    if (fs_ctx->flash_info->mapped_addr == NULL) {
+        return PSA_ERROR_NOT_SUPPORTED;
+    }
+
+    file = its_log_find_file(fs_ctx, fid);
+    if (file == NULL) {
+        return PSA_ERROR_DOES_NOT_EXIST;
+    }
+
+    /* Boundary check the incoming request */
+    err = its_utils_check_contained_in(file->cur_size, offset, size);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    /* The data is contiguous in flash only where no delta record applies */
+    if ((offset + size) > file->base_size) {
+        return PSA_ERROR_NOT_SUPPORTED;
+    }
+
+    for (i = 0; i < file->num_deltas; i++) {
+        if ((file->delta[i].offset < (offset + size)) &&
+            (offset < (file->delta[i].offset + file->delta[i].size))) {
+            return PSA_ERROR_NOT_SUPPORTED;
+        }
+    }
+
+    *addr = fs_ctx->flash_info->mapped_addr
+            + (file->block * fs_ctx->flash_info->block_size)
+            + file->pos + ITS_LOG_RECORD_HEADER_SIZE + offset;
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t its_flash_fs_file_read(struct its_flash_fs_ctx_t *fs_ctx,
+                                    const uint8_t *fid,
+                                    size_t size,
+                                    size_t offset,
+                                    uint8_t *data)
+{
+    psa_status_t err;
+    const struct its_log_file_t *file = its_log_find_file(fs_ctx, fid);
+
+    if (file == NULL) {
+        return PSA_ERROR_DOES_NOT_EXIST;
+    }
+
+    /* Boundary check the incoming request */
+    err = its_utils_check_contained_in(file->cur_size, offset, size);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    return its_log_read_data(fs_ctx, file, offset, size, data);
+}
@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/**
+ * \file its_flash_fs_log.h
+ *
+ * \brief Log-structured implementation of the ITS filesystem, selected with
+ *        ITS_LOG_FS in place of the metadata block based one.
+ *
+ *        Each flash block holds a header, followed by the records of the log.
+ *        A file record contains the whole content of a version of a file and
+ *        is ended by two markers, programmed after the record: the commit
+ *        marker, which makes the record valid, and the obsolete marker, which
+ *        discards it when a newer version is committed or the file is
+ *        deleted. A small write within or at the end of a file is appended
+ *        as a delta record, which only holds the written range and is applied
+ *        over the file record when the file is read, until the next full
+ *        version of the file discards both. Blocks are reclaimed by copying
+ *        their current records to the head of the log, and the log is replayed
+ *        when the filesystem is prepared to rebuild the RAM file table.
+ *
+ * \note The markers are programmed in flash units which are left erased when
+ *       the record is written, so this filesystem requires a flash device
+ *       which can program the units of a block separately (NOR or RAM).
+ */
+
+#ifndef __ITS_FLASH_FS_LOG_H__
+#define __ITS_FLASH_FS_LOG_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "secure_fw/services/internal_trusted_storage/flash/its_flash.h"
+#include "secure_fw/services/internal_trusted_storage/its_utils.h"
+#include "psa/error.h"
+#if defined(SST_STREAMED_OBJECTS) || defined(SST_TRANSACTIONS) || \
+    defined(SST_OBJ_TABLE_SHARDS)
+#include "secure_fw/services/secure_storage/sst_object_defs.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * \def ITS_LOG_FS_VERSION
+ *
+ * \brief Defines the version of the log format.
+ */
+#define ITS_LOG_FS_VERSION  0x02
+
+/*!
+ * \def ITS_LOG_FS_MAX_FILES
+ *
+ * \brief Defines the largest number of files of a context. By default, it fits
+ *        both the ITS context and the SST context, whose number of files is
+ *        SST_MAX_NUM_OBJECTS.
+ */
+#ifndef ITS_LOG_FS_MAX_FILES
+#if defined(SST_NUM_ASSETS) && \
+    (defined(SST_STREAMED_OBJECTS) || defined(SST_TRANSACTIONS) || \
+     defined(SST_OBJ_TABLE_SHARDS))
+/* The SST context also holds the chunk files of the streamed objects, the
+ * spare objects of the transactions or the object table shards.
+ */
+#define ITS_LOG_FS_MAX_FILES ITS_UTILS_MAX(ITS_NUM_ASSETS, SST_MAX_NUM_OBJECTS)
+#elif defined(SST_NUM_ASSETS) && defined(SST_OBJ_TABLE_JOURNAL)
+#define ITS_LOG_FS_MAX_FILES ITS_UTILS_MAX(ITS_NUM_ASSETS, (SST_NUM_ASSETS + 4))
+#elif defined(SST_NUM_ASSETS)
+#define ITS_LOG_FS_MAX_FILES ITS_UTILS_MAX(ITS_NUM_ASSETS, (SST_NUM_ASSETS + 3))
+#else
+#define ITS_LOG_FS_MAX_FILES ITS_NUM_ASSETS
+#endif
+#endif
+
+/*!
+ * \def ITS_LOG_FS_MAX_BLOCKS
+ *
+ * \brief Defines the largest number of flash blocks of a context. By default,
+ *        it fits both the ITS and the SST flash areas.
+ */
+#ifndef ITS_LOG_FS_MAX_BLOCKS
+#define ITS_LOG_FS_MAX_BLOCKS \
+    ITS_UTILS_MAX((ITS_FLASH_AREA_SIZE / \
+                   (ITS_SECTOR_SIZE * ITS_SECTORS_PER_BLOCK)), \
+                  (SST_FLASH_AREA_SIZE / \
+                   (SST_SECTOR_SIZE * SST_SECTORS_PER_BLOCK)))
+#endif
+
+/*!
+ * \def ITS_LOG_FS_MAX_DELTAS
+ *
+ * \brief Defines the largest number of delta records applied over the current
+ *        file record of a file. The next small write of a file which has as
+ *        many rewrites the whole file.
+ */
+#ifndef ITS_LOG_FS_MAX_DELTAS
+#define ITS_LOG_FS_MAX_DELTAS 4
+#endif
+
+#if ITS_LOG_FS_MAX_DELTAS < 1
+#error "ITS_LOG_FS_MAX_DELTAS must be at least 1"
+#endif
+
+/*!
+ * \def ITS_LOG_FS_DELTA_MAX_SIZE
+ *
+ * \brief Defines the largest write, in bytes, which is appended as a delta
+ *        record. Setting it to 0 disables delta records.
+ */
+#ifndef ITS_LOG_FS_DELTA_MAX_SIZE
+#define ITS_LOG_FS_DELTA_MAX_SIZE 16
+#endif
+
+/*!
+ * \struct its_log_block_header_t
+ *
+ * \brief Structure to store the header of a log block.
+ *
+ * \note This structure is programmed to flash, so it must be aligned to the
+ *       maximum required flash program unit.
+ */
+struct __attribute__((__aligned__(ITS_FLASH_MAX_ALIGNMENT)))
+its_log_block_header_t {
+    uint32_t magic;     /*!< ITS_LOG_BLOCK_MAGIC for a block in use */
+    uint32_t seq;       /*!< Position of the block in the log */
+    uint8_t fs_version; /*!< Version of the log format */
+};
+
+/*!
+ * \struct its_log_record_t
+ *
+ * \brief Structure to store the header of a log record, followed in flash by
+ *        the file data, padded to the flash alignment, and by the commit and
+ *        the obsolete markers.
+ *
+ * \note This structure is programmed to flash, so it must be aligned to the
+ *       maximum required flash program unit.
+ */
+struct __attribute__((__aligned__(ITS_FLASH_MAX_ALIGNMENT)))
+its_log_record_t {
+    uint32_t magic;                /*!< ITS_LOG_RECORD_MAGIC */
+    uint32_t type;                 /*!< Type of the record */
+    uint32_t reclaimed_seq;        /*!< Sequence number of the block whose
+                                    *   records have been copied, for a
+                                    *   reclaim record
+                                    */
+    uint32_t version;              /*!< Version of the file, incremented by
+                                    *   each file or delta record
+                                    */
+    size_t offset;                 /*!< Offset in the file of the data of a
+                                    *   delta record
+                                    */
+    size_t cur_size;               /*!< Size of the data of the record */
+    size_t max_size;               /*!< Maximum size of this file */
+    uint32_t flags;                /*!< Flags set when the file was created */
+    uint8_t id[ITS_FILE_ID_SIZE];  /*!< ID of this file */
+};
+
+/*!
+ * \struct its_log_marker_t
+ *
+ * \brief Structure to store a marker which ends a log record.
+ *
+ * \note This structure is programmed to flash on its own, so it must be
+ *       aligned to the maximum required flash program unit.
+ */
+struct __attribute__((__aligned__(ITS_FLASH_MAX_ALIGNMENT)))
+its_log_marker_t {
+    uint32_t value; /*!< Value of the marker */
+};
+
+/*!
+ * \def ITS_LOG_RECORD_SIZE
+ *
+ * \brief Evaluates to the size in flash of a record with \p data_size bytes of
+ *        file data.
+ */
+#define ITS_LOG_RECORD_SIZE(data_size) \
+    (sizeof(struct its_log_record_t) \
+     + ITS_UTILS_ALIGN((data_size), ITS_FLASH_MAX_ALIGNMENT) \
+     + (2 * sizeof(struct its_log_marker_t)))
+
+/*!
+ * \struct its_log_delta_t
+ *
+ * \brief Structure to store the location of a delta record of a file.
+ */
+struct its_log_delta_t {
+    uint32_t block;   /*!< Physical block of the record */
+    size_t pos;       /*!< Offset of the record in the block */
+    size_t offset;    /*!< Offset in the file of the data of the record */
+    size_t size;      /*!< Size of the data of the record */
+    uint32_t version; /*!< Version of the file the record makes current */
+};
+
+/*!
+ * \struct its_log_file_t
+ *
+ * \brief Structure to store the location and the attributes of the current
+ *        version of a file.
+ */
+struct its_log_file_t {
+    uint8_t id[ITS_FILE_ID_SIZE]; /*!< ID of this file, 0 for a free entry */
+    uint32_t block;               /*!< Physical block of the file record */
+    size_t pos;                   /*!< Offset of the file record in the
+                                   *   block
+                                   */
+    uint32_t version;             /*!< Version of the file record */
+    size_t base_size;             /*!< Size of the data of the file record */
+    size_t cur_size;              /*!< Size of the file data */
+    size_t max_size;              /*!< Maximum size of this file */
+    uint32_t flags;               /*!< Flags set when the file was created */
+    uint32_t num_deltas;          /*!< Number of delta records */
+    struct its_log_delta_t delta[ITS_LOG_FS_MAX_DELTAS]; /*!< Delta records
+                                                          *   applied over the
+                                                          *   file record, from
+                                                          *   the oldest
+                                                          */
+};
+
+/*!
+ * \struct its_log_block_t
+ *
+ * \brief Structure to store the state of a log block.
+ */
+struct its_log_block_t {
+    uint32_t seq;   /*!< Position of the block in the log */
+    size_t used;    /*!< Offset where the next record is appended */
+    uint8_t state;  /*!< Whether the block is free, erased or in use */
+};
+
+/**
+ * \struct its_flash_fs_ctx_t
+ *
+ * \brief Structure to store the ITS flash file system context.
+ */
+struct its_flash_fs_ctx_t {
+    const struct its_flash_info_t *flash_info; /**< Info for the flash device */
+    uint32_t head;     /**< Block where the records are appended */
+    uint32_t next_seq; /**< Sequence number of the next block opened */
+    struct its_log_block_t block[ITS_LOG_FS_MAX_BLOCKS]; /**< State of each
+                                                          *   block
+                                                          */
+    struct its_log_file_t file[ITS_LOG_FS_MAX_FILES]; /**< Current version of
+                                                       *   each file
+                                                       */
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ITS_FLASH_FS_LOG_H__ */
@@ -7,6 +7,8 @@
 
 #include "its_flash_fs_mblock.h"
 
+#include <stdbool.h>
+
 #include "psa/storage_common.h"
 #include "tfm_memory_utils.h"
 
@@ -27,8 +29,39 @@
 (ITS_METADATA_BLOCK1) : (ITS_METADATA_BLOCK0))
 
 #define ITS_BLOCK_META_HEADER_SIZE  sizeof(struct its_metadata_block_header_t)
-#define ITS_BLOCK_METADATA_SIZE     sizeof(struct its_block_meta_t)
-#define ITS_FILE_METADATA_SIZE      sizeof(struct its_file_meta_t)
+
+/* Number of file metadata entries read at once when the file metadata table
+ * is scanned, so that a flash device with a high cost per read, such as an
+ * external QSPI flash, is read in a few bursts rather than once per entry.
+ */
+#ifndef ITS_FILE_META_BURST_NUM
+#define ITS_FILE_META_BURST_NUM  8
+#endif
+
+/* Scratch blocks which are left to be erased */
+#define ITS_ERASE_PENDING_META  (1U << 0)
+#define ITS_ERASE_PENDING_DATA  (1U << 1)
+
+#ifdef ITS_MOUNT_CHECKPOINT
+/* The consumed marker of the checkpoint is programmed after the checkpoint,
+ * which a NAND device buffering the whole block cannot do.
+ */
+#if !defined(ITS_RAM_FS) && (ITS_FLASH_PROGRAM_UNIT > 16)
+#error "ITS_MOUNT_CHECKPOINT requires ITS_FLASH_PROGRAM_UNIT to be at most 16"
+#endif
+
+#if !defined(SST_RAM_FS) && (SST_FLASH_PROGRAM_UNIT > 16)
+#error "ITS_MOUNT_CHECKPOINT requires SST_FLASH_PROGRAM_UNIT to be at most 16"
+#endif
+
+#define ITS_MOUNT_CHECKPOINT_MAGIC  0x54504B43U
+
+/* The mount checkpoint is followed by its consumed marker */
+#define ITS_MOUNT_CHECKPOINT_SIZE   (sizeof(struct its_mount_checkpoint_t) \
+                                     + ITS_FLASH_MAX_ALIGNMENT)
+#else
+#define ITS_MOUNT_CHECKPOINT_SIZE   0
+#endif
 
 /* FIXME: Precompute these for each context */
 /**
@@ -130,6 +163,77 @@ static size_t its_mblock_file_meta_offset(struct its_flash_fs_ctx_t *fs_ctx,
            + (idx * ITS_FILE_METADATA_SIZE);
 }
 
+#ifdef ITS_METADATA_CACHE
+/**
+ * \brief Checks whether the metadata of a context fits in its metadata cache.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ *
+ * \return Returns 1 if the scratch metadata is staged in the cache, 0
+ *         otherwise
+ */
+__attribute__((always_inline))
+static inline uint32_t its_mblock_meta_cached(struct its_flash_fs_ctx_t *fs_ctx)
+{
+    return (its_mblock_file_meta_offset(fs_ctx,
+                                        fs_ctx->flash_info->max_num_files)
+            <= ITS_METADATA_CACHE_SIZE) ? 1U : 0U;
+}
+#endif
+
+/**
+ * \brief Writes metadata to the scratch metadata block.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ * \param[in]     data    Metadata to write
+ * \param[in]     pos     Offset of the metadata in the block
+ * \param[in]     size    Size of the metadata
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_mblock_write_scratch_meta(
+                                              struct its_flash_fs_ctx_t *fs_ctx,
+                                              const uint8_t *data, size_t pos,
+                                              size_t size)
+{
+#ifdef ITS_METADATA_CACHE
+    /* The staged metadata is programmed before the header is written */
+    if (its_mblock_meta_cached(fs_ctx)) {
+        (void)tfm_memcpy(fs_ctx->meta_cache + pos, data, size);
+        return PSA_SUCCESS;
+    }
+#endif
+
+    return fs_ctx->flash_info->write(fs_ctx->flash_info,
+                                     fs_ctx->scratch_metablock, data, pos,
+                                     size);
+}
+
+/**
+ * \brief Copies metadata from the active to the scratch metadata block.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ * \param[in]     pos     Offset of the metadata in the blocks
+ * \param[in]     size    Size of the metadata
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_mblock_copy_meta(struct its_flash_fs_ctx_t *fs_ctx,
+                                         size_t pos, size_t size)
+{
+#ifdef ITS_METADATA_CACHE
+    if (its_mblock_meta_cached(fs_ctx)) {
+        return fs_ctx->flash_info->read(fs_ctx->flash_info,
+                                        fs_ctx->active_metablock,
+                                        fs_ctx->meta_cache + pos, pos, size);
+    }
+#endif
+
+    return its_flash_block_to_block_move(fs_ctx->flash_info,
+                                         fs_ctx->scratch_metablock, pos,
+                                         fs_ctx->active_metablock, pos, size);
+}
+
 /**
  * \brief Swaps metablocks. Scratch becomes active and active becomes scratch.
  *
@@ -306,74 +410,667 @@ static inline psa_status_t its_mblock_validate_block_meta(
 }
 #endif /* ITS_VALIDATE_METADATA_FROM_FLASH */
 
+#ifdef ITS_PACKED_METADATA
 /**
- * \brief Gets a free file metadata table entry.
+ * \brief Encodes block metadata into its packed entry.
+ *
+ * \param[in]  block_meta  Pointer to block meta structure
+ * \param[out] buf         Buffer of ITS_BLOCK_METADATA_SIZE bytes
+ */
+static void its_mblock_encode_block_meta(
+                                      const struct its_block_meta_t *block_meta,
+                                      uint8_t *buf)
+{
+    struct its_block_meta_packed_t packed;
+
+    packed.phy_id = (uint16_t)block_meta->phy_id;
+    packed.data_start = (uint16_t)block_meta->data_start;
+    packed.free_size = (uint16_t)block_meta->free_size;
+
+    (void)tfm_memset(buf, ITS_DEFAULT_EMPTY_BUFF_VAL, ITS_BLOCK_METADATA_SIZE);
+    (void)tfm_memcpy(buf, &packed, sizeof(packed));
+}
+
+/**
+ * \brief Decodes block metadata from its packed entry.
+ *
+ * \param[in]  buf         Packed entry
+ * \param[out] block_meta  Pointer to block meta structure
+ */
+static void its_mblock_decode_block_meta(const uint8_t *buf,
+                                         struct its_block_meta_t *block_meta)
+{
+    struct its_block_meta_packed_t packed;
+
+    (void)tfm_memcpy(&packed, buf, sizeof(packed));
+
+    block_meta->phy_id = packed.phy_id;
+    block_meta->data_start = packed.data_start;
+    block_meta->free_size = packed.free_size;
+}
+
+/**
+ * \brief Encodes file metadata into its packed entry.
+ *
+ * \param[in]  file_meta  Pointer to file meta structure
+ * \param[out] buf        Buffer of ITS_FILE_METADATA_SIZE bytes
+ */
+static void its_mblock_encode_file_meta(const struct its_file_meta_t *file_meta,
+                                        uint8_t *buf)
+{
+    struct its_file_meta_packed_t packed;
+
+    packed.lblock = (uint16_t)file_meta->lblock;
+    packed.data_idx = (uint16_t)file_meta->data_idx;
+    packed.cur_size = (uint16_t)file_meta->cur_size;
+    packed.max_size = (uint16_t)file_meta->max_size;
+    packed.flags = file_meta->flags;
+    (void)tfm_memcpy(packed.id, file_meta->id, ITS_FILE_ID_SIZE);
+
+    (void)tfm_memset(buf, ITS_DEFAULT_EMPTY_BUFF_VAL, ITS_FILE_METADATA_SIZE);
+    (void)tfm_memcpy(buf, &packed, sizeof(packed));
+}
+
+/**
+ * \brief Decodes file metadata from its packed entry. The fields of an erased
+ *        entry decode to all ones, as they do without the packing, so that
+ *        the entry fails the validation.
+ *
+ * \param[in]  buf        Packed entry
+ * \param[out] file_meta  Pointer to file meta structure
+ */
+static void its_mblock_decode_file_meta(const uint8_t *buf,
+                                        struct its_file_meta_t *file_meta)
+{
+    struct its_file_meta_packed_t packed;
+
+    (void)tfm_memcpy(&packed, buf, sizeof(packed));
+
+    file_meta->lblock = (packed.lblock == UINT16_MAX) ? UINT32_MAX
+                                                      : packed.lblock;
+    file_meta->data_idx = packed.data_idx;
+    file_meta->cur_size = packed.cur_size;
+    file_meta->max_size = packed.max_size;
+    file_meta->flags = packed.flags;
+    (void)tfm_memcpy(file_meta->id, packed.id, ITS_FILE_ID_SIZE);
+}
+#endif /* ITS_PACKED_METADATA */
+
+/**
+ * \brief Reads consecutive file metadata entries from the active metadata
+ *        block with a single flash read.
+ *
+ * \param[in,out] fs_ctx      Filesystem context
+ * \param[in]     idx         Index of the first entry
+ * \param[in]     num         Number of entries to read, at most
+ *                            ITS_FILE_META_BURST_NUM
+ * \param[out]    file_metas  Array of at least num file meta structures
+ *
+ * \note The entries are not validated, each one must be checked with
+ *       its_mblock_check_file_meta() before it is used.
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_mblock_read_file_meta_burst(
+                                              struct its_flash_fs_ctx_t *fs_ctx,
+                                              uint32_t idx, uint32_t num,
+                                              struct its_file_meta_t *file_metas)
+{
+#ifdef ITS_PACKED_METADATA
+    psa_status_t err;
+    uint32_t i;
+    uint8_t buf[ITS_FILE_META_BURST_NUM * ITS_FILE_METADATA_SIZE];
+
+    err = fs_ctx->flash_info->read(fs_ctx->flash_info,
+                                   fs_ctx->active_metablock, buf,
+                                   its_mblock_file_meta_offset(fs_ctx, idx),
+                                   num * ITS_FILE_METADATA_SIZE);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    for (i = 0; i < num; i++) {
+        its_mblock_decode_file_meta(&buf[i * ITS_FILE_METADATA_SIZE],
+                                    &file_metas[i]);
+    }
+
+    return PSA_SUCCESS;
+#else
+    return fs_ctx->flash_info->read(fs_ctx->flash_info,
+                                    fs_ctx->active_metablock,
+                                    (uint8_t *)file_metas,
+                                    its_mblock_file_meta_offset(fs_ctx, idx),
+                                    num * ITS_FILE_METADATA_SIZE);
+#endif
+}
+
+/**
+ * \brief Checks a file metadata entry read by
+ *        its_mblock_read_file_meta_burst().
+ *
+ * \param[in,out] fs_ctx     Filesystem context
+ * \param[in]     file_meta  Pointer to file meta structure
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+__attribute__((always_inline))
+static inline psa_status_t its_mblock_check_file_meta(
+                                        struct its_flash_fs_ctx_t *fs_ctx,
+                                        const struct its_file_meta_t *file_meta)
+{
+#ifdef ITS_VALIDATE_METADATA_FROM_FLASH
+    return its_mblock_validate_file_meta(fs_ctx, file_meta);
+#else
+    (void)fs_ctx;
+    (void)file_meta;
+
+    return PSA_SUCCESS;
+#endif
+}
+
+#ifdef ITS_RAM_FILE_INDEX
+/**
+ * \brief Gets the home slot of a file ID in the hash table of the RAM file
+ *        index.
+ *
+ * \param[in] fid  ID of the file
+ *
+ * \return The slot where the probe sequence of the ID starts
+ */
+static uint32_t its_file_index_hash(const uint8_t *fid)
+{
+    uint32_t hash = 2166136261U;
+    uint32_t i;
+
+    /* 32-bit FNV-1a hash of the file ID */
+    for (i = 0; i < ITS_FILE_ID_SIZE; i++) {
+        hash = (hash ^ fid[i]) * 16777619U;
+    }
+
+    return hash % ITS_RAM_FILE_INDEX_NUM_SLOTS;
+}
+
+/**
+ * \brief Gets the slot which follows a slot in a probe sequence.
+ *
+ * \param[in] slot  Slot of the hash table
+ *
+ * \return The next slot, wrapping around the end of the table
+ */
+__attribute__((always_inline))
+static inline uint32_t its_file_index_next_slot(uint32_t slot)
+{
+    return (slot + 1) % ITS_RAM_FILE_INDEX_NUM_SLOTS;
+}
+
+/**
+ * \brief Finds the slot of the hash table which holds a file ID.
+ *
+ * \param[in] index  RAM file index
+ * \param[in] fid    ID of the file
+ *
+ * \return The slot which holds the ID, or the empty slot which ends its probe
+ *         sequence if the ID is not in the index
+ */
+static uint32_t its_file_index_find_slot(const struct its_file_index_t *index,
+                                         const uint8_t *fid)
+{
+    uint32_t slot = its_file_index_hash(fid);
+
+    /* At least half of the slots are empty, so the probe sequence ends */
+    while ((index->slot[slot] != ITS_METADATA_INVALID_INDEX) &&
+           tfm_memcmp(index->id[index->slot[slot]], fid, ITS_FILE_ID_SIZE)) {
+        slot = its_file_index_next_slot(slot);
+    }
+
+    return slot;
+}
+
+/**
+ * \brief Adds a file metadata entry to the hash table of the RAM file index.
+ *
+ * \param[in,out] index  RAM file index, which holds the ID of the entry
+ * \param[in]     idx    File metadata entry index
+ */
+static void its_file_index_insert(struct its_file_index_t *index, uint32_t idx)
+{
+    uint32_t slot = its_file_index_hash(index->id[idx]);
+
+    /* The entry is added at the end of its probe sequence, so that a lookup
+     * returns the lowest entry with a given ID, as the metadata block scan.
+     */
+    while (index->slot[slot] != ITS_METADATA_INVALID_INDEX) {
+        slot = its_file_index_next_slot(slot);
+    }
+
+    index->slot[slot] = (uint16_t)idx;
+}
+
+/**
+ * \brief Removes a file metadata entry from the hash table of the RAM file
+ *        index.
+ *
+ * \param[in,out] index  RAM file index, which holds the ID of the entry
+ * \param[in]     idx    File metadata entry index
+ */
+static void its_file_index_remove(struct its_file_index_t *index, uint32_t idx)
+{
+    uint32_t empty;
+    uint32_t home;
+    uint32_t slot = its_file_index_hash(index->id[idx]);
+
+    while (index->slot[slot] != idx) {
+        if (index->slot[slot] == ITS_METADATA_INVALID_INDEX) {
+            /* The entry is not in the table */
+            return;
+        }
+        slot = its_file_index_next_slot(slot);
+    }
+
+    /* Move back the entries of the probe sequence which follow the removed
+     * one, unless their home slot lies between the empty slot and them.
+     */
+    empty = slot;
+    for (slot = its_file_index_next_slot(slot);
+         index->slot[slot] != ITS_METADATA_INVALID_INDEX;
+         slot = its_file_index_next_slot(slot)) {
+        home = its_file_index_hash(index->id[index->slot[slot]]);
+        if (((slot > empty) && ((home <= empty) || (home > slot))) ||
+            ((slot < empty) && (home <= empty) && (home > slot))) {
+            index->slot[empty] = index->slot[slot];
+            empty = slot;
+        }
+    }
+
+    index->slot[empty] = ITS_METADATA_INVALID_INDEX;
+}
+
+/**
+ * \brief Sets the ID of a file metadata entry in the RAM file index.
+ *
+ * \param[in,out] index  RAM file index
+ * \param[in]     idx    File metadata entry index
+ * \param[in]     fid    New ID of the entry, 0 if the entry is free
+ */
+static void its_file_index_set(struct its_file_index_t *index, uint32_t idx,
+                               const uint8_t *fid)
+{
+    if (its_utils_validate_fid(index->id[idx]) == PSA_SUCCESS) {
+        its_file_index_remove(index, idx);
+    }
+
+    tfm_memcpy(index->id[idx], fid, ITS_FILE_ID_SIZE);
+
+    if (its_utils_validate_fid(fid) == PSA_SUCCESS) {
+        its_file_index_insert(index, idx);
+    }
+}
+
+/**
+ * \brief Builds the RAM file index from the active metadata block.
+ *
+ * \note If the context has more files than the index can hold, or a file
+ *       metadata entry cannot be read, the index is left unused and the
+ *       lookups keep reading the metadata block, which reports the errors.
  *
  * \param[in,out] fs_ctx  Filesystem context
+ */
+static void its_file_index_build(struct its_flash_fs_ctx_t *fs_ctx)
+{
+    psa_status_t err;
+    uint32_t i;
+    uint32_t j;
+    uint32_t num;
+    struct its_file_index_t *index = &fs_ctx->file_index;
+    struct its_file_meta_t burst[ITS_FILE_META_BURST_NUM];
+
+    index->valid = 0;
+    (void)tfm_memset(index->id, 0, sizeof(index->id));
+    (void)tfm_memset(index->slot, 0xFF, sizeof(index->slot));
+    (void)tfm_memset(index->dirty, 0, sizeof(index->dirty));
+
+    if (fs_ctx->flash_info->max_num_files > ITS_RAM_FILE_INDEX_MAX_FILES) {
+        return;
+    }
+
+    for (i = 0; i < fs_ctx->flash_info->max_num_files; i += num) {
+        num = ITS_UTILS_MIN(fs_ctx->flash_info->max_num_files - i,
+                            ITS_FILE_META_BURST_NUM);
+        err = its_mblock_read_file_meta_burst(fs_ctx, i, num, burst);
+        if (err != PSA_SUCCESS) {
+            return;
+        }
+
+        for (j = 0; j < num; j++) {
+            if (its_mblock_check_file_meta(fs_ctx, &burst[j]) != PSA_SUCCESS) {
+                return;
+            }
+
+            its_file_index_set(index, i + j, burst[j].id);
+        }
+    }
+
+    index->valid = 1;
+}
+
+/**
+ * \brief Reads again the file metadata entries whose ID has been changed in
+ *        the metadata block which has just become active, and updates the
+ *        RAM file index with them.
  *
- * \return Return index of a free file meta entry
+ * \param[in,out] fs_ctx  Filesystem context
  */
-static uint32_t its_get_free_file_index(struct its_flash_fs_ctx_t *fs_ctx)
+static void its_file_index_refresh(struct its_flash_fs_ctx_t *fs_ctx)
 {
     psa_status_t err;
     uint32_t i;
+    struct its_file_index_t *index = &fs_ctx->file_index;
     struct its_file_meta_t tmp_metadata;
 
+    if (!index->valid) {
+        return;
+    }
+
     for (i = 0; i < fs_ctx->flash_info->max_num_files; i++) {
+        if (!(index->dirty[i / 32] & (1U << (i % 32)))) {
+            continue;
+        }
+
         err = its_flash_fs_mblock_read_file_meta(fs_ctx, i, &tmp_metadata);
+        if (err != PSA_SUCCESS) {
+            /* Fall back to the metadata block scan */
+            index->valid = 0;
+            return;
+        }
+
+        its_file_index_set(index, i, tmp_metadata.id);
+    }
+
+    (void)tfm_memset(index->dirty, 0, sizeof(index->dirty));
+}
+#endif /* ITS_RAM_FILE_INDEX */
+
+/**
+ * \brief Gets a free file metadata table entry.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ *
+ * \return Return index of a free file meta entry
+ */
+static uint32_t its_get_free_file_index(struct its_flash_fs_ctx_t *fs_ctx)
+{
+    psa_status_t err;
+    uint32_t i;
+    uint32_t j;
+    uint32_t num;
+    struct its_file_meta_t burst[ITS_FILE_META_BURST_NUM];
+
+#ifdef ITS_RAM_FILE_INDEX
+    if (fs_ctx->file_index.valid) {
+        for (i = 0; i < fs_ctx->flash_info->max_num_files; i++) {
+            if (its_utils_validate_fid(fs_ctx->file_index.id[i])
+                != PSA_SUCCESS) {
+                return i;
+            }
+        }
+
+        return ITS_METADATA_INVALID_INDEX;
+    }
+#endif
+
+    for (i = 0; i < fs_ctx->flash_info->max_num_files; i += num) {
+        num = ITS_UTILS_MIN(fs_ctx->flash_info->max_num_files - i,
+                            ITS_FILE_META_BURST_NUM);
+        err = its_mblock_read_file_meta_burst(fs_ctx, i, num, burst);
         if (err != PSA_SUCCESS) {
             return ITS_METADATA_INVALID_INDEX;
         }
 
-        /* Check if this entry is free by checking if ID values is an
-         * invalid ID.
-         */
-        if (its_utils_validate_fid(tmp_metadata.id) != PSA_SUCCESS) {
-            /* Found */
-            return i;
+        for (j = 0; j < num; j++) {
+            if (its_mblock_check_file_meta(fs_ctx, &burst[j]) != PSA_SUCCESS) {
+                return ITS_METADATA_INVALID_INDEX;
+            }
+
+            /* Check if this entry is free by checking if ID values is an
+             * invalid ID.
+             */
+            if (its_utils_validate_fid(burst[j].id) != PSA_SUCCESS) {
+                /* Found */
+                return i + j;
+            }
         }
     }
 
-    return ITS_METADATA_INVALID_INDEX;
+    return ITS_METADATA_INVALID_INDEX;
+}
+
+/**
+ * \brief Erases data and meta scratch blocks.
+ *
+ * \param[in,out] fs_ctx      Filesystem context
+ * \param[in]     erase_data  Whether the scratch data block is erased too
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_mblock_erase_scratch_blocks(
+                                              struct its_flash_fs_ctx_t *fs_ctx,
+                                              bool erase_data)
+{
+    psa_status_t err;
+    uint32_t scratch_datablock;
+
+    /* For the atomicity of the data update process
+     * and power-failure-safe operation, it is necessary that
+     * metadata scratch block is erased before data block.
+     */
+    err = fs_ctx->flash_info->erase(fs_ctx->flash_info,
+                                    fs_ctx->scratch_metablock);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+#ifdef ITS_WEAR_LEVELING
+    /* The erase counts are programmed with the header of the next update */
+    fs_ctx->meta_block_header.erase_count[fs_ctx->scratch_metablock]++;
+#endif
+
+    if (!erase_data) {
+        return PSA_SUCCESS;
+    }
+
+    /* If the number of blocks is bigger than 2, the code needs to erase the
+     * scratch block used to process any change in the data block which contains
+     * only data. Otherwise, if the number of blocks is equal to 2, it means
+     * that all data is stored in the metadata block.
+     */
+    if (fs_ctx->flash_info->num_blocks > 2) {
+        scratch_datablock =
+            its_flash_fs_mblock_cur_data_scratch_id(fs_ctx,
+                                                    (ITS_LOGICAL_DBLOCK0 + 1));
+        err = fs_ctx->flash_info->erase(fs_ctx->flash_info, scratch_datablock);
+#ifdef ITS_WEAR_LEVELING
+        if (err == PSA_SUCCESS) {
+            fs_ctx->meta_block_header.erase_count[scratch_datablock]++;
+        }
+#endif
+    }
+
+    return err;
+}
+
+#ifdef ITS_MOUNT_CHECKPOINT
+/**
+ * \brief Computes the check value of a mount checkpoint.
+ *
+ * \param[in] checkpoint  Mount checkpoint
+ *
+ * \return Returns the check value
+ */
+static uint32_t its_mblock_checkpoint_check(
+                             const struct its_mount_checkpoint_t *checkpoint)
+{
+    return ~(checkpoint->magic ^ checkpoint->swap_count
+             ^ checkpoint->scratch_dblock);
+}
+
+/**
+ * \brief Programs a mount checkpoint in the scratch metadata block, which
+ *        records that the scratch blocks are erased.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ *
+ * \note A checkpoint which fails to be programmed is not valid, so the next
+ *       mount erases the scratch blocks again.
+ */
+static void its_mblock_write_checkpoint(struct its_flash_fs_ctx_t *fs_ctx)
+{
+    struct its_mount_checkpoint_t checkpoint = {0};
+    psa_status_t err;
+
+    checkpoint.magic = ITS_MOUNT_CHECKPOINT_MAGIC;
+    checkpoint.swap_count = fs_ctx->meta_block_header.active_swap_count;
+    checkpoint.scratch_dblock = fs_ctx->meta_block_header.scratch_dblock;
+    checkpoint.check = its_mblock_checkpoint_check(&checkpoint);
+
+    err = fs_ctx->flash_info->write(fs_ctx->flash_info,
+                                    fs_ctx->scratch_metablock,
+                                    (const uint8_t *)&checkpoint,
+                                    its_mblock_file_meta_offset(fs_ctx,
+                                             fs_ctx->flash_info->max_num_files),
+                                    sizeof(checkpoint));
+    if (err == PSA_SUCCESS) {
+        err = fs_ctx->flash_info->flush(fs_ctx->flash_info);
+    }
+
+    fs_ctx->checkpoint_valid = (err == PSA_SUCCESS) ? 1U : 0U;
+}
+
+/**
+ * \brief Checks whether the scratch metadata block holds a mount checkpoint
+ *        of the active metadata block which has not been consumed, in which
+ *        case the scratch blocks are still erased.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ *
+ * \return Returns PSA_SUCCESS if the checkpoint is valid, or an error code as
+ *         specified in \ref psa_status_t
+ */
+static psa_status_t its_mblock_read_checkpoint(
+                                              struct its_flash_fs_ctx_t *fs_ctx)
+{
+    struct its_mount_checkpoint_t checkpoint;
+    uint8_t marker[ITS_FLASH_MAX_ALIGNMENT];
+    psa_status_t err;
+    size_t pos;
+    uint32_t i;
+
+    pos = its_mblock_file_meta_offset(fs_ctx,
+                                      fs_ctx->flash_info->max_num_files);
+    err = fs_ctx->flash_info->read(fs_ctx->flash_info,
+                                   fs_ctx->scratch_metablock,
+                                   (uint8_t *)&checkpoint, pos,
+                                   sizeof(checkpoint));
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    err = fs_ctx->flash_info->read(fs_ctx->flash_info,
+                                   fs_ctx->scratch_metablock, marker,
+                                   pos + sizeof(checkpoint), sizeof(marker));
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    /* The swap count ties the checkpoint to the active metadata block, so a
+     * stale checkpoint left in a block which is not erased is rejected.
+     */
+    if ((checkpoint.magic != ITS_MOUNT_CHECKPOINT_MAGIC) ||
+        (checkpoint.check != its_mblock_checkpoint_check(&checkpoint)) ||
+        (checkpoint.swap_count !=
+         fs_ctx->meta_block_header.active_swap_count) ||
+        (checkpoint.scratch_dblock !=
+         fs_ctx->meta_block_header.scratch_dblock)) {
+        return PSA_ERROR_DOES_NOT_EXIST;
+    }
+
+    /* Any programmed bit of the marker consumes the checkpoint */
+    for (i = 0; i < sizeof(marker); i++) {
+        if (marker[i] != fs_ctx->flash_info->erase_val) {
+            return PSA_ERROR_DOES_NOT_EXIST;
+        }
+    }
+
+    return PSA_SUCCESS;
+}
+#endif /* ITS_MOUNT_CHECKPOINT */
+
+/**
+ * \brief Erases the scratch blocks. With ITS_MOUNT_CHECKPOINT, it then
+ *        records in the scratch metadata block that they are erased. With
+ *        ITS_DEFERRED_ERASE, the erase is only recorded as pending.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_mblock_clean_scratch_blocks(
+                                              struct its_flash_fs_ctx_t *fs_ctx)
+{
+    uint8_t erase_pending = ITS_ERASE_PENDING_META | ITS_ERASE_PENDING_DATA;
+#ifndef ITS_DEFERRED_ERASE
+    psa_status_t err;
+#endif
+
+#ifdef ITS_IN_PLACE_APPEND
+    /* An in-place append does not program the scratch data block */
+    if (fs_ctx->keep_data_scratch) {
+        erase_pending = ITS_ERASE_PENDING_META;
+    }
+#endif
+
+#ifdef ITS_DEFERRED_ERASE
+    /* The blocks are erased by its_flash_fs_mblock_maintain(), or before the
+     * next update writes to them.
+     */
+    fs_ctx->erase_pending = erase_pending;
+
+    return PSA_SUCCESS;
+#else
+    err = its_mblock_erase_scratch_blocks(fs_ctx,
+                                (erase_pending & ITS_ERASE_PENDING_DATA) != 0U);
+
+#ifdef ITS_MOUNT_CHECKPOINT
+    if (err == PSA_SUCCESS) {
+        its_mblock_write_checkpoint(fs_ctx);
+    }
+#endif
+
+    return err;
+#endif /* ITS_DEFERRED_ERASE */
 }
 
+#ifdef ITS_DEFERRED_ERASE
 /**
- * \brief Erases data and meta scratch blocks.
+ * \brief Erases the scratch blocks whose erase has been deferred.
  *
  * \param[in,out] fs_ctx  Filesystem context
  *
  * \return Returns error code as specified in \ref psa_status_t
  */
-static psa_status_t its_mblock_erase_scratch_blocks(
+static psa_status_t its_mblock_erase_pending_blocks(
                                               struct its_flash_fs_ctx_t *fs_ctx)
 {
     psa_status_t err;
-    uint32_t scratch_datablock;
-
-    /* For the atomicity of the data update process
-     * and power-failure-safe operation, it is necessary that
-     * metadata scratch block is erased before data block.
-     */
-    err = fs_ctx->flash_info->erase(fs_ctx->flash_info,
-                                    fs_ctx->scratch_metablock);
-    if (err != PSA_SUCCESS) {
-        return err;
-    }
 
-    /* If the number of blocks is bigger than 2, the code needs to erase the
-     * scratch block used to process any change in the data block which contains
-     * only data. Otherwise, if the number of blocks is equal to 2, it means
-     * that all data is stored in the metadata block.
-     */
-    if (fs_ctx->flash_info->num_blocks > 2) {
-        scratch_datablock =
-            its_flash_fs_mblock_cur_data_scratch_id(fs_ctx,
-                                                    (ITS_LOGICAL_DBLOCK0 + 1));
-        err = fs_ctx->flash_info->erase(fs_ctx->flash_info, scratch_datablock);
+    err = its_mblock_erase_scratch_blocks(fs_ctx,
+                        (fs_ctx->erase_pending & ITS_ERASE_PENDING_DATA) != 0U);
+    if (err == PSA_SUCCESS) {
+        fs_ctx->erase_pending = 0U;
     }
 
     return err;
 }
+#endif /* ITS_DEFERRED_ERASE */
 
 /**
  * \brief Updates scratch block meta.
@@ -391,13 +1088,18 @@ static psa_status_t its_mblock_update_scratch_block_meta(
                                       const struct its_block_meta_t *block_meta)
 {
     size_t pos;
+#ifdef ITS_PACKED_METADATA
+    uint8_t buf[ITS_BLOCK_METADATA_SIZE];
+
+    its_mblock_encode_block_meta(block_meta, buf);
+#else
+    const uint8_t *buf = (const uint8_t *)block_meta;
+#endif
 
     /* Calculate the position */
     pos = its_mblock_block_meta_offset(lblock);
-    return fs_ctx->flash_info->write(fs_ctx->flash_info,
-                                     fs_ctx->scratch_metablock,
-                                     (const uint8_t *)block_meta, pos,
-                                     ITS_BLOCK_METADATA_SIZE);
+    return its_mblock_write_scratch_meta(fs_ctx, buf, pos,
+                                         ITS_BLOCK_METADATA_SIZE);
 }
 
 /**
@@ -414,13 +1116,11 @@ static psa_status_t its_mblock_copy_remaining_block_meta(
 {
     struct its_block_meta_t block_meta;
     psa_status_t err;
-    uint32_t meta_block;
     size_t pos;
     uint32_t scratch_block;
     size_t size;
 
     scratch_block = fs_ctx->scratch_metablock;
-    meta_block = fs_ctx->active_metablock;
 
     if (lblock != ITS_LOGICAL_DBLOCK0) {
         /* The file data in the logical block 0 is stored in same physical
@@ -458,9 +1158,7 @@ static psa_status_t its_mblock_copy_remaining_block_meta(
 
             /* Copy rest of the block data from previous block */
             /* Data before updated content */
-            err = its_flash_block_to_block_move(fs_ctx->flash_info,
-                                                scratch_block, pos, meta_block,
-                                                pos, size);
+            err = its_mblock_copy_meta(fs_ctx, pos, size);
             if (err != PSA_SUCCESS) {
                 return err;
             }
@@ -472,8 +1170,7 @@ static psa_status_t its_mblock_copy_remaining_block_meta(
 
     size = its_mblock_file_meta_offset(fs_ctx, 0) - pos;
 
-    return its_flash_block_to_block_move(fs_ctx->flash_info, scratch_block, pos,
-                                         meta_block, pos, size);
+    return its_mblock_copy_meta(fs_ctx, pos, size);
 }
 
 /**
@@ -516,6 +1213,13 @@ static inline psa_status_t its_mblock_validate_swap_count(
 __attribute__((always_inline))
 static inline psa_status_t its_mblock_validate_fs_version(uint8_t fs_version)
 {
+#ifdef ITS_PACKED_METADATA
+    /* A metadata block with unpacked entries is migrated at mount */
+    if (fs_version == ITS_UNPACKED_VERSION) {
+        return PSA_SUCCESS;
+    }
+#endif
+
     /* Looks for exact version number.
      * FIXME: backward compatibility could be considered in future revisions.
      */
@@ -569,6 +1273,23 @@ static psa_status_t its_mblock_write_scratch_meta_header(
         fs_ctx->meta_block_header.active_swap_count = 0;
     }
 
+#ifdef ITS_METADATA_CACHE
+    /* Program the staged block and file metadata in a single write */
+    if (its_mblock_meta_cached(fs_ctx)) {
+        err = fs_ctx->flash_info->write(fs_ctx->flash_info,
+                                        fs_ctx->scratch_metablock,
+                                        fs_ctx->meta_cache
+                                        + ITS_BLOCK_META_HEADER_SIZE,
+                                        ITS_BLOCK_META_HEADER_SIZE,
+                                        its_mblock_file_meta_offset(fs_ctx,
+                                            fs_ctx->flash_info->max_num_files)
+                                        - ITS_BLOCK_META_HEADER_SIZE);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+    }
+#endif
+
     /* Write the metadata block header */
     return fs_ctx->flash_info->write(fs_ctx->flash_info,
                                      fs_ctx->scratch_metablock,
@@ -703,25 +1424,162 @@ static psa_status_t its_init_get_active_metablock(
     return PSA_SUCCESS;
 }
 
+#ifdef ITS_PACKED_METADATA
+/**
+ * \brief Migrates the active metadata block from the unpacked entries to the
+ *        packed entries. The entries are converted into the scratch metadata
+ *        block, with the data of the logical block 0 moved down to the end of
+ *        the smaller metadata, and the scratch metadata block then becomes
+ *        the active one. An interrupted migration is done again at the next
+ *        mount, as the unpacked metadata block is still the latest valid one.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_mblock_migrate_to_packed(
+                                              struct its_flash_fs_ctx_t *fs_ctx)
+{
+    psa_status_t err;
+    uint32_t i;
+    size_t unpacked_start;
+    size_t packed_start;
+    size_t data_size = 0;
+    struct its_block_meta_t block_meta;
+    struct its_file_meta_t file_meta;
+
+    /* Start of the data of the logical block 0 in both layouts */
+    unpacked_start = ITS_BLOCK_META_HEADER_SIZE
+                     + (its_num_active_dblocks(fs_ctx)
+                        * sizeof(struct its_block_meta_t))
+                     + (fs_ctx->flash_info->max_num_files
+                        * sizeof(struct its_file_meta_t))
+                     + ITS_MOUNT_CHECKPOINT_SIZE;
+    packed_start = its_mblock_file_meta_offset(fs_ctx,
+                                             fs_ctx->flash_info->max_num_files)
+                   + ITS_MOUNT_CHECKPOINT_SIZE;
+
+    err = its_mblock_erase_scratch_blocks(fs_ctx, false);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    for (i = 0; i < its_num_active_dblocks(fs_ctx); i++) {
+        err = fs_ctx->flash_info->read(fs_ctx->flash_info,
+                                       fs_ctx->active_metablock,
+                                       (uint8_t *)&block_meta,
+                                       ITS_BLOCK_META_HEADER_SIZE
+                                       + (i * sizeof(struct its_block_meta_t)),
+                                       sizeof(struct its_block_meta_t));
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+
+        if (i == ITS_LOGICAL_DBLOCK0) {
+            if ((block_meta.data_start != unpacked_start) ||
+                (its_utils_check_contained_in(fs_ctx->flash_info->block_size,
+                                              block_meta.data_start,
+                                              block_meta.free_size)
+                 != PSA_SUCCESS)) {
+                return PSA_ERROR_DATA_CORRUPT;
+            }
+
+            data_size = fs_ctx->flash_info->block_size - unpacked_start
+                        - block_meta.free_size;
+
+            /* The space freed by the packing is added to the free space */
+            block_meta.phy_id = fs_ctx->scratch_metablock;
+            block_meta.data_start = packed_start;
+            block_meta.free_size += unpacked_start - packed_start;
+        }
+
+#ifdef ITS_VALIDATE_METADATA_FROM_FLASH
+        err = its_mblock_validate_block_meta(fs_ctx, &block_meta);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+#endif
+
+        err = its_mblock_update_scratch_block_meta(fs_ctx, i, &block_meta);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+    }
+
+    for (i = 0; i < fs_ctx->flash_info->max_num_files; i++) {
+        err = fs_ctx->flash_info->read(fs_ctx->flash_info,
+                                       fs_ctx->active_metablock,
+                                       (uint8_t *)&file_meta,
+                                       ITS_BLOCK_META_HEADER_SIZE
+                                       + (its_num_active_dblocks(fs_ctx)
+                                          * sizeof(struct its_block_meta_t))
+                                       + (i * sizeof(struct its_file_meta_t)),
+                                       sizeof(struct its_file_meta_t));
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+
+        if ((its_utils_validate_fid(file_meta.id) == PSA_SUCCESS) &&
+            (file_meta.lblock == ITS_LOGICAL_DBLOCK0)) {
+            if (file_meta.data_idx < unpacked_start) {
+                return PSA_ERROR_DATA_CORRUPT;
+            }
+
+            file_meta.data_idx -= unpacked_start - packed_start;
+        }
+
+        err = its_mblock_check_file_meta(fs_ctx, &file_meta);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+
+        err = its_flash_fs_mblock_update_scratch_file_meta(fs_ctx, i,
+                                                           &file_meta);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+    }
+
+    err = its_flash_block_to_block_move(fs_ctx->flash_info,
+                                        fs_ctx->scratch_metablock,
+                                        packed_start,
+                                        fs_ctx->active_metablock,
+                                        unpacked_start, data_size);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    fs_ctx->meta_block_header.fs_version = ITS_SUPPORTED_VERSION;
+
+    err = its_mblock_write_scratch_meta_header(fs_ctx);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    err = fs_ctx->flash_info->flush(fs_ctx->flash_info);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    its_mblock_swap_metablocks(fs_ctx);
+
+    return PSA_SUCCESS;
+}
+#endif /* ITS_PACKED_METADATA */
+
 psa_status_t its_flash_fs_mblock_cp_remaining_file_meta(
                                               struct its_flash_fs_ctx_t *fs_ctx,
                                               uint32_t idx)
 {
     psa_status_t err;
     size_t end;
-    uint32_t meta_block;
     size_t pos;
-    uint32_t scratch_block;
 
-    scratch_block = fs_ctx->scratch_metablock;
-    meta_block = fs_ctx->active_metablock;
     /* Calculate the position */
     pos = its_mblock_file_meta_offset(fs_ctx, 0);
     /* Copy rest of the block data from previous block */
     /* Data before updated content */
-    err = its_flash_block_to_block_move(fs_ctx->flash_info, scratch_block, pos,
-                                        meta_block, pos,
-                                        (idx * ITS_FILE_METADATA_SIZE));
+    err = its_mblock_copy_meta(fs_ctx, pos, (idx * ITS_FILE_METADATA_SIZE));
     if (err != PSA_SUCCESS) {
         return err;
     }
@@ -735,8 +1593,7 @@ psa_status_t its_flash_fs_mblock_cp_remaining_file_meta(
     end = its_mblock_file_meta_offset(fs_ctx,
                                       fs_ctx->flash_info->max_num_files);
     if (end > pos) {
-        err = its_flash_block_to_block_move(fs_ctx->flash_info, scratch_block,
-                                            pos, meta_block, pos, (end - pos));
+        err = its_mblock_copy_meta(fs_ctx, pos, (end - pos));
     }
 
     return err;
@@ -760,19 +1617,99 @@ psa_status_t its_flash_fs_mblock_get_file_idx(struct its_flash_fs_ctx_t *fs_ctx,
 {
     psa_status_t err;
     uint32_t i;
-    struct its_file_meta_t tmp_metadata;
+    uint32_t j;
+    uint32_t num;
+    struct its_file_meta_t burst[ITS_FILE_META_BURST_NUM];
+
+#ifdef ITS_RAM_FILE_INDEX
+    /* The index does not hold the free entries, whose ID is 0 */
+    if (fs_ctx->file_index.valid &&
+        (its_utils_validate_fid(fid) == PSA_SUCCESS)) {
+        i = fs_ctx->file_index.slot[
+                       its_file_index_find_slot(&fs_ctx->file_index, fid)];
+        if (i == ITS_METADATA_INVALID_INDEX) {
+            return PSA_ERROR_DOES_NOT_EXIST;
+        }
 
-    for (i = 0; i < fs_ctx->flash_info->max_num_files; i++) {
-        err = its_flash_fs_mblock_read_file_meta(fs_ctx, i, &tmp_metadata);
+        *idx = i;
+        return PSA_SUCCESS;
+    }
+#endif
+
+    for (i = 0; i < fs_ctx->flash_info->max_num_files; i += num) {
+        num = ITS_UTILS_MIN(fs_ctx->flash_info->max_num_files - i,
+                            ITS_FILE_META_BURST_NUM);
+        err = its_mblock_read_file_meta_burst(fs_ctx, i, num, burst);
         if (err != PSA_SUCCESS) {
             return PSA_ERROR_GENERIC_ERROR;
         }
 
-        /* ID with value 0x00 means end of file meta section */
-        if (!tfm_memcmp(tmp_metadata.id, fid, ITS_FILE_ID_SIZE)) {
-            /* Found */
-            *idx = i;
-            return PSA_SUCCESS;
+        for (j = 0; j < num; j++) {
+            if (its_mblock_check_file_meta(fs_ctx, &burst[j]) != PSA_SUCCESS) {
+                return PSA_ERROR_GENERIC_ERROR;
+            }
+
+            /* ID with value 0x00 means end of file meta section */
+            if (!tfm_memcmp(burst[j].id, fid, ITS_FILE_ID_SIZE)) {
+                /* Found */
+                *idx = i + j;
+                return PSA_SUCCESS;
+            }
+        }
+    }
+
+    return PSA_ERROR_DOES_NOT_EXIST;
+}
+
+psa_status_t its_flash_fs_mblock_find_file(struct its_flash_fs_ctx_t *fs_ctx,
+                                           const uint8_t *prefix,
+                                           size_t prefix_len,
+                                           uint32_t *idx,
+                                           uint8_t *fid)
+{
+    psa_status_t err;
+    uint32_t i;
+    uint32_t j;
+    uint32_t num;
+    struct its_file_meta_t burst[ITS_FILE_META_BURST_NUM];
+
+#ifdef ITS_RAM_FILE_INDEX
+    /* The index holds the ID of every entry, so no flash read is needed */
+    if (fs_ctx->file_index.valid) {
+        for (i = *idx; i < fs_ctx->flash_info->max_num_files; i++) {
+            if ((its_utils_validate_fid(fs_ctx->file_index.id[i])
+                 == PSA_SUCCESS) &&
+                !tfm_memcmp(fs_ctx->file_index.id[i], prefix, prefix_len)) {
+                (void)tfm_memcpy(fid, fs_ctx->file_index.id[i],
+                                 ITS_FILE_ID_SIZE);
+                *idx = i;
+                return PSA_SUCCESS;
+            }
+        }
+
+        return PSA_ERROR_DOES_NOT_EXIST;
+    }
+#endif
+
+    for (i = *idx; i < fs_ctx->flash_info->max_num_files; i += num) {
+        num = ITS_UTILS_MIN(fs_ctx->flash_info->max_num_files - i,
+                            ITS_FILE_META_BURST_NUM);
+        err = its_mblock_read_file_meta_burst(fs_ctx, i, num, burst);
+        if (err != PSA_SUCCESS) {
+            return PSA_ERROR_GENERIC_ERROR;
+        }
+
+        for (j = 0; j < num; j++) {
+            if (its_mblock_check_file_meta(fs_ctx, &burst[j]) != PSA_SUCCESS) {
+                return PSA_ERROR_GENERIC_ERROR;
+            }
+
+            if ((its_utils_validate_fid(burst[j].id) == PSA_SUCCESS) &&
+                !tfm_memcmp(burst[j].id, prefix, prefix_len)) {
+                (void)tfm_memcpy(fid, burst[j].id, ITS_FILE_ID_SIZE);
+                *idx = i + j;
+                return PSA_SUCCESS;
+            }
         }
     }
 
@@ -799,8 +1736,31 @@ psa_status_t its_flash_fs_mblock_init(struct its_flash_fs_ctx_t *fs_ctx)
         return PSA_ERROR_GENERIC_ERROR;
     }
 
+#ifdef ITS_PACKED_METADATA
+    if (fs_ctx->meta_block_header.fs_version == ITS_UNPACKED_VERSION) {
+        err = its_mblock_migrate_to_packed(fs_ctx);
+        if (err != PSA_SUCCESS) {
+            return PSA_ERROR_GENERIC_ERROR;
+        }
+    }
+#endif
+
+#ifdef ITS_RAM_FILE_INDEX
+    its_file_index_build(fs_ctx);
+#endif
+
+#ifdef ITS_MOUNT_CHECKPOINT
+    /* After a clean shutdown, the scratch blocks are already erased */
+    if (its_mblock_read_checkpoint(fs_ctx) == PSA_SUCCESS) {
+        fs_ctx->checkpoint_valid = 1U;
+        return PSA_SUCCESS;
+    }
+
+    fs_ctx->checkpoint_valid = 0U;
+#endif
+
     /* Erase the other scratch metadata block */
-    return its_mblock_erase_scratch_blocks(fs_ctx);
+    return its_mblock_clean_scratch_blocks(fs_ctx);
 }
 
 psa_status_t its_flash_fs_mblock_meta_update_finalize(
@@ -823,9 +1783,80 @@ psa_status_t its_flash_fs_mblock_meta_update_finalize(
     /* Update the running context */
     its_mblock_swap_metablocks(fs_ctx);
 
+#ifdef ITS_RAM_FILE_INDEX
+    its_file_index_refresh(fs_ctx);
+#endif
+
     /* Erase meta block and current scratch block */
-    return its_mblock_erase_scratch_blocks(fs_ctx);
+    return its_mblock_clean_scratch_blocks(fs_ctx);
+}
+
+psa_status_t its_flash_fs_mblock_begin_update(
+                                              struct its_flash_fs_ctx_t *fs_ctx)
+{
+#ifdef ITS_MOUNT_CHECKPOINT
+    uint8_t marker[ITS_FLASH_MAX_ALIGNMENT];
+    psa_status_t err;
+#endif
+
+#ifdef ITS_DEFERRED_ERASE
+    /* The maintenance has not run since the last update */
+    if (fs_ctx->erase_pending) {
+        return its_mblock_erase_pending_blocks(fs_ctx);
+    }
+#endif
+
+#ifdef ITS_MOUNT_CHECKPOINT
+    if (!fs_ctx->checkpoint_valid) {
+        return PSA_SUCCESS;
+    }
+
+    /* Program the consumed marker before the scratch blocks are written */
+    (void)tfm_memset(marker, (uint8_t)~fs_ctx->flash_info->erase_val,
+                     sizeof(marker));
+    err = fs_ctx->flash_info->write(fs_ctx->flash_info,
+                                    fs_ctx->scratch_metablock, marker,
+                                    its_mblock_file_meta_offset(fs_ctx,
+                                             fs_ctx->flash_info->max_num_files)
+                                    + sizeof(struct its_mount_checkpoint_t),
+                                    sizeof(marker));
+    if (err == PSA_SUCCESS) {
+        err = fs_ctx->flash_info->flush(fs_ctx->flash_info);
+    }
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    fs_ctx->checkpoint_valid = 0U;
+#endif
+
+#if !defined(ITS_DEFERRED_ERASE) && !defined(ITS_MOUNT_CHECKPOINT)
+    (void)fs_ctx;
+#endif
+
+    return PSA_SUCCESS;
+}
+
+#ifdef ITS_DEFERRED_ERASE
+psa_status_t its_flash_fs_mblock_maintain(struct its_flash_fs_ctx_t *fs_ctx)
+{
+    psa_status_t err;
+
+    if (!fs_ctx->erase_pending) {
+        return PSA_ERROR_DOES_NOT_EXIST;
+    }
+
+    err = its_mblock_erase_pending_blocks(fs_ctx);
+
+#ifdef ITS_MOUNT_CHECKPOINT
+    if (err == PSA_SUCCESS) {
+        its_mblock_write_checkpoint(fs_ctx);
+    }
+#endif
+
+    return err;
 }
+#endif /* ITS_DEFERRED_ERASE */
 
 psa_status_t its_flash_fs_mblock_migrate_lb0_data_to_scratch(
                                               struct its_flash_fs_ctx_t *fs_ctx)
@@ -858,12 +1889,8 @@ psa_status_t its_flash_fs_mblock_read_file_meta(
                                               struct its_file_meta_t *file_meta)
 {
     psa_status_t err;
-    size_t offset;
 
-    offset = its_mblock_file_meta_offset(fs_ctx, idx);
-    err = fs_ctx->flash_info->read(fs_ctx->flash_info, fs_ctx->active_metablock,
-                                   (uint8_t *)file_meta, offset,
-                                   ITS_FILE_METADATA_SIZE);
+    err = its_mblock_read_file_meta_burst(fs_ctx, idx, 1, file_meta);
 
 #ifdef ITS_VALIDATE_METADATA_FROM_FLASH
     if (err == PSA_SUCCESS) {
@@ -881,11 +1908,21 @@ psa_status_t its_flash_fs_mblock_read_block_metadata(
 {
     psa_status_t err;
     size_t pos;
+#ifdef ITS_PACKED_METADATA
+    uint8_t buf[ITS_BLOCK_METADATA_SIZE];
+#else
+    uint8_t *buf = (uint8_t *)block_meta;
+#endif
 
     pos = its_mblock_block_meta_offset(lblock);
     err = fs_ctx->flash_info->read(fs_ctx->flash_info, fs_ctx->active_metablock,
-                                   (uint8_t *)block_meta, pos,
-                                   ITS_BLOCK_METADATA_SIZE);
+                                   buf, pos, ITS_BLOCK_METADATA_SIZE);
+
+#ifdef ITS_PACKED_METADATA
+    if (err == PSA_SUCCESS) {
+        its_mblock_decode_block_meta(buf, block_meta);
+    }
+#endif
 
 #ifdef ITS_VALIDATE_METADATA_FROM_FLASH
     if (err == PSA_SUCCESS) {
@@ -927,6 +1964,21 @@ psa_status_t its_flash_fs_mblock_reset_metablock(
     uint32_t i;
     uint32_t metablock_to_erase_first = ITS_METADATA_BLOCK0;
     struct its_file_meta_t file_metadata;
+#ifdef ITS_WEAR_LEVELING
+    psa_status_t header_err = PSA_ERROR_GENERIC_ERROR;
+#endif
+
+#ifdef ITS_MOUNT_CHECKPOINT
+    /* The checkpoint is erased with the metadata blocks */
+    fs_ctx->checkpoint_valid = 0U;
+#endif
+
+#ifdef ITS_DEFERRED_ERASE
+    /* The reset erases the blocks, and the next mount sets the erase of the
+     * scratch blocks as pending again.
+     */
+    fs_ctx->erase_pending = 0U;
+#endif
 
     /* Erase both metadata blocks. If at least one metadata block is valid,
      * ensure that the active metadata block is erased last to prevent rollback
@@ -934,8 +1986,21 @@ psa_status_t its_flash_fs_mblock_reset_metablock(
      */
     if (its_init_get_active_metablock(fs_ctx) == PSA_SUCCESS) {
         metablock_to_erase_first = fs_ctx->scratch_metablock;
+#ifdef ITS_WEAR_LEVELING
+        header_err = its_mblock_read_meta_header(fs_ctx);
+#endif
     }
 
+#ifdef ITS_WEAR_LEVELING
+    /* The erase counts of a valid metadata block are kept, so that they
+     * survive the wipe of the filesystem.
+     */
+    if (header_err != PSA_SUCCESS) {
+        (void)tfm_memset(fs_ctx->meta_block_header.erase_count, 0,
+                         sizeof(fs_ctx->meta_block_header.erase_count));
+    }
+#endif
+
     err = fs_ctx->flash_info->erase(fs_ctx->flash_info,
                                     metablock_to_erase_first);
     if (err != PSA_SUCCESS) {
@@ -956,10 +2021,12 @@ psa_status_t its_flash_fs_mblock_reset_metablock(
 
     /* Fill the block metadata for logical datablock 0, which has the physical
      * id of the active metadata block. For this datablock, the space available
-     * for data is from the end of the metadata to the end of the block.
+     * for data is from the end of the metadata, and of the mount checkpoint if
+     * enabled, to the end of the block.
      */
     block_meta.data_start =
-        its_mblock_file_meta_offset(fs_ctx, fs_ctx->flash_info->max_num_files);
+        its_mblock_file_meta_offset(fs_ctx, fs_ctx->flash_info->max_num_files)
+        + ITS_MOUNT_CHECKPOINT_SIZE;
     block_meta.free_size = fs_ctx->flash_info->block_size
                            - block_meta.data_start;
     block_meta.phy_id = ITS_METADATA_BLOCK0;
@@ -991,6 +2058,15 @@ psa_status_t its_flash_fs_mblock_reset_metablock(
         return PSA_ERROR_STORAGE_FAILURE;
     }
 
+#ifdef ITS_WEAR_LEVELING
+    fs_ctx->meta_block_header.erase_count[ITS_METADATA_BLOCK0]++;
+    fs_ctx->meta_block_header.erase_count[ITS_METADATA_BLOCK1]++;
+    for (i = 0; i < its_num_dedicated_dblocks(fs_ctx); i++) {
+        fs_ctx->meta_block_header.erase_count[i
+                                            + its_init_dblock_start(fs_ctx)]++;
+    }
+#endif
+
     for (i = 0; i < its_num_dedicated_dblocks(fs_ctx); i++) {
         block_meta.phy_id = i + its_init_dblock_start(fs_ctx);
         err = its_mblock_update_scratch_block_meta(fs_ctx, i + 1, &block_meta);
@@ -1001,7 +2077,7 @@ psa_status_t its_flash_fs_mblock_reset_metablock(
 
     /* Initialize file metadata table */
     (void)tfm_memset(&file_metadata, ITS_DEFAULT_EMPTY_BUFF_VAL,
-                     ITS_FILE_METADATA_SIZE);
+                     sizeof(file_metadata));
     for (i = 0; i < fs_ctx->flash_info->max_num_files; i++) {
         /* In the beginning phys id is same as logical id */
         /* Update file metadata to reflect new attributes */
@@ -1026,8 +2102,70 @@ psa_status_t its_flash_fs_mblock_reset_metablock(
     /* Swap active and scratch metablocks */
     its_mblock_swap_metablocks(fs_ctx);
 
+#ifdef ITS_RAM_FILE_INDEX
+    its_file_index_build(fs_ctx);
+#endif
+
+    return PSA_SUCCESS;
+}
+
+#ifdef ITS_WEAR_LEVELING
+psa_status_t its_flash_fs_mblock_get_cold_lblock(
+                                              struct its_flash_fs_ctx_t *fs_ctx,
+                                              uint32_t *lblock)
+{
+    struct its_block_meta_t block_meta;
+    const uint32_t *erase_count = fs_ctx->meta_block_header.erase_count;
+    psa_status_t err;
+    uint32_t i;
+    uint32_t min_count = UINT32_MAX;
+    uint32_t scratch_id = fs_ctx->meta_block_header.scratch_dblock;
+
+    *lblock = ITS_LOGICAL_DBLOCK0;
+
+    if ((fs_ctx->flash_info->num_blocks <= 2) ||
+        (scratch_id >= fs_ctx->flash_info->num_blocks)) {
+        return PSA_ERROR_DOES_NOT_EXIST;
+    }
+
+    /* The data in the logical block 0 moves with the metadata, so only the
+     * dedicated data blocks are compared.
+     */
+    for (i = ITS_LOGICAL_DBLOCK0 + 1; i < its_num_active_dblocks(fs_ctx); i++) {
+        err = its_flash_fs_mblock_read_block_metadata(fs_ctx, i, &block_meta);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+
+        if (erase_count[block_meta.phy_id] < min_count) {
+            min_count = erase_count[block_meta.phy_id];
+            *lblock = i;
+        }
+    }
+
+    if ((*lblock == ITS_LOGICAL_DBLOCK0) ||
+        ((erase_count[scratch_id] - min_count) < ITS_WEAR_LEVELING_THRESHOLD) ||
+        (erase_count[scratch_id] < min_count)) {
+        return PSA_ERROR_DOES_NOT_EXIST;
+    }
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t its_flash_fs_mblock_get_erase_count(
+                                              struct its_flash_fs_ctx_t *fs_ctx,
+                                              uint32_t block,
+                                              uint32_t *erase_count)
+{
+    if (block >= fs_ctx->flash_info->num_blocks) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    *erase_count = fs_ctx->meta_block_header.erase_count[block];
+
     return PSA_SUCCESS;
 }
+#endif /* ITS_WEAR_LEVELING */
 
 void its_flash_fs_mblock_set_data_scratch(struct its_flash_fs_ctx_t *fs_ctx,
                                           uint32_t phy_id, uint32_t lblock)
@@ -1066,11 +2204,29 @@ psa_status_t its_flash_fs_mblock_update_scratch_file_meta(
                                         const struct its_file_meta_t *file_meta)
 {
     size_t pos;
+#ifdef ITS_PACKED_METADATA
+    uint8_t buf[ITS_FILE_METADATA_SIZE];
+#else
+    const uint8_t *buf = (const uint8_t *)file_meta;
+#endif
+
+#ifdef ITS_RAM_FILE_INDEX
+    /* The index follows the active metadata block, so the entries whose ID
+     * changes are only updated once the scratch block becomes active.
+     */
+    if (fs_ctx->file_index.valid &&
+        tfm_memcmp(fs_ctx->file_index.id[idx], file_meta->id,
+                   ITS_FILE_ID_SIZE)) {
+        fs_ctx->file_index.dirty[idx / 32] |= (1U << (idx % 32));
+    }
+#endif
+
+#ifdef ITS_PACKED_METADATA
+    its_mblock_encode_file_meta(file_meta, buf);
+#endif
 
     /* Calculate the position */
     pos = its_mblock_file_meta_offset(fs_ctx, idx);
-    return fs_ctx->flash_info->write(fs_ctx->flash_info,
-                                     fs_ctx->scratch_metablock,
-                                     (const uint8_t *)file_meta, pos,
-                                     ITS_FILE_METADATA_SIZE);
+    return its_mblock_write_scratch_meta(fs_ctx, buf, pos,
+                                         ITS_FILE_METADATA_SIZE);
 }
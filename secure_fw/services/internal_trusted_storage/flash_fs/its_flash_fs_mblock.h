@@ -14,6 +14,10 @@
 #include "secure_fw/services/internal_trusted_storage/flash/its_flash.h"
 #include "secure_fw/services/internal_trusted_storage/its_utils.h"
 #include "psa/error.h"
+#if defined(SST_STREAMED_OBJECTS) || defined(SST_TRANSACTIONS) || \
+    defined(SST_OBJ_TABLE_SHARDS)
+#include "secure_fw/services/secure_storage/sst_object_defs.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -22,9 +26,72 @@ extern "C" {
 /*!
  * \def ITS_SUPPORTED_VERSION
  *
- * \brief Defines the supported version.
+ * \brief Defines the supported version. The metadata block header holds the
+ *        erase count of each block when ITS_WEAR_LEVELING is enabled, the
+ *        metadata block reserves space for a mount checkpoint when
+ *        ITS_MOUNT_CHECKPOINT is enabled, and the block and file metadata
+ *        entries are packed when ITS_PACKED_METADATA is enabled.
+ */
+#ifdef ITS_WEAR_LEVELING
+#define ITS_VERSION_WEAR_LEVELING  1
+#else
+#define ITS_VERSION_WEAR_LEVELING  0
+#endif
+
+#ifdef ITS_MOUNT_CHECKPOINT
+#define ITS_VERSION_MOUNT_CHECKPOINT  2
+#else
+#define ITS_VERSION_MOUNT_CHECKPOINT  0
+#endif
+
+#ifdef ITS_PACKED_METADATA
+#define ITS_VERSION_PACKED_METADATA  4
+#else
+#define ITS_VERSION_PACKED_METADATA  0
+#endif
+
+#define ITS_SUPPORTED_VERSION  (0x01 + ITS_VERSION_WEAR_LEVELING \
+                                + ITS_VERSION_MOUNT_CHECKPOINT \
+                                + ITS_VERSION_PACKED_METADATA)
+
+#ifdef ITS_PACKED_METADATA
+/*!
+ * \def ITS_UNPACKED_VERSION
+ *
+ * \brief Defines the version of a metadata block with the same features but
+ *        unpacked entries, which is migrated to the packed entries at mount.
+ */
+#define ITS_UNPACKED_VERSION  (ITS_SUPPORTED_VERSION \
+                               - ITS_VERSION_PACKED_METADATA)
+#endif
+
+#ifdef ITS_WEAR_LEVELING
+/*!
+ * \def ITS_WEAR_LEVELING_MAX_BLOCKS
+ *
+ * \brief Defines the largest number of flash blocks of a context whose erase
+ *        counts are tracked. By default, it fits both the ITS and the SST
+ *        flash areas.
+ */
+#ifndef ITS_WEAR_LEVELING_MAX_BLOCKS
+#define ITS_WEAR_LEVELING_MAX_BLOCKS \
+    ITS_UTILS_MAX((ITS_FLASH_AREA_SIZE / \
+                   (ITS_SECTOR_SIZE * ITS_SECTORS_PER_BLOCK)), \
+                  (SST_FLASH_AREA_SIZE / \
+                   (SST_SECTOR_SIZE * SST_SECTORS_PER_BLOCK)))
+#endif
+
+/*!
+ * \def ITS_WEAR_LEVELING_THRESHOLD
+ *
+ * \brief Defines by how many erases the scratch data block must lead the
+ *        least erased data block for the data of that block to be moved to
+ *        the scratch data block, which makes it the next scratch data block.
  */
-#define ITS_SUPPORTED_VERSION  0x01
+#ifndef ITS_WEAR_LEVELING_THRESHOLD
+#define ITS_WEAR_LEVELING_THRESHOLD 32
+#endif
+#endif /* ITS_WEAR_LEVELING */
 
 /*!
  * \def ITS_METADATA_INVALID_INDEX
@@ -53,6 +120,12 @@ extern "C" {
  */
 struct __attribute__((__aligned__(ITS_FLASH_MAX_ALIGNMENT)))
 its_metadata_block_header_t {
+#ifdef ITS_WEAR_LEVELING
+    uint32_t erase_count[ITS_WEAR_LEVELING_MAX_BLOCKS]; /*!< Number of erases
+                                                         *   of each physical
+                                                         *   block
+                                                         */
+#endif
     uint32_t scratch_dblock;    /*!< Physical block ID of the data
                                  *   section's scratch block
                                  */
@@ -101,6 +174,143 @@ its_file_meta_t {
     uint8_t id[ITS_FILE_ID_SIZE];  /*!< ID of this file */
 };
 
+#ifdef ITS_PACKED_METADATA
+/*!
+ * \struct its_block_meta_packed_t
+ *
+ * \brief Packed encoding of struct its_block_meta_t in the metadata block.
+ *        The offsets and sizes fit in 16 bits, as the size of a block does.
+ */
+struct __attribute__((__packed__)) its_block_meta_packed_t {
+    uint16_t phy_id;      /*!< Physical ID of this logical block */
+    uint16_t data_start;  /*!< Offset of the data in the block */
+    uint16_t free_size;   /*!< Number of bytes free at end of block */
+};
+
+/*!
+ * \struct its_file_meta_packed_t
+ *
+ * \brief Packed encoding of struct its_file_meta_t in the metadata block.
+ */
+struct __attribute__((__packed__)) its_file_meta_packed_t {
+    uint16_t lblock;               /*!< Logical datablock of the file */
+    uint16_t data_idx;             /*!< Offset in the logical data block */
+    uint16_t cur_size;             /*!< Size of the file */
+    uint16_t max_size;             /*!< Maximum size of the file */
+    uint32_t flags;                /*!< Flags set when the file was created */
+    uint8_t id[ITS_FILE_ID_SIZE];  /*!< ID of this file */
+};
+
+/* Each entry is padded to a whole number of program units, so that it can be
+ * programmed on its own.
+ */
+#define ITS_BLOCK_METADATA_SIZE \
+    ITS_UTILS_ALIGN(sizeof(struct its_block_meta_packed_t), \
+                    ITS_FLASH_MAX_ALIGNMENT)
+#define ITS_FILE_METADATA_SIZE \
+    ITS_UTILS_ALIGN(sizeof(struct its_file_meta_packed_t), \
+                    ITS_FLASH_MAX_ALIGNMENT)
+#else
+#define ITS_BLOCK_METADATA_SIZE  sizeof(struct its_block_meta_t)
+#define ITS_FILE_METADATA_SIZE   sizeof(struct its_file_meta_t)
+#endif /* ITS_PACKED_METADATA */
+
+#ifdef ITS_RAM_FILE_INDEX
+/*!
+ * \def ITS_RAM_FILE_INDEX_MAX_FILES
+ *
+ * \brief Defines the largest number of files that the RAM file index of a
+ *        context can hold. A context with more files keeps looking them up
+ *        in the metadata block. By default, it fits both the ITS context and
+ *        the SST context, whose number of files is SST_MAX_NUM_OBJECTS.
+ */
+#ifndef ITS_RAM_FILE_INDEX_MAX_FILES
+#if defined(SST_NUM_ASSETS) && \
+    (defined(SST_STREAMED_OBJECTS) || defined(SST_TRANSACTIONS) || \
+     defined(SST_OBJ_TABLE_SHARDS))
+/* The SST context also holds the chunk files of the streamed objects, the
+ * spare objects of the transactions or the object table shards.
+ */
+#define ITS_RAM_FILE_INDEX_MAX_FILES ITS_UTILS_MAX(ITS_NUM_ASSETS, \
+                                                   SST_MAX_NUM_OBJECTS)
+#elif defined(SST_NUM_ASSETS) && defined(SST_OBJ_TABLE_JOURNAL)
+#define ITS_RAM_FILE_INDEX_MAX_FILES ITS_UTILS_MAX(ITS_NUM_ASSETS, \
+                                                   (SST_NUM_ASSETS + 4))
+#elif defined(SST_NUM_ASSETS)
+#define ITS_RAM_FILE_INDEX_MAX_FILES ITS_UTILS_MAX(ITS_NUM_ASSETS, \
+                                                   (SST_NUM_ASSETS + 3))
+#else
+#define ITS_RAM_FILE_INDEX_MAX_FILES ITS_NUM_ASSETS
+#endif
+#endif
+
+/*!
+ * \def ITS_RAM_FILE_INDEX_NUM_SLOTS
+ *
+ * \brief Defines the number of slots of the hash table of the RAM file index.
+ *        Keeping at least half of the slots empty bounds the length of the
+ *        probe sequences.
+ */
+#define ITS_RAM_FILE_INDEX_NUM_SLOTS (2 * ITS_RAM_FILE_INDEX_MAX_FILES)
+
+/*!
+ * \struct its_file_index_t
+ *
+ * \brief Structure to store the RAM index of the file IDs of the active
+ *        metadata block.
+ */
+struct its_file_index_t {
+    /*! ID of each file metadata entry, 0 for a free entry */
+    uint8_t id[ITS_RAM_FILE_INDEX_MAX_FILES][ITS_FILE_ID_SIZE];
+    /*! File metadata entry index in each slot of the hash table, or
+     *  ITS_METADATA_INVALID_INDEX for an empty slot
+     */
+    uint16_t slot[ITS_RAM_FILE_INDEX_NUM_SLOTS];
+    /*! Bitmap of the entries whose ID is changed in the scratch metadata
+     *  block, which are read again when the metablocks are swapped
+     */
+    uint32_t dirty[(ITS_RAM_FILE_INDEX_MAX_FILES + 31) / 32];
+    uint8_t valid; /*!< Whether the index matches the active metadata block */
+};
+#endif /* ITS_RAM_FILE_INDEX */
+
+#ifdef ITS_MOUNT_CHECKPOINT
+/*!
+ * \struct its_mount_checkpoint_t
+ *
+ * \brief Structure of the checkpoint programmed in the scratch metadata block,
+ *        after the file metadata, once the scratch blocks have been erased. It
+ *        is followed by a consumed marker, which is programmed before the
+ *        scratch blocks are written again.
+ *
+ * \note This structure is programmed to flash, so it must be aligned to the
+ *       maximum required flash program unit.
+ */
+struct __attribute__((__aligned__(ITS_FLASH_MAX_ALIGNMENT)))
+its_mount_checkpoint_t {
+    uint32_t magic;           /*!< Identifies a checkpoint */
+    uint32_t swap_count;      /*!< Swap count of the active metadata block */
+    uint32_t scratch_dblock;  /*!< Physical ID of the erased scratch data
+                               *   block
+                               */
+    uint32_t check;           /*!< Detects a partially programmed checkpoint */
+};
+#endif /* ITS_MOUNT_CHECKPOINT */
+
+#ifdef ITS_METADATA_CACHE
+/*!
+ * \def ITS_METADATA_CACHE_SIZE
+ *
+ * \brief Defines the size of the RAM page which stages the metadata written
+ *        to the scratch metadata block, so that it is programmed in a single
+ *        write when the metadata update is finalized. A context whose metadata
+ *        does not fit programs each entry as it is written.
+ */
+#ifndef ITS_METADATA_CACHE_SIZE
+#define ITS_METADATA_CACHE_SIZE 1024
+#endif
+#endif /* ITS_METADATA_CACHE */
+
 /**
  * \struct its_flash_fs_ctx_t
  *
@@ -113,6 +323,29 @@ struct its_flash_fs_ctx_t {
                                                            */
     uint32_t active_metablock;  /**< Active metadata block */
     uint32_t scratch_metablock; /**< Scratch metadata block */
+#ifdef ITS_RAM_FILE_INDEX
+    struct its_file_index_t file_index; /**< RAM index of the file IDs */
+#endif
+#ifdef ITS_METADATA_CACHE
+    uint8_t meta_cache[ITS_METADATA_CACHE_SIZE]; /**< Metadata staged for the
+                                                  *   scratch metadata block
+                                                  */
+#endif
+#ifdef ITS_IN_PLACE_APPEND
+    uint8_t keep_data_scratch;  /**< Set while an update which has left the
+                                 *   scratch data block erased is finalized
+                                 */
+#endif
+#ifdef ITS_MOUNT_CHECKPOINT
+    uint8_t checkpoint_valid;   /**< Set while the scratch metadata block holds
+                                 *   a checkpoint which is not consumed
+                                 */
+#endif
+#ifdef ITS_DEFERRED_ERASE
+    uint8_t erase_pending;      /**< Scratch blocks left to be erased by the
+                                 *   last update
+                                 */
+#endif
 };
 
 /**
@@ -124,6 +357,33 @@ struct its_flash_fs_ctx_t {
  */
 psa_status_t its_flash_fs_mblock_init(struct its_flash_fs_ctx_t *fs_ctx);
 
+/**
+ * \brief Prepares the scratch blocks to be written by an update. With
+ *        ITS_DEFERRED_ERASE, it erases the scratch blocks if that is still
+ *        pending. With ITS_MOUNT_CHECKPOINT, it consumes the mount checkpoint,
+ *        so that the scratch blocks are erased at the next mount if the update
+ *        is interrupted.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+psa_status_t its_flash_fs_mblock_begin_update(
+                                             struct its_flash_fs_ctx_t *fs_ctx);
+
+#ifdef ITS_DEFERRED_ERASE
+/**
+ * \brief Erases the scratch blocks left by the last update, if that has not
+ *        been done yet.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ *
+ * \return Returns PSA_ERROR_DOES_NOT_EXIST if no erase is pending. Otherwise,
+ *         it returns error code as specified in \ref psa_status_t.
+ */
+psa_status_t its_flash_fs_mblock_maintain(struct its_flash_fs_ctx_t *fs_ctx);
+#endif
+
 /**
  * \brief Copies rest of the file metadata, except for the one pointed by
  *        index.
@@ -162,6 +422,26 @@ psa_status_t its_flash_fs_mblock_get_file_idx(struct its_flash_fs_ctx_t *fs_ctx,
                                               const uint8_t *fid,
                                               uint32_t *idx);
 
+/**
+ * \brief Finds the next file whose ID begins with the given prefix.
+ *
+ * \param[in,out] fs_ctx      Filesystem context
+ * \param[in]     prefix      Prefix of the file ID
+ * \param[in]     prefix_len  Size of the prefix, at most ITS_FILE_ID_SIZE
+ * \param[in,out] idx         File metadata entry index to start the search
+ *                            from. On success, index of the file found.
+ * \param[out]    fid         ID of the file found
+ *
+ * \return Returns PSA_ERROR_DOES_NOT_EXIST if no file from the start index
+ *         on matches. Otherwise, it returns error code as specified in
+ *         \ref psa_status_t
+ */
+psa_status_t its_flash_fs_mblock_find_file(struct its_flash_fs_ctx_t *fs_ctx,
+                                           const uint8_t *prefix,
+                                           size_t prefix_len,
+                                           uint32_t *idx,
+                                           uint8_t *fid);
+
 /**
  * \brief Finalizes an update operation.
  *        Last step when a create/write/delete is performed.
@@ -250,6 +530,39 @@ psa_status_t its_flash_fs_mblock_reserve_file(
 psa_status_t its_flash_fs_mblock_reset_metablock(
                                              struct its_flash_fs_ctx_t *fs_ctx);
 
+#ifdef ITS_WEAR_LEVELING
+/**
+ * \brief Gets the logical data block whose physical block has been erased the
+ *        fewest times, if the scratch data block has been erased
+ *        ITS_WEAR_LEVELING_THRESHOLD times more.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ * \param[out]    lblock  Logical block number
+ *
+ * \return Returns PSA_SUCCESS if the data of the logical block is to be moved
+ *         to the scratch data block, PSA_ERROR_DOES_NOT_EXIST if the wear is
+ *         level enough, or another error code as specified in
+ *         \ref psa_status_t
+ */
+psa_status_t its_flash_fs_mblock_get_cold_lblock(
+                                              struct its_flash_fs_ctx_t *fs_ctx,
+                                              uint32_t *lblock);
+
+/**
+ * \brief Gets the number of erases of a physical block.
+ *
+ * \param[in,out] fs_ctx       Filesystem context
+ * \param[in]     block        Physical block
+ * \param[out]    erase_count  Number of erases of the block
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+psa_status_t its_flash_fs_mblock_get_erase_count(
+                                              struct its_flash_fs_ctx_t *fs_ctx,
+                                              uint32_t block,
+                                              uint32_t *erase_count);
+#endif /* ITS_WEAR_LEVELING */
+
 /**
  * \brief Sets current data scratch block
  *
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include "its_hot_tier.h"
+
+#include <stddef.h>
+
+#include "tfm_memory_utils.h"
+
+/* Initial value of the CRC of an entry. It is not the usual all ones so that
+ * a RAM area which is all ones or all zeros never holds a valid entry.
+ */
+#define ITS_HOT_TIER_CRC_SEED 0x484F5454U /* "HOTT" */
+
+/* Size of the part of an entry covered by its CRC */
+#define ITS_HOT_TIER_CRC_SIZE offsetof(struct its_hot_asset_t, crc)
+
+/* Entries of the hot tier. The target can place them in a section of RAM
+ * which is retained across resets, and is neither loaded nor zeroed at
+ * startup, by defining ITS_HOT_TIER_SECTION to the name of that section. The
+ * entries which are dirty at a reset are then flushed at the next boot.
+ */
+#ifdef ITS_HOT_TIER_SECTION
+__attribute__((section(ITS_HOT_TIER_SECTION)))
+#endif
+static struct its_hot_asset_t hot_assets[ITS_HOT_TIER_NUM_ASSETS];
+
+/**
+ * \brief Computes the CRC-32 (IEEE 802.3 polynomial) of an entry.
+ *
+ * \param[in] asset  Pointer to the entry
+ *
+ * \return CRC of the entry.
+ */
+static uint32_t its_hot_tier_crc(const struct its_hot_asset_t *asset)
+{
+    const uint8_t *p = (const uint8_t *)asset;
+    uint32_t crc = ITS_HOT_TIER_CRC_SEED;
+    uint32_t i;
+    uint32_t j;
+
+    for (i = 0; i < ITS_HOT_TIER_CRC_SIZE; i++) {
+        crc ^= p[i];
+        for (j = 0; j < 8; j++) {
+            crc = (crc >> 1) ^ (0xEDB88320U & (0U - (crc & 1U)));
+        }
+    }
+
+    return ~crc;
+}
+
+/**
+ * \brief Checks whether an entry holds an asset and passes the integrity
+ *        check.
+ *
+ * \param[in] asset  Pointer to the entry
+ *
+ * \return true if the entry is valid, false otherwise.
+ */
+static bool its_hot_tier_is_valid(const struct its_hot_asset_t *asset)
+{
+    if ((asset->state != ITS_HOT_ASSET_CLEAN) &&
+        (asset->state != ITS_HOT_ASSET_DIRTY)) {
+        return false;
+    }
+
+    if (asset->size > ITS_HOT_TIER_MAX_ASSET_SIZE) {
+        return false;
+    }
+
+    return (asset->crc == its_hot_tier_crc(asset));
+}
+
+void its_hot_tier_init(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < ITS_HOT_TIER_NUM_ASSETS; i++) {
+        if (!its_hot_tier_is_valid(&hot_assets[i])) {
+            its_hot_tier_free(&hot_assets[i]);
+        }
+    }
+}
+
+struct its_hot_asset_t *its_hot_tier_get(uint32_t idx)
+{
+    return &hot_assets[idx];
+}
+
+struct its_hot_asset_t *its_hot_tier_find(const uint8_t *fid)
+{
+    uint32_t i;
+
+    for (i = 0; i < ITS_HOT_TIER_NUM_ASSETS; i++) {
+        if ((hot_assets[i].state != ITS_HOT_ASSET_FREE) &&
+            (tfm_memcmp(hot_assets[i].fid, fid, ITS_FILE_ID_SIZE) == 0)) {
+            if (!its_hot_tier_is_valid(&hot_assets[i])) {
+                its_hot_tier_free(&hot_assets[i]);
+                return NULL;
+            }
+            return &hot_assets[i];
+        }
+    }
+
+    return NULL;
+}
+
+struct its_hot_asset_t *its_hot_tier_alloc(const uint8_t *fid)
+{
+    struct its_hot_asset_t *asset = NULL;
+    uint32_t i;
+
+    for (i = 0; i < ITS_HOT_TIER_NUM_ASSETS; i++) {
+        if (hot_assets[i].state == ITS_HOT_ASSET_FREE) {
+            asset = &hot_assets[i];
+            break;
+        } else if ((asset == NULL) &&
+                   (hot_assets[i].state == ITS_HOT_ASSET_CLEAN)) {
+            asset = &hot_assets[i];
+        }
+    }
+
+    if (asset != NULL) {
+        tfm_memset(asset, 0, sizeof(*asset));
+        tfm_memcpy(asset->fid, fid, ITS_FILE_ID_SIZE);
+    }
+
+    return asset;
+}
+
+void its_hot_tier_seal(struct its_hot_asset_t *asset)
+{
+    asset->crc = its_hot_tier_crc(asset);
+}
+
+void its_hot_tier_free(struct its_hot_asset_t *asset)
+{
+    tfm_memset(asset, 0, sizeof(*asset));
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __ITS_HOT_TIER_H__
+#define __ITS_HOT_TIER_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "flash/its_flash.h"
+#include "its_utils.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * \def ITS_HOT_TIER_NUM_ASSETS
+ *
+ * \brief Defines the number of assets which can be held in the hot tier at
+ *        the same time. It can be set by the target in flash_layout.h.
+ */
+#ifndef ITS_HOT_TIER_NUM_ASSETS
+#define ITS_HOT_TIER_NUM_ASSETS 4
+#endif
+
+/*!
+ * \def ITS_HOT_TIER_MAX_ASSET_SIZE
+ *
+ * \brief Defines the largest asset held in the hot tier. Larger assets
+ *        created with TFM_STORAGE_FLAG_HOT are stored in flash directly. It
+ *        can be set by the target in flash_layout.h.
+ */
+#ifndef ITS_HOT_TIER_MAX_ASSET_SIZE
+#define ITS_HOT_TIER_MAX_ASSET_SIZE 64
+#endif
+
+/*!
+ * \def ITS_HOT_TIER_FLUSH_WRITES
+ *
+ * \brief Defines the number of writes to a hot asset after which it is
+ *        flushed to flash. It can be set by the target in flash_layout.h.
+ */
+#ifndef ITS_HOT_TIER_FLUSH_WRITES
+#define ITS_HOT_TIER_FLUSH_WRITES 64
+#endif
+
+#if (ITS_HOT_TIER_NUM_ASSETS == 0) || (ITS_HOT_TIER_FLUSH_WRITES == 0)
+#error "ITS_HOT_TIER_NUM_ASSETS and ITS_HOT_TIER_FLUSH_WRITES must not be 0"
+#endif
+
+/*!
+ * \enum its_hot_asset_state_t
+ *
+ * \brief State of an entry of the hot tier.
+ */
+enum its_hot_asset_state_t {
+    ITS_HOT_ASSET_FREE = 0, /*!< The entry holds no asset */
+    ITS_HOT_ASSET_CLEAN,    /*!< The flash holds the same data as the entry */
+    ITS_HOT_ASSET_DIRTY,    /*!< The entry holds data not flushed to flash */
+};
+
+/*!
+ * \struct its_hot_asset_t
+ *
+ * \brief Entry of the hot tier, which holds the data of an asset in RAM.
+ */
+struct its_hot_asset_t {
+    uint8_t fid[ITS_FILE_ID_SIZE]; /*!< ID of the file of the asset */
+    uint32_t flags;                /*!< Flags of the asset */
+    uint32_t size;                 /*!< Size of the data */
+    uint32_t state;                /*!< State of the entry, see
+                                    *   enum its_hot_asset_state_t
+                                    */
+    uint32_t writes;               /*!< Number of writes since the last
+                                    *   flush
+                                    */
+    uint8_t data[ITS_UTILS_ALIGN(ITS_HOT_TIER_MAX_ASSET_SIZE,
+                                 ITS_FLASH_MAX_ALIGNMENT)]; /*!< Data */
+    uint32_t crc;                  /*!< CRC-32 of the fields above */
+};
+
+/**
+ * \brief Checks the entries of the hot tier, which are kept across resets
+ *        when they are placed in retained RAM. The entries which fail the
+ *        integrity check, for example because their RAM was not retained or
+ *        because they were being written when the reset occurred, are freed.
+ *        The other entries are kept, dirty or not.
+ */
+void its_hot_tier_init(void);
+
+/**
+ * \brief Gets an entry of the hot tier.
+ *
+ * \param[in] idx  Index of the entry, less than ITS_HOT_TIER_NUM_ASSETS
+ *
+ * \return Pointer to the entry.
+ */
+struct its_hot_asset_t *its_hot_tier_get(uint32_t idx);
+
+/**
+ * \brief Looks up the entry holding an asset. An entry which fails the
+ *        integrity check is freed, so that the asset is read from flash.
+ *
+ * \param[in] fid  ID of the file of the asset
+ *
+ * \return Pointer to the entry, or NULL if the asset is not in the hot tier.
+ */
+struct its_hot_asset_t *its_hot_tier_find(const uint8_t *fid);
+
+/**
+ * \brief Allocates an entry for an asset. A free entry is used first,
+ *        otherwise a clean one, whose asset remains in flash.
+ *
+ * \param[in] fid  ID of the file of the asset
+ *
+ * \return Pointer to the entry, or NULL if all the entries are dirty.
+ */
+struct its_hot_asset_t *its_hot_tier_alloc(const uint8_t *fid);
+
+/**
+ * \brief Updates the CRC of an entry. Must be called after each update of the
+ *        entry.
+ *
+ * \param[in,out] asset  Pointer to the entry
+ */
+void its_hot_tier_seal(struct its_hot_asset_t *asset);
+
+/**
+ * \brief Frees an entry.
+ *
+ * \param[in,out] asset  Pointer to the entry
+ */
+void its_hot_tier_free(struct its_hot_asset_t *asset);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ITS_HOT_TIER_H__ */
@@ -18,6 +18,8 @@ extern "C" {
 #define TFM_ITS_GET_SIGNAL                                      (1U << (1 + 4))
 #define TFM_ITS_GET_INFO_SIGNAL                                 (1U << (2 + 4))
 #define TFM_ITS_REMOVE_SIGNAL                                   (1U << (3 + 4))
+#define TFM_ITS_LIST_SIGNAL                                     (1U << (4 + 4))
+#define TFM_ITS_SYNC_SIGNAL                                     (1U << (5 + 4))
 
 #ifdef __cplusplus
 }
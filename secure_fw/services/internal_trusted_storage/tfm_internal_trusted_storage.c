@@ -7,6 +7,8 @@
 
 #include "tfm_internal_trusted_storage.h"
 
+#include <stdbool.h>
+
 #include "flash/its_flash.h"
 #include "flash_fs/its_flash_fs.h"
 #include "psa_manifest/pid.h"
@@ -14,6 +16,12 @@
 #include "tfm_its_defs.h"
 #include "tfm_its_req_mngr.h"
 #include "its_utils.h"
+#ifdef TFM_RESOURCE_USAGE
+#include "secure_fw/include/tfm_spm_services_api.h"
+#endif
+#ifdef ITS_HOT_TIER
+#include "its_hot_tier.h"
+#endif
 
 #ifndef ITS_BUF_SIZE
 /* By default, set the ITS buffer size to the max asset size so that all
@@ -32,12 +40,80 @@ static uint8_t asset_data[ITS_UTILS_ALIGN(ITS_BUF_SIZE,
 static uint8_t g_fid[ITS_FILE_ID_SIZE];
 static struct its_file_info_t g_file_info;
 
-static its_flash_fs_ctx_t fs_ctx_its;
-static its_flash_fs_ctx_t fs_ctx_sst;
+#ifdef ITS_CREATE_FLASH_LAYOUT
+#define ITS_CREATE_LAYOUT true
+#else
+#define ITS_CREATE_LAYOUT false
+#endif
+
+#ifdef SST_CREATE_FLASH_LAYOUT
+#define SST_CREATE_LAYOUT true
+#else
+#define SST_CREATE_LAYOUT false
+#endif
+
+/* Flags which are only supported with the hot tier */
+#ifdef ITS_HOT_TIER
+#define ITS_HOT_FLAG TFM_STORAGE_FLAG_HOT
+#else
+#define ITS_HOT_FLAG 0
+#endif
+
+/* Client ID of an instance which stores the assets of any other client */
+#define ITS_FS_ANY_CLIENT 0
+
+/*!
+ * \struct its_fs_instance_t
+ *
+ * \brief Filesystem instance, which stores the assets of a client on a flash
+ *        device.
+ */
+struct its_fs_instance_t {
+    int32_t client_id;            /*!< Client whose assets are stored, or
+                                   *   ITS_FS_ANY_CLIENT
+                                   */
+    enum its_flash_id_t flash_id; /*!< Flash device of the instance */
+    bool create_layout;           /*!< Whether a valid layout is created in
+                                   *   the flash area if there is none
+                                   */
+    its_flash_fs_ctx_t fs_ctx;    /*!< Filesystem context */
+};
+
+/* Filesystem instances. A client's assets are stored in the first instance
+ * which matches its client ID, so the instance for any client must be last.
+ * A new instance needs its own flash device, added to enum its_flash_id_t.
+ */
+static struct its_fs_instance_t fs_instances[] = {
+#ifdef TFM_PARTITION_SECURE_STORAGE
+    {
+        .client_id = TFM_SP_STORAGE,
+        .flash_id = ITS_FLASH_ID_EXTERNAL,
+        .create_layout = SST_CREATE_LAYOUT,
+    },
+#endif
+    {
+        .client_id = ITS_FS_ANY_CLIENT,
+        .flash_id = ITS_FLASH_ID_INTERNAL,
+        .create_layout = ITS_CREATE_LAYOUT,
+    },
+};
+
+#define ITS_NUM_FS_INSTANCES \
+    (sizeof(fs_instances) / sizeof(fs_instances[0]))
 
 static its_flash_fs_ctx_t *get_fs_ctx(int32_t client_id)
 {
-    return (client_id == TFM_SP_STORAGE) ? &fs_ctx_sst : &fs_ctx_its;
+    uint32_t i;
+
+    for (i = 0; i < ITS_NUM_FS_INSTANCES; i++) {
+        if ((fs_instances[i].client_id == client_id) ||
+            (fs_instances[i].client_id == ITS_FS_ANY_CLIENT)) {
+            return &fs_instances[i].fs_ctx;
+        }
+    }
+
+    /* Not reached while the last instance is for any client */
+    return &fs_instances[ITS_NUM_FS_INSTANCES - 1].fs_ctx;
 }
 
 /**
@@ -55,74 +131,182 @@ static void tfm_its_get_fid(int32_t client_id,
     tfm_memcpy(fid + sizeof(client_id), (const void *)&uid, sizeof(uid));
 }
 
-psa_status_t tfm_its_init(void)
+#ifdef ITS_HOT_TIER
+/**
+ * \brief Writes the data of an asset of the hot tier to flash, replacing the
+ *        copy of the asset held in flash if there is one.
+ *
+ * \param[in,out] asset  Pointer to the entry of the asset
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t tfm_its_hot_tier_flush(struct its_hot_asset_t *asset)
 {
+    struct its_file_info_t file_info;
+    its_flash_fs_ctx_t *fs_ctx;
+    int32_t client_id;
     psa_status_t status;
 
-    /* Initialise the ITS context */
-    status = its_flash_fs_prepare(&fs_ctx_its,
-                                  its_flash_get_info(ITS_FLASH_ID_INTERNAL));
-#ifdef ITS_CREATE_FLASH_LAYOUT
-    /* If ITS_CREATE_FLASH_LAYOUT is set, it indicates that it is required to
-     * create a ITS flash layout. ITS service will generate an empty and valid
-     * ITS flash layout to store assets. It will erase all data located in the
-     * assigned ITS memory area before generating the ITS layout.
-     * This flag is required to be set if the ITS memory area is located in
-     * non-persistent memory.
-     * This flag can be set if the ITS memory area is located in persistent
-     * memory without a previous valid ITS flash layout in it. That is the case
-     * when it is the first time in the device life that the ITS service is
-     * executed.
-     */
-     if (status != PSA_SUCCESS) {
-        /* Remove all data in the ITS memory area and create a valid ITS flash
-         * layout in that area.
+    /* The file ID begins with the client ID */
+    tfm_memcpy(&client_id, asset->fid, sizeof(client_id));
+    fs_ctx = get_fs_ctx(client_id);
+
+    status = its_flash_fs_file_get_info(fs_ctx, asset->fid, &file_info);
+    if (status == PSA_SUCCESS) {
+        status = its_flash_fs_file_delete(fs_ctx, asset->fid);
+    } else if (status == PSA_ERROR_DOES_NOT_EXIST) {
+        status = PSA_SUCCESS;
+    }
+
+    if (status == PSA_SUCCESS) {
+        status = its_flash_fs_file_create(fs_ctx, asset->fid, asset->size,
+                                          asset->size, asset->flags,
+                                          asset->data);
+    }
+
+    if (status == PSA_SUCCESS) {
+        asset->state = ITS_HOT_ASSET_CLEAN;
+        asset->writes = 0;
+        its_hot_tier_seal(asset);
+    }
+
+    return status;
+}
+
+/**
+ * \brief Writes an asset created with TFM_STORAGE_FLAG_HOT to the hot tier.
+ *        The asset is flushed to flash once it has been written
+ *        ITS_HOT_TIER_FLUSH_WRITES times since its last flush.
+ *
+ * \param[in] client_id     Identifier of the asset's owner (client)
+ * \param[in] data_length   The size in bytes of the data
+ * \param[in] create_flags  The flags that the data will be stored with
+ *
+ * \note The file ID of the asset is in g_fid.
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t tfm_its_hot_tier_set(int32_t client_id,
+                                         size_t data_length,
+                                         psa_storage_create_flags_t create_flags)
+{
+    struct its_hot_asset_t *asset;
+    psa_status_t status;
+
+    asset = its_hot_tier_find(g_fid);
+    if (asset == NULL) {
+        /* The asset may be in flash, if it was created without the hot flag
+         * or if it was flushed and its entry reused since.
          */
-        status = its_flash_fs_wipe_all(&fs_ctx_its);
-        if (status != PSA_SUCCESS) {
+        status = its_flash_fs_file_get_info(get_fs_ctx(client_id), g_fid,
+                                            &g_file_info);
+        if (status == PSA_SUCCESS) {
+            if (g_file_info.flags & PSA_STORAGE_FLAG_WRITE_ONCE) {
+                return PSA_ERROR_NOT_PERMITTED;
+            }
+        } else if (status != PSA_ERROR_DOES_NOT_EXIST) {
             return status;
         }
 
-        /* Attempt to initialise again */
-        status = its_flash_fs_prepare(&fs_ctx_its,
-                                     its_flash_get_info(ITS_FLASH_ID_INTERNAL));
+        asset = its_hot_tier_alloc(g_fid);
+        if (asset == NULL) {
+            /* All the entries are dirty. Flush them so that one can be
+             * reused.
+             */
+            status = tfm_its_sync();
+            if (status != PSA_SUCCESS) {
+                return status;
+            }
+            asset = its_hot_tier_alloc(g_fid);
+        }
     }
-#endif /* ITS_CREATE_FLASH_LAYOUT */
 
-#ifdef TFM_PARTITION_SECURE_STORAGE
-    /* Initialise the SST context */
-    status = its_flash_fs_prepare(&fs_ctx_sst,
-                                  its_flash_get_info(ITS_FLASH_ID_EXTERNAL));
-#ifdef SST_CREATE_FLASH_LAYOUT
-    /* If SST_CREATE_FLASH_LAYOUT is set, it indicates that it is required to
-     * create a SST flash layout. SST service will generate an empty and valid
-     * SST flash layout to store assets. It will erase all data located in the
-     * assigned SST memory area before generating the SST layout.
-     * This flag is required to be set if the SST memory area is located in
-     * non-persistent memory.
-     * This flag can be set if the SST memory area is located in persistent
-     * memory without a previous valid SST flash layout in it. That is the case
-     * when it is the first time in the device life that the SST service is
-     * executed.
+    asset->state = ITS_HOT_ASSET_DIRTY;
+    asset->flags = (uint32_t)create_flags;
+    asset->size = (uint32_t)its_req_mngr_read(asset->data, data_length);
+    asset->writes++;
+    its_hot_tier_seal(asset);
+
+    /* A failed flush leaves the asset dirty in the hot tier. It is tried
+     * again at the next write or synchronisation.
      */
-     if (status != PSA_SUCCESS) {
-        /* Remove all data in the SST memory area and create a valid SST flash
-         * layout in that area.
+    if (asset->writes >= ITS_HOT_TIER_FLUSH_WRITES) {
+        (void)tfm_its_hot_tier_flush(asset);
+    }
+
+    return PSA_SUCCESS;
+}
+#endif /* ITS_HOT_TIER */
+
+#ifdef TFM_RESOURCE_USAGE
+/**
+ * \brief Usage of the files of all the filesystem instances, reported by SPM
+ */
+static struct tfm_resource_usage_t its_usage = {
+    .resource_id = TFM_RESOURCE_ITS_FILES,
+};
+#endif
+
+psa_status_t tfm_its_init(void)
+{
+    const struct its_flash_info_t *flash_info;
+    psa_status_t status;
+    uint32_t i;
+
+    for (i = 0; i < ITS_NUM_FS_INSTANCES; i++) {
+        flash_info = its_flash_get_info(fs_instances[i].flash_id);
+
+        /* Initialise the filesystem context */
+        status = its_flash_fs_prepare(&fs_instances[i].fs_ctx, flash_info);
+
+        /* If create_layout is set, it indicates that it is required to create
+         * a flash layout. The service will generate an empty and valid flash
+         * layout to store assets. It will erase all data located in the
+         * assigned memory area before generating the layout.
+         * This flag is required to be set if the memory area is located in
+         * non-persistent memory.
+         * This flag can be set if the memory area is located in persistent
+         * memory without a previous valid flash layout in it. That is the case
+         * when it is the first time in the device life that the service is
+         * executed.
          */
-        status = its_flash_fs_wipe_all(&fs_ctx_sst);
+        if ((status != PSA_SUCCESS) && fs_instances[i].create_layout) {
+            /* Remove all data in the memory area and create a valid flash
+             * layout in that area.
+             */
+            status = its_flash_fs_wipe_all(&fs_instances[i].fs_ctx);
+            if (status != PSA_SUCCESS) {
+                return status;
+            }
+
+            /* Attempt to initialise again */
+            status = its_flash_fs_prepare(&fs_instances[i].fs_ctx, flash_info);
+        }
+
         if (status != PSA_SUCCESS) {
             return status;
         }
-
-        /* Attempt to initialise again */
-        status = its_flash_fs_prepare(&fs_ctx_sst,
-                                     its_flash_get_info(ITS_FLASH_ID_EXTERNAL));
     }
-#endif /* SST_CREATE_FLASH_LAYOUT */
 
-#endif /* TFM_PARTITION_SECURE_STORAGE */
+#ifdef ITS_HOT_TIER
+    /* Flush the hot assets which were not flushed before the last reset, if
+     * they were kept in retained RAM. Those which cannot be flushed stay
+     * dirty in the hot tier.
+     */
+    its_hot_tier_init();
+    (void)tfm_its_sync();
+#endif
+
+#ifdef TFM_RESOURCE_USAGE
+    for (i = 0; i < ITS_NUM_FS_INSTANCES; i++) {
+        its_usage.capacity +=
+            its_flash_get_info(fs_instances[i].flash_id)->max_num_files;
+    }
+    (void)tfm_core_resource_usage_register(&its_usage);
+    tfm_its_update_usage();
+#endif
 
-    return status;
+    return PSA_SUCCESS;
 }
 
 psa_status_t tfm_its_set(int32_t client_id,
@@ -130,9 +314,10 @@ psa_status_t tfm_its_set(int32_t client_id,
                          size_t data_length,
                          psa_storage_create_flags_t create_flags)
 {
+#ifdef ITS_HOT_TIER
+    struct its_hot_asset_t *p_hot_asset;
+#endif
     psa_status_t status;
-    size_t write_size;
-    size_t offset;
 
     /* Check that the UID is valid */
     if (uid == TFM_ITS_INVALID_UID) {
@@ -142,13 +327,34 @@ psa_status_t tfm_its_set(int32_t client_id,
     /* Check that the create_flags does not contain any unsupported flags */
     if (create_flags & ~(PSA_STORAGE_FLAG_WRITE_ONCE |
                          PSA_STORAGE_FLAG_NO_CONFIDENTIALITY |
-                         PSA_STORAGE_FLAG_NO_REPLAY_PROTECTION)) {
+                         PSA_STORAGE_FLAG_NO_REPLAY_PROTECTION |
+                         ITS_HOT_FLAG)) {
         return PSA_ERROR_NOT_SUPPORTED;
     }
 
     /* Set file id */
     tfm_its_get_fid(client_id, uid, g_fid);
 
+#ifdef ITS_HOT_TIER
+    if (create_flags & TFM_STORAGE_FLAG_HOT) {
+        /* A hot asset is rewritten, so it cannot be write once */
+        if (create_flags & PSA_STORAGE_FLAG_WRITE_ONCE) {
+            return PSA_ERROR_NOT_SUPPORTED;
+        }
+
+        /* The assets too large for the hot tier are stored in flash */
+        if (data_length <= ITS_HOT_TIER_MAX_ASSET_SIZE) {
+            return tfm_its_hot_tier_set(client_id, data_length, create_flags);
+        }
+    }
+
+    /* The asset is stored in flash from now on */
+    p_hot_asset = its_hot_tier_find(g_fid);
+    if (p_hot_asset != NULL) {
+        its_hot_tier_free(p_hot_asset);
+    }
+#endif
+
     /* Read file info */
     status = its_flash_fs_file_get_info(get_fs_ctx(client_id), g_fid,
                                         &g_file_info);
@@ -171,46 +377,15 @@ psa_status_t tfm_its_set(int32_t client_id,
         return status;
     }
 
-    /* Write as much of the data as will fit in the asset_data buffer */
-    write_size = ITS_UTILS_MIN(data_length, sizeof(asset_data));
-
-    /* Read asset data from the caller */
-    (void)its_req_mngr_read(asset_data, write_size);
-
-    /* Create the file in the file system */
-    status = its_flash_fs_file_create(get_fs_ctx(client_id), g_fid, data_length,
-                                      write_size, (uint32_t)create_flags,
-                                      asset_data);
-    if (status != PSA_SUCCESS) {
-        return status;
-    }
-
-    offset = write_size;
-    data_length -= write_size;
-
-    /* Iteratively read data from the caller and write it to the filesystem, in
-     * chunks no larger than the size of the asset_data buffer.
+    /* Create the file in the file system, with the data read from the caller
+     * in chunks no larger than the size of the asset_data buffer. The chunks
+     * are committed together, with a single metadata update.
      */
-    while (data_length > 0) {
-        write_size = ITS_UTILS_MIN(data_length, sizeof(asset_data));
-
-        /* Read asset data from the caller */
-        (void)its_req_mngr_read(asset_data, write_size);
-
-        /* Write to the file in the file system */
-        status = its_flash_fs_file_write(get_fs_ctx(client_id), g_fid,
-                                         write_size, offset, asset_data);
-        if (status != PSA_SUCCESS) {
-            /* Delete the file to avoid leaving partial data */
-            (void)its_flash_fs_file_delete(get_fs_ctx(client_id), g_fid);
-            return status;
-        }
-
-        offset += write_size;
-        data_length -= write_size;
-    }
-
-    return PSA_SUCCESS;
+    return its_flash_fs_file_create_chunked(get_fs_ctx(client_id), g_fid,
+                                            data_length, data_length,
+                                            (uint32_t)create_flags,
+                                            asset_data, sizeof(asset_data),
+                                            its_req_mngr_read);
 }
 
 psa_status_t tfm_its_get(int32_t client_id,
@@ -219,6 +394,10 @@ psa_status_t tfm_its_get(int32_t client_id,
                          size_t data_size,
                          size_t *p_data_length)
 {
+#ifdef ITS_HOT_TIER
+    struct its_hot_asset_t *p_hot_asset;
+#endif
+    const uint8_t *p_data;
     psa_status_t status;
     size_t read_size;
 
@@ -239,6 +418,22 @@ psa_status_t tfm_its_get(int32_t client_id,
     /* Set file id */
     tfm_its_get_fid(client_id, uid, g_fid);
 
+#ifdef ITS_HOT_TIER
+    /* The hot tier holds the latest data of its assets */
+    p_hot_asset = its_hot_tier_find(g_fid);
+    if (p_hot_asset != NULL) {
+        if (data_offset > p_hot_asset->size) {
+            return PSA_ERROR_INVALID_ARGUMENT;
+        }
+
+        data_size = ITS_UTILS_MIN(data_size, p_hot_asset->size - data_offset);
+        *p_data_length = data_size;
+        its_req_mngr_write(p_hot_asset->data + data_offset, data_size);
+
+        return PSA_SUCCESS;
+    }
+#endif
+
     /* Read file info */
     status = its_flash_fs_file_get_info(get_fs_ctx(client_id), g_fid,
                                         &g_file_info);
@@ -258,6 +453,19 @@ psa_status_t tfm_its_get(int32_t client_id,
     /* Update the size of the output data */
     *p_data_length = data_size;
 
+    /* If the flash area is memory-mapped, write the data to the caller
+     * directly from flash.
+     */
+    status = its_flash_fs_file_get_addr(get_fs_ctx(client_id), g_fid,
+                                        data_size, data_offset, &p_data);
+    if (status == PSA_SUCCESS) {
+        its_req_mngr_write(p_data, data_size);
+        return PSA_SUCCESS;
+    } else if (status != PSA_ERROR_NOT_SUPPORTED) {
+        *p_data_length = 0;
+        return status;
+    }
+
     /* Iteratively read data from the filesystem and write it to the caller, in
      * chunks no larger than the size of the asset_data buffer.
      */
@@ -286,6 +494,9 @@ psa_status_t tfm_its_get(int32_t client_id,
 psa_status_t tfm_its_get_info(int32_t client_id, psa_storage_uid_t uid,
                               struct psa_storage_info_t *p_info)
 {
+#ifdef ITS_HOT_TIER
+    struct its_hot_asset_t *p_hot_asset;
+#endif
     psa_status_t status;
 
     /* Check that the UID is valid */
@@ -296,6 +507,17 @@ psa_status_t tfm_its_get_info(int32_t client_id, psa_storage_uid_t uid,
     /* Set file id */
     tfm_its_get_fid(client_id, uid, g_fid);
 
+#ifdef ITS_HOT_TIER
+    p_hot_asset = its_hot_tier_find(g_fid);
+    if (p_hot_asset != NULL) {
+        p_info->capacity = p_hot_asset->size;
+        p_info->size = p_hot_asset->size;
+        p_info->flags = p_hot_asset->flags;
+
+        return PSA_SUCCESS;
+    }
+#endif
+
     /* Read file info */
     status = its_flash_fs_file_get_info(get_fs_ctx(client_id), g_fid,
                                         &g_file_info);
@@ -313,6 +535,9 @@ psa_status_t tfm_its_get_info(int32_t client_id, psa_storage_uid_t uid,
 
 psa_status_t tfm_its_remove(int32_t client_id, psa_storage_uid_t uid)
 {
+#ifdef ITS_HOT_TIER
+    struct its_hot_asset_t *p_hot_asset;
+#endif
     psa_status_t status;
 
 #ifdef TFM_PARTITION_TEST_SST
@@ -332,6 +557,26 @@ psa_status_t tfm_its_remove(int32_t client_id, psa_storage_uid_t uid)
     /* Set file id */
     tfm_its_get_fid(client_id, uid, g_fid);
 
+#ifdef ITS_HOT_TIER
+    /* A hot asset is never write once. Its copy in flash, if any, is removed
+     * too.
+     */
+    p_hot_asset = its_hot_tier_find(g_fid);
+    if (p_hot_asset != NULL) {
+        its_hot_tier_free(p_hot_asset);
+
+        status = its_flash_fs_file_get_info(get_fs_ctx(client_id), g_fid,
+                                            &g_file_info);
+        if (status == PSA_SUCCESS) {
+            return its_flash_fs_file_delete(get_fs_ctx(client_id), g_fid);
+        } else if (status == PSA_ERROR_DOES_NOT_EXIST) {
+            return PSA_SUCCESS;
+        }
+
+        return status;
+    }
+#endif
+
     status = its_flash_fs_file_get_info(get_fs_ctx(client_id), g_fid,
                                         &g_file_info);
     if (status != PSA_SUCCESS) {
@@ -348,3 +593,107 @@ psa_status_t tfm_its_remove(int32_t client_id, psa_storage_uid_t uid)
     /* Delete old file from the persistent area */
     return its_flash_fs_file_delete(get_fs_ctx(client_id), g_fid);
 }
+
+psa_status_t tfm_its_list(int32_t client_id, uint32_t *cursor,
+                          size_t max_uids, size_t *uid_count)
+{
+    psa_status_t status = PSA_SUCCESS;
+    psa_storage_uid_t uid;
+    size_t count = 0;
+
+    *uid_count = 0;
+
+    if (*cursor == TFM_STORAGE_LIST_END) {
+        return PSA_SUCCESS;
+    }
+
+#ifdef ITS_HOT_TIER
+    /* Flush the hot assets so that they are all found in flash */
+    status = tfm_its_sync();
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+#endif
+
+    /* The file IDs of the client begin with its client ID */
+    while (count < max_uids) {
+        status = its_flash_fs_file_find(get_fs_ctx(client_id),
+                                        (const uint8_t *)&client_id,
+                                        sizeof(client_id), cursor, g_fid);
+        if (status != PSA_SUCCESS) {
+            break;
+        }
+
+        tfm_memcpy(&uid, g_fid + sizeof(client_id), sizeof(uid));
+        its_req_mngr_write((const uint8_t *)&uid, sizeof(uid));
+        count++;
+    }
+
+    *uid_count = count;
+
+    if (status == PSA_ERROR_DOES_NOT_EXIST) {
+        *cursor = TFM_STORAGE_LIST_END;
+        return PSA_SUCCESS;
+    }
+
+    return status;
+}
+
+psa_status_t tfm_its_sync(void)
+{
+#ifdef ITS_HOT_TIER
+    struct its_hot_asset_t *asset;
+    psa_status_t status = PSA_SUCCESS;
+    psa_status_t err;
+    uint32_t i;
+
+    /* Flush every dirty asset, even if the flush of another one failed */
+    for (i = 0; i < ITS_HOT_TIER_NUM_ASSETS; i++) {
+        asset = its_hot_tier_get(i);
+        if (asset->state == ITS_HOT_ASSET_DIRTY) {
+            err = tfm_its_hot_tier_flush(asset);
+            if (status == PSA_SUCCESS) {
+                status = err;
+            }
+        }
+    }
+
+    return status;
+#else
+    /* Every asset is written to flash when it is set */
+    return PSA_SUCCESS;
+#endif
+}
+
+#ifdef ITS_DEFERRED_ERASE
+psa_status_t tfm_its_maintain(void)
+{
+    psa_status_t status = PSA_ERROR_DOES_NOT_EXIST;
+    uint32_t i;
+
+    for (i = 0; (i < ITS_NUM_FS_INSTANCES) &&
+                (status == PSA_ERROR_DOES_NOT_EXIST); i++) {
+        status = its_flash_fs_maintain(&fs_instances[i].fs_ctx);
+    }
+
+    return status;
+}
+#endif
+
+#ifdef TFM_RESOURCE_USAGE
+void tfm_its_update_usage(void)
+{
+    uint32_t i, cursor, used = 0;
+
+    for (i = 0; i < ITS_NUM_FS_INSTANCES; i++) {
+        cursor = 0;
+        /* An empty prefix matches every file */
+        while (its_flash_fs_file_find(&fs_instances[i].fs_ctx, g_fid, 0,
+                                      &cursor, g_fid) == PSA_SUCCESS) {
+            used++;
+        }
+    }
+
+    tfm_resource_usage_set(&its_usage, used);
+}
+#endif
@@ -163,6 +163,71 @@ psa_status_t tfm_its_get_info(int32_t client_id, psa_storage_uid_t uid,
  */
 psa_status_t tfm_its_remove(int32_t client_id, psa_storage_uid_t uid);
 
+/**
+ * \brief Lists the UIDs stored by a client, starting from a cursor
+ *
+ * The UIDs are written to the caller, up to \p max_uids of them. They are
+ * looked up in the file metadata, in the RAM file index when it is enabled,
+ * so the data of the assets is not read.
+ *
+ * \param[in]     client_id  Identifier of the assets' owner (client)
+ * \param[in,out] cursor     TFM_STORAGE_LIST_START, or the cursor returned by
+ *                           the previous call. Set to TFM_STORAGE_LIST_END
+ *                           once all the UIDs are listed.
+ * \param[in]     max_uids   Largest number of UIDs to list
+ * \param[out]    uid_count  Number of UIDs listed
+ *
+ * \return A status indicating the success/failure of the operation
+ *
+ * \retval PSA_SUCCESS                 The operation completed successfully
+ * \retval PSA_ERROR_STORAGE_FAILURE   The operation failed because the physical
+ *                                     storage has failed (Fatal error)
+ */
+psa_status_t tfm_its_list(int32_t client_id, uint32_t *cursor,
+                          size_t max_uids, size_t *uid_count);
+
+/**
+ * \brief Writes to flash the data of the hot assets which has not been
+ *        flushed yet. Does nothing when the hot tier is not enabled.
+ *
+ * \return A status indicating the success/failure of the operation
+ *
+ * \retval PSA_SUCCESS                     The operation completed successfully
+ * \retval PSA_ERROR_INSUFFICIENT_STORAGE  The operation failed because there
+ *                                         was insufficient space on the
+ *                                         storage medium
+ * \retval PSA_ERROR_STORAGE_FAILURE       The operation failed because the
+ *                                         physical storage has failed (Fatal
+ *                                         error)
+ */
+psa_status_t tfm_its_sync(void);
+
+#ifdef ITS_DEFERRED_ERASE
+/**
+ * \brief Does one step of the maintenance deferred from the last updates of
+ *        the storage, while no request is pending.
+ *
+ * \return A status indicating whether maintenance remains to be done
+ *
+ * \retval PSA_SUCCESS                 A step was done, and the function
+ *                                     should be called again
+ * \retval PSA_ERROR_DOES_NOT_EXIST    There is no maintenance left to do
+ * \retval PSA_ERROR_STORAGE_FAILURE   The operation failed because the physical
+ *                                     storage has failed (Fatal error)
+ */
+psa_status_t tfm_its_maintain(void);
+#endif
+
+#ifdef TFM_RESOURCE_USAGE
+/**
+ * \brief Counts the files of all the filesystem instances, to bring the usage
+ *        reported by SPM up to date. It is called after the requests which
+ *        add or remove files. The hot assets which are not flushed yet are
+ *        not counted.
+ */
+void tfm_its_update_usage(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -7,6 +7,7 @@
 
 #include "tfm_its_req_mngr.h"
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "psa/storage_common.h"
@@ -18,12 +19,27 @@
 #include "psa/service.h"
 #include "psa_manifest/tfm_internal_trusted_storage.h"
 #else
-#include <stdbool.h>
 #include "tfm_secure_api.h"
 #include "tfm_memory_utils.h"
 #include "tfm_api.h"
 #endif
 
+#ifdef ITS_HOT_TIER
+/* Set while a request is served. The power-fail handler does not flush the hot
+ * tier then, as the filesystem may be in the middle of an update.
+ */
+static volatile bool its_busy = false;
+#define ITS_SET_BUSY(busy) (its_busy = (busy))
+#else
+#define ITS_SET_BUSY(busy)
+#endif
+
+#ifdef TFM_RESOURCE_USAGE
+#define ITS_UPDATE_USAGE() tfm_its_update_usage()
+#else
+#define ITS_UPDATE_USAGE()
+#endif
+
 #ifndef TFM_PSA_API
 static uint8_t *p_data;
 
@@ -35,6 +51,7 @@ static bool its_is_init = false;
 psa_status_t tfm_its_set_req(psa_invec *in_vec, size_t in_len,
                              psa_outvec *out_vec, size_t out_len)
 {
+    psa_status_t status;
     psa_storage_uid_t uid;
     size_t data_length;
     psa_storage_create_flags_t create_flags;
@@ -69,12 +86,18 @@ psa_status_t tfm_its_set_req(psa_invec *in_vec, size_t in_len,
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
-    return tfm_its_set(client_id, uid, data_length, create_flags);
+    ITS_SET_BUSY(true);
+    status = tfm_its_set(client_id, uid, data_length, create_flags);
+    ITS_UPDATE_USAGE();
+    ITS_SET_BUSY(false);
+
+    return status;
 }
 
 psa_status_t tfm_its_get_req(psa_invec *in_vec, size_t in_len,
                              psa_outvec *out_vec, size_t out_len)
 {
+    psa_status_t status;
     psa_storage_uid_t uid;
     size_t data_offset;
     size_t data_size;
@@ -110,12 +133,17 @@ psa_status_t tfm_its_get_req(psa_invec *in_vec, size_t in_len,
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
-    return tfm_its_get(client_id, uid, data_offset, data_size, p_data_length);
+    ITS_SET_BUSY(true);
+    status = tfm_its_get(client_id, uid, data_offset, data_size, p_data_length);
+    ITS_SET_BUSY(false);
+
+    return status;
 }
 
 psa_status_t tfm_its_get_info_req(psa_invec *in_vec, size_t in_len,
                                   psa_outvec *out_vec, size_t out_len)
 {
+    psa_status_t status;
     psa_storage_uid_t uid;
     struct psa_storage_info_t *p_info;
     int32_t client_id;
@@ -144,12 +172,17 @@ psa_status_t tfm_its_get_info_req(psa_invec *in_vec, size_t in_len,
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
-    return tfm_its_get_info(client_id, uid, p_info);
+    ITS_SET_BUSY(true);
+    status = tfm_its_get_info(client_id, uid, p_info);
+    ITS_SET_BUSY(false);
+
+    return status;
 }
 
 psa_status_t tfm_its_remove_req(psa_invec *in_vec, size_t in_len,
                                 psa_outvec *out_vec, size_t out_len)
 {
+    psa_status_t status;
     psa_storage_uid_t uid;
     int32_t client_id;
 
@@ -176,7 +209,83 @@ psa_status_t tfm_its_remove_req(psa_invec *in_vec, size_t in_len,
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
-    return tfm_its_remove(client_id, uid);
+    ITS_SET_BUSY(true);
+    status = tfm_its_remove(client_id, uid);
+    ITS_UPDATE_USAGE();
+    ITS_SET_BUSY(false);
+
+    return status;
+}
+
+psa_status_t tfm_its_list_req(psa_invec *in_vec, size_t in_len,
+                              psa_outvec *out_vec, size_t out_len)
+{
+    psa_status_t status;
+    uint32_t cursor;
+    size_t uid_count;
+    int32_t client_id;
+
+    if (!its_is_init) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    if ((in_len != 1) || (out_len != 2)) {
+        /* The number of arguments is incorrect */
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    if (in_vec[0].len != sizeof(cursor) ||
+        out_vec[1].len != sizeof(cursor)) {
+        /* The size of one of the arguments is incorrect */
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    cursor = *((uint32_t *)in_vec[0].base);
+
+    p_data = (uint8_t *)out_vec[0].base;
+
+    /* Get the caller's client ID */
+    if (tfm_core_get_caller_client_id(&client_id) != (int32_t)TFM_SUCCESS) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    ITS_SET_BUSY(true);
+    status = tfm_its_list(client_id, &cursor,
+                          out_vec[0].len / sizeof(psa_storage_uid_t),
+                          &uid_count);
+    ITS_SET_BUSY(false);
+
+    out_vec[0].len = uid_count * sizeof(psa_storage_uid_t);
+    if (status == PSA_SUCCESS) {
+        *((uint32_t *)out_vec[1].base) = cursor;
+    }
+
+    return status;
+}
+
+psa_status_t tfm_its_sync_req(psa_invec *in_vec, size_t in_len,
+                              psa_outvec *out_vec, size_t out_len)
+{
+    psa_status_t status;
+
+    (void)in_vec;
+    (void)out_vec;
+
+    if (!its_is_init) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    if ((in_len != 0) || (out_len != 0)) {
+        /* The number of arguments is incorrect */
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    ITS_SET_BUSY(true);
+    status = tfm_its_sync();
+    ITS_UPDATE_USAGE();
+    ITS_SET_BUSY(false);
+
+    return status;
 }
 
 #else /* !defined(TFM_PSA_API) */
@@ -285,6 +394,39 @@ static psa_status_t tfm_its_remove_ipc(void)
     return tfm_its_remove(msg.client_id, uid);
 }
 
+static psa_status_t tfm_its_list_ipc(void)
+{
+    psa_status_t status;
+    uint32_t cursor;
+    size_t uid_count;
+    size_t num;
+
+    if (msg.in_size[0] != sizeof(cursor) ||
+        msg.out_size[1] != sizeof(cursor)) {
+        /* The size of one of the arguments is incorrect */
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    num = psa_read(msg.handle, 0, &cursor, sizeof(cursor));
+    if (num != sizeof(cursor)) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    status = tfm_its_list(msg.client_id, &cursor,
+                          msg.out_size[0] / sizeof(psa_storage_uid_t),
+                          &uid_count);
+    if (status == PSA_SUCCESS) {
+        psa_write(msg.handle, 1, &cursor, sizeof(cursor));
+    }
+
+    return status;
+}
+
+static psa_status_t tfm_its_sync_ipc(void)
+{
+    return tfm_its_sync();
+}
+
 /*
  * Fixme: Temporarily implement abort as infinite loop,
  * will replace it later.
@@ -309,7 +451,13 @@ static void its_signal_handle(psa_signal_t signal, its_func_t pfn)
         psa_reply(msg.handle, PSA_SUCCESS);
         break;
     case PSA_IPC_CALL:
+        ITS_SET_BUSY(true);
         status = pfn();
+        if (signal & (TFM_ITS_SET_SIGNAL | TFM_ITS_REMOVE_SIGNAL |
+                      TFM_ITS_SYNC_SIGNAL)) {
+            ITS_UPDATE_USAGE();
+        }
+        ITS_SET_BUSY(false);
         psa_reply(msg.handle, status);
         break;
     case PSA_IPC_DISCONNECT:
@@ -331,7 +479,23 @@ psa_status_t tfm_its_req_mngr_init(void)
     }
 
     while (1) {
+#ifdef ITS_DEFERRED_ERASE
+        /* Erase the scratch blocks left by the last updates while no request
+         * is pending, one step at a time so that a new request is served
+         * after at most one step.
+         */
+        signals = psa_wait(PSA_WAIT_ANY, PSA_POLL);
+        ITS_SET_BUSY(true);
+        while ((signals == 0) && (tfm_its_maintain() == PSA_SUCCESS)) {
+            signals = psa_wait(PSA_WAIT_ANY, PSA_POLL);
+        }
+        ITS_SET_BUSY(false);
+        if (signals == 0) {
+            signals = psa_wait(PSA_WAIT_ANY, PSA_BLOCK);
+        }
+#else
         signals = psa_wait(PSA_WAIT_ANY, PSA_BLOCK);
+#endif
         if (signals & TFM_ITS_SET_SIGNAL) {
             its_signal_handle(TFM_ITS_SET_SIGNAL, tfm_its_set_ipc);
         } else if (signals & TFM_ITS_GET_SIGNAL) {
@@ -340,6 +504,10 @@ psa_status_t tfm_its_req_mngr_init(void)
             its_signal_handle(TFM_ITS_GET_INFO_SIGNAL, tfm_its_get_info_ipc);
         } else if (signals & TFM_ITS_REMOVE_SIGNAL) {
             its_signal_handle(TFM_ITS_REMOVE_SIGNAL, tfm_its_remove_ipc);
+        } else if (signals & TFM_ITS_LIST_SIGNAL) {
+            its_signal_handle(TFM_ITS_LIST_SIGNAL, tfm_its_list_ipc);
+        } else if (signals & TFM_ITS_SYNC_SIGNAL) {
+            its_signal_handle(TFM_ITS_SYNC_SIGNAL, tfm_its_sync_ipc);
         } else {
             tfm_abort();
         }
@@ -353,6 +521,18 @@ psa_status_t tfm_its_req_mngr_init(void)
     return PSA_SUCCESS;
 }
 
+#ifdef ITS_HOT_TIER
+void tfm_its_power_fail_handler(void)
+{
+    /* If a request is being served, the dirty hot assets are left to the
+     * retained RAM, from which they are flushed at the next boot.
+     */
+    if (!its_busy) {
+        (void)tfm_its_sync();
+    }
+}
+#endif
+
 size_t its_req_mngr_read(uint8_t *buf, size_t num_bytes)
 {
 #ifdef TFM_PSA_API
@@ -80,6 +80,51 @@ psa_status_t tfm_its_get_info_req(psa_invec *in_vec, size_t in_len,
 psa_status_t tfm_its_remove_req(psa_invec *in_vec, size_t in_len,
                                 psa_outvec *out_vec, size_t out_len);
 
+/**
+ * \brief Handles the list request.
+ *
+ * \param[in]  in_vec  Pointer to the input vector which contains the input
+ *                     parameters.
+ * \param[in]  in_len  Number of input parameters in the input vector.
+ * \param[out] out_vec Pointer to the output vector which contains the output
+ *                     parameters.
+ * \param[in]  out_len Number of output parameters in the output vector.
+ *
+ * \return A status indicating the success/failure of the operation as specified
+ *         in \ref psa_status_t
+ */
+psa_status_t tfm_its_list_req(psa_invec *in_vec, size_t in_len,
+                              psa_outvec *out_vec, size_t out_len);
+
+/**
+ * \brief Handles the sync request.
+ *
+ * \param[in]  in_vec  Pointer to the input vector which contains the input
+ *                     parameters.
+ * \param[in]  in_len  Number of input parameters in the input vector.
+ * \param[out] out_vec Pointer to the output vector which contains the output
+ *                     parameters.
+ * \param[in]  out_len Number of output parameters in the output vector.
+ *
+ * \return A status indicating the success/failure of the operation as specified
+ *         in \ref psa_status_t
+ */
+psa_status_t tfm_its_sync_req(psa_invec *in_vec, size_t in_len,
+                              psa_outvec *out_vec, size_t out_len);
+
+#ifdef ITS_HOT_TIER
+/**
+ * \brief Flushes the hot tier to flash on a power failure. To be called by
+ *        the brown-out or power-fail interrupt handler of the platform.
+ *
+ * \note The flash is only accessed if no request is being served, otherwise
+ *       the dirty hot assets are flushed from retained RAM at the next boot.
+ *       The handler runs with the privileges of the interrupt, so it is only
+ *       supported in isolation level 1.
+ */
+void tfm_its_power_fail_handler(void);
+#endif
+
 /**
  * \brief Reads asset data from the caller.
  *
@@ -24,9 +24,6 @@ psa_status_t psa_its_set(psa_storage_uid_t uid,
                          psa_storage_create_flags_t create_flags)
 {
     psa_status_t status;
-#ifdef TFM_PSA_API
-    psa_handle_t handle;
-#endif
 
     psa_invec in_vec[] = {
         { .base = &uid, .len = sizeof(uid) },
@@ -35,14 +32,8 @@ psa_status_t psa_its_set(psa_storage_uid_t uid,
     };
 
 #ifdef TFM_PSA_API
-    handle = psa_connect(TFM_ITS_SET_SID, TFM_ITS_SET_VERSION);
-    if (!PSA_HANDLE_IS_VALID(handle)) {
-        return PSA_ERROR_GENERIC_ERROR;
-    }
-
-    status = psa_call(handle, PSA_IPC_CALL, in_vec, IOVEC_LEN(in_vec), NULL, 0);
-
-    psa_close(handle);
+    status = psa_call(TFM_ITS_SET_HANDLE, PSA_IPC_CALL,
+                      in_vec, IOVEC_LEN(in_vec), NULL, 0);
 #else
     status = tfm_tfm_its_set_req_veneer(in_vec, IOVEC_LEN(in_vec), NULL, 0);
 #endif
@@ -68,9 +59,6 @@ psa_status_t psa_its_get(psa_storage_uid_t uid,
                          size_t *p_data_length)
 {
     psa_status_t status;
-#ifdef TFM_PSA_API
-    psa_handle_t handle;
-#endif
 
     psa_invec in_vec[] = {
         { .base = &uid, .len = sizeof(uid) },
@@ -86,15 +74,8 @@ psa_status_t psa_its_get(psa_storage_uid_t uid,
     }
 
 #ifdef TFM_PSA_API
-    handle = psa_connect(TFM_ITS_GET_SID, TFM_ITS_GET_VERSION);
-    if (!PSA_HANDLE_IS_VALID(handle)) {
-        return PSA_ERROR_GENERIC_ERROR;
-    }
-
-    status = psa_call(handle, PSA_IPC_CALL, in_vec, IOVEC_LEN(in_vec), out_vec,
-                      IOVEC_LEN(out_vec));
-
-    psa_close(handle);
+    status = psa_call(TFM_ITS_GET_HANDLE, PSA_IPC_CALL,
+                      in_vec, IOVEC_LEN(in_vec), out_vec, IOVEC_LEN(out_vec));
 #else
     status = tfm_tfm_its_get_req_veneer(in_vec, IOVEC_LEN(in_vec),
                                         out_vec, IOVEC_LEN(out_vec));
@@ -121,9 +102,6 @@ psa_status_t psa_its_get_info(psa_storage_uid_t uid,
                               struct psa_storage_info_t *p_info)
 {
     psa_status_t status;
-#ifdef TFM_PSA_API
-    psa_handle_t handle;
-#endif
 
     psa_invec in_vec[] = {
         { .base = &uid, .len = sizeof(uid) }
@@ -134,15 +112,8 @@ psa_status_t psa_its_get_info(psa_storage_uid_t uid,
     };
 
 #ifdef TFM_PSA_API
-    handle = psa_connect(TFM_ITS_GET_INFO_SID, TFM_ITS_GET_INFO_VERSION);
-    if (!PSA_HANDLE_IS_VALID(handle)) {
-        return PSA_ERROR_GENERIC_ERROR;
-    }
-
-    status = psa_call(handle, PSA_IPC_CALL, in_vec, IOVEC_LEN(in_vec), out_vec,
-                      IOVEC_LEN(out_vec));
-
-    psa_close(handle);
+    status = psa_call(TFM_ITS_GET_INFO_HANDLE, PSA_IPC_CALL,
+                      in_vec, IOVEC_LEN(in_vec), out_vec, IOVEC_LEN(out_vec));
 #else
     status = tfm_tfm_its_get_info_req_veneer(in_vec, IOVEC_LEN(in_vec),
                                              out_vec, IOVEC_LEN(out_vec));
@@ -164,26 +135,69 @@ __attribute__((section("SFN")))
 psa_status_t psa_its_remove(psa_storage_uid_t uid)
 {
     psa_status_t status;
+
+    psa_invec in_vec[] = {
+        { .base = &uid, .len = sizeof(uid) }
+    };
+
 #ifdef TFM_PSA_API
-    psa_handle_t handle;
+    status = psa_call(TFM_ITS_REMOVE_HANDLE, PSA_IPC_CALL,
+                      in_vec, IOVEC_LEN(in_vec), NULL, 0);
+
+#else
+    status = tfm_tfm_its_remove_req_veneer(in_vec, IOVEC_LEN(in_vec), NULL, 0);
 #endif
 
+    return status;
+}
+
+__attribute__((section("SFN")))
+psa_status_t psa_its_list(uint32_t *cursor,
+                          psa_storage_uid_t *uids,
+                          size_t max_uids,
+                          size_t *uid_count)
+{
+    psa_status_t status;
+
     psa_invec in_vec[] = {
-        { .base = &uid, .len = sizeof(uid) }
+        { .base = cursor, .len = sizeof(*cursor) }
     };
 
+    psa_outvec out_vec[] = {
+        { .base = uids, .len = max_uids * sizeof(psa_storage_uid_t) },
+        { .base = cursor, .len = sizeof(*cursor) }
+    };
+
+    if ((cursor == NULL) || (uid_count == NULL)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
 #ifdef TFM_PSA_API
-    handle = psa_connect(TFM_ITS_REMOVE_SID, TFM_ITS_REMOVE_VERSION);
-    if (!PSA_HANDLE_IS_VALID(handle)) {
-        return PSA_ERROR_GENERIC_ERROR;
+    status = psa_call(TFM_ITS_LIST_HANDLE, PSA_IPC_CALL,
+                      in_vec, IOVEC_LEN(in_vec), out_vec, IOVEC_LEN(out_vec));
+#else
+    status = tfm_tfm_its_list_req_veneer(in_vec, IOVEC_LEN(in_vec),
+                                       out_vec, IOVEC_LEN(out_vec));
+#endif
+
+    if (status == (psa_status_t)TFM_ERROR_INVALID_PARAMETER) {
+        return PSA_ERROR_INVALID_ARGUMENT;
     }
 
-    status = psa_call(handle, PSA_IPC_CALL, in_vec, IOVEC_LEN(in_vec), NULL, 0);
+    *uid_count = out_vec[0].len / sizeof(psa_storage_uid_t);
 
-    psa_close(handle);
+    return status;
+}
 
+__attribute__((section("SFN")))
+psa_status_t psa_its_sync(void)
+{
+    psa_status_t status;
+#ifdef TFM_PSA_API
+    status = psa_call(TFM_ITS_SYNC_HANDLE, PSA_IPC_CALL,
+                      NULL, 0, NULL, 0);
 #else
-    status = tfm_tfm_its_remove_req_veneer(in_vec, IOVEC_LEN(in_vec), NULL, 0);
+    status = tfm_tfm_its_sync_req_veneer(NULL, 0, NULL, 0);
 #endif
 
     return status;
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -9,19 +9,259 @@
 
 #include "platform/include/tfm_platform_system.h"
 #include "secure_fw/include/tfm_spm_services_api.h"
+#ifdef TFM_BOOT_TIME
+#include "tfm_secure_api.h"
+#include "tfm_memory_utils.h"
+#endif
+#if defined(TFM_SPM_STATS) || defined(TFM_SPM_PROFILE) || \
+    defined(TFM_RESOURCE_USAGE)
+#include "tfm_memory_utils.h"
+#endif
+#ifdef TFM_PERF_COUNTERS
+#include "platform/include/tfm_plat_perf_counters.h"
+#include "tfm_memory_utils.h"
+#ifndef TFM_PSA_API
+#include "tfm_secure_api.h"
+#endif
+#endif
 
 #ifdef TFM_PSA_API
 #include "psa_manifest/tfm_platform.h"
 #include "psa/client.h"
 #include "psa/service.h"
 #include "region_defs.h"
+#include "tfm_memory_utils.h"
 
 #define INPUT_BUFFER_SIZE  64
 #define OUTPUT_BUFFER_SIZE 64
 
 typedef enum tfm_platform_err_t (*plat_func_t)(const psa_msg_t *msg);
+
+#ifdef TFM_IPC_TRACE
+static struct tfm_ipc_trace_entry_t ipc_trace_buf[TFM_IPC_TRACE_ENTRIES];
+#endif
+#endif
+
+#ifdef TFM_BOOT_TIME
+/* Boot data of the timelines recorded by BL2 and by the secure image */
+static uint8_t boot_time_data[SHARED_DATA_HEADER_SIZE +
+                              2 * SHARED_DATA_ENTRY_HEADER_SIZE +
+                              TFM_BOOT_TIME_ENTRIES *
+                              sizeof(struct tfm_boot_time_entry_t)];
+static struct tfm_boot_time_entry_t boot_time_buf[TFM_BOOT_TIME_ENTRIES];
+
+/**
+ * \brief Reads the boot stages from the shared data area to boot_time_buf,
+ *        the stages of BL2 first.
+ *
+ * \param[out] num  Number of stages read
+ *
+ * \return Returns values as specified by the \ref tfm_platform_err_t
+ */
+static enum tfm_platform_err_t platform_sp_boot_time_get(uint32_t *num)
+{
+    struct tfm_boot_data *boot_data = (struct tfm_boot_data *)boot_time_data;
+    struct shared_data_tlv_entry tlv_entry;
+    uint32_t offset, tlv_end, size = 0;
+
+    if (tfm_core_get_boot_data(TLV_MAJOR_BOOT_TIME, boot_data,
+                               sizeof(boot_time_data)) != TFM_SUCCESS) {
+        return TFM_PLATFORM_ERR_SYSTEM_ERROR;
+    }
+
+    /* The entries come in the order they were added: BL2, then SPE */
+    tlv_end = boot_data->header.tlv_tot_len;
+    for (offset = SHARED_DATA_HEADER_SIZE;
+         offset + SHARED_DATA_ENTRY_HEADER_SIZE <= tlv_end;
+         offset += tlv_entry.tlv_len) {
+        (void)tfm_memcpy(&tlv_entry, &boot_time_data[offset],
+                         SHARED_DATA_ENTRY_HEADER_SIZE);
+        if ((tlv_entry.tlv_len < SHARED_DATA_ENTRY_HEADER_SIZE) ||
+            (tlv_entry.tlv_len - SHARED_DATA_ENTRY_HEADER_SIZE >
+             sizeof(boot_time_buf) - size)) {
+            break;
+        }
+        (void)tfm_memcpy((uint8_t *)boot_time_buf + size,
+                         &boot_time_data[offset +
+                                         SHARED_DATA_ENTRY_HEADER_SIZE],
+                         tlv_entry.tlv_len - SHARED_DATA_ENTRY_HEADER_SIZE);
+        size += tlv_entry.tlv_len - SHARED_DATA_ENTRY_HEADER_SIZE;
+    }
+
+    *num = size / sizeof(struct tfm_boot_time_entry_t);
+
+    return TFM_PLATFORM_ERR_SUCCESS;
+}
+#endif /* TFM_BOOT_TIME */
+
+#ifdef TFM_SPM_STATS
+/* Number of statistics entries read from SPM at a time */
+#define SPM_STATS_CHUNK_ENTRIES 8
+
+/* Both types of entries have the same size */
+static struct tfm_spm_partition_stats_t spm_stats_buf[SPM_STATS_CHUNK_ENTRIES];
+
+/* Size of the entries of each statistics type, in outvec order */
+static const uint32_t spm_stats_entry_size[] = {
+    sizeof(struct tfm_spm_partition_stats_t),
+    sizeof(struct tfm_spm_service_stats_t),
+};
+#endif /* TFM_SPM_STATS */
+
+#ifdef TFM_SPM_PROFILE
+/* Number of samples moved from SPM at a time */
+#define SPM_PROFILE_CHUNK_SAMPLES 16
+
+static struct tfm_spm_profile_sample_t
+    spm_profile_buf[SPM_PROFILE_CHUNK_SAMPLES];
+#endif /* TFM_SPM_PROFILE */
+
+#ifdef TFM_RESOURCE_USAGE
+/* Number of entries copied from SPM at a time */
+#define RESOURCE_USAGE_CHUNK_ENTRIES 4
+
+static struct tfm_resource_usage_t
+    resource_usage_buf[RESOURCE_USAGE_CHUNK_ENTRIES];
+#endif /* TFM_RESOURCE_USAGE */
+
+#ifdef TFM_PERF_COUNTERS
+/* The counters belong to the client which configured them until released */
+static bool perf_owned;
+static int32_t perf_owner;
+
+static enum tfm_platform_err_t platform_sp_perf_err(enum tfm_plat_err_t err)
+{
+    switch (err) {
+    case TFM_PLAT_ERR_SUCCESS:
+        return TFM_PLATFORM_ERR_SUCCESS;
+    case TFM_PLAT_ERR_INVALID_INPUT:
+        return TFM_PLATFORM_ERR_INVALID_PARAM;
+    case TFM_PLAT_ERR_UNSUPPORTED:
+        return TFM_PLATFORM_ERR_NOT_SUPPORTED;
+    default:
+        return TFM_PLATFORM_ERR_SYSTEM_ERROR;
+    }
+}
+
+/**
+ * \brief Performs the TFM_PLATFORM_IOCTL_PERF_* requests.
+ *
+ * \param[in]  client_id  Client of the request
+ * \param[in]  request    Request identifier
+ * \param[in]  in_vec     Input buffer of the request (or NULL)
+ * \param[out] out_vec    Output buffer of the request (or NULL)
+ *
+ * \return Returns TFM_PLATFORM_ERR_NOT_SUPPORTED to the non-secure clients,
+ *         unless TFM_PERF_COUNTERS_NS is set, and TFM_PLATFORM_ERR_SYSTEM_ERROR
+ *         if another client has configured the counters. Other values are
+ *         returned as specified by the \ref tfm_platform_err_t
+ */
+static enum tfm_platform_err_t
+platform_sp_perf_ioctl(int32_t client_id, tfm_platform_ioctl_req_t request,
+                       psa_invec *in_vec, psa_outvec *out_vec)
+{
+    struct tfm_perf_info_t info;
+    struct tfm_perf_config_t config;
+    struct tfm_perf_values_t values;
+    enum tfm_plat_err_t err;
+
+#ifndef TFM_PERF_COUNTERS_NS
+    if (TFM_CLIENT_ID_IS_NS(client_id)) {
+        return TFM_PLATFORM_ERR_NOT_SUPPORTED;
+    }
 #endif
 
+    if (request == TFM_PLATFORM_IOCTL_PERF_INFO) {
+        if ((out_vec == NULL) || (out_vec->len < sizeof(info))) {
+            return TFM_PLATFORM_ERR_INVALID_PARAM;
+        }
+        err = tfm_plat_perf_get_info(&info);
+        if (err == TFM_PLAT_ERR_SUCCESS) {
+            (void)tfm_memcpy(out_vec->base, &info, sizeof(info));
+            out_vec->len = sizeof(info);
+        }
+        return platform_sp_perf_err(err);
+    }
+
+    if (perf_owned && (perf_owner != client_id)) {
+        return TFM_PLATFORM_ERR_SYSTEM_ERROR;
+    }
+
+    switch (request) {
+    case TFM_PLATFORM_IOCTL_PERF_CONFIG:
+        if ((in_vec == NULL) || (in_vec->len != sizeof(config))) {
+            return TFM_PLATFORM_ERR_INVALID_PARAM;
+        }
+        /* The input of a vectored request may not be aligned */
+        (void)tfm_memcpy(&config, in_vec->base, sizeof(config));
+        err = tfm_plat_perf_config(&config);
+        if (err == TFM_PLAT_ERR_SUCCESS) {
+            perf_owned = true;
+            perf_owner = client_id;
+        }
+        return platform_sp_perf_err(err);
+    case TFM_PLATFORM_IOCTL_PERF_RELEASE:
+        if (!perf_owned) {
+            return TFM_PLATFORM_ERR_SUCCESS;
+        }
+        perf_owned = false;
+        return platform_sp_perf_err(tfm_plat_perf_release());
+    default:
+        break;
+    }
+
+    /* The other requests use the configuration of the client */
+    if (!perf_owned) {
+        return TFM_PLATFORM_ERR_INVALID_PARAM;
+    }
+
+    switch (request) {
+    case TFM_PLATFORM_IOCTL_PERF_START:
+        return platform_sp_perf_err(tfm_plat_perf_start());
+    case TFM_PLATFORM_IOCTL_PERF_STOP:
+        return platform_sp_perf_err(tfm_plat_perf_stop());
+    case TFM_PLATFORM_IOCTL_PERF_READ:
+        if ((out_vec == NULL) || (out_vec->len < sizeof(values))) {
+            return TFM_PLATFORM_ERR_INVALID_PARAM;
+        }
+        err = tfm_plat_perf_read(&values);
+        if (err == TFM_PLAT_ERR_SUCCESS) {
+            (void)tfm_memcpy(out_vec->base, &values, sizeof(values));
+            out_vec->len = sizeof(values);
+        }
+        return platform_sp_perf_err(err);
+    default:
+        return TFM_PLATFORM_ERR_NOT_SUPPORTED;
+    }
+}
+#endif /* TFM_PERF_COUNTERS */
+
+/**
+ * \brief Performs a platform-specific service, or a request of the platform
+ *        service itself.
+ *
+ * \param[in]  client_id  Client of the request
+ * \param[in]  request    Request identifier
+ * \param[in]  in_vec     Input buffer of the request (or NULL)
+ * \param[out] out_vec    Output buffer of the request (or NULL)
+ *
+ * \return Returns values as specified by the \ref tfm_platform_err_t
+ */
+static enum tfm_platform_err_t
+platform_sp_hal_ioctl(int32_t client_id, tfm_platform_ioctl_req_t request,
+                      psa_invec *in_vec, psa_outvec *out_vec)
+{
+#ifdef TFM_PERF_COUNTERS
+    if (request < 0) {
+        return platform_sp_perf_ioctl(client_id, request, in_vec, out_vec);
+    }
+#else
+    (void)client_id;
+#endif
+
+    return tfm_platform_hal_ioctl(request, in_vec, out_vec);
+}
+
 enum tfm_platform_err_t platform_sp_system_reset(void)
 {
     /* Check if SPM allows the system reset */
@@ -47,6 +287,7 @@ platform_sp_ioctl(psa_invec  *in_vec,  uint32_t num_invec,
 {
     void *input, *output;
     tfm_platform_ioctl_req_t request;
+    int32_t client_id = 0;
 
     if ((num_invec < 1) || (num_invec > 2) ||
         (num_outvec > 1) ||
@@ -59,7 +300,252 @@ platform_sp_ioctl(psa_invec  *in_vec,  uint32_t num_invec,
     output = out_vec;
     request = *((tfm_platform_ioctl_req_t *)in_vec[0].base);
 
-    return tfm_platform_hal_ioctl(request, input, output);
+#ifdef TFM_PERF_COUNTERS
+    if (tfm_core_get_caller_client_id(&client_id) != TFM_SUCCESS) {
+        return TFM_PLATFORM_ERR_SYSTEM_ERROR;
+    }
+#endif
+
+    return platform_sp_hal_ioctl(client_id, request, input, output);
+}
+
+enum tfm_platform_err_t
+platform_sp_ioctl_vector(psa_invec  *in_vec,  uint32_t num_invec,
+                         psa_outvec *out_vec, uint32_t num_outvec)
+{
+    const struct tfm_platform_ioctl_vec_t *requests;
+    enum tfm_platform_err_t *status;
+    psa_invec invec, *input;
+    psa_outvec outvec, *output;
+    size_t in_offset = 0, out_offset = 0;
+    size_t in_size, out_size;
+    enum tfm_platform_err_t ret = TFM_PLATFORM_ERR_SUCCESS;
+    int32_t client_id = 0;
+    uint32_t i, num;
+
+    if ((num_invec < 1) || (num_invec > 2) ||
+        (num_outvec < 1) || (num_outvec > 2) ||
+        (in_vec[0].len == 0) ||
+        (in_vec[0].len % sizeof(struct tfm_platform_ioctl_vec_t) != 0)) {
+        return TFM_PLATFORM_ERR_SYSTEM_ERROR;
+    }
+
+    num = in_vec[0].len / sizeof(struct tfm_platform_ioctl_vec_t);
+    if (out_vec[0].len != num * sizeof(enum tfm_platform_err_t)) {
+        return TFM_PLATFORM_ERR_SYSTEM_ERROR;
+    }
+
+#ifdef TFM_PERF_COUNTERS
+    if (tfm_core_get_caller_client_id(&client_id) != TFM_SUCCESS) {
+        return TFM_PLATFORM_ERR_SYSTEM_ERROR;
+    }
+#endif
+
+    requests = (const struct tfm_platform_ioctl_vec_t *)in_vec[0].base;
+    status = (enum tfm_platform_err_t *)out_vec[0].base;
+    in_size = (num_invec > 1) ? in_vec[1].len : 0;
+    out_size = (num_outvec > 1) ? out_vec[1].len : 0;
+
+    for (i = 0; i < num; i++) {
+        /* The buffers of the following requests are not known past this one */
+        if ((ret != TFM_PLATFORM_ERR_SUCCESS) ||
+            (requests[i].input_len > in_size - in_offset) ||
+            (requests[i].output_len > out_size - out_offset)) {
+            ret = TFM_PLATFORM_ERR_INVALID_PARAM;
+            status[i] = ret;
+            continue;
+        }
+
+        input = NULL;
+        if (requests[i].input_len > 0) {
+            invec.base = (const uint8_t *)in_vec[1].base + in_offset;
+            invec.len = requests[i].input_len;
+            input = &invec;
+            in_offset += requests[i].input_len;
+        }
+
+        output = NULL;
+        if (requests[i].output_len > 0) {
+            outvec.base = (uint8_t *)out_vec[1].base + out_offset;
+            outvec.len = requests[i].output_len;
+            output = &outvec;
+            out_offset += requests[i].output_len;
+        }
+
+        status[i] = platform_sp_hal_ioctl(client_id, requests[i].request,
+                                          input, output);
+    }
+
+    return ret;
+}
+
+enum tfm_platform_err_t
+platform_sp_boot_time_read(psa_invec  *in_vec,  uint32_t num_invec,
+                           psa_outvec *out_vec, uint32_t num_outvec)
+{
+#ifdef TFM_BOOT_TIME
+    enum tfm_platform_err_t ret;
+    uint32_t num;
+
+    (void)in_vec;
+
+    if ((num_invec != 0) || (num_outvec != 1)) {
+        return TFM_PLATFORM_ERR_SYSTEM_ERROR;
+    }
+
+    ret = platform_sp_boot_time_get(&num);
+    if (ret != TFM_PLATFORM_ERR_SUCCESS) {
+        return ret;
+    }
+
+    /* Only the first stages are returned to a smaller buffer */
+    if (num > out_vec[0].len / sizeof(struct tfm_boot_time_entry_t)) {
+        num = out_vec[0].len / sizeof(struct tfm_boot_time_entry_t);
+    }
+    (void)tfm_memcpy(out_vec[0].base, boot_time_buf,
+                     num * sizeof(struct tfm_boot_time_entry_t));
+    out_vec[0].len = num * sizeof(struct tfm_boot_time_entry_t);
+
+    return TFM_PLATFORM_ERR_SUCCESS;
+#else
+    (void)in_vec;
+    (void)num_invec;
+    (void)out_vec;
+    (void)num_outvec;
+
+    return TFM_PLATFORM_ERR_NOT_SUPPORTED;
+#endif
+}
+
+enum tfm_platform_err_t
+platform_sp_spm_stats_read(psa_invec  *in_vec,  uint32_t num_invec,
+                           psa_outvec *out_vec, uint32_t num_outvec)
+{
+#ifdef TFM_SPM_STATS
+    uint32_t type, max_num, num, chunk, copied;
+
+    (void)in_vec;
+
+    if ((num_invec != 0) || (num_outvec != 2)) {
+        return TFM_PLATFORM_ERR_SYSTEM_ERROR;
+    }
+
+    /* The partitions go to the first outvec, the services to the second */
+    for (type = TFM_SPM_STATS_PARTITIONS; type <= TFM_SPM_STATS_SERVICES;
+         type++) {
+        max_num = out_vec[type].len / spm_stats_entry_size[type];
+        num = 0;
+        while (num < max_num) {
+            chunk = max_num - num;
+            if (chunk > SPM_STATS_CHUNK_ENTRIES) {
+                chunk = SPM_STATS_CHUNK_ENTRIES;
+            }
+            copied = tfm_core_get_spm_stats(type, num, spm_stats_buf, chunk);
+            (void)tfm_memcpy((uint8_t *)out_vec[type].base +
+                             num * spm_stats_entry_size[type],
+                             spm_stats_buf,
+                             copied * spm_stats_entry_size[type]);
+            num += copied;
+            if (copied < chunk) {
+                break;
+            }
+        }
+        out_vec[type].len = num * spm_stats_entry_size[type];
+    }
+
+    return TFM_PLATFORM_ERR_SUCCESS;
+#else
+    (void)in_vec;
+    (void)num_invec;
+    (void)out_vec;
+    (void)num_outvec;
+
+    return TFM_PLATFORM_ERR_NOT_SUPPORTED;
+#endif
+}
+
+enum tfm_platform_err_t
+platform_sp_spm_profile_read(psa_invec  *in_vec,  uint32_t num_invec,
+                             psa_outvec *out_vec, uint32_t num_outvec)
+{
+#ifdef TFM_SPM_PROFILE
+    uint32_t max_num, num, chunk, copied;
+
+    (void)in_vec;
+
+    if ((num_invec != 0) || (num_outvec != 1)) {
+        return TFM_PLATFORM_ERR_SYSTEM_ERROR;
+    }
+
+    max_num = out_vec[0].len / sizeof(struct tfm_spm_profile_sample_t);
+    num = 0;
+    while (num < max_num) {
+        chunk = max_num - num;
+        if (chunk > SPM_PROFILE_CHUNK_SAMPLES) {
+            chunk = SPM_PROFILE_CHUNK_SAMPLES;
+        }
+        copied = tfm_core_get_spm_profile(spm_profile_buf, chunk);
+        (void)tfm_memcpy((struct tfm_spm_profile_sample_t *)out_vec[0].base +
+                         num, spm_profile_buf,
+                         copied * sizeof(struct tfm_spm_profile_sample_t));
+        num += copied;
+        if (copied < chunk) {
+            break;
+        }
+    }
+    out_vec[0].len = num * sizeof(struct tfm_spm_profile_sample_t);
+
+    return TFM_PLATFORM_ERR_SUCCESS;
+#else
+    (void)in_vec;
+    (void)num_invec;
+    (void)out_vec;
+    (void)num_outvec;
+
+    return TFM_PLATFORM_ERR_NOT_SUPPORTED;
+#endif
+}
+
+enum tfm_platform_err_t
+platform_sp_resource_usage_read(psa_invec  *in_vec,  uint32_t num_invec,
+                                psa_outvec *out_vec, uint32_t num_outvec)
+{
+#ifdef TFM_RESOURCE_USAGE
+    uint32_t max_num, num, chunk, copied;
+
+    (void)in_vec;
+
+    if ((num_invec != 0) || (num_outvec != 1)) {
+        return TFM_PLATFORM_ERR_SYSTEM_ERROR;
+    }
+
+    max_num = out_vec[0].len / sizeof(struct tfm_resource_usage_t);
+    num = 0;
+    while (num < max_num) {
+        chunk = max_num - num;
+        if (chunk > RESOURCE_USAGE_CHUNK_ENTRIES) {
+            chunk = RESOURCE_USAGE_CHUNK_ENTRIES;
+        }
+        copied = tfm_core_get_resource_usage(num, resource_usage_buf, chunk);
+        (void)tfm_memcpy((struct tfm_resource_usage_t *)out_vec[0].base + num,
+                         resource_usage_buf,
+                         copied * sizeof(struct tfm_resource_usage_t));
+        num += copied;
+        if (copied < chunk) {
+            break;
+        }
+    }
+    out_vec[0].len = num * sizeof(struct tfm_resource_usage_t);
+
+    return TFM_PLATFORM_ERR_SUCCESS;
+#else
+    (void)in_vec;
+    (void)num_invec;
+    (void)out_vec;
+    (void)num_outvec;
+
+    return TFM_PLATFORM_ERR_NOT_SUPPORTED;
+#endif
 }
 
 #else /* TFM_PSA_API */
@@ -127,7 +613,7 @@ platform_sp_ioctl_ipc(const psa_msg_t *msg)
         output = &outvec;
     }
 
-    ret = tfm_platform_hal_ioctl(request, input, output);
+    ret = platform_sp_hal_ioctl(msg->client_id, request, input, output);
 
     if (output != NULL) {
         psa_write(msg->handle, 0, outvec.base, outvec.len);
@@ -136,6 +622,237 @@ platform_sp_ioctl_ipc(const psa_msg_t *msg)
     return ret;
 }
 
+static enum tfm_platform_err_t
+platform_sp_ioctl_vector_ipc(const psa_msg_t *msg)
+{
+    psa_invec invec;
+    psa_outvec outvec;
+    uint8_t input_buffer[INPUT_BUFFER_SIZE];
+    uint8_t output_buffer[OUTPUT_BUFFER_SIZE];
+    struct tfm_platform_ioctl_vec_t request;
+    enum tfm_platform_err_t status;
+    enum tfm_platform_err_t ret = TFM_PLATFORM_ERR_SUCCESS;
+    size_t in_left = msg->in_size[1];
+    size_t out_left = msg->out_size[1];
+    uint32_t i, num;
+
+    if ((msg->in_size[0] == 0) ||
+        (msg->in_size[0] % sizeof(struct tfm_platform_ioctl_vec_t) != 0)) {
+        return TFM_PLATFORM_ERR_SYSTEM_ERROR;
+    }
+
+    num = msg->in_size[0] / sizeof(struct tfm_platform_ioctl_vec_t);
+    if (msg->out_size[0] != num * sizeof(enum tfm_platform_err_t)) {
+        return TFM_PLATFORM_ERR_SYSTEM_ERROR;
+    }
+
+    /* The requests and their buffers are read and written in order, one
+     * request at a time, as psa_read() and psa_write() move through the
+     * vectors.
+     */
+    for (i = 0; i < num; i++) {
+        (void)psa_read(msg->handle, 0, &request, sizeof(request));
+
+        /* The buffers of the following requests are not known past this one.
+         * The requests must also fit the buffers of the partition.
+         */
+        if ((ret != TFM_PLATFORM_ERR_SUCCESS) ||
+            (request.input_len > in_left) ||
+            (request.output_len > out_left) ||
+            (request.input_len > INPUT_BUFFER_SIZE) ||
+            (request.output_len > OUTPUT_BUFFER_SIZE)) {
+            ret = TFM_PLATFORM_ERR_INVALID_PARAM;
+            psa_write(msg->handle, 0, &ret, sizeof(ret));
+            continue;
+        }
+
+        if (request.input_len > 0) {
+            (void)psa_read(msg->handle, 1, input_buffer, request.input_len);
+            invec.base = input_buffer;
+            invec.len = request.input_len;
+            in_left -= request.input_len;
+        }
+
+        if (request.output_len > 0) {
+            (void)tfm_memset(output_buffer, 0, request.output_len);
+            outvec.base = output_buffer;
+            outvec.len = request.output_len;
+        }
+
+        status = platform_sp_hal_ioctl(msg->client_id, request.request,
+                                       (request.input_len > 0) ?
+                                       &invec : NULL,
+                                       (request.output_len > 0) ?
+                                       &outvec : NULL);
+
+        /* The whole slot is written for the outputs to stay where the
+         * client expects them.
+         */
+        if (request.output_len > 0) {
+            psa_write(msg->handle, 1, output_buffer, request.output_len);
+            out_left -= request.output_len;
+        }
+        psa_write(msg->handle, 0, &status, sizeof(status));
+    }
+
+    return ret;
+}
+
+static enum tfm_platform_err_t
+platform_sp_ipc_trace_ipc(const psa_msg_t *msg)
+{
+#ifdef TFM_IPC_TRACE
+    uint32_t num, max_num;
+
+    max_num = msg->out_size[0] / sizeof(struct tfm_ipc_trace_entry_t);
+    if (max_num > TFM_IPC_TRACE_ENTRIES) {
+        max_num = TFM_IPC_TRACE_ENTRIES;
+    }
+
+    /* Only the most recent entries are returned to a smaller buffer */
+    num = tfm_core_get_ipc_trace(ipc_trace_buf, max_num);
+    if (num > 0) {
+        psa_write(msg->handle, 0, ipc_trace_buf,
+                  num * sizeof(struct tfm_ipc_trace_entry_t));
+    }
+
+    return TFM_PLATFORM_ERR_SUCCESS;
+#else
+    (void)msg; /* unused parameter */
+
+    return TFM_PLATFORM_ERR_NOT_SUPPORTED;
+#endif
+}
+
+static enum tfm_platform_err_t
+platform_sp_boot_time_ipc(const psa_msg_t *msg)
+{
+#ifdef TFM_BOOT_TIME
+    enum tfm_platform_err_t ret;
+    uint32_t num;
+
+    ret = platform_sp_boot_time_get(&num);
+    if (ret != TFM_PLATFORM_ERR_SUCCESS) {
+        return ret;
+    }
+
+    /* Only the first stages are returned to a smaller buffer */
+    if (num > msg->out_size[0] / sizeof(struct tfm_boot_time_entry_t)) {
+        num = msg->out_size[0] / sizeof(struct tfm_boot_time_entry_t);
+    }
+    if (num > 0) {
+        psa_write(msg->handle, 0, boot_time_buf,
+                  num * sizeof(struct tfm_boot_time_entry_t));
+    }
+
+    return TFM_PLATFORM_ERR_SUCCESS;
+#else
+    (void)msg; /* unused parameter */
+
+    return TFM_PLATFORM_ERR_NOT_SUPPORTED;
+#endif
+}
+
+static enum tfm_platform_err_t
+platform_sp_spm_stats_ipc(const psa_msg_t *msg)
+{
+#ifdef TFM_SPM_STATS
+    uint32_t type, max_num, num, chunk, copied;
+
+    /* The partitions go to the first outvec, the services to the second */
+    for (type = TFM_SPM_STATS_PARTITIONS; type <= TFM_SPM_STATS_SERVICES;
+         type++) {
+        max_num = msg->out_size[type] / spm_stats_entry_size[type];
+        num = 0;
+        while (num < max_num) {
+            chunk = max_num - num;
+            if (chunk > SPM_STATS_CHUNK_ENTRIES) {
+                chunk = SPM_STATS_CHUNK_ENTRIES;
+            }
+            copied = tfm_core_get_spm_stats(type, num, spm_stats_buf, chunk);
+            if (copied > 0) {
+                psa_write(msg->handle, type, spm_stats_buf,
+                          copied * spm_stats_entry_size[type]);
+            }
+            num += copied;
+            if (copied < chunk) {
+                break;
+            }
+        }
+    }
+
+    return TFM_PLATFORM_ERR_SUCCESS;
+#else
+    (void)msg; /* unused parameter */
+
+    return TFM_PLATFORM_ERR_NOT_SUPPORTED;
+#endif
+}
+
+static enum tfm_platform_err_t
+platform_sp_spm_profile_ipc(const psa_msg_t *msg)
+{
+#ifdef TFM_SPM_PROFILE
+    uint32_t max_num, num, chunk, copied;
+
+    max_num = msg->out_size[0] / sizeof(struct tfm_spm_profile_sample_t);
+    num = 0;
+    while (num < max_num) {
+        chunk = max_num - num;
+        if (chunk > SPM_PROFILE_CHUNK_SAMPLES) {
+            chunk = SPM_PROFILE_CHUNK_SAMPLES;
+        }
+        copied = tfm_core_get_spm_profile(spm_profile_buf, chunk);
+        if (copied > 0) {
+            psa_write(msg->handle, 0, spm_profile_buf,
+                      copied * sizeof(struct tfm_spm_profile_sample_t));
+        }
+        num += copied;
+        if (copied < chunk) {
+            break;
+        }
+    }
+
+    return TFM_PLATFORM_ERR_SUCCESS;
+#else
+    (void)msg; /* unused parameter */
+
+    return TFM_PLATFORM_ERR_NOT_SUPPORTED;
+#endif
+}
+
+static enum tfm_platform_err_t
+platform_sp_resource_usage_ipc(const psa_msg_t *msg)
+{
+#ifdef TFM_RESOURCE_USAGE
+    uint32_t max_num, num, chunk, copied;
+
+    max_num = msg->out_size[0] / sizeof(struct tfm_resource_usage_t);
+    num = 0;
+    while (num < max_num) {
+        chunk = max_num - num;
+        if (chunk > RESOURCE_USAGE_CHUNK_ENTRIES) {
+            chunk = RESOURCE_USAGE_CHUNK_ENTRIES;
+        }
+        copied = tfm_core_get_resource_usage(num, resource_usage_buf, chunk);
+        if (copied > 0) {
+            psa_write(msg->handle, 0, resource_usage_buf,
+                      copied * sizeof(struct tfm_resource_usage_t));
+        }
+        num += copied;
+        if (copied < chunk) {
+            break;
+        }
+    }
+
+    return TFM_PLATFORM_ERR_SUCCESS;
+#else
+    (void)msg; /* unused parameter */
+
+    return TFM_PLATFORM_ERR_NOT_SUPPORTED;
+#endif
+}
+
 static void platform_signal_handle(psa_signal_t signal, plat_func_t pfn)
 {
     psa_msg_t msg;
@@ -178,6 +895,24 @@ enum tfm_platform_err_t platform_sp_init(void)
         } else if (signals & TFM_SP_PLATFORM_IOCTL_SIGNAL) {
             platform_signal_handle(TFM_SP_PLATFORM_IOCTL_SIGNAL,
                                    platform_sp_ioctl_ipc);
+        } else if (signals & TFM_SP_PLATFORM_IPC_TRACE_SIGNAL) {
+            platform_signal_handle(TFM_SP_PLATFORM_IPC_TRACE_SIGNAL,
+                                   platform_sp_ipc_trace_ipc);
+        } else if (signals & TFM_SP_PLATFORM_BOOT_TIME_SIGNAL) {
+            platform_signal_handle(TFM_SP_PLATFORM_BOOT_TIME_SIGNAL,
+                                   platform_sp_boot_time_ipc);
+        } else if (signals & TFM_SP_PLATFORM_SPM_STATS_SIGNAL) {
+            platform_signal_handle(TFM_SP_PLATFORM_SPM_STATS_SIGNAL,
+                                   platform_sp_spm_stats_ipc);
+        } else if (signals & TFM_SP_PLATFORM_IOCTL_VECTOR_SIGNAL) {
+            platform_signal_handle(TFM_SP_PLATFORM_IOCTL_VECTOR_SIGNAL,
+                                   platform_sp_ioctl_vector_ipc);
+        } else if (signals & TFM_SP_PLATFORM_SPM_PROFILE_SIGNAL) {
+            platform_signal_handle(TFM_SP_PLATFORM_SPM_PROFILE_SIGNAL,
+                                   platform_sp_spm_profile_ipc);
+        } else if (signals & TFM_SP_PLATFORM_RESOURCE_USAGE_SIGNAL) {
+            platform_signal_handle(TFM_SP_PLATFORM_RESOURCE_USAGE_SIGNAL,
+                                   platform_sp_resource_usage_ipc);
         } else {
             /* FIXME: Should be replaced by a call to psa_panic() when it
              * becomes available.
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -44,6 +44,85 @@ enum tfm_platform_err_t
 platform_sp_pin_service(const psa_invec  *in_vec,  uint32_t num_invec,
                         const psa_outvec *out_vec, uint32_t num_outvec);
 
+/*!
+ * \brief Performs a batch of platform-specific services
+ *
+ * \param[in]     in_vec     Pointer to in_vec array, which holds the array
+ *                           of \ref tfm_platform_ioctl_vec_t requests, then
+ *                           the inputs of the requests if any
+ * \param[in]     num_invec  Number of elements in in_vec array, 1 or 2
+ * \param[in,out] out_vec    Pointer to out_vec array, which holds the buffer
+ *                           of the status of each request, then the buffer of
+ *                           the outputs of the requests if any
+ * \param[in]     num_outvec Number of elements in out_vec array, 1 or 2
+ *
+ * \return Returns values as specified by the \ref tfm_platform_err_t
+ */
+enum tfm_platform_err_t
+platform_sp_ioctl_vector(psa_invec  *in_vec,  uint32_t num_invec,
+                         psa_outvec *out_vec, uint32_t num_outvec);
+
+/*!
+ * \brief Reads the boot stages recorded by BL2 and by the secure image
+ *
+ * \param[in]     in_vec     Pointer to in_vec array, unused
+ * \param[in]     num_invec  Number of elements in in_vec array, must be 0
+ * \param[in,out] out_vec    Pointer to out_vec array, which holds the buffer
+ *                           of the stages
+ * \param[in]     num_outvec Number of elements in out_vec array, must be 1
+ *
+ * \return Returns values as specified by the \ref tfm_platform_err_t
+ */
+enum tfm_platform_err_t
+platform_sp_boot_time_read(psa_invec  *in_vec,  uint32_t num_invec,
+                           psa_outvec *out_vec, uint32_t num_outvec);
+
+/*!
+ * \brief Reads the load statistics of the partitions and RoT Services
+ *
+ * \param[in]     in_vec     Pointer to in_vec array, unused
+ * \param[in]     num_invec  Number of elements in in_vec array, must be 0
+ * \param[in,out] out_vec    Pointer to out_vec array, which holds the buffer
+ *                           of the partition statistics, then the buffer of
+ *                           the RoT Service statistics
+ * \param[in]     num_outvec Number of elements in out_vec array, must be 2
+ *
+ * \return Returns values as specified by the \ref tfm_platform_err_t
+ */
+enum tfm_platform_err_t
+platform_sp_spm_stats_read(psa_invec  *in_vec,  uint32_t num_invec,
+                           psa_outvec *out_vec, uint32_t num_outvec);
+
+/*!
+ * \brief Moves the PC samples of the secure image recorded by SPM
+ *
+ * \param[in]     in_vec     Pointer to in_vec array, unused
+ * \param[in]     num_invec  Number of elements in in_vec array, must be 0
+ * \param[in,out] out_vec    Pointer to out_vec array, which holds the buffer
+ *                           of the samples
+ * \param[in]     num_outvec Number of elements in out_vec array, must be 1
+ *
+ * \return Returns values as specified by the \ref tfm_platform_err_t
+ */
+enum tfm_platform_err_t
+platform_sp_spm_profile_read(psa_invec  *in_vec,  uint32_t num_invec,
+                             psa_outvec *out_vec, uint32_t num_outvec);
+
+/*!
+ * \brief Copies the usage of the resource pools registered with SPM
+ *
+ * \param[in]     in_vec     Pointer to in_vec array, unused
+ * \param[in]     num_invec  Number of elements in in_vec array, must be 0
+ * \param[in,out] out_vec    Pointer to out_vec array, which holds the buffer
+ *                           of the entries
+ * \param[in]     num_outvec Number of elements in out_vec array, must be 1
+ *
+ * \return Returns values as specified by the \ref tfm_platform_err_t
+ */
+enum tfm_platform_err_t
+platform_sp_resource_usage_read(psa_invec  *in_vec,  uint32_t num_invec,
+                                psa_outvec *out_vec, uint32_t num_outvec);
+
 #ifdef __cplusplus
 }
 #endif
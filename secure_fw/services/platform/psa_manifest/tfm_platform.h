@@ -16,6 +16,12 @@ extern "C" {
 
 #define TFM_SP_PLATFORM_SYSTEM_RESET_SIGNAL                     (1U << (0 + 4))
 #define TFM_SP_PLATFORM_IOCTL_SIGNAL                            (1U << (1 + 4))
+#define TFM_SP_PLATFORM_IPC_TRACE_SIGNAL                        (1U << (2 + 4))
+#define TFM_SP_PLATFORM_BOOT_TIME_SIGNAL                        (1U << (3 + 4))
+#define TFM_SP_PLATFORM_SPM_STATS_SIGNAL                        (1U << (4 + 4))
+#define TFM_SP_PLATFORM_IOCTL_VECTOR_SIGNAL                     (1U << (5 + 4))
+#define TFM_SP_PLATFORM_SPM_PROFILE_SIGNAL                      (1U << (6 + 4))
+#define TFM_SP_PLATFORM_RESOURCE_USAGE_SIGNAL                   (1U << (7 + 4))
 
 #ifdef __cplusplus
 }
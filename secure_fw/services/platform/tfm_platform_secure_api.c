@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -16,17 +16,9 @@ enum tfm_platform_err_t tfm_platform_system_reset(void)
 {
 #ifdef TFM_PSA_API
     psa_status_t status = PSA_ERROR_CONNECTION_REFUSED;
-    psa_handle_t handle = PSA_NULL_HANDLE;
 
-    handle = psa_connect(TFM_SP_PLATFORM_SYSTEM_RESET_SID,
-                         TFM_SP_PLATFORM_SYSTEM_RESET_VERSION);
-    if (handle <= 0) {
-        return TFM_PLATFORM_ERR_SYSTEM_ERROR;
-    }
-
-    status = psa_call(handle, PSA_IPC_CALL,
+    status = psa_call(TFM_SP_PLATFORM_SYSTEM_RESET_HANDLE, PSA_IPC_CALL,
                       NULL, 0, NULL, 0);
-    psa_close(handle);
 
     if (status < PSA_SUCCESS) {
         return TFM_PLATFORM_ERR_SYSTEM_ERROR;
@@ -49,7 +41,6 @@ tfm_platform_ioctl(tfm_platform_ioctl_req_t request,
     size_t inlen, outlen;
 #ifdef TFM_PSA_API
     psa_status_t status = PSA_ERROR_CONNECTION_REFUSED;
-    psa_handle_t handle = PSA_NULL_HANDLE;
 #endif /* TFM_PSA_API */
 
     in_vec[0].base = &req;
@@ -68,16 +59,9 @@ tfm_platform_ioctl(tfm_platform_ioctl_req_t request,
         outlen = 0;
     }
 #ifdef TFM_PSA_API
-    handle = psa_connect(TFM_SP_PLATFORM_IOCTL_SID,
-                         TFM_SP_PLATFORM_IOCTL_VERSION);
-    if (handle <= 0) {
-        return TFM_PLATFORM_ERR_SYSTEM_ERROR;
-    }
-
-    status = psa_call(handle, PSA_IPC_CALL,
+    status = psa_call(TFM_SP_PLATFORM_IOCTL_HANDLE, PSA_IPC_CALL,
                       in_vec, inlen,
                       output, outlen);
-    psa_close(handle);
 
     if (status < PSA_SUCCESS) {
         return TFM_PLATFORM_ERR_SYSTEM_ERROR;
@@ -90,3 +74,265 @@ tfm_platform_ioctl(tfm_platform_ioctl_req_t request,
 #endif /* TFM_PSA_API */
 }
 
+__attribute__((section("SFN")))
+enum tfm_platform_err_t
+tfm_platform_ioctl_vector(const struct tfm_platform_ioctl_vec_t *requests,
+                          size_t num_requests,
+                          psa_invec *input,
+                          psa_outvec *output,
+                          enum tfm_platform_err_t *status)
+{
+    psa_invec in_vec[2];
+    psa_outvec out_vec[2];
+    size_t inlen, outlen;
+#ifdef TFM_PSA_API
+    psa_status_t status_call;
+#endif /* TFM_PSA_API */
+
+    if ((requests == NULL) || (num_requests == 0) || (status == NULL)) {
+        return TFM_PLATFORM_ERR_INVALID_PARAM;
+    }
+
+    in_vec[0].base = requests;
+    in_vec[0].len = num_requests * sizeof(struct tfm_platform_ioctl_vec_t);
+    if (input != NULL) {
+        in_vec[1] = *input;
+        inlen = 2;
+    } else {
+        inlen = 1;
+    }
+
+    out_vec[0].base = status;
+    out_vec[0].len = num_requests * sizeof(enum tfm_platform_err_t);
+    if (output != NULL) {
+        out_vec[1] = *output;
+        outlen = 2;
+    } else {
+        outlen = 1;
+    }
+#ifdef TFM_PSA_API
+    status_call = psa_call(TFM_SP_PLATFORM_IOCTL_VECTOR_HANDLE, PSA_IPC_CALL,
+                           in_vec, inlen, out_vec, outlen);
+
+    if (status_call < PSA_SUCCESS) {
+        return TFM_PLATFORM_ERR_SYSTEM_ERROR;
+    } else {
+        return (enum tfm_platform_err_t) status_call;
+    }
+#else /* TFM_PSA_API */
+    return (enum tfm_platform_err_t) tfm_platform_sp_ioctl_vector_veneer(
+                                            in_vec, inlen, out_vec, outlen);
+#endif /* TFM_PSA_API */
+}
+
+__attribute__((section("SFN")))
+enum tfm_platform_err_t
+tfm_platform_ipc_trace_read(struct tfm_ipc_trace_entry_t *entries,
+                            size_t *num)
+{
+#ifdef TFM_PSA_API
+    psa_outvec out_vec;
+    psa_status_t status;
+
+    if (num == NULL) {
+        return TFM_PLATFORM_ERR_INVALID_PARAM;
+    }
+
+    out_vec.base = entries;
+    out_vec.len = *num * sizeof(struct tfm_ipc_trace_entry_t);
+
+    status = psa_call(TFM_SP_PLATFORM_IPC_TRACE_HANDLE, PSA_IPC_CALL,
+                      NULL, 0, &out_vec, 1);
+
+    if (status < PSA_SUCCESS) {
+        return TFM_PLATFORM_ERR_SYSTEM_ERROR;
+    }
+
+    *num = out_vec.len / sizeof(struct tfm_ipc_trace_entry_t);
+
+    return (enum tfm_platform_err_t) status;
+#else /* TFM_PSA_API */
+    (void)entries;
+    (void)num;
+
+    /* The IPC trace is only recorded by the SPM of the IPC model */
+    return TFM_PLATFORM_ERR_NOT_SUPPORTED;
+#endif /* TFM_PSA_API */
+}
+
+__attribute__((section("SFN")))
+enum tfm_platform_err_t
+tfm_platform_boot_time_read(struct tfm_boot_time_entry_t *entries,
+                            size_t *num)
+{
+#ifdef TFM_PSA_API
+    psa_outvec out_vec;
+    psa_status_t status;
+
+    if (num == NULL) {
+        return TFM_PLATFORM_ERR_INVALID_PARAM;
+    }
+
+    out_vec.base = entries;
+    out_vec.len = *num * sizeof(struct tfm_boot_time_entry_t);
+
+    status = psa_call(TFM_SP_PLATFORM_BOOT_TIME_HANDLE, PSA_IPC_CALL,
+                      NULL, 0, &out_vec, 1);
+
+    if (status < PSA_SUCCESS) {
+        return TFM_PLATFORM_ERR_SYSTEM_ERROR;
+    }
+
+    *num = out_vec.len / sizeof(struct tfm_boot_time_entry_t);
+
+    return (enum tfm_platform_err_t) status;
+#else /* TFM_PSA_API */
+    psa_outvec out_vec;
+    enum tfm_platform_err_t ret;
+
+    if (num == NULL) {
+        return TFM_PLATFORM_ERR_INVALID_PARAM;
+    }
+
+    out_vec.base = entries;
+    out_vec.len = *num * sizeof(struct tfm_boot_time_entry_t);
+
+    ret = (enum tfm_platform_err_t) tfm_platform_sp_boot_time_read_veneer(
+                                                        NULL, 0, &out_vec, 1);
+    if (ret == TFM_PLATFORM_ERR_SUCCESS) {
+        *num = out_vec.len / sizeof(struct tfm_boot_time_entry_t);
+    }
+
+    return ret;
+#endif /* TFM_PSA_API */
+}
+
+__attribute__((section("SFN")))
+enum tfm_platform_err_t
+tfm_platform_spm_stats_read(struct tfm_spm_partition_stats_t *partitions,
+                            size_t *num_partitions,
+                            struct tfm_spm_service_stats_t *services,
+                            size_t *num_services)
+{
+    psa_outvec out_vec[2];
+#ifdef TFM_PSA_API
+    psa_status_t status;
+#else
+    enum tfm_platform_err_t ret;
+#endif
+
+    if ((num_partitions == NULL) || (num_services == NULL)) {
+        return TFM_PLATFORM_ERR_INVALID_PARAM;
+    }
+
+    out_vec[0].base = partitions;
+    out_vec[0].len = *num_partitions * sizeof(struct tfm_spm_partition_stats_t);
+    out_vec[1].base = services;
+    out_vec[1].len = *num_services * sizeof(struct tfm_spm_service_stats_t);
+
+#ifdef TFM_PSA_API
+    status = psa_call(TFM_SP_PLATFORM_SPM_STATS_HANDLE, PSA_IPC_CALL,
+                      NULL, 0, out_vec, 2);
+
+    if (status < PSA_SUCCESS) {
+        return TFM_PLATFORM_ERR_SYSTEM_ERROR;
+    }
+
+    *num_partitions = out_vec[0].len / sizeof(struct tfm_spm_partition_stats_t);
+    *num_services = out_vec[1].len / sizeof(struct tfm_spm_service_stats_t);
+
+    return (enum tfm_platform_err_t) status;
+#else /* TFM_PSA_API */
+    ret = (enum tfm_platform_err_t) tfm_platform_sp_spm_stats_read_veneer(
+                                                        NULL, 0, out_vec, 2);
+    if (ret == TFM_PLATFORM_ERR_SUCCESS) {
+        *num_partitions =
+                    out_vec[0].len / sizeof(struct tfm_spm_partition_stats_t);
+        *num_services = out_vec[1].len / sizeof(struct tfm_spm_service_stats_t);
+    }
+
+    return ret;
+#endif /* TFM_PSA_API */
+}
+
+__attribute__((section("SFN")))
+enum tfm_platform_err_t
+tfm_platform_spm_profile_read(struct tfm_spm_profile_sample_t *samples,
+                              size_t *num)
+{
+    psa_outvec out_vec;
+#ifdef TFM_PSA_API
+    psa_status_t status;
+#else
+    enum tfm_platform_err_t ret;
+#endif
+
+    if (num == NULL) {
+        return TFM_PLATFORM_ERR_INVALID_PARAM;
+    }
+
+    out_vec.base = samples;
+    out_vec.len = *num * sizeof(struct tfm_spm_profile_sample_t);
+
+#ifdef TFM_PSA_API
+    status = psa_call(TFM_SP_PLATFORM_SPM_PROFILE_HANDLE, PSA_IPC_CALL,
+                      NULL, 0, &out_vec, 1);
+
+    if (status < PSA_SUCCESS) {
+        return TFM_PLATFORM_ERR_SYSTEM_ERROR;
+    }
+
+    *num = out_vec.len / sizeof(struct tfm_spm_profile_sample_t);
+
+    return (enum tfm_platform_err_t) status;
+#else /* TFM_PSA_API */
+    ret = (enum tfm_platform_err_t) tfm_platform_sp_spm_profile_read_veneer(
+                                                        NULL, 0, &out_vec, 1);
+    if (ret == TFM_PLATFORM_ERR_SUCCESS) {
+        *num = out_vec.len / sizeof(struct tfm_spm_profile_sample_t);
+    }
+
+    return ret;
+#endif /* TFM_PSA_API */
+}
+
+__attribute__((section("SFN")))
+enum tfm_platform_err_t
+tfm_platform_resource_usage_read(struct tfm_resource_usage_t *entries,
+                                 size_t *num)
+{
+    psa_outvec out_vec;
+#ifdef TFM_PSA_API
+    psa_status_t status;
+#else
+    enum tfm_platform_err_t ret;
+#endif
+
+    if (num == NULL) {
+        return TFM_PLATFORM_ERR_INVALID_PARAM;
+    }
+
+    out_vec.base = entries;
+    out_vec.len = *num * sizeof(struct tfm_resource_usage_t);
+
+#ifdef TFM_PSA_API
+    status = psa_call(TFM_SP_PLATFORM_RESOURCE_USAGE_HANDLE, PSA_IPC_CALL,
+                      NULL, 0, &out_vec, 1);
+
+    if (status < PSA_SUCCESS) {
+        return TFM_PLATFORM_ERR_SYSTEM_ERROR;
+    }
+
+    *num = out_vec.len / sizeof(struct tfm_resource_usage_t);
+
+    return (enum tfm_platform_err_t) status;
+#else /* TFM_PSA_API */
+    ret = (enum tfm_platform_err_t) tfm_platform_sp_resource_usage_read_veneer(
+                                                        NULL, 0, &out_vec, 1);
+    if (ret == TFM_PLATFORM_ERR_SUCCESS) {
+        *num = out_vec.len / sizeof(struct tfm_resource_usage_t);
+    }
+
+    return ret;
+#endif /* TFM_PSA_API */
+}
@@ -13,18 +13,36 @@
 #include "psa/crypto.h"
 #include "tfm_memory_utils.h"
 
-/* The PSA key type used by this implementation */
-#define SST_KEY_TYPE PSA_KEY_TYPE_AES
 /* The PSA key usage required by this implementation */
 #define SST_KEY_USAGE (PSA_KEY_USAGE_ENCRYPT | PSA_KEY_USAGE_DECRYPT)
-/* The PSA algorithm used by this implementation */
-#define SST_CRYPTO_ALG \
-    PSA_ALG_AEAD_WITH_TAG_LENGTH(PSA_ALG_GCM, SST_TAG_LEN_BYTES)
 
 static const uint8_t sst_key_label[] = "storage_key";
 static psa_key_handle_t sst_key_handle;
 static uint8_t sst_crypto_iv_buf[SST_IV_LEN_BYTES];
 
+#ifdef SST_RESIDENT_STORAGE_KEY
+/* Whether sst_key_handle refers to the resident storage key */
+static bool sst_key_loaded = false;
+
+/**
+ * \brief Checks the status of an operation with the resident storage key.
+ *        The Crypto service releases the handles to the keys derived from the
+ *        HUK when the security lifecycle of the device changes. The stale
+ *        handle is then dropped, so that the next operation derives the key
+ *        again under the new lifecycle.
+ *
+ * \param[in] status  Status of the operation with the storage key
+ */
+static void sst_crypto_check_key(psa_status_t status)
+{
+    if (status == PSA_ERROR_INVALID_HANDLE) {
+        sst_key_loaded = false;
+    }
+}
+#else
+#define sst_crypto_check_key(status)
+#endif /* SST_RESIDENT_STORAGE_KEY */
+
 psa_status_t sst_crypto_init(void)
 {
     /* Currently, no initialisation is required. This may change if key
@@ -39,6 +57,13 @@ psa_status_t sst_crypto_setkey(void)
     psa_key_attributes_t attributes = PSA_KEY_ATTRIBUTES_INIT;
     psa_key_derivation_operation_t op = PSA_KEY_DERIVATION_OPERATION_INIT;
 
+#ifdef SST_RESIDENT_STORAGE_KEY
+    /* The storage key is derived once and kept for the next operations */
+    if (sst_key_loaded) {
+        return PSA_SUCCESS;
+    }
+#endif
+
     /* Set the key attributes for the storage key */
     psa_set_key_usage_flags(&attributes, SST_KEY_USAGE);
     psa_set_key_algorithm(&attributes, SST_CRYPTO_ALG);
@@ -71,6 +96,10 @@ psa_status_t sst_crypto_setkey(void)
         goto err_release_key;
     }
 
+#ifdef SST_RESIDENT_STORAGE_KEY
+    sst_key_loaded = true;
+#endif
+
     return PSA_SUCCESS;
 
 err_release_key:
@@ -84,15 +113,23 @@ err_release_op:
 
 psa_status_t sst_crypto_destroykey(void)
 {
+#ifdef SST_RESIDENT_STORAGE_KEY
+    /* The storage key stays resident for the lifetime of the partition */
+    return PSA_SUCCESS;
+#else
     psa_status_t status;
 
-    /* Destroy the transient key */
+    /* Destroy the transient key. When the Crypto service caches the keys
+     * derived from the HUK, the key stays loaded for the next operation and
+     * only the handle is released.
+     */
     status = psa_destroy_key(sst_key_handle);
     if (status != PSA_SUCCESS) {
         return PSA_ERROR_GENERIC_ERROR;
     }
 
     return PSA_SUCCESS;
+#endif
 }
 
 void sst_crypto_set_iv(const union sst_crypto_t *crypto)
@@ -103,13 +140,14 @@ void sst_crypto_set_iv(const union sst_crypto_t *crypto)
 void sst_crypto_get_iv(union sst_crypto_t *crypto)
 {
     /* IV characteristic is algorithm dependent.
-     * For GCM it is essential that it doesn't get repeated.
+     * For GCM and ChaCha20-Poly1305 it is essential that it doesn't get
+     * repeated.
      * A simple increment will suffice.
      * FIXME:
      * Since IV is predictable in this case,
      * If there is no rollback protection, an attacker could
      * try to rollback the storage and encrypt another plaintext
-     * block with same IV/Key pair; this breaks GCM usage rules.
+     * block with same IV/Key pair; this breaks the AEAD usage rules.
      * One potential fix would be to generate IV through RNG
      */
 
@@ -158,6 +196,7 @@ psa_status_t sst_crypto_encrypt_and_tag(union sst_crypto_t *crypto,
                               add, add_len,
                               in, in_len,
                               out, out_size, out_len);
+    sst_crypto_check_key(status);
     if (status != PSA_SUCCESS) {
         return PSA_ERROR_GENERIC_ERROR;
     }
@@ -189,6 +228,7 @@ psa_status_t sst_crypto_auth_and_decrypt(const union sst_crypto_t *crypto,
                               add, add_len,
                               in, in_len,
                               out, out_size, out_len);
+    sst_crypto_check_key(status);
     if (status != PSA_SUCCESS) {
         return PSA_ERROR_INVALID_SIGNATURE;
     }
@@ -208,6 +248,7 @@ psa_status_t sst_crypto_generate_auth_tag(union sst_crypto_t *crypto,
                               add, add_len,
                               0, 0,
                               crypto->ref.tag, SST_TAG_LEN_BYTES, &out_len);
+    sst_crypto_check_key(status);
     if (status != PSA_SUCCESS || out_len != SST_TAG_LEN_BYTES) {
         return PSA_ERROR_GENERIC_ERROR;
     }
@@ -227,6 +268,7 @@ psa_status_t sst_crypto_authenticate(const union sst_crypto_t *crypto,
                               add, add_len,
                               crypto->ref.tag, SST_TAG_LEN_BYTES,
                               0, 0, &out_len);
+    sst_crypto_check_key(status);
     if (status != PSA_SUCCESS || out_len != 0) {
         return PSA_ERROR_INVALID_SIGNATURE;
     }
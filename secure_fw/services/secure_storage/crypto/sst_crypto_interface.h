@@ -17,7 +17,22 @@
 extern "C" {
 #endif
 
+/* The AEAD algorithm protecting the objects is selected by the SST_CRYPTO_ALG
+ * build option. ChaCha20-Poly1305 is faster than AES-GCM in software, and
+ * constant-time without tables, so it suits the targets without an AES
+ * accelerator.
+ */
+#ifdef SST_CRYPTO_ALG_CHACHA20_POLY1305
+#define SST_KEY_LEN_BYTES  32
+#define SST_KEY_TYPE       PSA_KEY_TYPE_CHACHA20
+#define SST_CRYPTO_ALG     PSA_ALG_CHACHA20_POLY1305
+#else
 #define SST_KEY_LEN_BYTES  16
+#define SST_KEY_TYPE       PSA_KEY_TYPE_AES
+#define SST_CRYPTO_ALG \
+    PSA_ALG_AEAD_WITH_TAG_LENGTH(PSA_ALG_GCM, SST_TAG_LEN_BYTES)
+#endif
+
 #define SST_TAG_LEN_BYTES  16
 #define SST_IV_LEN_BYTES   12
 
@@ -42,6 +57,9 @@ psa_status_t sst_crypto_init(void);
 /**
  * \brief Sets the key to use for crypto operations for the current client.
  *
+ * Note: With SST_RESIDENT_STORAGE_KEY, the key is only derived by the first
+ *       call, and again after the Crypto service has released it.
+ *
  * \return Returns values as described in \ref psa_status_t
  */
 psa_status_t sst_crypto_setkey(void);
@@ -49,6 +67,9 @@ psa_status_t sst_crypto_setkey(void);
 /**
  * \brief Destroys the transient key used for crypto operations.
  *
+ * Note: With SST_RESIDENT_STORAGE_KEY, the key is kept and this function
+ *       does nothing.
+ *
  * \return Returns values as described in \ref psa_status_t
  */
 psa_status_t sst_crypto_destroykey(void);
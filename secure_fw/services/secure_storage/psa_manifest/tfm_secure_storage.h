@@ -19,6 +19,10 @@ extern "C" {
 #define TFM_SST_GET_INFO_SIGNAL                                 (1U << (2 + 4))
 #define TFM_SST_REMOVE_SIGNAL                                   (1U << (3 + 4))
 #define TFM_SST_GET_SUPPORT_SIGNAL                              (1U << (4 + 4))
+#define TFM_SST_TRANSACTION_SIGNAL                              (1U << (5 + 4))
+#define TFM_SST_SET_ASYNC_SIGNAL                                (1U << (6 + 4))
+#define TFM_SST_FLUSH_SIGNAL                                    (1U << (7 + 4))
+#define TFM_SST_LIST_SIGNAL                                     (1U << (8 + 4))
 
 #ifdef __cplusplus
 }
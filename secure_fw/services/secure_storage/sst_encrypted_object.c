@@ -15,23 +15,408 @@
 #include "sst_object_defs.h"
 #include "sst_utils.h"
 
+#define SST_OBJECT_START_POSITION  0
+
+#ifdef SST_CHUNKED_OBJECTS
+/* Size of the object header stored in the persistent area. The header tag is
+ * not part of it, as it is stored in the object table.
+ */
+#define SST_OBJECT_STORED_HEADER_SIZE \
+    (SST_OBJECT_HEADER_SIZE - SST_TAG_LEN_BYTES)
+
+/* The associated data of the header is the header, minus the crypto data */
+#define SST_OBJECT_HEADER_ASSOC_DATA(obj) ((const uint8_t *)&(obj)->header.info)
+#define SST_OBJECT_HEADER_ASSOC_DATA_LEN \
+    (SST_OBJECT_HEADER_SIZE - sizeof(union sst_crypto_t))
+
+#ifdef SST_STREAMED_OBJECTS
+/* Size of the stored object, which is only its header */
+#define SST_OBJECT_STORED_SIZE(obj) SST_OBJECT_STORED_HEADER_SIZE
+
+/* Each chunk file holds the chunk crypto metadata followed by the encrypted
+ * chunk.
+ */
+#define SST_CHUNK_FILE_DATA_POSITION sizeof(union sst_crypto_t)
+
+/* Buffer to store one chunk file, plus the tag which is appended to the
+ * ciphertext by the crypto layer.
+ */
+#define SST_CRYPTO_BUF_LEN (SST_CHUNK_FILE_DATA_POSITION + \
+                            SST_OBJECT_CHUNK_SIZE + SST_TAG_LEN_BYTES)
+
+/* Check at compilation time if a chunk file fits in an object file */
+SST_UTILS_BOUND_CHECK(CHUNK_FILE_NOT_FIT_IN_OBJ_FILE,
+                      SST_CHUNK_FILE_DATA_POSITION + SST_OBJECT_CHUNK_SIZE,
+                      SST_MAX_OBJECT_SIZE);
+
+/*!
+ * \struct sst_chunk_assoc_data_t
+ *
+ * \brief Associated data of a chunk of a streamed object.
+ */
+struct sst_chunk_assoc_data_t {
+    uint32_t fid;                  /*!< File ID of the object */
+    uint32_t chunk;                /*!< Chunk index */
+    uint8_t gen[SST_IV_LEN_BYTES]; /*!< Generation of the chunk files */
+};
+#else
+/* Size of the stored object, the header followed by the encrypted chunks */
+#define SST_OBJECT_STORED_SIZE(obj) \
+    (SST_OBJECT_STORED_HEADER_SIZE + (obj)->header.info.current_size)
+
+/* Position of a chunk in the stored object */
+#define SST_OBJECT_CHUNK_POSITION(chunk) \
+    (SST_OBJECT_STORED_HEADER_SIZE + ((chunk) * SST_OBJECT_CHUNK_SIZE))
+
+/* Buffer to store one encrypted chunk, plus the tag which is appended to the
+ * ciphertext by the crypto layer.
+ */
+#define SST_CRYPTO_BUF_LEN (SST_OBJECT_CHUNK_SIZE + SST_TAG_LEN_BYTES)
+#endif /* SST_STREAMED_OBJECTS */
+#else
 /* Gets the size of data to encrypt */
 #define SST_ENCRYPT_SIZE(plaintext_size) \
     ((plaintext_size) + SST_OBJECT_HEADER_SIZE - sizeof(union sst_crypto_t))
 
-#define SST_OBJECT_START_POSITION  0
-
 /* Buffer to store the maximum encrypted object */
-/* FIXME: Do partial encrypt/decrypt to reduce the size of internal buffer */
 #define SST_MAX_ENCRYPTED_OBJ_SIZE SST_ENCRYPT_SIZE(SST_MAX_OBJECT_DATA_SIZE)
 
 /* FIXME: add the tag length to the crypto buffer size to account for the tag
  * being appended to the ciphertext by the crypto layer.
  */
 #define SST_CRYPTO_BUF_LEN (SST_MAX_ENCRYPTED_OBJ_SIZE + SST_TAG_LEN_BYTES)
+#endif /* SST_CHUNKED_OBJECTS */
 
 static uint8_t sst_crypto_buf[SST_CRYPTO_BUF_LEN];
 
+#ifdef SST_CHUNKED_OBJECTS
+#ifndef SST_STREAMED_OBJECTS
+/**
+ * \brief Performs authenticated decryption of the chunk held in
+ *        sst_crypto_buf, with the chunk index as the associated data.
+ *
+ * \param[in]  obj    Pointer to the object which holds the chunk crypto
+ *                    metadata
+ * \param[in]  chunk  Chunk index
+ * \param[in]  len    Size of the chunk
+ * \param[out] buf    Pointer to the buffer to fill in with the decrypted
+ *                    chunk, of SST_OBJECT_CHUNK_SIZE bytes
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t sst_object_chunk_auth_decrypt(
+                                                 const struct sst_object_t *obj,
+                                                 uint32_t chunk,
+                                                 uint32_t len,
+                                                 uint8_t *buf)
+{
+    psa_status_t err;
+    size_t out_len;
+
+    /* The chunk index is the associated data, so that a chunk cannot be
+     * moved within the object. The chunk crypto metadata is authenticated
+     * with the object header.
+     */
+    err = sst_crypto_auth_and_decrypt(&obj->header.chunk_crypto[chunk],
+                                      (const uint8_t *)&chunk,
+                                      sizeof(chunk),
+                                      sst_crypto_buf,
+                                      len,
+                                      buf,
+                                      SST_OBJECT_CHUNK_SIZE,
+                                      &out_len);
+    if (err != PSA_SUCCESS || out_len != len) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    return PSA_SUCCESS;
+}
+#endif /* !SST_STREAMED_OBJECTS */
+
+psa_status_t sst_encrypted_object_read_header(uint32_t fid,
+                                              struct sst_object_t *obj)
+{
+    psa_status_t err;
+    size_t data_length;
+
+    /* Read the object header from the persistent area */
+    err = psa_its_get(fid, SST_OBJECT_START_POSITION,
+                      SST_OBJECT_STORED_HEADER_SIZE,
+                      (void *)obj->header.crypto.ref.iv,
+                      &data_length);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    if (data_length != SST_OBJECT_STORED_HEADER_SIZE) {
+        return PSA_ERROR_DATA_CORRUPT;
+    }
+
+    err = sst_crypto_setkey();
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    /* Authenticate the header with the tag stored in the object table */
+    err = sst_crypto_authenticate(&obj->header.crypto,
+                                  SST_OBJECT_HEADER_ASSOC_DATA(obj),
+                                  SST_OBJECT_HEADER_ASSOC_DATA_LEN);
+    if (err != PSA_SUCCESS) {
+        (void)sst_crypto_destroykey();
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    err = sst_crypto_destroykey();
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    if (obj->header.fid != fid ||
+        obj->header.info.current_size > obj->header.info.max_size ||
+        obj->header.info.max_size > SST_MAX_OBJECT_CONTENT_SIZE) {
+        return PSA_ERROR_DATA_CORRUPT;
+    }
+
+    return PSA_SUCCESS;
+}
+
+#ifdef SST_STREAMED_OBJECTS
+/**
+ * \brief Fills in the associated data of a chunk, which binds the chunk to
+ *        its index, and to the file ID and the generation of the object, so
+ *        that a chunk file cannot be moved within the object, to another
+ *        object, or replaced by an older chunk file.
+ *
+ * \param[in]  fid    File ID of the object
+ * \param[in]  gen    Generation of the chunk files of the object
+ * \param[in]  chunk  Chunk index
+ * \param[out] add    Pointer to the associated data to fill in
+ */
+static void sst_chunk_assoc_data(uint32_t fid, const uint8_t *gen,
+                                 uint32_t chunk,
+                                 struct sst_chunk_assoc_data_t *add)
+{
+    add->fid = fid;
+    add->chunk = chunk;
+    (void)tfm_memcpy(add->gen, gen, SST_IV_LEN_BYTES);
+}
+
+psa_status_t sst_encrypted_object_read_chunk(uint32_t fid,
+                                             const struct sst_object_t *obj,
+                                             uint32_t chunk,
+                                             uint8_t *buf)
+{
+    psa_status_t err;
+    size_t data_length;
+    size_t out_len;
+    union sst_crypto_t crypto;
+    struct sst_chunk_assoc_data_t add;
+    uint32_t len = SST_UTILS_MIN(SST_OBJECT_CHUNK_SIZE,
+                                 obj->header.info.current_size -
+                                 (chunk * SST_OBJECT_CHUNK_SIZE));
+
+    /* Read the chunk file from the persistent area */
+    err = psa_its_get(SST_OBJECT_CHUNK_FID(fid, chunk), 0,
+                      SST_CHUNK_FILE_DATA_POSITION + len,
+                      (void *)sst_crypto_buf, &data_length);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    if (data_length != SST_CHUNK_FILE_DATA_POSITION + len) {
+        return PSA_ERROR_DATA_CORRUPT;
+    }
+
+    (void)tfm_memcpy(&crypto, sst_crypto_buf, sizeof(crypto));
+    sst_chunk_assoc_data(fid, obj->header.gen, chunk, &add);
+
+    err = sst_crypto_auth_and_decrypt(&crypto,
+                                      (const uint8_t *)&add,
+                                      sizeof(add),
+                                      sst_crypto_buf +
+                                      SST_CHUNK_FILE_DATA_POSITION,
+                                      len,
+                                      buf,
+                                      SST_OBJECT_CHUNK_SIZE,
+                                      &out_len);
+    if (err != PSA_SUCCESS || out_len != len) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t sst_encrypted_object_write_chunk(uint32_t fid,
+                                              const uint8_t *gen,
+                                              uint32_t chunk,
+                                              uint32_t len,
+                                              const uint8_t *buf)
+{
+    psa_status_t err;
+    size_t out_len;
+    union sst_crypto_t crypto;
+    struct sst_chunk_assoc_data_t add;
+
+    /* Get a new IV for each chunk encryption */
+    sst_crypto_get_iv(&crypto);
+    sst_chunk_assoc_data(fid, gen, chunk, &add);
+
+    err = sst_crypto_encrypt_and_tag(&crypto,
+                                     (const uint8_t *)&add,
+                                     sizeof(add),
+                                     buf,
+                                     len,
+                                     sst_crypto_buf +
+                                     SST_CHUNK_FILE_DATA_POSITION,
+                                     sizeof(sst_crypto_buf) -
+                                     SST_CHUNK_FILE_DATA_POSITION,
+                                     &out_len);
+    if (err != PSA_SUCCESS || out_len != len) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    (void)tfm_memcpy(sst_crypto_buf, &crypto, sizeof(crypto));
+
+    return psa_its_set(SST_OBJECT_CHUNK_FID(fid, chunk),
+                       SST_CHUNK_FILE_DATA_POSITION + len,
+                       (const void *)sst_crypto_buf,
+                       PSA_STORAGE_FLAG_NONE);
+}
+#else
+psa_status_t sst_encrypted_object_read_data(uint32_t fid,
+                                            struct sst_object_t *obj)
+{
+    psa_status_t err;
+    size_t data_length;
+
+    if (obj->header.info.current_size == 0) {
+        return PSA_SUCCESS;
+    }
+
+    err = psa_its_get(fid, SST_OBJECT_CHUNK_POSITION(0),
+                      obj->header.info.current_size,
+                      (void *)obj->data,
+                      &data_length);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    if (data_length != obj->header.info.current_size) {
+        return PSA_ERROR_DATA_CORRUPT;
+    }
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t sst_encrypted_object_read_chunk(uint32_t fid,
+                                             const struct sst_object_t *obj,
+                                             uint32_t chunk,
+                                             uint8_t *buf)
+{
+    psa_status_t err;
+    size_t data_length;
+    uint32_t len = SST_UTILS_MIN(SST_OBJECT_CHUNK_SIZE,
+                                 obj->header.info.current_size -
+                                 (chunk * SST_OBJECT_CHUNK_SIZE));
+
+    /* Read only the encrypted chunk from the persistent area */
+    err = psa_its_get(fid, SST_OBJECT_CHUNK_POSITION(chunk), len,
+                      (void *)sst_crypto_buf, &data_length);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    if (data_length != len) {
+        return PSA_ERROR_DATA_CORRUPT;
+    }
+
+    return sst_object_chunk_auth_decrypt(obj, chunk, len, buf);
+}
+
+psa_status_t sst_encrypted_object_decrypt_chunk(const struct sst_object_t *obj,
+                                                uint32_t chunk,
+                                                uint32_t len,
+                                                uint8_t *buf)
+{
+    (void)tfm_memcpy(sst_crypto_buf,
+                     obj->data + (chunk * SST_OBJECT_CHUNK_SIZE), len);
+
+    return sst_object_chunk_auth_decrypt(obj, chunk, len, buf);
+}
+
+psa_status_t sst_encrypted_object_encrypt_chunk(struct sst_object_t *obj,
+                                                uint32_t chunk,
+                                                uint32_t len,
+                                                const uint8_t *buf)
+{
+    psa_status_t err;
+    size_t out_len;
+
+    /* Get a new IV for each chunk encryption */
+    sst_crypto_get_iv(&obj->header.chunk_crypto[chunk]);
+
+    err = sst_crypto_encrypt_and_tag(&obj->header.chunk_crypto[chunk],
+                                     (const uint8_t *)&chunk,
+                                     sizeof(chunk),
+                                     buf,
+                                     len,
+                                     sst_crypto_buf,
+                                     sizeof(sst_crypto_buf),
+                                     &out_len);
+    if (err != PSA_SUCCESS || out_len != len) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    (void)tfm_memcpy(obj->data + (chunk * SST_OBJECT_CHUNK_SIZE),
+                     sst_crypto_buf, len);
+
+    return PSA_SUCCESS;
+}
+
+#endif /* SST_STREAMED_OBJECTS */
+
+psa_status_t sst_encrypted_object_write(uint32_t fid, struct sst_object_t *obj)
+{
+    psa_status_t err;
+
+    /* Bind the header to the File ID */
+    obj->header.fid = fid;
+
+    err = sst_crypto_setkey();
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    /* Get a new IV for each header authentication */
+    sst_crypto_get_iv(&obj->header.crypto);
+
+    /* Generate the header tag, which covers the crypto metadata of each
+     * chunk, or the generation of the chunk files of a streamed object, and
+     * so the whole object data.
+     */
+    err = sst_crypto_generate_auth_tag(&obj->header.crypto,
+                                       SST_OBJECT_HEADER_ASSOC_DATA(obj),
+                                       SST_OBJECT_HEADER_ASSOC_DATA_LEN);
+    if (err != PSA_SUCCESS) {
+        (void)sst_crypto_destroykey();
+        return err;
+    }
+
+    err = sst_crypto_destroykey();
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    /* Write the object to the persistent area. The chunks are already
+     * encrypted. The tag value is not copied as it is stored in the object
+     * table.
+     */
+    return psa_its_set(fid, SST_OBJECT_STORED_SIZE(obj),
+                       (const void *)obj->header.crypto.ref.iv,
+                       PSA_STORAGE_FLAG_NONE);
+}
+#else /* SST_CHUNKED_OBJECTS */
+
 /**
  * \brief Performs authenticated decryption on object data, with the header as
  *        the associated data.
@@ -159,6 +544,13 @@ psa_status_t sst_encrypted_object_read(uint32_t fid, struct sst_object_t *obj)
     return PSA_SUCCESS;
 }
 
+psa_status_t sst_encrypted_object_read_header(uint32_t fid,
+                                              struct sst_object_t *obj)
+{
+    /* The header is authenticated together with the object data */
+    return sst_encrypted_object_read(fid, obj);
+}
+
 psa_status_t sst_encrypted_object_write(uint32_t fid, struct sst_object_t *obj)
 {
     psa_status_t err;
@@ -180,3 +572,4 @@ psa_status_t sst_encrypted_object_write(uint32_t fid, struct sst_object_t *obj)
     return psa_its_set(fid, wrt_size, (const void *)obj->header.crypto.ref.iv,
                        PSA_STORAGE_FLAG_NONE);
 }
+#endif /* SST_CHUNKED_OBJECTS */
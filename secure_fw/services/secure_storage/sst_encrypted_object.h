@@ -16,6 +16,7 @@
 extern "C" {
 #endif
 
+#ifndef SST_CHUNKED_OBJECTS
 /**
  * \brief Reads object referenced by the object File ID.
  *
@@ -26,6 +27,121 @@ extern "C" {
  */
 psa_status_t sst_encrypted_object_read(uint32_t fid,
                                        struct sst_object_t *obj);
+#endif
+
+/**
+ * \brief Reads and authenticates the header of the object referenced by the
+ *        object File ID.
+ *
+ * \param[in]  fid      File ID
+ * \param[out] obj      Pointer to the object structure to fill in
+ *
+ * Note: Without SST_CHUNKED_OBJECTS, the header is authenticated together
+ *       with the object data, so the whole object is read.
+ *
+ * \return Returns error code specified in \ref psa_status_t
+ */
+psa_status_t sst_encrypted_object_read_header(uint32_t fid,
+                                              struct sst_object_t *obj);
+
+#if defined(SST_CHUNKED_OBJECTS) && !defined(SST_STREAMED_OBJECTS)
+/**
+ * \brief Reads the encrypted data of the object referenced by the object File
+ *        ID, without decrypting it.
+ *
+ * \param[in]     fid  File ID
+ * \param[in,out] obj  Pointer to the object structure, whose header has been
+ *                     read, to fill in with the encrypted data
+ *
+ * \return Returns error code specified in \ref psa_status_t
+ */
+psa_status_t sst_encrypted_object_read_data(uint32_t fid,
+                                            struct sst_object_t *obj);
+#endif /* SST_CHUNKED_OBJECTS && !SST_STREAMED_OBJECTS */
+
+#ifdef SST_CHUNKED_OBJECTS
+/**
+ * \brief Reads and decrypts one chunk of the object referenced by the object
+ *        File ID. With SST_STREAMED_OBJECTS, the chunk is read from its own
+ *        chunk file.
+ *
+ * \param[in]  fid    File ID
+ * \param[in]  obj    Pointer to the object structure, whose header has been
+ *                    read
+ * \param[in]  chunk  Index of the chunk to read
+ * \param[out] buf    Pointer to the buffer to fill in with the chunk data, of
+ *                    SST_OBJECT_CHUNK_SIZE bytes
+ *
+ * Note: The storage key must have been set with sst_crypto_setkey().
+ *
+ * \return Returns error code specified in \ref psa_status_t
+ */
+psa_status_t sst_encrypted_object_read_chunk(uint32_t fid,
+                                             const struct sst_object_t *obj,
+                                             uint32_t chunk,
+                                             uint8_t *buf);
+#endif /* SST_CHUNKED_OBJECTS */
+
+#if defined(SST_CHUNKED_OBJECTS) && !defined(SST_STREAMED_OBJECTS)
+/**
+ * \brief Decrypts one chunk of the encrypted data held in the object
+ *        structure.
+ *
+ * \param[in]  obj    Pointer to the object structure
+ * \param[in]  chunk  Index of the chunk to decrypt
+ * \param[in]  len    Size of the chunk
+ * \param[out] buf    Pointer to the buffer to fill in with the chunk data, of
+ *                    SST_OBJECT_CHUNK_SIZE bytes
+ *
+ * Note: The storage key must have been set with sst_crypto_setkey().
+ *
+ * \return Returns error code specified in \ref psa_status_t
+ */
+psa_status_t sst_encrypted_object_decrypt_chunk(const struct sst_object_t *obj,
+                                                uint32_t chunk,
+                                                uint32_t len,
+                                                uint8_t *buf);
+
+/**
+ * \brief Encrypts one chunk of data into the object structure.
+ *
+ * \param[in,out] obj    Pointer to the object structure
+ * \param[in]     chunk  Index of the chunk to encrypt
+ * \param[in]     len    Size of the chunk
+ * \param[in]     buf    Pointer to the chunk data
+ *
+ * Note: The storage key must have been set with sst_crypto_setkey().
+ *
+ * \return Returns error code specified in \ref psa_status_t
+ */
+psa_status_t sst_encrypted_object_encrypt_chunk(struct sst_object_t *obj,
+                                                uint32_t chunk,
+                                                uint32_t len,
+                                                const uint8_t *buf);
+#endif /* SST_CHUNKED_OBJECTS && !SST_STREAMED_OBJECTS */
+
+#ifdef SST_STREAMED_OBJECTS
+/**
+ * \brief Encrypts one chunk of a streamed object and writes it to its own
+ *        chunk file.
+ *
+ * \param[in] fid    File ID of the object
+ * \param[in] gen    Generation of the chunk files of the object, which is
+ *                   then stored in the object header
+ * \param[in] chunk  Index of the chunk to write
+ * \param[in] len    Size of the chunk
+ * \param[in] buf    Pointer to the chunk data
+ *
+ * Note: The storage key must have been set with sst_crypto_setkey().
+ *
+ * \return Returns error code specified in \ref psa_status_t
+ */
+psa_status_t sst_encrypted_object_write_chunk(uint32_t fid,
+                                              const uint8_t *gen,
+                                              uint32_t chunk,
+                                              uint32_t len,
+                                              const uint8_t *buf);
+#endif /* SST_STREAMED_OBJECTS */
 
 /**
  * \brief Creates and writes a new encrypted object based on the given
@@ -38,6 +154,11 @@ psa_status_t sst_encrypted_object_read(uint32_t fid,
  *       into the flash to reduce the memory requirements and the number of
  *       internal copies. So, this object will contain the encrypted object
  *       stored in the flash.
+ *       With SST_CHUNKED_OBJECTS, the object data must already be encrypted
+ *       with sst_encrypted_object_encrypt_chunk(), and only the header is
+ *       authenticated. With SST_STREAMED_OBJECTS, only the header is written,
+ *       as the chunks are written to their own files with
+ *       sst_encrypted_object_write_chunk().
  *
  * \return Returns error code specified in \ref psa_status_t
  */
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include "sst_object_cache.h"
+
+#include <stddef.h>
+
+#include "tfm_memory_utils.h"
+#include "sst_utils.h"
+
+/*!
+ * \struct sst_object_cache_entry_t
+ *
+ * \brief Object cache entry, which holds the plain data of an object.
+ */
+struct sst_object_cache_entry_t {
+    psa_storage_uid_t uid; /*!< Object UID */
+    int32_t client_id;     /*!< Client ID */
+    uint32_t fid;          /*!< File ID of the object when it was cached */
+    uint32_t in_use;       /*!< Whether the entry holds an object */
+    uint32_t last_use;     /*!< Time of the last use of the entry */
+    uint32_t size;         /*!< Size of the object data */
+    uint8_t data[SST_OBJECT_CACHE_MAX_SIZE]; /*!< Object data */
+};
+
+/*!
+ * \struct sst_object_cache_t
+ *
+ * \brief Object cache structure.
+ */
+struct sst_object_cache_t {
+    uint32_t clock; /*!< Counter used to order the entries by their last use */
+    struct sst_object_cache_entry_t entry[SST_OBJECT_CACHE_ENTRIES]; /*!<
+                                                                      *  Cache
+                                                                      *  entries
+                                                                      */
+};
+
+/* Allocate the object cache in the SST partition RAM */
+static struct sst_object_cache_t sst_obj_cache;
+
+/**
+ * \brief Clears an object cache entry, so that the object data does not stay
+ *        in RAM.
+ *
+ * \param[out] entry  Entry to clear
+ */
+static void sst_object_cache_clear_entry(struct sst_object_cache_entry_t *entry)
+{
+    (void)tfm_memset(entry, SST_DEFAULT_EMPTY_BUFF_VAL,
+                     sizeof(struct sst_object_cache_entry_t));
+}
+
+/**
+ * \brief Gets the object cache entry of an object.
+ *
+ * \param[in] uid        Unique identifier for the data
+ * \param[in] client_id  Identifier of the asset's owner (client)
+ *
+ * \return Returns a pointer to the entry, or NULL if the object is not in the
+ *         cache
+ */
+static struct sst_object_cache_entry_t *sst_object_cache_find(
+                                                        psa_storage_uid_t uid,
+                                                        int32_t client_id)
+{
+    uint32_t idx;
+
+    for (idx = 0; idx < SST_OBJECT_CACHE_ENTRIES; idx++) {
+        if (sst_obj_cache.entry[idx].in_use &&
+            sst_obj_cache.entry[idx].uid == uid &&
+            sst_obj_cache.entry[idx].client_id == client_id) {
+            return &sst_obj_cache.entry[idx];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * \brief Marks an object cache entry as the most recently used one.
+ *
+ * \param[out] entry  Entry to mark
+ */
+static void sst_object_cache_touch(struct sst_object_cache_entry_t *entry)
+{
+    uint32_t idx;
+
+    sst_obj_cache.clock++;
+    if (sst_obj_cache.clock == 0) {
+        /* The clock wrapped, so restart the order of all the entries */
+        for (idx = 0; idx < SST_OBJECT_CACHE_ENTRIES; idx++) {
+            sst_obj_cache.entry[idx].last_use = 0;
+        }
+        sst_obj_cache.clock = 1;
+    }
+
+    entry->last_use = sst_obj_cache.clock;
+}
+
+const uint8_t *sst_object_cache_lookup(psa_storage_uid_t uid,
+                                       int32_t client_id, uint32_t fid,
+                                       uint32_t *size)
+{
+    struct sst_object_cache_entry_t *entry;
+
+    entry = sst_object_cache_find(uid, client_id);
+    if (entry == NULL) {
+        return NULL;
+    }
+
+    /* The object has been replaced in the object table since it was cached */
+    if (entry->fid != fid) {
+        sst_object_cache_clear_entry(entry);
+        return NULL;
+    }
+
+    sst_object_cache_touch(entry);
+    *size = entry->size;
+
+    return entry->data;
+}
+
+uint8_t *sst_object_cache_alloc(psa_storage_uid_t uid, int32_t client_id,
+                                uint32_t fid, uint32_t size)
+{
+    struct sst_object_cache_entry_t *entry;
+    uint32_t idx;
+
+    if (size > SST_OBJECT_CACHE_MAX_SIZE) {
+        return NULL;
+    }
+
+    entry = sst_object_cache_find(uid, client_id);
+    if (entry == NULL) {
+        /* Take a free entry, or else the least recently used one */
+        entry = &sst_obj_cache.entry[0];
+        for (idx = 0; idx < SST_OBJECT_CACHE_ENTRIES; idx++) {
+            if (!sst_obj_cache.entry[idx].in_use) {
+                entry = &sst_obj_cache.entry[idx];
+                break;
+            }
+
+            if (sst_obj_cache.entry[idx].last_use < entry->last_use) {
+                entry = &sst_obj_cache.entry[idx];
+            }
+        }
+    }
+
+    sst_object_cache_clear_entry(entry);
+
+    entry->uid = uid;
+    entry->client_id = client_id;
+    entry->fid = fid;
+    entry->size = size;
+    entry->in_use = 1;
+    sst_object_cache_touch(entry);
+
+    return entry->data;
+}
+
+void sst_object_cache_invalidate(psa_storage_uid_t uid, int32_t client_id)
+{
+    struct sst_object_cache_entry_t *entry;
+
+    entry = sst_object_cache_find(uid, client_id);
+    if (entry != NULL) {
+        sst_object_cache_clear_entry(entry);
+    }
+}
+
+void sst_object_cache_clear(void)
+{
+    (void)tfm_memset(&sst_obj_cache, SST_DEFAULT_EMPTY_BUFF_VAL,
+                     sizeof(sst_obj_cache));
+}
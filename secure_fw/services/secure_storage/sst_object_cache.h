@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __SST_OBJECT_CACHE_H__
+#define __SST_OBJECT_CACHE_H__
+
+#include <stdint.h>
+
+#include "psa/protected_storage.h"
+#include "sst_object_defs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * \def SST_OBJECT_CACHE_ENTRIES
+ *
+ * \brief Number of objects that the object cache holds.
+ */
+#ifndef SST_OBJECT_CACHE_ENTRIES
+#define SST_OBJECT_CACHE_ENTRIES 4
+#endif
+
+/*!
+ * \def SST_OBJECT_CACHE_MAX_SIZE
+ *
+ * \brief Maximum size of the data of an object held in the object cache.
+ *        Larger objects are always read from the storage.
+ */
+#ifndef SST_OBJECT_CACHE_MAX_SIZE
+#define SST_OBJECT_CACHE_MAX_SIZE 256
+#endif
+
+/**
+ * \brief Looks up the data of an object in the object cache.
+ *
+ * \param[in]  uid        Unique identifier for the data
+ * \param[in]  client_id  Identifier of the asset's owner (client)
+ * \param[in]  fid        File ID of the object in the object table
+ * \param[out] size       Pointer to the size of the object data
+ *
+ * \return Returns a pointer to the cached object data, or NULL if the object
+ *         is not in the cache
+ */
+const uint8_t *sst_object_cache_lookup(psa_storage_uid_t uid,
+                                       int32_t client_id, uint32_t fid,
+                                       uint32_t *size);
+
+/**
+ * \brief Allocates an object cache entry, evicting the least recently used
+ *        entry if the cache is full.
+ *
+ * \param[in] uid        Unique identifier for the data
+ * \param[in] client_id  Identifier of the asset's owner (client)
+ * \param[in] fid        File ID of the object in the object table
+ * \param[in] size       Size of the object data
+ *
+ * Note: The caller fills in the returned buffer with the authenticated object
+ *       data, or invalidates the entry with sst_object_cache_invalidate() if
+ *       it fails to do so.
+ *
+ * \return Returns a pointer to the buffer of the entry, or NULL if the object
+ *         is too large to be cached
+ */
+uint8_t *sst_object_cache_alloc(psa_storage_uid_t uid, int32_t client_id,
+                                uint32_t fid, uint32_t size);
+
+/**
+ * \brief Invalidates and clears the object cache entry of an object, if any.
+ *
+ * \param[in] uid        Unique identifier for the data
+ * \param[in] client_id  Identifier of the asset's owner (client)
+ */
+void sst_object_cache_invalidate(psa_storage_uid_t uid, int32_t client_id);
+
+/**
+ * \brief Invalidates and clears all the object cache entries.
+ */
+void sst_object_cache_clear(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SST_OBJECT_CACHE_H__ */
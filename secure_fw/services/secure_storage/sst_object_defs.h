@@ -28,6 +28,55 @@ struct sst_object_info_t {
     psa_storage_create_flags_t create_flags; /*!< Object creation flags */
 };
 
+#ifdef SST_CHUNKED_OBJECTS
+/*!
+ * \def SST_OBJECT_CHUNK_SIZE
+ *
+ * \brief Size of the chunks which the object data is split into. Each chunk
+ *        is encrypted and authenticated on its own.
+ */
+#ifndef SST_OBJECT_CHUNK_SIZE
+#define SST_OBJECT_CHUNK_SIZE 256
+#endif
+
+/* Number of chunks of the given object data size */
+#define SST_OBJECT_NUM_CHUNKS(size) \
+    (((size) + SST_OBJECT_CHUNK_SIZE - 1) / SST_OBJECT_CHUNK_SIZE)
+
+#ifdef SST_STREAMED_OBJECTS
+/*!
+ * \def SST_STREAMED_MAX_CHUNKS
+ *
+ * \brief Maximum number of chunk files of all the streamed objects. Each
+ *        chunk file takes an entry in the file system metadata, so the
+ *        default is kept small enough for the metadata to fit in one flash
+ *        block of the SST area.
+ */
+#ifndef SST_STREAMED_MAX_CHUNKS
+#define SST_STREAMED_MAX_CHUNKS (4 * SST_NUM_ASSETS)
+#endif
+
+/*!
+ * \def SST_MAX_STREAMED_ASSET_SIZE
+ *
+ * \brief Maximum size of a streamed object. By default, it is half of the
+ *        chunk files, so that the largest object can be updated while its old
+ *        chunk files are still stored.
+ */
+#ifndef SST_MAX_STREAMED_ASSET_SIZE
+#define SST_MAX_STREAMED_ASSET_SIZE \
+    ((SST_STREAMED_MAX_CHUNKS / 2) * SST_OBJECT_CHUNK_SIZE)
+#endif
+
+/* File ID of a chunk file of the object stored in the given file ID */
+#define SST_OBJECT_CHUNK_FID(fid, chunk) \
+    ((((psa_storage_uid_t)(chunk) + 1) << 32) | (fid))
+#else
+/* Maximum number of chunks of an object */
+#define SST_MAX_OBJECT_CHUNKS SST_OBJECT_NUM_CHUNKS(SST_MAX_ASSET_SIZE)
+#endif /* SST_STREAMED_OBJECTS */
+#endif /* SST_CHUNKED_OBJECTS */
+
 /*!
  * \struct sst_obj_header_t
  *
@@ -41,11 +90,30 @@ struct sst_obj_header_t {
     uint32_t fid;                  /*!< File ID */
 #endif
     struct sst_object_info_t info; /*!< Object information */
+#ifdef SST_STREAMED_OBJECTS
+    uint32_t fid;                  /*!< File ID */
+    uint8_t gen[SST_IV_LEN_BYTES]; /*!< Generation of the chunk files */
+#elif defined(SST_CHUNKED_OBJECTS)
+    uint32_t fid;                  /*!< File ID */
+    union sst_crypto_t chunk_crypto[SST_MAX_OBJECT_CHUNKS]; /*!< Crypto
+                                                             *   metadata of
+                                                             *   each chunk
+                                                             */
+#endif
 };
 
 
 #define SST_MAX_OBJECT_DATA_SIZE  SST_MAX_ASSET_SIZE
 
+/* Maximum size of the object content. Streamed objects are not held in the
+ * object data, so they are only limited by the chunk files.
+ */
+#ifdef SST_STREAMED_OBJECTS
+#define SST_MAX_OBJECT_CONTENT_SIZE SST_MAX_STREAMED_ASSET_SIZE
+#else
+#define SST_MAX_OBJECT_CONTENT_SIZE SST_MAX_ASSET_SIZE
+#endif
+
 /*!
  * \struct sst_object_t
  *
@@ -61,13 +129,68 @@ struct sst_object_t {
 #define SST_OBJECT_HEADER_SIZE    sizeof(struct sst_obj_header_t)
 #define SST_MAX_OBJECT_SIZE       sizeof(struct sst_object_t)
 
+#ifdef SST_TRANSACTIONS
+/*!
+ * \def SST_TRANSACTION_MAX_OBJECTS
+ *
+ * \brief Number of stored objects that a transaction can always update or
+ *        delete. The old file of each of them is kept until the transaction
+ *        is committed, so it takes a spare object table entry.
+ */
+#ifndef SST_TRANSACTION_MAX_OBJECTS
+#define SST_TRANSACTION_MAX_OBJECTS 4
+#endif
+
+/* Number of spare objects to store the updated objects */
+#define SST_NUM_SPARE_OBJECTS SST_TRANSACTION_MAX_OBJECTS
+#else
+#define SST_NUM_SPARE_OBJECTS 1
+#endif /* SST_TRANSACTIONS */
+
+#ifdef SST_OBJ_TABLE_SHARDS
+/*!
+ * \def SST_OBJ_TABLE_SHARD_ENTRIES
+ *
+ * \brief Number of object table entries held in each shard of the object
+ *        table. It can be set by the target in flash_layout.h.
+ */
+#ifndef SST_OBJ_TABLE_SHARD_ENTRIES
+#define SST_OBJ_TABLE_SHARD_ENTRIES 8
+#endif
+
+/*!
+ * \def SST_OBJ_TABLE_NUM_SHARDS
+ *
+ * \brief Number of shards which the object table entries are split into.
+ */
+#define SST_OBJ_TABLE_NUM_SHARDS \
+    ((SST_NUM_ASSETS + SST_NUM_SPARE_OBJECTS + \
+      SST_OBJ_TABLE_SHARD_ENTRIES - 1) / SST_OBJ_TABLE_SHARD_ENTRIES)
+#endif /* SST_OBJ_TABLE_SHARDS */
+
 /*!
  * \def SST_MAX_NUM_OBJECTS
  *
  * \brief Specifies the maximum number of objects in the system, which is the
- *        number of defined assets, the object table and 2 temporary objects to
- *        store the temporary object table and temporary updated object.
+ *        number of defined assets, the object table and a temporary object
+ *        table, the spare objects to store the updated objects, plus the
+ *        object table journal if it is enabled, plus the two copies of each
+ *        object table shard if they are enabled, plus the chunk files of the
+ *        streamed objects if they are enabled.
  */
-#define SST_MAX_NUM_OBJECTS (SST_NUM_ASSETS + 3)
+#ifdef SST_OBJ_TABLE_JOURNAL
+#define SST_NUM_OBJECT_FILES (SST_NUM_ASSETS + SST_NUM_SPARE_OBJECTS + 3)
+#elif defined(SST_OBJ_TABLE_SHARDS)
+#define SST_NUM_OBJECT_FILES (SST_NUM_ASSETS + SST_NUM_SPARE_OBJECTS + 2 + \
+                              (2 * SST_OBJ_TABLE_NUM_SHARDS))
+#else
+#define SST_NUM_OBJECT_FILES (SST_NUM_ASSETS + SST_NUM_SPARE_OBJECTS + 2)
+#endif
+
+#ifdef SST_STREAMED_OBJECTS
+#define SST_MAX_NUM_OBJECTS (SST_NUM_OBJECT_FILES + SST_STREAMED_MAX_CHUNKS)
+#else
+#define SST_MAX_NUM_OBJECTS SST_NUM_OBJECT_FILES
+#endif
 
 #endif /* __SST_OBJECT_DEFS_H__ */
@@ -15,6 +15,9 @@
 #ifdef SST_ENCRYPTION
 #include "sst_encrypted_object.h"
 #endif
+#ifdef SST_OBJECT_CACHE
+#include "sst_object_cache.h"
+#endif
 #include "sst_object_defs.h"
 #include "sst_object_table.h"
 #include "sst_utils.h"
@@ -30,6 +33,55 @@
 static struct sst_object_t g_sst_object;
 static struct sst_obj_table_info_t g_obj_tbl_info;
 
+#ifdef SST_CHUNKED_OBJECTS
+/* Allocate a static buffer to process the plain data of one object chunk */
+static uint8_t g_sst_chunk_buf[SST_OBJECT_CHUNK_SIZE];
+#endif
+
+#ifdef SST_TRANSACTIONS
+/* Maximum number of object files of each kind that a transaction tracks. It
+ * is the number of object table entries, as each file is referred to by one.
+ */
+#define SST_TXN_MAX_FILES (SST_NUM_ASSETS + SST_NUM_SPARE_OBJECTS)
+
+/*!
+ * \struct sst_txn_file_t
+ *
+ * \brief Object file tracked by a transaction.
+ */
+struct sst_txn_file_t {
+    uint32_t fid;  /*!< File ID of the object */
+#ifdef SST_STREAMED_OBJECTS
+    uint32_t size; /*!< Size of the object data held in the chunk files */
+#endif
+};
+
+/*!
+ * \struct sst_txn_t
+ *
+ * \brief Transaction structure.
+ */
+struct sst_txn_t {
+    uint32_t active;  /*!< Whether a transaction is open */
+    uint32_t num_new; /*!< Number of new files */
+    uint32_t num_old; /*!< Number of old files */
+    struct sst_txn_file_t new_file[SST_TXN_MAX_FILES]; /*!< Files written in
+                                                        *   the transaction,
+                                                        *   which are removed
+                                                        *   if it is aborted
+                                                        */
+    struct sst_txn_file_t old_file[SST_TXN_MAX_FILES]; /*!< Files replaced or
+                                                        *   deleted in the
+                                                        *   transaction, which
+                                                        *   are removed when
+                                                        *   it is committed
+                                                        */
+};
+
+/* Allocate a static variable to track the open transaction */
+static struct sst_txn_t g_sst_txn;
+#endif /* SST_TRANSACTIONS */
+
 /**
  * \brief Initialize g_sst_object based on the input parameters and empty data.
  *
@@ -57,27 +109,6 @@ __STATIC_INLINE void sst_init_empty_object(
     obj->header.info.create_flags = create_flags;
 }
 
-/**
- * \brief Removes the old object table and object from the file system.
- *
- * \param[in] old_fid  Old file ID to remove.
- *
- * \return Returns error code as specified in \ref psa_status_t
- */
-static psa_status_t sst_remove_old_data(uint32_t old_fid)
-{
-    psa_status_t err;
-
-    /* Delete old object table from the persistent area */
-    err = sst_object_table_delete_old_table();
-    if (err != PSA_SUCCESS) {
-        return err;
-    }
-
-    /* Delete old file from the persistent area */
-    return psa_its_remove(old_fid);
-}
-
 #ifndef SST_ENCRYPTION
 enum read_type_t {
     READ_HEADER_ONLY = 0,
@@ -154,10 +185,440 @@ static psa_status_t sst_write_object(uint32_t wrt_size)
 
 #endif /* !SST_ENCRYPTION */
 
+#ifdef SST_STREAMED_OBJECTS
+/**
+ * \brief Removes the chunk files of a streamed object. They are removed from
+ *        the last one, so that an interrupted removal only leaves the first
+ *        chunk files, which are removed when the file ID is used again.
+ *
+ * \param[in] fid   File ID of the object
+ * \param[in] size  Size of the object data held in the chunk files
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t sst_remove_object_chunks(uint32_t fid, uint32_t size)
+{
+    psa_status_t err;
+    uint32_t num_chunks = SST_OBJECT_NUM_CHUNKS(size);
+
+    while (num_chunks > 0) {
+        num_chunks--;
+
+        err = psa_its_remove(SST_OBJECT_CHUNK_FID(fid, num_chunks));
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+    }
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Writes the chunk files of a streamed object, whose header is in
+ *        g_sst_object, to the new file ID in g_obj_tbl_info. The chunks which
+ *        the asset data of the request overlaps are merged with it, and the
+ *        other chunks are copied from the old file ID. Only one chunk of the
+ *        object is held in memory at a time.
+ *
+ * \param[in] old_fid  Old file ID of the object
+ * \param[in] offset   Offset in the object data where the asset data starts.
+ *                     It must not be larger than the current object size.
+ * \param[in] size     Size of the asset data
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t sst_write_object_stream(uint32_t old_fid, uint32_t offset,
+                                            uint32_t size)
+{
+    psa_status_t err;
+    union sst_crypto_t gen;
+    uint32_t old_size = g_sst_object.header.info.current_size;
+    uint32_t end = offset + size;
+    uint32_t new_size = (end > old_size) ? end : old_size;
+    uint32_t chunk;
+    uint32_t chunk_start;
+    uint32_t chunk_end;
+    uint32_t old_chunk_end;
+    uint32_t wrt_start;
+    uint32_t wrt_end;
+
+    /* Get a new generation for the chunk files, so that the chunk files of an
+     * older object stored in the same file ID cannot be used instead.
+     */
+    sst_crypto_get_iv(&gen);
+
+    /* Remove the chunk files which an interrupted removal of an older object
+     * stored in the same file ID may have left.
+     */
+    chunk = SST_OBJECT_NUM_CHUNKS(new_size);
+    while (psa_its_remove(SST_OBJECT_CHUNK_FID(g_obj_tbl_info.fid, chunk)) ==
+           PSA_SUCCESS) {
+        chunk++;
+    }
+
+    err = sst_crypto_setkey();
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    for (chunk = 0; chunk * SST_OBJECT_CHUNK_SIZE < new_size; chunk++) {
+        chunk_start = chunk * SST_OBJECT_CHUNK_SIZE;
+        chunk_end = SST_UTILS_MIN(chunk_start + SST_OBJECT_CHUNK_SIZE,
+                                  new_size);
+        wrt_start = (offset > chunk_start) ? offset : chunk_start;
+        wrt_end = SST_UTILS_MIN(end, chunk_end);
+
+        /* Read the old chunk content if it is not fully overwritten */
+        if (chunk_start < old_size) {
+            old_chunk_end = SST_UTILS_MIN(chunk_start + SST_OBJECT_CHUNK_SIZE,
+                                          old_size);
+            if (wrt_start > chunk_start || wrt_end < old_chunk_end) {
+                err = sst_encrypted_object_read_chunk(old_fid, &g_sst_object,
+                                                      chunk, g_sst_chunk_buf);
+                if (err != PSA_SUCCESS) {
+                    break;
+                }
+            }
+        }
+
+        if (wrt_end > wrt_start) {
+            err = sst_req_mngr_read_asset_data(&g_sst_chunk_buf[wrt_start -
+                                                                chunk_start],
+                                               wrt_end - wrt_start);
+            if (err != PSA_SUCCESS) {
+                break;
+            }
+        }
+
+        err = sst_encrypted_object_write_chunk(g_obj_tbl_info.fid,
+                                               gen.ref.iv, chunk,
+                                               chunk_end - chunk_start,
+                                               g_sst_chunk_buf);
+        if (err != PSA_SUCCESS) {
+            /* Include the chunk file which may be partially written */
+            chunk++;
+            break;
+        }
+    }
+
+    /* Remove the plain data of the chunk before leaving the function */
+    (void)tfm_memset(g_sst_chunk_buf, SST_DEFAULT_EMPTY_BUFF_VAL,
+                     SST_OBJECT_CHUNK_SIZE);
+
+    if (err != PSA_SUCCESS) {
+        /* Remove the new chunk files written so far */
+        (void)sst_remove_object_chunks(g_obj_tbl_info.fid,
+                                       chunk * SST_OBJECT_CHUNK_SIZE);
+        (void)sst_crypto_destroykey();
+        return err;
+    }
+
+    /* The object header now refers to the new chunk files */
+    g_sst_object.header.info.current_size = new_size;
+    (void)tfm_memcpy(g_sst_object.header.gen, gen.ref.iv, SST_IV_LEN_BYTES);
+
+    return sst_crypto_destroykey();
+}
+#elif defined(SST_CHUNKED_OBJECTS)
+/**
+ * \brief Writes the asset data of the request into g_sst_object, whose data
+ *        holds the encrypted chunks of the object. Only the chunks which the
+ *        asset data overlaps are decrypted and encrypted again.
+ *
+ * \param[in] offset  Offset in the object data where the asset data starts.
+ *                    It must not be larger than the current object size.
+ * \param[in] size    Size of the asset data
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t sst_write_object_chunks(uint32_t offset, uint32_t size)
+{
+    psa_status_t err;
+    uint32_t old_size = g_sst_object.header.info.current_size;
+    uint32_t end = offset + size;
+    uint32_t chunk;
+    uint32_t chunk_start;
+    uint32_t chunk_end;
+    uint32_t old_chunk_end;
+    uint32_t wrt_start;
+    uint32_t wrt_end;
+
+    if (end > old_size) {
+        g_sst_object.header.info.current_size = end;
+    }
+
+    err = sst_crypto_setkey();
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    for (chunk = offset / SST_OBJECT_CHUNK_SIZE;
+         chunk * SST_OBJECT_CHUNK_SIZE < end; chunk++) {
+        chunk_start = chunk * SST_OBJECT_CHUNK_SIZE;
+        chunk_end = SST_UTILS_MIN(chunk_start + SST_OBJECT_CHUNK_SIZE,
+                                  g_sst_object.header.info.current_size);
+        wrt_start = (offset > chunk_start) ? offset : chunk_start;
+        wrt_end = SST_UTILS_MIN(end, chunk_end);
+
+        /* Decrypt the old chunk content if it is not fully overwritten */
+        if (chunk_start < old_size) {
+            old_chunk_end = SST_UTILS_MIN(chunk_start + SST_OBJECT_CHUNK_SIZE,
+                                          old_size);
+            if (wrt_start > chunk_start || wrt_end < old_chunk_end) {
+                err = sst_encrypted_object_decrypt_chunk(&g_sst_object, chunk,
+                                                  old_chunk_end - chunk_start,
+                                                  g_sst_chunk_buf);
+                if (err != PSA_SUCCESS) {
+                    goto release_key_and_return;
+                }
+            }
+        }
+
+        err = sst_req_mngr_read_asset_data(&g_sst_chunk_buf[wrt_start -
+                                                            chunk_start],
+                                           wrt_end - wrt_start);
+        if (err != PSA_SUCCESS) {
+            goto release_key_and_return;
+        }
+
+        err = sst_encrypted_object_encrypt_chunk(&g_sst_object, chunk,
+                                                 chunk_end - chunk_start,
+                                                 g_sst_chunk_buf);
+        if (err != PSA_SUCCESS) {
+            goto release_key_and_return;
+        }
+    }
+
+release_key_and_return:
+    /* Remove the plain data of the chunk before leaving the function */
+    (void)tfm_memset(g_sst_chunk_buf, SST_DEFAULT_EMPTY_BUFF_VAL,
+                     SST_OBJECT_CHUNK_SIZE);
+
+    if (err != PSA_SUCCESS) {
+        (void)sst_crypto_destroykey();
+        return err;
+    }
+
+    return sst_crypto_destroykey();
+}
+#endif /* SST_STREAMED_OBJECTS */
+
+#ifdef SST_CHUNKED_OBJECTS
+/**
+ * \brief Reads part of the data of an object, whose header is in g_sst_object,
+ *        and writes it to the request, or to the given buffer. Only the
+ *        chunks which hold the data are read and decrypted.
+ *
+ * \param[in]  offset  Offset in the object data where the read starts
+ * \param[in]  size    Size of the data to read, which must be contained in
+ *                     the current object size
+ * \param[out] buf     Buffer to write the data to, or NULL to write it to the
+ *                     request
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t sst_read_object_chunks(uint32_t offset, uint32_t size,
+                                           uint8_t *buf)
+{
+    psa_status_t err = PSA_SUCCESS;
+    uint32_t end = offset + size;
+    uint32_t chunk;
+    uint32_t chunk_start;
+    uint32_t rd_start;
+    uint32_t rd_end;
+
+    if (size == 0) {
+        return PSA_SUCCESS;
+    }
+
+    err = sst_crypto_setkey();
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    for (chunk = offset / SST_OBJECT_CHUNK_SIZE;
+         chunk * SST_OBJECT_CHUNK_SIZE < end; chunk++) {
+        chunk_start = chunk * SST_OBJECT_CHUNK_SIZE;
+        rd_start = (offset > chunk_start) ? offset : chunk_start;
+        rd_end = SST_UTILS_MIN(end, chunk_start + SST_OBJECT_CHUNK_SIZE);
+
+        /* The object data buffer is not used, so decrypt the chunk in it */
+        err = sst_encrypted_object_read_chunk(g_obj_tbl_info.fid,
+                                              &g_sst_object, chunk,
+                                              g_sst_object.data);
+        if (err != PSA_SUCCESS) {
+            (void)sst_crypto_destroykey();
+            return err;
+        }
+
+        if (buf != NULL) {
+            (void)tfm_memcpy(buf + (rd_start - offset),
+                             g_sst_object.data + (rd_start - chunk_start),
+                             rd_end - rd_start);
+        } else {
+            sst_req_mngr_write_asset_data(
+                                   g_sst_object.data + (rd_start - chunk_start),
+                                   rd_end - rd_start);
+        }
+    }
+
+    return sst_crypto_destroykey();
+}
+#endif /* SST_CHUNKED_OBJECTS */
+
+/**
+ * \brief Removes the file of an object from the file system.
+ *
+ * \param[in] fid   File ID to remove
+ * \param[in] size  Size of the object data
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t sst_remove_object_file(uint32_t fid, uint32_t size)
+{
+    psa_status_t err;
+
+    err = psa_its_remove(fid);
+#ifdef SST_STREAMED_OBJECTS
+    if (err == PSA_SUCCESS) {
+        err = sst_remove_object_chunks(fid, size);
+    }
+#else
+    (void)size;
+#endif
+
+    return err;
+}
+
+#ifdef SST_TRANSACTIONS
+/**
+ * \brief Tracks the file of an object written in the open transaction.
+ *
+ * \param[in] fid   File ID of the object
+ * \param[in] size  Size of the object data
+ */
+static void sst_txn_add_new_file(uint32_t fid, uint32_t size)
+{
+    struct sst_txn_file_t *file = &g_sst_txn.new_file[g_sst_txn.num_new];
+
+    file->fid = fid;
+#ifdef SST_STREAMED_OBJECTS
+    file->size = size;
+#else
+    (void)size;
+#endif
+    g_sst_txn.num_new++;
+}
+
+/**
+ * \brief Releases the file of an object replaced or deleted in the open
+ *        transaction. A file written in the transaction is not referred to by
+ *        the persistent object table, so it can be removed straight away.
+ *        Otherwise, the file is tracked to be removed on commit.
+ *
+ * \param[in] fid   File ID of the object
+ * \param[in] size  Size of the object data
+ *
+ * \return Returns 1 if the file must be removed straight away, 0 otherwise
+ */
+static uint32_t sst_txn_release_file(uint32_t fid, uint32_t size)
+{
+    struct sst_txn_file_t *file;
+    uint32_t i;
+
+    for (i = 0; i < g_sst_txn.num_new; i++) {
+        if (g_sst_txn.new_file[i].fid == fid) {
+            g_sst_txn.num_new--;
+            g_sst_txn.new_file[i] = g_sst_txn.new_file[g_sst_txn.num_new];
+            return 1;
+        }
+    }
+
+    file = &g_sst_txn.old_file[g_sst_txn.num_old];
+    file->fid = fid;
+#ifdef SST_STREAMED_OBJECTS
+    file->size = size;
+#else
+    (void)size;
+#endif
+    g_sst_txn.num_old++;
+
+    return 0;
+}
+
+/**
+ * \brief Removes the tracked files of a transaction. All of them are removed,
+ *        even if the removal of one fails, as a file left behind is removed
+ *        when its file ID is used again.
+ *
+ * \param[in] files      Tracked files
+ * \param[in] num_files  Number of tracked files
+ *
+ * \return Returns the first error as specified in \ref psa_status_t
+ */
+static psa_status_t sst_txn_remove_files(const struct sst_txn_file_t *files,
+                                         uint32_t num_files)
+{
+    psa_status_t err = PSA_SUCCESS;
+    psa_status_t file_err;
+    uint32_t size = 0;
+    uint32_t i;
+
+    for (i = 0; i < num_files; i++) {
+#ifdef SST_STREAMED_OBJECTS
+        size = files[i].size;
+#endif
+        file_err = sst_remove_object_file(files[i].fid, size);
+        if (err == PSA_SUCCESS) {
+            err = file_err;
+        }
+    }
+
+    return err;
+}
+#endif /* SST_TRANSACTIONS */
+
+/**
+ * \brief Removes the old object table and object from the file system.
+ *
+ * \param[in] old_fid   Old file ID to remove, or SST_INVALID_FID if there is
+ *                      no old object
+ * \param[in] old_size  Size of the old object data
+ *
+ * \note In a transaction, an old object which the persistent object table
+ *       refers to is only removed when the transaction is committed.
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t sst_remove_old_data(uint32_t old_fid, uint32_t old_size)
+{
+    psa_status_t err;
+
+    /* Delete old object table from the persistent area */
+    err = sst_object_table_delete_old_table();
+    if (err != PSA_SUCCESS || old_fid == SST_INVALID_FID) {
+        return err;
+    }
+
+#ifdef SST_TRANSACTIONS
+    if (g_sst_txn.active && !sst_txn_release_file(old_fid, old_size)) {
+        return PSA_SUCCESS;
+    }
+#endif
+
+    /* Delete old file from the persistent area */
+    return sst_remove_object_file(old_fid, old_size);
+}
+
 psa_status_t sst_system_prepare(void)
 {
     psa_status_t err;
 
+#ifdef SST_OBJECT_CACHE
+    /* The object table is loaded again, so drop the cached objects */
+    sst_object_cache_clear();
+#endif
+
     /* Reuse the allocated g_sst_object.data to store a temporary object table
      * data to be validate inside the function.
      * The stored date will be cleaned up when the g_sst_object.data will
@@ -177,6 +638,11 @@ psa_status_t sst_object_read(psa_storage_uid_t uid, int32_t client_id,
                              size_t *p_data_length)
 {
     psa_status_t err;
+#ifdef SST_OBJECT_CACHE
+    const uint8_t *cached_data;
+    uint32_t cached_size;
+    uint8_t *cache_buf;
+#endif
 
     /* Retrieve the object information from the object table if the object
      * exists.
@@ -186,8 +652,30 @@ psa_status_t sst_object_read(psa_storage_uid_t uid, int32_t client_id,
         return err;
     }
 
+#ifdef SST_OBJECT_CACHE
+    /* If the object is in the object cache, copy the cached data to the output
+     * buffer without reading the object again.
+     */
+    cached_data = sst_object_cache_lookup(uid, client_id, g_obj_tbl_info.fid,
+                                          &cached_size);
+    if (cached_data != NULL) {
+        if (offset > cached_size) {
+            return PSA_ERROR_INVALID_ARGUMENT;
+        }
+
+        size = SST_UTILS_MIN(size, cached_size - offset);
+        sst_req_mngr_write_asset_data(cached_data + offset, size);
+        *p_data_length = size;
+
+        return PSA_SUCCESS;
+    }
+#endif
+
     /* Read object */
-#ifdef SST_ENCRYPTION
+#ifdef SST_CHUNKED_OBJECTS
+    /* Read the object header only, the data is read chunk by chunk */
+    err = sst_encrypted_object_read_header(g_obj_tbl_info.fid, &g_sst_object);
+#elif defined(SST_ENCRYPTION)
     err = sst_encrypted_object_read(g_obj_tbl_info.fid, &g_sst_object);
 #else
     /* Read object header */
@@ -206,8 +694,41 @@ psa_status_t sst_object_read(psa_storage_uid_t uid, int32_t client_id,
     size = SST_UTILS_MIN(size,
                          g_sst_object.header.info.current_size - offset);
 
+#ifdef SST_OBJECT_CACHE
+    /* Keep the authenticated object data in the object cache, if it fits, and
+     * copy it from there to the output buffer.
+     */
+    cache_buf = sst_object_cache_alloc(uid, client_id, g_obj_tbl_info.fid,
+                                       g_sst_object.header.info.current_size);
+    if (cache_buf != NULL) {
+#ifdef SST_CHUNKED_OBJECTS
+        err = sst_read_object_chunks(0, g_sst_object.header.info.current_size,
+                                     cache_buf);
+        if (err != PSA_SUCCESS) {
+            sst_object_cache_invalidate(uid, client_id);
+            goto clear_data_and_return;
+        }
+#else
+        (void)tfm_memcpy(cache_buf, g_sst_object.data,
+                         g_sst_object.header.info.current_size);
+#endif
+        sst_req_mngr_write_asset_data(cache_buf + offset, size);
+        *p_data_length = size;
+
+        goto clear_data_and_return;
+    }
+#endif
+
+#ifdef SST_CHUNKED_OBJECTS
+    /* Decrypt the chunks which hold the data into the output buffer */
+    err = sst_read_object_chunks(offset, size, NULL);
+    if (err != PSA_SUCCESS) {
+        goto clear_data_and_return;
+    }
+#else
     /* Copy the decrypted object data to the output buffer */
     sst_req_mngr_write_asset_data(g_sst_object.data + offset, size);
+#endif
 
     *p_data_length = size;
 
@@ -225,6 +746,7 @@ psa_status_t sst_object_create(psa_storage_uid_t uid, int32_t client_id,
 {
     psa_status_t err;
     uint32_t old_fid = SST_INVALID_FID;
+    uint32_t old_size = 0;
     uint32_t fid_am_reserved = 1;
 
 #ifndef SST_ENCRYPTION
@@ -232,18 +754,24 @@ psa_status_t sst_object_create(psa_storage_uid_t uid, int32_t client_id,
 #endif
 
     /* Boundary check the incoming request */
-    if (size > SST_MAX_ASSET_SIZE) {
+    if (size > SST_MAX_OBJECT_CONTENT_SIZE) {
         return PSA_ERROR_INVALID_ARGUMENT;
     }
 
+#ifdef SST_OBJECT_CACHE
+    /* The cached object data, if any, is about to become stale */
+    sst_object_cache_invalidate(uid, client_id);
+#endif
+
     /* Retrieve the object information from the object table if the object
      * exists.
      */
     err = sst_object_table_get_obj_tbl_info(uid, client_id, &g_obj_tbl_info);
     if (err == PSA_SUCCESS) {
 #ifdef SST_ENCRYPTION
-        /* Read the object */
-        err = sst_encrypted_object_read(g_obj_tbl_info.fid, &g_sst_object);
+        /* Read the object header */
+        err = sst_encrypted_object_read_header(g_obj_tbl_info.fid,
+                                               &g_sst_object);
 #else
         /* Read the object header */
         err = sst_read_object(READ_HEADER_ONLY);
@@ -265,8 +793,9 @@ psa_status_t sst_object_create(psa_storage_uid_t uid, int32_t client_id,
         g_sst_object.header.info.create_flags = create_flags;
         g_sst_object.header.info.max_size = size;
 
-        /* Save old file ID */
+        /* Save old file ID and size */
         old_fid = g_obj_tbl_info.fid;
+        old_size = g_sst_object.header.info.current_size;
     } else if (err == PSA_ERROR_DOES_NOT_EXIST) {
         /* If the object does not exist, then initialize it based on the input
          * arguments and empty content. Requests 2 FIDs to prevent exhaustion.
@@ -277,6 +806,33 @@ psa_status_t sst_object_create(psa_storage_uid_t uid, int32_t client_id,
         goto clear_data_and_return;
     }
 
+#ifdef SST_STREAMED_OBJECTS
+    /* Get new file ID */
+    err = sst_object_table_get_free_fid(fid_am_reserved,
+                                        &g_obj_tbl_info.fid);
+    if (err != PSA_SUCCESS) {
+        goto clear_data_and_return;
+    }
+
+    /* Write the chunk files of the new file ID, from empty content */
+    g_sst_object.header.info.current_size = 0;
+
+    err = sst_write_object_stream(old_fid, 0, size);
+    if (err != PSA_SUCCESS) {
+        goto clear_data_and_return;
+    }
+#elif defined(SST_CHUNKED_OBJECTS)
+    /* Encrypt the object data chunk by chunk, from empty content */
+    g_sst_object.header.info.current_size = 0;
+    (void)tfm_memset(g_sst_object.header.chunk_crypto,
+                     SST_DEFAULT_EMPTY_BUFF_VAL,
+                     sizeof(g_sst_object.header.chunk_crypto));
+
+    err = sst_write_object_chunks(0, size);
+    if (err != PSA_SUCCESS) {
+        goto clear_data_and_return;
+    }
+#else
     /* Update the object data */
     err = sst_req_mngr_read_asset_data(g_sst_object.data, size);
     if (err != PSA_SUCCESS) {
@@ -285,13 +841,16 @@ psa_status_t sst_object_create(psa_storage_uid_t uid, int32_t client_id,
 
     /* Update the current object size */
     g_sst_object.header.info.current_size = size;
+#endif
 
+#ifndef SST_STREAMED_OBJECTS
     /* Get new file ID */
     err = sst_object_table_get_free_fid(fid_am_reserved,
                                         &g_obj_tbl_info.fid);
     if (err != PSA_SUCCESS) {
         goto clear_data_and_return;
     }
+#endif
 
 #ifdef SST_ENCRYPTION
     err = sst_encrypted_object_write(g_obj_tbl_info.fid, &g_sst_object);
@@ -302,6 +861,10 @@ psa_status_t sst_object_create(psa_storage_uid_t uid, int32_t client_id,
     err = sst_write_object(wrt_size);
 #endif
     if (err != PSA_SUCCESS) {
+#ifdef SST_STREAMED_OBJECTS
+        (void)sst_remove_object_chunks(g_obj_tbl_info.fid,
+                                       g_sst_object.header.info.current_size);
+#endif
         goto clear_data_and_return;
     }
 
@@ -314,17 +877,23 @@ psa_status_t sst_object_create(psa_storage_uid_t uid, int32_t client_id,
          * object table manipulation error.
          */
         (void)psa_its_remove(g_obj_tbl_info.fid);
+#ifdef SST_STREAMED_OBJECTS
+        (void)sst_remove_object_chunks(g_obj_tbl_info.fid,
+                                       g_sst_object.header.info.current_size);
+#endif
 
         goto clear_data_and_return;
     }
 
-    if (old_fid == SST_INVALID_FID) {
-        /* Delete old object table from the persistent area */
-        err = sst_object_table_delete_old_table();
-    } else {
-        /* Remove old object and delete old object table */
-        err = sst_remove_old_data(old_fid);
+#ifdef SST_TRANSACTIONS
+    if (g_sst_txn.active) {
+        sst_txn_add_new_file(g_obj_tbl_info.fid,
+                             g_sst_object.header.info.current_size);
     }
+#endif
+
+    /* Remove old object, if any, and delete old object table */
+    err = sst_remove_old_data(old_fid, old_size);
 
 clear_data_and_return:
     /* Remove data stored in the object before leaving the function */
@@ -339,11 +908,17 @@ psa_status_t sst_object_write(psa_storage_uid_t uid, int32_t client_id,
 {
     psa_status_t err;
     uint32_t old_fid;
+    uint32_t old_size;
 
 #ifndef SST_ENCRYPTION
     uint32_t wrt_size;
 #endif
 
+#ifdef SST_OBJECT_CACHE
+    /* The cached object data, if any, is about to become stale */
+    sst_object_cache_invalidate(uid, client_id);
+#endif
+
     /* Retrieve the object information from the object table if the object
      * exists.
      */
@@ -353,7 +928,10 @@ psa_status_t sst_object_write(psa_storage_uid_t uid, int32_t client_id,
     }
 
     /* Read the object */
-#ifdef SST_ENCRYPTION
+#ifdef SST_CHUNKED_OBJECTS
+    /* Read the object header only, the data is checked chunk by chunk */
+    err = sst_encrypted_object_read_header(g_obj_tbl_info.fid, &g_sst_object);
+#elif defined(SST_ENCRYPTION)
     err = sst_encrypted_object_read(g_obj_tbl_info.fid, &g_sst_object);
 #else
     err = sst_read_object(READ_ALL_OBJECT);
@@ -383,6 +961,36 @@ psa_status_t sst_object_write(psa_storage_uid_t uid, int32_t client_id,
         goto clear_data_and_return;
     }
 
+#ifdef SST_STREAMED_OBJECTS
+    /* Save old file ID and size */
+    old_fid = g_obj_tbl_info.fid;
+    old_size = g_sst_object.header.info.current_size;
+
+    /* Get new file ID */
+    err = sst_object_table_get_free_fid(1, &g_obj_tbl_info.fid);
+    if (err != PSA_SUCCESS) {
+        goto clear_data_and_return;
+    }
+
+    /* Copy the chunk files to the new file ID, merged with the new data */
+    err = sst_write_object_stream(old_fid, offset, size);
+    if (err != PSA_SUCCESS) {
+        goto clear_data_and_return;
+    }
+#elif defined(SST_CHUNKED_OBJECTS)
+    /* Read the encrypted object data and update the chunks which the new
+     * data overlaps.
+     */
+    err = sst_encrypted_object_read_data(g_obj_tbl_info.fid, &g_sst_object);
+    if (err != PSA_SUCCESS) {
+        goto clear_data_and_return;
+    }
+
+    err = sst_write_object_chunks(offset, size);
+    if (err != PSA_SUCCESS) {
+        goto clear_data_and_return;
+    }
+#else
     /* Update the object data */
     err = sst_req_mngr_read_asset_data(g_sst_object.data + offset, size);
     if (err != PSA_SUCCESS) {
@@ -393,15 +1001,19 @@ psa_status_t sst_object_write(psa_storage_uid_t uid, int32_t client_id,
     if ((offset + size) > g_sst_object.header.info.current_size) {
         g_sst_object.header.info.current_size = offset + size;
     }
+#endif
 
-    /* Save old file ID */
+#ifndef SST_STREAMED_OBJECTS
+    /* Save old file ID and size */
     old_fid = g_obj_tbl_info.fid;
+    old_size = g_sst_object.header.info.current_size;
 
     /* Get new file ID */
     err = sst_object_table_get_free_fid(1, &g_obj_tbl_info.fid);
     if (err != PSA_SUCCESS) {
         goto clear_data_and_return;
     }
+#endif
 
 #ifdef SST_ENCRYPTION
     err = sst_encrypted_object_write(g_obj_tbl_info.fid, &g_sst_object);
@@ -412,6 +1024,10 @@ psa_status_t sst_object_write(psa_storage_uid_t uid, int32_t client_id,
     err = sst_write_object(wrt_size);
 #endif
     if (err != PSA_SUCCESS) {
+#ifdef SST_STREAMED_OBJECTS
+        (void)sst_remove_object_chunks(g_obj_tbl_info.fid,
+                                       g_sst_object.header.info.current_size);
+#endif
         goto clear_data_and_return;
     }
 
@@ -424,12 +1040,23 @@ psa_status_t sst_object_write(psa_storage_uid_t uid, int32_t client_id,
          * object table manipulation error.
          */
         (void)psa_its_remove(g_obj_tbl_info.fid);
+#ifdef SST_STREAMED_OBJECTS
+        (void)sst_remove_object_chunks(g_obj_tbl_info.fid,
+                                       g_sst_object.header.info.current_size);
+#endif
 
         goto clear_data_and_return;
     }
 
+#ifdef SST_TRANSACTIONS
+    if (g_sst_txn.active) {
+        sst_txn_add_new_file(g_obj_tbl_info.fid,
+                             g_sst_object.header.info.current_size);
+    }
+#endif
+
     /* Remove old object table and object */
-    err = sst_remove_old_data(old_fid);
+    err = sst_remove_old_data(old_fid, old_size);
 
 clear_data_and_return:
     /* Remove data stored in the object before leaving the function */
@@ -453,7 +1080,7 @@ psa_status_t sst_object_get_info(psa_storage_uid_t uid, int32_t client_id,
     }
 
 #ifdef SST_ENCRYPTION
-    err = sst_encrypted_object_read(g_obj_tbl_info.fid, &g_sst_object);
+    err = sst_encrypted_object_read_header(g_obj_tbl_info.fid, &g_sst_object);
 #else
     err = sst_read_object(READ_HEADER_ONLY);
 #endif
@@ -473,10 +1100,35 @@ clear_data_and_return:
     return err;
 }
 
+void sst_object_list(int32_t client_id, uint32_t *cursor, size_t max_uids,
+                     size_t *uid_count)
+{
+    psa_storage_uid_t uid;
+    size_t count = 0;
+
+    while (*cursor != TFM_STORAGE_LIST_END && count < max_uids) {
+        if (sst_object_table_get_next_uid(client_id, cursor, &uid)
+            != PSA_SUCCESS) {
+            *cursor = TFM_STORAGE_LIST_END;
+            break;
+        }
+
+        sst_req_mngr_write_asset_data((const uint8_t *)&uid, sizeof(uid));
+        count++;
+    }
+
+    *uid_count = count;
+}
+
 psa_status_t sst_object_delete(psa_storage_uid_t uid, int32_t client_id)
 {
     psa_status_t err;
 
+#ifdef SST_OBJECT_CACHE
+    /* The cached object data, if any, is about to become stale */
+    sst_object_cache_invalidate(uid, client_id);
+#endif
+
     /* Retrieve the object information from the object table if the object
      * exists.
      */
@@ -486,7 +1138,7 @@ psa_status_t sst_object_delete(psa_storage_uid_t uid, int32_t client_id)
     }
 
 #ifdef SST_ENCRYPTION
-    err = sst_encrypted_object_read(g_obj_tbl_info.fid, &g_sst_object);
+    err = sst_encrypted_object_read_header(g_obj_tbl_info.fid, &g_sst_object);
 #else
     err = sst_read_object(READ_HEADER_ONLY);
 #endif
@@ -509,7 +1161,8 @@ psa_status_t sst_object_delete(psa_storage_uid_t uid, int32_t client_id)
     }
 
     /* Remove old object table and file */
-    err = sst_remove_old_data(g_obj_tbl_info.fid);
+    err = sst_remove_old_data(g_obj_tbl_info.fid,
+                              g_sst_object.header.info.current_size);
 
 clear_data_and_return:
     /* Remove data stored in the object before leaving the function */
@@ -528,5 +1181,76 @@ psa_status_t sst_system_wipe_all(void)
      * this function doesn't block on the lock and directly
      * moves to erasing the flash instead.
      */
+#ifdef SST_TRANSACTIONS
+    /* The open transaction, if any, is dropped with the objects */
+    g_sst_txn.active = 0;
+#endif
+
+#ifdef SST_OBJECT_CACHE
+    sst_object_cache_clear();
+#endif
+
     return sst_object_table_create();
 }
+
+#ifdef SST_TRANSACTIONS
+psa_status_t sst_system_begin_transaction(void)
+{
+    if (g_sst_txn.active) {
+        return PSA_ERROR_BAD_STATE;
+    }
+
+    sst_object_table_begin_transaction();
+
+    g_sst_txn.num_new = 0;
+    g_sst_txn.num_old = 0;
+    g_sst_txn.active = 1;
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t sst_system_commit_transaction(void)
+{
+    psa_status_t err;
+
+    if (!g_sst_txn.active) {
+        return PSA_ERROR_BAD_STATE;
+    }
+
+    g_sst_txn.active = 0;
+
+    /* Update the persistent object table once for all the objects */
+    err = sst_object_table_commit_transaction();
+    if (err != PSA_SUCCESS) {
+#ifdef SST_OBJECT_CACHE
+        /* The objects read in the transaction may have been rolled back */
+        sst_object_cache_clear();
+#endif
+        /* The transaction has been aborted, so remove the new objects */
+        (void)sst_txn_remove_files(g_sst_txn.new_file, g_sst_txn.num_new);
+        return err;
+    }
+
+    /* Remove the old objects, which are not referred to anymore */
+    return sst_txn_remove_files(g_sst_txn.old_file, g_sst_txn.num_old);
+}
+
+psa_status_t sst_system_abort_transaction(void)
+{
+    if (!g_sst_txn.active) {
+        return PSA_ERROR_BAD_STATE;
+    }
+
+    g_sst_txn.active = 0;
+
+#ifdef SST_OBJECT_CACHE
+    /* The objects read in the transaction may be rolled back */
+    sst_object_cache_clear();
+#endif
+
+    /* Restore the persistent object table and remove the new objects */
+    sst_object_table_abort_transaction();
+
+    return sst_txn_remove_files(g_sst_txn.new_file, g_sst_txn.num_new);
+}
+#endif /* SST_TRANSACTIONS */
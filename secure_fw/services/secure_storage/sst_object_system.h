@@ -92,6 +92,21 @@ psa_status_t sst_object_delete(psa_storage_uid_t uid, int32_t client_id);
 psa_status_t sst_object_get_info(psa_storage_uid_t uid, int32_t client_id,
                                  struct psa_storage_info_t *info);
 
+/**
+ * \brief Lists the UIDs of the objects of a client, starting from a cursor,
+ *        and writes them to the caller. They are read from the object table
+ *        in RAM, so no object is read from the storage.
+ *
+ * \param[in]     client_id  Identifier of the objects' owner (client)
+ * \param[in,out] cursor     TFM_STORAGE_LIST_START, or the cursor returned by
+ *                           the previous call. Set to TFM_STORAGE_LIST_END
+ *                           once all the UIDs are listed.
+ * \param[in]     max_uids   Largest number of UIDs to list
+ * \param[out]    uid_count  Number of UIDs listed
+ */
+void sst_object_list(int32_t client_id, uint32_t *cursor, size_t max_uids,
+                     size_t *uid_count);
+
 /**
  * \brief Wipes the secure storage system and all object data.
  *
@@ -99,6 +114,34 @@ psa_status_t sst_object_get_info(psa_storage_uid_t uid, int32_t client_id,
  */
 psa_status_t sst_system_wipe_all(void);
 
+#ifdef SST_TRANSACTIONS
+/**
+ * \brief Opens a transaction. The objects created, written or deleted until
+ *        the transaction is committed are made persistent together, with one
+ *        update of the object table.
+ *
+ * \return Returns PSA_ERROR_BAD_STATE if a transaction is already open.
+ *         Otherwise, it returns PSA_SUCCESS.
+ */
+psa_status_t sst_system_begin_transaction(void);
+
+/**
+ * \brief Commits the open transaction, making all its changes persistent.
+ *
+ * \note If the changes cannot be made persistent, none of them is.
+ *
+ * \return Returns error code specified in \ref psa_status_t
+ */
+psa_status_t sst_system_commit_transaction(void);
+
+/**
+ * \brief Aborts the open transaction, discarding all its changes.
+ *
+ * \return Returns error code specified in \ref psa_status_t
+ */
+psa_status_t sst_system_abort_transaction(void);
+#endif /* SST_TRANSACTIONS */
+
 #ifdef __cplusplus
 }
 #endif
@@ -15,8 +15,12 @@
 #include "nv_counters/sst_nv_counters.h"
 #include "psa/internal_trusted_storage.h"
 #include "tfm_memory_utils.h"
+#include "sst_object_defs.h"
 #include "sst_utils.h"
 #include "tfm_sst_defs.h"
+#ifdef TFM_RESOURCE_USAGE
+#include "secure_fw/include/tfm_spm_services_api.h"
+#endif
 
 /* FIXME: Duplicated from flash info */
 #define SST_FLASH_DEFAULT_VAL 0xFFU
@@ -28,6 +32,23 @@
  */
 #define SST_OBJECT_SYSTEM_VERSION  0x01
 
+#ifdef SST_NV_COUNTER_EPOCHS
+/*!
+ * \def SST_NV_COUNTER_EPOCH_COMMITS
+ *
+ * \brief Maximum number of object table saves in one NV counter epoch. The
+ *        NV counters are only increased by the first save of an epoch, and
+ *        each boot starts a new epoch.
+ */
+#ifndef SST_NV_COUNTER_EPOCH_COMMITS
+#define SST_NV_COUNTER_EPOCH_COMMITS 16
+#endif
+#endif /* SST_NV_COUNTER_EPOCHS */
+
+#if defined(SST_OBJ_TABLE_SHARDS) && defined(SST_OBJ_TABLE_JOURNAL)
+#error "SST_OBJ_TABLE_SHARDS and SST_OBJ_TABLE_JOURNAL cannot be enabled together"
+#endif
+
 /*!
  * \struct sst_obj_table_info_t
  *
@@ -44,10 +65,24 @@ struct sst_obj_table_entry_t {
 };
 
 /* Specifies number of entries in the table. The number of entries is the
- * number of assets, defined in asset_defs.h, plus one extra entry to store
+ * number of assets, defined in asset_defs.h, plus the spare entries to store
  * a new object when the code processes a change in a file.
  */
-#define SST_OBJ_TABLE_ENTRIES (SST_NUM_ASSETS + 1)
+#define SST_OBJ_TABLE_ENTRIES (SST_NUM_ASSETS + SST_NUM_SPARE_OBJECTS)
+
+#ifdef SST_OBJ_TABLE_SHARDS
+/*!
+ * \struct sst_obj_table_shard_ref_t
+ *
+ * \brief Reference to an object table shard, held in the object table.
+ */
+struct sst_obj_table_shard_ref_t {
+#ifdef SST_ENCRYPTION
+    uint8_t tag[SST_TAG_LEN_BYTES]; /*!< MAC value of the shard */
+#endif
+    uint32_t copy;                  /*!< File copy holding the shard, 0 or 1 */
+};
+#endif /* SST_OBJ_TABLE_SHARDS */
 
 /*!
  * \struct sst_obj_table_t
@@ -65,8 +100,21 @@ struct sst_obj_table_t {
   uint8_t swap_count;            /*!< Swap counter to distinguish 2 different
                                   *   object tables.
                                   */
+#elif defined(SST_NV_COUNTER_EPOCHS)
+  uint32_t epoch_seq;            /*!< Sequence number of the table save in
+                                  *   the NV counter epoch, to distinguish 2
+                                  *   object tables of the same epoch.
+                                  */
 #endif /* SST_ROLLBACK_PROTECTION */
 
+#ifdef SST_OBJ_TABLE_SHARDS
+  struct sst_obj_table_shard_ref_t shard[SST_OBJ_TABLE_NUM_SHARDS]; /*!<
+                                  *   References to the shards holding the
+                                  *   entries. The entries below are not
+                                  *   saved in the object table files.
+                                  */
+#endif
+
   struct sst_obj_table_entry_t obj_db[SST_OBJ_TABLE_ENTRIES]; /*!< Table's
                                                                *   entries
                                                                */
@@ -117,6 +165,129 @@ struct sst_obj_table_t {
 #define SST_OBJECT_FS_ID_TO_IDX(fid) ((fid - 1) - \
                                       SST_TABLE_FS_ID(SST_OBJ_TABLE_IDX_1))
 
+#ifdef SST_OBJ_TABLE_JOURNAL
+/*!
+ * \def SST_OBJ_TABLE_JOURNAL_RECORDS
+ *
+ * \brief Number of change records that the object table journal holds before
+ *        the whole object table is saved again.
+ */
+#ifndef SST_OBJ_TABLE_JOURNAL_RECORDS
+#define SST_OBJ_TABLE_JOURNAL_RECORDS 8
+#endif
+
+/*!
+ * \def SST_OBJ_TABLE_JOURNAL_FS_ID
+ *
+ * \brief File ID to be used in order to store the object table journal in the
+ *        file system. It follows the file IDs of the objects.
+ */
+#define SST_OBJ_TABLE_JOURNAL_FS_ID SST_OBJECT_FS_ID(SST_OBJ_TABLE_ENTRIES)
+
+/*!
+ * \struct sst_obj_table_record_t
+ *
+ * \brief Object table journal record structure.
+ */
+struct sst_obj_table_record_t {
+    uint32_t idx;                       /*!< Index of the changed entry */
+    struct sst_obj_table_entry_t entry; /*!< New content of the entry */
+};
+
+/*!
+ * \struct sst_obj_table_journal_t
+ *
+ * \brief Object table journal structure. It holds the changes of the object
+ *        table since the object table was last saved, in order.
+ */
+struct sst_obj_table_journal_t {
+#ifdef SST_ENCRYPTION
+  union sst_crypto_t crypto;     /*!< Crypto metadata. */
+  uint8_t base_tag[SST_TAG_LEN_BYTES]; /*!< Tag of the object table which
+                                        *   the records apply to
+                                        */
+#else
+  uint32_t base_swap_count;      /*!< Swap count of the object table which
+                                  *   the records apply to
+                                  */
+#endif
+  uint32_t num_records;          /*!< Number of records in the journal */
+  struct sst_obj_table_record_t record[SST_OBJ_TABLE_JOURNAL_RECORDS]; /*!<
+                                  *   Journal records
+                                  */
+};
+#endif /* SST_OBJ_TABLE_JOURNAL */
+
+#ifdef SST_OBJ_TABLE_SHARDS
+/*!
+ * \def SST_OBJ_TABLE_SHARD_FS_ID
+ *
+ * \brief File ID to be used in order to store a copy of an object table shard
+ *        in the file system. The two copies of each shard follow the file IDs
+ *        of the objects.
+ *
+ * \param[in] shard  Shard index
+ * \param[in] copy   Copy of the shard, 0 or 1
+ *
+ * \return Returns file ID
+ */
+#define SST_OBJ_TABLE_SHARD_FS_ID(shard, copy) \
+    (SST_OBJECT_FS_ID(SST_OBJ_TABLE_ENTRIES) + (2 * (shard)) + (copy))
+
+/* Index of the shard holding an object table entry */
+#define SST_OBJ_TABLE_SHARD_OF(idx) ((idx) / SST_OBJ_TABLE_SHARD_ENTRIES)
+
+/*!
+ * \struct sst_obj_table_shard_t
+ *
+ * \brief Object table shard structure. It holds a range of the object table
+ *        entries, and is authenticated on its own.
+ */
+struct sst_obj_table_shard_t {
+#ifdef SST_ENCRYPTION
+  union sst_crypto_t crypto;     /*!< Crypto metadata. */
+#endif
+  uint32_t shard_idx;            /*!< Index of the shard */
+  struct sst_obj_table_entry_t entry[SST_OBJ_TABLE_SHARD_ENTRIES]; /*!<
+                                  *   Entries of the shard
+                                  */
+};
+#endif /* SST_OBJ_TABLE_SHARDS */
+
+#ifdef SST_OBJ_TABLE_INDEX
+/*!
+ * \def SST_OBJ_TABLE_INDEX_NUM_SLOTS
+ *
+ * \brief Number of slots of the hash table of the object table index. It is
+ *        twice the number of entries, so that probe sequences stay short.
+ */
+#define SST_OBJ_TABLE_INDEX_NUM_SLOTS (2 * SST_OBJ_TABLE_ENTRIES)
+
+/* Value of an empty slot of the object table index */
+#define SST_OBJ_TABLE_INDEX_INVALID_SLOT 0xFFFFU
+
+/* Check at compilation time if the entry indexes fit in the slots */
+SST_UTILS_BOUND_CHECK(OBJ_TABLE_ENTRIES_NOT_FIT_IN_INDEX_SLOT,
+                      SST_OBJ_TABLE_ENTRIES, SST_OBJ_TABLE_INDEX_INVALID_SLOT);
+
+/*!
+ * \struct sst_obj_table_index_t
+ *
+ * \brief Object table index structure. It is built from the active object
+ *        table and kept in step with every change of its entries.
+ */
+struct sst_obj_table_index_t {
+    uint16_t slot[SST_OBJ_TABLE_INDEX_NUM_SLOTS]; /*!< Open addressing hash
+                                                   *   table of the used
+                                                   *   entries
+                                                   */
+    uint32_t free_map[(SST_OBJ_TABLE_ENTRIES + 31) / 32]; /*!< Bitmap of the
+                                                           *   free entries
+                                                           */
+    uint32_t num_free;                /*!< Number of free entries */
+};
+#endif /* SST_OBJ_TABLE_INDEX */
+
 /*!
  * \struct sst_obj_table_ctx_t
  *
@@ -126,13 +297,46 @@ struct sst_obj_table_ctx_t {
     struct sst_obj_table_t obj_table; /*!< Object tables */
     uint8_t active_table;             /*!< Active object table */
     uint8_t scratch_table;            /*!< Scratch object table */
+#ifdef SST_OBJ_TABLE_INDEX
+    struct sst_obj_table_index_t index; /*!< Index of the object table */
+#endif
+#ifdef SST_OBJ_TABLE_JOURNAL
+    struct sst_obj_table_journal_t journal; /*!< Object table journal */
+#endif
+#ifdef SST_OBJ_TABLE_SHARDS
+    struct sst_obj_table_shard_t shard_buf; /*!< Buffer to save and load the
+                                             *   object table shards
+                                             */
+#endif
+#if defined(SST_ROLLBACK_PROTECTION) && defined(SST_NV_COUNTER_EPOCHS)
+    uint32_t epoch_commits;           /*!< Number of table saves in the
+                                       *   current NV counter epoch, 0 if no
+                                       *   epoch has been started
+                                       */
+    uint32_t epoch_nvc;               /*!< Value of SST NV counter 1 in the
+                                       *   current epoch
+                                       */
+#endif
+#ifdef SST_TRANSACTIONS
+    uint8_t in_transaction;           /*!< Whether a transaction is open */
+    struct sst_obj_table_entry_t txn_entries[SST_OBJ_TABLE_ENTRIES]; /*!<
+                                       *   Entries of the persistent object
+                                       *   table while a transaction is open
+                                       */
+#endif
 };
 
 /* Object table context */
 static struct sst_obj_table_ctx_t sst_obj_table_ctx;
 
-/* Object table size */
+/* Object table size. With SST_OBJ_TABLE_SHARDS, only the header and the shard
+ * references are saved in the object table files.
+ */
+#ifdef SST_OBJ_TABLE_SHARDS
+#define SST_OBJ_TABLE_SIZE            offsetof(struct sst_obj_table_t, obj_db)
+#else
 #define SST_OBJ_TABLE_SIZE            sizeof(struct sst_obj_table_t)
+#endif
 
 /* Object table entry size */
 #define SST_OBJECTS_TABLE_ENTRY_SIZE  sizeof(struct sst_obj_table_entry_t)
@@ -177,6 +381,34 @@ struct sst_crypto_assoc_data_t {
 SST_UTILS_BOUND_CHECK(OBJ_TABLE_NOT_FIT_IN_STATIC_OBJ_DATA_BUF,
                       SST_OBJ_TABLE_SIZE, SST_MAX_ASSET_SIZE);
 
+#ifdef SST_OBJ_TABLE_SHARDS
+/* Check at compilation time if a shard fits in an object file */
+SST_UTILS_BOUND_CHECK(OBJ_TABLE_SHARD_NOT_FIT_IN_OBJ_FILE,
+                      sizeof(struct sst_obj_table_shard_t), SST_MAX_ASSET_SIZE);
+#endif
+
+#ifdef SST_OBJ_TABLE_JOURNAL
+/* Size of the journal header, which precedes the records */
+#define SST_OBJ_TABLE_JOURNAL_HDR_SIZE \
+                          offsetof(struct sst_obj_table_journal_t, record)
+
+/* Size of the journal with the given number of records */
+#define SST_OBJ_TABLE_JOURNAL_SIZE(num_records) \
+    (SST_OBJ_TABLE_JOURNAL_HDR_SIZE + \
+     ((num_records) * sizeof(struct sst_obj_table_record_t)))
+
+/* Check at compilation time if a full journal fits in an object file */
+SST_UTILS_BOUND_CHECK(OBJ_TABLE_JOURNAL_NOT_FIT_IN_OBJ_FILE,
+                      SST_OBJ_TABLE_JOURNAL_SIZE(SST_OBJ_TABLE_JOURNAL_RECORDS),
+                      SST_MAX_ASSET_SIZE);
+
+/* Check at compilation time if the journal fits the two records of an object
+ * update.
+ */
+SST_UTILS_BOUND_CHECK(OBJ_TABLE_JOURNAL_TOO_SMALL, 2,
+                      SST_OBJ_TABLE_JOURNAL_RECORDS);
+#endif /* SST_OBJ_TABLE_JOURNAL */
+
 enum sst_obj_table_state {
     SST_OBJ_TABLE_VALID = 0,   /*!< Table content is valid */
     SST_OBJ_TABLE_INVALID,     /*!< Table content is invalid */
@@ -319,6 +551,55 @@ static psa_status_t sst_object_table_align_nv_counters(uint32_t nvc_1)
     return PSA_SUCCESS;
 }
 
+/**
+ * \brief Increases SST non-volatile counter 1 for a new object table save.
+ *        With SST_NV_COUNTER_EPOCHS, the counter is only increased by the
+ *        first save of an epoch, and the next saves of the epoch are told
+ *        apart by their sequence number, authenticated with the table.
+ *
+ * \param[in,out] obj_table  Pointer to the object table to save
+ * \param[out]    nvc_1      Value of SST non-volatile counter 1 to
+ *                           authenticate the table with
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t sst_object_table_increment_nvc(
+                                             struct sst_obj_table_t *obj_table,
+                                             uint32_t *nvc_1)
+{
+    psa_status_t err;
+
+#ifdef SST_NV_COUNTER_EPOCHS
+    if (sst_obj_table_ctx.epoch_commits != 0) {
+        /* Stay in the current epoch */
+        *nvc_1 = sst_obj_table_ctx.epoch_nvc;
+        obj_table->epoch_seq++;
+
+        return PSA_SUCCESS;
+    }
+#else
+    (void)obj_table;
+#endif
+
+    err = sst_increment_nv_counter(TFM_SST_NV_COUNTER_1);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    err = sst_read_nv_counter(TFM_SST_NV_COUNTER_1, nvc_1);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+#ifdef SST_NV_COUNTER_EPOCHS
+    /* Start a new epoch */
+    sst_obj_table_ctx.epoch_nvc = *nvc_1;
+    obj_table->epoch_seq = 0;
+#endif
+
+    return PSA_SUCCESS;
+}
+
 /**
  * \brief Generates table authentication tag.
  *
@@ -522,12 +803,7 @@ static psa_status_t sst_object_table_save_table(
 #ifdef SST_ROLLBACK_PROTECTION
     uint32_t nvc_1 = 0;
 
-    err = sst_increment_nv_counter(TFM_SST_NV_COUNTER_1);
-    if (err != PSA_SUCCESS) {
-        return err;
-    }
-
-    err = sst_read_nv_counter(TFM_SST_NV_COUNTER_1, &nvc_1);
+    err = sst_object_table_increment_nvc(obj_table, &nvc_1);
     if (err != PSA_SUCCESS) {
         return err;
     }
@@ -580,6 +856,19 @@ static psa_status_t sst_object_table_save_table(
         return err;
     }
 
+#ifdef SST_NV_COUNTER_EPOCHS
+    /* Close the epoch after its last save */
+    sst_obj_table_ctx.epoch_commits++;
+    if (sst_obj_table_ctx.epoch_commits == SST_NV_COUNTER_EPOCH_COMMITS) {
+        sst_obj_table_ctx.epoch_commits = 0;
+    }
+
+    if (obj_table->epoch_seq != 0) {
+        /* The NV counters have been aligned by the first save of the epoch */
+        return PSA_SUCCESS;
+    }
+#endif
+
     /* Align SST NV counters to have the same value */
     err = sst_object_table_align_nv_counters(nvc_1);
 #endif /* SST_ROLLBACK_PROTECTION */
@@ -663,6 +952,24 @@ static psa_status_t sst_set_active_object_table(
     }
 
 #ifdef SST_ROLLBACK_PROTECTION
+#ifdef SST_NV_COUNTER_EPOCHS
+    if ((init_ctx->table_state[SST_OBJ_TABLE_IDX_0] ==
+                                                   SST_OBJ_TABLE_NVC_1_VALID) &&
+        (init_ctx->table_state[SST_OBJ_TABLE_IDX_1] ==
+                                                   SST_OBJ_TABLE_NVC_1_VALID)) {
+        /* Both tables have been saved in the current epoch, the latest one
+         * has the highest sequence number.
+         */
+        if (init_ctx->p_table[SST_OBJ_TABLE_IDX_1]->epoch_seq >
+            init_ctx->p_table[SST_OBJ_TABLE_IDX_0]->epoch_seq) {
+            sst_obj_table_ctx.active_table  = SST_OBJ_TABLE_IDX_1;
+            sst_obj_table_ctx.scratch_table = SST_OBJ_TABLE_IDX_0;
+        } else {
+            sst_obj_table_ctx.active_table  = SST_OBJ_TABLE_IDX_0;
+            sst_obj_table_ctx.scratch_table = SST_OBJ_TABLE_IDX_1;
+        }
+    } else
+#endif /* SST_NV_COUNTER_EPOCHS */
     if (init_ctx->table_state[SST_OBJ_TABLE_IDX_1] ==
                                                     SST_OBJ_TABLE_NVC_1_VALID) {
         /* Table 0 is invalid, the active one is table 1 */
@@ -724,6 +1031,144 @@ static psa_status_t sst_set_active_object_table(
     return PSA_SUCCESS;
 }
 
+#ifdef SST_OBJ_TABLE_INDEX
+/**
+ * \brief Gets the home slot of an object in the hash table of the object
+ *        table index.
+ *
+ * \param[in] uid        Object UID
+ * \param[in] client_id  Client UID
+ *
+ * \return The slot where the probe sequence of the object starts
+ */
+static uint32_t sst_obj_table_index_hash(psa_storage_uid_t uid,
+                                         int32_t client_id)
+{
+    uint32_t hash = 2166136261U;
+    uint64_t key = uid;
+    uint32_t i;
+
+    /* 32-bit FNV-1a hash of the UID followed by the client ID */
+    for (i = 0; i < sizeof(uid); i++) {
+        hash = (hash ^ (uint8_t)key) * 16777619U;
+        key >>= 8;
+    }
+
+    key = (uint32_t)client_id;
+    for (i = 0; i < sizeof(client_id); i++) {
+        hash = (hash ^ (uint8_t)key) * 16777619U;
+        key >>= 8;
+    }
+
+    return hash % SST_OBJ_TABLE_INDEX_NUM_SLOTS;
+}
+
+/**
+ * \brief Gets the slot which follows a slot in a probe sequence.
+ *
+ * \param[in] slot  Slot of the hash table
+ *
+ * \return The next slot, wrapping around the end of the table
+ */
+__attribute__ ((always_inline))
+__STATIC_INLINE uint32_t sst_obj_table_index_next_slot(uint32_t slot)
+{
+    return (slot + 1) % SST_OBJ_TABLE_INDEX_NUM_SLOTS;
+}
+
+/**
+ * \brief Adds a used table entry to the object table index.
+ *
+ * \param[in] idx  Entry index, which holds the object UID and client ID
+ */
+static void sst_obj_table_index_insert(uint32_t idx)
+{
+    struct sst_obj_table_index_t *index = &sst_obj_table_ctx.index;
+    struct sst_obj_table_entry_t *entry;
+    uint32_t slot;
+
+    entry = &sst_obj_table_ctx.obj_table.obj_db[idx];
+    slot = sst_obj_table_index_hash(entry->uid, entry->client_id);
+
+    /* The entry is added at the end of its probe sequence, so that a lookup
+     * returns the lowest entry of an object, as the table scan.
+     */
+    while (index->slot[slot] != SST_OBJ_TABLE_INDEX_INVALID_SLOT) {
+        slot = sst_obj_table_index_next_slot(slot);
+    }
+
+    index->slot[slot] = (uint16_t)idx;
+    index->free_map[idx / 32] &= ~(1U << (idx % 32));
+    index->num_free--;
+}
+
+/**
+ * \brief Removes a used table entry from the object table index.
+ *
+ * \param[in] idx  Entry index, which still holds the object UID and client ID
+ */
+static void sst_obj_table_index_remove(uint32_t idx)
+{
+    struct sst_obj_table_index_t *index = &sst_obj_table_ctx.index;
+    struct sst_obj_table_entry_t *entry;
+    uint32_t empty;
+    uint32_t home;
+    uint32_t slot;
+
+    entry = &sst_obj_table_ctx.obj_table.obj_db[idx];
+    slot = sst_obj_table_index_hash(entry->uid, entry->client_id);
+
+    while (index->slot[slot] != idx) {
+        if (index->slot[slot] == SST_OBJ_TABLE_INDEX_INVALID_SLOT) {
+            /* The entry is not in the index */
+            return;
+        }
+        slot = sst_obj_table_index_next_slot(slot);
+    }
+
+    /* Move back the entries of the probe sequence which follow the removed
+     * one, unless their home slot lies between the empty slot and them.
+     */
+    empty = slot;
+    for (slot = sst_obj_table_index_next_slot(slot);
+         index->slot[slot] != SST_OBJ_TABLE_INDEX_INVALID_SLOT;
+         slot = sst_obj_table_index_next_slot(slot)) {
+        entry = &sst_obj_table_ctx.obj_table.obj_db[index->slot[slot]];
+        home = sst_obj_table_index_hash(entry->uid, entry->client_id);
+        if (((slot > empty) && ((home <= empty) || (home > slot))) ||
+            ((slot < empty) && (home <= empty) && (home > slot))) {
+            index->slot[empty] = index->slot[slot];
+            empty = slot;
+        }
+    }
+
+    index->slot[empty] = SST_OBJ_TABLE_INDEX_INVALID_SLOT;
+    index->free_map[idx / 32] |= (1U << (idx % 32));
+    index->num_free++;
+}
+
+/**
+ * \brief Builds the object table index from the entries of the object table.
+ */
+static void sst_obj_table_index_build(void)
+{
+    struct sst_obj_table_index_t *index = &sst_obj_table_ctx.index;
+    uint32_t i;
+
+    (void)tfm_memset(index->slot, 0xFF, sizeof(index->slot));
+    (void)tfm_memset(index->free_map, 0, sizeof(index->free_map));
+    index->num_free = SST_OBJ_TABLE_ENTRIES;
+
+    for (i = 0; i < SST_OBJ_TABLE_ENTRIES; i++) {
+        index->free_map[i / 32] |= (1U << (i % 32));
+
+        if (sst_obj_table_ctx.obj_table.obj_db[i].uid != TFM_SST_INVALID_UID) {
+            sst_obj_table_index_insert(i);
+        }
+    }
+}
+#endif /* SST_OBJ_TABLE_INDEX */
+
 /**
  * \brief Gets table's entry index based on the given object UID and client ID.
  *
@@ -738,8 +1183,28 @@ static psa_status_t sst_get_object_entry_idx(psa_storage_uid_t uid,
                                              int32_t client_id,
                                              uint32_t *idx)
 {
-    uint32_t i;
     struct sst_obj_table_t *p_table = &sst_obj_table_ctx.obj_table;
+#ifdef SST_OBJ_TABLE_INDEX
+    struct sst_obj_table_index_t *index = &sst_obj_table_ctx.index;
+    uint32_t slot;
+
+    if (uid == TFM_SST_INVALID_UID) {
+        /* Free entries are not in the index */
+        return PSA_ERROR_DOES_NOT_EXIST;
+    }
+
+    /* At least half of the slots are empty, so the probe sequence ends */
+    for (slot = sst_obj_table_index_hash(uid, client_id);
+         index->slot[slot] != SST_OBJ_TABLE_INDEX_INVALID_SLOT;
+         slot = sst_obj_table_index_next_slot(slot)) {
+        if (p_table->obj_db[index->slot[slot]].uid == uid
+            && p_table->obj_db[index->slot[slot]].client_id == client_id) {
+            *idx = index->slot[slot];
+            return PSA_SUCCESS;
+        }
+    }
+#else
+    uint32_t i;
 
     for (i = 0; i < SST_OBJ_TABLE_ENTRIES; i++) {
         if (p_table->obj_db[i].uid == uid
@@ -748,10 +1213,29 @@ static psa_status_t sst_get_object_entry_idx(psa_storage_uid_t uid,
             return PSA_SUCCESS;
         }
     }
+#endif /* SST_OBJ_TABLE_INDEX */
 
     return PSA_ERROR_DOES_NOT_EXIST;
 }
 
+#ifdef SST_TRANSACTIONS
+/**
+ * \brief Checks if a table entry is reserved by the open transaction. The
+ *        entries used in the persistent object table stay reserved until the
+ *        transaction ends, so that the files they refer to are not reused.
+ *
+ * \param[in] idx  Entry index to check
+ *
+ * \return Returns 1 if the entry is reserved, 0 otherwise
+ */
+__attribute__ ((always_inline))
+__STATIC_INLINE uint32_t sst_table_is_reserved(uint32_t idx)
+{
+    return (sst_obj_table_ctx.in_transaction &&
+            sst_obj_table_ctx.txn_entries[idx].uid != TFM_SST_INVALID_UID);
+}
+#endif /* SST_TRANSACTIONS */
+
 /**
  * \brief Gets free index in the table
  *
@@ -772,18 +1256,45 @@ __STATIC_INLINE psa_status_t sst_table_free_idx(uint32_t idx_num,
 {
     uint32_t i;
     uint32_t last_free = 0;
+#ifdef SST_OBJ_TABLE_INDEX
+    struct sst_obj_table_index_t *index = &sst_obj_table_ctx.index;
+#else
     struct sst_obj_table_t *p_table = &sst_obj_table_ctx.obj_table;
+#endif
 
     if (idx_num == 0) {
         return PSA_ERROR_INVALID_ARGUMENT;
     }
 
+#ifdef SST_OBJ_TABLE_INDEX
+    if (index->num_free < idx_num) {
+        return PSA_ERROR_INSUFFICIENT_STORAGE;
+    }
+
+    /* Return the idx_num-th free entry, as the table scan, skipping the
+     * bitmap words without free entries.
+     */
+    for (i = 0; idx_num > 0; i++) {
+        if (index->free_map[i / 32] == 0) {
+            i += 31;
+        } else if (index->free_map[i / 32] & (1U << (i % 32))) {
+            last_free = i;
+            idx_num--;
+        }
+    }
+#else
     for (i = 0; i < SST_OBJ_TABLE_ENTRIES && idx_num > 0; i++) {
+#ifdef SST_TRANSACTIONS
+        if (sst_table_is_reserved(i)) {
+            continue;
+        }
+#endif
         if (p_table->obj_db[i].uid == TFM_SST_INVALID_UID) {
             last_free = i;
             idx_num--;
         }
     }
+#endif /* SST_OBJ_TABLE_INDEX */
 
     if (idx_num != 0) {
         return PSA_ERROR_INSUFFICIENT_STORAGE;
@@ -793,6 +1304,32 @@ __STATIC_INLINE psa_status_t sst_table_free_idx(uint32_t idx_num,
     }
 }
 
+/**
+ * \brief Sets an entry of the table
+ *
+ * \param[in] idx    Entry index to set
+ * \param[in] entry  Pointer to the new content of the entry
+ *
+ */
+static void sst_table_set_entry(uint32_t idx,
+                                const struct sst_obj_table_entry_t *entry)
+{
+#ifdef SST_OBJ_TABLE_INDEX
+    if (sst_obj_table_ctx.obj_table.obj_db[idx].uid != TFM_SST_INVALID_UID) {
+        sst_obj_table_index_remove(idx);
+    }
+#endif
+
+    (void)tfm_memcpy(&sst_obj_table_ctx.obj_table.obj_db[idx], entry,
+                     SST_OBJECTS_TABLE_ENTRY_SIZE);
+
+#ifdef SST_OBJ_TABLE_INDEX
+    if (entry->uid != TFM_SST_INVALID_UID) {
+        sst_obj_table_index_insert(idx);
+    }
+#endif
+}
+
 /**
  * \brief Deletes an entry from the table
  *
@@ -801,44 +1338,582 @@ __STATIC_INLINE psa_status_t sst_table_free_idx(uint32_t idx_num,
  */
 static void sst_table_delete_entry(uint32_t idx)
 {
+#ifdef SST_OBJ_TABLE_INDEX
+    struct sst_obj_table_index_t *index = &sst_obj_table_ctx.index;
+
+    if (sst_obj_table_ctx.obj_table.obj_db[idx].uid != TFM_SST_INVALID_UID) {
+        sst_obj_table_index_remove(idx);
+#ifdef SST_TRANSACTIONS
+        if (sst_table_is_reserved(idx)) {
+            /* Keep the reserved entry out of the free entries */
+            index->free_map[idx / 32] &= ~(1U << (idx % 32));
+            index->num_free--;
+        }
+#endif
+    }
+#endif
+
     /* Initialise object table entry structure */
     (void)tfm_memset(&sst_obj_table_ctx.obj_table.obj_db[idx],
                      SST_DEFAULT_EMPTY_BUFF_VAL, SST_OBJECTS_TABLE_ENTRY_SIZE);
 }
 
-psa_status_t sst_object_table_create(void)
+#ifdef SST_OBJ_TABLE_JOURNAL
+/**
+ * \brief Empties the journal and binds it to the current object table.
+ */
+static void sst_obj_table_journal_reset(void)
 {
-    struct sst_obj_table_t *p_table = &sst_obj_table_ctx.obj_table;
+    struct sst_obj_table_journal_t *journal = &sst_obj_table_ctx.journal;
 
-#ifdef SST_ROLLBACK_PROTECTION
-    psa_status_t err;
+    (void)tfm_memset(journal, SST_DEFAULT_EMPTY_BUFF_VAL,
+                     sizeof(struct sst_obj_table_journal_t));
 
-    /* Initialize SST NV counters */
-    err = sst_init_nv_counter();
-    if (err != PSA_SUCCESS) {
-        return err;
-    }
+#ifdef SST_ENCRYPTION
+    (void)tfm_memcpy(journal->base_tag,
+                     sst_obj_table_ctx.obj_table.crypto.ref.tag,
+                     SST_TAG_LEN_BYTES);
+#else
+    journal->base_swap_count = sst_obj_table_ctx.obj_table.swap_count;
 #endif
+}
 
-    /* Initialize object structure */
-    (void)tfm_memset(&sst_obj_table_ctx, SST_DEFAULT_EMPTY_BUFF_VAL,
-                     sizeof(struct sst_obj_table_ctx_t));
-
-    /* Invert the other in the context as sst_object_table_save_table will
-     * use the scratch index to create and store the current table.
+/**
+ * \brief Saves the journal in the persistent memory.
+ *
+ * \param[in,out] journal  Pointer to the journal to save
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t sst_obj_table_journal_save(
+                                       struct sst_obj_table_journal_t *journal)
+{
+    size_t journal_size = SST_OBJ_TABLE_JOURNAL_SIZE(journal->num_records);
+#ifdef SST_ENCRYPTION
+    psa_status_t err;
+
+    /* Set object table key */
+    err = sst_crypto_setkey();
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    /* Get new IV */
+    sst_crypto_get_iv(&journal->crypto);
+
+    /* Generate authentication tag from the journal content, which includes
+     * the tag of the object table it applies to.
+     */
+    err = sst_crypto_generate_auth_tag(&journal->crypto,
+                                 SST_CRYPTO_ASSOCIATED_DATA(&journal->crypto),
+                                 journal_size - SST_NON_AUTH_OBJ_TABLE_SIZE);
+    if (err != PSA_SUCCESS) {
+        (void)sst_crypto_destroykey();
+        return err;
+    }
+
+    err = sst_crypto_destroykey();
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+#endif /* SST_ENCRYPTION */
+
+    return psa_its_set(SST_OBJ_TABLE_JOURNAL_FS_ID, journal_size,
+                       (const void *)journal, PSA_STORAGE_FLAG_NONE);
+}
+
+/**
+ * \brief Loads the journal from the persistent memory and applies its records
+ *        to the active object table.
+ *
+ * \note The records are applied only if the journal is valid and applies to
+ *       the active object table. Otherwise, the object table is left as it is.
+ *
+ * \return Returns PSA_SUCCESS if the records have been applied. Otherwise, it
+ *         returns an error code as specified in \ref psa_status_t
+ */
+static psa_status_t sst_obj_table_journal_load(void)
+{
+    struct sst_obj_table_journal_t *journal = &sst_obj_table_ctx.journal;
+    struct sst_obj_table_t *p_table = &sst_obj_table_ctx.obj_table;
+    psa_status_t err;
+    size_t data_length;
+    uint32_t i;
+
+    err = psa_its_get(SST_OBJ_TABLE_JOURNAL_FS_ID, 0,
+                      sizeof(struct sst_obj_table_journal_t),
+                      (void *)journal, &data_length);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    if ((data_length < SST_OBJ_TABLE_JOURNAL_HDR_SIZE) ||
+        (journal->num_records > SST_OBJ_TABLE_JOURNAL_RECORDS) ||
+        (data_length != SST_OBJ_TABLE_JOURNAL_SIZE(journal->num_records))) {
+        return PSA_ERROR_DATA_CORRUPT;
+    }
+
+    /* A journal written before the last save of the object table is stale */
+#ifdef SST_ENCRYPTION
+    if (tfm_memcmp(journal->base_tag, p_table->crypto.ref.tag,
+                   SST_TAG_LEN_BYTES)) {
+        return PSA_ERROR_DOES_NOT_EXIST;
+    }
+
+    err = sst_crypto_setkey();
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    err = sst_crypto_authenticate(&journal->crypto,
+                                  SST_CRYPTO_ASSOCIATED_DATA(&journal->crypto),
+                                  data_length - SST_NON_AUTH_OBJ_TABLE_SIZE);
+    if (err != PSA_SUCCESS) {
+        (void)sst_crypto_destroykey();
+        return err;
+    }
+
+    err = sst_crypto_destroykey();
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+#else
+    if (journal->base_swap_count != p_table->swap_count) {
+        return PSA_ERROR_DOES_NOT_EXIST;
+    }
+#endif /* SST_ENCRYPTION */
+
+    for (i = 0; i < journal->num_records; i++) {
+        if (journal->record[i].idx >= SST_OBJ_TABLE_ENTRIES) {
+            return PSA_ERROR_DATA_CORRUPT;
+        }
+    }
+
+    /* Replay the records in order */
+    for (i = 0; i < journal->num_records; i++) {
+        (void)tfm_memcpy(&p_table->obj_db[journal->record[i].idx],
+                         &journal->record[i].entry,
+                         SST_OBJECTS_TABLE_ENTRY_SIZE);
+    }
+
+    return PSA_SUCCESS;
+}
+#endif /* SST_OBJ_TABLE_JOURNAL */
+
+#ifdef SST_OBJ_TABLE_SHARDS
+/**
+ * \brief Gets the number of object table entries held in a shard, which is
+ *        less than SST_OBJ_TABLE_SHARD_ENTRIES for the last shard.
+ *
+ * \param[in] shard  Shard index
+ *
+ * \return Number of entries.
+ */
+static uint32_t sst_obj_table_shard_num_entries(uint32_t shard)
+{
+    uint32_t first = shard * SST_OBJ_TABLE_SHARD_ENTRIES;
+
+    return SST_UTILS_MIN(SST_OBJ_TABLE_SHARD_ENTRIES,
+                         SST_OBJ_TABLE_ENTRIES - first);
+}
+
+/**
+ * \brief Saves a shard in the copy which the object table does not refer to,
+ *        and makes the object table refer to it. The object table has to be
+ *        saved afterwards for the new copy to be used.
+ *
+ * \param[in] shard  Shard index
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t sst_obj_table_shard_save(uint32_t shard)
+{
+    struct sst_obj_table_shard_t *p_shard = &sst_obj_table_ctx.shard_buf;
+    struct sst_obj_table_shard_ref_t *ref =
+                                     &sst_obj_table_ctx.obj_table.shard[shard];
+    uint32_t copy = (ref->copy == 0) ? 1 : 0;
+    psa_status_t err;
+
+    /* Initialise the shard, including its padding, as it is authenticated */
+    (void)tfm_memset(p_shard, SST_DEFAULT_EMPTY_BUFF_VAL,
+                     sizeof(struct sst_obj_table_shard_t));
+    p_shard->shard_idx = shard;
+    (void)tfm_memcpy(p_shard->entry,
+             &sst_obj_table_ctx.obj_table.obj_db[shard *
+                                                 SST_OBJ_TABLE_SHARD_ENTRIES],
+             sst_obj_table_shard_num_entries(shard) *
+             SST_OBJECTS_TABLE_ENTRY_SIZE);
+
+#ifdef SST_ENCRYPTION
+    /* Set object table key */
+    err = sst_crypto_setkey();
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    /* Get new IV */
+    sst_crypto_get_iv(&p_shard->crypto);
+
+    err = sst_crypto_generate_auth_tag(&p_shard->crypto,
+                                 SST_CRYPTO_ASSOCIATED_DATA(&p_shard->crypto),
+                                 sizeof(struct sst_obj_table_shard_t) -
+                                 SST_NON_AUTH_OBJ_TABLE_SIZE);
+    if (err != PSA_SUCCESS) {
+        (void)sst_crypto_destroykey();
+        return err;
+    }
+
+    err = sst_crypto_destroykey();
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+#endif /* SST_ENCRYPTION */
+
+    err = psa_its_set(SST_OBJ_TABLE_SHARD_FS_ID(shard, copy),
+                      sizeof(struct sst_obj_table_shard_t),
+                      (const void *)p_shard, PSA_STORAGE_FLAG_NONE);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    ref->copy = copy;
+#ifdef SST_ENCRYPTION
+    (void)tfm_memcpy(ref->tag, p_shard->crypto.ref.tag, SST_TAG_LEN_BYTES);
+#endif
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Loads a shard referred to by the active object table into the
+ *        entries of the object table.
+ *
+ * \param[in] shard  Shard index
+ *
+ * \note With SST_ENCRYPTION, the object table key must be set.
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t sst_obj_table_shard_load(uint32_t shard)
+{
+    struct sst_obj_table_shard_t *p_shard = &sst_obj_table_ctx.shard_buf;
+    const struct sst_obj_table_shard_ref_t *ref =
+                                     &sst_obj_table_ctx.obj_table.shard[shard];
+    psa_status_t err;
+    size_t data_length;
+
+    if (ref->copy > 1) {
+        return PSA_ERROR_DATA_CORRUPT;
+    }
+
+    err = psa_its_get(SST_OBJ_TABLE_SHARD_FS_ID(shard, ref->copy), 0,
+                      sizeof(struct sst_obj_table_shard_t),
+                      (void *)p_shard, &data_length);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    if ((data_length != sizeof(struct sst_obj_table_shard_t)) ||
+        (p_shard->shard_idx != shard)) {
+        return PSA_ERROR_DATA_CORRUPT;
+    }
+
+#ifdef SST_ENCRYPTION
+    /* The shard must be the one which the object table has been saved with */
+    if (tfm_memcmp(p_shard->crypto.ref.tag, ref->tag, SST_TAG_LEN_BYTES)) {
+        return PSA_ERROR_INVALID_SIGNATURE;
+    }
+
+    err = sst_crypto_authenticate(&p_shard->crypto,
+                                  SST_CRYPTO_ASSOCIATED_DATA(&p_shard->crypto),
+                                  sizeof(struct sst_obj_table_shard_t) -
+                                  SST_NON_AUTH_OBJ_TABLE_SIZE);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+#endif /* SST_ENCRYPTION */
+
+    (void)tfm_memcpy(
+             &sst_obj_table_ctx.obj_table.obj_db[shard *
+                                                 SST_OBJ_TABLE_SHARD_ENTRIES],
+             p_shard->entry,
+             sst_obj_table_shard_num_entries(shard) *
+             SST_OBJECTS_TABLE_ENTRY_SIZE);
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Loads all the shards referred to by the active object table.
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t sst_obj_table_shards_load(void)
+{
+    psa_status_t err;
+    uint32_t shard;
+
+#ifdef SST_ENCRYPTION
+    /* Set object table key */
+    err = sst_crypto_setkey();
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+#endif
+
+    for (shard = 0; shard < SST_OBJ_TABLE_NUM_SHARDS; shard++) {
+        err = sst_obj_table_shard_load(shard);
+        if (err != PSA_SUCCESS) {
+#ifdef SST_ENCRYPTION
+            (void)sst_crypto_destroykey();
+#endif
+            return err;
+        }
+    }
+
+#ifdef SST_ENCRYPTION
+    return sst_crypto_destroykey();
+#else
+    return PSA_SUCCESS;
+#endif
+}
+
+/**
+ * \brief Saves the shards holding the changed entries, then the object table
+ *        which refers to them.
+ *
+ * \param[in] idx      Indexes of the changed entries
+ * \param[in] num_idx  Number of changed entries
+ *
+ * \note The shards are saved in the copies which the saved object table does
+ *       not refer to, so a power failure before the object table is saved
+ *       leaves the previous object table and shards intact.
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t sst_obj_table_shards_commit(const uint32_t *idx,
+                                                uint32_t num_idx)
+{
+    struct sst_obj_table_t *p_table = &sst_obj_table_ctx.obj_table;
+    struct sst_obj_table_shard_ref_t backup_ref[SST_OBJ_TABLE_NUM_SHARDS];
+    uint8_t saved[SST_OBJ_TABLE_NUM_SHARDS] = {0U};
+    psa_status_t err = PSA_SUCCESS;
+    uint32_t shard;
+    uint32_t i;
+
+    (void)tfm_memcpy(backup_ref, p_table->shard, sizeof(backup_ref));
+
+    for (i = 0; (i < num_idx) && (err == PSA_SUCCESS); i++) {
+        shard = SST_OBJ_TABLE_SHARD_OF(idx[i]);
+        if (!saved[shard]) {
+            err = sst_obj_table_shard_save(shard);
+            saved[shard] = 1U;
+        }
+    }
+
+    if (err == PSA_SUCCESS) {
+        err = sst_object_table_save_table(p_table);
+    }
+
+    if (err != PSA_SUCCESS) {
+        /* Keep referring to the copies of the saved object table */
+        (void)tfm_memcpy(p_table->shard, backup_ref, sizeof(backup_ref));
+    }
+
+    return err;
+}
+#endif /* SST_OBJ_TABLE_SHARDS */
+
+/**
+ * \brief Makes the changes of the object table entries persistent.
+ *
+ * \param[in] idx      Indexes of the changed entries, in the order in which
+ *                     they have been changed
+ * \param[in] num_idx  Number of changed entries
+ *
+ * \note When the object table journal is enabled, the changes are appended to
+ *       the journal, unless it is full. In that case, or when the journal is
+ *       disabled, the whole object table is saved. When the object table
+ *       shards are enabled, only the shards holding the changed entries are
+ *       saved, with the object table.
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t sst_object_table_commit(const uint32_t *idx,
+                                            uint32_t num_idx)
+{
+#ifdef SST_OBJ_TABLE_JOURNAL
+    struct sst_obj_table_journal_t *journal = &sst_obj_table_ctx.journal;
+    struct sst_obj_table_record_t *record;
+    psa_status_t err;
+    uint32_t i;
+#endif
+
+#ifdef SST_TRANSACTIONS
+    if (sst_obj_table_ctx.in_transaction) {
+        /* The changes are made persistent when the transaction is
+         * committed.
+         */
+        return PSA_SUCCESS;
+    }
+#endif
+
+#ifdef SST_OBJ_TABLE_JOURNAL
+    if (journal->num_records + num_idx <= SST_OBJ_TABLE_JOURNAL_RECORDS) {
+        for (i = 0; i < num_idx; i++) {
+            record = &journal->record[journal->num_records + i];
+
+            /* Initialise the record, including its padding, as it is
+             * authenticated.
+             */
+            (void)tfm_memset(record, SST_DEFAULT_EMPTY_BUFF_VAL,
+                             sizeof(struct sst_obj_table_record_t));
+            record->idx = idx[i];
+            (void)tfm_memcpy(&record->entry,
+                             &sst_obj_table_ctx.obj_table.obj_db[idx[i]],
+                             SST_OBJECTS_TABLE_ENTRY_SIZE);
+        }
+
+        journal->num_records += num_idx;
+
+        err = sst_obj_table_journal_save(journal);
+        if (err != PSA_SUCCESS) {
+            /* Drop the records of the failed change */
+            journal->num_records -= num_idx;
+        }
+
+        return err;
+    }
+
+    /* The journal is full, so save the whole table and start a new journal
+     * which applies to it.
+     */
+    err = sst_object_table_save_table(&sst_obj_table_ctx.obj_table);
+    if (err == PSA_SUCCESS) {
+        sst_obj_table_journal_reset();
+    }
+
+    return err;
+#elif defined(SST_OBJ_TABLE_SHARDS)
+    return sst_obj_table_shards_commit(idx, num_idx);
+#else
+    (void)idx;
+    (void)num_idx;
+
+    return sst_object_table_save_table(&sst_obj_table_ctx.obj_table);
+#endif /* SST_OBJ_TABLE_JOURNAL */
+}
+
+#ifdef TFM_RESOURCE_USAGE
+/**
+ * \brief Usage of the entries of the object table, spare entries included,
+ *        reported by SPM
+ */
+static struct tfm_resource_usage_t sst_obj_table_usage = {
+    .resource_id = TFM_RESOURCE_SST_OBJECTS,
+    .capacity = SST_OBJ_TABLE_ENTRIES,
+};
+
+/**
+ * \brief Counts the used entries of the object table. The entries can be
+ *        replaced as a whole, on load or rollback, so they are counted again
+ *        after each change rather than tracked one by one.
+ */
+static void sst_object_table_update_usage(void)
+{
+    uint32_t i, used = 0;
+
+    for (i = 0; i < SST_OBJ_TABLE_ENTRIES; i++) {
+        if (sst_obj_table_ctx.obj_table.obj_db[i].uid != TFM_SST_INVALID_UID) {
+            used++;
+        }
+    }
+
+    tfm_resource_usage_set(&sst_obj_table_usage, used);
+}
+#endif /* TFM_RESOURCE_USAGE */
+
+psa_status_t sst_object_table_create(void)
+{
+    struct sst_obj_table_t *p_table = &sst_obj_table_ctx.obj_table;
+#if defined(SST_ROLLBACK_PROTECTION) || defined(SST_OBJ_TABLE_JOURNAL) || \
+    defined(SST_OBJ_TABLE_SHARDS)
+    psa_status_t err;
+#endif
+#ifdef SST_OBJ_TABLE_SHARDS
+    uint32_t shard;
+#endif
+
+#ifdef SST_ROLLBACK_PROTECTION
+    /* Initialize SST NV counters */
+    err = sst_init_nv_counter();
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+#endif
+
+#ifdef SST_OBJ_TABLE_JOURNAL
+    /* Remove the journal of the previous object table, so that it is never
+     * applied to the new one.
+     */
+    err = psa_its_remove(SST_OBJ_TABLE_JOURNAL_FS_ID);
+    if (err != PSA_SUCCESS && err != PSA_ERROR_DOES_NOT_EXIST) {
+        return err;
+    }
+#endif
+
+    /* Initialize object structure */
+    (void)tfm_memset(&sst_obj_table_ctx, SST_DEFAULT_EMPTY_BUFF_VAL,
+                     sizeof(struct sst_obj_table_ctx_t));
+
+    /* Invert the other in the context as sst_object_table_save_table will
+     * use the scratch index to create and store the current table.
      */
     sst_obj_table_ctx.active_table  = SST_OBJ_TABLE_IDX_1;
     sst_obj_table_ctx.scratch_table = SST_OBJ_TABLE_IDX_0;
 
     p_table->version = SST_OBJECT_SYSTEM_VERSION;
 
+#ifdef SST_OBJ_TABLE_INDEX
+    sst_obj_table_index_build();
+#endif
+
+#ifdef TFM_RESOURCE_USAGE
+    sst_object_table_update_usage();
+#endif
+
+#ifdef SST_OBJ_TABLE_SHARDS
+    /* Save the empty shards, which the object table refers to */
+    for (shard = 0; shard < SST_OBJ_TABLE_NUM_SHARDS; shard++) {
+        err = sst_obj_table_shard_save(shard);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+    }
+#endif
+
+#ifdef SST_OBJ_TABLE_JOURNAL
+    /* Save object table contents */
+    err = sst_object_table_save_table(p_table);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    sst_obj_table_journal_reset();
+
+    return PSA_SUCCESS;
+#else
     /* Save object table contents */
     return sst_object_table_save_table(p_table);
+#endif
 }
 
 psa_status_t sst_object_table_init(uint8_t *obj_data)
 {
     psa_status_t err;
+#ifdef SST_OBJ_TABLE_JOURNAL
+    psa_status_t journal_err;
+#endif
     struct sst_obj_table_init_ctx_t init_ctx = {
         .p_table = {&sst_obj_table_ctx.obj_table, NULL},
         .table_state = {SST_OBJ_TABLE_VALID, SST_OBJ_TABLE_VALID},
@@ -893,6 +1968,37 @@ psa_status_t sst_object_table_init(uint8_t *obj_data)
         return err;
     }
 
+#ifdef SST_OBJ_TABLE_SHARDS
+    /* Load the entries from the shards which the active table refers to */
+    err = sst_obj_table_shards_load();
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+#endif
+
+#ifdef SST_OBJ_TABLE_JOURNAL
+    /* Apply the changes made since the active table was saved. If there are
+     * none, start a new journal which applies to the active table.
+     */
+    journal_err = sst_obj_table_journal_load();
+    if (journal_err != PSA_SUCCESS) {
+        sst_obj_table_journal_reset();
+    }
+#endif
+
+#ifdef SST_OBJ_TABLE_INDEX
+    /* Build the index of the active table */
+    sst_obj_table_index_build();
+#endif
+
+#ifdef TFM_RESOURCE_USAGE
+    /* The object table is loaded again on each preparation of the system,
+     * the record is only registered the first time.
+     */
+    (void)tfm_core_resource_usage_register(&sst_obj_table_usage);
+    sst_object_table_update_usage();
+#endif
+
     /* Remove the old object table file */
     err = psa_its_remove(SST_TABLE_FS_ID(sst_obj_table_ctx.scratch_table));
     if (err != PSA_SUCCESS && err != PSA_ERROR_DOES_NOT_EXIST) {
@@ -908,8 +2014,17 @@ psa_status_t sst_object_table_init(uint8_t *obj_data)
 #endif /* SST_ROLLBACK_PROTECTION */
 
 #ifdef SST_ENCRYPTION
+#ifdef SST_OBJ_TABLE_JOURNAL
+    if (journal_err == PSA_SUCCESS) {
+        /* The journal has been saved after the active table */
+        sst_crypto_set_iv(&sst_obj_table_ctx.journal.crypto);
+    } else {
+        sst_crypto_set_iv(&sst_obj_table_ctx.obj_table.crypto);
+    }
+#else
     sst_crypto_set_iv(&sst_obj_table_ctx.obj_table.crypto);
-#endif
+#endif /* SST_OBJ_TABLE_JOURNAL */
+#endif /* SST_ENCRYPTION */
 
     return PSA_SUCCESS;
 }
@@ -969,6 +2084,8 @@ psa_status_t sst_object_table_set_obj_tbl_info(psa_storage_uid_t uid,
         .uid = TFM_SST_INVALID_UID,
         .client_id = 0,
     };
+    struct sst_obj_table_entry_t new_entry;
+    uint32_t changed_idx[2];
     struct sst_obj_table_t *p_table = &sst_obj_table_ctx.obj_table;
 
     err = sst_get_object_entry_idx(uid, client_id, &backup_idx);
@@ -984,28 +2101,45 @@ psa_status_t sst_object_table_set_obj_tbl_info(psa_storage_uid_t uid,
     }
 
     idx = SST_OBJECT_FS_ID_TO_IDX(obj_tbl_info->fid);
-    p_table->obj_db[idx].uid = uid;
-    p_table->obj_db[idx].client_id = client_id;
+
+    /* Initialise the new entry, including its padding, as the table is
+     * authenticated as a whole.
+     */
+    (void)tfm_memset(&new_entry, SST_DEFAULT_EMPTY_BUFF_VAL,
+                     SST_OBJECTS_TABLE_ENTRY_SIZE);
+    new_entry.uid = uid;
+    new_entry.client_id = client_id;
 
     /* Add new object information */
 #ifdef SST_ENCRYPTION
-    (void)tfm_memcpy(p_table->obj_db[idx].tag, obj_tbl_info->tag,
-                     SST_TAG_LEN_BYTES);
+    (void)tfm_memcpy(new_entry.tag, obj_tbl_info->tag, SST_TAG_LEN_BYTES);
 #else
-    p_table->obj_db[idx].version = obj_tbl_info->version;
+    new_entry.version = obj_tbl_info->version;
 #endif
 
-    err = sst_object_table_save_table(p_table);
+    sst_table_set_entry(idx, &new_entry);
+
+    if (backup_entry.uid != TFM_SST_INVALID_UID) {
+        changed_idx[0] = backup_idx;
+        changed_idx[1] = idx;
+        err = sst_object_table_commit(changed_idx, 2);
+    } else {
+        err = sst_object_table_commit(&idx, 1);
+    }
+
     if (err != PSA_SUCCESS) {
         if (backup_entry.uid != TFM_SST_INVALID_UID) {
             /* Rollback the change in the table */
-            (void)tfm_memcpy(&p_table->obj_db[backup_idx], &backup_entry,
-                             SST_OBJECTS_TABLE_ENTRY_SIZE);
+            sst_table_set_entry(backup_idx, &backup_entry);
         }
 
         sst_table_delete_entry(idx);
     }
 
+#ifdef TFM_RESOURCE_USAGE
+    sst_object_table_update_usage();
+#endif
+
     return err;
 }
 
@@ -1060,19 +2194,131 @@ psa_status_t sst_object_table_delete_object(psa_storage_uid_t uid,
 
     sst_table_delete_entry(backup_idx);
 
-    err = sst_object_table_save_table(p_table);
+    err = sst_object_table_commit(&backup_idx, 1);
     if (err != PSA_SUCCESS) {
        /* Rollback the change in the table */
-       (void)tfm_memcpy(&p_table->obj_db[backup_idx], &backup_entry,
-                        SST_OBJECTS_TABLE_ENTRY_SIZE);
+       sst_table_set_entry(backup_idx, &backup_entry);
     }
 
+#ifdef TFM_RESOURCE_USAGE
+    sst_object_table_update_usage();
+#endif
+
     return err;
 }
 
+psa_status_t sst_object_table_get_next_uid(int32_t client_id,
+                                           uint32_t *cursor,
+                                           psa_storage_uid_t *uid)
+{
+    uint32_t idx;
+    struct sst_obj_table_t *p_table = &sst_obj_table_ctx.obj_table;
+
+    for (idx = *cursor; idx < SST_OBJ_TABLE_ENTRIES; idx++) {
+        if (p_table->obj_db[idx].uid != TFM_SST_INVALID_UID
+            && p_table->obj_db[idx].client_id == client_id) {
+            *uid = p_table->obj_db[idx].uid;
+            *cursor = idx + 1;
+            return PSA_SUCCESS;
+        }
+    }
+
+    return PSA_ERROR_DOES_NOT_EXIST;
+}
+
 psa_status_t sst_object_table_delete_old_table(void)
 {
     uint32_t table_id = SST_TABLE_FS_ID(sst_obj_table_ctx.scratch_table);
+#ifdef SST_OBJ_TABLE_JOURNAL
+    psa_status_t err;
+#endif
+
+#ifdef SST_TRANSACTIONS
+    if (sst_obj_table_ctx.in_transaction) {
+        /* The object table has not been saved */
+        return PSA_SUCCESS;
+    }
+#endif
+
+#ifdef SST_OBJ_TABLE_JOURNAL
+    /* There is no old table when the last change went to the journal */
+    err = psa_its_remove(table_id);
+    if (err == PSA_ERROR_DOES_NOT_EXIST) {
+        return PSA_SUCCESS;
+    }
 
+    return err;
+#else
     return psa_its_remove(table_id);
+#endif
+}
+
+#ifdef SST_TRANSACTIONS
+void sst_object_table_begin_transaction(void)
+{
+    /* Keep the entries of the persistent object table, to reserve them and
+     * to restore them if the transaction is aborted.
+     */
+    (void)tfm_memcpy(sst_obj_table_ctx.txn_entries,
+                     sst_obj_table_ctx.obj_table.obj_db,
+                     sizeof(sst_obj_table_ctx.txn_entries));
+
+    sst_obj_table_ctx.in_transaction = 1;
+}
+
+psa_status_t sst_object_table_commit_transaction(void)
+{
+    struct sst_obj_table_entry_t *p_entries = sst_obj_table_ctx.txn_entries;
+    uint32_t changed_idx[SST_OBJ_TABLE_ENTRIES];
+    uint32_t num_idx = 0;
+    psa_status_t err;
+    uint32_t i;
+
+    for (i = 0; i < SST_OBJ_TABLE_ENTRIES; i++) {
+        if (tfm_memcmp(&sst_obj_table_ctx.obj_table.obj_db[i], &p_entries[i],
+                       SST_OBJECTS_TABLE_ENTRY_SIZE) != 0) {
+            changed_idx[num_idx] = i;
+            num_idx++;
+        }
+    }
+
+    sst_obj_table_ctx.in_transaction = 0;
+
+    if (num_idx == 0) {
+        /* There is nothing to make persistent */
+        return PSA_SUCCESS;
+    }
+
+    /* Make all the changes of the transaction persistent at once */
+    err = sst_object_table_commit(changed_idx, num_idx);
+    if (err != PSA_SUCCESS) {
+        /* Restore the persistent object table */
+        sst_object_table_abort_transaction();
+        return err;
+    }
+
+#ifdef SST_OBJ_TABLE_INDEX
+    /* Release the entries reserved by the transaction */
+    sst_obj_table_index_build();
+#endif
+
+    return sst_object_table_delete_old_table();
+}
+
+void sst_object_table_abort_transaction(void)
+{
+    (void)tfm_memcpy(sst_obj_table_ctx.obj_table.obj_db,
+                     sst_obj_table_ctx.txn_entries,
+                     sizeof(sst_obj_table_ctx.txn_entries));
+
+    sst_obj_table_ctx.in_transaction = 0;
+
+#ifdef SST_OBJ_TABLE_INDEX
+    sst_obj_table_index_build();
+#endif
+
+#ifdef TFM_RESOURCE_USAGE
+    sst_object_table_update_usage();
+#endif
 }
+#endif /* SST_TRANSACTIONS */
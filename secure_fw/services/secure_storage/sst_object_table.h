@@ -124,6 +124,22 @@ psa_status_t sst_object_table_get_obj_tbl_info(psa_storage_uid_t uid,
 psa_status_t sst_object_table_delete_object(psa_storage_uid_t uid,
                                             int32_t client_id);
 
+/**
+ * \brief Gets the UID of the next object of a client in the table.
+ *
+ * \param[in]     client_id  Identifier of the objects' owner (client)
+ * \param[in,out] cursor     Table entry to start the search from, 0 for the
+ *                           first entry. On success, the entry following the
+ *                           object found.
+ * \param[out]    uid        UID of the object found
+ *
+ * \return Returns PSA_ERROR_DOES_NOT_EXIST if the client has no other object.
+ *         Otherwise, it returns PSA_SUCCESS.
+ */
+psa_status_t sst_object_table_get_next_uid(int32_t client_id,
+                                           uint32_t *cursor,
+                                           psa_storage_uid_t *uid);
+
 /**
  * \brief Deletes old object table from the persistent area.
  *
@@ -131,6 +147,31 @@ psa_status_t sst_object_table_delete_object(psa_storage_uid_t uid,
  */
 psa_status_t sst_object_table_delete_old_table(void);
 
+#ifdef SST_TRANSACTIONS
+/**
+ * \brief Opens a transaction. Until it ends, the changes of the object table
+ *        are not saved, and the entries of the persistent object table are
+ *        not allocated again, so that the files they refer to are kept.
+ */
+void sst_object_table_begin_transaction(void);
+
+/**
+ * \brief Commits the open transaction. All its changes are saved at once in
+ *        the persistent area, and the old object table is deleted.
+ *
+ * \note If the changes cannot be saved, the transaction is aborted.
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+psa_status_t sst_object_table_commit_transaction(void);
+
+/**
+ * \brief Aborts the open transaction. The object table is restored to the
+ *        persistent object table.
+ */
+void sst_object_table_abort_transaction(void);
+#endif /* SST_TRANSACTIONS */
+
 #ifdef __cplusplus
 }
 #endif
@@ -9,6 +9,31 @@
 #include "sst_object_system.h"
 #include "tfm_sst_defs.h"
 
+#ifdef SST_TRANSACTIONS
+/* Whether a transaction is open, and the client which has opened it */
+static uint32_t sst_txn_open;
+static int32_t sst_txn_client_id;
+
+/**
+ * \brief Checks that a client may change its assets. While a transaction is
+ *        open, only the client which has opened it can, as all the changes
+ *        are made persistent together.
+ *
+ * \param[in] client_id  Identifier of the client
+ *
+ * \return Returns PSA_ERROR_BAD_STATE if the client may not change its assets.
+ *         Otherwise, it returns PSA_SUCCESS.
+ */
+static psa_status_t tfm_sst_check_txn_client(int32_t client_id)
+{
+    if (sst_txn_open && client_id != sst_txn_client_id) {
+        return PSA_ERROR_BAD_STATE;
+    }
+
+    return PSA_SUCCESS;
+}
+#endif /* SST_TRANSACTIONS */
+
 psa_status_t tfm_sst_init(void)
 {
     psa_status_t err;
@@ -43,16 +68,23 @@ psa_status_t tfm_sst_init(void)
     return err;
 }
 
-psa_status_t tfm_sst_set(int32_t client_id,
-                         psa_storage_uid_t uid,
-                         uint32_t data_length,
-                         psa_storage_create_flags_t create_flags)
+psa_status_t tfm_sst_check_set(int32_t client_id,
+                               psa_storage_uid_t uid,
+                               psa_storage_create_flags_t create_flags)
 {
     /* Check that the UID is valid */
     if (uid == TFM_SST_INVALID_UID) {
         return PSA_ERROR_INVALID_ARGUMENT;
     }
 
+#ifdef SST_TRANSACTIONS
+    if (tfm_sst_check_txn_client(client_id) != PSA_SUCCESS) {
+        return PSA_ERROR_BAD_STATE;
+    }
+#else
+    (void)client_id;
+#endif
+
     /* Check that the create_flags does not contain any unsupported flags */
     if (create_flags & ~(PSA_STORAGE_FLAG_WRITE_ONCE |
                          PSA_STORAGE_FLAG_NO_CONFIDENTIALITY |
@@ -60,6 +92,21 @@ psa_status_t tfm_sst_set(int32_t client_id,
         return PSA_ERROR_NOT_SUPPORTED;
     }
 
+    return PSA_SUCCESS;
+}
+
+psa_status_t tfm_sst_set(int32_t client_id,
+                         psa_storage_uid_t uid,
+                         uint32_t data_length,
+                         psa_storage_create_flags_t create_flags)
+{
+    psa_status_t err;
+
+    err = tfm_sst_check_set(client_id, uid, create_flags);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
     /* Create the object in the object system */
     return sst_object_create(uid, client_id, create_flags, data_length);
 }
@@ -101,6 +148,12 @@ psa_status_t tfm_sst_remove(int32_t client_id, psa_storage_uid_t uid)
         return PSA_ERROR_INVALID_ARGUMENT;
     }
 
+#ifdef SST_TRANSACTIONS
+    if (tfm_sst_check_txn_client(client_id) != PSA_SUCCESS) {
+        return PSA_ERROR_BAD_STATE;
+    }
+#endif
+
     /* Delete the object from the object system */
     err = sst_object_delete(uid, client_id);
 
@@ -115,6 +168,15 @@ psa_status_t tfm_sst_remove(int32_t client_id, psa_storage_uid_t uid)
     return err;
 }
 
+psa_status_t tfm_sst_list(int32_t client_id, uint32_t *cursor,
+                          size_t max_uids, size_t *uid_count)
+{
+    /* Get the UIDs from the object table of the object system */
+    sst_object_list(client_id, cursor, max_uids, uid_count);
+
+    return PSA_SUCCESS;
+}
+
 uint32_t tfm_sst_get_support(void)
 {
     /*
@@ -126,3 +188,44 @@ uint32_t tfm_sst_get_support(void)
 
     return 0;
 }
+
+psa_status_t tfm_sst_transaction(int32_t client_id, uint32_t operation)
+{
+#ifdef SST_TRANSACTIONS
+    psa_status_t err;
+
+    if (operation == TFM_SST_TRANSACTION_BEGIN) {
+        err = sst_system_begin_transaction();
+        if (err == PSA_SUCCESS) {
+            sst_txn_open = 1;
+            sst_txn_client_id = client_id;
+        }
+
+        return err;
+    }
+
+    if (operation != TFM_SST_TRANSACTION_COMMIT &&
+        operation != TFM_SST_TRANSACTION_ABORT) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    /* Only the client which has opened the transaction can end it */
+    if (!sst_txn_open || client_id != sst_txn_client_id) {
+        return PSA_ERROR_BAD_STATE;
+    }
+
+    /* The transaction ends, even if the operation fails */
+    sst_txn_open = 0;
+
+    if (operation == TFM_SST_TRANSACTION_COMMIT) {
+        return sst_system_commit_transaction();
+    } else {
+        return sst_system_abort_transaction();
+    }
+#else
+    (void)client_id;
+    (void)operation;
+
+    return PSA_ERROR_NOT_SUPPORTED;
+#endif /* SST_TRANSACTIONS */
+}
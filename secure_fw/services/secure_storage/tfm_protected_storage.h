@@ -67,6 +67,29 @@ psa_status_t tfm_sst_set(int32_t client_id,
                          psa_storage_uid_t uid,
                          uint32_t data_length,
                          psa_storage_create_flags_t create_flags);
+
+/**
+ * \brief Checks the arguments of a set request, without changing the asset.
+ *
+ * \param[in] client_id     Identifier of the asset's owner (client)
+ * \param[in] uid           Unique identifier for the data
+ * \param[in] create_flags  The flags indicating the properties of the data
+ *
+ * \return A status indicating the success/failure of the operation as specified
+ *         in \ref psa_status_t
+ *
+ * \retval PSA_SUCCESS                      The set request may be made
+ * \retval PSA_ERROR_INVALID_ARGUMENT       The uid is not valid
+ * \retval PSA_ERROR_BAD_STATE              Another client has an open
+ *                                          transaction
+ * \retval PSA_ERROR_NOT_SUPPORTED          One or more of the flags provided in
+ *                                          `create_flags` is not supported or
+ *                                          is not valid
+ */
+psa_status_t tfm_sst_check_set(int32_t client_id,
+                               psa_storage_uid_t uid,
+                               psa_storage_create_flags_t create_flags);
+
 /**
  * \brief Gets the asset data for the provided uid.
  *
@@ -162,6 +185,26 @@ psa_status_t tfm_sst_get_info(int32_t client_id, psa_storage_uid_t uid,
  */
 psa_status_t tfm_sst_remove(int32_t client_id, psa_storage_uid_t uid);
 
+/**
+ * \brief Lists the UIDs stored by a client, starting from a cursor
+ *
+ * The UIDs are written to the caller, up to \p max_uids of them.
+ *
+ * \param[in]     client_id  Identifier of the assets' owner (client)
+ * \param[in,out] cursor     TFM_STORAGE_LIST_START, or the cursor returned by
+ *                           the previous call. Set to TFM_STORAGE_LIST_END
+ *                           once all the UIDs are listed.
+ * \param[in]     max_uids   Largest number of UIDs to list
+ * \param[out]    uid_count  Number of UIDs listed
+ *
+ * \return A status indicating the success/failure of the operation as specified
+ *         in \ref psa_status_t
+ *
+ * \retval PSA_SUCCESS                    The operation completed successfully
+ */
+psa_status_t tfm_sst_list(int32_t client_id, uint32_t *cursor,
+                          size_t max_uids, size_t *uid_count);
+
 /**
  * \brief Gets a bitmask with flags set for all of the optional features
  *        supported by the implementation.
@@ -171,6 +214,32 @@ psa_status_t tfm_sst_remove(int32_t client_id, psa_storage_uid_t uid);
  */
 uint32_t tfm_sst_get_support(void);
 
+/**
+ * \brief Begins, commits or aborts the transaction of a client.
+ *
+ * \param[in] client_id  Identifier of the client
+ * \param[in] operation  Transaction operation, TFM_SST_TRANSACTION_*
+ *
+ * \return A status indicating the success/failure of the operation as specified
+ *         in \ref psa_status_t
+ *
+ * \retval PSA_SUCCESS                    The operation completed successfully
+ * \retval PSA_ERROR_BAD_STATE            The operation failed because a
+ *                                        transaction is already open, when
+ *                                        beginning one, or because the client
+ *                                        has no open transaction otherwise
+ * \retval PSA_ERROR_INVALID_ARGUMENT     The operation failed because the
+ *                                        operation is not valid
+ * \retval PSA_ERROR_NOT_SUPPORTED        The operation failed because the
+ *                                        transactions are not enabled
+ * \retval PSA_ERROR_STORAGE_FAILURE      The operation failed because the
+ *                                        physical storage has failed (fatal
+ *                                        error)
+ * \retval PSA_ERROR_GENERIC_ERROR        The operation failed because of an
+ *                                        unspecified internal failure
+ */
+psa_status_t tfm_sst_transaction(int32_t client_id, uint32_t operation);
+
 #ifdef __cplusplus
 }
 #endif
@@ -19,11 +19,318 @@
 #include "psa_manifest/tfm_secure_storage.h"
 #include "flash_layout.h"
 #endif
+#if !defined(TFM_PSA_API) || defined(SST_WRITE_BEHIND)
+#include "tfm_memory_utils.h"
+#endif
 
+#ifdef SST_WRITE_BEHIND
 #ifndef TFM_PSA_API
-#include "tfm_memory_utils.h"
+#include "flash_layout.h"
+#endif
 
-static void *p_data;
+/*!
+ * \def SST_WRITE_BEHIND_QUEUE_DEPTH
+ *
+ * \brief Number of writes that the write-behind queue holds.
+ */
+#ifndef SST_WRITE_BEHIND_QUEUE_DEPTH
+#define SST_WRITE_BEHIND_QUEUE_DEPTH 4
+#endif
+
+/*!
+ * \def SST_WRITE_BEHIND_MAX_DATA_SIZE
+ *
+ * \brief Maximum size of the data of a queued write. Larger writes are made
+ *        synchronously.
+ */
+#ifndef SST_WRITE_BEHIND_MAX_DATA_SIZE
+#define SST_WRITE_BEHIND_MAX_DATA_SIZE 64
+#endif
+
+/* States of a write-behind queue entry */
+#define SST_WB_FREE   0U /* The entry is not used */
+#define SST_WB_QUEUED 1U /* The entry holds a write which is not made yet */
+#define SST_WB_FAILED 2U /* The entry holds the error of a failed write, which
+                          * is reported when its client flushes the queue
+                          */
+
+/*!
+ * \struct sst_wb_entry_t
+ *
+ * \brief Write-behind queue entry.
+ */
+struct sst_wb_entry_t {
+    psa_storage_uid_t uid;                   /*!< Asset UID */
+    int32_t client_id;                       /*!< Client ID */
+    uint32_t state;                          /*!< Entry state, SST_WB_* */
+    uint32_t seq;                            /*!< Order of the queued write */
+    psa_storage_create_flags_t create_flags; /*!< Asset create flags */
+    uint32_t data_length;                    /*!< Size of the asset data */
+    psa_status_t status;                     /*!< Error of a failed write */
+    uint8_t data[SST_WRITE_BEHIND_MAX_DATA_SIZE]; /*!< Asset data */
+};
+
+/* Allocate the write-behind queue */
+static struct sst_wb_entry_t sst_wb_queue[SST_WRITE_BEHIND_QUEUE_DEPTH];
+
+/* Order of the next queued write */
+static uint32_t sst_wb_seq;
+
+/* Data of the queued write being made, read instead of the request data */
+static const uint8_t *p_wb_data;
+
+/**
+ * \brief Gets the queued write of an asset.
+ *
+ * \param[in] client_id  Identifier of the asset's owner (client)
+ * \param[in] uid        Unique identifier for the data
+ *
+ * \return Returns a pointer to the entry, or NULL if no write of the asset is
+ *         queued
+ */
+static struct sst_wb_entry_t *sst_wb_find(int32_t client_id,
+                                          psa_storage_uid_t uid)
+{
+    uint32_t idx;
+
+    for (idx = 0; idx < SST_WRITE_BEHIND_QUEUE_DEPTH; idx++) {
+        if (sst_wb_queue[idx].state == SST_WB_QUEUED &&
+            sst_wb_queue[idx].client_id == client_id &&
+            sst_wb_queue[idx].uid == uid) {
+            return &sst_wb_queue[idx];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * \brief Gets the oldest queued write.
+ *
+ * \return Returns a pointer to the entry, or NULL if the queue holds no write
+ */
+static struct sst_wb_entry_t *sst_wb_oldest(void)
+{
+    struct sst_wb_entry_t *oldest = NULL;
+    uint32_t idx;
+
+    for (idx = 0; idx < SST_WRITE_BEHIND_QUEUE_DEPTH; idx++) {
+        if (sst_wb_queue[idx].state == SST_WB_QUEUED &&
+            (oldest == NULL ||
+             (int32_t)(sst_wb_queue[idx].seq - oldest->seq) < 0)) {
+            oldest = &sst_wb_queue[idx];
+        }
+    }
+
+    return oldest;
+}
+
+/**
+ * \brief Makes a queued write persistent. If the write fails, the entry keeps
+ *        the error until the client flushes the queue.
+ *
+ * \param[in,out] entry  Entry of the queued write
+ */
+static void sst_wb_commit(struct sst_wb_entry_t *entry)
+{
+    psa_status_t status;
+
+    p_wb_data = entry->data;
+    status = tfm_sst_set(entry->client_id, entry->uid, entry->data_length,
+                         entry->create_flags);
+    p_wb_data = NULL;
+
+    /* Clear the asset data, which is not needed anymore */
+    (void)tfm_memset(entry->data, 0, sizeof(entry->data));
+
+    if (status == PSA_SUCCESS) {
+        entry->state = SST_WB_FREE;
+    } else {
+        entry->state = SST_WB_FAILED;
+        entry->status = status;
+    }
+}
+
+/**
+ * \brief Makes the queued write of an asset persistent, if any, before a
+ *        request accesses the asset.
+ *
+ * \param[in] client_id  Identifier of the asset's owner (client)
+ * \param[in] uid        Unique identifier for the data
+ */
+static void sst_wb_sync(int32_t client_id, psa_storage_uid_t uid)
+{
+    struct sst_wb_entry_t *entry;
+
+    entry = sst_wb_find(client_id, uid);
+    if (entry != NULL) {
+        sst_wb_commit(entry);
+    }
+}
+
+/**
+ * \brief Makes all the queued writes persistent, in the order they were
+ *        queued.
+ */
+static void sst_wb_drain(void)
+{
+    struct sst_wb_entry_t *entry;
+
+    while ((entry = sst_wb_oldest()) != NULL) {
+        sst_wb_commit(entry);
+    }
+}
+
+/**
+ * \brief Queues a write of an asset, whose data is read from the request. A
+ *        queued write of the same asset is replaced. If the data is too large
+ *        or no entry can be freed, the write is made synchronously.
+ *
+ * \param[in] client_id     Identifier of the asset's owner (client)
+ * \param[in] uid           Unique identifier for the data
+ * \param[in] data_length   The size in bytes of the data
+ * \param[in] create_flags  The flags indicating the properties of the data
+ *
+ * \return A status indicating the success/failure of the operation as specified
+ *         in \ref psa_status_t
+ */
+static psa_status_t sst_wb_set(int32_t client_id, psa_storage_uid_t uid,
+                               uint32_t data_length,
+                               psa_storage_create_flags_t create_flags)
+{
+    struct sst_wb_entry_t *entry;
+    struct sst_wb_entry_t *oldest;
+    psa_status_t err;
+    uint32_t idx;
+    uint32_t replaced;
+
+    err = tfm_sst_check_set(client_id, uid, create_flags);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    if (data_length > SST_WRITE_BEHIND_MAX_DATA_SIZE) {
+        /* Make the write synchronously, after the queued write of the asset */
+        sst_wb_sync(client_id, uid);
+        return tfm_sst_set(client_id, uid, data_length, create_flags);
+    }
+
+    entry = sst_wb_find(client_id, uid);
+    replaced = (entry != NULL);
+
+    /* Take a free entry, making the oldest queued write persistent if there
+     * is none.
+     */
+    while (entry == NULL) {
+        for (idx = 0; idx < SST_WRITE_BEHIND_QUEUE_DEPTH; idx++) {
+            if (sst_wb_queue[idx].state == SST_WB_FREE) {
+                entry = &sst_wb_queue[idx];
+                entry->seq = sst_wb_seq++;
+                break;
+            }
+        }
+
+        if (entry == NULL) {
+            oldest = sst_wb_oldest();
+            if (oldest == NULL) {
+                /* All the entries hold errors which are not reported yet */
+                break;
+            }
+            sst_wb_commit(oldest);
+        }
+    }
+
+    if (entry == NULL) {
+        return tfm_sst_set(client_id, uid, data_length, create_flags);
+    }
+
+    err = sst_req_mngr_read_asset_data(entry->data, data_length);
+    if (err != PSA_SUCCESS) {
+        (void)tfm_memset(entry->data, 0, sizeof(entry->data));
+        if (replaced) {
+            /* The replaced write is lost, so report it as failed */
+            entry->state = SST_WB_FAILED;
+            entry->status = err;
+        } else {
+            entry->state = SST_WB_FREE;
+        }
+        return err;
+    }
+
+    entry->uid = uid;
+    entry->client_id = client_id;
+    entry->create_flags = create_flags;
+    entry->data_length = data_length;
+    entry->state = SST_WB_QUEUED;
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Makes all the queued writes persistent, and reports the errors of the
+ *        failed writes of the client.
+ *
+ * \param[in] client_id  Identifier of the client
+ *
+ * \return Returns the error of the first failed write of the client since its
+ *         last flush, or PSA_SUCCESS if all its writes are persistent
+ */
+static psa_status_t sst_wb_flush(int32_t client_id)
+{
+    psa_status_t status = PSA_SUCCESS;
+    struct sst_wb_entry_t *failed = NULL;
+    uint32_t idx;
+
+    sst_wb_drain();
+
+    for (idx = 0; idx < SST_WRITE_BEHIND_QUEUE_DEPTH; idx++) {
+        if (sst_wb_queue[idx].state == SST_WB_FAILED &&
+            sst_wb_queue[idx].client_id == client_id) {
+            if (failed == NULL ||
+                (int32_t)(sst_wb_queue[idx].seq - failed->seq) < 0) {
+                failed = &sst_wb_queue[idx];
+                status = failed->status;
+            }
+        }
+    }
+
+    /* The errors are reported, so free their entries */
+    for (idx = 0; idx < SST_WRITE_BEHIND_QUEUE_DEPTH; idx++) {
+        if (sst_wb_queue[idx].state == SST_WB_FAILED &&
+            sst_wb_queue[idx].client_id == client_id) {
+            (void)tfm_memset(&sst_wb_queue[idx], 0,
+                             sizeof(struct sst_wb_entry_t));
+        }
+    }
+
+    return status;
+}
+#else /* SST_WRITE_BEHIND */
+/* Without the write-behind queue, the writes are made synchronously */
+static psa_status_t sst_wb_set(int32_t client_id, psa_storage_uid_t uid,
+                               uint32_t data_length,
+                               psa_storage_create_flags_t create_flags)
+{
+    return tfm_sst_set(client_id, uid, data_length, create_flags);
+}
+
+static psa_status_t sst_wb_flush(int32_t client_id)
+{
+    (void)client_id;
+
+    return PSA_SUCCESS;
+}
+
+static void sst_wb_sync(int32_t client_id, psa_storage_uid_t uid)
+{
+    (void)client_id;
+    (void)uid;
+}
+
+static void sst_wb_drain(void)
+{
+}
+#endif /* SST_WRITE_BEHIND */
 
 /*
  * \brief Indicates whether SST has been initialised.
@@ -33,9 +340,12 @@ static bool sst_is_init = false;
 /*
  * \brief Initialises SST, if not already initialised.
  *
- * \note In library mode, initialisation is delayed until the first secure
- *       function call, as calls to the Crypto service are required for
- *       initialisation.
+ * \note Initialisation is delayed until the first request, in both models. In
+ *       library mode, calls to the Crypto service are required for
+ *       initialisation. In both, the object table is read from flash and
+ *       authenticated, and the NV counters are aligned, which is kept out of
+ *       the boot path. A failed initialisation is tried again at the next
+ *       request.
  *
  * \return PSA_SUCCESS if SST is initialised, PSA_ERROR_GENERIC_ERROR
  *         otherwise.
@@ -52,6 +362,9 @@ static psa_status_t sst_check_init(void)
     return PSA_SUCCESS;
 }
 
+#ifndef TFM_PSA_API
+static void *p_data;
+
 psa_status_t tfm_sst_set_req(psa_invec *in_vec, size_t in_len,
                              psa_outvec *out_vec, size_t out_len)
 {
@@ -93,6 +406,8 @@ psa_status_t tfm_sst_set_req(psa_invec *in_vec, size_t in_len,
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
+    sst_wb_sync(client_id, uid);
+
     return tfm_sst_set(client_id, uid, data_length, create_flags);
 }
 
@@ -139,6 +454,8 @@ psa_status_t tfm_sst_get_req(psa_invec *in_vec, size_t in_len,
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
+    sst_wb_sync(client_id, uid);
+
     return tfm_sst_get(client_id, uid, data_offset, data_size, p_data_length);
 
 }
@@ -180,6 +497,8 @@ psa_status_t tfm_sst_get_info_req(psa_invec *in_vec, size_t in_len,
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
+    sst_wb_sync(client_id, uid);
+
     return tfm_sst_get_info(client_id, uid, p_info);
 }
 
@@ -209,7 +528,9 @@ psa_status_t tfm_sst_remove_req(psa_invec *in_vec, size_t in_len,
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
-    return tfm_sst_remove(client_id, uid);;
+    sst_wb_sync(client_id, uid);
+
+    return tfm_sst_remove(client_id, uid);
 }
 
 psa_status_t tfm_sst_get_support_req(psa_invec *in_vec, size_t in_len,
@@ -240,6 +561,162 @@ psa_status_t tfm_sst_get_support_req(psa_invec *in_vec, size_t in_len,
     return PSA_SUCCESS;
 }
 
+psa_status_t tfm_sst_transaction_req(psa_invec *in_vec, size_t in_len,
+                                     psa_outvec *out_vec, size_t out_len)
+{
+    int32_t client_id;
+    uint32_t operation;
+    int32_t tfm_status;
+
+    (void)out_vec;
+
+    if (sst_check_init() != PSA_SUCCESS) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    if ((in_len != 1) ||
+        (in_vec[0].len != sizeof(operation)) ||
+        (out_len != 0)) {
+        /* The number of arguments/input argument size are incorrect */
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    operation = *((uint32_t *)in_vec[0].base);
+
+    /* Get the caller's client ID */
+    tfm_status = tfm_core_get_caller_client_id(&client_id);
+    if (tfm_status != (int32_t)TFM_SUCCESS) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    /* Keep the queued writes out of the transaction */
+    sst_wb_drain();
+
+    return tfm_sst_transaction(client_id, operation);
+}
+
+psa_status_t tfm_sst_set_async_req(psa_invec *in_vec, size_t in_len,
+                                   psa_outvec *out_vec, size_t out_len)
+{
+    psa_storage_uid_t uid;
+    uint32_t data_length;
+    int32_t client_id;
+    int32_t status;
+    psa_storage_create_flags_t create_flags;
+
+    (void)out_vec;
+
+    if (sst_check_init() != PSA_SUCCESS) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    if ((in_len != 3) || (out_len != 0)) {
+        /* The number of arguments are incorrect */
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    if (in_vec[0].len != sizeof(psa_storage_uid_t)) {
+        /* The input argument size is incorrect */
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    uid = *((psa_storage_uid_t *)in_vec[0].base);
+
+    p_data = (void *)in_vec[1].base;
+    data_length = in_vec[1].len;
+
+    if (in_vec[2].len != sizeof(psa_storage_create_flags_t)) {
+        /* The input argument size is incorrect */
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    create_flags = *(psa_storage_create_flags_t *)in_vec[2].base;
+
+    /* Get the caller's client ID */
+    status = tfm_core_get_caller_client_id(&client_id);
+    if (status != (int32_t)TFM_SUCCESS) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    return sst_wb_set(client_id, uid, data_length, create_flags);
+}
+
+psa_status_t tfm_sst_flush_req(psa_invec *in_vec, size_t in_len,
+                               psa_outvec *out_vec, size_t out_len)
+{
+    int32_t client_id;
+    int32_t tfm_status;
+
+    (void)in_vec;
+    (void)out_vec;
+
+    if (sst_check_init() != PSA_SUCCESS) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    if ((in_len != 0) || (out_len != 0)) {
+        /* The number of arguments are incorrect */
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    /* Get the caller's client ID */
+    tfm_status = tfm_core_get_caller_client_id(&client_id);
+    if (tfm_status != (int32_t)TFM_SUCCESS) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    return sst_wb_flush(client_id);
+}
+
+psa_status_t tfm_sst_list_req(psa_invec *in_vec, size_t in_len,
+                              psa_outvec *out_vec, size_t out_len)
+{
+    psa_status_t status;
+    uint32_t cursor;
+    size_t uid_count;
+    int32_t client_id;
+    int32_t tfm_status;
+
+    if (sst_check_init() != PSA_SUCCESS) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    if ((in_len != 1) || (out_len != 2)) {
+        /* The number of arguments are incorrect */
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    if (in_vec[0].len != sizeof(cursor) ||
+        out_vec[1].len != sizeof(cursor)) {
+        /* The size of one of the arguments is incorrect */
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    cursor = *((uint32_t *)in_vec[0].base);
+
+    /* Get the caller's client ID */
+    tfm_status = tfm_core_get_caller_client_id(&client_id);
+    if (tfm_status != (int32_t)TFM_SUCCESS) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    /* The objects of the queued writes are listed once they are made */
+    sst_wb_drain();
+
+    p_data = out_vec[0].base;
+
+    status = tfm_sst_list(client_id, &cursor,
+                          out_vec[0].len / sizeof(psa_storage_uid_t),
+                          &uid_count);
+
+    out_vec[0].len = uid_count * sizeof(psa_storage_uid_t);
+    if (status == PSA_SUCCESS) {
+        *((uint32_t *)out_vec[1].base) = cursor;
+    }
+
+    return status;
+}
+
 #else /* !defined(TFM_PSA_API) */
 typedef psa_status_t (*sst_func_t)(void);
 static psa_msg_t msg;
@@ -269,6 +746,8 @@ static psa_status_t tfm_sst_set_ipc(void)
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
+    sst_wb_sync(client_id, uid);
+
     return tfm_sst_set(client_id, uid, msg.in_size[1], create_flags);
 }
 
@@ -295,6 +774,8 @@ static psa_status_t tfm_sst_get_ipc(void)
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
+    sst_wb_sync(msg.client_id, uid);
+
     return tfm_sst_get(msg.client_id, uid, data_offset,  msg.out_size[0],
                        &p_data_length);
 }
@@ -318,6 +799,8 @@ static psa_status_t tfm_sst_get_info_ipc(void)
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
+    sst_wb_sync(msg.client_id, uid);
+
     status = tfm_sst_get_info(msg.client_id, uid, &info);
 
     if (status == PSA_SUCCESS) {
@@ -341,6 +824,8 @@ static psa_status_t tfm_sst_remove_ipc(void)
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
+    sst_wb_sync(msg.client_id, uid);
+
     return tfm_sst_remove(msg.client_id, uid);
 }
 
@@ -360,6 +845,88 @@ static psa_status_t tfm_sst_get_support_ipc(void)
     return PSA_SUCCESS;
 }
 
+static psa_status_t tfm_sst_transaction_ipc(void)
+{
+    uint32_t operation;
+    size_t num = 0;
+
+    if (msg.in_size[0] != sizeof(operation)) {
+        /* The size of the argument is incorrect */
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    num = psa_read(msg.handle, 0, &operation, msg.in_size[0]);
+    if (num != msg.in_size[0]) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    /* Keep the queued writes out of the transaction */
+    sst_wb_drain();
+
+    return tfm_sst_transaction(msg.client_id, operation);
+}
+
+static psa_status_t tfm_sst_set_async_ipc(void)
+{
+    psa_storage_uid_t uid;
+    psa_storage_create_flags_t create_flags;
+    size_t num = 0;
+
+    if (msg.in_size[0] != sizeof(psa_storage_uid_t) ||
+        msg.in_size[2] != sizeof(psa_storage_create_flags_t)) {
+        /* The size of one of the arguments is incorrect */
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    num = psa_read(msg.handle, 0, &uid, msg.in_size[0]);
+    if (num != msg.in_size[0]) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    num = psa_read(msg.handle, 2, &create_flags, msg.in_size[2]);
+    if (num != msg.in_size[2]) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    return sst_wb_set(msg.client_id, uid, msg.in_size[1], create_flags);
+}
+
+static psa_status_t tfm_sst_flush_ipc(void)
+{
+    return sst_wb_flush(msg.client_id);
+}
+
+static psa_status_t tfm_sst_list_ipc(void)
+{
+    psa_status_t status;
+    uint32_t cursor;
+    size_t uid_count;
+    size_t num = 0;
+
+    if (msg.in_size[0] != sizeof(cursor) ||
+        msg.out_size[1] != sizeof(cursor)) {
+        /* The size of one of the arguments is incorrect */
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    num = psa_read(msg.handle, 0, &cursor, msg.in_size[0]);
+    if (num != msg.in_size[0]) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    /* The objects of the queued writes are listed once they are made */
+    sst_wb_drain();
+
+    status = tfm_sst_list(msg.client_id, &cursor,
+                          msg.out_size[0] / sizeof(psa_storage_uid_t),
+                          &uid_count);
+    if (status == PSA_SUCCESS) {
+        psa_write(msg.handle, 1, &cursor, sizeof(cursor));
+    }
+
+    return status;
+}
+
 /*
  * Fixme: Temporarily implement abort as infinite loop,
  * will replace it later.
@@ -380,7 +947,10 @@ static void ps_signal_handle(psa_signal_t signal, sst_func_t pfn)
         psa_reply(msg.handle, PSA_SUCCESS);
         break;
     case PSA_IPC_CALL:
-        status = pfn();
+        status = sst_check_init();
+        if (status == PSA_SUCCESS) {
+            status = pfn();
+        }
         psa_reply(msg.handle, status);
         break;
     case PSA_IPC_DISCONNECT:
@@ -397,10 +967,6 @@ psa_status_t tfm_sst_req_mngr_init(void)
 #ifdef TFM_PSA_API
     psa_signal_t signals = 0;
 
-    if (tfm_sst_init() != PSA_SUCCESS) {
-        tfm_abort();
-    }
-
     while (1) {
         signals = psa_wait(PSA_WAIT_ANY, PSA_BLOCK);
         if (signals & TFM_SST_SET_SIGNAL) {
@@ -414,20 +980,36 @@ psa_status_t tfm_sst_req_mngr_init(void)
         } else if (signals & TFM_SST_GET_SUPPORT_SIGNAL) {
             ps_signal_handle(TFM_SST_GET_SUPPORT_SIGNAL,
                              tfm_sst_get_support_ipc);
+        } else if (signals & TFM_SST_TRANSACTION_SIGNAL) {
+            ps_signal_handle(TFM_SST_TRANSACTION_SIGNAL,
+                             tfm_sst_transaction_ipc);
+        } else if (signals & TFM_SST_SET_ASYNC_SIGNAL) {
+            ps_signal_handle(TFM_SST_SET_ASYNC_SIGNAL, tfm_sst_set_async_ipc);
+        } else if (signals & TFM_SST_FLUSH_SIGNAL) {
+            ps_signal_handle(TFM_SST_FLUSH_SIGNAL, tfm_sst_flush_ipc);
+        } else if (signals & TFM_SST_LIST_SIGNAL) {
+            ps_signal_handle(TFM_SST_LIST_SIGNAL, tfm_sst_list_ipc);
         } else {
             tfm_abort();
         }
     }
 #endif
-    /* In library mode, initialisation is delayed until the first secure
-     * function call, as calls to the Crypto service are required for
-     * initialisation.
+    /* Initialisation is delayed until the first request, see
+     * sst_check_init().
      */
     return PSA_SUCCESS;
 }
 
 psa_status_t sst_req_mngr_read_asset_data(uint8_t *out_data, uint32_t size)
 {
+#ifdef SST_WRITE_BEHIND
+  if (p_wb_data != NULL) {
+      /* A queued write is being made, so read its data from the queue */
+      (void)tfm_memcpy(out_data, p_wb_data, size);
+      p_wb_data += size;
+      return PSA_SUCCESS;
+  }
+#endif
 #ifdef TFM_PSA_API
   size_t num = 0;
   num = psa_read(msg.handle, 1, out_data, size);
@@ -436,6 +1018,9 @@ psa_status_t sst_req_mngr_read_asset_data(uint8_t *out_data, uint32_t size)
   }
 #else /* TFM_PSA_API */
   (void)tfm_memcpy(out_data, p_data, size);
+
+  /* Successive calls read the following data, as psa_read does */
+  p_data = (uint8_t *)p_data + size;
 #endif
   return PSA_SUCCESS;
 }
@@ -447,5 +1032,8 @@ void sst_req_mngr_write_asset_data(const uint8_t *in_data,
   psa_write(msg.handle, 0, in_data, size);
 #else /* TFM_PSA_API */
   (void)tfm_memcpy(p_data, in_data, size);
+
+  /* Successive calls write the following data, as psa_write does */
+  p_data = (uint8_t *)p_data + size;
 #endif
 }
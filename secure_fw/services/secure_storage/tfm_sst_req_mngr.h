@@ -98,6 +98,74 @@ psa_status_t tfm_sst_remove_req(psa_invec *in_vec, size_t in_len,
 psa_status_t tfm_sst_get_support_req(psa_invec *in_vec, size_t in_len,
                                      psa_outvec *out_vec, size_t out_len);
 
+/**
+ * \brief Handles the transaction request.
+ *
+ * \param[in]  in_vec  Pointer to the input vector which contains the input
+ *                     parameters.
+ * \param[in]  in_len  Number of input parameters in the input vector.
+ * \param[out] out_vec Pointer to the ouput vector which contains the output
+ *                     parameters.
+ * \param[in]  out_len Number of output parameters in the output vector.
+ *
+ * \return A status indicating the success/failure of the operation as specified
+ *         in \ref psa_status_t
+ *
+ */
+psa_status_t tfm_sst_transaction_req(psa_invec *in_vec, size_t in_len,
+                                     psa_outvec *out_vec, size_t out_len);
+
+/**
+ * \brief Handles the asynchronous set request.
+ *
+ * \param[in]  in_vec  Pointer to the input vector which contains the input
+ *                     parameters.
+ * \param[in]  in_len  Number of input parameters in the input vector.
+ * \param[out] out_vec Pointer to the ouput vector which contains the output
+ *                     parameters.
+ * \param[in]  out_len Number of output parameters in the output vector.
+ *
+ * \return A status indicating the success/failure of the operation as specified
+ *         in \ref psa_status_t
+ *
+ */
+psa_status_t tfm_sst_set_async_req(psa_invec *in_vec, size_t in_len,
+                                   psa_outvec *out_vec, size_t out_len);
+
+/**
+ * \brief Handles the flush request.
+ *
+ * \param[in]  in_vec  Pointer to the input vector which contains the input
+ *                     parameters.
+ * \param[in]  in_len  Number of input parameters in the input vector.
+ * \param[out] out_vec Pointer to the ouput vector which contains the output
+ *                     parameters.
+ * \param[in]  out_len Number of output parameters in the output vector.
+ *
+ * \return A status indicating the success/failure of the operation as specified
+ *         in \ref psa_status_t
+ *
+ */
+psa_status_t tfm_sst_flush_req(psa_invec *in_vec, size_t in_len,
+                               psa_outvec *out_vec, size_t out_len);
+
+/**
+ * \brief Handles the list request.
+ *
+ * \param[in]  in_vec  Pointer to the input vector which contains the input
+ *                     parameters.
+ * \param[in]  in_len  Number of input parameters in the input vector.
+ * \param[out] out_vec Pointer to the ouput vector which contains the output
+ *                     parameters.
+ * \param[in]  out_len Number of output parameters in the output vector.
+ *
+ * \return A status indicating the success/failure of the operation as specified
+ *         in \ref psa_status_t
+ *
+ */
+psa_status_t tfm_sst_list_req(psa_invec *in_vec, size_t in_len,
+                              psa_outvec *out_vec, size_t out_len);
+
 /**
  * \brief Takes an input buffer containing asset data and writes
  *        its contents to the client iovec
@@ -105,6 +173,7 @@ psa_status_t tfm_sst_get_support_req(psa_invec *in_vec, size_t in_len,
  * \param[in]  in_data Pointer to the buffer data will read from.
  * \param[in]  size    The amount of data to read.
  *
+ * \note Successive calls write successive parts of the client iovec.
  *
  */
 void sst_req_mngr_write_asset_data(const uint8_t *in_data,
@@ -116,6 +185,8 @@ void sst_req_mngr_write_asset_data(const uint8_t *in_data,
  * \param[out] out_data  Pointer to the buffer data will be written to.
  * \param[in]  size      The amount of data to write.
  *
+ * \note Successive calls read successive parts of the client iovec.
+ *
  * \return A status indicating the success/failure of the operation as specified
  *         in \ref psa_status_t
  *
@@ -6,6 +6,7 @@
  */
 
 #include "psa/protected_storage.h"
+#include "tfm_sst_defs.h"
 #include "tfm_veneers.h"
 #ifdef TFM_PSA_API
 #include "psa_manifest/sid.h"
@@ -20,9 +21,6 @@ psa_status_t psa_ps_set(psa_storage_uid_t uid,
                         psa_storage_create_flags_t create_flags)
 {
     psa_status_t status;
-#ifdef TFM_PSA_API
-    psa_handle_t handle;
-#endif
 
     psa_invec in_vec[] = {
         { .base = &uid,   .len = sizeof(uid) },
@@ -31,15 +29,8 @@ psa_status_t psa_ps_set(psa_storage_uid_t uid,
     };
 
 #ifdef TFM_PSA_API
-    handle = psa_connect(TFM_SST_SET_SID, TFM_SST_SET_VERSION);
-    if (!PSA_HANDLE_IS_VALID(handle)) {
-        return PSA_ERROR_GENERIC_ERROR;
-    }
-
-    status = psa_call(handle, PSA_IPC_CALL, in_vec, IOVEC_LEN(in_vec),
-                      NULL, 0);
-
-    psa_close(handle);
+    status = psa_call(TFM_SST_SET_HANDLE, PSA_IPC_CALL,
+                      in_vec, IOVEC_LEN(in_vec), NULL, 0);
 
 #else
     status = tfm_tfm_sst_set_req_veneer(in_vec, IOVEC_LEN(in_vec),
@@ -65,9 +56,6 @@ psa_status_t psa_ps_get(psa_storage_uid_t uid,
                         size_t *p_data_length)
 {
     psa_status_t status;
-#ifdef TFM_PSA_API
-    psa_handle_t handle;
-#endif
 
     psa_invec in_vec[] = {
         { .base = &uid, .len = sizeof(uid) },
@@ -82,15 +70,8 @@ psa_status_t psa_ps_get(psa_storage_uid_t uid,
         return PSA_ERROR_INVALID_ARGUMENT;
     }
 #ifdef TFM_PSA_API
-    handle = psa_connect(TFM_SST_GET_SID, TFM_SST_GET_VERSION);
-    if (!PSA_HANDLE_IS_VALID(handle)) {
-        return PSA_ERROR_GENERIC_ERROR;
-    }
-
-    status = psa_call(handle, PSA_IPC_CALL, in_vec, IOVEC_LEN(in_vec), out_vec,
-                      IOVEC_LEN(out_vec));
-
-    psa_close(handle);
+    status = psa_call(TFM_SST_GET_HANDLE, PSA_IPC_CALL,
+                      in_vec, IOVEC_LEN(in_vec), out_vec, IOVEC_LEN(out_vec));
 
 #else
     status = tfm_tfm_sst_get_req_veneer(in_vec, IOVEC_LEN(in_vec),
@@ -116,9 +97,6 @@ psa_status_t psa_ps_get_info(psa_storage_uid_t uid,
                              struct psa_storage_info_t *p_info)
 {
     psa_status_t status;
-#ifdef TFM_PSA_API
-    psa_handle_t handle;
-#endif
 
     psa_invec in_vec[] = {
         { .base = &uid, .len = sizeof(uid) }
@@ -129,15 +107,8 @@ psa_status_t psa_ps_get_info(psa_storage_uid_t uid,
     };
 
 #ifdef TFM_PSA_API
-    handle = psa_connect(TFM_SST_GET_INFO_SID, TFM_SST_GET_INFO_VERSION);
-    if (!PSA_HANDLE_IS_VALID(handle)) {
-        return PSA_ERROR_GENERIC_ERROR;
-    }
-
-    status = psa_call(handle, PSA_IPC_CALL, in_vec, IOVEC_LEN(in_vec), out_vec,
-                      IOVEC_LEN(out_vec));
-
-    psa_close(handle);
+    status = psa_call(TFM_SST_GET_INFO_HANDLE, PSA_IPC_CALL,
+                      in_vec, IOVEC_LEN(in_vec), out_vec, IOVEC_LEN(out_vec));
 
 #else
     status = tfm_tfm_sst_get_info_req_veneer(in_vec, IOVEC_LEN(in_vec),
@@ -154,24 +125,14 @@ __attribute__((section("SFN")))
 psa_status_t psa_ps_remove(psa_storage_uid_t uid)
 {
     psa_status_t status;
-#ifdef TFM_PSA_API
-    psa_handle_t handle;
-#endif
 
     psa_invec in_vec[] = {
         { .base = &uid, .len = sizeof(uid) }
     };
 
 #ifdef TFM_PSA_API
-    handle = psa_connect(TFM_SST_REMOVE_SID, TFM_SST_REMOVE_VERSION);
-    if (!PSA_HANDLE_IS_VALID(handle)) {
-        return PSA_ERROR_GENERIC_ERROR;
-    }
-
-    status = psa_call(handle, PSA_IPC_CALL, in_vec, IOVEC_LEN(in_vec),
-                      NULL, 0);
-
-    psa_close(handle);
+    status = psa_call(TFM_SST_REMOVE_HANDLE, PSA_IPC_CALL,
+                      in_vec, IOVEC_LEN(in_vec), NULL, 0);
 
 #else
     status = tfm_tfm_sst_remove_req_veneer(in_vec, IOVEC_LEN(in_vec),
@@ -215,9 +176,6 @@ uint32_t psa_ps_get_support(void)
      * uninitialised value in case the secure function fails.
      */
     uint32_t support_flags = 0;
-#ifdef TFM_PSA_API
-    psa_handle_t handle;
-#endif
 
     psa_outvec out_vec[] = {
         { .base = &support_flags, .len = sizeof(support_flags) }
@@ -227,14 +185,9 @@ uint32_t psa_ps_get_support(void)
      * ignored.
      */
 #ifdef TFM_PSA_API
-    handle = psa_connect(TFM_SST_GET_SUPPORT_SID, TFM_SST_GET_SUPPORT_VERSION);
-    if (!PSA_HANDLE_IS_VALID(handle)) {
-        return support_flags;
-    }
-
-    (void)psa_call(handle, PSA_IPC_CALL, NULL, 0, out_vec, IOVEC_LEN(out_vec));
+    (void)psa_call(TFM_SST_GET_SUPPORT_HANDLE, PSA_IPC_CALL,
+                   NULL, 0, out_vec, IOVEC_LEN(out_vec));
 
-    psa_close(handle);
 #else
     (void)tfm_tfm_sst_get_support_req_veneer(NULL, 0,
                                              out_vec, IOVEC_LEN(out_vec));
@@ -242,3 +195,136 @@ uint32_t psa_ps_get_support(void)
 
     return support_flags;
 }
+
+/**
+ * \brief Sends an SST transaction request.
+ *
+ * \param[in] operation  Transaction operation, TFM_SST_TRANSACTION_*
+ *
+ * \return A status indicating the success/failure of the operation
+ */
+__attribute__((section("SFN")))
+static psa_status_t sst_transaction_request(uint32_t operation)
+{
+    psa_status_t status;
+
+    psa_invec in_vec[] = {
+        { .base = &operation, .len = sizeof(operation) }
+    };
+
+#ifdef TFM_PSA_API
+    status = psa_call(TFM_SST_TRANSACTION_HANDLE, PSA_IPC_CALL,
+                      in_vec, IOVEC_LEN(in_vec), NULL, 0);
+
+#else
+    status = tfm_tfm_sst_transaction_req_veneer(in_vec, IOVEC_LEN(in_vec),
+                                                NULL, 0);
+#endif
+
+    return status;
+}
+
+__attribute__((section("SFN")))
+psa_status_t psa_ps_begin_transaction(void)
+{
+    return sst_transaction_request(TFM_SST_TRANSACTION_BEGIN);
+}
+
+__attribute__((section("SFN")))
+psa_status_t psa_ps_commit_transaction(void)
+{
+    return sst_transaction_request(TFM_SST_TRANSACTION_COMMIT);
+}
+
+__attribute__((section("SFN")))
+psa_status_t psa_ps_abort_transaction(void)
+{
+    return sst_transaction_request(TFM_SST_TRANSACTION_ABORT);
+}
+
+__attribute__((section("SFN")))
+psa_status_t psa_ps_set_async(psa_storage_uid_t uid,
+                              size_t data_length,
+                              const void *p_data,
+                              psa_storage_create_flags_t create_flags)
+{
+    psa_status_t status;
+
+    psa_invec in_vec[] = {
+        { .base = &uid,   .len = sizeof(uid) },
+        { .base = p_data, .len = data_length },
+        { .base = &create_flags, .len = sizeof(create_flags) }
+    };
+
+#ifdef TFM_PSA_API
+    status = psa_call(TFM_SST_SET_ASYNC_HANDLE, PSA_IPC_CALL,
+                      in_vec, IOVEC_LEN(in_vec), NULL, 0);
+
+#else
+    status = tfm_tfm_sst_set_async_req_veneer(in_vec, IOVEC_LEN(in_vec),
+                                              NULL, 0);
+#endif
+
+   /* A parameter with a buffer pointer pointer that has data length longer
+    * than maximum permitted is treated as a secure violation.
+    * TF-M framework rejects the request with TFM_ERROR_INVALID_PARAMETER.
+    */
+    if (status == (psa_status_t)TFM_ERROR_INVALID_PARAMETER) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    return status;
+}
+
+__attribute__((section("SFN")))
+psa_status_t psa_ps_flush(void)
+{
+    psa_status_t status;
+#ifdef TFM_PSA_API
+    status = psa_call(TFM_SST_FLUSH_HANDLE, PSA_IPC_CALL,
+                      NULL, 0, NULL, 0);
+
+#else
+    status = tfm_tfm_sst_flush_req_veneer(NULL, 0, NULL, 0);
+#endif
+
+    return status;
+}
+
+__attribute__((section("SFN")))
+psa_status_t psa_ps_list(uint32_t *cursor,
+                         psa_storage_uid_t *uids,
+                         size_t max_uids,
+                         size_t *uid_count)
+{
+    psa_status_t status;
+
+    psa_invec in_vec[] = {
+        { .base = cursor, .len = sizeof(*cursor) }
+    };
+
+    psa_outvec out_vec[] = {
+        { .base = uids, .len = max_uids * sizeof(psa_storage_uid_t) },
+        { .base = cursor, .len = sizeof(*cursor) }
+    };
+
+    if ((cursor == NULL) || (uid_count == NULL)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+#ifdef TFM_PSA_API
+    status = psa_call(TFM_SST_LIST_HANDLE, PSA_IPC_CALL,
+                      in_vec, IOVEC_LEN(in_vec), out_vec, IOVEC_LEN(out_vec));
+#else
+    status = tfm_tfm_sst_list_req_veneer(in_vec, IOVEC_LEN(in_vec),
+                                       out_vec, IOVEC_LEN(out_vec));
+#endif
+
+    if (status == (psa_status_t)TFM_ERROR_INVALID_PARAMETER) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    *uid_count = out_vec[0].len / sizeof(psa_storage_uid_t);
+
+    return status;
+}
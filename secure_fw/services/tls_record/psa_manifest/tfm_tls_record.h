@@ -0,0 +1,26 @@
+/*
+ * Copyright (c) 2019, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*********** WARNING: This is an auto-generated file. Do not edit! ***********/
+
+#ifndef __PSA_MANIFEST_TFM_TLS_RECORD_H__
+#define __PSA_MANIFEST_TFM_TLS_RECORD_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TFM_TLS_RECORD_SETUP_SIGNAL                             (1U << (0 + 4))
+#define TFM_TLS_RECORD_PROTECT_SIGNAL                           (1U << (1 + 4))
+#define TFM_TLS_RECORD_UNPROTECT_SIGNAL                         (1U << (2 + 4))
+#define TFM_TLS_RECORD_ABORT_SIGNAL                             (1U << (3 + 4))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __PSA_MANIFEST_TFM_TLS_RECORD_H__ */
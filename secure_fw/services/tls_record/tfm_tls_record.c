@@ -0,0 +1,827 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "psa/client.h"
+#include "psa/service.h"
+#include "psa/crypto.h"
+#include "psa_manifest/tfm_tls_record.h"
+#include "tfm_tls_record_api.h"
+
+/* Number of connections protected at the same time */
+#ifndef TFM_TLS_RECORD_CONN_NUM
+#define TFM_TLS_RECORD_CONN_NUM     2
+#endif
+
+/* Size of the buffer the records are read through */
+#ifndef TFM_TLS_RECORD_BUF_SIZE
+#define TFM_TLS_RECORD_BUF_SIZE     256
+#endif
+
+/* Length of the nonce of the AEAD algorithms of the records */
+#define TLS_RECORD_NONCE_LENGTH     12U
+
+/* Length of the sequence number of a record */
+#define TLS_RECORD_SEQ_LENGTH       8U
+
+/* Length of the additional data of a TLS 1.2 record: the sequence number,
+ * the type, the version and the length of the plaintext, RFC 5246 section
+ * 6.2.3.3. TLS 1.3 uses the record header instead, RFC 8446 section 5.2.
+ */
+#define TLS_RECORD_AD_LENGTH        13U
+
+/* Legacy version carried by the records of both versions */
+#define TLS_RECORD_LEGACY_MAJOR     3U
+#define TLS_RECORD_LEGACY_MINOR     3U
+
+/* Type of the protected records of TLS 1.3 */
+#define TLS_RECORD_APPLICATION_DATA 23U
+
+/* Maximum length of the fragment of a protected record, RFC 5246 section
+ * 6.2.3 and RFC 8446 section 5.2
+ */
+#define TLS_RECORD_MAX_FRAGMENT_12  (TFM_TLS_RECORD_MAX_PLAINTEXT_LENGTH + 2048U)
+#define TLS_RECORD_MAX_FRAGMENT_13  (TFM_TLS_RECORD_MAX_PLAINTEXT_LENGTH + 256U)
+
+/* Longest secret of TLS 1.3, of SHA-384 */
+#define TLS_RECORD_MAX_SECRET_LENGTH PSA_HASH_SIZE(PSA_ALG_SHA_384)
+
+/* Longest label of HKDF-Expand-Label used, "tls13 key" */
+#define TLS_RECORD_LABEL_PREFIX     "tls13 "
+#define TLS_RECORD_MAX_LABEL_LENGTH 9U
+
+typedef psa_status_t (*tls_record_func_t)(const psa_msg_t *msg);
+
+/* Record protection state of a connection */
+struct tls_record_conn_t {
+    bool in_use;
+    int32_t client_id;              /* Client which set up the connection */
+    uint32_t version;               /* TFM_TLS_RECORD_VERSION_* */
+    psa_algorithm_t alg;            /* AEAD algorithm of the records */
+    psa_key_handle_t write_key;     /* Key protecting the records sent */
+    psa_key_handle_t read_key;      /* Key of the records received */
+    uint8_t iv_length;              /* 4 for AES-GCM in TLS 1.2, 12 otherwise */
+    uint8_t write_iv[TLS_RECORD_NONCE_LENGTH];
+    uint8_t read_iv[TLS_RECORD_NONCE_LENGTH];
+    uint64_t write_seq;             /* Sequence number of the next record sent */
+    uint64_t read_seq;              /* Sequence number of the next record
+                                     * received
+                                     */
+};
+
+static struct tls_record_conn_t tls_record_conn[TFM_TLS_RECORD_CONN_NUM];
+
+static uint8_t tls_record_in_buf[TFM_TLS_RECORD_BUF_SIZE];
+/* GCM can output a block held from the previous input on top of the input */
+static uint8_t tls_record_out_buf[TFM_TLS_RECORD_BUF_SIZE + 16];
+
+static size_t tls_record_min(size_t a, size_t b)
+{
+    return (a < b) ? a : b;
+}
+
+/**
+ * \brief Writes a sequence number in network byte order.
+ */
+static void tls_record_put_seq(uint64_t seq, uint8_t *buf)
+{
+    uint32_t i;
+
+    for (i = TLS_RECORD_SEQ_LENGTH; i > 0; i--) {
+        buf[i - 1] = (uint8_t)seq;
+        seq >>= 8;
+    }
+}
+
+/**
+ * \brief Builds the nonce of a record.
+ *
+ * \details For AES-GCM in TLS 1.2 the nonce is the 4 bytes IV followed by the
+ *          explicit nonce carried by the record, which is the sequence
+ *          number (RFC 5288). Otherwise it is the 12 bytes IV XORed with the
+ *          sequence number (RFC 7905, RFC 8446 section 5.3).
+ */
+static void tls_record_nonce(const struct tls_record_conn_t *conn,
+                             const uint8_t *iv, uint64_t seq, uint8_t *nonce)
+{
+    uint8_t seq_bytes[TLS_RECORD_SEQ_LENGTH];
+    uint32_t i;
+
+    tls_record_put_seq(seq, seq_bytes);
+    memcpy(nonce, iv, conn->iv_length);
+
+    if (conn->iv_length < TLS_RECORD_NONCE_LENGTH) {
+        memcpy(&nonce[conn->iv_length], seq_bytes, TLS_RECORD_SEQ_LENGTH);
+    } else {
+        for (i = 0; i < TLS_RECORD_SEQ_LENGTH; i++) {
+            nonce[TLS_RECORD_NONCE_LENGTH - TLS_RECORD_SEQ_LENGTH + i] ^=
+                                                                  seq_bytes[i];
+        }
+    }
+}
+
+/**
+ * \brief Length of the explicit nonce carried by the records of a connection.
+ */
+static size_t tls_record_explicit_length(const struct tls_record_conn_t *conn)
+{
+    return (conn->iv_length < TLS_RECORD_NONCE_LENGTH) ?
+           TFM_TLS_RECORD_EXPLICIT_NONCE_LENGTH : 0;
+}
+
+/**
+ * \brief Builds the additional data of a record.
+ *
+ * \param[in]  conn       Connection of the record
+ * \param[in]  seq        Sequence number of the record
+ * \param[in]  header     Header of the record
+ * \param[in]  length     Length of the plaintext, for TLS 1.2
+ * \param[out] ad         Buffer of \ref TLS_RECORD_AD_LENGTH bytes
+ *
+ * \return Length of the additional data
+ */
+static size_t tls_record_ad(const struct tls_record_conn_t *conn,
+                            uint64_t seq, const uint8_t *header,
+                            size_t length, uint8_t *ad)
+{
+    if (conn->version == TFM_TLS_RECORD_VERSION_1_3) {
+        memcpy(ad, header, TFM_TLS_RECORD_HEADER_LENGTH);
+        return TFM_TLS_RECORD_HEADER_LENGTH;
+    }
+
+    tls_record_put_seq(seq, ad);
+    ad[8] = header[0];
+    ad[9] = header[1];
+    ad[10] = header[2];
+    ad[11] = (uint8_t)(length >> 8);
+    ad[12] = (uint8_t)length;
+
+    return TLS_RECORD_AD_LENGTH;
+}
+
+/**
+ * \brief Finds a connection of the client of a message.
+ */
+static struct tls_record_conn_t *tls_record_find(const psa_msg_t *msg)
+{
+    uint32_t handle;
+
+    if ((msg->in_size[0] != sizeof(handle)) ||
+        (psa_read(msg->handle, 0, &handle, sizeof(handle)) !=
+         sizeof(handle))) {
+        return NULL;
+    }
+
+    if ((handle == TFM_TLS_RECORD_INVALID_HANDLE) ||
+        (handle > TFM_TLS_RECORD_CONN_NUM)) {
+        return NULL;
+    }
+
+    if (!tls_record_conn[handle - 1].in_use ||
+        (tls_record_conn[handle - 1].client_id != msg->client_id)) {
+        return NULL;
+    }
+
+    return &tls_record_conn[handle - 1];
+}
+
+static void tls_record_release(struct tls_record_conn_t *conn)
+{
+    if (conn->write_key != 0) {
+        (void)psa_destroy_key(conn->write_key);
+    }
+    if (conn->read_key != 0) {
+        (void)psa_destroy_key(conn->read_key);
+    }
+
+    memset(conn, 0, sizeof(*conn));
+}
+
+/**
+ * \brief HKDF-Expand-Label with an empty context, RFC 8446 section 7.1.
+ *
+ * \details The keys and IVs are never longer than the hash, so the output is
+ *          the first block of HKDF-Expand, one HMAC of the label.
+ */
+static psa_status_t tls_record_expand_label(psa_algorithm_t hash_alg,
+                                            const uint8_t *secret,
+                                            size_t secret_length,
+                                            const char *label,
+                                            uint8_t *out, size_t out_length)
+{
+    psa_key_attributes_t attributes = PSA_KEY_ATTRIBUTES_INIT;
+    psa_key_handle_t key = 0;
+    uint8_t info[2 + 1 + TLS_RECORD_MAX_LABEL_LENGTH + 1 + 1];
+    uint8_t block[PSA_HASH_MAX_SIZE];
+    size_t prefix_length = sizeof(TLS_RECORD_LABEL_PREFIX) - 1;
+    size_t label_length = strlen(label);
+    size_t info_length = 0;
+    size_t block_length = 0;
+    psa_status_t status;
+
+    if ((prefix_length + label_length > TLS_RECORD_MAX_LABEL_LENGTH) ||
+        (out_length > PSA_HASH_SIZE(hash_alg))) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    info[info_length++] = (uint8_t)(out_length >> 8);
+    info[info_length++] = (uint8_t)out_length;
+    info[info_length++] = (uint8_t)(prefix_length + label_length);
+    memcpy(&info[info_length], TLS_RECORD_LABEL_PREFIX, prefix_length);
+    info_length += prefix_length;
+    memcpy(&info[info_length], label, label_length);
+    info_length += label_length;
+    info[info_length++] = 0;    /* Empty context */
+    info[info_length++] = 1;    /* Counter of the first block */
+
+    psa_set_key_usage_flags(&attributes, PSA_KEY_USAGE_SIGN_HASH);
+    psa_set_key_algorithm(&attributes, PSA_ALG_HMAC(hash_alg));
+    psa_set_key_type(&attributes, PSA_KEY_TYPE_HMAC);
+
+    status = psa_import_key(&attributes, secret, secret_length, &key);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    status = psa_mac_compute(key, PSA_ALG_HMAC(hash_alg), info, info_length,
+                             block, sizeof(block), &block_length);
+    (void)psa_destroy_key(key);
+
+    if (status == PSA_SUCCESS) {
+        memcpy(out, block, out_length);
+    }
+    memset(block, 0, sizeof(block));
+
+    return status;
+}
+
+/**
+ * \brief Derives the keys and IVs of a TLS 1.2 connection from the key block,
+ *        RFC 5246 section 6.3. The keys go straight from the derivation to
+ *        key slots of the partition.
+ */
+static psa_status_t tls_record_setup_12(
+                                const struct tfm_tls_record_params *params,
+                                const psa_key_attributes_t *attributes,
+                                const uint8_t *secret,
+                                const uint8_t *randoms,
+                                psa_key_handle_t keys[2],
+                                uint8_t *ivs[2],
+                                size_t iv_length)
+{
+    static const uint8_t label[] = "key expansion";
+    psa_key_derivation_operation_t key_block =
+                                            PSA_KEY_DERIVATION_OPERATION_INIT;
+    psa_status_t status;
+    uint32_t i;
+
+    status = psa_key_derivation_setup(&key_block,
+                                      PSA_ALG_TLS12_PRF(params->hash_alg));
+    if (status == PSA_SUCCESS) {
+        status = psa_key_derivation_input_bytes(&key_block,
+                                                PSA_KEY_DERIVATION_INPUT_SEED,
+                                                randoms,
+                                                TFM_TLS_RECORD_RANDOMS_LENGTH);
+    }
+    if (status == PSA_SUCCESS) {
+        status = psa_key_derivation_input_bytes(&key_block,
+                                           PSA_KEY_DERIVATION_INPUT_SECRET,
+                                           secret,
+                                           TFM_TLS_RECORD_MASTER_SECRET_LENGTH);
+    }
+    if (status == PSA_SUCCESS) {
+        status = psa_key_derivation_input_bytes(&key_block,
+                                                PSA_KEY_DERIVATION_INPUT_LABEL,
+                                                label, sizeof(label) - 1);
+    }
+
+    /* The key block holds the client write key, the server write key, the
+     * client write IV and the server write IV.
+     */
+    for (i = 0; (i < 2) && (status == PSA_SUCCESS); i++) {
+        status = psa_key_derivation_output_key(attributes, &key_block,
+                                               &keys[i]);
+    }
+    for (i = 0; (i < 2) && (status == PSA_SUCCESS); i++) {
+        status = psa_key_derivation_output_bytes(&key_block, ivs[i],
+                                                 iv_length);
+    }
+
+    (void)psa_key_derivation_abort(&key_block);
+
+    return status;
+}
+
+/**
+ * \brief Derives the keys and IVs of a TLS 1.3 connection from the client
+ *        and server application traffic secrets, RFC 8446 section 7.3.
+ */
+static psa_status_t tls_record_setup_13(
+                                const struct tfm_tls_record_params *params,
+                                const psa_key_attributes_t *attributes,
+                                const uint8_t *secret,
+                                psa_key_handle_t keys[2],
+                                uint8_t *ivs[2])
+{
+    uint8_t key[PSA_BITS_TO_BYTES(256)];
+    size_t key_length = PSA_BITS_TO_BYTES(params->key_bits);
+    size_t secret_length = PSA_HASH_SIZE(params->hash_alg);
+    psa_status_t status = PSA_SUCCESS;
+    uint32_t i;
+
+    for (i = 0; (i < 2) && (status == PSA_SUCCESS); i++) {
+        status = tls_record_expand_label(params->hash_alg,
+                                         &secret[i * secret_length],
+                                         secret_length, "key",
+                                         key, key_length);
+        if (status == PSA_SUCCESS) {
+            status = psa_import_key(attributes, key, key_length, &keys[i]);
+        }
+        if (status == PSA_SUCCESS) {
+            status = tls_record_expand_label(params->hash_alg,
+                                             &secret[i * secret_length],
+                                             secret_length, "iv",
+                                             ivs[i], TLS_RECORD_NONCE_LENGTH);
+        }
+    }
+
+    memset(key, 0, sizeof(key));
+
+    return status;
+}
+
+static psa_status_t tls_record_setup_ipc(const psa_msg_t *msg)
+{
+    struct tfm_tls_record_params params;
+    psa_key_attributes_t attributes = PSA_KEY_ATTRIBUTES_INIT;
+    struct tls_record_conn_t *conn = NULL;
+    uint8_t secret[2 * TLS_RECORD_MAX_SECRET_LENGTH];
+    uint8_t randoms[TFM_TLS_RECORD_RANDOMS_LENGTH];
+    psa_key_handle_t keys[2] = {0, 0};
+    uint8_t *ivs[2];
+    size_t secret_length;
+    size_t randoms_length;
+    psa_key_type_t key_type;
+    psa_status_t status;
+    uint32_t handle;
+    uint32_t i;
+
+    if ((msg->in_size[0] != sizeof(params)) ||
+        (msg->out_size[0] != sizeof(handle))) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+    psa_read(msg->handle, 0, &params, sizeof(params));
+
+    if ((params.hash_alg != PSA_ALG_SHA_256) &&
+        (params.hash_alg != PSA_ALG_SHA_384)) {
+        return PSA_ERROR_NOT_SUPPORTED;
+    }
+
+    if (params.version == TFM_TLS_RECORD_VERSION_1_2) {
+        secret_length = TFM_TLS_RECORD_MASTER_SECRET_LENGTH;
+        randoms_length = TFM_TLS_RECORD_RANDOMS_LENGTH;
+    } else if (params.version == TFM_TLS_RECORD_VERSION_1_3) {
+        secret_length = 2 * PSA_HASH_SIZE(params.hash_alg);
+        randoms_length = 0;
+    } else {
+        return PSA_ERROR_NOT_SUPPORTED;
+    }
+
+    if (params.alg == PSA_ALG_GCM) {
+        if ((params.key_bits != 128) && (params.key_bits != 256)) {
+            return PSA_ERROR_INVALID_ARGUMENT;
+        }
+        key_type = PSA_KEY_TYPE_AES;
+    } else if (params.alg == PSA_ALG_CHACHA20_POLY1305) {
+        if (params.key_bits != 256) {
+            return PSA_ERROR_INVALID_ARGUMENT;
+        }
+        key_type = PSA_KEY_TYPE_CHACHA20;
+    } else {
+        return PSA_ERROR_NOT_SUPPORTED;
+    }
+
+    if ((msg->in_size[1] != secret_length) ||
+        (msg->in_size[2] != randoms_length)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    for (i = 0; i < TFM_TLS_RECORD_CONN_NUM; i++) {
+        if (!tls_record_conn[i].in_use) {
+            conn = &tls_record_conn[i];
+            break;
+        }
+    }
+    if (conn == NULL) {
+        return PSA_ERROR_INSUFFICIENT_MEMORY;
+    }
+
+    psa_read(msg->handle, 1, secret, secret_length);
+    if (randoms_length > 0) {
+        psa_read(msg->handle, 2, randoms, randoms_length);
+    }
+
+    conn->version = params.version;
+    conn->alg = params.alg;
+    conn->iv_length = ((params.version == TFM_TLS_RECORD_VERSION_1_2) &&
+                       (params.alg == PSA_ALG_GCM)) ?
+                      (TLS_RECORD_NONCE_LENGTH -
+                       TFM_TLS_RECORD_EXPLICIT_NONCE_LENGTH) :
+                      TLS_RECORD_NONCE_LENGTH;
+
+    psa_set_key_usage_flags(&attributes,
+                            PSA_KEY_USAGE_ENCRYPT | PSA_KEY_USAGE_DECRYPT);
+    psa_set_key_algorithm(&attributes, params.alg);
+    psa_set_key_type(&attributes, key_type);
+    psa_set_key_bits(&attributes, params.key_bits);
+
+    /* Both versions derive the client material first */
+    ivs[0] = params.is_server ? conn->read_iv : conn->write_iv;
+    ivs[1] = params.is_server ? conn->write_iv : conn->read_iv;
+
+    if (params.version == TFM_TLS_RECORD_VERSION_1_2) {
+        status = tls_record_setup_12(&params, &attributes, secret, randoms,
+                                     keys, ivs, conn->iv_length);
+    } else {
+        status = tls_record_setup_13(&params, &attributes, secret, keys, ivs);
+    }
+
+    memset(secret, 0, sizeof(secret));
+
+    conn->write_key = params.is_server ? keys[1] : keys[0];
+    conn->read_key = params.is_server ? keys[0] : keys[1];
+
+    if (status != PSA_SUCCESS) {
+        tls_record_release(conn);
+        return status;
+    }
+
+    conn->in_use = true;
+    conn->client_id = msg->client_id;
+
+    handle = (uint32_t)(conn - tls_record_conn) + 1;
+    psa_write(msg->handle, 0, &handle, sizeof(handle));
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Encrypts the next bytes of a record from an input vector, or from
+ *        \p data if it is not NULL, and writes the ciphertext to the record.
+ */
+static psa_status_t tls_record_encrypt(const psa_msg_t *msg,
+                                       psa_aead_operation_t *op,
+                                       const uint8_t *data, size_t length)
+{
+    size_t chunk;
+    size_t out_length;
+    psa_status_t status;
+
+    while (length > 0) {
+        chunk = tls_record_min(length, sizeof(tls_record_in_buf));
+        if (data != NULL) {
+            memcpy(tls_record_in_buf, data, chunk);
+        } else if (psa_read(msg->handle, 2, tls_record_in_buf, chunk) !=
+                   chunk) {
+            return PSA_ERROR_INVALID_ARGUMENT;
+        }
+
+        status = psa_aead_update(op, tls_record_in_buf, chunk,
+                                 tls_record_out_buf,
+                                 sizeof(tls_record_out_buf), &out_length);
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+        psa_write(msg->handle, 0, tls_record_out_buf, out_length);
+        length -= chunk;
+    }
+
+    return PSA_SUCCESS;
+}
+
+static psa_status_t tls_record_protect_ipc(const psa_msg_t *msg)
+{
+    psa_aead_operation_t op = PSA_AEAD_OPERATION_INIT;
+    struct tls_record_conn_t *conn;
+    uint8_t header[TFM_TLS_RECORD_HEADER_LENGTH];
+    uint8_t explicit[TFM_TLS_RECORD_EXPLICIT_NONCE_LENGTH];
+    uint8_t nonce[TLS_RECORD_NONCE_LENGTH];
+    uint8_t ad[TLS_RECORD_AD_LENGTH];
+    uint8_t tag[TFM_TLS_RECORD_TAG_LENGTH];
+    size_t plaintext_length = msg->in_size[2];
+    size_t inner_length;
+    size_t explicit_length;
+    size_t fragment_length;
+    size_t ad_length;
+    size_t out_length;
+    size_t tag_length;
+    uint8_t content_type;
+    psa_status_t status;
+
+    conn = tls_record_find(msg);
+    if (conn == NULL) {
+        return PSA_ERROR_INVALID_HANDLE;
+    }
+
+    if ((msg->in_size[1] != sizeof(content_type)) ||
+        (plaintext_length > TFM_TLS_RECORD_MAX_PLAINTEXT_LENGTH)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+    psa_read(msg->handle, 1, &content_type, sizeof(content_type));
+
+    /* The sequence number must not wrap, RFC 5246 section 6.1 */
+    if (conn->write_seq == UINT64_MAX) {
+        return PSA_ERROR_BAD_STATE;
+    }
+
+    /* TLS 1.3 protects the content type with the plaintext */
+    inner_length = plaintext_length +
+                   ((conn->version == TFM_TLS_RECORD_VERSION_1_3) ? 1 : 0);
+    explicit_length = tls_record_explicit_length(conn);
+    fragment_length = explicit_length + inner_length +
+                      TFM_TLS_RECORD_TAG_LENGTH;
+    if (msg->out_size[0] < TFM_TLS_RECORD_HEADER_LENGTH + fragment_length) {
+        return PSA_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    header[0] = (conn->version == TFM_TLS_RECORD_VERSION_1_3) ?
+                TLS_RECORD_APPLICATION_DATA : content_type;
+    header[1] = TLS_RECORD_LEGACY_MAJOR;
+    header[2] = TLS_RECORD_LEGACY_MINOR;
+    header[3] = (uint8_t)(fragment_length >> 8);
+    header[4] = (uint8_t)fragment_length;
+
+    tls_record_nonce(conn, conn->write_iv, conn->write_seq, nonce);
+    ad_length = tls_record_ad(conn, conn->write_seq, header, plaintext_length,
+                              ad);
+
+    status = psa_aead_encrypt_setup(&op, conn->write_key, conn->alg);
+    if (status == PSA_SUCCESS) {
+        status = psa_aead_set_nonce(&op, nonce, sizeof(nonce));
+    }
+    if (status == PSA_SUCCESS) {
+        status = psa_aead_set_lengths(&op, ad_length, inner_length);
+    }
+    if (status == PSA_SUCCESS) {
+        status = psa_aead_update_ad(&op, ad, ad_length);
+    }
+    if (status != PSA_SUCCESS) {
+        (void)psa_aead_abort(&op);
+        return status;
+    }
+
+    psa_write(msg->handle, 0, header, sizeof(header));
+    if (explicit_length > 0) {
+        /* The sequence number is the explicit nonce of AES-GCM */
+        tls_record_put_seq(conn->write_seq, explicit);
+        psa_write(msg->handle, 0, explicit, explicit_length);
+    }
+
+    status = tls_record_encrypt(msg, &op, NULL, plaintext_length);
+    if ((status == PSA_SUCCESS) &&
+        (conn->version == TFM_TLS_RECORD_VERSION_1_3)) {
+        status = tls_record_encrypt(msg, &op, &content_type,
+                                    sizeof(content_type));
+    }
+    if (status == PSA_SUCCESS) {
+        status = psa_aead_finish(&op, tls_record_out_buf,
+                                 sizeof(tls_record_out_buf), &out_length,
+                                 tag, sizeof(tag), &tag_length);
+    }
+    if (status != PSA_SUCCESS) {
+        (void)psa_aead_abort(&op);
+        return status;
+    }
+
+    psa_write(msg->handle, 0, tls_record_out_buf, out_length);
+    psa_write(msg->handle, 0, tag, tag_length);
+
+    conn->write_seq++;
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Keeps the position and the value of the last non-zero byte of the
+ *        inner plaintext of a TLS 1.3 record, which is its content type.
+ */
+static void tls_record_scan(const uint8_t *data, size_t length, size_t offset,
+                            size_t *type_offset, uint8_t *type)
+{
+    size_t i;
+
+    for (i = length; i > 0; i--) {
+        if (data[i - 1] != 0) {
+            *type_offset = offset + i - 1;
+            *type = data[i - 1];
+            return;
+        }
+    }
+}
+
+static psa_status_t tls_record_unprotect_ipc(const psa_msg_t *msg)
+{
+    psa_aead_operation_t op = PSA_AEAD_OPERATION_INIT;
+    struct tls_record_conn_t *conn;
+    uint8_t header[TFM_TLS_RECORD_HEADER_LENGTH];
+    uint8_t explicit[TFM_TLS_RECORD_EXPLICIT_NONCE_LENGTH];
+    uint8_t nonce[TLS_RECORD_NONCE_LENGTH];
+    uint8_t ad[TLS_RECORD_AD_LENGTH];
+    uint8_t tag[TFM_TLS_RECORD_TAG_LENGTH];
+    size_t record_length = msg->in_size[1];
+    size_t explicit_length;
+    size_t fragment_length;
+    size_t ciphertext_length;
+    size_t max_fragment;
+    size_t min_inner;
+    size_t ad_length;
+    size_t out_length;
+    size_t written = 0;
+    size_t type_offset = SIZE_MAX;
+    size_t chunk;
+    uint32_t plaintext_length;
+    uint8_t content_type = 0;
+    psa_status_t status;
+    bool is_13;
+
+    conn = tls_record_find(msg);
+    if (conn == NULL) {
+        return PSA_ERROR_INVALID_HANDLE;
+    }
+
+    if ((msg->out_size[0] != sizeof(content_type)) ||
+        (msg->out_size[1] != sizeof(plaintext_length))) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (conn->read_seq == UINT64_MAX) {
+        return PSA_ERROR_BAD_STATE;
+    }
+
+    is_13 = (conn->version == TFM_TLS_RECORD_VERSION_1_3);
+    explicit_length = tls_record_explicit_length(conn);
+    max_fragment = is_13 ? TLS_RECORD_MAX_FRAGMENT_13 :
+                           TLS_RECORD_MAX_FRAGMENT_12;
+    /* The inner plaintext of TLS 1.3 holds at least the content type */
+    min_inner = is_13 ? 1 : 0;
+
+    /* The record must be whole and of the version of the connection */
+    if (record_length < TFM_TLS_RECORD_HEADER_LENGTH + explicit_length +
+                        min_inner + TFM_TLS_RECORD_TAG_LENGTH) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+    psa_read(msg->handle, 1, header, sizeof(header));
+    fragment_length = ((size_t)header[3] << 8) | header[4];
+    if ((header[1] != TLS_RECORD_LEGACY_MAJOR) ||
+        (header[2] != TLS_RECORD_LEGACY_MINOR) ||
+        (is_13 && (header[0] != TLS_RECORD_APPLICATION_DATA)) ||
+        (fragment_length != record_length - TFM_TLS_RECORD_HEADER_LENGTH) ||
+        (fragment_length > max_fragment)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    ciphertext_length = fragment_length - explicit_length -
+                        TFM_TLS_RECORD_TAG_LENGTH;
+    if (msg->out_size[2] < ciphertext_length) {
+        return PSA_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    if (explicit_length > 0) {
+        psa_read(msg->handle, 1, explicit, explicit_length);
+    }
+
+    tls_record_nonce(conn, conn->read_iv, conn->read_seq, nonce);
+    ad_length = tls_record_ad(conn, conn->read_seq, header, ciphertext_length,
+                              ad);
+
+    status = psa_aead_decrypt_setup(&op, conn->read_key, conn->alg);
+    if (status == PSA_SUCCESS) {
+        status = psa_aead_set_nonce(&op, nonce, sizeof(nonce));
+    }
+    if (status == PSA_SUCCESS) {
+        status = psa_aead_set_lengths(&op, ad_length, ciphertext_length);
+    }
+    if (status == PSA_SUCCESS) {
+        status = psa_aead_update_ad(&op, ad, ad_length);
+    }
+
+    while ((status == PSA_SUCCESS) && (ciphertext_length > 0)) {
+        chunk = tls_record_min(ciphertext_length, sizeof(tls_record_in_buf));
+        psa_read(msg->handle, 1, tls_record_in_buf, chunk);
+        status = psa_aead_update(&op, tls_record_in_buf, chunk,
+                                 tls_record_out_buf,
+                                 sizeof(tls_record_out_buf), &out_length);
+        if (status == PSA_SUCCESS) {
+            tls_record_scan(tls_record_out_buf, out_length, written,
+                            &type_offset, &content_type);
+            psa_write(msg->handle, 2, tls_record_out_buf, out_length);
+            written += out_length;
+            ciphertext_length -= chunk;
+        }
+    }
+
+    if (status == PSA_SUCCESS) {
+        psa_read(msg->handle, 1, tag, sizeof(tag));
+        status = psa_aead_verify(&op, tls_record_out_buf,
+                                 sizeof(tls_record_out_buf), &out_length,
+                                 tag, sizeof(tag));
+    }
+    if (status != PSA_SUCCESS) {
+        (void)psa_aead_abort(&op);
+        return status;
+    }
+
+    tls_record_scan(tls_record_out_buf, out_length, written, &type_offset,
+                    &content_type);
+    psa_write(msg->handle, 2, tls_record_out_buf, out_length);
+    written += out_length;
+
+    if (is_13) {
+        /* An inner plaintext of padding only is not valid, RFC 8446
+         * section 5.4
+         */
+        if ((type_offset == SIZE_MAX) ||
+            (type_offset > TFM_TLS_RECORD_MAX_PLAINTEXT_LENGTH)) {
+            return PSA_ERROR_INVALID_ARGUMENT;
+        }
+        plaintext_length = (uint32_t)type_offset;
+    } else {
+        content_type = header[0];
+        plaintext_length = (uint32_t)written;
+    }
+
+    conn->read_seq++;
+
+    psa_write(msg->handle, 0, &content_type, sizeof(content_type));
+    psa_write(msg->handle, 1, &plaintext_length, sizeof(plaintext_length));
+
+    return PSA_SUCCESS;
+}
+
+static psa_status_t tls_record_abort_ipc(const psa_msg_t *msg)
+{
+    struct tls_record_conn_t *conn;
+
+    conn = tls_record_find(msg);
+    if (conn != NULL) {
+        tls_record_release(conn);
+    }
+
+    /* The connection does not exist, so abort has no effect */
+    return PSA_SUCCESS;
+}
+
+static void tls_record_signal_handle(psa_signal_t signal,
+                                     tls_record_func_t pfn)
+{
+    psa_msg_t msg;
+    psa_status_t status;
+
+    status = psa_get(signal, &msg);
+    if (status != PSA_SUCCESS) {
+        return;
+    }
+
+    switch (msg.type) {
+    case PSA_IPC_CONNECT:
+    case PSA_IPC_DISCONNECT:
+        psa_reply(msg.handle, PSA_SUCCESS);
+        break;
+    case PSA_IPC_CALL:
+        psa_reply(msg.handle, pfn(&msg));
+        break;
+    default:
+        psa_panic();
+    }
+}
+
+void tfm_tls_record_init(void)
+{
+    psa_signal_t signals;
+
+    while (1) {
+        signals = psa_wait(PSA_WAIT_ANY, PSA_BLOCK);
+        if (signals & TFM_TLS_RECORD_SETUP_SIGNAL) {
+            tls_record_signal_handle(TFM_TLS_RECORD_SETUP_SIGNAL,
+                                     tls_record_setup_ipc);
+        } else if (signals & TFM_TLS_RECORD_PROTECT_SIGNAL) {
+            tls_record_signal_handle(TFM_TLS_RECORD_PROTECT_SIGNAL,
+                                     tls_record_protect_ipc);
+        } else if (signals & TFM_TLS_RECORD_UNPROTECT_SIGNAL) {
+            tls_record_signal_handle(TFM_TLS_RECORD_UNPROTECT_SIGNAL,
+                                     tls_record_unprotect_ipc);
+        } else if (signals & TFM_TLS_RECORD_ABORT_SIGNAL) {
+            tls_record_signal_handle(TFM_TLS_RECORD_ABORT_SIGNAL,
+                                     tls_record_abort_ipc);
+        } else {
+            psa_panic();
+        }
+    }
+}
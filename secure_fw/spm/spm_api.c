@@ -17,9 +17,12 @@
 #include "tfm_api.h"
 #include "tfm_nspm.h"
 #include "tfm_core.h"
+#include "tfm_utils.h"
 #include "tfm_peripherals_def.h"
 #include "spm_partition_defs.h"
 #include "psa/lifecycle.h"
+#include "tfm_spm_stats.h"
+#include "tfm_spm_profile.h"
 
 #define NON_SECURE_INTERNAL_PARTITION_DB_IDX 0
 #define TFM_CORE_INTERNAL_PARTITION_DB_IDX   1
@@ -46,17 +49,18 @@ uint32_t get_partition_idx(uint32_t partition_id)
 
 enum spm_err_t tfm_spm_db_init(void)
 {
-    uint32_t i;
+    /*
+     * This function initialises partition db. The descriptors are linked to
+     * the partition db at compile time, only the runtime data is set here.
+     */
 
-    /* This function initialises partition db */
+#ifndef TFM_PSA_API
+    uint32_t i;
 
     /* For the non secure Execution environment */
-#ifndef TFM_PSA_API
     tfm_nspm_configure_clients();
-#endif
 
     for (i = 0; i < g_spm_partition_db.partition_count; i++) {
-#ifndef TFM_PSA_API
         g_spm_partition_db.partitions[i].runtime_data.partition_state =
             SPM_PARTITION_STATE_UNINIT;
         g_spm_partition_db.partitions[i].runtime_data.caller_partition_idx =
@@ -65,14 +69,17 @@ enum spm_err_t tfm_spm_db_init(void)
             TFM_INVALID_CLIENT_ID;
         g_spm_partition_db.partitions[i].runtime_data.ctx_stack_ptr =
             ctx_stack_list[i];
+    }
 #endif /* !defined(TFM_PSA_API) */
-        g_spm_partition_db.partitions[i].static_data = &static_data_list[i];
-        g_spm_partition_db.partitions[i].platform_data_list =
-                                                     platform_data_list_list[i];
-#ifdef TFM_PSA_API
-        g_spm_partition_db.partitions[i].memory_data = &memory_data_list[i];
+
+#ifdef TFM_SPM_STATS
+    tfm_spm_stats_init();
 #endif
-    }
+
+#ifdef TFM_SPM_PROFILE
+    tfm_spm_profile_init();
+#endif
+
     g_spm_partition_db.is_init = 1;
 
     return SPM_ERR_OK;
@@ -120,14 +127,21 @@ __attribute__((section("SFN")))
 void tfm_spm_partition_change_privilege(uint32_t privileged)
 {
     CONTROL_Type ctrl;
+    uint32_t npriv;
 
     ctrl.w = __get_CONTROL();
 
     if (privileged == TFM_PARTITION_PRIVILEGED_MODE) {
-        ctrl.b.nPRIV = 0;
+        npriv = 0;
     } else {
-        ctrl.b.nPRIV = 1;
+        npriv = 1;
     }
 
-    __set_CONTROL(ctrl.w);
+    /* Consecutive partitions often run in the same mode, in which case the
+     * CONTROL register is left untouched.
+     */
+    if (ctrl.b.nPRIV != npriv) {
+        ctrl.b.nPRIV = npriv;
+        __set_CONTROL(ctrl.w);
+    }
 }
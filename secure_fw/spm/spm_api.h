@@ -13,6 +13,9 @@
 #include "spm_partition_defs.h"
 #include "tfm_secure_api.h"
 #include <stdbool.h>
+#ifdef TFM_SPM_STATS
+#include "tfm_spm_stats_defs.h"
+#endif
 #ifdef TFM_PSA_API
 #include "tfm_list.h"
 #include "tfm_wait.h"
@@ -47,6 +50,18 @@ enum spm_err_t {
 #define SPM_PART_FLAG_APP_ROT 0x01
 #define SPM_PART_FLAG_PSA_ROT 0x02
 #define SPM_PART_FLAG_IPC     0x04
+#define SPM_PART_FLAG_SFN     0x08
+#define SPM_PART_FLAG_INIT_LAZY         0x10
+#define SPM_PART_FLAG_INIT_BACKGROUND   0x20
+
+/*
+ * Initialization state of a partition thread, with TFM_DEFERRED_INIT. The
+ * partitions without a thread stay in the zero state.
+ */
+#define SPM_INIT_STATE_DONE         0   /* Has waited for signals            */
+#define SPM_INIT_STATE_RUNNING      1   /* Started at its own priority       */
+#define SPM_INIT_STATE_BACKGROUND   2   /* Started at the priority of NSPE   */
+#define SPM_INIT_STATE_PENDING      3   /* Not started until first requested */
 
 #define TFM_HANDLE_STATUS_IDLE          0
 #define TFM_HANDLE_STATUS_ACTIVE        1
@@ -83,6 +98,37 @@ struct handler_ctx_stack_frame_t {
 };
 #endif /* !define(TFM_PSA_API) */
 
+/* Statistics of the SPM idle state */
+struct tfm_spm_idle_info_t {
+    uint32_t entry_count;               /* Number of times SPM went idle     */
+    uint32_t last_wake_latency;         /* Reported latency of the last wake */
+    uint32_t max_wake_latency;          /* Worst reported wake latency       */
+};
+
+#ifdef TFM_MEM_CHECK_CACHE
+#define TFM_MEM_CHECK_CACHE_ENTRIES         4
+
+/* A memory region the partition has been granted access to */
+struct tfm_mem_check_cache_entry_t {
+    uintptr_t base;                     /* First byte of the region          */
+    uintptr_t limit;                    /* Last byte of the region           */
+    uint32_t attr;                      /* Access granted, 0 if unused       */
+};
+
+/* Regions recently validated by tfm_memory_check() for a partition */
+struct tfm_mem_check_cache_t {
+    struct tfm_mem_check_cache_entry_t entries[TFM_MEM_CHECK_CACHE_ENTRIES];
+    uint32_t next;                      /* Entry to be replaced next         */
+};
+#endif /* TFM_MEM_CHECK_CACHE */
+
+#ifdef TFM_MAILBOX_NS_WINDOWS
+/* Number of NS shared memory windows registered at the same time */
+#ifndef TFM_NS_WINDOW_ENTRIES
+#define TFM_NS_WINDOW_ENTRIES               4
+#endif
+#endif
+
 /**
  * \brief Runtime context information of a partition
  */
@@ -92,7 +138,23 @@ struct spm_partition_runtime_data_t {
     uint32_t signals;                   /* Service signals had been triggered*/
     struct tfm_list_node_t service_list;/* Service list                      */
     struct tfm_core_thread_t sp_thrd;   /* Thread object                     */
-    uint32_t assigned_signals;          /* All assigned signals              */
+#ifdef TFM_MEM_CHECK_CACHE
+    struct tfm_mem_check_cache_t mem_check_cache;/* Validated regions        */
+#endif
+#ifdef TFM_SFN_PARTITIONS
+    struct tfm_msg_body_t *sfn_top;     /*
+                                         * Last request to a secure function
+                                         * running on the partition thread
+                                         */
+    struct tfm_msg_body_t *sfn_msg;     /*
+                                         * Request handled by the secure
+                                         * functions of an SFN partition
+                                         */
+    bool sfn_init_done;                 /* The SFN partition is initialised  */
+#endif
+#ifdef TFM_DEFERRED_INIT
+    uint32_t init_state;                /* SPM_INIT_STATE_*                  */
+#endif
 #else /* TFM_PSA_API */
     uint32_t partition_state;
     uint32_t caller_partition_idx;
@@ -116,6 +178,65 @@ struct spm_partition_runtime_data_t {
 
 #define TFM_CONN_HANDLE_MAX_NUM         16
 
+/*
+ * Static handles of stateless RoT Services are derived from the SID. Bit 30
+ * marks a static handle, which is never a valid connection handle address.
+ * Keep aligned with tools/tfm_parse_manifest_list.py.
+ */
+#define TFM_STATELESS_HANDLE_INDICATOR  0x40000000U
+#define TFM_STATELESS_HANDLE_SID_MASK   0x00FFFFFFU
+
+#define TFM_HANDLE_IS_STATELESS(handle)                                  \
+    (((uint32_t)(handle) & ~TFM_STATELESS_HANDLE_SID_MASK) ==            \
+                                              TFM_STATELESS_HANDLE_INDICATOR)
+#define TFM_STATELESS_HANDLE_TO_SID(handle)                              \
+    ((uint32_t)(handle) & TFM_STATELESS_HANDLE_SID_MASK)
+
+/* Largest number of requests in a batch submitted by psa_call_batch() */
+#ifndef TFM_BATCH_MAX_CALLS
+#define TFM_BATCH_MAX_CALLS             8
+#endif
+
+/* Number of batches delivered at the same time */
+#ifndef TFM_BATCH_MAX_NUM
+#define TFM_BATCH_MAX_NUM               2
+#endif
+
+/* Request of a batch, copied out of the client memory once it is checked */
+struct tfm_batch_req_t {
+    int32_t type;                       /* Request type                      */
+    size_t in_len;                      /* Number of input vectors           */
+    size_t out_len;                     /* Number of output vectors          */
+    psa_invec in_vec[PSA_MAX_IOVEC];    /* Checked input vectors             */
+    psa_outvec out_vec[PSA_MAX_IOVEC];  /* Checked output vectors            */
+    psa_outvec *caller_outvec;          /* Client output vectors, which get
+                                         * the written lengths
+                                         */
+};
+
+/* Checked requests of a batch, owned by SPM until the batch is complete */
+struct tfm_batch_reqs_t {
+    bool in_use;                        /* Holds the requests of a batch     */
+    struct tfm_batch_req_t req[TFM_BATCH_MAX_CALLS];
+};
+
+/* Batch of requests submitted to a connection by psa_call_batch() */
+struct tfm_conn_batch_t {
+    psa_batch_call_t *calls;            /* Client requests, NULL if no batch */
+    struct tfm_batch_reqs_t *reqs;      /* Checked requests                  */
+    size_t num_calls;                   /* Number of requests in the batch   */
+    size_t idx;                         /* Request handled by the service    */
+};
+
+#ifdef TFM_PSA_ASYNC_CALL
+/* Asynchronous call submitted to a connection by psa_call_async() */
+struct tfm_conn_async_t {
+    bool pending;                       /* Call submitted, not replied yet   */
+    bool done;                          /* Status not collected yet          */
+    psa_status_t status;                /* Status replied by the service     */
+};
+#endif
+
 /* RoT connection handle list */
 struct tfm_conn_handle_t {
     void *rhandle;                      /* Reverse handle value              */
@@ -135,6 +256,10 @@ struct tfm_conn_handle_t {
     struct tfm_msg_body_t internal_msg; /* Internal message for message queue */
     struct tfm_spm_service_t *service;  /* RoT service pointer               */
     struct tfm_list_node_t list;        /* list node                         */
+    struct tfm_conn_batch_t batch;      /* Batch being delivered             */
+#ifdef TFM_PSA_ASYNC_CALL
+    struct tfm_conn_async_t async;      /* Asynchronous call state           */
+#endif
 };
 
 /* Service database defined by manifest */
@@ -144,8 +269,24 @@ struct tfm_spm_service_db_t {
     psa_signal_t signal;            /* Service signal                        */
     uint32_t sid;                   /* Service identifier                    */
     bool non_secure_client;         /* If can be called by non secure client */
+    bool connection_based;          /*
+                                     * False for a stateless service, which
+                                     * is called through its static handle
+                                     */
     uint32_t version;               /* Service version                       */
     uint32_t version_policy;        /* Service version policy                */
+#ifdef TFM_SFN_PARTITIONS
+    psa_status_t (*sfn)(const psa_msg_t *msg);/*
+                                     * Secure function of a service of an SFN
+                                     * partition, NULL otherwise
+                                     */
+#endif
+};
+
+/* SID index entry, the generated index is sorted by SID in ascending order */
+struct tfm_spm_service_sid_idx_t {
+    uint32_t sid;                   /* Service identifier                    */
+    uint32_t service_idx;           /* Service index in service database     */
 };
 
 /* RoT Service data */
@@ -158,6 +299,13 @@ struct tfm_spm_service_t {
     struct tfm_list_node_t handle_list;      /* Service handle list          */
     struct tfm_msg_queue_t msg_queue;        /* Message queue                */
     struct tfm_list_node_t list;             /* For list operation           */
+#ifdef TFM_SPM_STATS
+    uint32_t stats_requests;                 /* Messages replied to          */
+    uint64_t stats_cycles;                   /*
+                                              * Cycles from psa_get() to
+                                              * psa_reply() of the messages
+                                              */
+#endif
 };
 #endif /* ifdef(TFM_PSA_API) */
 
@@ -381,6 +529,22 @@ void tfm_spm_partition_cleanup_context(uint32_t partition_idx);
  */
 void tfm_spm_partition_set_signal_mask(uint32_t partition_idx,
                                        uint32_t signal_mask);
+
+#ifdef TFM_SFN_TRUSTED_CALLS
+/**
+ * \brief Check whether a partition declares another partition as a trusted
+ *        callee in its manifest
+ *
+ * \param[in] partition_idx  Partition index of the caller
+ * \param[in] callee_id      Partition ID of the partition to be called
+ *
+ * \return true if the callee is trusted by the partition, false otherwise
+ *
+ * \note This function doesn't check if partition_idx is valid.
+ */
+bool tfm_spm_partition_is_trusted_callee(uint32_t partition_idx,
+                                         uint32_t callee_id);
+#endif /* TFM_SFN_TRUSTED_CALLS */
 #endif /* !defined(TFM_PSA_API) */
 
 #ifdef TFM_PSA_API
@@ -408,6 +572,31 @@ uint32_t tfm_spm_partition_get_stack_bottom(uint32_t partition_idx);
  */
 uint32_t tfm_spm_partition_get_stack_top(uint32_t partition_idx);
 
+#ifdef TFM_STACK_WATERMARK
+/* Value of the unused words of a partition stack */
+#define TFM_STACK_WATERMARK_PATTERN 0xCDCDCDCDU
+
+/**
+ * \brief Get the maximum stack usage of a partition
+ *
+ * \param[in] partition_idx     Partition index
+ *
+ * \return The number of bytes of the stack region used since the SPM
+ *         initialisation, found as the lowest word which no longer holds
+ *         \ref TFM_STACK_WATERMARK_PATTERN.
+ *
+ * \note This function doesn't check if partition_idx is valid. The usage of
+ *       the non-secure partition, whose stack is in use when the SPM paints
+ *       the stacks, is not tracked and reported as 0.
+ */
+uint32_t tfm_spm_partition_get_stack_watermark(uint32_t partition_idx);
+
+/**
+ * \brief Print the maximum stack usage and the stack size of each partition
+ */
+void tfm_spm_stack_watermark_log(void);
+#endif /* TFM_STACK_WATERMARK */
+
 /**
  * \brief   Get the running partition ID.
  *
@@ -498,6 +687,18 @@ void *tfm_spm_get_rhandle(struct tfm_spm_service_t *service,
  */
 struct spm_partition_desc_t *tfm_spm_get_running_partition(void);
 
+#ifdef TFM_SFN_PARTITIONS
+/**
+ * \brief                   Get the partition owning the running thread. It
+ *                          differs from the running partition while the thread
+ *                          runs the secure function of an SFN partition.
+ *
+ * \return                  The partition context pointer,
+ *                          \ref spm_partition_desc_t structures
+ */
+struct spm_partition_desc_t *tfm_spm_get_thread_partition(void);
+#endif
+
 /**
  * \brief                   Get the service context by signal.
  *
@@ -598,6 +799,43 @@ void tfm_spm_fill_msg(struct tfm_msg_body_t *msg,
                       psa_outvec *outvec, size_t out_len,
                       psa_outvec *caller_outvec);
 
+#ifdef TFM_MAILBOX_SG
+/**
+ * \brief                   Set the client vectors of a message filled by
+ *                          \ref tfm_spm_fill_msg from scatter-gather segment
+ *                          lists. The segments must have been checked.
+ *
+ * \param[in] msg           Service Message Queue buffer pointer
+ * \param[in] in_segs       Segments of all the input vectors
+ * \param[in] in_nr_segs    Number of segments of each input vector
+ * \param[in] in_len        Number of input vectors
+ * \param[in] out_segs      Segments of all the output vectors
+ * \param[in] out_nr_segs   Number of segments of each output vector
+ * \param[in] out_len       Number of output vectors
+ * \param[in] out_written   Caller buffer for the written lengths
+ */
+void tfm_spm_fill_msg_sg(struct tfm_msg_body_t *msg,
+                         const psa_invec *in_segs, const size_t *in_nr_segs,
+                         size_t in_len,
+                         psa_outvec *out_segs, const size_t *out_nr_segs,
+                         size_t out_len, size_t *out_written);
+#endif
+
+/**
+ * \brief                   Queue message and wake up the SP who is waiting on
+ *                          message queue, without blocking the current thread
+ *
+ * \param[in] service       Target service context pointer, which can be
+ *                          obtained by partition management functions
+ * \param[in] msg           message created by tfm_spm_create_msg()
+ *                          \ref tfm_msg_body_t structures
+ *
+ * \retval IPC_SUCCESS      Success
+ * \retval IPC_ERROR_GENERIC Failed to enqueue message to service message queue
+ */
+int32_t tfm_spm_queue_msg(struct tfm_spm_service_t *service,
+                          struct tfm_msg_body_t *msg);
+
 /**
  * \brief                   Send message and wake up the SP who is waiting on
  *                          message queue, block the current thread and
@@ -615,6 +853,75 @@ void tfm_spm_fill_msg(struct tfm_msg_body_t *msg,
 int32_t tfm_spm_send_event(struct tfm_spm_service_t *service,
                            struct tfm_msg_body_t *msg);
 
+#ifdef TFM_MSG_QUEUE_PRIORITY
+/**
+ * \brief                   Drop the priority a partition inherited from the
+ *                          messages it has handled
+ *
+ * \param[in] partition     Partition descriptor
+ *
+ * \note                    The partition keeps the priority of the most
+ *                          urgent message still pending for its services.
+ */
+void tfm_spm_partition_restore_priority(struct spm_partition_desc_t *partition);
+#endif
+
+#ifdef TFM_DEFERRED_INIT
+/**
+ * \brief                   Make sure a partition with a deferred
+ *                          initialization completes it, as a signal is
+ *                          asserted for it
+ *
+ * \param[in] partition     Partition descriptor
+ *
+ * \note                    The thread of a lazy partition is started, and a
+ *                          background partition is given its own priority.
+ */
+void tfm_spm_partition_demand(struct spm_partition_desc_t *partition);
+
+/**
+ * \brief                   Mark the initialization of the running partition
+ *                          as done, as it waits for signals
+ *
+ * \param[in] partition     Partition descriptor
+ */
+void tfm_spm_partition_init_done(struct spm_partition_desc_t *partition);
+#endif
+
+/**
+ * \brief                   Enter the SPM idle state until an interrupt is
+ *                          pending
+ *
+ * \note                    Called when no secure partition is ready to run.
+ *                          The wake-up latencies are those reported by
+ *                          tfm_spm_hal_enter_idle(), in microseconds.
+ */
+void tfm_spm_idle(void);
+
+/**
+ * \brief                   Get the statistics of the SPM idle state
+ *
+ * \param[out] info         Filled with the statistics,
+ *                          \ref tfm_spm_idle_info_t structures
+ */
+void tfm_spm_get_idle_info(struct tfm_spm_idle_info_t *info);
+
+#ifdef TFM_SPM_STATS
+/**
+ * \brief                   Copy the load statistics of the RoT Services
+ *
+ * \param[out] entries      Buffer to hold the statistics
+ * \param[in] first         Index of the first RoT Service to copy
+ * \param[in] num           Number of entries the buffer can hold
+ *
+ * \return                  Number of entries copied
+ *
+ * \note                    The caller must have checked the buffer.
+ */
+uint32_t tfm_spm_get_service_stats(struct tfm_spm_service_stats_t *entries,
+                                   uint32_t first, uint32_t num);
+#endif
+
 /**
  * \brief                   Check the client version according to
  *                          version policy
@@ -665,6 +972,49 @@ int32_t tfm_memory_check(const void *buffer, size_t len, bool ns_caller,
                          enum tfm_memory_access_e access,
                          uint32_t privileged);
 
+#ifdef TFM_MEM_CHECK_CACHE
+/**
+ * \brief                   Drop the memory access decisions cached by
+ *                          tfm_memory_check() for a partition
+ *
+ * \param[in] partition     Partition descriptor, NULL for all partitions
+ *
+ * \note                    Call it whenever the isolation hardware is
+ *                          reconfigured for the partition.
+ */
+void tfm_spm_mem_check_cache_invalidate(struct spm_partition_desc_t *partition);
+#endif
+
+#ifdef TFM_MAILBOX_NS_WINDOWS
+/**
+ * \brief                   Register a window of non-secure memory shared with
+ *                          SPE. The window is checked once here, then
+ *                          tfm_memory_check() accepts any NS client buffer
+ *                          within it with a bounds check.
+ *
+ * \param[in] base          Base address of the window
+ * \param[in] len           Length of the window in bytes
+ * \param[in] access        Access granted to the buffers within the window,
+ *                          \ref tfm_memory_access_e
+ *
+ * \retval >0                            ID of the window
+ * \retval PSA_ERROR_INVALID_ARGUMENT    NS clients cannot access the window
+ * \retval PSA_ERROR_INSUFFICIENT_MEMORY All the windows are in use
+ */
+int32_t tfm_spm_ns_window_register(const void *base, size_t len,
+                                   enum tfm_memory_access_e access);
+
+/**
+ * \brief                   Unregister a window of non-secure memory
+ *
+ * \param[in] window_id     ID returned by \ref tfm_spm_ns_window_register
+ *
+ * \retval PSA_SUCCESS               Success
+ * \retval PSA_ERROR_DOES_NOT_EXIST  No window is registered with this ID
+ */
+int32_t tfm_spm_ns_window_unregister(int32_t window_id);
+#endif
+
 /*
  * PendSV specified function.
  *
@@ -19,6 +19,7 @@
 #include "tfm_nspm.h"
 #include "tfm_memory_utils.h"
 #include "tfm_internal.h"
+#include "tfm_spm_stats.h"
 
 extern struct spm_partition_db_t g_spm_partition_db;
 
@@ -179,6 +180,9 @@ void tfm_spm_partition_set_state(uint32_t partition_idx, uint32_t state)
     if (state == SPM_PARTITION_STATE_RUNNING ||
         state == SPM_PARTITION_STATE_HANDLING_IRQ) {
         g_spm_partition_db.running_partition_idx = partition_idx;
+#ifdef TFM_SPM_STATS
+        tfm_spm_stats_switch(partition_idx);
+#endif
     }
 }
 
@@ -196,6 +200,24 @@ void tfm_spm_partition_set_signal_mask(uint32_t partition_idx,
             signal_mask = signal_mask;
 }
 
+#ifdef TFM_SFN_TRUSTED_CALLS
+bool tfm_spm_partition_is_trusted_callee(uint32_t partition_idx,
+                                         uint32_t callee_id)
+{
+    const struct spm_partition_static_data_t *static_data =
+            g_spm_partition_db.partitions[partition_idx].static_data;
+    uint32_t i;
+
+    for (i = 0; i < static_data->trusted_callees_num; ++i) {
+        if (static_data->p_trusted_callees[i] == callee_id) {
+            return true;
+        }
+    }
+
+    return false;
+}
+#endif /* TFM_SFN_TRUSTED_CALLS */
+
 void tfm_spm_partition_set_caller_client_id(uint32_t partition_idx,
                                             int32_t caller_client_id)
 {
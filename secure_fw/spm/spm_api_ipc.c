@@ -30,17 +30,30 @@
 #include "tfm_memory_utils.h"
 #include "tfm_core_utils.h"
 #include "tfm_rpc.h"
-#include "tfm_irq_list.h"
+#include "tfm_ipc_trace.h"
+#include "tfm_spm_stats.h"
+#include "tfm_resource_usage.h"
+#ifdef TFM_BOOT_TIME
+#include "tfm_internal.h"
+#include "tfm_boot_time_defs.h"
+#endif
+#ifdef TFM_STACK_WATERMARK
+#include "log/tfm_log.h"
+#endif
 
 #include "secure_fw/services/tfm_service_list.inc"
 
 /* Extern service variable */
 extern struct tfm_spm_service_t service[];
 extern const struct tfm_spm_service_db_t service_db[];
+extern const struct tfm_spm_service_sid_idx_t service_sid_idx[];
 
 /* Extern SPM variable */
 extern struct spm_partition_db_t g_spm_partition_db;
 
+/* Statistics of the SPM idle state */
+static struct tfm_spm_idle_info_t spm_idle_info;
+
 /* Pools */
 TFM_POOL_DECLARE(conn_handle_pool, sizeof(struct tfm_conn_handle_t),
                  TFM_CONN_HANDLE_MAX_NUM);
@@ -64,6 +77,11 @@ psa_handle_t tfm_spm_create_conn_handle(struct tfm_spm_service_t *service,
     p_handle->service = service;
     p_handle->status = TFM_HANDLE_STATUS_IDLE;
     p_handle->client_id = client_id;
+    p_handle->batch.calls = NULL;
+#ifdef TFM_PSA_ASYNC_CALL
+    p_handle->async.pending = false;
+    p_handle->async.done = false;
+#endif
 
     /* Add handle node to list for next psa functions */
     tfm_list_add_tail(&service->handle_list, &p_handle->list);
@@ -71,6 +89,7 @@ psa_handle_t tfm_spm_create_conn_handle(struct tfm_spm_service_t *service,
     return (psa_handle_t)p_handle;
 }
 
+TFM_HOT_CODE
 int32_t tfm_spm_validate_conn_handle(psa_handle_t conn_handle,
                                      int32_t client_id)
 {
@@ -183,31 +202,22 @@ struct tfm_spm_service_t *
     return NULL;
 }
 
+TFM_HOT_CODE
 struct tfm_spm_service_t *tfm_spm_get_service_by_sid(uint32_t sid)
 {
-    uint32_t i;
-    struct tfm_list_node_t *node, *head;
-    struct tfm_spm_service_t *service;
-    struct spm_partition_desc_t *partition;
-
-    for (i = 0; i < g_spm_partition_db.partition_count; i++) {
-        partition = &g_spm_partition_db.partitions[i];
-        /* Skip partition without IPC flag */
-        if ((tfm_spm_partition_get_flags(i) & SPM_PART_FLAG_IPC) == 0) {
-            continue;
-        }
-
-        if (tfm_list_is_empty(&partition->runtime_data.service_list)) {
-            continue;
-        }
-
-        head = &partition->runtime_data.service_list;
-        TFM_LIST_FOR_EACH(node, head) {
-            service = TFM_GET_CONTAINER_PTR(node, struct tfm_spm_service_t,
-                                            list);
-            if (service->service_db->sid == sid) {
-                return service;
-            }
+    uint32_t low, high, mid;
+
+    /* The SID index is generated in ascending order, binary search it */
+    low = 0;
+    high = sizeof(service_sid_idx) / sizeof(service_sid_idx[0]);
+    while (low < high) {
+        mid = low + (high - low) / 2;
+        if (service_sid_idx[mid].sid == sid) {
+            return &service[service_sid_idx[mid].service_idx];
+        } else if (service_sid_idx[mid].sid < sid) {
+            low = mid + 1;
+        } else {
+            high = mid;
         }
     }
     return NULL;
@@ -229,6 +239,7 @@ struct spm_partition_desc_t *tfm_spm_get_partition_by_id(int32_t partition_id)
     return NULL;
 }
 
+TFM_HOT_CODE
 struct spm_partition_desc_t *tfm_spm_get_running_partition(void)
 {
     uint32_t spid;
@@ -293,6 +304,7 @@ int32_t tfm_spm_check_authorization(uint32_t sid,
 }
 
 /* Message functions */
+TFM_HOT_CODE
 struct tfm_msg_body_t *tfm_spm_get_msg_from_handle(psa_handle_t msg_handle)
 {
     /*
@@ -350,6 +362,7 @@ struct tfm_msg_body_t *
     return &(((struct tfm_conn_handle_t *)conn_handle)->internal_msg);
 }
 
+TFM_HOT_CODE
 void tfm_spm_fill_msg(struct tfm_msg_body_t *msg,
                       struct tfm_spm_service_t *service,
                       psa_handle_t handle,
@@ -384,6 +397,10 @@ void tfm_spm_fill_msg(struct tfm_msg_body_t *msg,
     for (i = 0; i < in_len; i++) {
         msg->msg.in_size[i] = invec[i].len;
         msg->invec[i].base = invec[i].base;
+#ifdef TFM_MAILBOX_SG
+        /* The vector is a single segment */
+        msg->invec[i].len = invec[i].len;
+#endif
     }
 
     for (i = 0; i < out_len; i++) {
@@ -391,6 +408,9 @@ void tfm_spm_fill_msg(struct tfm_msg_body_t *msg,
         msg->outvec[i].base = outvec[i].base;
         /* Out len is used to record the writed number, set 0 here again */
         msg->outvec[i].len = 0;
+#ifdef TFM_MAILBOX_SG
+        msg->sg.out_cur[i] = outvec[i];
+#endif
     }
 
     /* Use message address as handle */
@@ -407,8 +427,57 @@ void tfm_spm_fill_msg(struct tfm_msg_body_t *msg,
     }
 }
 
-int32_t tfm_spm_send_event(struct tfm_spm_service_t *service,
-                           struct tfm_msg_body_t *msg)
+#ifdef TFM_MAILBOX_SG
+void tfm_spm_fill_msg_sg(struct tfm_msg_body_t *msg,
+                         const psa_invec *in_segs, const size_t *in_nr_segs,
+                         size_t in_len,
+                         psa_outvec *out_segs, const size_t *out_nr_segs,
+                         size_t out_len, size_t *out_written)
+{
+    uint32_t i, j;
+
+    TFM_CORE_ASSERT(msg);
+    TFM_CORE_ASSERT(in_len + out_len <= PSA_MAX_IOVEC);
+
+    /* The first segment is the current one, the others are left */
+    for (i = 0; i < in_len; i++) {
+        msg->msg.in_size[i] = 0;
+        for (j = 0; j < in_nr_segs[i]; j++) {
+            msg->msg.in_size[i] += in_segs[j].len;
+        }
+
+        if (in_nr_segs[i] != 0) {
+            msg->invec[i] = in_segs[0];
+            msg->sg.in_segs[i] = &in_segs[1];
+            msg->sg.in_nr_segs[i] = in_nr_segs[i] - 1;
+        }
+        in_segs += in_nr_segs[i];
+    }
+
+    for (i = 0; i < out_len; i++) {
+        msg->msg.out_size[i] = 0;
+        for (j = 0; j < out_nr_segs[i]; j++) {
+            msg->msg.out_size[i] += out_segs[j].len;
+        }
+
+        if (out_nr_segs[i] != 0) {
+            msg->outvec[i].base = out_segs[0].base;
+            msg->outvec[i].len = 0;
+            msg->sg.out_cur[i] = out_segs[0];
+            msg->sg.out_segs[i] = &out_segs[1];
+            msg->sg.out_nr_segs[i] = out_nr_segs[i] - 1;
+        }
+        out_segs += out_nr_segs[i];
+    }
+
+    msg->sg.out_len = out_len;
+    msg->sg.out_written = out_written;
+}
+#endif
+
+TFM_HOT_CODE
+int32_t tfm_spm_queue_msg(struct tfm_spm_service_t *service,
+                          struct tfm_msg_body_t *msg)
 {
     struct spm_partition_runtime_data_t *p_runtime_data =
                                             &service->partition->runtime_data;
@@ -421,12 +490,60 @@ int32_t tfm_spm_send_event(struct tfm_spm_service_t *service,
         return IPC_ERROR_GENERIC;
     }
 
+#ifdef TFM_DEFERRED_INIT
+    if (p_runtime_data->init_state != SPM_INIT_STATE_DONE) {
+        tfm_spm_partition_demand(service->partition);
+    }
+#endif
+
+#ifdef TFM_MSG_QUEUE_PRIORITY
+    /*
+     * The partition inherits the priority of the message so that threads of
+     * lower priority than the client cannot delay it.
+     */
+    if (msg->prior < (p_runtime_data->sp_thrd.prior & THRD_PRIOR_MASK)) {
+        tfm_core_thrd_change_priority(&p_runtime_data->sp_thrd, msg->prior);
+    }
+#endif
+
     /* Messages put. Update signals */
     p_runtime_data->signals |= service->service_db->signal;
 
     tfm_event_wake(&p_runtime_data->signal_evnt, (p_runtime_data->signals &
                                                   p_runtime_data->signal_mask));
 
+    return IPC_SUCCESS;
+}
+
+TFM_HOT_CODE
+int32_t tfm_spm_send_event(struct tfm_spm_service_t *service,
+                           struct tfm_msg_body_t *msg)
+{
+#ifdef TFM_SFN_PARTITIONS
+    /* Requests to a secure function are not queued, see tfm_sfn_call() */
+    if (service->service_db->sfn) {
+        return IPC_ERROR_GENERIC;
+    }
+#endif
+
+#ifdef TFM_MSG_QUEUE_PRIORITY
+    /*
+     * The message takes the priority of the client thread. Requests of the
+     * NSPE via RPC are not bound to a thread and have the lowest priority.
+     */
+    if (is_tfm_rpc_msg(msg)) {
+        msg->prior = THRD_PRIOR_LOWEST;
+    } else {
+        msg->prior = tfm_core_thrd_get_curr_thread()->prior;
+    }
+#endif
+
+    TFM_IPC_TRACE_POINT(TFM_IPC_TRACE_SEND_EVENT, service->service_db->sid);
+
+    if (tfm_spm_queue_msg(service, msg) != IPC_SUCCESS) {
+        return IPC_ERROR_GENERIC;
+    }
+
     /*
      * If it is a NS request via RPC, it is unnecessary to block current
      * thread.
@@ -449,6 +566,87 @@ uint32_t tfm_spm_partition_get_stack_top(uint32_t partition_idx)
     return g_spm_partition_db.partitions[partition_idx].memory_data->stack_top;
 }
 
+#ifdef TFM_STACK_WATERMARK
+/**
+ * \brief Fills the stack region of a partition with
+ *        TFM_STACK_WATERMARK_PATTERN. Must be called before the thread of the
+ *        partition is initialised.
+ */
+static void tfm_spm_partition_paint_stack(uint32_t partition_idx)
+{
+    uint32_t *p = (uint32_t *)tfm_spm_partition_get_stack_bottom(
+                                                                partition_idx);
+    uint32_t *top = (uint32_t *)tfm_spm_partition_get_stack_top(partition_idx);
+
+    while (p < top) {
+        *p++ = TFM_STACK_WATERMARK_PATTERN;
+    }
+}
+
+uint32_t tfm_spm_partition_get_stack_watermark(uint32_t partition_idx)
+{
+    const uint32_t *p = (const uint32_t *)tfm_spm_partition_get_stack_bottom(
+                                                                partition_idx);
+    const uint32_t *top =
+              (const uint32_t *)tfm_spm_partition_get_stack_top(partition_idx);
+
+    if (tfm_spm_partition_get_partition_id(partition_idx) ==
+        TFM_SP_NON_SECURE_ID) {
+        return 0;
+    }
+
+    /* The stack grows down, so the lowest word written is the high-water */
+    while (p < top && *p == TFM_STACK_WATERMARK_PATTERN) {
+        p++;
+    }
+
+    return (uint32_t)((uintptr_t)top - (uintptr_t)p);
+}
+
+void tfm_spm_stack_watermark_log(void)
+{
+    uint32_t i;
+
+    LOG_MSG("Partition stack usage (partition ID, used, size in bytes):\r\n");
+    for (i = 0; i < g_spm_partition_db.partition_count; i++) {
+        if (tfm_spm_partition_get_partition_id(i) == TFM_SP_NON_SECURE_ID) {
+            continue;
+        }
+        LOG_MSG("STACK,%d,%d,%d\r\n",
+                (int)tfm_spm_partition_get_partition_id(i),
+                (int)tfm_spm_partition_get_stack_watermark(i),
+                (int)(tfm_spm_partition_get_stack_top(i) -
+                      tfm_spm_partition_get_stack_bottom(i)));
+    }
+}
+#endif /* TFM_STACK_WATERMARK */
+
+#ifdef TFM_SFN_PARTITIONS
+TFM_HOT_CODE
+struct spm_partition_desc_t *tfm_spm_get_thread_partition(void)
+{
+    struct tfm_core_thread_t *pth = tfm_core_thrd_get_curr_thread();
+    struct spm_partition_runtime_data_t *r_data;
+
+    r_data = TFM_GET_CONTAINER_PTR(pth, struct spm_partition_runtime_data_t,
+                                   sp_thrd);
+    return TFM_GET_CONTAINER_PTR(r_data, struct spm_partition_desc_t,
+                                 runtime_data);
+}
+
+TFM_HOT_CODE
+uint32_t tfm_spm_partition_get_running_partition_id(void)
+{
+    struct spm_partition_desc_t *partition = tfm_spm_get_thread_partition();
+
+    /* The thread runs the secure function of the last request made on it */
+    if (partition->runtime_data.sfn_top) {
+        partition = partition->runtime_data.sfn_top->service->partition;
+    }
+    return partition->static_data->partition_id;
+}
+#else /* TFM_SFN_PARTITIONS */
+TFM_HOT_CODE
 uint32_t tfm_spm_partition_get_running_partition_id(void)
 {
     struct tfm_core_thread_t *pth = tfm_core_thrd_get_curr_thread();
@@ -461,6 +659,7 @@ uint32_t tfm_spm_partition_get_running_partition_id(void)
                                       runtime_data);
     return partition->static_data->partition_id;
 }
+#endif /* TFM_SFN_PARTITIONS */
 
 static struct tfm_core_thread_t *
     tfm_spm_partition_get_thread_info(uint32_t partition_idx)
@@ -481,11 +680,253 @@ static uint32_t tfm_spm_partition_get_priority(uint32_t partition_idx)
                     partition_priority;
 }
 
+#ifdef TFM_MSG_QUEUE_PRIORITY
+void tfm_spm_partition_restore_priority(struct spm_partition_desc_t *partition)
+{
+    struct tfm_spm_service_t *service;
+    struct tfm_list_node_t *node;
+    uint32_t prior = partition->static_data->partition_priority;
+
+    /* Keep the priority of the most urgent message still pending */
+    TFM_LIST_FOR_EACH(node, &partition->runtime_data.service_list) {
+        service = TFM_GET_CONTAINER_PTR(node, struct tfm_spm_service_t, list);
+        if (!tfm_msg_queue_is_empty(&service->msg_queue) &&
+            service->msg_queue.head->prior < prior) {
+            prior = service->msg_queue.head->prior;
+        }
+    }
+
+    tfm_core_thrd_change_priority(&partition->runtime_data.sp_thrd, prior);
+}
+#endif
+
+#ifdef TFM_DEFERRED_INIT
+void tfm_spm_partition_demand(struct spm_partition_desc_t *partition)
+{
+    struct tfm_core_thread_t *pth = &partition->runtime_data.sp_thrd;
+
+    switch (partition->runtime_data.init_state) {
+    case SPM_INIT_STATE_PENDING:
+        partition->runtime_data.init_state = SPM_INIT_STATE_RUNNING;
+        if (tfm_core_thrd_start(pth) != THRD_SUCCESS) {
+            tfm_core_panic();
+        }
+        tfm_core_thrd_activate_schedule();
+        break;
+    case SPM_INIT_STATE_BACKGROUND:
+        /* A client waits for the partition, which must not wait for NSPE */
+        partition->runtime_data.init_state = SPM_INIT_STATE_RUNNING;
+        tfm_core_thrd_change_priority(pth,
+                                  partition->static_data->partition_priority);
+        tfm_core_thrd_activate_schedule();
+        break;
+    default:
+        break;
+    }
+}
+
+void tfm_spm_partition_init_done(struct spm_partition_desc_t *partition)
+{
+    if (partition->runtime_data.init_state == SPM_INIT_STATE_BACKGROUND) {
+        tfm_core_thrd_change_priority(&partition->runtime_data.sp_thrd,
+                                  partition->static_data->partition_priority);
+    }
+    partition->runtime_data.init_state = SPM_INIT_STATE_DONE;
+}
+#endif
+
+#ifdef TFM_MEM_CHECK_CACHE
+#define MEM_CHECK_CACHE_ATTR_VALID      (1U << 0)
+#define MEM_CHECK_CACHE_ATTR_RW         (1U << 1)
+#define MEM_CHECK_CACHE_ATTR_NS         (1U << 2)
+#define MEM_CHECK_CACHE_ATTR_UNPRIV     (1U << 3)
+
+/*
+ * Get the cache of the running partition, NULL if the decision about this
+ * access must not be cached.
+ */
+TFM_HOT_CODE
+static struct tfm_mem_check_cache_t *mem_check_cache_get(bool ns_caller,
+                                                        uint32_t privileged)
+{
+    struct tfm_core_thread_t *pth = tfm_core_thrd_get_curr_thread();
+    struct spm_partition_runtime_data_t *r_data;
+
+#ifndef TFM_MULTI_CORE_TOPOLOGY
+    /* NSPE can reprogram its own MPU at any time without notifying SPM */
+    if (ns_caller) {
+        return NULL;
+    }
+#endif
+
+    if (!pth || (privileged != TFM_PARTITION_PRIVILEGED_MODE &&
+                 privileged != TFM_PARTITION_UNPRIVILEGED_MODE)) {
+        return NULL;
+    }
+
+    r_data = TFM_GET_CONTAINER_PTR(pth, struct spm_partition_runtime_data_t,
+                                   sp_thrd);
+    return &r_data->mem_check_cache;
+}
+
+TFM_HOT_CODE
+static uint32_t mem_check_cache_attr(bool ns_caller,
+                                     enum tfm_memory_access_e access,
+                                     uint32_t privileged)
+{
+    uint32_t attr = MEM_CHECK_CACHE_ATTR_VALID;
+
+    if (access == TFM_MEMORY_ACCESS_RW) {
+        attr |= MEM_CHECK_CACHE_ATTR_RW;
+    }
+    if (ns_caller) {
+        attr |= MEM_CHECK_CACHE_ATTR_NS;
+    }
+    if (privileged == TFM_PARTITION_UNPRIVILEGED_MODE) {
+        attr |= MEM_CHECK_CACHE_ATTR_UNPRIV;
+    }
+
+    return attr;
+}
+
+TFM_HOT_CODE
+static bool mem_check_cache_lookup(const struct tfm_mem_check_cache_t *cache,
+                                   uintptr_t base, uintptr_t limit,
+                                   uint32_t attr)
+{
+    const struct tfm_mem_check_cache_entry_t *entry;
+    uint32_t i;
+
+    for (i = 0; i < TFM_MEM_CHECK_CACHE_ENTRIES; i++) {
+        entry = &cache->entries[i];
+        /* A read-write grant covers read-only accesses as well */
+        if ((entry->attr & attr) == attr &&
+            ((entry->attr ^ attr) & ~MEM_CHECK_CACHE_ATTR_RW) == 0 &&
+            base >= entry->base && limit <= entry->limit) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+TFM_HOT_CODE
+static void mem_check_cache_insert(struct tfm_mem_check_cache_t *cache,
+                                   uintptr_t base, uintptr_t limit,
+                                   uint32_t attr)
+{
+    struct tfm_mem_check_cache_entry_t *entry = &cache->entries[cache->next];
+
+    cache->next = (cache->next + 1) % TFM_MEM_CHECK_CACHE_ENTRIES;
+
+    entry->base = base;
+    entry->limit = limit;
+    entry->attr = attr;
+}
+
+void tfm_spm_mem_check_cache_invalidate(struct spm_partition_desc_t *partition)
+{
+    uint32_t i;
+
+    if (partition) {
+        tfm_core_util_memset(&partition->runtime_data.mem_check_cache, 0,
+                             sizeof(partition->runtime_data.mem_check_cache));
+        return;
+    }
+
+    for (i = 0; i < g_spm_partition_db.partition_count; i++) {
+        tfm_spm_mem_check_cache_invalidate(&g_spm_partition_db.partitions[i]);
+    }
+}
+#endif /* TFM_MEM_CHECK_CACHE */
+
+#ifdef TFM_MAILBOX_NS_WINDOWS
+struct tfm_ns_window_t {
+    uintptr_t base;                     /* First byte of the window */
+    uintptr_t limit;                    /* Last byte of the window */
+    enum tfm_memory_access_e access;    /* Access granted within the window */
+    bool in_use;                        /* The window is registered */
+};
+
+static struct tfm_ns_window_t ns_windows[TFM_NS_WINDOW_ENTRIES];
+
+/* Check whether a NS client buffer lies within a registered window */
+TFM_HOT_CODE
+static bool ns_window_lookup(uintptr_t base, uintptr_t limit,
+                             enum tfm_memory_access_e access)
+{
+    const struct tfm_ns_window_t *window;
+    uint32_t i;
+
+    for (i = 0; i < TFM_NS_WINDOW_ENTRIES; i++) {
+        window = &ns_windows[i];
+        /* A read-write window covers read-only accesses as well */
+        if (window->in_use &&
+            (access == TFM_MEMORY_ACCESS_RO ||
+             window->access == TFM_MEMORY_ACCESS_RW) &&
+            base >= window->base && limit <= window->limit) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+int32_t tfm_spm_ns_window_register(const void *base, size_t len,
+                                   enum tfm_memory_access_e access)
+{
+    struct tfm_ns_window_t *window;
+    uint32_t i;
+
+    if (len == 0 ||
+        (access != TFM_MEMORY_ACCESS_RO && access != TFM_MEMORY_ACCESS_RW)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    /* The only time the window goes through the full memory check */
+    if (tfm_memory_check(base, len, true, access,
+                         TFM_PARTITION_UNPRIVILEGED_MODE) != IPC_SUCCESS) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    for (i = 0; i < TFM_NS_WINDOW_ENTRIES; i++) {
+        window = &ns_windows[i];
+        if (!window->in_use) {
+            window->base = (uintptr_t)base;
+            window->limit = (uintptr_t)base + len - 1;
+            window->access = access;
+            window->in_use = true;
+            return (int32_t)(i + 1);
+        }
+    }
+
+    return PSA_ERROR_INSUFFICIENT_MEMORY;
+}
+
+int32_t tfm_spm_ns_window_unregister(int32_t window_id)
+{
+    if (window_id <= 0 || window_id > TFM_NS_WINDOW_ENTRIES ||
+        !ns_windows[window_id - 1].in_use) {
+        return PSA_ERROR_DOES_NOT_EXIST;
+    }
+
+    ns_windows[window_id - 1].in_use = false;
+
+    return PSA_SUCCESS;
+}
+#endif /* TFM_MAILBOX_NS_WINDOWS */
+
+TFM_HOT_CODE
 int32_t tfm_memory_check(const void *buffer, size_t len, bool ns_caller,
                          enum tfm_memory_access_e access,
                          uint32_t privileged)
 {
     enum tfm_status_e err;
+#ifdef TFM_MEM_CHECK_CACHE
+    struct tfm_mem_check_cache_t *cache;
+    uintptr_t limit;
+    uint32_t attr;
+#endif
 
     /* If len is zero, this indicates an empty buffer and base is ignored */
     if (len == 0) {
@@ -500,6 +941,24 @@ int32_t tfm_memory_check(const void *buffer, size_t len, bool ns_caller,
         return IPC_ERROR_MEMORY_CHECK;
     }
 
+#ifdef TFM_MAILBOX_NS_WINDOWS
+    if (ns_caller &&
+        ns_window_lookup((uintptr_t)buffer, (uintptr_t)buffer + len - 1,
+                         access)) {
+        return IPC_SUCCESS;
+    }
+#endif
+
+#ifdef TFM_MEM_CHECK_CACHE
+    limit = (uintptr_t)buffer + len - 1;
+    attr = mem_check_cache_attr(ns_caller, access, privileged);
+    cache = mem_check_cache_get(ns_caller, privileged);
+    if (cache &&
+        mem_check_cache_lookup(cache, (uintptr_t)buffer, limit, attr)) {
+        return IPC_SUCCESS;
+    }
+#endif
+
     if (access == TFM_MEMORY_ACCESS_RW) {
         err = tfm_core_has_write_access_to_region(buffer, len, ns_caller,
                                                   privileged);
@@ -508,6 +967,11 @@ int32_t tfm_memory_check(const void *buffer, size_t len, bool ns_caller,
                                                  privileged);
     }
     if (err == TFM_SUCCESS) {
+#ifdef TFM_MEM_CHECK_CACHE
+        if (cache) {
+            mem_check_cache_insert(cache, (uintptr_t)buffer, limit, attr);
+        }
+#endif
         return IPC_SUCCESS;
     }
 
@@ -516,18 +980,39 @@ int32_t tfm_memory_check(const void *buffer, size_t len, bool ns_caller,
 
 /********************** SPM functions for thread mode ************************/
 
+#ifdef TFM_RESOURCE_USAGE
+static void tfm_spm_conn_handle_usage(struct tfm_resource_usage_t *usage)
+{
+    struct tfm_pool_stats_t stats;
+
+    tfm_pool_get_stats(conn_handle_pool, &stats);
+    usage->used = stats.in_use;
+    usage->peak = stats.max_in_use;
+    usage->capacity = TFM_CONN_HANDLE_MAX_NUM;
+}
+#endif
+
 uint32_t tfm_spm_init(void)
 {
-    uint32_t i, j, num;
+    uint32_t i, num;
     struct spm_partition_desc_t *partition;
     struct tfm_core_thread_t *pth, *p_ns_entry_thread = NULL;
     const struct tfm_spm_partition_platform_data_t **platform_data_p;
 
+#ifdef TFM_IPC_TRACE
+    tfm_ipc_trace_init();
+#endif
+
     tfm_pool_init(conn_handle_pool,
                   POOL_BUFFER_SIZE(conn_handle_pool),
                   sizeof(struct tfm_conn_handle_t),
                   TFM_CONN_HANDLE_MAX_NUM);
 
+#ifdef TFM_RESOURCE_USAGE
+    (void)tfm_resource_usage_add_core(TFM_RESOURCE_CONN_HANDLES,
+                                      tfm_spm_conn_handle_usage);
+#endif
+
     /* Init partition first for it will be used when init service */
     for (i = 0; i < g_spm_partition_db.partition_count; i++) {
         partition = &g_spm_partition_db.partitions[i];
@@ -550,32 +1035,39 @@ uint32_t tfm_spm_init(void)
             }
         }
 
+#ifdef TFM_MEM_CHECK_CACHE
+        tfm_spm_mem_check_cache_invalidate(partition);
+#endif
+
         if ((tfm_spm_partition_get_flags(i) & SPM_PART_FLAG_IPC) == 0) {
             continue;
         }
 
-        /* Add PSA_DOORBELL signal to assigned_signals */
-        partition->runtime_data.assigned_signals |= PSA_DOORBELL;
+        tfm_event_init(&partition->runtime_data.signal_evnt);
+        tfm_list_init(&partition->runtime_data.service_list);
 
-        /* TODO: This can be optimized by generating the assigned signal
-         *       in code generation time.
+#ifdef TFM_SFN_PARTITIONS
+        /*
+         * The secure functions of an SFN partition run on the threads of
+         * their clients, the partition has no thread of its own.
          */
-        for (j = 0; j < tfm_core_irq_signals_count; ++j) {
-            if (tfm_core_irq_signals[j].partition_id ==
-                                        partition->static_data->partition_id) {
-                partition->runtime_data.assigned_signals |=
-                                        tfm_core_irq_signals[j].signal_value;
-            }
+        if (tfm_spm_partition_get_flags(i) & SPM_PART_FLAG_SFN) {
+            continue;
         }
-
-        tfm_event_init(&partition->runtime_data.signal_evnt);
-        tfm_list_init(&partition->runtime_data.service_list);
+#endif
 
         pth = tfm_spm_partition_get_thread_info(i);
         if (!pth) {
             tfm_core_panic();
         }
 
+#ifdef TFM_STACK_WATERMARK
+        /* The non-secure partition already runs on its stack */
+        if (partition->static_data->partition_id != TFM_SP_NON_SECURE_ID) {
+            tfm_spm_partition_paint_stack(i);
+        }
+#endif
+
         tfm_core_thrd_init(pth,
                            tfm_spm_partition_get_init_func(i),
                            NULL,
@@ -589,6 +1081,24 @@ uint32_t tfm_spm_init(void)
             pth->param = (void *)tfm_spm_hal_get_ns_entry_point();
         }
 
+#ifdef TFM_DEFERRED_INIT
+        /*
+         * The first signal asserted for a lazy partition starts its thread.
+         * A background partition runs behind NSPE, which is started first,
+         * until it waits for signals or one is asserted for it.
+         */
+        if (tfm_spm_partition_get_flags(i) & SPM_PART_FLAG_INIT_LAZY) {
+            partition->runtime_data.init_state = SPM_INIT_STATE_PENDING;
+            continue;
+        } else if (tfm_spm_partition_get_flags(i) &
+                   SPM_PART_FLAG_INIT_BACKGROUND) {
+            partition->runtime_data.init_state = SPM_INIT_STATE_BACKGROUND;
+            pth->prior = TFM_PRIORITY_LOW;
+        } else {
+            partition->runtime_data.init_state = SPM_INIT_STATE_RUNNING;
+        }
+#endif
+
         /* Kick off */
         if (tfm_core_thrd_start(pth) != THRD_SUCCESS) {
             tfm_core_panic();
@@ -598,14 +1108,12 @@ uint32_t tfm_spm_init(void)
     /* Init Service */
     num = sizeof(service) / sizeof(struct tfm_spm_service_t);
     for (i = 0; i < num; i++) {
-        service[i].service_db = &service_db[i];
         partition =
             tfm_spm_get_partition_by_id(service[i].service_db->partition_id);
         if (!partition) {
             tfm_core_panic();
         }
         service[i].partition = partition;
-        partition->runtime_data.assigned_signals |= service[i].service_db->signal;
 
         tfm_list_init(&service[i].handle_list);
         tfm_list_add_tail(&partition->runtime_data.service_list,
@@ -625,9 +1133,79 @@ uint32_t tfm_spm_init(void)
      */
     tfm_core_thrd_start_scheduler(p_ns_entry_thread);
 
+#ifdef TFM_BOOT_TIME
+    /* The partitions are initialized by their threads from now on, so this is
+     * the last stage recorded in the IPC model.
+     */
+    tfm_core_boot_time_save(TFM_BOOT_TIME_S_SPM_INIT);
+#endif
+
     return p_ns_entry_thread->arch_ctx.lr;
 }
 
+void tfm_spm_idle(void)
+{
+    uint32_t latency;
+
+    spm_idle_info.entry_count++;
+
+#ifdef TFM_SPM_STATS
+    tfm_spm_stats_idle_enter();
+#endif
+
+    latency = tfm_spm_hal_enter_idle();
+
+#ifdef TFM_SPM_STATS
+    tfm_spm_stats_idle_exit();
+#endif
+
+    spm_idle_info.last_wake_latency = latency;
+    if (latency > spm_idle_info.max_wake_latency) {
+        spm_idle_info.max_wake_latency = latency;
+    }
+}
+
+void tfm_spm_get_idle_info(struct tfm_spm_idle_info_t *info)
+{
+    TFM_CORE_ASSERT(info);
+
+    *info = spm_idle_info;
+}
+
+#ifdef TFM_SPM_STATS
+uint32_t tfm_spm_get_service_stats(struct tfm_spm_service_stats_t *entries,
+                                   uint32_t first, uint32_t num)
+{
+    uint32_t count = sizeof(service) / sizeof(struct tfm_spm_service_t);
+    uint32_t i;
+
+    TFM_CORE_ASSERT(entries);
+
+    for (i = 0; (i < num) && (first + i < count); i++) {
+        entries[i].sid = service[first + i].service_db->sid;
+        entries[i].requests = service[first + i].stats_requests;
+        entries[i].cycles = service[first + i].stats_cycles;
+    }
+
+    return i;
+}
+
+/* Index of the partition which runs the thread */
+static uint32_t tfm_spm_stats_thread_to_idx(struct tfm_core_thread_t *pth)
+{
+    struct spm_partition_runtime_data_t *r_data;
+    struct spm_partition_desc_t *partition;
+
+    r_data = TFM_GET_CONTAINER_PTR(pth, struct spm_partition_runtime_data_t,
+                                   sp_thrd);
+    partition = TFM_GET_CONTAINER_PTR(r_data, struct spm_partition_desc_t,
+                                      runtime_data);
+
+    return (uint32_t)(partition - g_spm_partition_db.partitions);
+}
+#endif /* TFM_SPM_STATS */
+
+TFM_HOT_CODE
 void tfm_pendsv_do_schedule(struct tfm_arch_ctx_t *p_actx)
 {
 #if TFM_LVL == 2
@@ -635,10 +1213,25 @@ void tfm_pendsv_do_schedule(struct tfm_arch_ctx_t *p_actx)
     struct spm_partition_runtime_data_t *r_data;
     uint32_t is_privileged;
 #endif
-    struct tfm_core_thread_t *pth_next = tfm_core_thrd_get_next_thread();
+    struct tfm_core_thread_t *pth_next;
     struct tfm_core_thread_t *pth_curr = tfm_core_thrd_get_curr_thread();
 
-    if (pth_next != NULL && pth_curr != pth_next) {
+#ifdef TFM_THRD_TIME_SLICE
+    tfm_core_thrd_time_slice();
+#endif
+    pth_next = tfm_core_thrd_get_next_thread();
+
+    /*
+     * Every thread, including the non-secure one, is blocked. PendSV has the
+     * lowest priority, so stay idle here until an interrupt handler makes a
+     * thread ready to run.
+     */
+    while (pth_next == NULL) {
+        tfm_spm_idle();
+        pth_next = tfm_core_thrd_get_next_thread();
+    }
+
+    if (pth_curr != pth_next) {
 #if TFM_LVL == 2
         r_data = TFM_GET_CONTAINER_PTR(pth_next,
                                        struct spm_partition_runtime_data_t,
@@ -657,7 +1250,14 @@ void tfm_pendsv_do_schedule(struct tfm_arch_ctx_t *p_actx)
         tfm_spm_partition_change_privilege(is_privileged);
 #endif
 
+#ifdef TFM_SPM_STATS
+        tfm_spm_stats_switch(tfm_spm_stats_thread_to_idx(pth_next));
+#endif
+
         tfm_core_thrd_switch_context(p_actx, pth_curr, pth_next);
+
+        TFM_IPC_TRACE_POINT(TFM_IPC_TRACE_SWITCH_IN,
+                            tfm_spm_partition_get_running_partition_id());
     }
 
     /*
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2017-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -30,8 +30,7 @@ typedef void(*sp_entry_point)(void);
 
 /**
  * Holds the fields of the partition DB used by the SPM code. The values of
- * these fields are calculated at compile time, and set during initialisation
- * phase.
+ * these fields are calculated at compile time and placed in read-only memory.
  */
 struct spm_partition_static_data_t {
 #ifdef TFM_PSA_API
@@ -43,6 +42,13 @@ struct spm_partition_static_data_t {
     sp_entry_point partition_init;
     uint32_t dependencies_num;
     int32_t *p_dependencies;
+#ifdef TFM_SFN_TRUSTED_CALLS
+    uint32_t trusted_callees_num;
+    const uint32_t *p_trusted_callees;   /* Partition IDs of trusted callees */
+#endif /* defined(TFM_SFN_TRUSTED_CALLS) */
+#ifdef TFM_PSA_API
+    uint32_t assigned_signals;      /* Service, IRQ and doorbell signals */
+#endif /* defined(TFM_PSA_API) */
 };
 
 /**
@@ -68,6 +74,19 @@ struct spm_partition_db_t {
     struct spm_partition_desc_t *partitions;
 };
 
+#ifdef TFM_SHM_CHANNELS
+/* Shared memory channel declared in the manifest of its producer */
+struct tfm_spm_shm_t {
+    void *base;                 /* Buffer, NULL if the producer is not built */
+    uint32_t size;              /* Size of the buffer in bytes              */
+    int32_t producer_id;        /* Partition ID of the producer             */
+    int32_t consumer_id;        /* Partition ID of the consumer             */
+};
+
+/* Channels indexed by the <name>_SHM_ID of psa_manifest/sid.h */
+extern const struct tfm_spm_shm_t shm_list[];
+#endif
+
 /* Macros to pick linker symbols and allow to form the partition data base */
 #define REGION(a, b, c) a##b##c
 #define REGION_NAME(a, b, c) REGION(a, b, c)
@@ -9,10 +9,20 @@ option(ENABLE_SECURE_STORAGE_SERVICE_TESTS "Option for secure storage service te
 option(ENABLE_INTERNAL_TRUSTED_STORAGE_SERVICE_TESTS "Option for internal trusted storage services tests" TRUE)
 option(ENABLE_AUDIT_LOGGING_SERVICE_TESTS "Option for audit logging service tests" TRUE)
 option(ENABLE_CRYPTO_SERVICE_TESTS "Option for crypto service tests" TRUE)
+option(ENABLE_CRYPTO_BENCHMARK_TESTS "Option for crypto service benchmark" FALSE)
+option(ENABLE_STORAGE_BENCHMARK_TESTS "Option for storage services benchmark" FALSE)
 option(ENABLE_ATTESTATION_SERVICE_TESTS "Option for attestation service tests" TRUE)
+option(ENABLE_ATTESTATION_BENCHMARK_TESTS "Option for attestation service benchmark" FALSE)
 option(ENABLE_PLATFORM_SERVICE_TESTS "Option for platform service tests" TRUE)
+option(ENABLE_FIRMWARE_UPDATE_SERVICE_TESTS "Option for firmware update service tests" TRUE)
+option(ENABLE_TLS_RECORD_SERVICE_TESTS "Option for TLS record service tests" TRUE)
 option(ENABLE_QCBOR_TESTS "Option for QCBOR tests" TRUE)
 option(ENABLE_T_COSE_TESTS "Option for T_COSE tests" TRUE)
+option(ENABLE_CORE_UTILS_TESTS "Option for core utility tests" TRUE)
+option(ENABLE_IPC_BENCHMARK_TESTS "Option for IPC round trip benchmark" FALSE)
+option(ENABLE_IRQ_BENCHMARK_TESTS "Option for secure IRQ latency benchmark" FALSE)
+option(ENABLE_MULTI_CORE_BENCHMARK_TESTS "Option for multi-core mailbox benchmark" FALSE)
+option(ENABLE_TEST_TIMING "Option to time the tests and enforce their cycle budgets" FALSE)
 
 # If a partition is not enabled, then neither should its tests.
 if (NOT TFM_PARTITION_SECURE_STORAGE)
@@ -21,20 +31,67 @@ endif()
 
 if (NOT TFM_PARTITION_INTERNAL_TRUSTED_STORAGE)
 	set(ENABLE_INTERNAL_TRUSTED_STORAGE_SERVICE_TESTS FALSE)
+	set(ENABLE_STORAGE_BENCHMARK_TESTS FALSE)
 endif()
 
 if (NOT TFM_PARTITION_CRYPTO)
 	set(ENABLE_CRYPTO_SERVICE_TESTS FALSE)
+	set(ENABLE_CRYPTO_BENCHMARK_TESTS FALSE)
 endif()
 
 if (NOT TFM_PARTITION_INITIAL_ATTESTATION)
 	set(ENABLE_ATTESTATION_SERVICE_TESTS FALSE)
+	set(ENABLE_ATTESTATION_BENCHMARK_TESTS FALSE)
 endif()
 
 if (NOT TFM_PARTITION_PLATFORM)
 	set(ENABLE_PLATFORM_SERVICE_TESTS FALSE)
 endif()
 
+if (NOT TFM_PARTITION_FIRMWARE_UPDATE)
+	set(ENABLE_FIRMWARE_UPDATE_SERVICE_TESTS FALSE)
+endif()
+
+if (NOT TFM_PARTITION_TLS_RECORD)
+	set(ENABLE_TLS_RECORD_SERVICE_TESTS FALSE)
+endif()
+
 if (NOT TFM_PARTITION_AUDIT_LOG)
 	set(ENABLE_AUDIT_LOGGING_SERVICE_TESTS FALSE)
 endif()
+
+# The IPC benchmark uses the services of the IPC test partitions.
+if (NOT IPC_TEST)
+	set(ENABLE_IPC_BENCHMARK_TESTS FALSE)
+endif()
+
+# The IRQ benchmark uses the IRQ test partition, and its latency scenarios are
+# only implemented in the IPC model.
+if (NOT TFM_ENABLE_IRQ_TEST OR NOT CORE_IPC)
+	set(ENABLE_IRQ_BENCHMARK_TESTS FALSE)
+endif()
+
+# The multi-core benchmark uses the multi-core test partition and reports the
+# mailbox statistics.
+if (NOT TFM_MULTI_CORE_TEST OR NOT TFM_MAILBOX_STATS)
+	set(ENABLE_MULTI_CORE_BENCHMARK_TESTS FALSE)
+endif()
+
+# The core utilities are only reachable from the secure test partition when it
+# runs privileged.
+if (NOT TFM_LVL EQUAL 1)
+	set(ENABLE_CORE_UTILS_TESTS FALSE)
+endif()
+
+# The storage benchmark reads the cycle counter and the flash operation counts
+# of the ITS partition, which are only reachable from the secure test partition
+# when it runs privileged.
+if (NOT TFM_LVL EQUAL 1)
+	set(ENABLE_STORAGE_BENCHMARK_TESTS FALSE)
+endif()
+
+# The attestation benchmark reads the cycle counter, which is only reachable
+# from the secure test partition when it runs privileged.
+if (NOT TFM_LVL EQUAL 1)
+	set(ENABLE_ATTESTATION_BENCHMARK_TESTS FALSE)
+endif()
@@ -20,6 +20,8 @@
 #include "test/suites/core/non_secure/core_ns_tests.h"
 #include "test/suites/ipc/non_secure/ipc_ns_tests.h"
 #include "test/suites/platform/non_secure/platform_ns_tests.h"
+#include "test/suites/fwu/non_secure/fwu_ns_tests.h"
+#include "test/suites/tls_record/non_secure/tls_record_ns_tests.h"
 #include "test/suites/multi_core/non_secure/multi_core_ns_test.h"
 
 static struct test_suite_t test_suites[] = {
@@ -40,6 +42,11 @@ static struct test_suite_t test_suites[] = {
     {&register_testsuite_ns_crypto_interface, 0, 0, 0},
 #endif
 
+#ifdef ENABLE_CRYPTO_BENCHMARK_TESTS
+    /* Non-secure Crypto benchmark */
+    {&register_testsuite_ns_crypto_benchmark, 0, 0, 0},
+#endif
+
 #ifdef ENABLE_ATTESTATION_SERVICE_TESTS
     /* Non-secure initial attestation service test cases */
     {&register_testsuite_ns_attestation_interface, 0, 0, 0},
@@ -50,6 +57,16 @@ static struct test_suite_t test_suites[] = {
     {&register_testsuite_ns_platform_interface, 0, 0, 0},
 #endif
 
+#ifdef ENABLE_FIRMWARE_UPDATE_SERVICE_TESTS
+    /* Non-secure firmware update service test cases */
+    {&register_testsuite_ns_fwu_interface, 0, 0, 0},
+#endif
+
+#ifdef ENABLE_TLS_RECORD_SERVICE_TESTS
+    /* Non-secure TLS record service test cases */
+    {&register_testsuite_ns_tls_record_interface, 0, 0, 0},
+#endif
+
 #ifdef ENABLE_QCBOR_TESTS
     /* Non-secure QCBOR library test cases */
     {&register_testsuite_ns_qcbor, 0, 0, 0},
@@ -74,6 +91,11 @@ static struct test_suite_t test_suites[] = {
 #endif
 #endif
 
+#ifdef ENABLE_IRQ_BENCHMARK_TESTS
+    /* Non-secure secure IRQ latency benchmark */
+    {&register_testsuite_ns_core_irq_benchmark, 0, 0, 0},
+#endif
+
 #ifdef CORE_TEST_INTERACTIVE
     /* Non-secure interactive test cases */
     {&register_testsuite_ns_core_interactive, 0, 0, 0},
@@ -84,11 +106,21 @@ static struct test_suite_t test_suites[] = {
     {&register_testsuite_ns_ipc_interface, 0, 0, 0},
 #endif
 
+#ifdef ENABLE_IPC_BENCHMARK_TESTS
+    /* Non-secure IPC benchmark */
+    {&register_testsuite_ns_ipc_benchmark, 0, 0, 0},
+#endif
+
 #ifdef TFM_MULTI_CORE_TEST
     /* Multi-core topology test cases */
     {&register_testsuite_multi_core_ns_interface, 0, 0, 0},
 #endif
 
+#ifdef ENABLE_MULTI_CORE_BENCHMARK_TESTS
+    /* Multi-core mailbox benchmark */
+    {&register_testsuite_multi_core_ns_benchmark, 0, 0, 0},
+#endif
+
     /* End of test suites */
     {0, 0, 0, 0}
 };
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2017-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -17,6 +17,7 @@
 #include "test/suites/crypto/secure/crypto_s_tests.h"
 #include "test/suites/ipc/secure/ipc_s_tests.h"
 #include "test/suites/platform/secure/platform_s_tests.h"
+#include "test/suites/core/secure/core_s_tests.h"
 
 static struct test_suite_t test_suites[] = {
 #ifdef SERVICES_TEST_S
@@ -37,16 +38,34 @@ static struct test_suite_t test_suites[] = {
     {&register_testsuite_s_psa_its_reliability, 0, 0, 0},
 #endif
 
+#ifdef ENABLE_STORAGE_BENCHMARK_TESTS
+    /* Storage benchmark */
+    {&register_testsuite_s_psa_its_benchmark, 0, 0, 0},
+#ifdef ENABLE_SECURE_STORAGE_SERVICE_TESTS
+    {&register_testsuite_s_psa_ps_benchmark, 0, 0, 0},
+#endif
+#endif
+
 #ifdef ENABLE_CRYPTO_SERVICE_TESTS
     /* Crypto test cases */
     {&register_testsuite_s_crypto_interface, 0, 0, 0},
 #endif
 
+#ifdef ENABLE_CRYPTO_BENCHMARK_TESTS
+    /* Crypto benchmark */
+    {&register_testsuite_s_crypto_benchmark, 0, 0, 0},
+#endif
+
 #ifdef ENABLE_ATTESTATION_SERVICE_TESTS
     /* Secure initial attestation service test cases */
     {&register_testsuite_s_attestation_interface, 0, 0, 0},
 #endif
 
+#ifdef ENABLE_ATTESTATION_BENCHMARK_TESTS
+    /* Initial attestation service benchmark */
+    {&register_testsuite_s_attestation_benchmark, 0, 0, 0},
+#endif
+
 #ifdef ENABLE_PLATFORM_SERVICE_TESTS
     /* Secure platform service test cases */
     {&register_testsuite_s_platform_interface, 0, 0, 0},
@@ -68,6 +87,11 @@ static struct test_suite_t test_suites[] = {
     /* Secure IPC test cases */
     {&register_testsuite_s_ipc_interface, 0, 0, 0},
 #endif
+
+#ifdef ENABLE_CORE_UTILS_TESTS
+    /* Secure core utility test cases */
+    {&register_testsuite_s_core_utils, 0, 0, 0},
+#endif
 #endif /* SERVICES_TEST_S */
     /* End of test suites */
     {0, 0, 0, 0}
@@ -80,11 +104,19 @@ static void setup_integ_test(void)
      */
 }
 
+#if defined(TFM_STACK_WATERMARK) && (TFM_LVL == 1)
+/* Provided by the SPM, and callable from the privileged secure test partition
+ * at isolation level 1.
+ */
+void tfm_spm_stack_watermark_log(void);
+#endif
+
 static void tear_down_integ_test(void)
 {
-    /* Left empty intentionally, currently implemented
-     * test suites require no tear down
-     */
+#if defined(TFM_STACK_WATERMARK) && (TFM_LVL == 1)
+    /* Report the stack high-water of the partitions after the secure tests */
+    tfm_spm_stack_watermark_log();
+#endif
 }
 
 enum test_suite_err_t start_integ_test(void)
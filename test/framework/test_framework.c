@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2017-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -8,10 +8,88 @@
 #include "test_framework.h"
 
 #include <assert.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include "tfm_hal_device_header.h"
+
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || \
+    defined(__ARM_ARCH_8M_MAIN__) || defined(__ARM_ARCH_8_1M_MAIN__)
+__WEAK int32_t test_timer_start(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    if (DWT->CTRL & DWT_CTRL_NOCYCCNT_Msk) {
+        return -1;
+    }
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    return 0;
+}
+
+__WEAK uint32_t test_timer_read(void)
+{
+    return DWT->CYCCNT;
+}
+#else
+__WEAK int32_t test_timer_start(void)
+{
+    /* Baseline architectures have no cycle counter */
+    return -1;
+}
+
+__WEAK uint32_t test_timer_read(void)
+{
+    return 0;
+}
+#endif
+
+#ifdef ENABLE_TEST_TIMING
+/* Each timed test prints a line with the following comma separated fields,
+ * followed by a line with the total of the test suite:
+ *  - the TIMING tag, to pick the lines out of the test log
+ *  - the name of the test suite
+ *  - the name of the test, or total
+ *  - the cycles taken by the test
+ *  - the cycle budget of the test, 0 if it has none
+ *  - the result of the test, PASSED or FAILED
+ */
+#define TIMING_HEADER "TIMING,suite,test,cycles,budget,result\r\n"
+
+enum timer_state_t {
+    TIMER_NOT_STARTED = 0,
+    TIMER_RUNNING,
+    TIMER_UNAVAILABLE,
+};
+
+static enum timer_state_t timer_state = TIMER_NOT_STARTED;
+
+static bool test_timing_enabled(void)
+{
+    if (timer_state == TIMER_NOT_STARTED) {
+        if (test_timer_start() == 0) {
+            timer_state = TIMER_RUNNING;
+            TEST_LOG(TIMING_HEADER);
+        } else {
+            timer_state = TIMER_UNAVAILABLE;
+            TEST_LOG("No test timer, the tests are not timed.\r\n");
+        }
+    }
+
+    return timer_state == TIMER_RUNNING;
+}
+
+static void test_timing_log(const char *suite, const char *test,
+                            uint32_t cycles, uint32_t budget,
+                            enum test_status_t val)
+{
+    printf_set_color(WHITE);
+    TEST_LOG("TIMING,%s,%s,%u,%u,%s\r\n", suite, test, (unsigned int)cycles,
+             (unsigned int)budget, (val == TEST_PASSED) ? "PASSED" : "FAILED");
+}
+#endif /* ENABLE_TEST_TIMING */
+
 static void test_failed(const struct test_result_t *ret)
 {
     printf_set_color(RED);
@@ -88,6 +166,11 @@ enum test_suite_err_t run_testsuite(struct test_suite_t *test_suite)
     uint32_t failed_tests = 0;
     uint32_t i;
     struct test_t *p_test;
+#ifdef ENABLE_TEST_TIMING
+    bool timed = test_timing_enabled();
+    uint32_t total_cycles = 0;
+    uint32_t start = 0;
+#endif
 
     if (test_suite == 0 || test_suite->freg == 0) {
         print_error("TEST_SUITE_ERR_INVALID_DATA!");
@@ -120,9 +203,28 @@ enum test_suite_err_t run_testsuite(struct test_suite_t *test_suite)
 
         /* Sets the default value before the test */
         p_test->ret.val = TEST_PASSED;
+        p_test->cycles = 0;
+
+#ifdef ENABLE_TEST_TIMING
+        if (timed) {
+            start = test_timer_read();
+        }
+#endif
 
         /* Executes the test */
         p_test->test(&p_test->ret);
+
+#ifdef ENABLE_TEST_TIMING
+        if (timed) {
+            p_test->cycles = test_timer_read() - start;
+            total_cycles += p_test->cycles;
+            if ((p_test->ret.val == TEST_PASSED) && (p_test->cycle_budget != 0)
+                && (p_test->cycles > p_test->cycle_budget)) {
+                set_test_failed("Cycle budget exceeded", 0, 0, &p_test->ret);
+            }
+        }
+#endif
+
         if (p_test->ret.val == TEST_FAILED) {
             test_failed(&p_test->ret);
             failed_tests++;
@@ -131,6 +233,13 @@ enum test_suite_err_t run_testsuite(struct test_suite_t *test_suite)
             TEST_LOG("  TEST PASSED!\r\n");
         }
 
+#ifdef ENABLE_TEST_TIMING
+        if (timed) {
+            test_timing_log(test_suite->name, p_test->name, p_test->cycles,
+                            p_test->cycle_budget, p_test->ret.val);
+        }
+#endif
+
         /* Sets pointer to the next test */
         p_test++;
     }
@@ -149,5 +258,12 @@ enum test_suite_err_t run_testsuite(struct test_suite_t *test_suite)
         test_suite->val = TEST_FAILED;
     }
 
+#ifdef ENABLE_TEST_TIMING
+    if (timed) {
+        test_timing_log(test_suite->name, "total", total_cycles, 0,
+                        test_suite->val);
+    }
+#endif
+
     return TEST_SUITE_ERR_NO_ERROR;
 }
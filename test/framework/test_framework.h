@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2017-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -45,6 +45,13 @@ struct test_t {
     const char *name;              /*!< Test name */
     const char *desc;              /*!< Test description */
     struct test_result_t ret;      /*!< Test result */
+    uint32_t cycle_budget;         /*!< Maximum number of cycles the test may
+                                    *   take when the tests are timed, 0 for
+                                    *   no limit
+                                    */
+    uint32_t cycles;               /*!< Cycles taken by the test, 0 when the
+                                    *   tests are not timed
+                                    */
 };
 
 struct test_suite_t;
@@ -134,6 +141,25 @@ void show_tests(const struct test_suite_t *ts);
 void set_test_failed(const char *info_msg, const char *filename, uint32_t line,
                      struct test_result_t *ret);
 
+/**
+ * \brief Starts the timer which measures the tests and the benchmarks.
+ *
+ * \details The default implementation starts the DWT cycle counter of the
+ *          Mainline architectures. A platform can provide another timer by
+ *          implementing this function and \ref test_timer_read.
+ *
+ * \returns 0 if the timer runs, non-zero if there is no timer.
+ */
+int32_t test_timer_start(void);
+
+/**
+ * \brief Reads the timer which measures the tests and the benchmarks. The
+ *        timer counts up and may wrap around.
+ *
+ * \returns the current count of the timer.
+ */
+uint32_t test_timer_read(void);
+
 #define TEST_FAIL(info_msg)  set_test_failed(info_msg, __FILE__, __LINE__, ret)
 
 #define TEST_LOG(...) tfm_log_printf(__VA_ARGS__)
@@ -38,3 +38,15 @@ void printf_set_color(enum serial_color_t color_id)
 {
     TEST_LOG("\33[3%dm", color_id);
 }
+
+void bench_log_header(const char *fields)
+{
+    TEST_LOG("BENCH,%s\r\n", fields);
+}
+
+void bench_log_hundredths(uint32_t hundredths, const char *end)
+{
+    TEST_LOG("%u.%u%u%s", (unsigned int)(hundredths / 100),
+             (unsigned int)((hundredths / 10) % 10),
+             (unsigned int)(hundredths % 10), end);
+}
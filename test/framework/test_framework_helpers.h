@@ -45,6 +45,24 @@ const char *asset_perms_to_str(uint8_t permissions);
  */
 void printf_set_color(enum serial_color_t color_id);
 
+/**
+ * \brief Prints the header line of a benchmark. The lines of a benchmark are
+ *        comma separated and start with the BENCH tag, so that they can be
+ *        picked out of the test log.
+ *
+ * \param[in] fields  Comma separated names of the fields after the tag
+ */
+void bench_log_header(const char *fields);
+
+/**
+ * \brief Prints a value given in hundredths with its two decimals, as the log
+ *        supports neither floating point values nor field widths.
+ *
+ * \param[in] hundredths  Value multiplied by 100
+ * \param[in] end         String printed after the value
+ */
+void bench_log_hundredths(uint32_t hundredths, const char *end);
+
 #ifdef __cplusplus
 }
 #endif
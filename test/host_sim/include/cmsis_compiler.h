@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __CMSIS_COMPILER_H__
+#define __CMSIS_COMPILER_H__
+
+/* The few CMSIS compiler macros used by the service cores, for the host
+ * compiler.
+ */
+
+#include <stdint.h>
+
+#ifndef __STATIC_INLINE
+#define __STATIC_INLINE static inline
+#endif
+
+#ifndef __WEAK
+#define __WEAK __attribute__((weak))
+#endif
+
+#ifndef __PACKED
+#define __PACKED __attribute__((packed))
+#endif
+
+#endif /* __CMSIS_COMPILER_H__ */
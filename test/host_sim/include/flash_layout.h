@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __FLASH_LAYOUT_H__
+#define __FLASH_LAYOUT_H__
+
+/* Storage layout of the host build. Both areas are emulated in RAM, so the
+ * addresses are only offsets. The sizes match the MPS2 AN521 target, and can
+ * be overridden from the compiler command line to profile other layouts.
+ */
+
+#ifndef HOST_SIM_SECTOR_SIZE
+#define HOST_SIM_SECTOR_SIZE    (0x1000)     /* 4 KB */
+#endif
+
+/* Secure Storage (SST) Service definitions */
+#define SST_FLASH_DEV_NAME      Driver_FLASH0
+#define SST_FLASH_AREA_ADDR     (0x0)
+#ifndef SST_FLASH_AREA_SIZE
+#ifdef ITS_LOG_FS
+/* The log filesystem keeps a free block and copies the records of a block
+ * next to a new version of an asset, so it needs 13 blocks to hold all the
+ * SST assets at their maximum size.
+ */
+#define SST_FLASH_AREA_SIZE     (0xD000)     /* 52 KB */
+#else
+#define SST_FLASH_AREA_SIZE     (0x5000)     /* 20 KB */
+#endif
+#endif
+#define SST_SECTOR_SIZE         HOST_SIM_SECTOR_SIZE
+#define SST_SECTORS_PER_BLOCK   (0x1)
+#define SST_FLASH_PROGRAM_UNIT  (0x1)
+#ifndef SST_MAX_ASSET_SIZE
+#define SST_MAX_ASSET_SIZE      (2048)
+#endif
+#ifndef SST_NUM_ASSETS
+#define SST_NUM_ASSETS          (10)
+#endif
+
+/* Internal Trusted Storage (ITS) Service definitions */
+#define ITS_FLASH_DEV_NAME      Driver_FLASH0
+#define ITS_FLASH_AREA_ADDR     (SST_FLASH_AREA_ADDR + SST_FLASH_AREA_SIZE)
+#ifndef ITS_FLASH_AREA_SIZE
+#define ITS_FLASH_AREA_SIZE     (0x4000)     /* 16 KB */
+#endif
+#define ITS_SECTOR_SIZE         HOST_SIM_SECTOR_SIZE
+#define ITS_SECTORS_PER_BLOCK   (0x1)
+#define ITS_FLASH_PROGRAM_UNIT  (0x1)
+#ifndef ITS_MAX_ASSET_SIZE
+#define ITS_MAX_ASSET_SIZE      (512)
+#endif
+#ifndef ITS_NUM_ASSETS
+#define ITS_NUM_ASSETS          (10)
+#endif
+
+#endif /* __FLASH_LAYOUT_H__ */
@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Benchmark of the storage services on the host. Each operation is repeated
+ * on a filesystem which already holds half of its assets, and the result is
+ * printed as a BENCH line:
+ *   BENCH,service,operation,bytes,loops,ns,reads,programs,erases
+ * with the average time of an operation in nanoseconds and the average
+ * number of flash operations it did.
+ *
+ * Usage: tfm_host_bench [loops]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "flash/its_flash.h"
+#include "flash_layout.h"
+#ifdef ITS_HOT_TIER
+#include "its_hot_tier.h"
+#endif
+#include "tfm_host_spm.h"
+
+#define BENCH_DEFAULT_LOOPS 1000
+
+/* First UID of the assets written by the benchmark */
+#define BENCH_UID_BASE 0x1000U
+
+/* UID of the asset measured by the benchmark */
+#define BENCH_UID (BENCH_UID_BASE - 1U)
+
+#define BENCH_MAX_SIZE \
+    ((SST_MAX_ASSET_SIZE > ITS_MAX_ASSET_SIZE) ? SST_MAX_ASSET_SIZE : \
+                                                 ITS_MAX_ASSET_SIZE)
+
+/*!
+ * \struct bench_service_t
+ *
+ * \brief Requests of a service under measurement.
+ */
+struct bench_service_t {
+    const char *name;
+    enum its_flash_id_t flash_id;
+    size_t max_size;
+    uint32_t num_assets;
+    psa_storage_create_flags_t create_flags;
+    psa_status_t (*set)(psa_storage_uid_t uid, size_t data_length,
+                        const void *p_data,
+                        psa_storage_create_flags_t create_flags);
+    psa_status_t (*get)(psa_storage_uid_t uid, size_t data_offset,
+                        size_t data_size, void *p_data,
+                        size_t *p_data_length);
+    psa_status_t (*remove)(psa_storage_uid_t uid);
+};
+
+enum bench_op_t {
+    BENCH_OP_CREATE = 0,
+    BENCH_OP_OVERWRITE,
+    BENCH_OP_GET,
+    BENCH_OP_REMOVE,
+};
+
+static const char *const bench_op_names[] = {
+    [BENCH_OP_CREATE] = "create",
+    [BENCH_OP_OVERWRITE] = "overwrite",
+    [BENCH_OP_GET] = "get",
+    [BENCH_OP_REMOVE] = "remove",
+};
+
+static const struct bench_service_t bench_services[] = {
+    {"ITS", ITS_FLASH_ID_INTERNAL, ITS_MAX_ASSET_SIZE, ITS_NUM_ASSETS,
+     PSA_STORAGE_FLAG_NONE, host_its_set, host_its_get, host_its_remove},
+#ifdef ITS_HOT_TIER
+    /* Assets held in the hot tier, with the UIDs of the ITS ones */
+    {"ITS-HOT", ITS_FLASH_ID_INTERNAL, ITS_HOT_TIER_MAX_ASSET_SIZE,
+     ITS_HOT_TIER_NUM_ASSETS, TFM_STORAGE_FLAG_HOT,
+     host_its_set, host_its_get, host_its_remove},
+#endif
+#ifdef TFM_PARTITION_SECURE_STORAGE
+    {"SST", ITS_FLASH_ID_EXTERNAL, SST_MAX_ASSET_SIZE, SST_NUM_ASSETS,
+     PSA_STORAGE_FLAG_NONE, host_sst_set, host_sst_get, host_sst_remove},
+#endif
+};
+
+static uint8_t bench_data[BENCH_MAX_SIZE];
+static uint8_t bench_read_buf[BENCH_MAX_SIZE];
+
+static uint64_t bench_now_ns(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * 1000000000U) + (uint64_t)ts.tv_nsec;
+}
+
+static void bench_fail(const char *svc, const char *what, psa_status_t status)
+{
+    fprintf(stderr, "%s: %s failed with status %d\n", svc, what, (int)status);
+    exit(EXIT_FAILURE);
+}
+
+/**
+ * \brief Does one operation on the measured asset. The asset exists before
+ *        all the operations but create.
+ */
+static psa_status_t bench_do_op(const struct bench_service_t *svc,
+                                enum bench_op_t op, size_t size)
+{
+    size_t read_len;
+
+    switch (op) {
+    case BENCH_OP_CREATE:
+    case BENCH_OP_OVERWRITE:
+        return svc->set(BENCH_UID, size, bench_data, svc->create_flags);
+    case BENCH_OP_GET:
+        return svc->get(BENCH_UID, 0, size, bench_read_buf, &read_len);
+    case BENCH_OP_REMOVE:
+        return svc->remove(BENCH_UID);
+    default:
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+}
+
+/**
+ * \brief Measures an operation, and prints its BENCH line.
+ *
+ * \details Create and remove are measured in pairs, so the asset is removed
+ *          after each create and created again before each remove, out of the
+ *          measured time.
+ */
+static void bench_op(const struct bench_service_t *svc, enum bench_op_t op,
+                     size_t size, uint32_t loops)
+{
+    struct its_flash_stats_t stats;
+    psa_status_t status;
+    uint64_t total = 0;
+    uint64_t start;
+    uint32_t i;
+
+    its_flash_reset_stats(svc->flash_id);
+
+    for (i = 0; i < loops; i++) {
+        if (op == BENCH_OP_REMOVE ||
+            (op != BENCH_OP_CREATE && i == 0)) {
+            status = svc->set(BENCH_UID, size, bench_data,
+                              svc->create_flags);
+            if (status != PSA_SUCCESS) {
+                bench_fail(svc->name, "set", status);
+            }
+        }
+
+        start = bench_now_ns();
+        status = bench_do_op(svc, op, size);
+        total += bench_now_ns() - start;
+
+        if (status != PSA_SUCCESS) {
+            bench_fail(svc->name, bench_op_names[op], status);
+        }
+
+        if (op == BENCH_OP_CREATE) {
+            status = svc->remove(BENCH_UID);
+            if (status != PSA_SUCCESS) {
+                bench_fail(svc->name, "remove", status);
+            }
+        }
+    }
+
+    if (op != BENCH_OP_CREATE && op != BENCH_OP_REMOVE) {
+        (void)svc->remove(BENCH_UID);
+    }
+
+    /* The counts include the untimed set and remove of each loop */
+    its_flash_get_stats(svc->flash_id, &stats);
+
+    printf("BENCH,%s,%s,%zu,%u,%llu,%.1f,%.1f,%.1f\n", svc->name,
+           bench_op_names[op], size, loops,
+           (unsigned long long)(total / loops),
+           (double)stats.reads / loops, (double)stats.programs / loops,
+           (double)stats.erases / loops);
+}
+
+/**
+ * \brief Fills half of the assets of the service, so the measured asset is
+ *        not alone in the filesystem.
+ */
+static void bench_prefill(const struct bench_service_t *svc)
+{
+    psa_status_t status;
+    uint32_t i;
+
+    for (i = 0; i < svc->num_assets / 2; i++) {
+        status = svc->set(BENCH_UID_BASE + i, svc->max_size / 2, bench_data,
+                          svc->create_flags);
+        if (status != PSA_SUCCESS) {
+            bench_fail(svc->name, "prefill", status);
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const struct bench_service_t *svc;
+    uint32_t loops = BENCH_DEFAULT_LOOPS;
+    psa_status_t status;
+    size_t size;
+    uint32_t i;
+    uint32_t op;
+
+    if (argc > 1) {
+        loops = (uint32_t)strtoul(argv[1], NULL, 0);
+        if (loops == 0) {
+            fprintf(stderr, "Usage: %s [loops]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    for (i = 0; i < sizeof(bench_data); i++) {
+        bench_data[i] = (uint8_t)i;
+    }
+
+    status = host_spm_init();
+    if (status != PSA_SUCCESS) {
+        bench_fail("SPM", "init", status);
+    }
+
+    printf("BENCH,service,operation,bytes,loops,ns,reads,programs,erases\n");
+
+    for (i = 0; i < sizeof(bench_services) / sizeof(bench_services[0]); i++) {
+        svc = &bench_services[i];
+        bench_prefill(svc);
+
+        for (size = 16; size <= svc->max_size; size *= 4) {
+            for (op = BENCH_OP_CREATE; op <= BENCH_OP_REMOVE; op++) {
+                bench_op(svc, (enum bench_op_t)op, size, loops);
+            }
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
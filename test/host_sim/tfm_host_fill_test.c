@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Capacity test of the storage services on the host. Each service is filled
+ * with its number of assets at their maximum size, then each asset is
+ * rewritten several times and read back, and the assets are removed. Every
+ * request must succeed, as the log filesystem checks at compile time that the
+ * flash layout holds all the assets of each service.
+ *
+ * Usage: tfm_host_fill_test [rounds]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "flash_layout.h"
+#include "tfm_host_spm.h"
+
+#define FILL_DEFAULT_ROUNDS 20
+
+/* First UID of the assets written by the test */
+#define FILL_UID_BASE 0x2000U
+
+#define FILL_MAX_SIZE \
+    ((SST_MAX_ASSET_SIZE > ITS_MAX_ASSET_SIZE) ? SST_MAX_ASSET_SIZE : \
+                                                 ITS_MAX_ASSET_SIZE)
+
+/*!
+ * \struct fill_service_t
+ *
+ * \brief Requests of a service under test.
+ */
+struct fill_service_t {
+    const char *name;
+    size_t max_size;
+    uint32_t num_assets;
+    psa_status_t (*set)(psa_storage_uid_t uid, size_t data_length,
+                        const void *p_data,
+                        psa_storage_create_flags_t create_flags);
+    psa_status_t (*get)(psa_storage_uid_t uid, size_t data_offset,
+                        size_t data_size, void *p_data,
+                        size_t *p_data_length);
+    psa_status_t (*remove)(psa_storage_uid_t uid);
+};
+
+static const struct fill_service_t fill_services[] = {
+    {"ITS", ITS_MAX_ASSET_SIZE, ITS_NUM_ASSETS,
+     host_its_set, host_its_get, host_its_remove},
+#ifdef TFM_PARTITION_SECURE_STORAGE
+    {"SST", SST_MAX_ASSET_SIZE, SST_NUM_ASSETS,
+     host_sst_set, host_sst_get, host_sst_remove},
+#endif
+};
+
+static uint8_t fill_data[FILL_MAX_SIZE];
+static uint8_t fill_read_buf[FILL_MAX_SIZE];
+
+static void fill_fail(const char *svc, const char *what, uint32_t asset,
+                      psa_status_t status)
+{
+    fprintf(stderr, "%s: %s of asset %u failed with status %d\n", svc, what,
+            (unsigned int)asset, (int)status);
+    exit(EXIT_FAILURE);
+}
+
+/**
+ * \brief Generates the content of an asset for a round, so that a read back
+ *        of a previous version or of another asset is detected.
+ */
+static void fill_pattern(uint32_t asset, uint32_t round, size_t size)
+{
+    size_t i;
+
+    for (i = 0; i < size; i++) {
+        fill_data[i] = (uint8_t)(i + (asset * 31U) + (round * 7U));
+    }
+}
+
+static void fill_set(const struct fill_service_t *svc, uint32_t asset,
+                     uint32_t round)
+{
+    psa_status_t status;
+
+    fill_pattern(asset, round, svc->max_size);
+
+    status = svc->set(FILL_UID_BASE + asset, svc->max_size, fill_data,
+                      PSA_STORAGE_FLAG_NONE);
+    if (status != PSA_SUCCESS) {
+        fill_fail(svc->name, "set", asset, status);
+    }
+}
+
+static void fill_check(const struct fill_service_t *svc, uint32_t asset,
+                       uint32_t round)
+{
+    size_t read_len = 0;
+    psa_status_t status;
+
+    fill_pattern(asset, round, svc->max_size);
+
+    status = svc->get(FILL_UID_BASE + asset, 0, svc->max_size, fill_read_buf,
+                      &read_len);
+    if (status != PSA_SUCCESS) {
+        fill_fail(svc->name, "get", asset, status);
+    }
+
+    if ((read_len != svc->max_size) ||
+        (memcmp(fill_read_buf, fill_data, svc->max_size) != 0)) {
+        fill_fail(svc->name, "check", asset, PSA_ERROR_DATA_CORRUPT);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const struct fill_service_t *svc;
+    uint32_t rounds = FILL_DEFAULT_ROUNDS;
+    psa_status_t status;
+    uint32_t round;
+    uint32_t asset;
+    uint32_t i;
+
+    if (argc > 1) {
+        rounds = (uint32_t)strtoul(argv[1], NULL, 0);
+        if (rounds == 0) {
+            fprintf(stderr, "Usage: %s [rounds]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    status = host_spm_init();
+    if (status != PSA_SUCCESS) {
+        fill_fail("SPM", "init", 0, status);
+    }
+
+    for (i = 0; i < sizeof(fill_services) / sizeof(fill_services[0]); i++) {
+        svc = &fill_services[i];
+
+        for (asset = 0; asset < svc->num_assets; asset++) {
+            fill_set(svc, asset, 0);
+        }
+
+        for (round = 1; round <= rounds; round++) {
+            for (asset = 0; asset < svc->num_assets; asset++) {
+                fill_set(svc, asset, round);
+            }
+
+            for (asset = 0; asset < svc->num_assets; asset++) {
+                fill_check(svc, asset, round);
+            }
+        }
+
+        for (asset = 0; asset < svc->num_assets; asset++) {
+            status = svc->remove(FILL_UID_BASE + asset);
+            if (status != PSA_SUCCESS) {
+                fill_fail(svc->name, "remove", asset, status);
+            }
+        }
+
+        printf("%s: %u assets of %u bytes rewritten %u times\n", svc->name,
+               (unsigned int)svc->num_assets, (unsigned int)svc->max_size,
+               (unsigned int)rounds);
+    }
+
+    return EXIT_SUCCESS;
+}
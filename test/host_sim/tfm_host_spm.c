@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Stub of the SPM and of the request managers of the storage services, for
+ * the host build. A request is a direct call to the core of the service, and
+ * the data of the client is copied from and to the buffers of the current
+ * request, as the request managers do with psa_read() and psa_write().
+ */
+
+#include "tfm_host_spm.h"
+
+#include <string.h>
+
+#include "psa/internal_trusted_storage.h"
+#include "psa_manifest/pid.h"
+#include "tfm_internal_trusted_storage.h"
+#include "tfm_its_req_mngr.h"
+#ifdef TFM_PARTITION_SECURE_STORAGE
+#include "tfm_protected_storage.h"
+#include "tfm_sst_req_mngr.h"
+#endif
+
+/*!
+ * \struct host_req_t
+ *
+ * \brief Data buffers of the request being handled by a service.
+ */
+struct host_req_t {
+    const uint8_t *in;  /*!< Data sent by the client */
+    size_t in_len;      /*!< Data left to read from the client */
+    uint8_t *out;       /*!< Buffer to return data to the client */
+    size_t out_len;     /*!< Space left in the output buffer */
+};
+
+/* SST calls ITS while handling a request, so each service has its own */
+static struct host_req_t its_req;
+#ifdef TFM_PARTITION_SECURE_STORAGE
+static struct host_req_t sst_req;
+#endif
+
+static void host_req_start(struct host_req_t *req, const void *in,
+                           size_t in_len, void *out, size_t out_len)
+{
+    req->in = in;
+    req->in_len = in_len;
+    req->out = out;
+    req->out_len = out_len;
+}
+
+static size_t host_req_read(struct host_req_t *req, uint8_t *buf,
+                            size_t num_bytes)
+{
+    if (num_bytes > req->in_len) {
+        num_bytes = req->in_len;
+    }
+
+    (void)memcpy(buf, req->in, num_bytes);
+    req->in += num_bytes;
+    req->in_len -= num_bytes;
+
+    return num_bytes;
+}
+
+static void host_req_write(struct host_req_t *req, const uint8_t *buf,
+                           size_t num_bytes)
+{
+    if (num_bytes > req->out_len) {
+        num_bytes = req->out_len;
+    }
+
+    (void)memcpy(req->out, buf, num_bytes);
+    req->out += num_bytes;
+    req->out_len -= num_bytes;
+}
+
+size_t its_req_mngr_read(uint8_t *buf, size_t num_bytes)
+{
+    return host_req_read(&its_req, buf, num_bytes);
+}
+
+void its_req_mngr_write(const uint8_t *buf, size_t num_bytes)
+{
+    host_req_write(&its_req, buf, num_bytes);
+}
+
+static psa_status_t its_set(int32_t client_id, psa_storage_uid_t uid,
+                            size_t data_length, const void *p_data,
+                            psa_storage_create_flags_t create_flags)
+{
+    host_req_start(&its_req, p_data, data_length, NULL, 0);
+
+    return tfm_its_set(client_id, uid, data_length, create_flags);
+}
+
+static psa_status_t its_get(int32_t client_id, psa_storage_uid_t uid,
+                            size_t data_offset, size_t data_size,
+                            void *p_data, size_t *p_data_length)
+{
+    host_req_start(&its_req, NULL, 0, p_data, data_size);
+
+    return tfm_its_get(client_id, uid, data_offset, data_size, p_data_length);
+}
+
+psa_status_t host_its_set(psa_storage_uid_t uid, size_t data_length,
+                          const void *p_data,
+                          psa_storage_create_flags_t create_flags)
+{
+    return its_set(HOST_SIM_CLIENT_ID, uid, data_length, p_data,
+                   create_flags);
+}
+
+psa_status_t host_its_get(psa_storage_uid_t uid, size_t data_offset,
+                          size_t data_size, void *p_data,
+                          size_t *p_data_length)
+{
+    return its_get(HOST_SIM_CLIENT_ID, uid, data_offset, data_size, p_data,
+                   p_data_length);
+}
+
+psa_status_t host_its_remove(psa_storage_uid_t uid)
+{
+    return tfm_its_remove(HOST_SIM_CLIENT_ID, uid);
+}
+
+#ifdef TFM_PARTITION_SECURE_STORAGE
+/* The ITS API used by SST, called with the client ID of the SST partition */
+psa_status_t psa_its_set(psa_storage_uid_t uid, size_t data_length,
+                         const void *p_data,
+                         psa_storage_create_flags_t create_flags)
+{
+    return its_set(TFM_SP_STORAGE, uid, data_length, p_data, create_flags);
+}
+
+psa_status_t psa_its_get(psa_storage_uid_t uid, size_t data_offset,
+                         size_t data_size, void *p_data,
+                         size_t *p_data_length)
+{
+    return its_get(TFM_SP_STORAGE, uid, data_offset, data_size, p_data,
+                   p_data_length);
+}
+
+psa_status_t psa_its_get_info(psa_storage_uid_t uid,
+                              struct psa_storage_info_t *p_info)
+{
+    return tfm_its_get_info(TFM_SP_STORAGE, uid, p_info);
+}
+
+psa_status_t psa_its_remove(psa_storage_uid_t uid)
+{
+    return tfm_its_remove(TFM_SP_STORAGE, uid);
+}
+
+psa_status_t sst_req_mngr_read_asset_data(uint8_t *out_data, uint32_t size)
+{
+    if (host_req_read(&sst_req, out_data, size) != size) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    return PSA_SUCCESS;
+}
+
+void sst_req_mngr_write_asset_data(const uint8_t *in_data, uint32_t size)
+{
+    host_req_write(&sst_req, in_data, size);
+}
+
+psa_status_t host_sst_set(psa_storage_uid_t uid, size_t data_length,
+                          const void *p_data,
+                          psa_storage_create_flags_t create_flags)
+{
+    host_req_start(&sst_req, p_data, data_length, NULL, 0);
+
+    return tfm_sst_set(HOST_SIM_CLIENT_ID, uid, data_length, create_flags);
+}
+
+psa_status_t host_sst_get(psa_storage_uid_t uid, size_t data_offset,
+                          size_t data_size, void *p_data,
+                          size_t *p_data_length)
+{
+    host_req_start(&sst_req, NULL, 0, p_data, data_size);
+
+    return tfm_sst_get(HOST_SIM_CLIENT_ID, uid, data_offset, data_size,
+                       p_data_length);
+}
+
+psa_status_t host_sst_remove(psa_storage_uid_t uid)
+{
+    return tfm_sst_remove(HOST_SIM_CLIENT_ID, uid);
+}
+#else /* TFM_PARTITION_SECURE_STORAGE */
+psa_status_t host_sst_set(psa_storage_uid_t uid, size_t data_length,
+                          const void *p_data,
+                          psa_storage_create_flags_t create_flags)
+{
+    (void)uid;
+    (void)data_length;
+    (void)p_data;
+    (void)create_flags;
+
+    return PSA_ERROR_NOT_SUPPORTED;
+}
+
+psa_status_t host_sst_get(psa_storage_uid_t uid, size_t data_offset,
+                          size_t data_size, void *p_data,
+                          size_t *p_data_length)
+{
+    (void)uid;
+    (void)data_offset;
+    (void)data_size;
+    (void)p_data;
+    (void)p_data_length;
+
+    return PSA_ERROR_NOT_SUPPORTED;
+}
+
+psa_status_t host_sst_remove(psa_storage_uid_t uid)
+{
+    (void)uid;
+
+    return PSA_ERROR_NOT_SUPPORTED;
+}
+#endif /* TFM_PARTITION_SECURE_STORAGE */
+
+psa_status_t host_spm_init(void)
+{
+    psa_status_t status;
+
+    /* ITS is initialised first, as SST depends on it */
+    status = tfm_its_init();
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+#ifdef TFM_PARTITION_SECURE_STORAGE
+    status = tfm_sst_init();
+#endif
+
+    return status;
+}
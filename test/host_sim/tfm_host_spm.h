@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __TFM_HOST_SPM_H__
+#define __TFM_HOST_SPM_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "psa/error.h"
+#include "psa/storage_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Client ID used by the host for the requests to the services, as for a
+ * non-secure client.
+ */
+#define HOST_SIM_CLIENT_ID (-1)
+
+/**
+ * \brief Initialises the services, as the SPM does at boot.
+ *
+ * \return PSA_SUCCESS, or the error of the first service which failed
+ */
+psa_status_t host_spm_init(void);
+
+/**
+ * \brief Requests to the ITS service, which behave as the PSA ITS API called
+ *        by the client HOST_SIM_CLIENT_ID, without the IPC layer.
+ */
+psa_status_t host_its_set(psa_storage_uid_t uid, size_t data_length,
+                          const void *p_data,
+                          psa_storage_create_flags_t create_flags);
+psa_status_t host_its_get(psa_storage_uid_t uid, size_t data_offset,
+                          size_t data_size, void *p_data,
+                          size_t *p_data_length);
+psa_status_t host_its_remove(psa_storage_uid_t uid);
+
+/**
+ * \brief Requests to the SST service, which behave as the PSA Protected
+ *        Storage API called by the client HOST_SIM_CLIENT_ID, without the IPC
+ *        layer.
+ */
+psa_status_t host_sst_set(psa_storage_uid_t uid, size_t data_length,
+                          const void *p_data,
+                          psa_storage_create_flags_t create_flags);
+psa_status_t host_sst_get(psa_storage_uid_t uid, size_t data_offset,
+                          size_t data_size, void *p_data,
+                          size_t *p_data_length);
+psa_status_t host_sst_remove(psa_storage_uid_t uid);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TFM_HOST_SPM_H__ */
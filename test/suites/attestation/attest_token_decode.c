@@ -137,6 +137,100 @@ map_t_cose_errors(enum t_cose_err_t t_cose_error)
 }
 
 
+/**
+ * \brief Index the claims of a validated token.
+ *
+ * \param[in] me  The token decoder context.
+ *
+ * The payload is decoded once, then claims are got from the index. They
+ * are decoded from the payload again if it cannot be indexed, for
+ * instance if it has too many claims.
+ */
+static void index_claims(struct attest_token_decode_context *me)
+{
+    me->claims_indexed = false;
+    if(me->last_error == ATTEST_TOKEN_ERR_SUCCESS) {
+        me->claims_indexed =
+            (qcbor_util_index_map(me->payload, &me->claim_index) ==
+             ATTEST_TOKEN_ERR_SUCCESS);
+    }
+}
+
+
+#ifdef ATTEST_TOKEN_MAC0
+/**
+ * Size of the HMAC-SHA256 tag of a \c COSE_Mac0 token
+ */
+#define MAC0_TAG_SIZE 32
+
+
+/**
+ * \brief Decode a \c COSE_Mac0 token.
+ *
+ * \param[in]  token    The CBOR-encoded token to decode.
+ * \param[out] payload  The payload of the token.
+ *
+ * \return An error from \ref attest_token_err_t.
+ *
+ * The token must be tagged as a \c COSE_Mac0, have the \c HMAC
+ * 256/256 algorithm in its protected header parameters and a tag of
+ * the size of this algorithm. The tag itself cannot be checked here:
+ * the key is derived from the HUK for the attestation partition only
+ * and never leaves the Crypto service.
+ */
+static enum attest_token_err_t
+decode_mac0_token(struct q_useful_buf_c token,
+                  struct q_useful_buf_c *payload)
+{
+    QCBORDecodeContext             decode_context;
+    QCBORItem                      item;
+    struct q_useful_buf_c          mac_tag = NULL_Q_USEFUL_BUF_C;
+    uint32_t                       num_items = 0;
+    enum t_cose_err_t              t_cose_error;
+    struct t_cose_sign1_verify_ctx verify_ctx;
+    struct t_cose_parameters       parameters;
+
+    /* -- The tagged array of four, the last item being the tag -- */
+    QCBORDecode_Init(&decode_context, token, QCBOR_DECODE_MODE_NORMAL);
+    if(QCBORDecode_GetNext(&decode_context, &item) != QCBOR_SUCCESS ||
+       item.uDataType != QCBOR_TYPE_ARRAY ||
+       !QCBORDecode_IsTagged(&decode_context, &item, CBOR_TAG_COSE_MAC0)) {
+        return ATTEST_TOKEN_ERR_COSE_SIGN1_FORMAT;
+    }
+    while(QCBORDecode_GetNext(&decode_context, &item) == QCBOR_SUCCESS) {
+        if(item.uNestingLevel == 1) {
+            num_items++;
+            mac_tag = item.uDataType == QCBOR_TYPE_BYTE_STRING ?
+                      item.val.string : NULL_Q_USEFUL_BUF_C;
+        }
+    }
+    if(QCBORDecode_Finish(&decode_context) != QCBOR_SUCCESS) {
+        return ATTEST_TOKEN_ERR_CBOR_NOT_WELL_FORMED;
+    }
+    if(num_items != 4 || mac_tag.len != MAC0_TAG_SIZE) {
+        return ATTEST_TOKEN_ERR_COSE_SIGN1_FORMAT;
+    }
+
+    /* -- The header parameters and the payload are laid out as in a
+     * COSE_Sign1, decode them without verifying the signature -- */
+    t_cose_sign1_verify_init(&verify_ctx, T_COSE_OPT_DECODE_ONLY);
+    t_cose_error = t_cose_sign1_verify(&verify_ctx,
+                                       token,
+                                       payload,
+                                       &parameters);
+    if(t_cose_error != T_COSE_SUCCESS) {
+        return map_t_cose_errors(t_cose_error);
+    }
+
+    if(parameters.cose_algorithm_id != T_COSE_ALGORITHM_HMAC256) {
+        return ATTEST_TOKEN_ERR_UNSUPPORTED_SIG_ALG;
+    }
+
+    return ATTEST_TOKEN_ERR_SUCCESS;
+}
+#endif /* ATTEST_TOKEN_MAC0 */
+
+
 /*
  * Public function. See attest_token_decode.h
  */
@@ -152,6 +246,16 @@ attest_token_decode_validate_token(struct attest_token_decode_context *me,
     struct t_cose_key              attest_key;
     psa_key_handle_t               public_key;
 
+#ifdef ATTEST_TOKEN_MAC0
+    /* Short-circuit tokens are still COSE_Sign1 */
+    if(!(me->options & TOKEN_OPT_SHORT_CIRCUIT_SIGN)) {
+        return_value = decode_mac0_token(token, &me->payload);
+        me->last_error = return_value;
+        index_claims(me);
+        return return_value;
+    }
+#endif
+
     /* Run the signature verification */
     if(me->options & TOKEN_OPT_SHORT_CIRCUIT_SIGN) {
         t_cose_options |= T_COSE_OPT_ALLOW_SHORT_CIRCUIT;
@@ -176,6 +280,8 @@ attest_token_decode_validate_token(struct attest_token_decode_context *me,
     return_value = map_t_cose_errors(t_cose_error);
     me->last_error = return_value;
 
+    index_claims(me);
+
     attest_ret = attest_unregister_initial_attestation_public_key(public_key);
     if (attest_ret != PSA_ATTEST_ERR_SUCCESS) {
         return ATTEST_TOKEN_ERR_GENERAL;
@@ -185,6 +291,87 @@ attest_token_decode_validate_token(struct attest_token_decode_context *me,
 }
 
 
+/**
+ * \brief Get a top-level claim from the claim index.
+ *
+ * \param[in] me     The token decoder context, with claims indexed.
+ * \param[in] label  Integer label of the claim.
+ * \param[out] item  Filled in with the type and value of the claim.
+ *
+ * \return An error from \ref attest_token_err_t.
+ */
+static enum attest_token_err_t
+get_indexed_claim(struct attest_token_decode_context *me,
+                  int32_t label,
+                  QCBORItem *item)
+{
+    const struct qcbor_util_map_entry_t *entry;
+
+    entry = qcbor_util_find_in_map_index(&me->claim_index, label);
+    if(entry == NULL) {
+        return ATTEST_TOKEN_ERR_NOT_FOUND;
+    }
+
+    memset(item, 0, sizeof(QCBORItem));
+    item->uDataType   = entry->data_type;
+    item->uLabelType  = QCBOR_TYPE_INT64;
+    item->label.int64 = entry->label;
+
+    switch(entry->data_type) {
+    case QCBOR_TYPE_BYTE_STRING:
+    case QCBOR_TYPE_TEXT_STRING:
+        item->val.string = entry->val.string;
+        break;
+    case QCBOR_TYPE_INT64:
+        item->val.int64 = entry->val.int64;
+        break;
+    case QCBOR_TYPE_UINT64:
+        item->val.uint64 = entry->val.uint64;
+        break;
+    case QCBOR_TYPE_ARRAY:
+    case QCBOR_TYPE_MAP:
+        item->val.uCount = entry->count;
+        break;
+    default:
+        break;
+    }
+
+    return ATTEST_TOKEN_ERR_SUCCESS;
+}
+
+
+/**
+ * \brief Get a top-level claim of a given type, from the claim index
+ *        or by decoding the payload.
+ *
+ * Same as qcbor_util_get_top_level_item_in_map() for the payload of
+ * the token.
+ */
+static enum attest_token_err_t
+get_top_level_claim(struct attest_token_decode_context *me,
+                    int32_t label,
+                    uint_fast8_t qcbor_type,
+                    QCBORItem *item)
+{
+    enum attest_token_err_t return_value;
+
+    if(!me->claims_indexed) {
+        return qcbor_util_get_top_level_item_in_map(me->payload,
+                                                    label,
+                                                    qcbor_type,
+                                                    item);
+    }
+
+    return_value = get_indexed_claim(me, label, item);
+    if(return_value == ATTEST_TOKEN_ERR_SUCCESS &&
+       item->uDataType != qcbor_type) {
+        return_value = ATTETST_TOKEN_ERR_CBOR_TYPE;
+    }
+
+    return return_value;
+}
+
+
 /*
  * Public function. See attest_token_decode.h
  */
@@ -202,10 +389,10 @@ attest_token_decode_get_bstr(struct attest_token_decode_context *me,
         goto Done;
     }
 
-    return_value = qcbor_util_get_top_level_item_in_map(me->payload,
-                                                       label,
-                                                       QCBOR_TYPE_BYTE_STRING,
-                                                       &item);
+    return_value = get_top_level_claim(me,
+                                       label,
+                                       QCBOR_TYPE_BYTE_STRING,
+                                       &item);
     if(return_value != ATTEST_TOKEN_ERR_SUCCESS) {
         goto Done;
     }
@@ -234,10 +421,10 @@ attest_token_decode_get_tstr(struct attest_token_decode_context *me,
         goto Done;
     }
 
-    return_value = qcbor_util_get_top_level_item_in_map(me->payload,
-                                                       label,
-                                                       QCBOR_TYPE_TEXT_STRING,
-                                                       &item);
+    return_value = get_top_level_claim(me,
+                                       label,
+                                       QCBOR_TYPE_TEXT_STRING,
+                                       &item);
     if(return_value != ATTEST_TOKEN_ERR_SUCCESS) {
         goto Done;
     }
@@ -267,17 +454,25 @@ attest_token_decode_get_int(struct attest_token_decode_context *me,
         goto Done;
     }
 
-    QCBORDecode_Init(&decode_context, me->payload, QCBOR_DECODE_MODE_NORMAL);
+    if(me->claims_indexed) {
+        return_value = get_indexed_claim(me, label, &item);
+        if(return_value != ATTEST_TOKEN_ERR_SUCCESS) {
+            goto Done;
+        }
+    } else {
+        QCBORDecode_Init(&decode_context, me->payload,
+                         QCBOR_DECODE_MODE_NORMAL);
 
-    return_value = qcbor_util_get_item_in_map(&decode_context,
-                                             label,
-                                             &item);
-    if(return_value != ATTEST_TOKEN_ERR_SUCCESS) {
-        goto Done;
-    }
+        return_value = qcbor_util_get_item_in_map(&decode_context,
+                                                 label,
+                                                 &item);
+        if(return_value != ATTEST_TOKEN_ERR_SUCCESS) {
+            goto Done;
+        }
 
-    if(QCBORDecode_Finish(&decode_context)) {
-        return_value = ATTEST_TOKEN_ERR_CBOR_STRUCTURE;
+        if(QCBORDecode_Finish(&decode_context)) {
+            return_value = ATTEST_TOKEN_ERR_CBOR_STRUCTURE;
+        }
     }
 
     if(item.uDataType == QCBOR_TYPE_INT64) {
@@ -315,17 +510,25 @@ attest_token_decode_get_uint(struct attest_token_decode_context *me,
         goto Done;
     }
 
-    QCBORDecode_Init(&decode_context, me->payload, QCBOR_DECODE_MODE_NORMAL);
+    if(me->claims_indexed) {
+        return_value = get_indexed_claim(me, label, &item);
+        if(return_value != ATTEST_TOKEN_ERR_SUCCESS) {
+            goto Done;
+        }
+    } else {
+        QCBORDecode_Init(&decode_context, me->payload,
+                         QCBOR_DECODE_MODE_NORMAL);
 
-    return_value = qcbor_util_get_item_in_map(&decode_context,
-                                             label,
-                                             &item);
-    if(return_value != 0) {
-        goto Done;
-    }
+        return_value = qcbor_util_get_item_in_map(&decode_context,
+                                                 label,
+                                                 &item);
+        if(return_value != 0) {
+            goto Done;
+        }
 
-    if(QCBORDecode_Finish(&decode_context)) {
-        return_value = ATTEST_TOKEN_ERR_CBOR_STRUCTURE;
+        if(QCBORDecode_Finish(&decode_context)) {
+            return_value = ATTEST_TOKEN_ERR_CBOR_STRUCTURE;
+        }
     }
 
     if(item.uDataType == QCBOR_TYPE_UINT64) {
@@ -384,6 +587,7 @@ attest_token_decode_get_iat_simple(struct attest_token_decode_context *me,
     QCBORDecodeContext                decode_context;
     int64_t                           client_id_64;
     enum attest_token_err_t           return_value;
+    uint32_t                          i;
 
     /* Set all q_useful_bufs to NULL and flags to 0 */
     memset(items, 0, sizeof(struct attest_token_iat_simple_t));
@@ -405,12 +609,23 @@ attest_token_decode_get_iat_simple(struct attest_token_decode_context *me,
         goto Done;
     }
 
-    QCBORDecode_Init(&decode_context, me->payload, QCBOR_DECODE_MODE_NORMAL);
+    if(me->claims_indexed) {
+        for(i = 0; i < NUMBER_OF_ITEMS; i++) {
+            if(get_indexed_claim(me, (int32_t)list[i].label, &list[i].item) !=
+               ATTEST_TOKEN_ERR_SUCCESS) {
+                list[i].item.uDataType = QCBOR_TYPE_NONE;
+            }
+        }
+        return_value = ATTEST_TOKEN_ERR_SUCCESS;
+    } else {
+        QCBORDecode_Init(&decode_context, me->payload,
+                         QCBOR_DECODE_MODE_NORMAL);
 
-    return_value = qcbor_util_get_items_in_map(&decode_context,
-                                              list);
-    if(return_value != ATTEST_TOKEN_ERR_SUCCESS) {
-        goto Done;
+        return_value = qcbor_util_get_items_in_map(&decode_context,
+                                                  list);
+        if(return_value != ATTEST_TOKEN_ERR_SUCCESS) {
+            goto Done;
+        }
     }
 
     /* ---- NONCE ---- */
@@ -494,17 +709,17 @@ attest_token_get_num_sw_components(struct attest_token_decode_context *me,
         goto Done;
     }
 
-    return_value = qcbor_util_get_top_level_item_in_map(me->payload,
-                                        EAT_CBOR_ARM_LABEL_SW_COMPONENTS,
-                                        QCBOR_TYPE_ARRAY,
-                                        &item);
+    return_value = get_top_level_claim(me,
+                                       EAT_CBOR_ARM_LABEL_SW_COMPONENTS,
+                                       QCBOR_TYPE_ARRAY,
+                                       &item);
     if(return_value != ATTEST_TOKEN_ERR_SUCCESS) {
         if(return_value != ATTEST_TOKEN_ERR_NOT_FOUND) {
             /* Something very wrong. Bail out passing on the return_value */
             goto Done;
         } else {
             /* Now decide if it was intentionally left out. */
-            return_value = qcbor_util_get_top_level_item_in_map(me->payload,
+            return_value = get_top_level_claim(me,
                                           EAT_CBOR_ARM_LABEL_NO_SW_COMPONENTS,
                                           QCBOR_TYPE_INT64,
                                           &item);
@@ -652,6 +867,59 @@ Done:
 }
 
 
+/**
+ * \brief Decode a single SW component, starting from the first member
+ *        of the SW components array recorded in the claim index.
+ *
+ * \param[in] me               The token decoder context.
+ * \param[in] entry            The index entry of the SW components
+ *                             claim, a definite-length array.
+ * \param[in] requested_index  Index of the SW component to decode.
+ * \param[out] sw_component    The structure to fill in with decoded
+ *                             data.
+ *
+ * \return An error from \ref attest_token_err_t.
+ *
+ * The SW components before \c requested_index are skipped, but no
+ * other claim of the payload is decoded.
+ */
+static enum attest_token_err_t
+get_indexed_sw_component(struct attest_token_decode_context *me,
+                         const struct qcbor_util_map_entry_t *entry,
+                         uint32_t requested_index,
+                         struct attest_token_sw_component_t *sw_component)
+{
+    QCBORDecodeContext decode_context;
+    QCBORItem          sw_component_item;
+
+    if(requested_index >= entry->count) {
+        return ATTEST_TOKEN_ERR_NOT_FOUND;
+    }
+
+    /* The members of the array are top-level items from here on */
+    QCBORDecode_Init(&decode_context,
+                     q_useful_buf_tail(me->payload, entry->offset),
+                     QCBOR_DECODE_MODE_NORMAL);
+
+    while(1) {
+        if(QCBORDecode_GetNext(&decode_context, &sw_component_item)) {
+            return ATTEST_TOKEN_ERR_CBOR_NOT_WELL_FORMED;
+        }
+
+        if(requested_index == 0) {
+            return decode_sw_component(&decode_context,
+                                       &sw_component_item,
+                                       sw_component);
+        }
+        requested_index--;
+
+        if(qcbor_util_consume_item(&decode_context, &sw_component_item, NULL)) {
+            return ATTEST_TOKEN_ERR_CBOR_NOT_WELL_FORMED;
+        }
+    }
+}
+
+
 /*
  * Public function. See attest_token_decode.h
  */
@@ -666,12 +934,33 @@ attest_token_get_sw_component(struct attest_token_decode_context *me,
     QCBORItem               sw_component_item;
     QCBORError              qcbor_error;
     uint_fast8_t            exit_array_level;
+    const struct qcbor_util_map_entry_t *entry;
 
     if(me->last_error != ATTEST_TOKEN_ERR_SUCCESS) {
         return_value = me->last_error;
         goto Done;
     }
 
+    if(me->claims_indexed) {
+        entry = qcbor_util_find_in_map_index(&me->claim_index,
+                                             EAT_CBOR_ARM_LABEL_SW_COMPONENTS);
+        if(entry == NULL) {
+            return_value = ATTEST_TOKEN_ERR_NOT_FOUND;
+            goto Done;
+        }
+        if(entry->data_type != QCBOR_TYPE_ARRAY) {
+            return_value = ATTETST_TOKEN_ERR_CBOR_TYPE;
+            goto Done;
+        }
+        /* The count of an indefinite-length array is not known */
+        if(entry->count != UINT16_MAX) {
+            return_value = get_indexed_sw_component(me, entry,
+                                                    requested_index,
+                                                    sw_components);
+            goto Done;
+        }
+    }
+
     QCBORDecode_Init(&decode_context, me->payload, QCBOR_DECODE_MODE_NORMAL);
 
     /* Find the map containing all the SW Components */
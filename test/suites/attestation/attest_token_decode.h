@@ -14,6 +14,7 @@
 #include <stdbool.h>
 #include "attest_token.h"
 #include "attest_eat_defines.h"
+#include "qcbor_util.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -103,6 +104,10 @@ struct attest_token_decode_context {
     struct q_useful_buf_c   payload;
     uint32_t                options;
     enum attest_token_err_t last_error;
+    /* Top-level claims of the payload, recorded once when the token
+       is validated. Only used when claims_indexed is true. */
+    bool                    claims_indexed;
+    struct qcbor_util_map_index_t claim_index;
     /* FIXME: This will have to expand when the pub key
        handling functions are implemented */
 };
@@ -923,3 +923,134 @@ int_fast16_t decode_test_normal_sig(void)
 {
     return decode_test_internal(NORMAL_SIGN);
 }
+
+
+#ifdef ATTEST_BATCH_TOKEN
+/* Number of challenges of the batch, odd so that a node moves up unchanged */
+#define BATCH_TEST_NUM_CHALLENGES 3
+
+/**
+ * \brief Computes a node of the Merkle tree of a batch.
+ *
+ * \param[in]  prefix  Prefix of the node, 0 for a leaf and 1 for inner nodes
+ * \param[in]  first   First part of the hashed data
+ * \param[in]  second  Second part of the hashed data, can be NULL_Q_USEFUL_BUF_C
+ * \param[out] node    Buffer of 32 bytes to store the node
+ *
+ * \return 0 on success, test failure code otherwise.
+ */
+static int_fast16_t batch_hash_node(uint8_t prefix,
+                                    struct q_useful_buf_c first,
+                                    struct q_useful_buf_c second,
+                                    uint8_t *node)
+{
+    psa_hash_operation_t hash = psa_hash_operation_init();
+    size_t               hash_len;
+
+    if(psa_hash_setup(&hash, PSA_ALG_SHA_256) != PSA_SUCCESS ||
+       psa_hash_update(&hash, &prefix, 1) != PSA_SUCCESS ||
+       psa_hash_update(&hash, first.ptr, first.len) != PSA_SUCCESS ||
+       (second.len != 0 &&
+        psa_hash_update(&hash, second.ptr, second.len) != PSA_SUCCESS) ||
+       psa_hash_finish(&hash, node, PSA_HASH_SIZE(PSA_ALG_SHA_256),
+                       &hash_len) != PSA_SUCCESS) {
+        (void)psa_hash_abort(&hash);
+        return -300;
+    }
+
+    return 0;
+}
+
+
+/*
+ * Public function. See token_test.h
+ */
+int_fast16_t decode_test_batch_token(void)
+{
+    int_fast16_t                        return_value;
+    psa_status_t                        status;
+    Q_USEFUL_BUF_MAKE_STACK_UB(         token_storage, ATTEST_TOKEN_MAX_SIZE);
+    struct q_useful_buf_c               completed_token;
+    struct attest_token_decode_context  token_decode;
+    struct q_useful_buf_c               nonce;
+    struct q_useful_buf_c               left;
+    struct q_useful_buf_c               right;
+    uint8_t challenges[BATCH_TEST_NUM_CHALLENGES]
+                      [PSA_INITIAL_ATTEST_CHALLENGE_SIZE_32];
+    uint8_t leaves[BATCH_TEST_NUM_CHALLENGES]
+                  [PSA_HASH_SIZE(PSA_ALG_SHA_256)];
+    uint8_t root[PSA_HASH_SIZE(PSA_ALG_SHA_256)];
+    size_t  token_size;
+    size_t  i;
+
+    for(i = 0; i < sizeof(challenges); i++) {
+        ((uint8_t *)challenges)[i] = (uint8_t)i;
+    }
+
+    status = tfm_initial_attest_get_batch_token((uint8_t *)challenges,
+                                            PSA_INITIAL_ATTEST_CHALLENGE_SIZE_32,
+                                            BATCH_TEST_NUM_CHALLENGES,
+                                            token_storage.ptr,
+                                            token_storage.len,
+                                            &token_size);
+    if(status != PSA_SUCCESS) {
+        return_value = (int_fast16_t)status;
+        goto Done;
+    }
+    completed_token.ptr = token_storage.ptr;
+    completed_token.len = token_size;
+
+    /* -- Initialize and validate the signature on the token -- */
+    attest_token_decode_init(&token_decode, 0);
+    return_value = attest_token_decode_validate_token(&token_decode,
+                                                      completed_token);
+    if(return_value != ATTEST_TOKEN_ERR_SUCCESS) {
+        goto Done;
+    }
+
+    return_value = attest_token_decode_get_nonce(&token_decode, &nonce);
+    if(return_value != ATTEST_TOKEN_ERR_SUCCESS) {
+        goto Done;
+    }
+
+    /* -- Compute the root: ((leaf 0, leaf 1), leaf 2) -- */
+    for(i = 0; i < BATCH_TEST_NUM_CHALLENGES; i++) {
+        left.ptr = challenges[i];
+        left.len = sizeof(challenges[i]);
+        return_value = batch_hash_node(0x00, left, NULL_Q_USEFUL_BUF_C,
+                                       leaves[i]);
+        if(return_value) {
+            goto Done;
+        }
+    }
+
+    left.ptr = leaves[0];
+    left.len = sizeof(leaves[0]);
+    right.ptr = leaves[1];
+    right.len = sizeof(leaves[1]);
+    return_value = batch_hash_node(0x01, left, right, root);
+    if(return_value) {
+        goto Done;
+    }
+
+    left.ptr = root;
+    left.len = sizeof(root);
+    right.ptr = leaves[2];
+    right.len = sizeof(leaves[2]);
+    return_value = batch_hash_node(0x01, left, right, root);
+    if(return_value) {
+        goto Done;
+    }
+
+    if(q_useful_buf_compare(nonce,
+                            Q_USEFUL_BUF_FROM_BYTE_ARRAY_LITERAL(root))) {
+        return_value = -301;
+        goto Done;
+    }
+
+    return_value = 0;
+
+Done:
+    return return_value;
+}
+#endif /* ATTEST_BATCH_TOKEN */
@@ -75,6 +75,10 @@ int_fast16_t buffer_too_small_test(void);
  * requires that the t_cose crypto porting layer operates correctly
  * and that all keys are present. See also
  * decode_test_short_circuit_sig().
+ *
+ * With \c ATTEST_TOKEN_MAC0 the token is a \c COSE_Mac0. Its
+ * structure and algorithm are checked, but not its tag, as the HMAC
+ * key never leaves the Crypto service.
  */
 int_fast16_t decode_test_normal_sig(void);
 
@@ -99,6 +103,19 @@ int_fast16_t decode_test_normal_sig(void);
  */
 int_fast16_t decode_test_short_circuit_sig(void);
 
+#ifdef ATTEST_BATCH_TOKEN
+/**
+ * \brief Test of a batch token.
+ *
+ * \return non-zero on failure.
+ *
+ * A token is requested for a batch of challenges and its signature is
+ * verified. Its challenge claim is checked against the root of the Merkle
+ * tree of the challenges, which is computed by the test.
+ */
+int_fast16_t decode_test_batch_token(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -25,6 +25,9 @@ static void tfm_attest_test_2003(struct test_result_t *ret);
 #endif
 static void tfm_attest_test_2004(struct test_result_t *ret);
 static void tfm_attest_test_2005(struct test_result_t *ret);
+#ifdef ATTEST_BATCH_TOKEN
+static void tfm_attest_test_2006(struct test_result_t *ret);
+#endif
 
 static struct test_t attestation_interface_tests[] = {
 #ifdef INCLUDE_TEST_CODE /* Remove them from release build */
@@ -35,10 +38,19 @@ static struct test_t attestation_interface_tests[] = {
     {&tfm_attest_test_2003, "TFM_ATTEST_TEST_2003",
      "Short circuit signature test of attest token", {0} },
 #endif
+#ifdef ATTEST_TOKEN_MAC0
+    {&tfm_attest_test_2004, "TFM_ATTEST_TEST_2004",
+     "COSE_Mac0 test of attest token", {0} },
+#else
     {&tfm_attest_test_2004, "TFM_ATTEST_TEST_2004",
      "ECDSA signature test of attest token", {0} },
+#endif
     {&tfm_attest_test_2005, "TFM_ATTEST_TEST_2005",
      "Negative test cases for initial attestation service", {0} },
+#ifdef ATTEST_BATCH_TOKEN
+    {&tfm_attest_test_2006, "TFM_ATTEST_TEST_2006",
+     "Batch token test of attest token", {0} },
+#endif
 };
 
 void
@@ -122,7 +134,8 @@ static void tfm_attest_test_2003(struct test_result_t *ret)
  *        presence of claims and compare them against expected values in
  *        token_test_values.h
  *
- * ECDSA signing is currently not supported in TF_M.
+ * With ATTEST_TOKEN_MAC0 the token is a COSE_Mac0, whose HMAC tag is not
+ * checked as its key never leaves the Crypto service.
  *
  * More info in token_test.h
  */
@@ -181,3 +194,24 @@ static void tfm_attest_test_2005(struct test_result_t *ret)
 
     ret->val = TEST_PASSED;
 }
+
+#ifdef ATTEST_BATCH_TOKEN
+/*!
+ * \brief Get one token for a batch of challenges. Validate its signature, or
+ *        its COSE_Mac0 structure with ATTEST_TOKEN_MAC0, and compare its
+ *        challenge claim with the root of the Merkle tree of the challenges.
+ */
+static void tfm_attest_test_2006(struct test_result_t *ret)
+{
+    int32_t err;
+
+    err = decode_test_batch_token();
+    if (err != 0) {
+        TEST_LOG("decode_test_batch_token() returned: %d\r\n", err);
+        TEST_FAIL("Attest token decode_test_batch_token() has failed");
+        return;
+    }
+
+    ret->val = TEST_PASSED;
+}
+#endif /* ATTEST_BATCH_TOKEN */
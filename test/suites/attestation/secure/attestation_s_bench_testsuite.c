@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "attestation_s_tests.h"
+#include "psa/initial_attestation.h"
+#include "attest_token.h"
+#include "tfm_hal_device_header.h"
+#include "test/framework/test_framework_helpers.h"
+
+/**
+ * \brief Number of tokens created for each token option, the reported cycles
+ *        are the average of the tokens
+ *
+ */
+#ifndef ATTEST_BENCH_LOOPS
+#define ATTEST_BENCH_LOOPS (4)
+#endif
+
+/* Fields of each line of the benchmark, after the BENCH tag:
+ *  - the token option, see the TOKEN_OPT_* flags of attest_token.h
+ *  - the number of tokens created
+ *  - the cycles taken by a call to psa_initial_attest_get_token()
+ *  - the tokens per second at the frequency of the core, with two decimals
+ *  - the cycles taken by attest_create_token() in the service
+ *  - the cycles taken by each stage of attest_create_token(): the key
+ *    registration, the gathering of the claims, the encoding, and the hash
+ *    and signature
+ * The last five fields are the profiling counters of the service, and are -
+ * when the service is built without ATTEST_PROFILING.
+ */
+#define BENCH_FIELDS "option,tokens,cycles,tokens_per_s,service," \
+                     "key,claims,encode,sign"
+
+/*!
+ * \struct bench_option_t
+ *
+ * \brief Token option measured by the benchmark.
+ */
+struct bench_option_t {
+    const char *name; /*!< Name of the option, printed in each line */
+    uint32_t flags;   /*!< Option flags passed in the challenge */
+};
+
+/* The options are passed to the service in a 64 byte challenge, which is only
+ * parsed when the service is built with the test code.
+ */
+static const struct bench_option_t bench_options[] = {
+    {"none", 0},
+#ifdef INCLUDE_TEST_CODE /* Remove them from release build */
+    {"omit_claims", TOKEN_OPT_OMIT_CLAIMS},
+    {"short_circuit_sign", TOKEN_OPT_SHORT_CIRCUIT_SIGN},
+    {"omit_claims+short_circuit_sign",
+     TOKEN_OPT_OMIT_CLAIMS | TOKEN_OPT_SHORT_CIRCUIT_SIGN},
+#endif
+};
+
+static uint8_t bench_challenge[PSA_INITIAL_ATTEST_CHALLENGE_SIZE_64];
+static uint8_t bench_token[PSA_INITIAL_ATTEST_MAX_TOKEN_SIZE];
+
+/* List of tests */
+static void tfm_attest_test_5001(struct test_result_t *ret);
+
+static struct test_t attestation_bench_tests[] = {
+    {&tfm_attest_test_5001, "TFM_ATTEST_TEST_5001",
+     "Token creation benchmark by token option", {0} },
+};
+
+void
+register_testsuite_s_attestation_benchmark(struct test_suite_t *p_test_suite)
+{
+    uint32_t list_size;
+
+    list_size = (sizeof(attestation_bench_tests) /
+                 sizeof(attestation_bench_tests[0]));
+
+    set_testsuite("Initial Attestation Service secure benchmark "
+                  "(TFM_ATTEST_TEST_5XXX)",
+                  attestation_bench_tests, list_size, p_test_suite);
+}
+
+/**
+ * \brief Fills the challenge which selects the token option. A challenge
+ *        without option has non-zero bytes after the first four, so that it is
+ *        not parsed as option flags.
+ */
+static void bench_set_challenge(uint32_t flags)
+{
+    uint32_t i;
+
+    if (flags == 0) {
+        for (i = 0; i < sizeof(bench_challenge); i++) {
+            bench_challenge[i] = (uint8_t)(i + 1);
+        }
+    } else {
+        (void)memset(bench_challenge, 0, sizeof(bench_challenge));
+        (void)memcpy(bench_challenge, &flags, sizeof(flags));
+    }
+}
+
+/**
+ * \brief Prints one benchmark line, with the tokens per second in
+ *        hundredths.
+ */
+static void bench_log(const struct bench_option_t *option, uint32_t cycles,
+                      psa_status_t profile_status,
+                      const struct tfm_initial_attest_profile_t *profile)
+{
+    uint32_t per_s;
+    uint32_t i;
+
+    TEST_LOG("BENCH,%s,%u,%u,", option->name, (unsigned int)ATTEST_BENCH_LOOPS,
+             (unsigned int)cycles);
+
+    if (cycles == 0) {
+        TEST_LOG("-,");
+    } else {
+        per_s = (uint32_t)(((uint64_t)SystemCoreClock * 100) / cycles);
+        bench_log_hundredths(per_s, ",");
+    }
+
+    if ((profile_status != PSA_SUCCESS) || (profile->num_tokens == 0)) {
+        TEST_LOG("-,-,-,-,-\r\n");
+        return;
+    }
+
+    TEST_LOG("%u", (unsigned int)(profile->total_cycles / profile->num_tokens));
+    for (i = 0; i < TFM_INITIAL_ATTEST_STAGE_NUM; i++) {
+        TEST_LOG(",%u", (unsigned int)(profile->stage_cycles[i] /
+                                       profile->num_tokens));
+    }
+    TEST_LOG("\r\n");
+}
+
+/**
+ * \brief Secure benchmark for the initial attestation service
+ *
+ * \details The scope of this test is to measure the cycles taken by the
+ *          creation of a token for each token option. One token is created
+ *          before the measurement, so that the key registration and the
+ *          gathering of the claims done by the first token are not measured.
+ *          The results are printed as BENCH lines, described above, which can
+ *          be collected from the test log.
+ *
+ */
+static void tfm_attest_test_5001(struct test_result_t *ret)
+{
+    struct tfm_initial_attest_profile_t profile;
+    psa_status_t profile_status;
+    psa_status_t status;
+    size_t token_size;
+    uint32_t cycles;
+    uint32_t start;
+    uint32_t i;
+    uint32_t j;
+
+    if (test_timer_start() != 0) {
+        TEST_LOG("No cycle counter, the cycles are reported as 0.\r\n");
+    }
+
+    profile_status = tfm_initial_attest_get_profile(&profile, 1);
+    if (profile_status == PSA_ERROR_NOT_SUPPORTED) {
+        TEST_LOG("ATTEST_PROFILING is disabled, the stages are not "
+                 "reported.\r\n");
+    } else if (profile_status != PSA_SUCCESS) {
+        TEST_FAIL("Failed to read the profiling counters");
+        return;
+    }
+
+    bench_log_header(BENCH_FIELDS);
+
+    for (i = 0; i < sizeof(bench_options) / sizeof(bench_options[0]); i++) {
+        bench_set_challenge(bench_options[i].flags);
+
+        status = psa_initial_attest_get_token(bench_challenge,
+                                              sizeof(bench_challenge),
+                                              bench_token,
+                                              sizeof(bench_token),
+                                              &token_size);
+        if (status != PSA_SUCCESS) {
+            TEST_LOG("BENCH,%s,failed,%d\r\n", bench_options[i].name,
+                     (int)status);
+            TEST_FAIL("Failed to create the attestation token");
+            return;
+        }
+
+        if (profile_status == PSA_SUCCESS) {
+            (void)tfm_initial_attest_get_profile(&profile, 1);
+        }
+
+        cycles = 0;
+        for (j = 0; j < ATTEST_BENCH_LOOPS; j++) {
+            start = test_timer_read();
+            status = psa_initial_attest_get_token(bench_challenge,
+                                                  sizeof(bench_challenge),
+                                                  bench_token,
+                                                  sizeof(bench_token),
+                                                  &token_size);
+            cycles += test_timer_read() - start;
+            if (status != PSA_SUCCESS) {
+                TEST_FAIL("Failed to create the attestation token");
+                return;
+            }
+        }
+
+        if (profile_status == PSA_SUCCESS) {
+            profile_status = tfm_initial_attest_get_profile(&profile, 1);
+        }
+
+        bench_log(&bench_options[i], cycles / ATTEST_BENCH_LOOPS,
+                  profile_status, &profile);
+    }
+
+    ret->val = TEST_PASSED;
+}
@@ -22,6 +22,16 @@ extern "C" {
 void
 register_testsuite_s_attestation_interface(struct test_suite_t *p_test_suite);
 
+#ifdef ENABLE_ATTESTATION_BENCHMARK_TESTS
+/**
+ * \brief Register testsuite for the initial attestation secure benchmark.
+ *
+ * \param[in] p_test_suite  The test suite to be executed.
+ */
+void
+register_testsuite_s_attestation_benchmark(struct test_suite_t *p_test_suite);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
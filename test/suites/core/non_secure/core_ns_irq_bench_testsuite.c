@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdint.h>
+#include "core_ns_tests.h"
+#include "psa/client.h"
+#include "psa/crypto.h"
+#include "psa_manifest/sid.h"
+#include "test/framework/test_framework_helpers.h"
+#include "test/test_services/tfm_core_test/core_test_defs.h"
+
+/* Size of the buffer the loads work on */
+#ifndef IRQ_BENCH_LOAD_SIZE
+#define IRQ_BENCH_LOAD_SIZE 16384
+#endif
+
+/* Fields of each line of the benchmark, after the BENCH tag:
+ *  - the load running when the secure timer interrupt is asserted
+ *  - the measured point: the return of psa_wait() in the handling partition,
+ *    or the return of its psa_eoi()
+ *  - the number of interrupts measured
+ *  - the minimum, average and maximum ticks of the secure timer between the
+ *    assertion of the interrupt and the point
+ */
+#define BENCH_FIELDS "load,point,samples,min_ticks,avg_ticks,max_ticks"
+
+static uint8_t bench_buf[IRQ_BENCH_LOAD_SIZE];
+
+/* Checksum of the NS load, kept so that the load is not optimised out */
+static volatile uint32_t bench_sum;
+
+/* List of tests */
+static void tfm_core_test_1101(struct test_result_t *ret);
+static void tfm_core_test_1102(struct test_result_t *ret);
+#ifdef TFM_PARTITION_CRYPTO
+static void tfm_core_test_1103(struct test_result_t *ret);
+#endif
+
+static struct test_t core_irq_bench_tests[] = {
+    {&tfm_core_test_1101, "TFM_CORE_TEST_1101",
+     "Secure IRQ latency benchmark, partition waiting", {0} },
+    {&tfm_core_test_1102, "TFM_CORE_TEST_1102",
+     "Secure IRQ latency benchmark, NS load", {0} },
+#ifdef TFM_PARTITION_CRYPTO
+    {&tfm_core_test_1103, "TFM_CORE_TEST_1103",
+     "Secure IRQ latency benchmark, crypto operations", {0} },
+#endif
+};
+
+void register_testsuite_ns_core_irq_benchmark(struct test_suite_t *p_test_suite)
+{
+    uint32_t list_size = (sizeof(core_irq_bench_tests) /
+                          sizeof(core_irq_bench_tests[0]));
+
+    set_testsuite("Core non-secure IRQ latency benchmark (TFM_CORE_TEST_11XX)",
+                  core_irq_bench_tests, list_size, p_test_suite);
+}
+
+/* The load applied while the interrupts are measured, NULL for none */
+typedef int32_t (*irq_bench_load_t)(void);
+
+static void bench_log_point(const char *load, const char *point,
+                            const struct irq_test_latency_t *latency,
+                            const struct irq_test_latency_stage_t *stage)
+{
+    TEST_LOG("BENCH,%s,%s,%u,%u,", load, point,
+             (unsigned int)latency->samples, (unsigned int)stage->min);
+    bench_log_hundredths((uint32_t)(((uint64_t)stage->sum * 100) /
+                                    latency->samples), ",");
+    TEST_LOG("%u\r\n", (unsigned int)stage->max);
+}
+
+static int32_t bench_call(uint32_t sid, uint32_t version, uint32_t scenario,
+                          struct irq_test_latency_t *latency)
+{
+    /* The execution data is not used by the latency scenarios */
+    struct irq_test_execution_data_t *execution_data = NULL;
+    psa_invec in_vec[] = { {&scenario, sizeof(scenario)},
+                           {&execution_data, sizeof(execution_data)} };
+    psa_outvec out_vec[] = { {latency, sizeof(*latency)} };
+    psa_handle_t handle;
+    psa_status_t status;
+
+    handle = psa_connect(sid, version);
+    if (handle <= 0) {
+        return CORE_TEST_ERRNO_TEST_FAULT;
+    }
+
+    status = psa_call(handle, PSA_IPC_CALL, in_vec, 2, out_vec,
+                      (latency != NULL) ? 1 : 0);
+
+    psa_close(handle);
+
+    return status;
+}
+
+/**
+ * \brief Measures the latency of the handling of the secure timer interrupt
+ *        by the TFM_IRQ_TEST_1 partition, and prints it.
+ *
+ * \details Without a load, the partition waits for the interrupts in
+ *          psa_wait() while the NS side is blocked in the call. With a load,
+ *          the partition handles the interrupts from its main loop, and the
+ *          NS side runs the load until all the interrupts are measured.
+ */
+static void bench_irq_latency(const char *name, irq_bench_load_t load,
+                              struct test_result_t *ret)
+{
+    struct irq_test_latency_t latency = {0};
+    uint32_t scenario = (load == NULL) ? IRQ_TEST_SCENARIO_LATENCY_IDLE :
+                                         IRQ_TEST_SCENARIO_LATENCY_LOADED;
+    int32_t err;
+
+    err = bench_call(SPM_CORE_IRQ_TEST_1_PREPARE_TEST_SCENARIO_SID,
+                     SPM_CORE_IRQ_TEST_1_PREPARE_TEST_SCENARIO_VERSION,
+                     scenario, NULL);
+    if (err != CORE_TEST_ERRNO_SUCCESS) {
+        TEST_FAIL("Failed to prepare the IRQ latency scenario");
+        return;
+    }
+
+    do {
+        if (load != NULL) {
+            err = load();
+            if (err != CORE_TEST_ERRNO_SUCCESS) {
+                TEST_FAIL("The load of the benchmark failed");
+                return;
+            }
+        }
+
+        err = bench_call(SPM_CORE_IRQ_TEST_1_EXECUTE_TEST_SCENARIO_SID,
+                         SPM_CORE_IRQ_TEST_1_EXECUTE_TEST_SCENARIO_VERSION,
+                         scenario, &latency);
+        if (err != CORE_TEST_ERRNO_SUCCESS) {
+            TEST_FAIL("Failed to read the IRQ latency");
+            return;
+        }
+    } while (latency.samples < IRQ_TEST_LATENCY_SAMPLES);
+
+    bench_log_point(name, "psa_wait", &latency, &latency.wake);
+    bench_log_point(name, "psa_eoi", &latency, &latency.eoi);
+
+    ret->val = TEST_PASSED;
+}
+
+/* NS load: a checksum of the buffer, between two reads of the latency */
+static int32_t bench_load_ns(void)
+{
+    uint32_t sum = bench_sum;
+    uint32_t i;
+
+    for (i = 0; i < sizeof(bench_buf); i++) {
+        sum = (sum << 1) + (sum >> 31) + bench_buf[i] + i;
+    }
+    bench_sum = sum;
+
+    return CORE_TEST_ERRNO_SUCCESS;
+}
+
+#ifdef TFM_PARTITION_CRYPTO
+/* Crypto load: a SHA-256 of the whole buffer, a single long operation of the
+ * crypto partition
+ */
+static int32_t bench_load_crypto(void)
+{
+    uint8_t hash[PSA_HASH_SIZE(PSA_ALG_SHA_256)];
+    size_t hash_len;
+    psa_status_t status;
+
+    status = psa_hash_compute(PSA_ALG_SHA_256, bench_buf, sizeof(bench_buf),
+                              hash, sizeof(hash), &hash_len);
+
+    return (status == PSA_SUCCESS) ? CORE_TEST_ERRNO_SUCCESS :
+                                     CORE_TEST_ERRNO_TEST_FAULT;
+}
+#endif
+
+/**
+ * \brief Non Secure benchmark of the secure interrupt latency
+ *
+ * \details The scope of this set of tests is to measure the time taken by
+ *          the TFM_IRQ_TEST_1 partition to be woken up by the secure timer
+ *          interrupt, and to end its handling, when the partition waits for
+ *          the interrupt and when the NS side or the crypto partition are
+ *          running. The results are printed as BENCH lines, described above,
+ *          which can be collected from the test log.
+ */
+static void tfm_core_test_1101(struct test_result_t *ret)
+{
+    bench_log_header(BENCH_FIELDS);
+
+    bench_irq_latency("idle", NULL, ret);
+}
+
+static void tfm_core_test_1102(struct test_result_t *ret)
+{
+    bench_irq_latency("ns", bench_load_ns, ret);
+}
+
+#ifdef TFM_PARTITION_CRYPTO
+static void tfm_core_test_1103(struct test_result_t *ret)
+{
+    bench_irq_latency("crypto", bench_load_crypto, ret);
+}
+#endif
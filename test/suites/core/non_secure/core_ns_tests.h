@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Arm Limited. All rights reserved.
+ * Copyright (c) 2017-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -28,6 +28,13 @@ void register_testsuite_ns_core_positive(struct test_suite_t *p_test_suite);
  */
 void register_testsuite_ns_core_interactive(struct test_suite_t *p_test_suite);
 
+/**
+ * \brief Register testsuite for the secure IRQ latency benchmark.
+ *
+ * \param[in] p_test_suite  The test suite to be executed.
+ */
+void register_testsuite_ns_core_irq_benchmark(struct test_suite_t *p_test_suite);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdint.h>
+#include "core_s_tests.h"
+#include "tfm_core_utils.h"
+#include "tfm_hal_device_header.h"
+#include "test/framework/test_framework_helpers.h"
+
+#define UTILS_TEST_BUF_SIZE     256
+#define UTILS_TEST_MAX_OFFSET   sizeof(uint32_t)
+#define UTILS_BENCH_SIZE        2048
+#define UTILS_BENCH_LOOPS       16
+
+/* Guard bytes around each copy or set to catch over and under runs */
+#define UTILS_TEST_GUARD        0xA5
+
+/* List of tests */
+static void tfm_core_utils_test_1001(struct test_result_t *ret);
+static void tfm_core_utils_test_1002(struct test_result_t *ret);
+static void tfm_core_utils_test_1003(struct test_result_t *ret);
+
+static struct test_t core_utils_tests[] = {
+    {&tfm_core_utils_test_1001, "TFM_CORE_UTILS_TEST_1001",
+     "Memory copy for every alignment combination", {0} },
+    {&tfm_core_utils_test_1002, "TFM_CORE_UTILS_TEST_1002",
+     "Memory set for every alignment", {0} },
+    {&tfm_core_utils_test_1003, "TFM_CORE_UTILS_TEST_1003",
+     "Memory copy and set throughput", {0} },
+};
+
+void register_testsuite_s_core_utils(struct test_suite_t *p_test_suite)
+{
+    uint32_t list_size;
+
+    list_size = (sizeof(core_utils_tests) / sizeof(core_utils_tests[0]));
+
+    set_testsuite("Core utility secure tests (TFM_CORE_UTILS_TEST_1XXX)",
+                  core_utils_tests, list_size, p_test_suite);
+}
+
+static uint32_t src_buf[(UTILS_TEST_BUF_SIZE + 2 * UTILS_TEST_MAX_OFFSET) /
+                        sizeof(uint32_t)];
+static uint32_t dst_buf[(UTILS_TEST_BUF_SIZE + 2 * UTILS_TEST_MAX_OFFSET) /
+                        sizeof(uint32_t)];
+
+/**
+ * \brief Checks that the bytes outside [start, start + len) of dst_buf still
+ *        hold the guard value and the bytes inside match the expected ones.
+ */
+static int check_dst(size_t start, size_t len, const uint8_t *expected,
+                     uint8_t value)
+{
+    const uint8_t *p_dst = (const uint8_t *)dst_buf;
+    size_t i;
+
+    for (i = 0; i < sizeof(dst_buf); i++) {
+        if (i < start || i >= start + len) {
+            if (p_dst[i] != UTILS_TEST_GUARD) {
+                return 0;
+            }
+        } else if (p_dst[i] != (expected ? expected[i - start] : value)) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/**
+ * \brief Copies every length up to the buffer size for every combination of
+ *        source and destination alignment.
+ */
+static void tfm_core_utils_test_1001(struct test_result_t *ret)
+{
+    uint8_t *p_src = (uint8_t *)src_buf;
+    uint8_t *p_dst = (uint8_t *)dst_buf;
+    size_t src_off, dst_off, len, i;
+
+    for (i = 0; i < sizeof(src_buf); i++) {
+        p_src[i] = (uint8_t)(i * 7 + 1);
+    }
+
+    for (src_off = 0; src_off < UTILS_TEST_MAX_OFFSET; src_off++) {
+        for (dst_off = 0; dst_off < UTILS_TEST_MAX_OFFSET; dst_off++) {
+            for (len = 0; len <= UTILS_TEST_BUF_SIZE; len++) {
+                for (i = 0; i < sizeof(dst_buf); i++) {
+                    p_dst[i] = UTILS_TEST_GUARD;
+                }
+
+                if (tfm_core_util_memcpy(p_dst + dst_off, p_src + src_off,
+                                         len) != p_dst + dst_off) {
+                    TEST_FAIL("Memory copy returned a wrong pointer");
+                    return;
+                }
+
+                if (!check_dst(dst_off, len, p_src + src_off, 0)) {
+                    TEST_FAIL("Memory copy result is not correct");
+                    return;
+                }
+            }
+        }
+    }
+
+    ret->val = TEST_PASSED;
+}
+
+/**
+ * \brief Sets every length up to the buffer size for every alignment.
+ */
+static void tfm_core_utils_test_1002(struct test_result_t *ret)
+{
+    uint8_t *p_dst = (uint8_t *)dst_buf;
+    size_t dst_off, len, i;
+
+    for (dst_off = 0; dst_off < UTILS_TEST_MAX_OFFSET; dst_off++) {
+        for (len = 0; len <= UTILS_TEST_BUF_SIZE; len++) {
+            for (i = 0; i < sizeof(dst_buf); i++) {
+                p_dst[i] = UTILS_TEST_GUARD;
+            }
+
+            if (tfm_core_util_memset(p_dst + dst_off, 0x5A, len) !=
+                p_dst + dst_off) {
+                TEST_FAIL("Memory set returned a wrong pointer");
+                return;
+            }
+
+            if (!check_dst(dst_off, len, NULL, 0x5A)) {
+                TEST_FAIL("Memory set result is not correct");
+                return;
+            }
+        }
+    }
+
+    ret->val = TEST_PASSED;
+}
+
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || \
+    defined(__ARM_ARCH_8M_MAIN__) || defined(__ARM_ARCH_8_1M_MAIN__)
+static uint32_t bench_src[UTILS_BENCH_SIZE / sizeof(uint32_t) + 1];
+static uint32_t bench_dst[UTILS_BENCH_SIZE / sizeof(uint32_t) + 1];
+
+/**
+ * \brief Logs the throughput of one copy or set case, computed in hundredths
+ *        of a byte per cycle as the log does not print floating point values.
+ */
+static void log_throughput(const char *name, uint32_t cycles)
+{
+    uint32_t rate = (uint32_t)(((uint64_t)UTILS_BENCH_SIZE *
+                                UTILS_BENCH_LOOPS * 100) / cycles);
+
+    /* The log does not support field widths, print the two decimals */
+    TEST_LOG("  > %s: %d.%d%d bytes/cycle\r\n", name, (int)(rate / 100),
+             (int)((rate / 10) % 10), (int)(rate % 10));
+}
+
+static uint32_t bench_memcpy(size_t dst_off, size_t src_off)
+{
+    uint32_t start;
+    uint32_t i;
+
+    start = DWT->CYCCNT;
+    for (i = 0; i < UTILS_BENCH_LOOPS; i++) {
+        tfm_core_util_memcpy((uint8_t *)bench_dst + dst_off,
+                             (uint8_t *)bench_src + src_off,
+                             UTILS_BENCH_SIZE);
+    }
+
+    return DWT->CYCCNT - start;
+}
+
+/**
+ * \brief Measures the throughput of the memory copy and set functions with
+ *        the cycle counter. The test only fails if there is no cycle counter.
+ */
+static void tfm_core_utils_test_1003(struct test_result_t *ret)
+{
+    uint32_t start;
+    uint32_t i;
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    if (DWT->CTRL & DWT_CTRL_NOCYCCNT_Msk) {
+        TEST_FAIL("The cycle counter is not implemented");
+        return;
+    }
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    log_throughput("memcpy, aligned", bench_memcpy(0, 0));
+    log_throughput("memcpy, source misaligned", bench_memcpy(0, 1));
+    log_throughput("memcpy, destination misaligned", bench_memcpy(3, 0));
+
+    start = DWT->CYCCNT;
+    for (i = 0; i < UTILS_BENCH_LOOPS; i++) {
+        tfm_core_util_memset(bench_dst, 0, UTILS_BENCH_SIZE);
+    }
+    log_throughput("memset", DWT->CYCCNT - start);
+
+    ret->val = TEST_PASSED;
+}
+#else
+static void tfm_core_utils_test_1003(struct test_result_t *ret)
+{
+    /* Baseline architectures have no cycle counter, nothing to measure */
+    ret->val = TEST_PASSED;
+}
+#endif
@@ -0,0 +1,549 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdint.h>
+#include "crypto_bench_common.h"
+
+/* Fields of each line of the benchmark, after the BENCH tag:
+ *  - the caller of the service, S or NS
+ *  - the measured operation
+ *  - the size of the message in bytes, 0 for operations without a message
+ *  - the number of calls to the service made by the operation
+ *  - the cycles taken by the operation
+ *  - the share of the cycles spent in the calls, that is the number of calls
+ *    times the cost of a call which does no cryptographic work
+ *  - the remaining cycles, spent in the algorithm
+ *  - cpb (cycles per byte) or cpo (cycles per operation)
+ *  - the cycles per byte, with two decimals, or the cycles per operation
+ */
+#define BENCH_FIELDS "side,operation,bytes,calls,cycles,call_cycles," \
+                     "alg_cycles,unit,value"
+
+static const uint32_t bench_sizes[] = {16, 64, 256, 1024, 4096, 16384};
+
+static uint8_t bench_in[CRYPTO_BENCH_MAX_SIZE];
+static uint8_t bench_out[CRYPTO_BENCH_MAX_SIZE + 16];
+
+static const uint8_t bench_key[] = "THIS IS MY KEY1 THIS IS MY KEY2";
+static const uint8_t bench_iv[] = "012345678901234";
+
+/* Cycles taken by a call which does no cryptographic work */
+static uint32_t bench_call_cycles;
+
+/**
+ * \brief Starts the cycle counter of the test framework. The benchmark is
+ *        skipped if there is none.
+ */
+static int bench_counter_start(struct test_result_t *ret)
+{
+    if (test_timer_start() != 0) {
+        TEST_LOG("No cycle counter, the benchmark was SKIPPED.\r\n");
+        ret->val = TEST_PASSED;
+        return 0;
+    }
+
+    return 1;
+}
+
+static void bench_fill_input(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < sizeof(bench_in); i++) {
+        bench_in[i] = (uint8_t)i;
+    }
+}
+
+/**
+ * \brief Measures the cost of a call to the service, as the average over
+ *        \ref CRYPTO_BENCH_CALL_LOOPS aborts of an inactive hash operation
+ */
+static uint32_t bench_measure_call(void)
+{
+    psa_hash_operation_t handle = psa_hash_operation_init();
+    uint32_t start;
+    uint32_t i;
+
+    start = test_timer_read();
+    for (i = 0; i < CRYPTO_BENCH_CALL_LOOPS; i++) {
+        (void)psa_hash_abort(&handle);
+    }
+
+    return (test_timer_read() - start) / CRYPTO_BENCH_CALL_LOOPS;
+}
+
+static uint32_t bench_get_call_cycles(void)
+{
+    if (bench_call_cycles == 0) {
+        bench_call_cycles = bench_measure_call();
+    }
+
+    return bench_call_cycles;
+}
+
+/**
+ * \brief Prints one benchmark line, with the cycles per byte in hundredths.
+ */
+static void bench_log(const char *side, const char *name, uint32_t bytes,
+                      uint32_t calls, uint32_t cycles)
+{
+    uint32_t call_cycles = calls * bench_get_call_cycles();
+    uint32_t alg_cycles = (cycles > call_cycles) ? (cycles - call_cycles) : 0;
+    uint32_t rate;
+
+    TEST_LOG("BENCH,%s,%s,%u,%u,%u,%u,%u,", side, name,
+             (unsigned int)bytes, (unsigned int)calls, (unsigned int)cycles,
+             (unsigned int)call_cycles, (unsigned int)alg_cycles);
+
+    if (bytes == 0) {
+        TEST_LOG("cpo,%u\r\n", (unsigned int)cycles);
+    } else {
+        rate = (uint32_t)(((uint64_t)cycles * 100) / bytes);
+        TEST_LOG("cpb,");
+        bench_log_hundredths(rate, "\r\n");
+    }
+}
+
+static void bench_log_skipped(const char *side, const char *name,
+                              uint32_t bytes, psa_status_t status)
+{
+    TEST_LOG("BENCH,%s,%s,%u,skipped,%d\r\n", side, name,
+             (unsigned int)bytes, (int)status);
+}
+
+static psa_status_t bench_import_key(psa_key_type_t key_type,
+                                     psa_algorithm_t alg,
+                                     psa_key_usage_t usage,
+                                     size_t key_size,
+                                     psa_key_handle_t *key_handle)
+{
+    psa_key_attributes_t key_attributes = psa_key_attributes_init();
+
+    psa_set_key_usage_flags(&key_attributes, usage);
+    psa_set_key_algorithm(&key_attributes, alg);
+    psa_set_key_type(&key_attributes, key_type);
+
+    return psa_import_key(&key_attributes, bench_key, key_size, key_handle);
+}
+
+void psa_call_bench_test(const char *side, struct test_result_t *ret)
+{
+    if (!bench_counter_start(ret)) {
+        return;
+    }
+
+    bench_call_cycles = bench_measure_call();
+
+    bench_log_header(BENCH_FIELDS);
+    bench_log(side, "call", 0, 1, bench_call_cycles);
+
+    ret->val = TEST_PASSED;
+}
+
+void psa_hash_bench_test(const char *side, const char *name,
+                         const psa_algorithm_t alg,
+                         struct test_result_t *ret)
+{
+    psa_hash_operation_t handle;
+    psa_status_t status;
+    uint8_t hash[PSA_HASH_MAX_SIZE];
+    size_t hash_length;
+    uint32_t start, cycles;
+    uint32_t i, j;
+
+    if (!bench_counter_start(ret)) {
+        return;
+    }
+    bench_fill_input();
+
+    for (i = 0; i < sizeof(bench_sizes) / sizeof(bench_sizes[0]); i++) {
+        if (bench_sizes[i] > CRYPTO_BENCH_MAX_SIZE) {
+            break;
+        }
+
+        cycles = 0;
+        for (j = 0; j < CRYPTO_BENCH_LOOPS; j++) {
+            handle = psa_hash_operation_init();
+
+            start = test_timer_read();
+            status = psa_hash_setup(&handle, alg);
+            if (status == PSA_SUCCESS) {
+                status = psa_hash_update(&handle, bench_in, bench_sizes[i]);
+            }
+            if (status == PSA_SUCCESS) {
+                status = psa_hash_finish(&handle, hash, sizeof(hash),
+                                         &hash_length);
+            }
+            cycles += test_timer_read() - start;
+
+            if (status != PSA_SUCCESS) {
+                (void)psa_hash_abort(&handle);
+                TEST_FAIL("Error computing the hash");
+                return;
+            }
+        }
+
+        bench_log(side, name, bench_sizes[i], 3, cycles / CRYPTO_BENCH_LOOPS);
+    }
+
+    ret->val = TEST_PASSED;
+}
+
+void psa_mac_bench_test(const char *side, const char *name,
+                        const psa_algorithm_t alg,
+                        struct test_result_t *ret)
+{
+    psa_mac_operation_t handle;
+    psa_key_handle_t key_handle;
+    psa_status_t status;
+    uint8_t mac[PSA_MAC_MAX_SIZE];
+    size_t mac_length;
+    uint32_t start, cycles;
+    uint32_t i, j;
+
+    if (!bench_counter_start(ret)) {
+        return;
+    }
+    bench_fill_input();
+
+    status = bench_import_key(PSA_KEY_TYPE_HMAC, alg, PSA_KEY_USAGE_SIGN,
+                              32, &key_handle);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error importing a key");
+        return;
+    }
+
+    ret->val = TEST_PASSED;
+
+    for (i = 0; i < sizeof(bench_sizes) / sizeof(bench_sizes[0]); i++) {
+        if (bench_sizes[i] > CRYPTO_BENCH_MAX_SIZE) {
+            break;
+        }
+
+        cycles = 0;
+        for (j = 0; j < CRYPTO_BENCH_LOOPS; j++) {
+            handle = psa_mac_operation_init();
+
+            start = test_timer_read();
+            status = psa_mac_sign_setup(&handle, key_handle, alg);
+            if (status == PSA_SUCCESS) {
+                status = psa_mac_update(&handle, bench_in, bench_sizes[i]);
+            }
+            if (status == PSA_SUCCESS) {
+                status = psa_mac_sign_finish(&handle, mac, sizeof(mac),
+                                             &mac_length);
+            }
+            cycles += test_timer_read() - start;
+
+            if (status != PSA_SUCCESS) {
+                (void)psa_mac_abort(&handle);
+                TEST_FAIL("Error computing the MAC");
+                goto destroy_key;
+            }
+        }
+
+        bench_log(side, name, bench_sizes[i], 3, cycles / CRYPTO_BENCH_LOOPS);
+    }
+
+destroy_key:
+    status = psa_destroy_key(key_handle);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error destroying a key");
+    }
+}
+
+void psa_cipher_bench_test(const char *side, const char *name,
+                           const psa_key_type_t key_type,
+                           const psa_algorithm_t alg,
+                           struct test_result_t *ret)
+{
+    psa_cipher_operation_t handle;
+    psa_key_handle_t key_handle;
+    psa_status_t status;
+    const size_t iv_length = PSA_BLOCK_CIPHER_BLOCK_SIZE(key_type);
+    size_t output_length;
+    uint32_t offset, chunk;
+    uint32_t start, cycles, calls;
+    uint32_t i, j;
+
+    if (!bench_counter_start(ret)) {
+        return;
+    }
+    bench_fill_input();
+
+    status = bench_import_key(key_type, alg, PSA_KEY_USAGE_ENCRYPT,
+                              16, &key_handle);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error importing a key");
+        return;
+    }
+
+    ret->val = TEST_PASSED;
+
+    for (i = 0; i < sizeof(bench_sizes) / sizeof(bench_sizes[0]); i++) {
+        if (bench_sizes[i] > CRYPTO_BENCH_MAX_SIZE) {
+            break;
+        }
+
+        cycles = 0;
+        calls = 0;
+        for (j = 0; j < CRYPTO_BENCH_LOOPS; j++) {
+            handle = psa_cipher_operation_init();
+            calls = 3;
+
+            start = test_timer_read();
+            status = psa_cipher_encrypt_setup(&handle, key_handle, alg);
+            if (status == PSA_SUCCESS) {
+                status = psa_cipher_set_iv(&handle, bench_iv, iv_length);
+            }
+            for (offset = 0;
+                 (status == PSA_SUCCESS) && (offset < bench_sizes[i]);
+                 offset += chunk) {
+                chunk = bench_sizes[i] - offset;
+                if (chunk > CRYPTO_BENCH_CHUNK_SIZE) {
+                    chunk = CRYPTO_BENCH_CHUNK_SIZE;
+                }
+                status = psa_cipher_update(&handle, &bench_in[offset], chunk,
+                                           bench_out, sizeof(bench_out),
+                                           &output_length);
+                calls++;
+            }
+            if (status == PSA_SUCCESS) {
+                status = psa_cipher_finish(&handle, bench_out,
+                                           sizeof(bench_out), &output_length);
+            }
+            cycles += test_timer_read() - start;
+
+            if (status != PSA_SUCCESS) {
+                (void)psa_cipher_abort(&handle);
+                TEST_FAIL("Error encrypting the message");
+                goto destroy_key;
+            }
+        }
+
+        bench_log(side, name, bench_sizes[i], calls,
+                  cycles / CRYPTO_BENCH_LOOPS);
+    }
+
+destroy_key:
+    status = psa_destroy_key(key_handle);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error destroying a key");
+    }
+}
+
+void psa_aead_bench_test(const char *side, const char *name,
+                         const psa_key_type_t key_type,
+                         const psa_algorithm_t alg,
+                         struct test_result_t *ret)
+{
+    psa_key_handle_t key_handle;
+    psa_status_t status;
+    const size_t nonce_length = 12;
+    size_t output_length;
+    uint32_t start, cycles;
+    uint32_t i, j;
+
+    if (!bench_counter_start(ret)) {
+        return;
+    }
+    bench_fill_input();
+
+    status = bench_import_key(key_type, alg, PSA_KEY_USAGE_ENCRYPT,
+                              16, &key_handle);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error importing a key");
+        return;
+    }
+
+    ret->val = TEST_PASSED;
+
+    for (i = 0; i < sizeof(bench_sizes) / sizeof(bench_sizes[0]); i++) {
+        if (bench_sizes[i] > CRYPTO_BENCH_MAX_SIZE) {
+            break;
+        }
+
+        cycles = 0;
+        for (j = 0; j < CRYPTO_BENCH_LOOPS; j++) {
+            start = test_timer_read();
+            status = psa_aead_encrypt(key_handle, alg, bench_iv, nonce_length,
+                                      NULL, 0, bench_in, bench_sizes[i],
+                                      bench_out, sizeof(bench_out),
+                                      &output_length);
+            cycles += test_timer_read() - start;
+
+            if (status != PSA_SUCCESS) {
+                break;
+            }
+        }
+
+        if (status != PSA_SUCCESS) {
+            /* The whole message has to fit in the service at once, so only
+             * the smallest size is required to succeed.
+             */
+            if (i == 0) {
+                TEST_FAIL("Error encrypting the message");
+                goto destroy_key;
+            }
+            bench_log_skipped(side, name, bench_sizes[i], status);
+            continue;
+        }
+
+        bench_log(side, name, bench_sizes[i], 1, cycles / CRYPTO_BENCH_LOOPS);
+    }
+
+destroy_key:
+    status = psa_destroy_key(key_handle);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error destroying a key");
+    }
+}
+
+void psa_ecdsa_bench_test(const char *side, struct test_result_t *ret)
+{
+    const psa_algorithm_t alg = PSA_ALG_ECDSA(PSA_ALG_SHA_256);
+    psa_key_attributes_t key_attributes = psa_key_attributes_init();
+    psa_key_handle_t key_handle;
+    psa_status_t status;
+    uint8_t signature[PSA_ECDSA_SIGNATURE_SIZE(256)];
+    size_t signature_length;
+    uint32_t start, keygen_cycles, sign_cycles, verify_cycles;
+    uint32_t j;
+
+    if (!bench_counter_start(ret)) {
+        return;
+    }
+    bench_fill_input();
+
+    psa_set_key_usage_flags(&key_attributes,
+                            PSA_KEY_USAGE_SIGN | PSA_KEY_USAGE_VERIFY);
+    psa_set_key_algorithm(&key_attributes, alg);
+    psa_set_key_type(&key_attributes,
+                     PSA_KEY_TYPE_ECC_KEY_PAIR(PSA_ECC_CURVE_SECP256R1));
+    psa_set_key_bits(&key_attributes, 256);
+
+    keygen_cycles = 0;
+    sign_cycles = 0;
+    verify_cycles = 0;
+    for (j = 0; j < CRYPTO_BENCH_LOOPS; j++) {
+        start = test_timer_read();
+        status = psa_generate_key(&key_attributes, &key_handle);
+        keygen_cycles += test_timer_read() - start;
+        if (status != PSA_SUCCESS) {
+            TEST_FAIL("Error generating a key");
+            return;
+        }
+
+        /* The first bytes of the input stand for a SHA-256 hash */
+        start = test_timer_read();
+        status = psa_sign_hash(key_handle, alg, bench_in,
+                               PSA_HASH_SIZE(PSA_ALG_SHA_256), signature,
+                               sizeof(signature), &signature_length);
+        sign_cycles += test_timer_read() - start;
+        if (status != PSA_SUCCESS) {
+            TEST_FAIL("Error signing the hash");
+            (void)psa_destroy_key(key_handle);
+            return;
+        }
+
+        start = test_timer_read();
+        status = psa_verify_hash(key_handle, alg, bench_in,
+                                 PSA_HASH_SIZE(PSA_ALG_SHA_256), signature,
+                                 signature_length);
+        verify_cycles += test_timer_read() - start;
+        if (status != PSA_SUCCESS) {
+            TEST_FAIL("Error verifying the signature");
+            (void)psa_destroy_key(key_handle);
+            return;
+        }
+
+        status = psa_destroy_key(key_handle);
+        if (status != PSA_SUCCESS) {
+            TEST_FAIL("Error destroying a key");
+            return;
+        }
+    }
+
+    bench_log(side, "ECDSA-P256-keygen", 0, 1,
+              keygen_cycles / CRYPTO_BENCH_LOOPS);
+    bench_log(side, "ECDSA-P256-sign", 0, 1, sign_cycles / CRYPTO_BENCH_LOOPS);
+    bench_log(side, "ECDSA-P256-verify", 0, 1,
+              verify_cycles / CRYPTO_BENCH_LOOPS);
+
+    ret->val = TEST_PASSED;
+}
+
+void psa_key_derivation_bench_test(const char *side, const char *name,
+                                   const psa_algorithm_t alg,
+                                   struct test_result_t *ret)
+{
+    psa_key_derivation_operation_t handle;
+    psa_key_handle_t key_handle;
+    psa_status_t status;
+    uint8_t output[32];
+    uint32_t start, cycles;
+    uint32_t j;
+
+    if (!bench_counter_start(ret)) {
+        return;
+    }
+    bench_fill_input();
+
+    status = bench_import_key(PSA_KEY_TYPE_DERIVE, alg, PSA_KEY_USAGE_DERIVE,
+                              32, &key_handle);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error importing a key");
+        return;
+    }
+
+    ret->val = TEST_PASSED;
+
+    cycles = 0;
+    for (j = 0; j < CRYPTO_BENCH_LOOPS; j++) {
+        handle = psa_key_derivation_operation_init();
+
+        start = test_timer_read();
+        status = psa_key_derivation_setup(&handle, alg);
+        if (status == PSA_SUCCESS) {
+            status = psa_key_derivation_input_bytes(&handle,
+                                                PSA_KEY_DERIVATION_INPUT_SALT,
+                                                bench_in, 16);
+        }
+        if (status == PSA_SUCCESS) {
+            status = psa_key_derivation_input_key(&handle,
+                                              PSA_KEY_DERIVATION_INPUT_SECRET,
+                                              key_handle);
+        }
+        if (status == PSA_SUCCESS) {
+            status = psa_key_derivation_input_bytes(&handle,
+                                                PSA_KEY_DERIVATION_INPUT_INFO,
+                                                &bench_in[16], 16);
+        }
+        if (status == PSA_SUCCESS) {
+            status = psa_key_derivation_output_bytes(&handle, output,
+                                                     sizeof(output));
+        }
+        if (status == PSA_SUCCESS) {
+            status = psa_key_derivation_abort(&handle);
+        }
+        cycles += test_timer_read() - start;
+
+        if (status != PSA_SUCCESS) {
+            (void)psa_key_derivation_abort(&handle);
+            TEST_FAIL("Error deriving the output");
+            goto destroy_key;
+        }
+    }
+
+    bench_log(side, name, 0, 6, cycles / CRYPTO_BENCH_LOOPS);
+
+destroy_key:
+    status = psa_destroy_key(key_handle);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error destroying a key");
+    }
+}
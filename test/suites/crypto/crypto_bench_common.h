@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __CRYPTO_BENCH_COMMON_H__
+#define __CRYPTO_BENCH_COMMON_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "psa/crypto.h"
+#include "test/framework/test_framework_helpers.h"
+
+/**
+ * \brief Number of times each measured operation is repeated, the reported
+ *        cycles are the average of the repetitions
+ *
+ */
+#ifndef CRYPTO_BENCH_LOOPS
+#define CRYPTO_BENCH_LOOPS (4)
+#endif
+
+/**
+ * \brief Number of calls averaged to measure the cost of a call to the
+ *        Crypto service
+ *
+ */
+#ifndef CRYPTO_BENCH_CALL_LOOPS
+#define CRYPTO_BENCH_CALL_LOOPS (64)
+#endif
+
+/**
+ * \brief Largest message size in bytes measured by the hash, MAC, cipher
+ *        and AEAD benchmarks
+ *
+ */
+#ifndef CRYPTO_BENCH_MAX_SIZE
+#define CRYPTO_BENCH_MAX_SIZE (16384)
+#endif
+
+/**
+ * \brief Size in bytes of the data passed to each cipher update call
+ *
+ */
+#ifndef CRYPTO_BENCH_CHUNK_SIZE
+#define CRYPTO_BENCH_CHUNK_SIZE (1024)
+#endif
+
+/**
+ * \brief Measures the cost of a call to the Crypto service which does no
+ *        cryptographic work, and prints the header of the benchmark lines
+ *
+ * \param[in]  side Name of the caller, printed in each line
+ * \param[out] ret  Test result
+ *
+ */
+void psa_call_bench_test(const char *side, struct test_result_t *ret);
+
+/**
+ * \brief Measures a multipart hash for each message size
+ *
+ * \param[in]  side Name of the caller, printed in each line
+ * \param[in]  name Name of the algorithm, printed in each line
+ * \param[in]  alg  PSA hash algorithm
+ * \param[out] ret  Test result
+ *
+ */
+void psa_hash_bench_test(const char *side, const char *name,
+                         const psa_algorithm_t alg,
+                         struct test_result_t *ret);
+
+/**
+ * \brief Measures a multipart MAC computation for each message size
+ *
+ * \param[in]  side Name of the caller, printed in each line
+ * \param[in]  name Name of the algorithm, printed in each line
+ * \param[in]  alg  PSA MAC algorithm
+ * \param[out] ret  Test result
+ *
+ */
+void psa_mac_bench_test(const char *side, const char *name,
+                        const psa_algorithm_t alg,
+                        struct test_result_t *ret);
+
+/**
+ * \brief Measures a multipart encryption for each message size, the data
+ *        is passed in chunks of \ref CRYPTO_BENCH_CHUNK_SIZE bytes
+ *
+ * \param[in]  side     Name of the caller, printed in each line
+ * \param[in]  name     Name of the algorithm, printed in each line
+ * \param[in]  key_type PSA key type
+ * \param[in]  alg      PSA cipher algorithm
+ * \param[out] ret      Test result
+ *
+ */
+void psa_cipher_bench_test(const char *side, const char *name,
+                           const psa_key_type_t key_type,
+                           const psa_algorithm_t alg,
+                           struct test_result_t *ret);
+
+/**
+ * \brief Measures a single part AEAD encryption for each message size. The
+ *        sizes which the service cannot take in a single call are reported
+ *        as skipped
+ *
+ * \param[in]  side     Name of the caller, printed in each line
+ * \param[in]  name     Name of the algorithm, printed in each line
+ * \param[in]  key_type PSA key type
+ * \param[in]  alg      PSA AEAD algorithm
+ * \param[out] ret      Test result
+ *
+ */
+void psa_aead_bench_test(const char *side, const char *name,
+                         const psa_key_type_t key_type,
+                         const psa_algorithm_t alg,
+                         struct test_result_t *ret);
+
+/**
+ * \brief Measures the generation of an ECDSA P-256 key pair, and the
+ *        signature and the verification of a SHA-256 hash with it
+ *
+ * \param[in]  side Name of the caller, printed in each line
+ * \param[out] ret  Test result
+ *
+ */
+void psa_ecdsa_bench_test(const char *side, struct test_result_t *ret);
+
+/**
+ * \brief Measures a complete key derivation, from the setup of the operation
+ *        to the output of 32 bytes
+ *
+ * \param[in]  side Name of the caller, printed in each line
+ * \param[in]  name Name of the algorithm, printed in each line
+ * \param[in]  alg  PSA key derivation algorithm
+ * \param[out] ret  Test result
+ *
+ */
+void psa_key_derivation_bench_test(const char *side, const char *name,
+                                   const psa_algorithm_t alg,
+                                   struct test_result_t *ret);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CRYPTO_BENCH_COMMON_H__ */
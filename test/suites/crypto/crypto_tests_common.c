@@ -11,6 +11,7 @@
 #include "tfm_memory_utils.h"
 #endif
 #include "crypto_tests_common.h"
+#include "tfm_crypto_defs.h"
 
 void psa_key_interface_test(const psa_key_type_t key_type,
                             struct test_result_t *ret)
@@ -974,3 +975,970 @@ void psa_persistent_key_test(psa_key_id_t key_id, struct test_result_t *ret)
 
     ret->val = TEST_PASSED;
 }
+
+#define RANDOM_BATCH_COUNT (5)
+
+void psa_random_batch_test(struct test_result_t *ret)
+{
+    psa_status_t status;
+    uint32_t i, j;
+    /* More buffers than a request can fill, one of them larger than the
+     * random pool of the service and one of them empty
+     */
+    uint8_t buf_0[16] = {0}, buf_1[4] = {0}, buf_2[33] = {0};
+    uint8_t buf_3[200] = {0}, buf_4[16] = {0};
+    uint8_t *const outputs[RANDOM_BATCH_COUNT] = {
+        buf_0, buf_1, buf_2, buf_3, buf_4,
+    };
+    const size_t output_sizes[RANDOM_BATCH_COUNT] = {
+        sizeof(buf_0), 0, sizeof(buf_2), sizeof(buf_3), sizeof(buf_4),
+    };
+    int comp_result;
+
+    status = psa_generate_random_batch(outputs, output_sizes,
+                                       RANDOM_BATCH_COUNT);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Failed to generate a batch of random values");
+        return;
+    }
+
+    for (i = 0; i < RANDOM_BATCH_COUNT; i++) {
+        for (j = 0; j < output_sizes[i]; j++) {
+            if (outputs[i][j] != 0) {
+                break;
+            }
+        }
+
+        if ((output_sizes[i] != 0) && (j == output_sizes[i])) {
+            TEST_FAIL("A buffer of the batch has not been filled");
+            return;
+        }
+    }
+
+    for (j = 0; j < sizeof(buf_1); j++) {
+        if (buf_1[j] != 0) {
+            TEST_FAIL("An empty buffer of the batch has been written");
+            return;
+        }
+    }
+
+    /* Two buffers of the batch must not get the same random bytes */
+#if DOMAIN_NS == 1U
+    comp_result = memcmp(buf_0, buf_4, sizeof(buf_0));
+#else
+    comp_result = tfm_memcmp(buf_0, buf_4, sizeof(buf_0));
+#endif
+    if (comp_result == 0) {
+        TEST_FAIL("Two buffers of the batch hold the same random bytes");
+        return;
+    }
+
+    status = psa_generate_random_batch(NULL, output_sizes, RANDOM_BATCH_COUNT);
+    if (status != PSA_ERROR_INVALID_ARGUMENT) {
+        TEST_FAIL("A batch without buffers should not succeed");
+        return;
+    }
+
+    ret->val = TEST_PASSED;
+}
+
+void psa_hash_clone_test(const psa_algorithm_t alg,
+                         struct test_result_t *ret)
+{
+    const char *msg[] = {"This is my test message, ",
+                         "please generate a hash for this."};
+    const size_t msg_size[] = {25, 32}; /* Length in bytes of msg[0], msg[1] */
+    uint32_t idx;
+    psa_status_t status;
+    psa_hash_operation_t handle = psa_hash_operation_init();
+    psa_hash_operation_t clone_handle = psa_hash_operation_init();
+
+    /* Cycle until idx points to the correct index in the algorithm table */
+    for (idx=0; hash_alg[idx] != alg; idx++);
+
+    status = psa_hash_setup(&handle, alg);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error setting up hash operation object");
+        return;
+    }
+
+    /* Hash the common prefix once, then branch */
+    status = psa_hash_update(&handle, (const uint8_t *)msg[0], msg_size[0]);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error updating the hash operation object");
+        goto abort_hash;
+    }
+
+    status = psa_hash_clone(&handle, &clone_handle);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error cloning the hash operation object");
+        goto abort_hash;
+    }
+
+    /* A clone must not be set up over an active operation */
+    status = psa_hash_clone(&handle, &clone_handle);
+    if (status != PSA_ERROR_BAD_STATE) {
+        TEST_FAIL("Cloning into an active operation should fail");
+        goto abort_hash;
+    }
+
+    /* Each branch gets the rest of the message once */
+    status = psa_hash_update(&clone_handle,
+                             (const uint8_t *)msg[1], msg_size[1]);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error updating the cloned hash operation object");
+        goto abort_hash;
+    }
+
+    status = psa_hash_verify(&clone_handle, &(hash_val[idx][0]),
+                             PSA_HASH_SIZE(alg));
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error verifying the cloned hash operation object");
+        goto abort_hash;
+    }
+
+    status = psa_hash_update(&handle, (const uint8_t *)msg[1], msg_size[1]);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error updating the hash operation object");
+        goto abort_hash;
+    }
+
+    status = psa_hash_verify(&handle, &(hash_val[idx][0]), PSA_HASH_SIZE(alg));
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error verifying the hash operation object");
+        goto abort_hash;
+    }
+
+    ret->val = TEST_PASSED;
+    return;
+
+abort_hash:
+    (void)psa_hash_abort(&clone_handle);
+    (void)psa_hash_abort(&handle);
+}
+
+void psa_mac_clone_test(const psa_algorithm_t alg,
+                        struct test_result_t *ret)
+{
+    const char *msg[] = {"This is my test message, ",
+                         "please generate a hmac for this."};
+    const size_t msg_size[] = {25, 32}; /* Length in bytes of msg[0], msg[1] */
+    uint32_t idx;
+    psa_key_handle_t key_handle;
+    const uint8_t data[] = "THIS IS MY KEY1";
+    psa_status_t status;
+    psa_mac_operation_t handle = psa_mac_operation_init();
+    psa_mac_operation_t clone_handle = psa_mac_operation_init();
+    psa_key_attributes_t key_attributes = psa_key_attributes_init();
+
+    ret->val = TEST_PASSED;
+
+    /* Cycle until idx points to the correct index in the algorithm table */
+    for (idx=0; hash_alg[idx] != PSA_ALG_HMAC_GET_HASH(alg); idx++);
+
+    /* Setup the key policy */
+    psa_set_key_usage_flags(&key_attributes, PSA_KEY_USAGE_VERIFY);
+    psa_set_key_algorithm(&key_attributes, alg);
+    psa_set_key_type(&key_attributes, PSA_KEY_TYPE_HMAC);
+
+    status = psa_import_key(&key_attributes, data, sizeof(data), &key_handle);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error importing a key");
+        return;
+    }
+
+    status = psa_mac_verify_setup(&handle, key_handle, alg);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error setting up mac operation object");
+        goto destroy_key_mac;
+    }
+
+    /* Authenticate the common prefix once, then branch */
+    status = psa_mac_update(&handle, (const uint8_t *)msg[0], msg_size[0]);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error during mac operation");
+        goto destroy_key_mac;
+    }
+
+    status = psa_mac_clone(&handle, &clone_handle);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error cloning the mac operation object");
+        goto destroy_key_mac;
+    }
+
+    /* Each branch gets the rest of the message once */
+    status = psa_mac_update(&clone_handle,
+                            (const uint8_t *)msg[1], msg_size[1]);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error during the cloned mac operation");
+        goto destroy_key_mac;
+    }
+
+    status = psa_mac_verify_finish(&clone_handle, &(hmac_val[idx][0]),
+                                   PSA_HASH_SIZE(PSA_ALG_HMAC_GET_HASH(alg)));
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error during finalising the cloned mac operation");
+        goto destroy_key_mac;
+    }
+
+    status = psa_mac_update(&handle, (const uint8_t *)msg[1], msg_size[1]);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error during mac operation");
+        goto destroy_key_mac;
+    }
+
+    status = psa_mac_verify_finish(&handle, &(hmac_val[idx][0]),
+                                   PSA_HASH_SIZE(PSA_ALG_HMAC_GET_HASH(alg)));
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error during finalising the mac operation");
+        goto destroy_key_mac;
+    }
+
+destroy_key_mac:
+    (void)psa_mac_abort(&clone_handle);
+    (void)psa_mac_abort(&handle);
+
+    /* Destroy the key */
+    status = psa_destroy_key(key_handle);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error destroying the key");
+    }
+}
+
+void psa_aead_multipart_test(const psa_key_type_t key_type,
+                             const psa_algorithm_t alg,
+                             struct test_result_t *ret)
+{
+    /* Chunks of the plaintext which are not aligned on blocks, so that GCM
+     * holds bytes back
+     */
+    const size_t chunk_size[] = {7, 16, 16};
+    const size_t ad_chunk = 10;
+    const uint8_t nonce[] = "01234567890";
+    const size_t nonce_length = 12;
+    const uint8_t plain_text[] = "This plaintext spans several blocks!!!!";
+    const size_t plain_text_length = sizeof(plain_text) - 1;
+    const uint8_t associated_data[ASSOCIATED_DATA_SIZE] =
+                                                      "This is associated data";
+    const uint8_t data[] = "THIS IS MY KEY1";
+    uint8_t reference[2 * ENC_DEC_BUFFER_SIZE] = {0};
+    uint8_t encrypted_data[2 * ENC_DEC_BUFFER_SIZE] = {0};
+    uint8_t decrypted_data[2 * ENC_DEC_BUFFER_SIZE] = {0};
+    uint8_t tag[PSA_AEAD_TAG_LENGTH(PSA_ALG_GCM)] = {0};
+    size_t reference_length = 0, tag_length = 0;
+    size_t total, length, offset, i;
+    uint32_t comp_result;
+    psa_key_handle_t key_handle;
+    psa_aead_operation_t handle = psa_aead_operation_init();
+    psa_key_attributes_t key_attributes = psa_key_attributes_init();
+    psa_status_t status;
+
+    /* Setup the key policy */
+    psa_set_key_usage_flags(&key_attributes,
+                            PSA_KEY_USAGE_ENCRYPT | PSA_KEY_USAGE_DECRYPT);
+    psa_set_key_algorithm(&key_attributes, alg);
+    psa_set_key_type(&key_attributes, key_type);
+
+    status = psa_import_key(&key_attributes, data, sizeof(data), &key_handle);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error importing a key");
+        return;
+    }
+
+    /* The single-part encryption gives the expected ciphertext and tag */
+    status = psa_aead_encrypt(key_handle, alg, nonce, nonce_length,
+                              associated_data, sizeof(associated_data),
+                              plain_text, plain_text_length,
+                              reference, sizeof(reference),
+                              &reference_length);
+    if ((status != PSA_SUCCESS) ||
+        (reference_length != plain_text_length + sizeof(tag))) {
+        TEST_FAIL("Error performing AEAD encryption");
+        goto destroy_key_aead;
+    }
+
+    /* Encrypt in chunks, the additional data included */
+    status = psa_aead_encrypt_setup(&handle, key_handle, alg);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error setting up AEAD encryption");
+        goto destroy_key_aead;
+    }
+
+    status = psa_aead_set_nonce(&handle, nonce, nonce_length);
+    if (status == PSA_SUCCESS) {
+        status = psa_aead_update_ad(&handle, associated_data, ad_chunk);
+    }
+    if (status == PSA_SUCCESS) {
+        status = psa_aead_update_ad(&handle, &associated_data[ad_chunk],
+                                    sizeof(associated_data) - ad_chunk);
+    }
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error passing the additional data");
+        goto abort_aead;
+    }
+
+    total = 0;
+    for (i = 0, offset = 0; i < sizeof(chunk_size) / sizeof(chunk_size[0]);
+         offset += chunk_size[i], i++) {
+        status = psa_aead_update(&handle, &plain_text[offset], chunk_size[i],
+                                 &encrypted_data[total],
+                                 sizeof(encrypted_data) - total, &length);
+        if (status != PSA_SUCCESS) {
+            TEST_FAIL("Error encrypting a chunk");
+            goto abort_aead;
+        }
+        total += length;
+    }
+
+    status = psa_aead_finish(&handle, &encrypted_data[total],
+                             sizeof(encrypted_data) - total, &length,
+                             tag, sizeof(tag), &tag_length);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error finishing AEAD encryption");
+        goto abort_aead;
+    }
+    total += length;
+
+    if ((total != plain_text_length) || (tag_length != sizeof(tag))) {
+        TEST_FAIL("Encrypted data length is different than expected");
+        goto destroy_key_aead;
+    }
+
+#if DOMAIN_NS == 1U
+    comp_result = memcmp(encrypted_data, reference, total) |
+                  memcmp(tag, &reference[total], tag_length);
+#else
+    comp_result = tfm_memcmp(encrypted_data, reference, total) |
+                  tfm_memcmp(tag, &reference[total], tag_length);
+#endif
+    if (comp_result != 0) {
+        TEST_FAIL("Chunked encryption differs from the single-part one");
+        goto destroy_key_aead;
+    }
+
+    /* Decrypt in chunks and check the tag */
+    status = psa_aead_decrypt_setup(&handle, key_handle, alg);
+    if (status == PSA_SUCCESS) {
+        status = psa_aead_set_nonce(&handle, nonce, nonce_length);
+    }
+    if (status == PSA_SUCCESS) {
+        status = psa_aead_update_ad(&handle, associated_data,
+                                    sizeof(associated_data));
+    }
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error setting up AEAD decryption");
+        goto abort_aead;
+    }
+
+    total = 0;
+    for (i = 0, offset = 0; i < sizeof(chunk_size) / sizeof(chunk_size[0]);
+         offset += chunk_size[i], i++) {
+        status = psa_aead_update(&handle, &reference[offset], chunk_size[i],
+                                 &decrypted_data[total],
+                                 sizeof(decrypted_data) - total, &length);
+        if (status != PSA_SUCCESS) {
+            TEST_FAIL("Error decrypting a chunk");
+            goto abort_aead;
+        }
+        total += length;
+    }
+
+    status = psa_aead_verify(&handle, &decrypted_data[total],
+                             sizeof(decrypted_data) - total, &length,
+                             &reference[plain_text_length], sizeof(tag));
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error verifying the tag");
+        goto abort_aead;
+    }
+    total += length;
+
+#if DOMAIN_NS == 1U
+    comp_result = memcmp(plain_text, decrypted_data, plain_text_length);
+#else
+    comp_result = tfm_memcmp(plain_text, decrypted_data, plain_text_length);
+#endif
+    if ((total != plain_text_length) || (comp_result != 0)) {
+        TEST_FAIL("Decrypted data doesn't match with plain text");
+        goto destroy_key_aead;
+    }
+
+    /* A tag which does not match must not release any plaintext */
+    tag[0] = reference[plain_text_length] ^ 1;
+    for (i = 1; i < sizeof(tag); i++) {
+        tag[i] = reference[plain_text_length + i];
+    }
+
+    status = psa_aead_decrypt_setup(&handle, key_handle, alg);
+    if (status == PSA_SUCCESS) {
+        status = psa_aead_set_nonce(&handle, nonce, nonce_length);
+    }
+    if (status == PSA_SUCCESS) {
+        status = psa_aead_update_ad(&handle, associated_data,
+                                    sizeof(associated_data));
+    }
+    if (status == PSA_SUCCESS) {
+        status = psa_aead_update(&handle, reference, chunk_size[0],
+                                 decrypted_data, sizeof(decrypted_data),
+                                 &total);
+    }
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error decrypting the first chunk");
+        goto abort_aead;
+    }
+
+    status = psa_aead_verify(&handle, &decrypted_data[total],
+                             sizeof(decrypted_data) - total, &length,
+                             tag, sizeof(tag));
+    if (status != PSA_ERROR_INVALID_SIGNATURE) {
+        TEST_FAIL("A wrong tag should not be verified");
+        goto abort_aead;
+    }
+
+    if (length != 0) {
+        TEST_FAIL("No plaintext should be output with a wrong tag");
+        goto abort_aead;
+    }
+
+    /* The verification ended the operation */
+    status = psa_aead_update(&handle, reference, chunk_size[0],
+                             decrypted_data, sizeof(decrypted_data), &length);
+    if (status != PSA_ERROR_BAD_STATE) {
+        TEST_FAIL("The operation should end with the verification");
+        goto abort_aead;
+    }
+
+    /* Abort in the middle of the data, more times than there are AEAD
+     * contexts, so that a context leaked by the abort would be seen
+     */
+    for (i = 0; i < 4; i++) {
+        status = psa_aead_encrypt_setup(&handle, key_handle, alg);
+        if (status == PSA_SUCCESS) {
+            status = psa_aead_set_nonce(&handle, nonce, nonce_length);
+        }
+        if (status == PSA_SUCCESS) {
+            status = psa_aead_update(&handle, plain_text, chunk_size[0],
+                                     encrypted_data, sizeof(encrypted_data),
+                                     &length);
+        }
+        if (status != PSA_SUCCESS) {
+            TEST_FAIL("Error starting the operation to abort");
+            goto abort_aead;
+        }
+
+        status = psa_aead_abort(&handle);
+        if (status != PSA_SUCCESS) {
+            TEST_FAIL("Error aborting the operation");
+            goto abort_aead;
+        }
+
+        status = psa_aead_finish(&handle, encrypted_data,
+                                 sizeof(encrypted_data), &length,
+                                 tag, sizeof(tag), &tag_length);
+        if (status != PSA_ERROR_BAD_STATE) {
+            TEST_FAIL("An aborted operation should not be finished");
+            goto abort_aead;
+        }
+    }
+
+    ret->val = TEST_PASSED;
+    goto destroy_key_aead;
+
+abort_aead:
+    (void)psa_aead_abort(&handle);
+
+destroy_key_aead:
+    /* Destroy the key */
+    status = psa_destroy_key(key_handle);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error destroying a key");
+    }
+}
+
+#define AEAD_BATCH_COUNT       (3)
+#define AEAD_BATCH_BUFFER_SIZE (128)
+
+/* Copies data at the given offset of a batch buffer, returns the end offset */
+static size_t aead_batch_append(uint8_t *buf, size_t offset,
+                                const uint8_t *data, size_t length)
+{
+#if DOMAIN_NS == 1U
+    (void)memcpy(&buf[offset], data, length);
+#else
+    (void)tfm_memcpy(&buf[offset], data, length);
+#endif
+    return offset + length;
+}
+
+void psa_aead_batch_test(const psa_key_type_t key_type,
+                         const psa_algorithm_t alg,
+                         struct test_result_t *ret)
+{
+    /* The messages have different lengths, one of them no additional data */
+    const size_t ad_length[AEAD_BATCH_COUNT] = {8, 0, 5};
+    const size_t pt_length[AEAD_BATCH_COUNT] = {12, 20, 7};
+    /* The message whose tag is altered before the decryption */
+    const size_t altered = 1;
+    const size_t nonce_length = 12;
+    const size_t tag_length = PSA_AEAD_TAG_LENGTH(alg);
+    const uint8_t plain_text[] = "Each message of a batch has its own nonce";
+    const uint8_t associated_data[ASSOCIATED_DATA_SIZE] =
+                                                      "This is associated data";
+    const uint8_t data[] = "THIS IS MY KEY1";
+    struct tfm_crypto_aead_batch_entry entries[AEAD_BATCH_COUNT];
+    uint8_t input[AEAD_BATCH_BUFFER_SIZE] = {0};
+    uint8_t encrypted_data[AEAD_BATCH_BUFFER_SIZE] = {0};
+    uint8_t decrypted_data[AEAD_BATCH_BUFFER_SIZE] = {0};
+    uint8_t reference[AEAD_BATCH_BUFFER_SIZE] = {0};
+    size_t reference_length;
+    size_t in_offset, out_offset, pt_offset, i, j;
+    uint32_t comp_result;
+    psa_key_handle_t key_handle;
+    psa_key_attributes_t key_attributes = psa_key_attributes_init();
+    psa_status_t status;
+
+    /* Setup the key policy */
+    psa_set_key_usage_flags(&key_attributes,
+                            PSA_KEY_USAGE_ENCRYPT | PSA_KEY_USAGE_DECRYPT);
+    psa_set_key_algorithm(&key_attributes, alg);
+    psa_set_key_type(&key_attributes, key_type);
+
+    status = psa_import_key(&key_attributes, data, sizeof(data), &key_handle);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error importing a key");
+        return;
+    }
+
+    /* Lay out the additional data and the plaintext of each message */
+    for (i = 0, in_offset = 0, pt_offset = 0; i < AEAD_BATCH_COUNT; i++) {
+        for (j = 0; j < TFM_CRYPTO_MAX_NONCE_LENGTH; j++) {
+            entries[i].nonce[j] = (uint8_t)((i << 4) | j);
+        }
+        entries[i].nonce_length = nonce_length;
+        entries[i].additional_data_length = ad_length[i];
+        entries[i].input_length = pt_length[i];
+
+        in_offset = aead_batch_append(input, in_offset, associated_data,
+                                      ad_length[i]);
+        in_offset = aead_batch_append(input, in_offset,
+                                      &plain_text[pt_offset], pt_length[i]);
+        pt_offset += pt_length[i];
+    }
+
+    status = psa_aead_encrypt_batch(key_handle, alg, entries,
+                                    AEAD_BATCH_COUNT, input, in_offset,
+                                    encrypted_data, sizeof(encrypted_data));
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error performing batch AEAD encryption");
+        goto destroy_key_aead;
+    }
+
+    /* Each message is encrypted as by a single-part encryption */
+    for (i = 0, out_offset = 0, pt_offset = 0; i < AEAD_BATCH_COUNT; i++) {
+        if ((entries[i].status != PSA_SUCCESS) ||
+            (entries[i].output_length != pt_length[i] + tag_length)) {
+            TEST_FAIL("A message of the batch has not been encrypted");
+            goto destroy_key_aead;
+        }
+
+        status = psa_aead_encrypt(key_handle, alg,
+                                  entries[i].nonce, nonce_length,
+                                  associated_data, ad_length[i],
+                                  &plain_text[pt_offset], pt_length[i],
+                                  reference, sizeof(reference),
+                                  &reference_length);
+        if ((status != PSA_SUCCESS) ||
+            (reference_length != entries[i].output_length)) {
+            TEST_FAIL("Error performing AEAD encryption");
+            goto destroy_key_aead;
+        }
+
+#if DOMAIN_NS == 1U
+        comp_result = memcmp(&encrypted_data[out_offset], reference,
+                             reference_length);
+#else
+        comp_result = tfm_memcmp(&encrypted_data[out_offset], reference,
+                                 reference_length);
+#endif
+        if (comp_result != 0) {
+            TEST_FAIL("Batch encryption differs from the single-part one");
+            goto destroy_key_aead;
+        }
+
+        out_offset += reference_length;
+        pt_offset += pt_length[i];
+    }
+
+    /* Lay out the additional data, the ciphertext and the tag of each
+     * message, with one bit of a tag flipped
+     */
+    for (i = 0, in_offset = 0, out_offset = 0; i < AEAD_BATCH_COUNT; i++) {
+        entries[i].input_length = entries[i].output_length;
+
+        in_offset = aead_batch_append(input, in_offset, associated_data,
+                                      ad_length[i]);
+        in_offset = aead_batch_append(input, in_offset,
+                                      &encrypted_data[out_offset],
+                                      entries[i].input_length);
+        out_offset += entries[i].input_length;
+
+        if (i == altered) {
+            input[in_offset - 1] ^= 1;
+        }
+    }
+
+    status = psa_aead_decrypt_batch(key_handle, alg, entries,
+                                    AEAD_BATCH_COUNT, input, in_offset,
+                                    decrypted_data, sizeof(decrypted_data));
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error performing batch AEAD decryption");
+        goto destroy_key_aead;
+    }
+
+    /* The altered message has no output, the others are back to back */
+    for (i = 0, out_offset = 0, pt_offset = 0; i < AEAD_BATCH_COUNT; i++) {
+        if (i == altered) {
+            if ((entries[i].status != PSA_ERROR_INVALID_SIGNATURE) ||
+                (entries[i].output_length != 0)) {
+                TEST_FAIL("A message with a wrong tag should not decrypt");
+                goto destroy_key_aead;
+            }
+            pt_offset += pt_length[i];
+            continue;
+        }
+
+        if ((entries[i].status != PSA_SUCCESS) ||
+            (entries[i].output_length != pt_length[i])) {
+            TEST_FAIL("A message of the batch has not been decrypted");
+            goto destroy_key_aead;
+        }
+
+#if DOMAIN_NS == 1U
+        comp_result = memcmp(&decrypted_data[out_offset],
+                             &plain_text[pt_offset], pt_length[i]);
+#else
+        comp_result = tfm_memcmp(&decrypted_data[out_offset],
+                                 &plain_text[pt_offset], pt_length[i]);
+#endif
+        if (comp_result != 0) {
+            TEST_FAIL("Decrypted data doesn't match with plain text");
+            goto destroy_key_aead;
+        }
+
+        out_offset += pt_length[i];
+        pt_offset += pt_length[i];
+    }
+
+    ret->val = TEST_PASSED;
+
+destroy_key_aead:
+    /* Destroy the key */
+    status = psa_destroy_key(key_handle);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error destroying a key");
+    }
+}
+
+#define VERIFY_BATCH_COUNT (4)
+
+void psa_verify_hash_batch_test(struct test_result_t *ret)
+{
+    const psa_algorithm_t alg = PSA_ALG_ECDSA(PSA_ALG_SHA_256);
+    const size_t hash_length = PSA_HASH_SIZE(PSA_ALG_SHA_256);
+    const size_t signature_length = PSA_ECDSA_SIGNATURE_SIZE(256);
+    /* Key which signs the hash of each item, and key it is verified with */
+    const uint32_t sign_key[VERIFY_BATCH_COUNT] = {0, 0, 0, 1};
+    const uint32_t verify_key[VERIFY_BATCH_COUNT] = {0, 0, 1, 1};
+    /* Item whose signature is altered after it is computed */
+    const size_t altered = 1;
+    /* Items 0 and 3 are valid, 1 has a wrong signature and 2 a wrong key */
+    const uint32_t expected = 0x9u;
+    struct tfm_crypto_verify_batch_entry entries[VERIFY_BATCH_COUNT];
+    uint8_t input[VERIFY_BATCH_COUNT * (PSA_HASH_SIZE(PSA_ALG_SHA_256) +
+                                        PSA_ECDSA_SIGNATURE_SIZE(256))];
+    psa_key_handle_t key_handles[2] = {0};
+    psa_key_attributes_t key_attributes = psa_key_attributes_init();
+    psa_status_t status;
+    size_t offset, length, i, j;
+    uint32_t verified;
+
+    psa_set_key_usage_flags(&key_attributes,
+                            PSA_KEY_USAGE_SIGN | PSA_KEY_USAGE_VERIFY);
+    psa_set_key_algorithm(&key_attributes, alg);
+    psa_set_key_type(&key_attributes,
+                     PSA_KEY_TYPE_ECC_KEY_PAIR(PSA_ECC_CURVE_SECP256R1));
+    psa_set_key_bits(&key_attributes, 256);
+
+    for (i = 0; i < 2; i++) {
+        status = psa_generate_key(&key_attributes, &key_handles[i]);
+        if (status != PSA_SUCCESS) {
+            TEST_FAIL("Error generating a key");
+            goto destroy_keys;
+        }
+    }
+
+    /* Lay out the hash and the signature of each item */
+    for (i = 0, offset = 0; i < VERIFY_BATCH_COUNT; i++) {
+        for (j = 0; j < hash_length; j++) {
+            input[offset + j] = (uint8_t)((i << 5) + j);
+        }
+
+        status = psa_sign_hash(key_handles[sign_key[i]], alg,
+                               &input[offset], hash_length,
+                               &input[offset + hash_length], signature_length,
+                               &length);
+        if ((status != PSA_SUCCESS) || (length != signature_length)) {
+            TEST_FAIL("Error signing the hash");
+            goto destroy_keys;
+        }
+
+        if (i == altered) {
+            input[offset + hash_length + signature_length - 1] ^= 1;
+        }
+
+        entries[i].key_handle = key_handles[verify_key[i]];
+        entries[i].alg = alg;
+        entries[i].hash_length = hash_length;
+        entries[i].signature_length = signature_length;
+
+        offset += hash_length + signature_length;
+    }
+
+    verified = ~expected;
+    status = psa_verify_hash_batch(entries, VERIFY_BATCH_COUNT,
+                                   input, offset, &verified);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error verifying the batch");
+        goto destroy_keys;
+    }
+
+    if (verified != expected) {
+        TEST_FAIL("Unexpected result of the batch verification");
+        goto destroy_keys;
+    }
+
+    /* The last item, which overruns the input, is left unverified */
+    verified = ~0u;
+    status = psa_verify_hash_batch(entries, VERIFY_BATCH_COUNT,
+                                   input, offset - 1, &verified);
+    if ((status != PSA_SUCCESS) || (verified != (expected & 0x7u))) {
+        TEST_FAIL("A truncated item should not be verified");
+        goto destroy_keys;
+    }
+
+    ret->val = TEST_PASSED;
+
+destroy_keys:
+    for (i = 0; i < 2; i++) {
+        if (key_handles[i] == 0) {
+            continue;
+        }
+        status = psa_destroy_key(key_handles[i]);
+        if (status != PSA_SUCCESS) {
+            TEST_FAIL("Error destroying a key");
+        }
+    }
+}
+
+/* AEAD test vector of RFC 8439, section 2.8.2 */
+static const uint8_t chachapoly_key[32] = {
+    0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87,
+    0x88, 0x89, 0x8a, 0x8b, 0x8c, 0x8d, 0x8e, 0x8f,
+    0x90, 0x91, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97,
+    0x98, 0x99, 0x9a, 0x9b, 0x9c, 0x9d, 0x9e, 0x9f,
+};
+
+static const uint8_t chachapoly_nonce[12] = {
+    0x07, 0x00, 0x00, 0x00, 0x40, 0x41, 0x42, 0x43,
+    0x44, 0x45, 0x46, 0x47,
+};
+
+static const uint8_t chachapoly_ad[12] = {
+    0x50, 0x51, 0x52, 0x53, 0xc0, 0xc1, 0xc2, 0xc3,
+    0xc4, 0xc5, 0xc6, 0xc7,
+};
+
+static const uint8_t chachapoly_plain_text[] =
+    "Ladies and Gentlemen of the class of '99: If I could offer you only "
+    "one tip for the future, sunscreen would be it.";
+
+/* Ciphertext followed by the tag */
+static const uint8_t chachapoly_cipher_text[114 + 16] = {
+    0xd3, 0x1a, 0x8d, 0x34, 0x64, 0x8e, 0x60, 0xdb,
+    0x7b, 0x86, 0xaf, 0xbc, 0x53, 0xef, 0x7e, 0xc2,
+    0xa4, 0xad, 0xed, 0x51, 0x29, 0x6e, 0x08, 0xfe,
+    0xa9, 0xe2, 0xb5, 0xa7, 0x36, 0xee, 0x62, 0xd6,
+    0x3d, 0xbe, 0xa4, 0x5e, 0x8c, 0xa9, 0x67, 0x12,
+    0x82, 0xfa, 0xfb, 0x69, 0xda, 0x92, 0x72, 0x8b,
+    0x1a, 0x71, 0xde, 0x0a, 0x9e, 0x06, 0x0b, 0x29,
+    0x05, 0xd6, 0xa5, 0xb6, 0x7e, 0xcd, 0x3b, 0x36,
+    0x92, 0xdd, 0xbd, 0x7f, 0x2d, 0x77, 0x8b, 0x8c,
+    0x98, 0x03, 0xae, 0xe3, 0x28, 0x09, 0x1b, 0x58,
+    0xfa, 0xb3, 0x24, 0xe4, 0xfa, 0xd6, 0x75, 0x94,
+    0x55, 0x85, 0x80, 0x8b, 0x48, 0x31, 0xd7, 0xbc,
+    0x3f, 0xf4, 0xde, 0xf0, 0x8e, 0x4b, 0x7a, 0x9d,
+    0xe5, 0x76, 0xd2, 0x65, 0x86, 0xce, 0xc6, 0x4b,
+    0x61, 0x16,
+    /* Tag */
+    0x1a, 0xe1, 0x0b, 0x59, 0x4f, 0x09, 0xe2, 0x6a,
+    0x7e, 0x90, 0x2e, 0xcb, 0xd0, 0x60, 0x06, 0x91,
+};
+
+void psa_aead_chacha20_poly1305_kat_test(struct test_result_t *ret)
+{
+    const psa_algorithm_t alg = PSA_ALG_CHACHA20_POLY1305;
+    const size_t plain_text_length = sizeof(chachapoly_plain_text) - 1;
+    /* A first chunk which is not a whole ChaCha20 block */
+    const size_t chunk = 50;
+    uint8_t encrypted_data[sizeof(chachapoly_cipher_text)] = {0};
+    uint8_t decrypted_data[sizeof(chachapoly_cipher_text)] = {0};
+    uint8_t tag[PSA_AEAD_TAG_LENGTH(PSA_ALG_CHACHA20_POLY1305)] = {0};
+    size_t total, length, tag_length;
+    uint32_t comp_result;
+    psa_key_handle_t key_handle;
+    psa_aead_operation_t handle = psa_aead_operation_init();
+    psa_key_attributes_t key_attributes = psa_key_attributes_init();
+    psa_status_t status;
+
+    /* Setup the key policy */
+    psa_set_key_usage_flags(&key_attributes,
+                            PSA_KEY_USAGE_ENCRYPT | PSA_KEY_USAGE_DECRYPT);
+    psa_set_key_algorithm(&key_attributes, alg);
+    psa_set_key_type(&key_attributes, PSA_KEY_TYPE_CHACHA20);
+
+    status = psa_import_key(&key_attributes, chachapoly_key,
+                            sizeof(chachapoly_key), &key_handle);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error importing a key");
+        return;
+    }
+
+    status = psa_aead_encrypt(key_handle, alg,
+                              chachapoly_nonce, sizeof(chachapoly_nonce),
+                              chachapoly_ad, sizeof(chachapoly_ad),
+                              chachapoly_plain_text, plain_text_length,
+                              encrypted_data, sizeof(encrypted_data), &total);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error performing AEAD encryption");
+        goto destroy_key_aead;
+    }
+
+#if DOMAIN_NS == 1U
+    comp_result = memcmp(encrypted_data, chachapoly_cipher_text,
+                         sizeof(chachapoly_cipher_text));
+#else
+    comp_result = tfm_memcmp(encrypted_data, chachapoly_cipher_text,
+                             sizeof(chachapoly_cipher_text));
+#endif
+    if ((total != sizeof(chachapoly_cipher_text)) || (comp_result != 0)) {
+        TEST_FAIL("Encrypted data doesn't match with the test vector");
+        goto destroy_key_aead;
+    }
+
+    status = psa_aead_decrypt(key_handle, alg,
+                              chachapoly_nonce, sizeof(chachapoly_nonce),
+                              chachapoly_ad, sizeof(chachapoly_ad),
+                              chachapoly_cipher_text,
+                              sizeof(chachapoly_cipher_text),
+                              decrypted_data, sizeof(decrypted_data), &total);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error performing AEAD decryption");
+        goto destroy_key_aead;
+    }
+
+#if DOMAIN_NS == 1U
+    comp_result = memcmp(decrypted_data, chachapoly_plain_text,
+                         plain_text_length);
+#else
+    comp_result = tfm_memcmp(decrypted_data, chachapoly_plain_text,
+                             plain_text_length);
+#endif
+    if ((total != plain_text_length) || (comp_result != 0)) {
+        TEST_FAIL("Decrypted data doesn't match with plain text");
+        goto destroy_key_aead;
+    }
+
+    /* The multipart encryption gives the same ciphertext and tag */
+    status = psa_aead_encrypt_setup(&handle, key_handle, alg);
+    if (status == PSA_SUCCESS) {
+        status = psa_aead_set_nonce(&handle, chachapoly_nonce,
+                                    sizeof(chachapoly_nonce));
+    }
+    if (status == PSA_SUCCESS) {
+        status = psa_aead_update_ad(&handle, chachapoly_ad,
+                                    sizeof(chachapoly_ad));
+    }
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error setting up AEAD encryption");
+        goto abort_aead;
+    }
+
+    status = psa_aead_update(&handle, chachapoly_plain_text, chunk,
+                             encrypted_data, sizeof(encrypted_data), &total);
+    if (status == PSA_SUCCESS) {
+        status = psa_aead_update(&handle, &chachapoly_plain_text[chunk],
+                                 plain_text_length - chunk,
+                                 &encrypted_data[total],
+                                 sizeof(encrypted_data) - total, &length);
+        total += length;
+    }
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error encrypting a chunk");
+        goto abort_aead;
+    }
+
+    status = psa_aead_finish(&handle, &encrypted_data[total],
+                             sizeof(encrypted_data) - total, &length,
+                             tag, sizeof(tag), &tag_length);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error finishing AEAD encryption");
+        goto abort_aead;
+    }
+    total += length;
+
+#if DOMAIN_NS == 1U
+    comp_result = memcmp(encrypted_data, chachapoly_cipher_text, total) |
+                  memcmp(tag, &chachapoly_cipher_text[plain_text_length],
+                         sizeof(tag));
+#else
+    comp_result = tfm_memcmp(encrypted_data, chachapoly_cipher_text, total) |
+                  tfm_memcmp(tag, &chachapoly_cipher_text[plain_text_length],
+                             sizeof(tag));
+#endif
+    if ((total != plain_text_length) || (tag_length != sizeof(tag)) ||
+        (comp_result != 0)) {
+        TEST_FAIL("Chunked encryption doesn't match with the test vector");
+        goto destroy_key_aead;
+    }
+
+    /* A ciphertext with one bit flipped must not be authenticated */
+#if DOMAIN_NS == 1U
+    (void)memcpy(encrypted_data, chachapoly_cipher_text,
+                 sizeof(chachapoly_cipher_text));
+#else
+    (void)tfm_memcpy(encrypted_data, chachapoly_cipher_text,
+                     sizeof(chachapoly_cipher_text));
+#endif
+    encrypted_data[0] ^= 1;
+    status = psa_aead_decrypt(key_handle, alg,
+                              chachapoly_nonce, sizeof(chachapoly_nonce),
+                              chachapoly_ad, sizeof(chachapoly_ad),
+                              encrypted_data, sizeof(chachapoly_cipher_text),
+                              decrypted_data, sizeof(decrypted_data), &total);
+    if (status != PSA_ERROR_INVALID_SIGNATURE) {
+        TEST_FAIL("An altered ciphertext should not be authenticated");
+        goto destroy_key_aead;
+    }
+
+    ret->val = TEST_PASSED;
+    goto destroy_key_aead;
+
+abort_aead:
+    (void)psa_aead_abort(&handle);
+
+destroy_key_aead:
+    /* Destroy the key */
+    status = psa_destroy_key(key_handle);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error destroying a key");
+    }
+}
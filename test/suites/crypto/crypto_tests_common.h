@@ -174,6 +174,82 @@ void psa_policy_invalid_policy_usage_test(struct test_result_t *ret);
  */
 void psa_persistent_key_test(psa_key_id_t key_id, struct test_result_t *ret);
 
+/**
+ * \brief Tests the generation of random bytes into a batch of buffers
+ *
+ * \param[out] ret Test result
+ *
+ */
+void psa_random_batch_test(struct test_result_t *ret);
+
+/**
+ * \brief Tests the clone of a hash operation, each branch completing the
+ *        hash of a common prefix
+ *
+ * \param[in]  alg Hash algorithm
+ * \param[out] ret Test result
+ *
+ */
+void psa_hash_clone_test(const psa_algorithm_t alg,
+                         struct test_result_t *ret);
+
+/**
+ * \brief Tests the clone of an HMAC operation, each branch completing the
+ *        MAC of a common prefix
+ *
+ * \param[in]  alg HMAC algorithm
+ * \param[out] ret Test result
+ *
+ */
+void psa_mac_clone_test(const psa_algorithm_t alg,
+                        struct test_result_t *ret);
+
+/**
+ * \brief Tests a multipart AEAD operation: encryption and decryption in
+ *        chunks which are not whole blocks, a wrong tag and an abort in the
+ *        middle of the data
+ *
+ * \param[in]  key_type PSA key type
+ * \param[in]  alg      AEAD algorithm
+ * \param[out] ret      Test result
+ *
+ */
+void psa_aead_multipart_test(const psa_key_type_t key_type,
+                             const psa_algorithm_t alg,
+                             struct test_result_t *ret);
+
+/**
+ * \brief Tests the batch AEAD encryption and decryption of messages of
+ *        different lengths, one of which fails to be authenticated
+ *
+ * \param[in]  key_type PSA key type
+ * \param[in]  alg      AEAD algorithm
+ * \param[out] ret      Test result
+ *
+ */
+void psa_aead_batch_test(const psa_key_type_t key_type,
+                         const psa_algorithm_t alg,
+                         struct test_result_t *ret);
+
+/**
+ * \brief Tests the verification of a batch of ECDSA signatures, made with two
+ *        keys, in which a signature is altered and another one is verified
+ *        with the wrong key
+ *
+ * \param[out] ret Test result
+ *
+ */
+void psa_verify_hash_batch_test(struct test_result_t *ret);
+
+/**
+ * \brief Tests ChaCha20-Poly1305 against the AEAD test vector of RFC 8439, in
+ *        single part and in chunks, and the rejection of an altered ciphertext
+ *
+ * \param[out] ret Test result
+ *
+ */
+void psa_aead_chacha20_poly1305_kat_test(struct test_result_t *ret);
+
 #ifdef __cplusplus
 }
 #endif
@@ -32,6 +32,13 @@ static void tfm_crypto_test_6031(struct test_result_t *ret);
 static void tfm_crypto_test_6032(struct test_result_t *ret);
 static void tfm_crypto_test_6033(struct test_result_t *ret);
 static void tfm_crypto_test_6034(struct test_result_t *ret);
+static void tfm_crypto_test_6035(struct test_result_t *ret);
+static void tfm_crypto_test_6036(struct test_result_t *ret);
+static void tfm_crypto_test_6037(struct test_result_t *ret);
+static void tfm_crypto_test_6038(struct test_result_t *ret);
+static void tfm_crypto_test_6039(struct test_result_t *ret);
+static void tfm_crypto_test_6040(struct test_result_t *ret);
+static void tfm_crypto_test_6041(struct test_result_t *ret);
 
 static struct test_t crypto_tests[] = {
     {&tfm_crypto_test_6001, "TFM_CRYPTO_TEST_6001",
@@ -78,6 +85,20 @@ static struct test_t crypto_tests[] = {
      "Non Secure key policy check permissions", {0} },
     {&tfm_crypto_test_6034, "TFM_CRYPTO_TEST_6034",
      "Non Secure persistent key interface", {0} },
+    {&tfm_crypto_test_6035, "TFM_CRYPTO_TEST_6035",
+     "Non Secure random generation batch interface", {0} },
+    {&tfm_crypto_test_6036, "TFM_CRYPTO_TEST_6036",
+     "Non Secure hash clone (SHA-256) interface", {0} },
+    {&tfm_crypto_test_6037, "TFM_CRYPTO_TEST_6037",
+     "Non Secure HMAC clone (SHA-256) interface", {0} },
+    {&tfm_crypto_test_6038, "TFM_CRYPTO_TEST_6038",
+     "Non Secure multipart AEAD (AES-128-GCM) interface", {0} },
+    {&tfm_crypto_test_6039, "TFM_CRYPTO_TEST_6039",
+     "Non Secure batch AEAD (AES-128-GCM) interface", {0} },
+    {&tfm_crypto_test_6040, "TFM_CRYPTO_TEST_6040",
+     "Non Secure batch signature verification (ECDSA-P256) interface", {0} },
+    {&tfm_crypto_test_6041, "TFM_CRYPTO_TEST_6041",
+     "Non Secure ChaCha20-Poly1305 known answer interface", {0} },
 };
 
 void register_testsuite_ns_crypto_interface(struct test_suite_t *p_test_suite)
@@ -208,3 +229,38 @@ static void tfm_crypto_test_6034(struct test_result_t *ret)
 {
     psa_persistent_key_test(1, ret);
 }
+
+static void tfm_crypto_test_6035(struct test_result_t *ret)
+{
+    psa_random_batch_test(ret);
+}
+
+static void tfm_crypto_test_6036(struct test_result_t *ret)
+{
+    psa_hash_clone_test(PSA_ALG_SHA_256, ret);
+}
+
+static void tfm_crypto_test_6037(struct test_result_t *ret)
+{
+    psa_mac_clone_test(PSA_ALG_HMAC(PSA_ALG_SHA_256), ret);
+}
+
+static void tfm_crypto_test_6038(struct test_result_t *ret)
+{
+    psa_aead_multipart_test(PSA_KEY_TYPE_AES, PSA_ALG_GCM, ret);
+}
+
+static void tfm_crypto_test_6039(struct test_result_t *ret)
+{
+    psa_aead_batch_test(PSA_KEY_TYPE_AES, PSA_ALG_GCM, ret);
+}
+
+static void tfm_crypto_test_6040(struct test_result_t *ret)
+{
+    psa_verify_hash_batch_test(ret);
+}
+
+static void tfm_crypto_test_6041(struct test_result_t *ret)
+{
+    psa_aead_chacha20_poly1305_kat_test(ret);
+}
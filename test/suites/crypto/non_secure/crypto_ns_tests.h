@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -21,6 +21,13 @@ extern "C" {
  */
 void register_testsuite_ns_crypto_interface(struct test_suite_t *p_test_suite);
 
+/**
+ * \brief Register testsuite for Crypto non-secure benchmark.
+ *
+ * \param[in] p_test_suite The test suite to be executed.
+ */
+void register_testsuite_ns_crypto_benchmark(struct test_suite_t *p_test_suite);
+
 #ifdef __cplusplus
 }
 #endif
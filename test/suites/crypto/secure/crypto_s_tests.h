@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -16,6 +16,8 @@ extern "C" {
 
 void register_testsuite_s_crypto_interface(struct test_suite_t *p_test_suite);
 
+void register_testsuite_s_crypto_benchmark(struct test_suite_t *p_test_suite);
+
 #ifdef __cplusplus
 }
 #endif
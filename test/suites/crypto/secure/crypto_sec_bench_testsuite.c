@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include "test/framework/test_framework_helpers.h"
+#include "../crypto_bench_common.h"
+
+#define BENCH_SIDE "S"
+
+/* List of tests */
+static void tfm_crypto_test_5101(struct test_result_t *ret);
+static void tfm_crypto_test_5102(struct test_result_t *ret);
+static void tfm_crypto_test_5103(struct test_result_t *ret);
+static void tfm_crypto_test_5104(struct test_result_t *ret);
+static void tfm_crypto_test_5105(struct test_result_t *ret);
+static void tfm_crypto_test_5106(struct test_result_t *ret);
+static void tfm_crypto_test_5107(struct test_result_t *ret);
+
+static struct test_t crypto_bench_tests[] = {
+    {&tfm_crypto_test_5101, "TFM_CRYPTO_TEST_5101",
+     "Secure call overhead benchmark", {0} },
+    {&tfm_crypto_test_5102, "TFM_CRYPTO_TEST_5102",
+     "Secure Hash (SHA-256) benchmark", {0} },
+    {&tfm_crypto_test_5103, "TFM_CRYPTO_TEST_5103",
+     "Secure HMAC (SHA-256) benchmark", {0} },
+    {&tfm_crypto_test_5104, "TFM_CRYPTO_TEST_5104",
+     "Secure Symmetric encryption (AES-128-CBC, AES-128-CTR) benchmark", {0} },
+    {&tfm_crypto_test_5105, "TFM_CRYPTO_TEST_5105",
+     "Secure AEAD (AES-128-CCM, AES-128-GCM) benchmark", {0} },
+    {&tfm_crypto_test_5106, "TFM_CRYPTO_TEST_5106",
+     "Secure ECDSA (P-256) key generation, sign and verify benchmark", {0} },
+    {&tfm_crypto_test_5107, "TFM_CRYPTO_TEST_5107",
+     "Secure Key derivation (HKDF-SHA-256) benchmark", {0} },
+};
+
+void register_testsuite_s_crypto_benchmark(struct test_suite_t *p_test_suite)
+{
+    uint32_t list_size = (sizeof(crypto_bench_tests) /
+                          sizeof(crypto_bench_tests[0]));
+
+    set_testsuite("Crypto secure benchmark (TFM_CRYPTO_TEST_51XX)",
+                  crypto_bench_tests, list_size, p_test_suite);
+}
+
+/**
+ * \brief Secure benchmark for Crypto
+ *
+ * \details The scope of this set of tests is to measure the cycles taken by
+ *          the operations of psa/crypto.h when called from the secure side.
+ *          The results are printed as BENCH lines, described in
+ *          crypto_bench_common.c, which can be collected from the test log.
+ *
+ */
+static void tfm_crypto_test_5101(struct test_result_t *ret)
+{
+    psa_call_bench_test(BENCH_SIDE, ret);
+}
+
+static void tfm_crypto_test_5102(struct test_result_t *ret)
+{
+    psa_hash_bench_test(BENCH_SIDE, "SHA-256", PSA_ALG_SHA_256, ret);
+}
+
+static void tfm_crypto_test_5103(struct test_result_t *ret)
+{
+    psa_mac_bench_test(BENCH_SIDE, "HMAC-SHA-256",
+                       PSA_ALG_HMAC(PSA_ALG_SHA_256), ret);
+}
+
+static void tfm_crypto_test_5104(struct test_result_t *ret)
+{
+    psa_cipher_bench_test(BENCH_SIDE, "AES-128-CBC", PSA_KEY_TYPE_AES,
+                          PSA_ALG_CBC_NO_PADDING, ret);
+    if (ret->val != TEST_PASSED) {
+        return;
+    }
+
+    psa_cipher_bench_test(BENCH_SIDE, "AES-128-CTR", PSA_KEY_TYPE_AES,
+                          PSA_ALG_CTR, ret);
+}
+
+static void tfm_crypto_test_5105(struct test_result_t *ret)
+{
+    psa_aead_bench_test(BENCH_SIDE, "AES-128-CCM", PSA_KEY_TYPE_AES,
+                        PSA_ALG_CCM, ret);
+    if (ret->val != TEST_PASSED) {
+        return;
+    }
+
+    psa_aead_bench_test(BENCH_SIDE, "AES-128-GCM", PSA_KEY_TYPE_AES,
+                        PSA_ALG_GCM, ret);
+}
+
+static void tfm_crypto_test_5106(struct test_result_t *ret)
+{
+    psa_ecdsa_bench_test(BENCH_SIDE, ret);
+}
+
+static void tfm_crypto_test_5107(struct test_result_t *ret)
+{
+    psa_key_derivation_bench_test(BENCH_SIDE, "HKDF-SHA-256",
+                                  PSA_ALG_HKDF(PSA_ALG_SHA_256), ret);
+}
@@ -34,6 +34,13 @@ static void tfm_crypto_test_5032(struct test_result_t *ret);
 static void tfm_crypto_test_5033(struct test_result_t *ret);
 static void tfm_crypto_test_5034(struct test_result_t *ret);
 static void tfm_crypto_test_5035(struct test_result_t *ret);
+static void tfm_crypto_test_5036(struct test_result_t *ret);
+static void tfm_crypto_test_5037(struct test_result_t *ret);
+static void tfm_crypto_test_5038(struct test_result_t *ret);
+static void tfm_crypto_test_5039(struct test_result_t *ret);
+static void tfm_crypto_test_5040(struct test_result_t *ret);
+static void tfm_crypto_test_5041(struct test_result_t *ret);
+static void tfm_crypto_test_5042(struct test_result_t *ret);
 
 static struct test_t crypto_tests[] = {
     {&tfm_crypto_test_5001, "TFM_CRYPTO_TEST_5001",
@@ -82,6 +89,20 @@ static struct test_t crypto_tests[] = {
      "Secure persistent key interface", {0} },
     {&tfm_crypto_test_5035, "TFM_CRYPTO_TEST_5035",
      "Key access control", {0} },
+    {&tfm_crypto_test_5036, "TFM_CRYPTO_TEST_5036",
+     "Secure random generation batch interface", {0} },
+    {&tfm_crypto_test_5037, "TFM_CRYPTO_TEST_5037",
+     "Secure hash clone (SHA-256) interface", {0} },
+    {&tfm_crypto_test_5038, "TFM_CRYPTO_TEST_5038",
+     "Secure HMAC clone (SHA-256) interface", {0} },
+    {&tfm_crypto_test_5039, "TFM_CRYPTO_TEST_5039",
+     "Secure multipart AEAD (AES-128-GCM) interface", {0} },
+    {&tfm_crypto_test_5040, "TFM_CRYPTO_TEST_5040",
+     "Secure batch AEAD (AES-128-GCM) interface", {0} },
+    {&tfm_crypto_test_5041, "TFM_CRYPTO_TEST_5041",
+     "Secure batch signature verification (ECDSA-P256) interface", {0} },
+    {&tfm_crypto_test_5042, "TFM_CRYPTO_TEST_5042",
+     "Secure ChaCha20-Poly1305 known answer interface", {0} },
 };
 
 void register_testsuite_s_crypto_interface(struct test_suite_t *p_test_suite)
@@ -253,3 +274,38 @@ static void tfm_crypto_test_5035(struct test_result_t *ret)
     }
     return;
 }
+
+static void tfm_crypto_test_5036(struct test_result_t *ret)
+{
+    psa_random_batch_test(ret);
+}
+
+static void tfm_crypto_test_5037(struct test_result_t *ret)
+{
+    psa_hash_clone_test(PSA_ALG_SHA_256, ret);
+}
+
+static void tfm_crypto_test_5038(struct test_result_t *ret)
+{
+    psa_mac_clone_test(PSA_ALG_HMAC(PSA_ALG_SHA_256), ret);
+}
+
+static void tfm_crypto_test_5039(struct test_result_t *ret)
+{
+    psa_aead_multipart_test(PSA_KEY_TYPE_AES, PSA_ALG_GCM, ret);
+}
+
+static void tfm_crypto_test_5040(struct test_result_t *ret)
+{
+    psa_aead_batch_test(PSA_KEY_TYPE_AES, PSA_ALG_GCM, ret);
+}
+
+static void tfm_crypto_test_5041(struct test_result_t *ret)
+{
+    psa_verify_hash_batch_test(ret);
+}
+
+static void tfm_crypto_test_5042(struct test_result_t *ret)
+{
+    psa_aead_chacha20_poly1305_kat_test(ret);
+}
@@ -0,0 +1,478 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdbool.h>
+#include <string.h>
+#include "fwu_ns_tests.h"
+#include "tfm_fwu_api.h"
+#include "psa/crypto.h"
+
+/* Fields of the MCUBoot image format, see bootutil/image.h */
+#define FWU_TEST_IMAGE_MAGIC        0x96f3b83dU
+#define FWU_TEST_TLV_INFO_MAGIC     0x6907U
+#define FWU_TEST_HEADER_SIZE        32U
+#define FWU_TEST_F_ENCRYPTED        0x00000004U
+#define FWU_TEST_TLV_SHA256         0x10U
+#define FWU_TEST_TLV_ECDSA256       0x22U
+
+#define FWU_TEST_HASH_SIZE          32U
+#define FWU_TEST_SIG_SIZE           64U
+
+/* Not a multiple of the flash write alignment, so that the service keeps a
+ * partial write unit between the blocks.
+ */
+#define FWU_TEST_BODY_SIZE          1001U
+
+/* Crosses the end of the header and of the body within a block */
+#define FWU_TEST_BLOCK_SIZE         100U
+
+#define FWU_TEST_TLV_TOT            (4U + (4U + FWU_TEST_HASH_SIZE) + \
+                                     (4U + FWU_TEST_SIG_SIZE))
+#define FWU_TEST_IMAGE_SIZE         (FWU_TEST_HEADER_SIZE + \
+                                     FWU_TEST_BODY_SIZE + FWU_TEST_TLV_TOT)
+
+/* Not an image of MCUBoot */
+#define FWU_TEST_INVALID_IMAGE_ID   8U
+
+/* Options of the test image */
+#define FWU_TEST_OPT_NONE           0U
+#define FWU_TEST_OPT_BAD_MAGIC      (1U << 0)
+#define FWU_TEST_OPT_ENCRYPTED      (1U << 1)
+#define FWU_TEST_OPT_BAD_HASH       (1U << 2)
+#define FWU_TEST_OPT_NO_SIG         (1U << 3)
+
+static uint8_t fwu_test_image[FWU_TEST_IMAGE_SIZE];
+
+/* List of tests */
+static void tfm_fwu_test_1001(struct test_result_t *ret);
+static void tfm_fwu_test_1002(struct test_result_t *ret);
+static void tfm_fwu_test_1003(struct test_result_t *ret);
+static void tfm_fwu_test_1004(struct test_result_t *ret);
+
+static struct test_t fwu_interface_tests[] = {
+    {&tfm_fwu_test_1001, "TFM_FWU_TEST_1001",
+     "Write, install and abort an image", {0} },
+    {&tfm_fwu_test_1002, "TFM_FWU_TEST_1002",
+     "Abort an image being written", {0} },
+    {&tfm_fwu_test_1003, "TFM_FWU_TEST_1003",
+     "Rejection of invalid requests and malformed images", {0} },
+    {&tfm_fwu_test_1004, "TFM_FWU_TEST_1004",
+     "Rejection of images failing the verification", {0} },
+};
+
+void register_testsuite_ns_fwu_interface(struct test_suite_t *p_test_suite)
+{
+    uint32_t list_size;
+
+    list_size = (sizeof(fwu_interface_tests) /
+                 sizeof(fwu_interface_tests[0]));
+
+    set_testsuite("Firmware update Service Non-Secure interface tests"
+                  "(TFM_FWU_TEST_1XXX)",
+                  fwu_interface_tests, list_size, p_test_suite);
+}
+
+static uint32_t fwu_test_put16(uint32_t off, uint16_t val)
+{
+    fwu_test_image[off] = (uint8_t)val;
+    fwu_test_image[off + 1] = (uint8_t)(val >> 8);
+
+    return off + 2;
+}
+
+static uint32_t fwu_test_put32(uint32_t off, uint32_t val)
+{
+    off = fwu_test_put16(off, (uint16_t)val);
+
+    return fwu_test_put16(off, (uint16_t)(val >> 16));
+}
+
+static uint32_t fwu_test_put_tlv(uint32_t off, uint8_t type, uint16_t len)
+{
+    fwu_test_image[off] = type;
+    fwu_test_image[off + 1] = 0;
+
+    return fwu_test_put16(off + 2, len);
+}
+
+/**
+ * \brief Builds an image in the MCUBoot format, with its SHA256 TLV and a
+ *        signature TLV. The service checks the hash of the image and that it
+ *        has a signature, which only MCUBoot verifies.
+ *
+ * \param[in] opts  FWU_TEST_OPT_* to make the image invalid
+ *
+ * \return PSA_SUCCESS if the image is built.
+ */
+static psa_status_t fwu_test_build_image(uint32_t opts)
+{
+    uint32_t hash_off, off, i;
+    size_t hash_len;
+    psa_status_t status;
+
+    memset(fwu_test_image, 0, sizeof(fwu_test_image));
+
+    off = fwu_test_put32(0, (opts & FWU_TEST_OPT_BAD_MAGIC) ?
+                            ~FWU_TEST_IMAGE_MAGIC : FWU_TEST_IMAGE_MAGIC);
+    off = fwu_test_put32(off, 0);                       /* ih_load_addr */
+    off = fwu_test_put16(off, FWU_TEST_HEADER_SIZE);    /* ih_hdr_size */
+    off = fwu_test_put16(off, 0);                       /* ih_protect_tlv */
+    off = fwu_test_put32(off, FWU_TEST_BODY_SIZE);      /* ih_img_size */
+    (void)fwu_test_put32(off, (opts & FWU_TEST_OPT_ENCRYPTED) ?
+                              FWU_TEST_F_ENCRYPTED : 0);
+
+    for (i = 0; i < FWU_TEST_BODY_SIZE; i++) {
+        fwu_test_image[FWU_TEST_HEADER_SIZE + i] = (uint8_t)(i * 7U);
+    }
+
+    off = FWU_TEST_HEADER_SIZE + FWU_TEST_BODY_SIZE;
+    off = fwu_test_put16(off, FWU_TEST_TLV_INFO_MAGIC);
+    off = fwu_test_put16(off, FWU_TEST_TLV_TOT);
+
+    off = fwu_test_put_tlv(off, FWU_TEST_TLV_SHA256, FWU_TEST_HASH_SIZE);
+    hash_off = off;
+    status = psa_hash_compute(PSA_ALG_SHA_256, fwu_test_image,
+                              FWU_TEST_HEADER_SIZE + FWU_TEST_BODY_SIZE,
+                              &fwu_test_image[hash_off], FWU_TEST_HASH_SIZE,
+                              &hash_len);
+    if ((status != PSA_SUCCESS) || (hash_len != FWU_TEST_HASH_SIZE)) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+    off += FWU_TEST_HASH_SIZE;
+
+    /* Any other TLV keeps the size of the image */
+    off = fwu_test_put_tlv(off, (opts & FWU_TEST_OPT_NO_SIG) ?
+                                FWU_TEST_TLV_SHA256 + 1U :
+                                FWU_TEST_TLV_ECDSA256,
+                           FWU_TEST_SIG_SIZE);
+    memset(&fwu_test_image[off], 0x5A, FWU_TEST_SIG_SIZE);
+
+    /* The image no longer matches its hash */
+    if (opts & FWU_TEST_OPT_BAD_HASH) {
+        fwu_test_image[FWU_TEST_HEADER_SIZE + FWU_TEST_BODY_SIZE / 2] ^= 1U;
+    }
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Writes the image from an offset up to a size, in blocks.
+ *
+ * \return Status of the first block which is not written, or PSA_SUCCESS.
+ */
+static psa_status_t fwu_test_write(uint32_t start, uint32_t end)
+{
+    uint32_t off, len;
+    psa_status_t status;
+
+    for (off = start; off < end; off += len) {
+        len = end - off;
+        if (len > FWU_TEST_BLOCK_SIZE) {
+            len = FWU_TEST_BLOCK_SIZE;
+        }
+        status = tfm_fwu_write(TFM_FWU_IMAGE_ID_S, off, &fwu_test_image[off],
+                               len);
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+    }
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Checks the progress of the update of the secure image.
+ */
+static bool fwu_test_check_state(uint32_t state, uint32_t written)
+{
+    struct tfm_fwu_info_t info;
+
+    if (tfm_fwu_query(TFM_FWU_IMAGE_ID_S, &info) != PSA_SUCCESS) {
+        return false;
+    }
+
+    return (info.state == state) && (info.written == written);
+}
+
+/**
+ * \brief Writes a valid image, checks that it is verified, marks it for
+ *        installation and aborts the installation.
+ */
+static void tfm_fwu_test_1001(struct test_result_t *ret)
+{
+    struct tfm_fwu_info_t info;
+    psa_status_t status;
+
+    if (fwu_test_build_image(FWU_TEST_OPT_NONE) != PSA_SUCCESS) {
+        TEST_FAIL("Building the image should not fail");
+        return;
+    }
+
+    status = fwu_test_write(0, FWU_TEST_IMAGE_SIZE);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Writing a valid image should not fail");
+        return;
+    }
+
+    status = tfm_fwu_query(TFM_FWU_IMAGE_ID_S, &info);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Query should not fail");
+        return;
+    }
+
+    if ((info.state != TFM_FWU_STATE_VERIFIED) ||
+        (info.written != FWU_TEST_IMAGE_SIZE) ||
+        (info.image_size != FWU_TEST_IMAGE_SIZE)) {
+        TEST_FAIL("The written image should be verified");
+        return;
+    }
+
+    /* Test mode, so that a failed boot reverts to the running image */
+    status = tfm_fwu_install(TFM_FWU_IMAGE_ID_S, false);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Installing a verified image should not fail");
+        return;
+    }
+
+    if (!fwu_test_check_state(TFM_FWU_STATE_INSTALLED, FWU_TEST_IMAGE_SIZE)) {
+        TEST_FAIL("The image should be installed");
+        return;
+    }
+
+    /* The image of the test must not be installed at the next boot */
+    status = tfm_fwu_abort(TFM_FWU_IMAGE_ID_S);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Aborting an installed image should not fail");
+        return;
+    }
+
+    if (!fwu_test_check_state(TFM_FWU_STATE_IDLE, 0)) {
+        TEST_FAIL("No update should be in progress after the abort");
+        return;
+    }
+
+    status = tfm_fwu_install(TFM_FWU_IMAGE_ID_S, false);
+    if (status != PSA_ERROR_BAD_STATE) {
+        TEST_FAIL("Installing an aborted image should fail");
+        return;
+    }
+
+    ret->val = TEST_PASSED;
+}
+
+/**
+ * \brief Aborts an image half written, and checks that the update cannot be
+ *        continued or installed.
+ */
+static void tfm_fwu_test_1002(struct test_result_t *ret)
+{
+    const uint32_t half = FWU_TEST_IMAGE_SIZE / 2;
+    psa_status_t status;
+
+    if (fwu_test_build_image(FWU_TEST_OPT_NONE) != PSA_SUCCESS) {
+        TEST_FAIL("Building the image should not fail");
+        return;
+    }
+
+    status = fwu_test_write(0, half);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Writing the first half of the image should not fail");
+        return;
+    }
+
+    if (!fwu_test_check_state(TFM_FWU_STATE_WRITING, half)) {
+        TEST_FAIL("The image should be being written");
+        return;
+    }
+
+    status = tfm_fwu_abort(TFM_FWU_IMAGE_ID_S);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Aborting an image being written should not fail");
+        return;
+    }
+
+    if (!fwu_test_check_state(TFM_FWU_STATE_IDLE, 0)) {
+        TEST_FAIL("No update should be in progress after the abort");
+        return;
+    }
+
+    status = fwu_test_write(half, FWU_TEST_IMAGE_SIZE);
+    if (status != PSA_ERROR_INVALID_ARGUMENT) {
+        TEST_FAIL("Continuing an aborted update should fail");
+        return;
+    }
+
+    status = tfm_fwu_install(TFM_FWU_IMAGE_ID_S, false);
+    if (status != PSA_ERROR_BAD_STATE) {
+        TEST_FAIL("Installing an aborted image should fail");
+        return;
+    }
+
+    /* Aborting without an update in progress is not an error */
+    status = tfm_fwu_abort(TFM_FWU_IMAGE_ID_S);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Aborting without an update should not fail");
+        return;
+    }
+
+    ret->val = TEST_PASSED;
+}
+
+/**
+ * \brief Checks the rejection of requests out of order or on an invalid
+ *        image, and of malformed images.
+ */
+static void tfm_fwu_test_1003(struct test_result_t *ret)
+{
+    struct tfm_fwu_info_t info;
+    psa_status_t status;
+
+    if (fwu_test_build_image(FWU_TEST_OPT_NONE) != PSA_SUCCESS) {
+        TEST_FAIL("Building the image should not fail");
+        return;
+    }
+
+    status = tfm_fwu_write(FWU_TEST_INVALID_IMAGE_ID, 0, fwu_test_image,
+                           FWU_TEST_BLOCK_SIZE);
+    if (status != PSA_ERROR_INVALID_ARGUMENT) {
+        TEST_FAIL("Writing an invalid image ID should fail");
+        return;
+    }
+
+    status = tfm_fwu_query(FWU_TEST_INVALID_IMAGE_ID, &info);
+    if (status != PSA_ERROR_INVALID_ARGUMENT) {
+        TEST_FAIL("Querying an invalid image ID should fail");
+        return;
+    }
+
+    status = tfm_fwu_write(TFM_FWU_IMAGE_ID_S, FWU_TEST_BLOCK_SIZE,
+                           &fwu_test_image[FWU_TEST_BLOCK_SIZE],
+                           FWU_TEST_BLOCK_SIZE);
+    if (status != PSA_ERROR_INVALID_ARGUMENT) {
+        TEST_FAIL("Writing without starting an update should fail");
+        return;
+    }
+
+    status = fwu_test_write(0, FWU_TEST_BLOCK_SIZE);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Writing the first block should not fail");
+        return;
+    }
+
+    /* A gap in the image */
+    status = tfm_fwu_write(TFM_FWU_IMAGE_ID_S, 2 * FWU_TEST_BLOCK_SIZE,
+                           &fwu_test_image[2 * FWU_TEST_BLOCK_SIZE],
+                           FWU_TEST_BLOCK_SIZE);
+    if (status != PSA_ERROR_INVALID_ARGUMENT) {
+        TEST_FAIL("Writing beyond the next offset should fail");
+        return;
+    }
+
+    status = tfm_fwu_install(TFM_FWU_IMAGE_ID_S, false);
+    if (status != PSA_ERROR_BAD_STATE) {
+        TEST_FAIL("Installing an image not verified should fail");
+        return;
+    }
+
+    /* The update continues after the rejected requests */
+    status = fwu_test_write(FWU_TEST_BLOCK_SIZE, FWU_TEST_IMAGE_SIZE);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Writing the rest of the image should not fail");
+        return;
+    }
+
+    status = tfm_fwu_write(TFM_FWU_IMAGE_ID_S, FWU_TEST_IMAGE_SIZE,
+                           fwu_test_image, FWU_TEST_BLOCK_SIZE);
+    if (status != PSA_ERROR_INVALID_ARGUMENT) {
+        TEST_FAIL("Writing beyond the end of the image should fail");
+        return;
+    }
+
+    if (fwu_test_build_image(FWU_TEST_OPT_BAD_MAGIC) != PSA_SUCCESS) {
+        TEST_FAIL("Building the image should not fail");
+        return;
+    }
+
+    /* Restarts the update */
+    status = fwu_test_write(0, FWU_TEST_IMAGE_SIZE);
+    if (status != PSA_ERROR_INVALID_ARGUMENT) {
+        TEST_FAIL("Writing an image with a bad header magic should fail");
+        return;
+    }
+
+    if (!fwu_test_check_state(TFM_FWU_STATE_FAILED, 0)) {
+        TEST_FAIL("The update of a malformed image should be failed");
+        return;
+    }
+
+    if (fwu_test_build_image(FWU_TEST_OPT_ENCRYPTED) != PSA_SUCCESS) {
+        TEST_FAIL("Building the image should not fail");
+        return;
+    }
+
+    status = fwu_test_write(0, FWU_TEST_IMAGE_SIZE);
+    if (status != PSA_ERROR_NOT_SUPPORTED) {
+        TEST_FAIL("Writing an encrypted image should fail");
+        return;
+    }
+
+    status = tfm_fwu_abort(TFM_FWU_IMAGE_ID_S);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Aborting a failed update should not fail");
+        return;
+    }
+
+    ret->val = TEST_PASSED;
+}
+
+/**
+ * \brief Checks that an image not matching its hash, or without signature,
+ *        is not verified and cannot be installed.
+ */
+static void tfm_fwu_test_1004(struct test_result_t *ret)
+{
+    static const uint32_t opts[] = {
+        FWU_TEST_OPT_BAD_HASH,
+        FWU_TEST_OPT_NO_SIG,
+    };
+    psa_status_t status;
+    uint32_t i;
+
+    for (i = 0; i < sizeof(opts) / sizeof(opts[0]); i++) {
+        if (fwu_test_build_image(opts[i]) != PSA_SUCCESS) {
+            TEST_FAIL("Building the image should not fail");
+            return;
+        }
+
+        status = fwu_test_write(0, FWU_TEST_IMAGE_SIZE);
+        if (status != PSA_ERROR_INVALID_SIGNATURE) {
+            TEST_FAIL("Writing an image failing the verification should fail");
+            return;
+        }
+
+        if (!fwu_test_check_state(TFM_FWU_STATE_FAILED,
+                                  FWU_TEST_IMAGE_SIZE)) {
+            TEST_FAIL("The update of the image should be failed");
+            return;
+        }
+
+        status = tfm_fwu_install(TFM_FWU_IMAGE_ID_S, true);
+        if (status != PSA_ERROR_BAD_STATE) {
+            TEST_FAIL("Installing an image failing the verification "
+                      "should fail");
+            return;
+        }
+    }
+
+    status = tfm_fwu_abort(TFM_FWU_IMAGE_ID_S);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Aborting a failed update should not fail");
+        return;
+    }
+
+    ret->val = TEST_PASSED;
+}
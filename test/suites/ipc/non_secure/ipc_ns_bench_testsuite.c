@@ -0,0 +1,310 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdint.h>
+#include "ipc_ns_tests.h"
+#include "psa/client.h"
+#include "psa_manifest/sid.h"
+#include "test/framework/test_framework_helpers.h"
+#include "test/test_services/tfm_ipc_service/tfm_ipc_bench.h"
+
+/* Number of operations each measurement is averaged over */
+#ifndef IPC_BENCH_LOOPS
+#define IPC_BENCH_LOOPS 32
+#endif
+
+/* Fields of each line of the benchmark, after the BENCH tag:
+ *  - the caller of the service, NS for the non-secure side or S for the IPC
+ *    client test partition
+ *  - the measured operation
+ *  - the payload size in bytes, sent and received by each call
+ *  - the number of operations the measurement is averaged over
+ *  - the average cycles per operation
+ */
+#define BENCH_FIELDS "side,operation,bytes,loops,cycles"
+
+static const uint32_t bench_sizes[] = {0, 64, 512, IPC_BENCH_MAX_SIZE};
+
+static uint8_t bench_buf[IPC_BENCH_MAX_SIZE];
+
+/* List of tests */
+static void tfm_ipc_test_1101(struct test_result_t *ret);
+static void tfm_ipc_test_1102(struct test_result_t *ret);
+static void tfm_ipc_test_1103(struct test_result_t *ret);
+static void tfm_ipc_test_1104(struct test_result_t *ret);
+static void tfm_ipc_test_1105(struct test_result_t *ret);
+
+static struct test_t ipc_bench_tests[] = {
+    {&tfm_ipc_test_1101, "TFM_IPC_TEST_1101",
+     "Non Secure to Secure psa_call benchmark", {0} },
+    {&tfm_ipc_test_1102, "TFM_IPC_TEST_1102",
+     "Non Secure to Secure psa_connect and psa_close benchmark", {0} },
+    {&tfm_ipc_test_1103, "TFM_IPC_TEST_1103",
+     "Secure to Secure psa_call benchmark", {0} },
+    {&tfm_ipc_test_1104, "TFM_IPC_TEST_1104",
+     "Secure to Secure psa_connect and psa_close benchmark", {0} },
+    {&tfm_ipc_test_1105, "TFM_IPC_TEST_1105",
+     "Service psa_wait wake-up and psa_reply benchmark", {0} },
+};
+
+void register_testsuite_ns_ipc_benchmark(struct test_suite_t *p_test_suite)
+{
+    uint32_t list_size = (sizeof(ipc_bench_tests) /
+                          sizeof(ipc_bench_tests[0]));
+
+    set_testsuite("IPC non-secure benchmark (TFM_IPC_TEST_11XX)",
+                  ipc_bench_tests, list_size, p_test_suite);
+}
+
+/**
+ * \brief Starts the cycle counter of the test framework. The benchmark is
+ *        skipped if there is none.
+ */
+static int bench_counter_start(struct test_result_t *ret)
+{
+    if (test_timer_start() != 0) {
+        TEST_LOG("No cycle counter, the benchmark was SKIPPED.\r\n");
+        ret->val = TEST_PASSED;
+        return 0;
+    }
+
+    return 1;
+}
+
+static void bench_log(const char *side, const char *name, uint32_t bytes,
+                      uint32_t cycles)
+{
+    TEST_LOG("BENCH,%s,%s,%u,%u,%u\r\n", side, name, (unsigned int)bytes,
+             (unsigned int)IPC_BENCH_LOOPS, (unsigned int)cycles);
+}
+
+/**
+ * \brief Makes the IPC client test partition run a benchmark operation, and
+ *        returns the average cycles of the operation on the secure side.
+ *
+ * \details The cost of the non-secure call to the client partition is
+ *          removed by subtracting the cycles of the same request without
+ *          any loop. This keeps the cycle counter on the non-secure side,
+ *          which also works when the client partition runs unprivileged.
+ */
+static psa_status_t bench_secure_op(uint32_t op, uint32_t size,
+                                    uint32_t *cycles)
+{
+    struct ipc_bench_req req = {op, size, 0};
+    psa_invec invecs[1] = {{&req, sizeof(req)}};
+    psa_handle_t handle;
+    psa_status_t status;
+    uint32_t start;
+    uint32_t empty;
+    uint32_t full;
+
+    handle = psa_connect(IPC_CLIENT_TEST_BENCH_SID,
+                         IPC_CLIENT_TEST_BENCH_VERSION);
+    if (handle <= 0) {
+        return PSA_ERROR_CONNECTION_REFUSED;
+    }
+
+    start = test_timer_read();
+    status = psa_call(handle, PSA_IPC_CALL, invecs, 1, NULL, 0);
+    empty = test_timer_read() - start;
+
+    if (status == PSA_SUCCESS) {
+        req.loops = IPC_BENCH_LOOPS;
+        start = test_timer_read();
+        status = psa_call(handle, PSA_IPC_CALL, invecs, 1, NULL, 0);
+        full = test_timer_read() - start;
+
+        *cycles = (full > empty) ? ((full - empty) / IPC_BENCH_LOOPS) : 0;
+    }
+
+    psa_close(handle);
+
+    return status;
+}
+
+/**
+ * \brief Non Secure benchmark for IPC
+ *
+ * \details The scope of this set of tests is to measure the cycles taken by
+ *          the IPC round trips through the SPM, to the IPC_SERVICE_TEST_BENCH
+ *          service which does nothing but copy the payload. The results are
+ *          printed as BENCH lines, described above, which can be collected
+ *          from the test log.
+ */
+static void tfm_ipc_test_1101(struct test_result_t *ret)
+{
+    psa_invec invecs[1] = {{bench_buf, 0}};
+    psa_outvec outvecs[1] = {{bench_buf, 0}};
+    psa_handle_t handle;
+    psa_status_t status = PSA_SUCCESS;
+    uint32_t start;
+    uint32_t cycles;
+    uint32_t i;
+    uint32_t j;
+
+    if (!bench_counter_start(ret)) {
+        return;
+    }
+
+    bench_log_header(BENCH_FIELDS);
+
+    handle = psa_connect(IPC_SERVICE_TEST_BENCH_SID,
+                         IPC_SERVICE_TEST_BENCH_VERSION);
+    if (handle <= 0) {
+        TEST_FAIL("Connection to the benchmark service failed");
+        return;
+    }
+
+    for (i = 0; i < sizeof(bench_sizes) / sizeof(bench_sizes[0]); i++) {
+        invecs[0].len = bench_sizes[i];
+        outvecs[0].len = bench_sizes[i];
+
+        start = test_timer_read();
+        for (j = 0; j < IPC_BENCH_LOOPS && status == PSA_SUCCESS; j++) {
+            status = psa_call(handle, PSA_IPC_CALL, invecs,
+                              (bench_sizes[i] != 0) ? 1 : 0, outvecs,
+                              (bench_sizes[i] != 0) ? 1 : 0);
+        }
+        cycles = (test_timer_read() - start) / IPC_BENCH_LOOPS;
+
+        if (status != PSA_SUCCESS) {
+            psa_close(handle);
+            TEST_FAIL("Call to the benchmark service failed");
+            return;
+        }
+
+        bench_log("NS", "psa_call", bench_sizes[i], cycles);
+    }
+
+    psa_close(handle);
+
+    ret->val = TEST_PASSED;
+}
+
+static void tfm_ipc_test_1102(struct test_result_t *ret)
+{
+    psa_handle_t handle;
+    uint32_t start;
+    uint32_t cycles;
+    uint32_t i;
+
+    if (!bench_counter_start(ret)) {
+        return;
+    }
+
+    start = test_timer_read();
+    for (i = 0; i < IPC_BENCH_LOOPS; i++) {
+        handle = psa_connect(IPC_SERVICE_TEST_BENCH_SID,
+                             IPC_SERVICE_TEST_BENCH_VERSION);
+        if (handle <= 0) {
+            TEST_FAIL("Connection to the benchmark service failed");
+            return;
+        }
+        psa_close(handle);
+    }
+    cycles = (test_timer_read() - start) / IPC_BENCH_LOOPS;
+
+    bench_log("NS", "psa_connect+psa_close", 0, cycles);
+
+    ret->val = TEST_PASSED;
+}
+
+static void tfm_ipc_test_1103(struct test_result_t *ret)
+{
+    psa_status_t status;
+    uint32_t cycles;
+    uint32_t i;
+
+    if (!bench_counter_start(ret)) {
+        return;
+    }
+
+    for (i = 0; i < sizeof(bench_sizes) / sizeof(bench_sizes[0]); i++) {
+        status = bench_secure_op(IPC_BENCH_OP_CALL, bench_sizes[i], &cycles);
+        if (status != PSA_SUCCESS) {
+            TEST_FAIL("Secure to Secure call benchmark failed");
+            return;
+        }
+
+        bench_log("S", "psa_call", bench_sizes[i], cycles);
+    }
+
+    ret->val = TEST_PASSED;
+}
+
+static void tfm_ipc_test_1104(struct test_result_t *ret)
+{
+    psa_status_t status;
+    uint32_t cycles;
+
+    if (!bench_counter_start(ret)) {
+        return;
+    }
+
+    status = bench_secure_op(IPC_BENCH_OP_CONNECT_CLOSE, 0, &cycles);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Secure to Secure connection benchmark failed");
+        return;
+    }
+
+    bench_log("S", "psa_connect+psa_close", 0, cycles);
+
+    ret->val = TEST_PASSED;
+}
+
+/**
+ * \brief Splits the round trip of a call in the time taken to wake the
+ *        service partition up from psa_wait(), and the time from there to
+ *        the return of psa_call(), which includes the psa_reply() of the
+ *        service. The service partition stamps its wake-up with the DWT
+ *        cycle counter, so the split needs the default test timer.
+ */
+static void tfm_ipc_test_1105(struct test_result_t *ret)
+{
+    uint32_t stamp = 0;
+    psa_outvec outvecs[1] = {{&stamp, sizeof(stamp)}};
+    psa_handle_t handle;
+    psa_status_t status;
+    uint32_t start;
+    uint32_t end;
+    uint32_t wake = 0;
+    uint32_t reply = 0;
+    uint32_t i;
+
+    if (!bench_counter_start(ret)) {
+        return;
+    }
+
+    handle = psa_connect(IPC_SERVICE_TEST_BENCH_SID,
+                         IPC_SERVICE_TEST_BENCH_VERSION);
+    if (handle <= 0) {
+        TEST_FAIL("Connection to the benchmark service failed");
+        return;
+    }
+
+    for (i = 0; i < IPC_BENCH_LOOPS; i++) {
+        start = test_timer_read();
+        status = psa_call(handle, IPC_BENCH_CALL_STAMP, NULL, 0, outvecs, 1);
+        end = test_timer_read();
+
+        if (status != PSA_SUCCESS) {
+            psa_close(handle);
+            TEST_FAIL("Call to the benchmark service failed");
+            return;
+        }
+
+        wake += stamp - start;
+        reply += end - stamp;
+    }
+
+    psa_close(handle);
+
+    bench_log("NS", "psa_call-to-wake", 0, wake / IPC_BENCH_LOOPS);
+    bench_log("NS", "wake-to-return", 0, reply / IPC_BENCH_LOOPS);
+
+    ret->val = TEST_PASSED;
+}
@@ -1,18 +1,39 @@
 /*
- * Copyright (c) 2018-2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
  */
 
 #include <stdio.h>
+#include <string.h>
 #include "ipc_ns_tests.h"
 #include "psa/client.h"
 #include "test/framework/test_framework_helpers.h"
 #ifdef TFM_PSA_API
 #include "psa_manifest/sid.h"
+#include "test/test_services/tfm_ipc_service/tfm_ipc_bench.h"
 #endif
 
+/* One more request than the SPM holds in a batch, TFM_BATCH_MAX_CALLS */
+#define IPC_TEST_BATCH_OVERSIZE     9
+
+/* Status a request of a batch keeps if it is not delivered */
+#define IPC_TEST_BATCH_NOT_RUN      ((psa_status_t)1)
+
+/* Call type IPC_SERVICE_TEST_BENCH does not handle */
+#define IPC_TEST_BENCH_BAD_TYPE     (100)
+
+/*
+ * Static handle built like the one of a stateless RoT Service, for the
+ * connection based IPC_SERVICE_TEST_BENCH
+ */
+#define IPC_TEST_BENCH_STATIC_HANDLE \
+    ((psa_handle_t)(0x40000000U | IPC_SERVICE_TEST_BENCH_SID))
+
+/* Number of times the result of an asynchronous call is polled */
+#define IPC_TEST_ASYNC_POLLS        1000
+
 /* List of tests */
 static void tfm_ipc_test_1001(struct test_result_t *ret);
 static void tfm_ipc_test_1002(struct test_result_t *ret);
@@ -34,6 +55,57 @@ static void tfm_ipc_test_1009(struct test_result_t *ret);
 #endif
 
 static void tfm_ipc_test_1010(struct test_result_t *ret);
+static void tfm_ipc_test_1011(struct test_result_t *ret);
+static void tfm_ipc_test_1012(struct test_result_t *ret);
+
+#ifdef TFM_IPC_TEST_BATCH_OVERSIZE
+static void tfm_ipc_test_1013(struct test_result_t *ret);
+#endif
+
+#ifdef TFM_IPC_TEST_BATCH_INVALID_HANDLE
+static void tfm_ipc_test_1014(struct test_result_t *ret);
+#endif
+
+static void tfm_ipc_test_1015(struct test_result_t *ret);
+
+#ifdef TFM_IPC_TEST_MAP_TWICE
+static void tfm_ipc_test_1016(struct test_result_t *ret);
+#endif
+
+#ifdef TFM_IPC_TEST_MAP_AFTER_READ
+static void tfm_ipc_test_1017(struct test_result_t *ret);
+#endif
+
+#ifdef TFM_IPC_TEST_UNMAP_OVERSIZE
+static void tfm_ipc_test_1018(struct test_result_t *ret);
+#endif
+
+#ifdef TFM_IPC_TEST_UNMAP_UNMAPPED
+static void tfm_ipc_test_1019(struct test_result_t *ret);
+#endif
+
+static void tfm_ipc_test_1020(struct test_result_t *ret);
+
+#ifdef TFM_IPC_TEST_CONNECT_STATELESS
+static void tfm_ipc_test_1021(struct test_result_t *ret);
+#endif
+
+#ifdef TFM_IPC_TEST_STATIC_HANDLE_CONNECTION_BASED
+static void tfm_ipc_test_1022(struct test_result_t *ret);
+#endif
+
+#ifdef TFM_PSA_ASYNC_CALL
+static void tfm_ipc_test_1023(struct test_result_t *ret);
+static void tfm_ipc_test_1024(struct test_result_t *ret);
+
+#ifdef TFM_IPC_TEST_ASYNC_RESULT_INVALID_HANDLE
+static void tfm_ipc_test_1025(struct test_result_t *ret);
+#endif
+
+#ifdef TFM_IPC_TEST_ASYNC_CALL_UNFINISHED
+static void tfm_ipc_test_1026(struct test_result_t *ret);
+#endif
+#endif /* TFM_PSA_ASYNC_CALL */
 
 static struct test_t ipc_veneers_tests[] = {
     {&tfm_ipc_test_1001, "TFM_IPC_TEST_1001",
@@ -62,6 +134,60 @@ static struct test_t ipc_veneers_tests[] = {
 #endif
     {&tfm_ipc_test_1010, "TFM_IPC_TEST_1010",
      "Test psa_call with the status of PSA_ERROR_PROGRAMMER_ERROR", {0}},
+    {&tfm_ipc_test_1011, "TFM_IPC_TEST_1011",
+     "Call an RoT Service with a batch of requests", {0}},
+    {&tfm_ipc_test_1012, "TFM_IPC_TEST_1012",
+     "Stop a batch at a PSA_ERROR_PROGRAMMER_ERROR status", {0}},
+#ifdef TFM_IPC_TEST_BATCH_OVERSIZE
+    {&tfm_ipc_test_1013, "TFM_IPC_TEST_1013",
+     "Submit a batch larger than SPM holds", {0}},
+#endif
+#ifdef TFM_IPC_TEST_BATCH_INVALID_HANDLE
+    {&tfm_ipc_test_1014, "TFM_IPC_TEST_1014",
+     "Submit a batch to a closed connection", {0}},
+#endif
+    {&tfm_ipc_test_1015, "TFM_IPC_TEST_1015",
+     "Call an RoT Service which maps the vectors", {0}},
+#ifdef TFM_IPC_TEST_MAP_TWICE
+    {&tfm_ipc_test_1016, "TFM_IPC_TEST_1016",
+     "Call an RoT Service which maps an input vector twice", {0}},
+#endif
+#ifdef TFM_IPC_TEST_MAP_AFTER_READ
+    {&tfm_ipc_test_1017, "TFM_IPC_TEST_1017",
+     "Call an RoT Service which maps an input vector it has read", {0}},
+#endif
+#ifdef TFM_IPC_TEST_UNMAP_OVERSIZE
+    {&tfm_ipc_test_1018, "TFM_IPC_TEST_1018",
+     "Call an RoT Service which unmaps more than an output vector holds", {0}},
+#endif
+#ifdef TFM_IPC_TEST_UNMAP_UNMAPPED
+    {&tfm_ipc_test_1019, "TFM_IPC_TEST_1019",
+     "Call an RoT Service which unmaps an output vector not mapped", {0}},
+#endif
+    {&tfm_ipc_test_1020, "TFM_IPC_TEST_1020",
+     "Call a stateless RoT Service without connecting", {0}},
+#ifdef TFM_IPC_TEST_CONNECT_STATELESS
+    {&tfm_ipc_test_1021, "TFM_IPC_TEST_1021",
+     "Connect to a stateless RoT Service", {0}},
+#endif
+#ifdef TFM_IPC_TEST_STATIC_HANDLE_CONNECTION_BASED
+    {&tfm_ipc_test_1022, "TFM_IPC_TEST_1022",
+     "Call a connection based RoT Service through a static handle", {0}},
+#endif
+#ifdef TFM_PSA_ASYNC_CALL
+    {&tfm_ipc_test_1023, "TFM_IPC_TEST_1023",
+     "Poll the result of asynchronous calls", {0}},
+    {&tfm_ipc_test_1024, "TFM_IPC_TEST_1024",
+     "Poll the result of an asynchronous call in progress", {0}},
+#ifdef TFM_IPC_TEST_ASYNC_RESULT_INVALID_HANDLE
+    {&tfm_ipc_test_1025, "TFM_IPC_TEST_1025",
+     "Poll the result of an asynchronous call on a closed connection", {0}},
+#endif
+#ifdef TFM_IPC_TEST_ASYNC_CALL_UNFINISHED
+    {&tfm_ipc_test_1026, "TFM_IPC_TEST_1026",
+     "Call on a connection with an asynchronous call in progress", {0}},
+#endif
+#endif /* TFM_PSA_ASYNC_CALL */
 };
 
 void register_testsuite_ns_ipc_interface(struct test_suite_t *p_test_suite)
@@ -360,3 +486,600 @@ static void tfm_ipc_test_1010(struct test_result_t *ret)
 
     psa_close(handle);
 }
+
+/**
+ * \brief Call IPC_SERVICE_TEST_BENCH with a batch of requests of different
+ *  types, and check the status and the written length of each of them.
+ */
+static void tfm_ipc_test_1011(struct test_result_t *ret)
+{
+    uint8_t in_buf[8] = "batch";
+    uint8_t out_buf[16];
+    uint32_t stamp;
+    psa_invec invecs[1] = {{in_buf, sizeof(in_buf)}};
+    psa_outvec call_outvecs[1] = {{out_buf, sizeof(out_buf)}};
+    psa_outvec stamp_outvecs[1] = {{&stamp, sizeof(stamp)}};
+    psa_batch_call_t calls[3] = {
+        {PSA_IPC_CALL, invecs, 1, call_outvecs, 1, IPC_TEST_BATCH_NOT_RUN},
+        {IPC_BENCH_CALL_STAMP, NULL, 0, stamp_outvecs, 1,
+         IPC_TEST_BATCH_NOT_RUN},
+        /* Not a type of the service, which replies with an error */
+        {IPC_TEST_BENCH_BAD_TYPE, invecs, 1, NULL, 0, IPC_TEST_BATCH_NOT_RUN},
+    };
+    psa_handle_t handle;
+    psa_status_t status;
+
+    handle = psa_connect(IPC_SERVICE_TEST_BENCH_SID,
+                         IPC_SERVICE_TEST_BENCH_VERSION);
+    if (handle <= 0) {
+        TEST_FAIL("The RoT Service has refused the connection!\r\n");
+        return;
+    }
+
+    status = psa_call_batch(handle, calls, 0);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("An empty batch should succeed!\r\n");
+        goto close;
+    }
+
+    status = psa_call_batch(handle, calls, 3);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("psa_call_batch is failed!\r\n");
+        goto close;
+    }
+
+    if ((calls[0].status != PSA_SUCCESS) ||
+        (calls[1].status != PSA_SUCCESS) ||
+        (calls[2].status != PSA_ERROR_NOT_SUPPORTED)) {
+        TEST_FAIL("The status of a request is not the one of its reply!\r\n");
+        goto close;
+    }
+
+    if ((call_outvecs[0].len != sizeof(out_buf)) ||
+        (stamp_outvecs[0].len != sizeof(stamp))) {
+        TEST_FAIL("The written lengths are not reported!\r\n");
+        goto close;
+    }
+
+    /* The connection takes single calls again */
+    status = psa_call(handle, PSA_IPC_CALL, invecs, 1, NULL, 0);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("psa_call after the batch is failed!\r\n");
+        goto close;
+    }
+
+    ret->val = TEST_PASSED;
+
+close:
+    psa_close(handle);
+}
+
+/**
+ * \brief Call IPC_SERVICE_TEST_CLIENT_PROGRAMMER_ERROR with a batch, and check
+ *  that the requests after the one which terminated the connection are not
+ *  delivered.
+ */
+static void tfm_ipc_test_1012(struct test_result_t *ret)
+{
+    psa_batch_call_t calls[2] = {
+        {PSA_IPC_CALL, NULL, 0, NULL, 0, IPC_TEST_BATCH_NOT_RUN},
+        {PSA_IPC_CALL, NULL, 0, NULL, 0, IPC_TEST_BATCH_NOT_RUN},
+    };
+    psa_handle_t handle;
+    psa_status_t status;
+
+    handle = psa_connect(IPC_SERVICE_TEST_CLIENT_PROGRAMMER_ERROR_SID,
+                         IPC_SERVICE_TEST_CLIENT_PROGRAMMER_ERROR_VERSION);
+    if (handle <= 0) {
+        TEST_FAIL("The RoT Service has refused the connection!\r\n");
+        return;
+    }
+
+    status = psa_call_batch(handle, calls, 2);
+    if (status != PSA_ERROR_PROGRAMMER_ERROR) {
+        TEST_FAIL("The batch should end with the terminated connection!\r\n");
+        goto close;
+    }
+
+    if ((calls[0].status != PSA_ERROR_PROGRAMMER_ERROR) ||
+        (calls[1].status != IPC_TEST_BATCH_NOT_RUN)) {
+        TEST_FAIL("A request after the terminated connection is run!\r\n");
+        goto close;
+    }
+
+    ret->val = TEST_PASSED;
+
+close:
+    psa_close(handle);
+}
+
+#ifdef TFM_IPC_TEST_BATCH_OVERSIZE
+/**
+ * \brief Submit a batch of more requests than SPM holds, which is a
+ *  PROGRAMMER ERROR.
+ */
+static void tfm_ipc_test_1013(struct test_result_t *ret)
+{
+    psa_batch_call_t calls[IPC_TEST_BATCH_OVERSIZE];
+    psa_handle_t handle;
+    uint32_t i;
+
+    for (i = 0; i < IPC_TEST_BATCH_OVERSIZE; i++) {
+        calls[i] = (psa_batch_call_t){PSA_IPC_CALL, NULL, 0, NULL, 0,
+                                      IPC_TEST_BATCH_NOT_RUN};
+    }
+
+    handle = psa_connect(IPC_SERVICE_TEST_BENCH_SID,
+                         IPC_SERVICE_TEST_BENCH_VERSION);
+    if (handle <= 0) {
+        TEST_FAIL("The RoT Service has refused the connection!\r\n");
+        return;
+    }
+
+    psa_call_batch(handle, calls, IPC_TEST_BATCH_OVERSIZE);
+
+    /* The system should panic in psa_call_batch. If runs here, the test
+     * fails.
+     */
+    ret->val = TEST_FAILED;
+    psa_close(handle);
+}
+#endif
+
+#ifdef TFM_IPC_TEST_BATCH_INVALID_HANDLE
+/**
+ * \brief Submit a batch to a connection which has been closed, which is a
+ *  PROGRAMMER ERROR.
+ */
+static void tfm_ipc_test_1014(struct test_result_t *ret)
+{
+    psa_batch_call_t calls[1] = {
+        {PSA_IPC_CALL, NULL, 0, NULL, 0, IPC_TEST_BATCH_NOT_RUN},
+    };
+    psa_handle_t handle;
+
+    handle = psa_connect(IPC_SERVICE_TEST_BENCH_SID,
+                         IPC_SERVICE_TEST_BENCH_VERSION);
+    if (handle <= 0) {
+        TEST_FAIL("The RoT Service has refused the connection!\r\n");
+        return;
+    }
+    psa_close(handle);
+
+    psa_call_batch(handle, calls, 1);
+
+    /* The system should panic in psa_call_batch. If runs here, the test
+     * fails.
+     */
+    ret->val = TEST_FAILED;
+}
+#endif
+
+/**
+ * \brief Call IPC_SERVICE_TEST_BENCH with the type which maps the vectors, and
+ *  check the bytes it wrote in place and the written lengths. The second
+ *  output vector is still mapped on reply, so it is reported as empty.
+ */
+static void tfm_ipc_test_1015(struct test_result_t *ret)
+{
+    uint8_t in_buf[16] = "mapped vectors";
+    uint8_t out_buf[sizeof(in_buf) + 4];
+    uint8_t mapped_buf[8];
+    psa_invec invecs[2] = {{in_buf, sizeof(in_buf)}, {NULL, 0}};
+    psa_outvec outvecs[2] = {{out_buf, sizeof(out_buf)},
+                             {mapped_buf, sizeof(mapped_buf)}};
+    psa_handle_t handle;
+    psa_status_t status;
+    uint32_t i;
+
+    memset(mapped_buf, 0xAA, sizeof(mapped_buf));
+
+    handle = psa_connect(IPC_SERVICE_TEST_BENCH_SID,
+                         IPC_SERVICE_TEST_BENCH_VERSION);
+    if (handle <= 0) {
+        TEST_FAIL("The RoT Service has refused the connection!\r\n");
+        return;
+    }
+
+    status = psa_call(handle, IPC_BENCH_CALL_MAP, invecs, 2, outvecs, 2);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("A vector of length zero is not mapped to NULL!\r\n");
+        goto close;
+    }
+
+    if (outvecs[0].len != sizeof(in_buf)) {
+        TEST_FAIL("The length given to psa_unmap_outvec is not reported!\r\n");
+        goto close;
+    }
+
+    for (i = 0; i < sizeof(in_buf); i++) {
+        if ((out_buf[i] ^ in_buf[i]) != 0xFF) {
+            TEST_FAIL("The output vector is not written in place!\r\n");
+            goto close;
+        }
+    }
+
+    if (outvecs[1].len != 0) {
+        TEST_FAIL("A vector still mapped on reply should be empty!\r\n");
+        goto close;
+    }
+
+    for (i = 0; i < sizeof(mapped_buf); i++) {
+        if (mapped_buf[i] != 0) {
+            TEST_FAIL("The mapped output vector is not written!\r\n");
+            goto close;
+        }
+    }
+
+    ret->val = TEST_PASSED;
+
+close:
+    psa_close(handle);
+}
+
+#if defined TFM_IPC_TEST_MAP_TWICE || defined TFM_IPC_TEST_MAP_AFTER_READ \
+    || defined TFM_IPC_TEST_UNMAP_OVERSIZE || defined TFM_IPC_TEST_UNMAP_UNMAPPED
+/**
+ * \brief Call IPC_SERVICE_TEST_BENCH with a type which misuses the mapping of
+ *  the vectors, which is a PROGRAMMER ERROR of the RoT Service.
+ */
+static void ipc_test_map_misuse(int32_t type, struct test_result_t *ret)
+{
+    uint8_t in_buf[8] = "misuse";
+    uint8_t out_buf[8];
+    psa_invec invecs[1] = {{in_buf, sizeof(in_buf)}};
+    psa_outvec outvecs[1] = {{out_buf, sizeof(out_buf)}};
+    psa_handle_t handle;
+
+    handle = psa_connect(IPC_SERVICE_TEST_BENCH_SID,
+                         IPC_SERVICE_TEST_BENCH_VERSION);
+    if (handle <= 0) {
+        TEST_FAIL("The RoT Service has refused the connection!\r\n");
+        return;
+    }
+
+    psa_call(handle, type, invecs, 1, outvecs, 1);
+
+    /* The system should panic in the RoT Service. If runs here, the test
+     * fails.
+     */
+    ret->val = TEST_FAILED;
+    psa_close(handle);
+}
+#endif
+
+#ifdef TFM_IPC_TEST_MAP_TWICE
+/**
+ * \brief The RoT Service maps an input vector which is already mapped.
+ */
+static void tfm_ipc_test_1016(struct test_result_t *ret)
+{
+    ipc_test_map_misuse(IPC_BENCH_CALL_MAP_TWICE, ret);
+}
+#endif
+
+#ifdef TFM_IPC_TEST_MAP_AFTER_READ
+/**
+ * \brief The RoT Service maps an input vector it has read with psa_read.
+ */
+static void tfm_ipc_test_1017(struct test_result_t *ret)
+{
+    ipc_test_map_misuse(IPC_BENCH_CALL_MAP_AFTER_READ, ret);
+}
+#endif
+
+#ifdef TFM_IPC_TEST_UNMAP_OVERSIZE
+/**
+ * \brief The RoT Service unmaps an output vector with a length over its size.
+ */
+static void tfm_ipc_test_1018(struct test_result_t *ret)
+{
+    ipc_test_map_misuse(IPC_BENCH_CALL_UNMAP_OVERSIZE, ret);
+}
+#endif
+
+#ifdef TFM_IPC_TEST_UNMAP_UNMAPPED
+/**
+ * \brief The RoT Service unmaps an output vector it has not mapped.
+ */
+static void tfm_ipc_test_1019(struct test_result_t *ret)
+{
+    ipc_test_map_misuse(IPC_BENCH_CALL_UNMAP_UNMAPPED, ret);
+}
+#endif
+
+/**
+ * \brief Call a stateless RoT Service through its static handle, which needs
+ *  no connection. psa_close() on the static handle has no effect.
+ */
+static void tfm_ipc_test_1020(struct test_result_t *ret)
+{
+    uint8_t in_buf[16] = "stateless call";
+    uint8_t out_buf[16];
+    psa_invec invecs[1] = {{in_buf, sizeof(in_buf)}};
+    psa_outvec outvecs[1] = {{out_buf, sizeof(out_buf)}};
+    psa_status_t status;
+    uint32_t i;
+
+    if (psa_version(IPC_SERVICE_TEST_STATELESS_SID) !=
+        IPC_SERVICE_TEST_STATELESS_VERSION) {
+        TEST_FAIL("The version of the RoT Service is not reported!\r\n");
+        return;
+    }
+
+    for (i = 0; i < 2; i++) {
+        memset(out_buf, 0, sizeof(out_buf));
+        outvecs[0].len = sizeof(out_buf);
+
+        status = psa_call(IPC_SERVICE_TEST_STATELESS_HANDLE, PSA_IPC_CALL,
+                          invecs, 1, outvecs, 1);
+        if (status != PSA_SUCCESS) {
+            TEST_FAIL("psa_call on the static handle is failed!\r\n");
+            return;
+        }
+
+        if ((outvecs[0].len != sizeof(in_buf)) ||
+            (memcmp(out_buf, in_buf, sizeof(in_buf)) != 0)) {
+            TEST_FAIL("The RoT Service has not echoed the input!\r\n");
+            return;
+        }
+
+        /* The static handle stays valid */
+        psa_close(IPC_SERVICE_TEST_STATELESS_HANDLE);
+    }
+
+    ret->val = TEST_PASSED;
+}
+
+#ifdef TFM_IPC_TEST_CONNECT_STATELESS
+/**
+ * \brief Connect to a stateless RoT Service, which is a PROGRAMMER ERROR.
+ */
+static void tfm_ipc_test_1021(struct test_result_t *ret)
+{
+    psa_handle_t handle;
+
+    handle = psa_connect(IPC_SERVICE_TEST_STATELESS_SID,
+                         IPC_SERVICE_TEST_STATELESS_VERSION);
+
+    /* The system should panic in psa_connect. If runs here, the test fails.
+     */
+    ret->val = TEST_FAILED;
+    if (handle > 0) {
+        psa_close(handle);
+    }
+}
+#endif
+
+#ifdef TFM_IPC_TEST_STATIC_HANDLE_CONNECTION_BASED
+/**
+ * \brief Call a connection based RoT Service through a static handle without
+ *  connecting, which is a PROGRAMMER ERROR.
+ */
+static void tfm_ipc_test_1022(struct test_result_t *ret)
+{
+    psa_call(IPC_TEST_BENCH_STATIC_HANDLE, PSA_IPC_CALL, NULL, 0, NULL, 0);
+
+    /* The system should panic in psa_call. If runs here, the test fails. */
+    ret->val = TEST_FAILED;
+}
+#endif
+
+#ifdef TFM_PSA_ASYNC_CALL
+/**
+ * \brief Poll the result of an asynchronous call until the call is complete.
+ */
+static psa_status_t ipc_test_async_poll(psa_handle_t token,
+                                        psa_status_t *status)
+{
+    psa_status_t ret = PSA_ERROR_CONNECTION_BUSY;
+    uint32_t i;
+
+    for (i = 0; (i < IPC_TEST_ASYNC_POLLS) &&
+                (ret == PSA_ERROR_CONNECTION_BUSY); i++) {
+        ret = psa_call_async_result(token, status);
+    }
+
+    return ret;
+}
+
+/**
+ * \brief Submit asynchronous calls on an established connection and to a
+ *  stateless RoT Service, and poll their results. A result is only collected
+ *  once.
+ */
+static void tfm_ipc_test_1023(struct test_result_t *ret)
+{
+    uint8_t in_buf[16] = "async call";
+    uint8_t out_buf[16];
+    psa_invec invecs[1] = {{in_buf, sizeof(in_buf)}};
+    psa_outvec outvecs[1] = {{out_buf, sizeof(out_buf)}};
+    psa_handle_t handle;
+    psa_handle_t token = PSA_NULL_HANDLE;
+    psa_status_t status;
+    psa_status_t call_status;
+
+    handle = psa_connect(IPC_SERVICE_TEST_BENCH_SID,
+                         IPC_SERVICE_TEST_BENCH_VERSION);
+    if (handle <= 0) {
+        TEST_FAIL("The RoT Service has refused the connection!\r\n");
+        return;
+    }
+
+    status = psa_call_async_result(handle, &call_status);
+    if (status != PSA_ERROR_DOES_NOT_EXIST) {
+        TEST_FAIL("A result is reported before any call!\r\n");
+        goto close;
+    }
+
+    status = psa_call_async(handle, PSA_IPC_CALL, invecs, 1, outvecs, 1,
+                            &token);
+    if ((status != PSA_SUCCESS) || (token != handle)) {
+        TEST_FAIL("psa_call_async on the connection is failed!\r\n");
+        goto close;
+    }
+
+    status = ipc_test_async_poll(token, &call_status);
+    if ((status != PSA_SUCCESS) || (call_status != PSA_SUCCESS)) {
+        TEST_FAIL("The call on the connection has not completed!\r\n");
+        goto close;
+    }
+
+    if (outvecs[0].len != sizeof(out_buf)) {
+        TEST_FAIL("The written length is not reported!\r\n");
+        goto close;
+    }
+
+    status = psa_call_async_result(token, &call_status);
+    if (status != PSA_ERROR_DOES_NOT_EXIST) {
+        TEST_FAIL("The result is reported twice!\r\n");
+        goto close;
+    }
+
+    /* The token of a call to a stateless RoT Service is a new connection */
+    memset(out_buf, 0, sizeof(out_buf));
+    status = psa_call_async(IPC_SERVICE_TEST_STATELESS_HANDLE, PSA_IPC_CALL,
+                            invecs, 1, outvecs, 1, &token);
+    if ((status != PSA_SUCCESS) || (token <= 0)) {
+        TEST_FAIL("psa_call_async on the static handle is failed!\r\n");
+        goto close;
+    }
+
+    status = ipc_test_async_poll(token, &call_status);
+    if ((status != PSA_SUCCESS) || (call_status != PSA_SUCCESS)) {
+        TEST_FAIL("The call to the stateless service has not completed!\r\n");
+        goto close;
+    }
+
+    if ((outvecs[0].len != sizeof(in_buf)) ||
+        (memcmp(out_buf, in_buf, sizeof(in_buf)) != 0)) {
+        TEST_FAIL("The RoT Service has not echoed the input!\r\n");
+        goto close;
+    }
+
+    ret->val = TEST_PASSED;
+
+close:
+    psa_close(handle);
+}
+
+/**
+ * \brief Submit an asynchronous call which IPC_SERVICE_TEST_BENCH does not
+ *  reply until its next message. The call is reported in progress until a
+ *  call on another connection completes it.
+ */
+static void tfm_ipc_test_1024(struct test_result_t *ret)
+{
+    psa_handle_t deferred;
+    psa_handle_t handle;
+    psa_handle_t token = PSA_NULL_HANDLE;
+    psa_status_t status;
+    psa_status_t call_status;
+
+    deferred = psa_connect(IPC_SERVICE_TEST_BENCH_SID,
+                           IPC_SERVICE_TEST_BENCH_VERSION);
+    if (deferred <= 0) {
+        TEST_FAIL("The RoT Service has refused the connection!\r\n");
+        return;
+    }
+
+    handle = psa_connect(IPC_SERVICE_TEST_BENCH_SID,
+                         IPC_SERVICE_TEST_BENCH_VERSION);
+    if (handle <= 0) {
+        TEST_FAIL("The RoT Service has refused the connection!\r\n");
+        psa_close(deferred);
+        return;
+    }
+
+    status = psa_call_async(deferred, IPC_BENCH_CALL_DEFER, NULL, 0, NULL, 0,
+                            &token);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("psa_call_async is failed!\r\n");
+        goto close;
+    }
+
+    status = ipc_test_async_poll(token, &call_status);
+    if (status != PSA_ERROR_CONNECTION_BUSY) {
+        TEST_FAIL("The call is not reported in progress!\r\n");
+        goto complete;
+    }
+
+    /* The next message to the service replies the deferred call */
+    status = psa_call(handle, PSA_IPC_CALL, NULL, 0, NULL, 0);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("psa_call on the other connection is failed!\r\n");
+        goto close;
+    }
+
+    status = ipc_test_async_poll(token, &call_status);
+    if ((status != PSA_SUCCESS) || (call_status != PSA_SUCCESS)) {
+        TEST_FAIL("The deferred call has not completed!\r\n");
+        goto close;
+    }
+
+    ret->val = TEST_PASSED;
+    goto close;
+
+complete:
+    /* Complete the deferred call before its connection is closed */
+    (void)psa_call(handle, PSA_IPC_CALL, NULL, 0, NULL, 0);
+    (void)ipc_test_async_poll(token, &call_status);
+
+close:
+    psa_close(handle);
+    psa_close(deferred);
+}
+
+#ifdef TFM_IPC_TEST_ASYNC_RESULT_INVALID_HANDLE
+/**
+ * \brief Poll the result of an asynchronous call with the token of a closed
+ *  connection, which is a PROGRAMMER ERROR.
+ */
+static void tfm_ipc_test_1025(struct test_result_t *ret)
+{
+    psa_handle_t handle;
+    psa_status_t call_status;
+
+    handle = psa_connect(IPC_SERVICE_TEST_BENCH_SID,
+                         IPC_SERVICE_TEST_BENCH_VERSION);
+    if (handle <= 0) {
+        TEST_FAIL("The RoT Service has refused the connection!\r\n");
+        return;
+    }
+    psa_close(handle);
+
+    psa_call_async_result(handle, &call_status);
+
+    /* The system should panic in psa_call_async_result. If runs here, the
+     * test fails.
+     */
+    ret->val = TEST_FAILED;
+}
+#endif
+
+#ifdef TFM_IPC_TEST_ASYNC_CALL_UNFINISHED
+/**
+ * \brief Call on a connection whose asynchronous call is still in progress,
+ *  which is a PROGRAMMER ERROR.
+ */
+static void tfm_ipc_test_1026(struct test_result_t *ret)
+{
+    psa_handle_t handle;
+    psa_handle_t token;
+
+    handle = psa_connect(IPC_SERVICE_TEST_BENCH_SID,
+                         IPC_SERVICE_TEST_BENCH_VERSION);
+    if (handle <= 0) {
+        TEST_FAIL("The RoT Service has refused the connection!\r\n");
+        return;
+    }
+
+    psa_call_async(handle, IPC_BENCH_CALL_DEFER, NULL, 0, NULL, 0, &token);
+    psa_call(handle, PSA_IPC_CALL, NULL, 0, NULL, 0);
+
+    /* The system should panic in psa_call. If runs here, the test fails. */
+    ret->val = TEST_FAILED;
+    psa_close(handle);
+}
+#endif
+#endif /* TFM_PSA_ASYNC_CALL */
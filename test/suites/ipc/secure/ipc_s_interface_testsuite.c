@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -8,12 +8,24 @@
 #include "ipc_s_tests.h"
 #include "psa/client.h"
 #include "test/framework/test_framework_helpers.h"
+#ifdef TFM_SHM_CHANNELS
+#include "psa_manifest/sid.h"
+#include "secure_fw/include/tfm_spm_services_api.h"
+#include "test/test_services/tfm_ipc_service/tfm_ipc_bench.h"
+#endif
 
 /* List of tests */
 static void tfm_ipc_test_1001(struct test_result_t *ret);
+#ifdef TFM_SHM_CHANNELS
+static void tfm_ipc_test_1002(struct test_result_t *ret);
+#endif
 
 static struct test_t ipc_veneers_tests[] = {
     {&tfm_ipc_test_1001, "TFM_IPC_TEST_1001", "Secure functional", {0} },
+#ifdef TFM_SHM_CHANNELS
+    {&tfm_ipc_test_1002, "TFM_IPC_TEST_1002",
+     "Shared memory channel between two partitions", {0} },
+#endif
 };
 
 void register_testsuite_s_ipc_interface(struct test_suite_t *p_test_suite)
@@ -37,3 +49,70 @@ static void tfm_ipc_test_1001(struct test_result_t *ret)
 {
     ret->val = TEST_PASSED;
 }
+
+#ifdef TFM_SHM_CHANNELS
+/**
+ * \brief Tests tfm_shm_get() with the IPC_SERVICE_TEST channel, of which the
+ *        IPC service test partition is the producer and this partition the
+ *        consumer.
+ *
+ * \note The data written by each side must be seen by the other one, and the
+ *       IDs out of the list must be rejected.
+ */
+static void tfm_ipc_test_1002(struct test_result_t *ret)
+{
+    psa_handle_t handle;
+    psa_status_t status;
+    uint8_t *buf;
+    uint32_t i;
+
+    buf = tfm_shm_get(IPC_SERVICE_TEST_SHM_ID);
+    if (buf == NULL) {
+        TEST_FAIL("The consumer should get the buffer of the channel");
+        return;
+    }
+
+    if (tfm_shm_get(IPC_SERVICE_TEST_SHM_ID) != buf) {
+        TEST_FAIL("The buffer of a channel should not move");
+        return;
+    }
+
+    if (tfm_shm_get(TFM_SHM_NUM) != NULL) {
+        TEST_FAIL("An ID past the last channel should be rejected");
+        return;
+    }
+
+    if (tfm_shm_get(UINT32_MAX) != NULL) {
+        TEST_FAIL("An invalid ID should be rejected");
+        return;
+    }
+
+    for (i = 0; i < IPC_SERVICE_TEST_SHM_SIZE; i++) {
+        buf[i] = (uint8_t)i;
+    }
+
+    handle = psa_connect(IPC_SERVICE_TEST_BENCH_SID,
+                         IPC_SERVICE_TEST_BENCH_VERSION);
+    if (handle <= 0) {
+        TEST_FAIL("Connection to the producer failed");
+        return;
+    }
+
+    /* The producer inverts each byte of the buffer in place */
+    status = psa_call(handle, IPC_BENCH_CALL_SHM, NULL, 0, NULL, 0);
+    psa_close(handle);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("The producer should get the buffer of the channel");
+        return;
+    }
+
+    for (i = 0; i < IPC_SERVICE_TEST_SHM_SIZE; i++) {
+        if (buf[i] != (uint8_t)~i) {
+            TEST_FAIL("The data of the producer should be in the buffer");
+            return;
+        }
+    }
+
+    ret->val = TEST_PASSED;
+}
+#endif /* TFM_SHM_CHANNELS */
@@ -18,6 +18,9 @@
 #endif
 
 #define TEST_019_CYCLES    3U
+#define TEST_020_UIDS      3U
+/* Batch size which lists all the UIDs of test 020 in a single call */
+#define TEST_020_FULL_SIZE (TEST_020_UIDS + 2U)
 
 static const uint8_t write_asset_data[ITS_MAX_ASSET_SIZE] = {0xBF};
 static uint8_t read_asset_data[ITS_MAX_ASSET_SIZE] = {0};
@@ -1044,3 +1047,164 @@ void tfm_its_test_common_019(struct test_result_t *ret)
 
     ret->val = TEST_PASSED;
 }
+
+/**
+ * \brief Lists the UIDs of the caller in batches of \p batch_size, and checks
+ *        that each of \p uids is listed exactly once and that no other UID
+ *        than WRITE_ONCE_UID, which may have been set by a previous test, is
+ *        listed. A batch with fewer UIDs than \p batch_size must be the last.
+ *
+ * \param[in]  uids        UIDs expected to be listed
+ * \param[in]  uid_count   Number of UIDs in \p uids
+ * \param[in]  batch_size  Number of UIDs listed by each call, up to
+ *                         TEST_020_FULL_SIZE
+ * \param[out] calls       Number of calls made to list all the UIDs
+ * \param[out] ret         Test result
+ *
+ * \return 0 if the UIDs are listed as expected, 1 otherwise
+ */
+static uint32_t its_test_list_check(const psa_storage_uid_t *uids,
+                                    size_t uid_count, size_t batch_size,
+                                    uint32_t *calls,
+                                    struct test_result_t *ret)
+{
+    psa_status_t status;
+    psa_storage_uid_t listed[TEST_020_FULL_SIZE];
+    uint32_t seen[TEST_020_UIDS] = {0};
+    uint32_t cursor = TFM_STORAGE_LIST_START;
+    size_t count;
+    size_t i, j;
+
+    *calls = 0;
+
+    while (cursor != TFM_STORAGE_LIST_END) {
+        /* Each asset is listed at most once, so the enumeration must end */
+        if (*calls > TEST_020_FULL_SIZE) {
+            TEST_FAIL("List should reach the end of the UIDs");
+            return 1;
+        }
+
+        status = psa_its_list(&cursor, listed, batch_size, &count);
+        (*calls)++;
+        if (status != PSA_SUCCESS) {
+            TEST_FAIL("List should not fail");
+            return 1;
+        }
+
+        if (count > batch_size) {
+            TEST_FAIL("List should not overflow the batch");
+            return 1;
+        }
+
+        if ((count < batch_size) && (cursor != TFM_STORAGE_LIST_END)) {
+            TEST_FAIL("A partial batch should end the enumeration");
+            return 1;
+        }
+
+        for (i = 0; i < count; i++) {
+            for (j = 0; j < uid_count; j++) {
+                if (listed[i] == uids[j]) {
+                    seen[j]++;
+                    break;
+                }
+            }
+
+            if ((j == uid_count) && (listed[i] != WRITE_ONCE_UID)) {
+                TEST_FAIL("List should only return the UIDs set");
+                return 1;
+            }
+        }
+    }
+
+    for (j = 0; j < uid_count; j++) {
+        if (seen[j] != 1) {
+            TEST_FAIL("Each UID set should be listed exactly once");
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+void tfm_its_test_common_020(struct test_result_t *ret)
+{
+    psa_status_t status;
+    const psa_storage_uid_t test_uid[TEST_020_UIDS] = {
+        TEST_UID_1,
+        TEST_UID_2,
+        TEST_UID_3};
+    const psa_storage_uid_t remaining_uid[TEST_020_UIDS - 1] = {
+        TEST_UID_1,
+        TEST_UID_3};
+    psa_storage_uid_t listed[1];
+    uint32_t cursor = TFM_STORAGE_LIST_END;
+    uint32_t calls;
+    size_t count = 1;
+    uint32_t i;
+
+    /* Listing from the end cursor returns no UID */
+    status = psa_its_list(&cursor, listed, 1, &count);
+    if ((status != PSA_SUCCESS) || (count != 0) ||
+        (cursor != TFM_STORAGE_LIST_END)) {
+        TEST_FAIL("List should return no UID from the end cursor");
+        return;
+    }
+
+    /* Empty storage, apart from the write once UID */
+    if (its_test_list_check(test_uid, 0, 1, &calls, ret) != 0) {
+        return;
+    }
+
+    for (i = 0; i < TEST_020_UIDS; i++) {
+        status = psa_its_set(test_uid[i], WRITE_DATA_SIZE, WRITE_DATA,
+                             PSA_STORAGE_FLAG_NONE);
+        if (status != PSA_SUCCESS) {
+            TEST_FAIL("Set should not fail with valid UID");
+            return;
+        }
+    }
+
+    /* Partial batches, which need several calls */
+    if (its_test_list_check(test_uid, TEST_020_UIDS, 2, &calls, ret) != 0) {
+        return;
+    }
+
+    if (calls < 2) {
+        TEST_FAIL("List should need several calls with partial batches");
+        return;
+    }
+
+    /* A batch which holds all the UIDs */
+    if (its_test_list_check(test_uid, TEST_020_UIDS, TEST_020_FULL_SIZE,
+                            &calls, ret) != 0) {
+        return;
+    }
+
+    if (calls != 1) {
+        TEST_FAIL("List should return all the UIDs in a single call");
+        return;
+    }
+
+    /* A removed UID is not listed anymore */
+    status = psa_its_remove(TEST_UID_2);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Remove should not fail with valid UID");
+        return;
+    }
+
+    if (its_test_list_check(remaining_uid, TEST_020_UIDS - 1, 1, &calls,
+                            ret) != 0) {
+        return;
+    }
+
+    /* Call remove to clean up storage for the next test */
+    for (i = 0; i < TEST_020_UIDS - 1; i++) {
+        status = psa_its_remove(remaining_uid[i]);
+        if (status != PSA_SUCCESS) {
+            TEST_FAIL("Remove should not fail with valid UID");
+            return;
+        }
+    }
+
+    ret->val = TEST_PASSED;
+}
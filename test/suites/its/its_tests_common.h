@@ -230,6 +230,17 @@ void tfm_its_test_common_018(struct test_result_t *ret);
  */
 void tfm_its_test_common_019(struct test_result_t *ret);
 
+/**
+ * \brief Tests list function with:
+ *        - No UID set
+ *        - Batches which hold part of the UIDs set
+ *        - A batch which holds all the UIDs set
+ *        - A UID removed
+ *
+ * \param[out] ret  Test result
+ */
+void tfm_its_test_common_020(struct test_result_t *ret);
+
 #ifdef __cplusplus
 }
 #endif
@@ -30,6 +30,15 @@ void register_testsuite_s_psa_its_interface(struct test_suite_t *p_test_suite);
 void register_testsuite_s_psa_its_reliability(struct test_suite_t
                                                                  *p_test_suite);
 
+#ifdef ENABLE_STORAGE_BENCHMARK_TESTS
+/**
+ * \brief Register testsuite for the ITS secure benchmark.
+ *
+ * \param[in] p_test_suite  The test suite to be executed.
+ */
+void register_testsuite_s_psa_its_benchmark(struct test_suite_t *p_test_suite);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
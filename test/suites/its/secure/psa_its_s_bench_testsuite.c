@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include "its_s_tests.h"
+#include "psa/internal_trusted_storage.h"
+#include "test/framework/test_framework_helpers.h"
+#include "flash_layout.h"
+#include "../storage_bench_common.h"
+
+static const struct storage_bench_api_t its_bench_api = {
+    .name = "ITS",
+    .set = psa_its_set,
+    .get = psa_its_get,
+    .remove = psa_its_remove,
+    .flash_id = ITS_FLASH_ID_INTERNAL,
+    .max_size = ITS_MAX_ASSET_SIZE,
+    .num_assets = ITS_NUM_ASSETS,
+};
+
+/* List of tests */
+static void tfm_its_test_5001(struct test_result_t *ret);
+static void tfm_its_test_5002(struct test_result_t *ret);
+
+static struct test_t its_bench_tests[] = {
+    {&tfm_its_test_5001, "TFM_ITS_TEST_5001",
+     "ITS create, set, get and remove benchmark by asset size", {0} },
+    {&tfm_its_test_5002, "TFM_ITS_TEST_5002",
+     "ITS create, set, get and remove benchmark by fill level", {0} },
+};
+
+void register_testsuite_s_psa_its_benchmark(struct test_suite_t *p_test_suite)
+{
+    uint32_t list_size = (sizeof(its_bench_tests) /
+                          sizeof(its_bench_tests[0]));
+
+    set_testsuite("ITS secure benchmark (TFM_ITS_TEST_5XXX)",
+                  its_bench_tests, list_size, p_test_suite);
+}
+
+/**
+ * \brief Secure benchmark for ITS
+ *
+ * \details The scope of this set of tests is to measure the cycles and the
+ *          flash operations taken by the operations of
+ *          psa/internal_trusted_storage.h. The results are printed as BENCH
+ *          lines, described in storage_bench_common.c, which can be collected
+ *          from the test log.
+ *
+ */
+static void tfm_its_test_5001(struct test_result_t *ret)
+{
+    storage_bench_size_test(&its_bench_api, ret);
+}
+
+static void tfm_its_test_5002(struct test_result_t *ret)
+{
+    storage_bench_fill_test(&its_bench_api, ret);
+}
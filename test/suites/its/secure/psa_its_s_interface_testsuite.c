@@ -68,6 +68,8 @@ static struct test_t psa_its_s_tests[] = {
      "Get info interface with NULL info pointer"},
     {&tfm_its_test_2023, "TFM_ITS_TEST_2023",
      "Attempt to get a UID set by a different partition"},
+    {&tfm_its_test_common_020, "TFM_ITS_TEST_2024",
+     "List interface"},
 };
 
 void register_testsuite_s_psa_its_interface(struct test_suite_t *p_test_suite)
@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdint.h>
+#include "tfm_memory_utils.h"
+#include "storage_bench_common.h"
+
+/* Fields of each line of the benchmark, after the BENCH tag:
+ *  - the measured service, ITS or SST
+ *  - the measured operation: create, set (update of an existing asset), get
+ *    or remove
+ *  - the size of the asset in bytes
+ *  - the number of other assets in the storage
+ *  - the cycles taken by the operation
+ *  - the number of flash reads and of bytes read
+ *  - the number of flash programs and of bytes programmed
+ *  - the number of erased flash blocks
+ *  - the write amplification, that is the bytes programmed divided by the
+ *    size of the asset, with two decimals, or - for the operations which do
+ *    not write the asset
+ */
+#define BENCH_FIELDS "service,operation,bytes,fill,cycles,reads," \
+                     "read_bytes,programs,program_bytes,erases,wa"
+
+/* UIDs of the measured asset and of the assets which fill the storage, chosen
+ * away from the UIDs used by the other storage tests.
+ */
+#define BENCH_UID      0x5B00UL
+#define BENCH_FILL_UID 0x5C00UL
+
+enum bench_op_t {
+    BENCH_OP_CREATE = 0,
+    BENCH_OP_SET,
+    BENCH_OP_GET,
+    BENCH_OP_REMOVE,
+    BENCH_OP_NUM,
+};
+
+static const char *const bench_op_names[BENCH_OP_NUM] = {
+    [BENCH_OP_CREATE] = "create",
+    [BENCH_OP_SET] = "set",
+    [BENCH_OP_GET] = "get",
+    [BENCH_OP_REMOVE] = "remove",
+};
+
+/* Sizes smaller than the maximum asset size of the service are measured,
+ * followed by the maximum asset size.
+ */
+static const uint32_t bench_sizes[] = {16, 64, 256, 1024, 4096};
+
+/* Fill levels, in percent of the maximum number of assets which leaves room
+ * for the measured asset.
+ */
+static const uint32_t bench_fill_levels[] = {0, 25, 50, 75, 100};
+
+/* The update writes the input from its second byte, to change the data */
+static uint8_t bench_in[STORAGE_BENCH_MAX_SIZE + 1];
+static uint8_t bench_out[STORAGE_BENCH_MAX_SIZE];
+
+static uint32_t bench_header_printed;
+
+/*!
+ * \struct bench_result_t
+ *
+ * \brief Cycles and flash operations of a measured operation, summed over the
+ *        repetitions.
+ */
+struct bench_result_t {
+    uint32_t cycles;                /*!< Cycles taken */
+    struct its_flash_stats_t flash; /*!< Flash operations done */
+};
+
+#ifdef ITS_FLASH_STATS
+static void bench_flash_reset(enum its_flash_id_t flash_id)
+{
+    its_flash_reset_stats(flash_id);
+}
+
+static void bench_flash_add(enum its_flash_id_t flash_id,
+                            struct its_flash_stats_t *sum)
+{
+    struct its_flash_stats_t stats;
+
+    its_flash_get_stats(flash_id, &stats);
+
+    sum->reads += stats.reads;
+    sum->read_bytes += stats.read_bytes;
+    sum->programs += stats.programs;
+    sum->program_bytes += stats.program_bytes;
+    sum->erases += stats.erases;
+}
+#else
+static void bench_flash_reset(enum its_flash_id_t flash_id)
+{
+    (void)flash_id;
+}
+
+static void bench_flash_add(enum its_flash_id_t flash_id,
+                            struct its_flash_stats_t *sum)
+{
+    /* The flash operations are not counted by the ITS partition */
+    (void)flash_id;
+    (void)sum;
+}
+#endif /* ITS_FLASH_STATS */
+
+static void bench_start(void)
+{
+    uint32_t i;
+
+    if (!bench_header_printed) {
+        /* Without a cycle counter, only the flash operations are measured */
+        if (test_timer_start() != 0) {
+            TEST_LOG("No cycle counter, the cycles are reported as 0.\r\n");
+        }
+#ifndef ITS_FLASH_STATS
+        TEST_LOG("ITS_FLASH_STATS is disabled, the flash operations are "
+                 "reported as 0.\r\n");
+#endif
+        bench_log_header(BENCH_FIELDS);
+        bench_header_printed = 1;
+    }
+
+    for (i = 0; i < sizeof(bench_in); i++) {
+        bench_in[i] = (uint8_t)i;
+    }
+}
+
+/**
+ * \brief Prints one benchmark line, with the average of the repetitions and
+ *        the write amplification in hundredths.
+ */
+static void bench_log(const struct storage_bench_api_t *api,
+                      enum bench_op_t op, uint32_t bytes, uint32_t fill,
+                      const struct bench_result_t *res)
+{
+    uint32_t program_bytes = res->flash.program_bytes / STORAGE_BENCH_LOOPS;
+    uint32_t wa;
+
+    TEST_LOG("BENCH,%s,%s,%u,%u,%u,%u,%u,%u,%u,%u,", api->name,
+             bench_op_names[op], (unsigned int)bytes, (unsigned int)fill,
+             (unsigned int)(res->cycles / STORAGE_BENCH_LOOPS),
+             (unsigned int)(res->flash.reads / STORAGE_BENCH_LOOPS),
+             (unsigned int)(res->flash.read_bytes / STORAGE_BENCH_LOOPS),
+             (unsigned int)(res->flash.programs / STORAGE_BENCH_LOOPS),
+             (unsigned int)program_bytes,
+             (unsigned int)(res->flash.erases / STORAGE_BENCH_LOOPS));
+
+    if (((op != BENCH_OP_CREATE) && (op != BENCH_OP_SET)) || (bytes == 0)) {
+        TEST_LOG("-\r\n");
+    } else {
+        wa = (uint32_t)(((uint64_t)program_bytes * 100) / bytes);
+        bench_log_hundredths(wa, "\r\n");
+    }
+}
+
+/**
+ * \brief Measures the creation, the update, the read and the removal of an
+ *        asset, and prints the results.
+ *
+ * \param[in] api   Storage service to measure
+ * \param[in] size  Size of the asset
+ * \param[in] fill  Number of other assets in the storage
+ *
+ * \return Returns PSA_SUCCESS if the operations succeeded, or the status of
+ *         the failed operation
+ */
+static psa_status_t bench_asset(const struct storage_bench_api_t *api,
+                                uint32_t size, uint32_t fill)
+{
+    struct bench_result_t res[BENCH_OP_NUM] = {0};
+    psa_status_t status;
+    size_t data_len;
+    uint32_t start;
+    uint32_t i;
+
+    for (i = 0; i < STORAGE_BENCH_LOOPS; i++) {
+        bench_flash_reset(api->flash_id);
+        start = test_timer_read();
+        status = api->set(BENCH_UID, size, bench_in, PSA_STORAGE_FLAG_NONE);
+        res[BENCH_OP_CREATE].cycles += test_timer_read() - start;
+        bench_flash_add(api->flash_id, &res[BENCH_OP_CREATE].flash);
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+
+        bench_flash_reset(api->flash_id);
+        start = test_timer_read();
+        status = api->set(BENCH_UID, size, &bench_in[1], PSA_STORAGE_FLAG_NONE);
+        res[BENCH_OP_SET].cycles += test_timer_read() - start;
+        bench_flash_add(api->flash_id, &res[BENCH_OP_SET].flash);
+        if (status != PSA_SUCCESS) {
+            (void)api->remove(BENCH_UID);
+            return status;
+        }
+
+        bench_flash_reset(api->flash_id);
+        start = test_timer_read();
+        status = api->get(BENCH_UID, 0, size, bench_out, &data_len);
+        res[BENCH_OP_GET].cycles += test_timer_read() - start;
+        bench_flash_add(api->flash_id, &res[BENCH_OP_GET].flash);
+        if ((status == PSA_SUCCESS) &&
+            ((data_len != size) ||
+             (tfm_memcmp(bench_out, &bench_in[1], size) != 0))) {
+            status = PSA_ERROR_GENERIC_ERROR;
+        }
+        if (status != PSA_SUCCESS) {
+            (void)api->remove(BENCH_UID);
+            return status;
+        }
+
+        bench_flash_reset(api->flash_id);
+        start = test_timer_read();
+        status = api->remove(BENCH_UID);
+        res[BENCH_OP_REMOVE].cycles += test_timer_read() - start;
+        bench_flash_add(api->flash_id, &res[BENCH_OP_REMOVE].flash);
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+    }
+
+    for (i = 0; i < BENCH_OP_NUM; i++) {
+        bench_log(api, (enum bench_op_t)i, size, fill, &res[i]);
+    }
+
+    return PSA_SUCCESS;
+}
+
+void storage_bench_size_test(const struct storage_bench_api_t *api,
+                             struct test_result_t *ret)
+{
+    uint32_t max_size = api->max_size;
+    uint32_t i;
+
+    if (max_size > STORAGE_BENCH_MAX_SIZE) {
+        max_size = STORAGE_BENCH_MAX_SIZE;
+    }
+
+    bench_start();
+
+    for (i = 0; i < sizeof(bench_sizes) / sizeof(bench_sizes[0]); i++) {
+        if (bench_sizes[i] >= max_size) {
+            break;
+        }
+
+        if (bench_asset(api, bench_sizes[i], 0) != PSA_SUCCESS) {
+            TEST_FAIL("Error measuring the operations on an asset");
+            return;
+        }
+    }
+
+    if (bench_asset(api, max_size, 0) != PSA_SUCCESS) {
+        TEST_FAIL("Error measuring the operations on the largest asset");
+        return;
+    }
+
+    ret->val = TEST_PASSED;
+}
+
+void storage_bench_fill_test(const struct storage_bench_api_t *api,
+                             struct test_result_t *ret)
+{
+    psa_status_t status = PSA_SUCCESS;
+    uint32_t filled = 0;
+    uint32_t level;
+    uint32_t i;
+
+    bench_start();
+
+    ret->val = TEST_PASSED;
+
+    for (i = 0; i < sizeof(bench_fill_levels) / sizeof(bench_fill_levels[0]);
+         i++) {
+        level = ((api->num_assets - 1) * bench_fill_levels[i]) / 100;
+
+        while (filled < level) {
+            status = api->set(BENCH_FILL_UID + filled, STORAGE_BENCH_FILL_SIZE,
+                              bench_in, PSA_STORAGE_FLAG_NONE);
+            if (status != PSA_SUCCESS) {
+                break;
+            }
+            filled++;
+        }
+
+        if (status == PSA_SUCCESS) {
+            status = bench_asset(api, STORAGE_BENCH_FILL_SIZE, filled);
+        }
+
+        if (status == PSA_ERROR_INSUFFICIENT_STORAGE) {
+            /* The assets left by the other test suites take part of the
+             * storage, so the highest levels may not be reachable.
+             */
+            TEST_LOG("BENCH,%s,fill,%u,skipped,%d\r\n", api->name,
+                     (unsigned int)level, (int)status);
+            break;
+        } else if (status != PSA_SUCCESS) {
+            TEST_FAIL("Error measuring the operations on a filled storage");
+            break;
+        }
+    }
+
+    /* Remove the assets which filled the storage */
+    while (filled > 0) {
+        filled--;
+        if (api->remove(BENCH_FILL_UID + filled) != PSA_SUCCESS) {
+            TEST_FAIL("Error removing the assets which filled the storage");
+        }
+    }
+}
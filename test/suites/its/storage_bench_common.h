@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __STORAGE_BENCH_COMMON_H__
+#define __STORAGE_BENCH_COMMON_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "psa/error.h"
+#include "psa/storage_common.h"
+#include "secure_fw/services/internal_trusted_storage/flash/its_flash.h"
+#include "test/framework/test_framework_helpers.h"
+
+/**
+ * \brief Number of times each measured operation is repeated, the reported
+ *        cycles and flash operations are the average of the repetitions
+ *
+ */
+#ifndef STORAGE_BENCH_LOOPS
+#define STORAGE_BENCH_LOOPS (4)
+#endif
+
+/**
+ * \brief Size in bytes of the assets which fill the storage before the
+ *        operations are measured at each fill level
+ *
+ */
+#ifndef STORAGE_BENCH_FILL_SIZE
+#define STORAGE_BENCH_FILL_SIZE (64)
+#endif
+
+/**
+ * \brief Largest asset size in bytes measured by the benchmark
+ *
+ */
+#ifndef STORAGE_BENCH_MAX_SIZE
+#define STORAGE_BENCH_MAX_SIZE ITS_UTILS_MAX(ITS_MAX_ASSET_SIZE, \
+                                             SST_MAX_ASSET_SIZE)
+#endif
+
+/**
+ * \struct storage_bench_api_t
+ *
+ * \brief Storage service measured by the benchmark.
+ */
+struct storage_bench_api_t {
+    const char *name;             /*!< Name of the service, printed in each
+                                   *   line
+                                   */
+    psa_status_t (*set)(psa_storage_uid_t uid, size_t data_length,
+                        const void *p_data,
+                        psa_storage_create_flags_t create_flags);
+                                  /*!< Set function of the service */
+    psa_status_t (*get)(psa_storage_uid_t uid, size_t data_offset,
+                        size_t data_size, void *p_data,
+                        size_t *p_data_length);
+                                  /*!< Get function of the service */
+    psa_status_t (*remove)(psa_storage_uid_t uid);
+                                  /*!< Remove function of the service */
+    enum its_flash_id_t flash_id; /*!< Flash device which stores the assets */
+    uint32_t max_size;            /*!< Maximum size of an asset */
+    uint32_t num_assets;          /*!< Maximum number of assets */
+};
+
+/**
+ * \brief Measures the creation, the update, the read and the removal of an
+ *        asset for each asset size, in an otherwise empty storage
+ *
+ * \param[in]  api  Storage service to measure
+ * \param[out] ret  Test result
+ *
+ */
+void storage_bench_size_test(const struct storage_bench_api_t *api,
+                             struct test_result_t *ret);
+
+/**
+ * \brief Measures the creation, the update, the read and the removal of an
+ *        asset of \ref STORAGE_BENCH_FILL_SIZE bytes after the storage has
+ *        been filled with other assets, for several fill levels up to the
+ *        maximum number of assets
+ *
+ * \param[in]  api  Storage service to measure
+ * \param[out] ret  Test result
+ *
+ */
+void storage_bench_fill_test(const struct storage_bench_api_t *api,
+                             struct test_result_t *ret);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __STORAGE_BENCH_COMMON_H__ */
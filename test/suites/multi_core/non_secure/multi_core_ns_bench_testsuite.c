@@ -0,0 +1,354 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "multi_core_ns_test.h"
+#include "os_wrapper/mutex.h"
+#include "os_wrapper/thread.h"
+#include "psa/client.h"
+#include "psa/internal_trusted_storage.h"
+#include "psa_manifest/sid.h"
+#include "test/framework/test_framework_helpers.h"
+#include "tfm_ns_mailbox.h"
+
+/* Number of NS threads issuing PSA client calls at the same time */
+#ifndef MULTI_CORE_BENCH_NR_THREADS
+#define MULTI_CORE_BENCH_NR_THREADS          (NUM_MAILBOX_QUEUE_SLOT * 2)
+#endif
+
+/* Number of rounds of each thread. A round is one operation of the mix. */
+#ifndef MULTI_CORE_BENCH_NR_ROUNDS
+#define MULTI_CORE_BENCH_NR_ROUNDS           0x40
+#endif
+
+/*
+ * NS OS ticks each thread sleeps between two rounds, which sets the offered
+ * load. 0 issues the rounds back to back, to measure the saturation
+ * throughput.
+ */
+#ifndef MULTI_CORE_BENCH_INTERVAL
+#define MULTI_CORE_BENCH_INTERVAL            0
+#endif
+
+#ifndef MULTI_CORE_BENCH_STACK_SIZE
+#define MULTI_CORE_BENCH_STACK_SIZE          0x300
+#endif
+
+#if (MULTI_CORE_BENCH_NR_THREADS > 30)
+#error "Error: MULTI_CORE_BENCH_NR_THREADS should be no more than 30"
+#endif
+
+/* The event flag to start a thread */
+#define BENCH_START_FLAG(x)                  (uint32_t)(0x1UL << (x))
+
+/*
+ * The event flag a thread waits for to sleep between two rounds. It is never
+ * set, the wait always times out. It does not collide with the mailbox
+ * message handles, which threads wait for as flags too.
+ */
+#define BENCH_PACE_FLAG                      (uint32_t)(0x1UL << 30)
+
+/* UIDs of the assets written by the threads, one per thread */
+#define BENCH_UID_BASE                       0x100U
+#define BENCH_ITS_DATA                       "ITSDataForMailboxBench"
+#define BENCH_ITS_DATA_LEN                   sizeof(BENCH_ITS_DATA)
+
+/* Number of operations in the mix of PSA client calls */
+#define BENCH_NR_OPS                         4
+
+/* Each line of the benchmark has the following comma separated fields, the
+ * latencies and durations being in ticks of the timer shared with SPE:
+ *  - the BENCH tag, to pick the lines out of the test log
+ *  - the number of threads, of mailbox queue slots, and the sleep interval of
+ *    the threads in NS OS ticks
+ *  - the PSA client call type, or total for the whole run
+ *  - for a call type: the number of calls, their average round-trip latency,
+ *    the 50th and 99th percentiles, which are upper bounds of power of two
+ *    histogram bins, and the maximum
+ *  - for the total: the number of calls, the duration of the run, the
+ *    throughput in calls per thousand ticks, and the number of requests which
+ *    waited for a free queue slot, in total and per thousand requests
+ */
+#define BENCH_CALL_HEADER  "BENCH,threads,slots,interval,call,calls,avg,p50," \
+                           "p99,max\r\n"
+#define BENCH_TOTAL_HEADER "BENCH,threads,slots,interval,total,calls,ticks," \
+                           "calls_per_kticks,queue_waits,queue_waits_permille\r\n"
+
+/* Names of the call types, indexed by call type - 1 */
+static const char * const bench_call_names[MAILBOX_STATS_NR_CALL_TYPES] = {
+    "psa_framework_version",
+    "psa_version",
+    "psa_connect",
+    "psa_call",
+    "psa_close",
+#ifdef TFM_MAILBOX_SG
+    "psa_call_sg",
+#endif
+};
+
+/* Structure passed to the benchmark threads */
+struct bench_params {
+    uint32_t idx;                   /* The index of the thread */
+    void *mutex_handle;             /* Mutex to protect is_complete flag */
+    enum test_status_t ret;         /* The result of the thread */
+    bool is_complete;               /* Whether the thread completes */
+};
+
+/* List of tests */
+static void multi_core_bench_test_1(struct test_result_t *ret);
+
+static struct test_t multi_core_bench_tests[] = {
+    {&multi_core_bench_test_1,
+     "MULTI_CORE_BENCH_TEST_1",
+     "Mailbox throughput and latency under concurrent NS PSA client calls",
+     {0}},
+};
+
+void register_testsuite_multi_core_ns_benchmark(
+                                              struct test_suite_t *p_test_suite)
+{
+    uint32_t list_size;
+
+    list_size = (sizeof(multi_core_bench_tests) /
+                 sizeof(multi_core_bench_tests[0]));
+
+    set_testsuite("TF-M benchmark for multi-core topology",
+                  multi_core_bench_tests, list_size, p_test_suite);
+}
+
+/**
+ * \brief Runs one operation of the mix. Each operation issues from 1 to 9
+ *        PSA client calls, from a lightweight version query to the writing
+ *        of an ITS asset.
+ */
+static enum test_status_t bench_op(uint32_t op, uint32_t idx)
+{
+    psa_handle_t handle;
+    psa_status_t status;
+    uint32_t nr_calls;
+    struct psa_outvec outvec = {&nr_calls, sizeof(nr_calls)};
+    const psa_storage_uid_t uid = BENCH_UID_BASE + idx;
+    char rd_data[BENCH_ITS_DATA_LEN];
+    size_t rd_data_len;
+
+    switch (op) {
+    case 0:
+        if (psa_framework_version() != PSA_FRAMEWORK_VERSION) {
+            return TEST_FAILED;
+        }
+        break;
+    case 1:
+        if (psa_version(MULTI_CORE_MULTI_CLIENT_CALL_TEST_0_SID) ==
+            PSA_VERSION_NONE) {
+            return TEST_FAILED;
+        }
+        break;
+    case 2:
+        handle = psa_connect(MULTI_CORE_MULTI_CLIENT_CALL_TEST_1_SID,
+                             MULTI_CORE_MULTI_CLIENT_CALL_TEST_1_VERSION);
+        if (handle <= 0) {
+            return TEST_FAILED;
+        }
+        status = psa_call(handle, PSA_IPC_CALL, NULL, 0, &outvec, 1);
+        psa_close(handle);
+        if (status < 0) {
+            return TEST_FAILED;
+        }
+        break;
+    default:
+        if (psa_its_set(uid, BENCH_ITS_DATA_LEN, BENCH_ITS_DATA,
+                        PSA_STORAGE_FLAG_NONE) != PSA_SUCCESS) {
+            return TEST_FAILED;
+        }
+        if (psa_its_get(uid, 0, BENCH_ITS_DATA_LEN, rd_data,
+                        &rd_data_len) != PSA_SUCCESS) {
+            return TEST_FAILED;
+        }
+        if (psa_its_remove(uid) != PSA_SUCCESS) {
+            return TEST_FAILED;
+        }
+        break;
+    }
+
+    return TEST_PASSED;
+}
+
+static void bench_runner(void *argument)
+{
+    struct bench_params *params = (struct bench_params *)argument;
+    uint32_t i;
+
+    /* Wait for the signal to kick-off the benchmark */
+    os_wrapper_thread_wait_flag(BENCH_START_FLAG(params->idx),
+                                OS_WRAPPER_WAIT_FOREVER);
+
+    params->ret = TEST_PASSED;
+    for (i = 0; i < MULTI_CORE_BENCH_NR_ROUNDS; i++) {
+        /* Shift the mix of each thread, to keep every operation in flight */
+        params->ret = bench_op((params->idx + i) % BENCH_NR_OPS, params->idx);
+        if (params->ret != TEST_PASSED) {
+            break;
+        }
+
+        if (MULTI_CORE_BENCH_INTERVAL != 0) {
+            os_wrapper_thread_wait_flag(BENCH_PACE_FLAG,
+                                        MULTI_CORE_BENCH_INTERVAL);
+        }
+    }
+
+    /* Mark this thread has completed */
+    os_wrapper_mutex_acquire(params->mutex_handle, OS_WRAPPER_WAIT_FOREVER);
+    params->is_complete = true;
+    os_wrapper_mutex_release(params->mutex_handle);
+}
+
+static void bench_wait_completion(struct bench_params *params,
+                                  uint32_t nr_threads)
+{
+    bool is_complete;
+    uint32_t i;
+
+    for (i = 0; i < nr_threads; i++) {
+        while (1) {
+            os_wrapper_mutex_acquire(params[i].mutex_handle,
+                                     OS_WRAPPER_WAIT_FOREVER);
+            is_complete = params[i].is_complete;
+            os_wrapper_mutex_release(params[i].mutex_handle);
+
+            if (is_complete) {
+                break;
+            }
+        }
+    }
+}
+
+static void bench_log(const struct ns_mailbox_stats_t *stats, uint32_t ticks)
+{
+    const struct ns_mailbox_call_stats_t *call;
+    uint32_t calls = 0;
+    uint32_t i;
+
+    TEST_LOG(BENCH_CALL_HEADER);
+    for (i = 0; i < MAILBOX_STATS_NR_CALL_TYPES; i++) {
+        call = &stats->call[i];
+        if (call->round_trip.nr == 0) {
+            continue;
+        }
+        calls += call->round_trip.nr;
+
+        TEST_LOG("BENCH,%d,%d,%d,%s,%u,%u,%u,%u,%u\r\n",
+                 MULTI_CORE_BENCH_NR_THREADS, NUM_MAILBOX_QUEUE_SLOT,
+                 MULTI_CORE_BENCH_INTERVAL, bench_call_names[i],
+                 (unsigned int)call->round_trip.nr,
+                 (unsigned int)(call->round_trip.total / call->round_trip.nr),
+                 (unsigned int)tfm_ns_mailbox_stats_percentile(call, 50),
+                 (unsigned int)tfm_ns_mailbox_stats_percentile(call, 99),
+                 (unsigned int)call->round_trip.max);
+    }
+
+    TEST_LOG(BENCH_TOTAL_HEADER);
+    TEST_LOG("BENCH,%d,%d,%d,total,%u,%u,%u,%u,%u\r\n",
+             MULTI_CORE_BENCH_NR_THREADS, NUM_MAILBOX_QUEUE_SLOT,
+             MULTI_CORE_BENCH_INTERVAL, (unsigned int)calls,
+             (unsigned int)ticks,
+             (unsigned int)(ticks ? ((uint64_t)calls * 1000 / ticks) : 0),
+             (unsigned int)stats->nr_queue_waits,
+             (unsigned int)(calls ?
+                            ((uint64_t)stats->nr_queue_waits * 1000 / calls) :
+                            0));
+}
+
+/**
+ * \brief Load generator for the NS mailbox
+ *
+ * \details MULTI_CORE_BENCH_NR_THREADS threads issue a mix of PSA client
+ *          calls at the same time, and the mailbox statistics of the run are
+ *          printed as BENCH lines, described above. Runs with different
+ *          numbers of threads, intervals and NUM_MAILBOX_QUEUE_SLOT values
+ *          can be compared to size the queue for a given load.
+ */
+static void multi_core_bench_test_1(struct test_result_t *ret)
+{
+    struct bench_params params[MULTI_CORE_BENCH_NR_THREADS];
+    void *thread_ids[MULTI_CORE_BENCH_NR_THREADS];
+    struct ns_mailbox_stats_t stats;
+    void *current_thread_handle;
+    uint32_t current_thread_priority;
+    void *mutex_handle;
+    uint32_t start;
+    uint32_t ticks;
+    uint32_t nr_threads;
+    uint32_t i;
+
+    current_thread_handle = os_wrapper_thread_get_handle();
+    if (!current_thread_handle) {
+        TEST_FAIL("Failed to get current thread ID\r\n");
+        return;
+    }
+
+    if (os_wrapper_thread_get_priority(current_thread_handle,
+                                       &current_thread_priority) ==
+        OS_WRAPPER_ERROR) {
+        TEST_FAIL("Failed to get current thread priority\r\n");
+        return;
+    }
+
+    /* The same flag and mutex scheme as the multi-core interface tests */
+    mutex_handle = os_wrapper_mutex_create();
+    if (!mutex_handle) {
+        TEST_FAIL("Failed to create a mutex\r\n");
+        return;
+    }
+
+    for (i = 0; i < MULTI_CORE_BENCH_NR_THREADS; i++) {
+        params[i].idx = i;
+        params[i].mutex_handle = mutex_handle;
+        params[i].ret = TEST_FAILED;
+        params[i].is_complete = false;
+
+        thread_ids[i] = os_wrapper_thread_new(NULL,
+                                              MULTI_CORE_BENCH_STACK_SIZE,
+                                              bench_runner, &params[i],
+                                              current_thread_priority);
+        if (!thread_ids[i]) {
+            break;
+        }
+    }
+    nr_threads = i;
+
+    tfm_ns_mailbox_reset_stats();
+    start = tfm_ns_mailbox_hal_get_timestamp();
+
+    /* Kick off the threads one by one, to make them run together */
+    for (i = 0; i < nr_threads; i++) {
+        os_wrapper_thread_set_flag(thread_ids[i], BENCH_START_FLAG(i));
+    }
+
+    bench_wait_completion(params, nr_threads);
+
+    ticks = tfm_ns_mailbox_hal_get_timestamp() - start;
+    tfm_ns_mailbox_get_stats(&stats);
+
+    os_wrapper_mutex_delete(mutex_handle);
+
+    if (nr_threads != MULTI_CORE_BENCH_NR_THREADS) {
+        TEST_FAIL("Failed to create the benchmark threads\r\n");
+        return;
+    }
+
+    for (i = 0; i < nr_threads; i++) {
+        if (params[i].ret != TEST_PASSED) {
+            TEST_FAIL("A PSA client call of the benchmark failed\r\n");
+            return;
+        }
+    }
+
+    bench_log(&stats, ticks);
+
+    ret->val = TEST_PASSED;
+}
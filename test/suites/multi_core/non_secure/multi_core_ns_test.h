@@ -22,6 +22,14 @@ extern "C" {
 void register_testsuite_multi_core_ns_interface(
                                              struct test_suite_t *p_test_suite);
 
+/**
+ * \brief Register benchmark for multi-core topology.
+ *
+ * \param[in] p_test_suite The test suite to be executed.
+ */
+void register_testsuite_multi_core_ns_benchmark(
+                                             struct test_suite_t *p_test_suite);
+
 #ifdef __cplusplus
 }
 #endif
@@ -12,6 +12,8 @@
 static struct test_t platform_interface_tests[] = {
     {&tfm_platform_test_common_001, "TFM_PLATFORM_TEST_2001",
      "Minimal platform service test", {0} },
+    {&tfm_platform_test_common_002, "TFM_PLATFORM_TEST_2002",
+     "Vectored platform service test", {0} },
 };
 
 void
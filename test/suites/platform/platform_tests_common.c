@@ -8,6 +8,9 @@
 #include "tfm_platform_api.h"
 #include "platform_tests_common.h"
 
+/* Number of requests of the vectored calls */
+#define VECTOR_REQUESTS 4U
+
 /*!
  * \brief Call the platform service with an invalid request
  */
@@ -25,3 +28,76 @@ void tfm_platform_test_common_001(struct test_result_t *ret)
 
     ret->val = TEST_PASSED;
 }
+
+/*!
+ * \brief Call the platform service with a vector of invalid requests, and
+ *        with a request whose output does not fit the output buffer
+ */
+void tfm_platform_test_common_002(struct test_result_t *ret)
+{
+    const struct tfm_platform_ioctl_vec_t requests[VECTOR_REQUESTS] = {
+        {(tfm_platform_ioctl_req_t) INVALID_REQUEST, 0, 0},
+        {(tfm_platform_ioctl_req_t) INVALID_REQUEST, 4, 4},
+        /* Only 4 bytes of the output buffer are left for this request */
+        {(tfm_platform_ioctl_req_t) INVALID_REQUEST, 4, 8},
+        {(tfm_platform_ioctl_req_t) INVALID_REQUEST, 0, 0},
+    };
+    const enum tfm_platform_err_t expected[VECTOR_REQUESTS] = {
+        TFM_PLATFORM_ERR_NOT_SUPPORTED,
+        TFM_PLATFORM_ERR_NOT_SUPPORTED,
+        TFM_PLATFORM_ERR_INVALID_PARAM,
+        TFM_PLATFORM_ERR_INVALID_PARAM,
+    };
+    enum tfm_platform_err_t status[VECTOR_REQUESTS];
+    uint8_t in_buf[8] = {0};
+    uint8_t out_buf[8] = {0};
+    psa_invec input = {in_buf, sizeof(in_buf)};
+    psa_outvec output = {out_buf, sizeof(out_buf)};
+    enum tfm_platform_err_t err;
+    uint32_t i;
+
+    err = tfm_platform_ioctl_vector(requests, 0, &input, &output, status);
+    if (err != TFM_PLATFORM_ERR_INVALID_PARAM) {
+        TEST_FAIL("Call with no request should fail.");
+        return;
+    }
+
+    /* The requests which fit the buffers are all performed */
+    for (i = 0; i < VECTOR_REQUESTS; i++) {
+        status[i] = TFM_PLATFORM_ERR_SUCCESS;
+    }
+
+    err = tfm_platform_ioctl_vector(requests, 2, &input, &output, status);
+    if (err != TFM_PLATFORM_ERR_SUCCESS) {
+        TEST_FAIL("Call with invalid requests should not fail.");
+        return;
+    }
+
+    for (i = 0; i < 2; i++) {
+        if (status[i] != expected[i]) {
+            TEST_FAIL("Invalid request should fail.");
+            return;
+        }
+    }
+
+    /* The request which does not fit and the following one are not */
+    for (i = 0; i < VECTOR_REQUESTS; i++) {
+        status[i] = TFM_PLATFORM_ERR_SUCCESS;
+    }
+
+    err = tfm_platform_ioctl_vector(requests, VECTOR_REQUESTS, &input,
+                                    &output, status);
+    if (err != TFM_PLATFORM_ERR_INVALID_PARAM) {
+        TEST_FAIL("Call with a request which does not fit should fail.");
+        return;
+    }
+
+    for (i = 0; i < VECTOR_REQUESTS; i++) {
+        if (status[i] != expected[i]) {
+            TEST_FAIL("Unexpected status of a request.");
+            return;
+        }
+    }
+
+    ret->val = TEST_PASSED;
+}
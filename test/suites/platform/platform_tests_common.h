@@ -14,7 +14,8 @@ extern "C" {
 
 #include "test/framework/test_framework.h"
 
-#define INVALID_REQUEST 0xffffffff
+/* Not a negative value, which the platform may route to its own requests */
+#define INVALID_REQUEST 0x7fffffff
 
 /*!
  * \brief Call the platform service with an invalid request
@@ -23,6 +24,14 @@ extern "C" {
  */
 void tfm_platform_test_common_001(struct test_result_t *ret);
 
+/*!
+ * \brief Call the platform service with a vector of invalid requests, and
+ *        with a request whose output does not fit the output buffer
+ *
+ * \param[out] ret  Test results
+ */
+void tfm_platform_test_common_002(struct test_result_t *ret);
+
 #ifdef __cplusplus
 }
 #endif
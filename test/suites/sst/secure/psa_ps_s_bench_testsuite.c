@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include "sst_tests.h"
+#include "psa/protected_storage.h"
+#include "test/framework/test_framework_helpers.h"
+#include "flash_layout.h"
+#include "test/suites/its/storage_bench_common.h"
+
+static const struct storage_bench_api_t sst_bench_api = {
+    .name = "SST",
+    .set = psa_ps_set,
+    .get = psa_ps_get,
+    .remove = psa_ps_remove,
+    .flash_id = ITS_FLASH_ID_EXTERNAL,
+    .max_size = SST_MAX_ASSET_SIZE,
+    .num_assets = SST_NUM_ASSETS,
+};
+
+/* List of tests */
+static void tfm_sst_test_5001(struct test_result_t *ret);
+static void tfm_sst_test_5002(struct test_result_t *ret);
+
+static struct test_t sst_bench_tests[] = {
+    {&tfm_sst_test_5001, "TFM_SST_TEST_5001",
+     "SST create, set, get and remove benchmark by asset size", {0} },
+    {&tfm_sst_test_5002, "TFM_SST_TEST_5002",
+     "SST create, set, get and remove benchmark by fill level", {0} },
+};
+
+void register_testsuite_s_psa_ps_benchmark(struct test_suite_t *p_test_suite)
+{
+    uint32_t list_size = (sizeof(sst_bench_tests) /
+                          sizeof(sst_bench_tests[0]));
+
+    set_testsuite("SST secure benchmark (TFM_SST_TEST_5XXX)",
+                  sst_bench_tests, list_size, p_test_suite);
+}
+
+/**
+ * \brief Secure benchmark for SST
+ *
+ * \details The scope of this set of tests is to measure the cycles and the
+ *          flash operations taken by the operations of
+ *          psa/protected_storage.h. The results are printed as BENCH
+ *          lines, described in storage_bench_common.c, which can be collected
+ *          from the test log.
+ *
+ */
+static void tfm_sst_test_5001(struct test_result_t *ret)
+{
+    storage_bench_size_test(&sst_bench_api, ret);
+}
+
+static void tfm_sst_test_5002(struct test_result_t *ret)
+{
+    storage_bench_fill_test(&sst_bench_api, ret);
+}
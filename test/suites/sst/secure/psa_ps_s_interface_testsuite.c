@@ -42,6 +42,9 @@
 #define OFFSET_RESULT_DATA       ("____" OFFSET_READ_DATA "_____")
 
 #define TEST_1022_CYCLES         3U
+#define TEST_2023_UIDS           3U
+/* Batch size which lists all the UIDs of test 2023 in a single call */
+#define TEST_2023_FULL_SIZE      (TEST_2023_UIDS + 2U)
 
 static const uint8_t write_asset_data[SST_MAX_ASSET_SIZE] = {0xBF};
 static uint8_t read_asset_data[SST_MAX_ASSET_SIZE] = {0};
@@ -70,6 +73,12 @@ static void tfm_sst_test_2019(struct test_result_t *ret);
 static void tfm_sst_test_2020(struct test_result_t *ret);
 static void tfm_sst_test_2021(struct test_result_t *ret);
 static void tfm_sst_test_2022(struct test_result_t *ret);
+static void tfm_sst_test_2023(struct test_result_t *ret);
+#ifdef SST_TRANSACTIONS
+static void tfm_sst_test_2024(struct test_result_t *ret);
+static void tfm_sst_test_2025(struct test_result_t *ret);
+#endif /* SST_TRANSACTIONS */
+static void tfm_sst_test_2026(struct test_result_t *ret);
 
 static struct test_t psa_ps_s_tests[] = {
     {&tfm_sst_test_2001, "TFM_SST_TEST_2001",
@@ -116,6 +125,16 @@ static struct test_t psa_ps_s_tests[] = {
      "Get support interface"},
     {&tfm_sst_test_2022, "TFM_SST_TEST_2022",
      "Set, get and remove interface with different asset sizes"},
+    {&tfm_sst_test_2023, "TFM_SST_TEST_2023",
+     "List interface"},
+#ifdef SST_TRANSACTIONS
+    {&tfm_sst_test_2024, "TFM_SST_TEST_2024",
+     "Committed transaction"},
+    {&tfm_sst_test_2025, "TFM_SST_TEST_2025",
+     "Aborted transaction after writes"},
+#endif /* SST_TRANSACTIONS */
+    {&tfm_sst_test_2026, "TFM_SST_TEST_2026",
+     "Set async interface, get before and after the flush"},
 };
 
 void register_testsuite_s_psa_ps_interface(struct test_suite_t *p_test_suite)
@@ -1217,3 +1236,532 @@ static void tfm_sst_test_2022(struct test_result_t *ret)
 
     ret->val = TEST_PASSED;
 }
+
+/**
+ * \brief Lists the UIDs of the caller in batches of \p batch_size, and checks
+ *        that each of \p uids is listed exactly once and that no other UID
+ *        than WRITE_ONCE_UID, which may have been set by a previous test, is
+ *        listed. A batch with fewer UIDs than \p batch_size must be the last.
+ *
+ * \param[in]  uids        UIDs expected to be listed
+ * \param[in]  uid_count   Number of UIDs in \p uids
+ * \param[in]  batch_size  Number of UIDs listed by each call, up to
+ *                         TEST_2023_FULL_SIZE
+ * \param[out] calls       Number of calls made to list all the UIDs
+ * \param[out] ret         Test result
+ *
+ * \return 0 if the UIDs are listed as expected, 1 otherwise
+ */
+static uint32_t sst_test_list_check(const psa_storage_uid_t *uids,
+                                    size_t uid_count, size_t batch_size,
+                                    uint32_t *calls,
+                                    struct test_result_t *ret)
+{
+    psa_status_t status;
+    psa_storage_uid_t listed[TEST_2023_FULL_SIZE];
+    uint32_t seen[TEST_2023_UIDS] = {0};
+    uint32_t cursor = TFM_STORAGE_LIST_START;
+    size_t count;
+    size_t i, j;
+
+    *calls = 0;
+
+    while (cursor != TFM_STORAGE_LIST_END) {
+        /* Each asset is listed at most once, so the enumeration must end */
+        if (*calls > TEST_2023_FULL_SIZE) {
+            TEST_FAIL("List should reach the end of the UIDs");
+            return 1;
+        }
+
+        status = psa_ps_list(&cursor, listed, batch_size, &count);
+        (*calls)++;
+        if (status != PSA_SUCCESS) {
+            TEST_FAIL("List should not fail");
+            return 1;
+        }
+
+        if (count > batch_size) {
+            TEST_FAIL("List should not overflow the batch");
+            return 1;
+        }
+
+        if ((count < batch_size) && (cursor != TFM_STORAGE_LIST_END)) {
+            TEST_FAIL("A partial batch should end the enumeration");
+            return 1;
+        }
+
+        for (i = 0; i < count; i++) {
+            for (j = 0; j < uid_count; j++) {
+                if (listed[i] == uids[j]) {
+                    seen[j]++;
+                    break;
+                }
+            }
+
+            if ((j == uid_count) && (listed[i] != WRITE_ONCE_UID)) {
+                TEST_FAIL("List should only return the UIDs set");
+                return 1;
+            }
+        }
+    }
+
+    for (j = 0; j < uid_count; j++) {
+        if (seen[j] != 1) {
+            TEST_FAIL("Each UID set should be listed exactly once");
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Tests list function with:
+ * - No UID set
+ * - Batches which hold part of the UIDs set
+ * - A batch which holds all the UIDs set
+ * - A UID removed
+ */
+static void tfm_sst_test_2023(struct test_result_t *ret)
+{
+    psa_status_t status;
+    const psa_storage_uid_t test_uid[TEST_2023_UIDS] = {
+        TEST_UID_1,
+        TEST_UID_2,
+        TEST_UID_3};
+    const psa_storage_uid_t remaining_uid[TEST_2023_UIDS - 1] = {
+        TEST_UID_1,
+        TEST_UID_3};
+    psa_storage_uid_t listed[1];
+    uint32_t cursor = TFM_STORAGE_LIST_END;
+    uint32_t calls;
+    size_t count = 1;
+    uint32_t i;
+
+    /* Listing from the end cursor returns no UID */
+    status = psa_ps_list(&cursor, listed, 1, &count);
+    if ((status != PSA_SUCCESS) || (count != 0) ||
+        (cursor != TFM_STORAGE_LIST_END)) {
+        TEST_FAIL("List should return no UID from the end cursor");
+        return;
+    }
+
+    /* Empty storage, apart from the write once UID */
+    if (sst_test_list_check(test_uid, 0, 1, &calls, ret) != 0) {
+        return;
+    }
+
+    for (i = 0; i < TEST_2023_UIDS; i++) {
+        status = psa_ps_set(test_uid[i], WRITE_DATA_SIZE, WRITE_DATA,
+                            PSA_STORAGE_FLAG_NONE);
+        if (status != PSA_SUCCESS) {
+            TEST_FAIL("Set should not fail with valid UID");
+            return;
+        }
+    }
+
+    /* Partial batches, which need several calls */
+    if (sst_test_list_check(test_uid, TEST_2023_UIDS, 2, &calls, ret) != 0) {
+        return;
+    }
+
+    if (calls < 2) {
+        TEST_FAIL("List should need several calls with partial batches");
+        return;
+    }
+
+    /* A batch which holds all the UIDs */
+    if (sst_test_list_check(test_uid, TEST_2023_UIDS, TEST_2023_FULL_SIZE,
+                            &calls, ret) != 0) {
+        return;
+    }
+
+    if (calls != 1) {
+        TEST_FAIL("List should return all the UIDs in a single call");
+        return;
+    }
+
+    /* A removed UID is not listed anymore */
+    status = psa_ps_remove(TEST_UID_2);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Remove should not fail with valid UID");
+        return;
+    }
+
+    if (sst_test_list_check(remaining_uid, TEST_2023_UIDS - 1, 1, &calls,
+                            ret) != 0) {
+        return;
+    }
+
+    /* Call remove to clean up storage for the next test */
+    for (i = 0; i < TEST_2023_UIDS - 1; i++) {
+        status = psa_ps_remove(remaining_uid[i]);
+        if (status != PSA_SUCCESS) {
+            TEST_FAIL("Remove should not fail with valid UID");
+            return;
+        }
+    }
+
+    ret->val = TEST_PASSED;
+}
+
+/**
+ * \brief Checks that the data of a UID is the given data.
+ *
+ * \param[in]  uid       UID to get
+ * \param[in]  data      Expected data of the UID
+ * \param[in]  data_len  Size of the expected data, up to SST_MAX_ASSET_SIZE
+ * \param[out] ret       Test result
+ *
+ * \return 0 if the UID holds the expected data, 1 otherwise
+ */
+static uint32_t sst_test_check_data(psa_storage_uid_t uid,
+                                    const uint8_t *data, size_t data_len,
+                                    struct test_result_t *ret)
+{
+    psa_status_t status;
+    size_t read_data_len = 0;
+
+    status = psa_ps_get(uid, 0, data_len, read_asset_data, &read_data_len);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Get should not fail with valid UID");
+        return 1;
+    }
+
+    if ((read_data_len != data_len) ||
+        (tfm_memcmp(read_asset_data, data, data_len) != 0)) {
+        TEST_FAIL("Read data should be equal to the data set last");
+        return 1;
+    }
+
+    return 0;
+}
+
+#ifdef SST_TRANSACTIONS
+/**
+ * \brief Tests a committed transaction:
+ * - Commit and abort without an open transaction
+ * - Begin while the transaction is open
+ * - Set of a new UID and of an existing UID in the transaction
+ */
+static void tfm_sst_test_2024(struct test_result_t *ret)
+{
+    psa_status_t status;
+    const psa_storage_create_flags_t flags = PSA_STORAGE_FLAG_NONE;
+    const uint8_t write_data_1[] = "ONE";
+    const uint8_t write_data_2[] = "TWO";
+
+    status = psa_ps_commit_transaction();
+    if (status != PSA_ERROR_BAD_STATE) {
+        TEST_FAIL("Commit should fail without an open transaction");
+        return;
+    }
+
+    status = psa_ps_abort_transaction();
+    if (status != PSA_ERROR_BAD_STATE) {
+        TEST_FAIL("Abort should fail without an open transaction");
+        return;
+    }
+
+    status = psa_ps_set(TEST_UID_1, sizeof(write_data_1), write_data_1, flags);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Set should not fail with valid UID");
+        return;
+    }
+
+    status = psa_ps_begin_transaction();
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Begin should not fail");
+        return;
+    }
+
+    status = psa_ps_begin_transaction();
+    if (status != PSA_ERROR_BAD_STATE) {
+        TEST_FAIL("Begin should fail while a transaction is open");
+        goto abort;
+    }
+
+    /* Set an existing UID and a new one in the transaction */
+    status = psa_ps_set(TEST_UID_1, sizeof(write_data_2), write_data_2, flags);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Set should not fail in a transaction");
+        goto abort;
+    }
+
+    status = psa_ps_set(TEST_UID_2, WRITE_DATA_SIZE, WRITE_DATA, flags);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Set should not fail in a transaction");
+        goto abort;
+    }
+
+    status = psa_ps_commit_transaction();
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Commit should not fail");
+        return;
+    }
+
+    /* Both sets are kept */
+    if (sst_test_check_data(TEST_UID_1, write_data_2, sizeof(write_data_2),
+                            ret) != 0) {
+        return;
+    }
+
+    if (sst_test_check_data(TEST_UID_2, (const uint8_t *)WRITE_DATA,
+                            WRITE_DATA_SIZE, ret) != 0) {
+        return;
+    }
+
+    /* The commit has ended the transaction */
+    status = psa_ps_commit_transaction();
+    if (status != PSA_ERROR_BAD_STATE) {
+        TEST_FAIL("Commit should fail once the transaction has ended");
+        return;
+    }
+
+    /* Remove UIDs to clean up storage for the next test */
+    status = psa_ps_remove(TEST_UID_1);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Remove should not fail with valid UID");
+        return;
+    }
+
+    status = psa_ps_remove(TEST_UID_2);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Remove should not fail with valid UID");
+        return;
+    }
+
+    ret->val = TEST_PASSED;
+    return;
+
+abort:
+    (void)psa_ps_abort_transaction();
+}
+
+/**
+ * \brief Tests an aborted transaction, after a set of a new UID, a set of an
+ *        existing UID and a remove in the transaction.
+ */
+static void tfm_sst_test_2025(struct test_result_t *ret)
+{
+    psa_status_t status;
+    struct psa_storage_info_t info = {0};
+    const psa_storage_create_flags_t flags = PSA_STORAGE_FLAG_NONE;
+    const uint8_t write_data_1[] = "ONE";
+    const uint8_t write_data_2[] = "TWO";
+
+    status = psa_ps_set(TEST_UID_1, sizeof(write_data_1), write_data_1, flags);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Set should not fail with valid UID");
+        return;
+    }
+
+    status = psa_ps_set(TEST_UID_2, sizeof(write_data_2), write_data_2, flags);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Set should not fail with valid UID");
+        return;
+    }
+
+    status = psa_ps_begin_transaction();
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Begin should not fail");
+        return;
+    }
+
+    status = psa_ps_set(TEST_UID_1, WRITE_DATA_SIZE, WRITE_DATA, flags);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Set should not fail in a transaction");
+        goto abort;
+    }
+
+    status = psa_ps_set(TEST_UID_3, WRITE_DATA_SIZE, WRITE_DATA, flags);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Set should not fail in a transaction");
+        goto abort;
+    }
+
+    status = psa_ps_remove(TEST_UID_2);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Remove should not fail in a transaction");
+        goto abort;
+    }
+
+    status = psa_ps_abort_transaction();
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Abort should not fail");
+        return;
+    }
+
+    /* None of the changes is kept */
+    if (sst_test_check_data(TEST_UID_1, write_data_1, sizeof(write_data_1),
+                            ret) != 0) {
+        return;
+    }
+
+    if (sst_test_check_data(TEST_UID_2, write_data_2, sizeof(write_data_2),
+                            ret) != 0) {
+        return;
+    }
+
+    status = psa_ps_get_info(TEST_UID_3, &info);
+    if (status != PSA_ERROR_DOES_NOT_EXIST) {
+        TEST_FAIL("UID set in an aborted transaction should not exist");
+        return;
+    }
+
+    /* The abort has ended the transaction */
+    status = psa_ps_abort_transaction();
+    if (status != PSA_ERROR_BAD_STATE) {
+        TEST_FAIL("Abort should fail once the transaction has ended");
+        return;
+    }
+
+    /* Remove UIDs to clean up storage for the next test */
+    status = psa_ps_remove(TEST_UID_1);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Remove should not fail with valid UID");
+        return;
+    }
+
+    status = psa_ps_remove(TEST_UID_2);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Remove should not fail with valid UID");
+        return;
+    }
+
+    ret->val = TEST_PASSED;
+    return;
+
+abort:
+    (void)psa_ps_abort_transaction();
+}
+#endif /* SST_TRANSACTIONS */
+
+/**
+ * \brief Tests set async and flush functions:
+ * - Get of the UIDs before and after the flush
+ * - Set async of a UID whose write is queued
+ * - Set async of data larger than a queued write
+ * - Set async of the write once UID, whose error is reported by set async or
+ *   by the flush
+ */
+static void tfm_sst_test_2026(struct test_result_t *ret)
+{
+    psa_status_t status;
+    psa_status_t flush_status;
+    const psa_storage_create_flags_t flags = PSA_STORAGE_FLAG_NONE;
+    const uint8_t write_data_1[] = "ONE";
+    const uint8_t write_data_2[] = "TWO";
+
+    status = psa_ps_set_async(TEST_UID_1, sizeof(write_data_1), write_data_1,
+                              flags);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Set async should not fail with valid UID");
+        return;
+    }
+
+    /* The caller reads the data it has queued */
+    if (sst_test_check_data(TEST_UID_1, write_data_1, sizeof(write_data_1),
+                            ret) != 0) {
+        return;
+    }
+
+    /* Replace the data of UID 1, and set two more UIDs */
+    status = psa_ps_set_async(TEST_UID_1, sizeof(write_data_2), write_data_2,
+                              flags);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Set async should not fail with valid UID");
+        return;
+    }
+
+    status = psa_ps_set_async(TEST_UID_2, WRITE_DATA_SIZE, WRITE_DATA, flags);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Set async should not fail with valid UID");
+        return;
+    }
+
+    status = psa_ps_set_async(TEST_UID_3, SST_MAX_ASSET_SIZE,
+                              write_asset_data, flags);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Set async should not fail with the maximum asset size");
+        return;
+    }
+
+    if (sst_test_check_data(TEST_UID_1, write_data_2, sizeof(write_data_2),
+                            ret) != 0) {
+        return;
+    }
+
+    status = psa_ps_flush();
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Flush should not fail");
+        return;
+    }
+
+    /* All the UIDs hold the data set last */
+    if (sst_test_check_data(TEST_UID_1, write_data_2, sizeof(write_data_2),
+                            ret) != 0) {
+        return;
+    }
+
+    if (sst_test_check_data(TEST_UID_2, (const uint8_t *)WRITE_DATA,
+                            WRITE_DATA_SIZE, ret) != 0) {
+        return;
+    }
+
+    if (sst_test_check_data(TEST_UID_3, write_asset_data, SST_MAX_ASSET_SIZE,
+                            ret) != 0) {
+        return;
+    }
+
+    /* A flush with no queued write */
+    status = psa_ps_flush();
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Flush should not fail without queued writes");
+        return;
+    }
+
+    /* The write once UID was set by a previous test. The error of its write
+     * is reported either by set async or, when the write is queued, by the
+     * flush.
+     */
+    status = psa_ps_set_async(WRITE_ONCE_UID, sizeof(write_data_1),
+                              write_data_1, flags);
+    flush_status = psa_ps_flush();
+    if ((status != PSA_SUCCESS) && (status != PSA_ERROR_NOT_PERMITTED)) {
+        TEST_FAIL("Set async should not fail with an unexpected error");
+        return;
+    }
+
+    if (flush_status != ((status == PSA_SUCCESS) ? PSA_ERROR_NOT_PERMITTED :
+                                                   PSA_SUCCESS)) {
+        TEST_FAIL("Error of the write once UID should be reported once");
+        return;
+    }
+
+    if (sst_test_check_data(WRITE_ONCE_UID, (const uint8_t *)WRITE_ONCE_DATA,
+                            WRITE_ONCE_DATA_SIZE, ret) != 0) {
+        return;
+    }
+
+    /* Call remove to clean up storage for the next test */
+    status = psa_ps_remove(TEST_UID_1);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Remove should not fail with valid UID");
+        return;
+    }
+
+    status = psa_ps_remove(TEST_UID_2);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Remove should not fail with valid UID");
+        return;
+    }
+
+    status = psa_ps_remove(TEST_UID_3);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Remove should not fail with valid UID");
+        return;
+    }
+
+    ret->val = TEST_PASSED;
+}
@@ -28,6 +28,15 @@ void register_testsuite_s_psa_ps_interface(struct test_suite_t *p_test_suite);
  */
 void register_testsuite_s_psa_ps_reliability(struct test_suite_t *p_test_suite);
 
+#ifdef ENABLE_STORAGE_BENCHMARK_TESTS
+/**
+ * \brief Register testsuite for the sst secure benchmark.
+ *
+ * \param[in] p_test_suite  The test suite to be executed.
+ */
+void register_testsuite_s_psa_ps_benchmark(struct test_suite_t *p_test_suite);
+#endif
+
 #ifdef SST_TEST_NV_COUNTERS
 /**
  * \brief Register testsuite for the sst rollback protection tests.
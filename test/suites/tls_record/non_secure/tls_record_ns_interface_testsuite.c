@@ -0,0 +1,610 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdbool.h>
+#include <string.h>
+#include "tls_record_ns_tests.h"
+#include "tfm_tls_record_api.h"
+
+/* Content types of the records, RFC 8446 section 5.1 */
+#define TLS_RECORD_TEST_HANDSHAKE       22U
+#define TLS_RECORD_TEST_APP_DATA        23U
+
+#define TLS_RECORD_TEST_PLAINTEXT_SIZE  40U
+#define TLS_RECORD_TEST_SECRET_SIZE     32U /* Of SHA-256 */
+
+#define TLS_RECORD_TEST_BUF_SIZE \
+    TFM_TLS_RECORD_SIZE(TLS_RECORD_TEST_PLAINTEXT_SIZE)
+
+/* The known answers below are computed with the inputs built by
+ * tls_record_test_fill(): a master secret of bytes 0x00 to 0x2F, randoms of
+ * bytes 0x40 to 0x7F, client and server application traffic secrets of bytes
+ * 0x80 to 0x9F and 0xA0 to 0xBF, and a plaintext of "ABC...ZABC...N".
+ */
+
+/* TLS_RSA_WITH_AES_128_GCM_SHA256, client records 0 and 1 */
+static const uint8_t tls12_gcm_record[2][69] = {
+    {0x17, 0x03, 0x03, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x93, 0x85, 0x73, 0x24, 0x04, 0x29, 0x7b, 0xef, 0x33, 0xab, 0xe6,
+     0x29, 0xd9, 0x59, 0x23, 0x2c, 0x43, 0x69, 0x96, 0x57, 0x42, 0x93, 0x0f,
+     0x30, 0x31, 0xfd, 0xf8, 0x7a, 0x81, 0x71, 0xfb, 0x64, 0xbb, 0x1e, 0xd8,
+     0x6a, 0xde, 0x78, 0x1b, 0x35, 0x15, 0x4f, 0x94, 0x33, 0xef, 0x5b, 0x6d,
+     0x34, 0x43, 0x9a, 0xd4, 0x65, 0x86, 0xf3, 0xee, 0x56},
+    {0x17, 0x03, 0x03, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x01, 0x1e, 0x2e, 0xb4, 0xda, 0xd7, 0xf7, 0x3e, 0x95, 0x5a, 0xc4, 0x75,
+     0xa7, 0x77, 0x18, 0x53, 0xf0, 0x22, 0x90, 0x73, 0x93, 0x54, 0xd6, 0x18,
+     0x88, 0x18, 0x00, 0xde, 0x4f, 0x59, 0x00, 0xff, 0xe6, 0x94, 0x9b, 0xbc,
+     0xca, 0x38, 0x42, 0x57, 0x14, 0x81, 0x3c, 0x5a, 0xa3, 0xfa, 0xb6, 0xf4,
+     0xac, 0x21, 0xb4, 0x9c, 0x9f, 0x3a, 0xac, 0xb4, 0xf4},
+};
+
+/* TLS_ECDHE_RSA_WITH_CHACHA20_POLY1305_SHA256, server record 0 */
+static const uint8_t tls12_chacha_record[61] = {
+    0x17, 0x03, 0x03, 0x00, 0x38, 0xb1, 0xa2, 0x33, 0x94, 0x6a, 0xba, 0xb0,
+    0x88, 0x13, 0x3d, 0xaf, 0x31, 0xfd, 0x5e, 0xae, 0x0f, 0x90, 0xfd, 0x97,
+    0x55, 0x4a, 0x99, 0x94, 0x0b, 0xde, 0x0c, 0x8e, 0x6f, 0x0a, 0xb2, 0xb7,
+    0x25, 0xe2, 0xfb, 0x26, 0x79, 0x55, 0xbd, 0x59, 0x36, 0x2f, 0x74, 0xb8,
+    0xe1, 0xc0, 0x86, 0x72, 0xbb, 0x45, 0xeb, 0xf9, 0x3a, 0x40, 0x28, 0xba,
+    0x06,
+};
+
+/* TLS_AES_128_GCM_SHA256, client records 0 and 1 */
+static const uint8_t tls13_gcm_record[2][62] = {
+    {0x17, 0x03, 0x03, 0x00, 0x39, 0x81, 0x6a, 0xe1, 0x7b, 0xc6, 0xeb, 0x95,
+     0x3e, 0x64, 0x6e, 0x90, 0x0d, 0x89, 0xbc, 0x64, 0x1f, 0xcd, 0xe3, 0x02,
+     0xd2, 0xf7, 0xb1, 0x2e, 0x7f, 0x4f, 0xef, 0x85, 0x4d, 0x5e, 0x2a, 0xd7,
+     0xcf, 0x41, 0xa9, 0x6e, 0x10, 0x47, 0xf6, 0x1a, 0xde, 0x96, 0xa9, 0xea,
+     0x63, 0x54, 0x37, 0x9e, 0xd0, 0x30, 0x52, 0xba, 0xc5, 0xbd, 0xae, 0xf4,
+     0x13, 0x6f},
+    {0x17, 0x03, 0x03, 0x00, 0x39, 0xa6, 0x9b, 0xd6, 0x15, 0x83, 0x8c, 0x5e,
+     0x87, 0xfd, 0xb9, 0xd7, 0x46, 0xe3, 0x11, 0x8a, 0xca, 0x72, 0x9d, 0x2b,
+     0xcd, 0x2c, 0x55, 0x24, 0x73, 0x49, 0x01, 0xd5, 0x61, 0xeb, 0x94, 0x79,
+     0xb7, 0xe2, 0x73, 0x17, 0xe4, 0xaa, 0x19, 0xca, 0x12, 0x36, 0x80, 0x90,
+     0x91, 0xd8, 0x4a, 0x78, 0xc5, 0x4c, 0x9a, 0x2d, 0x15, 0xe5, 0xa8, 0x3f,
+     0x12, 0xb1},
+};
+
+static uint8_t tls_record_test_master[TFM_TLS_RECORD_MASTER_SECRET_LENGTH];
+static uint8_t tls_record_test_randoms[TFM_TLS_RECORD_RANDOMS_LENGTH];
+static uint8_t tls_record_test_secrets[2 * TLS_RECORD_TEST_SECRET_SIZE];
+static uint8_t tls_record_test_plaintext[TLS_RECORD_TEST_PLAINTEXT_SIZE];
+static uint8_t tls_record_test_record[TLS_RECORD_TEST_BUF_SIZE];
+static uint8_t tls_record_test_output[TLS_RECORD_TEST_BUF_SIZE];
+
+/* List of tests */
+static void tfm_tls_record_test_1001(struct test_result_t *ret);
+static void tfm_tls_record_test_1002(struct test_result_t *ret);
+static void tfm_tls_record_test_1003(struct test_result_t *ret);
+static void tfm_tls_record_test_1004(struct test_result_t *ret);
+static void tfm_tls_record_test_1005(struct test_result_t *ret);
+
+static struct test_t tls_record_interface_tests[] = {
+    {&tfm_tls_record_test_1001, "TFM_TLS_RECORD_TEST_1001",
+     "TLS 1.2 AES-GCM records against known answers", {0} },
+    {&tfm_tls_record_test_1002, "TFM_TLS_RECORD_TEST_1002",
+     "TLS 1.2 ChaCha20-Poly1305 records against known answers", {0} },
+    {&tfm_tls_record_test_1003, "TFM_TLS_RECORD_TEST_1003",
+     "TLS 1.3 AES-GCM records against known answers", {0} },
+    {&tfm_tls_record_test_1004, "TFM_TLS_RECORD_TEST_1004",
+     "Rejection of altered and replayed records", {0} },
+    {&tfm_tls_record_test_1005, "TFM_TLS_RECORD_TEST_1005",
+     "Rejection of invalid requests", {0} },
+};
+
+void register_testsuite_ns_tls_record_interface(
+                                             struct test_suite_t *p_test_suite)
+{
+    uint32_t list_size;
+
+    list_size = (sizeof(tls_record_interface_tests) /
+                 sizeof(tls_record_interface_tests[0]));
+
+    set_testsuite("TLS record Service Non-Secure interface tests"
+                  "(TFM_TLS_RECORD_TEST_1XXX)",
+                  tls_record_interface_tests, list_size, p_test_suite);
+}
+
+static void tls_record_test_fill(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < sizeof(tls_record_test_master); i++) {
+        tls_record_test_master[i] = (uint8_t)i;
+    }
+    for (i = 0; i < sizeof(tls_record_test_randoms); i++) {
+        tls_record_test_randoms[i] = (uint8_t)(0x40U + i);
+    }
+    for (i = 0; i < sizeof(tls_record_test_secrets); i++) {
+        tls_record_test_secrets[i] = (uint8_t)(0x80U + i);
+    }
+    for (i = 0; i < sizeof(tls_record_test_plaintext); i++) {
+        tls_record_test_plaintext[i] = (uint8_t)('A' + (i % 26U));
+    }
+}
+
+/**
+ * \brief Sets up a connection with the inputs of the known answers.
+ */
+static psa_status_t tls_record_test_setup(uint32_t *connection,
+                                          uint32_t version,
+                                          psa_algorithm_t alg,
+                                          uint32_t key_bits,
+                                          uint32_t is_server)
+{
+    struct tfm_tls_record_params params = {
+        .version = version,
+        .alg = alg,
+        .hash_alg = PSA_ALG_SHA_256,
+        .key_bits = key_bits,
+        .is_server = is_server,
+    };
+
+    tls_record_test_fill();
+
+    if (version == TFM_TLS_RECORD_VERSION_1_2) {
+        return psa_tls_record_setup(connection, &params,
+                                    tls_record_test_master,
+                                    sizeof(tls_record_test_master),
+                                    tls_record_test_randoms,
+                                    sizeof(tls_record_test_randoms));
+    }
+
+    return psa_tls_record_setup(connection, &params,
+                                tls_record_test_secrets,
+                                sizeof(tls_record_test_secrets), NULL, 0);
+}
+
+/**
+ * \brief Protects the plaintext of the test and compares the record with a
+ *        known answer.
+ */
+static bool tls_record_test_protect(uint32_t connection,
+                                    const uint8_t *expected,
+                                    size_t expected_length)
+{
+    size_t record_length;
+
+    if (psa_tls_record_protect(connection, TLS_RECORD_TEST_APP_DATA,
+                               tls_record_test_plaintext,
+                               sizeof(tls_record_test_plaintext),
+                               tls_record_test_record,
+                               sizeof(tls_record_test_record),
+                               &record_length) != PSA_SUCCESS) {
+        return false;
+    }
+
+    return (record_length == expected_length) &&
+           (memcmp(tls_record_test_record, expected, expected_length) == 0);
+}
+
+/**
+ * \brief Unprotects a record and checks that it holds the plaintext of the
+ *        test, of the given content type.
+ */
+static bool tls_record_test_unprotect(uint32_t connection,
+                                      const uint8_t *record,
+                                      size_t record_length,
+                                      uint8_t expected_type)
+{
+    size_t plaintext_length;
+    uint8_t content_type;
+
+    if (psa_tls_record_unprotect(connection, record, record_length,
+                                 &content_type, tls_record_test_output,
+                                 sizeof(tls_record_test_output),
+                                 &plaintext_length) != PSA_SUCCESS) {
+        return false;
+    }
+
+    return (content_type == expected_type) &&
+           (plaintext_length == sizeof(tls_record_test_plaintext)) &&
+           (memcmp(tls_record_test_output, tls_record_test_plaintext,
+                   plaintext_length) == 0);
+}
+
+/**
+ * \brief Protects two records at the client and checks them at the server.
+ *        The second record checks that the sequence numbers advance.
+ */
+static void tfm_tls_record_test_1001(struct test_result_t *ret)
+{
+    uint32_t client, server;
+    uint32_t i;
+
+    if ((tls_record_test_setup(&client, TFM_TLS_RECORD_VERSION_1_2,
+                               PSA_ALG_GCM, 128, 0) != PSA_SUCCESS) ||
+        (tls_record_test_setup(&server, TFM_TLS_RECORD_VERSION_1_2,
+                               PSA_ALG_GCM, 128, 1) != PSA_SUCCESS)) {
+        TEST_FAIL("Setting up the connections should not fail");
+        return;
+    }
+
+    for (i = 0; i < 2; i++) {
+        if (!tls_record_test_protect(client, tls12_gcm_record[i],
+                                     sizeof(tls12_gcm_record[i]))) {
+            TEST_FAIL("The record should match the known answer");
+            goto abort;
+        }
+
+        if (!tls_record_test_unprotect(server, tls12_gcm_record[i],
+                                       sizeof(tls12_gcm_record[i]),
+                                       TLS_RECORD_TEST_APP_DATA)) {
+            TEST_FAIL("The server should decrypt the client record");
+            goto abort;
+        }
+    }
+
+    ret->val = TEST_PASSED;
+
+abort:
+    (void)psa_tls_record_abort(&client);
+    (void)psa_tls_record_abort(&server);
+}
+
+/**
+ * \brief Protects a record at the server and checks it at the client, with
+ *        the nonce built from the IV and the sequence number only.
+ */
+static void tfm_tls_record_test_1002(struct test_result_t *ret)
+{
+    uint32_t client, server;
+
+    if ((tls_record_test_setup(&client, TFM_TLS_RECORD_VERSION_1_2,
+                               PSA_ALG_CHACHA20_POLY1305, 256,
+                               0) != PSA_SUCCESS) ||
+        (tls_record_test_setup(&server, TFM_TLS_RECORD_VERSION_1_2,
+                               PSA_ALG_CHACHA20_POLY1305, 256,
+                               1) != PSA_SUCCESS)) {
+        TEST_FAIL("Setting up the connections should not fail");
+        return;
+    }
+
+    if (!tls_record_test_protect(server, tls12_chacha_record,
+                                 sizeof(tls12_chacha_record))) {
+        TEST_FAIL("The record should match the known answer");
+        goto abort;
+    }
+
+    if (!tls_record_test_unprotect(client, tls12_chacha_record,
+                                   sizeof(tls12_chacha_record),
+                                   TLS_RECORD_TEST_APP_DATA)) {
+        TEST_FAIL("The client should decrypt the server record");
+        goto abort;
+    }
+
+    ret->val = TEST_PASSED;
+
+abort:
+    (void)psa_tls_record_abort(&client);
+    (void)psa_tls_record_abort(&server);
+}
+
+/**
+ * \brief Protects two records at the client with the keys expanded from the
+ *        traffic secret, then a handshake record at the server, whose
+ *        content type is only carried by the inner plaintext.
+ */
+static void tfm_tls_record_test_1003(struct test_result_t *ret)
+{
+    uint32_t client, server;
+    size_t record_length;
+    psa_status_t status;
+    uint32_t i;
+
+    if ((tls_record_test_setup(&client, TFM_TLS_RECORD_VERSION_1_3,
+                               PSA_ALG_GCM, 128, 0) != PSA_SUCCESS) ||
+        (tls_record_test_setup(&server, TFM_TLS_RECORD_VERSION_1_3,
+                               PSA_ALG_GCM, 128, 1) != PSA_SUCCESS)) {
+        TEST_FAIL("Setting up the connections should not fail");
+        return;
+    }
+
+    for (i = 0; i < 2; i++) {
+        if (!tls_record_test_protect(client, tls13_gcm_record[i],
+                                     sizeof(tls13_gcm_record[i]))) {
+            TEST_FAIL("The record should match the known answer");
+            goto abort;
+        }
+
+        if (!tls_record_test_unprotect(server, tls13_gcm_record[i],
+                                       sizeof(tls13_gcm_record[i]),
+                                       TLS_RECORD_TEST_APP_DATA)) {
+            TEST_FAIL("The server should decrypt the client record");
+            goto abort;
+        }
+    }
+
+    status = psa_tls_record_protect(server, TLS_RECORD_TEST_HANDSHAKE,
+                                    tls_record_test_plaintext,
+                                    sizeof(tls_record_test_plaintext),
+                                    tls_record_test_record,
+                                    sizeof(tls_record_test_record),
+                                    &record_length);
+    if ((status != PSA_SUCCESS) ||
+        (tls_record_test_record[0] != TLS_RECORD_TEST_APP_DATA)) {
+        TEST_FAIL("The record should be protected as application data");
+        goto abort;
+    }
+
+    if (!tls_record_test_unprotect(client, tls_record_test_record,
+                                   record_length,
+                                   TLS_RECORD_TEST_HANDSHAKE)) {
+        TEST_FAIL("The client should read the inner content type");
+        goto abort;
+    }
+
+    ret->val = TEST_PASSED;
+
+abort:
+    (void)psa_tls_record_abort(&client);
+    (void)psa_tls_record_abort(&server);
+}
+
+/**
+ * \brief Checks that altered, replayed and malformed records are rejected,
+ *        and that a rejected record does not advance the sequence number.
+ */
+static void tfm_tls_record_test_1004(struct test_result_t *ret)
+{
+    const size_t record_size = sizeof(tls12_gcm_record[0]);
+    uint32_t server, server_13;
+    size_t plaintext_length;
+    uint8_t content_type;
+    psa_status_t status;
+
+    if ((tls_record_test_setup(&server, TFM_TLS_RECORD_VERSION_1_2,
+                               PSA_ALG_GCM, 128, 1) != PSA_SUCCESS) ||
+        (tls_record_test_setup(&server_13, TFM_TLS_RECORD_VERSION_1_3,
+                               PSA_ALG_GCM, 128, 1) != PSA_SUCCESS)) {
+        TEST_FAIL("Setting up the connections should not fail");
+        return;
+    }
+
+    memcpy(tls_record_test_record, tls12_gcm_record[0], record_size);
+    tls_record_test_record[record_size / 2] ^= 1U;
+    status = psa_tls_record_unprotect(server, tls_record_test_record,
+                                      record_size, &content_type,
+                                      tls_record_test_output,
+                                      sizeof(tls_record_test_output),
+                                      &plaintext_length);
+    if (status != PSA_ERROR_INVALID_SIGNATURE) {
+        TEST_FAIL("An altered record should not be authentic");
+        goto abort;
+    }
+
+    /* The header is authenticated too */
+    memcpy(tls_record_test_record, tls12_gcm_record[0], record_size);
+    tls_record_test_record[0] = TLS_RECORD_TEST_HANDSHAKE;
+    status = psa_tls_record_unprotect(server, tls_record_test_record,
+                                      record_size, &content_type,
+                                      tls_record_test_output,
+                                      sizeof(tls_record_test_output),
+                                      &plaintext_length);
+    if (status != PSA_ERROR_INVALID_SIGNATURE) {
+        TEST_FAIL("A record of another type should not be authentic");
+        goto abort;
+    }
+
+    if (!tls_record_test_unprotect(server, tls12_gcm_record[0], record_size,
+                                   TLS_RECORD_TEST_APP_DATA)) {
+        TEST_FAIL("The genuine record should still be accepted");
+        goto abort;
+    }
+
+    status = psa_tls_record_unprotect(server, tls12_gcm_record[0],
+                                      record_size, &content_type,
+                                      tls_record_test_output,
+                                      sizeof(tls_record_test_output),
+                                      &plaintext_length);
+    if (status != PSA_ERROR_INVALID_SIGNATURE) {
+        TEST_FAIL("A replayed record should not be authentic");
+        goto abort;
+    }
+
+    memcpy(tls_record_test_record, tls12_gcm_record[1], record_size);
+    tls_record_test_record[2] = 0x02;
+    status = psa_tls_record_unprotect(server, tls_record_test_record,
+                                      record_size, &content_type,
+                                      tls_record_test_output,
+                                      sizeof(tls_record_test_output),
+                                      &plaintext_length);
+    if (status != PSA_ERROR_INVALID_ARGUMENT) {
+        TEST_FAIL("A record of another version should be rejected");
+        goto abort;
+    }
+
+    status = psa_tls_record_unprotect(server, tls12_gcm_record[1],
+                                      record_size - 1, &content_type,
+                                      tls_record_test_output,
+                                      sizeof(tls_record_test_output),
+                                      &plaintext_length);
+    if (status != PSA_ERROR_INVALID_ARGUMENT) {
+        TEST_FAIL("A truncated record should be rejected");
+        goto abort;
+    }
+
+    if (!tls_record_test_unprotect(server, tls12_gcm_record[1], record_size,
+                                   TLS_RECORD_TEST_APP_DATA)) {
+        TEST_FAIL("The next record should be accepted");
+        goto abort;
+    }
+
+    /* The protected records of TLS 1.3 are all of the application data
+     * type
+     */
+    memcpy(tls_record_test_record, tls13_gcm_record[0],
+           sizeof(tls13_gcm_record[0]));
+    tls_record_test_record[0] = TLS_RECORD_TEST_HANDSHAKE;
+    status = psa_tls_record_unprotect(server_13, tls_record_test_record,
+                                      sizeof(tls13_gcm_record[0]),
+                                      &content_type, tls_record_test_output,
+                                      sizeof(tls_record_test_output),
+                                      &plaintext_length);
+    if (status != PSA_ERROR_INVALID_ARGUMENT) {
+        TEST_FAIL("A TLS 1.3 record of another type should be rejected");
+        goto abort;
+    }
+
+    ret->val = TEST_PASSED;
+
+abort:
+    (void)psa_tls_record_abort(&server);
+    (void)psa_tls_record_abort(&server_13);
+}
+
+/**
+ * \brief Checks the rejection of invalid parameters, buffers and handles.
+ */
+static void tfm_tls_record_test_1005(struct test_result_t *ret)
+{
+    struct tfm_tls_record_params params = {
+        .version = TFM_TLS_RECORD_VERSION_1_2,
+        .alg = PSA_ALG_GCM,
+        .hash_alg = PSA_ALG_SHA_256,
+        .key_bits = 128,
+        .is_server = 0,
+    };
+    uint32_t client = TFM_TLS_RECORD_INVALID_HANDLE;
+    size_t record_length;
+    size_t plaintext_length;
+    uint8_t content_type;
+    psa_status_t status;
+
+    tls_record_test_fill();
+
+    params.version = 0x0302;
+    status = psa_tls_record_setup(&client, &params, tls_record_test_master,
+                                  sizeof(tls_record_test_master),
+                                  tls_record_test_randoms,
+                                  sizeof(tls_record_test_randoms));
+    if (status != PSA_ERROR_NOT_SUPPORTED) {
+        TEST_FAIL("TLS 1.1 should not be supported");
+        return;
+    }
+
+    params.version = TFM_TLS_RECORD_VERSION_1_2;
+    params.alg = PSA_ALG_CCM;
+    status = psa_tls_record_setup(&client, &params, tls_record_test_master,
+                                  sizeof(tls_record_test_master),
+                                  tls_record_test_randoms,
+                                  sizeof(tls_record_test_randoms));
+    if (status != PSA_ERROR_NOT_SUPPORTED) {
+        TEST_FAIL("AES-CCM should not be supported");
+        return;
+    }
+
+    params.alg = PSA_ALG_GCM;
+    params.key_bits = 192;
+    status = psa_tls_record_setup(&client, &params, tls_record_test_master,
+                                  sizeof(tls_record_test_master),
+                                  tls_record_test_randoms,
+                                  sizeof(tls_record_test_randoms));
+    if (status != PSA_ERROR_INVALID_ARGUMENT) {
+        TEST_FAIL("AES-192 is not used by any suite");
+        return;
+    }
+
+    params.key_bits = 128;
+    status = psa_tls_record_setup(&client, &params, tls_record_test_master,
+                                  sizeof(tls_record_test_master), NULL, 0);
+    if (status != PSA_ERROR_INVALID_ARGUMENT) {
+        TEST_FAIL("TLS 1.2 should need the randoms");
+        return;
+    }
+
+    params.version = TFM_TLS_RECORD_VERSION_1_3;
+    status = psa_tls_record_setup(&client, &params, tls_record_test_secrets,
+                                  TLS_RECORD_TEST_SECRET_SIZE, NULL, 0);
+    if (status != PSA_ERROR_INVALID_ARGUMENT) {
+        TEST_FAIL("TLS 1.3 should need the secrets of both sides");
+        return;
+    }
+
+    if (client != TFM_TLS_RECORD_INVALID_HANDLE) {
+        TEST_FAIL("A failed setup should not return a connection");
+        return;
+    }
+
+    status = psa_tls_record_protect(TFM_TLS_RECORD_INVALID_HANDLE,
+                                    TLS_RECORD_TEST_APP_DATA,
+                                    tls_record_test_plaintext,
+                                    sizeof(tls_record_test_plaintext),
+                                    tls_record_test_record,
+                                    sizeof(tls_record_test_record),
+                                    &record_length);
+    if (status != PSA_ERROR_INVALID_HANDLE) {
+        TEST_FAIL("The invalid handle should be rejected");
+        return;
+    }
+
+    if (tls_record_test_setup(&client, TFM_TLS_RECORD_VERSION_1_2,
+                              PSA_ALG_GCM, 128, 0) != PSA_SUCCESS) {
+        TEST_FAIL("Setting up the connection should not fail");
+        return;
+    }
+
+    status = psa_tls_record_protect(client, TLS_RECORD_TEST_APP_DATA,
+                                    tls_record_test_plaintext,
+                                    sizeof(tls_record_test_plaintext),
+                                    tls_record_test_record,
+                                    sizeof(tls12_gcm_record[0]) - 1,
+                                    &record_length);
+    if ((status != PSA_ERROR_BUFFER_TOO_SMALL) || (record_length != 0)) {
+        TEST_FAIL("A record larger than the buffer should be rejected");
+        goto abort;
+    }
+
+    /* The record which did not fit does not use a sequence number */
+    if (!tls_record_test_protect(client, tls12_gcm_record[0],
+                                 sizeof(tls12_gcm_record[0]))) {
+        TEST_FAIL("The record should match the known answer");
+        goto abort;
+    }
+
+    status = psa_tls_record_unprotect(client, tls12_gcm_record[0],
+                                      sizeof(tls12_gcm_record[0]),
+                                      &content_type, tls_record_test_output,
+                                      TLS_RECORD_TEST_PLAINTEXT_SIZE - 1,
+                                      &plaintext_length);
+    if (status != PSA_ERROR_BUFFER_TOO_SMALL) {
+        TEST_FAIL("A plaintext larger than the buffer should be rejected");
+        goto abort;
+    }
+
+    if (psa_tls_record_abort(&client) != PSA_SUCCESS) {
+        TEST_FAIL("Aborting the connection should not fail");
+        return;
+    }
+
+    if (client != TFM_TLS_RECORD_INVALID_HANDLE) {
+        TEST_FAIL("The handle should be invalid after the abort");
+        return;
+    }
+
+    /* 1 is the handle of the first connection of the partition */
+    status = psa_tls_record_protect(1, TLS_RECORD_TEST_APP_DATA,
+                                    tls_record_test_plaintext,
+                                    sizeof(tls_record_test_plaintext),
+                                    tls_record_test_record,
+                                    sizeof(tls_record_test_record),
+                                    &record_length);
+    if (status != PSA_ERROR_INVALID_HANDLE) {
+        TEST_FAIL("An aborted connection should not be used");
+        return;
+    }
+
+    if (psa_tls_record_abort(&client) != PSA_SUCCESS) {
+        TEST_FAIL("Aborting an invalid connection should have no effect");
+        return;
+    }
+
+    ret->val = TEST_PASSED;
+    return;
+
+abort:
+    (void)psa_tls_record_abort(&client);
+}
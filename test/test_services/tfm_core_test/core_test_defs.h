@@ -39,6 +39,8 @@ enum irq_test_scenario_t {
     IRQ_TEST_SCENARIO_3,
     IRQ_TEST_SCENARIO_4,
     IRQ_TEST_SCENARIO_5,
+    IRQ_TEST_SCENARIO_LATENCY_IDLE,
+    IRQ_TEST_SCENARIO_LATENCY_LOADED,
 };
 
 struct irq_test_execution_data_t {
@@ -46,6 +48,27 @@ struct irq_test_execution_data_t {
     volatile int32_t timer1_triggered;
 };
 
+/* Number of timer interrupts a latency scenario is measured over */
+#ifndef IRQ_TEST_LATENCY_SAMPLES
+#define IRQ_TEST_LATENCY_SAMPLES 8
+#endif
+
+/* Latency of a point of the interrupt handling, in ticks of the secure timer
+ * since the assertion of the timer interrupt
+ */
+struct irq_test_latency_stage_t {
+    uint32_t min;
+    uint32_t max;
+    uint32_t sum;
+};
+
+/* Result of a latency scenario, written by the execute_test_scenario call */
+struct irq_test_latency_t {
+    uint32_t samples;                       /* Interrupts measured so far  */
+    struct irq_test_latency_stage_t wake;   /* Return of psa_wait()        */
+    struct irq_test_latency_stage_t eoi;    /* Return of psa_eoi()         */
+};
+
 /* Use lower 16 bits in return value for error code, upper 16 for line number
  * in test service
  */
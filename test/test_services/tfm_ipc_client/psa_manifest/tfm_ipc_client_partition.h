@@ -19,6 +19,7 @@ extern "C" {
 #define IPC_CLIENT_TEST_PSA_ACCESS_APP_READ_ONLY_MEM_SIGNAL     (1U << (2 + 4))
 #define IPC_CLIENT_TEST_APP_ACCESS_PSA_MEM_SIGNAL               (1U << (3 + 4))
 #define IPC_CLIENT_TEST_MEM_CHECK_SIGNAL                        (1U << (4 + 4))
+#define IPC_CLIENT_TEST_BENCH_SIGNAL                            (1U << (5 + 4))
 
 #ifdef __cplusplus
 }
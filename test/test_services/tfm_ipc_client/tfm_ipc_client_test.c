@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -13,6 +13,7 @@
 #include "psa_manifest/tfm_ipc_client_partition.h"
 #include "tfm_utils.h"
 #include "psa_manifest/sid.h"
+#include "test/test_services/tfm_ipc_service/tfm_ipc_bench.h"
 
 /* Define the return status */
 #define IPC_SP_TEST_SUCCESS     (1)
@@ -30,6 +31,12 @@ uint32_t service_in_use = 0;
  */
 char const client_data_read_only = 'A';
 
+/*
+ * Payload of the benchmark calls. The input and output vectors of a call may
+ * share it, as only input vectors must not overlap.
+ */
+static uint8_t ipc_bench_buf[IPC_BENCH_MAX_SIZE];
+
 /*
  * Fixme: Temporarily implement abort as infinite loop,
  * will replace it later.
@@ -223,6 +230,77 @@ static void ipc_client_handle_ser_req(psa_msg_t msg, uint32_t signals,
     }
 }
 
+static psa_status_t ipc_client_bench_run(const struct ipc_bench_req *req)
+{
+    psa_handle_t handle;
+    psa_status_t status = PSA_SUCCESS;
+    uint32_t i;
+    psa_invec invecs[1] = {{ipc_bench_buf, req->size}};
+    psa_outvec outvecs[1] = {{ipc_bench_buf, req->size}};
+    size_t vec_num = (req->size != 0) ? 1 : 0;
+
+    if (req->size > sizeof(ipc_bench_buf)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    switch (req->op) {
+    case IPC_BENCH_OP_CONNECT_CLOSE:
+        for (i = 0; i < req->loops; i++) {
+            handle = psa_connect(IPC_SERVICE_TEST_BENCH_SID,
+                                 IPC_SERVICE_TEST_BENCH_VERSION);
+            if (handle <= 0) {
+                return PSA_ERROR_CONNECTION_REFUSED;
+            }
+            psa_close(handle);
+        }
+        return PSA_SUCCESS;
+    case IPC_BENCH_OP_CALL:
+        handle = psa_connect(IPC_SERVICE_TEST_BENCH_SID,
+                             IPC_SERVICE_TEST_BENCH_VERSION);
+        if (handle <= 0) {
+            return PSA_ERROR_CONNECTION_REFUSED;
+        }
+        for (i = 0; i < req->loops && status == PSA_SUCCESS; i++) {
+            status = psa_call(handle, PSA_IPC_CALL, invecs, vec_num,
+                              outvecs, vec_num);
+        }
+        psa_close(handle);
+        return status;
+    default:
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+}
+
+/*
+ * Runs the S to S benchmark operation requested by the caller, whose cost is
+ * measured on the caller side.
+ */
+static void ipc_client_bench(psa_msg_t msg)
+{
+    struct ipc_bench_req req;
+    psa_status_t status;
+
+    switch (msg.type) {
+    case PSA_IPC_CONNECT:
+    case PSA_IPC_DISCONNECT:
+        psa_reply(msg.handle, PSA_SUCCESS);
+        break;
+    case PSA_IPC_CALL:
+        if (msg.in_size[0] != sizeof(req) ||
+            psa_read(msg.handle, 0, &req, sizeof(req)) != sizeof(req)) {
+            status = PSA_ERROR_INVALID_ARGUMENT;
+        } else {
+            status = ipc_client_bench_run(&req);
+        }
+        psa_reply(msg.handle, status);
+        break;
+    default:
+        /* cannot get here? [broken SPM]. TODO*/
+        tfm_abort();
+        break;
+    }
+}
+
 void ipc_client_test_main(void)
 {
     psa_msg_t msg;
@@ -256,6 +334,8 @@ void ipc_client_test_main(void)
             ipc_client_handle_ser_req(msg, IPC_CLIENT_TEST_MEM_CHECK_SIGNAL,
                                       &ipc_client_mem_check_test);
 #endif
+        } else if (signals & IPC_CLIENT_TEST_BENCH_SIGNAL) {
+            ipc_client_bench(msg);
         } else {
             /* Should not go here. */
             tfm_abort();
@@ -19,6 +19,8 @@ extern "C" {
 #define IPC_SERVICE_TEST_PSA_ACCESS_APP_READ_ONLY_MEM_SIGNAL    (1U << (2 + 4))
 #define IPC_SERVICE_TEST_APP_ACCESS_PSA_MEM_SIGNAL              (1U << (3 + 4))
 #define IPC_SERVICE_TEST_CLIENT_PROGRAMMER_ERROR_SIGNAL         (1U << (4 + 4))
+#define IPC_SERVICE_TEST_BENCH_SIGNAL                           (1U << (5 + 4))
+#define IPC_SERVICE_TEST_STATELESS_SIGNAL                       (1U << (6 + 4))
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __TFM_IPC_BENCH_H__
+#define __TFM_IPC_BENCH_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Largest payload of a benchmark call, in each direction */
+#define IPC_BENCH_MAX_SIZE          4096
+
+/*
+ * Call type of IPC_SERVICE_TEST_BENCH which writes to the first output vector
+ * the cycle count read when the service partition returned from psa_wait() to
+ * handle the call. The cycle count is a uint32_t.
+ */
+#define IPC_BENCH_CALL_STAMP        (1)
+
+/*
+ * Call type of IPC_SERVICE_TEST_BENCH which maps all the vectors of the call,
+ * and writes in place to the first output vector the bytes of the first input
+ * vector, each inverted. The first output vector is unmapped with the number
+ * of bytes written, the second is left mapped. The service replies
+ * PSA_ERROR_GENERIC_ERROR if a vector of length zero is not mapped to NULL.
+ */
+#define IPC_BENCH_CALL_MAP          (2)
+
+/*
+ * Call types of IPC_SERVICE_TEST_BENCH which use psa_map_invec() and
+ * psa_map_outvec() in a way that is a PROGRAMMER ERROR, so they never return.
+ */
+#define IPC_BENCH_CALL_MAP_TWICE        (3) /* Maps the first input twice */
+#define IPC_BENCH_CALL_MAP_AFTER_READ   (4) /* Reads, then maps the first
+                                             * input
+                                             */
+#define IPC_BENCH_CALL_UNMAP_OVERSIZE   (5) /* Unmaps the first output with a
+                                             * length over its size
+                                             */
+#define IPC_BENCH_CALL_UNMAP_UNMAPPED   (6) /* Unmaps the first output, which
+                                             * is not mapped
+                                             */
+
+/*
+ * Call type of IPC_SERVICE_TEST_BENCH which is only replied, with PSA_SUCCESS,
+ * when the service gets its next message. It lets a client submitting it with
+ * psa_call_async() see the call in progress.
+ */
+#define IPC_BENCH_CALL_DEFER        (7)
+
+/*
+ * Call type of IPC_SERVICE_TEST_BENCH which inverts in place each byte of the
+ * buffer of the IPC_SERVICE_TEST shared memory channel, of which the service
+ * partition is the producer. The service replies PSA_ERROR_GENERIC_ERROR if
+ * tfm_shm_get() does not give the buffer.
+ */
+#define IPC_BENCH_CALL_SHM          (8)
+
+/* Operations of IPC_CLIENT_TEST_BENCH */
+#define IPC_BENCH_OP_CALL           (0) /* Calls to IPC_SERVICE_TEST_BENCH */
+#define IPC_BENCH_OP_CONNECT_CLOSE  (1) /* Connections to the same service */
+
+/*
+ * Request of a call to IPC_CLIENT_TEST_BENCH, given as the first input vector.
+ * The client partition repeats the operation the given number of times. The
+ * calls share one connection, opened before the first call, and each of them
+ * sends and receives size bytes.
+ */
+struct ipc_bench_req {
+    uint32_t op;    /* IPC_BENCH_OP_CALL or IPC_BENCH_OP_CONNECT_CLOSE */
+    uint32_t size;  /* Payload size of a call, up to IPC_BENCH_MAX_SIZE */
+    uint32_t loops; /* Number of times the operation is repeated */
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TFM_IPC_BENCH_H__ */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -8,12 +8,19 @@
 #include <assert.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <string.h>
 #include "psa/client.h"
 #include "psa/service.h"
 #include "secure_utilities.h"
 #include "tfm_secure_api.h"
 #include "tfm_api.h"
 #include "psa_manifest/tfm_ipc_service_partition.h"
+#include "tfm_hal_device_header.h"
+#include "tfm_ipc_bench.h"
+#ifdef TFM_SHM_CHANNELS
+#include "psa_manifest/sid.h"
+#include "secure_fw/include/tfm_spm_services_api.h"
+#endif
 
 #define IPC_SERVICE_BUFFER_LEN                          32
 
@@ -24,6 +31,30 @@ static uint32_t service_in_use = 0;
 uint8_t ipc_servic_data;
 uint8_t *ipc_service_data_p = &ipc_servic_data;
 
+/* Payload buffer of the IPC_SERVICE_TEST_BENCH service. */
+static uint8_t ipc_bench_buf[IPC_BENCH_MAX_SIZE];
+
+/* Cycle count read when the partition woke up for the current message. */
+static uint32_t ipc_bench_wake_cycles;
+
+/* IPC_BENCH_CALL_DEFER message not replied yet. */
+static psa_handle_t ipc_bench_deferred = PSA_NULL_HANDLE;
+
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || \
+    defined(__ARM_ARCH_8M_MAIN__) || defined(__ARM_ARCH_8_1M_MAIN__)
+/* The counter is enabled by the benchmark, which reads it on its side too. */
+static inline uint32_t ipc_bench_cycles(void)
+{
+    return DWT->CYCCNT;
+}
+#else
+static inline uint32_t ipc_bench_cycles(void)
+{
+    /* Baseline architectures have no cycle counter */
+    return 0;
+}
+#endif
+
 /*
  * Fixme: Temporarily implement abort as infinite loop,
  * will replace it later.
@@ -261,6 +292,173 @@ static void ipc_service_programmer_error(void)
     }
 }
 
+/* Handles IPC_BENCH_CALL_MAP, see tfm_ipc_bench.h */
+static psa_status_t ipc_bench_map(const psa_msg_t *msg)
+{
+    const uint8_t *in_vecs[PSA_MAX_IOVEC];
+    uint8_t *out_vecs[PSA_MAX_IOVEC];
+    size_t len;
+    size_t j;
+    uint32_t i;
+
+    for (i = 0; i < PSA_MAX_IOVEC; i++) {
+        in_vecs[i] = psa_map_invec(msg->handle, i);
+        out_vecs[i] = psa_map_outvec(msg->handle, i);
+        if (((in_vecs[i] == NULL) != (msg->in_size[i] == 0)) ||
+            ((out_vecs[i] == NULL) != (msg->out_size[i] == 0))) {
+            return PSA_ERROR_GENERIC_ERROR;
+        }
+    }
+
+    len = msg->in_size[0] < msg->out_size[0] ?
+          msg->in_size[0] : msg->out_size[0];
+    for (j = 0; j < len; j++) {
+        out_vecs[0][j] = (uint8_t)~in_vecs[0][j];
+    }
+
+    for (i = 0; i < PSA_MAX_IOVEC; i++) {
+        psa_unmap_invec(msg->handle, i);
+    }
+    psa_unmap_outvec(msg->handle, 0, len);
+    if (out_vecs[1] != NULL) {
+        /* Reported as empty, as it is still mapped on psa_reply() */
+        memset(out_vecs[1], 0, msg->out_size[1]);
+    }
+    for (i = 2; i < PSA_MAX_IOVEC; i++) {
+        psa_unmap_outvec(msg->handle, i, 0);
+    }
+
+    return PSA_SUCCESS;
+}
+
+#ifdef TFM_SHM_CHANNELS
+/* Handles IPC_BENCH_CALL_SHM, see tfm_ipc_bench.h */
+static psa_status_t ipc_bench_shm(void)
+{
+    uint8_t *buf = tfm_shm_get(IPC_SERVICE_TEST_SHM_ID);
+    uint32_t i;
+
+    if (buf == NULL) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    for (i = 0; i < IPC_SERVICE_TEST_SHM_SIZE; i++) {
+        buf[i] = (uint8_t)~buf[i];
+    }
+
+    return PSA_SUCCESS;
+}
+#endif
+
+static void ipc_service_bench(void)
+{
+    psa_msg_t msg;
+    size_t len;
+    int i;
+
+    psa_get(IPC_SERVICE_TEST_BENCH_SIGNAL, &msg);
+    if (ipc_bench_deferred != PSA_NULL_HANDLE) {
+        psa_reply(ipc_bench_deferred, PSA_SUCCESS);
+        ipc_bench_deferred = PSA_NULL_HANDLE;
+    }
+
+    switch (msg.type) {
+    case PSA_IPC_CONNECT:
+    case PSA_IPC_DISCONNECT:
+        /* Any number of connections, connecting is what is measured. */
+        psa_reply(msg.handle, PSA_SUCCESS);
+        break;
+    case PSA_IPC_CALL:
+        for (i = 0; i < PSA_MAX_IOVEC; i++) {
+            if (msg.in_size[i] != 0) {
+                (void)psa_read(msg.handle, i, ipc_bench_buf,
+                               sizeof(ipc_bench_buf));
+            }
+        }
+        for (i = 0; i < PSA_MAX_IOVEC; i++) {
+            len = msg.out_size[i];
+            if (len > sizeof(ipc_bench_buf)) {
+                len = sizeof(ipc_bench_buf);
+            }
+            if (len != 0) {
+                psa_write(msg.handle, i, ipc_bench_buf, len);
+            }
+        }
+        psa_reply(msg.handle, PSA_SUCCESS);
+        break;
+    case IPC_BENCH_CALL_STAMP:
+        if (msg.out_size[0] >= sizeof(ipc_bench_wake_cycles)) {
+            psa_write(msg.handle, 0, &ipc_bench_wake_cycles,
+                      sizeof(ipc_bench_wake_cycles));
+        }
+        psa_reply(msg.handle, PSA_SUCCESS);
+        break;
+    case IPC_BENCH_CALL_MAP:
+        psa_reply(msg.handle, ipc_bench_map(&msg));
+        break;
+    case IPC_BENCH_CALL_DEFER:
+        ipc_bench_deferred = msg.handle;
+        break;
+#ifdef TFM_SHM_CHANNELS
+    case IPC_BENCH_CALL_SHM:
+        psa_reply(msg.handle, ipc_bench_shm());
+        break;
+#endif
+    case IPC_BENCH_CALL_MAP_TWICE:
+        (void)psa_map_invec(msg.handle, 0);
+        (void)psa_map_invec(msg.handle, 0);
+        /* Should not come here */
+        tfm_abort();
+        break;
+    case IPC_BENCH_CALL_MAP_AFTER_READ:
+        (void)psa_read(msg.handle, 0, ipc_bench_buf, sizeof(ipc_bench_buf));
+        (void)psa_map_invec(msg.handle, 0);
+        /* Should not come here */
+        tfm_abort();
+        break;
+    case IPC_BENCH_CALL_UNMAP_OVERSIZE:
+        (void)psa_map_outvec(msg.handle, 0);
+        psa_unmap_outvec(msg.handle, 0, msg.out_size[0] + 1);
+        /* Should not come here */
+        tfm_abort();
+        break;
+    case IPC_BENCH_CALL_UNMAP_UNMAPPED:
+        psa_unmap_outvec(msg.handle, 0, 0);
+        /* Should not come here */
+        tfm_abort();
+        break;
+    default:
+        psa_reply(msg.handle, PSA_ERROR_NOT_SUPPORTED);
+        break;
+    }
+}
+
+static void ipc_service_stateless(void)
+{
+    psa_msg_t msg;
+    uint8_t buf[IPC_SERVICE_BUFFER_LEN];
+    size_t len;
+
+    psa_get(IPC_SERVICE_TEST_STATELESS_SIGNAL, &msg);
+    switch (msg.type) {
+    case PSA_IPC_CALL:
+        /* Echo the first input vector to the first output vector */
+        len = psa_read(msg.handle, 0, buf, sizeof(buf));
+        if (len > msg.out_size[0]) {
+            len = msg.out_size[0];
+        }
+        if (len != 0) {
+            psa_write(msg.handle, 0, buf, len);
+        }
+        psa_reply(msg.handle, PSA_SUCCESS);
+        break;
+    default:
+        /* A stateless service gets no connect or disconnect message */
+        tfm_abort();
+        break;
+    }
+}
+
 /* Test thread */
 void ipc_service_test_main(void *param)
 {
@@ -268,6 +466,7 @@ void ipc_service_test_main(void *param)
 
     while (1) {
         signals = psa_wait(PSA_WAIT_ANY, PSA_BLOCK);
+        ipc_bench_wake_cycles = ipc_bench_cycles();
         if (signals & IPC_SERVICE_TEST_BASIC_SIGNAL) {
             ipc_service_basic();
         } else if (signals & IPC_SERVICE_TEST_PSA_ACCESS_APP_MEM_SIGNAL) {
@@ -284,6 +483,10 @@ void ipc_service_test_main(void *param)
 #endif
         } else if (signals & IPC_SERVICE_TEST_CLIENT_PROGRAMMER_ERROR_SIGNAL) {
             ipc_service_programmer_error();
+        } else if (signals & IPC_SERVICE_TEST_BENCH_SIGNAL) {
+            ipc_service_bench();
+        } else if (signals & IPC_SERVICE_TEST_STATELESS_SIGNAL) {
+            ipc_service_stateless();
         } else {
             /* Should not come here */
             tfm_abort();
@@ -1,11 +1,13 @@
 /*
- * Copyright (c) 2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
  */
 
+#include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include "tfm_api.h"
 #include "tfm_veneers.h"
 #include "secure_utilities.h"
@@ -22,6 +24,9 @@ static struct irq_test_execution_data_t *current_execution_data;
 
 #ifdef TFM_PSA_API
 static psa_handle_t execute_msg_handle = -1;
+
+/* Latency measured by the current latency scenario */
+static struct irq_test_latency_t irq_latency;
 #endif
 
 /**
@@ -45,11 +50,86 @@ static void stop_timer(void)
     tfm_plat_test_secure_timer_stop();
 }
 
+#ifdef TFM_PSA_API
+static void irq_test_latency_reset_stage(struct irq_test_latency_stage_t *stage)
+{
+    stage->min = UINT32_MAX;
+    stage->max = 0;
+    stage->sum = 0;
+}
+
+static void irq_test_latency_add(struct irq_test_latency_stage_t *stage,
+                                 uint32_t ticks)
+{
+    if (ticks < stage->min) {
+        stage->min = ticks;
+    }
+    if (ticks > stage->max) {
+        stage->max = ticks;
+    }
+    stage->sum += ticks;
+}
+
+/**
+ * \brief Handles a timer interrupt of a latency scenario, right after the
+ *        return of psa_wait().
+ *
+ * The points are timed with the secure timer, which keeps running after it
+ * asserts its interrupt, so that the measure also works when the partition
+ * runs unprivileged. The timer is stopped after the last sample.
+ */
+static void irq_test_latency_handle_irq(void)
+{
+    uint32_t wake = tfm_plat_test_secure_timer_get_elapsed();
+    uint32_t eoi;
+
+    /* Only the interrupt is cleared, so that the timer times psa_eoi() and
+     * the interrupt is not asserted again when the SPM enables the line.
+     */
+    tfm_plat_test_secure_timer_clear_intr();
+    psa_eoi(SPM_CORE_IRQ_TEST_1_SIGNAL_TIMER_0_IRQ);
+    eoi = tfm_plat_test_secure_timer_get_elapsed();
+
+    if (irq_latency.samples >= IRQ_TEST_LATENCY_SAMPLES) {
+        return;
+    }
+
+    irq_test_latency_add(&irq_latency.wake, wake);
+    irq_test_latency_add(&irq_latency.eoi, eoi);
+    irq_latency.samples++;
+
+    if (irq_latency.samples == IRQ_TEST_LATENCY_SAMPLES) {
+        stop_timer();
+    }
+}
+
+static bool irq_test_is_latency_scenario(uint32_t irq_test_scenario)
+{
+    return (irq_test_scenario == IRQ_TEST_SCENARIO_LATENCY_IDLE) ||
+           (irq_test_scenario == IRQ_TEST_SCENARIO_LATENCY_LOADED);
+}
+#endif /* TFM_PSA_API */
+
 uint32_t spm_irq_test_1_prepare_test_scenario_internal(
                                enum irq_test_scenario_t irq_test_scenario,
                                struct irq_test_execution_data_t *execution_data)
 {
     current_scenario = irq_test_scenario;
+
+#ifdef TFM_PSA_API
+    /* The latency scenarios do not use the execution data, so that they also
+     * run when the partition cannot access the non-secure memory.
+     */
+    if (irq_test_is_latency_scenario(irq_test_scenario)) {
+        current_execution_data = NULL;
+        irq_latency.samples = 0;
+        irq_test_latency_reset_stage(&irq_latency.wake);
+        irq_test_latency_reset_stage(&irq_latency.eoi);
+        tfm_plat_test_secure_timer_start();
+        return CORE_TEST_ERRNO_SUCCESS;
+    }
+#endif
+
     current_execution_data = execution_data;
 
     current_execution_data->timer0_triggered = 0;
@@ -220,6 +300,11 @@ static void spm_irq_test_1_signal_handle(psa_signal_t signal,
 
 void TIMER_0_isr_ipc(void)
 {
+    if (irq_test_is_latency_scenario(current_scenario)) {
+        irq_test_latency_handle_irq();
+        return;
+    }
+
     current_execution_data->timer0_triggered = 1;
 
     tfm_plat_test_secure_timer_stop();
@@ -287,6 +372,17 @@ static psa_status_t spm_irq_test_1_wrap_prepare_test_scenario(psa_msg_t *msg)
                                                          execution_data);
 }
 
+static void spm_irq_test_1_reply_latency(psa_msg_t *msg)
+{
+    if (msg->out_size[0] != sizeof(irq_latency)) {
+        psa_reply(msg->handle, CORE_TEST_ERRNO_INVALID_PARAMETER);
+        return;
+    }
+
+    psa_write(msg->handle, 0, &irq_latency, sizeof(irq_latency));
+    psa_reply(msg->handle, CORE_TEST_ERRNO_SUCCESS);
+}
+
 static void spm_irq_test_1_execute_test_scenario_ipc_call(psa_msg_t *msg)
 {
     size_t num;
@@ -343,6 +439,23 @@ static void spm_irq_test_1_execute_test_scenario_ipc_call(psa_msg_t *msg)
         psa_eoi(SPM_CORE_IRQ_TEST_1_SIGNAL_TIMER_0_IRQ);
         psa_reply(msg->handle, CORE_TEST_ERRNO_SUCCESS);
         break;
+    case IRQ_TEST_SCENARIO_LATENCY_IDLE:
+        /* The partition waits for all the samples, the NS side is blocked */
+        while (irq_latency.samples < IRQ_TEST_LATENCY_SAMPLES) {
+            signals = psa_wait(SPM_CORE_IRQ_TEST_1_SIGNAL_TIMER_0_IRQ,
+                               PSA_BLOCK);
+            if (signals & SPM_CORE_IRQ_TEST_1_SIGNAL_TIMER_0_IRQ) {
+                irq_test_latency_handle_irq();
+            }
+        }
+        spm_irq_test_1_reply_latency(msg);
+        return;
+    case IRQ_TEST_SCENARIO_LATENCY_LOADED:
+        /* The interrupts are handled in the main loop while the NS side runs
+         * its load, this call only reads the samples measured so far.
+         */
+        spm_irq_test_1_reply_latency(msg);
+        return;
     default:
         psa_reply(msg->handle, CORE_TEST_ERRNO_INVALID_PARAMETER);
         return;
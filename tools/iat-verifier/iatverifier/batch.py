@@ -0,0 +1,282 @@
+# -----------------------------------------------------------------------------
+# Copyright (c) 2020, Arm Limited. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# -----------------------------------------------------------------------------
+
+import argparse
+import base64
+import hashlib
+import json
+import logging
+import multiprocessing
+import os
+import sys
+
+import cbor
+from ecdsa import BadSignatureError
+
+from iatverifier.util import read_keyfile, recursive_bytes_to_strings
+from iatverifier.verify import decode_and_validate_iat
+
+
+logger = logging.getLogger('iat-verify-batch')
+
+# COSE constants, see RFC 8152
+COSE_SIGN1_TAG = 18
+COSE_HEADER_PARAM_KID = 4
+COSE_KEY_COMMON_KTY = 1
+COSE_KEY_TYPE_EC2 = 2
+COSE_KEY_PARAM_CRV = -1
+COSE_KEY_PARAM_X_COORDINATE = -2
+COSE_KEY_PARAM_Y_COORDINATE = -3
+COSE_ELLIPTIC_CURVE_P_256 = 1
+
+STATUS_OK = 'ok'
+STATUS_BAD_SIGNATURE = 'bad-signature'
+STATUS_UNKNOWN_KEY = 'unknown-key'
+STATUS_BAD_TOKEN = 'bad-token'
+
+# Keys of the current process, set up once by load_keys()
+_keys = {}
+
+
+def cose_key_id(verifying_key):
+    """
+    Return the COSE key ID of a P-256 public key, as computed by the
+    attestation service with INCLUDE_COSE_KEY_ID: the SHA-256 of the key
+    encoded as a COSE_Key.
+    """
+    point = verifying_key.to_string()
+    coord_len = len(point) // 2
+    cose_key = {
+        COSE_KEY_COMMON_KTY: COSE_KEY_TYPE_EC2,
+        COSE_KEY_PARAM_CRV: COSE_ELLIPTIC_CURVE_P_256,
+        COSE_KEY_PARAM_X_COORDINATE: point[:coord_len],
+        COSE_KEY_PARAM_Y_COORDINATE: point[coord_len:],
+    }
+    return hashlib.sha256(cbor.dumps(cose_key)).digest()
+
+
+def load_keys(keyfiles):
+    """
+    Parse the key files into verifying keys indexed by COSE key ID. This is
+    done once per process, rather than once per token.
+    """
+    _keys.clear()
+    for keyfile in keyfiles:
+        key = read_keyfile(keyfile)
+        if hasattr(key, 'get_verifying_key'):
+            key = key.get_verifying_key()
+        if hasattr(key, 'precompute'):
+            # Speeds up each of the verifications with the key
+            key.precompute()
+        _keys[cose_key_id(key)] = key
+    return _keys
+
+
+def _decode_cose_sign1(raw_token):
+    msg = cbor.loads(raw_token)
+    if isinstance(msg, cbor.Tag):
+        if msg.tag != COSE_SIGN1_TAG:
+            raise ValueError('Unexpected CBOR tag {}'.format(msg.tag))
+        msg = msg.value
+    if not isinstance(msg, list) or len(msg) != 4:
+        raise ValueError('Not a COSE_Sign1 array')
+    protected, unprotected, payload, signature = msg
+    if not isinstance(unprotected, dict):
+        unprotected = {}
+    return protected, unprotected, payload, signature
+
+
+def _check_signature(key, protected, payload, signature):
+    sig_structure = cbor.dumps(['Signature1', protected, b'', payload])
+    try:
+        return key.verify(signature, sig_structure, hashfunc=hashlib.sha256)
+    except BadSignatureError:
+        return False
+
+
+def verify_token(raw_token, keep_going=False, strict=False, print_iat=False):
+    """
+    Verify one token with the keys loaded by load_keys() and return the
+    result as a dictionary. The key is selected by the kid of the token; a
+    token without a kid is checked against every key.
+    """
+    result = {}
+    try:
+        protected, unprotected, payload, signature = \
+            _decode_cose_sign1(raw_token)
+    except Exception as e:
+        result['status'] = STATUS_BAD_TOKEN
+        result['error'] = 'Bad COSE: {}'.format(e)
+        return result
+
+    kid = unprotected.get(COSE_HEADER_PARAM_KID)
+    if kid is not None:
+        result['kid'] = kid.hex()
+        candidates = [_keys[kid]] if kid in _keys else []
+    else:
+        candidates = list(_keys.values())
+
+    if _keys:
+        if not candidates:
+            result['status'] = STATUS_UNKNOWN_KEY
+            result['error'] = 'No key for the kid of the token'
+            return result
+        if not any(_check_signature(key, protected, payload, signature)
+                   for key in candidates):
+            result['status'] = STATUS_BAD_SIGNATURE
+            result['error'] = 'Bad signature'
+            return result
+
+    try:
+        token = decode_and_validate_iat(payload, keep_going, strict)
+    except ValueError as e:
+        result['status'] = STATUS_BAD_TOKEN
+        result['error'] = str(e)
+        return result
+
+    result['status'] = STATUS_OK
+    if print_iat:
+        result['token'] = recursive_bytes_to_strings(token, in_place=True)
+    return result
+
+
+def _init_worker(keyfiles):
+    load_keys(keyfiles)
+
+
+def _verify_entry(args):
+    index, entry_id, raw_token, read_error, options = args
+    if read_error:
+        result = {'status': STATUS_BAD_TOKEN, 'error': read_error}
+    else:
+        result = verify_token(raw_token, **options)
+    result['index'] = index
+    if entry_id is not None:
+        result['id'] = entry_id
+    return result
+
+
+def read_entries(stream, paths=False):
+    """
+    Yield (id, raw token, error) for each line of the stream. The lines are
+    either JSON objects with a base64 "token" and an optional "id", or token
+    file paths. The error is None unless the entry could not be read.
+    """
+    for line in stream:
+        line = line.strip()
+        if not line:
+            continue
+        try:
+            if paths:
+                with open(line, 'rb') as fh:
+                    yield line, fh.read(), None
+            else:
+                entry = json.loads(line)
+                yield (entry.get('id'), base64.b64decode(entry['token']),
+                       None)
+        except Exception as e:
+            yield None, None, 'Could not read entry: {}'.format(e)
+
+
+def verify_stream(stream, keyfiles, jobs=None, paths=False, options=None):
+    """
+    Verify the tokens of a stream and yield a result for each of them, in
+    the order of the stream. The tokens are spread over jobs worker
+    processes, which each parse the keys once.
+    """
+    options = options or {}
+    work = ((index,) + entry + (options,)
+            for index, entry in enumerate(read_entries(stream, paths)))
+
+    if jobs == 1:
+        _init_worker(keyfiles)
+        for args in work:
+            yield _verify_entry(args)
+        return
+
+    with multiprocessing.Pool(jobs, _init_worker, (keyfiles,)) as pool:
+        # The chunks keep the inter-process traffic per token low
+        for result in pool.imap(_verify_entry, work, chunksize=64):
+            yield result
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='''
+        Validates a stream of signed Initial Attestation Tokens (IAT) in
+        parallel, and writes one JSON result per token to the output.
+        ''')
+    parser.add_argument('-k', '--keyfile', action='append', default=[],
+                        help='''
+                        Path to a file containing a signing key in PEM
+                        format. Can be given several times; each token is
+                        checked with the key matching its kid.
+                        ''')
+    parser.add_argument('infile', nargs='?', default='-',
+                        help='''
+                        File with one JSON object per line, holding the
+                        base64 "token" and an optional "id". Defaults to
+                        the standard input.
+                        ''')
+    parser.add_argument('-o', '--outfile', default='-',
+                        help='''
+                        File to write the JSON results to, one per line.
+                        Defaults to the standard output.
+                        ''')
+    parser.add_argument('-P', '--paths', action='store_true',
+                        help='''
+                        The lines of the input are paths to token files.
+                        ''')
+    parser.add_argument('-j', '--jobs', type=int, default=os.cpu_count(),
+                        help='''
+                        Number of worker processes. Defaults to the number
+                        of CPUs.
+                        ''')
+    parser.add_argument('-K', '--keep-going', action='store_true',
+                        help='''
+                        Do not stop upon encountering a validation error.
+                        ''')
+    parser.add_argument('-p', '--print-iat', action='store_true',
+                        help='''
+                        Add the decoded token to the result.
+                        ''')
+    parser.add_argument('-s', '--strict', action='store_true',
+                        help='''
+                        Report failure if unknown claim is encountered.
+                        ''')
+    args = parser.parse_args()
+
+    logging.basicConfig(level=logging.INFO)
+
+    try:
+        load_keys(args.keyfile)
+    except ValueError as e:
+        logger.error(e)
+        sys.exit(1)
+
+    options = {
+        'keep_going': args.keep_going,
+        'strict': args.strict,
+        'print_iat': args.print_iat,
+    }
+
+    infile = sys.stdin if args.infile == '-' else open(args.infile)
+    outfile = sys.stdout if args.outfile == '-' else open(args.outfile, 'w')
+
+    counts = {}
+    with infile, outfile:
+        for result in verify_stream(infile, args.keyfile, args.jobs,
+                                    args.paths, options):
+            counts[result['status']] = counts.get(result['status'], 0) + 1
+            outfile.write(json.dumps(result) + '\n')
+
+    logger.info('Verified {} tokens: {}'.format(
+        sum(counts.values()),
+        ', '.join('{} {}'.format(n, s) for s, n in sorted(counts.items()))))
+
+    if set(counts) - {STATUS_OK}:
+        sys.exit(1)
@@ -15,6 +15,7 @@ setup(
     ],
     scripts=[
         'scripts/check_iat',
+        'scripts/check_iat_batch',
         'scripts/compile_token',
         'scripts/decompile_token',
     ],
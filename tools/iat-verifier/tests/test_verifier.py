@@ -5,11 +5,13 @@
 #
 # -----------------------------------------------------------------------------
 
+import io
 import os
 import sys
 import tempfile
 import unittest
 
+from iatverifier.batch import verify_stream
 from iatverifier.util import convert_map_to_token_files
 from iatverifier.verify import extract_iat_from_cose, decode_and_validate_iat
 
@@ -84,3 +86,23 @@ class TestIatVerifier(unittest.TestCase):
     def test_security_lifecycle_decoding(self):
         iat = create_and_read_iat('valid-iat.yaml', KEYFILE)
         self.assertEqual(iat['SECURITY_LIFECYCLE'], 'SL_SECURED')
+
+    def test_batch_verification(self):
+        good_sig = create_token('valid-iat.yaml', KEYFILE)
+        bad_sig = create_token('valid-iat.yaml', KEYFILE_ALT)
+        bad_claim = create_token('missing-claim.yaml', KEYFILE)
+        stream = io.StringIO('\n'.join([good_sig, bad_sig, bad_claim,
+                                         'no-such-token']))
+
+        results = list(verify_stream(stream, [KEYFILE], jobs=1, paths=True))
+
+        self.assertEqual([r['index'] for r in results], [0, 1, 2, 3])
+        self.assertEqual([r['status'] for r in results],
+                         ['ok', 'bad-signature', 'bad-token', 'bad-token'])
+        self.assertIn('missing MANDATORY claim', results[2]['error'])
+
+        # Both keys are cached, and the token is checked against each
+        stream = io.StringIO(bad_sig)
+        results = list(verify_stream(stream, [KEYFILE, KEYFILE_ALT], jobs=2,
+                                     paths=True))
+        self.assertEqual(results[0]['status'], 'ok')
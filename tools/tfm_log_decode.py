@@ -0,0 +1,195 @@
+#-------------------------------------------------------------------------------
+# Copyright (c) 2020, Arm Limited. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+#-------------------------------------------------------------------------------
+
+"""
+Decodes the output of an image built with TFM_LOG_DEFERRED.
+
+The deferred log messages are frames made of the TFM_LOG_FRAME_MARKER byte,
+the number of arguments on one byte, then the address of the format string
+and each argument on four bytes. The format strings, and the strings printed
+with %s, are read from the ELF file of the image. The bytes which are not in a
+frame are copied to the output, so the text printed by the other log functions
+is kept.
+"""
+
+import sys
+import struct
+import argparse
+
+FRAME_MARKER = 0xA5
+MAX_ARGS = 8
+FMT_SECTION = '.tfm_log_fmt'
+
+SHF_ALLOC = 0x2
+SHT_NOBITS = 8
+
+
+class ElfImage(object):
+    """
+    Sections of an ELF file, read without any external package.
+    """
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            self.data = f.read()
+
+        if self.data[:4] != b'\x7fELF':
+            raise ValueError(path + " is not an ELF file")
+
+        is_64 = self.data[4] == 2
+        self.endian = '<' if self.data[5] == 1 else '>'
+
+        if is_64:
+            shoff, = struct.unpack_from(self.endian + 'Q', self.data, 0x28)
+            shentsize, shnum, shstrndx = struct.unpack_from(
+                self.endian + 'HHH', self.data, 0x3A)
+            sh_fmt = self.endian + 'IIQQQQIIQQ'
+        else:
+            shoff, = struct.unpack_from(self.endian + 'I', self.data, 0x20)
+            shentsize, shnum, shstrndx = struct.unpack_from(
+                self.endian + 'HHH', self.data, 0x2E)
+            sh_fmt = self.endian + 'IIIIIIIIII'
+
+        headers = [struct.unpack_from(sh_fmt, self.data, shoff + i * shentsize)
+                   for i in range(shnum)]
+        names_off = headers[shstrndx][4]
+
+        # (name, flags, address, file offset, size) of the sections with data
+        self.sections = []
+        for (name, sh_type, flags, addr, off, size) in \
+                [h[:6] for h in headers]:
+            if sh_type == SHT_NOBITS or size == 0:
+                continue
+            end = self.data.index(b'\0', names_off + name)
+            name = self.data[names_off + name:end].decode()
+            self.sections.append((name, flags, addr, off, size))
+
+    def read_string(self, addr, in_fmt_section):
+        """
+        Returns the NUL terminated string at addr, from the format string
+        section if in_fmt_section is True, otherwise from the loaded sections.
+        """
+        for (name, flags, sec_addr, off, size) in self.sections:
+            if in_fmt_section != (name == FMT_SECTION):
+                continue
+            if not in_fmt_section and not (flags & SHF_ALLOC):
+                continue
+            if sec_addr <= addr < sec_addr + size:
+                start = off + addr - sec_addr
+                end = self.data.find(b'\0', start, off + size)
+                if end < 0:
+                    end = off + size
+                return self.data[start:end].decode('utf-8', 'replace')
+        return None
+
+    def has_fmt_section(self):
+        return any(s[0] == FMT_SECTION for s in self.sections)
+
+
+def format_message(image, fmt, args):
+    """
+    Formats a message as tfm_log_printf() does.
+    """
+    out = []
+    args = list(args)
+    i = 0
+    while i < len(fmt):
+        c = fmt[i]
+        i += 1
+        if c != '%' or i == len(fmt):
+            out.append(c)
+            continue
+        conv = fmt[i]
+        i += 1
+        if conv == '%':
+            out.append('%')
+            continue
+        if conv not in 'dicuxXps':
+            out.append('[Unsupported Tag]')
+            i -= 1
+            continue
+        if not args:
+            out.append('[Missing Argument]')
+            continue
+        arg = args.pop(0)
+        if conv in 'di':
+            out.append(str(arg - (1 << 32) if arg & 0x80000000 else arg))
+        elif conv == 'u':
+            out.append(str(arg))
+        elif conv == 'x':
+            out.append('%x' % arg)
+        elif conv == 'X':
+            out.append('%X' % arg)
+        elif conv == 'p':
+            out.append('0x%x' % arg)
+        elif conv == 'c':
+            out.append(chr(arg & 0xFF))
+        else:
+            string = image.read_string(arg, False)
+            out.append(string if string is not None else '<0x%x>' % arg)
+    return ''.join(out)
+
+
+def decode(image, stream, out):
+    """
+    Decodes the log stream, which is a bytes object.
+    """
+    use_fmt_section = image.has_fmt_section()
+    pos = 0
+    text_start = 0
+
+    while pos < len(stream):
+        if stream[pos] != FRAME_MARKER or pos + 6 > len(stream):
+            pos += 1
+            continue
+
+        nargs = stream[pos + 1]
+        end = pos + 6 + 4 * nargs
+        if nargs > MAX_ARGS or end > len(stream):
+            pos += 1
+            continue
+
+        words = struct.unpack_from(image.endian + 'I' * (1 + nargs),
+                                   stream, pos + 2)
+        fmt = image.read_string(words[0], use_fmt_section)
+        if fmt is None:
+            # Not a frame, or a frame of another image
+            pos += 1
+            continue
+
+        out.write(stream[text_start:pos].decode('utf-8', 'replace'))
+        out.write(format_message(image, fmt, words[1:]))
+        pos = end
+        text_start = pos
+
+    out.write(stream[text_start:].decode('utf-8', 'replace'))
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        description='Decode the deferred log output of a TF-M image')
+    parser.add_argument('elf', help='ELF file of the image, e.g. tfm_s.axf')
+    parser.add_argument('log', nargs='?', default='-',
+                        help='Captured log output, or - (default) to read '
+                             'standard input')
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+    image = ElfImage(args.elf)
+
+    if args.log == '-':
+        stream = sys.stdin.buffer.read()
+    else:
+        with open(args.log, 'rb') as f:
+            stream = f.read()
+
+    decode(image, stream, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
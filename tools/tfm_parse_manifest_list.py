@@ -28,6 +28,10 @@ DEFAULT_GEN_FILE_LIST = os.path.join('tools', 'tfm_generated_file_list.yaml')
 
 OUT_DIR = None # The root directory that files are generated to
 
+# Static handles of stateless RoT Services, keep aligned with spm_api.h
+STATELESS_HANDLE_INDICATOR = 0x40000000
+STATELESS_HANDLE_SID_MASK = 0x00FFFFFF
+
 class TemplateLoader(BaseLoader):
     """
     Template loader class.
@@ -124,6 +128,54 @@ def process_manifest(manifest_list_file, append):
 
     return manifest_header_list, db
 
+def gen_service_sid_list(db):
+    """
+    Collect the RoT Services of all IPC partitions and sort them by SID, so
+    that the SPM can look a service up by SID with a binary search.
+    The static handle of each stateless RoT Service is derived from its SID
+    and stored in the service as 'stateless_handle'.
+
+    Parameters
+    ----------
+    db:
+        The data base generated by process_manifest().
+
+    Returns
+    -------
+    The list of services sorted by SID in ascending order. Each item holds
+    the service, the manifest and the manifest list attributes it comes from.
+    """
+
+    service_list = []
+    sid_owner = {}
+
+    for item in db:
+        if not item["attr"].get("tfm_partition_ipc"):
+            continue
+
+        for service in item["manifest"].get("services", []):
+            sid = int(str(service["sid"]), 0)
+            if sid in sid_owner:
+                print ("Error: SID " + hex(sid) + " of '" + service["name"] +
+                       "' is already used by '" + sid_owner[sid] + "'")
+                exit(1)
+            sid_owner[sid] = service["name"]
+
+            if service.get("connection_based", True) is False:
+                if sid & ~STATELESS_HANDLE_SID_MASK:
+                    print ("Error: SID " + hex(sid) + " of stateless service '" +
+                           service["name"] + "' is out of the static handle range")
+                    exit(1)
+                service["stateless_handle"] = \
+                    "0x%08X" % (STATELESS_HANDLE_INDICATOR | sid)
+
+            service_list.append({"sid": sid,
+                                 "service": service,
+                                 "manifest": item["manifest"],
+                                 "attr": item["attr"]})
+
+    return sorted(service_list, key=lambda service: service["sid"])
+
 def gen_files(context, gen_file_list, append):
     """
     Generate files according to the gen_file_list
@@ -283,6 +335,7 @@ def main():
     utilities['manifest_header_list']=manifest_header_list
 
     context['manifests'] = db
+    context['service_sid_list'] = gen_service_sid_list(db)
     context['utilities'] = utilities
 
     gen_files(context, gen_file_list, append_gen_file)
@@ -0,0 +1,185 @@
+#-------------------------------------------------------------------------------
+# Copyright (c) 2020, Arm Limited. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+#-------------------------------------------------------------------------------
+
+"""
+Turns the PC samples of an image built with TFM_SPM_PROFILE into histograms.
+
+The samples are read with tfm_platform_spm_profile_read() and saved as they
+are in memory: eight bytes per sample, the PC then the partition ID, both
+32-bit little-endian. Each PC is attributed to the function of the secure ELF
+file which contains it, and each sample to the partition which was running.
+"""
+
+import re
+import sys
+import struct
+import argparse
+from collections import Counter
+
+SAMPLE_FMT = '<Ii'
+SAMPLE_SIZE = struct.calcsize(SAMPLE_FMT)
+
+HANDLER_ID = -1
+NON_SECURE_ID = 0
+
+SHT_SYMTAB = 2
+STT_FUNC = 2
+
+
+class ElfSymbols(object):
+    """
+    Function symbols of an ELF file, read without any external package.
+    """
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            data = f.read()
+
+        if data[:4] != b'\x7fELF':
+            raise ValueError(path + " is not an ELF file")
+
+        is_64 = data[4] == 2
+        endian = '<' if data[5] == 1 else '>'
+
+        if is_64:
+            shoff, = struct.unpack_from(endian + 'Q', data, 0x28)
+            shentsize, shnum = struct.unpack_from(endian + 'HH', data, 0x3A)
+            sh_fmt = endian + 'IIQQQQIIQQ'
+            sym_fmt = endian + 'IBBHQQ'
+        else:
+            shoff, = struct.unpack_from(endian + 'I', data, 0x20)
+            shentsize, shnum = struct.unpack_from(endian + 'HH', data, 0x2E)
+            sh_fmt = endian + 'IIIIIIIIII'
+            sym_fmt = endian + 'IIIBBH'
+
+        headers = [struct.unpack_from(sh_fmt, data, shoff + i * shentsize)
+                   for i in range(shnum)]
+
+        # (start, end, name) of the functions, sorted by start address
+        self.funcs = []
+        for header in headers:
+            if header[1] != SHT_SYMTAB:
+                continue
+            off, size, link, entsize = (header[4], header[5], header[6],
+                                        header[9])
+            names_off = headers[link][4]
+            for pos in range(off, off + size, entsize):
+                if is_64:
+                    name, info, _, _, value, sym_size = \
+                        struct.unpack_from(sym_fmt, data, pos)
+                else:
+                    name, value, sym_size, info, _, _ = \
+                        struct.unpack_from(sym_fmt, data, pos)
+                if (info & 0xF) != STT_FUNC or value == 0:
+                    continue
+                end = data.index(b'\0', names_off + name)
+                name = data[names_off + name:end].decode()
+                # Thumb functions have the low bit of their address set
+                start = value & ~1
+                self.funcs.append((start, start + max(sym_size, 1), name))
+        self.funcs.sort()
+
+    def lookup(self, pc):
+        """
+        Returns the name of the function which contains pc, or None.
+        """
+        lo, hi = 0, len(self.funcs)
+        while lo < hi:
+            mid = (lo + hi) // 2
+            if self.funcs[mid][0] <= pc:
+                lo = mid + 1
+            else:
+                hi = mid
+        if lo > 0:
+            start, end, name = self.funcs[lo - 1]
+            if start <= pc < end:
+                return name
+        return None
+
+
+def read_partition_names(path):
+    """
+    Reads the partition names from psa_manifest/pid.h.
+    """
+    names = {NON_SECURE_ID: 'NON_SECURE', HANDLER_ID: 'HANDLER'}
+    pattern = re.compile(r'#define\s+(\w+)\s+\((\d+)\)')
+    with open(path) as f:
+        for line in f:
+            match = pattern.match(line)
+            if match and match.group(1) != 'TFM_MAX_USER_PARTITIONS':
+                names[int(match.group(2))] = match.group(1)
+    return names
+
+
+def read_samples(stream):
+    """
+    Returns the (pc, partition ID) pairs of the samples, a bytes object.
+    """
+    count = len(stream) // SAMPLE_SIZE
+    return [struct.unpack_from(SAMPLE_FMT, stream, i * SAMPLE_SIZE)
+            for i in range(count)]
+
+
+def print_histogram(title, counter, total, limit, out):
+    out.write('%s\n' % title)
+    for key, count in counter.most_common(limit):
+        out.write('%8d %6.2f%%  %s\n' % (count, 100.0 * count / total, key))
+    out.write('\n')
+
+
+def report(symbols, names, samples, limit, out):
+    if not samples:
+        out.write('No samples\n')
+        return
+
+    partitions = Counter()
+    functions = Counter()
+    for pc, partition_id in samples:
+        partitions[names.get(partition_id, str(partition_id))] += 1
+        if partition_id == NON_SECURE_ID and pc == 0:
+            functions['<non-secure>'] += 1
+        else:
+            functions[symbols.lookup(pc) or '<0x%08x>' % pc] += 1
+
+    out.write('%d samples\n\n' % len(samples))
+    print_histogram('Partitions', partitions, len(samples), None, out)
+    print_histogram('Functions', functions, len(samples), limit, out)
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        description='Build the PC sample histograms of a TF-M secure image')
+    parser.add_argument('elf', help='ELF file of the secure image, '
+                                    'e.g. tfm_s.axf')
+    parser.add_argument('samples', nargs='?', default='-',
+                        help='Saved samples, or - (default) to read standard '
+                             'input')
+    parser.add_argument('--pid', metavar='PID_H',
+                        help='psa_manifest/pid.h, to print partition names')
+    parser.add_argument('--top', type=int, default=30,
+                        help='Number of functions listed (default 30)')
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+    symbols = ElfSymbols(args.elf)
+    if args.pid:
+        names = read_partition_names(args.pid)
+    else:
+        names = {NON_SECURE_ID: 'NON_SECURE', HANDLER_ID: 'HANDLER'}
+
+    if args.samples == '-':
+        stream = sys.stdin.buffer.read()
+    else:
+        with open(args.samples, 'rb') as f:
+            stream = f.read()
+
+    report(symbols, names, read_samples(stream), args.top, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
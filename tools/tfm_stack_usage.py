@@ -0,0 +1,315 @@
+#-------------------------------------------------------------------------------
+# Copyright (c) 2020, Arm Limited. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+#-------------------------------------------------------------------------------
+
+"""
+Reports the worst case stack depth of the entry point of each secure
+partition, next to the stack size of its manifest.
+
+In the library model the partitions have no stack of their own. They all run
+on the TFM_SECURE_STACK region, and a secure function called by another
+partition runs on the stack of its caller. The call graph is then extended
+from the veneer of each secure function to the function itself, and the
+depth of each secure function and partition init function is reported next
+to the size of the shared stack, read from the ELF file.
+
+The stack used by each function is read from the .su files written by GCC
+with -fstack-usage (TFM_STACK_USAGE=ON). The call graph is read from the
+disassembly of the secure image, so it includes the tail calls and the
+functions of the libraries. The depth of a function is its own stack usage,
+plus the deepest depth of the functions it calls.
+
+The depth is a lower bound when the call graph of a function contains:
+ - an indirect call, through a function pointer,
+ - a recursive call,
+ - a function without stack usage information, such as an assembly function
+   or a function of a library built without -fstack-usage, counted as 0,
+ - a dynamic stack allocation, counted with its static part only.
+These are listed under the partition, to be checked by hand.
+"""
+
+import os
+import re
+import sys
+import argparse
+import subprocess
+
+try:
+    import yaml
+except ImportError as e:
+    print (str(e) + " To install it, type:")
+    print ("pip install PyYAML")
+    exit(1)
+
+DEFAULT_MANIFEST_LIST = os.path.join('tools', 'tfm_manifest_list.yaml')
+
+# Context pushed onto the partition stack by an exception taken while the
+# partition runs: the basic frame of 32 bytes, and the additional state of 40
+# bytes of Armv8-M when a non-secure exception preempts the secure state. The
+# image is built without the floating point context.
+DEFAULT_EXCEPTION_FRAME = 72
+
+# Section of the stack shared by the partitions of the library model
+SHARED_STACK_SECTION = '.TFM_SECURE_STACK'
+
+# The iovec arguments of a call from the non-secure world are kept at the top
+# of the shared stack: four psa_invec, four psa_outvec and their two counts.
+IOVEC_ARGS_SIZE = 72
+
+# Function header of the disassembly, for example "00010234 <main>:"
+FUNC_RE = re.compile(r'^[0-9a-f]+ <([^>]+)>:$')
+# Direct branch to a symbol, for example "bl 1037c <foo>" or "b.w 10400 <bar>"
+BRANCH_RE = re.compile(r'\t(b[a-z]*)(?:\.[nw])?\s+[0-9a-f]+ <([^>+]+)(\+0x[0-9a-f]+)?>')
+# Branch through a register other than the link register
+INDIRECT_RE = re.compile(r'\t(blx|bx)(?:\.[nw])?\s+(r[0-9]+|ip|sb|sl|fp)\b')
+
+
+def read_stack_usage(su_dir):
+    """
+    Reads the .su files under su_dir, and returns a dictionary of the stack
+    usage of each function, with whether it is dynamic. A static function of
+    the same name in several files gets the largest usage.
+    """
+    usage = {}
+    for root, _, files in os.walk(su_dir):
+        for name in files:
+            if not name.endswith('.su'):
+                continue
+            with open(os.path.join(root, name)) as f:
+                for line in f:
+                    fields = line.rstrip('\n').split('\t')
+                    if len(fields) < 3:
+                        continue
+                    func = fields[0].rsplit(':', 1)[-1]
+                    size = int(fields[1])
+                    dynamic = 'dynamic' in fields[2] and \
+                              'bounded' not in fields[2]
+                    old_size, old_dynamic = usage.get(func, (0, False))
+                    usage[func] = (max(size, old_size), dynamic or old_dynamic)
+    return usage
+
+
+def read_call_graph(objdump, elf):
+    """
+    Disassembles the ELF file, and returns a dictionary of the functions
+    called by each function, and the set of functions which do indirect
+    calls.
+    """
+    out = subprocess.check_output([objdump, '-d', '--no-show-raw-insn', elf],
+                                  universal_newlines=True)
+    calls = {}
+    indirect = set()
+    func = None
+    for line in out.splitlines():
+        m = FUNC_RE.match(line)
+        if m:
+            func = m.group(1)
+            calls.setdefault(func, set())
+            continue
+        if func is None:
+            continue
+        m = BRANCH_RE.search(line)
+        if m:
+            # A branch inside the function is not a call
+            if m.group(2) != func and not m.group(3):
+                calls[func].add(m.group(2))
+            continue
+        if INDIRECT_RE.search(line):
+            indirect.add(func)
+    return calls, indirect
+
+
+def read_section_size(objdump, elf, section):
+    """
+    Returns the size of a section of the ELF file, or None if the image has no
+    such section.
+    """
+    out = subprocess.check_output([objdump, '-h', elf],
+                                  universal_newlines=True)
+    for line in out.splitlines():
+        fields = line.split()
+        if len(fields) > 2 and fields[1] == section:
+            return int(fields[2], 16)
+    return None
+
+
+def add_secure_function_calls(calls, usage, sfns, exception_frame):
+    """
+    Extends the call graph of the library model with the calls to the secure
+    functions. A call to the veneer of a secure function goes through an SVC,
+    which stacks an exception frame, then runs the function on the same stack.
+    """
+    for sfn in sfns:
+        node = 'svc:' + sfn
+        usage[node] = (exception_frame, False)
+        calls[node] = set([sfn])
+        veneer = 'tfm_' + sfn + '_veneer'
+        if '__acle_se_' + veneer in calls:
+            # The veneer is a stub of the linker which only branches
+            usage.setdefault(veneer, (0, False))
+        for name in (veneer, '__acle_se_' + veneer):
+            if name in calls:
+                calls[name].add(node)
+
+
+class StackDepth(object):
+    """
+    Worst case stack depth of the functions of a call graph.
+    """
+    def __init__(self, usage, calls, indirect):
+        self.usage = usage
+        self.calls = calls
+        self.indirect = indirect
+        self.depth = {}
+
+    def get(self, func, issues, path=()):
+        """
+        Returns the worst case stack depth of func, and adds to issues the
+        reasons why it may be a lower bound.
+        """
+        if func in path:
+            issues.add('recursion: ' + func)
+            return 0
+        if func in self.depth:
+            depth, func_issues = self.depth[func]
+            issues.update(func_issues)
+            return depth
+
+        func_issues = set()
+        size, dynamic = self.usage.get(func, (0, False))
+        if func not in self.usage:
+            func_issues.add('no stack usage: ' + func)
+        if dynamic:
+            func_issues.add('dynamic allocation: ' + func)
+        if func in self.indirect:
+            func_issues.add('indirect call: ' + func)
+
+        deepest = 0
+        for callee in sorted(self.calls.get(func, ())):
+            deepest = max(deepest,
+                          self.get(callee, func_issues, path + (func,)))
+
+        depth = size + deepest
+        # A depth found inside a cycle depends on the path taken to it
+        if not any(i.startswith('recursion') for i in func_issues):
+            self.depth[func] = (depth, func_issues)
+        issues.update(func_issues)
+        return depth
+
+
+def read_partitions(manifest_list_file, root):
+    """
+    Returns the name, the entry point, the stack size and the secure functions
+    of each partition of the manifest list.
+    """
+    with open(manifest_list_file) as f:
+        manifest_list = yaml.safe_load(f)
+
+    partitions = []
+    for item in manifest_list['manifest_list']:
+        with open(os.path.join(root, item['manifest'])) as f:
+            manifest = yaml.safe_load(f)
+        sfns = [func['signal'].lower()
+                for func in manifest.get('secure_functions', [])]
+        partitions.append((manifest['name'], manifest['entry_point'],
+                           int(str(manifest['stack_size']), 0), sfns))
+    return partitions
+
+
+def report_shared_stack(depths, calls, partitions, stack_size,
+                        exception_frame):
+    """
+    Prints the depth of the partition init functions and of the secure
+    functions on the stack shared in the library model, and returns the
+    smallest margin.
+    """
+    worst = None
+    print("SHARED_STACK,partition,function,depth,stack_size,margin")
+    for name, entry, _, sfns in partitions:
+        for func in [entry] + sfns:
+            if func not in calls:
+                continue
+
+            issues = set()
+            depth = depths.get(func, issues) + exception_frame + \
+                    IOVEC_ARGS_SIZE
+            print("SHARED_STACK,%s,%s,%d,%d,%d" % (name, func, depth,
+                                                   stack_size,
+                                                   stack_size - depth))
+            for issue in sorted(issues):
+                print("    lower bound, " + issue)
+            if worst is None or depth > worst:
+                worst = depth
+    if worst is None:
+        return 0
+    return stack_size - worst
+
+
+def main():
+    parser = argparse.ArgumentParser(description='TF-M partition stack usage report')
+    parser.add_argument('-e', '--elf', required=True,
+                        help='ELF file of the secure image')
+    parser.add_argument('-s', '--su-dir', required=True,
+                        help='Directory searched for the .su files')
+    parser.add_argument('-d', '--objdump', default='arm-none-eabi-objdump',
+                        help='objdump of the toolchain')
+    parser.add_argument('-m', '--manifest-list', default=DEFAULT_MANIFEST_LIST,
+                        help='Manifest list of the partitions')
+    parser.add_argument('-r', '--root', default='.',
+                        help='TF-M root directory, which the manifest paths '
+                             'are relative to')
+    parser.add_argument('-f', '--exception-frame', type=int,
+                        default=DEFAULT_EXCEPTION_FRAME,
+                        help='Bytes added to each depth for the context '
+                             'pushed by an exception')
+    parser.add_argument('-c', '--check', action='store_true',
+                        help='Fail if a depth found exceeds its stack')
+    args = parser.parse_args()
+
+    # The call chains of the libraries can be deep
+    sys.setrecursionlimit(10000)
+
+    usage = read_stack_usage(args.su_dir)
+    if not usage:
+        print("No .su file found in " + args.su_dir +
+              ", build with TFM_STACK_USAGE=ON")
+        return 1
+
+    calls, indirect = read_call_graph(args.objdump, args.elf)
+    partitions = read_partitions(args.manifest_list, args.root)
+    shared_size = read_section_size(args.objdump, args.elf,
+                                    SHARED_STACK_SECTION)
+
+    if shared_size is not None:
+        sfns = [sfn for partition in partitions for sfn in partition[3]]
+        add_secure_function_calls(calls, usage, sfns, args.exception_frame)
+        depths = StackDepth(usage, calls, indirect)
+        margin = report_shared_stack(depths, calls, partitions, shared_size,
+                                     args.exception_frame)
+        return 1 if args.check and margin < 0 else 0
+
+    depths = StackDepth(usage, calls, indirect)
+    overflow = False
+
+    print("STACK,partition,entry_point,depth,stack_size,margin")
+    for name, entry, stack_size, _ in partitions:
+        if entry not in calls:
+            # The partition is not built in this configuration
+            continue
+
+        issues = set()
+        depth = depths.get(entry, issues) + args.exception_frame
+        print("STACK,%s,%s,%d,%d,%d" % (name, entry, depth, stack_size,
+                                        stack_size - depth))
+        for issue in sorted(issues):
+            print("    lower bound, " + issue)
+        overflow = overflow or depth > stack_size
+
+    return 1 if args.check and overflow else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())